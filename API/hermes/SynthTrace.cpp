@@ -15,6 +15,7 @@
 #include "hermes/VM/MockedEnvironment.h"
 
 #include "llvm/Support/Endian.h"
+#include "llvm/Support/LEB128.h"
 #include "llvm/Support/NativeFormatting.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -346,6 +347,130 @@ std::string doublePrinter(double x) {
   return result;
 }
 
+/// The first bytes of a binary trace, which a JSON trace can't start with.
+constexpr char kBinaryMagic[] = {'\0', 'h', 's', 'y', 'n', 't', 'h', '\0'};
+
+/// Tags of the entries of a binary trace that are not records. Records are
+/// tagged with their RecordType.
+enum class BinaryTag : uint8_t {
+  /// The definition of the next string of the string table: its length and
+  /// its bytes.
+  String = 0x40,
+  /// The source hash and the mocked environment, which end the trace.
+  Trailer = 0x41,
+};
+
+/// Tags of the values of a binary trace.
+enum class ValueTag : uint8_t {
+  Undefined,
+  Null,
+  False,
+  True,
+  /// The 8 bytes of a double, little-endian.
+  Number,
+  /// A number that is a non-negative integer, as a varint.
+  Integer,
+  String,
+  Object,
+};
+
+/// Reads the entries of a binary trace.
+/// \throws invalid_argument if the trace is malformed or truncated.
+class BinaryReader {
+ public:
+  explicit BinaryReader(const llvm::MemoryBuffer &buf)
+      : cur_(reinterpret_cast<const uint8_t *>(buf.getBufferStart())),
+        end_(reinterpret_cast<const uint8_t *>(buf.getBufferEnd())) {}
+
+  bool atEnd() const {
+    return cur_ == end_;
+  }
+
+  uint8_t readByte() {
+    if (cur_ == end_) {
+      throw std::invalid_argument("Binary trace is truncated");
+    }
+    return *cur_++;
+  }
+
+  llvm::ArrayRef<uint8_t> readBytes(size_t size) {
+    if (static_cast<size_t>(end_ - cur_) < size) {
+      throw std::invalid_argument("Binary trace is truncated");
+    }
+    llvm::ArrayRef<uint8_t> bytes{cur_, size};
+    cur_ += size;
+    return bytes;
+  }
+
+  uint64_t readVarint() {
+    unsigned size;
+    const char *error = nullptr;
+    uint64_t value = llvm::decodeULEB128(cur_, &size, end_, &error);
+    if (error) {
+      throw std::invalid_argument(std::string("Binary trace: ") + error);
+    }
+    cur_ += size;
+    return value;
+  }
+
+  std::string readRawString() {
+    auto bytes = readBytes(readVarint());
+    return std::string(bytes.begin(), bytes.end());
+  }
+
+  /// Read the index of a string, which must already be defined.
+  const std::string &readString() {
+    uint64_t idx = readVarint();
+    if (idx >= strings_.size()) {
+      throw std::invalid_argument("Binary trace uses an undefined string");
+    }
+    return strings_[idx];
+  }
+
+  /// Add the string defined at the current position to the table.
+  void readStringDefinition() {
+    strings_.push_back(readRawString());
+  }
+
+  SynthTrace::TraceValue readValue(SynthTrace &trace) {
+    switch (static_cast<ValueTag>(readByte())) {
+      case ValueTag::Undefined:
+        return SynthTrace::encodeUndefined();
+      case ValueTag::Null:
+        return SynthTrace::encodeNull();
+      case ValueTag::False:
+        return SynthTrace::encodeBool(false);
+      case ValueTag::True:
+        return SynthTrace::encodeBool(true);
+      case ValueTag::Number:
+        return SynthTrace::encodeNumber(
+            llvm::support::endian::read<double, llvm::support::little, 1>(
+                readBytes(sizeof(double)).data()));
+      case ValueTag::Integer:
+        return SynthTrace::encodeNumber(readVarint());
+      case ValueTag::String:
+        return trace.encodeString(readString());
+      case ValueTag::Object:
+        return SynthTrace::encodeObject(readVarint());
+    }
+    throw std::invalid_argument("Binary trace has an invalid value");
+  }
+
+  std::vector<SynthTrace::TraceValue> readValues(SynthTrace &trace) {
+    std::vector<SynthTrace::TraceValue> values;
+    for (uint64_t i = 0, e = readVarint(); i < e; ++i) {
+      values.push_back(readValue(trace));
+    }
+    return values;
+  }
+
+ private:
+  const uint8_t *cur_;
+  const uint8_t *end_;
+  /// The strings defined so far, by index.
+  std::vector<std::string> strings_;
+};
+
 } // namespace
 
 SynthTrace::TraceValue SynthTrace::encodeUndefined() {
@@ -365,13 +490,10 @@ SynthTrace::TraceValue SynthTrace::encodeNumber(double value) {
 }
 
 SynthTrace::TraceValue SynthTrace::encodeString(const std::string &value) {
-  auto it = std::find(stringTable_.begin(), stringTable_.end(), value);
-  uint64_t idx = 0;
-  if (it == stringTable_.end()) {
-    stringTable_.push_back(value);
-    idx = stringTable_.size() - 1;
-  } else {
-    idx = std::distance(stringTable_.begin(), it);
+  auto it = stringIndices_.emplace(value, stringTable_.size()).first;
+  uint64_t idx = it->second;
+  if (idx == stringTable_.size()) {
+    stringTable_.push_back(&it->first);
   }
   // Fake a HermesValue string with a non-pointer. Don't use this value in a
   // GC or it will think the index is a pointer.
@@ -380,7 +502,7 @@ SynthTrace::TraceValue SynthTrace::encodeString(const std::string &value) {
 }
 
 const std::string &SynthTrace::decodeString(TraceValue value) const {
-  return stringTable_.at(reinterpret_cast<uint64_t>(value.getString()));
+  return *stringTable_.at(reinterpret_cast<uint64_t>(value.getString()));
 }
 
 SynthTrace::TraceValue SynthTrace::encodeObject(ObjectID objID) {
@@ -445,6 +567,13 @@ std::tuple<
     ::hermes::vm::RuntimeConfig,
     ::hermes::vm::MockedEnvironment>
 SynthTrace::parse(std::unique_ptr<llvm::MemoryBuffer> trace) {
+  if (trace->getBufferSize() >= sizeof(kBinaryMagic) &&
+      std::equal(
+          std::begin(kBinaryMagic),
+          std::end(kBinaryMagic),
+          trace->getBufferStart())) {
+    return parseBinary(std::move(trace));
+  }
   JSLexer::Allocator alloc;
   JSONObject *root = llvm::cast<JSONObject>(parseJSON(alloc, std::move(trace)));
   if (!llvm::dyn_cast_or_null<JSONNumber>(root->get("globalObjID"))) {
@@ -500,6 +629,400 @@ SynthTrace::parse(const std::string &tracefile) {
   return parse(std::move(llvm::MemoryBuffer::getFile(tracefile).get()));
 }
 
+/* static */
+std::tuple<
+    SynthTrace,
+    ::hermes::vm::RuntimeConfig,
+    ::hermes::vm::MockedEnvironment>
+SynthTrace::parseBinary(std::unique_ptr<llvm::MemoryBuffer> buf) {
+  BinaryReader reader{*buf};
+  llvm::ArrayRef<uint8_t> magic = reader.readBytes(sizeof(kBinaryMagic));
+  if (!std::equal(
+          std::begin(kBinaryMagic),
+          std::end(kBinaryMagic),
+          magic.begin())) {
+    throw std::invalid_argument("Binary trace has an invalid magic number");
+  }
+  const uint64_t version = reader.readVarint();
+  if (version != synthVersion()) {
+    throw std::invalid_argument(
+        "Trace version mismatch, expected " +
+        ::hermes::oscompat::to_string(synthVersion()) +
+        ", actual: " + ::hermes::oscompat::to_string(version));
+  }
+  SynthTrace trace(reader.readVarint());
+  ::hermes::vm::GCConfig::Builder gcconf;
+  gcconf.withInitHeapSize(reader.readVarint());
+  gcconf.withMaxHeapSize(reader.readVarint());
+
+  TimeSinceStart time = TimeSinceStart::zero();
+  while (true) {
+    uint8_t tag = reader.readByte();
+    if (tag == static_cast<uint8_t>(BinaryTag::String)) {
+      reader.readStringDefinition();
+      continue;
+    }
+    if (tag == static_cast<uint8_t>(BinaryTag::Trailer)) {
+      break;
+    }
+    if (tag > static_cast<uint8_t>(RecordType::SetPropertyNativeReturn)) {
+      throw std::invalid_argument("Binary trace has an invalid record type");
+    }
+    // Times are stored as zig-zag encoded differences with the previous
+    // record.
+    uint64_t delta = reader.readVarint();
+    time += TimeSinceStart(
+        static_cast<int64_t>(delta >> 1) ^ -static_cast<int64_t>(delta & 1));
+    switch (static_cast<RecordType>(tag)) {
+      case RecordType::BeginExecJS:
+        trace.emplace_back<BeginExecJSRecord>(time);
+        break;
+      case RecordType::EndExecJS:
+        trace.emplace_back<EndExecJSRecord>(time, reader.readValue(trace));
+        break;
+      case RecordType::Marker:
+        trace.emplace_back<MarkerRecord>(time, reader.readString());
+        break;
+      case RecordType::CreateObject:
+        trace.emplace_back<CreateObjectRecord>(time, reader.readVarint());
+        break;
+      case RecordType::CreateHostObject:
+        trace.emplace_back<CreateHostObjectRecord>(time, reader.readVarint());
+        break;
+      case RecordType::CreateHostFunction:
+        trace.emplace_back<CreateHostFunctionRecord>(
+            time, reader.readVarint());
+        break;
+      case RecordType::GetProperty: {
+        ObjectID objID = reader.readVarint();
+        const std::string &propName = reader.readString();
+        trace.emplace_back<GetPropertyRecord>(
+            time, objID, propName, reader.readValue(trace));
+        break;
+      }
+      case RecordType::SetProperty: {
+        ObjectID objID = reader.readVarint();
+        const std::string &propName = reader.readString();
+        trace.emplace_back<SetPropertyRecord>(
+            time, objID, propName, reader.readValue(trace));
+        break;
+      }
+      case RecordType::HasProperty: {
+        ObjectID objID = reader.readVarint();
+        trace.emplace_back<HasPropertyRecord>(
+            time, objID, reader.readString());
+        break;
+      }
+      case RecordType::GetPropertyNames: {
+        ObjectID objID = reader.readVarint();
+        trace.emplace_back<GetPropertyNamesRecord>(
+            time, objID, reader.readVarint());
+        break;
+      }
+      case RecordType::CreateArray: {
+        ObjectID objID = reader.readVarint();
+        trace.emplace_back<CreateArrayRecord>(
+            time, objID, reader.readVarint());
+        break;
+      }
+      case RecordType::ArrayRead: {
+        ObjectID objID = reader.readVarint();
+        size_t index = reader.readVarint();
+        trace.emplace_back<ArrayReadRecord>(
+            time, objID, index, reader.readValue(trace));
+        break;
+      }
+      case RecordType::ArrayWrite: {
+        ObjectID objID = reader.readVarint();
+        size_t index = reader.readVarint();
+        trace.emplace_back<ArrayWriteRecord>(
+            time, objID, index, reader.readValue(trace));
+        break;
+      }
+      case RecordType::CallFromNative:
+      case RecordType::ConstructFromNative:
+      case RecordType::CallToNative: {
+        ObjectID functionID = reader.readVarint();
+        TraceValue thisArg = reader.readValue(trace);
+        auto args = reader.readValues(trace);
+        if (tag == static_cast<uint8_t>(RecordType::CallFromNative)) {
+          trace.emplace_back<CallFromNativeRecord>(
+              time, functionID, thisArg, args);
+        } else if (tag == static_cast<uint8_t>(RecordType::CallToNative)) {
+          trace.emplace_back<CallToNativeRecord>(
+              time, functionID, thisArg, args);
+        } else {
+          trace.emplace_back<ConstructFromNativeRecord>(
+              time, functionID, thisArg, args);
+        }
+        break;
+      }
+      case RecordType::ReturnFromNative:
+        trace.emplace_back<ReturnFromNativeRecord>(
+            time, reader.readValue(trace));
+        break;
+      case RecordType::ReturnToNative:
+        trace.emplace_back<ReturnToNativeRecord>(
+            time, reader.readValue(trace));
+        break;
+      case RecordType::GetPropertyNative: {
+        ObjectID hostObjectID = reader.readVarint();
+        trace.emplace_back<GetPropertyNativeRecord>(
+            time, hostObjectID, reader.readString());
+        break;
+      }
+      case RecordType::GetPropertyNativeReturn:
+        trace.emplace_back<GetPropertyNativeReturnRecord>(
+            time, reader.readValue(trace));
+        break;
+      case RecordType::SetPropertyNative: {
+        ObjectID hostObjectID = reader.readVarint();
+        const std::string &propName = reader.readString();
+        trace.emplace_back<SetPropertyNativeRecord>(
+            time, hostObjectID, propName, reader.readValue(trace));
+        break;
+      }
+      case RecordType::SetPropertyNativeReturn:
+        trace.emplace_back<SetPropertyNativeReturnRecord>(time);
+        break;
+    }
+  }
+
+  ::hermes::SHA1 hash;
+  auto hashBytes = reader.readBytes(hash.size());
+  std::copy(hashBytes.begin(), hashBytes.end(), hash.begin());
+  trace.setSourceHash(hash);
+  ::hermes::vm::MockedEnvironment env;
+  env.mathRandomSeed = reader.readVarint();
+  for (uint64_t i = 0, e = reader.readVarint(); i < e; ++i) {
+    env.callsToDateNow.push_back(reader.readVarint());
+  }
+  for (uint64_t i = 0, e = reader.readVarint(); i < e; ++i) {
+    env.callsToNewDate.push_back(reader.readVarint());
+  }
+  for (uint64_t i = 0, e = reader.readVarint(); i < e; ++i) {
+    env.callsToDateAsFunction.push_back(reader.readRawString());
+  }
+  if (!reader.atEnd()) {
+    throw std::invalid_argument("Binary trace continues after its trailer");
+  }
+  return std::make_tuple(
+      std::move(trace),
+      ::hermes::vm::RuntimeConfig::Builder()
+          .withGCConfig(gcconf.build())
+          .build(),
+      std::move(env));
+}
+
+SynthTrace::BinaryWriter::BinaryWriter(
+    llvm::raw_ostream &os,
+    const SynthTrace &trace,
+    const ::hermes::vm::RuntimeConfig &conf)
+    : os_(os), trace_(trace), record_(recordBuf_) {
+  os_.write(kBinaryMagic, sizeof(kBinaryMagic));
+  writeVarint(os_, synthVersion());
+  writeVarint(os_, trace.globalObjID());
+  writeVarint(os_, conf.getGCConfig().getInitHeapSize());
+  writeVarint(os_, conf.getGCConfig().getMaxHeapSize());
+}
+
+/* static */
+void SynthTrace::BinaryWriter::writeVarint(
+    llvm::raw_ostream &os,
+    uint64_t value) {
+  llvm::encodeULEB128(value, os);
+}
+
+/* static */
+void SynthTrace::BinaryWriter::writeRawString(
+    llvm::raw_ostream &os,
+    llvm::StringRef str) {
+  writeVarint(os, str.size());
+  os << str;
+}
+
+uint64_t SynthTrace::BinaryWriter::internString(llvm::StringRef str) {
+  auto it = strings_.try_emplace(str, strings_.size());
+  if (it.second) {
+    os_ << static_cast<char>(BinaryTag::String);
+    writeRawString(os_, str);
+  }
+  return it.first->second;
+}
+
+void SynthTrace::BinaryWriter::writeString(llvm::StringRef str) {
+  writeVarint(record_, internString(str));
+}
+
+void SynthTrace::BinaryWriter::writeValue(TraceValue value) {
+  if (value.isUndefined()) {
+    record_ << static_cast<char>(ValueTag::Undefined);
+  } else if (value.isNull()) {
+    record_ << static_cast<char>(ValueTag::Null);
+  } else if (value.isBool()) {
+    record_ << static_cast<char>(
+        value.getBool() ? ValueTag::True : ValueTag::False);
+  } else if (value.isNumber()) {
+    double number = value.getNumber();
+    // Most numbers are small integers, which take one or two bytes as a
+    // varint.  Keep the exact bits of everything else, including -0.
+    if (number >= 0 && number < (uint64_t(1) << 53) &&
+        number == std::trunc(number) && !std::signbit(number)) {
+      record_ << static_cast<char>(ValueTag::Integer);
+      writeVarint(record_, static_cast<uint64_t>(number));
+    } else {
+      char bytes[sizeof(double)];
+      llvm::support::endian::write<double, llvm::support::little, 1>(
+          bytes, number);
+      record_ << static_cast<char>(ValueTag::Number);
+      record_.write(bytes, sizeof(bytes));
+    }
+  } else if (value.isString()) {
+    record_ << static_cast<char>(ValueTag::String);
+    writeString(trace_.decodeString(value));
+  } else if (value.isObject()) {
+    record_ << static_cast<char>(ValueTag::Object);
+    writeVarint(record_, decodeObject(value));
+  } else {
+    llvm_unreachable("No other values allowed in the trace");
+  }
+}
+
+void SynthTrace::BinaryWriter::writeValues(
+    const std::vector<TraceValue> &values) {
+  writeVarint(record_, values.size());
+  for (TraceValue value : values) {
+    writeValue(value);
+  }
+}
+
+void SynthTrace::BinaryWriter::write(const Record &rec) {
+  // The fields are buffered, so that the definitions of the strings they use
+  // can be written before the record.
+  recordBuf_.clear();
+  // Times are stored as zig-zag encoded differences with the previous record.
+  int64_t delta = (rec.time_ - lastTime_).count();
+  lastTime_ = rec.time_;
+  writeVarint(record_, (static_cast<uint64_t>(delta) << 1) ^ (delta >> 63));
+  switch (rec.getType()) {
+    case RecordType::BeginExecJS:
+    case RecordType::SetPropertyNativeReturn:
+      break;
+    case RecordType::EndExecJS:
+      writeValue(static_cast<const EndExecJSRecord &>(rec).retVal_);
+      break;
+    case RecordType::Marker:
+      writeString(static_cast<const MarkerRecord &>(rec).tag_);
+      break;
+    case RecordType::CreateObject:
+    case RecordType::CreateHostObject:
+    case RecordType::CreateHostFunction:
+      writeVarint(
+          record_, static_cast<const CreateObjectRecord &>(rec).objID_);
+      break;
+    case RecordType::GetProperty:
+    case RecordType::SetProperty: {
+      const auto &gspr = static_cast<const GetOrSetPropertyRecord &>(rec);
+      writeVarint(record_, gspr.objID_);
+      writeString(gspr.propName_);
+      writeValue(gspr.value_);
+      break;
+    }
+    case RecordType::HasProperty: {
+      const auto &hpr = static_cast<const HasPropertyRecord &>(rec);
+      writeVarint(record_, hpr.objID_);
+      writeString(hpr.propName_);
+      break;
+    }
+    case RecordType::GetPropertyNames: {
+      const auto &gpnr = static_cast<const GetPropertyNamesRecord &>(rec);
+      writeVarint(record_, gpnr.objID_);
+      writeVarint(record_, gpnr.propNamesID_);
+      break;
+    }
+    case RecordType::CreateArray: {
+      const auto &car = static_cast<const CreateArrayRecord &>(rec);
+      writeVarint(record_, car.objID_);
+      writeVarint(record_, car.length_);
+      break;
+    }
+    case RecordType::ArrayRead:
+    case RecordType::ArrayWrite: {
+      const auto &arwr = static_cast<const ArrayReadOrWriteRecord &>(rec);
+      writeVarint(record_, arwr.objID_);
+      writeVarint(record_, arwr.index_);
+      writeValue(arwr.value_);
+      break;
+    }
+    case RecordType::CallFromNative:
+    case RecordType::ConstructFromNative:
+    case RecordType::CallToNative: {
+      const auto &cr = static_cast<const CallRecord &>(rec);
+      writeVarint(record_, cr.functionID_);
+      writeValue(cr.thisArg_);
+      writeValues(cr.args_);
+      break;
+    }
+    case RecordType::ReturnFromNative:
+      writeValue(static_cast<const ReturnFromNativeRecord &>(rec).retVal_);
+      break;
+    case RecordType::ReturnToNative:
+      writeValue(static_cast<const ReturnToNativeRecord &>(rec).retVal_);
+      break;
+    case RecordType::GetPropertyNativeReturn:
+      writeValue(
+          static_cast<const GetPropertyNativeReturnRecord &>(rec).retVal_);
+      break;
+    case RecordType::GetPropertyNative: {
+      const auto &gpnr = static_cast<const GetPropertyNativeRecord &>(rec);
+      writeVarint(record_, gpnr.hostObjectID_);
+      writeString(gpnr.propName_);
+      break;
+    }
+    case RecordType::SetPropertyNative: {
+      const auto &spnr = static_cast<const SetPropertyNativeRecord &>(rec);
+      writeVarint(record_, spnr.hostObjectID_);
+      writeString(spnr.propName_);
+      writeValue(spnr.value_);
+      break;
+    }
+  }
+  os_ << static_cast<char>(rec.getType());
+  os_.write(recordBuf_.data(), recordBuf_.size());
+}
+
+void SynthTrace::BinaryWriter::finish(
+    const ::hermes::vm::MockedEnvironment &env) {
+  os_ << static_cast<char>(BinaryTag::Trailer);
+  const ::hermes::SHA1 &hash = trace_.sourceHash();
+  os_.write(reinterpret_cast<const char *>(hash.data()), hash.size());
+  writeVarint(os_, env.mathRandomSeed);
+  writeVarint(os_, env.callsToDateNow.size());
+  for (uint64_t dateNow : env.callsToDateNow) {
+    writeVarint(os_, dateNow);
+  }
+  writeVarint(os_, env.callsToNewDate.size());
+  for (uint64_t newDate : env.callsToNewDate) {
+    writeVarint(os_, newDate);
+  }
+  writeVarint(os_, env.callsToDateAsFunction.size());
+  for (const std::string &dateAsFunc : env.callsToDateAsFunction) {
+    writeRawString(os_, dateAsFunc);
+  }
+  os_.flush();
+}
+
+/* static */
+void SynthTrace::BinaryWriter::writeTrace(
+    llvm::raw_ostream &os,
+    const Printable &trace) {
+  BinaryWriter writer{os, trace.trace, trace.conf};
+  for (const std::unique_ptr<Record> &rec : trace.trace.records()) {
+    writer.write(*rec);
+  }
+  writer.finish(trace.env);
+}
+
 void SynthTrace::Record::toJSON(JSONEmitter &json, const SynthTrace &trace)
     const {
   json.openDict();
@@ -13,25 +13,29 @@
 #include "hermes/VM/MockedEnvironment.h"
 #include "hermes/VM/Operations.h"
 
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/raw_ostream.h"
+
 #include <chrono>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
-namespace llvm {
-// Forward declaration to avoid including llvm headers.
-class raw_ostream;
-} // namespace llvm
-
 namespace facebook {
 namespace hermes {
 namespace tracing {
 
 /// A SynthTrace is a list of events that occur in a run of a JS file by a
 /// runtime that uses JSI.
-/// It can be serialized into JSON and written to a llvm::raw_ostream.
+/// It can be serialized into JSON and written to a llvm::raw_ostream, or
+/// written in a compact binary format with a BinaryWriter, which can stream
+/// the records as they are added instead of keeping them.
 class SynthTrace {
  public:
+  class BinaryWriter;
+
   struct Printable final {
     const SynthTrace &trace;
     /// References to the vectors stored by the Runtime.
@@ -139,9 +143,19 @@ class SynthTrace {
 
   template <typename T, typename... Args>
   void emplace_back(Args &&... args) {
+    if (binaryWriter_) {
+      binaryWriter_->write(T(std::forward<Args>(args)...));
+      return;
+    }
     records_.emplace_back(new T(std::forward<Args>(args)...));
   }
 
+  /// Write the records added from now on to \p writer, which must outlive
+  /// this trace or be reset with nullptr, instead of keeping them.
+  void setBinaryWriter(BinaryWriter *writer) {
+    binaryWriter_ = writer;
+  }
+
   const std::vector<std::unique_ptr<Record>> &records() const {
     return records_;
   }
@@ -190,7 +204,7 @@ class SynthTrace {
     return x.getRaw() == y.getRaw();
   }
 
-  /// Parse a trace from a JSON string.
+  /// Parse a trace, either from a JSON string or in the binary format.
   static std::tuple<
       SynthTrace,
       ::hermes::vm::RuntimeConfig,
@@ -213,7 +227,18 @@ class SynthTrace {
   /// the IdentifierTable, except it doesn't need to be collected (it stores
   /// strings forever).
   /// Strings are stored in the trace objects as an index into this table.
-  std::vector<std::string> stringTable_;
+  std::vector<const std::string *> stringTable_;
+  /// The index of every string in stringTable_, which points to its keys.
+  std::unordered_map<std::string, uint64_t> stringIndices_;
+  /// If non-null, where the records are written instead of records_.
+  BinaryWriter *binaryWriter_{nullptr};
+
+  /// Parse a trace in the binary format written by BinaryWriter.
+  static std::tuple<
+      SynthTrace,
+      ::hermes::vm::RuntimeConfig,
+      ::hermes::vm::MockedEnvironment>
+  parseBinary(std::unique_ptr<llvm::MemoryBuffer> buf);
 
   /// The version of the Synth Benchmark
   constexpr static uint32_t synthVersion() {
@@ -750,6 +775,54 @@ class SynthTrace {
   };
 
   /// @}
+
+  /// Writes a trace in the binary format, one record at a time, so that the
+  /// trace can be streamed to disk while it is recorded.  The format is a
+  /// header with the global object id and the GC config, then the records,
+  /// then a trailer with the source hash and the mocked environment, which
+  /// are only known at the end.  Integers are varints, numbers that are small
+  /// integers too, and every string is written once and then referred to by
+  /// its index.
+  class BinaryWriter {
+   public:
+    /// Write the header for \p trace, recorded with \p conf, to \p os.
+    BinaryWriter(
+        llvm::raw_ostream &os,
+        const SynthTrace &trace,
+        const ::hermes::vm::RuntimeConfig &conf);
+
+    /// Write \p rec, a record of the trace.
+    void write(const Record &rec);
+
+    /// Write the trailer, with the source hash of the trace and \p env.
+    /// Nothing can be written after it.
+    void finish(const ::hermes::vm::MockedEnvironment &env);
+
+    /// Write all the records of \p trace, and its trailer, to \p os.
+    static void writeTrace(llvm::raw_ostream &os, const Printable &trace);
+
+   private:
+    static void writeVarint(llvm::raw_ostream &os, uint64_t value);
+    static void writeRawString(llvm::raw_ostream &os, llvm::StringRef str);
+    /// \return the index of \p str, after writing its definition the first
+    /// time.
+    uint64_t internString(llvm::StringRef str);
+    /// The following write the fields of the current record.
+    void writeString(llvm::StringRef str);
+    void writeValue(TraceValue value);
+    void writeValues(const std::vector<TraceValue> &values);
+
+    llvm::raw_ostream &os_;
+    const SynthTrace &trace_;
+    /// The fields of the current record.
+    llvm::SmallVector<char, 64> recordBuf_;
+    llvm::raw_svector_ostream record_;
+    /// The index of every string written so far.
+    llvm::StringMap<uint64_t> strings_;
+    /// The time of the last record written.
+    TimeSinceStart lastTime_{TimeSinceStart::zero()};
+  };
+
   friend llvm::raw_ostream &operator<<(
       llvm::raw_ostream &os,
       const SynthTrace::Printable &trace);
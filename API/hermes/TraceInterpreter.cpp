@@ -6,14 +6,19 @@
  */
 #include <hermes/TraceInterpreter.h>
 
+#include <hermes/Parser/JSONParser.h>
+#include <hermes/Support/JSONEmitter.h>
+#include <hermes/Support/OSCompat.h>
 #include <hermes/Support/SHA1.h>
 #include <hermes/TracingRuntime.h>
 #include <hermes/VM/instrumentation/PerfEvents.h>
 #include <jsi/instrumentation.h>
+#include <llvm/Support/Format.h>
 #include <llvm/Support/SHA1.h>
 #include <llvm/Support/SaveAndRestore.h>
 
 #include <algorithm>
+#include <cmath>
 #include <unordered_set>
 
 using namespace hermes::parser;
@@ -414,6 +419,103 @@ static std::string mergeGCStats(const std::vector<std::string> &repGCStats) {
   return *valueAndStats[median].second;
 }
 
+/// \return milliseconds elapsed since \p start.
+double msSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+/// \return the numeric entries of the heap info of \p rt, by name.
+TraceInterpreter::PhaseTimes getHeapMetrics(jsi::Runtime &rt) {
+  TraceInterpreter::PhaseTimes metrics;
+  Object info = rt.instrumentation().getHeapInfo(false).getObject(rt);
+  Array names = info.getPropertyNames(rt);
+  for (size_t i = 0, e = names.size(rt); i < e; ++i) {
+    std::string name = names.getValueAtIndex(rt, i).getString(rt).utf8(rt);
+    Value value = info.getProperty(rt, name.c_str());
+    if (value.isNumber())
+      metrics.emplace_back(std::move(name), value.getNumber());
+  }
+  return metrics;
+}
+
+/// \return the \p p-th percentile of \p sorted, by the nearest-rank method.
+double percentile(const std::vector<double> &sorted, double p) {
+  size_t rank = std::ceil(p / 100 * sorted.size());
+  return sorted[rank ? rank - 1 : 0];
+}
+
+/// Emit a dictionary with the summary over the reps of every value named in
+/// \p reps, in the order in which the names first appear.
+void emitSummaries(
+    ::hermes::JSONEmitter &json,
+    const std::vector<TraceInterpreter::PhaseTimes> &reps) {
+  std::vector<std::string> names;
+  std::unordered_map<std::string, std::vector<double>> values;
+  for (const auto &rep : reps) {
+    for (const auto &nameAndValue : rep) {
+      auto &samples = values[nameAndValue.first];
+      if (samples.empty())
+        names.push_back(nameAndValue.first);
+      samples.push_back(nameAndValue.second);
+    }
+  }
+  json.openDict();
+  for (const auto &name : names) {
+    auto &samples = values[name];
+    std::sort(samples.begin(), samples.end());
+    double sum = 0;
+    for (double sample : samples)
+      sum += sample;
+    json.emitKey(name);
+    json.openDict();
+    json.emitKeyValue("min", samples.front());
+    json.emitKeyValue("p50", percentile(samples, 50));
+    json.emitKeyValue("p90", percentile(samples, 90));
+    json.emitKeyValue("p99", percentile(samples, 99));
+    json.emitKeyValue("max", samples.back());
+    json.emitKeyValue("mean", sum / samples.size());
+    json.closeDict();
+  }
+  json.closeDict();
+}
+
+/// \return the benchmark report of the reps timed in \p repPhases, whose GC
+/// metrics are in \p repGCMetrics.
+std::string benchmarkReport(
+    const std::vector<TraceInterpreter::PhaseTimes> &repPhases,
+    const std::vector<TraceInterpreter::PhaseTimes> &repGCMetrics) {
+  std::string report;
+  llvm::raw_string_ostream os(report);
+  ::hermes::JSONEmitter json(os);
+  json.openDict();
+  json.emitKeyValue("reps", repPhases.size());
+  json.emitKey("phases");
+  emitSummaries(json, repPhases);
+  json.emitKey("gc");
+  emitSummaries(json, repGCMetrics);
+  json.emitKeyValue("peakRSS", ::hermes::oscompat::peak_rss());
+  json.closeDict();
+  return os.str();
+}
+
+/// Parse the benchmark report in \p buf.
+/// \throws invalid_argument if it isn't a JSON object.
+JSONObject *parseBenchmarkReport(
+    JSONFactory::Allocator &alloc,
+    std::unique_ptr<llvm::MemoryBuffer> buf) {
+  JSONFactory factory(alloc);
+  ::hermes::SourceErrorManager sm;
+  JSONParser parser(factory, std::move(buf), sm);
+  auto root = parser.parse();
+  if (!root || !llvm::isa<JSONObject>(root.getValue())) {
+    // The source error manager will print to stderr.
+    throw std::invalid_argument("Malformed benchmark report.");
+  }
+  return llvm::cast<JSONObject>(root.getValue());
+}
+
 } // namespace
 
 TraceInterpreter::TraceInterpreter(
@@ -425,7 +527,9 @@ TraceInterpreter::TraceInterpreter(
     const std::unordered_map<ObjectID, TraceInterpreter::DefAndUse>
         &globalDefsAndUses,
     const HostFunctionToCalls &hostFunctionCalls,
-    const HostObjectToCalls &hostObjectCalls)
+    const HostObjectToCalls &hostObjectCalls,
+    PhaseTimes *phases,
+    std::chrono::steady_clock::time_point replayStart)
     : rt(rt),
       options(options),
 #ifdef HERMESVM_API_TRACE
@@ -440,7 +544,9 @@ TraceInterpreter::TraceInterpreter(
       hostFunctionsCallCount(),
       hostObjects(),
       hostObjectsCallCount(),
-      gom() {
+      gom(),
+      phases(phases),
+      replayStart(replayStart) {
 #ifdef HERMESVM_API_TRACE
   assert(writeTrace && "writeTrace must be non-empty");
 #endif
@@ -547,8 +653,11 @@ std::string TraceInterpreter::execFromMemoryBuffer(
   rtConfig = rtConfigBuilder.withGCConfig(gcConfigBuilder.build()).build();
 
   std::vector<std::string> repGCStats(options.reps);
+  std::vector<PhaseTimes> repPhases(options.benchmark ? options.reps : 0);
+  std::vector<PhaseTimes> repGCMetrics(options.benchmark ? options.reps : 0);
   for (int rep = -options.warmupReps; rep < options.reps; ++rep) {
     ::hermes::vm::instrumentation::PerfEvents::begin();
+    auto replayStart = std::chrono::steady_clock::now();
 #ifdef HERMESVM_API_TRACE
     std::unique_ptr<TracingHermesRuntime> rt =
         makeTracingHermesRuntime(makeHermesRuntime(rtConfig), rtConfig);
@@ -563,23 +672,94 @@ std::string TraceInterpreter::execFromMemoryBuffer(
     rt->setMockedEnvironment(std::get<2>(traceAndConfigAndEnv));
     std::function<void()> writeTrace = nullptr;
 #endif
-    auto stats =
-        exec(*rt, options, trace, bufView(codeFileBuffer.get()), writeTrace);
+    PhaseTimes phases;
+    if (options.benchmark) {
+      phases.emplace_back("runtimeInit", msSince(replayStart));
+    }
+    auto stats = exec(
+        *rt,
+        options,
+        trace,
+        bufView(codeFileBuffer.get()),
+        writeTrace,
+        options.benchmark ? &phases : nullptr,
+        replayStart);
+    if (options.benchmark) {
+      phases.emplace_back("total", msSince(replayStart));
+    }
     // If we're not warming up, save the stats.
     if (rep >= 0) {
       repGCStats[rep] = stats;
+      if (options.benchmark) {
+        repPhases[rep] = std::move(phases);
+        repGCMetrics[rep] = getHeapMetrics(*rt);
+      }
     }
   }
+  if (options.benchmark) {
+    return benchmarkReport(repPhases, repGCMetrics);
+  }
   return options.shouldPrintGCStats ? mergeGCStats(repGCStats) : "";
 }
 
+/* static */
+void TraceInterpreter::compareBenchmarks(
+    std::unique_ptr<llvm::MemoryBuffer> baseline,
+    std::unique_ptr<llvm::MemoryBuffer> current,
+    llvm::raw_ostream &os) {
+  JSONFactory::Allocator alloc;
+  JSONObject *before = parseBenchmarkReport(alloc, std::move(baseline));
+  JSONObject *after = parseBenchmarkReport(alloc, std::move(current));
+  os << llvm::left_justify("median", 40) << llvm::right_justify("baseline", 15)
+     << llvm::right_justify("current", 15) << llvm::right_justify("change", 10)
+     << "\n";
+  for (const char *section : {"phases", "gc"}) {
+    auto *beforeSection = llvm::dyn_cast_or_null<JSONObject>(
+        before->get(section));
+    auto *afterSection = llvm::dyn_cast_or_null<JSONObject>(
+        after->get(section));
+    if (!beforeSection || !afterSection) {
+      throw std::invalid_argument("Malformed benchmark report.");
+    }
+    for (auto nameAndSummary : *afterSection) {
+      llvm::StringRef name = nameAndSummary.first->str();
+      auto *afterSummary =
+          llvm::dyn_cast<JSONObject>(nameAndSummary.second);
+      auto *beforeSummary =
+          llvm::dyn_cast_or_null<JSONObject>(beforeSection->get(name));
+      // Phases that only one of the builds reached can't be compared.
+      if (!afterSummary || !beforeSummary) {
+        continue;
+      }
+      auto *afterMedian =
+          llvm::dyn_cast_or_null<JSONNumber>(afterSummary->get("p50"));
+      auto *beforeMedian =
+          llvm::dyn_cast_or_null<JSONNumber>(beforeSummary->get("p50"));
+      if (!afterMedian || !beforeMedian) {
+        throw std::invalid_argument("Malformed benchmark report.");
+      }
+      double from = beforeMedian->getValue();
+      double to = afterMedian->getValue();
+      os << llvm::left_justify(name, 40)
+         << llvm::format(" %14.3f %14.3f", from, to);
+      if (from != 0) {
+        os << llvm::format(" %+8.2f%%\n", (to - from) / from * 100);
+      } else {
+        os << llvm::right_justify("-", 10) << "\n";
+      }
+    }
+  }
+}
+
 /* static */
 std::string TraceInterpreter::exec(
     jsi::Runtime &rt,
     const ExecuteOptions &options,
     const SynthTrace &trace,
     std::unique_ptr<const jsi::Buffer> bundle,
-    std::function<void()> &writeTrace) {
+    std::function<void()> &writeTrace,
+    PhaseTimes *phases,
+    std::chrono::steady_clock::time_point replayStart) {
   if (!HermesRuntime::isHermesBytecode(bundle->data(), bundle->size())) {
     llvm::errs()
         << "Note: You are running from source code, not HBC bytecode.\n"
@@ -607,7 +787,9 @@ std::string TraceInterpreter::exec(
       std::move(bundle),
       globalDefsAndUses,
       hostFuncs,
-      hostObjs);
+      hostObjs,
+      phases,
+      replayStart);
   return interpreter.execEntryFunction(hostFuncs.at(setupFuncID).at(0));
 }
 
@@ -765,11 +947,23 @@ Value TraceInterpreter::execFunction(
     for (const SynthTrace::Record *rec : piece.records) {
       try {
         switch (rec->getType()) {
-          case RecordType::BeginExecJS:
+          case RecordType::BeginExecJS: {
             // Since this is bytecode, there's no sourceURL to pass.
             // overallRetval is to be consumed when we get an EndExecJS record.
-            overallRetval = rt.evaluateJavaScript(std::move(bundle), "");
+            std::string index = std::to_string(numExecJS++);
+            if (!phases) {
+              overallRetval = rt.evaluateJavaScript(std::move(bundle), "");
+              break;
+            }
+            // Time the loading of the bytecode separately from its execution.
+            auto start = std::chrono::steady_clock::now();
+            auto prepared = rt.prepareJavaScript(std::move(bundle), "");
+            endPhase("bytecodeLoad" + index, start);
+            start = std::chrono::steady_clock::now();
+            overallRetval = rt.evaluatePreparedJavaScript(prepared);
+            endPhase("execJS" + index, start);
             break;
+          }
           case RecordType::EndExecJS: {
             const auto &eejsr =
                 dynamic_cast<const SynthTrace::EndExecJSRecord &>(*rec);
@@ -794,6 +988,18 @@ Value TraceInterpreter::execFunction(
           case RecordType::Marker: {
             const auto &mr =
                 dynamic_cast<const SynthTrace::MarkerRecord &>(*rec);
+            // Time the first occurrence of every marker, from the start of
+            // the rep, so that TTI includes the creation of the runtime.
+            std::string phase = "marker:" + mr.tag_;
+            if (phases &&
+                std::find_if(
+                    phases->begin(),
+                    phases->end(),
+                    [&phase](const std::pair<std::string, double> &p) {
+                      return p.first == phase;
+                    }) == phases->end()) {
+              endPhase(std::move(phase), replayStart);
+            }
             // If the tag is the requested tag, and the stats have not already
             // been collected, collect them.
             if (mr.tag_ == options.marker && !markerFound) {
@@ -1167,6 +1373,12 @@ void TraceInterpreter::addObjectToDefs(
       call, objID, globalRecordNum, Value(rt, obj).getObject(rt), locals);
 }
 
+void TraceInterpreter::endPhase(
+    std::string name,
+    std::chrono::steady_clock::time_point start) {
+  phases->emplace_back(std::move(name), msSince(start));
+}
+
 std::string TraceInterpreter::printStats() {
   std::string stats = rt.instrumentation().getRecordedGCStats();
   ::hermes::vm::instrumentation::PerfEvents::endAndInsertStats(stats);
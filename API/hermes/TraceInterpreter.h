@@ -17,6 +17,7 @@
 #include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/raw_ostream.h>
 
+#include <chrono>
 #include <unordered_map>
 #include <vector>
 
@@ -96,6 +97,9 @@ class TraceInterpreter final {
   ///   the young generation.
   /// \param revertToYGAtTTI: if true, and if the GC was not allocating in the
   ///   young generation, change back to young-gen allocation at TTI.
+  /// \param benchmark: if true, time the phases of every rep instead of
+  ///   collecting its GC stats, and return a benchmark report as JSON (see
+  ///   execFromMemoryBuffer).
   struct ExecuteOptions {
     std::string marker;
     int warmupReps{0};
@@ -109,8 +113,13 @@ class TraceInterpreter final {
     uint8_t bytecodeWarmupPercent{0};
     double sanitizeRate{0.0};
     int64_t sanitizeRandomSeed{-1};
+    bool benchmark{false};
   };
 
+  /// The latency of the phases of one rep, in milliseconds, in the order that
+  /// they ended.
+  using PhaseTimes = std::vector<std::pair<std::string, double>>;
+
  private:
   jsi::Runtime &rt;
   ExecuteOptions options;
@@ -140,6 +149,12 @@ class TraceInterpreter final {
   bool markerFound{false};
   /// Depth in the execution stack. Zero is the outermost function.
   uint64_t depth{0};
+  /// If non-null, where the phases of the replay are timed.
+  PhaseTimes *phases;
+  /// When the replay started, including the creation of the runtime.
+  std::chrono::steady_clock::time_point replayStart;
+  /// The number of BeginExecJS records seen so far.
+  unsigned numExecJS{0};
 
  public:
   /// Execute the trace given by \p traceFile, that was the trace of executing
@@ -165,12 +180,29 @@ class TraceInterpreter final {
       const ExecuteOptions &options,
       llvm::raw_ostream &outTrace);
 
+  /// Execute the trace in \p traceBuf against the code in \p codeBuf.
+  /// \return the GC stats of the median rep, or with options.benchmark, a
+  ///   JSON report of the whole run: the min, percentiles, max and mean over
+  ///   the reps of the latency of every phase and of every GC metric, and
+  ///   the peak RSS of the process.  The phases are the creation of the
+  ///   runtime, the loading of the bytecode and the execution of every
+  ///   BeginExecJS record, the time from the start of the rep to the first
+  ///   occurrence of every marker, and the whole rep.
   static std::string execFromMemoryBuffer(
       std::unique_ptr<llvm::MemoryBuffer> traceBuf,
       std::unique_ptr<llvm::MemoryBuffer> codeBuf,
       const ExecuteOptions &options,
       llvm::raw_ostream &outTrace);
 
+  /// Compare the median of every phase and GC metric in the benchmark report
+  /// \p current with the one in \p baseline, typically produced by another
+  ///   build, and print a table of the differences to \p os.
+  /// \throws invalid_argument if either report is malformed.
+  static void compareBenchmarks(
+      std::unique_ptr<llvm::MemoryBuffer> baseline,
+      std::unique_ptr<llvm::MemoryBuffer> current,
+      llvm::raw_ostream &os);
+
  private:
   TraceInterpreter(
       jsi::Runtime &rt,
@@ -181,7 +213,9 @@ class TraceInterpreter final {
       const std::unordered_map<SynthTrace::ObjectID, DefAndUse>
           &globalDefsAndUses,
       const HostFunctionToCalls &hostFunctionCalls,
-      const HostObjectToCalls &hostObjectCalls);
+      const HostObjectToCalls &hostObjectCalls,
+      PhaseTimes *phases,
+      std::chrono::steady_clock::time_point replayStart);
 
   static std::string execFromFileNames(
       const std::string &traceFile,
@@ -194,7 +228,10 @@ class TraceInterpreter final {
       const ExecuteOptions &options,
       const SynthTrace &trace,
       std::unique_ptr<const jsi::Buffer> bundle,
-      std::function<void()> &writeTrace);
+      std::function<void()> &writeTrace,
+      PhaseTimes *phases = nullptr,
+      std::chrono::steady_clock::time_point replayStart =
+          std::chrono::steady_clock::now());
 
   jsi::Function createHostFunction(
       SynthTrace::ObjectID funcID,
@@ -231,6 +268,11 @@ class TraceInterpreter final {
       std::unordered_map<SynthTrace::ObjectID, jsi::Object> &locals);
 
   std::string printStats();
+
+  /// Record that the phase \p name ended now, having started at \p start.
+  void endPhase(
+      std::string name,
+      std::chrono::steady_clock::time_point start);
 };
 
 } // namespace tracing
@@ -361,11 +361,42 @@ TracingHermesRuntime::TracingHermesRuntime(
     const ::hermes::vm::RuntimeConfig &runtimeConfig)
     : TracingRuntime(std::move(runtime), globalID), conf_(runtimeConfig) {}
 
+TracingHermesRuntime::~TracingHermesRuntime() {
+  if (binaryWriter_) {
+    binaryWriter_->finish(hermesRuntime().getMockedEnvironment());
+    trace().setBinaryWriter(nullptr);
+  }
+}
+
 void TracingHermesRuntime::writeTrace(llvm::raw_ostream &os) const {
+  if (binaryWriter_) {
+    throw std::logic_error("The trace is streamed, it can't be written");
+  }
   os << SynthTrace::Printable(
       trace(), hermesRuntime().getMockedEnvironment(), conf_);
 }
 
+void TracingHermesRuntime::writeBinaryTrace(llvm::raw_ostream &os) const {
+  if (binaryWriter_) {
+    throw std::logic_error("The trace is streamed, it can't be written");
+  }
+  SynthTrace::BinaryWriter::writeTrace(
+      os,
+      SynthTrace::Printable(
+          trace(), hermesRuntime().getMockedEnvironment(), conf_));
+}
+
+void TracingHermesRuntime::streamBinaryTrace(
+    std::unique_ptr<llvm::raw_ostream> os) {
+  if (binaryWriter_ || !trace().records().empty()) {
+    throw std::logic_error("Streaming must start before anything is traced");
+  }
+  traceStream_ = std::move(os);
+  binaryWriter_ =
+      std::make_unique<SynthTrace::BinaryWriter>(*traceStream_, trace(), conf_);
+  trace().setBinaryWriter(binaryWriter_.get());
+}
+
 void TracingHermesRuntime::writeBridgeTrafficTraceToFile(
     const std::string &fileName) const {
   std::error_code ec;
@@ -122,12 +122,23 @@ class TracingHermesRuntime final : public TracingRuntime {
       std::unique_ptr<HermesRuntime> runtime,
       const ::hermes::vm::RuntimeConfig &runtimeConfig);
 
+  ~TracingHermesRuntime() override;
+
   SynthTrace::ObjectID getUniqueID(const jsi::Object &o) override {
     return static_cast<SynthTrace::ObjectID>(hermesRuntime().getUniqueID(o));
   }
 
   void writeTrace(llvm::raw_ostream &os) const override;
 
+  /// Write the trace recorded so far to \p os in the binary format.
+  void writeBinaryTrace(llvm::raw_ostream &os) const;
+
+  /// Stream the trace to \p os in the binary format while it is recorded,
+  /// instead of keeping it in memory, which makes tracing long runs cheap.
+  /// The trace is finished when the runtime is destroyed.  Must be called
+  /// before anything is traced; writeTrace can't be used afterwards.
+  void streamBinaryTrace(std::unique_ptr<llvm::raw_ostream> os);
+
   void writeBridgeTrafficTraceToFile(
       const std::string &fileName) const override;
 
@@ -157,6 +168,9 @@ class TracingHermesRuntime final : public TracingRuntime {
       const ::hermes::vm::RuntimeConfig &runtimeConfig);
 
   const ::hermes::vm::RuntimeConfig conf_;
+  /// If the trace is streamed, where to, and its writer.
+  std::unique_ptr<llvm::raw_ostream> traceStream_;
+  std::unique_ptr<SynthTrace::BinaryWriter> binaryWriter_;
 };
 
 std::unique_ptr<TracingHermesRuntime> makeTracingHermesRuntime(
@@ -24,6 +24,8 @@
 #include "hermes/Platform/Logging.h"
 #include "hermes/Public/RuntimeConfig.h"
 #include "hermes/Support/Algorithms.h"
+#include "hermes/Support/OSCompat.h"
+#include "hermes/Support/CallbackOStream.h"
 #include "hermes/Support/UTF8.h"
 #include "hermes/VM/CallResult.h"
 #include "hermes/VM/Debugger/Debugger.h"
@@ -39,23 +41,27 @@
 #include "hermes/VM/Runtime.h"
 #include "hermes/VM/StringPrimitive.h"
 #include "hermes/VM/StringView.h"
+#include "hermes/VM/StructuredClone.h"
 
+#include "llvm/ADT/Hashing.h"
 #include "llvm/Support/ConvertUTF.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/SHA1.h"
 #include "llvm/Support/raw_os_ostream.h"
 
+#include <array>
 #include <atomic>
+#include <future>
 #include <limits>
 #include <list>
 #include <mutex>
 #include <system_error>
-
-#ifdef HERMESJSI_ON_STACK
-#include <future>
 #include <thread>
-#endif
 
 #include <jsi/instrumentation.h>
 #include <jsi/threadsafe.h>
@@ -303,6 +309,8 @@ class HermesRuntimeImpl final : public HermesRuntime,
           ++it;
         }
       }
+      for (auto &entry : objectClassCache_)
+        acceptor.accept(entry.clazz);
     });
   }
 
@@ -732,6 +740,62 @@ class HermesRuntimeImpl final : public HermesRuntime,
   ScopeState *pushScope() override;
   void popScope(ScopeState *prv) override;
 
+  // Strings without copies, see HermesRuntime.
+  jsi::String createExternalString(std::string &&utf8);
+  jsi::String createExternalString(std::u16string &&utf16);
+  void getStringData(
+      const jsi::String &str,
+      void *ctx,
+      void (*cb)(void *ctx, bool ascii, const void *data, size_t num));
+  jsi::ArrayBuffer createExternalArrayBuffer(
+      uint8_t *data,
+      size_t size,
+      std::function<void()> release);
+
+  // Bulk property access, see HermesRuntime.
+  jsi::Object createObjectWithCapacity(size_t propertyCount);
+  jsi::Array createArrayWithElements(const jsi::Value *values, size_t count);
+  jsi::Object createObjectWithProperties(
+      const jsi::PropNameID *names,
+      const jsi::Value *values,
+      size_t count);
+  void getProperties(
+      const jsi::Object &obj,
+      const jsi::PropNameID *names,
+      jsi::Value *values,
+      size_t count);
+  void setProperties(
+      jsi::Object &obj,
+      const jsi::PropNameID *names,
+      const jsi::Value *values,
+      size_t count);
+
+  /// Compile or load \p buffer, using the code cache in \p codeCacheDir
+  /// unless it is empty.  This doesn't touch any runtime, so it can be called
+  /// on any thread.
+  static std::shared_ptr<const jsi::PreparedJavaScript> prepare(
+      const std::shared_ptr<const jsi::Buffer> &buffer,
+      std::string sourceURL,
+      const std::string &codeCacheDir);
+
+#ifndef HERMESVM_LEAN
+  /// Compile \p source with \p compileFlags through the code cache: map the
+  /// bytecode of an earlier compilation from \p codeCacheDir if there is one,
+  /// or compile it and add it to the cache.
+  static std::pair<std::unique_ptr<hbc::BCProvider>, std::string>
+  compileWithCodeCache(
+      std::unique_ptr<::hermes::Buffer> source,
+      const std::string &sourceURL,
+      hbc::CompileFlags compileFlags,
+      const std::string &codeCacheDir);
+#endif
+
+  // Structured clone, see HermesRuntime.
+  std::shared_ptr<vm::SerializedValue> serialize(
+      const jsi::Value &value,
+      const jsi::Value &transfer);
+  jsi::Value deserialize(vm::SerializedValue &value);
+
   void checkStatus(vm::ExecutionStatus);
   vm::HermesValue stringHVFromAscii(const char *ascii, size_t length);
   vm::HermesValue stringHVFromUtf8(const uint8_t *utf8, size_t length);
@@ -969,6 +1033,22 @@ class HermesRuntimeImpl final : public HermesRuntime,
   std::unique_ptr<debugger::Debugger> debugger_;
 #endif
   std::shared_ptr<vm::CrashManager> crashMgr_;
+
+  /// The hidden class of an object created by createObjectWithProperties(),
+  /// with the names of its properties in slot order.
+  struct ObjectClassCacheEntry {
+    std::vector<vm::SymbolID> names;
+    vm::PinnedHermesValue clazz{vm::HermesValue::encodeUndefinedValue()};
+  };
+  static constexpr size_t kObjectClassCacheSize = 32;
+  /// Direct-mapped by a hash of the names, so that objects created again with
+  /// the same names get their class without a lookup per property.  The
+  /// classes are roots, which also keeps the SymbolIDs of the names alive.
+  std::array<ObjectClassCacheEntry, kObjectClassCacheSize> objectClassCache_;
+
+  /// Where the bytecode compiled from source is cached, if anywhere.  See
+  /// HermesRuntime::setCodeCacheDirectory().
+  std::string codeCacheDir_;
 };
 
 namespace {
@@ -1007,6 +1087,86 @@ bool HermesRuntime::hermesBytecodeSanityCheck(
       llvm::ArrayRef<uint8_t>(data, len), errorMessage);
 }
 
+std::shared_ptr<const jsi::PreparedJavaScript>
+HermesRuntime::prepareJavaScriptOnAnyThread(
+    const std::shared_ptr<const jsi::Buffer> &buffer,
+    std::string sourceURL,
+    const std::string &codeCacheDir) {
+  // Nobody waits for this, so the bytecode can be checked thoroughly.
+  std::string error;
+  if (isHermesBytecode(buffer->data(), buffer->size()) &&
+      !hermesBytecodeSanityCheck(buffer->data(), buffer->size(), &error)) {
+    throw jsi::JSINativeException(std::move(error));
+  }
+  return HermesRuntimeImpl::prepare(
+      buffer, std::move(sourceURL), codeCacheDir);
+}
+
+std::future<std::shared_ptr<const jsi::PreparedJavaScript>>
+HermesRuntime::prepareJavaScriptAsync(
+    std::shared_ptr<const jsi::Buffer> buffer,
+    std::string sourceURL,
+    std::string codeCacheDir) {
+  return std::async(
+      std::launch::async,
+      [buffer = std::move(buffer),
+       sourceURL = std::move(sourceURL),
+       codeCacheDir = std::move(codeCacheDir)]() mutable {
+        return prepareJavaScriptOnAnyThread(
+            buffer, std::move(sourceURL), codeCacheDir);
+      });
+}
+
+namespace {
+/// A jsi::Buffer that owns an llvm::MemoryBuffer, which may be mapped.
+class LLVMMemoryBufferAdapter final : public jsi::Buffer {
+ public:
+  LLVMMemoryBufferAdapter(std::unique_ptr<llvm::MemoryBuffer> buf)
+      : buf_(std::move(buf)) {}
+
+  size_t size() const override {
+    return buf_->getBufferSize();
+  }
+  const uint8_t *data() const override {
+    return reinterpret_cast<const uint8_t *>(buf_->getBufferStart());
+  }
+
+ private:
+  std::unique_ptr<llvm::MemoryBuffer> buf_;
+};
+} // namespace
+
+std::unique_ptr<const jsi::Buffer> HermesRuntime::mapHermesBytecode(
+    int fd,
+    size_t offset,
+    size_t len,
+    std::string *errorMessage) {
+  // The sections of the bytecode are 4 byte aligned relative to its start.
+  if (offset % 4 != 0) {
+    if (errorMessage) {
+      *errorMessage = "Bytecode offset is not 4 byte aligned";
+    }
+    return nullptr;
+  }
+  // The mapping starts at the page containing offset.  Small slices may be
+  // read instead.
+  auto bufOrErr = llvm::MemoryBuffer::getOpenFileSlice(fd, "", len, offset);
+  if (!bufOrErr) {
+    if (errorMessage) {
+      *errorMessage = bufOrErr.getError().message();
+    }
+    return nullptr;
+  }
+  auto buffer = std::make_unique<LLVMMemoryBufferAdapter>(std::move(*bufOrErr));
+  // Only the header is checked, to avoid touching the rest of the mapping.
+  if (!hbc::BCProviderFromBuffer::bytecodeStreamSanityCheck(
+          llvm::ArrayRef<uint8_t>(buffer->data(), buffer->size()),
+          errorMessage)) {
+    return nullptr;
+  }
+  return std::move(buffer);
+}
+
 std::pair<const uint8_t *, size_t> HermesRuntime::getBytecodeEpilogue(
     const uint8_t *data,
     size_t len) {
@@ -1015,8 +1175,8 @@ std::pair<const uint8_t *, size_t> HermesRuntime::getBytecodeEpilogue(
   return std::make_pair(epi.data(), epi.size());
 }
 
-void HermesRuntime::enableSamplingProfiler() {
-  ::hermes::vm::SamplingProfiler::getInstance()->enable();
+void HermesRuntime::enableSamplingProfiler(bool capturePerfCounters) {
+  ::hermes::vm::SamplingProfiler::getInstance()->enable(capturePerfCounters);
 }
 
 void HermesRuntime::disableSamplingProfiler() {
@@ -1032,6 +1192,22 @@ void HermesRuntime::dumpSampledTraceToFile(const std::string &fileName) {
   ::hermes::vm::SamplingProfiler::getInstance()->dumpChromeTrace(os);
 }
 
+void HermesRuntime::dumpSampledPerfCountersToFile(const std::string &fileName) {
+  std::error_code ec;
+  llvm::raw_fd_ostream os(fileName.c_str(), ec, llvm::sys::fs::F_Text);
+  if (ec) {
+    throw std::system_error(ec);
+  }
+  ::hermes::vm::SamplingProfiler::getInstance()->dumpPerfCounters(os);
+}
+
+void HermesRuntime::setSampledTraceChunkCallback(
+    std::function<void(std::string)> callback,
+    std::chrono::milliseconds interval) {
+  ::hermes::vm::SamplingProfiler::getInstance()->setChromeTraceChunkCallback(
+      std::move(callback), interval);
+}
+
 void HermesRuntime::setFatalHandler(void (*handler)(const std::string &)) {
   detail::sApiFatalHandler = handler;
 }
@@ -1071,11 +1247,200 @@ void HermesRuntime::loadSegment(
       std::move(ret.first), requireContext, flags));
 }
 
+void HermesRuntime::setSegmentLoader(
+    std::function<std::unique_ptr<const jsi::Buffer>(uint32_t moduleID)>
+        loader) {
+  vm::RuntimeModuleFlags flags;
+  flags.persistent = true;
+  impl(this)->runtime_.setSegmentLoader(
+      [loader](uint32_t moduleID) -> std::shared_ptr<hbc::BCProvider> {
+        auto buffer = loader(moduleID);
+        if (!buffer) {
+          return nullptr;
+        }
+        // Bytecode that cannot be deserialized is treated as a missing
+        // segment, since this is called from the interpreter.
+        return hbc::BCProviderFromBuffer::createBCProviderFromBuffer(
+                   std::make_unique<BufferAdapter>(std::move(buffer)))
+            .first;
+      },
+      flags);
+}
+
 uint64_t HermesRuntime::getUniqueID(const jsi::Object &o) const {
   return static_cast<vm::GCCell *>(impl(this)->phv(o).getObject())
       ->getDebugAllocationId();
 }
 
+bool HermesRuntime::collectIncrementally(
+    std::chrono::steady_clock::time_point deadline) {
+  return impl(this)->runtime_.collectIncrementally(deadline);
+}
+
+void HermesRuntime::handleMemoryPressure(
+    ::hermes::vm::MemoryPressure pressure) {
+  impl(this)->runtime_.handleMemoryPressure(pressure);
+}
+
+void HermesRuntime::drainMicrotasks() {
+  vm::GCScope gcScope(&impl(this)->runtime_);
+  impl(this)->checkStatus(impl(this)->runtime_.drainJobs());
+}
+
+void HermesRuntime::saveResetPoint() {
+  impl(this)->runtime_.saveResetPoint();
+}
+
+void HermesRuntime::resetToSavedPoint() {
+  vm::GCScope gcScope(&impl(this)->runtime_);
+  impl(this)->checkStatus(impl(this)->runtime_.resetToSavedPoint());
+}
+
+jsi::String HermesRuntime::createExternalString(std::string &&utf8) {
+  return impl(this)->createExternalString(std::move(utf8));
+}
+
+jsi::String HermesRuntime::createExternalString(std::u16string &&utf16) {
+  return impl(this)->createExternalString(std::move(utf16));
+}
+
+void HermesRuntime::getStringData(
+    const jsi::String &str,
+    void *ctx,
+    void (*cb)(void *ctx, bool ascii, const void *data, size_t num)) {
+  impl(this)->getStringData(str, ctx, cb);
+}
+
+jsi::ArrayBuffer HermesRuntime::createExternalArrayBuffer(
+    uint8_t *data,
+    size_t size,
+    std::function<void()> release) {
+  return impl(this)->createExternalArrayBuffer(
+      data, size, std::move(release));
+}
+
+uint32_t HermesRuntime::getPropNameIDKey(const jsi::PropNameID &name) {
+  return HermesRuntimeImpl::phv(name).getSymbol().unsafeGetRaw();
+}
+
+void HermesRuntime::setCodeCacheDirectory(const std::string &dir) {
+  impl(this)->codeCacheDir_ = dir;
+}
+
+jsi::Object HermesRuntime::createObjectWithCapacity(size_t propertyCount) {
+  return impl(this)->createObjectWithCapacity(propertyCount);
+}
+
+jsi::Array HermesRuntime::createArrayWithElements(
+    const jsi::Value *values,
+    size_t count) {
+  return impl(this)->createArrayWithElements(values, count);
+}
+
+jsi::Object HermesRuntime::createObjectWithProperties(
+    const jsi::PropNameID *names,
+    const jsi::Value *values,
+    size_t count) {
+  return impl(this)->createObjectWithProperties(names, values, count);
+}
+
+void HermesRuntime::getProperties(
+    const jsi::Object &obj,
+    const jsi::PropNameID *names,
+    jsi::Value *values,
+    size_t count) {
+  impl(this)->getProperties(obj, names, values, count);
+}
+
+void HermesRuntime::setProperties(
+    jsi::Object &obj,
+    const jsi::PropNameID *names,
+    const jsi::Value *values,
+    size_t count) {
+  impl(this)->setProperties(obj, names, values, count);
+}
+
+std::shared_ptr<vm::SerializedValue> HermesRuntime::serialize(
+    const jsi::Value &value) {
+  return impl(this)->serialize(value, jsi::Value());
+}
+
+std::shared_ptr<vm::SerializedValue> HermesRuntime::serialize(
+    const jsi::Value &value,
+    const jsi::Array &transfer) {
+  return impl(this)->serialize(
+      value, jsi::Value(*this, static_cast<const jsi::Object &>(transfer)));
+}
+
+jsi::Value HermesRuntime::deserialize(
+    const std::shared_ptr<vm::SerializedValue> &value) {
+  return impl(this)->deserialize(*value);
+}
+
+void HermesRuntime::enableSamplingHeapProfiler(size_t samplingInterval) {
+  impl(this)->runtime_.enableSamplingHeapProfiler(samplingInterval);
+}
+
+void HermesRuntime::disableSamplingHeapProfiler(std::ostream &os) {
+  llvm::raw_os_ostream ros(os);
+  impl(this)->runtime_.disableSamplingHeapProfiler(ros);
+}
+
+void HermesRuntime::enableFunctionProfiler(
+    std::chrono::microseconds samplingInterval,
+    bool attributeTime) {
+  impl(this)->runtime_.enableFunctionProfiler(samplingInterval, attributeTime);
+}
+
+void HermesRuntime::disableFunctionProfiler() {
+  impl(this)->runtime_.disableFunctionProfiler();
+}
+
+void HermesRuntime::dumpFunctionProfile(std::ostream &os) {
+  llvm::raw_os_ostream ros(os);
+  impl(this)->runtime_.dumpFunctionProfile(ros);
+}
+
+std::string HermesRuntime::getInstrumentedStats() {
+  std::string s;
+  llvm::raw_string_ostream os(s);
+  os << "{\"startup\": ";
+  impl(this)->runtime_.getRuntimeStats().printStartupStats(os);
+  os << ", \"gcTelemetry\": ";
+  impl(this)->runtime_.getHeap().printTelemetry(os);
+  os << "}";
+  return os.str();
+}
+
+void HermesRuntime::enableCodeCoverage() {
+  impl(this)->runtime_.enableCodeCoverage();
+}
+
+void HermesRuntime::disableCodeCoverage() {
+  impl(this)->runtime_.disableCodeCoverage();
+}
+
+void HermesRuntime::dumpCodeCoverage(std::ostream &os) {
+  llvm::raw_os_ostream ros(os);
+  impl(this)->runtime_.dumpCodeCoverage(ros);
+}
+
+bool HermesRuntime::createSnapshotToFileDescriptor(int fd, bool compact) {
+  vm::GC &gc = impl(this)->runtime_.getHeap();
+  gc.collect();
+  return gc.createSnapshotToFileDescriptor(fd, compact);
+}
+
+void HermesRuntime::createSnapshotToCallback(
+    const std::function<void(const char *data, size_t size)> &callback,
+    bool compact,
+    size_t chunkSize) {
+  vm::GC &gc = impl(this)->runtime_.getHeap();
+  gc.collect();
+  ::hermes::CallbackOStream os(callback, chunkSize);
+  gc.createSnapshot(os, compact);
+}
+
 #ifdef HERMESVM_API_TRACE
 /// Get a structure representing the enviroment-dependent behavior, so
 /// it can be written into the trace for later replay.
@@ -1175,8 +1540,19 @@ class HermesPreparedJavaScript final : public jsi::PreparedJavaScript {
 
 std::shared_ptr<const jsi::PreparedJavaScript>
 HermesRuntimeImpl::prepareJavaScript(
-    const std::shared_ptr<const jsi::Buffer> &jsiBuffer,
+    const std::shared_ptr<const jsi::Buffer> &buffer,
     std::string sourceURL) {
+  // Mapping bytecode is part of startup, unlike compiling source.
+  llvm::Optional<vm::instrumentation::StartupTimer> timer;
+  if (isHermesBytecode(buffer->data(), buffer->size()))
+    timer.emplace(&runtime_.getRuntimeStats().startup.bytecodeMapping);
+  return prepare(buffer, std::move(sourceURL), codeCacheDir_);
+}
+
+std::shared_ptr<const jsi::PreparedJavaScript> HermesRuntimeImpl::prepare(
+    const std::shared_ptr<const jsi::Buffer> &jsiBuffer,
+    std::string sourceURL,
+    const std::string &codeCacheDir) {
   std::pair<std::unique_ptr<hbc::BCProvider>, std::string> bcErr{};
   auto buffer = std::make_unique<BufferAdapter>(std::move(jsiBuffer));
   vm::RuntimeModuleFlags runtimeFlags{};
@@ -1202,8 +1578,11 @@ HermesRuntimeImpl::prepareJavaScript(
 #if defined(HERMESVM_LEAN)
     bcErr.second = "prepareJavaScript source compilation not supported";
 #else
-    bcErr = hbc::BCProviderFromSrc::createBCProviderFromSrc(
-        std::move(buffer), sourceURL, compileFlags);
+    bcErr = codeCacheDir.empty()
+        ? hbc::BCProviderFromSrc::createBCProviderFromSrc(
+              std::move(buffer), sourceURL, compileFlags)
+        : compileWithCodeCache(
+              std::move(buffer), sourceURL, compileFlags, codeCacheDir);
 #endif
   }
   if (!bcErr.first) {
@@ -1213,6 +1592,99 @@ HermesRuntimeImpl::prepareJavaScript(
       std::move(bcErr.first), runtimeFlags, std::move(sourceURL));
 }
 
+#ifndef HERMESVM_LEAN
+std::pair<std::unique_ptr<hbc::BCProvider>, std::string>
+HermesRuntimeImpl::compileWithCodeCache(
+    std::unique_ptr<::hermes::Buffer> source,
+    const std::string &sourceURL,
+    hbc::CompileFlags compileFlags,
+    const std::string &codeCacheDir) {
+  // Lazily compiled functions can't be serialized, so the whole source is
+  // compiled up front, once.
+  compileFlags.lazy = false;
+  const ::hermes::SHA1 sourceHash = llvm::SHA1::hash(
+      llvm::ArrayRef<uint8_t>(source->data(), source->size()));
+
+  // The key covers everything the bytecode depends on.
+  llvm::SHA1 hasher;
+  auto update = [&hasher](llvm::StringRef str) {
+    hasher.update(str);
+    // Separate the strings so that their boundaries are part of the key.
+    hasher.update(llvm::StringRef("", 1));
+  };
+#ifdef HERMES_RELEASE_VERSION
+  update(HERMES_RELEASE_VERSION);
+#endif
+  update(::hermes::oscompat::to_string(hbc::BYTECODE_VERSION));
+  const char flags[] = {
+      compileFlags.optimize, compileFlags.debug, compileFlags.strict};
+  update(llvm::StringRef(flags, sizeof(flags)));
+  update(sourceURL);
+  hasher.update(sourceHash);
+  std::string key;
+  llvm::raw_string_ostream keyOS{key};
+  for (unsigned char c : hasher.final()) {
+    keyOS << llvm::format_hex_no_prefix(c, 2);
+  }
+  llvm::SmallString<64> path{codeCacheDir};
+  llvm::sys::path::append(path, keyOS.str() + ".hbc");
+
+  // On a hit, the bytecode is mapped rather than read.
+  int fd;
+  uint64_t size;
+  if (!llvm::sys::fs::file_size(path, size) &&
+      !llvm::sys::fs::openFileForRead(path, fd)) {
+    auto mapped = mapHermesBytecode(fd, 0, size);
+    llvm::sys::Process::SafelyCloseFileDescriptor(fd);
+    if (mapped) {
+      auto ret = hbc::BCProviderFromBuffer::createBCProviderFromBuffer(
+          std::make_unique<BufferAdapter>(std::move(mapped)));
+      if (ret.first) {
+        return {std::move(ret.first), std::string()};
+      }
+    }
+  }
+
+  auto ret = hbc::BCProviderFromSrc::createBCProviderFromSrc(
+      std::move(source), sourceURL, compileFlags);
+  if (!ret.first) {
+    return {nullptr, std::move(ret.second)};
+  }
+  auto bytecode = std::make_shared<jsi::StringBuffer>([&] {
+    std::string bytes;
+    llvm::raw_string_ostream os(bytes);
+    ::hermes::BytecodeGenerationOptions opts(::hermes::EmitBundle);
+    opts.optimizationEnabled = compileFlags.optimize;
+    hbc::BytecodeSerializer{os, opts}.serialize(
+        *static_cast<hbc::BCProviderFromSrc *>(ret.first.get())
+             ->getBytecodeModule(),
+        sourceHash);
+    os.flush();
+    return bytes;
+  }());
+
+  // Write to a temporary file first, so that a runtime reading the cache
+  // concurrently never sees a partial file.  Failing to add to the cache is
+  // not an error.
+  llvm::SmallString<64> tmpPath;
+  if (!llvm::sys::fs::create_directories(codeCacheDir) &&
+      !llvm::sys::fs::createUniqueFile(path + "-%%%%%%%%", fd, tmpPath)) {
+    {
+      llvm::raw_fd_ostream os(fd, /* shouldClose */ true);
+      os.write(
+          reinterpret_cast<const char *>(bytecode->data()), bytecode->size());
+    }
+    if (llvm::sys::fs::rename(tmpPath, path)) {
+      llvm::sys::fs::remove(tmpPath);
+    }
+  }
+
+  // Run the serialized bytecode, like later runs will.
+  return hbc::BCProviderFromBuffer::createBCProviderFromBuffer(
+      std::make_unique<BufferAdapter>(std::move(bytecode)));
+}
+#endif
+
 jsi::Value HermesRuntimeImpl::evaluatePreparedJavaScript(
     const std::shared_ptr<const jsi::PreparedJavaScript> &js) {
   return maybeRethrow([&] {
@@ -1351,6 +1823,9 @@ std::string toStdString(
     vm::Runtime *runtime,
     vm::Handle<vm::StringPrimitive> handle) {
   auto view = vm::StringPrimitive::createStringView(runtime, handle);
+  // ASCII is valid UTF-8, so it is returned as is.
+  if (view.isASCII())
+    return std::string(view.castToCharPtr(), view.length());
   vm::SmallU16String<32> allocator;
   std::string ret;
   ::hermes::convertUTF16ToUTF8WithReplacements(
@@ -1395,6 +1870,79 @@ jsi::String HermesRuntimeImpl::createStringFromUtf8(
   });
 }
 
+jsi::String HermesRuntimeImpl::createExternalString(std::string &&utf8) {
+  return maybeRethrow([&] {
+    vm::GCScope gcScope(&runtime_);
+    if (!::hermes::isAllASCII(utf8.data(), utf8.data() + utf8.size())) {
+      return add<jsi::String>(stringHVFromUtf8(
+          reinterpret_cast<const uint8_t *>(utf8.data()), utf8.size()));
+    }
+    auto strRes =
+        vm::StringPrimitive::createEfficient(&runtime_, std::move(utf8));
+    checkStatus(strRes.getStatus());
+    return add<jsi::String>(*strRes);
+  });
+}
+
+jsi::String HermesRuntimeImpl::createExternalString(std::u16string &&utf16) {
+  return maybeRethrow([&] {
+    vm::GCScope gcScope(&runtime_);
+    auto strRes =
+        vm::StringPrimitive::createEfficient(&runtime_, std::move(utf16));
+    checkStatus(strRes.getStatus());
+    return add<jsi::String>(*strRes);
+  });
+}
+
+void HermesRuntimeImpl::getStringData(
+    const jsi::String &str,
+    void *ctx,
+    void (*cb)(void *ctx, bool ascii, const void *data, size_t num)) {
+  // Every kind of string has contiguous characters, which don't move until
+  // the next allocation.
+  const vm::StringPrimitive *prim = phv(str).getString();
+  if (prim->isASCII()) {
+    auto ref = prim->getStringRef<char>();
+    cb(ctx, true, ref.data(), ref.size());
+  } else {
+    auto ref = prim->getStringRef<char16_t>();
+    cb(ctx, false, ref.data(), ref.size());
+  }
+}
+
+jsi::ArrayBuffer HermesRuntimeImpl::createExternalArrayBuffer(
+    uint8_t *data,
+    size_t size,
+    std::function<void()> release) {
+  // The VM only keeps a plain function pointer and a context, so the
+  // std::function lives on the heap until it has been called.
+  auto *context = new std::function<void()>(std::move(release));
+  auto releaseTrampoline = [](void *ctx, char *) {
+    auto *fn = static_cast<std::function<void()> *>(ctx);
+    if (*fn)
+      (*fn)();
+    delete fn;
+  };
+  return maybeRethrow([&] {
+    vm::GCScope gcScope(&runtime_);
+    auto bufRes = vm::JSArrayBuffer::create(
+        &runtime_,
+        vm::Handle<vm::JSObject>::vmcast(&runtime_.arrayBufferPrototype));
+    if (LLVM_UNLIKELY(bufRes == vm::ExecutionStatus::EXCEPTION)) {
+      releaseTrampoline(context, nullptr);
+      checkStatus(vm::ExecutionStatus::EXCEPTION);
+    }
+    auto buf = runtime_.makeHandle<vm::JSArrayBuffer>(*bufRes);
+    checkStatus(buf->setExternalDataBlock(
+        &runtime_,
+        reinterpret_cast<char *>(data),
+        size,
+        context,
+        releaseTrampoline));
+    return add<jsi::Object>(buf.getHermesValue()).getArrayBuffer(*this);
+  });
+}
+
 std::string HermesRuntimeImpl::utf8(const jsi::String &str) {
   vm::GCScope gcScope(&runtime_);
   return maybeRethrow([&] {
@@ -1512,6 +2060,167 @@ void HermesRuntimeImpl::setPropertyValue(
   });
 }
 
+jsi::Object HermesRuntimeImpl::createObjectWithCapacity(
+    size_t propertyCount) {
+  return maybeRethrow([&] {
+    vm::GCScope gcScope(&runtime_);
+    auto obj = vm::toHandle(&runtime_, vm::JSObject::create(&runtime_));
+    if (propertyCount > vm::PropStorage::maxElements()) {
+      checkStatus(runtime_.raiseRangeError("Too many properties"));
+    }
+    checkStatus(vm::JSObject::allocatePropStorage(
+        obj,
+        &runtime_,
+        static_cast<vm::PropStorage::size_type>(propertyCount)));
+    return add<jsi::Object>(obj.getHermesValue());
+  });
+}
+
+jsi::Array HermesRuntimeImpl::createArrayWithElements(
+    const jsi::Value *values,
+    size_t count) {
+  return maybeRethrow([&] {
+    vm::GCScope gcScope(&runtime_);
+    if (count > vm::JSArray::StorageType::maxElements()) {
+      checkStatus(runtime_.raiseRangeError("Too many elements"));
+    }
+    auto size = static_cast<vm::JSArray::size_type>(count);
+    auto arrRes = vm::JSArray::create(&runtime_, size, size);
+    checkStatus(arrRes.getStatus());
+    auto arr = vm::toHandle(&runtime_, std::move(*arrRes));
+    checkStatus(vm::JSArray::setStorageEndIndex(arr, &runtime_, size));
+    // The array is new and hasn't been seen by JS, so the elements can be
+    // stored directly.
+    for (vm::JSArray::size_type i = 0; i < size; ++i) {
+      vm::JSArray::unsafeSetExistingElementAt(
+          *arr, &runtime_, i, hvFromValue(values[i]));
+    }
+    return add<jsi::Object>(arr.getHermesValue()).getArray(*this);
+  });
+}
+
+jsi::Object HermesRuntimeImpl::createObjectWithProperties(
+    const jsi::PropNameID *names,
+    const jsi::Value *values,
+    size_t count) {
+  return maybeRethrow([&] {
+    vm::GCScope gcScope(&runtime_);
+    llvm::hash_code hash = llvm::hash_value(count);
+    for (size_t i = 0; i < count; ++i)
+      hash = llvm::hash_combine(hash, phv(names[i]).getSymbol().unsafeGetRaw());
+    ObjectClassCacheEntry &entry =
+        objectClassCache_[static_cast<size_t>(hash) % kObjectClassCacheSize];
+
+    if (entry.clazz.isObject() && entry.names.size() == count &&
+        std::equal(
+            entry.names.begin(),
+            entry.names.end(),
+            names,
+            [this](vm::SymbolID id, const jsi::PropNameID &name) {
+              return id == phv(name).getSymbol();
+            })) {
+      // The properties are in slots 0 to count - 1, in order.
+      auto obj = vm::toHandle(
+          &runtime_,
+          vm::JSObject::create(
+              &runtime_,
+              runtime_.makeHandle(vm::vmcast<vm::HiddenClass>(entry.clazz))));
+      for (size_t i = 0; i < count; ++i) {
+        vm::JSObject::setNamedSlotValue(
+            *obj, &runtime_, i, hvFromValue(values[i]));
+      }
+      return add<jsi::Object>(obj.getHermesValue());
+    }
+
+    auto obj = vm::toHandle(&runtime_, vm::JSObject::create(&runtime_, count));
+    auto marker = gcScope.createMarker();
+    for (size_t i = 0; i < count; ++i) {
+      checkStatus(vm::JSObject::defineOwnProperty(
+                      obj,
+                      &runtime_,
+                      phv(names[i]).getSymbol(),
+                      vm::DefinePropertyFlags::getDefaultNewPropertyFlags(),
+                      vmHandleFromValue(values[i]),
+                      vm::PropOpFlags().plusThrowOnError())
+                      .getStatus());
+      gcScope.flushToMarker(marker);
+    }
+
+    // Only cache the class if the slots are in the order of the names, which
+    // isn't the case if a name is repeated.
+    vm::HiddenClass *clazz = obj->getClass(&runtime_);
+    if (!clazz->isDictionary() && clazz->getNumProperties() == count &&
+        !clazz->getHasIndexLikeProperties()) {
+      entry.names.clear();
+      for (size_t i = 0; i < count; ++i)
+        entry.names.push_back(phv(names[i]).getSymbol());
+      entry.clazz = vm::HermesValue::encodeObjectValue(clazz);
+    }
+    return add<jsi::Object>(obj.getHermesValue());
+  });
+}
+
+void HermesRuntimeImpl::getProperties(
+    const jsi::Object &obj,
+    const jsi::PropNameID *names,
+    jsi::Value *values,
+    size_t count) {
+  return maybeRethrow([&] {
+    vm::GCScope gcScope(&runtime_);
+    auto h = handle(obj);
+    auto marker = gcScope.createMarker();
+    for (size_t i = 0; i < count; ++i) {
+      auto res = h->getNamedOrIndexed(h, &runtime_, phv(names[i]).getSymbol());
+      checkStatus(res.getStatus());
+      values[i] = valueFromHermesValue(*res);
+      gcScope.flushToMarker(marker);
+    }
+  });
+}
+
+void HermesRuntimeImpl::setProperties(
+    jsi::Object &obj,
+    const jsi::PropNameID *names,
+    const jsi::Value *values,
+    size_t count) {
+  return maybeRethrow([&] {
+    vm::GCScope gcScope(&runtime_);
+    auto h = handle(obj);
+    auto marker = gcScope.createMarker();
+    for (size_t i = 0; i < count; ++i) {
+      checkStatus(h->putNamedOrIndexed(
+                       h,
+                       &runtime_,
+                       phv(names[i]).getSymbol(),
+                       vmHandleFromValue(values[i]),
+                       vm::PropOpFlags().plusThrowOnError())
+                      .getStatus());
+      gcScope.flushToMarker(marker);
+    }
+  });
+}
+
+std::shared_ptr<vm::SerializedValue> HermesRuntimeImpl::serialize(
+    const jsi::Value &value,
+    const jsi::Value &transfer) {
+  return maybeRethrow([&] {
+    vm::GCScope gcScope(&runtime_);
+    auto res = vm::SerializedValue::serialize(
+        &runtime_, vmHandleFromValue(value), vmHandleFromValue(transfer));
+    checkStatus(res.getStatus());
+    return std::shared_ptr<vm::SerializedValue>(std::move(*res));
+  });
+}
+
+jsi::Value HermesRuntimeImpl::deserialize(vm::SerializedValue &value) {
+  return maybeRethrow([&] {
+    vm::GCScope gcScope(&runtime_);
+    auto res = value.deserialize(&runtime_);
+    checkStatus(res.getStatus());
+    return valueFromHermesValue(*res);
+  });
+}
+
 bool HermesRuntimeImpl::isArray(const jsi::Object &obj) const {
   return vm::vmisa<vm::JSArray>(phv(obj));
 }
@@ -1947,12 +2656,47 @@ size_t HermesRuntimeImpl::getByteLength(vm::Handle<vm::JSArrayBuffer> arr) {
 
 namespace {
 
-class HermesMutex : public std::recursive_mutex {
+/// The lock of the thread safe runtime.  It is re-entrant, and taking it
+/// again on the thread that holds it (which is what every call made while a
+/// ThreadSafeRuntimeLock is held does) is an inline check of the owner,
+/// without any read-modify-write atomic or call into the OS.
+class HermesMutex {
  public:
   // ThreadSafeRuntimeImpl expects that the lock ctor takes a
-  // reference to the Runtime.  Otherwise, this is a
-  // std::recursive_mutex.
+  // reference to the Runtime.
   HermesMutex(HermesRuntimeImpl &) {}
+
+  void lock() {
+    const std::thread::id self = std::this_thread::get_id();
+    // Only this thread can have stored its own ID, so a relaxed load is
+    // enough to tell whether it holds the lock.
+    if (owner_.load(std::memory_order_relaxed) == self) {
+      ++depth_;
+      return;
+    }
+    mutex_.lock();
+    owner_.store(self, std::memory_order_relaxed);
+    depth_ = 1;
+  }
+
+  void unlock() {
+    assert(
+        owner_.load(std::memory_order_relaxed) ==
+            std::this_thread::get_id() &&
+        "unlocking a runtime that this thread doesn't hold");
+    if (--depth_)
+      return;
+    owner_.store(std::thread::id(), std::memory_order_relaxed);
+    mutex_.unlock();
+  }
+
+ private:
+  std::mutex mutex_;
+  /// The thread that holds mutex_, if any.
+  std::atomic<std::thread::id> owner_{};
+  /// How many times the owner has taken the lock.  Only accessed by the
+  /// owner.
+  unsigned depth_{0};
 };
 
 } // namespace
@@ -1989,6 +2733,51 @@ std::unique_ptr<HermesRuntime> makeHermesRuntime(
   return std::move(ret);
 }
 
+HermesRuntimePool::HermesRuntimePool(
+    const vm::RuntimeConfig &runtimeConfig,
+    std::function<void(HermesRuntime &)> init,
+    size_t maxIdle)
+    : runtimeConfig_(runtimeConfig),
+      init_(std::move(init)),
+      maxIdle_(maxIdle) {}
+
+std::unique_ptr<HermesRuntime> HermesRuntimePool::acquire() {
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (!idle_.empty()) {
+      auto runtime = std::move(idle_.back());
+      idle_.pop_back();
+      return runtime;
+    }
+  }
+  auto runtime = makeHermesRuntime(runtimeConfig_);
+  if (init_)
+    init_(*runtime);
+  runtime->saveResetPoint();
+  return runtime;
+}
+
+void HermesRuntimePool::release(std::unique_ptr<HermesRuntime> runtime) {
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (idle_.size() >= maxIdle_)
+      return;
+  }
+  try {
+    runtime->resetToSavedPoint();
+  } catch (const jsi::JSIException &) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (idle_.size() < maxIdle_)
+    idle_.push_back(std::move(runtime));
+}
+
+size_t HermesRuntimePool::idleCount() const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  return idle_.size();
+}
+
 std::unique_ptr<jsi::ThreadSafeRuntime> makeThreadSafeHermesRuntime(
     const vm::RuntimeConfig &runtimeConfig) {
 #if defined(HERMESVM_PLATFORM_LOGGING)
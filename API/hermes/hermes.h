@@ -7,10 +7,16 @@
 #ifndef HERMES_HERMES_H
 #define HERMES_HERMES_H
 
+#include <chrono>
 #include <exception>
+#include <functional>
+#include <future>
 #include <list>
 #include <memory>
+#include <mutex>
+#include <ostream>
 #include <string>
+#include <vector>
 
 #include <hermes/Public/RuntimeConfig.h>
 #include <jsi/jsi.h>
@@ -24,6 +30,7 @@ class raw_ostream;
 namespace hermes {
 namespace vm {
 struct MockedEnvironment;
+class SerializedValue;
 } // namespace vm
 } // namespace hermes
 
@@ -59,6 +66,18 @@ class HermesRuntime : public jsi::Runtime {
       const uint8_t *data,
       size_t len,
       std::string *errorMessage = nullptr);
+  // Maps \p len bytes of bytecode starting at byte \p offset of the file
+  // descriptor \p fd, so that it is used in place, without being copied. \p fd
+  // may be a regular file, a memfd or ashmem region, or an uncompressed asset
+  // of an APK (with the offset and length of the asset). It may be closed
+  // once this returns. \p offset must be a multiple of 4, so that the
+  // bytecode is aligned. Returns null, and why in errorMessage (if nonnull),
+  // if the data cannot be mapped or is not valid HBC.
+  static std::unique_ptr<const jsi::Buffer> mapHermesBytecode(
+      int fd,
+      size_t offset,
+      size_t len,
+      std::string *errorMessage = nullptr);
   static void setFatalHandler(void (*handler)(const std::string &));
 
   // Assuming that \p data is valid HBC bytecode data, returns a pointer to then
@@ -68,8 +87,32 @@ class HermesRuntime : public jsi::Runtime {
       const uint8_t *data,
       size_t len);
 
-  /// Enable sampling profiler.
-  static void enableSamplingProfiler();
+  /// Prepare \p buffer for evaluatePreparedJavaScript() like
+  /// prepareJavaScript() does, but without a runtime, so that it can be done
+  /// on any thread, for example to compile a downloaded bundle in the
+  /// background while the runtime keeps running JS.  Bytecode also gets the
+  /// checks of hermesBytecodeSanityCheck().  The result can be evaluated by
+  /// any runtime.  Source is compiled through the code cache in
+  /// \p codeCacheDir, unless it is empty (see setCodeCacheDirectory()).
+  /// Throws jsi::JSINativeException if \p buffer is invalid.
+  static std::shared_ptr<const jsi::PreparedJavaScript>
+  prepareJavaScriptOnAnyThread(
+      const std::shared_ptr<const jsi::Buffer> &buffer,
+      std::string sourceURL,
+      const std::string &codeCacheDir = std::string());
+
+  /// Run prepareJavaScriptOnAnyThread() on a new thread.  The future holds
+  /// the result or the exception.
+  static std::future<std::shared_ptr<const jsi::PreparedJavaScript>>
+  prepareJavaScriptAsync(
+      std::shared_ptr<const jsi::Buffer> buffer,
+      std::string sourceURL,
+      std::string codeCacheDir = std::string());
+
+  /// Enable sampling profiler.  If \p capturePerfCounters, the hardware
+  /// performance counters of the runtime threads are read with every sample,
+  /// where the OS allows it (Linux perf events).
+  static void enableSamplingProfiler(bool capturePerfCounters = false);
 
   /// Disable the sampling profiler
   static void disableSamplingProfiler();
@@ -77,6 +120,21 @@ class HermesRuntime : public jsi::Runtime {
   /// Dump sampled stack trace to the given file name.
   static void dumpSampledTraceToFile(const std::string &fileName);
 
+  /// Dump to the given file name, as JSON, the hardware performance counters
+  /// captured by the sampling profiler, charged to the function on top of the
+  /// stack of each sample and ranked by cycles.
+  static void dumpSampledPerfCountersToFile(const std::string &fileName);
+
+  /// While the sampling profiler runs, call \p callback every \p interval
+  /// with the stacks sampled since the previous call, as a Chrome trace, so
+  /// that a long session can be uploaded piece by piece in bounded memory.
+  /// Stack frame ids are shared by the chunks of a session and each chunk
+  /// only lists the frames that are new.  The callback runs on the sampling
+  /// thread.  An empty \p callback stops it.
+  static void setSampledTraceChunkCallback(
+      std::function<void(std::string)> callback,
+      std::chrono::milliseconds interval);
+
   // The base class declares most of the interesting methods.  This
   // just declares new methods which are specific to HermesRuntime.
   // The actual implementations of the pure virtual methods are
@@ -90,6 +148,15 @@ class HermesRuntime : public jsi::Runtime {
       std::unique_ptr<const jsi::Buffer> buffer,
       const jsi::Value &context);
 
+  /// Set the \param loader that is asked for the segment of a statically
+  /// resolved CJS module, the first time it is required before its segment
+  /// was loaded with loadSegment().  The loader returns the bytecode of the
+  /// segment that defines the module with the given ID, or null if there is
+  /// none, which makes the require throw.
+  void setSegmentLoader(
+      std::function<std::unique_ptr<const jsi::Buffer>(uint32_t moduleID)>
+          loader);
+
   /// Gets a guaranteed unique id for an object, which is assigned at
   /// allocation time and is static throughout that object's lifetime.
   /// This is mainly useful for tracing and debugging use cases, so in
@@ -97,6 +164,219 @@ class HermesRuntime : public jsi::Runtime {
   /// values.
   uint64_t getUniqueID(const jsi::Object &o) const;
 
+  /// Do garbage collection work until \p deadline, such as marking part of
+  /// the heap, so that it does not have to be done in later pauses.  Meant to
+  /// be called in idle periods, for example between frames.  The work is
+  /// done in bounded steps, but the last one may overrun the deadline a
+  /// little.
+  /// \return true if there is more work that further calls could do.
+  bool collectIncrementally(std::chrono::steady_clock::time_point deadline);
+
+  /// Return memory that the heap does not use to the OS.  Meant to be called
+  /// when the OS signals memory \p pressure, for example from a low memory
+  /// warning.  The bytecode cached for eval() is dropped first; critical
+  /// pressure also drops the other caches of the runtime, such as the
+  /// compiled RegExps, and triggers a garbage collection.
+  void handleMemoryPressure(::hermes::vm::MemoryPressure pressure);
+
+  /// Run the promise jobs queued by JS, including the ones that they queue,
+  /// until there are none left.  Meant to be called by the host once the
+  /// current task is done, for example after evaluateJavaScript().  Jobs left
+  /// after one throws stay queued for the next call.
+  void drainMicrotasks();
+
+  /// Record the state of the global object, of the objects stored in its
+  /// properties and of their prototype objects, so that
+  /// resetToSavedPoint() can bring it back.  Meant to be called once the
+  /// runtime is initialized, so that it can serve many requests, for example
+  /// of server-side rendering, instead of initializing a new runtime for
+  /// each.  Replaces the state recorded before.
+  void saveResetPoint();
+
+  /// Restore the state recorded by saveResetPoint(): the own properties,
+  /// prototype and extensibility of those objects are put back, and the
+  /// pending microtasks are dropped.  The loaded bytecode, its compiled code
+  /// and its caches are kept.  Other state, such as the variables captured
+  /// by closures, the elements of arrays and other objects reachable from
+  /// the global object, is not restored.  Throws a JSError if there is no
+  /// saved state or it can't be restored.
+  void resetToSavedPoint();
+
+  /// Keep the bytecode that evaluateJavaScript() and prepareJavaScript()
+  /// compile from source in the directory \p dir, and map it from there
+  /// instead of compiling the same source again, in this run or a later one.
+  /// Entries are keyed by the source, its URL, the compiler flags and the
+  /// bytecode version, and are never removed.  Sources are compiled eagerly
+  /// when the cache is used.  An empty \p dir turns the cache off.
+  void setCodeCacheDirectory(const std::string &dir);
+
+  /// Create a string that takes over the storage of \p utf8 instead of
+  /// copying it, if it is ASCII (and not too short for that to pay off).
+  /// Other strings are transcoded, as by createStringFromUtf8().
+  jsi::String createExternalString(std::string &&utf8);
+
+  /// Create a string that takes over the storage of \p utf16 instead of
+  /// copying it (unless it is too short for that to pay off).
+  jsi::String createExternalString(std::u16string &&utf16);
+
+  /// Call \p cb with the characters of \p str, without copying them: \p data
+  /// points to \p num 8-bit ASCII characters if \p ascii is true, and to \p
+  /// num UTF-16 code units otherwise.  The data is only valid during the
+  /// call, and \p cb must not use the runtime.
+  void getStringData(
+      const jsi::String &str,
+      void *ctx,
+      void (*cb)(void *ctx, bool ascii, const void *data, size_t num));
+
+  /// Create an ArrayBuffer over the \p size bytes at \p data, which stay
+  /// owned by the host and are not copied.  \p release is called once the
+  /// buffer no longer uses them: when it is collected, or when the runtime
+  /// is destroyed.  It may run during a garbage collection, so it must not
+  /// use the runtime.  The memory counts towards the heap's external memory,
+  /// which lets the GC collect large buffers promptly.
+  jsi::ArrayBuffer createExternalArrayBuffer(
+      uint8_t *data,
+      size_t size,
+      std::function<void()> release);
+
+  /// Create an empty plain object with room for \p propertyCount properties,
+  /// so that adding that many doesn't reallocate its property storage.
+  jsi::Object createObjectWithCapacity(size_t propertyCount);
+
+  /// Create an array of the \p count elements \p values, in a single call
+  /// into the VM.  The elements are stored in dense storage allocated once,
+  /// instead of growing it one setValueAtIndex() at a time.
+  jsi::Array createArrayWithElements(const jsi::Value *values, size_t count);
+
+  /// Create a plain object with the properties \p names set to \p values,
+  /// as an object literal would, in a single call into the VM.  Objects
+  /// created with the same names in the same order share their hidden class,
+  /// which is only looked up the first time.  Meant for host bridges that
+  /// marshal many objects of the same shape.
+  jsi::Object createObjectWithProperties(
+      const jsi::PropNameID *names,
+      const jsi::Value *values,
+      size_t count);
+
+  /// Read the properties \p names of \p obj into \p values, in a single call
+  /// into the VM.
+  void getProperties(
+      const jsi::Object &obj,
+      const jsi::PropNameID *names,
+      jsi::Value *values,
+      size_t count);
+
+  /// Set the properties \p names of \p obj to \p values, in a single call into
+  /// the VM.
+  void setProperties(
+      jsi::Object &obj,
+      const jsi::PropNameID *names,
+      const jsi::Value *values,
+      size_t count);
+
+  /// Return a key that identifies the property name \p name: two names have
+  /// the same key iff they are equal, as by PropNameID::compare().  A key is
+  /// only stable while some PropNameID for it is alive, so a HostObject can
+  /// keep the PropNameIDs it understands, map their keys to its properties,
+  /// and look up the key of the name passed to get() or set() instead of
+  /// comparing strings.
+  static uint32_t getPropNameIDKey(const jsi::PropNameID &name);
+
+  /// Serialize \p value with the structured clone algorithm, into a form
+  /// that doesn't depend on this runtime.  Objects, arrays, Dates,
+  /// ArrayBuffers and typed arrays are copied, and shared or cyclic
+  /// references are kept.  This is how runtimes exchange messages, in
+  /// particular a runtime created on a worker thread: the result can be moved
+  /// to the worker and deserialized by its runtime.  Throws a JSError for
+  /// values that can't be cloned, such as functions and host objects.
+  std::shared_ptr<::hermes::vm::SerializedValue> serialize(
+      const jsi::Value &value);
+
+  /// As above, but the ArrayBuffers in \p transfer are detached and their
+  /// contents moved into the result instead of being copied.  Only one
+  /// deserialize() call can then get them.
+  std::shared_ptr<::hermes::vm::SerializedValue> serialize(
+      const jsi::Value &value,
+      const jsi::Array &transfer);
+
+  /// Create a copy of the serialized \p value in this runtime.  A value must
+  /// not be deserialized by several runtimes at the same time.
+  jsi::Value deserialize(
+      const std::shared_ptr<::hermes::vm::SerializedValue> &value);
+
+  /// Start recording the JS stack of an allocation once every \p
+  /// samplingInterval allocated bytes.  Much cheaper than a heap snapshot,
+  /// so that it can be left on in production.
+  void enableSamplingHeapProfiler(size_t samplingInterval = 32 * 1024);
+
+  /// Stop recording allocations, and write what was recorded to \p os as a
+  /// sampling heap profile that the Chrome DevTools can load (a .heapprofile
+  /// file).
+  void disableSamplingHeapProfiler(std::ostream &os);
+
+  /// Reset the per-function invocation counts, and start sampling the
+  /// executing JS function once every \p samplingInterval, or only count the
+  /// invocations if it is 0.  Cheap enough to be left on in production, to
+  /// collect the profile of real sessions for function ordering and inlining.
+  /// If \p attributeTime, also measure the self time of every function, split
+  /// into the time in the interpreter, in JIT-compiled code, in the native
+  /// functions it calls and in the collections triggered while it runs.  This
+  /// reads the clock at every call and return, so it is for development.
+  void enableFunctionProfiler(
+      std::chrono::microseconds samplingInterval =
+          std::chrono::milliseconds(1),
+      bool attributeTime = false);
+
+  /// Stop sampling and measuring time.  The counters are kept until the
+  /// profiler is enabled again.
+  void disableFunctionProfiler();
+
+  /// Write the invocation count and the number of samples of every JS
+  /// function that was called or sampled to \p os, as JSON, hottest first.
+  /// With time attribution, the times are included, in microseconds, and the
+  /// functions are ranked by their total.
+  void dumpFunctionProfile(std::ostream &os);
+
+  /// Forget the code coverage recorded so far and start recording which basic
+  /// blocks of the bytecode run.  The cost is a flag test at every branch and
+  /// call, so it is meant for test suites.  Nothing is JIT-compiled while it
+  /// is recorded.
+  void enableCodeCoverage();
+
+  /// Stop recording code coverage.  What was recorded is kept.
+  void disableCodeCoverage();
+
+  /// Write the basic blocks of every loaded function to \p os as JSON, with
+  /// their bytecode offset and size, the source line and column of their first
+  /// instruction when there is debug info, and whether they were covered.
+  void dumpCodeCoverage(std::ostream &os);
+
+  /// \return instrumentation of the runtime, as JSON.  "startup" has the
+  /// wall and CPU time in seconds, page faults and count of every phase of
+  /// startup: runtime creation, predefined strings, JS library initialization,
+  /// bytecode mapping, string table registration, global function execution
+  /// and first GC.  "gcTelemetry" has the allocation telemetry of the heap:
+  /// histograms of the allocation rate in bytes per second between
+  /// collections, of the percentage of the young generation that survives its
+  /// collections, and of the age of the promoted objects in bytes allocated
+  /// after them, plus the bytes allocated by cell kind.  It is an empty object
+  /// unless the runtime was created with GCConfig::ShouldRecordTelemetry.
+  std::string getInstrumentedStats();
+
+  /// Collect garbage, then write a heap snapshot to the open file descriptor
+  /// \p fd as it is produced, without holding the whole snapshot in memory.
+  /// \p fd is left open.
+  /// \return true on success, false if writing failed.
+  bool createSnapshotToFileDescriptor(int fd, bool compact);
+
+  /// Collect garbage, then pass a heap snapshot to \p callback as it is
+  /// produced, in chunks of at most \p chunkSize bytes.  Each chunk is only
+  /// valid during the call that receives it.
+  void createSnapshotToCallback(
+      const std::function<void(const char *data, size_t size)> &callback,
+      bool compact,
+      size_t chunkSize = 64 * 1024);
+
 #ifdef HERMESVM_API_TRACE
   /// Get a structure representing the enviroment-dependent behavior, so
   /// it can be written into the trace for later replay.
@@ -164,6 +444,41 @@ std::unique_ptr<HermesRuntime> makeHermesRuntime(
 std::unique_ptr<jsi::ThreadSafeRuntime> makeThreadSafeHermesRuntime(
     const ::hermes::vm::RuntimeConfig &runtimeConfig =
         ::hermes::vm::RuntimeConfig());
+
+/// A pool of initialized runtimes, which are reset between uses instead of
+/// being created again, for servers which run every request in a fresh
+/// runtime.  A new runtime is initialized by the init callback, typically by
+/// evaluating the bundle, and its state is then saved with
+/// HermesRuntime::saveResetPoint().  The pool can be used from any thread,
+/// but a runtime only by one thread at a time.
+class HermesRuntimePool {
+ public:
+  /// Create runtimes with \p runtimeConfig, initialized by \p init.  At most
+  /// \p maxIdle runtimes are kept for reuse.
+  HermesRuntimePool(
+      const ::hermes::vm::RuntimeConfig &runtimeConfig,
+      std::function<void(HermesRuntime &)> init,
+      size_t maxIdle);
+
+  /// Take an idle runtime, or create and initialize a new one if there is
+  /// none.  Exceptions thrown by the init callback are propagated.
+  std::unique_ptr<HermesRuntime> acquire();
+
+  /// Reset \p runtime and keep it for reuse, unless the pool is full.  It is
+  /// destroyed instead if it can't be reset.
+  void release(std::unique_ptr<HermesRuntime> runtime);
+
+  /// Return the number of idle runtimes.
+  size_t idleCount() const;
+
+ private:
+  const ::hermes::vm::RuntimeConfig runtimeConfig_;
+  const std::function<void(HermesRuntime &)> init_;
+  const size_t maxIdle_;
+
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<HermesRuntime>> idle_;
+};
 } // namespace hermes
 } // namespace facebook
 
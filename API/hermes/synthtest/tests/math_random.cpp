@@ -45,7 +45,7 @@ var a = [Math.random(), Math.random(), Math.random()];
 // These were the numbers that came out for the seed 10 for the first three
 // calls to Math.random. This test ensures that the seed is set when replaying
 // and mocking out Math.random.
-var b = [0.8503244913652883, 0.9161127707202693, 0.8968977185307782];
+var b = [0.6571792125033512, 0.40507071429424046, 0.5163300987197419];
 
 for (var i = 0; i < a.length; i++) {
   if (a[i] != b[i]) {
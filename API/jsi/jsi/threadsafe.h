@@ -21,6 +21,27 @@ class ThreadSafeRuntime : public Runtime {
   virtual Runtime& getUnsafeRuntime() = 0;
 };
 
+/// Holds the lock of a ThreadSafeRuntime while in scope.  The lock is
+/// re-entrant, so calls made through the runtime meanwhile still work, and
+/// only take the cheap path of a lock already held by this thread.  Holding
+/// one across a batch of calls saves locking and unlocking for each of them.
+/// Calls made through getUnsafeRuntime() inside the scope skip even that.
+class ThreadSafeRuntimeLock {
+ public:
+  explicit ThreadSafeRuntimeLock(const ThreadSafeRuntime& rt) : rt_(rt) {
+    rt_.lock();
+  }
+  ~ThreadSafeRuntimeLock() {
+    rt_.unlock();
+  }
+
+  ThreadSafeRuntimeLock(const ThreadSafeRuntimeLock&) = delete;
+  ThreadSafeRuntimeLock& operator=(const ThreadSafeRuntimeLock&) = delete;
+
+ private:
+  const ThreadSafeRuntime& rt_;
+};
+
 namespace detail {
 
 template <typename R, typename L>
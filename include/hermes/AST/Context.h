@@ -12,6 +12,8 @@
 #include "hermes/Support/SourceErrorManager.h"
 #include "hermes/Support/StringTable.h"
 
+#include "llvm/ADT/StringMap.h"
+
 namespace hermes {
 
 namespace hbc {
@@ -57,6 +59,21 @@ struct OutliningSettings {
   unsigned maxParameters{5};
 };
 
+struct InliningSettings {
+  /// The number of times each call site ran in a profile, keyed by its
+  /// location in the source as "<file>:<line>:<column>".  Empty if no profile
+  /// was given, in which case only functions called once are inlined.
+  llvm::StringMap<uint64_t> callCounts;
+  /// Minimum count for a call site to be hot.  Hot call sites are inlined even
+  /// if the callee is called from other places.
+  unsigned minHotCount{1000};
+  /// Maximum number of instructions of a callee inlined into a hot call site.
+  unsigned maxHotCalleeSize{64};
+  /// Maximum number of instructions that inlining hot call sites may add, in
+  /// percent of the instructions of the module.
+  unsigned hotGrowthPercent{5};
+};
+
 struct OptimizationSettings {
   /// Enable constant property optimization
   bool constantPropertyOptimizations{false};
@@ -76,6 +93,9 @@ struct OptimizationSettings {
   /// Enable any inlining of functions.
   bool inlining{true};
 
+  /// Specific settings for the inliner.
+  InliningSettings inliningSettings;
+
   /// Enable IR outlining.
   bool outlining{false};
 
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_AST_ESTREESERIALIZER_H
+#define HERMES_AST_ESTREESERIALIZER_H
+
+#include "hermes/AST/Context.h"
+#include "hermes/AST/ESTree.h"
+
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+namespace hermes {
+
+/// Information about a source buffer which is stored along with its AST.
+struct SerializedESTreeInfo {
+  /// Whether the 'use static builtin' directive was found.
+  bool useStaticBuiltin{false};
+  /// The URL from the sourceMappingURL comment, if any.
+  std::string sourceMappingUrl{};
+};
+
+/// Write the AST \p program, parsed from \p buffer, to \p os in a compact
+/// binary form. Labels are written once each, and source locations as offsets
+/// in the buffer. The format is only meant to be read back by the same build.
+void serializeESTree(
+    llvm::raw_ostream &os,
+    ESTree::ProgramNode *program,
+    const llvm::MemoryBuffer &buffer,
+    const SerializedESTreeInfo &info);
+
+/// Read an AST written by serializeESTree() from \p data, allocating its nodes
+/// and labels in \p context. Its locations point into the source buffer
+/// \p bufId, which must have the same contents as the one it was parsed from.
+/// \return the program, or nullptr if \p data is not a valid serialized AST
+///   for that buffer.
+ESTree::ProgramNode *deserializeESTree(
+    Context &context,
+    llvm::StringRef data,
+    uint32_t bufId,
+    SerializedESTreeInfo &info);
+
+} // namespace hermes
+
+#endif
@@ -122,6 +122,11 @@ class BytecodeFunction {
     return opcodes_;
   }
 
+  /// \return the bytecode, to patch operands in place.
+  llvm::MutableArrayRef<opcode_atom_t> getMutableOpcodeArray() {
+    return opcodes_;
+  }
+
   ArrayRef<uint32_t> getJumpTables() const {
     return jumpTables_;
   }
@@ -20,6 +20,7 @@
 
 #include <atomic>
 #include <thread>
+#include <vector>
 
 namespace hermes {
 namespace hbc {
@@ -223,6 +224,13 @@ class BCProviderBase {
   /// Get a pointer to the bytecode stream.
   virtual const uint8_t *getBytecode(uint32_t functionID) const = 0;
 
+  /// Check that the header and the bytecode of the function with \p
+  /// functionID lie within the data.  Loading only checks the sections, so
+  /// this is done for each function when it is first used.
+  virtual bool isFunctionInBounds(uint32_t functionID) const {
+    return true;
+  }
+
   /// Get the exception table for a given function with \p functionID.
   virtual llvm::ArrayRef<hbc::HBCExceptionHandlerInfo> getExceptionTable(
       uint32_t functionID) const = 0;
@@ -248,6 +256,11 @@ class BCProviderBase {
   /// Read some bytecode into OS page cache (only implemented for buffers).
   virtual void startWarmup(uint8_t percent) {}
 
+  /// Read the given \p pages of the bytecode into OS page cache, in order
+  /// (only implemented for buffers). Pages are numbered as by the
+  /// PageAccessTracker, from the first page-aligned address of the buffer.
+  virtual void startWarmupPages(const std::vector<uint32_t> &pages) {}
+
   /// Issue an madvise call (only implemented for buffers).
   virtual void madvise(oscompat::MAdvice advice) {}
 
@@ -316,7 +329,8 @@ class BCProviderFromBuffer final : public BCProviderBase {
   /// Offset of the location to find debug info.
   uint32_t debugInfoOffset_{};
 
-  /// If \p startWarmup has been called, this is the thread doing the warmup.
+  /// If \p startWarmup or \p startWarmupPages has been called, this is the
+  /// thread doing the warmup.
   llvm::Optional<std::thread> warmupThread_;
 
   /// Set by \p stopWarmup to tell any warmup thread to abort.
@@ -429,6 +443,8 @@ class BCProviderFromBuffer final : public BCProviderBase {
     return bufferPtr_ + getFunctionHeader(functionID).offset();
   }
 
+  bool isFunctionInBounds(uint32_t functionID) const;
+
   llvm::ArrayRef<hbc::HBCExceptionHandlerInfo> getExceptionTable(
       uint32_t functionID) const {
     return getExceptionTableAndDebugOffsets(functionID).first;
@@ -442,6 +458,7 @@ class BCProviderFromBuffer final : public BCProviderBase {
   virtual SHA1 getSourceHash() const;
 
   virtual void startWarmup(uint8_t percent);
+  virtual void startWarmupPages(const std::vector<uint32_t> &pages);
 
   virtual void madvise(oscompat::MAdvice advice);
   virtual void adviseStringTableSequential();
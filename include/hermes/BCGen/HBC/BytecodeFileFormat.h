@@ -28,8 +28,8 @@ const static uint64_t MAGIC = 0x1F1903C103BC1FC6;
 const static uint64_t DELTA_MAGIC = ~MAGIC;
 
 // Bytecode version generated by this version of the compiler.
-// Updated: Jun 22, 2019
-const static uint32_t BYTECODE_VERSION = 59;
+// Updated: Oct 15, 2026
+const static uint32_t BYTECODE_VERSION = 67;
 
 /// Property cache index which indicates no caching.
 static constexpr uint8_t PROPERTY_CACHING_DISABLED = 0;
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_BCGEN_HBC_BYTECODEPATCH_H
+#define HERMES_BCGEN_HBC_BYTECODEPATCH_H
+
+#include "hermes/BCGen/HBC/BytecodeFileFormat.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <string>
+#include <vector>
+
+namespace hermes {
+namespace hbc {
+
+/// Magic number of a bytecode patch file.
+const static uint64_t PATCH_MAGIC = 0x48435441504342C6;
+
+/// Version of the bytecode patch format.
+const static uint32_t PATCH_VERSION = 1;
+
+/// A bytecode patch turns a base bytecode file into a new one, at the
+/// granularity of the sections of the file and of the bodies of its
+/// functions: every such region of the new file is either copied from an
+/// identical region anywhere in the base file, or stored in the patch.
+/// The patch starts with this header, which identifies the base file, and is
+/// followed by a sequence of operations.  Each operation starts with a
+/// uint32_t whose high bit is set when its bytes follow it in the patch, and
+/// whose other bits are its length; when the high bit is clear, the length is
+/// followed by the uint32_t offset in the base file of the bytes to copy.
+LLVM_PACKED_START
+struct BytecodePatchHeader {
+  uint64_t magic;
+  uint32_t version;
+  /// The source hash and length of the base file.
+  uint8_t baseSourceHash[SHA1_NUM_BYTES];
+  uint32_t baseFileLength;
+  /// The length of the file the patch creates.
+  uint32_t newFileLength;
+  /// The number of operations following the header.
+  uint32_t opCount;
+};
+LLVM_PACKED_END
+
+/// Create a patch turning the bytecode file \p base into \p newFile, and
+/// append it to \p patch.  The regions of \p newFile are matched against the
+/// regions of \p base with the same contents, wherever they are in the file,
+/// so functions and buffers that moved are still copied.
+/// \return true if successful, false if either file could not be interpreted,
+/// in which case an error is returned in \p outError.
+bool createBytecodePatch(
+    llvm::ArrayRef<uint8_t> base,
+    llvm::ArrayRef<uint8_t> newFile,
+    std::vector<uint8_t> &patch,
+    std::string *outError);
+
+/// Apply \p patch to the bytecode file \p base, writing the new file to
+/// \p os as it is reconstructed, so it never needs to be in memory and can be
+/// mapped once written.
+/// \return true if successful, false if the patch is invalid or was not
+/// created from \p base, in which case an error is returned in \p outError
+/// and part of the new file may have been written.
+bool applyBytecodePatch(
+    llvm::ArrayRef<uint8_t> base,
+    llvm::ArrayRef<uint8_t> patch,
+    llvm::raw_ostream &os,
+    std::string *outError);
+
+} // namespace hbc
+} // namespace hermes
+
+#endif // HERMES_BCGEN_HBC_BYTECODEPATCH_H
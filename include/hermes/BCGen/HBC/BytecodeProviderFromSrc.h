@@ -20,6 +20,10 @@ struct CompileFlags {
   bool optimize{false};
   bool debug{false};
   bool lazy{false};
+  /// In lazy mode, find the functions to compile lazily by matching brackets
+  /// instead of pre-parsing the whole source. Syntax errors in these functions
+  /// are then only reported when they are first called.
+  bool lazySkipPreParse{false};
   bool strict{false};
   /// The value is optional; when it is set, the optimization setting is based
   /// on the value; when it is unset, it means the parser needs to automatically
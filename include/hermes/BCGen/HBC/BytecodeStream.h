@@ -97,6 +97,10 @@ class BytecodeSerializer {
 
   void serializeDebugOffsets(BytecodeFunction &BF);
 
+  /// \return the functions of \p BM in the order their bodies and info are
+  /// laid out, as requested by options_.functionOrder.
+  std::vector<BytecodeFunction *> functionsInLayoutOrder(BytecodeModule &BM);
+
   void serializeFunctionsBytecode(BytecodeModule &BM);
   void serializeFunctionInfo(BytecodeFunction &BF);
 
@@ -16,6 +16,7 @@
 #include "hermes/Support/OptValue.h"
 #include "hermes/Support/StringTable.h"
 #include "hermes/Support/UTF8.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/Support/Format.h"
 
 #include <string>
@@ -133,9 +134,50 @@ class DebugInfo {
   uint32_t lexicalDataOffset_ = 0;
   StreamVector<uint8_t> data_{};
 
+  /// A decoded location of a function, and the offset in data_ it was
+  /// decoded from, which determines its file.
+  struct FunctionLocation {
+    DebugSourceLocation location;
+    uint32_t offset;
+  };
+
+  /// A decoded location of a file, in the order it is found in data_.
+  struct FileLocation {
+    uint32_t line;
+    uint32_t column;
+    uint32_t functionIndex;
+    uint32_t address;
+  };
+
+  /// Functions with at most this many locations are scanned instead of being
+  /// indexed, since decoding them is cheaper than keeping their locations.
+  static constexpr uint32_t kMinIndexedFunctionLocations = 16;
+
+  /// The decoded locations of the functions looked up so far, keyed by their
+  /// debug offset, and sorted by address. Small functions map to an empty
+  /// list. Like BCProviderBase::getDebugInfo(), this is filled in lazily and
+  /// is not thread safe.
+  mutable llvm::DenseMap<uint32_t, std::vector<FunctionLocation>>
+      functionLocations_{};
+
+  /// The decoded locations of the files looked up so far, keyed by their
+  /// filename ID, and stably sorted by line.
+  mutable llvm::DenseMap<uint32_t, std::vector<FileLocation>>
+      fileLocations_{};
+
   /// Get source filename as string id.
   OptValue<uint32_t> getFilenameForAddress(uint32_t debugOffset) const;
 
+  /// \return the locations of the function at \p debugOffset sorted by
+  /// address, decoding them the first time, or nullptr if the function is
+  /// small enough to be scanned.
+  const std::vector<FunctionLocation> *getFunctionLocations(
+      uint32_t debugOffset) const;
+
+  /// \return the locations of the file \p filenameId stably sorted by line,
+  /// decoding them the first time.
+  const std::vector<FileLocation> &getFileLocations(uint32_t filenameId) const;
+
  public:
   explicit DebugInfo() = default;
   /*implicit*/ DebugInfo(DebugInfo &&that) = default;
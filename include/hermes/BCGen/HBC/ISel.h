@@ -142,6 +142,11 @@ class HBCISel {
   /// Emit an Unreachable opcode in debug builds, otherwise do nothing.
   void emitUnreachableIfDebug();
 
+  /// \return the number of levels to walk up from the environment of the
+  ///   current function to reach the environment of \p scope, the operand of
+  ///   GetEnvironment, or None if the current function is dead.
+  llvm::Optional<uint32_t> getEnvironmentLevel(VariableScope *scope);
+
   /// In debug mode, assert that parameters have been correctly allocated.
   void verifyCall(CallInst *Inst);
 
@@ -158,6 +163,13 @@ class HBCISel {
   uint8_t acquirePropertyReadCacheIndex(unsigned id);
   uint8_t acquirePropertyWriteCacheIndex(unsigned id);
 
+  /// The read cache index shared by the InstanceOf instructions, which cache
+  /// the slot of the "prototype" property of the constructor by its class.
+  uint8_t instanceOfCacheIndex_{0};
+
+  /// Compute and return the read cache index of an InstanceOf.
+  uint8_t acquireInstanceOfCacheIndex();
+
   // Looking up filename/sourcemap id for each instruction is pretty slow,
   // and it's almost always from the same bufId every time. Cache the previous
   // result here, to reuse it when possible.
@@ -49,16 +49,24 @@ class LoadParameters : public FunctionPass {
 /// Lower LoadFrameInst, StoreFrameInst and CreateFunctionInst.
 class LowerLoadStoreFrameInst : public FunctionPass {
   /// Decide the correct scope to use when dealing with given variable.
+  /// \param resolvedScopes the environments of enclosing scopes that were
+  ///   already resolved on entry to the function.
   Instruction *getScope(
       IRBuilder &builder,
       Variable *var,
-      HBCCreateEnvironmentInst *captureScope);
+      HBCCreateEnvironmentInst *captureScope,
+      const llvm::DenseMap<VariableScope *, Instruction *> &resolvedScopes);
 
  public:
-  explicit LowerLoadStoreFrameInst()
-      : FunctionPass("LowerLoadStoreFrameInst") {}
+  explicit LowerLoadStoreFrameInst(bool optimizationEnabled)
+      : FunctionPass("LowerLoadStoreFrameInst"),
+        optimizationEnabled_(optimizationEnabled) {}
   ~LowerLoadStoreFrameInst() override = default;
   bool runOnFunction(Function *F) override;
+
+ private:
+  /// Whether functions that don't need an environment may skip creating one.
+  bool const optimizationEnabled_;
 };
 
 // Lower uses of the JS `arguments` array into HBC*Arguments* instructions.
@@ -81,6 +89,19 @@ class DedupReifyArguments : public FunctionPass {
   bool runOnFunction(Function *F) override;
 };
 
+/// Fuse an HBCResolveEnvironment whose only user is a load from the resolved
+/// environment into an HBCLoadFromOuterEnvironmentInst, which is a single
+/// instruction that doesn't need a register for the environment. Should run
+/// after CSE and CodeMotion, which decide how many users the environments
+/// have.
+class FuseOuterEnvironmentLoads : public FunctionPass {
+ public:
+  explicit FuseOuterEnvironmentLoads()
+      : FunctionPass("FuseOuterEnvironmentLoads") {}
+  ~FuseOuterEnvironmentLoads() override = default;
+  bool runOnFunction(Function *F) override;
+};
+
 class LowerConstruction : public FunctionPass {
  public:
   explicit LowerConstruction() : FunctionPass("LowerConstruction") {}
@@ -88,6 +109,17 @@ class LowerConstruction : public FunctionPass {
   bool runOnFunction(Function *F) override;
 };
 
+/// Replace the comparison of `typeof x` with a string literal by a single
+/// HBCTypeOfIsInst, so that the type name is neither materialized nor
+/// compared as a string. Only applies when the comparison is the sole user
+/// of the `typeof`. Must run before LoadConstants.
+class FuseTypeOfComparisons : public FunctionPass {
+ public:
+  explicit FuseTypeOfComparisons() : FunctionPass("FuseTypeOfComparisons") {}
+  ~FuseTypeOfComparisons() override = default;
+  bool runOnFunction(Function *F) override;
+};
+
 /// Lower calls into a series of parameter moves followed by a call with
 /// those moved values. Should only run once, right before MovElimination.
 class LowerCalls : public FunctionPass {
@@ -33,6 +33,14 @@ struct StringLiteralIDMapping {
       ConsecutiveStringStorage storage,
       std::vector<bool> isIdentifier);
 
+  /// Take ownership of \p storage and of \p strings, which must be the
+  /// strings in \p storage in the order of their IDs, so that they need not
+  /// be decoded from it again. \p isIdentifier is as above.
+  StringLiteralIDMapping(
+      ConsecutiveStringStorage storage,
+      StringSetVector strings,
+      std::vector<bool> isIdentifier);
+
  protected:
   /// The storage that the mapping was initialised with.
   ConsecutiveStringStorage storage_;
@@ -305,14 +305,23 @@ class RegisterAllocator {
   /// Calculates the live intervals for each instruction.
   void calculateLiveIntervals(ArrayRef<BasicBlock *> order);
 
+  /// Calculates a single conservative interval for each instruction, from its
+  /// definition to its last use, extended to the end of every loop that it is
+  /// live into. Unlike calculateLiveIntervals() this does not need the
+  /// liveness of every value in every block.
+  void calculateLinearIntervals(ArrayRef<BasicBlock *> order);
+
   /// Coalesce registers by merging the live intervals of multiple instructions
   /// together to take advantage of holes. Updates \p map with mapping between
   /// the coalesced interval and the interval it was merged into and the
   /// register that it will adopt.
   /// The order of the basic blocks is passed in \p order.
+  /// Only the merges that are required for correctness are done unless
+  /// \p mergeCopies is set.
   void coalesce(
       DenseMap<Instruction *, Instruction *> &map,
-      ArrayRef<BasicBlock *> order);
+      ArrayRef<BasicBlock *> order,
+      bool mergeCopies);
 
  protected:
   /// Keeps track of the already allocated values.
@@ -330,6 +339,11 @@ class RegisterAllocator {
   /// degenerate cases.
   uint64_t memoryLimit = -1;
 
+  /// If the function has at least this number of instructions, compute
+  /// conservative live intervals in a single scan instead of solving the
+  /// liveness of every value in every block.
+  unsigned linearScanThreshold = -1;
+
   /// Allocate the registers for the instructions in the function in a trivial,
   /// suboptimal, but very fast way.
   void allocateFastPass(ArrayRef<BasicBlock *> order);
@@ -359,6 +373,10 @@ class RegisterAllocator {
     memoryLimit = memoryLimitInBytes;
   }
 
+  void setLinearScanThreshold(unsigned minInstCount) {
+    linearScanThreshold = minInstCount;
+  }
+
   /// \returns the index of instruction \p I.
   unsigned getInstructionNumber(Instruction *I);
 
@@ -76,8 +76,11 @@ struct CompileResult {
 };
 
 /// Drive the Hermes compiler according to the command line options.
+/// \p args is the command line itself, which keys the bundles cached with
+/// -cache-dir; nothing is cached when it is empty.
 /// \return an exit status.
-CompileResult compileFromCommandLineOptions();
+CompileResult compileFromCommandLineOptions(
+    llvm::ArrayRef<const char *> args = llvm::None);
 
 /// Print the Hermes version (with VM) to the given stream \p s.
 void printHermesCompilerVMVersion(llvm::raw_ostream &s);
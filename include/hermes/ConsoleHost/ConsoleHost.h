@@ -32,10 +32,13 @@ class Runtime;
 ///     is null, this does not happen.
 /// \p filename If non-null, the filename of the BC buffer being loaded.
 ///    Used to find the other segments to be loaded at runtime.
+/// \p printStream If non-null, print() writes to it without flushing, instead
+///    of writing to stdout and flushing it on every call.
 void installConsoleBindings(
     vm::Runtime *runtime,
     vm::StatSamplingThread *statSampler = nullptr,
-    const std::string *filename = nullptr);
+    const std::string *filename = nullptr,
+    llvm::raw_ostream *printStream = nullptr);
 
 /// Options for executing an HBC bundle.
 struct ExecuteOptions {
@@ -48,6 +51,11 @@ struct ExecuteOptions {
   /// Stop after creating the RuntimeModule.
   bool stopAfterInit{false};
 
+  /// Buffer the output of print() and write it to stdout from another thread,
+  /// flushing it at exit and before an uncaught exception is reported.
+  /// Ignored when dumping JIT'ed code, which is also written to stdout.
+  bool bufferedOutput{false};
+
 #ifdef HERMESVM_PROFILER_EXTERN
   /// Patch the symbols so that the external profiler can be used.
   bool patchProfilerSymbols{false};
@@ -61,6 +69,10 @@ struct ExecuteOptions {
 
   /// Fatally crash on any JIT compilation error.
   bool jitCrashOnError{false};
+
+  /// If not empty, the file from which the JIT loads the functions compiled
+  /// by previous runs, and to which it saves them with those of this run.
+  std::string jitProfileFile;
 };
 
 /// Executes the HBC bytecode provided in HermesVM.
@@ -110,16 +110,33 @@ static opt<std::string> ProfilerSymbolsFile(
 static opt<bool>
     ES6Symbol("Xes6-symbol", desc("Enable support for ES6 Symbol"), init(true));
 
+static opt<bool> ES6Promise(
+    "Xes6-promise",
+    desc("Enable support for ES6 Promise"),
+    init(true));
+
 static llvm::cl::opt<bool> StopAfterInit(
     "stop-after-module-init",
     llvm::cl::desc("Exit once module loading is finished. Useful "
                    "to measure module initialization time"));
 
+static opt<bool> BufferedOutput(
+    "buffered-output",
+    desc("Buffer the output of print() and write it from a separate thread "
+         "instead of flushing stdout on every call"),
+    init(false));
+
 static opt<bool> TrackBytecodeIO(
     "track-io",
     desc(
         "Track bytecode I/O when executing bytecode. Only works with bytecode mode"));
 
+static opt<bool> RegisterStackGuard(
+    "Xregister-stack-guard",
+    desc("Detect register stack overflow with a guard region and a SIGSEGV "
+         "handler instead of checking the stack on every call"),
+    init(false));
+
 static opt<uint32_t> VMExperimentFlags(
     "Xvm-experiment-flags",
     llvm::cl::desc("VM experiment flags."),
@@ -1431,6 +1431,12 @@ class Function : public ilist_node_with_parent<Function, Module>, public Value {
   /// However this does not deallocate (destroy) the memory of this function.
   void eraseFromParentNoDestroy();
 
+  /// Erase all the basic blocks and instructions in this function, removing
+  /// their references to other values, but keep the function, its parameters
+  /// and its variables. This releases the memory of a body which is no longer
+  /// needed.
+  void eraseBody();
+
   /// \returns the original function name specified by the user,
   /// or if not specified, the inferred name.
   Identifier getOriginalOrInferredName() const {
@@ -1723,6 +1729,9 @@ class Module : public Value {
   /// true if all CJS modules have been resolved.
   bool cjsModulesResolved_{false};
 
+  /// true if the IR has been lowered for the bytecode backend.
+  bool lowered_{false};
+
   using CJSModuleUseGraph =
       std::unordered_map<Function *, llvm::SmallPtrSet<Function *, 2>>;
 
@@ -1886,6 +1895,16 @@ class Module : public Value {
     cjsModulesResolved_ = cjsModulesResolved;
   }
 
+  /// \return true if the IR has been lowered for the bytecode backend.
+  bool isLowered() const {
+    return lowered_;
+  }
+
+  /// Mark the IR as lowered for the bytecode backend.
+  void setLowered(bool lowered) {
+    lowered_ = lowered;
+  }
+
   /// \return the set of functions which are used by the modules in the segment
   /// specified by \p range. Order is unspecified, so the return value should
   /// not be used for iteration, only for checking membership.
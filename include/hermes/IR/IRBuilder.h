@@ -386,6 +386,16 @@ class IRBuilder {
 
   ThrowIfUndefinedInst *createThrowIfUndefinedInst(Value *checkedValue);
 
+  IteratorBeginInst *createIteratorBeginInst(AllocStackInst *sourceOrNext);
+
+  IteratorNextInst *createIteratorNextInst(
+      AllocStackInst *iterator,
+      AllocStackInst *sourceOrNext);
+
+  IteratorCloseInst *createIteratorCloseInst(
+      Value *iterator,
+      bool ignoreInnerException);
+
   HBCGetGlobalObjectInst *createHBCGetGlobalObjectInst();
 
   CreateRegExpInst *createRegExpInst(Identifier pattern, Identifier flags);
@@ -458,6 +468,8 @@ class IRBuilder {
   HBCLoadFromEnvironmentInst *createHBCLoadFromEnvironmentInst(
       Value *env,
       Variable *var);
+  HBCLoadFromOuterEnvironmentInst *createHBCLoadFromOuterEnvironmentInst(
+      Variable *var);
 
   SwitchImmInst *createSwitchImmInst(
       Value *input,
@@ -484,6 +496,12 @@ class IRBuilder {
 
   HBCReifyArgumentsInst *createHBCReifyArgumentsInst(AllocStackInst *lazyReg);
 
+  HBCCallApplyArgumentsInst *createHBCCallApplyArgumentsInst(
+      Value *callee,
+      Value *thisValue,
+      Value *thisArg,
+      AllocStackInst *lazyReg);
+
   HBCCreateThisInst *createHBCCreateThisInst(Value *prototype, Value *closure);
 
   HBCConstructInst *createHBCConstructInst(
@@ -494,6 +512,7 @@ class IRBuilder {
       HBCCreateThisInst *thisValue,
       HBCConstructInst *constructorReturnValue);
   HBCProfilePointInst *createHBCProfilePointInst(uint16_t pointIndex);
+  HBCTypeOfIsInst *createHBCTypeOfIsInst(Value *argument, uint8_t types);
 
   HBCCallBuiltinInst *createHBCCallBuiltinInst(
       int builtinIndex,
@@ -2426,6 +2426,140 @@ class ThrowIfUndefinedInst : public Instruction {
   }
 };
 
+/// Get the iterator of a for-of loop over the value stored in the stack
+/// location \p sourceOrNext. The result is opaque: it is either the iterator
+/// object, in which case its next() method is stored to \p sourceOrNext, or
+/// the state of an iteration which needs no iterator object, like the index
+/// of an array whose iteration hasn't been modified.
+class IteratorBeginInst : public Instruction {
+  IteratorBeginInst(const IteratorBeginInst &) = delete;
+  void operator=(const IteratorBeginInst &) = delete;
+
+ public:
+  enum { SourceOrNextIdx };
+
+  explicit IteratorBeginInst(AllocStackInst *sourceOrNext)
+      : Instruction(ValueKind::IteratorBeginInstKind) {
+    pushOperand(sourceOrNext);
+  }
+  explicit IteratorBeginInst(
+      const IteratorBeginInst *src,
+      llvm::ArrayRef<Value *> operands)
+      : Instruction(src, operands) {}
+
+  Value *getSourceOrNext() const {
+    return getOperand(SourceOrNextIdx);
+  }
+
+  SideEffectKind getSideEffect() {
+    return SideEffectKind::Unknown;
+  }
+
+  WordBitSet<> getChangedOperandsImpl() {
+    return WordBitSet<>{}.set(SourceOrNextIdx);
+  }
+
+  bool canSetOperandImpl(ValueKind kind, unsigned index) const {
+    return index == SourceOrNextIdx;
+  }
+
+  static bool classof(const Value *V) {
+    return kindIsA(V->getKind(), ValueKind::IteratorBeginInstKind);
+  }
+};
+
+/// Advance the iteration of a for-of loop. \p iterator and \p sourceOrNext
+/// are the stack locations holding the result of IteratorBeginInst and its
+/// updated source. The result is the next value, and \p iterator is set to
+/// undefined when the iteration is done.
+class IteratorNextInst : public Instruction {
+  IteratorNextInst(const IteratorNextInst &) = delete;
+  void operator=(const IteratorNextInst &) = delete;
+
+ public:
+  enum { IteratorIdx, SourceOrNextIdx };
+
+  explicit IteratorNextInst(
+      AllocStackInst *iterator,
+      AllocStackInst *sourceOrNext)
+      : Instruction(ValueKind::IteratorNextInstKind) {
+    pushOperand(iterator);
+    pushOperand(sourceOrNext);
+  }
+  explicit IteratorNextInst(
+      const IteratorNextInst *src,
+      llvm::ArrayRef<Value *> operands)
+      : Instruction(src, operands) {}
+
+  Value *getIterator() const {
+    return getOperand(IteratorIdx);
+  }
+  Value *getSourceOrNext() const {
+    return getOperand(SourceOrNextIdx);
+  }
+
+  SideEffectKind getSideEffect() {
+    return SideEffectKind::Unknown;
+  }
+
+  WordBitSet<> getChangedOperandsImpl() {
+    return WordBitSet<>{}.set(IteratorIdx);
+  }
+
+  bool canSetOperandImpl(ValueKind kind, unsigned index) const {
+    return index <= SourceOrNextIdx;
+  }
+
+  static bool classof(const Value *V) {
+    return kindIsA(V->getKind(), ValueKind::IteratorNextInstKind);
+  }
+};
+
+/// Call the return() method of the iterator of a for-of loop which is exited
+/// early. \p iterator is the result of IteratorBeginInst, and
+/// \p ignoreInnerException is true when the loop is exited by an exception,
+/// which takes precedence over the ones thrown while closing the iterator.
+class IteratorCloseInst : public Instruction {
+  IteratorCloseInst(const IteratorCloseInst &) = delete;
+  void operator=(const IteratorCloseInst &) = delete;
+
+ public:
+  enum { IteratorIdx, IgnoreInnerExceptionIdx };
+
+  explicit IteratorCloseInst(Value *iterator, LiteralBool *ignoreInnerException)
+      : Instruction(ValueKind::IteratorCloseInstKind) {
+    pushOperand(iterator);
+    pushOperand(ignoreInnerException);
+  }
+  explicit IteratorCloseInst(
+      const IteratorCloseInst *src,
+      llvm::ArrayRef<Value *> operands)
+      : Instruction(src, operands) {}
+
+  Value *getIterator() const {
+    return getOperand(IteratorIdx);
+  }
+  bool getIgnoreInnerException() const {
+    return cast<LiteralBool>(getOperand(IgnoreInnerExceptionIdx))->getValue();
+  }
+
+  SideEffectKind getSideEffect() {
+    return SideEffectKind::Unknown;
+  }
+
+  WordBitSet<> getChangedOperandsImpl() {
+    return {};
+  }
+
+  bool canSetOperandImpl(ValueKind kind, unsigned index) const {
+    return index <= IgnoreInnerExceptionIdx;
+  }
+
+  static bool classof(const Value *V) {
+    return kindIsA(V->getKind(), ValueKind::IteratorCloseInstKind);
+  }
+};
+
 class HBCResolveEnvironment : public SingleOperandInst {
   HBCResolveEnvironment(const HBCResolveEnvironment &) = delete;
   void operator=(const HBCResolveEnvironment &) = delete;
@@ -2561,6 +2695,48 @@ class HBCLoadFromEnvironmentInst : public Instruction {
   }
 };
 
+/// Load a variable from the environment of an enclosing function, fusing the
+/// HBCResolveEnvironment of its scope and the HBCLoadFromEnvironmentInst, for
+/// environments that are only used once.
+class HBCLoadFromOuterEnvironmentInst : public Instruction {
+  HBCLoadFromOuterEnvironmentInst(const HBCLoadFromOuterEnvironmentInst &) =
+      delete;
+  void operator=(const HBCLoadFromOuterEnvironmentInst &) = delete;
+
+ public:
+  enum { NameIdx };
+
+  explicit HBCLoadFromOuterEnvironmentInst(Variable *var)
+      : Instruction(ValueKind::HBCLoadFromOuterEnvironmentInstKind) {
+    pushOperand(var);
+  }
+  explicit HBCLoadFromOuterEnvironmentInst(
+      const HBCLoadFromOuterEnvironmentInst *src,
+      llvm::ArrayRef<Value *> operands)
+      : Instruction(src, operands) {}
+
+  Variable *getResolvedName() const {
+    return cast<Variable>(getOperand(NameIdx));
+  }
+
+  SideEffectKind getSideEffect() {
+    return SideEffectKind::MayRead;
+  }
+
+  WordBitSet<> getChangedOperandsImpl() {
+    return {};
+  }
+
+  bool canSetOperandImpl(ValueKind kind, unsigned index) const {
+    return index == NameIdx && kindIsA(kind, ValueKind::VariableKind);
+  }
+
+  static bool classof(const Value *V) {
+    return kindIsA(
+        V->getKind(), ValueKind::HBCLoadFromOuterEnvironmentInstKind);
+  }
+};
+
 class SwitchImmInst : public TerminatorInst {
   SwitchImmInst(const SwitchImmInst &) = delete;
   void operator=(const SwitchImmInst &) = delete;
@@ -2811,6 +2987,51 @@ class HBCProfilePointInst : public Instruction {
   }
 };
 
+/// Test whether `typeof` of a value is one of a set of results, given as
+/// inst::TypeOfIsTypes bits. Replaces the comparison of `typeof` with a
+/// string literal.
+class HBCTypeOfIsInst : public Instruction {
+  HBCTypeOfIsInst(const HBCTypeOfIsInst &) = delete;
+  void operator=(const HBCTypeOfIsInst &) = delete;
+
+ public:
+  enum { ArgumentIdx, TypesIdx };
+
+  explicit HBCTypeOfIsInst(Value *argument, LiteralNumber *types)
+      : Instruction(ValueKind::HBCTypeOfIsInstKind) {
+    setType(Type::createBoolean());
+    pushOperand(argument);
+    pushOperand(types);
+  }
+  explicit HBCTypeOfIsInst(
+      const HBCTypeOfIsInst *src,
+      llvm::ArrayRef<Value *> operands)
+      : Instruction(src, operands) {}
+
+  Value *getArgument() const {
+    return getOperand(ArgumentIdx);
+  }
+  LiteralNumber *getTypes() const {
+    return cast<LiteralNumber>(getOperand(TypesIdx));
+  }
+
+  SideEffectKind getSideEffect() {
+    return SideEffectKind::None;
+  }
+
+  WordBitSet<> getChangedOperandsImpl() {
+    return {};
+  }
+
+  bool canSetOperandImpl(ValueKind kind, unsigned index) const {
+    return index == ArgumentIdx;
+  }
+
+  static bool classof(const Value *V) {
+    return kindIsA(V->getKind(), ValueKind::HBCTypeOfIsInstKind);
+  }
+};
+
 class HBCLoadConstInst : public SingleOperandInst {
   HBCLoadConstInst(const HBCLoadConstInst &) = delete;
   void operator=(const HBCLoadConstInst &) = delete;
@@ -3030,6 +3251,65 @@ class HBCReifyArgumentsInst : public SingleOperandInst {
   }
 };
 
+/// Call a function, which is normally Function.prototype.apply, with the
+/// arguments (thisArg, arguments). This is how `fn.apply(thisArg, arguments)`
+/// forwards the arguments of the current function without reifying them, when
+/// the callee is the built-in apply.
+class HBCCallApplyArgumentsInst : public Instruction {
+  HBCCallApplyArgumentsInst(const HBCCallApplyArgumentsInst &) = delete;
+  void operator=(const HBCCallApplyArgumentsInst &) = delete;
+
+ public:
+  enum { CalleeIdx, ThisIdx, ThisArgIdx, LazyRegisterIdx };
+
+  explicit HBCCallApplyArgumentsInst(
+      Value *callee,
+      Value *thisValue,
+      Value *thisArg,
+      AllocStackInst *reg)
+      : Instruction(ValueKind::HBCCallApplyArgumentsInstKind) {
+    pushOperand(callee);
+    pushOperand(thisValue);
+    pushOperand(thisArg);
+    pushOperand(reg);
+  }
+  explicit HBCCallApplyArgumentsInst(
+      const HBCCallApplyArgumentsInst *src,
+      llvm::ArrayRef<Value *> operands)
+      : Instruction(src, operands) {}
+
+  Value *getCallee() const {
+    return getOperand(CalleeIdx);
+  }
+  Value *getThis() const {
+    return getOperand(ThisIdx);
+  }
+  Value *getThisArg() const {
+    return getOperand(ThisArgIdx);
+  }
+  Value *getLazyRegister() const {
+    return getOperand(LazyRegisterIdx);
+  }
+
+  SideEffectKind getSideEffect() {
+    return SideEffectKind::Unknown;
+  }
+
+  /// The arguments are reified into the lazy register when the callee is not
+  /// the built-in apply.
+  WordBitSet<> getChangedOperandsImpl() {
+    return WordBitSet<>{}.set(LazyRegisterIdx);
+  }
+
+  bool canSetOperandImpl(ValueKind kind, unsigned index) const {
+    return index <= LazyRegisterIdx;
+  }
+
+  static bool classof(const Value *V) {
+    return kindIsA(V->getKind(), ValueKind::HBCCallApplyArgumentsInstKind);
+  }
+};
+
 /// Create a 'this' object to be filled in by a constructor.
 class HBCCreateThisInst : public Instruction {
   HBCCreateThisInst(const HBCCreateThisInst &) = delete;
@@ -77,6 +77,19 @@ enum class OpCode : uint8_t {
 
 #include "hermes/BCGen/HBC/BytecodeList.def"
 
+/// The results of typeof tested by TypeOfIs, as a set of bits.
+enum TypeOfIsTypes : uint8_t {
+  TypeOfIsUndefined = 1 << 0,
+  /// Both objects which are not callable and null.
+  TypeOfIsObject = 1 << 1,
+  TypeOfIsString = 1 << 2,
+  TypeOfIsBoolean = 1 << 3,
+  TypeOfIsSymbol = 1 << 4,
+  TypeOfIsFunction = 1 << 5,
+  TypeOfIsNumber = 1 << 6,
+  TypeOfIsAny = (1 << 7) - 1,
+};
+
 /// A union of all instructions.
 LLVM_PACKED_START
 struct Inst {
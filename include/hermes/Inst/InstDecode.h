@@ -7,7 +7,8 @@
 //===----------------------------------------------------------------------===//
 /// \file
 /// Utilities for decoding instructions into a universal representation. To be
-/// used only for debugging.
+/// used only for debugging, except for the constexpr table of InstDescriptor,
+/// which is cheap enough for any code walking bytecode.
 //===----------------------------------------------------------------------===//
 #ifndef HERMES_INST_INSTDECODE_H
 #define HERMES_INST_INSTDECODE_H
@@ -33,6 +34,11 @@ inline constexpr bool isOperandTypeFloating(OperandType opType) {
 inline constexpr bool isOperandTypeInteger(OperandType opType) {
   return !isOperandTypeFloating(opType);
 }
+/// \return whether operands of type \p opType are jump offsets, relative to
+/// the start of their instruction.
+inline constexpr bool isOperandTypeAddr(OperandType opType) {
+  return opType == OperandType::Addr8 || opType == OperandType::Addr32;
+}
 
 /// The maximum number of operands used by any instruction.
 constexpr unsigned INST_MAX_OPERANDS = 6;
@@ -50,6 +56,132 @@ struct InstMetaData {
   OperandType operandType[INST_MAX_OPERANDS];
 };
 
+/// Flags in InstDescriptor::flags.
+enum InstFlags : uint8_t {
+  /// The instruction has an Addr8 or Addr32 operand, so it may continue at
+  /// another instruction of the function than the next one.
+  InstFlagBranch = 1 << 0,
+  /// The instruction never continues with the next instruction.
+  InstFlagTerminator = 1 << 1,
+};
+
+/// The static description of an opcode from BytecodeList.def, without the
+/// OpCode itself so that the table of all of them stays compact.
+struct InstDescriptor {
+  /// Size of the entire instruction in bytes.
+  uint8_t size;
+  /// Number of operands.
+  uint8_t numOperands;
+  /// The InstFlags of the instruction.
+  uint8_t flags;
+  /// The type of each operand. The unused ones are Reg8.
+  OperandType operandType[INST_MAX_OPERANDS];
+};
+
+namespace detail {
+/// \return whether \p opCode never continues with the next instruction,
+/// neither jumping anywhere nor returning.
+constexpr bool isTerminatorOpCode(OpCode opCode) {
+  return opCode == OpCode::Jmp || opCode == OpCode::JmpLong ||
+      opCode == OpCode::Ret || opCode == OpCode::Throw ||
+      opCode == OpCode::SwitchImm;
+}
+
+constexpr InstDescriptor makeInstDescriptor(
+    OpCode opCode,
+    uint8_t size,
+    uint8_t numOperands,
+    OperandType t1 = OperandType::Reg8,
+    OperandType t2 = OperandType::Reg8,
+    OperandType t3 = OperandType::Reg8,
+    OperandType t4 = OperandType::Reg8,
+    OperandType t5 = OperandType::Reg8,
+    OperandType t6 = OperandType::Reg8) {
+  return InstDescriptor{
+      size,
+      numOperands,
+      static_cast<uint8_t>(
+          (isTerminatorOpCode(opCode) ? InstFlagTerminator : 0) |
+          (isOperandTypeAddr(t1) || isOperandTypeAddr(t2) ||
+                   isOperandTypeAddr(t3) || isOperandTypeAddr(t4) ||
+                   isOperandTypeAddr(t5) || isOperandTypeAddr(t6)
+               ? InstFlagBranch
+               : 0)),
+      {t1, t2, t3, t4, t5, t6}};
+}
+
+struct InstDescriptorTable {
+  /// The descriptors of all opcodes, indexed by OpCode.
+  static constexpr InstDescriptor table[] = {
+#define DEFINE_OPCODE_0(name) \
+  makeInstDescriptor(OpCode::name, sizeof(name##Inst), 0),
+#define DEFINE_OPCODE_1(name, t1) \
+  makeInstDescriptor(OpCode::name, sizeof(name##Inst), 1, OperandType::t1),
+#define DEFINE_OPCODE_2(name, t1, t2) \
+  makeInstDescriptor(                 \
+      OpCode::name,                   \
+      sizeof(name##Inst),             \
+      2,                              \
+      OperandType::t1,                \
+      OperandType::t2),
+#define DEFINE_OPCODE_3(name, t1, t2, t3) \
+  makeInstDescriptor(                     \
+      OpCode::name,                       \
+      sizeof(name##Inst),                 \
+      3,                                  \
+      OperandType::t1,                    \
+      OperandType::t2,                    \
+      OperandType::t3),
+#define DEFINE_OPCODE_4(name, t1, t2, t3, t4) \
+  makeInstDescriptor(                         \
+      OpCode::name,                           \
+      sizeof(name##Inst),                     \
+      4,                                      \
+      OperandType::t1,                        \
+      OperandType::t2,                        \
+      OperandType::t3,                        \
+      OperandType::t4),
+#define DEFINE_OPCODE_5(name, t1, t2, t3, t4, t5) \
+  makeInstDescriptor(                             \
+      OpCode::name,                               \
+      sizeof(name##Inst),                         \
+      5,                                          \
+      OperandType::t1,                            \
+      OperandType::t2,                            \
+      OperandType::t3,                            \
+      OperandType::t4,                            \
+      OperandType::t5),
+#define DEFINE_OPCODE_6(name, t1, t2, t3, t4, t5, t6) \
+  makeInstDescriptor(                                 \
+      OpCode::name,                                   \
+      sizeof(name##Inst),                             \
+      6,                                              \
+      OperandType::t1,                                \
+      OperandType::t2,                                \
+      OperandType::t3,                                \
+      OperandType::t4,                                \
+      OperandType::t5,                                \
+      OperandType::t6),
+#include "hermes/BCGen/HBC/BytecodeList.def"
+  };
+};
+} // namespace detail
+
+/// \return the descriptor of \p opCode.
+inline constexpr const InstDescriptor &getInstDescriptor(OpCode opCode) {
+  return detail::InstDescriptorTable::table[(unsigned)opCode];
+}
+
+/// \return the size of the specified instruction in bytes.
+inline constexpr uint8_t getInstSize(OpCode opCode) {
+  return getInstDescriptor(opCode).size;
+}
+
+/// \return whether \p opCode has a jump offset operand.
+inline constexpr bool isBranchOpCode(OpCode opCode) {
+  return getInstDescriptor(opCode).flags & InstFlagBranch;
+}
+
 /// A union combining all possible types of operand values.
 union OperandValue {
   double floating;
@@ -73,9 +205,6 @@ struct DecodedInstruction {
   OperandValue operandValue[INST_MAX_OPERANDS];
 };
 
-/// \return the size of the specified instruction in bytes.
-uint8_t getInstSize(OpCode opCode);
-
 /// \return the size of the specified operand type in bytes.
 uint8_t getOperandSize(OperandType type);
 
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_OPTIMIZER_SCALAR_DEADMODULEELIMINATION_H
+#define HERMES_OPTIMIZER_SCALAR_DEADMODULEELIMINATION_H
+
+#include "hermes/Optimizer/PassManager/Pass.h"
+
+namespace hermes {
+
+/// Remove the bodies of the CommonJS modules that are never required,
+/// directly or indirectly, from the first module. This relies on every
+/// require() call having been resolved by ResolveStaticRequire.
+class DeadModuleElimination : public ModulePass {
+ public:
+  explicit DeadModuleElimination() : ModulePass("DeadModuleElimination") {}
+  ~DeadModuleElimination() override = default;
+
+  bool runOnModule(Module *M) override;
+};
+
+} // namespace hermes
+
+#endif // HERMES_OPTIMIZER_SCALAR_DEADMODULEELIMINATION_H
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_OPTIMIZER_SCALAR_SCALARREPLACEMENT_H
+#define HERMES_OPTIMIZER_SCALAR_SCALARREPLACEMENT_H
+
+#include "hermes/IR/IR.h"
+#include "hermes/Optimizer/PassManager/Pass.h"
+
+namespace hermes {
+
+/// Replace the properties of objects that do not escape with the values
+/// stored to them, and remove the objects.
+class ScalarReplacement : public FunctionPass {
+ public:
+  explicit ScalarReplacement() : FunctionPass("ScalarReplacement") {}
+  ~ScalarReplacement() override = default;
+
+  bool runOnFunction(Function *F) override;
+};
+
+} // namespace hermes
+
+#endif // HERMES_OPTIMIZER_SCALAR_SCALARREPLACEMENT_H
@@ -12,13 +12,15 @@
 
 namespace hermes {
 
-/// Eliminate TDZ checks dominated by the same TDZ check.
-class TDZDedup : public FunctionPass {
+/// Eliminate TDZ checks of variables which are known to be initialized on
+/// every path reaching them, including in closures which are only created
+/// after the variable has been initialized.
+class TDZDedup : public ModulePass {
  public:
-  explicit TDZDedup() : FunctionPass("TDZDedup") {}
+  explicit TDZDedup() : ModulePass("TDZDedup") {}
   ~TDZDedup() override = default;
 
-  bool runOnFunction(Function *F) override;
+  bool runOnModule(Module *M) override;
 };
 
 } // namespace hermes
@@ -67,6 +67,14 @@ MatchRuntimeResult searchWithBytecode(
     MatchResults<const char *> &m,
     constants::MatchFlagType matchFlags);
 
+/// Find which ASCII characters the Width1 instruction \p insn of the bytecode
+/// \p bytecode matches in a search of an ASCII string: set \p table[c] to 1
+/// if it matches the character c, and to 0 otherwise.
+void getWidth1ASCIITable(
+    llvm::ArrayRef<uint8_t> bytecode,
+    const Insn *insn,
+    uint8_t table[128]);
+
 } // namespace regex
 } // namespace hermes
 
@@ -9,6 +9,7 @@
 
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/ErrorHandling.h"
 
 #include <cstdint>
 #include <vector>
@@ -323,4 +324,24 @@ struct isa_impl<
   }
 };
 } // namespace llvm
+
+namespace hermes {
+namespace regex {
+
+/// \return the width in bytes of the instruction \p insn, not including the
+/// body of a Width1Loop or a Lookahead, which follows it.
+inline uint32_t insnWidth(const Insn *insn) {
+  if (const auto *bracket = llvm::dyn_cast<BracketInsn>(insn))
+    return bracket->totalWidth();
+  switch (insn->opcode) {
+#define REOP(code)   \
+  case Opcode::code: \
+    return sizeof(code##Insn);
+#include "hermes/Regex/RegexOpcodes.def"
+  }
+  llvm_unreachable("Invalid opcode");
+}
+
+} // namespace regex
+} // namespace hermes
 #endif // HERMES_REGEX_REGEXBYTECODE_H
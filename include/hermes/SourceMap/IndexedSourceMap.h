@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_SOURCEMAP_INDEXEDSOURCEMAP_H
+#define HERMES_SOURCEMAP_INDEXEDSOURCEMAP_H
+
+#include "hermes/SourceMap/SourceMapParser.h"
+
+#include "llvm/ADT/DenseMap.h"
+
+namespace hermes {
+
+/// A JavaScript version 3 source map whose mappings are only decoded when
+/// they are looked up, for symbolicating a few addresses with a large map.
+/// Creating it only finds where each line of the mappings starts. Looking up
+/// an address decodes its line, which is then kept for later lookups. Since
+/// the mappings are delta-encoded across lines, this also skips over the
+/// lines before it, without keeping their segments.
+///
+/// The line index can be written with writeIndex(), and read back with
+/// readIndex() without parsing the JSON or skipping over lines again.
+class IndexedSourceMap {
+ public:
+  /// Construct a source map from its \p sourceRoot, \p sources and the
+  /// contents of its "mappings" section \p mappings.
+  IndexedSourceMap(
+      std::string sourceRoot,
+      std::vector<std::string> sources,
+      std::string mappings);
+
+  /// Query source map text location for \p line and \p column.
+  /// In both the input and output of this function, Line and column numbers
+  /// are 1-based.
+  llvm::Optional<SourceMapTextLocation> getLocationForAddress(
+      uint32_t line,
+      uint32_t column);
+
+  /// Query the segment covering \p line and \p column, which are 1-based.
+  /// \return the segment, or nullptr if no segment covers the address, or if
+  ///   the mappings are malformed up to its line.
+  const SourceMap::Segment *getSegmentForAddress(
+      uint32_t line,
+      uint32_t column);
+
+  /// \return the number of lines in the mappings.
+  uint32_t getNumLines() const {
+    return lineStarts_.size();
+  }
+
+  /// \return source file path with root combined for source \p index.
+  std::string getSourceFullPath(uint32_t index) const {
+    assert(index < sources_.size() && "index out-of-range for sources_");
+    return sourceRoot_ + sources_[index];
+  }
+
+  /// Write the source map and its line index to \p OS in a binary format,
+  /// which is only meant to be read back by readIndex() of the same build.
+  void writeIndex(llvm::raw_ostream &OS);
+
+  /// Read a source map written by writeIndex() from \p data.
+  /// \return the source map, or nullptr if \p data is malformed.
+  static std::unique_ptr<IndexedSourceMap> readIndex(llvm::StringRef data);
+
+ private:
+  using State = SourceMapParser::State;
+
+  /// Decode line \p lineIndex of the mappings, delta-encoded from \p state,
+  /// and update \p state to be the state after it. Append its segments to
+  /// \p segments if it is not null.
+  /// \return false if the line is malformed.
+  bool decodeLine(
+      uint32_t lineIndex,
+      State &state,
+      SourceMap::SegmentList *segments) const;
+
+  /// \return the delta encoding state at the start of line \p lineIndex, or
+  ///   llvm::None if the mappings are malformed before it.
+  llvm::Optional<State> getLineStartState(uint32_t lineIndex);
+
+  /// \return the segments of line \p lineIndex, or nullptr if the mappings
+  ///   are malformed up to it.
+  const SourceMap::SegmentList *getLine(uint32_t lineIndex);
+
+  /// Prepended to the sources.
+  std::string sourceRoot_;
+
+  /// The list of sources, without sourceRoot_.
+  std::vector<std::string> sources_;
+
+  /// The encoded "mappings" section.
+  std::string mappings_;
+
+  /// The offset in mappings_ of the start of each line.
+  std::vector<uint32_t> lineStarts_{};
+
+  /// The delta encoding state at the start of the lines skipped over so far,
+  /// and of the line after them.
+  std::vector<State> lineStartStates_{State{}};
+
+  /// Whether skipping over the lines stopped at a malformed line.
+  bool malformed_{false};
+
+  /// The lines decoded so far.
+  llvm::DenseMap<uint32_t, SourceMap::SegmentList> decodedLines_{};
+};
+
+} // namespace hermes
+
+#endif // HERMES_SOURCEMAP_INDEXEDSOURCEMAP_H
@@ -102,6 +102,30 @@ class SourceMap {
       uint32_t line,
       uint32_t column);
 
+  /// Query the segment covering \p line and \p column, which are 1-based.
+  /// Unlike getLocationForAddress(), this does not allocate, so it is meant
+  /// for looking up many addresses.
+  /// \return the segment, or nullptr if no segment covers the address.
+  const Segment *getSegmentForAddress(uint32_t line, uint32_t column) const;
+
+  /// \return the last segment of \p segments starting at or before
+  /// \p column, which is 1-based, or nullptr if there is none.
+  static const Segment *findSegmentForColumn(
+      const SegmentList &segments,
+      uint32_t column);
+
+  /// \return the number of entries in the "sources" section.
+  uint32_t getNumSources() const {
+    return sources_.size();
+  }
+
+  /// \return source file path with root combined for source \p index.
+  std::string getSourceFullPath(uint32_t index) const {
+    assert(index < sources_.size() && "index out-of-range for sources_");
+    // TODO: more sophisticated path concat handling.
+    return sourceRoot_ + sources_[index];
+  }
+
   /// \return a list of original sources used by “mappings” entry.
   /// For testing.
   std::vector<std::string> getAllFullPathSources() const {
@@ -112,14 +136,6 @@ class SourceMap {
     return sourceFullPath;
   }
 
- private:
-  /// \return source file path with root combined for source \p index.
-  std::string getSourceFullPath(uint32_t index) const {
-    assert(index < sources_.size() && "index out-of-range for sources_");
-    // TODO: more sophisticated path concat handling.
-    return sourceRoot_ + sources_[index];
-  }
-
  private:
   /// An optional source root, useful for relocating source files on a server or
   /// removing repeated values in the “sources” entry.  This value is prepended
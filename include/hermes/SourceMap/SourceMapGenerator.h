@@ -11,6 +11,7 @@
 #include "hermes/Support/StringSetVector.h"
 
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
 
 namespace hermes {
 
@@ -71,49 +72,26 @@ class SourceMapGenerator {
     int32_t nameIndex = 0;
   };
 
-  /// Implementation of outputAsJSON for a merged source map generator.
-  void outputAsJSONImpl(llvm::raw_ostream &OS) const;
-
-  /// \return the mappings encoded in VLQ format.
-  std::string getVLQMappingsString() const;
-
   /// \return a list of sources, in order.
   /// This list refers to internals of the StringMap and is invalidated by
   /// addSource().
   std::vector<llvm::StringRef> getSources() const;
 
-  /// Encode the list \p segments into \p OS using the SourceMap
-  /// Base64-VLQ scheme, delta-encoded with \p lastState as the starting state.
-  static SourceMapGenerator::State encodeSourceLocations(
-      const SourceMapGenerator::State &lastState,
-      llvm::ArrayRef<SourceMap::Segment> segments,
+  /// Encode the segment \p seg into \p OS using the SourceMap Base64-VLQ
+  /// scheme, delta-encoded with \p state as the starting state, and update
+  /// \p state to be the state after \p seg.
+  static void encodeSegment(
+      SourceMapGenerator::State &state,
+      const SourceMap::Segment &seg,
       llvm::raw_ostream &OS);
 
-  /// Merge the input source maps with the state in this generator,
-  /// and return a new generator which contains a merged representation.
-  SourceMapGenerator mergedWithInputSourceMaps() const;
-
-  /// \return the input source map location for \p seg if the input source map
-  /// exists and has a valid location for \p seg, else return llvm::None.
-  llvm::Optional<SourceMapTextLocation> getInputLocationForSegment(
-      const SourceMap::Segment &seg) const {
-    if (seg.representedLocation.hasValue()) {
-      assert(
-          seg.representedLocation->sourceIndex >= 0 && "Negative source index");
-    }
-    // True iff inputSourceMaps_ has a valid source map for
-    // seg.representedLocation->sourceIndex.
-    bool hasInput = seg.representedLocation.hasValue() &&
-        (uint32_t)seg.representedLocation->sourceIndex <
-            inputSourceMaps_.size() &&
-        inputSourceMaps_[seg.representedLocation->sourceIndex] != nullptr;
-
-    return hasInput ? inputSourceMaps_[seg.representedLocation->sourceIndex]
-                          ->getLocationForAddress(
-                              seg.representedLocation->lineIndex + 1,
-                              seg.representedLocation->columnIndex + 1)
-                    : llvm::None;
-  }
+  /// Encode the mappings into \p OS using the SourceMap Base64-VLQ scheme,
+  /// writing \p translate(seg) in place of each segment seg. The segments are
+  /// encoded as they are translated, so no copy of the mappings is built.
+  void encodeMappings(
+      llvm::function_ref<SourceMap::Segment(const SourceMap::Segment &)>
+          translate,
+      llvm::raw_ostream &OS) const;
 
   /// The list of symbol names, populating the names field.
   std::vector<std::string> symbolNames_;
@@ -11,6 +11,8 @@
 
 namespace hermes {
 
+class IndexedSourceMap;
+
 /// JavaScript version 3 source map parser.
 /// See https://sourcemaps.info/spec.html for the spec that this class
 /// parses.
@@ -20,7 +22,15 @@ class SourceMapParser {
   /// Return nullptr on failure if malformed.
   static std::unique_ptr<SourceMap> parse(llvm::StringRef sourceMapContent);
 
+  /// Parse input \p sourceMapContent like parse(), but only find where the
+  /// lines of its mappings start. They are decoded when first looked up.
+  /// Return nullptr on failure if malformed.
+  static std::unique_ptr<IndexedSourceMap> parseIndexed(
+      llvm::StringRef sourceMapContent);
+
  private:
+  friend class IndexedSourceMap;
+
   /// Delta encoding state.
   struct State {
     int32_t generatedColumn = 0;
@@ -30,12 +40,26 @@ class SourceMapParser {
     int32_t nameIndex = 0;
   };
 
+  /// Parse the JSON of the source map \p sourceMapContent and call
+  /// \p onParsed with its source root, sources and "mappings" section.
+  /// \return false if the source map is malformed, else the result of
+  /// \p onParsed.
+  static bool parseJSON(
+      llvm::StringRef sourceMapContent,
+      llvm::function_ref<bool(
+          std::string &sourceRoot,
+          std::vector<std::string> &sources,
+          llvm::StringRef mappings)> onParsed);
+
   /// Parse "mappings" section from \p sourceMappings. The parsed line mappings
   /// are returned in \p lines.
   static bool parseMappings(
       llvm::StringRef sourceMappings,
       std::vector<SourceMap::SegmentList> &lines);
 
+  /// Update \p state to be the delta encoding state after \p segment.
+  static void updateState(State &state, const SourceMap::Segment &segment);
+
   /// Parse single segment in mapping.
   static llvm::Optional<SourceMap::Segment>
   parseSegment(const State &state, const char *&pCur, const char *pSegEnd);
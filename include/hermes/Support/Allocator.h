@@ -104,6 +104,12 @@ class BacktrackingBumpPtrAllocator {
     // then again so don't bother.
   }
 
+  /// \return the number of bytes in slabs. Slabs are kept when scopes are
+  /// popped, so this is the peak memory used outside of huge allocations.
+  size_t getSlabBytes() const {
+    return slabs_.size() * SlabSize;
+  }
+
   /// Allocate space for N elements of type T.
   template <typename T>
   inline T *Allocate(size_t num = 1, size_t alignment = sizeof(double)) {
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_SUPPORT_ASYNCOSTREAM_H
+#define HERMES_SUPPORT_ASYNCOSTREAM_H
+
+#include "llvm/Support/raw_ostream.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace hermes {
+
+/// A raw_ostream that collects what is written to it in memory and writes it
+/// to another stream from a writer thread, so that the thread producing the
+/// output doesn't wait for the I/O.  The writer wakes up periodically, and as
+/// soon as enough output is pending.  If the writer falls too far behind,
+/// writing blocks until it catches up, so that memory use stays bounded.
+/// Call sync() to wait until everything written so far is out; the
+/// destructor also does.  The other stream must not be used by anyone else
+/// between the creation of this stream and its destruction, except right
+/// after sync().
+class AsyncOStream : public llvm::raw_ostream {
+ public:
+  /// Write what is written to \p out, at least every \p interval.
+  explicit AsyncOStream(
+      llvm::raw_ostream &out,
+      std::chrono::milliseconds interval = std::chrono::milliseconds(50));
+  ~AsyncOStream() override;
+
+  /// Flush this stream, then wait until the writer has written everything to
+  /// the other stream and flushed it.
+  void sync();
+
+  /// Wake up the writer when this much output is pending.
+  static constexpr size_t kWakeSize = 64 * 1024;
+  /// Block writes while this much output is pending.
+  static constexpr size_t kMaxPendingSize = 16 * 1024 * 1024;
+
+ private:
+  void write_impl(const char *ptr, size_t size) override;
+  uint64_t current_pos() const override {
+    return pos_;
+  }
+
+  /// The body of the writer thread.
+  void run();
+
+  llvm::raw_ostream &out_;
+  const std::chrono::milliseconds interval_;
+  /// The number of bytes written to this stream and handed to the writer.
+  uint64_t pos_{0};
+
+  /// Protects the fields below.
+  std::mutex mutex_;
+  /// Signalled to wake up the writer.
+  std::condition_variable wakeWriter_;
+  /// Signalled by the writer after each write.
+  std::condition_variable written_;
+  /// The output not yet taken by the writer.
+  std::string pending_;
+  /// Whether the writer is writing output it has taken.
+  bool writing_{false};
+  /// Whether sync() is waiting for the writer to wake up.
+  bool syncing_{false};
+  /// Whether the writer must exit once everything is written.
+  bool stopping_{false};
+
+  std::thread writer_;
+};
+
+} // namespace hermes
+
+#endif // HERMES_SUPPORT_ASYNCOSTREAM_H
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_SUPPORT_CALLBACKOSTREAM_H
+#define HERMES_SUPPORT_CALLBACKOSTREAM_H
+
+#include "llvm/Support/raw_ostream.h"
+
+#include <functional>
+
+namespace hermes {
+
+/// A raw_ostream that hands what is written to it to a callback, in chunks of
+/// at most a fixed size, so that long outputs can be sent elsewhere (to a
+/// socket, a compressor, ...) without being held in memory as a whole.  At
+/// most one chunk is buffered at a time.  Call flush() to pass on what is
+/// still buffered; the destructor also does.
+class CallbackOStream : public llvm::raw_ostream {
+ public:
+  /// Called with \p size bytes of output at \p data, which are only valid for
+  /// the duration of the call.
+  using Callback = std::function<void(const char *data, size_t size)>;
+
+  /// Pass what is written to \p callback, in chunks of at most \p chunkSize
+  /// bytes, which must be greater than 0.
+  CallbackOStream(Callback callback, size_t chunkSize = kDefaultChunkSize);
+  ~CallbackOStream() override;
+
+  static constexpr size_t kDefaultChunkSize = 64 * 1024;
+
+ private:
+  void write_impl(const char *ptr, size_t size) override;
+  uint64_t current_pos() const override {
+    return pos_;
+  }
+
+  Callback callback_;
+  const size_t chunkSize_;
+  /// The number of bytes passed to the callback so far.
+  uint64_t pos_{0};
+};
+
+} // namespace hermes
+
+#endif // HERMES_SUPPORT_CALLBACKOSTREAM_H
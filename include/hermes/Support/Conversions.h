@@ -153,6 +153,114 @@ const size_t NUMBER_TO_STRING_BUF_SIZE = 32;
 /// \return the length of the generated string (excluding the terminating zero).
 size_t numberToString(double m, char *dest, size_t destSize);
 
+/// Convert \p mantissa * 10^\p exponent, where \p mantissa is not zero, to the
+/// nearest double, with the algorithm of Eisel and Lemire.
+/// \return the number, or llvm::None in the rare cases where the result can't
+///   be rounded correctly this way, or is subnormal or out of range, in which
+///   case g_strtod() must be used.
+OptValue<double> decimalToDoubleFast(uint64_t mantissa, int exponent);
+
+/// Convert the decimal literal in [\p first, \p last) to a double, when it
+/// has at most 19 significant digits, which fit in a 64-bit integer. The
+/// literal is an optional sign, digits with an optional decimal point and an
+/// optional exponent, without any whitespace. Literals with at most 15 digits
+/// and a power of ten up to 10^22 are converted exactly with a single
+/// multiplication or division, the others with decimalToDoubleFast().
+/// \return the number, or llvm::None if the literal isn't valid or can't be
+///   converted this way, in which case g_strtod() must be used.
+template <typename It>
+OptValue<double> parseDecimalFast(It first, It last) {
+  // The powers of ten which are exactly representable.
+  static constexpr double kPowersOfTen[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  const int kMaxPower = 22;
+  const int kMaxExactDigits = 15;
+  const int kMaxDigits = 19;
+
+  auto isDigit = [](decltype(*first) c) { return c >= '0' && c <= '9'; };
+
+  bool negative = false;
+  if (first != last && (*first == '-' || *first == '+')) {
+    negative = *first == '-';
+    ++first;
+  }
+
+  // The literal is mantissa * 10^exponent.
+  uint64_t mantissa = 0;
+  int exponent = 0;
+  int numDigits = 0;
+  bool sawDigit = false;
+  for (; first != last && isDigit(*first); ++first) {
+    sawDigit = true;
+    if (mantissa || *first != '0') {
+      if (++numDigits > kMaxDigits)
+        return llvm::None;
+      mantissa = mantissa * 10 + (*first - '0');
+    }
+  }
+  if (first != last && *first == '.') {
+    for (++first; first != last && isDigit(*first); ++first) {
+      sawDigit = true;
+      if (mantissa || *first != '0') {
+        if (++numDigits > kMaxDigits)
+          return llvm::None;
+        mantissa = mantissa * 10 + (*first - '0');
+      }
+      --exponent;
+    }
+  }
+  if (!sawDigit)
+    return llvm::None;
+
+  if (first != last && (*first == 'e' || *first == 'E')) {
+    ++first;
+    bool negativeExp = false;
+    if (first != last && (*first == '-' || *first == '+')) {
+      negativeExp = *first == '-';
+      ++first;
+    }
+    if (first == last)
+      return llvm::None;
+    int exp = 0;
+    for (; first != last && isDigit(*first); ++first) {
+      // Large exponents are left to g_strtod().
+      if (exp > 1000)
+        return llvm::None;
+      exp = exp * 10 + (*first - '0');
+    }
+    exponent += negativeExp ? -exp : exp;
+  }
+  if (first != last)
+    return llvm::None;
+
+  if (mantissa == 0)
+    return negative ? -0.0 : 0.0;
+
+  if (numDigits <= kMaxExactDigits) {
+    // Move the excess of a large exponent into the mantissa while it stays
+    // exact, as in 1e30 = 10^8 * 10^22.
+    if (exponent > kMaxPower &&
+        numDigits + exponent - kMaxPower <= kMaxExactDigits) {
+      mantissa *= (uint64_t)kPowersOfTen[exponent - kMaxPower];
+      exponent = kMaxPower;
+    }
+    if (exponent >= -kMaxPower && exponent <= kMaxPower) {
+      double result = (double)mantissa;
+      if (exponent >= 0)
+        result *= kPowersOfTen[exponent];
+      else
+        result /= kPowersOfTen[-exponent];
+      return negative ? -result : result;
+    }
+  }
+
+  auto result = decimalToDoubleFast(mantissa, exponent);
+  if (!result)
+    return llvm::None;
+  return negative ? -*result : *result;
+}
+
 /// Takes a letter (a-z or A-Z) and makes it lowercase.
 inline char charLetterToLower(char ch) {
   return ch | 32;
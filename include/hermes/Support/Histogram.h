@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_SUPPORT_HISTOGRAM_H
+#define HERMES_SUPPORT_HISTOGRAM_H
+
+#include "hermes/Support/StatsAccumulator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace hermes {
+
+/// Counts samples in buckets with fixed bounds, along with their summary
+/// statistics.  Bucket i holds the samples at most upperBound(i) and greater
+/// than the bound of the bucket before it; the last bucket holds the samples
+/// greater than every bound.  Recording a sample is a binary search over the
+/// bounds.
+class Histogram {
+ public:
+  /// \return a histogram with \p count bounds: \p first, then each bound
+  /// \p factor times the previous one.
+  static Histogram exponential(double first, double factor, unsigned count) {
+    std::vector<double> bounds;
+    for (double bound = first; bounds.size() < count; bound *= factor)
+      bounds.push_back(bound);
+    return Histogram(std::move(bounds));
+  }
+
+  /// \return a histogram with \p count bounds, \p width apart and starting at
+  /// \p width.
+  static Histogram linear(double width, unsigned count) {
+    std::vector<double> bounds;
+    for (unsigned i = 1; i <= count; ++i)
+      bounds.push_back(width * i);
+    return Histogram(std::move(bounds));
+  }
+
+  /// Create a histogram with the given upper bounds, which must be sorted.
+  explicit Histogram(std::vector<double> upperBounds)
+      : upperBounds_(std::move(upperBounds)),
+        counts_(upperBounds_.size() + 1, 0) {
+    assert(
+        std::is_sorted(upperBounds_.begin(), upperBounds_.end()) &&
+        "bounds must be sorted");
+  }
+
+  /// Add \p value to the histogram.
+  void record(double value) {
+    auto it =
+        std::lower_bound(upperBounds_.begin(), upperBounds_.end(), value);
+    ++counts_[it - upperBounds_.begin()];
+    stats_.record(value);
+  }
+
+  /// \return the number of buckets, including the one for the samples
+  /// greater than every bound.
+  unsigned numBuckets() const {
+    return counts_.size();
+  }
+
+  /// \return the upper bound of bucket \p i, which must not be the last one.
+  double upperBound(unsigned i) const {
+    return upperBounds_[i];
+  }
+
+  /// \return the number of samples in bucket \p i.
+  uint64_t count(unsigned i) const {
+    return counts_[i];
+  }
+
+  /// \return the summary statistics of all the samples.
+  const StatsAccumulator<double> &stats() const {
+    return stats_;
+  }
+
+ private:
+  std::vector<double> upperBounds_;
+  std::vector<uint64_t> counts_;
+  StatsAccumulator<double> stats_;
+};
+
+} // namespace hermes
+
+#endif // HERMES_SUPPORT_HISTOGRAM_H
@@ -7,8 +7,47 @@
 #ifndef HERMES_SUPPORT_JSON_H
 #define HERMES_SUPPORT_JSON_H
 
+#include "hermes/Support/StringSearch.h"
+
 namespace hermes {
 
+/// Appends \p ch to \p output, escaped as it has to be in a JSON string.
+template <typename Output>
+void appendCharForJSON(Output &output, char16_t ch) {
+#define ESCAPE(ch, replace)    \
+  case ch:                     \
+    output.push_back(u'\\');   \
+    output.push_back(replace); \
+    break
+
+  switch (ch) {
+    // Quote.2.a.
+    ESCAPE(u'\\', u'\\');
+    ESCAPE(u'"', u'"');
+    // Quote.2.b.
+    ESCAPE(u'\b', u'b');
+    ESCAPE(u'\f', u'f');
+    ESCAPE(u'\n', u'n');
+    ESCAPE(u'\r', u'r');
+    ESCAPE(u'\t', u't');
+    default:
+      if (ch < u' ') {
+        // Quote.2.c.
+        output.append({u'\\', u'u', u'0', u'0'});
+        output.push_back(u'0' + (ch / 16));
+        if (ch % 16 < 10) {
+          output.push_back(u'0' + (ch % 16));
+        } else {
+          output.push_back(u'a' + (ch % 16 - 10));
+        }
+      } else {
+        // Quote.2.d.
+        output.push_back(ch);
+      }
+  }
+#undef ESCAPE
+}
+
 /// Quotes a string given by \p view and puts the quoted version into \p output.
 /// \p view should be utf16-encoded, and \p output will be as well.
 /// \post output is a container that has a sequential list of utf16 characters
@@ -19,37 +58,28 @@ void quoteStringForJSON(Output &output, StringView view) {
   output.push_back(u'"');
   // Quote.2.
   for (char16_t ch : view) {
-#define ESCAPE(ch, replace)    \
-  case ch:                     \
-    output.push_back(u'\\');   \
-    output.push_back(replace); \
-    break
+    appendCharForJSON(output, ch);
+  }
+  // Quote.3.
+  output.push_back(u'"');
+}
 
-    switch (ch) {
-      // Quote.2.a.
-      ESCAPE(u'\\', u'\\');
-      ESCAPE(u'"', u'"');
-      // Quote.2.b.
-      ESCAPE(u'\b', u'b');
-      ESCAPE(u'\f', u'f');
-      ESCAPE(u'\n', u'n');
-      ESCAPE(u'\r', u'r');
-      ESCAPE(u'\t', u't');
-      default:
-        if (ch < u' ') {
-          // Quote.2.c.
-          output.append({u'\\', u'u', u'0', u'0'});
-          output.push_back(u'0' + (ch / 16));
-          if (ch % 16 < 10) {
-            output.push_back(u'0' + (ch % 16));
-          } else {
-            output.push_back(u'a' + (ch % 16 - 10));
-          }
-        } else {
-          // Quote.2.d.
-          output.push_back(ch);
-        }
+/// Like quoteStringForJSON, for the contiguous string \p str, whose runs of
+/// characters that need no escaping are found a chunk at a time and appended
+/// at once.
+template <typename Output, typename CharT>
+void quoteStringRefForJSON(Output &output, llvm::ArrayRef<CharT> str) {
+  // Quote.1.
+  output.push_back(u'"');
+  // Quote.2.
+  for (;;) {
+    size_t run = findJSONEscape(str);
+    output.append(str.begin(), str.begin() + run);
+    if (run == str.size()) {
+      break;
     }
+    appendCharForJSON(output, str[run]);
+    str = str.drop_front(run + 1);
   }
   // Quote.3.
   output.push_back(u'"');
@@ -10,6 +10,7 @@
 #include <cstdint>
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/raw_ostream.h"
@@ -79,6 +80,12 @@ class JSONEmitter {
     emitValue(llvm::StringRef(val));
   }
 
+  /// Emit a string whose contents are written to the stream by \p contents,
+  /// without building it in memory first. The contents are not escaped, so
+  /// they must be printable ASCII, and not contain '"', '\\' or '/'.
+  void emitRawStringValue(
+      llvm::function_ref<void(llvm::raw_ostream &)> contents);
+
   /// Emit a null as value.
   void emitNullValue();
 
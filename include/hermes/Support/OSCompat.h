@@ -91,16 +91,17 @@ void vm_prefetch(void *p, size_t sz);
 /// for a process (e.g. by /proc/<pid>/maps).
 void vm_name(void *p, size_t sz, const char *name);
 
-enum class ProtectMode { ReadWrite };
+enum class ProtectMode { ReadWrite, None };
 
 /// Set the \p sz byte region of memory starting at \p p to the specified
 /// \p mode. \p p must be page-aligned. \return true if successful,
 /// false on error.
 bool vm_protect(void *p, size_t sz, ProtectMode mode);
 
-/// Issue an madvise() call.
+/// Issue an madvise() call. HugePage asks for the region to be backed by
+/// transparent huge pages, and fails where they are not supported.
 /// \return true on success, false on error.
-enum class MAdvice { Random, Sequential };
+enum class MAdvice { Random, Sequential, HugePage };
 bool vm_madvise(void *p, size_t sz, MAdvice advice);
 
 /// Return the number of pages in the given region that are currently in RAM.
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_SUPPORT_STRINGSEARCH_H
+#define HERMES_SUPPORT_STRINGSEARCH_H
+
+#include "llvm/ADT/ArrayRef.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/// Search and comparison of strings of char or char16_t, examining 16 bytes at
+/// a time where SSE2 or NEON is available. Strings of char are expected to
+/// only contain ASCII characters, which compare equal to the same char16_t.
+namespace hermes {
+
+/// Returned by findSubstring() and findLastSubstring() when there is no match.
+constexpr size_t kSubstringNotFound = SIZE_MAX;
+
+/// \return the first index at which the \p length characters at \p a and
+///   \p b differ, or \p length if they are all the same.
+size_t findMismatch(const char *a, const char *b, size_t length);
+size_t findMismatch(const char16_t *a, const char16_t *b, size_t length);
+size_t findMismatch(const char *a, const char16_t *b, size_t length);
+inline size_t findMismatch(const char16_t *a, const char *b, size_t length) {
+  return findMismatch(b, a, length);
+}
+
+/// \return the index of the first occurrence of \p needle in \p haystack that
+///   starts at or after \p start, or kSubstringNotFound. An empty needle is
+///   found at \p start if it is not past the end of \p haystack.
+size_t findSubstring(
+    llvm::ArrayRef<char> haystack,
+    llvm::ArrayRef<char> needle,
+    size_t start = 0);
+size_t findSubstring(
+    llvm::ArrayRef<char16_t> haystack,
+    llvm::ArrayRef<char16_t> needle,
+    size_t start = 0);
+
+/// \return the index of the last occurrence of \p needle in \p haystack that
+///   starts at or before \p start, or kSubstringNotFound.
+size_t findLastSubstring(
+    llvm::ArrayRef<char> haystack,
+    llvm::ArrayRef<char> needle,
+    size_t start = SIZE_MAX);
+size_t findLastSubstring(
+    llvm::ArrayRef<char16_t> haystack,
+    llvm::ArrayRef<char16_t> needle,
+    size_t start = SIZE_MAX);
+
+/// \return the index of the first character of \p str that has to be escaped
+///   in a JSON string: a control character, '"' or '\\'. \return the size of
+///   \p str if there is none.
+size_t findJSONEscape(llvm::ArrayRef<char> str);
+size_t findJSONEscape(llvm::ArrayRef<char16_t> str);
+
+/// \return the index of the first occurrence of \p c in \p str at or after
+///   \p start, or the size of \p str if there is none.
+size_t findCharacter(llvm::ArrayRef<char> str, char c, size_t start = 0);
+size_t
+findCharacter(llvm::ArrayRef<char16_t> str, char16_t c, size_t start = 0);
+
+/// \return the index of the first character of \p str at or after \p start
+///   that is not an ASCII letter or digit, or the size of \p str if there is
+///   none.
+size_t findNonAlphanumeric(llvm::ArrayRef<char> str, size_t start = 0);
+size_t findNonAlphanumeric(llvm::ArrayRef<char16_t> str, size_t start = 0);
+
+} // namespace hermes
+
+#endif // HERMES_SUPPORT_STRINGSEARCH_H
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_SUPPORT_XORSHIFT128PLUS_H
+#define HERMES_SUPPORT_XORSHIFT128PLUS_H
+
+#include <cstdint>
+#include <limits>
+
+namespace hermes {
+
+/// The xorshift128+ pseudo-random number generator. It has a period of
+/// 2^128 - 1 and passes BigCrush, and each number only costs a few shifts and
+/// xors on its 16 bytes of state, which is what Math.random() needs.
+/// It is not suitable for cryptography.
+/// It satisfies UniformRandomBitGenerator, so it can also be used with the
+/// distributions of <random>.
+class XorShift128Plus {
+ public:
+  using result_type = uint64_t;
+
+  explicit XorShift128Plus(uint64_t s = 0) {
+    seed(s);
+  }
+
+  /// Reset the state from \p s. The seed is expanded with SplitMix64, so that
+  /// similar seeds give unrelated sequences and the state is never all zeros.
+  void seed(uint64_t s) {
+    state0_ = splitMix64(s);
+    state1_ = splitMix64(s);
+  }
+
+  /// \return the next 64 random bits.
+  uint64_t next() {
+    uint64_t s1 = state0_;
+    uint64_t s0 = state1_;
+    state0_ = s0;
+    s1 ^= s1 << 23;
+    s1 ^= s1 >> 17;
+    s1 ^= s0;
+    s1 ^= s0 >> 26;
+    state1_ = s1;
+    return state0_ + state1_;
+  }
+
+  /// \return a number uniformly chosen from [0, 1), from the top 53 bits of
+  ///   the next number, one for each bit of the significand.
+  double nextDouble() {
+    return (next() >> 11) * (1.0 / (UINT64_C(1) << 53));
+  }
+
+  uint64_t operator()() {
+    return next();
+  }
+  static constexpr uint64_t min() {
+    return 0;
+  }
+  static constexpr uint64_t max() {
+    return std::numeric_limits<uint64_t>::max();
+  }
+
+ private:
+  /// Advance \p x and \return the next number of SplitMix64 from it.
+  static uint64_t splitMix64(uint64_t &x) {
+    uint64_t z = (x += UINT64_C(0x9E3779B97F4A7C15));
+    z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+    return z ^ (z >> 31);
+  }
+
+  uint64_t state0_;
+  uint64_t state1_;
+};
+
+} // namespace hermes
+
+#endif // HERMES_SUPPORT_XORSHIFT128PLUS_H
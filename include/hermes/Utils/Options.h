@@ -7,6 +7,9 @@
 #ifndef HERMES_UTILS_OPTIONS_H
 #define HERMES_UTILS_OPTIONS_H
 
+#include <cstdint>
+#include <vector>
+
 namespace hermes {
 
 enum OutputFormatKind {
@@ -53,6 +56,16 @@ struct BytecodeGenerationOptions {
   /// Add this much garbage after each function body (relative to its size).
   unsigned padFunctionBodiesPercent = 0;
 
+  /// Register allocation of functions with at least this many instructions
+  /// uses conservative live intervals computed in a single scan, instead of
+  /// solving liveness, whose cost grows with blocks times instructions.
+  unsigned linearScanThreshold = 20000;
+
+  /// The IDs of the functions whose bodies and info are laid out first, in
+  /// this order, e.g. the order in which they were first touched at startup.
+  /// The other functions follow in ID order. Unknown IDs are ignored.
+  std::vector<uint32_t> functionOrder{};
+
   /* implicit */ BytecodeGenerationOptions(OutputFormatKind format)
       : format(format) {}
 
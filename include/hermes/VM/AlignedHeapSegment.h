@@ -220,6 +220,11 @@ class AlignedHeapSegment final {
   template <AdviseUnused MU = AdviseUnused::No>
   void resetLevel();
 
+  /// Return the pages between the level and the end of the allocation region
+  /// to the OS, for example once pages freed with AdviseUnused::No are not
+  /// expected to be reused soon.
+  void markUnusedAboveLevel();
+
   /// Increase the size of the allocation region in this segment by the minimum
   /// amount such that this.size() >= desired.
   ///
@@ -253,6 +258,16 @@ class AlignedHeapSegment final {
   /// max size of markStack sets a flag and returns.
   void completeMarking(GC *gc, CompleteMarkState *markState);
 
+  /// Like completeMarking, but only visits the marked cells that start in
+  /// [\p low, \p high), which must both lie within the allocated region of one
+  /// segment.  On return, the finger in \p markState is \p high, so that
+  /// cells below it that are marked later get pushed on the mark stack.
+  static void completeMarkingInRange(
+      GC *gc,
+      CompleteMarkState *markState,
+      char *low,
+      char *high);
+
   /// Assumes marking is complete.  Scans the heap, determining, for each live
   /// object, the address to which it will later be compacted.  Objects are
   /// compacted into chunks, in the order they are provided by
@@ -267,6 +282,10 @@ class AlignedHeapSegment final {
   /// subsequent heap traversals.
   void sweepAndInstallForwardingPointers(GC *gc, SweepResult *sweepResult);
 
+  /// Like sweepAndInstallForwardingPointers, but the live objects are not
+  /// moved: their forwarding pointers point to themselves.
+  void sweepInPlace(GC *gc, SweepResult *sweepResult);
+
   /// Assumes sweeping is complete.  Traverses the live objects, scanning their
   /// pointers.  For each pointer to another heap object, update the pointer by
   /// following the referent's forwarding pointer.  Marked cells are considered
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_VM_ALLOCATIONSITE_H
+#define HERMES_VM_ALLOCATIONSITE_H
+
+#include <cstdint>
+
+namespace hermes {
+namespace vm {
+
+/// Feedback about how long the objects created by one instruction live.  A
+/// site starts out tracking: the GC records whether its objects survive the
+/// young-gen collection that follows their allocation.  After kNumSamples of
+/// them, it decides once and for all whether the site is pretenured, that is
+/// whether its objects are allocated directly in the old generation.
+class AllocationSite {
+ public:
+  /// The number of objects whose fate is recorded before deciding.
+  static constexpr uint32_t kNumSamples = 128;
+
+  /// The percentage of the sampled objects that must survive for the site to
+  /// be pretenured.
+  static constexpr uint32_t kPretenureSurvivalPct = 85;
+
+  /// \return true if the objects of this site should be allocated in the old
+  ///   generation.
+  bool isPretenured() const {
+    return state_ == State::Pretenured;
+  }
+
+  /// \return true if the GC should record the fate of an object just
+  ///   allocated by this site, in which case it must call recordFate() for it
+  ///   later.
+  bool wantsSample() {
+    if (state_ != State::Tracking || numPending_ + numSampled_ >= kNumSamples)
+      return false;
+    ++numPending_;
+    return true;
+  }
+
+  /// Record whether a sampled object \p survived its first young-gen
+  /// collection.  \return true if this made the site pretenured.
+  bool recordFate(bool survived) {
+    --numPending_;
+    ++numSampled_;
+    numSurvived_ += survived;
+    if (state_ != State::Tracking || numSampled_ < kNumSamples)
+      return false;
+    state_ = numSurvived_ * 100 >= numSampled_ * kPretenureSurvivalPct
+        ? State::Pretenured
+        : State::YoungGen;
+    return state_ == State::Pretenured;
+  }
+
+  /// Forget a sampled object whose fate the GC could not record.
+  void dropSample() {
+    --numPending_;
+  }
+
+ private:
+  enum class State : uint8_t {
+    /// Sampling the objects of the site.
+    Tracking,
+    /// Allocating in the old generation.
+    Pretenured,
+    /// Allocating in the young generation; too many of the objects die young.
+    YoungGen,
+  };
+
+  State state_{State::Tracking};
+
+  /// Number of sampled objects whose fate is not known yet.
+  uint32_t numPending_{0};
+
+  /// Number of sampled objects whose fate is known.
+  uint32_t numSampled_{0};
+
+  /// Number of the sampled objects that survived.
+  uint32_t numSurvived_{0};
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_ALLOCATIONSITE_H
@@ -299,6 +299,58 @@ class Callable : public JSObject {
       Runtime *runtime);
 };
 
+/// Calls the same Callable repeatedly with the same "this" argument and number
+/// of arguments, like the callbacks of Array.prototype.forEach() and similar
+/// built-ins. The native call frame is allocated and checked for overflow only
+/// once, when the RepeatedCall is constructed; each call just initializes the
+/// frame again and stores the arguments.
+/// Like a ScopedNativeCallFrame, the frame stays on the register stack until
+/// the RepeatedCall is destroyed, so it must be a local variable.
+class RepeatedCall {
+ public:
+  RepeatedCall(
+      Runtime *runtime,
+      Handle<Callable> callee,
+      Handle<> thisArg,
+      uint32_t argCount)
+      : runtime_(runtime),
+        callee_(callee),
+        thisArg_(thisArg),
+        frame_(runtime, argCount, *callee, false, *thisArg) {
+    // A GC may happen before the first call, so the arguments must be valid.
+    if (LLVM_LIKELY(!frame_.overflowed()))
+      frame_.fillArguments(argCount, HermesValue::encodeUndefinedValue());
+  }
+
+  RepeatedCall(const RepeatedCall &) = delete;
+  void operator=(const RepeatedCall &) = delete;
+
+  /// Call the callee with the arguments \p args, which must be as many as the
+  /// \c argCount passed to the constructor.
+  template <typename... Args>
+  CallResult<HermesValue> call(const Args &... args) {
+    if (LLVM_UNLIKELY(frame_.overflowed()))
+      return runtime_->raiseStackOverflow(
+          Runtime::StackOverflowKind::NativeStack);
+    frame_.reinitialize(
+        callee_.getHermesValue(),
+        HermesValue::encodeUndefinedValue(),
+        *thisArg_);
+    assert(
+        sizeof...(Args) == frame_->getArgCount() && "argument count mismatch");
+    const HermesValue argValues[] = {args...};
+    for (uint32_t i = 0; i < sizeof...(Args); ++i)
+      frame_->getArgRef(i) = argValues[i];
+    return Callable::call(callee_, runtime_);
+  }
+
+ private:
+  Runtime *const runtime_;
+  Handle<Callable> callee_;
+  Handle<> thisArg_;
+  ScopedNativeCallFrame frame_;
+};
+
 /// A function produced by Function.prototype.bind(). It packages a function
 /// with values for some of its parameters.
 class BoundFunction final : public Callable {
@@ -469,6 +521,11 @@ class NativeFunction : public Callable {
     auto t1 = HERMESVM_RDTSC();
 #endif
 
+    // Charge the call to the JS function that made it.
+    ScopedTimeAttribution timeScope(
+        runtime->getTimeAttribution(),
+        nullptr,
+        FunctionTimeAttribution::Category::Native);
     auto res =
         self->functionPtr_(self->context_, runtime, newFrame.getNativeArgs());
 
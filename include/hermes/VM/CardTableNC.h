@@ -12,6 +12,7 @@
 #include "hermes/VM/GCCell.h"
 
 #include <cassert>
+#include <cstdint>
 
 namespace hermes {
 namespace vm {
@@ -27,6 +28,10 @@ namespace vm {
 /// object whose extent [obj-start, end) contains the start of the card.  This
 /// allows us to scan dirty cards: finding the crossing object allows us to then
 /// do object-to-object traversal to the end of the card.
+///
+/// The cards are summarized by a bitmap with one bit per kCardsPerSummaryBit
+/// cards, set when any of them may be dirty, so that finding the dirty cards
+/// of a mostly clean table does not read every card.
 class CardTable {
  public:
   /// Points at the start of a card.
@@ -61,6 +66,9 @@ class CardTable {
   static constexpr size_t kValidIndices =
       AlignedStorage::size() >> kLogCardSize;
 
+  /// The number of cards covered by each bit of the summary bitmap.
+  static constexpr size_t kCardsPerSummaryBit = 64;
+
   CardTable() = default;
 
   /// CardTable is not copyable or movable: It must be constructed in-place.
@@ -204,8 +212,33 @@ class CardTable {
 
   void cleanOrDirtyRange(size_t from, size_t to, CardStatus cleanOrDirty);
 
+  /// The number of cards in a word, for scanning them a word at a time.
+  static constexpr size_t kCardsPerWord = sizeof(uint64_t);
+  static_assert(
+      kCardsPerSummaryBit % kCardsPerWord == 0,
+      "A summary bit must cover whole words of cards");
+
+  /// The number of bits, and words, of the summary bitmap.
+  static constexpr size_t kSummaryBits =
+      (kValidIndices + kCardsPerSummaryBit - 1) / kCardsPerSummaryBit;
+  static constexpr size_t kSummaryWords = (kSummaryBits + 63) / 64;
+
+  /// Set the summary bits of the cards [from, to].
+  inline void setSummaryBits(size_t from, size_t to);
+
+  /// \return the index of the first dirty card in [fromIndex, endIndex),
+  /// reading only the cards whose summary bit is set.
+  OptValue<size_t> findNextDirtyCardSummarized(
+      size_t fromIndex,
+      size_t endIndex) const;
+
   CardStatus cards_[kValidIndices]{};
 
+  /// Bit i of the summary is set if any of the cards [i * kCardsPerSummaryBit,
+  /// (i + 1) * kCardsPerSummaryBit) may be dirty: it is set when one of them
+  /// is dirtied, and only cleared when all of them are cleaned.
+  uint64_t summary_[kSummaryWords]{};
+
   /// Each card has a corresponding signed byte in the boundaries_ table.  A
   /// non-negative entry, K, indicates that the crossing object starts K *
   /// HeapAlign bytes before the start of the card. A negative entry, L,
@@ -254,7 +287,9 @@ inline const char *CardTable::indexToAddress(size_t index) const {
 }
 
 inline void CardTable::dirtyCardForAddress(const void *addr) {
-  cards_[addressToIndex(addr)] = CardStatus::Dirty;
+  size_t index = addressToIndex(addr);
+  cards_[index] = CardStatus::Dirty;
+  setSummaryBits(index, index);
 }
 
 inline bool CardTable::isCardForAddressDirty(const void *addr) const {
@@ -269,7 +304,7 @@ inline bool CardTable::isCardForIndexDirty(size_t index) const {
 inline OptValue<size_t> CardTable::findNextDirtyCard(
     size_t fromIndex,
     size_t endIndex) const {
-  return findNextCardWithStatus(CardStatus::Dirty, fromIndex, endIndex);
+  return findNextDirtyCardSummarized(fromIndex, endIndex);
 }
 
 inline OptValue<size_t> CardTable::findNextCleanCard(
@@ -286,6 +321,14 @@ inline CardTable::Boundary CardTable::nextBoundary(const char *level) const {
   return {ix, addr};
 }
 
+inline void CardTable::setSummaryBits(size_t from, size_t to) {
+  for (size_t bit = from / kCardsPerSummaryBit, last = to / kCardsPerSummaryBit;
+       bit <= last;
+       ++bit) {
+    summary_[bit / 64] |= uint64_t(1) << (bit % 64);
+  }
+}
+
 inline const char *CardTable::base() const {
   // As we know the card table is laid out inline before the allocation region
   // of its aligned heap segment, we can use its own this pointer as the base
@@ -12,16 +12,23 @@
 #include "hermes/BCGen/HBC/BytecodeProviderFromSrc.h"
 #include "hermes/Inst/Inst.h"
 #include "hermes/Support/SourceErrorManager.h"
+#include "hermes/VM/AllocationSite.h"
 #include "hermes/VM/Debugger/Debugger.h"
 #include "hermes/VM/HermesValue.h"
 #include "hermes/VM/IdentifierTable.h"
 #include "hermes/VM/Profiler.h"
+#include "hermes/VM/Profiler/FunctionProfiler.h"
 #include "hermes/VM/PropertyCache.h"
 #include "hermes/VM/SerializedLiteralParser.h"
+#include "hermes/VM/TypeFeedback.h"
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/Support/TrailingObjects.h"
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -36,8 +43,26 @@ typedef CallResult<HermesValue> (*JITCompiledFunctionPtr)(Runtime *runtime);
 
 /// A sequence of instructions representing the body of a function.
 class CodeBlock final
-    : private llvm::TrailingObjects<CodeBlock, PropertyCacheEntry> {
+    : private llvm::TrailingObjects<
+          CodeBlock,
+          PolyPropertyCacheEntry,
+          ProtoPropertyCacheEntry> {
   friend TrailingObjects;
+  // The fields read on every call come first, so that entering a function
+  // touches a single cache line of its CodeBlock and doesn't read the function
+  // header, which lives in the bytecode file and, for the functions whose
+  // header overflowed, in a separate part of it.
+
+  /// Pointer to the bytecode opcodes.
+  const uint8_t *bytecode_;
+
+  /// Copies of the header fields used when entering the function. See
+  /// setHeader().
+  uint32_t frameSize_;
+  uint32_t paramCount_;
+  uint32_t environmentSize_;
+  hbc::FunctionHeaderFlag headerFlags_;
+
   /// Points to the runtime module with the information required for this code
   /// block.
   RuntimeModule *const runtimeModule_;
@@ -45,24 +70,63 @@ class CodeBlock final
   /// Pointer to the function header.
   hbc::RuntimeFunctionHeader functionHeader_;
 
-  /// Pointer to the bytecode opcodes.
-  const uint8_t *bytecode_;
-
   /// ID of this function in the module's function list.
   uint32_t functionID_;
 
+  /// Number of times this function was entered by the interpreter, for the
+  /// function profile. Unlike executionCount_, it is never reset by the JIT.
+  uint32_t invocationCount_ = 0;
+
+  /// The value of invocationCount_ at the last call to checkIdle().
+  uint32_t invocationCountAtIdleCheck_ = 0;
+
+  /// Number of function profile ticks taken while this function was
+  /// executing. See FunctionProfiler.
+  uint32_t profileSamples_ = 0;
+
+  /// Nanoseconds charged to this function by FunctionTimeAttribution, per
+  /// category. Only allocated for the functions that are charged.
+  std::unique_ptr<
+      std::array<uint64_t, FunctionTimeAttribution::kNumCategories>>
+      attributedTime_;
+
+  /// The bytecode offsets reached by a branch, or on entry, while code
+  /// coverage was being collected, one bit per byte of bytecode. Only
+  /// allocated for the functions that ran. See CodeCoverage.
+  std::unique_ptr<llvm::BitVector> coverage_;
+
 #ifdef HERMESVM_JIT
   /// Set to true if for some reason we don't want to JIT this block, for
-  /// example because it contains constructs that the JIT can't handle.
-  bool dontJIT_ = false;
+  /// example because it contains constructs that the JIT can't handle. It may
+  /// be set by the background compilation thread.
+  std::atomic<bool> dontJIT_{false};
+
+  /// Set to true once this block has been handed to the background
+  /// compilation thread, so it is queued only once. The thread clears it
+  /// when the block must be queued again.
+  std::atomic<bool> JITQueued_{false};
 
-  /// If this CodeBlock was compiled, a pointer to the body.
-  JITCompiledFunctionPtr JITCompiled_ = nullptr;
+  /// If this CodeBlock was compiled, a pointer to the body. It is published
+  /// last, after the OSR entries, so that a reader which sees it non-null can
+  /// also see the rest of the compiled state.
+  std::atomic<JITCompiledFunctionPtr> JITCompiled_{nullptr};
 
   /// Function execution count.
-  /// Ideally, a function's hotness should also include if it has a loop and how
-  /// hot that loop is.
   uint32_t executionCount_ = 0;
+
+  /// Number of loop back-edges taken while interpreting this function, so that
+  /// a function which is called rarely but has a hot loop is still considered
+  /// hot.
+  uint32_t backEdgeCount_ = 0;
+
+  /// Value of the JIT's use clock when the native code was last entered, used
+  /// to evict the least recently used code first.
+  uint32_t JITLastUse_ = 0;
+
+  /// Entry points into the compiled body at loop headers, keyed by the bytecode
+  /// offset of the header. They let a loop that became hot in the interpreter
+  /// continue in native code.
+  llvm::DenseMap<uint32_t, JITCompiledFunctionPtr> osrEntries_{};
 #endif
 
   /// Total size of the property cache.
@@ -72,6 +136,36 @@ class CodeBlock final
   /// cache.
   const uint32_t writePropCacheOffset_;
 
+  /// Hit/miss counters for the property caches of this function.
+  PropertyCacheStats propertyCacheStats_{};
+
+  /// Lifetime feedback for the instructions of this function that create
+  /// literal objects and arrays, keyed by bytecode offset.  The sites are
+  /// allocated separately because the GC keeps pointers to them.
+  llvm::DenseMap<uint32_t, std::unique_ptr<AllocationSite>> allocationSites_{};
+
+  /// The types observed by the slow paths of the instructions of this
+  /// function. Only allocated for the functions that took a slow path, and
+  /// only modified while the function is not queued for compilation, so the
+  /// background compiler can read it.
+  std::unique_ptr<TypeFeedbackVector> typeFeedback_{};
+
+  /// The ranges of bytecode covered by exception handlers, made disjoint and
+  /// sorted by start so that findCatchTargetOffset() can binary search them.
+  /// Each range maps to the innermost handler covering it. Empty if the
+  /// function has no handlers.
+  std::vector<hbc::HBCExceptionHandlerInfo> handlerIndex_{};
+
+#ifdef HERMESVM_INDIRECT_THREADING
+  /// The direct-threaded form of the bytecode, built on first use. See
+  /// getThreadedCode().
+  std::unique_ptr<void *[]> threadedCode_{};
+
+  /// The handlers threadedCode_ was built from, so that installing and
+  /// uninstalling breakpoints can patch it along with the bytecode.
+  void *const *threadedHandlers_{nullptr};
+#endif
+
 #ifndef HERMESVM_LEAN
   /// Compiles a lazy CodeBlock. Intended to be called from lazyCompile.
   void lazyCompileImpl(Runtime *runtime);
@@ -83,12 +177,22 @@ class CodeBlock final
   SourceErrorManager::SourceCoords getLazyFunctionLoc(bool start) const;
 
   /// \return the base pointer of the property cache.
-  PropertyCacheEntry *propertyCache() {
-    return getTrailingObjects<PropertyCacheEntry>();
+  PolyPropertyCacheEntry *propertyCache() {
+    return getTrailingObjects<PolyPropertyCacheEntry>();
+  }
+
+  PolyPropertyCacheEntry *writePropertyCache() {
+    return getTrailingObjects<PolyPropertyCacheEntry>() + writePropCacheOffset_;
+  }
+
+  /// \return the base pointer of the prototype-chain cache, which has one
+  /// entry per read property cache entry.
+  ProtoPropertyCacheEntry *protoPropertyCache() {
+    return getTrailingObjects<ProtoPropertyCacheEntry>();
   }
 
-  PropertyCacheEntry *writePropertyCache() {
-    return getTrailingObjects<PropertyCacheEntry>() + writePropCacheOffset_;
+  size_t numTrailingObjects(OverloadToken<PolyPropertyCacheEntry>) const {
+    return propertyCacheSize_;
   }
 
   CodeBlock(
@@ -98,15 +202,33 @@ class CodeBlock final
       uint32_t functionID,
       uint32_t cacheSize,
       uint32_t writePropCacheOffset)
-      : runtimeModule_(runtimeModule),
+      : bytecode_(bytecode),
+        runtimeModule_(runtimeModule),
         functionHeader_(header),
-        bytecode_(bytecode),
         functionID_(functionID),
         propertyCacheSize_(cacheSize),
         writePropCacheOffset_(writePropCacheOffset) {
-    std::uninitialized_fill_n(propertyCache(), cacheSize, PropertyCacheEntry{});
+    std::uninitialized_fill_n(
+        propertyCache(), cacheSize, PolyPropertyCacheEntry{});
+    std::uninitialized_fill_n(
+        protoPropertyCache(), writePropCacheOffset, ProtoPropertyCacheEntry{});
+    setHeader(header);
+    buildHandlerIndex();
   }
 
+  /// Point functionHeader_ to \p header and copy the fields used on calls.
+  void setHeader(hbc::RuntimeFunctionHeader header) {
+    functionHeader_ = header;
+    frameSize_ = header.frameSize();
+    paramCount_ = header.paramCount();
+    environmentSize_ = header.environmentSize();
+    headerFlags_ = header.flags();
+  }
+
+  /// Populate handlerIndex_ from the exception table of the function. It is
+  /// built eagerly, since the background compiler also reads it.
+  void buildHandlerIndex();
+
  public:
 #if defined(HERMESVM_PROFILER_JSFUNCTION) || defined(HERMESVM_PROFILER_EXTERN)
   /// ID written/read by JS function profiler on first/later function events.
@@ -125,7 +247,9 @@ class CodeBlock final
       uint32_t functionID,
       uint32_t cacheSize,
       uint32_t writePropCacheOffset) {
-    auto allocSize = totalSizeToAlloc<PropertyCacheEntry>(cacheSize);
+    auto allocSize =
+        totalSizeToAlloc<PolyPropertyCacheEntry, ProtoPropertyCacheEntry>(
+            cacheSize, writePropCacheOffset);
     void *mem = checkedMalloc(allocSize);
     return new (mem) CodeBlock(
         runtimeModule,
@@ -145,13 +269,13 @@ class CodeBlock final
   using const_iterator = const uint8_t *;
 
   uint32_t getParamCount() const {
-    return functionHeader_.paramCount();
+    return paramCount_;
   }
   uint32_t getFrameSize() const {
-    return functionHeader_.frameSize();
+    return frameSize_;
   }
   uint32_t getEnvironmentSize() const {
-    return functionHeader_.environmentSize();
+    return environmentSize_;
   }
   uint32_t getFunctionID() const {
     return functionID_;
@@ -160,7 +284,13 @@ class CodeBlock final
   /// Given the offset of the instruction where exception happened,
   /// \returns the offset of the exception handler to jump to.
   /// \returns -1 if a handler is not found.
-  int32_t findCatchTargetOffset(uint32_t exceptionOffset);
+  int32_t findCatchTargetOffset(uint32_t exceptionOffset) const;
+
+  /// \return true if the function has any exception handler, so that frames
+  /// without one can be unwound without a lookup.
+  bool hasExceptionHandlers() const {
+    return !handlerIndex_.empty();
+  }
 
   /// \return the offset of the function in a virtual bytecode stream, in which
   /// each function emits its bytecode in order. This is used for error
@@ -182,11 +312,11 @@ class CodeBlock final
   }
 
   hbc::FunctionHeaderFlag getHeaderFlags() const {
-    return functionHeader_.flags();
+    return headerFlags_;
   }
 
   bool isStrictMode() const {
-    return functionHeader_.flags().strictMode;
+    return headerFlags_.strictMode;
   }
 
   SymbolID getNameMayAllocate() const;
@@ -258,23 +388,36 @@ class CodeBlock final
 #ifdef HERMESVM_JIT
   /// \return true if JIT is disabled for this function.
   bool getDontJIT() const {
-    return dontJIT_;
+    return dontJIT_.load(std::memory_order_relaxed);
   }
 
   /// Enable or disable JIT compilation of this function.
   void setDontJIT(bool dontJIT) {
-    dontJIT_ = dontJIT;
+    dontJIT_.store(dontJIT, std::memory_order_relaxed);
+  }
+
+  /// \return true if this function is waiting to be compiled in the
+  ///   background.
+  bool getJITQueued() const {
+    return JITQueued_.load(std::memory_order_relaxed);
+  }
+
+  /// Record that this function has been queued for background compilation.
+  void setJITQueued(bool queued) {
+    JITQueued_.store(queued, std::memory_order_relaxed);
   }
 
   /// \return the native code for this function, or null if it hasn't been
   ///   compiled to native.
   JITCompiledFunctionPtr getJITCompiled() const {
-    return JITCompiled_;
+    return JITCompiled_.load(std::memory_order_acquire);
   }
 
-  /// Set the native code for this function.
+  /// Set the native code for this function. Everything else describing the
+  /// compiled code must already be set, since this makes it visible to the
+  /// interpreter thread.
   void setJITCompiled(JITCompiledFunctionPtr JITCompiled) {
-    JITCompiled_ = JITCompiled;
+    JITCompiled_.store(JITCompiled, std::memory_order_release);
   }
 
   /// Increment the function execution count.
@@ -291,6 +434,53 @@ class CodeBlock final
   void clearExecutionCount() {
     executionCount_ = 0;
   }
+
+  /// Set the function execution count to \p count.
+  void setExecutionCount(uint32_t count) {
+    executionCount_ = count;
+  }
+
+  /// Increment the number of loop back-edges taken.
+  void incrementBackEdgeCount() {
+    backEdgeCount_++;
+  }
+
+  /// \return the number of loop back-edges taken.
+  uint32_t getBackEdgeCount() const {
+    return backEdgeCount_;
+  }
+
+  /// Reset the number of loop back-edges taken to 0.
+  void clearBackEdgeCount() {
+    backEdgeCount_ = 0;
+  }
+
+  /// Record that the native code was entered at \p useClock.
+  void setJITLastUse(uint32_t useClock) {
+    JITLastUse_ = useClock;
+  }
+
+  /// \return the use clock when the native code was last entered.
+  uint32_t getJITLastUse() const {
+    return JITLastUse_;
+  }
+
+  /// \return the native entry point which continues the compiled body at the
+  ///   loop header at bytecode \p offset, or null if there isn't one.
+  JITCompiledFunctionPtr getOSREntry(uint32_t offset) const {
+    auto it = osrEntries_.find(offset);
+    return it != osrEntries_.end() ? it->second : nullptr;
+  }
+
+  /// Set the native entry point for the loop header at bytecode \p offset.
+  void setOSREntry(uint32_t offset, JITCompiledFunctionPtr entry) {
+    osrEntries_[offset] = entry;
+  }
+
+  /// Forget all OSR entries, once the native code has been freed.
+  void clearOSREntries() {
+    osrEntries_.clear();
+  }
 #else
   /// \return true if JIT is disabled for this function.
   bool getDontJIT() const {
@@ -300,6 +490,15 @@ class CodeBlock final
   /// Enable or disable JIT compilation of this function.
   void setDontJIT(bool dontJIT) {}
 
+  /// \return true if this function is waiting to be compiled in the
+  ///   background, as false if the JIT is not enabled.
+  bool getJITQueued() const {
+    return false;
+  }
+
+  /// Record that this function has been queued for background compilation.
+  void setJITQueued(bool queued) {}
+
   /// \return the native code for this function, or null if it hasn't been
   ///   compiled to native.
   JITCompiledFunctionPtr getJITCompiled() const {
@@ -319,14 +518,52 @@ class CodeBlock final
 
   /// Reset the function executionCount_ count to 0
   void clearExecutionCount() {}
+
+  /// Increment the number of loop back-edges taken.
+  void incrementBackEdgeCount() {}
+
+  /// \return the number of loop back-edges taken as 0 if the JIT is not
+  ///   enabled.
+  uint32_t getBackEdgeCount() const {
+    return 0;
+  }
+
+  /// Reset the number of loop back-edges taken to 0.
+  void clearBackEdgeCount() {}
+
+  /// Record that the native code was entered at \p useClock.
+  void setJITLastUse(uint32_t useClock) {}
+
+  /// \return the use clock when the native code was last entered, as 0 if
+  ///   the JIT is not enabled.
+  uint32_t getJITLastUse() const {
+    return 0;
+  }
+
+  /// \return the native entry point for the loop header at bytecode \p offset
+  ///   as null if the JIT is not enabled.
+  JITCompiledFunctionPtr getOSREntry(uint32_t offset) const {
+    return nullptr;
+  }
+
+  /// Set the native entry point for the loop header at bytecode \p offset.
+  void setOSREntry(uint32_t offset, JITCompiledFunctionPtr entry) {}
+
+  /// Forget all OSR entries.
+  void clearOSREntries() {}
 #endif
 
-  inline PropertyCacheEntry *getReadCacheEntry(uint8_t idx) {
+  inline PolyPropertyCacheEntry *getReadCacheEntry(uint8_t idx) {
     assert(idx < writePropCacheOffset_ && "idx out of ReadCache bound");
     return &propertyCache()[idx];
   }
 
-  inline PropertyCacheEntry *getWriteCacheEntry(uint8_t idx) {
+  inline ProtoPropertyCacheEntry *getProtoCacheEntry(uint8_t idx) {
+    assert(idx < writePropCacheOffset_ && "idx out of ReadCache bound");
+    return &protoPropertyCache()[idx];
+  }
+
+  inline PolyPropertyCacheEntry *getWriteCacheEntry(uint8_t idx) {
     assert(
         writePropCacheOffset_ + idx < propertyCacheSize_ &&
         "idx out of WriteCache bound");
@@ -336,6 +573,169 @@ class CodeBlock final
   // Mark all hidden classes in the property cache as roots.
   void markCachedHiddenClasses(SlotAcceptor &acceptor);
 
+  /// \return the property cache counters of this function.
+  const PropertyCacheStats &getPropertyCacheStats() const {
+    return propertyCacheStats_;
+  }
+
+  /// Record a property cache hit.
+  void recordPropertyCacheHit() {
+    ++propertyCacheStats_.hits;
+  }
+
+  /// Record a property cache miss on \p entry, distinguishing misses on
+  /// megamorphic sites.
+  void recordPropertyCacheMiss(const PolyPropertyCacheEntry *entry) {
+    if (LLVM_UNLIKELY(entry->megamorphic))
+      ++propertyCacheStats_.megamorphicMisses;
+    else
+      ++propertyCacheStats_.misses;
+  }
+
+  /// Record an entry into this function.
+  void incrementInvocationCount() {
+    ++invocationCount_;
+  }
+
+  /// \return the number of entries into this function.
+  uint32_t getInvocationCount() const {
+    return invocationCount_;
+  }
+
+  /// \return whether the interpreter hasn't entered this function since the
+  ///   previous call, and start a new period.
+  bool checkIdle() {
+    bool idle = invocationCount_ == invocationCountAtIdleCheck_;
+    invocationCountAtIdleCheck_ = invocationCount_;
+    return idle;
+  }
+
+  /// Free the data derived from the bytecode which is rebuilt on demand: the
+  /// threaded code and the type feedback. The function must not be executing,
+  /// nor be compiled or queued for compilation.
+  /// \return the number of bytes freed.
+  size_t releaseDerivedData();
+
+  /// Record a function profile tick taken while executing this function.
+  void incrementProfileSamples() {
+    ++profileSamples_;
+  }
+
+  /// \return the number of function profile ticks taken in this function.
+  uint32_t getProfileSamples() const {
+    return profileSamples_;
+  }
+
+  /// Charge \p nanos to \p category of this function's time.
+  void addAttributedTime(
+      FunctionTimeAttribution::Category category,
+      uint64_t nanos) {
+    if (!attributedTime_) {
+      attributedTime_.reset(
+          new std::array<uint64_t, FunctionTimeAttribution::kNumCategories>{});
+    }
+    (*attributedTime_)[static_cast<unsigned>(category)] += nanos;
+  }
+
+  /// \return the nanoseconds charged to \p category of this function's time.
+  uint64_t getAttributedTime(FunctionTimeAttribution::Category category) const {
+    return attributedTime_
+        ? (*attributedTime_)[static_cast<unsigned>(category)]
+        : 0;
+  }
+
+  /// \return the nanoseconds charged to this function in all categories.
+  uint64_t getTotalAttributedTime() const {
+    uint64_t total = 0;
+    if (attributedTime_) {
+      for (uint64_t nanos : *attributedTime_)
+        total += nanos;
+    }
+    return total;
+  }
+
+  /// Reset the function profile counters to 0.
+  void clearFunctionProfile() {
+    invocationCount_ = 0;
+    profileSamples_ = 0;
+    attributedTime_.reset();
+  }
+
+  /// Record for the code coverage that execution reached bytecode \p offset.
+  void markCovered(uint32_t offset) {
+    if (LLVM_UNLIKELY(!coverage_))
+      coverage_.reset(
+          new llvm::BitVector(functionHeader_.bytecodeSizeInBytes()));
+    coverage_->set(offset);
+  }
+
+  /// \return the offsets recorded by markCovered(), or null if none were.
+  const llvm::BitVector *getCoverage() const {
+    return coverage_.get();
+  }
+
+  /// Forget the recorded code coverage.
+  void clearCoverage() {
+    coverage_.reset();
+  }
+
+  /// \return the allocation site of the instruction at bytecode \p offset,
+  ///   creating it the first time.
+  AllocationSite *getAllocationSite(uint32_t offset) {
+    auto &site = allocationSites_[offset];
+    if (LLVM_UNLIKELY(!site))
+      site.reset(new AllocationSite());
+    return site.get();
+  }
+
+  /// Add \p types to the types observed by the instruction at bytecode
+  /// \p offset, unless the function is queued for compilation.
+  void recordTypeFeedback(Runtime *runtime, uint32_t offset, uint8_t types) {
+    if (getJITQueued())
+      return;
+    if (LLVM_UNLIKELY(!typeFeedback_))
+      createTypeFeedback(runtime);
+    typeFeedback_->record(offset, types);
+  }
+
+  /// \return the type feedback of this function, or nullptr if none was
+  ///   recorded.
+  const TypeFeedbackVector *getTypeFeedback() const {
+    return typeFeedback_.get();
+  }
+
+  /// \return the types observed by the instruction at bytecode \p offset.
+  uint8_t getTypeFeedback(uint32_t offset) const {
+    return typeFeedback_ ? typeFeedback_->getTypes(offset) : 0;
+  }
+
+  /// \return whether the arithmetic instruction at \p offset was executed
+  ///   with operands that are not numbers.
+  bool isGenericArithmetic(uint32_t offset) const {
+    return getTypeFeedback(offset) & ~FeedbackNumber;
+  }
+
+  /// Allocate typeFeedback_, with a slot for every feedback site of the
+  /// bytecode.
+  void createTypeFeedback(Runtime *runtime);
+
+#ifdef HERMESVM_INDIRECT_THREADING
+  /// \return the direct-threaded form of the bytecode: one entry per byte of
+  /// bytecode, holding the address of the interpreter handler of the
+  /// instruction that starts at that offset, so that dispatching doesn't need
+  /// to decode the opcode. It is built by the first call from \p handlers,
+  /// the addresses of the handlers indexed by opcode.
+  void *const *getThreadedCode(Runtime *runtime, void *const *handlers) {
+    if (LLVM_UNLIKELY(!threadedCode_))
+      buildThreadedCode(runtime, handlers);
+    return threadedCode_.get();
+  }
+
+  /// Build threadedCode_ from \p handlers. Breakpoints installed in
+  /// \p runtime's debugger keep the Debugger handler.
+  void buildThreadedCode(Runtime *runtime, void *const *handlers);
+#endif
+
   static CodeBlock *createCodeBlock(
       RuntimeModule *runtimeModule,
       hbc::RuntimeFunctionHeader header,
@@ -345,7 +745,16 @@ class CodeBlock final
   /// \return an estimate of the size of additional memory used by this
   /// CodeBlock.
   size_t additionalMemorySize() const {
-    return propertyCacheSize_ * sizeof(PropertyCacheEntry);
+    size_t size = propertyCacheSize_ * sizeof(PolyPropertyCacheEntry) +
+        writePropCacheOffset_ * sizeof(ProtoPropertyCacheEntry);
+    if (typeFeedback_)
+      size += typeFeedback_->size() * (sizeof(uint32_t) + sizeof(uint8_t));
+    size += handlerIndex_.capacity() * sizeof(hbc::HBCExceptionHandlerInfo);
+#ifdef HERMESVM_INDIRECT_THREADING
+    if (threadedCode_)
+      size += getOpcodeArray().size() * sizeof(void *);
+#endif
+    return size;
   }
 
 #ifdef HERMES_ENABLE_DEBUGGER
@@ -10,15 +10,19 @@
 #ifdef HERMES_ENABLE_DEBUGGER
 
 #include "hermes/BCGen/HBC/Bytecode.h"
+#include "hermes/BCGen/HBC/BytecodeDataProvider.h"
 #include "hermes/BCGen/HBC/DebugInfo.h"
 #include "hermes/Inst/Inst.h"
 #include "hermes/Public/DebuggerTypes.h"
 #include "hermes/Support/OptValue.h"
+#include "hermes/Support/ScopeChain.h"
+#include "hermes/VM/CallResult.h"
 #include "hermes/VM/Debugger/DebugCommand.h"
 #include "hermes/VM/HermesValue.h"
 #include "hermes/VM/InterpreterState.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/MapVector.h"
+#include "llvm/ADT/StringMap.h"
 
 #include <cstdint>
 #include <string>
@@ -159,6 +163,14 @@ class Debugger {
   /// and the debugger should stop on entering any code blocks.
   bool pauseOnAllCodeBlocks_{false};
 
+  /// The maximum number of entries of evalCache_, which is simply cleared
+  /// when it is full.
+  static constexpr unsigned kMaxEvalCacheSize = 64;
+
+  /// Compiled eval expressions, such as breakpoint conditions and watches,
+  /// keyed by the variables in scope and the source. See getEvalBytecode().
+  llvm::StringMap<std::shared_ptr<hbc::BCProvider>> evalCache_{};
+
   /// What conditions the debugger needs to stop on exceptions.
   PauseOnThrowMode pauseOnThrowMode_{PauseOnThrowMode::None};
 
@@ -467,6 +479,13 @@ class Debugger {
       const InterpreterState &state,
       EvalResultMetadata *outMetadata);
 
+  /// \return the bytecode of \p src compiled to be evaluated in a scope with
+  /// the variables of \p scopeChain, from evalCache_ if it was compiled for
+  /// the same names before, or raise a SyntaxError.
+  CallResult<std::shared_ptr<hbc::BCProvider>> getEvalBytecode(
+      const std::string &src,
+      const ScopeChain &scopeChain);
+
   /// Given that the runtime threw an exception, clear the thrown value, and
   /// populate the \p outMetadata. \return the thrown value.
   HermesValue getExceptionAsEvalResult(EvalResultMetadata *outMetadata);
@@ -539,7 +558,11 @@ class Debugger {
   /// the jump target.
   void breakAtJumpTarget(InterpreterState &state);
 
-  /// Set breakpoints at all possible next instructions after the current one.
+  /// Set breakpoints at all possible next instructions after the current one
+  /// where the step in progress may finish: the jump target of the current
+  /// instruction, and the first instruction after it that starts another
+  /// statement or may transfer control. The instructions in between can't
+  /// finish the step, so they run without stopping.
   void breakAtPossibleNextInstructions(InterpreterState &state);
 };
 
@@ -41,14 +41,17 @@ namespace vm {
 /// deleted and invalid properties, preserving the original insertion order.
 ///
 /// The object has to be reallocated when any of these conditions occur:
-/// - the descriptor array is full (it never shrinks, even after deletions)
+/// - the descriptor array is full (deletions don't free descriptors)
 /// - the hash table occupancy is above a certain threshold (note that deletions
 ///   don't decrease the hash table occupancy).
 ///
 /// Reallocation first scans the descriptor array and inserts valid (and not
 /// deleted) properties in the new hash table and descriptor array. We must also
 /// preserve the list of deleted properties, so then it walks the deleted list
-/// and appends the descriptors to the new desctiptor array.
+/// and appends the descriptors to the new desctiptor array. The invalid
+/// descriptors and the deleted hash entries are dropped, so the new capacity
+/// is derived from the number of descriptors which are kept: the map doubles
+/// when they are all kept, and is compacted, or even shrinks, otherwise.
 ///
 /// A property descriptor is always in one of these states:
 ///  - "uninitialized". It is beyond \c numDescriptors.
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_VM_EVALCACHE_H
+#define HERMES_VM_EVALCACHE_H
+
+#include "hermes/BCGen/HBC/BytecodeDataProvider.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace hermes {
+namespace vm {
+
+/// A cache of the bytecode compiled by eval() and the Function constructor,
+/// keyed by the source and the flags which affect compilation, so that code
+/// which evaluates the same source repeatedly only compiles it once. The
+/// bytecode can be run any number of times, each run creating its own
+/// RuntimeModule. The memory held by the cache is bounded by a budget
+/// covering the source and the bytecode of each entry; when it is exceeded,
+/// the least recently used entries are evicted.
+class EvalCache {
+ public:
+  /// Create a cache holding at most \p maxBytes of source and bytecode. If it
+  /// is 0, nothing is cached.
+  explicit EvalCache(size_t maxBytes) : maxBytes_(maxBytes) {}
+  EvalCache(const EvalCache &) = delete;
+  void operator=(const EvalCache &) = delete;
+
+  /// \return the bytecode compiled from \p source with \p flags, or nullptr if
+  ///   it isn't cached.
+  std::shared_ptr<hbc::BCProvider> find(
+      llvm::StringRef source,
+      uint8_t flags) {
+    if (map_.empty())
+      return nullptr;
+    auto it = map_.find(Key{source, flags});
+    if (it == map_.end())
+      return nullptr;
+    // Move the entry to the front of the list.
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->bytecode;
+  }
+
+  /// Record that \p bytecode, which takes \p bytecodeSize bytes, was compiled
+  /// from \p source with \p flags, evicting the least recently used entries
+  /// until the cache fits in its budget. Entries larger than the whole budget
+  /// are not cached.
+  void insert(
+      llvm::StringRef source,
+      uint8_t flags,
+      std::shared_ptr<hbc::BCProvider> bytecode,
+      size_t bytecodeSize) {
+    size_t size = source.size() + bytecodeSize;
+    if (size > maxBytes_)
+      return;
+    auto it = map_.find(Key{source, flags});
+    if (it != map_.end()) {
+      size_ -= it->second->size;
+      lru_.erase(it->second);
+      map_.erase(it);
+    }
+    while (size_ + size > maxBytes_) {
+      size_ -= lru_.back().size;
+      map_.erase(lru_.back().getKey());
+      lru_.pop_back();
+    }
+    lru_.push_front(Entry{source.str(), flags, std::move(bytecode), size});
+    map_[lru_.front().getKey()] = lru_.begin();
+    size_ += size;
+  }
+
+  /// \return the number of entries.
+  size_t size() const {
+    return map_.size();
+  }
+
+  /// \return the bytes of source and bytecode held by the entries.
+  size_t getSizeInBytes() const {
+    return size_;
+  }
+
+  /// Remove all entries.
+  void clear() {
+    map_.clear();
+    lru_.clear();
+    size_ = 0;
+  }
+
+ private:
+  /// The source and the flags of an entry. The source is owned by the entry.
+  using Key = std::pair<llvm::StringRef, unsigned>;
+
+  struct Entry {
+    std::string source;
+    uint8_t flags;
+    std::shared_ptr<hbc::BCProvider> bytecode;
+    /// The bytes charged to the budget for this entry.
+    size_t size;
+
+    Key getKey() const {
+      return Key{source, flags};
+    }
+  };
+  using List = std::list<Entry>;
+
+  /// The budget of the cache in bytes.
+  const size_t maxBytes_;
+
+  /// The bytes charged to the budget by the entries.
+  size_t size_{0};
+
+  /// Entries from the most recently used to the least recently used.
+  List lru_;
+
+  /// Map from the key of each entry to its position in lru_.
+  llvm::DenseMap<Key, List::iterator> map_;
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_EVALCACHE_H
@@ -13,6 +13,7 @@
 #include "hermes/Public/GCTripwireContext.h"
 #include "hermes/Public/MemoryEventTracker.h"
 #include "hermes/Support/CheckedMalloc.h"
+#include "hermes/Support/Histogram.h"
 #include "hermes/Support/OSCompat.h"
 #include "hermes/Support/StatsAccumulator.h"
 #include "hermes/VM/BuildMetadata.h"
@@ -32,11 +33,15 @@
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/Support/ErrorHandling.h"
 
+#include <array>
 #include <cassert>
 #include <chrono>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <functional>
+#include <limits>
 #include <random>
 #include <system_error>
 #include <vector>
@@ -44,6 +49,7 @@
 namespace hermes {
 namespace vm {
 
+class AllocationSite;
 class GCCell;
 
 // A specific GC class extend GCBase, and override its virtual functions.
@@ -139,6 +145,10 @@ class GCCell;
 ///      void writeBarrierRangeFill(HermesValue* start, uint32_t numHVs,
 ///                                 HermesValue value);
 ///
+///   The given symbol is being stored in the heap outside of a HermesValue,
+///   e.g. as the key of a property map.
+///      void writeBarrierSymbol(SymbolID symbol);
+///
 ///   In debug builds: is a write barrier necessary for a write of the given
 ///   GC pointer \p value to the given \p loc?
 ///      bool needsWriteBarrier(void *loc, void *value);
@@ -215,6 +225,10 @@ class GCBase {
     /// Returns the current stack as a string. This function will not cause
     /// any allocs in the GC.
     virtual std::string getCallStackNoAlloc() = 0;
+
+    /// Called when a collection starts (\p start is true) and when it ends.
+    /// Nested cycles are not reported.
+    virtual void onGCCycle(bool start) {}
   };
 
   /// Struct that keeps a reference to a GC.  Useful, for example, as a base
@@ -253,6 +267,12 @@ class GCBase {
     unsigned mallocSizeEstimate{0};
     /// The total amount of Virtual Address space (VA) that the GC is using.
     uint64_t va{0};
+    /// The distance from the start of the lowest segment to the end of the
+    /// highest one. The more it exceeds va, the more the heap is spread over
+    /// pages, and TLB entries.
+    uint64_t vaSpan{0};
+    /// Bytes of the storage of the heap that are backed by huge pages.
+    uint64_t hugePageBytes{0};
     /// Stats for full collections (zeroes if non-generational GC).
     CumulativeHeapStats fullStats;
     /// Stats for collections in the young generation (zeroes if
@@ -260,6 +280,28 @@ class GCBase {
     CumulativeHeapStats youngGenStats;
   };
 
+  /// Distributions of the allocation behavior of the program, recorded at
+  /// every collection if GCConfig::ShouldRecordTelemetry is set, for tuning
+  /// the heap sizes to a class of devices.  Only the generational collector
+  /// records them.
+  struct Telemetry {
+    /// Bytes allocated per second of execution between collections.
+    Histogram allocationRate{Histogram::exponential(64 << 10, 2, 16)};
+    /// Percentage of the bytes of the young generation that survive its
+    /// collections.
+    Histogram youngGenSurvival{Histogram::linear(5, 19)};
+    /// Age of the objects promoted out of the young generation, as the number
+    /// of bytes allocated in the young generation after them.
+    Histogram promotionAge{Histogram::exponential(256, 2, 16)};
+    /// Bytes allocated, indexed by CellKind.
+    static constexpr size_t kNumCellKinds =
+        static_cast<size_t>(CellKind::AllCellsKind_last) + 1;
+    std::array<uint64_t, kNumCellKinds> allocatedBytesByKind{};
+    /// When the last collection ended, or the heap was created.
+    std::chrono::steady_clock::time_point lastCollectionEnd{
+        std::chrono::steady_clock::now()};
+  };
+
 #ifndef NDEBUG
   struct DebugHeapInfo {
     /// Number of currently allocated objects present in the heap. Some may be
@@ -327,11 +369,49 @@ class GCBase {
   /// the first time.
   void runtimeWillExecute();
 
+  /// Called by the Runtime before it creates its initial heap (the global
+  /// object, the JS library and the special code blocks), and after it is
+  /// done.  The initial heap lives as long as the Runtime.  Default behavior
+  /// is to do nothing.
+  void runtimeWillInitialize() {}
+  void runtimeInitialized() {}
+
   /// Inform the GC that TTI has been reached.  (In case, for example,
   /// behavior should change at that point.  Default behavior is to do
   /// nothing.)
   void ttiReached() {}
 
+  /// Do collection work that would otherwise be done in later pauses, for as
+  /// long as it fits before \p deadline (for GCs that can divide their work).
+  /// \return true if there is more such work to do.  Default is to do
+  /// nothing.
+  bool collectIncrementally(std::chrono::steady_clock::time_point deadline) {
+    return false;
+  }
+
+  /// Return as much memory as possible to the OS, more eagerly the higher the
+  /// \p pressure.  Default is to do nothing.
+  void handleMemoryPressure(MemoryPressure pressure) {}
+
+  /// Called by finalizers to release native resources of their cell, such as
+  /// buffers or host objects, after the collection pause instead of during
+  /// it.  \p release must not touch the JS heap, and must not depend on the
+  /// cell, which is freed by then.
+  void deferFinalization(std::function<void()> release) {
+    deferredFinalizers_.push_back(std::move(release));
+  }
+
+  /// Run the finalizations deferred by deferFinalization, in order, until
+  /// \p deadline passes.  \return true if some are left.
+  bool runDeferredFinalizers(
+      std::chrono::steady_clock::time_point deadline =
+          std::chrono::steady_clock::time_point::max());
+
+  /// Inform the GC that \p cell was just allocated by \p site, so that it can
+  /// feed back whether the site's objects live long (for GCs where that
+  /// concept makes sense).  Default behavior is to do nothing.
+  void trackAllocationSite(GCCell *cell, AllocationSite *site) {}
+
   /// Do anything necessary to record the current number of allocated
   /// objects in numAllocatedObjects_.  Default is to do nothing.
   virtual void recordNumAllocatedObjects() {}
@@ -354,6 +434,16 @@ class GCBase {
     return cumStats_.gcCPUTime.sum();
   }
 
+  /// \return the telemetry recorded so far, or null if it is not recorded.
+  const Telemetry *getTelemetry() const {
+    return telemetry_.get();
+  }
+
+  /// Write the telemetry to \p os as JSON: each distribution with its summary
+  /// statistics and buckets, and the bytes allocated by cell kind.  Writes an
+  /// empty object if the telemetry is not recorded.
+  void printTelemetry(llvm::raw_ostream &os) const;
+
   /// Populate \p info with information about the heap.
   virtual void getHeapInfo(HeapInfo &info);
   /// Same as \c getHeapInfo, and it adds the amount of malloc memory in use.
@@ -377,6 +467,11 @@ class GCBase {
   ///   version.
   /// \return true on success, false on failure.
   bool createSnapshotToFile(const std::string &fileName, bool compact);
+  /// Like createSnapshotToFile, but writes to the open file descriptor \p fd,
+  /// which is left open.  The snapshot is written as it is produced, a
+  /// buffer at a time.
+  /// \return true on success, false if writing failed.
+  bool createSnapshotToFileDescriptor(int fd, bool compact);
   /// Creates a snapshot of the heap, which includes information about what
   /// objects exist, their sizes, and what they point to.
   virtual void createSnapshot(llvm::raw_ostream &os, bool compact) = 0;
@@ -394,6 +489,7 @@ class GCBase {
       HermesValue *start,
       uint32_t numHVs,
       HermesValue value) {}
+  inline void writeBarrierSymbol(SymbolID symbol) {}
 #ifndef NDEBUG
   bool needsWriteBarrier(void *loc, void *value) {
     return false;
@@ -463,6 +559,32 @@ class GCBase {
 #endif
   }
 
+  /// Sample one allocation in every \p interval bytes allocated, or none if
+  /// \p interval is 0.  See shouldSampleAllocation().
+  void setAllocationSamplingInterval(size_t interval) {
+    allocationSamplingInterval_ = interval;
+    bytesUntilAllocationSample_ =
+        interval ? interval : std::numeric_limits<size_t>::max();
+  }
+
+  /// Count an allocation of \p size bytes.  \return true if it is the one that
+  /// reaches the next multiple of the sampling interval, or is bigger than the
+  /// interval, so that its stack should be recorded.  This is called by the
+  /// Runtime when allocating, since the stack is the Runtime's.
+  bool shouldSampleAllocation(uint32_t size) {
+    if (LLVM_LIKELY(size < bytesUntilAllocationSample_)) {
+      bytesUntilAllocationSample_ -= size;
+      return false;
+    }
+    if (!allocationSamplingInterval_) {
+      // Sampling is off, and has merely run out of its budget.
+      bytesUntilAllocationSample_ = std::numeric_limits<size_t>::max();
+      return false;
+    }
+    bytesUntilAllocationSample_ = allocationSamplingInterval_;
+    return true;
+  }
+
   using TimePoint = std::chrono::steady_clock::time_point;
   /// Return the difference between the two time points (end - start)
   /// as a double representing the number of seconds in the duration.
@@ -475,6 +597,22 @@ class GCBase {
       std::chrono::microseconds start,
       std::chrono::microseconds end);
 
+  /// Record that \p phase of the collection in progress took \p secs
+  /// seconds, if the collection is recorded as a GCCycleEvent.
+  void recordCyclePhase(const char *phase, double secs) {
+    if (LLVM_UNLIKELY(recordingCycleEvent_)) {
+      currentCycleEvent_.phases.emplace_back(phase, secs);
+    }
+  }
+
+  /// Like the above, for a phase that ran from \p start to \p end.
+  /// \return the duration of the phase in seconds.
+  double recordCyclePhase(const char *phase, TimePoint start, TimePoint end) {
+    const double secs = clockDiffSeconds(start, end);
+    recordCyclePhase(phase, secs);
+    return secs;
+  }
+
 // Mangling scheme used by MSVC encode public/private into the name.
 // As a result, vanilla "ifdef public" trick leads to link errors.
 #if defined(UNIT_TEST) || defined(_MSC_VER)
@@ -503,6 +641,8 @@ class GCBase {
 
    private:
     GCBase *const gc_;
+    /// Whether this cycle is nested in another.
+    const bool nested_;
   };
 
   /// Returns the number of bytes allocated allocated since the last GC.
@@ -539,6 +679,34 @@ class GCBase {
   void
   recordGCStats(double wallTime, double cpuTime, gcheapsize_t finalHeapSize);
 
+  /// Start recording the collection that is starting as a GCCycleEvent, if
+  /// there is a callback or stats to record it for.  \p kind and \p cause
+  /// must be static strings, see GCCycleEvent.
+  void beginCycleEvent(
+      const char *kind,
+      const char *cause,
+      uint64_t allocatedBefore,
+      uint64_t sizeBefore);
+
+  /// \return the event of the collection in progress, or null if it is not
+  /// recorded.
+  GCCycleEvent *currentCycleEvent() {
+    return recordingCycleEvent_ ? &currentCycleEvent_ : nullptr;
+  }
+
+  /// Finish recording the collection in progress, if it was recorded: pass
+  /// it to the callback, and keep it among the recent events if stats are
+  /// recorded.
+  void endCycleEvent(
+      double wallTime,
+      double cpuTime,
+      uint64_t allocatedAfter,
+      uint64_t sizeAfter);
+
+  /// Print the recent collections, as a JSON array of GCCycleEvents.
+  /// \p trailingComma as in printStats.
+  void printCycleEvents(llvm::raw_ostream &os, bool trailingComma) const;
+
   /// Do any additional GC-specific logging that is useful before dying with
   /// out-of-memory.
   virtual void oomDetail(std::error_code reason);
@@ -555,6 +723,10 @@ class GCBase {
   /// Number of finalized objects in the last collection.
   unsigned numFinalizedObjects_{0};
 
+  /// The native resources released by finalizers, to be released after the
+  /// collection pause.  See deferFinalization.
+  std::deque<std::function<void()>> deferredFinalizers_;
+
   /// The total number of bytes allocated in the execution.
   uint64_t totalAllocatedBytes_{0};
 
@@ -615,6 +787,9 @@ class GCBase {
   // The cumulative GC stats.
   CumulativeHeapStats cumStats_;
 
+  /// The telemetry, if GCConfig::ShouldRecordTelemetry is set.
+  std::unique_ptr<Telemetry> telemetry_;
+
   /// Name to indentify this heap in logs.
   std::string name_;
 
@@ -624,6 +799,24 @@ class GCBase {
   std::shared_ptr<MemoryEventTracker> memEventTracker_;
 #endif
 
+  /// The number of bytes between sampled allocations, or 0 for none.
+  size_t allocationSamplingInterval_{0};
+
+  /// The number of bytes left to allocate before the next sample.
+  size_t bytesUntilAllocationSample_{std::numeric_limits<size_t>::max()};
+
+  /// Called with the record of each collection, if not null.
+  std::function<void(const GCCycleEvent &)> cycleEventCallback_;
+
+  /// Whether the collection in progress is recorded in currentCycleEvent_.
+  bool recordingCycleEvent_{false};
+  GCCycleEvent currentCycleEvent_;
+
+  /// The most recent collections, oldest first, if stats are recorded.  At
+  /// most kNumRecentCycleEvents are kept.
+  std::deque<GCCycleEvent> recentCycleEvents_;
+  static constexpr size_t kNumRecentCycleEvents = 256;
+
   /// Callback called if it's not null when the Live Data Tripwire is triggered
   std::function<void(GCTripwireContext &)> tripwireCallback_;
 
@@ -11,6 +11,7 @@
 #include "hermes/VM/HeapAlign.h"
 #include "hermes/VM/VTable.h"
 
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -138,6 +139,40 @@ class GCCell {
     return isMarked();
   }
 
+  /// These two functions implement marked forwarding pointers for when several
+  /// threads may try to forward the same cell at once.
+
+  /// \return the forwarding pointer set in this cell via
+  /// setMarkedForwardingPointer() or setMarkedForwardingPointerAtomic(), or
+  /// nullptr if there is none, in which case \p vtp is set to the VTable
+  /// pointer of the cell.
+  /// NOTE: this should only be used by the GC.
+  GCCell *getMarkedForwardingPointerAtomic(const VTable *&vtp) const {
+    vtp = atomicVTP()->load(std::memory_order_acquire);
+    return isMarked(vtp) ? reinterpret_cast<GCCell *>(
+                               const_cast<VTable *>(removeKnownMarkBit(vtp)))
+                         : nullptr;
+  }
+
+  /// Sets this cell to contain a marked forwarding pointer to \p cell, unless
+  /// its VTable pointer is no longer \p vtp because another thread has
+  /// forwarded it first.  \return the forwarding pointer held by the cell
+  /// afterwards: either \p cell, or the one set by the other thread.
+  /// NOTE: this should only be used by the GC.
+  GCCell *setMarkedForwardingPointerAtomic(
+      const VTable *vtp,
+      const GCCell *cell) {
+    assert(!isMarked(vtp) && "Expected a VTable pointer");
+    auto *marked = reinterpret_cast<const VTable *>(
+        reinterpret_cast<uintptr_t>(cell) | 0x1);
+    if (atomicVTP()->compare_exchange_strong(
+            vtp, marked, std::memory_order_acq_rel)) {
+      return const_cast<GCCell *>(cell);
+    }
+    return reinterpret_cast<GCCell *>(
+        const_cast<VTable *>(removeKnownMarkBit(vtp)));
+  }
+
   const GCCell *nextCell() const {
     return reinterpret_cast<const GCCell *>(
         reinterpret_cast<const char *>(this) + getAllocatedSize());
@@ -214,6 +249,15 @@ class GCCell {
   void trackAlloc(GC *gc, const VTable *vtp);
 
  private:
+  /// The header, accessed atomically.
+  std::atomic<const VTable *> *atomicVTP() const {
+    static_assert(
+        sizeof(std::atomic<const VTable *>) == sizeof(const VTable *),
+        "The header must be usable as an atomic");
+    return reinterpret_cast<std::atomic<const VTable *> *>(
+        const_cast<const VTable **>(&vtp_));
+  }
+
   /// This version assumes that the bit is set, and that it can
   /// therefore subtract 1.
   template <typename T>
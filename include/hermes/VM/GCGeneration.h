@@ -291,6 +291,10 @@ class GCGeneration {
   /// effective size of the generation to reflect this.
   void updateEffectiveEndForExternalMemory();
 
+  /// Return the free pages at the end of the active segment to the OS.
+  /// Requires that the generation own its allocation context.
+  void markUnusedAboveLevel();
+
   /// Assumes objects with associated external memory are on the generation's
   /// finalizer list.  Iterates over that list, summing and returning the
   /// external memory.
@@ -93,6 +93,12 @@ class GCPointerBase {
   }
 };
 
+#ifdef HERMESVM_COMPRESSED_POINTERS
+static_assert(
+    sizeof(GCPointerBase) == sizeof(uint32_t),
+    "Compressed GCPointers must be 32-bit offsets");
+#endif
+
 /// A class to represent "raw" pointers to heap objects.  Disallows assignment,
 /// requiring a method that takes a GC* to perform a write barrier.
 template <typename T>
@@ -214,7 +214,7 @@ class GenGC final : public GCBase {
   /// Symbolic constants for indexing numWriteBarriers_.
   static constexpr unsigned kNumWriteBarrierTotalCountIdx = 0;
   static constexpr unsigned kNumWriteBarrierOfObjectPtrIdx = 1;
-  static constexpr unsigned kNumWriteBarrierWithDifferentSegsIdx = 2;
+  static constexpr unsigned kNumWriteBarrierLocInOGIdx = 2;
   static constexpr unsigned kNumWriteBarrierPtrInYGIdx = 3;
 
   /// We copied HermesValues into the given region.  Note that \p numHVs is
@@ -233,15 +233,59 @@ class GenGC final : public GCBase {
   void
   writeBarrierRangeFill(HermesValue *start, uint32_t numHVs, HermesValue value);
 
+  /// The given symbol is being stored in the heap outside of a HermesValue,
+  /// e.g. as the key of a property map.
+  inline void writeBarrierSymbol(SymbolID symbol);
+
+  /// Allocate the initial heap of the Runtime directly in the old
+  /// generation, instead of copying all of it there on the first young-gen
+  /// collection.  Allocation reverts to the young generation once the
+  /// Runtime is initialized, if it was configured to start there.
+  void runtimeWillInitialize();
+  void runtimeInitialized();
+
   /// Inform the GC that TTI has been reached.
   void ttiReached();
 
+  /// Do collection work that would otherwise be done in later pauses, for as
+  /// long as it fits before \p deadline, for example while the application
+  /// is idle: release the native resources of the cells that the previous
+  /// collections finalized, collect the young generation if it is getting
+  /// full, and advance an incremental marking cycle of the old generation,
+  /// finishing it if the time left allows for a full collection pause.  Once
+  /// this is called, the releases are left for it rather than done right after
+  /// each collection.
+  /// \return true if an incremental marking cycle is still in progress, or
+  /// releases are left.
+  bool collectIncrementally(std::chrono::steady_clock::time_point deadline);
+
+  /// Return the segments cached for reuse, and the free pages of the active
+  /// segments, to the OS.  Under critical \p pressure, first do a full
+  /// collection, so that the heap also shrinks to fit what is live.
+  void handleMemoryPressure(MemoryPressure pressure);
+
+  /// Check that the cells of one used segment, chosen at random, are well
+  /// formed and only point to well formed cells, and fail fatally with a
+  /// description of the first bad cell otherwise. Unlike
+  /// checkWellFormedHeap(), this is available in any build, and its cost is
+  /// bounded by the size of a segment. See GCConfig::HeapVerificationInterval.
+  void verifyRandomSegment();
+
+  /// Inform the GC that \p cell was just allocated by \p site, so that it
+  /// records whether the cell survives its first young-gen collection.
+  void trackAllocationSite(GCCell *cell, AllocationSite *site) {
+    youngGen_.trackAllocationSite(cell, site);
+  }
+
   /// Force a garbage collection cycle.
   /// (Part of general GC API defined in GC.h).
   /// Does a mark/sweep/compact collection of both generations.
 
   /// \p canEffectiveOOM Indicates whether the GC can declare effective OOM as a
   ///     result of this collection.
+  ///
+  /// If the old generation is being marked incrementally, that marking is
+  /// abandoned and redone from scratch by this collection.
   void collect(bool canEffectiveOOM = false);
 
   static constexpr uint32_t maxAllocationSize() {
@@ -314,6 +358,15 @@ class GenGC final : public GCBase {
   inline size_t numGCs() const;
   inline size_t numYoungGCs() const;
   inline size_t numFullGCs() const;
+  /// The number of full collections whose marking of the old generation was
+  /// done incrementally.  These are included in numFullGCs().
+  inline size_t numIncrementalFullGCs() const;
+
+  /// \return true if the old generation is currently being marked
+  /// incrementally.
+  bool isOldGenMarkingActive() const {
+    return oldGenMarkingActive_;
+  }
 
   /// Creates a snapshot of the heap, which includes information about what
   /// objects exist, their sizes, and what they point to.
@@ -433,6 +486,19 @@ class GenGC final : public GCBase {
  public:
   /// Return a reference to the segment index, for testing purposes.
   inline const GCSegmentAddressIndex &segmentIndex() const;
+
+  /// Evacuate the young generation and start an incremental marking cycle of
+  /// the old generation, regardless of its occupancy, for testing purposes.
+  /// Any cycle in progress is abandoned.
+  inline void startOldGenMarkingForTesting();
+
+  /// Advance the current incremental marking cycle until every object that
+  /// existed at its start has been visited, for testing purposes.
+  inline void advanceOldGenMarkingForTesting();
+
+  /// Evacuate the young generation and finish the current incremental marking
+  /// cycle with a full collection, for testing purposes.
+  inline void finishOldGenMarkingForTesting();
 #else
  private:
 #endif
@@ -457,6 +523,10 @@ class GenGC final : public GCBase {
   /// arguments.
   void *allocSlow(uint32_t sz, bool fixedSize, HasFinalizer hasFinalizer);
 
+  /// Allocate a variable-sized cell of at least largeObjectThreshold_ bytes in
+  /// a segment of its own in the old generation, where it is never moved.
+  void *allocLarge(uint32_t sz, HasFinalizer hasFinalizer);
+
   /// The given pointer value is being written at the given loc (required to
   /// be in the heap).  The value is may be null.  Execute a write
   /// barrier.  The \p hv argument indicates whether this is being
@@ -464,6 +534,18 @@ class GenGC final : public GCBase {
   /// barrier; this is used only in debug builds, for statistics.
   inline void writeBarrierImpl(void *loc, void *value, bool hv);
 
+  /// The part of the write barrier that is only active while the old
+  /// generation is being marked incrementally: \p value, which may be null,
+  /// is being written into some heap location, so make sure that it is marked
+  /// before the final remark.  Only values in the old generation need this;
+  /// the young generation is evacuated before the remark.
+  inline void oldGenMarkingBarrier(void *value);
+
+  /// The symbol counterpart of oldGenMarkingBarrier(): \p symbol is being
+  /// stored into the heap, where the cycle may already have looked, so mark
+  /// it now.
+  void oldGenMarkingSymbolBarrier(SymbolID symbol);
+
   /// Returns the desired heap size for the given number of used bytes --
   /// determined by the occupancyTarget() ratio and the max heap size
   /// representable by gcheapsize_t.  Note that \p usedBytes is given as a
@@ -481,6 +563,10 @@ class GenGC final : public GCBase {
   /// Update totalBytesAllocated, at the start of a GC.
   void updateTotalAllocStats();
 
+  /// Record the allocation rate since the last GC and the bytes allocated by
+  /// cell kind in the telemetry, at the start of a GC.
+  void recordAllocationTelemetry();
+
   /// Return (via swap) the current allocation context to the GCGeneration
   /// from which it was claimed.
   void yieldAllocContext();
@@ -538,9 +624,14 @@ class GenGC final : public GCBase {
   friend struct CollectionSection;
 
   /// RAII class managing the actions that need to be performed immediately
-  /// before and immediately after every garbage collection.
+  /// before and immediately after every garbage collection.  The collection
+  /// is recorded as a GCCycleEvent of the given \p kind and \p cause.
   struct CollectionSection : public PerfSection {
-    CollectionSection(GenGC *gc, const char *name);
+    CollectionSection(
+        GenGC *gc,
+        const char *name,
+        const char *kind,
+        const char *cause);
     ~CollectionSection();
 
     /// Update the cumulative GC statistics held for all GCs, and the statistics
@@ -638,6 +729,86 @@ class GenGC final : public GCBase {
   /// close the mark bits.
   void completeMarking();
 
+  /// Same as completeMarking(), but shares the work between numGCThreads_
+  /// threads, which steal marked cells to scan from each other.
+  void completeMarkingParallel();
+
+  /// Update the pointer fields of the live objects in every segment, as
+  /// updateReferences() does, but with numGCThreads_ threads that take one
+  /// segment at a time.  Each segment's displaced VTable pointers are found by
+  /// counting the marked cells of the segments swept before it.
+  void updateHeapReferencesParallel(const SweepResult &sweepResult);
+
+  /// Call \p work on numGCThreads_ threads (the calling one included), and
+  /// return once each call has returned.
+  template <typename F>
+  void runOnGCThreads(F work);
+
+  /// Incremental marking of the old generation.
+  ///
+  /// Instead of marking the whole heap in the full collection's pause, a cycle
+  /// is started after a young-gen collection once the old generation is
+  /// getting full, and the transitive closure is computed a bounded slice at a
+  /// time after each of the following young-gen collections.  Objects in the
+  /// old generation are visited in address order, and the marking finger of
+  /// markState_ is kept between slices, so that objects below the finger that
+  /// become marked are pushed on the mark stack instead.
+  ///
+  /// The mutator keeps running between slices.  Every pointer it writes into
+  /// the heap goes through the write barrier, which marks (and if necessary
+  /// greys) the old-gen referent.  Roots are not covered by the barrier, and
+  /// objects allocated in or promoted to the old generation since the cycle
+  /// started are not visited by the slices; both are handled by a final
+  /// remark, which is done right after a young-gen collection (so that the
+  /// young generation is empty), and which is followed by the usual sweep and
+  /// compaction.  A full collection that is needed before the remark throws
+  /// the incremental work away and marks the heap as usual.
+
+  /// Called after every young-gen collection.  Starts, advances, or finishes
+  /// an incremental marking cycle, if that is enabled.
+  void didYoungGenCollection();
+
+  /// Start an incremental marking cycle of the old generation: clear the mark
+  /// bits, mark the objects directly reachable from the roots, and remember
+  /// the extent of the old generation.
+  /// \pre The young generation is empty.
+  void startOldGenMarking();
+
+  /// Visit about \p budget bytes of the old generation that existed at the
+  /// start of the cycle, marking transitively from the marked objects found.
+  /// \return true if the transitive closure is complete and the cycle is
+  /// ready for the final remark.
+  bool advanceOldGenMarking(size_t budget);
+
+  /// The final remark of an incremental marking cycle, replacing markPhase()
+  /// in a full collection.  Marks everything allocated in the old generation
+  /// since the cycle started, marks again from the roots, and completes the
+  /// transitive closure.
+  /// \pre The young generation is empty.
+  void finishOldGenMarking();
+
+  /// Forget all the state of the current incremental marking cycle.
+  void abandonOldGenMarking();
+
+  /// Collect the young generation outside of an allocation, as the
+  /// allocation slow path does.  \return false if the old generation could not
+  /// fit all of the young generation, in which case nothing is done.
+  bool idleYoungGenCollect();
+
+  /// Run the finalizations deferred during the collection that just ended,
+  /// unless the embedder gives the GC idle time to run them in.
+  void runDeferredFinalizersAfterCollection();
+
+  /// \return the level that the old-gen segment starting at \p start had
+  /// when the current incremental marking cycle started.  Everything above it
+  /// is treated as live by the cycle.
+  char *oldGenMarkStartFor(char *start) const;
+
+  /// Do a full collection, marking either from scratch, or by finishing an
+  /// ongoing incremental marking cycle of the old generation.  Otherwise as
+  /// specified by collect().  \p cause is recorded in its GCCycleEvent.
+  void fullCollect(bool canEffectiveOOM, const char *cause);
+
   /// Does any work necessary for GC stats at the end of collection.
   /// Returns the number of allocated objects before collection starts.
   /// (In optimized builds, does nothing, and returns zero.)
@@ -775,6 +946,10 @@ class GenGC final : public GCBase {
   /// allocation (if had been doing OG allocation).
   const bool revertToYGAtTTI_;
 
+  /// True while the Runtime is being initialized, if allocation should then
+  /// revert to the young generation.
+  bool revertToYGAfterInit_{false};
+
 #ifndef NDEBUG
   bool allocInYoung_{true};
 #endif
@@ -800,6 +975,78 @@ class GenGC final : public GCBase {
   /// parent object of the object currently being marked.
   CompleteMarkState markState_;
 
+  /// Whether the old generation should be marked incrementally.
+  const bool incrementalMarking_;
+
+  /// The number of threads that mark, and update references, in full
+  /// collections.  When it is 1, these phases run on the calling thread only.
+  const unsigned numGCThreads_;
+
+  /// Variable-sized objects at least this large are allocated by allocLarge().
+  const uint32_t largeObjectThreshold_;
+
+  /// A random segment is verified after every this many collections, or
+  /// never if it is 0.
+  const unsigned heapVerificationInterval_;
+
+  /// The number of collections since a segment was last verified.
+  unsigned collectionsSinceVerification_{0};
+
+  /// Chooses the segments to verify.
+  std::minstd_rand verificationRandom_{};
+
+  /// Whether an incremental marking cycle of the old generation is ongoing.
+  bool oldGenMarkingActive_{false};
+
+  /// The extent of an old-gen segment at the start of the incremental marking
+  /// cycle: the cells in [start, markStart) are the ones that the marking
+  /// slices visit.
+  struct OldGenMarkRegion {
+    char *start;
+    char *markStart;
+  };
+
+  /// The old-gen segments at the start of the incremental marking cycle, in
+  /// increasing address order.  Segments are identified by address, as the
+  /// AlignedHeapSegment objects of the old gen may move.
+  std::vector<OldGenMarkRegion> oldGenMarkRegions_;
+
+  /// The index, in oldGenMarkRegions_, of the region that the next marking
+  /// slice continues in, and the address it continues from.
+  size_t oldGenMarkRegionIdx_{0};
+  char *oldGenMarkNext_{nullptr};
+
+  /// The number of bytes the marking slices have to visit in the current
+  /// cycle, and the number of bytes that can be promoted before marking
+  /// should be complete.  Used to pace the slices.
+  size_t oldGenMarkBytes_{0};
+  size_t oldGenMarkHeadroom_{0};
+
+  /// The usage of the old generation after the last marking slice.
+  size_t oldGenUsedAtLastMarkSlice_{0};
+
+  /// Once the old generation occupies this fraction of its size after a
+  /// young-gen collection, an incremental marking cycle is started.
+  static constexpr double kOldGenMarkingStartOccupancy = 0.75;
+
+  /// The fraction of the free space in the old generation at the start of an
+  /// incremental marking cycle that may be used up before marking should be
+  /// complete.
+  static constexpr double kOldGenMarkingHeadroomFraction = 0.5;
+
+  /// The least number of bytes a marking slice visits, so that slices after
+  /// young-gen collections that promoted little still make progress.
+  static constexpr size_t kMinOldGenMarkSlice = 1 << 18;
+
+  /// collectIncrementally() collects the young generation once it occupies
+  /// this fraction of its size.
+  static constexpr double kIdleYoungGenCollectOccupancy = 0.5;
+
+  /// Whether collectIncrementally() has been called, in which case the
+  /// deferred finalizations are left for it, up to this many.
+  bool collectsIncrementally_{false};
+  static constexpr size_t kMaxIdleDeferredFinalizers = 1024;
+
   /// Every bit corresponds to a symbol id. It is set to true if the symbol is
   /// in use (was marked).
   std::vector<bool> markedSymbols_{};
@@ -834,6 +1081,13 @@ class GenGC final : public GCBase {
   double sweepSecs_ = 0.0;
   double updateReferencesSecs_ = 0.0;
   double compactSecs_ = 0.0;
+  /// Cumulative time spent on incremental marking of the old generation,
+  /// outside of full collection pauses.
+  double incrementalMarkSecs_ = 0.0;
+
+  /// The number of full collections that finished an incremental marking
+  /// cycle.
+  size_t numIncrementalFullGCs_ = 0;
 
   /// The sum of the pre-collection sizes of the heap before/after
   /// full collections.
@@ -866,6 +1120,10 @@ inline void *GenGC::alloc(uint32_t sz) {
     collect();
   }
 
+  if (!fixedSize && LLVM_UNLIKELY(sz >= largeObjectThreshold_)) {
+    return allocLarge(sz, hasFinalizer);
+  }
+
 #ifdef HERMESVM_GC_GENERATIONAL_MARKSWEEPCOMPACT
   AllocResult res = oldGen_.alloc(sz, hasFinalizer);
   assert(res.success && "Should never fail to allocate at the top level");
@@ -950,6 +1208,10 @@ inline size_t GenGC::numFullGCs() const {
   return fullCollectionCumStats_.numCollections;
 }
 
+inline size_t GenGC::numIncrementalFullGCs() const {
+  return numIncrementalFullGCs_;
+}
+
 inline size_t GenGC::numFailedSegmentMaterializations() const {
   return storageProvider_.numFailedAllocs();
 }
@@ -958,6 +1220,30 @@ inline size_t GenGC::numFailedSegmentMaterializations() const {
 const GCSegmentAddressIndex &GenGC::segmentIndex() const {
   return segmentIndex_;
 }
+
+void GenGC::startOldGenMarkingForTesting() {
+  if (oldGenMarkingActive_) {
+    abandonOldGenMarking();
+  }
+  {
+    AllocContextYieldThenClaim yielder(this);
+    youngGen_.collect("test");
+  }
+  startOldGenMarking();
+}
+
+void GenGC::advanceOldGenMarkingForTesting() {
+  while (!advanceOldGenMarking(kMinOldGenMarkSlice)) {
+  }
+}
+
+void GenGC::finishOldGenMarkingForTesting() {
+  {
+    AllocContextYieldThenClaim yielder(this);
+    youngGen_.collect("test");
+  }
+  fullCollect(/* canEffectiveOOM */ false, "test");
+}
 #endif // UNIT_TEST
 
 inline void GenGC::writeBarrierImpl(void *loc, void *value, bool hv) {
@@ -965,21 +1251,40 @@ inline void GenGC::writeBarrierImpl(void *loc, void *value, bool hv) {
 
   char *locPtr = reinterpret_cast<char *>(loc);
 
-  // value may be null.  But if that occurs: locPtr and value will not
-  // be in the same AlignedStorage, so the first test below will fail,
-  // and we will not return early.  But youngGen_.contains(value) will
-  // fail, so we will (correctly) not dirty the card for loc.
+  // value may be null, in which case youngGen_.contains(value) fails and we
+  // (correctly) do not dirty the card for loc.
   HERMES_SLOW_ASSERT(value == nullptr || dbgContains(value));
-  if (AlignedStorage::containedInSame(locPtr, value)) {
+  // This must come before the early return below: a young object may still
+  // be given a pointer to an unmarked object.
+  if (LLVM_UNLIKELY(oldGenMarkingActive_)) {
+    oldGenMarkingBarrier(value);
+  }
+  // Only old-to-young pointers need a card.  Most stores are into objects
+  // that were just allocated, so check the location first: being in the young
+  // generation is a single compare of its segment start, and it also covers
+  // the stores of young values into the same segment.
+  if (LLVM_LIKELY(youngGen_.contains(locPtr))) {
     return;
   }
-  countWriteBarrier(hv, kNumWriteBarrierWithDifferentSegsIdx);
+  countWriteBarrier(hv, kNumWriteBarrierLocInOGIdx);
   if (youngGen_.contains(value)) {
     countWriteBarrier(hv, kNumWriteBarrierPtrInYGIdx);
     AlignedHeapSegment::cardTableCovering(locPtr)->dirtyCardForAddress(locPtr);
   }
 }
 
+inline void GenGC::oldGenMarkingBarrier(void *value) {
+  if (value && !youngGen_.contains(value)) {
+    markState_.markTransitive(value);
+  }
+}
+
+inline void GenGC::writeBarrierSymbol(SymbolID symbol) {
+  if (LLVM_UNLIKELY(oldGenMarkingActive_)) {
+    oldGenMarkingSymbolBarrier(symbol);
+  }
+}
+
 inline bool GenGC::allocContextClaimed() const {
   return !!allocContext_;
 }
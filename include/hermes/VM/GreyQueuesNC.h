@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_VM_GREYQUEUESNC_H
+#define HERMES_VM_GREYQUEUESNC_H
+
+#include "hermes/VM/GCCell.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hermes {
+namespace vm {
+
+/// The grey cells of a collection that runs on several threads: cells that
+/// have been reached, but whose fields have not been scanned yet.  Each thread
+/// has its own queue (really a stack).  It keeps the top of the stack to
+/// itself, and publishes the rest for other threads to steal when they run out
+/// of work.  The work is done when every thread has run out of it, and none
+/// has any to steal.
+class GreyQueues {
+ public:
+  /// The queue of one thread.
+  class Queue {
+   public:
+    /// The position of this queue in its GreyQueues.
+    const unsigned index;
+
+    explicit Queue(unsigned index) : index(index) {}
+
+    /// Add \p cell to the cells to scan.
+    inline void push(GCCell *cell);
+
+    /// Take the next cell to scan into \p cell.  \return false if there is
+    /// none left in this queue.
+    inline bool pop(GCCell *&cell);
+
+   private:
+    friend class GreyQueues;
+
+    /// Move the published cells of \p victim (all of them if \p victim is this
+    /// queue, half of them otherwise) to the private ones of this queue.
+    /// \return true if any were moved.
+    bool take(Queue &victim);
+
+    /// Cells that only the owning thread can take.
+    std::vector<GCCell *> local_;
+
+    /// Guards published_.
+    std::mutex mutex_;
+    /// Cells that any thread can take.
+    std::vector<GCCell *> published_;
+    /// The size of published_, which can be read without holding the lock.
+    std::atomic<size_t> numPublished_{0};
+  };
+
+  /// The number of cells a queue accumulates privately before it publishes
+  /// some of them to be stolen.
+  static constexpr size_t kPublishThreshold = 64;
+
+  explicit GreyQueues(unsigned numThreads);
+
+  GreyQueues(const GreyQueues &) = delete;
+  void operator=(const GreyQueues &) = delete;
+
+  unsigned numThreads() const {
+    return queues_.size();
+  }
+
+  Queue &queue(unsigned i) {
+    return *queues_[i];
+  }
+
+  /// Give \p cell to one of the threads to scan.  Must be called before run().
+  void addInitial(GCCell *cell);
+
+  /// Run numThreads() threads, including the calling one, and return once they
+  /// have all finished.  Thread \c i first calls \p start(i), which may push
+  /// cells onto queue(i), and then calls \p scan(i, cell) for each cell it
+  /// takes, until there are none left anywhere.
+  template <typename Start, typename Scan>
+  void run(Start start, Scan scan);
+
+  /// Same as run(), with nothing to do before scanning.
+  template <typename Scan>
+  void run(Scan scan) {
+    run([](unsigned) {}, scan);
+  }
+
+ private:
+  /// Find cells for \p self to scan, on the queues of other threads.
+  /// \return false once there are none left anywhere.
+  bool waitForWork(Queue &self);
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+
+  /// The number of threads that have no cells to scan.
+  std::atomic<unsigned> numIdle_{0};
+
+  /// The queue given the next call to addInitial().
+  unsigned nextInitial_{0};
+};
+
+void GreyQueues::Queue::push(GCCell *cell) {
+  local_.push_back(cell);
+  if (local_.size() >= kPublishThreshold &&
+      numPublished_.load(std::memory_order_relaxed) == 0) {
+    // Hand over the older half of the stack, which is likely to lead to more
+    // work than the cells on top.
+    const size_t half = local_.size() / 2;
+    std::lock_guard<std::mutex> lk{mutex_};
+    published_.insert(published_.end(), local_.begin(), local_.begin() + half);
+    numPublished_.store(published_.size(), std::memory_order_relaxed);
+    local_.erase(local_.begin(), local_.begin() + half);
+  }
+}
+
+bool GreyQueues::Queue::pop(GCCell *&cell) {
+  if (local_.empty() && !take(*this)) {
+    return false;
+  }
+  cell = local_.back();
+  local_.pop_back();
+  return true;
+}
+
+template <typename Start, typename Scan>
+void GreyQueues::run(Start start, Scan scan) {
+  auto work = [this, &start, &scan](unsigned i) {
+    Queue &self = queue(i);
+    start(i);
+    do {
+      GCCell *cell;
+      while (self.pop(cell)) {
+        scan(i, cell);
+      }
+    } while (waitForWork(self));
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned i = 1; i < numThreads(); ++i) {
+    threads.emplace_back(work, i);
+  }
+  work(0);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_GREYQUEUESNC_H
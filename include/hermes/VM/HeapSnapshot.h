@@ -35,6 +35,9 @@ std::string converter(const char *name);
 std::string converter(unsigned index);
 std::string converter(int index);
 std::string converter(const StringPrimitive *str);
+/// Convert at most the first \p maxLength characters of \p str, so that the
+/// snapshot of a heap with huge strings does not have to copy all of them.
+std::string converter(const StringPrimitive *str, uint32_t maxLength);
 std::string converter(UTF16Ref ref);
 /// @}
 
@@ -220,6 +223,12 @@ class V8HeapSnapshot {
     Index index_; // valid only if pointerKind == PKUnnamed
   };
 
+  /// The longest prefix of the value of a string that is kept as the name of
+  /// its node.  The string table of the snapshot is held in memory until it
+  /// is written at the end, and would otherwise be as big as all the strings
+  /// in the heap.
+  static constexpr uint32_t kMaxStringValueLength = 1024;
+
   explicit V8HeapSnapshot(JSONEmitter &json);
 
   /// NOTE: this destructor writes to \p json.
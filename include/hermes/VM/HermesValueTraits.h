@@ -55,11 +55,13 @@ HERMES_VM_GCOBJECT(JSBoolean);
 HERMES_VM_GCOBJECT(JSSymbol);
 HERMES_VM_GCOBJECT(JSRegExp);
 HERMES_VM_GCOBJECT(JSDate);
+HERMES_VM_GCOBJECT(JSPromise);
+HERMES_VM_GCOBJECT(JSTextEncoder);
+HERMES_VM_GCOBJECT(JSTextDecoder);
 HERMES_VM_GCOBJECT(JSError);
 HERMES_VM_GCOBJECT(JSGenerator);
 HERMES_VM_GCOBJECT(Domain);
 HERMES_VM_GCOBJECT(RequireContext);
-HERMES_VM_GCOBJECT(HashMapEntry);
 HERMES_VM_GCOBJECT(OrderedHashMap);
 HERMES_VM_GCOBJECT(JSWeakMapImplBase);
 HERMES_VM_GCOBJECT(JSArrayIterator);
@@ -11,11 +11,13 @@
 #include "hermes/VM/ArrayStorage.h"
 #include "hermes/VM/DictPropertyMap.h"
 #include "hermes/VM/GCPointer-inline.h"
+#include "hermes/VM/Predefined.h"
 #include "hermes/VM/PropertyDescriptor.h"
 #include "hermes/VM/SegmentedArray.h"
-#include "hermes/VM/WeakValueMap.h"
+#include "hermes/VM/WeakRef.h"
 
 #include <functional>
+#include <memory>
 #include "llvm/ADT/ArrayRef.h"
 
 namespace hermes {
@@ -54,11 +56,28 @@ struct ClassFlags {
   /// properties are "read-only".
   uint32_t allReadOnly : 1;
 
+  /// Only meaningful in dictionary mode. Deleting a property or changing its
+  /// flags replaces the class instead of updating it in place, and adding a
+  /// property never moves the existing ones, so a (class, slot) pair stays
+  /// valid for as long as the object has the class and property caches can
+  /// key on it like on any other class.
+  uint32_t cacheableDictionary : 1;
+
+  /// The set of well-known symbols, like Symbol.toPrimitive, that have ever
+  /// been added as properties to this class or its ancestors, as a bit for
+  /// each symbol index. A clear bit means that looking up that symbol in the
+  /// class is certain to find nothing.
+  uint32_t wellKnownSymbols : 16;
+
   ClassFlags() {
     ::memset(this, 0, sizeof(*this));
   }
 };
 
+static_assert(
+    Predefined::kNumWellKnownSymbols <= 16,
+    "ClassFlags::wellKnownSymbols needs a bit for each well-known symbol");
+
 /// A "hidden class" describes a fixed set of properties, their property flags
 /// and the order that they were created in. It is logically immutable (unless
 /// it is in "dictionary mode", which is described below).
@@ -98,6 +117,11 @@ struct ClassFlags {
 /// is not shared - it belongs to exactly one object - and updates are done "in
 /// place" instead of creating new child classes.
 ///
+/// A dictionary can be made "cacheable" with \c makeCacheableDictionary(),
+/// which is done for the global object: deletions and flag updates then
+/// create a new parentless class, so that the property caches of the global
+/// variables keep hitting without a transition per added property.
+///
 /// Property Maps
 /// =============
 /// Conceptually every hidden class has a property map - a table mapping from
@@ -113,6 +137,9 @@ struct ClassFlags {
 /// The desired effect is that only "leaf" classes have property maps and normal
 /// property assignment doesn't create a map at all in the intermediate states
 /// (except the first time).
+/// Intermediate classes still get a map when a property of an object in an
+/// intermediate state is read, for example in a constructor. These maps are
+/// freed by the GC when they haven't been used since the previous collection.
 class HiddenClass final : public GCCell {
   friend void HiddenClassBuildMeta(const GCCell *cell, Metadata::Builder &mb);
 
@@ -121,6 +148,9 @@ class HiddenClass final : public GCCell {
   /// mode".
   static constexpr unsigned kDictionaryThreshold = 64;
 
+  /// The largest value tracked by getMaxDescendantProperties().
+  static constexpr unsigned kMaxDescendantProperties = 255;
+
   static VTable vt;
 
   static bool classof(const GCCell *cell) {
@@ -144,16 +174,38 @@ class HiddenClass final : public GCCell {
     return numProperties_;
   }
 
+  /// \return the largest number of properties of the classes created so far
+  /// by adding properties to this one (directly or through its children),
+  /// or of this class itself. Objects use it to size their indirect property
+  /// storage for the properties they are likely to get.
+  unsigned getMaxDescendantProperties() const {
+    return maxDescendantProperties_;
+  }
+
   /// \return true if this class is in "dictionary mode" - i.e. changes to it
   /// don't result in creation of new classes.
   bool isDictionary() const {
     return flags_.dictionaryMode;
   }
 
+  /// \return true if property caches may key on this class, which is the case
+  /// unless it is a dictionary that is updated in place.
+  bool isCacheable() const {
+    return !flags_.dictionaryMode || flags_.cacheableDictionary;
+  }
+
   bool getHasIndexLikeProperties() const {
     return flags_.hasIndexLikeProperties;
   }
 
+  /// \return true if the well-known symbol \p sym may be a property of this
+  ///   class, false if looking it up is certain to find nothing.
+  bool mayHaveWellKnownSymbol(Predefined::Sym sym) const {
+    int index =
+        Predefined::getWellKnownSymbolIndex(Predefined::getSymbolID(sym));
+    return flags_.wellKnownSymbols & (1u << index);
+  }
+
   /// \return a hidden class that we originated from entirely by using "flag
   /// transitions", in other words, one that has exactly the same fields in the
   /// same order as this class, but possibly different property flags.
@@ -174,6 +226,26 @@ class HiddenClass final : public GCCell {
     forInCache_ = nullptr;
   }
 
+  /// \return the JSON.stringify() cache if one has been set, otherwise
+  /// nullptr.
+  ArrayStorage *getJSONCache(Runtime *runtime) const {
+    return jsonCache_.get(runtime);
+  }
+
+  void setJSONCache(ArrayStorage *arr, Runtime *runtime) {
+    jsonCache_.set(runtime, arr, &runtime->getHeap());
+  }
+
+  /// \return the cache of the enumerable own properties used by Object.keys()
+  /// and related functions if one has been set, otherwise nullptr.
+  ArrayStorage *getOwnPropertiesCache(Runtime *runtime) const {
+    return ownPropertiesCache_.get(runtime);
+  }
+
+  void setOwnPropertiesCache(ArrayStorage *arr, Runtime *runtime) {
+    ownPropertiesCache_.set(runtime, arr, &runtime->getHeap());
+  }
+
   /// An opaque class representing a reference to a valid property in the
   /// property map.
   using PropertyPos = DictPropertyMap::PropertyPos;
@@ -232,6 +304,13 @@ class HiddenClass final : public GCCell {
   static bool
   debugIsPropertyDefined(HiddenClass *self, Runtime *runtime, SymbolID name);
 
+  /// Switch \p selfHandle to dictionary mode if it isn't already, and mark the
+  /// resulting dictionary as cacheable (see \c ClassFlags).
+  /// \return the resulting class.
+  static Handle<HiddenClass> makeCacheableDictionary(
+      Handle<HiddenClass> selfHandle,
+      Runtime *runtime);
+
   /// Delete a property which we found earlier using \c findProperty.
   /// \return the resulting new class.
   static Handle<HiddenClass> deleteProperty(
@@ -286,6 +365,15 @@ class HiddenClass final : public GCCell {
       PropertyFlags flagsToSet,
       OptValue<llvm::ArrayRef<SymbolID>> props);
 
+  /// Forget that all properties are non-configurable or read-only, after
+  /// properties which may not be were forcibly added or their flags changed.
+  /// This only clears what areAllNonConfigurable() and areAllReadOnly()
+  /// cache, so it is safe even if the class is shared.
+  void clearAllNonConfigurableFlags() {
+    flags_.allNonConfigurable = false;
+    flags_.allReadOnly = false;
+  }
+
   /// \return true if all properties are non-configurable
   static bool areAllNonConfigurable(
       Handle<HiddenClass> selfHandle,
@@ -315,6 +403,87 @@ class HiddenClass final : public GCCell {
   };
 
  private:
+  /// The transitions from a class to its children. Most classes have at most
+  /// one transition, which is stored inline. A few transitions are kept in a
+  /// small array which is searched linearly, and only classes with many
+  /// transitions (typically the root class) use a hash table.
+  /// The children are referenced weakly: transitions to collected children are
+  /// dropped by the GC in \c markWeakRefs(), or when they are looked up.
+  class TransitionMap {
+   public:
+    /// The maximum number of transitions stored in the linearly searched
+    /// array.
+    static constexpr unsigned kMaxSmallSize = 8;
+
+    TransitionMap();
+    ~TransitionMap();
+    TransitionMap(const TransitionMap &) = delete;
+    void operator=(const TransitionMap &) = delete;
+
+    /// \return true if there are no transitions. It can report false
+    /// negatives when all the children have been collected but the GC hasn't
+    /// pruned them yet.
+    bool isKnownEmpty() const {
+      return !singleSlot_ && !small_ && !large_;
+    }
+
+    /// \return true if there is a transition for \p key to a live child.
+    bool containsKey(const Transition &key) {
+      return findSlot(key) != nullptr;
+    }
+
+    /// Look for a transition and return the child if found, or llvm::None.
+    llvm::Optional<Handle<HiddenClass>> lookup(
+        HandleRootOwner *runtime,
+        const Transition &key) {
+      if (WeakRefSlot *slot = findSlot(key))
+        return WeakRef<HiddenClass>(slot).get(runtime);
+      return llvm::None;
+    }
+
+    /// Insert a transition if \p key is not already there.
+    /// \return true if the transition was inserted, false if the key was
+    ///   already there.
+    bool insertNew(GC *gc, const Transition &key, Handle<HiddenClass> value);
+
+    /// This method should be invoked during garbage collection. It calls
+    /// gc->markWeakRef() with every valid child and drops the others.
+    void markWeakRefs(GC *gc);
+
+    /// \return the amount of malloc memory used by the transitions.
+    size_t getMemorySize() const;
+
+   private:
+    struct Entry {
+      Transition key{SymbolID{}};
+      WeakRefSlot *slot{nullptr};
+    };
+
+    /// The linearly searched array of transitions.
+    struct SmallTable {
+      unsigned size{0};
+      Entry entries[kMaxSmallSize];
+    };
+
+    /// The hash table of transitions, defined in the .cpp file.
+    struct LargeTable;
+
+    /// \return the slot of the live child for \p key, or nullptr. A
+    ///   transition to a collected child is dropped.
+    WeakRefSlot *findSlot(const Transition &key);
+
+    /// Remove the transitions to collected children from the small table,
+    /// calling gc->markWeakRef() with the others if \p gc is not null.
+    void pruneSmall(GC *gc);
+
+    /// At most one of singleSlot_, small_ and large_ is used at a time. The
+    /// single transition is stored in singleKey_ and singleSlot_.
+    Transition singleKey_{SymbolID{}};
+    WeakRefSlot *singleSlot_{nullptr};
+    std::unique_ptr<SmallTable> small_{};
+    std::unique_ptr<LargeTable> large_{};
+  };
+
   HiddenClass(
       Runtime *runtime,
       ClassFlags flags,
@@ -328,7 +497,9 @@ class HiddenClass final : public GCCell {
         family_(runtime, this, &runtime->getHeap()),
         symbolID_(symbolID),
         propertyFlags_(propertyFlags),
-        numProperties_(numProperties) {
+        numProperties_(numProperties),
+        maxDescendantProperties_(
+            std::min(numProperties, toRValue(kMaxDescendantProperties))) {
     assert(propertyFlags.isValid() && "propertyFlags must be valid");
   }
 
@@ -346,11 +517,22 @@ class HiddenClass final : public GCCell {
   /// new class. Otherwise a new property map will be created for the new class.
   /// In either case, the current class will have no property map and the new
   /// class will have one.
+  /// A cacheable dictionary can be converted too, which simply replaces it
+  /// with an identical one.
   /// \return the new class.
   static Handle<HiddenClass> convertToDictionary(
       Handle<HiddenClass> selfHandle,
       Runtime *runtime);
 
+  /// Record in the flags that a property \p name was added, if it is a
+  /// well-known symbol.
+  void noteWellKnownSymbol(SymbolID name) {
+    int index = Predefined::getWellKnownSymbolIndex(name);
+    if (LLVM_UNLIKELY(index >= 0)) {
+      flags_.wellKnownSymbols |= 1u << index;
+    }
+  }
+
   /// Add a new property pair (\p name and \p desc) to the property map (which
   /// must have been initialized).
   static ExecutionStatus addToPropertyMap(
@@ -417,13 +599,34 @@ class HiddenClass final : public GCCell {
   /// when a transition is performed from the parent class to this one.
   GCPointer<DictPropertyMap> propertyMap_{};
 
-  /// This hash table encodes the transitions from this class to child classes
-  /// keyed on the property being added (or updated) and its flags.
-  WeakValueMap<Transition, HiddenClass> transitionMap_;
+  /// Set when the property map is looked up or updated, and cleared by every
+  /// full collection. The map of a class with children which wasn't used since
+  /// the previous collection is freed by the GC, since it can be rebuilt.
+  bool propertyMapUsed_{false};
+
+  /// See getMaxDescendantProperties(). It is updated when a new class is
+  /// created by adding a property, and saturates at kMaxDescendantProperties.
+  uint8_t maxDescendantProperties_;
 
   /// Cache that contains for-in property names for objects of this class.
   /// Never used in dictionary mode.
+  /// Kept next to the other GCPointers: with compressed pointers it fills the
+  /// padding before the 8-byte aligned \c transitionMap_.
   GCPointer<BigStorage> forInCache_{};
+
+  /// Cache of the enumerable properties of objects of this class, used by
+  /// JSON.stringify(). Never used in dictionary mode, where the properties
+  /// can change without changing the class.
+  GCPointer<ArrayStorage> jsonCache_{};
+
+  /// Cache of the enumerable own properties of objects of this class and
+  /// their slots, used by Object.keys(), Object.assign() and related
+  /// functions. Never used in dictionary mode.
+  GCPointer<ArrayStorage> ownPropertiesCache_{};
+
+  /// The transitions from this class to child classes keyed on the property
+  /// being added (or updated) and its flags.
+  TransitionMap transitionMap_;
 };
 
 //===----------------------------------------------------------------------===//
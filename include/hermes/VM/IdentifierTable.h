@@ -92,7 +92,8 @@ class IdentifierTable {
 
   /// Register a lazy ASCII identifier from a bytecode module or as predefined
   /// identifier.
-  /// This function should only be called during initialization of a module.
+  /// This function should only be called for the strings of a persistent
+  /// module, which outlive the table. It never allocates in the GC heap.
   SymbolID registerLazyIdentifier(ASCIIRef str);
   SymbolID registerLazyIdentifier(ASCIIRef str, uint32_t hash);
 
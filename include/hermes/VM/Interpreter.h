@@ -14,6 +14,9 @@ class CodeBlock;
 
 namespace hermes {
 namespace vm {
+
+class AllocationSite;
+
 /// This class is a convenience wrapper for the interpreter implementation that
 /// needs access to the private fields of Runtime, but doesn't belong in
 /// Runtime.
@@ -73,6 +76,51 @@ class Interpreter {
       Handle<Callable> curFunction,
       bool strictMode);
 
+  /// Implement OpCode::CallApplyArguments: call \p callee with the this
+  /// value \p thisVal and the arguments (\p thisArg, arguments).
+  /// If \p callee is the built-in Function.prototype.apply and the arguments
+  /// object hasn't been created, which is the case when \p lazyReg is
+  /// undefined, the arguments of the current frame are passed to \p thisVal
+  /// directly. Otherwise the arguments object is created in \p lazyReg and
+  /// \p callee is called normally.
+  static CallResult<HermesValue> callApplyArguments_RJS(
+      Runtime *runtime,
+      PinnedHermesValue *lazyReg,
+      Handle<> callee,
+      Handle<> thisVal,
+      Handle<> thisArg,
+      bool strictMode);
+
+  /// Implement OpCode::IteratorBegin: get the iterator of a for-of loop over
+  /// \p sourceOrNext.
+  /// An array whose @@iterator and array iterator next() are the built-in
+  /// ones is iterated directly: the iterator is the index of the next element
+  /// and \p sourceOrNext keeps the array. Otherwise the iterator is the
+  /// iterator object, and \p sourceOrNext is set to its next() method.
+  /// \return the iterator.
+  static CallResult<HermesValue> iteratorBegin_RJS(
+      Runtime *runtime,
+      PinnedHermesValue *sourceOrNext);
+
+  /// Implement OpCode::IteratorNext: advance \p iterator, as returned by
+  /// iteratorBegin_RJS() with \p sourceOrNext. The built-in array, string,
+  /// Map and Set iterators are advanced without creating the iterator result
+  /// object. \p iterator is set to undefined when the iteration is done.
+  /// \return the next value, or undefined if the iteration is done.
+  static CallResult<HermesValue> iteratorNext_RJS(
+      Runtime *runtime,
+      PinnedHermesValue *iterator,
+      Handle<> sourceOrNext);
+
+  /// Implement OpCode::IteratorClose: call the return() method of \p iterator
+  /// when a for-of loop is exited early. If \p ignoreInnerException is true,
+  /// because the loop is exited by an exception, catchable exceptions thrown
+  /// while closing the iterator are discarded.
+  static ExecutionStatus iteratorClose_RJS(
+      Runtime *runtime,
+      Handle<> iterator,
+      bool ignoreInnerException);
+
   static ExecutionStatus handleGetPNameList(
       Runtime *runtime,
       PinnedHermesValue *frameRegs,
@@ -97,6 +145,15 @@ class Interpreter {
   static OptValue<HermesValue>
   tryGetPrimitiveOwnPropertyById(Runtime *runtime, Handle<> base, SymbolID id);
 
+  /// Evaluate the call of the builtin method \p builtinMethodID with \p args
+  /// inline, without entering the native function, for the builtins that are
+  /// cheap enough for that to matter (Math.floor, Math.max, Array.isArray...)
+  /// when all the arguments are of the expected type.
+  /// \return the result, or llvm::None if the native function must be called.
+  static OptValue<HermesValue> tryCallBuiltinInline(
+      unsigned builtinMethodID,
+      NativeArgs args);
+
   /// Implement OpCode::GetById/TryGetById when the base is not an object.
   static CallResult<HermesValue>
   getByIdTransient_RJS(Runtime *runtime, Handle<> base, SymbolID id);
@@ -126,7 +183,9 @@ class Interpreter {
       Handle<> value,
       bool strictMode);
 
-  template <bool SingleStep>
+  /// \param ThreadedDispatch whether to dispatch through the direct-threaded
+  ///   form of the bytecode, for experiments::ThreadedDispatch.
+  template <bool SingleStep, bool ThreadedDispatch = false>
   static CallResult<HermesValue> interpretFunction(
       Runtime *runtime,
       InterpreterState &state);
@@ -135,24 +194,28 @@ class Interpreter {
   /// \param numLiterals the amount of literals to read from the buffer.
   /// \param keyBufferIndex the first element of the key buffer to read.
   /// \param valBufferIndex the first element of the val buffer to read.
+  /// \param site the allocation site of the instruction creating the object.
   /// \return ExecutionStatus::EXCEPTION if the property definitions throw.
   static CallResult<HermesValue> createObjectFromBuffer(
       Runtime *runtime,
       CodeBlock *curCodeBlock,
       unsigned numLiterals,
       unsigned keyBufferIndex,
-      unsigned valBufferIndex);
+      unsigned valBufferIndex,
+      AllocationSite *site);
 
   /// Populates an array with literal values from the array buffer.
   /// \param numLiterals the amount of literals to read from the buffer.
   /// \param bufferIndex the first element of the buffer to read.
+  /// \param site the allocation site of the instruction creating the array.
   /// \return ExecutionStatus::EXCEPTION if the property definitions throw.
   static CallResult<HermesValue> createArrayFromBuffer(
       Runtime *runtime,
       CodeBlock *curCodeBlock,
       unsigned numElements,
       unsigned numLiterals,
-      unsigned bufferIndex);
+      unsigned bufferIndex,
+      AllocationSite *site);
 
 #ifdef HERMES_ENABLE_DEBUGGER
   /// Wrapper around runDebugger() that reapplies the interpreter state.
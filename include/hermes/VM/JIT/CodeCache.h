@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_VM_JIT_CODECACHE_H
+#define HERMES_VM_JIT_CODECACHE_H
+
+#include "hermes/VM/JIT/ExecHeap.h"
+
+#include "llvm/ADT/DenseSet.h"
+
+#include <vector>
+
+namespace hermes {
+namespace vm {
+
+class CodeBlock;
+class Runtime;
+class RuntimeModule;
+
+/// Keeps track of the executable memory owned by every compiled CodeBlock, so
+/// that the least recently used ones can be evicted when the executable heap
+/// is full. An evicted function falls back to the interpreter until it becomes
+/// hot again and is recompiled.
+class CodeCache {
+ public:
+  /// Statistics about the compiled code.
+  struct Stats {
+    /// Bytes of emitted native code of all functions currently compiled.
+    size_t bytesUsed{0};
+    /// Number of compiled functions that were evicted.
+    uint64_t evictions{0};
+    /// Number of compilations of functions that had been evicted before.
+    uint64_t recompilations{0};
+  };
+
+  CodeCache() = default;
+  CodeCache(const CodeCache &) = delete;
+  void operator=(const CodeCache &) = delete;
+
+  /// Record that \p codeBlock was compiled into \p blocks, of which the first
+  /// \p sizes bytes are used.
+  void add(
+      CodeBlock *codeBlock,
+      ExecHeap::BlockPair blocks,
+      ExecHeap::SizePair sizes);
+
+  /// Evict compiled functions from \p heap, least recently used first, until
+  /// blocks with \p sizes can be allocated. Functions with a frame on the
+  /// stack of \p runtime may still be executing and are never evicted.
+  /// \return true if the allocation can now succeed.
+  bool evict(Runtime *runtime, ExecHeap &heap, ExecHeap::SizePair sizes);
+
+  /// Forget all functions of \p runtimeModule, which is about to be
+  /// destroyed, and free their native code from \p heap.
+  void removeRuntimeModule(RuntimeModule *runtimeModule, ExecHeap &heap);
+
+  /// \return the statistics collected so far.
+  const Stats &getStats() const {
+    return stats_;
+  }
+
+  /// Print the statistics to \p os.
+  void printStats(llvm::raw_ostream &os) const;
+
+ private:
+  /// The executable memory of one compiled function.
+  struct Entry {
+    CodeBlock *codeBlock;
+    ExecHeap::BlockPair blocks;
+    ExecHeap::SizePair sizes;
+  };
+
+  /// All functions that are currently compiled, in no particular order.
+  std::vector<Entry> entries_{};
+
+  /// Functions that were evicted, to count their recompilations.
+  llvm::DenseSet<CodeBlock *> evicted_{};
+
+  Stats stats_{};
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_JIT_CODECACHE_H
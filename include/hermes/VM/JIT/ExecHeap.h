@@ -46,7 +46,14 @@ class ExecHeap {
   /// Construct an empty execitable heap. New individual pools will be allocated
   /// with the specified heap sizes up to the total of the specified \p
   /// maxMemory.
-  ExecHeap(size_t firstHeapSize, size_t secondHeapSize, size_t maxMemory);
+  /// \param writeXorExecute if true, pools are never writable and executable
+  ///   at the same time. Code must then be emitted between \c makeWritable()
+  ///   and \c makeExecutable().
+  ExecHeap(
+      size_t firstHeapSize,
+      size_t secondHeapSize,
+      size_t maxMemory,
+      bool writeXorExecute = false);
   ~ExecHeap();
 
   /// Allocate a new pool with the pre-configured size and add it to the list
@@ -64,6 +71,11 @@ class ExecHeap {
   // the allocation.
   llvm::Optional<BlockPair> alloc(SizePair sizes);
 
+  /// \return true if blocks with the specified sizes could be allocated,
+  ///   either in one of the existing pools or in a new one, without exceeding
+  ///   the maximum memory limit.
+  bool canAlloc(SizePair sizes) const;
+
   /// Split the specified previously allocated blocks (which must have been
   /// allocated together by a call to \c alloc()) at offset keepSizes.first/
   /// .second and free the second blocks.
@@ -74,6 +86,24 @@ class ExecHeap {
   /// \c freeRemaining(blocks, {0, 0}).
   void free(BlockPair blocks);
 
+  /// Make the pool containing the previously allocated \p blocks writable,
+  /// so code can be emitted into them. In a W^X heap this also makes the
+  /// whole pool non-executable; otherwise the pool is always writable and
+  /// this does nothing.
+  /// \return false if the protection could not be changed.
+  bool makeWritable(BlockPair blocks);
+
+  /// Finish emitting \p sizes bytes at the start of \p blocks: in a W^X heap
+  /// make their pool executable and read-only again, then invalidate the
+  /// instruction cache for the emitted code.
+  /// \return false if the protection could not be changed.
+  bool makeExecutable(BlockPair blocks, SizePair sizes);
+
+  /// \return true if pools are never writable and executable at once.
+  bool isWriteXorExecute() const {
+    return writeXorExecute_;
+  }
+
   /// Invalidate the instruction cache for a JIT-ted block of code before
   /// executing it.
   inline void invalidateInstructionCache(void *addr, size_t len) {
@@ -120,6 +150,12 @@ class ExecHeap {
     // block.
     llvm::Optional<BlockPair> alloc(SizePair sizes);
 
+    /// \return true if \c alloc() would currently succeed for \p sizes.
+    bool canAlloc(SizePair sizes) const {
+      return (!sizes.first || firstHeap_.canAlloc(sizes.first)) &&
+          (!sizes.second || secondHeap_.canAlloc(sizes.second));
+    }
+
     /// Split the specified previously allocated blocks (which must have been
     /// allocated together by a call to \c alloc()) at offset keepSizes.first/
     /// .second and free the second blocks.
@@ -134,6 +170,11 @@ class ExecHeap {
     bool isEntirelyFree() const {
       return firstHeap_.isEntirelyFree() && secondHeap_.isEntirelyFree();
     }
+
+    /// Change the protection of the entire pool to \p flags, a combination
+    /// of llvm::sys::Memory::ProtectionFlags.
+    /// \return false on OS failure.
+    bool protect(unsigned flags);
   };
 
  public:
@@ -143,6 +184,8 @@ class ExecHeap {
   size_t const secondHeapSize_;
   /// The maximum number of pools we are allowed to allocate.
   unsigned const maxPools_;
+  /// Whether pools are mapped W^X.
+  bool const writeXorExecute_;
 
   using PoolList = std::list<DualPool>;
 
@@ -9,12 +9,20 @@
 
 #ifdef HERMESVM_JIT
 
+#if defined(__aarch64__)
+#include "hermes/VM/JIT/arm64/JIT.h"
+#else
 #include "hermes/VM/JIT/x86-64/JIT.h"
+#endif
 
 namespace hermes {
 namespace vm {
 
+#if defined(__aarch64__)
+using arm64::JITContext;
+#else
 using x86_64::JITContext;
+#endif
 
 } // namespace vm
 } // namespace hermes
@@ -22,6 +30,7 @@ using x86_64::JITContext;
 #else
 
 #include "hermes/VM/CodeBlock.h"
+#include "hermes/VM/JIT/RegexJIT.h"
 
 namespace hermes {
 namespace vm {
@@ -51,6 +60,31 @@ class JITContext {
     return codeBlock->getJITCompiled();
   }
 
+  /// Compile a function with a hot loop and return the native entry point
+  /// which continues at the loop header at bytecode \p offset. Return nullptr
+  /// if there is none.
+  inline JITCompiledFunctionPtr
+  compileOSR(Runtime *runtime, CodeBlock *codeBlock, uint32_t offset) {
+    return nullptr;
+  }
+
+  /// Regexes are never compiled. \return nullptr.
+  RegexJITFunction compileRegex(
+      RegexJITEntry *&entry,
+      llvm::ArrayRef<uint8_t> bytecode) {
+    return nullptr;
+  }
+
+  /// Never called, since no regex is compiled.
+  int runRegex(
+      RegexJITFunction code,
+      const char *first,
+      const char *last,
+      const char *start,
+      const char **captures) {
+    llvm_unreachable("regexes are not compiled");
+  }
+
   /// \return true if JIT compilation is enabled.
   bool isEnabled() const {
     return false;
@@ -74,6 +108,41 @@ class JITContext {
   bool getCrashOnError() {
     return false;
   }
+
+  /// Set the number of calls after which a function is compiled.
+  void setInvocationThreshold(uint32_t threshold) {}
+
+  /// Set the number of loop back-edges taken in the interpreter after which a
+  /// function is compiled.
+  void setLoopThreshold(uint32_t threshold) {}
+
+  /// Set the number of searches after which a regex is compiled.
+  void setRegExpThreshold(uint32_t threshold) {}
+
+  /// Set the base that compressed heap pointers are offsets from.
+  void setPointerBase(const PointerBase *base) {}
+
+  /// Enable or disable compiling functions on a background thread.
+  void setBackgroundCompilation(bool background) {}
+
+  /// Forget all functions of \p runtimeModule before its CodeBlocks are
+  /// destroyed.
+  void removeRuntimeModule(RuntimeModule *runtimeModule) {}
+
+  /// There is no profile to load. Ignore \p data.
+  void setProfile(llvm::ArrayRef<uint8_t> data) {}
+
+  /// No function is ever compiled, so \p data is left unchanged.
+  void getProfile(std::vector<uint8_t> &data) const {}
+
+  /// Called when \p codeBlock is created.
+  void noteCodeBlockCreated(CodeBlock *codeBlock) {}
+
+  /// Record that the native code of \p codeBlock is being entered.
+  void noteUse(CodeBlock *codeBlock) {}
+
+  /// Print statistics about the compiled code to \p os.
+  void printStats(llvm::raw_ostream &os) {}
 };
 
 } // namespace vm
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_VM_JIT_JITPROFILE_H
+#define HERMES_VM_JIT_JITPROFILE_H
+
+#include "hermes/Support/SHA1.h"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+
+#include <map>
+#include <vector>
+
+namespace hermes {
+namespace vm {
+
+class CodeBlock;
+
+/// The functions which the JIT compiled in previous runs, so that a new run
+/// can compile them on their first call instead of interpreting them until
+/// they become hot again. A function is identified by the source hash of its
+/// bytecode file and its function ID, and its entry is only used while a
+/// checksum of its bytecode still matches. Functions which were not loaded
+/// from a bytecode file have no source hash and are never recorded.
+class JITProfile {
+ public:
+  /// Magic number of a serialized profile.
+  static constexpr uint32_t kMagic = 0x4650544A;
+
+  /// Version of the serialized format.
+  static constexpr uint32_t kVersion = 1;
+
+  /// Replace the contents of the profile with \p data, as produced by
+  /// serialize().
+  /// \return false if \p data is not a valid profile, in which case the
+  ///   profile is left empty.
+  bool deserialize(llvm::ArrayRef<uint8_t> data);
+
+  /// Append the profile to \p out.
+  void serialize(std::vector<uint8_t> &out) const;
+
+  /// Record that \p codeBlock was compiled.
+  void add(const CodeBlock *codeBlock);
+
+  /// \return true if \p codeBlock, with the same bytecode, was compiled in a
+  ///   previous run or by add().
+  bool contains(const CodeBlock *codeBlock) const;
+
+  /// \return true if no function is recorded.
+  bool empty() const {
+    return files_.empty();
+  }
+
+ private:
+  /// The checksum of the bytecode of the recorded functions of one file, by
+  /// function ID.
+  using FunctionMap = llvm::DenseMap<uint32_t, uint32_t>;
+
+  /// The recorded functions by source hash of their file.
+  std::map<SHA1, FunctionMap> files_{};
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_JIT_JITPROFILE_H
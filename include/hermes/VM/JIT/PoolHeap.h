@@ -38,6 +38,9 @@ class PoolHeap {
   /// \return the address of the block or nullptr if no memory.
   void *alloc(size_t size);
 
+  /// \return true if a block of size \p size could currently be allocated.
+  bool canAlloc(size_t size) const;
+
   /// Split a previously allocated block \p block in two at offset \p keepSize.
   /// The second part of the block is freed. The block cannot be nullptr.
   void freeRemaining(void *block, size_t keepSize);
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_VM_JIT_REGEXJIT_H
+#define HERMES_VM_JIT_REGEXJIT_H
+
+#include <cstdint>
+
+namespace hermes {
+namespace vm {
+
+/// The memory the native code of a regex uses to backtrack.
+struct RegexJITStack {
+  /// The start of the backtracking stack.
+  uintptr_t *begin;
+  /// The end of the backtracking stack.
+  uintptr_t *end;
+  /// The number of times the search may backtrack before giving up.
+  uint64_t backtracksLeft;
+};
+
+/// The result of a search performed by the native code of a regex.
+enum RegexJITResult : int {
+  /// The search was abandoned because it backtracked too many times or ran
+  /// out of backtracking stack. It has to be performed by the interpreter.
+  RegexJITGiveUp = -1,
+  RegexJITNoMatch = 0,
+  RegexJITMatch = 1,
+};
+
+/// The native code compiled from regex bytecode. It searches the ASCII string
+/// [\p first, \p last) for a match starting at or after \p start, and returns
+/// a RegexJITResult. On a match, \p captures is set to the start and end of
+/// the match followed by the start and end of each capture group, or nullptr
+/// for the groups which didn't match.
+using RegexJITFunction = int (*)(
+    const char *first,
+    const char *last,
+    const char *start,
+    const char **captures,
+    RegexJITStack *stack);
+
+/// What the JIT knows about the regexes compiled to a given bytecode.
+struct RegexJITEntry {
+  /// Number of searches performed by the interpreter so far.
+  uint32_t searchCount{0};
+  /// Set if the bytecode can't be compiled.
+  bool dontJIT{false};
+  /// The native code, or nullptr if it hasn't been compiled.
+  RegexJITFunction code{nullptr};
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_JIT_REGEXJIT_H
@@ -0,0 +1,591 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+//===----------------------------------------------------------------------===//
+/// \file
+/// The AArch64 (A64) binary instruction emitter.
+/// Every A64 instruction is a single little-endian 32-bit word, so unlike the
+/// x86-64 emitter there is no addressing mode machinery: each method encodes
+/// exactly one instruction. Operations which don't fit in one instruction
+/// (large immediates, far branches) are composed by the JIT itself.
+//===----------------------------------------------------------------------===//
+
+#ifndef HERMES_VM_JIT_ARM64_EMITTER_H
+#define HERMES_VM_JIT_ARM64_EMITTER_H
+
+#include "hermes/Support/Compiler.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+namespace hermes {
+namespace vm {
+namespace arm64 {
+
+/// A general purpose register. The same number refers to the 64-bit (X) and
+/// the 32-bit (W) view; the width is selected by the emitter method.
+/// Register 31 is either the stack pointer or the zero register depending on
+/// the instruction.
+enum class Reg : uint8_t {
+  x0 = 0,
+  x1,
+  x2,
+  x3,
+  x4,
+  x5,
+  x6,
+  x7,
+  x8,
+  x9,
+  x10,
+  x11,
+  x12,
+  x13,
+  x14,
+  x15,
+  /// Intra-procedure-call scratch registers, reserved by the emitter helpers.
+  x16,
+  x17,
+  /// The platform register; never used.
+  x18,
+  x19,
+  x20,
+  x21,
+  x22,
+  x23,
+  x24,
+  x25,
+  x26,
+  x27,
+  x28,
+  /// Frame pointer.
+  x29,
+  /// Link register.
+  x30,
+  sp = 31,
+  zr = 31,
+};
+
+/// A SIMD&FP register, used only in its 64-bit (D) form.
+enum class FReg : uint8_t {
+  d0 = 0,
+  d1,
+  d2,
+  d3,
+  d4,
+  d5,
+  d6,
+  d7,
+};
+
+/// Condition codes, with the encoding used by B.cond and CSINC.
+enum class Cond : uint8_t {
+  EQ = 0,
+  NE = 1,
+  HS = 2,
+  LO = 3,
+  MI = 4,
+  PL = 5,
+  VS = 6,
+  VC = 7,
+  HI = 8,
+  LS = 9,
+  GE = 10,
+  LT = 11,
+  GT = 12,
+  LE = 13,
+};
+
+/// \return the condition which holds exactly when \p cc doesn't.
+inline constexpr Cond invert(Cond cc) {
+  return (Cond)((uint8_t)cc ^ 1);
+}
+
+/// Operand width of integer instructions.
+enum class W {
+  /// 32-bit (W registers).
+  L,
+  /// 64-bit (X registers).
+  Q,
+};
+
+/// \return true if \p x fits in a signed field of \p bits bits.
+inline constexpr bool isIntN(unsigned bits, int64_t x) {
+  return x >= -(int64_t(1) << (bits - 1)) && x < (int64_t(1) << (bits - 1));
+}
+
+/// \return true if \p x can be the unsigned 12-bit immediate of ADD/SUB/CMP.
+inline constexpr bool isAddSubImm(uint64_t x) {
+  return x < 4096;
+}
+
+/// An emitter of A64 instructions into a buffer.
+/// As with the x86-64 emitter, this class is trivially copyable and keeps no
+/// state except the output pointer. It doesn't check for buffer overflow; the
+/// caller must ensure there is enough space before emitting.
+class Emitter {
+ public:
+  static constexpr unsigned MAX_INSTRUCTION_LENGTH = 4;
+
+  explicit Emitter(uint8_t *buf) : out(buf) {}
+
+  Emitter(const Emitter &) = default;
+  Emitter &operator=(const Emitter &) = default;
+  ~Emitter() = default;
+
+  /// \return the current output pointer.
+  uint8_t *current() const {
+    return out;
+  }
+
+  /// Set the current output pointer.
+  void setCurrent(uint8_t *buf) {
+    out = buf;
+  }
+
+  template <uintptr_t x>
+  void align() {
+    out = reinterpret_cast<uint8_t *>(
+        (reinterpret_cast<uintptr_t>(out) + (x - 1)) & ~(x - 1));
+  }
+
+  template <typename T>
+  void numericConst(T x) {
+    std::memcpy(out, &x, sizeof(T));
+    out += sizeof(T);
+  }
+
+  /// @name Moves
+  /// @{
+
+  /// movz: \p rd = \p imm16 << (16 * \p hw).
+  template <W w = W::Q>
+  void movz(Reg rd, uint16_t imm16, unsigned hw = 0) {
+    emit(sf<w>() | 0x52800000 | (hw << 21) | (imm16 << 5) | r(rd));
+  }
+  /// movk: replace halfword \p hw of \p rd with \p imm16.
+  template <W w = W::Q>
+  void movk(Reg rd, uint16_t imm16, unsigned hw = 0) {
+    emit(sf<w>() | 0x72800000 | (hw << 21) | (imm16 << 5) | r(rd));
+  }
+  /// movn: \p rd = ~(\p imm16 << (16 * \p hw)).
+  template <W w = W::Q>
+  void movn(Reg rd, uint16_t imm16, unsigned hw = 0) {
+    emit(sf<w>() | 0x12800000 | (hw << 21) | (imm16 << 5) | r(rd));
+  }
+
+  /// \return the number of instructions \c movImm() emits for \p imm.
+  static unsigned movImmLength(uint64_t imm) {
+    unsigned zeroHalves = 0, onesHalves = 0;
+    countHalves(imm, zeroHalves, onesHalves);
+    unsigned len = 4 - std::max(zeroHalves, onesHalves);
+    return len ? len : 1;
+  }
+
+  /// Materialize an arbitrary 64-bit immediate in \p rd using the shortest
+  /// movz/movn + movk sequence (1 to 4 instructions).
+  void movImm(Reg rd, uint64_t imm) {
+    unsigned zeroHalves = 0, onesHalves = 0;
+    countHalves(imm, zeroHalves, onesHalves);
+    bool useMovn = onesHalves > zeroHalves;
+    uint16_t skip = useMovn ? 0xffff : 0;
+    bool first = true;
+    for (unsigned hw = 0; hw != 4; ++hw) {
+      uint16_t half = imm >> (16 * hw);
+      if (half == skip)
+        continue;
+      if (first) {
+        if (useMovn)
+          movn(rd, ~half, hw);
+        else
+          movz(rd, half, hw);
+        first = false;
+      } else {
+        movk(rd, half, hw);
+      }
+    }
+    // All halves were skipped: the value is 0 or ~0.
+    if (first) {
+      if (useMovn)
+        movn(rd, 0);
+      else
+        movz(rd, 0);
+    }
+  }
+
+  /// mov: \p rd = \p rm. Neither register may be sp.
+  template <W w = W::Q>
+  void movRegToReg(Reg rm, Reg rd) {
+    orrReg<w>(rd, Reg::zr, rm);
+  }
+
+  /// mov to or from sp: \p rd = \p rn + 0.
+  void movSP(Reg rn, Reg rd) {
+    addImm(rd, rn, 0);
+  }
+
+  /// @}
+
+  /// @name Integer arithmetic and logic
+  /// @{
+
+  /// add: \p rd = \p rn + \p imm12. \p rn and \p rd may be sp.
+  template <W w = W::Q>
+  void addImm(Reg rd, Reg rn, uint32_t imm12) {
+    assert(isAddSubImm(imm12) && "immediate out of range");
+    emit(sf<w>() | 0x11000000 | (imm12 << 10) | (r(rn) << 5) | r(rd));
+  }
+  /// sub: \p rd = \p rn - \p imm12. \p rn and \p rd may be sp.
+  template <W w = W::Q>
+  void subImm(Reg rd, Reg rn, uint32_t imm12) {
+    assert(isAddSubImm(imm12) && "immediate out of range");
+    emit(sf<w>() | 0x51000000 | (imm12 << 10) | (r(rn) << 5) | r(rd));
+  }
+  /// cmp: set the flags for \p rn - \p imm12.
+  template <W w = W::Q>
+  void cmpImm(Reg rn, uint32_t imm12) {
+    assert(isAddSubImm(imm12) && "immediate out of range");
+    emit(sf<w>() | 0x71000000 | (imm12 << 10) | (r(rn) << 5) | r(Reg::zr));
+  }
+
+  /// add: \p rd = \p rn + \p rm.
+  template <W w = W::Q>
+  void addReg(Reg rd, Reg rn, Reg rm) {
+    emit(sf<w>() | 0x0B000000 | (r(rm) << 16) | (r(rn) << 5) | r(rd));
+  }
+  /// sub: \p rd = \p rn - \p rm.
+  template <W w = W::Q>
+  void subReg(Reg rd, Reg rn, Reg rm) {
+    emit(sf<w>() | 0x4B000000 | (r(rm) << 16) | (r(rn) << 5) | r(rd));
+  }
+  /// cmp: set the flags for \p rn - \p rm.
+  template <W w = W::Q>
+  void cmpReg(Reg rn, Reg rm) {
+    emit(sf<w>() | 0x6B000000 | (r(rm) << 16) | (r(rn) << 5) | r(Reg::zr));
+  }
+
+  /// and: \p rd = \p rn & \p rm.
+  template <W w = W::Q>
+  void andReg(Reg rd, Reg rn, Reg rm) {
+    emit(sf<w>() | 0x0A000000 | (r(rm) << 16) | (r(rn) << 5) | r(rd));
+  }
+  /// orr: \p rd = \p rn | \p rm.
+  template <W w = W::Q>
+  void orrReg(Reg rd, Reg rn, Reg rm) {
+    emit(sf<w>() | 0x2A000000 | (r(rm) << 16) | (r(rn) << 5) | r(rd));
+  }
+  /// eor: \p rd = \p rn ^ \p rm.
+  template <W w = W::Q>
+  void eorReg(Reg rd, Reg rn, Reg rm) {
+    emit(sf<w>() | 0x4A000000 | (r(rm) << 16) | (r(rn) << 5) | r(rd));
+  }
+  /// mvn: \p rd = ~\p rm.
+  template <W w = W::Q>
+  void mvnReg(Reg rd, Reg rm) {
+    emit(sf<w>() | 0x2A200000 | (r(rm) << 16) | (r(Reg::zr) << 5) | r(rd));
+  }
+
+  /// ubfm, the primitive behind the immediate shifts and zero extensions.
+  template <W w = W::Q>
+  void ubfm(Reg rd, Reg rn, unsigned immr, unsigned imms) {
+    uint32_t n = w == W::Q ? (1u << 22) : 0;
+    emit(
+        sf<w>() | 0x53000000 | n | (immr << 16) | (imms << 10) | (r(rn) << 5) |
+        r(rd));
+  }
+  /// lsr: \p rd = \p rn >> \p shift (logical).
+  template <W w = W::Q>
+  void lsrImm(Reg rd, Reg rn, unsigned shift) {
+    ubfm<w>(rd, rn, shift, bits<w>() - 1);
+  }
+  /// lsl: \p rd = \p rn << \p shift.
+  template <W w = W::Q>
+  void lslImm(Reg rd, Reg rn, unsigned shift) {
+    ubfm<w>(rd, rn, (bits<w>() - shift) % bits<w>(), bits<w>() - 1 - shift);
+  }
+  /// uxtb: \p rd = \p rn & 0xff.
+  void uxtb(Reg rd, Reg rn) {
+    ubfm<W::L>(rd, rn, 0, 7);
+  }
+
+  /// cset: \p rd = \p cc ? 1 : 0.
+  template <W w = W::Q>
+  void cset(Reg rd, Cond cc) {
+    emit(
+        sf<w>() | 0x1A800400 | (r(Reg::zr) << 16) |
+        ((uint32_t)invert(cc) << 12) | (r(Reg::zr) << 5) | r(rd));
+  }
+
+  /// @}
+
+  /// @name Loads and stores
+  /// The immediate forms take a byte offset. The unsigned offset form requires
+  /// it to be a non-negative multiple of the access size below 4096 accesses;
+  /// the unscaled form accepts [-256, 255].
+  /// @{
+
+  template <W w = W::Q>
+  void ldrImm(Reg rt, Reg rn, uint32_t offset) {
+    emit(ldstSize<w>() | 0x39400000 | scaledOff<w>(offset) | ldst(rn, rt));
+  }
+  template <W w = W::Q>
+  void strImm(Reg rt, Reg rn, uint32_t offset) {
+    emit(ldstSize<w>() | 0x39000000 | scaledOff<w>(offset) | ldst(rn, rt));
+  }
+  template <W w = W::Q>
+  void ldur(Reg rt, Reg rn, int32_t offset) {
+    emit(ldstSize<w>() | 0x38400000 | unscaledOff(offset) | ldst(rn, rt));
+  }
+  template <W w = W::Q>
+  void stur(Reg rt, Reg rn, int32_t offset) {
+    emit(ldstSize<w>() | 0x38000000 | unscaledOff(offset) | ldst(rn, rt));
+  }
+  /// ldr \p rt, [\p rn, \p rm] or, if \p scaled, [\p rn, \p rm, lsl #log2
+  /// size].
+  template <W w = W::Q>
+  void ldrReg(Reg rt, Reg rn, Reg rm, bool scaled = false) {
+    emit(
+        ldstSize<w>() | 0x38606800 | (scaled ? 0x1000 : 0) | (r(rm) << 16) |
+        ldst(rn, rt));
+  }
+  template <W w = W::Q>
+  void strReg(Reg rt, Reg rn, Reg rm, bool scaled = false) {
+    emit(
+        ldstSize<w>() | 0x38206800 | (scaled ? 0x1000 : 0) | (r(rm) << 16) |
+        ldst(rn, rt));
+  }
+
+  void ldrbImm(Reg rt, Reg rn, uint32_t offset) {
+    assert(offset < 4096 && "offset out of range");
+    emit(0x39400000 | (offset << 10) | ldst(rn, rt));
+  }
+  void ldurb(Reg rt, Reg rn, int32_t offset) {
+    emit(0x38400000 | unscaledOff(offset) | ldst(rn, rt));
+  }
+
+  void ldrfpImm(FReg rt, Reg rn, uint32_t offset) {
+    emit(0xFD400000 | scaledOff<W::Q>(offset) | ldst(rn, rt));
+  }
+  void strfpImm(FReg rt, Reg rn, uint32_t offset) {
+    emit(0xFD000000 | scaledOff<W::Q>(offset) | ldst(rn, rt));
+  }
+  void ldurfp(FReg rt, Reg rn, int32_t offset) {
+    emit(0xFC400000 | unscaledOff(offset) | ldst(rn, rt));
+  }
+  void sturfp(FReg rt, Reg rn, int32_t offset) {
+    emit(0xFC000000 | unscaledOff(offset) | ldst(rn, rt));
+  }
+  void ldrfpReg(FReg rt, Reg rn, Reg rm) {
+    emit(0xFC606800 | (r(rm) << 16) | ldst(rn, rt));
+  }
+  void strfpReg(FReg rt, Reg rn, Reg rm) {
+    emit(0xFC206800 | (r(rm) << 16) | ldst(rn, rt));
+  }
+
+  /// stp \p rt1, \p rt2, [\p rn, #\p offset]! (pre-indexed).
+  void stpPre(Reg rt1, Reg rt2, Reg rn, int32_t offset) {
+    emit(0xA9800000 | pairOff(offset) | ldstPair(rn, rt1, rt2));
+  }
+  /// stp \p rt1, \p rt2, [\p rn, #\p offset].
+  void stp(Reg rt1, Reg rt2, Reg rn, int32_t offset) {
+    emit(0xA9000000 | pairOff(offset) | ldstPair(rn, rt1, rt2));
+  }
+  /// ldp \p rt1, \p rt2, [\p rn], #\p offset (post-indexed).
+  void ldpPost(Reg rt1, Reg rt2, Reg rn, int32_t offset) {
+    emit(0xA8C00000 | pairOff(offset) | ldstPair(rn, rt1, rt2));
+  }
+  /// ldp \p rt1, \p rt2, [\p rn, #\p offset].
+  void ldp(Reg rt1, Reg rt2, Reg rn, int32_t offset) {
+    emit(0xA9400000 | pairOff(offset) | ldstPair(rn, rt1, rt2));
+  }
+
+  /// adrp: \p rd = the 4KiB page containing \p target.
+  void adrp(Reg rd, const void *target) {
+    int64_t pages = (int64_t)((uintptr_t)target >> 12) -
+        (int64_t)((uintptr_t)out >> 12);
+    assert(isIntN(21, pages) && "adrp target out of range");
+    uint32_t imm = (uint32_t)pages & 0x1fffff;
+    emit(0x90000000 | ((imm & 3) << 29) | ((imm >> 2) << 5) | r(rd));
+  }
+
+  /// @}
+
+  /// @name Floating point
+  /// @{
+
+  void fadd(FReg rd, FReg rn, FReg rm) {
+    emit(0x1E602800 | fp3(rd, rn, rm));
+  }
+  void fsub(FReg rd, FReg rn, FReg rm) {
+    emit(0x1E603800 | fp3(rd, rn, rm));
+  }
+  void fmul(FReg rd, FReg rn, FReg rm) {
+    emit(0x1E600800 | fp3(rd, rn, rm));
+  }
+  void fdiv(FReg rd, FReg rn, FReg rm) {
+    emit(0x1E601800 | fp3(rd, rn, rm));
+  }
+  void fneg(FReg rd, FReg rn) {
+    emit(0x1E614000 | ((uint32_t)rn << 5) | (uint32_t)rd);
+  }
+  /// fcmp: set the flags comparing \p rn with \p rm. Unordered operands set
+  /// C and V.
+  void fcmp(FReg rn, FReg rm) {
+    emit(0x1E602000 | ((uint32_t)rm << 16) | ((uint32_t)rn << 5));
+  }
+  /// fcvtzs: \p rd (32-bit) = (int32_t)\p rn, rounding towards zero.
+  void fcvtzsToW(Reg rd, FReg rn) {
+    emit(0x1E780000 | ((uint32_t)rn << 5) | r(rd));
+  }
+  /// scvtf: \p rd = (double)\p rn, where \p rn is a signed 32-bit value.
+  void scvtfFromW(FReg rd, Reg rn) {
+    emit(0x1E620000 | (r(rn) << 5) | (uint32_t)rd);
+  }
+  /// ucvtf: \p rd = (double)\p rn, where \p rn is an unsigned 32-bit value.
+  void ucvtfFromW(FReg rd, Reg rn) {
+    emit(0x1E630000 | (r(rn) << 5) | (uint32_t)rd);
+  }
+
+  /// @}
+
+  /// @name Branches
+  /// The targets of the PC-relative branches may be set to the instruction
+  /// itself and patched later with \c patchBranch.
+  /// @{
+
+  void b(const uint8_t *target) {
+    emit(0x14000000 | branchOff(26, target));
+  }
+  void bcond(Cond cc, const uint8_t *target) {
+    emit(0x54000000 | (branchOff(19, target) << 5) | (uint32_t)cc);
+  }
+  template <W w = W::Q>
+  void cbz(Reg rt, const uint8_t *target) {
+    emit(sf<w>() | 0x34000000 | (branchOff(19, target) << 5) | r(rt));
+  }
+  template <W w = W::Q>
+  void cbnz(Reg rt, const uint8_t *target) {
+    emit(sf<w>() | 0x35000000 | (branchOff(19, target) << 5) | r(rt));
+  }
+  void blr(Reg rn) {
+    emit(0xD63F0000 | (r(rn) << 5));
+  }
+  void br(Reg rn) {
+    emit(0xD61F0000 | (r(rn) << 5));
+  }
+  void ret() {
+    emit(0xD65F0000 | (r(Reg::x30) << 5));
+  }
+
+  /// \return true if a branch at \p from with a \p bits wide offset field can
+  ///   reach \p to.
+  static bool
+  inBranchRange(unsigned bits, const uint8_t *from, const uint8_t *to) {
+    return isIntN(bits, (to - from) / 4);
+  }
+
+  /// Patch the offset of the B, B.cond, CBZ or CBNZ instruction at \p insn to
+  /// point to \p target.
+  static void patchBranch(uint8_t *insn, const uint8_t *target) {
+    uint32_t word;
+    std::memcpy(&word, insn, 4);
+    int64_t delta = (target - insn) / 4;
+    if ((word & 0x7C000000) == 0x14000000) {
+      // B / BL: imm26 at bit 0.
+      assert(isIntN(26, delta) && "branch target out of range");
+      word = (word & ~0x03FFFFFFu) | ((uint32_t)delta & 0x03FFFFFF);
+    } else {
+      // B.cond / CBZ / CBNZ: imm19 at bit 5.
+      assert(isIntN(19, delta) && "branch target out of range");
+      word = (word & ~(0x7FFFFu << 5)) | (((uint32_t)delta & 0x7FFFF) << 5);
+    }
+    std::memcpy(insn, &word, 4);
+  }
+
+  /// @}
+
+ private:
+  void emit(uint32_t word) {
+    std::memcpy(out, &word, 4);
+    out += 4;
+  }
+
+  /// Count the 16-bit halves of \p imm which are all zeros or all ones.
+  static void
+  countHalves(uint64_t imm, unsigned &zeroHalves, unsigned &onesHalves) {
+    for (unsigned hw = 0; hw != 4; ++hw) {
+      uint16_t half = imm >> (16 * hw);
+      zeroHalves += half == 0;
+      onesHalves += half == 0xffff;
+    }
+  }
+
+  static constexpr uint32_t r(Reg reg) {
+    return (uint32_t)reg;
+  }
+
+  template <W w>
+  static constexpr uint32_t sf() {
+    return w == W::Q ? 0x80000000 : 0;
+  }
+  template <W w>
+  static constexpr unsigned bits() {
+    return w == W::Q ? 64 : 32;
+  }
+  /// The size field (bits 30-31) of a load/store.
+  template <W w>
+  static constexpr uint32_t ldstSize() {
+    return w == W::Q ? 0xC0000000 : 0x80000000;
+  }
+
+  template <W w>
+  static uint32_t scaledOff(uint32_t offset) {
+    constexpr unsigned size = w == W::Q ? 8 : 4;
+    assert(
+        offset % size == 0 && offset / size < 4096 &&
+        "scaled offset out of range");
+    return (offset / size) << 10;
+  }
+  static uint32_t unscaledOff(int32_t offset) {
+    assert(isIntN(9, offset) && "unscaled offset out of range");
+    return ((uint32_t)offset & 0x1ff) << 12;
+  }
+  static uint32_t pairOff(int32_t offset) {
+    assert(offset % 8 == 0 && isIntN(7, offset / 8) && "pair offset invalid");
+    return ((uint32_t)(offset / 8) & 0x7f) << 15;
+  }
+  template <typename T>
+  static uint32_t ldst(Reg rn, T rt) {
+    return (r(rn) << 5) | (uint32_t)rt;
+  }
+  static uint32_t ldstPair(Reg rn, Reg rt1, Reg rt2) {
+    return (r(rt2) << 10) | (r(rn) << 5) | r(rt1);
+  }
+  static constexpr uint32_t fp3(FReg rd, FReg rn, FReg rm) {
+    return ((uint32_t)rm << 16) | ((uint32_t)rn << 5) | (uint32_t)rd;
+  }
+
+  uint32_t branchOff(unsigned bits, const uint8_t *target) const {
+    int64_t delta = (target - out) / 4;
+    assert((target - out) % 4 == 0 && "misaligned branch target");
+    assert(isIntN(bits, delta) && "branch target out of range");
+    return (uint32_t)delta & ((1u << bits) - 1);
+  }
+
+  uint8_t *out;
+} HERMES_ATTRIBUTE_WARN_UNUSED_RESULT_TYPE;
+
+static_assert(
+    IsTriviallyCopyable<Emitter, true>::value,
+    "Emitter must be trivially copyable");
+
+} // namespace arm64
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_JIT_ARM64_EMITTER_H
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_VM_JIT_ARM64_JIT_H
+#define HERMES_VM_JIT_ARM64_JIT_H
+
+#include "hermes/VM/CodeBlock.h"
+#include "hermes/VM/JIT/CodeCache.h"
+#include "hermes/VM/JIT/ExecHeap.h"
+#include "hermes/VM/JIT/JITProfile.h"
+#include "hermes/VM/JIT/NativeDisassembler.h"
+#include "hermes/VM/JIT/RegexJIT.h"
+
+namespace hermes {
+namespace vm {
+namespace arm64 {
+
+/// All state related to JIT compilation.
+class JITContext {
+ public:
+  /// Construct a JIT context. No executable memory is allocated before it is
+  /// needed.
+  /// \param enable whether JIT is enabled.
+  /// \param blockSize the size of individual blocks of executable memory to be
+  ///     allocated.
+  /// \param maximum amount of executable memory that can be allocated by the
+  ///     JIT.
+  JITContext(bool enable, size_t blockSize, size_t maxMemory);
+  ~JITContext();
+
+  JITContext(const JITContext &) = delete;
+  void operator=(const JITContext &) = delete;
+
+  /// Compile a function to native code and return the native pointer. If the
+  /// function was previously compiled, return the existing body. If it cannot
+  /// be compiled, return nullptr.
+  inline JITCompiledFunctionPtr compile(Runtime *runtime, CodeBlock *codeBlock);
+
+  /// Called by the interpreter after it has taken a loop back-edge to the
+  /// bytecode \p offset in \p codeBlock. If the function is hot enough,
+  /// compile it and return the native entry point that continues at the loop
+  /// header, reusing the registers of the current interpreter frame. Otherwise
+  /// return nullptr.
+  inline JITCompiledFunctionPtr
+  compileOSR(Runtime *runtime, CodeBlock *codeBlock, uint32_t offset);
+
+  /// Regexes are only compiled on x86-64. \return nullptr.
+  RegexJITFunction compileRegex(
+      RegexJITEntry *&entry,
+      llvm::ArrayRef<uint8_t> bytecode) {
+    return nullptr;
+  }
+
+  /// Never called, since no regex is compiled.
+  int runRegex(
+      RegexJITFunction code,
+      const char *first,
+      const char *last,
+      const char *start,
+      const char **captures) {
+    llvm_unreachable("regexes are not compiled");
+  }
+
+  /// \return true if JIT compilation is enabled.
+  bool isEnabled() const {
+    return enabled_;
+  }
+
+  /// Enable or disable JIT compilation.
+  void setEnabled(bool enabled) {
+    enabled_ = enabled;
+  }
+
+  /// Enable or disable dumping JIT'ed Code.
+  void setDumpJITCode(bool dump) {
+    dumpJITCode_ = dump;
+  }
+
+  /// \return true if dumping JIT'ed Code is enabled.
+  bool getDumpJITCode() {
+    return dumpJITCode_;
+  }
+
+  /// Set the flag to fatally crash on JIT compilation errors.
+  void setCrashOnError(bool crash) {
+    crashOnError_ = crash;
+  }
+
+  /// \return true if we should fatally crash on JIT compilation errors.
+  bool getCrashOnError() {
+    return crashOnError_;
+  }
+
+  /// Set the number of calls after which a function is compiled.
+  void setInvocationThreshold(uint32_t threshold) {
+    invocationThreshold_ = threshold;
+  }
+
+  /// Set the number of loop back-edges taken in the interpreter after which a
+  /// function is compiled.
+  void setLoopThreshold(uint32_t threshold) {
+    loopThreshold_ = threshold;
+  }
+
+  /// Set the number of searches after which a regex is compiled.
+  void setRegExpThreshold(uint32_t threshold) {}
+
+  /// Compiling in the background is not supported: the executable heap is
+  /// W^X, and a pool cannot be made writable while the interpreter thread may
+  /// be running other code in it. Functions are always compiled on the
+  /// calling thread.
+  void setBackgroundCompilation(bool background) {}
+
+  /// Set the base that compressed heap pointers are offsets from, so that
+  /// compiled code can decode them.
+  void setPointerBase(const PointerBase *base) {
+    pointerBase_ = base;
+  }
+
+  /// \return the base set by setPointerBase().
+  const PointerBase *getPointerBase() const {
+    return pointerBase_;
+  }
+
+  /// Forget all functions of \p runtimeModule before its CodeBlocks are
+  /// destroyed and free their native code.
+  void removeRuntimeModule(RuntimeModule *runtimeModule);
+
+  /// Load the profile of the functions compiled in previous runs from \p data,
+  /// as produced by getProfile(). Those functions are compiled on their first
+  /// call. Invalid data is ignored.
+  void setProfile(llvm::ArrayRef<uint8_t> data) {
+    profile_.deserialize(data);
+  }
+
+  /// Append to \p data the profile of the functions compiled in this run and
+  /// the previous ones, to be passed to setProfile() in the next run.
+  void getProfile(std::vector<uint8_t> &data) const {
+    profile_.serialize(data);
+  }
+
+  /// Called when \p codeBlock is created. If it was compiled in a previous
+  /// run, make it compile on its first call.
+  void noteCodeBlockCreated(CodeBlock *codeBlock) {
+    if (enabled_ && !profile_.empty() && profile_.contains(codeBlock))
+      codeBlock->setExecutionCount(invocationThreshold_);
+  }
+
+  /// Record that the native code of \p codeBlock is being entered, for the
+  /// eviction of least recently used code.
+  void noteUse(CodeBlock *codeBlock) {
+    codeBlock->setJITLastUse(useClock_);
+  }
+
+  /// Print statistics about the compiled code to \p os.
+  void printStats(llvm::raw_ostream &os);
+
+  /// \return the executable memory heap.
+  ExecHeap &getHeap() {
+    return heap_;
+  }
+
+  /// \return the record of the native code of every compiled function.
+  CodeCache &getCodeCache() {
+    return codeCache_;
+  }
+
+  /// \return the native disassembler for our target.
+  NativeDisassembler &getDisassembler() {
+    return *dis_;
+  }
+
+ private:
+  /// Slow path that actually performs the compilation of the specified
+  /// CodeBlock.
+  JITCompiledFunctionPtr compileImpl(Runtime *runtime, CodeBlock *codeBlock);
+
+ private:
+  /// Whether JIT compilation is enabled.
+  bool enabled_{false};
+  /// Executable heap where all executable code is allocated. It is always
+  /// W^X, since some AArch64 platforms refuse RWX mappings.
+  ExecHeap heap_;
+  /// The native code of every compiled function, for eviction.
+  CodeCache codeCache_{};
+  /// Advanced on every compilation. A function whose native code is entered
+  /// records the current value, so the function which has gone unused for the
+  /// most compilations is evicted first.
+  uint32_t useClock_{0};
+  /// whether to dump JIT'ed code
+  bool dumpJITCode_{false};
+  /// whether to fatally crash on JIT compilation errors
+  bool crashOnError_{false};
+
+  /// The disassembler for our target.
+  std::unique_ptr<NativeDisassembler> dis_ =
+      NativeDisassembler::create(NativeDisassembler::aarch64_unknown_linux_gnu);
+
+  /// The functions compiled in this run and the previous ones.
+  JITProfile profile_{};
+
+  /// A function is compiled once it has been called this many times.
+  uint32_t invocationThreshold_{0};
+  /// A function is compiled once this many loop back-edges have been taken
+  /// while interpreting it.
+  uint32_t loopThreshold_{0};
+
+  /// The base of compressed pointers into the heap of the runtime.
+  const PointerBase *pointerBase_{nullptr};
+};
+
+LLVM_ATTRIBUTE_ALWAYS_INLINE
+inline JITCompiledFunctionPtr JITContext::compile(
+    Runtime *runtime,
+    CodeBlock *codeBlock) {
+  auto ptr = codeBlock->getJITCompiled();
+  if (LLVM_LIKELY(ptr)) {
+    noteUse(codeBlock);
+    return ptr;
+  }
+  if (LLVM_LIKELY(!enabled_))
+    return nullptr;
+  if (LLVM_LIKELY(codeBlock->getDontJIT()))
+    return nullptr;
+  if (LLVM_LIKELY(
+          codeBlock->getExecutionCount() < invocationThreshold_ &&
+          codeBlock->getBackEdgeCount() < loopThreshold_))
+    return nullptr;
+  return compileImpl(runtime, codeBlock);
+}
+
+LLVM_ATTRIBUTE_ALWAYS_INLINE
+inline JITCompiledFunctionPtr JITContext::compileOSR(
+    Runtime *runtime,
+    CodeBlock *codeBlock,
+    uint32_t offset) {
+  if (LLVM_LIKELY(!enabled_))
+    return nullptr;
+  if (LLVM_LIKELY(codeBlock->getBackEdgeCount() < loopThreshold_))
+    return nullptr;
+  if (!codeBlock->getJITCompiled()) {
+    if (codeBlock->getDontJIT())
+      return nullptr;
+    compileImpl(runtime, codeBlock);
+  }
+  return codeBlock->getOSREntry(offset);
+}
+
+} // namespace arm64
+} // namespace vm
+} // namespace hermes
+#endif // HERMES_VM_JIT_ARM64_JIT_H
@@ -577,6 +577,17 @@ class Emitter {
     _opRMToReg<s, scale, 0x8A>(srcBase, srcIndex, srcOffset, dst);
   }
 
+  /// Load the byte at the given address into the 32-bit register \p dst,
+  /// zero-extended.
+  template <unsigned scale = 0>
+  void movzbRMToReg(Reg srcBase, Reg srcIndex, int32_t srcOffset, Reg dst) {
+    emitREX<S::L>(out, srcBase, srcIndex, ord(dst));
+    *out++ = 0x0F;
+    *out++ = 0xB6;
+    EmitModRM<S::L, 0, scale>::emitModRM(
+        out, srcBase, srcIndex, srcOffset, ord(dst));
+  }
+
   template <S s>
   void movImmToReg(typename OperandType<s>::type imm, Reg reg) {
     static_assert(s != S::SLQ, "SLQ not supported");
@@ -660,6 +671,13 @@ class Emitter {
     _opImmToRm<s, scale, 0x80, 7>(imm, dstBase, dstIndex, dstOffset);
   }
 
+  /// Compare \p dst with the operand at the given address: sets the flags
+  /// according to `dst - [srcBase + srcIndex * scale + srcOffset]`.
+  template <S s, unsigned scale = 0>
+  void cmpRMToReg(Reg srcBase, Reg srcIndex, int32_t srcOffset, Reg dst) {
+    _opRMToReg<s, scale, 0x3A>(srcBase, srcIndex, srcOffset, dst);
+  }
+
   template <S s, unsigned scale = 0>
   void testImmToRM(
       typename OperandType<s>::type imm,
@@ -794,6 +812,14 @@ class Emitter {
     emitConst(out, imm);
   }
 
+  /// shift \p reg to the left by \p imm bits
+  void shlImm8ToReg(typename OperandType<S::B>::type imm, Reg reg) {
+    emitREX<S::Q>(out, reg, Reg::none, 4);
+    *out++ = 0xc1;
+    *out++ = ModeSel<AddrMode::Reg>::modRM(reg, 4);
+    emitConst(out, imm);
+  }
+
   void retq() {
     *out++ = 0xc3;
   }
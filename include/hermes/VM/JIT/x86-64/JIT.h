@@ -8,8 +8,19 @@
 #define HERMES_VM_JIT_X86_64_JIT_H
 
 #include "hermes/VM/CodeBlock.h"
+#include "hermes/VM/JIT/CodeCache.h"
 #include "hermes/VM/JIT/ExecHeap.h"
+#include "hermes/VM/JIT/JITProfile.h"
 #include "hermes/VM/JIT/NativeDisassembler.h"
+#include "hermes/VM/JIT/RegexJIT.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace hermes {
 namespace vm {
@@ -33,9 +44,35 @@ class JITContext {
 
   /// Compile a function to native code and return the native pointer. If the
   /// function was previously compiled, return the existing body. If it cannot
-  /// be compiled, return nullptr.
+  /// be compiled, or is being compiled in the background, return nullptr.
   inline JITCompiledFunctionPtr compile(Runtime *runtime, CodeBlock *codeBlock);
 
+  /// Called by the interpreter after it has taken a loop back-edge to the
+  /// bytecode \p offset in \p codeBlock. If the function is hot enough,
+  /// compile it and return the native entry point that continues at the loop
+  /// header, reusing the registers of the current interpreter frame. Otherwise
+  /// return nullptr.
+  inline JITCompiledFunctionPtr
+  compileOSR(Runtime *runtime, CodeBlock *codeBlock, uint32_t offset);
+
+  /// Called before searching with the regex bytecode \p bytecode, whose entry
+  /// is cached in \p entry and looked up on the first call. If the bytecode
+  /// has been searched with enough times, compile it.
+  /// \return the native code, or nullptr if the search must be interpreted.
+  inline RegexJITFunction compileRegex(
+      RegexJITEntry *&entry,
+      llvm::ArrayRef<uint8_t> bytecode);
+
+  /// Search the ASCII string [\p first, \p last) from \p start with the
+  /// native code \p code of a regex, setting \p captures like the native
+  /// code does. \return a RegexJITResult.
+  int runRegex(
+      RegexJITFunction code,
+      const char *first,
+      const char *last,
+      const char *start,
+      const char **captures);
+
   /// \return true if JIT compilation is enabled.
   bool isEnabled() const {
     return enabled_;
@@ -66,11 +103,97 @@ class JITContext {
     return crashOnError_;
   }
 
+  /// Set the number of calls after which a function is compiled.
+  void setInvocationThreshold(uint32_t threshold) {
+    invocationThreshold_ = threshold;
+  }
+
+  /// Set the number of loop back-edges taken in the interpreter after which a
+  /// function is compiled.
+  void setLoopThreshold(uint32_t threshold) {
+    loopThreshold_ = threshold;
+  }
+
+  /// Set the number of searches after which a regex is compiled.
+  void setRegExpThreshold(uint32_t threshold) {
+    regExpThreshold_ = threshold;
+  }
+
+  /// Enable or disable compiling functions on a background thread. While a
+  /// function is being compiled the interpreter keeps executing it, and
+  /// switches to the native code on its next call or loop back-edge after it
+  /// is ready. This must be set before the first function is compiled.
+  void setBackgroundCompilation(bool background) {
+    background_ = background;
+  }
+
+  /// \return true if functions are compiled on a background thread.
+  bool getBackgroundCompilation() const {
+    return background_;
+  }
+
+  /// Set the base that compressed heap pointers are offsets from, so that
+  /// compiled code can decode them.
+  void setPointerBase(const PointerBase *base) {
+    pointerBase_ = base;
+  }
+
+  /// \return the base set by setPointerBase().
+  const PointerBase *getPointerBase() const {
+    return pointerBase_;
+  }
+
+  /// Forget all functions of \p runtimeModule before its CodeBlocks are
+  /// destroyed: remove them from the background compilation queue, wait for
+  /// the one that is being compiled if it belongs to it, and free their
+  /// native code.
+  void removeRuntimeModule(RuntimeModule *runtimeModule);
+
+  /// Load the profile of the functions compiled in previous runs from \p data,
+  /// as produced by getProfile(). Those functions are compiled on their first
+  /// call. Invalid data is ignored.
+  void setProfile(llvm::ArrayRef<uint8_t> data) {
+    profile_.deserialize(data);
+  }
+
+  /// Append to \p data the profile of the functions compiled in this run and
+  /// the previous ones, to be passed to setProfile() in the next run.
+  void getProfile(std::vector<uint8_t> &data) const {
+    profile_.serialize(data);
+  }
+
+  /// Called when \p codeBlock is created. If it was compiled in a previous
+  /// run, make it compile on its first call.
+  void noteCodeBlockCreated(CodeBlock *codeBlock) {
+    if (enabled_ && !profile_.empty() && profile_.contains(codeBlock))
+      codeBlock->setExecutionCount(invocationThreshold_);
+  }
+
+  /// Record that the native code of \p codeBlock is being entered, for the
+  /// eviction of least recently used code.
+  void noteUse(CodeBlock *codeBlock) {
+    codeBlock->setJITLastUse(useClock_);
+  }
+
+  /// Print statistics about the compiled code to \p os.
+  void printStats(llvm::raw_ostream &os);
+
   /// \return the executable memory heap.
   ExecHeap &getHeap() {
     return heap_;
   }
 
+  /// \return the mutex guarding the executable heap and the code cache, which
+  ///     are shared by the JS thread and the background compilation thread.
+  std::mutex &getHeapMutex() {
+    return heapMutex_;
+  }
+
+  /// \return the record of the native code of every compiled function.
+  CodeCache &getCodeCache() {
+    return codeCache_;
+  }
+
   /// \return the native disassembler for our target.
   NativeDisassembler &getDisassembler() {
     return *dis_;
@@ -81,11 +204,32 @@ class JITContext {
   /// CodeBlock.
   JITCompiledFunctionPtr compileImpl(Runtime *runtime, CodeBlock *codeBlock);
 
+  /// Add \p codeBlock to the background compilation queue, starting the
+  /// compilation thread if necessary.
+  void enqueue(CodeBlock *codeBlock);
+
+  /// The code to run in the background compilation thread.
+  void runWorker();
+
+  /// Slow path of compileRegex(), which looks up the entry of \p bytecode and
+  /// compiles it if it is hot.
+  RegexJITFunction compileRegexImpl(
+      RegexJITEntry *&entry,
+      llvm::ArrayRef<uint8_t> bytecode);
+
  private:
   /// Whether JIT compilation is enabled.
   bool enabled_{false};
   /// Executable heap where all executable code is allocated.
   ExecHeap heap_;
+  /// Guards heap_ and codeCache_.
+  std::mutex heapMutex_;
+  /// The native code of every compiled function, for eviction.
+  CodeCache codeCache_{};
+  /// Advanced on every compilation. A function whose native code is entered
+  /// records the current value, so the function which has gone unused for the
+  /// most compilations is evicted first.
+  uint32_t useClock_{0};
   /// whether to dump JIT'ed code
   bool dumpJITCode_{false};
   /// whether to fatally crash on JIT compilation errors
@@ -95,8 +239,53 @@ class JITContext {
   std::unique_ptr<NativeDisassembler> dis_ =
       NativeDisassembler::create(NativeDisassembler::x86_64_unknown_linux_gnu);
 
-  /// The JIT compile threshold for function execution count
-  static constexpr uint32_t COMPILE_THRESHOLD = 0;
+  /// The functions compiled in this run and the previous ones.
+  JITProfile profile_{};
+
+  /// A function is compiled once it has been called this many times.
+  uint32_t invocationThreshold_{0};
+  /// A function is compiled once this many loop back-edges have been taken
+  /// while interpreting it.
+  uint32_t loopThreshold_{0};
+
+  /// A regex is compiled once its bytecode has been searched with this many
+  /// times.
+  uint32_t regExpThreshold_{0};
+
+  /// The entry of every regex bytecode searched with, keyed by the bytecode.
+  std::unordered_map<std::string, RegexJITEntry> regexEntries_{};
+
+  /// The entry shared by the bytecode searched with after regexEntries_ is
+  /// full, which is never compiled.
+  RegexJITEntry noRegexEntry_{0, true, nullptr};
+
+  /// The backtracking stack of the native code of regexes, allocated on the
+  /// first search.
+  std::vector<uintptr_t> regexStack_{};
+
+  /// The base of compressed pointers into the heap of the runtime.
+  const PointerBase *pointerBase_{nullptr};
+
+  /// Whether functions are compiled on the background thread. Once it is
+  /// running, the executable heap is only accessed from that thread.
+  bool background_{false};
+
+  /// Guards the fields below, which are shared with the background thread.
+  std::mutex queueMutex_;
+  /// Signalled when a function is queued or the thread must stop.
+  std::condition_variable queueCond_;
+  /// Signalled when the background thread finishes compiling a function.
+  std::condition_variable doneCond_;
+  /// Functions waiting to be compiled, in the order they became hot.
+  std::deque<CodeBlock *> queue_{};
+  /// The function currently being compiled, or null.
+  CodeBlock *compiling_{nullptr};
+  /// Set to tell the background thread to exit.
+  bool stopWorker_{false};
+
+  /// The background compilation thread, started with the first queued
+  /// function.
+  std::thread worker_{};
 };
 
 LLVM_ATTRIBUTE_ALWAYS_INLINE
@@ -104,17 +293,58 @@ inline JITCompiledFunctionPtr JITContext::compile(
     Runtime *runtime,
     CodeBlock *codeBlock) {
   auto ptr = codeBlock->getJITCompiled();
-  if (LLVM_LIKELY(ptr))
+  if (LLVM_LIKELY(ptr)) {
+    noteUse(codeBlock);
     return ptr;
+  }
   if (LLVM_LIKELY(!enabled_))
     return nullptr;
-  if (LLVM_LIKELY(codeBlock->getDontJIT()))
+  if (LLVM_LIKELY(codeBlock->getDontJIT() || codeBlock->getJITQueued()))
     return nullptr;
-  if (LLVM_LIKELY(codeBlock->getExecutionCount() < COMPILE_THRESHOLD))
+  if (LLVM_LIKELY(
+          codeBlock->getExecutionCount() < invocationThreshold_ &&
+          codeBlock->getBackEdgeCount() < loopThreshold_))
     return nullptr;
   return compileImpl(runtime, codeBlock);
 }
 
+LLVM_ATTRIBUTE_ALWAYS_INLINE
+inline JITCompiledFunctionPtr JITContext::compileOSR(
+    Runtime *runtime,
+    CodeBlock *codeBlock,
+    uint32_t offset) {
+  if (LLVM_LIKELY(!enabled_))
+    return nullptr;
+  if (LLVM_LIKELY(codeBlock->getBackEdgeCount() < loopThreshold_))
+    return nullptr;
+  if (!codeBlock->getJITCompiled()) {
+    if (codeBlock->getDontJIT() || codeBlock->getJITQueued())
+      return nullptr;
+    if (!compileImpl(runtime, codeBlock))
+      return nullptr;
+  }
+  return codeBlock->getOSREntry(offset);
+}
+
+LLVM_ATTRIBUTE_ALWAYS_INLINE
+inline RegexJITFunction JITContext::compileRegex(
+    RegexJITEntry *&entry,
+    llvm::ArrayRef<uint8_t> bytecode) {
+  if (LLVM_LIKELY(entry && entry->code))
+    return entry->code;
+  if (LLVM_LIKELY(!enabled_))
+    return nullptr;
+  if (entry) {
+    if (LLVM_LIKELY(entry->dontJIT))
+      return nullptr;
+    if (LLVM_LIKELY(entry->searchCount < regExpThreshold_)) {
+      ++entry->searchCount;
+      return nullptr;
+    }
+  }
+  return compileRegexImpl(entry, bytecode);
+}
+
 } // namespace x86_64
 } // namespace vm
 } // namespace hermes
@@ -74,11 +74,25 @@ class ArrayImpl : public JSObject {
     assert(
         index >= self->beginIndex_ && index < self->endIndex_ &&
         "array index out of range");
-    self->indexedStorage_.getNonNull(runtime)
-        ->at(index - self->beginIndex_)
-        .set(value, &runtime->getHeap());
+    auto &elem = self->indexedStorage_.getNonNull(runtime)->at(
+        index - self->beginIndex_);
+    self->noteStore(elem, value);
+    elem.set(value, &runtime->getHeap());
   }
 
+  /// Copy the \p count elements of \p src starting at \p srcIndex over the
+  /// existing elements of \p self starting at \p index, a segment at a time
+  /// with a range write barrier. The source elements must all exist in its
+  /// storage and be present, and \p self must satisfy the requirements of
+  /// unsafeSetExistingElementAt().
+  static void unsafeCopyExistingElements(
+      ArrayImpl *self,
+      Runtime *runtime,
+      size_type index,
+      ArrayImpl *src,
+      size_type srcIndex,
+      size_type count);
+
   /// Set the element at index \p index to empty. This does not affect the
   /// storage size or array length.
   /// \return true if the operation succeeded (which is always in this class).
@@ -99,6 +113,19 @@ class ArrayImpl : public JSObject {
     return endIndex_;
   }
 
+  /// \return whether every element in the storage, from getBeginIndex() to
+  ///   getEndIndex(), is present.
+  bool hasNoHoles() const {
+    return numHoles_ == 0;
+  }
+
+  /// \return whether every element present in the storage is a number. Once
+  ///   another value has been stored, this stays false until the storage is
+  ///   emptied.
+  bool hasOnlyNumbers() const {
+    return onlyNumbers_;
+  }
+
   /// Return the value at index \p index, or \c empty if the index is not
   /// contained in the storage.
   const HermesValue at(Runtime *runtime, size_type index) const {
@@ -222,6 +249,25 @@ class ArrayImpl : public JSObject {
   /// The indexed property storage. It can be nullptr, if both its capacity and
   /// size are 0.
   GCPointer<StorageType> indexedStorage_;
+  /// The number of empty values in the storage.
+  uint32_t numHoles_{0};
+  /// Whether every non-empty value in the storage is a number.
+  bool onlyNumbers_{true};
+
+  /// Update numHoles_ and onlyNumbers_ for storing \p value over \p old.
+  void noteStore(HermesValue old, HermesValue value) {
+    if (old.isEmpty())
+      --numHoles_;
+    if (value.isEmpty())
+      ++numHoles_;
+    else if (!value.isNumber())
+      onlyNumbers_ = false;
+  }
+
+  /// Update numHoles_ and onlyNumbers_ before the end of the storage is moved
+  /// to \p newEndIndex, while the storage still has its old size. Elements
+  /// added by growing the storage are empty.
+  void noteNewEndIndex(Runtime *runtime, uint32_t newEndIndex);
 };
 
 class Arguments final : public ArrayImpl {
@@ -279,6 +325,15 @@ class JSArray final : public ArrayImpl {
     return self->shadowLength_;
   }
 
+  /// \return whether every index below the length of \p self has an element
+  ///   in the indexed storage, so that reading one doesn't need to check for a
+  ///   hole or look at the prototype chain.
+  static bool isPacked(const JSArray *self) {
+    return self->getBeginIndex() == 0 &&
+        self->getEndIndex() == self->shadowLength_ && self->hasNoHoles() &&
+        self->hasFastIndexProperties();
+  }
+
   /// Create an instance of Array, with [[Prototype]] initialized with
   /// \p prototypeHandle, with capacity for \p capacity elements and actual size
   /// \p length.
@@ -314,6 +369,11 @@ class JSArray final : public ArrayImpl {
   static CallResult<PseudoHandle<JSArray>>
   create(Runtime *runtime, size_type capacity, size_type length);
 
+  /// Same as create(Runtime *, size_type, size_type), but the array and its
+  /// element storage are expected to be long-lived.
+  static CallResult<PseudoHandle<JSArray>>
+  createLongLived(Runtime *runtime, size_type capacity, size_type length);
+
   /// A convenience method for setting the \c .length property of the array.
   /// It performs the necessary checks and updates the property. It could fail
   /// if the property is not writable or if there are read-only index-like
@@ -342,6 +402,16 @@ class JSArray final : public ArrayImpl {
   /// time would be too slow.
   uint32_t shadowLength_{0};
 
+  /// Shared implementation of create() and createLongLived(), allocating the
+  /// array and its storage in long-lived space if \p longLived.
+  static CallResult<HermesValue> createImpl(
+      Runtime *runtime,
+      Handle<JSObject> prototypeHandle,
+      Handle<HiddenClass> classHandle,
+      size_type capacity,
+      size_type length,
+      bool longLived);
+
   template <typename NeedsBarrier>
   JSArray(
       Runtime *runtime,
@@ -411,6 +481,13 @@ class JSArrayIterator : public JSObject {
       Handle<JSArrayIterator> self,
       Runtime *runtime);
 
+  /// Iterate to the next element without creating an iterator result object.
+  /// \return the value of the element, or the empty value if the iteration
+  ///   is done.
+  static CallResult<HermesValue> nextValue(
+      Handle<JSArrayIterator> self,
+      Runtime *runtime);
+
  private:
   JSArrayIterator(
       Runtime *runtime,
@@ -25,6 +25,11 @@ class JSArrayBuffer final : public JSObject {
   // amount is larger than the native platform's `size_t`
   using size_type = std::size_t;
 
+  /// Called with the context and the data of an external data block once the
+  /// ArrayBuffer no longer references it. This may run from a GC finalizer,
+  /// so it must not call back into the runtime.
+  using ExternalReleaseCallback = void (*)(void *context, char *data);
+
   static ObjectVTable vt;
 
   static bool classof(const GCCell *cell) {
@@ -60,6 +65,34 @@ class JSArrayBuffer final : public JSObject {
   ExecutionStatus
   createDataBlock(Runtime *runtime, size_type size, bool zero = true);
 
+  /// Makes this JSArrayBuffer hold the host-owned block \p data of \p size
+  /// bytes without copying it, replacing the currently used data block. The
+  /// block is charged to the GC as external memory, and \p release is invoked
+  /// with \p context when the buffer is detached or collected; if \p size is
+  /// zero it is invoked right away.
+  /// \return ExecutionStatus::RETURNED iff the block could be accounted for.
+  ExecutionStatus setExternalDataBlock(
+      Runtime *runtime,
+      char *data,
+      size_type size,
+      void *context,
+      ExternalReleaseCallback release);
+
+  /// Makes this JSArrayBuffer own the malloc'ed block \p data of \p size
+  /// bytes, replacing the currently used data block. The block is freed when
+  /// the buffer is detached or collected, and it is freed right away if this
+  /// fails.
+  /// \return ExecutionStatus::RETURNED iff the block could be accounted for.
+  ExecutionStatus adoptDataBlock(Runtime *runtime, char *data, size_type size);
+
+  /// Detaches this buffer and hands its data block over to the caller, who
+  /// then has to free() it. A block owned by the host is copied first, since
+  /// it can only be handed back through its release callback.
+  /// \return the block and its size; the block is null if the buffer was
+  ///   empty.
+  /// \pre attached() must be true
+  CallResult<std::pair<char *, size_type>> releaseDataBlock(Runtime *runtime);
+
   /// Retrieves a pointer to the held buffer.
   /// \return A pointer to the buffer owned by this object. This can be null
   ///   if the ArrayBuffer is empty.
@@ -98,6 +131,10 @@ class JSArrayBuffer final : public JSObject {
   char *data_;
   size_type size_;
   bool attached_;
+  /// If set, data_ is owned by the host and is handed back through this
+  /// callback instead of being freed.
+  ExternalReleaseCallback externalRelease_;
+  void *externalContext_;
 
   JSArrayBuffer(Runtime *runtime, JSObject *parent, HiddenClass *clazz);
 
@@ -132,9 +132,11 @@ class JSError final : public JSObject {
   /// A list of Domains which are referenced by the stacktrace_.
   GCPointer<ArrayStorage> domains_;
 
-  /// If not null, an array of function names as the 'name' property of the
-  /// Callables. This is parallel to the stack trace array.
-  GCPointer<PropStorage> funcNames_;
+  /// If not null, an array of the Callables on the stack, or of the names of
+  /// the CodeBlocks without one. This is parallel to the stack trace array.
+  /// The 'name' property of the Callables is only read when the stack trace
+  /// string is constructed.
+  GCPointer<PropStorage> callees_;
 
   /// If true, JS catch and finally blocks will be run after this error is
   /// thrown. Else, there will be no more JS executed after this error is
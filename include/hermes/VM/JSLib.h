@@ -11,6 +11,8 @@
 #ifndef HERMES_VM_JSLIB_H
 #define HERMES_VM_JSLIB_H
 
+#include "hermes/BCGen/HBC/BytecodeDataProvider.h"
+#include "hermes/Support/OptValue.h"
 #include "hermes/Support/ScopeChain.h"
 #include "hermes/VM/CallResult.h"
 #include "hermes/VM/Domain.h"
@@ -23,6 +25,9 @@ namespace hermes {
 namespace vm {
 
 // External forward declarations.
+class Callable;
+class JSArray;
+class NativeFunction;
 class Runtime;
 struct RuntimeCommonStorage;
 
@@ -30,6 +35,17 @@ void initGlobalObject(Runtime *runtime);
 
 std::shared_ptr<RuntimeCommonStorage> createRuntimeCommonStorage();
 
+/// Compile \p utf8code for evaluation in a scope whose identifiers are
+/// resolved with \p scopeChain. If \p singleFunction is set, require that the
+/// code be only a single function.  The result can be run any number of times
+/// with Runtime::runBytecode().
+/// \return the compiled bytecode, or raise a SyntaxError.
+CallResult<std::shared_ptr<hbc::BCProvider>> compileEvalSource(
+    Runtime *runtime,
+    llvm::StringRef utf8code,
+    const ScopeChain &scopeChain,
+    bool singleFunction);
+
 /// eval() entry point. Evaluate the given source \p utf8code within the given
 /// \p environment, using the given \p scopeChain to resolve identifiers.
 /// \p thisArg is the initial "this" value of the function being evaluated.
@@ -53,6 +69,44 @@ CallResult<HermesValue> runRequireCall(
     Handle<Domain> domain,
     uint32_t cjsModuleOffset);
 
+/// Run the jobs of the promise job queue until it is empty, or until one of
+/// them throws. See Runtime::drainJobs().
+ExecutionStatus drainPromiseJobs(Runtime *runtime);
+
+/// Evaluate the call of \p native with \p args inline, without entering it,
+/// if it is one of the get and set methods of DataView.prototype, this is an
+/// attached DataView, the byte offset is an integer within its bounds and
+/// the stored value is a number, so that no conversion can run user code or
+/// throw.
+/// \return the result, or llvm::None if the native function must be called.
+OptValue<HermesValue> tryDataViewAccessInline(
+    Runtime *runtime,
+    NativeFunction *native,
+    NativeArgs args);
+
+/// Evaluate the call of \p native with \p args inline, without entering it,
+/// if it is String.prototype.charCodeAt, this is a string primitive and the
+/// position is a number or missing, so that no conversion can run user code.
+/// \return the result, or llvm::None if the native function must be called.
+OptValue<HermesValue> tryStringCharCodeAtInline(
+    NativeFunction *native,
+    NativeArgs args);
+
+/// Create the string returned by String.fromCharCode() for the elements of
+/// the packed array \p arr if \p func is String.fromCharCode and they are all
+/// numbers, reading them directly instead of copying them into a call frame,
+/// whose size would limit the length of the array.
+/// \return the string, or an empty value if \p func must be called.
+CallResult<HermesValue> tryStringFromCharCodeApply(
+    Runtime *runtime,
+    Handle<Callable> func,
+    Handle<JSArray> arr);
+
+/// Convert \p args to strings and write them to \p os like print(), separated
+/// by spaces and followed by a new line, without flushing \p os.
+ExecutionStatus
+printArgs(Runtime *runtime, NativeArgs args, llvm::raw_ostream &os);
+
 /// The [[ThrowTypeError]] internal function.
 CallResult<HermesValue>
 throwTypeError(void *, Runtime *runtime, NativeArgs args);
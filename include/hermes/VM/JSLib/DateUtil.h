@@ -99,7 +99,7 @@ double weekDay(double t);
 // ES5.1 15.9.1.7
 
 /// Local time zone offset, explicitly not including DST offset.
-/// TODO: Cache this value to avoid recomputing every time.
+/// This calls into libc every time, LocalTimeCache caches it.
 double localTZA();
 
 //===----------------------------------------------------------------------===//
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_VM_JSLIB_LOCALTIMECACHE_H
+#define HERMES_VM_JSLIB_LOCALTIMECACHE_H
+
+#include <cstdint>
+#include <string>
+
+namespace hermes {
+namespace vm {
+
+/// A cache of the local time zone adjustment, and of the daylight saving time
+/// adjustments of recently used time ranges, so that converting between UTC
+/// and local time doesn't call into libc every time. Each range is an
+/// interval of time during which the adjustment doesn't change.
+///
+/// The cache is cleared when the TZ environment variable changes, and can be
+/// cleared explicitly when the time zone of the system changes.
+class LocalTimeCache {
+ public:
+  /// Number of cached time ranges.
+  static constexpr unsigned kNumRanges = 8;
+
+  /// The distance in seconds at which the adjustment is probed around a new
+  /// time, assuming that there are never two transitions within that
+  /// distance.
+  static constexpr int64_t kProbeSecs = 19 * 24 * 60 * 60;
+
+  LocalTimeCache() = default;
+  LocalTimeCache(const LocalTimeCache &) = delete;
+  void operator=(const LocalTimeCache &) = delete;
+
+  /// \return the same value as the localTZA() function.
+  double localTZA() {
+    checkTimeZone();
+    return cachedLocalTZA();
+  }
+
+  /// \return the same value as the daylightSavingTA() function, for the
+  ///   timestamp \p t in milliseconds.
+  double daylightSavingTA(double t) {
+    checkTimeZone();
+    return cachedDaylightSavingTA(t);
+  }
+
+  /// Conversion from UTC to local time.
+  double localTime(double t) {
+    checkTimeZone();
+    return t + cachedLocalTZA() + cachedDaylightSavingTA(t);
+  }
+
+  /// Conversion from local time to UTC.
+  double utcTime(double t) {
+    checkTimeZone();
+    double ltza = cachedLocalTZA();
+    return t - ltza - cachedDaylightSavingTA(t - ltza);
+  }
+
+  /// Forget all the cached values.
+  void clear();
+
+ private:
+  /// A range of seconds since the epoch, inclusive, with the same daylight
+  /// saving time adjustment.
+  struct Range {
+    int64_t start;
+    int64_t end;
+    double dst;
+    /// The value of useCounter_ when the range was last used, zero if the
+    /// range is empty.
+    uint64_t lastUse;
+  };
+
+  /// Clear the cache if the TZ environment variable changed since the last
+  /// call.
+  void checkTimeZone();
+
+  /// localTZA() and daylightSavingTA(), without checking the time zone.
+  double cachedLocalTZA() {
+    if (!tzaValid_) {
+      tza_ = computeLocalTZA();
+      tzaValid_ = true;
+    }
+    return tza_;
+  }
+  double cachedDaylightSavingTA(double t);
+
+  /// \return the uncached localTZA().
+  static double computeLocalTZA();
+
+  /// \return the end of the range starting at \p secs with the adjustment
+  ///   \p dst, searched up to \p delta seconds away.
+  static int64_t extendRange(int64_t secs, int64_t delta, double dst);
+
+  Range ranges_[kNumRanges]{};
+
+  /// Incremented every time a range is used.
+  uint64_t useCounter_{0};
+
+  /// The local time zone adjustment, if tzaValid_ is set.
+  double tza_{0};
+  bool tzaValid_{false};
+
+  /// The value of the TZ environment variable when the cache was filled.
+  std::string tz_{};
+  bool hasTZ_{false};
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_JSLIB_LOCALTIMECACHE_H
@@ -7,7 +7,8 @@
 #ifndef HERMES_VM_JSLIB_RUNTIMECOMMONSTORAGE_H
 #define HERMES_VM_JSLIB_RUNTIMECOMMONSTORAGE_H
 
-#include <random>
+#include "hermes/Support/XorShift128Plus.h"
+
 #if __APPLE__
 #include <CoreFoundation/CoreFoundation.h>
 #endif
@@ -40,8 +41,18 @@ struct RuntimeCommonStorage {
   MockedEnvironment tracedEnv;
 #endif
 
+  /// \return the PRNG used by Math.random(), seeding it on first use from
+  /// the mocked environment when replaying, or else from std::random_device.
+  XorShift128Plus &getRandomEngine() {
+    if (!randomEngineSeeded_) {
+      seedRandomEngine();
+    }
+    return randomEngine_;
+  }
+  void seedRandomEngine();
+
   /// PRNG used by Math.random()
-  std::minstd_rand randomEngine_;
+  XorShift128Plus randomEngine_;
   bool randomEngineSeeded_ = false;
 
 #if __APPLE__
@@ -54,19 +54,19 @@ class JSMapImpl final : public JSObject {
     return static_cast<bool>(storage_);
   }
 
-  /// Advance iterator and return the next.
-  HashMapEntry *iteratorNext(Runtime *runtime, HashMapEntry *entry) {
-    return storage_.get(runtime)->iteratorNext(runtime, entry);
+  /// \return the entries storage an iteration starts in.
+  ArrayStorage *iteratorBegin(Runtime *runtime) {
+    return storage_.get(runtime)->iteratorBegin(runtime);
   }
 
   /// Add a value.
-  static void addValue(
+  static ExecutionStatus addValue(
       Handle<JSMapImpl> self,
       Runtime *runtime,
       Handle<> key,
       Handle<> value) {
     self->assertInitialized();
-    OrderedHashMap::insert(
+    return OrderedHashMap::insert(
         runtime->makeHandle<OrderedHashMap>(self->storage_),
         runtime,
         key,
@@ -102,34 +102,34 @@ class JSMapImpl final : public JSObject {
   }
 
   /// Clear all elements from the storage.
-  static void clear(Handle<JSMapImpl> self, Runtime *runtime) {
+  static ExecutionStatus clear(Handle<JSMapImpl> self, Runtime *runtime) {
     self->assertInitialized();
-    self->storage_.get(runtime)->clear(runtime);
+    return OrderedHashMap::clear(
+        runtime->makeHandle<OrderedHashMap>(self->storage_), runtime);
   }
 
-  /// Call \p callbackfn for each entry, with \p thisArg as this.
+  /// Call \p callbackfn for each entry, with \p thisArg as this. The entries
+  /// are walked directly, and the same call frame is reused for every call.
   static ExecutionStatus forEach(
       Handle<JSMapImpl> self,
       Runtime *runtime,
       Handle<Callable> callbackfn,
       Handle<> thisArg) {
     self->assertInitialized();
-    MutableHandle<HashMapEntry> entry{runtime};
-    for (entry = self->storage_.get(runtime)->iteratorNext(runtime); entry;
-         entry =
-             self->storage_.get(runtime)->iteratorNext(runtime, entry.get())) {
-      HermesValue key = entry->key;
-      HermesValue value = entry->value;
-      assert(!key.isEmpty() && "Invalid key encountered");
+    MutableHandle<ArrayStorage> entries{runtime, self->iteratorBegin(runtime)};
+    RepeatedCall callback{runtime, callbackfn, thisArg, 3};
+    for (uint32_t index = 0;; ++index) {
+      ArrayStorage *entriesPtr = entries.get();
+      if (!OrderedHashMap::iteratorNext(runtime, entriesPtr, index)) {
+        break;
+      }
+      entries = entriesPtr;
+      HermesValue key = OrderedHashMap::iteratorKey(entriesPtr, index);
+      HermesValue value = OrderedHashMap::iteratorValue(entriesPtr, index);
       assert(!value.isEmpty() && "Invalid value encountered");
       if (LLVM_UNLIKELY(
-              Callable::executeCall3(
-                  callbackfn,
-                  runtime,
-                  thisArg,
-                  value,
-                  key,
-                  self.getHermesValue()) == ExecutionStatus::EXCEPTION)) {
+              callback.call(value, key, self.getHermesValue()) ==
+              ExecutionStatus::EXCEPTION)) {
         return ExecutionStatus::EXCEPTION;
       }
     }
@@ -187,6 +187,8 @@ class JSMapIteratorImpl final : public JSObject {
       Handle<JSMapImpl<JSMapTypeTraits<C>::ContainerKind>> data,
       IterationKind kind) {
     data_.set(runtime, data.get(), &runtime->getHeap());
+    itrEntries_.set(runtime, data->iteratorBegin(runtime), &runtime->getHeap());
+    itrIndex_ = 0;
     iterationKind_ = kind;
 
     assert(data_ && "Invalid storage data");
@@ -203,23 +205,43 @@ class JSMapIteratorImpl final : public JSObject {
   static CallResult<HermesValue> nextElement(
       Handle<JSMapIteratorImpl> self,
       Runtime *runtime) {
+    auto valueRes = nextValue(self, runtime);
+    if (LLVM_UNLIKELY(valueRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    if (valueRes->isEmpty()) {
+      return createIterResultObject(
+                 runtime, runtime->getUndefinedValue(), true)
+          .getHermesValue();
+    }
+    return createIterResultObject(
+               runtime, runtime->makeHandle(*valueRes), false)
+        .getHermesValue();
+  }
+
+  /// Iterate to the next element without creating an iterator result object.
+  /// \return the element, or the empty value if the iteration is done.
+  static CallResult<HermesValue> nextValue(
+      Handle<JSMapIteratorImpl> self,
+      Runtime *runtime) {
     MutableHandle<> value{runtime};
     if (!self->iterationFinished_) {
       // Iteration has not yet reached the end previously.
       assert(self->data_ && "Storage uninitialized");
       // Advance the iterator.
-      self->itr_.set(
-          runtime,
-          self->data_.get(runtime)->iteratorNext(
-              runtime, self->itr_.get(runtime)),
-          &runtime->getHeap());
-      if (self->itr_) {
+      ArrayStorage *entries = self->itrEntries_.get(runtime);
+      uint32_t index = self->itrIndex_;
+      bool found = OrderedHashMap::iteratorNext(runtime, entries, index);
+      self->itrEntries_.set(runtime, entries, &runtime->getHeap());
+      // The next call starts after the entry found.
+      self->itrIndex_ = index + 1;
+      if (found) {
         switch (self->iterationKind_) {
           case IterationKind::Key:
-            value = self->itr_.get(runtime)->key;
+            value = OrderedHashMap::iteratorKey(entries, index);
             break;
           case IterationKind::Value:
-            value = self->itr_.get(runtime)->value;
+            value = OrderedHashMap::iteratorValue(entries, index);
             break;
           case IterationKind::Entry: {
             // If we are iterating both key and value, we need to create an
@@ -229,9 +251,10 @@ class JSMapIteratorImpl final : public JSObject {
               return ExecutionStatus::EXCEPTION;
             }
             auto arrHandle = toHandle(runtime, std::move(*arrRes));
-            value = self->itr_.get(runtime)->key;
+            entries = self->itrEntries_.get(runtime);
+            value = OrderedHashMap::iteratorKey(entries, index);
             JSArray::setElementAt(arrHandle, runtime, 0, value);
-            value = self->itr_.get(runtime)->value;
+            value = OrderedHashMap::iteratorValue(entries, index);
             JSArray::setElementAt(arrHandle, runtime, 1, value);
             value = arrHandle.getHermesValue();
             break;
@@ -242,10 +265,13 @@ class JSMapIteratorImpl final : public JSObject {
         // reached the end.
         self->iterationFinished_ = true;
         self->data_ = nullptr;
+        self->itrEntries_ = nullptr;
       }
     }
-    return createIterResultObject(runtime, value, self->iterationFinished_)
-        .getHermesValue();
+    if (self->iterationFinished_) {
+      return HermesValue::encodeEmptyValue();
+    }
+    return value.getHermesValue();
   }
 
   /// Build the metadata for this map implementation, and store it into \p mb.
@@ -262,8 +288,12 @@ class JSMapIteratorImpl final : public JSObject {
   /// initialized or the iteration has ended.
   GCPointer<JSMapImpl<JSMapTypeTraits<C>::ContainerKind>> data_{nullptr};
 
-  /// Iteration pointer to the element storage in the Map.
-  GCPointer<HashMapEntry> itr_{nullptr};
+  /// The entries storage of the Map the iteration is in. It is replaced by
+  /// the one in use when the iterator is advanced.
+  GCPointer<ArrayStorage> itrEntries_{nullptr};
+
+  /// The index in itrEntries_ of the next entry to look at.
+  uint32_t itrIndex_{0};
 
   IterationKind iterationKind_;
 
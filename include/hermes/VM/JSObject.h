@@ -153,6 +153,7 @@ static_assert(
 ///
 /// \name InternalForce
 /// Used to insert an internal property, forcing the insertion no matter what.
+/// Also allows deleting a property which isn't configurable.
 /// @}
 #define HERMES_VM__LIST_PropOpFlags(FLAG) \
   FLAG(ThrowOnError)                      \
@@ -278,6 +279,8 @@ struct ObjectVTable {
 /// available.
 class JSObject : public GCCell {
   friend void ObjectBuildMeta(const GCCell *cell, Metadata::Builder &mb);
+  friend struct RuntimeOffsets;
+  friend class RuntimeResetPoint;
 
  protected:
   /// A light-weight constructor which performs no GC allocations. Its purpose
@@ -350,6 +353,18 @@ class JSObject : public GCCell {
       Runtime *runtime,
       Handle<HiddenClass> clazz);
 
+  /// Same as create(Runtime *, unsigned), but the object and its property
+  /// storage are expected to be long-lived.
+  static PseudoHandle<JSObject> createLongLived(
+      Runtime *runtime,
+      unsigned propertyCount);
+
+  /// Same as create(Runtime *, Handle<HiddenClass>), but the object and its
+  /// property storage are expected to be long-lived.
+  static PseudoHandle<JSObject> createLongLived(
+      Runtime *runtime,
+      Handle<HiddenClass> clazz);
+
   /// Attempts to allocate a JSObject and returns whether it succeeded or not.
   /// NOTE: This function always returns \c ExecutionStatus::RETURNED, it is
   /// only used in interfaces where other creators may throw a JS exception.
@@ -384,6 +399,12 @@ class JSObject : public GCCell {
     return !flags_.noExtend;
   }
 
+  /// \return true if there are no index-like named properties, so that the
+  /// indexed storage holds all of the object's own indexed properties.
+  bool hasFastIndexProperties() const {
+    return flags_.fastIndexProperties;
+  }
+
   /// true if this a lazy object that must be initialized prior to use.
   bool isLazy() const {
     return flags_.lazyObject;
@@ -404,6 +425,25 @@ class JSObject : public GCCell {
     return clazz_.getNonNull(runtime);
   }
 
+  /// \return true if \p self or an object in its prototype chain may have a
+  ///   property keyed by the well-known symbol \p sym, false if looking it up
+  ///   is certain to find nothing. This only checks a flag in the class of
+  ///   each object, which is much cheaper than the lookup for the ordinary
+  ///   objects which have none. Host objects and lazy objects may have any
+  ///   property.
+  static bool mayHaveWellKnownSymbol(
+      JSObject *self,
+      Runtime *runtime,
+      Predefined::Sym sym) {
+    for (JSObject *obj = self; obj; obj = obj->getParent(runtime)) {
+      if (obj->flags_.hostObject || obj->flags_.lazyObject ||
+          obj->getClass(runtime)->mayHaveWellKnownSymbol(sym)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   /// \return the object ID. Assign one if not yet exist. This ID can be used
   /// in Set or Map where hashing is required. We don't assign object an ID
   /// until we actually need it. An exception is lazily created objects where
@@ -486,6 +526,15 @@ class JSObject : public GCCell {
       Runtime *runtime,
       bool onlyEnumerable);
 
+  /// Give \p selfHandle, which must have no properties, the class of
+  /// \p source and copies of the values of its named properties. The class of
+  /// \p source must not be a dictionary. The caller must ensure that this is
+  /// the same as defining every property of \p source on \p selfHandle.
+  static void adoptClassAndSlots(
+      Handle<JSObject> selfHandle,
+      Runtime *runtime,
+      Handle<JSObject> source);
+
   /// Return a list of property symbols keys belonging to this object.
   /// The order of properties follows ES2015 - insertion order.
   /// \returns a JSArray containing the symbols.
@@ -686,13 +735,26 @@ class JSObject : public GCCell {
   /// getNamed is an optimized path for getting a property with a SymbolID when
   /// it is statically known that the SymbolID is not index-like.
   /// If \p cacheEntry is not null, and the result is suitable for use in a
-  /// property cache, populate the cache.
+  /// property cache, populate the cache. Likewise, if \p protoCacheEntry is
+  /// not null and the property is found on the prototype chain, or is an
+  /// accessor, populate it.
   static CallResult<HermesValue> getNamed_RJS(
       Handle<JSObject> selfHandle,
       Runtime *runtime,
       SymbolID name,
       PropOpFlags opFlags = PropOpFlags(),
-      PropertyCacheEntry *cacheEntry = nullptr);
+      PolyPropertyCacheEntry *cacheEntry = nullptr,
+      ProtoPropertyCacheEntry *protoCacheEntry = nullptr);
+
+  /// Check whether the prototype-chain cache entry \p entry applies to
+  /// \p self. The caller must already have checked that the class of \p self
+  /// is the entry's receiver class.
+  /// \return the object holding the cached property, or nullptr if the entry
+  ///   does not apply.
+  static inline JSObject *getProtoCacheHolder(
+      JSObject *self,
+      Runtime *runtime,
+      const ProtoPropertyCacheEntry &entry);
 
   // getNamedOrIndexed accesses a property with a SymbolIDs which may be
   // index-like.
@@ -921,6 +983,14 @@ class JSObject : public GCCell {
       PropertyFlags flagsToSet,
       OptValue<llvm::ArrayRef<SymbolID>> props);
 
+  /// Switch the class of \p selfHandle to a cacheable dictionary, so that the
+  /// property caches keep working no matter how many properties it gets.
+  /// Meant for objects with many long-lived properties that are accessed by
+  /// name, like the global object.
+  static void makeCacheableDictionary(
+      Handle<JSObject> selfHandle,
+      Runtime *runtime);
+
   /// First call \p indexedCB, passing each indexed property's \c uint32_t
   /// index and \c ComputedPropertyDescriptor. Then call \p namedCB passing each
   /// named property's \c SymbolID and \c  NamedPropertyDescriptor as
@@ -1156,6 +1226,17 @@ CallResult<Handle<BigStorage>> getForInPropertyNames(
     uint32_t &beginIndex,
     uint32_t &endIndex);
 
+/// \return the end of the names of \p obj itself in \p arr, an array returned
+/// by getForInPropertyNames() for \p obj, if they are known to still be
+/// properties of \p obj without looking them up, and 0 otherwise.  This is
+/// the case while \p arr is the for-in cache of the class of \p obj, since
+/// adding, deleting or redefining a property changes the class of an object
+/// which isn't a dictionary.
+inline uint32_t getForInCachedOwnEnd(
+    Runtime *runtime,
+    JSObject *obj,
+    BigStorage *arr);
+
 /// This object is the value of a property which has a getter and/or setter.
 class PropertyAccessor final : public GCCell {
  protected:
@@ -1323,6 +1404,33 @@ inline OptValue<bool> JSObject::tryGetOwnNamedDescriptorFast(
       self->clazz_.getNonNull(runtime), runtime, name, desc);
 }
 
+inline JSObject *JSObject::getProtoCacheHolder(
+    JSObject *self,
+    Runtime *runtime,
+    const ProtoPropertyCacheEntry &entry) {
+  assert(
+      self->getClass(runtime) == entry.receiverClass &&
+      "receiver class must match the entry");
+  // Lazy objects and host objects don't describe their properties through
+  // their class, so the class check alone doesn't prove the property absent.
+  if (LLVM_UNLIKELY(self->isLazy() || self->isHostObject()))
+    return nullptr;
+  if (entry.ownProperty)
+    return self;
+  JSObject *parent = self->getParent(runtime);
+  if (LLVM_UNLIKELY(!parent))
+    return nullptr;
+  if (entry.intermediateClass) {
+    if (parent->getClass(runtime) != entry.intermediateClass ||
+        LLVM_UNLIKELY(parent->isLazy() || parent->isHostObject()))
+      return nullptr;
+    parent = parent->getParent(runtime);
+    if (LLVM_UNLIKELY(!parent))
+      return nullptr;
+  }
+  return parent->getClass(runtime) == entry.holderClass ? parent : nullptr;
+}
+
 inline JSObject *JSObject::getNamedDescriptor(
     Handle<JSObject> selfHandle,
     Runtime *runtime,
@@ -1378,6 +1486,13 @@ inline bool JSObject::shouldCacheForIn(Runtime *runtime) const {
       !flags_.hostObject;
 }
 
+inline uint32_t
+getForInCachedOwnEnd(Runtime *runtime, JSObject *obj, BigStorage *arr) {
+  return obj->getClass(runtime)->getForInCache(runtime) == arr
+      ? arr->at(0).getNumber()
+      : 0;
+}
+
 } // namespace vm
 } // namespace hermes
 
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_VM_JSPROMISE_H
+#define HERMES_VM_JSPROMISE_H
+
+#include "hermes/VM/JSObject.h"
+
+namespace hermes {
+namespace vm {
+
+/// Promise object. ES6.0 25.4.6.
+/// Its internal slots are stored in internal properties:
+/// - [[PromiseState]], as a number (see State).
+/// - [[PromiseResult]].
+/// - The [[PromiseFulfillReactions]] and [[PromiseRejectReactions]], together
+///   in an ArrayStorage while the promise is pending, undefined otherwise. The
+///   layout of the reactions is private to JSLib/Promise.cpp.
+class JSPromise final : public JSObject {
+  using Super = JSObject;
+
+ public:
+  static ObjectVTable vt;
+
+  /// Number of property slots the class reserves for itself. Child classes
+  /// should override this value by adding to it and defining a constant with
+  /// the same name.
+  static const PropStorage::size_type NEEDED_PROPERTY_SLOTS =
+      Super::NEEDED_PROPERTY_SLOTS + 3;
+
+  /// The [[PromiseState]] internal slot.
+  enum class State { Pending, Fulfilled, Rejected };
+
+  static bool classof(const GCCell *cell) {
+    return cell->getKind() == CellKind::PromiseKind;
+  }
+
+  /// Create a pending promise.
+  static CallResult<HermesValue> create(
+      Runtime *runtime,
+      Handle<JSObject> prototype);
+
+  static State getState(JSObject *self, Runtime *runtime) {
+    return static_cast<State>(
+        JSObject::getInternalProperty(self, runtime, stateIndex).getNumber());
+  }
+
+  static HermesValue getResult(JSObject *self, Runtime *runtime) {
+    return JSObject::getInternalProperty(self, runtime, resultIndex);
+  }
+
+  /// \return the reactions of a pending promise.
+  static HermesValue getReactions(JSObject *self, Runtime *runtime) {
+    return JSObject::getInternalProperty(self, runtime, reactionsIndex);
+  }
+
+  static void
+  setReactions(JSObject *self, Runtime *runtime, HermesValue reactions) {
+    JSObject::setInternalProperty(self, runtime, reactionsIndex, reactions);
+  }
+
+  /// Settle the promise with \p result, and drop its reactions.
+  static void
+  settle(JSObject *self, Runtime *runtime, State state, HermesValue result) {
+    assert(state != State::Pending && "promises can't become pending again");
+    JSObject::setInternalProperty(
+        self,
+        runtime,
+        stateIndex,
+        HermesValue::encodeNumberValue(static_cast<double>(state)));
+    JSObject::setInternalProperty(self, runtime, resultIndex, result);
+    setReactions(self, runtime, HermesValue::encodeUndefinedValue());
+  }
+
+ protected:
+  JSPromise(Runtime *runtime, JSObject *parent, HiddenClass *clazz)
+      : JSObject(runtime, &vt.base, parent, clazz) {}
+
+ private:
+  static const SlotIndex stateIndex = 0;
+  static const SlotIndex resultIndex = 1;
+  static const SlotIndex reactionsIndex = 2;
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif
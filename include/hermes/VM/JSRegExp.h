@@ -7,8 +7,9 @@
 #ifndef HERMES_VM_JSREGEXP_H
 #define HERMES_VM_JSREGEXP_H
 
-#include "hermes/VM/CopyableVector.h"
+#include "hermes/VM/JIT/RegexJIT.h"
 #include "hermes/VM/JSObject.h"
+#include "hermes/VM/RegExpCache.h"
 #include "hermes/VM/RegExpMatch.h"
 #include "hermes/VM/SmallXString.h"
 
@@ -63,7 +64,8 @@ class JSRegExp final : public JSObject {
   /// the standard properties of the RegExp according to the flags. Note that
   /// RegExps are not mutable (with the exception of the lastIndex property).
   /// If \p bytecode is given, initialize the regex with that bytecode.
-  /// Otherwise compile the pattern and flags into a new regexp.
+  /// Otherwise compile the pattern and flags into a new regexp, or reuse the
+  /// bytecode in the runtime's RegExpCache if they were compiled recently.
   static ExecutionStatus initialize(
       Handle<JSRegExp> selfHandle,
       Runtime *runtime,
@@ -109,7 +111,11 @@ class JSRegExp final : public JSObject {
   JSRegExp(Runtime *runtime, JSObject *parent, HiddenClass *clazz)
       : JSObject(runtime, &vt.base, parent, clazz) {}
 
-  CopyableVector<uint8_t> bytecode_;
+  /// The compiled regex, which may be shared with other RegExps.
+  RegExpBytecode bytecode_;
+
+  /// What the JIT knows about bytecode_, looked up on the first search.
+  RegexJITEntry *jitEntry_{nullptr};
 
   FlagBits flagBits_ = {};
 
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_VM_JSTEXTENCODING_H
+#define HERMES_VM_JSTEXTENCODING_H
+
+#include "hermes/VM/JSObject.h"
+
+namespace hermes {
+namespace vm {
+
+/// TextEncoder object of the WHATWG Encoding Standard. It always encodes to
+/// UTF-8, so it has no state.
+class JSTextEncoder final : public JSObject {
+ public:
+  static ObjectVTable vt;
+
+  static bool classof(const GCCell *cell) {
+    return cell->getKind() == CellKind::TextEncoderKind;
+  }
+
+  static CallResult<HermesValue> create(
+      Runtime *runtime,
+      Handle<JSObject> prototype);
+
+ protected:
+  JSTextEncoder(Runtime *runtime, JSObject *parent, HiddenClass *clazz)
+      : JSObject(runtime, &vt.base, parent, clazz) {}
+};
+
+/// TextDecoder object of the WHATWG Encoding Standard, which only supports
+/// UTF-8. Its state is stored in internal properties:
+/// - Its Flags, as a number.
+/// - The bytes of an incomplete sequence left at the end of the last chunk
+///   decoded in streaming mode, as a number (see getPendingBytes()).
+class JSTextDecoder final : public JSObject {
+  using Super = JSObject;
+
+ public:
+  static ObjectVTable vt;
+
+  /// Number of property slots the class reserves for itself. Child classes
+  /// should override this value by adding to it and defining a constant with
+  /// the same name.
+  static const PropStorage::size_type NEEDED_PROPERTY_SLOTS =
+      Super::NEEDED_PROPERTY_SLOTS + 2;
+
+  enum Flags : uint8_t {
+    /// Invalid input throws a TypeError instead of being replaced with
+    /// U+FFFD.
+    Fatal = 1 << 0,
+    /// A leading byte order mark is part of the output.
+    IgnoreBOM = 1 << 1,
+    /// The byte order mark of the current stream has been handled.
+    BOMSeen = 1 << 2,
+  };
+
+  static bool classof(const GCCell *cell) {
+    return cell->getKind() == CellKind::TextDecoderKind;
+  }
+
+  /// Create a decoder without flags.
+  static CallResult<HermesValue> create(
+      Runtime *runtime,
+      Handle<JSObject> prototype);
+
+  static uint8_t getFlags(JSObject *self, Runtime *runtime) {
+    return JSObject::getInternalProperty(self, runtime, flagsIndex)
+        .getNumberAs<uint8_t>();
+  }
+
+  static void setFlags(JSObject *self, Runtime *runtime, uint8_t flags) {
+    JSObject::setInternalProperty(
+        self, runtime, flagsIndex, HermesValue::encodeNumberValue(flags));
+  }
+
+  /// \return the pending bytes, at most 3, with the first one in the lowest
+  ///   byte and their count in bits 24 to 31.
+  static uint32_t getPendingBytes(JSObject *self, Runtime *runtime) {
+    return JSObject::getInternalProperty(self, runtime, pendingIndex)
+        .getNumberAs<uint32_t>();
+  }
+
+  static void
+  setPendingBytes(JSObject *self, Runtime *runtime, uint32_t bytes) {
+    JSObject::setInternalProperty(
+        self, runtime, pendingIndex, HermesValue::encodeNumberValue(bytes));
+  }
+
+ protected:
+  JSTextDecoder(Runtime *runtime, JSObject *parent, HiddenClass *clazz)
+      : JSObject(runtime, &vt.base, parent, clazz) {}
+
+ private:
+  static const SlotIndex flagsIndex = 0;
+  static const SlotIndex pendingIndex = 1;
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_JSTEXTENCODING_H
@@ -156,6 +156,11 @@ class JSWeakMapImplBase : public JSObject {
  protected:
   static void _finalizeImpl(GCCell *cell, GC *gc) {
     auto *self = vmcast<JSWeakMapImplBase>(cell);
+    // The map only refers to the heap through weak refs, which are freed with
+    // the weak ref slots: free its buckets after the collection.
+    gc->deferFinalization([map = std::move(self->map_)]() mutable {
+      DenseMapT().swap(map);
+    });
     self->~JSWeakMapImplBase();
   }
 
@@ -174,14 +179,11 @@ class JSWeakMapImplBase : public JSObject {
     return map_.getMemorySize();
   }
 
-  /// Mark weak references and set hasFreeableSlots_ if invalidated slots
-  /// were found.
+  /// Mark the weak references of the live keys, and delete the entries of
+  /// the keys that earlier collections found dead, adding their value slots to
+  /// the free list.  Each entry is visited once per collection.
   void markWeakRefs(GC *gc);
 
-  /// Iterate the slots in map_ and call deleteInternal on any invalid
-  /// references, adding all available slots to the free list.
-  void findAndDeleteFreeSlots(PointerBase *base);
-
   /// Erase the map entry and corresponding valueStorage entry
   /// pointed to by the iterator \p it.
   /// Add the newly opened valueStorage slot to the free list.
@@ -216,12 +218,6 @@ class JSWeakMapImplBase : public JSObject {
 
   /// Next index to use when the free list runs out of elements.
   uint32_t nextIndex_{0};
-
-  /// This is set to true when markWeakRefs sees an invalid slot which can be
-  /// freed later.
-  /// When set to true, the WeakMap should look for free slots the next time
-  /// the user tries to add an element.
-  bool hasFreeableSlots_{false};
 };
 
 /// Underlying representation of the WeakMap and WeakSet objects.
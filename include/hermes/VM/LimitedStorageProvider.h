@@ -30,6 +30,10 @@ class LimitedStorageProvider final : public StorageProvider {
   llvm::ErrorOr<void *> newStorage(const char *name) override;
 
   void deleteStorage(void *storage) override;
+
+  size_t hugePageBytes() const override {
+    return delegate_->hugePageBytes();
+  }
 };
 
 } // namespace vm
@@ -32,6 +32,10 @@ class LogFailStorageProvider final : public StorageProvider {
   llvm::ErrorOr<void *> newStorage(const char *name) override;
 
   void deleteStorage(void *storage) override;
+
+  size_t hugePageBytes() const override {
+    return delegate_->hugePageBytes();
+  }
 };
 
 inline size_t LogFailStorageProvider::numFailedAllocs() const {
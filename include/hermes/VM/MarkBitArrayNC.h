@@ -10,6 +10,10 @@
 #include "hermes/VM/AlignedStorage.h"
 #include "hermes/VM/HeapAlign.h"
 
+#include "llvm/Support/MathExtras.h"
+
+#include <atomic>
+
 namespace hermes {
 namespace vm {
 
@@ -51,6 +55,14 @@ class MarkBitArrayNC {
   /// range of the array.
   inline void mark(size_t ind);
 
+  /// Marks the bit for the given index, like mark(), but safely when other
+  /// threads may be marking bits in the same array at the same time.
+  /// \return true if and only if this call set the bit.
+  inline bool atomicMark(size_t ind);
+
+  /// \return The number of bits that are set.
+  inline size_t countMarkedBits() const;
+
   /// Clears the bit array.
   inline void clear();
 
@@ -139,6 +151,33 @@ void MarkBitArrayNC::mark(size_t ind) {
   bitArray_[ind / kBitsPerVal] |= (size_t)1 << (ind % kBitsPerVal);
 }
 
+bool MarkBitArrayNC::atomicMark(size_t ind) {
+  assert(
+      ind < kValidIndices &&
+      "precondition: ind must be within the index range");
+  static_assert(
+      sizeof(std::atomic<size_t>) == sizeof(size_t),
+      "Words of the array must be usable as atomics");
+
+  const size_t bit = (size_t)1 << (ind % kBitsPerVal);
+  auto *word =
+      reinterpret_cast<std::atomic<size_t> *>(&bitArray_[ind / kBitsPerVal]);
+  // The plain load avoids a read-modify-write for the common case of the bit
+  // being set already.
+  if (word->load(std::memory_order_relaxed) & bit) {
+    return false;
+  }
+  return !(word->fetch_or(bit, std::memory_order_relaxed) & bit);
+}
+
+size_t MarkBitArrayNC::countMarkedBits() const {
+  size_t count = 0;
+  for (size_t val : bitArray_) {
+    count += llvm::countPopulation(val);
+  }
+  return count;
+}
+
 void MarkBitArrayNC::clear() {
   ::memset(bitArray_, 0, sizeof(bitArray_));
 }
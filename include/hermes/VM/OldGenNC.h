@@ -23,8 +23,11 @@
 
 #include "llvm/ADT/iterator_range.h"
 
+#include <chrono>
 #include <cstddef>
 #include <deque>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 namespace hermes {
@@ -47,6 +50,12 @@ namespace vm {
 /// - The logical ordering: Region M is ordered before region N if when filling
 ///   the generation's heap byte-by-byte, we start filling M before N.
 ///
+/// Large variable-sized objects are allocated by allocLarge() in segments of
+/// their own, which are in neither ordering: full collections sweep them in
+/// place rather than compacting them, and return a segment once its object is
+/// dead.  Their bytes are accounted for like external memory, as if allocated
+/// at the logical end of the generation.
+///
 /// @name External Memory
 /// @{
 ///
@@ -132,8 +141,13 @@ class OldGen : public GCGeneration {
 
   /// Initialize the OldGen as a generation in the given GenGC.  The \p minSize
   /// and \p maxSize arguments are hints for the minimum and maximum generation
-  /// size, respectively, in bytes.
-  OldGen(GenGC *gc, Size ogs, bool releaseUnused);
+  /// size, respectively, in bytes.  Unless \p releaseUnused, segments that are
+  /// no longer used are cached for \p unusedSegmentRetention.
+  OldGen(
+      GenGC *gc,
+      Size ogs,
+      bool releaseUnused,
+      std::chrono::milliseconds unusedSegmentRetention);
 
   /// @name GCGeneration API
   /// @{
@@ -164,10 +178,10 @@ class OldGen : public GCGeneration {
   void creditExternalMemory(uint32_t size);
   void debitExternalMemory(uint32_t size);
   void updateEffectiveEndForExternalMemory();
+  void forObjsAllocatedSinceGC(const std::function<void(GCCell *)> &callback);
 
 #ifndef NDEBUG
   bool dbgContains(const void *p) const final override;
-  void forObjsAllocatedSinceGC(const std::function<void(GCCell *)> &callback);
 #endif
 
   /// @}
@@ -176,6 +190,17 @@ class OldGen : public GCGeneration {
   /// in that; if that fails, calls allocSlow.
   inline AllocResult alloc(uint32_t size, HasFinalizer hasFinalizer);
 
+  /// Allocate \p size bytes in a segment of their own, which compactions do not
+  /// move, first collecting or growing the generation if it is needed to make
+  /// room.  Owns the allocation context for the duration of the call.
+  AllocResult allocLarge(uint32_t size, HasFinalizer hasFinalizer);
+
+  /// The number of objects allocated by allocLarge() that have not been
+  /// collected.
+  size_t numLargeObjects() const {
+    return largeObjectSegments_.size();
+  }
+
   /// A location in the old gen: a pair of a segment index, and a
   /// pointer into that segment.
   struct Location {
@@ -239,6 +264,114 @@ class OldGen : public GCGeneration {
       const Location &toScan,
       YoungGen::EvacAcceptor &acceptor);
 
+  /// @name Parallel young-gen collections
+  /// @{
+
+  /// A buffer that one thread of a parallel young-gen collection promotes
+  /// cells into.  Buffers are taken from the generation a chunk at a time, so
+  /// that the threads only contend for the generation when one needs a new
+  /// chunk.
+  class PromotionBuffer {
+   public:
+    explicit PromotionBuffer(OldGen *gen) : gen_(gen) {}
+
+    /// \return where to copy a promoted cell of \p size bytes.  The space is
+    /// only taken, by commit(), once the cell has been forwarded there: another
+    /// thread may have promoted the cell first.
+    inline char *reserve(uint32_t size);
+
+    /// Take the space returned by the last call to reserve().
+    inline void commit();
+
+#ifndef NDEBUG
+    /// The number of cells committed to the buffer.
+    unsigned numCells() const {
+      return numCells_;
+    }
+#endif
+
+   private:
+    friend class OldGen;
+
+    /// Cells larger than this are given a chunk of their own, to bound the
+    /// space lost at the end of chunks.
+    static constexpr uint32_t kMaxSharedCellSize = 4 * 1024;
+
+    /// The smallest hole that can be filled, with a FillerCell.
+    static constexpr uint32_t kMinHoleSize =
+        heapAlignSize(sizeof(VariableSizeRuntimeCell));
+
+    /// \return true if a cell of \p size can be taken from the current chunk,
+    /// leaving either nothing or enough space to fill with a FillerCell.
+    inline bool fits(uint32_t size) const;
+
+    /// Slow path of reserve(), which gets a new chunk if needed.
+    char *reserveSlow(uint32_t size);
+
+    /// Give up what is left of the current chunk, and of the last chunk that
+    /// was reserved for a large cell but not committed.
+    void retire();
+
+    OldGen *gen_;
+
+    /// The free part of the current chunk.
+    char *level_{nullptr};
+    char *end_{nullptr};
+
+    /// The card table of the segment holding the current chunk, and the next
+    /// card boundary that an allocation in the chunk is going to cross.
+    CardTable *cardTable_{nullptr};
+    CardTable::Boundary boundary_;
+
+    /// The size of the last reservation.
+    uint32_t reserved_{0};
+
+    /// The chunk taken for the last reservation, if it was for a large cell.
+    char *large_{nullptr};
+
+    /// Space in chunks that is not used by promoted cells, to be filled once
+    /// the collection's threads are done.
+    std::vector<std::pair<char *, uint32_t>> holes_;
+
+    /// The number of chunks taken from the generation.
+    unsigned numChunks_{0};
+
+#ifndef NDEBUG
+    unsigned numCells_{0};
+#endif
+  };
+
+  /// The size of the chunks that promotion buffers take.
+  static constexpr uint32_t kPromotionChunkSize = 32 * 1024;
+
+  /// The space that a parallel young-gen collection with \p numThreads
+  /// threads needs available in this generation, if \p amount bytes survive.
+  /// This is more than \p amount, because of the space left at the end of the
+  /// threads' chunks.
+  static size_t promotionSpaceFor(size_t amount, unsigned numThreads);
+
+  /// The start, and the level at \p originalLevel, of each segment that the
+  /// generation's cells occupied at the start of a young-gen collection.  The
+  /// young-gen pointers in such a region are found by
+  /// markYoungGenPointersInRegion(), which may be called on several regions
+  /// at once from different threads.
+  std::vector<std::pair<char *, const char *>> youngGenPointerRegions(
+      Location originalLevel);
+
+  /// Apply \p acceptor to the pointers in the dirty cards of
+  /// [\p start, \p level), a region returned by youngGenPointerRegions(),
+  /// and clear the cards.
+  void markYoungGenPointersInRegion(
+      char *start,
+      const char *level,
+      YoungGen::ParallelEvacAcceptor &acceptor);
+
+  /// Fill the holes left in the chunks of \p buffer, so that the generation
+  /// can be walked again, once the thread promoting into it is done.
+  void finishPromotion(PromotionBuffer &buffer);
+
+  /// @}
+
   /// Called after the GC's heap has been copied to a new location, in order to
   /// update the references in this space (and the space's own limits) to the
   /// new location.
@@ -254,6 +387,20 @@ class OldGen : public GCGeneration {
   /// assume any card might.
   void updateCardTablesAfterCompaction(bool youngIsEmpty);
 
+  /// Return the segments that were cached at or before \p cachedBefore to the
+  /// storage provider.
+  void releaseCachedSegments(
+      std::chrono::steady_clock::time_point cachedBefore);
+
+  /// Return the cached segments that have been unused for at least the
+  /// retention period, as of \p now, to the storage provider.
+  void releaseIdleSegments(std::chrono::steady_clock::time_point now);
+
+  /// The number of segments cached for reuse.
+  size_t numCachedSegments() const {
+    return segmentCache_.size();
+  }
+
   /// If the owning GC has been allocating directly in the OG, it will
   /// not have maintained the card object boundaries.  This call recreates
   /// the boundaries, making it valid for future YG collections.
@@ -341,11 +488,28 @@ class OldGen : public GCGeneration {
   /// segment, collection, etc).
   void updateCardTableBoundary();
 
+  /// Take a chunk for a PromotionBuffer, of between \p minSize and \p maxSize
+  /// bytes, setting \p size to its size.  Safe to call from several threads.
+  char *allocPromotionChunk(uint32_t minSize, uint32_t maxSize, uint32_t *size);
+
+#ifdef HERMES_SLOW_DEBUG
+  /// Verify that the cards holding young-gen pointers are dirty.
+  void verifyCardTableDirty();
+#endif
+
   /// Slow path for allocation: allocation in the current allocation
   /// segment failed.  Attempt in the next segment, if one exists,
   /// returning a failure if no it does not.
   AllocResult allocRawSlow(uint32_t size, HasFinalizer hasFinalizer);
 
+  /// The segments that compactions move cells within: the filled segments, and
+  /// the active one.
+  inline GCSegmentRange::Ptr compactedSegments();
+
+  /// Return the segments of the large objects that the last full collection
+  /// found dead, and re-register the others, which may have moved.
+  void releaseDeadLargeObjects();
+
   /// See GCGeneration.h for more information.
   size_t effectiveSize();
 
@@ -354,8 +518,8 @@ class OldGen : public GCGeneration {
   Location effectiveEnd();
 
   /// The external memory that is considered conceptually allocated at the end
-  /// of the generation.  This is the total external memory less the
-  /// fragmentation loss, but with a min of zero.
+  /// of the generation.  This is the total external memory, and the bytes of
+  /// large objects, less the fragmentation loss, but with a min of zero.
   size_t trailingExternalMemory() const;
 
   /// The name given to the memory mapping for segments owned by this
@@ -380,9 +544,22 @@ class OldGen : public GCGeneration {
   /// are not currently being allocated into.
   std::deque<AlignedHeapSegment> filledSegments_;
 
+  /// A segment that is not in use, and when it was cached.
+  struct CachedSegment {
+    AlignedHeapSegment segment;
+    std::chrono::steady_clock::time_point since;
+  };
+
   /// Segments in the old generation that are not currently in use, but we have
-  /// retained to serve requests to materialize segments in the future.
-  std::vector<AlignedHeapSegment> segmentCache_;
+  /// retained to serve requests to materialize segments in the future.  They
+  /// are in the order they were cached in.
+  std::vector<CachedSegment> segmentCache_;
+
+  /// The segments holding the objects allocated by allocLarge(), one in each.
+  std::deque<AlignedHeapSegment> largeObjectSegments_;
+
+  /// The sum of the sizes of the objects in largeObjectSegments_.
+  size_t largeObjectBytes_{0};
 
   /// We allocate in segments in "logical" order, and compact to low "logical"
   /// addresses.  This member holds the sum of the used portions of all but the
@@ -399,6 +576,12 @@ class OldGen : public GCGeneration {
 
   /// Whether to return unused memory to OS.
   bool releaseUnused_;
+
+  /// How long cached segments are kept, if not releaseUnused_.
+  std::chrono::milliseconds unusedSegmentRetention_;
+
+  /// Guards allocation of promotion buffer chunks.
+  std::mutex promotionMutex_;
 };
 
 size_t OldGen::Size::maxSegments() const {
@@ -441,7 +624,8 @@ AllocResult OldGen::allocRaw(uint32_t size, HasFinalizer hasFinalizer) {
 }
 
 size_t OldGen::used() const {
-  return usedInFilledSegments_ + activeSegment().used() + externalMemory();
+  return usedInFilledSegments_ + activeSegment().used() + largeObjectBytes_ +
+      externalMemory();
 }
 
 size_t OldGen::size() const {
@@ -471,6 +655,12 @@ GCSegmentRange::Ptr OldGen::allSegments() {
       GCSegmentRange::fuse(OldGenMaterializingRange::create(this)));
 }
 
+GCSegmentRange::Ptr OldGen::compactedSegments() {
+  return GCSegmentRange::concat(
+      OldGenFilledSegmentRange::create(this),
+      GCSegmentRange::singleton(&activeSegment()));
+}
+
 template <typename F>
 inline void OldGen::forUsedSegments(F callback) {
   assert(ownsAllocContext());
@@ -480,6 +670,10 @@ inline void OldGen::forUsedSegments(F callback) {
   }
 
   callback(activeSegment());
+
+  for (auto &large : largeObjectSegments_) {
+    callback(large);
+  }
 }
 
 template <typename F>
@@ -491,6 +685,10 @@ inline void OldGen::forUsedSegments(F callback) const {
   }
 
   callback(activeSegment());
+
+  for (const auto &large : largeObjectSegments_) {
+    callback(large);
+  }
 }
 
 template <typename F>
@@ -505,6 +703,11 @@ inline bool OldGen::whileUsedSegments(F callback) {
   if (LLVM_UNLIKELY(!callback(activeSegment())))
     return false;
 
+  for (auto &large : largeObjectSegments_) {
+    if (LLVM_UNLIKELY(!callback(large)))
+      return false;
+  }
+
   return true;
 }
 
@@ -520,9 +723,43 @@ inline bool OldGen::whileUsedSegments(F callback) const {
   if (!LLVM_UNLIKELY(callback(activeSegment())))
     return false;
 
+  for (const auto &large : largeObjectSegments_) {
+    if (!LLVM_UNLIKELY(callback(large)))
+      return false;
+  }
+
   return true;
 }
 
+char *OldGen::PromotionBuffer::reserve(uint32_t size) {
+  if (LLVM_UNLIKELY(large_ || !fits(size))) {
+    return reserveSlow(size);
+  }
+  reserved_ = size;
+  return level_;
+}
+
+void OldGen::PromotionBuffer::commit() {
+#ifndef NDEBUG
+  ++numCells_;
+#endif
+  if (LLVM_UNLIKELY(large_)) {
+    // The chunk was all for this cell.
+    large_ = nullptr;
+    return;
+  }
+  char *cell = level_;
+  level_ += reserved_;
+  if (boundary_.address() < level_) {
+    cardTable_->updateBoundaries(&boundary_, cell, level_);
+  }
+}
+
+bool OldGen::PromotionBuffer::fits(uint32_t size) const {
+  const size_t avail = end_ - level_;
+  return size == avail || size + kMinHoleSize <= avail;
+}
+
 OldGen::Location OldGen::level() const {
   return {filledSegments_.size(), trueActiveSegment().level()};
 }
@@ -182,6 +182,9 @@ CallResult<Handle<SymbolID>> valueToSymbolID(
 /// `typeof` operator.
 HermesValue typeOf(Runtime *runtime, Handle<> valueHandle);
 
+/// \return the inst::TypeOfIsTypes bit of the result of `typeof` \p value.
+uint8_t typeOfIsType(HermesValue value);
+
 /// Convert a string to an array index following ES5.1 15.4.
 /// A property name P (in the form of a String value) is an array index if and
 /// only if ToString(ToUint32(P)) is equal to P and ToUint32(P) is not equal to
@@ -193,8 +196,14 @@ OptValue<uint32_t> toArrayIndex(
 /// Fast path for toArrayIndex where we already have the view of the string.
 OptValue<uint32_t> toArrayIndex(StringView str);
 
+/// \return the array index represented by \p str, if it has at most as many
+///   characters as the largest index, so that it can be parsed without
+///   allocating. Longer strings are never array indices.
+OptValue<uint32_t> shortStringToArrayIndex(const StringPrimitive *str);
+
 /// If it is possible to cheaply verify that \p value is an array index
-/// according to the rules in ES5.1 15.4, do so and return the index. Note that
+/// according to the rules in ES5.1 15.4, do so and return the index. Numbers
+/// and short strings, such as the key of obj["42"], are checked. Note that
 /// it this fails, the value may still be a valid index.
 OptValue<uint32_t> toArrayIndexFastPath(HermesValue value)
     LLVM_NO_SANITIZE("float-cast-overflow");
@@ -202,6 +211,9 @@ inline OptValue<uint32_t> toArrayIndexFastPath(HermesValue value) {
   if (value.isNumber()) {
     return hermes::doubleToArrayIndex(value.getNumber());
   }
+  if (value.isString()) {
+    return shortStringToArrayIndex(value.getString());
+  }
   return llvm::None;
 }
 
@@ -10,72 +10,31 @@
 #include "hermes/Support/ErrorHandling.h"
 #include "hermes/VM/ArrayStorage.h"
 #include "hermes/VM/Runtime.h"
+#include "hermes/VM/StringPrimitive.h"
 
-#include <vector>
+#include "llvm/Support/MathExtras.h"
+
+#include <cmath>
+#include <limits>
 
 namespace hermes {
 namespace vm {
 
-/// HashMapEntry is a gc-managed entry in the OrderedHashMap.
-/// We use HashMapEntry to form two separate linked lists,
-/// one that tracks the insertion order for iteration purpose, one
-/// tracks the list of entries in a hash table bucket for hash operations.
-class HashMapEntry final : public GCCell {
- public:
-  static VTable vt;
-
-  /// The key.
-  GCHermesValue key;
-
-  /// The value.
-  GCHermesValue value;
-
-  /// Previous entry in insertion order.
-  GCPointer<HashMapEntry> prevIterationEntry{nullptr};
-
-  /// Next entry in insertion order.
-  GCPointer<HashMapEntry> nextIterationEntry{nullptr};
-
-  /// Next entry in the hash table bucket.
-  GCPointer<HashMapEntry> nextEntryInBucket{nullptr};
-
-  static bool classof(const GCCell *cell) {
-    return cell->getKind() == CellKind::HashMapEntryKind;
-  }
-
-  static CallResult<HermesValue> create(Runtime *runtime);
-
-  /// Indicates whether this entry has been deleted.
-  bool isDeleted() const {
-    assert(key.isEmpty() == value.isEmpty() && "Inconsistent deleted status");
-    return value.isEmpty();
-  }
-
-  /// Mark this entry as deleted.
-  void markDeleted() {
-    key.setNonPtr(HermesValue::encodeEmptyValue());
-    value.setNonPtr(HermesValue::encodeEmptyValue());
-  }
-
- protected:
-  HashMapEntry(Runtime *runtime) : GCCell(&runtime->getHeap(), &vt) {}
-}; // HashMapEntry
-
 /// OrderedHashMap is a gc-managed hash map that maintains insertion order.
-/// The map contains two conceptual parts: a standard chained hash table,
-/// to store and lookup HermesValue; a linked list to maintain the insertion
-/// order.
-/// When an element is added, it's always appended to the end of the linked
-/// list. When an element is deleted, we mark it as deleted and remove it
-/// from the linked list, unless it's the last element.
-/// Iterators are pointers to the entries, which are always linked according
-/// to insertion order.
-/// When the size of the hash table becomes unreasonably large or small
-/// comparing to the number of alive elements, we will rehash the table.
-/// We always make sure that any entry at any moment can successfully find
-/// the next entry according to insertion order, and rely on GC to manage
-/// the "deleted" entries", free them when no more iterators are before
-/// that entry.
+/// The map contains two parts: an array of entries in insertion order, and a
+/// hash table with open addressing, which maps the hash of a key to the index
+/// of its entry.
+/// Each entry takes three consecutive slots of the entries storage: the key,
+/// the value and the hash of the key. When an element is added, its entry is
+/// appended to the entries. When an element is deleted, its key and value are
+/// set to empty, and its slot in the hash table is reused by a later insertion.
+/// When the entries storage is full, the entries which haven't been deleted
+/// are moved to a new storage, which is larger if most of them are alive.
+///
+/// Iterators are positions in an entries storage. A storage which has been
+/// replaced records where each of its entries was moved to, and a pointer to
+/// the storage which replaced it, so that an iterator can find its position in
+/// the storage in use.
 class OrderedHashMap final : public GCCell {
   friend void OrderedHashMapBuildMeta(
       const GCCell *cell,
@@ -99,11 +58,12 @@ class OrderedHashMap final : public GCCell {
   get(Handle<OrderedHashMap> self, Runtime *runtime, Handle<> key);
 
   /// Lookup \p key in the table and \return the value if exists.
-  /// Otherwise \return nullptr.
-  static HashMapEntry *
+  /// Otherwise \return empty.
+  static HermesValue
   find(Handle<OrderedHashMap> self, Runtime *runtime, Handle<> key);
 
-  /// Insert a key/value pair into the map, if not already existing.
+  /// Insert a key/value pair into the map, or update the value if the key
+  /// already exists.
   static ExecutionStatus insert(
       Handle<OrderedHashMap> self,
       Runtime *runtime,
@@ -114,77 +74,130 @@ class OrderedHashMap final : public GCCell {
   static bool
   erase(Handle<OrderedHashMap> self, Runtime *runtime, Handle<> key);
 
-  /// Clear the map.  The \p gc parameter is necessary for write barriers.
-  void clear(Runtime *runtime);
+  /// Clear the map.
+  static ExecutionStatus clear(Handle<OrderedHashMap> self, Runtime *runtime);
 
   /// \return the size of the map.
   uint32_t size() const {
     return size_;
   }
 
-  /// \return the next element in insertion order.
-  /// If \p entry is nullptr, we are starting the iteration from the first
-  /// entry that is not deleted.
-  /// Otherwise, we look for the next element after \p entry that is not
-  /// deleted.
-  HashMapEntry *iteratorNext(Runtime *runtime, HashMapEntry *entry = nullptr)
-      const;
+  /// \return the entries storage an iteration starts in, at index 0.
+  ArrayStorage *iteratorBegin(Runtime *runtime) const {
+    return entries_.get(runtime);
+  }
+
+  /// Find the first entry at or after index \p index of \p entries which
+  /// hasn't been deleted, and update \p entries and \p index to its position.
+  /// If \p entries has been replaced, the position is first moved to the
+  /// storage in use.
+  /// \return false if there is no such entry, in which case the iteration has
+  ///   reached the end.
+  static bool
+  iteratorNext(Runtime *runtime, ArrayStorage *&entries, uint32_t &index);
+
+  /// \return the key of the entry at \p index in \p entries.
+  static HermesValue iteratorKey(ArrayStorage *entries, uint32_t index) {
+    return entries->at(keyIndex(index));
+  }
+
+  /// \return the value of the entry at \p index in \p entries.
+  static HermesValue iteratorValue(ArrayStorage *entries, uint32_t index) {
+    return entries->at(keyIndex(index) + 1);
+  }
 
  protected:
-  OrderedHashMap(Runtime *runtime, Handle<ArrayStorage> hashTableStorage);
+  OrderedHashMap(
+      Runtime *runtime,
+      Handle<ArrayStorage> entries,
+      Handle<ArrayStorage> hashTable);
 
  private:
-  /// The hashtable, with size always equal to capacity_. The number of
-  /// reachable entries from hashTable_ should be equal to size_.
-  GCPointer<ArrayStorage> hashTable_{nullptr};
-
-  /// The first entry ever inserted. We need this entry to begin an iteration.
-  GCPointer<HashMapEntry> firstIterationEntry_{nullptr};
+  /// The slots at the start of an entries storage. Once the storage has been
+  /// replaced, they contain the storage which replaced it, and the index in
+  /// that storage of the entry appended after the last one which was moved.
+  enum : uint32_t { ForwardSlot = 0, ForwardEndSlot = 1, HeaderSlots = 2 };
 
-  /// The last entry inserted. We need it to add new elements afterwards.
-  GCPointer<HashMapEntry> lastIterationEntry_{nullptr};
+  /// The number of slots of each entry.
+  static constexpr uint32_t SLOTS_PER_ENTRY = 3;
 
-  /// Initial capacity of the hash table.
-  static constexpr uint32_t INITIAL_CAPACITY = 16;
+  /// Initial number of entries the storage has room for.
+  static constexpr uint32_t INITIAL_CAPACITY = 8;
 
-  /// Maximum capacity cannot exceed the maximum capacity of the underlying
-  /// ArrayStorage.
-  // It needs to be less than 1/4th the max 32-bit integer in order to use an
-  // integer-based load factor check of 0.75.
-  /// TODO(T31421960): Use constexpr std::min.
+  /// Maximum number of entries, such that neither storage is larger than the
+  /// maximum capacity of an ArrayStorage.
   static constexpr uint32_t MAX_CAPACITY =
-      ArrayStorage::maxElements() < UINT32_MAX / 4 ? ArrayStorage::maxElements()
-                                                   : UINT32_MAX / 4;
+      (ArrayStorage::maxElements() - HeaderSlots) / SLOTS_PER_ENTRY;
 
-  /// Capacity of the hash table.
+  /// Returned by lookup() when the key isn't in the map.
+  static constexpr uint32_t NOT_FOUND = UINT32_MAX;
+
+  /// The entries in insertion order, with room for capacity_ entries. Its
+  /// size is always equal to its capacity, so that the GC doesn't trim it.
+  GCPointer<ArrayStorage> entries_{nullptr};
+
+  /// The hash table, with 2 * capacity_ slots. Each slot is either empty, or
+  /// the index of an entry, which may have been deleted.
+  GCPointer<ArrayStorage> hashTable_{nullptr};
+
+  /// The number of entries the entries storage has room for. It is always a
+  /// power of 2.
   uint32_t capacity_{INITIAL_CAPACITY};
 
+  /// The number of entries appended to the entries storage, including the
+  /// deleted ones.
+  uint32_t numEntries_{0};
+
   /// Number of alive entries in the storage.
   uint32_t size_{0};
 
-  /// Hash a HermesValue to an index to our hash table.
-  static uint32_t
-  hashToBucket(Handle<OrderedHashMap> self, Runtime *runtime, Handle<> key) {
-    auto hash = runtime->gcStableHashHermesValue(key);
-    assert(
-        (self->capacity_ & (self->capacity_ - 1)) == 0 &&
-        "capacity_ must be power of 2");
-    return hash & (self->capacity_ - 1);
+  /// \return the index in the entries storage of the key of entry \p entry.
+  static uint32_t keyIndex(uint32_t entry) {
+    return HeaderSlots + entry * SLOTS_PER_ENTRY;
   }
 
-  /// Remove a node from the linked list.
-  void removeLinkedListNode(Runtime *runtime, HashMapEntry *entry, GC *gc);
+  /// \return the hash of \p key, which is equal for keys that are the same
+  ///   value, with +0 and -0 being the same. Strings and numbers, the most
+  ///   common keys, are hashed inline.
+  static uint32_t hashKey(Runtime *runtime, Handle<> key) {
+    if (key->isString()) {
+      return key->getString()->getHash();
+    }
+    if (key->isNumber()) {
+      return hashNumber(key->getNumber());
+    }
+    return (uint32_t)runtime->gcStableHashHermesValue(key);
+  }
+
+  /// \return the hash of the number \p num, with +0 and -0, and all NaNs,
+  ///   having the same hash. The bits are mixed by a multiplication whose
+  ///   high half is kept, so that the low bits used by the hash table depend
+  ///   on all of them.
+  static uint32_t hashNumber(double num) {
+    if (num == 0) {
+      num = 0;
+    } else if (LLVM_UNLIKELY(std::isnan(num))) {
+      num = std::numeric_limits<double>::quiet_NaN();
+    }
+    uint64_t bits = llvm::DoubleToBits(num);
+    return (uint32_t)((bits * UINT64_C(0x9E3779B97F4A7C15)) >> 32);
+  }
 
-  /// Lookup an entry with key as \p key in a given \p bucket.
-  HashMapEntry *
-  lookupInBucket(Runtime *runtime, uint32_t bucket, HermesValue key);
+  /// \return the index of the entry with key \p key, whose hash is \p hash,
+  ///   or NOT_FOUND.
+  uint32_t lookup(Runtime *runtime, HermesValue key, uint32_t hash) const;
 
-  /// Adjust the capacity of the hashtable and rehash if necessary.
-  /// We make decisions based on the Load Factor (size / capacity).
-  /// Rehash if load factor is outside of the range of [0.25, 0.75].
-  static ExecutionStatus rehashIfNecessary(
+  /// Record the index of the new entry \p entry, whose key has hash \p hash,
+  /// in the hash table.
+  void addToHashTable(Runtime *runtime, uint32_t entry, uint32_t hash);
+
+  /// Move the entries which haven't been deleted to new storages with room
+  /// for \p newCapacity entries, and leave their new indices in the old
+  /// entries storage for the iterators.
+  static ExecutionStatus rehash(
       Handle<OrderedHashMap> self,
-      Runtime *runtime);
+      Runtime *runtime,
+      uint32_t newCapacity);
 }; // OrderedHashMap
 } // namespace vm
 } // namespace hermes
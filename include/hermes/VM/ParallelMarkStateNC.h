@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_VM_PARALLELMARKSTATENC_H
+#define HERMES_VM_PARALLELMARKSTATENC_H
+
+#include "hermes/VM/GCBase.h"
+#include "hermes/VM/GCCell.h"
+#include "hermes/VM/GreyQueuesNC.h"
+
+#include <memory>
+#include <vector>
+
+namespace hermes {
+namespace vm {
+
+/// State for completing the marking of a full collection with several threads,
+/// which share the marked cells to scan through GreyQueues.
+///
+/// Worker threads only set mark bits (atomically) and record what is to be
+/// done on the GC's own state, which the calling thread applies in finish().
+class ParallelMarkState {
+ public:
+  /// \p numThreads is the number of threads that marking runs on, including
+  /// the calling one.  \p numSymbols is the range of SymbolIDs that can be
+  /// marked.
+  ParallelMarkState(GC *gc, unsigned numThreads, size_t numSymbols);
+  ~ParallelMarkState();
+
+  ParallelMarkState(const ParallelMarkState &) = delete;
+  void operator=(const ParallelMarkState &) = delete;
+
+  /// Give the marked cell \p cell to one of the threads to scan.
+  void addGrey(GCCell *cell) {
+    greyQueues_.addInitial(cell);
+  }
+
+  /// Scan all the cells given to addGrey(), and all the cells they reach
+  /// transitively, on all threads, returning once they have all finished.
+  void run();
+
+  /// Mark the SymbolIDs, and the weak references of the cells, that were
+  /// reached.  Must be called after run(), on the thread that owns the GC.
+  void finish();
+
+ private:
+  struct Worker;
+  struct MarkAcceptor;
+
+  GC *const gc_;
+
+  GreyQueues greyQueues_;
+
+  /// What each thread has reached, other than cells.
+  std::vector<std::unique_ptr<Worker>> workers_;
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_PARALLELMARKSTATENC_H
@@ -51,6 +51,19 @@ constexpr bool isPredefined(SymbolID sym) {
   return sym.unsafeGetIndex() < _SYMBOL_AFTER_LAST;
 }
 
+/// The number of well-known symbols, like Symbol.iterator.
+constexpr unsigned kNumWellKnownSymbols =
+    _SYMBOL_AFTER_LAST - _SYMBOL_BEFORE_FIRST - 1;
+
+/// \return the position of the well-known symbol \p sym, in
+///   [0, kNumWellKnownSymbols), or -1 if \p sym isn't one.
+constexpr int getWellKnownSymbolIndex(SymbolID sym) {
+  return sym.isNotUniqued() && sym.unsafeGetIndex() > _SYMBOL_BEFORE_FIRST &&
+          sym.unsafeGetIndex() < _SYMBOL_AFTER_LAST
+      ? (int)(sym.unsafeGetIndex() - _SYMBOL_BEFORE_FIRST - 1)
+      : -1;
+}
+
 } // namespace Predefined
 
 } // namespace vm
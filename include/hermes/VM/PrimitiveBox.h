@@ -174,6 +174,14 @@ class JSStringIterator : public JSObject {
       Handle<JSStringIterator> self,
       Runtime *runtime);
 
+  /// Iterate to the next code point without creating an iterator result
+  /// object.
+  /// \return the string of the code point, or the empty value if the
+  ///   iteration is done.
+  static CallResult<HermesValue> nextValue(
+      Handle<JSStringIterator> self,
+      Runtime *runtime);
+
  private:
   JSStringIterator(
       Runtime *runtime,
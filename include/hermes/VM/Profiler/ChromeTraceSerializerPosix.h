@@ -33,6 +33,11 @@ class ChromeFrameIdGenerator {
   uint32_t getNextFrameNodeId() {
     return nextFrameId_++;
   }
+
+  /// \return the id that the next frame will get, without taking it.
+  uint32_t peekNextFrameNodeId() const {
+    return nextFrameId_;
+  }
 };
 
 /// Represent a single stack frame node in collapsed/merged call tree
@@ -148,6 +153,10 @@ class ChromeTraceFormat {
   std::vector<std::shared_ptr<ChromeStackFrameNode>> callTrees_;
   /// Maintain all transformed chrome sample events.
   std::vector<ChromeSampleEvent> sampleEvents_;
+  /// Generates the ids of the nodes of callTrees_.
+  ChromeFrameIdGenerator frameIdGen_;
+  /// Id of the first node not in a chunk returned by takeChunk() yet.
+  uint32_t firstUnsentFrameId_{1};
 
  private:
   ChromeTraceFormat(
@@ -161,6 +170,21 @@ class ChromeTraceFormat {
       const SamplingProfiler::ThreadNamesMap &threadNames,
       const std::vector<SamplingProfiler::StackTrace> &sampledStacks);
 
+  /// Merge \p sampledStacks into the call trees and add their sample events.
+  void addSamples(
+      const std::vector<SamplingProfiler::StackTrace> &sampledStacks);
+
+  /// Replace the thread names map with \p threadNames.
+  void setThreadNames(const SamplingProfiler::ThreadNamesMap &threadNames) {
+    threadNames_ = threadNames;
+  }
+
+  /// \return a trace with the sample events added since the last call, which
+  /// are removed from this one, and the call trees so far, which are shared
+  /// with this one. Frames with ids below the returned frame id were already
+  /// in the previous chunk.
+  std::pair<ChromeTraceFormat, uint32_t> takeChunk();
+
   uint32_t getPid() const {
     return pid_;
   }
@@ -184,6 +208,8 @@ class ChromeTraceSerializer {
  private:
   ChromeTraceFormat trace_;
   SamplingProfiler::TimeStampType firstEventTimeStamp_;
+  /// Stack frames with lower ids are left out of "stackFrames".
+  uint32_t firstFrameId_;
 
  private:
   // Emit process_name metadata event.
@@ -196,7 +222,12 @@ class ChromeTraceSerializer {
   void serializeStackFrames(JSONEmitter &json) const;
 
  public:
-  explicit ChromeTraceSerializer(ChromeTraceFormat &&chromeTrace);
+  /// Serialize \p chromeTrace, leaving out the stack frames with ids below
+  /// \p firstFrameId, which were emitted as part of an earlier chunk of the
+  /// same session.
+  explicit ChromeTraceSerializer(
+      ChromeTraceFormat &&chromeTrace,
+      uint32_t firstFrameId = 0);
 
   /// Serialize chrome trace to \p OS.
   void serialize(llvm::raw_ostream &OS) const;
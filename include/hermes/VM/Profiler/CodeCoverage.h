@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_VM_PROFILER_CODECOVERAGE_H
+#define HERMES_VM_PROFILER_CODECOVERAGE_H
+
+#include "llvm/Support/raw_ostream.h"
+
+namespace hermes {
+namespace vm {
+
+class Runtime;
+
+/// Basic block coverage of the bytecode, cheap enough to run a test suite
+/// with.  Unlike the basic block profiler, nothing is compiled in: while
+/// coverage is enabled, the interpreter sets a bit in the CodeBlock for the
+/// first instruction of a function when it is entered, and for the
+/// destination of every branch, taken or not, of every switch and of every
+/// exception handler, which are the only places where a basic block can be
+/// entered other than by falling through from the previous one.  The basic
+/// blocks themselves are only discovered when the coverage is written out.
+///
+/// A block entered by falling through counts as covered when the block
+/// before it is, even if an exception left that block before its end.
+/// Compiled code doesn't record coverage, so nothing is JIT-compiled while
+/// it is enabled, but functions that are already compiled and are called
+/// directly from compiled code are not seen.
+class CodeCoverage {
+ public:
+  /// Forget the coverage recorded in the functions of \p runtime.
+  static void clear(Runtime *runtime);
+
+  /// Write the basic blocks of every function loaded in \p runtime, and
+  /// whether they were covered, to \p os as JSON.  Every block has its
+  /// bytecode offset and size, and the source location of its first
+  /// instruction when the bytecode has debug info.  Functions compiled
+  /// lazily which never ran are left out.
+  static void serialize(Runtime *runtime, llvm::raw_ostream &os);
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_PROFILER_CODECOVERAGE_H
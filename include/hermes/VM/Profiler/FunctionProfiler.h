@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_VM_PROFILER_FUNCTIONPROFILER_H
+#define HERMES_VM_PROFILER_FUNCTIONPROFILER_H
+
+#include "llvm/Support/Compiler.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace hermes {
+namespace vm {
+
+class CodeBlock;
+class Runtime;
+
+/// The opt-in part of the function profile that measures where the time of
+/// each function goes: wall time is charged to the function that is current
+/// and to what it is doing, switching at every interpreted call and return,
+/// around calls into JIT-compiled code and native functions, and around
+/// garbage collections.  Native functions and collections are charged to the
+/// JS function that called or triggered them.  Time with no JS function on
+/// the stack is not charged.  The totals live in the CodeBlocks.
+class FunctionTimeAttribution {
+ public:
+  /// What the time of a function is spent on.
+  enum class Category {
+    /// Its own bytecode, in the interpreter.
+    Interpreter,
+    /// Its JIT-compiled code, including the compiled functions it calls
+    /// directly.
+    JIT,
+    /// The native functions it calls.
+    Native,
+    /// The collections triggered while it runs.
+    GC,
+  };
+  static constexpr unsigned kNumCategories = 4;
+
+  /// What the time is charged to.
+  struct State {
+    CodeBlock *codeBlock;
+    Category category;
+  };
+
+  FunctionTimeAttribution()
+      : current_{nullptr, Category::Interpreter},
+        since_(std::chrono::steady_clock::now()) {}
+
+  /// \return what the time is charged to.
+  const State &current() const {
+    return current_;
+  }
+
+  /// Charge the time since the last switch to the current state, then make
+  /// \p state current.
+  /// \return the previous state.
+  State switchTo(State state);
+
+ private:
+  State current_;
+  std::chrono::steady_clock::time_point since_;
+};
+
+/// Charges the time of a scope to a function and category, if time is being
+/// attributed, and goes back to the previous one at the end.
+class ScopedTimeAttribution {
+ public:
+  /// Charge the scope to \p codeBlock and \p category, or to the current
+  /// function if \p codeBlock is null.  Does nothing if \p attribution is
+  /// null.
+  ScopedTimeAttribution(
+      FunctionTimeAttribution *attribution,
+      CodeBlock *codeBlock,
+      FunctionTimeAttribution::Category category)
+      : attribution_(attribution) {
+    if (LLVM_UNLIKELY(attribution_ != nullptr)) {
+      previous_ = attribution_->switchTo(
+          {codeBlock ? codeBlock : attribution_->current().codeBlock,
+           category});
+    }
+  }
+
+  ~ScopedTimeAttribution() {
+    if (LLVM_UNLIKELY(attribution_ != nullptr))
+      attribution_->switchTo(previous_);
+  }
+
+  ScopedTimeAttribution(const ScopedTimeAttribution &) = delete;
+  void operator=(const ScopedTimeAttribution &) = delete;
+
+ private:
+  FunctionTimeAttribution *const attribution_;
+  FunctionTimeAttribution::State previous_{
+      nullptr,
+      FunctionTimeAttribution::Category::Interpreter};
+};
+
+/// Drives the cheap function profile that can be left on in release builds.
+/// The profile itself lives in the CodeBlocks: every interpreted call
+/// increments the invocation count of the callee, and whenever the tick flag
+/// is found set at a function entry, a return or a loop back-edge, it is
+/// cleared and a sample is added to the function that is executing.  This
+/// class owns the timer thread that sets the flag once per interval, so the
+/// samples of a function approximate the time spent in its own code.
+///
+/// Samples are only taken where the interpreter checks the flag, so time
+/// spent in a loop without calls is only seen when the JIT is built in (which
+/// is when the back-edges are checked), and time spent in native functions is
+/// charged to the JS function that called them.
+class FunctionProfiler {
+ public:
+  /// Start the timer thread, which sets \p tick once every \p interval.
+  FunctionProfiler(std::atomic<bool> &tick, std::chrono::microseconds interval);
+  ~FunctionProfiler();
+
+  FunctionProfiler(const FunctionProfiler &) = delete;
+  void operator=(const FunctionProfiler &) = delete;
+
+  std::chrono::microseconds getInterval() const {
+    return interval_;
+  }
+
+  /// Reset the invocation counts and samples of all the functions of
+  /// \p runtime.
+  static void clear(Runtime *runtime);
+
+  /// Write the invocation counts and samples of the functions of \p runtime
+  /// to \p os as JSON, skipping the functions that were neither called nor
+  /// sampled.  \p interval is the sampling interval, or 0 if only the
+  /// invocations were counted.  If \p attributedTime, the time attributed to
+  /// each function is written too, and the functions are ranked by it.
+  static void serialize(
+      Runtime *runtime,
+      std::chrono::microseconds interval,
+      bool attributedTime,
+      llvm::raw_ostream &os);
+
+ private:
+  /// Body of the timer thread.
+  void timerLoop();
+
+  std::atomic<bool> &tick_;
+  const std::chrono::microseconds interval_;
+
+  /// Protects stop_, which tells the timer thread to exit.
+  std::mutex mutex_;
+  std::condition_variable stopCondVar_;
+  bool stop_{false};
+
+  std::thread timerThread_;
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_PROFILER_FUNCTIONPROFILER_H
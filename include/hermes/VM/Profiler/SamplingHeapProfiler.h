@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_VM_PROFILER_SAMPLINGHEAPPROFILER_H
+#define HERMES_VM_PROFILER_SAMPLINGHEAPPROFILER_H
+
+#include "hermes/Support/JSONEmitter.h"
+#include "hermes/VM/Runtime.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <memory>
+#include <vector>
+
+namespace hermes {
+namespace vm {
+
+/// Records the JS stack of allocations sampled by the GC, once per sampling
+/// interval's worth of allocated bytes (see GCBase::shouldSampleAllocation()),
+/// and merges them into a call tree.  The tree is written in the format of
+/// the sampling heap profiles of the Chrome DevTools (.heapprofile files).
+///
+/// The profile covers every sampled allocation, including the objects that
+/// have since been collected.
+class SamplingHeapProfiler {
+ public:
+  /// Sample the allocations of \p runtime once every \p samplingInterval
+  /// bytes, which must be greater than 0.
+  SamplingHeapProfiler(Runtime *runtime, size_t samplingInterval);
+  ~SamplingHeapProfiler();
+
+  SamplingHeapProfiler(const SamplingHeapProfiler &) = delete;
+  void operator=(const SamplingHeapProfiler &) = delete;
+
+  /// Record an allocation of \p size bytes at the current JS stack.  Must not
+  /// be called during a collection.
+  void sample(uint32_t size);
+
+  /// Mark the Domains of the RuntimeModules that the recorded frames refer to,
+  /// which are needed to name them.
+  void markRoots(SlotAcceptorWithNames &acceptor) {
+    for (Domain *&domain : domains_) {
+      acceptor.acceptPtr(domain);
+    }
+  }
+
+  /// Write the profile to \p os, as a Chrome DevTools sampling heap profile.
+  void serialize(llvm::raw_ostream &os) const;
+
+ private:
+  /// A function on the stack of a sampled allocation.
+  struct Frame {
+    /// The module of a JS function, or null for a native function.
+    RuntimeModule *module;
+    /// The function ID of a JS function, or the address of a native one.
+    uintptr_t function;
+
+    bool operator==(const Frame &that) const {
+      return module == that.module && function == that.function;
+    }
+  };
+
+  /// A node of the call tree.  The root node has no frame.
+  struct Node {
+    /// Unique id of the node, which the samples refer to.
+    uint32_t id;
+    Frame frame;
+    /// The bytes sampled with this node at the top of the stack.
+    uint64_t selfSize{0};
+    std::vector<std::unique_ptr<Node>> children;
+
+    Node(uint32_t id, Frame frame) : id(id), frame(frame) {}
+  };
+
+  /// A sampled allocation.
+  struct Sample {
+    /// The size of the allocation.
+    uint32_t size;
+    /// The node of its stack.
+    uint32_t nodeId;
+  };
+
+  /// \return the child of \p parent for \p frame, adding it if needed.
+  Node *findOrAddChild(Node *parent, const Frame &frame);
+
+  /// Keep \p domain alive for as long as the profile refers to it.
+  void registerDomain(Domain *domain);
+
+  /// The scriptId of each module in the profile, in the order they are
+  /// first written.
+  using ScriptIDs = llvm::DenseMap<RuntimeModule *, unsigned>;
+
+  /// Write \p node, and the subtree below it, to \p json.
+  void serializeNode(JSONEmitter &json, const Node &node, ScriptIDs &ids)
+      const;
+
+  Runtime *const runtime_;
+
+  /// The number of allocated bytes that each sample stands for.
+  const size_t samplingInterval_;
+
+  Node root_{0, {nullptr, 0}};
+
+  /// The id of the next node to be added.
+  uint32_t nextNodeId_{1};
+
+  std::vector<Sample> samples_;
+
+  /// The Domains of the modules that the tree refers to.
+  std::vector<Domain *> domains_;
+
+  /// The frames of the stack being sampled, from the leaf to the root.  Kept
+  /// here to avoid allocating it for every sample.
+  std::vector<Frame> stack_;
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_PROFILER_SAMPLINGHEAPPROFILER_H
@@ -10,6 +10,7 @@
 #include "hermes/Support/Semaphore.h"
 #include "hermes/Support/ThreadLocal.h"
 #include "hermes/VM/Runtime.h"
+#include "hermes/VM/instrumentation/PerfEvents.h"
 
 #include "llvm/ADT/DenseMap.h"
 
@@ -20,6 +21,8 @@
 #endif
 
 #include <chrono>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -31,6 +34,8 @@
 namespace hermes {
 namespace vm {
 
+class ChromeTraceFormat;
+
 /// Singleton wall-time based JS sampling profiler that walks VM stack frames
 /// in a configurable interval. The profiler can be enabled and disabled
 /// on demand.
@@ -98,6 +103,27 @@ class SamplingProfiler {
   /// Max size of sampleStorage_.
   static const int kMaxStackDepth = 500;
 
+  /// Max number of samples kept, about a minute at the sampling rate.
+  static const uint32_t kMaxSamples = 1 << 16;
+  /// Max number of stack frames kept, for all samples.
+  static const uint32_t kMaxSampledFrames = 1 << 18;
+
+  /// A sample kept in sampledFrames_.
+  struct SampleRecord {
+    /// Id of the thread that the stack trace is taken from.
+    ThreadId tid;
+    /// Timestamp when the stack trace is taken.
+    TimeStampType timeStamp;
+    /// Index of the leaf frame in sampledFrames_. The callers follow it,
+    /// wrapping around at the end.
+    uint32_t firstFrame;
+    /// Number of frames.
+    uint32_t depth;
+    /// Whether the perf counters were read for this sample, in which case
+    /// they are at the same index in sampleCounters_.
+    bool hasCounters;
+  };
+
   /// Pointing to the singleton SamplingProfiler instance.
   /// We need this field because accessing local static variable from
   /// signal handler is unsafe.
@@ -110,6 +136,22 @@ class SamplingProfiler {
   /// Protected by profilerLock_.
   llvm::DenseMap<Runtime *, pthread_t> activeRuntimeThreads_;
 
+  /// The ids of the threads of activeRuntimeThreads_, for the perf counters.
+  /// Protected by profilerLock_.
+  llvm::DenseMap<Runtime *, ThreadId> runtimeThreadIds_;
+
+  /// Whether to read the perf counters of the sampled thread at each sample.
+  /// Protected by profilerLock_.
+  bool capturePerfCounters_{false};
+
+  /// The perf counters of the threads of activeRuntimeThreads_, while
+  /// profiling with capturePerfCounters_. Threads without counters are left
+  /// out. Protected by profilerLock_.
+  llvm::DenseMap<
+      Runtime *,
+      std::unique_ptr<instrumentation::ThreadPerfCounters>>
+      perfCounters_;
+
   /// Per-thread runtime instance for loom/local profiling.
   /// Limitations: No recursive runtimes in one thread.
   ThreadLocal<Runtime> threadLocalRuntime_;
@@ -122,8 +164,28 @@ class SamplingProfiler {
   /// Semaphore to indicate all signal handlers have finished the sampling.
   Semaphore samplingDoneSem_;
 
-  /// Sampled stack traces overtime. Protected by profilerLock_.
-  std::vector<StackTrace> sampledStacks_;
+  /// Ring buffer of the latest samples, of size kMaxSamples once the profiler
+  /// has been enabled, so that sampling doesn't allocate and long sessions
+  /// use bounded memory. The oldest samples are dropped when it is full.
+  /// Protected by profilerLock_.
+  std::vector<SampleRecord> samples_;
+  /// Index of the oldest sample in samples_, and number of samples kept.
+  uint32_t firstSample_{0};
+  uint32_t numSamples_{0};
+
+  /// Ring buffer of the frames of samples_, of size kMaxSampledFrames once the
+  /// profiler has been enabled. The frames are stored raw and are only turned
+  /// into StackTraces when dumped. Protected by profilerLock_.
+  std::vector<StackFrame> sampledFrames_;
+  /// Index of the first frame of the oldest sample, and number of frames
+  /// kept.
+  uint32_t firstFrame_{0};
+  uint32_t numFrames_{0};
+
+  /// The perf counters read at the samples of samples_, at the same indices,
+  /// of size kMaxSamples when profiling with capturePerfCounters_.
+  /// Protected by profilerLock_.
+  std::vector<instrumentation::ThreadPerfCounters::Values> sampleCounters_;
 
   /// Threading: load/store of sampledStackDepth_ and sampleStorage_
   /// are protected by samplingDoneSem_.
@@ -135,6 +197,12 @@ class SamplingProfiler {
   /// it is serialized by samplingDoneSem_.
   StackTrace sampleStorage_{kMaxStackDepth};
 
+  /// The perf counters that the signal handler reads into sampledCounters_,
+  /// or null. Serialized by samplingDoneSem_ like sampleStorage_.
+  const instrumentation::ThreadPerfCounters *samplePerfCounters_{nullptr};
+  instrumentation::ThreadPerfCounters::Values sampledCounters_;
+  bool sampledHasCounters_{false};
+
   /// Prellocated map that contains thread names mapping.
   ThreadNamesMap threadNames_;
 
@@ -149,6 +217,17 @@ class SamplingProfiler {
   /// registerDomain() keeps a Domain from being destructed.
   std::vector<Domain *> domains_;
 
+  /// The call trees of the samples streamed by dumpChromeTraceChunk() in the
+  /// current session, created by the first chunk. Protected by profilerLock_.
+  std::unique_ptr<ChromeTraceFormat> chunkedTrace_;
+
+  /// Called by the timer thread with a trace chunk every chunkInterval_, if
+  /// set. Protected by profilerLock_.
+  std::function<void(std::string)> chunkCallback_;
+  std::chrono::milliseconds chunkInterval_{0};
+  /// When the timer thread should produce the next chunk.
+  TimeStampType nextChunkTime_;
+
  private:
   SamplingProfiler();
 
@@ -178,6 +257,13 @@ class SamplingProfiler {
   /// Timer loop thread main routine.
   void timerLoop();
 
+  /// Pass a trace chunk to chunkCallback_ if one is due.
+  void maybeStreamChunk();
+
+  /// Serialize the samples since the previous chunk to \p OS.
+  /// Note: caller should take the lock before calling.
+  void writeChromeTraceChunk(llvm::raw_ostream &OS);
+
   /// Walk runtime stack frames and store in \p sampleStorage.
   /// This function is called from signal handler so should obey all
   /// rules of signal handler(no lock, no memory allocation etc...)
@@ -192,11 +278,35 @@ class SamplingProfiler {
       uint8_t max_depth);
 #endif
 
+  /// Add the first \p depth frames of \p sample, and \p counters if not null,
+  /// to the ring buffers, dropping the oldest samples if there is no room for
+  /// it.
+  /// Note: caller should take the lock before calling.
+  void recordSample(
+      const StackTrace &sample,
+      uint32_t depth,
+      const instrumentation::ThreadPerfCounters::Values *counters);
+
+  /// Start the perf counters of the thread of \p runtime, if they are
+  /// available.
+  /// Note: caller should take the lock before calling.
+  void openPerfCounters(Runtime *runtime);
+
+  /// \return the samples in the ring buffers, oldest first.
+  /// Note: caller should take the lock before calling.
+  std::vector<StackTrace> getSampledStacks() const;
+
   /// Clear previous stored samples.
   /// Note: caller should take the lock before calling.
   void clear();
 
+  /// Clear previous stored samples but keep the thread names.
+  /// Note: caller should take the lock before calling.
+  void clearSamples();
+
  public:
+  ~SamplingProfiler();
+
   /// Return the singleton profiler instance.
   static const std::shared_ptr<SamplingProfiler> &getInstance();
 
@@ -226,8 +336,33 @@ class SamplingProfiler {
   /// Dump sampled stack to \p OS in chrome trace format.
   void dumpChromeTrace(llvm::raw_ostream &OS);
 
-  /// Enable and start profiling.
-  bool enable();
+  /// Dump the stacks sampled since the previous chunk to \p OS in chrome
+  /// trace format, and drop them, so that a long session can be uploaded
+  /// piece by piece. Each chunk is a complete trace, but the stack frame
+  /// ids are kept for the whole session (from enable() on), and a chunk's
+  /// "stackFrames" only has the frames that are new since the previous
+  /// chunk: the consumer merges them.
+  void dumpChromeTraceChunk(llvm::raw_ostream &OS);
+
+  /// Have the sampling thread call \p callback with a chunk, as written by
+  /// dumpChromeTraceChunk(), every \p interval while profiling. An empty
+  /// \p callback stops it.
+  void setChromeTraceChunkCallback(
+      std::function<void(std::string)> callback,
+      std::chrono::milliseconds interval);
+
+  /// Write the perf counters of the samples, aggregated per function, to
+  /// \p OS as JSON: the counts between a sample and the previous one of the
+  /// same thread are charged to the function executing at the sample, so
+  /// that the ratios tell apart the functions that are bound by instructions
+  /// and by memory. Functions are ranked by cycles. Writes no functions if
+  /// the counters were not captured.
+  void dumpPerfCounters(llvm::raw_ostream &OS);
+
+  /// Enable and start profiling. If \p capturePerfCounters, also read the
+  /// CPU cycles, instructions, cache misses and branch misses of the sampled
+  /// thread at each sample, where the system allows it.
+  bool enable(bool capturePerfCounters = false);
 
   /// Disable and stop profiling.
   bool disable();
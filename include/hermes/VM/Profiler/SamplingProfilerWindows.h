@@ -44,8 +44,19 @@ class SamplingProfiler {
   /// Dump sampled stack to \p OS in chrome trace format.
   void dumpChromeTrace(llvm::raw_ostream &OS) {}
 
+  /// Dump the stacks sampled since the previous chunk to \p OS.
+  void dumpChromeTraceChunk(llvm::raw_ostream &OS) {}
+
+  /// Call \p callback with a chunk every \p interval while profiling.
+  void setChromeTraceChunkCallback(
+      std::function<void(std::string)> callback,
+      std::chrono::milliseconds interval) {}
+
+  /// Write the perf counters of the samples, per function, to \p OS.
+  void dumpPerfCounters(llvm::raw_ostream &OS) {}
+
   /// Enable and start profiling.
-  bool enable() {
+  bool enable(bool capturePerfCounters = false) {
     return false;
   }
 
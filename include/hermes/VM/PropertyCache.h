@@ -9,6 +9,9 @@
 
 #include "hermes/VM/SymbolID.h"
 
+#include <cassert>
+#include <cstdint>
+
 namespace hermes {
 namespace vm {
 using SlotIndex = uint32_t;
@@ -27,6 +30,180 @@ struct PropertyCacheEntry {
   SlotIndex slot{0};
 };
 
+/// A polymorphic inline cache for a single property access site.
+/// It remembers up to \c kNumWays (class, slot) pairs, which are probed in
+/// order. Once a site has observed more distinct classes than it can hold, it
+/// becomes megamorphic: the existing ways are kept (and can still hit), but
+/// no new classes are added, so that the site stops thrashing.
+/// Ways whose class was collected by the GC are reset to null. They are
+/// refilled by later insertions only while the site is not megamorphic; a
+/// megamorphic site never caches a new class, even in a freed way.
+struct PolyPropertyCacheEntry {
+  /// Number of (class, slot) pairs held by a single site.
+  static constexpr unsigned kNumWays = 4;
+
+  /// The cached pairs. Unused ways have a null class. The first way is at
+  /// offset zero, so a monomorphic site has the same layout as a
+  /// PropertyCacheEntry.
+  PropertyCacheEntry ways[kNumWays]{};
+
+  /// Set once the site has seen more than kNumWays classes.
+  bool megamorphic{false};
+
+  /// \return the way caching \p clazz, or nullptr if there is none.
+  PropertyCacheEntry *find(const HiddenClass *clazz) {
+    assert(clazz && "cannot look up a null class");
+    for (auto &way : ways) {
+      if (way.clazz == clazz)
+        return &way;
+    }
+    return nullptr;
+  }
+
+  /// Record that \p clazz has the property at \p slot. If all ways are in use
+  /// the site transitions to the megamorphic state instead.
+  /// \return true if the pair was cached.
+  bool insert(HiddenClass *clazz, SlotIndex slot) {
+    assert(clazz && "cannot cache a null class");
+    if (megamorphic)
+      return false;
+    for (auto &way : ways) {
+      if (!way.clazz || way.clazz == clazz) {
+        way.clazz = clazz;
+        way.slot = slot;
+        return true;
+      }
+    }
+    megamorphic = true;
+    return false;
+  }
+};
+
+/// A cache entry for a property found on the prototype chain rather than on
+/// the receiver itself, as is typical for method calls on class instances.
+/// Hidden classes do not record the prototype, so the entry is keyed on the
+/// class of the receiver, which proves that the receiver lacks the property,
+/// and is validated against the classes of the objects on the chain, which are
+/// read live on every hit. Since non-dictionary classes are immutable, adding,
+/// deleting or reconfiguring a property of any of those objects gives it a new
+/// class and so invalidates the entry, without a separate validity epoch.
+///
+/// Accessor properties are cached here too, including those owned by the
+/// receiver. A hit reads the PropertyAccessor from the slot and calls its
+/// getter, so replacing the accessor without changing the class is still
+/// observed.
+struct ProtoPropertyCacheEntry {
+  /// Class of the receiver.
+  HiddenClass *receiverClass{nullptr};
+
+  /// Class of the receiver's parent when the property is found on the
+  /// grandparent, or null when it is found on the parent itself.
+  HiddenClass *intermediateClass{nullptr};
+
+  /// Class of the object holding the property.
+  HiddenClass *holderClass{nullptr};
+
+  /// Index of the property in the holder.
+  SlotIndex slot{0};
+
+  /// Whether the property is an accessor, whose getter must be called.
+  bool accessor{false};
+
+  /// Whether the holder is the receiver itself, which is only the case for
+  /// accessors. \c intermediateClass is then null and \c holderClass is the
+  /// receiver class.
+  bool ownProperty{false};
+};
+
+/// A runtime-wide cache mapping (class, property name) to the slot of an own,
+/// non-accessor property, shared by all property access sites that have
+/// become megamorphic. It is direct-mapped: a colliding insertion simply
+/// overwrites the previous entry.
+/// Entries hold raw class pointers and SymbolIDs without keeping them alive,
+/// so the whole cache is cleared whenever the GC marks or updates weak roots,
+/// which covers both collected and moved classes.
+class MegamorphicPropertyCache {
+ public:
+  /// Number of entries. Must be a power of two.
+  static constexpr unsigned kNumEntries = 1024;
+
+  struct Entry {
+    /// Cached class, or null if the entry is unused.
+    const HiddenClass *clazz{nullptr};
+
+    /// Name of the property.
+    SymbolID name{};
+
+    /// Index of the property in objects of class \c clazz.
+    SlotIndex slot{0};
+
+    /// Whether the property may be written through the cache, i.e. whether
+    /// it is writable and has no internal setter.
+    bool writable{false};
+  };
+
+  MegamorphicPropertyCache() = default;
+  MegamorphicPropertyCache(const MegamorphicPropertyCache &) = delete;
+  void operator=(const MegamorphicPropertyCache &) = delete;
+
+  /// \return the entry for property \p name of \p clazz, or nullptr if it is
+  ///   not cached.
+  const Entry *find(const HiddenClass *clazz, SymbolID name) const {
+    const Entry &entry = entries_[index(clazz, name)];
+    return entry.clazz == clazz && entry.name == name ? &entry : nullptr;
+  }
+
+  /// Record that objects of class \p clazz hold property \p name at
+  /// \p slot.
+  void insert(
+      const HiddenClass *clazz,
+      SymbolID name,
+      SlotIndex slot,
+      bool writable) {
+    assert(clazz && "cannot cache a null class");
+    Entry &entry = entries_[index(clazz, name)];
+    entry.clazz = clazz;
+    entry.name = name;
+    entry.slot = slot;
+    entry.writable = writable;
+  }
+
+  /// Remove all entries.
+  void clear() {
+    for (auto &entry : entries_)
+      entry.clazz = nullptr;
+  }
+
+ private:
+  static unsigned index(const HiddenClass *clazz, SymbolID name) {
+    // Classes are at least 8-byte aligned, so drop the low bits before mixing
+    // in the symbol.
+    auto bits = reinterpret_cast<uintptr_t>(clazz) >> 3;
+    return (bits ^ (name.unsafeGetRaw() * 0x9E3779B1u)) & (kNumEntries - 1);
+  }
+
+  Entry entries_[kNumEntries];
+};
+
+/// Per-CodeBlock counters describing how effective its property caches are.
+struct PropertyCacheStats {
+  /// Number of accesses satisfied by a cached way.
+  uint64_t hits{0};
+
+  /// Number of accesses that were not, while the site could still learn.
+  uint64_t misses{0};
+
+  /// Number of accesses that missed on a site which was already megamorphic.
+  uint64_t megamorphicMisses{0};
+
+  PropertyCacheStats &operator+=(const PropertyCacheStats &other) {
+    hits += other.hits;
+    misses += other.misses;
+    megamorphicMisses += other.megamorphicMisses;
+    return *this;
+  }
+};
+
 } // namespace vm
 } // namespace hermes
 #endif // PROJECT_PROPERTYCACHE_H
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_VM_REGEXPCACHE_H
+#define HERMES_VM_REGEXPCACHE_H
+
+#include "llvm/ADT/ArrayRef.h"
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hermes {
+namespace vm {
+
+/// The bytecode of a compiled regex. It is never modified once compiled, so
+/// it is shared by every RegExp compiled from the same pattern and flags.
+using RegExpBytecode = std::shared_ptr<const std::vector<uint8_t>>;
+
+/// A cache of the bytecode compiled from RegExp patterns which are not
+/// literals, keyed by the pattern and the flags which affect compilation.
+/// When it is full, the least recently used entry is evicted.
+class RegExpCache {
+ public:
+  /// Maximum number of entries.
+  static constexpr size_t kMaxEntries = 64;
+
+  /// Patterns longer than this are not cached, so that a few large patterns
+  /// can't hold on to a lot of memory.
+  static constexpr size_t kMaxPatternLength = 1024;
+
+  RegExpCache() = default;
+  RegExpCache(const RegExpCache &) = delete;
+  void operator=(const RegExpCache &) = delete;
+
+  /// \return the bytecode compiled from \p pattern with \p flags, or nullptr
+  ///   if it isn't cached.
+  RegExpBytecode find(llvm::ArrayRef<char16_t> pattern, uint8_t flags) {
+    auto it = map_.find(makeKey(pattern, flags));
+    if (it == map_.end())
+      return nullptr;
+    // Move the entry to the front of the list.
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->second;
+  }
+
+  /// Record that \p bytecode was compiled from \p pattern with \p flags,
+  /// evicting the least recently used entry if the cache is full.
+  void insert(
+      llvm::ArrayRef<char16_t> pattern,
+      uint8_t flags,
+      RegExpBytecode bytecode) {
+    if (pattern.size() > kMaxPatternLength)
+      return;
+    std::u16string key = makeKey(pattern, flags);
+    auto it = map_.find(key);
+    if (it != map_.end()) {
+      it->second->second = std::move(bytecode);
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return;
+    }
+    if (map_.size() == kMaxEntries) {
+      map_.erase(lru_.back().first);
+      lru_.pop_back();
+    }
+    lru_.emplace_front(key, std::move(bytecode));
+    map_.emplace(std::move(key), lru_.begin());
+  }
+
+  /// \return the number of entries.
+  size_t size() const {
+    return map_.size();
+  }
+
+  /// Remove all entries.
+  void clear() {
+    map_.clear();
+    lru_.clear();
+  }
+
+ private:
+  using List = std::list<std::pair<std::u16string, RegExpBytecode>>;
+
+  /// \return the key of \p pattern with \p flags: the pattern followed by a
+  ///   character holding the flags.
+  static std::u16string makeKey(
+      llvm::ArrayRef<char16_t> pattern,
+      uint8_t flags) {
+    std::u16string key;
+    key.reserve(pattern.size() + 1);
+    key.append(pattern.begin(), pattern.end());
+    key.push_back(flags);
+    return key;
+  }
+
+  /// Entries from the most recently used to the least recently used.
+  List lru_;
+
+  /// Map from the key of each entry to its position in lru_.
+  std::unordered_map<std::u16string, List::iterator> map_;
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_REGEXPCACHE_H
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_VM_REGISTERSTACKGUARD_H
+#define HERMES_VM_REGISTERSTACKGUARD_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace hermes {
+namespace vm {
+
+class PinnedHermesValue;
+
+/// A register stack preceded by an inaccessible guard region. The stack grows
+/// down towards the guard, so the interpreter can allocate small frames
+/// without comparing the stack pointer with the end of the stack: the first
+/// write past the end faults in the guard region, and the fault handler makes
+/// the region accessible and sets a flag instead of crashing. The write then
+/// completes in the guard region, and while the flag is set the interpreter
+/// checks the stack explicitly, throwing a RangeError on the next call.
+/// Once the frames in the guard region are popped, the region is protected
+/// again with rearm().
+///
+/// The fault handler is installed for SIGSEGV and SIGBUS when the first guard
+/// is created, and passes the faults outside of all guard regions to the
+/// handlers that were installed before. Guards are only supported on POSIX
+/// systems.
+///
+/// Since the handler is process-wide, guards are opt-in through
+/// RuntimeConfig::RegisterStackGuard. A host crash reporter sees every fault
+/// only if it was installed before the first guard, in which case faults
+/// outside the guard regions are forwarded to it. A reporter installed later
+/// must itself chain to the previous handler, or the guard regions fault
+/// without being recovered.
+class RegisterStackGuard {
+ public:
+  /// The largest number of registers that may be allocated without a check.
+  /// The guard region holds such a frame, plus the STACK_RESERVE registers
+  /// native functions use without checking, with plenty of room to spare.
+  static constexpr uint32_t kMaxUncheckedRegisters = 1024;
+
+  /// Allocate a stack of \p numRegisters registers after a guard region.
+  /// \p hit is set when the region is written to, and must outlive the guard.
+  /// \return the guard, or nullptr if guards aren't supported or too many of
+  ///   them exist, in which case the stack must always be checked.
+  static std::unique_ptr<RegisterStackGuard> create(
+      uint32_t numRegisters,
+      std::atomic<bool> &hit);
+
+  ~RegisterStackGuard();
+  RegisterStackGuard(const RegisterStackGuard &) = delete;
+  void operator=(const RegisterStackGuard &) = delete;
+
+  /// \return the lowest register of the stack, just above the guard region.
+  PinnedHermesValue *getRegisterStack() const {
+    return reinterpret_cast<PinnedHermesValue *>(base_ + guardSize_);
+  }
+
+  /// Make the guard region inaccessible again after it was hit, and clear the
+  /// flag. Nothing may be stored in the region anymore.
+  void rearm();
+
+ private:
+  RegisterStackGuard(
+      char *base,
+      size_t guardSize,
+      size_t stackSize,
+      std::atomic<bool> &hit)
+      : base_(base), guardSize_(guardSize), stackSize_(stackSize), hit_(hit) {}
+
+  /// The start of the guard region, followed by the stack.
+  char *const base_;
+  const size_t guardSize_;
+  const size_t stackSize_;
+  std::atomic<bool> &hit_;
+  /// Whether the guard is known to the fault handler.
+  bool registered_{false};
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_REGISTERSTACKGUARD_H
@@ -23,13 +23,18 @@
 #include "hermes/VM/IdentifierTable.h"
 #include "hermes/VM/InterpreterState.h"
 #include "hermes/VM/JIT/JIT.h"
+#include "hermes/VM/EvalCache.h"
+#include "hermes/VM/JSLib/LocalTimeCache.h"
 #include "hermes/VM/MockedEnvironment.h"
 #include "hermes/VM/PointerBase.h"
 #include "hermes/VM/Predefined.h"
 #include "hermes/VM/Profiler.h"
+#include "hermes/VM/Profiler/FunctionProfiler.h"
 #include "hermes/VM/PropertyCache.h"
 #include "hermes/VM/PropertyDescriptor.h"
+#include "hermes/VM/RegExpCache.h"
 #include "hermes/VM/RegExpMatch.h"
+#include "hermes/VM/RegisterStackGuard.h"
 #include "hermes/VM/RuntimeModule.h"
 #include "hermes/VM/StackFrame.h"
 #include "hermes/VM/SymbolRegistry.h"
@@ -39,6 +44,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <type_traits>
@@ -68,6 +74,8 @@ struct RuntimeCommonStorage;
 struct RuntimeOffsets;
 class ScopedNativeDepthTracker;
 class ScopedNativeCallFrame;
+class RuntimeResetPoint;
+class SamplingHeapProfiler;
 class SamplingProfiler;
 
 /// Number of stack words after the top of frame that we always ensure are
@@ -86,6 +94,16 @@ enum {
   MAdviseStringsSequential = 1 << 4,
   MAdviseStringsRandom = 1 << 5,
   MAdviseStringsWillNeed = 1 << 6,
+  /// Dispatch instructions through a direct-threaded copy of the bytecode,
+  /// see CodeBlock::getThreadedCode(). Only available with
+  /// HERMESVM_INDIRECT_THREADING.
+  ThreadedDispatch = 1 << 7,
+  /// Don't record the stack trace of an error thrown by the interpreter when
+  /// it is caught in the throwing frame or in its caller. Errors created by
+  /// the Error constructors then record their stack trace when they are
+  /// thrown instead of when they are created, so the stack of an error which
+  /// is never thrown, or which is caught that close, is empty.
+  SkipStackTraceForLocalCatch = 1 << 8,
 };
 /// Set of flags for active VM experiments.
 using VMExperimentFlags = uint32_t;
@@ -181,6 +199,28 @@ class Runtime : public HandleRootOwner,
       Handle<RequireContext> requireContext,
       RuntimeModuleFlags flags = {});
 
+  /// Returns the bytecode of the segment that defines the CJS module with the
+  /// given static ID, or null if there is no such segment.
+  using SegmentLoader =
+      std::function<std::shared_ptr<hbc::BCProvider>(uint32_t moduleID)>;
+
+  /// Set the \p loader that is asked for the segment of a statically resolved
+  /// CJS module the first time the module is required before its segment was
+  /// loaded.  The segment is registered with \p flags, in the Domain of the
+  /// code that required it.
+  void setSegmentLoader(SegmentLoader loader, RuntimeModuleFlags flags = {}) {
+    segmentLoader_ = std::move(loader);
+    segmentLoaderFlags_ = flags;
+  }
+
+  /// Ask the segment loader for the segment of the CJS module with ID \p
+  /// moduleID, and register it in \p domain.
+  /// \return false if there is no segment loader, or it has no segment for
+  /// \p moduleID.
+  CallResult<bool> loadSegmentForModule(
+      Handle<Domain> domain,
+      uint32_t moduleID);
+
   /// A convenience function to print an exception to a stream.
   void printException(llvm::raw_ostream &os, Handle<> valueHandle);
 
@@ -202,6 +242,11 @@ class Runtime : public HandleRootOwner,
   template <HasFinalizer hasFinalizer = HasFinalizer::No>
   void *allocLongLived(uint32_t size);
 
+ private:
+  /// Record an allocation of \p size bytes that the heap chose to sample.
+  void sampleHeapAllocation(uint32_t size);
+
+ public:
   /// Used as a placeholder for places where we should be checking for OOM
   /// but aren't yet.
   /// TODO: do something when there is an uncaught exception, e.g. print
@@ -222,6 +267,28 @@ class Runtime : public HandleRootOwner,
     heap_.collect();
   }
 
+  /// Do garbage collection work that can be divided, until \p deadline, so
+  /// that later collection pauses are shorter.  Meant to be called while the
+  /// embedder is idle.  \return true if there is more work to do.
+  bool collectIncrementally(std::chrono::steady_clock::time_point deadline) {
+    return heap_.collectIncrementally(deadline);
+  }
+
+  /// Return memory that the heap does not use to the OS, in response to
+  /// memory \p pressure reported by the embedder. The caches of compiled
+  /// code are dropped first, so that the memory they keep alive can be
+  /// released too; under critical pressure, so are the caches which only
+  /// save a little work, such as the compiled RegExps, the megamorphic
+  /// property cache and the identifiers of small indices.
+  void handleMemoryPressure(MemoryPressure pressure);
+
+  /// Run the jobs of the promise job queue, including the jobs that they
+  /// enqueue, until it is empty. Meant to be called by the embedder once the
+  /// current script or host callback has returned, when the JS stack is empty.
+  /// If a job throws, the remaining jobs stay in the queue and the exception
+  /// is returned.
+  ExecutionStatus drainJobs();
+
   /// Potentially move the heap if handle sanitization is on.
   void potentiallyMoveHeap();
 
@@ -287,6 +354,23 @@ class Runtime : public HandleRootOwner,
   /// 256 characters are pre-allocated. The rest are allocated every time.
   Handle<StringPrimitive> getCharacterString(char16_t ch);
 
+  /// The number of array indices, starting from 0, whose identifiers are
+  /// cached by getIndexSymbol().
+  static constexpr uint32_t kNumIndexSymbols = 1024;
+
+  /// \return the identifier of the decimal string of \p index. It is created
+  ///   the first time and cached, so that converting a small index, as a
+  ///   number or as a string, to a property name doesn't allocate a string or
+  ///   search the identifier table.
+  /// \pre index < kNumIndexSymbols.
+  CallResult<SymbolID> getIndexSymbol(uint32_t index) {
+    assert(index < kNumIndexSymbols && "index has no cached identifier");
+    SymbolID sym = indexSymbols_[index];
+    if (LLVM_LIKELY(sym.isValid()))
+      return sym;
+    return createIndexSymbol(index);
+  }
+
   CodeBlock *getEmptyCodeBlock() const {
     assert(emptyCodeBlock_ && "Invalid empty code block");
     return emptyCodeBlock_;
@@ -346,6 +430,29 @@ class Runtime : public HandleRootOwner,
   /// \return \c true if allocation was successful.
   inline bool checkAndAllocStack(uint32_t count, HermesValue initValue);
 
+  /// Check whether <tt>count + STACK_RESERVE</tt> stack registers are available
+  /// and allocate \p count registers initialized with undefined. Unlike
+  /// checkAndAllocStack(), small counts are handled inline, which makes it
+  /// suitable for allocating the registers of interpreted frames on every call.
+  /// \return \c true if allocation was successful.
+  inline bool checkAndAllocUndefinedStack(uint32_t count);
+
+  /// Allocate \p count registers initialized with undefined for the frame of
+  /// an interpreted function. Small frames aren't checked while the guard
+  /// region of the register stack is armed: overflowing into it makes the
+  /// next call check the stack.
+  /// \return \c true if allocation was successful.
+  inline bool allocFrameRegisters(uint32_t count);
+
+  /// Allocate \p count registers initialized with undefined, without checking
+  /// that they are available.
+  inline void allocUndefinedStack(uint32_t count);
+
+  /// The slow path of allocFrameRegisters(), which checks the stack, and
+  /// rearms its guard region once no frame is in it.
+  LLVM_ATTRIBUTE_NOINLINE
+  bool checkAndAllocFrameRegisters(uint32_t count);
+
   /// Pop the specified number of elements from the stack.
   inline void popStack(uint32_t count);
 
@@ -436,6 +543,27 @@ class Runtime : public HandleRootOwner,
   /// Returns trailing data for all runtime modules.
   std::vector<llvm::ArrayRef<uint8_t>> getEpilogues();
 
+  /// \return the cache shared by all megamorphic property access sites.
+  MegamorphicPropertyCache &getMegamorphicPropertyCache() {
+    return megamorphicPropCache_;
+  }
+
+  /// \return the cache of bytecode compiled from RegExp patterns.
+  RegExpCache &getRegExpCache() {
+    return regExpCache_;
+  }
+
+  /// \return the cache of the bytecode compiled by eval and the Function
+  /// constructor.
+  EvalCache &getEvalCache() {
+    return evalCache_;
+  }
+
+  /// \return the cache of the local time adjustments used by Date.
+  LocalTimeCache &getLocalTimeCache() {
+    return localTimeCache_;
+  }
+
   /// \return the set of runtime stats.
   instrumentation::RuntimeStats &getRuntimeStats() {
     return runtimeStats_;
@@ -444,6 +572,15 @@ class Runtime : public HandleRootOwner,
   /// Print the heap and other misc. stats to the given stream.
   void printHeapStats(llvm::raw_ostream &os);
 
+  /// Sum the property cache counters of every CodeBlock into the runtime
+  /// stats.
+  /// \return the updated totals.
+  const PropertyCacheStats &collectPropertyCacheStats();
+
+  /// Print the property cache counters of every CodeBlock which has executed
+  /// a cacheable property access to the given stream.
+  void dumpPropertyCacheStats(llvm::raw_ostream &os);
+
   /// Returns the common storage object.
   RuntimeCommonStorage *getCommonStorage() {
     return commonStorage_.get();
@@ -619,6 +756,17 @@ class Runtime : public HandleRootOwner,
   PinnedHermesValue weakMapPrototype;
   /// WeakSet.prototype
   PinnedHermesValue weakSetPrototype;
+  /// Promise.prototype
+  PinnedHermesValue promisePrototype;
+  /// %Promise%, the Promise constructor.
+  PinnedHermesValue promiseConstructor;
+  /// TextEncoder.prototype
+  PinnedHermesValue textEncoderPrototype;
+  /// TextDecoder.prototype
+  PinnedHermesValue textDecoderPrototype;
+  /// The promise job queue, ES6.0 8.4. Each job is a fixed number of values,
+  /// interpreted by JSLib/Promise.cpp.
+  std::deque<PinnedHermesValue> promiseJobQueue{};
   /// RegExp.prototype.
   PinnedHermesValue regExpPrototype;
   /// TypedArrayBase.
@@ -638,6 +786,14 @@ class Runtime : public HandleRootOwner,
   PinnedHermesValue arrayIteratorPrototype;
   /// ArrayProto_values, needs to be stored for making new Arguments objects.
   PinnedHermesValue arrayPrototypeValues;
+  /// Function.prototype.apply, which OpCode::CallApplyArguments recognizes.
+  PinnedHermesValue functionPrototypeApply;
+  /// The built-in next() methods of the iterators which
+  /// OpCode::IteratorNext advances without creating iterator result objects.
+  PinnedHermesValue arrayIteratorPrototypeNext;
+  PinnedHermesValue stringIteratorPrototypeNext;
+  PinnedHermesValue mapIteratorPrototypeNext;
+  PinnedHermesValue setIteratorPrototypeNext;
   /// StringIteratorPrototype
   PinnedHermesValue stringIteratorPrototype;
   /// GeneratorPrototype
@@ -673,6 +829,11 @@ class Runtime : public HandleRootOwner,
   /// Track time spent of each opcode in the interpreter, in CPU cycles.
   uint64_t timeSpent[256] = {0};
 
+  /// Track the frequency of each pair of consecutive opcodes in the
+  /// interpreter, indexed by the first and then the second opcode.  These are
+  /// the candidates for superinstructions.
+  uint32_t opcodePairFrequency[256][256] = {{0}};
+
   /// Dump opcode stats to a stream.
   void dumpOpcodeStats(llvm::raw_ostream &os) const;
 #endif
@@ -716,6 +877,87 @@ class Runtime : public HandleRootOwner,
   void dumpNativeCallStats(llvm::raw_ostream &OS);
 #endif
 
+  /// Record the state of the global object and of the objects it exposes,
+  /// typically once the runtime is initialized, so that resetToSavedPoint()
+  /// can bring it back, see RuntimeResetPoint. Replaces the state recorded
+  /// before.
+  void saveResetPoint();
+
+  /// Restore the state recorded by saveResetPoint(), so that the runtime can
+  /// be reused as if it had just been initialized.
+  /// \return EXCEPTION if it couldn't be fully restored, or if no state was
+  ///   recorded.
+  ExecutionStatus resetToSavedPoint();
+
+  /// Start recording the JS stack of an allocation once every \p
+  /// samplingInterval allocated bytes.  Restarts the profile if it is already
+  /// enabled.
+  void enableSamplingHeapProfiler(size_t samplingInterval);
+
+  /// Stop recording allocations, and write the profile recorded since it was
+  /// enabled to \p os, in the format of the Chrome DevTools.  Does nothing if
+  /// it is not enabled.
+  void disableSamplingHeapProfiler(llvm::raw_ostream &os);
+
+  /// Reset the invocation counts and samples of all the functions, and start
+  /// sampling the executing function once every \p interval, or only count
+  /// the invocations if \p interval is 0.  Restarts the profile if it is
+  /// already enabled.  The invocations are counted even when the profile is
+  /// not enabled.  If \p attributeTime, also measure the time spent in each
+  /// function, see FunctionTimeAttribution.
+  void enableFunctionProfiler(
+      std::chrono::microseconds interval,
+      bool attributeTime = false);
+
+  /// Stop sampling and attributing time.  The counters are kept, so that they
+  /// can still be dumped.
+  void disableFunctionProfiler();
+
+  /// \return the time attribution of the function profile, or null if time is
+  /// not being attributed.
+  FunctionTimeAttribution *getTimeAttribution() {
+    return timeAttribution_.get();
+  }
+
+  /// Write the invocation counts and samples of all the functions to \p os as
+  /// JSON.
+  void dumpFunctionProfile(llvm::raw_ostream &os);
+
+  /// Forget the code coverage recorded so far and start recording it. See
+  /// CodeCoverage.
+  void enableCodeCoverage();
+
+  /// Stop recording code coverage. What was recorded is kept, so that it can
+  /// still be dumped.
+  void disableCodeCoverage() {
+    codeCoverageEnabled_ = false;
+  }
+
+  /// \return true if code coverage is being recorded.
+  bool isCodeCoverageEnabled() const {
+    return codeCoverageEnabled_;
+  }
+
+  /// Write the basic blocks of all the functions, and whether they were
+  /// covered, to \p os as JSON.
+  void dumpCodeCoverage(llvm::raw_ostream &os);
+
+  /// Free the data derived from the bytecode of the functions that weren't
+  /// entered since the previous call, which they rebuild if they run again.
+  /// Functions with a frame on the stack, or handled by the JIT, are skipped.
+  /// \return the number of bytes freed.
+  size_t releaseIdleCodeBlockData();
+
+  /// \return true if a function profile tick is pending, in which case it is
+  /// cleared and the caller must charge it to the executing function. It may
+  /// only be called by the thread running the interpreter.
+  bool testAndClearFunctionProfileTick() {
+    if (LLVM_LIKELY(!functionProfileTick_.load(std::memory_order_relaxed)))
+      return false;
+    functionProfileTick_.store(false, std::memory_order_relaxed);
+    return true;
+  }
+
 #ifdef HERMES_ENABLE_DEBUGGER
   Debugger &getDebugger() {
     return debugger_;
@@ -730,6 +972,10 @@ class Runtime : public HandleRootOwner,
     return hasES6Symbol_;
   }
 
+  bool hasES6Promise() const {
+    return hasES6Promise_;
+  }
+
   bool builtinsAreFrozen() const {
     return builtinsFrozen_;
   }
@@ -746,6 +992,11 @@ class Runtime : public HandleRootOwner,
   /// exception.
   std::string getCallStackNoAlloc() override;
 
+  /// Charge the time of a collection to the function that triggered it, if
+  /// time is being attributed, and release the data of idle functions every
+  /// codeBlockIdleGCs_ collections.
+  void onGCCycle(bool start) override;
+
  protected:
   /// Construct a Runtime on the stack.
   /// NOTE: This should only be used by StackRuntime. All other uses should use
@@ -805,6 +1056,11 @@ class Runtime : public HandleRootOwner,
   /// 1) a function that returns the global object.
   static std::unique_ptr<Buffer> generateSpecialRuntimeBytecode();
 
+  /// \return the bytecode of generateSpecialRuntimeBytecode(), which is
+  /// generated and parsed once per process and then shared by the special code
+  /// block modules of all runtimes, since it is never modified.
+  static std::shared_ptr<hbc::BCProvider> getSpecialRuntimeBytecode();
+
   /// Insert the predefined strings into the IdentifierTable.
   /// NOTE: this function does not do any allocations in the GC heap, it is safe
   /// to use at any time in initialization.
@@ -846,6 +1102,10 @@ class Runtime : public HandleRootOwner,
   /// string for the passed character \p ch.
   Handle<StringPrimitive> allocateCharacterString(char16_t ch);
 
+  /// The slow path for \c getIndexSymbol(). Create the identifier of \p index
+  /// and cache it.
+  CallResult<SymbolID> createIndexSymbol(uint32_t index);
+
   /// Add a \c RuntimeModule \p rm to the runtime module list.
   void addRuntimeModule(RuntimeModule *rm) {
     runtimeModuleList_.push_back(*rm);
@@ -875,15 +1135,28 @@ class Runtime : public HandleRootOwner,
   /// Set to true if we should enable ES6 Symbol.
   const bool hasES6Symbol_;
 
+  /// Set to true if we should enable ES6 Promise.
+  const bool hasES6Promise_;
+
   /// Set to true if we should randomize stack placement etc.
   const bool shouldRandomizeMemoryLayout_;
 
   // Percentage in [0,100] of bytecode we should eagerly read into page cache.
   const uint8_t bytecodeWarmupPercent_;
 
+  // Pages of bytecode we should eagerly read into page cache, in order.
+  const std::vector<uint32_t> bytecodeWarmupPages_;
+
   // Signal-based I/O tracking. Slows down execution.
   const bool trackIO_;
 
+  /// Loads the segments of CJS modules that are required before they were
+  /// loaded, if set.
+  SegmentLoader segmentLoader_{};
+
+  /// The flags of the RuntimeModules created for the segmentLoader_.
+  RuntimeModuleFlags segmentLoaderFlags_{};
+
   /// This value can be passed to the runtime as flags to test experimental
   /// features. Each experimental feature decides how to interpret these
   /// values. Generally each experiment is associated with one or more bits of
@@ -892,6 +1165,13 @@ class Runtime : public HandleRootOwner,
   /// bit values, typically 1 as test and 0 as control.
   experiments::VMExperimentFlags vmExperimentFlags_{experiments::Default};
 
+  /// Number of collections between calls to releaseIdleCodeBlockData(), or 0
+  /// to never call it.
+  const unsigned codeBlockIdleGCs_;
+
+  /// Number of collections since the last releaseIdleCodeBlockData().
+  unsigned gcsSinceCodeBlockRelease_{0};
+
   friend class GCScope;
   friend class HandleBase;
   friend class Interpreter;
@@ -932,6 +1212,9 @@ class Runtime : public HandleRootOwner,
   /// Set of runtime statistics.
   instrumentation::RuntimeStats runtimeStats_;
 
+  /// Times the first collection, while it runs.
+  llvm::Optional<instrumentation::StartupTimer> firstGCTimer_;
+
   /// Shared location to place native objects required by JSLib
   std::shared_ptr<RuntimeCommonStorage> commonStorage_;
 
@@ -965,6 +1248,11 @@ class Runtime : public HandleRootOwner,
   /// When set to false, the register stack is not allocated
   /// by the runtime itself.
   bool freeRegisterStack_{true};
+  /// Set if the frames of interpreted functions must be checked against the
+  /// end of the register stack: if it has no guard, or its guard was hit.
+  std::atomic<bool> checkRegisterStack_{true};
+  /// The guard region of the register stack, which owns the stack, if any.
+  std::unique_ptr<RegisterStackGuard> registerStackGuard_;
   /// Manages data to be used in the case of a crash.
   std::shared_ptr<CrashManager> crashMgr_;
   /// Points to the last register in the callers frame. The current frame (the
@@ -1008,11 +1296,27 @@ class Runtime : public HandleRootOwner,
   /// Cache for property lookups in non-JS code.
   PropertyCacheEntry fixedPropCache_[(size_t)PropCacheID::_COUNT];
 
+  /// Cache shared by all megamorphic property access sites.
+  MegamorphicPropertyCache megamorphicPropCache_{};
+
+  /// Cache of bytecode compiled from RegExp patterns which are not literals.
+  RegExpCache regExpCache_{};
+
+  /// Cache of the bytecode compiled by eval and the Function constructor.
+  EvalCache evalCache_;
+
+  /// Cache of the local time adjustments used by Date.
+  LocalTimeCache localTimeCache_{};
+
   /// StringPrimitive representation of the first 256 characters.
   /// These are allocated as "long-lived" objects, so they don't need
   /// to be scanned as roots in young-gen collections.
   std::vector<PinnedHermesValue> charStrings_{};
 
+  /// Identifiers of the decimal strings of the first kNumIndexSymbols array
+  /// indices, or invalid if they haven't been needed yet.
+  SymbolID indexSymbols_[kNumIndexSymbols];
+
   /// Pointers to native implementations of builtins.
   std::vector<NativeFunction *> builtins_{};
 
@@ -1031,6 +1335,38 @@ class Runtime : public HandleRootOwner,
   /// we are sure it's safe to unregisterRuntime in destructor.
   std::shared_ptr<SamplingProfiler> samplingProfiler_;
 
+  /// Records sampled allocations while it is enabled.
+  std::unique_ptr<SamplingHeapProfiler> samplingHeapProfiler_;
+
+  /// The state recorded by saveResetPoint(), if any.
+  std::unique_ptr<RuntimeResetPoint> resetPoint_;
+
+  /// Set by the timer thread of functionProfiler_ once per sampling interval,
+  /// and cleared by the interpreter when it takes the sample.
+  std::atomic<bool> functionProfileTick_{false};
+
+  /// Owns the sampling timer of the function profile while it is enabled.
+  std::unique_ptr<FunctionProfiler> functionProfiler_;
+
+  /// The sampling interval of the last function profile, kept after it is
+  /// disabled so that the dump can report it.
+  std::chrono::microseconds functionProfileInterval_{0};
+
+  /// Attributes time to the functions while the function profile is enabled
+  /// with time attribution.
+  std::unique_ptr<FunctionTimeAttribution> timeAttribution_;
+
+  /// Whether the last function profile attributed time.
+  bool functionProfileAttributedTime_{false};
+
+  /// Whether the interpreter records code coverage.
+  bool codeCoverageEnabled_{false};
+
+  /// What time was charged to before the current collection.
+  FunctionTimeAttribution::State stateBeforeGC_{
+      nullptr,
+      FunctionTimeAttribution::Category::Interpreter};
+
 #ifdef HERMES_ENABLE_DEBUGGER
   Debugger debugger_{this};
 
@@ -1158,6 +1494,9 @@ class ScopedNativeCallFrame {
   /// The contents of the new frame.
   StackFramePtr frame_;
 
+  /// The number of arguments of the frame.
+  const uint32_t argCount_;
+
   /// Whether this call frame overflowed.
   bool overflowed_;
 
@@ -1188,7 +1527,9 @@ class ScopedNativeCallFrame {
       HermesValue callee,
       HermesValue newTarget,
       HermesValue thisArg)
-      : runtime_(runtime), savedSP_(runtime->getStackPointer()) {
+      : runtime_(runtime),
+        savedSP_(runtime->getStackPointer()),
+        argCount_(argCount) {
     runtime->nativeCallFrameDepth_++;
     uint32_t registersNeeded =
         StackFrameLayout::callerOutgoingRegisters(argCount);
@@ -1247,6 +1588,25 @@ class ScopedNativeCallFrame {
 #endif
   }
 
+  /// Prepare the frame for another call to \p callee, after a call through it
+  /// has returned, without allocating it again. The previous callee may have
+  /// modified the frame, so the arguments must be stored again too.
+  void reinitialize(
+      HermesValue callee,
+      HermesValue newTarget,
+      HermesValue thisArg) {
+    assert(!overflowed() && "ScopedNativeCallFrame overflowed");
+    frame_ = StackFramePtr::initFrame(
+        frame_.ptr(),
+        runtime_->currentFrame_,
+        nullptr,
+        nullptr,
+        argCount_,
+        callee,
+        newTarget);
+    frame_.getThisArgRef() = thisArg;
+  }
+
   /// Fill \p argCount arguments with the given value \p fillValue.
   void fillArguments(uint32_t argCount, HermesValue fillValue) {
     assert(!overflowed() && "ScopedNativeCallFrame overflowed");
@@ -1276,11 +1636,17 @@ inline void Runtime::addCustomRootsFunction(const F &markRootsFn) {
 
 template <bool fixedSize, HasFinalizer hasFinalizer>
 inline void *Runtime::alloc(uint32_t sz) {
+  if (LLVM_UNLIKELY(heap_.shouldSampleAllocation(sz))) {
+    sampleHeapAllocation(sz);
+  }
   return heap_.alloc<fixedSize, hasFinalizer>(sz);
 }
 
 template <HasFinalizer hasFinalizer>
 inline void *Runtime::allocLongLived(uint32_t size) {
+  if (LLVM_UNLIKELY(heap_.shouldSampleAllocation(size))) {
+    sampleHeapAllocation(size);
+  }
   return heap_.allocLongLived<hasFinalizer>(size);
 }
 
@@ -1364,13 +1730,18 @@ inline uint32_t Runtime::getStackLevel() const {
 }
 
 inline uint32_t Runtime::availableStackSize() const {
-  return (uint32_t)(stackPointer_ - registerStack_);
+  // The stack pointer is below the stack while a frame is in the guard region.
+  return stackPointer_ > registerStack_
+      ? (uint32_t)(stackPointer_ - registerStack_)
+      : 0;
 }
 
 inline bool Runtime::checkAvailableStack(uint32_t count) {
   // Note: use 64-bit arithmetic to avoid overflow. We could also do it with
-  // a couple of comparisons, but that is likely to be slower.
-  return availableStackSize() >= (uint64_t)count + STACK_RESERVE;
+  // a couple of comparisons, but that is likely to be slower. The difference
+  // is negative while a frame is in the guard region.
+  return (int64_t)(stackPointer_ - registerStack_) >=
+      (int64_t)count + STACK_RESERVE;
 }
 
 inline PinnedHermesValue *Runtime::allocUninitializedStack(uint32_t count) {
@@ -1385,6 +1756,45 @@ inline bool Runtime::checkAndAllocStack(uint32_t count, HermesValue initValue) {
   return true;
 }
 
+inline bool Runtime::checkAndAllocUndefinedStack(uint32_t count) {
+  if (!checkAvailableStack(count))
+    return false;
+  allocUndefinedStack(count);
+  return true;
+}
+
+inline bool Runtime::allocFrameRegisters(uint32_t count) {
+  if (LLVM_UNLIKELY(
+          count > RegisterStackGuard::kMaxUncheckedRegisters ||
+          checkRegisterStack_.load(std::memory_order_relaxed)))
+    return checkAndAllocFrameRegisters(count);
+  allocUndefinedStack(count);
+  return true;
+}
+
+inline void Runtime::allocUndefinedStack(uint32_t count) {
+  // Larger counts are initialized by allocStack().
+  constexpr uint32_t kMaxInlineCount = 32;
+  if (LLVM_UNLIKELY(count > kMaxInlineCount)) {
+    allocStack(count, HermesValue::encodeUndefinedValue());
+    return;
+  }
+  // Initialize the registers in groups of four, starting up to three registers
+  // below the new stack pointer: those are in the STACK_RESERVE and not in use,
+  // or in the guard region. Writing several registers per iteration also keeps
+  // the compiler from turning the loop into a call to memset_pattern16 (see
+  // allocStack()).
+  PinnedHermesValue *end = stackPointer_;
+  stackPointer_ -= count;
+  PinnedHermesValue *p = end - llvm::alignTo(count, 4);
+  for (; p != end; p += 4) {
+    p[0] = HermesValue::encodeUndefinedValue();
+    p[1] = HermesValue::encodeUndefinedValue();
+    p[2] = HermesValue::encodeUndefinedValue();
+    p[3] = HermesValue::encodeUndefinedValue();
+  }
+}
+
 inline void Runtime::popStack(uint32_t count) {
   assert(getStackLevel() >= count && "register stack underflow");
   stackPointer_ += count;
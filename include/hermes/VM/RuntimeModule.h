@@ -19,6 +19,7 @@
 namespace hermes {
 namespace vm {
 
+class ArrayStorage;
 class CodeBlock;
 class Runtime;
 
@@ -77,6 +78,21 @@ class RuntimeModule final : public llvm::ilist_node<RuntimeModule> {
   /// SymbolID.
   std::vector<SymbolID> stringIDMap_;
 
+  /// A run of consecutive identifiers in the string table, whose symbols are
+  /// only created on first use.
+  struct LazyIdentifierRun {
+    /// The string ID of the first identifier of the run.
+    StringID firstStringID;
+    /// The number of identifiers in the run.
+    uint32_t count;
+    /// The index of the translation of the first identifier, which is its
+    /// hash as precomputed by the compiler.
+    uint32_t firstTranslation;
+  };
+
+  /// The runs of lazily registered identifiers, ordered by string ID.
+  std::vector<LazyIdentifierRun> lazyIdentifierRuns_;
+
   /// Weak pointer to a GC-managed Domain that owns this RuntimeModule.
   /// NOTE: This will not be made invalid through marking, because the domain
   /// updates the WeakRefs on the RuntimeModule when it is marked.
@@ -110,8 +126,19 @@ class RuntimeModule final : public llvm::ilist_node<RuntimeModule> {
   /// Cacheing will be skipped if keyBufferIndex is >= 2^24.
   llvm::DenseMap<uint32_t, HiddenClass *> objectLiteralHiddenClasses_;
 
-  /// A map from template object ids to template objects.
-  llvm::DenseMap<uint32_t, JSObject *> templateMap_;
+  /// The template objects indexed by their id, which the compiler allocates
+  /// densely for every module, or null for those not created yet.
+  std::vector<JSObject *> templateObjects_;
+
+  /// A map from the module index of the requireFast() calls of this module
+  /// to the exports of the module, once its initialization completed.  It
+  /// saves the lookup through the Domain on every call.
+  llvm::DenseMap<uint32_t, HermesValue> requireFastExports_;
+
+  /// A map from getLiteralValuesKey() of the literal value buffers that were
+  /// instantiated more than once to their decoded values.  Buffers that were
+  /// instantiated once map to null.
+  llvm::DenseMap<uint64_t, ArrayStorage *> literalValues_;
 
   /// Registers the created RuntimeModule with \param domain, resulting in
   /// \param domain owning it. The RuntimeModule will be freed when the
@@ -203,13 +230,35 @@ class RuntimeModule final : public llvm::ilist_node<RuntimeModule> {
   /// the compiler would have marked the stringID as identifier, and hence
   /// we should have created the symbol during identifier table initialization.
   /// The symbol must already exist in the map. This is a fast path.
-  SymbolID getSymbolIDMustExist(StringID stringID) {
+  /// In a persistent module, whose identifiers are registered lazily, the
+  /// identifier must have been registered by getIdentifierSymbolID().
+  /// This never modifies the module, so the JIT may call it on a background
+  /// thread.
+  SymbolID getSymbolIDMustExist(StringID stringID) const {
     assert(
         stringIDMap_[stringID].isValid() &&
         "Symbol must exist for this string ID");
     return stringIDMap_[stringID];
   }
 
+  /// \return the \c SymbolID for \p stringID, which an opcode uses explicitly
+  /// as an identifier. Like getSymbolIDMustExist(), except that the
+  /// identifiers of a persistent module are registered here on first use.
+  /// That never allocates in the GC heap, so it is safe in the interpreter's
+  /// no-allocation regions. It modifies this module and the IdentifierTable,
+  /// so it must only be called on the thread running JavaScript.
+  SymbolID getIdentifierSymbolID(StringID stringID) {
+    SymbolID id = stringIDMap_[stringID];
+    if (LLVM_UNLIKELY(!id.isValid())) {
+      assert(
+          flags_.persistent &&
+          "Symbol must exist for this string ID in a non-persistent module");
+      id = createLazySymbolFromStringIDMayAllocate(stringID);
+    }
+    assert(id.isValid() && "Symbol must exist for this string ID");
+    return id;
+  }
+
   /// \return the \c SymbolID for a string by string index. The symbol may not
   /// already exist for this given string ID. Hence we may need to create it
   /// on the fly.
@@ -217,8 +266,7 @@ class RuntimeModule final : public llvm::ilist_node<RuntimeModule> {
     SymbolID id = stringIDMap_[stringID];
     if (LLVM_UNLIKELY(!id.isValid())) {
       // Materialize this lazily created symbol.
-      auto entry = bcProvider_->getStringTableEntry(stringID);
-      id = createSymbolFromStringIDMayAllocate(stringID, entry, llvm::None);
+      id = createLazySymbolFromStringIDMayAllocate(stringID);
     }
     assert(id.isValid() && "Failed to create symbol for stringID");
     return id;
@@ -242,7 +290,10 @@ class RuntimeModule final : public llvm::ilist_node<RuntimeModule> {
     return functionMap_.size();
   }
 
-  /// \return the CodeBlock for a function by function index.
+  /// \return the CodeBlock for a function by function index, or nullptr if
+  /// the function lies outside of the bytecode. That is only checked when a
+  /// function is first used, so callers which are about to run it report the
+  /// error with raiseMalformedFunction().
   inline CodeBlock *getCodeBlockMayAllocate(unsigned index) {
     if (LLVM_LIKELY(functionMap_[index])) {
       return functionMap_[index];
@@ -250,6 +301,10 @@ class RuntimeModule final : public llvm::ilist_node<RuntimeModule> {
     return getCodeBlockSlowPath(index);
   }
 
+  /// Raise a SyntaxError for the function with \p index, which lies outside
+  /// of the bytecode. \return ExecutionStatus::EXCEPTION.
+  ExecutionStatus raiseMalformedFunction(unsigned index);
+
   /// \return whether this RuntimeModule has been initialized.
   bool isInitialized() const {
     return !bcProvider_->isLazy();
@@ -315,6 +370,12 @@ class RuntimeModule final : public llvm::ilist_node<RuntimeModule> {
   /// Mark the weak reference to the Domain which owns this RuntimeModule.
   void markDomainRef(GC *gc);
 
+  /// Drop the entries of the hidden class cache for object literals whose
+  /// class was collected, and, if \p all, the decoded literal buffers and the
+  /// cached exports of requireFast(), which are only kept to make later uses
+  /// faster.
+  void trimCaches(bool all);
+
   /// \return an estimate of the size of additional memory used by this
   /// RuntimeModule.
   size_t additionalMemorySize() const;
@@ -337,7 +398,9 @@ class RuntimeModule final : public llvm::ilist_node<RuntimeModule> {
   /// Given \p templateObjectID, retrieve the cached template object.
   /// if it doesn't exist, return a nullptr.
   JSObject *findCachedTemplateObject(uint32_t templateObjID) {
-    return templateMap_.lookup(templateObjID);
+    return templateObjID < templateObjects_.size()
+        ? templateObjects_[templateObjID]
+        : nullptr;
   }
 
   /// Cache a template object in the template map using a template object ID as
@@ -349,9 +412,55 @@ class RuntimeModule final : public llvm::ilist_node<RuntimeModule> {
       uint32_t templateObjID,
       Handle<JSObject> templateObj) {
     assert(
-        templateMap_.count(templateObjID) == 0 &&
+        !findCachedTemplateObject(templateObjID) &&
         "The template object already exists.");
-    templateMap_[templateObjID] = templateObj.get();
+    if (templateObjID >= templateObjects_.size())
+      templateObjects_.resize(templateObjID + 1, nullptr);
+    templateObjects_[templateObjID] = templateObj.get();
+  }
+
+  /// \return the exports of the module with index \p moduleIndex in the
+  /// Domain, if they were cached by cacheRequireFastExports(), or empty.
+  HermesValue findCachedRequireFastExports(uint32_t moduleIndex) const {
+    auto it = requireFastExports_.find(moduleIndex);
+    return it != requireFastExports_.end() ? it->second
+                                           : HermesValue::encodeEmptyValue();
+  }
+
+  /// Cache \p exports as the exports of the module with index
+  /// \p moduleIndex, which must have completed its initialization.
+  void cacheRequireFastExports(uint32_t moduleIndex, HermesValue exports) {
+    requireFastExports_.insert({moduleIndex, exports});
+  }
+
+  /// \return the key of the literal values of NewArrayWithBuffer if
+  /// \p isArray, and of NewObjectWithBuffer otherwise, which have
+  /// \p numLiterals values at \p bufferIndex in their buffer.
+  static uint64_t getLiteralValuesKey(
+      bool isArray,
+      uint32_t bufferIndex,
+      uint32_t numLiterals) {
+    return ((uint64_t)bufferIndex << 32) | ((uint64_t)numLiterals << 1) |
+        isArray;
+  }
+
+  /// \return the decoded values cached for the literal buffer with \p key, or
+  /// null if there are none.  In that case, set \p shouldCache when the buffer
+  /// was instantiated before, and record that it is instantiated otherwise.
+  ArrayStorage *findCachedLiteralValues(uint64_t key, bool &shouldCache) {
+    auto it = literalValues_.find(key);
+    if (it == literalValues_.end()) {
+      literalValues_[key] = nullptr;
+      shouldCache = false;
+      return nullptr;
+    }
+    shouldCache = !it->second;
+    return it->second;
+  }
+
+  /// Cache \p values as the decoded values of the literal buffer with \p key.
+  void cacheLiteralValues(uint64_t key, ArrayStorage *values) {
+    literalValues_[key] = values;
   }
 
  private:
@@ -394,6 +503,11 @@ class RuntimeModule final : public llvm::ilist_node<RuntimeModule> {
       const StringTableEntry &entry,
       OptValue<uint32_t> mhash);
 
+  /// Create the symbol of \p stringID, which has not been mapped yet. If it
+  /// is a lazily registered identifier, use the hash precomputed by the
+  /// compiler. \return the created symbol ID.
+  SymbolID createLazySymbolFromStringIDMayAllocate(StringID stringID);
+
   /// \return a unqiue hash key for object literal hidden class cache.
   /// \param keyBufferIndex value of NewObjectWithBuffer instruction(must be
   /// less than 2^24).
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_VM_RUNTIMERESETPOINT_H
+#define HERMES_VM_RUNTIMERESETPOINT_H
+
+#include "hermes/VM/CallResult.h"
+#include "hermes/VM/Handle.h"
+#include "hermes/VM/HermesValue.h"
+#include "hermes/VM/PropertyDescriptor.h"
+#include "hermes/VM/SymbolID.h"
+
+#include <vector>
+
+namespace hermes {
+namespace vm {
+
+class JSObject;
+class Runtime;
+struct SlotAcceptorWithNames;
+
+/// The state of the global object and of the objects it directly exposes,
+/// recorded once a runtime is initialized, so that the runtime can be reset
+/// to it and reused instead of creating and initializing a new runtime for
+/// every request of a server. The loaded RuntimeModules, their compiled code
+/// and the heap are kept.
+///
+/// The recorded objects are the global object, the objects stored in its
+/// own properties (such as Array and Math) and their own "prototype" objects
+/// (such as Array.prototype). Restoring one puts back its own named
+/// properties with their flags and values, its parent and its extensibility;
+/// the properties added since are deleted, even if they are not configurable.
+/// The state of other objects, such as the variables captured by closures,
+/// the elements of arrays and the objects reachable only through recorded
+/// properties, is not restored.
+class RuntimeResetPoint {
+ public:
+  /// Record the current state of \p runtime, replacing what was recorded
+  /// before. This may allocate, so the reset point must already be marked by
+  /// the runtime.
+  void save(Runtime *runtime);
+
+  /// Restore the recorded objects, clear the pending promise jobs, the thrown
+  /// value and the last RegExp match.
+  /// \return EXCEPTION if restoring the parent of an object would create a
+  ///   prototype cycle through an object which is not recorded.
+  ExecutionStatus restore(Runtime *runtime);
+
+  /// Mark the recorded objects and values as roots.
+  void markRoots(SlotAcceptorWithNames &acceptor);
+
+  /// \return the number of recorded objects.
+  size_t getNumObjects() const {
+    return objects_.size();
+  }
+
+ private:
+  struct SavedProperty {
+    SymbolID name;
+    PropertyFlags flags;
+    HermesValue value;
+  };
+
+  struct SavedObject {
+    SavedObject(
+        HermesValue object,
+        HermesValue parent,
+        bool noExtend,
+        bool sealed,
+        bool frozen)
+        : object(object),
+          parent(parent),
+          noExtend(noExtend),
+          sealed(sealed),
+          frozen(frozen) {}
+
+    /// The object, as an object value so that it is updated by the GC.
+    HermesValue object;
+    /// The parent, or null.
+    HermesValue parent;
+    bool noExtend;
+    bool sealed;
+    bool frozen;
+    std::vector<SavedProperty> properties;
+  };
+
+  /// Record the own named properties, parent and flags of \p obj, unless it
+  /// is already recorded or it is a host object. Lazy objects are initialized
+  /// first.
+  void addObject(Runtime *runtime, Handle<JSObject> obj);
+
+  /// Restore the own named properties and the flags of \p saved, but not its
+  /// parent.
+  ExecutionStatus restoreProperties(Runtime *runtime, SavedObject &saved);
+
+  std::vector<SavedObject> objects_{};
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_RUNTIMERESETPOINT_H
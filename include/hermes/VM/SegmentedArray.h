@@ -240,6 +240,16 @@ class SegmentedArray final
     }
   }
 
+  /// \return the number of elements stored contiguously from the one at
+  ///   \p index to the end of the inline storage or of its segment, so that
+  ///   they can be accessed through &at(index). Some of them may be past the
+  ///   size.
+  static size_type contiguousLengthAt(TotalIndex index) {
+    if (index < kValueToSegmentThreshold)
+      return kValueToSegmentThreshold - index;
+    return Segment::kMaxLength - toInterior(index);
+  }
+
   /// Gets the size of the SegmentedArray. The size is the number of elements
   /// currently active in the array.
   size_type size() const {
@@ -30,11 +30,17 @@ class StorageProvider {
   /// \param minAmount Minimum number of bytes that must be in the reserve pool.
   /// \param excess An excess amount of bytes that should be allowed to be
   ///   allocated.
+  /// \param hugePages Whether to ask the OS to back the pool with transparent
+  ///   huge pages, so that the heap needs fewer TLB entries. This is only a
+  ///   hint, see hugePageBytes().
   /// \pre excess <= AlignedStorage::size().
   /// \post The returned StorageProvider will be able to allocate at most 1
   ///   extra storage for the excess amount specified.
-  static llvm::ErrorOr<std::unique_ptr<StorageProvider>>
-  preAllocatedProvider(size_t amount, size_t minAmount, size_t excess);
+  static llvm::ErrorOr<std::unique_ptr<StorageProvider>> preAllocatedProvider(
+      size_t amount,
+      size_t minAmount,
+      size_t excess,
+      bool hugePages = false);
 
   /// Provide storage from mmap'ed separate regions.
   static std::unique_ptr<StorageProvider> mmapProvider();
@@ -57,6 +63,12 @@ class StorageProvider {
   /// \post Nothing in the range [storage, storage + AlignedStorage::size())
   ///   is valid memory to be read or written.
   virtual void deleteStorage(void *storage) = 0;
+
+  /// \return the number of bytes of the storage this provider manages that
+  ///   the OS agreed to back with huge pages.
+  virtual size_t hugePageBytes() const {
+    return 0;
+  }
 };
 
 /// Attempts to allocate \p sz memory, aligned at \p alignment.
@@ -8,6 +8,7 @@
 #define HERMES_VM_STRINGBUILDER_H
 
 #include "hermes/ADT/SafeInt.h"
+#include "hermes/Support/UTF8.h"
 #include "hermes/VM/Casting.h"
 #include "hermes/VM/Runtime.h"
 #include "hermes/VM/StringPrimitive.h"
@@ -96,6 +97,31 @@ class StringBuilder {
     index_ += ascii.size();
   }
 
+  /// Append \p str, whose characters must all be ASCII. Unlike
+  /// appendUTF16Ref(), this never turns an ASCII builder into a UTF16 one, and
+  /// never allocates, so \p str may point to GC-managed memory.
+  void appendASCIIChars(UTF16Ref str) {
+    assert(
+        index_ + str.size() <= strPrim_->getStringLength() &&
+        "StringBuilder append out of bound");
+    assert(isAllASCII(str.begin(), str.end()) && "characters must be ASCII");
+    if (LLVM_LIKELY(strPrim_->isASCII())) {
+      std::copy(
+          str.begin(),
+          str.end(),
+          strPrim_->castToASCIIPointerForWrite() + index_);
+    } else {
+      std::copy(
+          str.begin(),
+          str.end(),
+          strPrim_->castToUTF16PointerForWrite() + index_);
+    }
+    index_ += str.size();
+  }
+  void appendASCIIChars(ASCIIRef str) {
+    appendASCIIRef(str);
+  }
+
   /// Append a char16_t character \p ch.
   void appendCharacter(char16_t ch) {
     assert(
@@ -116,13 +142,30 @@ class StringBuilder {
 
   /// Append the first \p length characters from StringPrimitive \p other.
   void appendStringPrim(Handle<StringPrimitive> other, uint32_t length) {
+    appendSubstring(other, 0, length);
+  }
+
+  /// Append all characters from StringPrimitive \p other.
+  void appendStringPrim(Handle<StringPrimitive> other) {
+    return appendStringPrim(other, other->getStringLength());
+  }
+
+  /// Append the \p length characters of StringPrimitive \p other starting at
+  /// index \p start.
+  void appendSubstring(
+      Handle<StringPrimitive> other,
+      uint32_t start,
+      uint32_t length) {
     assert(
         index_ + length <= strPrim_->getStringLength() &&
         "StringBuilder append out of bound");
+    assert(
+        start + length <= other->getStringLength() &&
+        "substring out of bound");
     if (other->isASCII()) {
-      appendASCIIRef({other->castToASCIIPointer(), length});
+      appendASCIIRef({other->castToASCIIPointer() + start, length});
     } else if (!strPrim_->isASCII()) {
-      appendUTF16Ref({other->castToUTF16Pointer(), length});
+      appendUTF16Ref({other->castToUTF16Pointer() + start, length});
     } else {
       // strPrim_ is ASCII, while other is UTF16. We have to recreate string.
       auto strRes = runtime_->ignoreAllocationFailure(StringPrimitive::create(
@@ -134,15 +177,10 @@ class StringBuilder {
       index_ = 0;
       // Append original string and other.
       appendASCIIRef(currentPartialString);
-      appendUTF16Ref({other->castToUTF16Pointer(), length});
+      appendUTF16Ref({other->castToUTF16Pointer() + start, length});
     }
   }
 
-  /// Append all characters from StringPrimitive \p other.
-  void appendStringPrim(Handle<StringPrimitive> other) {
-    return appendStringPrim(other, other->getStringLength());
-  }
-
   /// After appending finished, return the StringPrimitive.
   Handle<StringPrimitive> getStringPrimitive() const {
     assert(
@@ -16,6 +16,7 @@
 
 #include "llvm/Support/TrailingObjects.h"
 
+#include <memory>
 #include <type_traits>
 
 namespace hermes {
@@ -107,6 +108,15 @@ class StringPrimitive : public VariableSizeRuntimeCell {
   // too small, because the std::string itself imposes a space overhead.
   static constexpr uint32_t EXTERNAL_STRING_MIN_SIZE = 128;
 
+  // Slices of at least this length share the characters of strings whose
+  // characters are outside the JS heap, instead of copying them. Copying
+  // shorter slices takes about as much memory as sharing them.
+  static constexpr uint32_t SHARED_SLICE_MIN_SIZE = 32;
+
+  // Slices don't share characters with strings that are more than this many
+  // times longer, so that short slices don't keep much larger strings alive.
+  static constexpr uint32_t SHARED_SLICE_MAX_RATIO = 256;
+
   static bool classof(const GCCell *cell) {
     return kindInRange(
         cell->getKind(),
@@ -191,17 +201,33 @@ class StringPrimitive : public VariableSizeRuntimeCell {
       uint32_t length,
       const StringPrimitive *other) const;
 
+  /// \return the index of the first occurrence of \p other in this string
+  /// that starts at or after \p start, or -1 if there is none.
+  int64_t indexOf(const StringPrimitive *other, uint32_t start) const;
+
+  /// \return the index of the last occurrence of \p other in this string
+  /// that starts at or before \p start, or -1 if there is none.
+  int64_t lastIndexOf(const StringPrimitive *other, uint32_t start) const;
+
   /// \return true if the other string is identical to this one.
   bool equals(const StringPrimitive *other) const;
 
   /// \return true if the other string view has identical content as self.
   bool equals(const StringView &other) const;
 
+  /// \return the hash of the characters of this string, hermes::hashString(),
+  /// which is equal for strings with equal characters, whether they are ASCII
+  /// or UTF-16. Uniqued and external strings cache it, since they have room
+  /// for it; other strings compute it each time.
+  uint32_t getHash() const;
+
   /// Lexicographically compare the two strings.
   /// \return -1 if `this` is smaller, 0 if equal, +1 if `this` is greater.
   int compare(const StringPrimitive *other) const;
 
   /// Concatenate two StringPrimitives at \p xHandle and \p yHandle.
+  /// Long results are buffered strings, which makes repeatedly appending to
+  /// a string take amortized linear time. See BufferedStringPrimitive.
   /// \return pointer to a new StringPrimitive, representing the concatenation.
   static CallResult<HermesValue> concat(
       Runtime *runtime,
@@ -209,6 +235,8 @@ class StringPrimitive : public VariableSizeRuntimeCell {
       Handle<StringPrimitive> yHandle);
 
   /// Slice the StringPrimitive at \p str, \p length characters at \p start.
+  /// Long enough slices of strings whose characters are outside the JS heap
+  /// share them. See SHARED_SLICE_MIN_SIZE and SHARED_SLICE_MAX_RATIO.
   /// \return new StringPrimitive, representing the sliced string.
   static CallResult<HermesValue> slice(
       Runtime *runtime,
@@ -253,6 +281,12 @@ class StringPrimitive : public VariableSizeRuntimeCell {
   /// Whether this is an external string.
   inline bool isExternal() const;
 
+  /// Whether this is a buffered string.
+  inline bool isBuffered() const;
+
+  /// Whether this is a sliced string.
+  inline bool isSliced() const;
+
   /// Get a StringRef of T. T must be char or char16_t corresponding to whether
   /// this string is ASCII or UTF-16.
   template <typename T>
@@ -268,6 +302,11 @@ class StringPrimitive : public VariableSizeRuntimeCell {
   /// only be called in rare cases carefully.
   void copyUTF16String(char16_t *ptr) const;
 
+  /// Shared implementation of indexOf (\p reverse is false) and lastIndexOf
+  /// (\p reverse is true).
+  int64_t find(const StringPrimitive *other, uint32_t start, bool reverse)
+      const;
+
   /// Get a read-only raw char pointer, assert that this is ASCII string.
   const char *castToASCIIPointer() const;
 
@@ -298,6 +337,16 @@ class StringPrimitive : public VariableSizeRuntimeCell {
     return castToASCIIRef(0, getStringLength());
   }
 
+  /// Slice \p length characters at \p start of \p str, sharing its
+  /// characters if they are outside the JS heap and shouldShareSlice() allows
+  /// it.
+  /// \return the slice, or an empty HermesValue if it should be copied.
+  static HermesValue sliceShared(
+      Runtime *runtime,
+      Handle<StringPrimitive> str,
+      uint32_t start,
+      uint32_t length);
+
   /// In cases when we know the String cannot be a rope (e.g. as Identifier),
   /// it is safe to call this function which guarantees to not trigger gc.
   static StringView createStringViewMustBeFlat(Handle<StringPrimitive> self);
@@ -310,6 +359,14 @@ class StringPrimitive : public VariableSizeRuntimeCell {
   /// \return the unique id.
   /// This requires and asserts that the string is uniqued.
   SymbolID getUniqueID() const;
+
+  /// \return whether a slice of \p length characters should share the
+  /// characters of a string, which would keep \p retainedLength characters
+  /// alive.
+  static bool shouldShareSlice(uint32_t length, size_t retainedLength) {
+    return length >= SHARED_SLICE_MIN_SIZE &&
+        retainedLength / SHARED_SLICE_MAX_RATIO <= length;
+  }
 };
 
 /// A subclass of StringPrimitive which stores a SymbolID.
@@ -317,8 +374,14 @@ class StringPrimitive : public VariableSizeRuntimeCell {
 /// All ExternalStringPrimitives store a Symbol, but only those marked as
 /// uniqued will use it.
 class SymbolStringPrimitive : public StringPrimitive {
+  friend class StringPrimitive;
+
   SymbolID uniqueID_{};
 
+  /// The hash of the characters, or 0 if it hasn't been computed yet. It fills
+  /// the padding after uniqueID_, so it doesn't make the string larger.
+  mutable uint32_t hash_{0};
+
   friend void symbolStringPrimitiveBuildMeta(
       const GCCell *cell,
       Metadata::Builder &mb);
@@ -571,6 +634,208 @@ class ExternalStringPrimitive final : public SymbolStringPrimitive {
   StdString contents_{};
 };
 
+/// An immutable JavaScript primitive string made by concatenation, which is
+/// never uniqued. Its characters are part of a concatenation buffer outside
+/// the JS heap, which is shared with the strings it was concatenated or
+/// sliced from and to. When the left side of a concatenation is a buffered
+/// string which ends its buffer, the right side is appended to the buffer in
+/// place, instead of copying both into a new string.
+/// Note: like ExternalStringPrimitive, this is fixed-size in the metadata.
+template <typename T>
+class BufferedStringPrimitive final : public StringPrimitive {
+  friend class StringPrimitive;
+  friend void BufferedASCIIStringPrimitiveBuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+  friend void BufferedUTF16StringPrimitiveBuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+
+  using Ref = llvm::ArrayRef<T>;
+  using StdString = std::basic_string<T>;
+
+  /// \return the cell kind for this string.
+  static constexpr CellKind getCellKind() {
+    return std::is_same<T, char16_t>::value
+        ? CellKind::BufferedUTF16StringPrimitiveKind
+        : CellKind::BufferedASCIIStringPrimitiveKind;
+  }
+
+ public:
+  static bool classof(const GCCell *cell) {
+    return cell->getKind() == BufferedStringPrimitive::getCellKind();
+  }
+
+ private:
+  static const VTable vt;
+
+  /// Construct a string of the \p length characters of \p buffer at
+  /// \p offset, which is charged \p externalBytes of its bytes. A slice
+  /// keeps \p owner alive, which is charged for the buffer instead.
+  BufferedStringPrimitive(
+      Runtime *runtime,
+      std::shared_ptr<StdString> buffer,
+      uint32_t offset,
+      uint32_t length,
+      uint32_t externalBytes,
+      BufferedStringPrimitive<T> *owner)
+      : StringPrimitive(
+            runtime,
+            &vt,
+            sizeof(BufferedStringPrimitive<T>),
+            length,
+            false /* not uniqued */),
+        buffer_(std::move(buffer)),
+        owner_(runtime, owner, &runtime->getHeap()),
+        offset_(offset),
+        externalBytes_(externalBytes) {
+    assert(
+        (size_t)offset + length <= buffer_->size() &&
+        "buffer is shorter than the string");
+  }
+
+  /// Allocate a string with the arguments of the constructor, and charge
+  /// \p externalBytes to it.
+  static HermesValue create(
+      Runtime *runtime,
+      std::shared_ptr<StdString> buffer,
+      uint32_t offset,
+      uint32_t length,
+      uint32_t externalBytes,
+      Handle<StringPrimitive> owner);
+
+  ~BufferedStringPrimitive() = default;
+
+  /// Concatenate \p xHandle and \p yHandle, of total length \p xyLen, whose
+  /// characters must fit in T. Append to the buffer of \p xHandle if it is a
+  /// BufferedStringPrimitive<T> which ends its buffer, and otherwise copy
+  /// both into a new buffer.
+  static CallResult<HermesValue> concat(
+      Runtime *runtime,
+      Handle<StringPrimitive> xHandle,
+      Handle<StringPrimitive> yHandle,
+      uint32_t xyLen);
+
+  /// Slice \p length characters at \p start of \p str, which must be a
+  /// BufferedStringPrimitive<T>, sharing its buffer if
+  /// StringPrimitive::shouldShareSlice() allows it. The slice isn't charged
+  /// for the buffer, but keeps \p str, or the owner of \p str if it is itself
+  /// a slice, alive, so the buffer stays charged once however many slices
+  /// share it.
+  /// \return the slice, or an empty HermesValue if it should be copied.
+  static HermesValue sliceShared(
+      Runtime *runtime,
+      Handle<StringPrimitive> str,
+      uint32_t start,
+      uint32_t length);
+
+  const T *getRawPointer() const {
+    return buffer_->data() + offset_;
+  }
+
+  Ref getStringRef() const {
+    return Ref(getRawPointer(), getStringLength());
+  }
+
+  // Finalizer to release the buffer.
+  static void _finalizeImpl(GCCell *cell, GC *gc);
+
+  /// \return the external memory charged to \p cell, which is assumed to be
+  /// a BufferedStringPrimitive.
+  static size_t _mallocSizeImpl(GCCell *cell);
+
+  /// The concatenation buffer. Characters outside of the ones at offset_
+  /// belong to other strings which share it.
+  std::shared_ptr<StdString> buffer_;
+
+  /// If this is a slice, the string it was sliced from, which is charged for
+  /// the buffer. Null otherwise.
+  GCPointer<BufferedStringPrimitive<T>> owner_;
+
+  /// The offset of the characters of this string in buffer_.
+  uint32_t const offset_;
+
+  /// The bytes of buffer_ charged to this string as external memory: all of
+  /// them if it created the buffer, the ones it appended if it appended to
+  /// it, and none if it is a slice.
+  uint32_t const externalBytes_;
+};
+
+/// An immutable JavaScript primitive string which is a slice of an
+/// ExternalStringPrimitive, sharing its characters instead of copying them.
+/// It keeps the parent string alive, and since the characters of an external
+/// string are outside the JS heap, they don't move when the GC moves it.
+/// The slice isn't charged any external memory: the parent stays alive and
+/// charged for its characters, once however many slices share them.
+/// It is never uniqued.
+template <typename T>
+class SlicedStringPrimitive final : public StringPrimitive {
+  friend class StringPrimitive;
+  friend void SlicedASCIIStringPrimitiveBuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+  friend void SlicedUTF16StringPrimitiveBuildMeta(
+      const GCCell *cell,
+      Metadata::Builder &mb);
+
+  using Ref = llvm::ArrayRef<T>;
+
+  /// \return the cell kind for this string.
+  static constexpr CellKind getCellKind() {
+    return std::is_same<T, char16_t>::value
+        ? CellKind::SlicedUTF16StringPrimitiveKind
+        : CellKind::SlicedASCIIStringPrimitiveKind;
+  }
+
+ public:
+  static bool classof(const GCCell *cell) {
+    return cell->getKind() == SlicedStringPrimitive::getCellKind();
+  }
+
+ private:
+  static const VTable vt;
+
+  /// Construct a string of the \p length characters at \p chars, which are
+  /// part of \p parent.
+  SlicedStringPrimitive(
+      Runtime *runtime,
+      ExternalStringPrimitive<T> *parent,
+      const T *chars,
+      uint32_t length)
+      : StringPrimitive(
+            runtime,
+            &vt,
+            sizeof(SlicedStringPrimitive<T>),
+            length,
+            false /* not uniqued */),
+        parent_(runtime, parent, &runtime->getHeap()),
+        chars_(chars) {}
+
+  /// Slice \p length characters at \p start of \p str, which must be an
+  /// ExternalStringPrimitive<T> or a SlicedStringPrimitive<T>, sharing its
+  /// characters if StringPrimitive::shouldShareSlice() allows it.
+  /// \return the slice, or an empty HermesValue if it should be copied.
+  static HermesValue sliceShared(
+      Runtime *runtime,
+      Handle<StringPrimitive> str,
+      uint32_t start,
+      uint32_t length);
+
+  const T *getRawPointer() const {
+    return chars_;
+  }
+
+  Ref getStringRef() const {
+    return Ref(getRawPointer(), getStringLength());
+  }
+
+  /// The string whose characters this is a slice of.
+  GCPointer<ExternalStringPrimitive<T>> parent_;
+
+  /// The first character of this string, which is in parent_.
+  const T *chars_;
+};
+
 template <typename T, bool Uniqued>
 const VTable DynamicStringPrimitive<T, Uniqued>::vt = VTable(
     DynamicStringPrimitive<T, Uniqued>::getCellKind(),
@@ -598,6 +863,25 @@ const VTable ExternalStringPrimitive<T>::vt = VTable(
 using ExternalUTF16StringPrimitive = ExternalStringPrimitive<char16_t>;
 using ExternalASCIIStringPrimitive = ExternalStringPrimitive<char>;
 
+template <typename T>
+const VTable BufferedStringPrimitive<T>::vt = VTable(
+    BufferedStringPrimitive<T>::getCellKind(),
+    sizeof(BufferedStringPrimitive<T>),
+    BufferedStringPrimitive<T>::_finalizeImpl,
+    nullptr, // markWeak.
+    BufferedStringPrimitive<T>::_mallocSizeImpl);
+
+using BufferedUTF16StringPrimitive = BufferedStringPrimitive<char16_t>;
+using BufferedASCIIStringPrimitive = BufferedStringPrimitive<char>;
+
+template <typename T>
+const VTable SlicedStringPrimitive<T>::vt = VTable(
+    SlicedStringPrimitive<T>::getCellKind(),
+    sizeof(SlicedStringPrimitive<T>));
+
+using SlicedUTF16StringPrimitive = SlicedStringPrimitive<char16_t>;
+using SlicedASCIIStringPrimitive = SlicedStringPrimitive<char>;
+
 //===----------------------------------------------------------------------===//
 // StringPrimitive inline methods.
 
@@ -708,6 +992,10 @@ inline CallResult<HermesValue> StringPrimitive::createLongLived(
 inline const char *StringPrimitive::castToASCIIPointer() const {
   if (LLVM_UNLIKELY(isExternal())) {
     return vmcast<ExternalASCIIStringPrimitive>(this)->getRawPointer();
+  } else if (LLVM_UNLIKELY(isBuffered())) {
+    return vmcast<BufferedASCIIStringPrimitive>(this)->getRawPointer();
+  } else if (LLVM_UNLIKELY(isSliced())) {
+    return vmcast<SlicedASCIIStringPrimitive>(this)->getRawPointer();
   } else if (isUniqued()) {
     return vmcast<DynamicUniquedASCIIStringPrimitive>(this)->getRawPointer();
   } else {
@@ -718,6 +1006,10 @@ inline const char *StringPrimitive::castToASCIIPointer() const {
 inline const char16_t *StringPrimitive::castToUTF16Pointer() const {
   if (LLVM_UNLIKELY(isExternal())) {
     return vmcast<ExternalUTF16StringPrimitive>(this)->getRawPointer();
+  } else if (LLVM_UNLIKELY(isBuffered())) {
+    return vmcast<BufferedUTF16StringPrimitive>(this)->getRawPointer();
+  } else if (LLVM_UNLIKELY(isSliced())) {
+    return vmcast<SlicedUTF16StringPrimitive>(this)->getRawPointer();
   } else if (isUniqued()) {
     return vmcast<DynamicUniquedUTF16StringPrimitive>(this)->getRawPointer();
   } else {
@@ -726,6 +1018,8 @@ inline const char16_t *StringPrimitive::castToUTF16Pointer() const {
 }
 
 inline char *StringPrimitive::castToASCIIPointerForWrite() {
+  assert(
+      !isBuffered() && !isSliced() && "string shares its characters");
   if (LLVM_UNLIKELY(isExternal())) {
     return vmcast<ExternalASCIIStringPrimitive>(this)->getRawPointerForWrite();
   } else if (isUniqued()) {
@@ -737,6 +1031,8 @@ inline char *StringPrimitive::castToASCIIPointerForWrite() {
 }
 
 inline char16_t *StringPrimitive::castToUTF16PointerForWrite() {
+  assert(
+      !isBuffered() && !isSliced() && "string shares its characters");
   if (LLVM_UNLIKELY(isExternal())) {
     return vmcast<ExternalUTF16StringPrimitive>(this)->getRawPointerForWrite();
   } else if (isUniqued()) {
@@ -770,7 +1066,9 @@ inline bool StringPrimitive::isASCII() const {
   // Abstractly, we're doing the following test:
   // return getKind() == CellKind::DynamicASCIIStringPrimitiveKind ||
   //        getKind() == CellKind::DynamicUniquedASCIIStringPrimitiveKind ||
-  //        getKind() == CellKind::ExternalASCIIStringPrimitiveKind;
+  //        getKind() == CellKind::ExternalASCIIStringPrimitiveKind ||
+  //        getKind() == CellKind::BufferedASCIIStringPrimitiveKind ||
+  //        getKind() == CellKind::SlicedASCIIStringPrimitiveKind;
   // We speed this up by making the assumption that the string primitive kinds
   // are defined consecutively, alternating between ASCII and UTF16.
   // We statically enforce this:
@@ -781,7 +1079,11 @@ inline bool StringPrimitive::isASCII() const {
           CellKind::DynamicUniquedUTF16StringPrimitiveKind,
           CellKind::DynamicUniquedASCIIStringPrimitiveKind,
           CellKind::ExternalUTF16StringPrimitiveKind,
-          CellKind::ExternalASCIIStringPrimitiveKind),
+          CellKind::ExternalASCIIStringPrimitiveKind,
+          CellKind::BufferedUTF16StringPrimitiveKind,
+          CellKind::BufferedASCIIStringPrimitiveKind,
+          CellKind::SlicedUTF16StringPrimitiveKind,
+          CellKind::SlicedASCIIStringPrimitiveKind),
       "Cell kinds in unexpected order");
   // Given this assumption, the ASCII versions are either both odd or both
   // even.
@@ -800,13 +1102,40 @@ inline bool StringPrimitive::isExternal() const {
           CellKind::ExternalUTF16StringPrimitiveKind,
           CellKind::ExternalASCIIStringPrimitiveKind),
       "Cell kinds in unexpected order");
-  return getKind() >= CellKind::ExternalUTF16StringPrimitiveKind;
+  return kindInRange(
+      getKind(),
+      CellKind::ExternalUTF16StringPrimitiveKind,
+      CellKind::ExternalASCIIStringPrimitiveKind);
+}
+
+inline bool StringPrimitive::isBuffered() const {
+  return kindInRange(
+      getKind(),
+      CellKind::BufferedUTF16StringPrimitiveKind,
+      CellKind::BufferedASCIIStringPrimitiveKind);
+}
+
+inline bool StringPrimitive::isSliced() const {
+  // We require that sliced cell kinds be the last string cell kinds.
+  static_assert(
+      cellKindsContiguousAscending(
+          CellKind::BufferedASCIIStringPrimitiveKind,
+          CellKind::SlicedUTF16StringPrimitiveKind,
+          CellKind::SlicedASCIIStringPrimitiveKind) &&
+          CellKind::SlicedASCIIStringPrimitiveKind ==
+              CellKind::StringPrimitiveKind_last,
+      "Cell kinds in unexpected order");
+  return getKind() >= CellKind::SlicedUTF16StringPrimitiveKind;
 }
 
 template <typename T>
 inline ArrayRef<T> StringPrimitive::getStringRef() const {
   if (isExternal()) {
     return vmcast<ExternalStringPrimitive<T>>(this)->getStringRef();
+  } else if (isBuffered()) {
+    return vmcast<BufferedStringPrimitive<T>>(this)->getStringRef();
+  } else if (isSliced()) {
+    return vmcast<SlicedStringPrimitive<T>>(this)->getStringRef();
   } else if (isUniqued()) {
     return vmcast<DynamicStringPrimitive<T, true /* Uniqued */>>(this)
         ->getStringRef();
@@ -825,6 +1154,12 @@ inline uint32_t StringPrimitive::externalMemorySize(const GCCell *cell) {
   } else if (
       const auto asExtUTF16 = dyn_vmcast<ExternalUTF16StringPrimitive>(cell)) {
     return asExtUTF16->getStringByteSize();
+  } else if (
+      const auto asBufAscii = dyn_vmcast<BufferedASCIIStringPrimitive>(cell)) {
+    return asBufAscii->externalBytes_;
+  } else if (
+      const auto asBufUTF16 = dyn_vmcast<BufferedUTF16StringPrimitive>(cell)) {
+    return asBufUTF16->externalBytes_;
   } else {
     return 0;
   }
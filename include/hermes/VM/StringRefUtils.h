@@ -7,6 +7,8 @@
 #ifndef HERMES_VM_UTF16REF_H
 #define HERMES_VM_UTF16REF_H
 
+#include "hermes/Support/StringSearch.h"
+
 #include "llvm/ADT/ArrayRef.h"
 
 namespace llvm {
@@ -39,38 +41,25 @@ bool stringRefEquals(llvm::ArrayRef<T1> str1, llvm::ArrayRef<T2> str2) {
   if (str1.size() != str2.size()) {
     return false;
   }
-  return std::equal(str1.begin(), str1.end(), str2.begin());
+  return findMismatch(str1.data(), str2.data(), str1.size()) == str1.size();
 };
 
 /// Compare two ArrayRef, \return +1 if str1 > str2, -1 if str1 < str2, 0
 /// otherwise.
 template <typename T1, typename T2>
 int stringRefCompare(llvm::ArrayRef<T1> str1, llvm::ArrayRef<T2> str2) {
-  if (str1.size() >= str2.size()) {
-    // If str1 is equal or longer than str2, match using str2's length.
-    auto pos = std::mismatch(str2.begin(), str2.end(), str1.begin());
-    // Note that pos.first is from str2, pos.second is from str1.
-    if (pos.first == str2.end()) {
-      // str2 reaches the end and everything is equal so far.
-      if (pos.second == str1.end()) {
-        // str1 also reaches the end, two strings are equal.
-        return 0;
-      }
-      // str1 is longer, so str1 > str2.
-      return +1;
+  // Match using the shorter string's length.
+  size_t length = std::min(str1.size(), str2.size());
+  size_t pos = findMismatch(str1.data(), str2.data(), length);
+  if (pos == length) {
+    // Everything is equal so far, so the longer string is bigger.
+    if (str1.size() == str2.size()) {
+      return 0;
     }
-    // Found a different character, return based on which is bigger.
-    return *pos.second > *pos.first ? +1 : -1;
-  }
-  // str1 is shorter than str2, match using str1's length.
-  auto pos = std::mismatch(str1.begin(), str1.end(), str2.begin());
-  if (pos.first == str1.end()) {
-    // str1 reaches the end and everything is equal so far.
-    // Since str1 is shorter than str2, str1 < str2.
-    return -1;
+    return str1.size() > str2.size() ? +1 : -1;
   }
   // Found a different character, return based on which is bigger.
-  return *pos.first > *pos.second ? +1 : -1;
+  return str1[pos] > str2[pos] ? +1 : -1;
 };
 
 } // namespace vm
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_VM_STRUCTUREDCLONE_H
+#define HERMES_VM_STRUCTUREDCLONE_H
+
+#include "hermes/VM/Runtime.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace hermes {
+namespace vm {
+
+/// A JS value serialized with the structured clone algorithm, in a form that
+/// doesn't refer to the runtime it came from. It can be moved to another
+/// thread and deserialized by any runtime, which is how separate runtimes
+/// exchange messages.
+///
+/// Supported are primitives other than symbols, plain objects and arrays
+/// (their own enumerable properties), Dates, ArrayBuffers and typed arrays.
+/// Objects reachable more than once, including cycles, are deserialized as a
+/// single object. The data blocks of transferred ArrayBuffers are moved into
+/// the SerializedValue instead of being copied.
+class SerializedValue {
+ public:
+  SerializedValue() = default;
+  ~SerializedValue();
+
+  SerializedValue(const SerializedValue &) = delete;
+  SerializedValue &operator=(const SerializedValue &) = delete;
+
+  /// Serialize \p value, detaching the ArrayBuffers in \p transfer, which is
+  /// undefined or an array of ArrayBuffers, and taking over their data blocks.
+  /// Nothing is detached if an exception is raised.
+  static CallResult<std::unique_ptr<SerializedValue>>
+  serialize(Runtime *runtime, Handle<> value, Handle<> transfer);
+
+  /// Create a copy of the serialized value in \p runtime. This can be done
+  /// several times, except when ArrayBuffers were transferred: their data
+  /// blocks are given to the first copy.
+  CallResult<HermesValue> deserialize(Runtime *runtime);
+
+  /// \return the number of bytes held, including transferred data blocks.
+  size_t size() const;
+
+ private:
+  class Serializer;
+  class Deserializer;
+
+  /// The serialized value.
+  std::vector<uint8_t> bytes_;
+
+  /// The malloc'ed data blocks of the transferred ArrayBuffers and their
+  /// sizes, in the order of the transfer list. A block is set to null once
+  /// a deserialized ArrayBuffer owns it.
+  std::vector<std::pair<char *, size_t>> transferred_;
+
+  /// Whether the blocks in transferred_ have been handed out.
+  bool transferredTaken_{false};
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_STRUCTUREDCLONE_H
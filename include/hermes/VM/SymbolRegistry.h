@@ -27,7 +27,8 @@ class Runtime;
 ///
 /// Contains a mapping from the string keys for each symbol to the SymbolID
 /// that was created with Symbol.for. This mapping is consulted every time
-/// Symbol.for is called.
+/// Symbol.for is called. The keys are uniqued in the IdentifierTable, which
+/// hashes them, so the mapping only needs to hash their SymbolIDs.
 ///
 /// To get Symbol.keyFor, we also keep a set of the registered symbols.
 /// Each symbol's description is the key string, so we use its
@@ -38,23 +39,18 @@ class Runtime;
 /// must be asked whether a symbol is globally registered before retrieving its
 /// description.
 class SymbolRegistry {
-  /// OrderedHashMap from the string key to the SymbolID.
-  /// Uses PinnedHermesValue to avoid allocating a new handle whenever we want
-  /// to use it.
-  PinnedHermesValue stringMap_;
+  /// Map from the uniqued SymbolID of each string key to the symbol
+  /// registered for it.
+  llvm::DenseMap<SymbolID, SymbolID> keyMap_{};
 
   /// The set of SymbolIDs that have been registered in the SymbolRegistry.
-  /// Note that these are guaranteed to be values in stringMap_,
-  /// and therefore their backing strings will be kept alive.
+  /// Note that these are guaranteed to be values in keyMap_, and therefore
+  /// they will be kept alive.
   llvm::DenseSet<SymbolID> registeredSymbols_{};
 
  public:
   explicit SymbolRegistry() {}
 
-  /// Initialize the data structures of the SymbolRegistry.
-  /// Must be performed before any other operations can be done.
-  void init(Runtime *runtime);
-
   /// Mark the Strings and Symbols in the registry as roots.
   void markRoots(SlotAcceptor &acceptor);
 
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_VM_TYPEFEEDBACK_H
+#define HERMES_VM_TYPEFEEDBACK_H
+
+#include "hermes/Inst/Inst.h"
+#include "hermes/VM/HermesValue.h"
+
+#include "llvm/ADT/ArrayRef.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace hermes {
+namespace vm {
+
+/// The types of the values observed at a feedback site, as a set of bits.
+enum FeedbackTypes : uint8_t {
+  FeedbackNumber = 1 << 0,
+  FeedbackString = 1 << 1,
+  FeedbackBoolean = 1 << 2,
+  FeedbackNullOrUndefined = 1 << 3,
+  FeedbackObject = 1 << 4,
+  /// Symbols and the values internal to the VM.
+  FeedbackOther = 1 << 5,
+};
+
+/// \return the feedback bit describing the type of \p value.
+inline uint8_t feedbackTypeOf(HermesValue value) {
+  if (value.isNumber())
+    return FeedbackNumber;
+  if (value.isObject())
+    return FeedbackObject;
+  if (value.isString())
+    return FeedbackString;
+  if (value.isBool())
+    return FeedbackBoolean;
+  if (value.isUndefined() || value.isNull())
+    return FeedbackNullOrUndefined;
+  return FeedbackOther;
+}
+
+/// The types observed by the interpreter at the arithmetic, comparison,
+/// property access and call instructions of one function.  Every such
+/// instruction is given a slot, numbered in bytecode order, when the vector
+/// is created.
+///
+/// Only the slow paths of the instructions record their operands, so a site
+/// whose types are empty either never ran or always took its fast path:
+/// numbers for arithmetic and comparisons, an own property or a cached one
+/// for named property accesses, an element of a packed array for computed
+/// ones, and a bytecode function for calls.  The recorded types are those of
+/// both operands of arithmetic and comparisons, of the object of property
+/// accesses, and of the callee of calls.
+class TypeFeedbackVector {
+ public:
+  /// \return true if instructions with opcode \p opCode have a slot.
+  static bool isFeedbackSite(inst::OpCode opCode) {
+    switch (opCode) {
+#define FEEDBACK_SITE(name) case inst::OpCode::name:
+      // Arithmetic.
+      FEEDBACK_SITE(Add)
+      FEEDBACK_SITE(Sub)
+      FEEDBACK_SITE(Mul)
+      FEEDBACK_SITE(Div)
+      FEEDBACK_SITE(Mod)
+      FEEDBACK_SITE(LShift)
+      FEEDBACK_SITE(RShift)
+      FEEDBACK_SITE(URshift)
+      FEEDBACK_SITE(BitAnd)
+      FEEDBACK_SITE(BitOr)
+      FEEDBACK_SITE(BitXor)
+      // Comparisons.
+      FEEDBACK_SITE(Less)
+      FEEDBACK_SITE(LessEq)
+      FEEDBACK_SITE(Greater)
+      FEEDBACK_SITE(GreaterEq)
+      FEEDBACK_SITE(JLess)
+      FEEDBACK_SITE(JLessLong)
+      FEEDBACK_SITE(JNotLess)
+      FEEDBACK_SITE(JNotLessLong)
+      FEEDBACK_SITE(JLessEqual)
+      FEEDBACK_SITE(JLessEqualLong)
+      FEEDBACK_SITE(JNotLessEqual)
+      FEEDBACK_SITE(JNotLessEqualLong)
+      FEEDBACK_SITE(JGreater)
+      FEEDBACK_SITE(JGreaterLong)
+      FEEDBACK_SITE(JNotGreater)
+      FEEDBACK_SITE(JNotGreaterLong)
+      FEEDBACK_SITE(JGreaterEqual)
+      FEEDBACK_SITE(JGreaterEqualLong)
+      FEEDBACK_SITE(JNotGreaterEqual)
+      FEEDBACK_SITE(JNotGreaterEqualLong)
+      // Property accesses.
+      FEEDBACK_SITE(GetByIdShort)
+      FEEDBACK_SITE(GetById)
+      FEEDBACK_SITE(GetByIdLong)
+      FEEDBACK_SITE(TryGetById)
+      FEEDBACK_SITE(TryGetByIdLong)
+      FEEDBACK_SITE(PutByIdShort)
+      FEEDBACK_SITE(PutById)
+      FEEDBACK_SITE(PutByIdLong)
+      FEEDBACK_SITE(TryPutById)
+      FEEDBACK_SITE(TryPutByIdLong)
+      FEEDBACK_SITE(GetByVal)
+      FEEDBACK_SITE(PutByVal)
+      // Calls.
+      FEEDBACK_SITE(Call)
+      FEEDBACK_SITE(CallLong)
+      FEEDBACK_SITE(Call1)
+      FEEDBACK_SITE(Call2)
+      FEEDBACK_SITE(Call3)
+      FEEDBACK_SITE(Call4)
+      FEEDBACK_SITE(Construct)
+      FEEDBACK_SITE(ConstructLong)
+#undef FEEDBACK_SITE
+      return true;
+      default:
+        return false;
+    }
+  }
+
+  /// Create the vector of a function whose feedback sites are at the sorted
+  /// bytecode offsets \p siteOffsets.
+  explicit TypeFeedbackVector(llvm::ArrayRef<uint32_t> siteOffsets)
+      : offsets_(siteOffsets.begin(), siteOffsets.end()),
+        types_(siteOffsets.size(), 0) {
+    assert(
+        std::is_sorted(offsets_.begin(), offsets_.end()) &&
+        "feedback sites must be sorted");
+  }
+
+  /// \return the number of slots.
+  uint32_t size() const {
+    return offsets_.size();
+  }
+
+  /// \return the bytecode offset of the instruction owning slot \p slot.
+  uint32_t getSlotOffset(uint32_t slot) const {
+    assert(slot < size() && "slot out of bounds");
+    return offsets_[slot];
+  }
+
+  /// \return the types observed at slot \p slot.
+  uint8_t getSlotTypes(uint32_t slot) const {
+    assert(slot < size() && "slot out of bounds");
+    return types_[slot];
+  }
+
+  /// \return the slot of the instruction at bytecode \p offset, or size() if
+  ///   it is not a feedback site.
+  uint32_t findSlot(uint32_t offset) const {
+    auto it = std::lower_bound(offsets_.begin(), offsets_.end(), offset);
+    if (it == offsets_.end() || *it != offset)
+      return size();
+    return it - offsets_.begin();
+  }
+
+  /// Add \p types to the types observed by the instruction at bytecode
+  /// \p offset, if it is a feedback site.
+  void record(uint32_t offset, uint8_t types) {
+    uint32_t slot = findSlot(offset);
+    if (slot < size())
+      types_[slot] |= types;
+  }
+
+  /// \return the types observed by the instruction at bytecode \p offset,
+  ///   which are empty if it is not a feedback site.
+  uint8_t getTypes(uint32_t offset) const {
+    uint32_t slot = findSlot(offset);
+    return slot < size() ? types_[slot] : 0;
+  }
+
+ private:
+  /// The bytecode offset of the instruction owning each slot, in increasing
+  /// order.
+  std::vector<uint32_t> offsets_;
+
+  /// The types observed at each slot.
+  std::vector<uint8_t> types_;
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_TYPEFEEDBACK_H
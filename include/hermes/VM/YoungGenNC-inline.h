@@ -10,6 +10,7 @@
 #include "hermes/VM/YoungGenNC.h"
 
 #include "hermes/VM/GC.h"
+#include "hermes/VM/GreyQueuesNC.h"
 #include "hermes/VM/SlotAcceptorDefault.h"
 
 namespace hermes {
@@ -35,6 +36,50 @@ struct YoungGen::EvacAcceptor final : public SlotAcceptorDefault {
   }
 };
 
+/// The acceptor used by each thread of a parallel evacuation of the young
+/// generation.  It promotes the young-gen referents of slots into the thread's
+/// own buffer, and queues the copies to have their own slots scanned.
+struct YoungGen::ParallelEvacAcceptor final : public SlotAcceptorDefault {
+  /// Weak reference slots are only freed by full collections, which mark them
+  /// from scratch.
+  static constexpr bool shouldMarkWeak = false;
+
+  YoungGen &gen;
+  GreyQueues::Queue &queue;
+  OldGen::PromotionBuffer buffer;
+
+#ifndef NDEBUG
+  /// Statistics about the cells promoted by this thread.
+  unsigned numHiddenClasses{0};
+  unsigned numLeafHiddenClasses{0};
+#endif
+
+  ParallelEvacAcceptor(GC &gc, YoungGen &gen, GreyQueues::Queue &queue)
+      : SlotAcceptorDefault(gc),
+        gen(gen),
+        queue(queue),
+        buffer(gen.nextGen_) {}
+
+  using SlotAcceptorDefault::accept;
+
+  void accept(void *&ptr) override {
+    if (gen.contains(ptr)) {
+      ptr = forward(static_cast<GCCell *>(ptr));
+    }
+  }
+
+  void accept(HermesValue &hv) override {
+    if (hv.isPointer() && gen.contains(hv.getPointer())) {
+      auto *cell = static_cast<GCCell *>(hv.getPointer());
+      hv.setInGC(hv.updatePointer(forward(cell)), &gc);
+    }
+  }
+
+  /// The parallel version of YoungGen::forwardPointer: \return the promoted
+  /// copy of \p cell, promoting it if no thread has done so yet.
+  GCCell *forward(GCCell *cell);
+};
+
 } // namespace vm
 } // namespace hermes
 
@@ -19,12 +19,16 @@
 
 #include "llvm/Support/MathExtras.h"
 
+#include <chrono>
 #include <functional>
+#include <utility>
+#include <vector>
 
 namespace hermes {
 namespace vm {
 
-// Forward declaration.
+// Forward declarations.
+class AllocationSite;
 class OldGen;
 
 /// A generation whose preferred mode of collection is a copying evacuation, to
@@ -103,10 +107,10 @@ class YoungGen : public GCGeneration {
   void creditExternalMemory(uint32_t size);
   void debitExternalMemory(uint32_t size);
   void updateEffectiveEndForExternalMemory();
+  void forObjsAllocatedSinceGC(const std::function<void(GCCell *)> &callback);
 
 #ifndef NDEBUG
   inline bool dbgContains(const void *p) const final override;
-  void forObjsAllocatedSinceGC(const std::function<void(GCCell *)> &callback);
 #endif
 
   /// @}
@@ -179,6 +183,15 @@ class YoungGen : public GCGeneration {
   /// references to cells with finalizers in the old gen.
   void finalizeUnreachableAndTransferReachableObjects();
 
+  /// Record that \p cell was just allocated by \p site.  If the site is
+  /// sampling, the next collection records whether \p cell survives it; if
+  /// the site is pretenured, the size of \p cell is counted in the stats.
+  void trackAllocationSite(GCCell *cell, AllocationSite *site);
+
+  /// Drop the allocation site samples that are still pending, before a full
+  /// collection moves or frees their cells.
+  void dropAllocationSiteSamples();
+
   /// Static override of GCGeneration::didFinishGC().
   void didFinishGC();
 
@@ -190,9 +203,18 @@ class YoungGen : public GCGeneration {
   /// GC.
   void moveHeap(GC *gc, ptrdiff_t moveHeapDelta);
 
+  /// Do an evacuating collection of the young generation, copying
+  /// reachable objects into the nextGen.  \p cause is recorded in its
+  /// GCCycleEvent.
+  void collect(const char *cause);
+
   /// Forward declaration of the acceptor used to evacuate the young generation.
   struct EvacAcceptor;
 
+  /// Forward declaration of the acceptor used by each thread of a parallel
+  /// evacuation of the young generation.
+  struct ParallelEvacAcceptor;
+
  private:
   /// Slow path taken when we can't attempt young-gen collection
   /// because there is insufficient free space in the older generation
@@ -213,16 +235,6 @@ class YoungGen : public GCGeneration {
       HasFinalizer hasFinalizer,
       bool fixedSizeAlloc);
 
-#ifndef NDEBUG
-  /// In debug builds, we expose the collect call to tests.
- public:
-#endif
-  /// Do an evacuating collection of the young generation, copying
-  /// reachable objects into the nextGen.
-  void collect();
-#ifndef NDEBUG
- private:
-#endif
 
   /// Assumes that ptr is a pointer into the current space.  If the
   /// vtable slot of *ptr already contains a forwarding pointer,
@@ -231,6 +243,25 @@ class YoungGen : public GCGeneration {
   /// of the copied GCCell.
   GCCell *forwardPointer(GCCell *ptr);
 
+  /// Record the fate of the pending allocation site samples, once the cells
+  /// that survive the collection have been forwarded.
+  void recordAllocationSiteFates();
+
+  /// Once the cells that survive the collection have been forwarded, record
+  /// in \p ages the age of each, as the number of bytes allocated in the
+  /// generation after it.
+  void recordPromotionAges(Histogram &ages);
+
+  /// Evacuate the cells reachable from the roots and from the dirty cards of
+  /// the old gen \p regions on GenGC::numGCThreads_ threads, each promoting
+  /// into its own OldGen::PromotionBuffer.  The starting times of the root and
+  /// transitive marking phases are stored in \p markRootsStart and
+  /// \p scanTransitiveStart.
+  void evacuateParallel(
+      const std::vector<std::pair<char *, const char *>> &regions,
+      std::chrono::steady_clock::time_point *markRootsStart,
+      std::chrono::steady_clock::time_point *scanTransitiveStart);
+
   /// The minimum and maximum size of this generation.
   const Size sz_;
 
@@ -261,6 +292,15 @@ class YoungGen : public GCGeneration {
   /// the former will yield the survival rate.
   gcheapsize_t cumPreBytes_ = 0;
   gcheapsize_t cumPromotedBytes_ = 0;
+
+  /// Cells allocated in this generation since the last collection by
+  /// allocation sites that are sampling, with their sites.
+  std::vector<std::pair<GCCell *, AllocationSite *>> siteSamples_;
+
+  /// The number of bytes allocated in the old gen by pretenured sites, and the
+  /// number of sites that became pretenured.
+  gcheapsize_t cumPretenuredBytes_ = 0;
+  unsigned numPretenuredSites_ = 0;
 };
 
 size_t YoungGen::size() const {
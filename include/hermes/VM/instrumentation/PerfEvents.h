@@ -7,6 +7,7 @@
 #ifndef HERMES_VM_INSTRUMENTATION_PERFEVENTS_H
 #define HERMES_VM_INSTRUMENTATION_PERFEVENTS_H
 
+#include <array>
 #include <cstdint>
 #include <string>
 
@@ -25,6 +26,37 @@ struct PerfEvents {
   static bool endAndInsertStats(std::string &jsonStats);
 };
 
+/// The CPU cycles, instructions, cache misses and branch misses of one
+/// thread, counted as a group so that they are read together. Only available
+/// on Linux: elsewhere open() fails.
+class ThreadPerfCounters {
+ public:
+  static constexpr unsigned kNumCounters = 4;
+  using Values = std::array<uint64_t, kNumCounters>;
+
+  /// The names of the counters, in the order of Values.
+  static const char *const kNames[kNumCounters];
+
+  ThreadPerfCounters() = default;
+  ~ThreadPerfCounters();
+
+  ThreadPerfCounters(const ThreadPerfCounters &) = delete;
+  void operator=(const ThreadPerfCounters &) = delete;
+
+  /// Start counting the events of the thread \p tid.
+  /// \return false if the counters are not available.
+  bool open(uint64_t tid);
+
+  /// Read the counters into \p values. This only makes a system call, so it
+  /// can be called from a signal handler.
+  /// \return false if they can't be read.
+  bool read(Values &values) const;
+
+ private:
+  /// The file descriptor of each counter. The first one leads the group.
+  int fds_[kNumCounters]{-1, -1, -1, -1};
+};
+
 } // namespace instrumentation
 } // namespace vm
 } // namespace hermes
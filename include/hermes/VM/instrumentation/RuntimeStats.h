@@ -8,6 +8,9 @@
 #define HERMES_VM_RUNTIMESTATS_H
 
 #include "hermes/Support/PerfSection.h"
+#include "hermes/VM/PropertyCache.h"
+
+#include "llvm/Support/raw_ostream.h"
 
 #include <stdint.h>
 #include <chrono>
@@ -39,6 +42,33 @@ struct RuntimeStats {
     uint64_t count{0};
   };
 
+  /// The phases of startup, which are timed by StartupTimer.  A phase which
+  /// happens once per module, like the string table registration, sums all of
+  /// its occurrences.
+  struct Startup {
+    /// Creation of the Runtime, including the heap, the predefined strings
+    /// and the JS library.
+    Statistic runtimeCreation;
+
+    /// Creation of the predefined strings and symbols.
+    Statistic predefinedStrings;
+
+    /// Initialization of the global object and the JS library.
+    Statistic jslibInit;
+
+    /// Validation and mapping of bytecode buffers.
+    Statistic bytecodeMapping;
+
+    /// Registration of the string tables of the runtime modules.
+    Statistic stringTableRegistration;
+
+    /// Execution of the global functions of the persistent modules.
+    Statistic globalFunction;
+
+    /// The first garbage collection.
+    Statistic firstGC;
+  };
+
   RuntimeStats(bool shouldSample) : shouldSample(shouldSample) {}
 
   /// Measure of host function callouts (outgoing from VM).
@@ -50,6 +80,13 @@ struct RuntimeStats {
   /// Measure of of jsi Function calls (incoming to VM).
   Statistic incomingFunction;
 
+  /// Measure of the phases of startup, which are always recorded.
+  Startup startup;
+
+  /// Property cache counters summed over all CodeBlocks. This is only brought
+  /// up to date by Runtime::collectPropertyCacheStats().
+  PropertyCacheStats propertyCache;
+
   /// The topmost RAIITimer in the stack.
   RAIITimer *timerStack{nullptr};
 
@@ -60,6 +97,10 @@ struct RuntimeStats {
 
   /// Flush all timers pending in our timer stack.
   void flushPendingTimers();
+
+  /// Write the startup phases to \p os as a JSON object, with the wall and
+  /// CPU time in seconds, the page faults and the count of every phase.
+  void printStartupStats(llvm::raw_ostream &os) const;
 };
 
 /// An RAII-style class for updating a Statistic.
@@ -111,6 +152,40 @@ class RAIITimer {
   ~RAIITimer();
 };
 
+/// Times a phase of startup, including the page faults of the thread, which
+/// is sampled regardless of RuntimeStats::shouldSample since startup phases
+/// are few.  Unlike RAIITimer, it is not part of the timer stack, so it can
+/// time phases which end before the RuntimeStats exists.
+class StartupTimer {
+  /// The statistic updated when the timer is destroyed, if any.
+  RuntimeStats::Statistic *const stat_;
+
+  /// The initial value of the wall time.
+  std::chrono::steady_clock::time_point wallTimeStart_;
+
+  /// The initial value of the CPU time.
+  std::chrono::microseconds cpuTimeStart_;
+
+  /// Initial values of the page fault counts, which are 0 on error.
+  RuntimeStats::Sampled sampledStart_{};
+
+  /// Whether stop() was called.
+  bool stopped_{false};
+
+ public:
+  /// Start timing a phase, which is added to \p stat when the timer is
+  /// destroyed.  If \p stat is null, stop() must be called instead.
+  explicit StartupTimer(RuntimeStats::Statistic *stat);
+
+  StartupTimer(const StartupTimer &) = delete;
+  StartupTimer &operator=(const StartupTimer &) = delete;
+
+  /// Add the phase to \p stat, which ends it.
+  void stop(RuntimeStats::Statistic &stat);
+
+  ~StartupTimer();
+};
+
 } // namespace instrumentation
 } // namespace vm
 } // namespace hermes
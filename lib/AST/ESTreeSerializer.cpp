@@ -0,0 +1,557 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/AST/ESTreeSerializer.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/LEB128.h"
+
+#include <cstring>
+#include <type_traits>
+
+namespace hermes {
+
+namespace {
+
+using namespace hermes::ESTree;
+using llvm::dyn_cast;
+using llvm::dyn_cast_or_null;
+
+/// Identifies serialized ASTs.
+constexpr char kMagic[4] = {'H', 'A', 'S', 'T'};
+
+/// Bump this whenever the encoding or ESTree.def changes.
+constexpr uint32_t kVersion = 1;
+
+/// The number of node kinds, as a cheap check that ESTree.def didn't change
+/// without a version bump.
+constexpr uint32_t kNumNodeKinds = 0
+#define ESTREE_NODE_0_ARGS(NAME, ...) +1
+#define ESTREE_NODE_1_ARGS(NAME, ...) +1
+#define ESTREE_NODE_2_ARGS(NAME, ...) +1
+#define ESTREE_NODE_3_ARGS(NAME, ...) +1
+#define ESTREE_NODE_4_ARGS(NAME, ...) +1
+#define ESTREE_NODE_5_ARGS(NAME, ...) +1
+#include "hermes/AST/ESTree.def"
+    ;
+
+class ESTreeSerializer {
+  /// The stream receiving the header and the string table.
+  llvm::raw_ostream &os_;
+
+  /// The encoded nodes, written after the string table.
+  llvm::SmallString<1024> nodes_{};
+  llvm::raw_svector_ostream nodesOS_{nodes_};
+
+  /// The start of the source buffer, used to encode locations as offsets.
+  const char *bufferStart_;
+
+  /// Index of every label in the string table, starting at 1. Zero is used
+  /// for null labels.
+  llvm::DenseMap<UniqueString *, uint32_t> labelIndex_{};
+  std::vector<UniqueString *> labels_{};
+
+ public:
+  ESTreeSerializer(llvm::raw_ostream &os, const char *bufferStart)
+      : os_(os), bufferStart_(bufferStart) {}
+
+  void doIt(
+      ProgramNode *program,
+      const llvm::MemoryBuffer &buffer,
+      const SerializedESTreeInfo &info) {
+    write(program);
+
+    os_.write(kMagic, sizeof(kMagic));
+    llvm::encodeULEB128(kVersion, os_);
+    llvm::encodeULEB128(kNumNodeKinds, os_);
+    llvm::encodeULEB128(buffer.getBufferSize(), os_);
+    os_ << (char)info.useStaticBuiltin;
+    writeString(os_, info.sourceMappingUrl);
+    llvm::encodeULEB128(labels_.size(), os_);
+    for (UniqueString *label : labels_)
+      writeString(os_, label->str());
+    os_ << nodesOS_.str();
+  }
+
+ private:
+  static void writeString(llvm::raw_ostream &os, llvm::StringRef str) {
+    llvm::encodeULEB128(str.size(), os);
+    os << str;
+  }
+
+  /// Write \p loc as one plus its offset in the buffer, or zero if invalid.
+  void writeLoc(SMLoc loc) {
+    llvm::encodeULEB128(
+        loc.isValid() ? loc.getPointer() - bufferStart_ + 1 : 0, nodesOS_);
+  }
+
+  void write(NodeLabel label) {
+    if (!label) {
+      llvm::encodeULEB128(0, nodesOS_);
+      return;
+    }
+    auto res = labelIndex_.insert({label, labels_.size() + 1});
+    if (res.second)
+      labels_.push_back(label);
+    llvm::encodeULEB128(res.first->second, nodesOS_);
+  }
+
+  void write(NodeBoolean val) {
+    nodesOS_ << (char)val;
+  }
+
+  void write(NodeNumber num) {
+    uint64_t bits;
+    std::memcpy(&bits, &num, sizeof(bits));
+    nodesOS_.write(reinterpret_cast<const char *>(&bits), sizeof(bits));
+  }
+
+  void write(NodeList &list) {
+    llvm::encodeULEB128(list.size(), nodesOS_);
+    for (auto &node : list)
+      write(&node);
+  }
+
+  /// Write the kind, location and decorations of \p node, followed by its
+  /// fields in the order of ESTree.def.
+  void write(NodePtr node) {
+    if (!node) {
+      llvm::encodeULEB128(0, nodesOS_);
+      return;
+    }
+    llvm::encodeULEB128((unsigned)node->getKind() + 1, nodesOS_);
+    nodesOS_ << (char)node->getParens();
+    writeLoc(node->getStartLoc());
+    writeLoc(node->getEndLoc());
+    writeLoc(node->getDebugLoc());
+    if (auto *func = dyn_cast<FunctionLikeNode>(node)) {
+      nodesOS_ << (char)func->strictness;
+      nodesOS_ << (char)func->isMethodDefinition;
+    }
+
+    switch (node->getKind()) {
+      default:
+        llvm_unreachable("invalid node kind");
+
+#define ESTREE_NODE_0_ARGS(NAME, BASE) \
+  case NodeKind::NAME:                 \
+    break;
+
+#define ESTREE_NODE_1_ARGS(NAME, BASE, ARG0TY, ARG0NM, ARG0OPT) \
+  case NodeKind::NAME:                                          \
+    write(cast<NAME##Node>(node)->_##ARG0NM);                   \
+    break;
+
+#define ESTREE_NODE_2_ARGS(                                       \
+    NAME, BASE, ARG0TY, ARG0NM, ARG0OPT, ARG1TY, ARG1NM, ARG1OPT) \
+  case NodeKind::NAME:                                            \
+    write(cast<NAME##Node>(node)->_##ARG0NM);                     \
+    write(cast<NAME##Node>(node)->_##ARG1NM);                     \
+    break;
+
+#define ESTREE_NODE_3_ARGS(                   \
+    NAME,                                     \
+    BASE,                                     \
+    ARG0TY,                                   \
+    ARG0NM,                                   \
+    ARG0OPT,                                  \
+    ARG1TY,                                   \
+    ARG1NM,                                   \
+    ARG1OPT,                                  \
+    ARG2TY,                                   \
+    ARG2NM,                                   \
+    ARG2OPT)                                  \
+  case NodeKind::NAME:                        \
+    write(cast<NAME##Node>(node)->_##ARG0NM); \
+    write(cast<NAME##Node>(node)->_##ARG1NM); \
+    write(cast<NAME##Node>(node)->_##ARG2NM); \
+    break;
+
+#define ESTREE_NODE_4_ARGS(                   \
+    NAME,                                     \
+    BASE,                                     \
+    ARG0TY,                                   \
+    ARG0NM,                                   \
+    ARG0OPT,                                  \
+    ARG1TY,                                   \
+    ARG1NM,                                   \
+    ARG1OPT,                                  \
+    ARG2TY,                                   \
+    ARG2NM,                                   \
+    ARG2OPT,                                  \
+    ARG3TY,                                   \
+    ARG3NM,                                   \
+    ARG3OPT)                                  \
+  case NodeKind::NAME:                        \
+    write(cast<NAME##Node>(node)->_##ARG0NM); \
+    write(cast<NAME##Node>(node)->_##ARG1NM); \
+    write(cast<NAME##Node>(node)->_##ARG2NM); \
+    write(cast<NAME##Node>(node)->_##ARG3NM); \
+    break;
+
+#define ESTREE_NODE_5_ARGS(                   \
+    NAME,                                     \
+    BASE,                                     \
+    ARG0TY,                                   \
+    ARG0NM,                                   \
+    ARG0OPT,                                  \
+    ARG1TY,                                   \
+    ARG1NM,                                   \
+    ARG1OPT,                                  \
+    ARG2TY,                                   \
+    ARG2NM,                                   \
+    ARG2OPT,                                  \
+    ARG3TY,                                   \
+    ARG3NM,                                   \
+    ARG3OPT,                                  \
+    ARG4TY,                                   \
+    ARG4NM,                                   \
+    ARG4OPT)                                  \
+  case NodeKind::NAME:                        \
+    write(cast<NAME##Node>(node)->_##ARG0NM); \
+    write(cast<NAME##Node>(node)->_##ARG1NM); \
+    write(cast<NAME##Node>(node)->_##ARG2NM); \
+    write(cast<NAME##Node>(node)->_##ARG3NM); \
+    write(cast<NAME##Node>(node)->_##ARG4NM); \
+    break;
+
+#include "hermes/AST/ESTree.def"
+    }
+  }
+};
+
+class ESTreeDeserializer {
+  Context &context_;
+
+  /// The remaining data.
+  const uint8_t *cur_;
+  const uint8_t *const end_;
+
+  /// The source buffer the locations point into.
+  const llvm::MemoryBuffer *buffer_;
+  uint32_t bufId_;
+
+  /// The labels, indexed from 1.
+  std::vector<UniqueString *> labels_{};
+
+ public:
+  ESTreeDeserializer(Context &context, llvm::StringRef data, uint32_t bufId)
+      : context_(context),
+        cur_(data.bytes_begin()),
+        end_(data.bytes_end()),
+        buffer_(context.getSourceErrorManager().getSourceBuffer(bufId)),
+        bufId_(bufId) {}
+
+  ProgramNode *doIt(SerializedESTreeInfo &info) {
+    if (end_ - cur_ < (ptrdiff_t)sizeof(kMagic) ||
+        std::memcmp(cur_, kMagic, sizeof(kMagic)) != 0)
+      return nullptr;
+    cur_ += sizeof(kMagic);
+
+    uint64_t version, numNodeKinds, bufferSize, numLabels;
+    NodeBoolean useStaticBuiltin;
+    if (!read(version) || version != kVersion || !read(numNodeKinds) ||
+        numNodeKinds != kNumNodeKinds || !read(bufferSize) ||
+        bufferSize != buffer_->getBufferSize() || !read(useStaticBuiltin) ||
+        !readString(info.sourceMappingUrl) || !read(numLabels))
+      return nullptr;
+    info.useStaticBuiltin = useStaticBuiltin;
+    // Every label takes at least one byte.
+    if (numLabels > (uint64_t)(end_ - cur_))
+      return nullptr;
+
+    labels_.reserve(numLabels);
+    for (uint64_t i = 0; i < numLabels; ++i) {
+      std::string str;
+      if (!readString(str))
+        return nullptr;
+      labels_.push_back(context_.getStringTable().getString(str));
+    }
+
+    NodePtr program;
+    if (!read(program) || cur_ != end_)
+      return nullptr;
+    return dyn_cast_or_null<ProgramNode>(program);
+  }
+
+ private:
+  bool read(uint64_t &val) {
+    val = 0;
+    for (unsigned shift = 0; cur_ != end_ && shift < 64; shift += 7) {
+      uint8_t byte = *cur_++;
+      val |= (uint64_t)(byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        return true;
+    }
+    return false;
+  }
+
+  bool readByte(uint8_t &byte) {
+    if (cur_ == end_)
+      return false;
+    byte = *cur_++;
+    return true;
+  }
+
+  bool readString(std::string &str) {
+    uint64_t size;
+    if (!read(size) || size > (uint64_t)(end_ - cur_))
+      return false;
+    str.assign(reinterpret_cast<const char *>(cur_), size);
+    cur_ += size;
+    return true;
+  }
+
+  bool readLoc(SMLoc &loc) {
+    uint64_t offset;
+    if (!read(offset) || offset > buffer_->getBufferSize() + 1)
+      return false;
+    loc = offset
+        ? SMLoc::getFromPointer(buffer_->getBufferStart() + offset - 1)
+        : SMLoc{};
+    return true;
+  }
+
+  bool read(NodeLabel &label) {
+    uint64_t index;
+    if (!read(index) || index > labels_.size())
+      return false;
+    label = index ? labels_[index - 1] : nullptr;
+    return true;
+  }
+
+  bool read(NodeBoolean &val) {
+    uint8_t byte;
+    if (!readByte(byte) || byte > 1)
+      return false;
+    val = byte;
+    return true;
+  }
+
+  bool read(NodeNumber &num) {
+    uint64_t bits;
+    if (end_ - cur_ < (ptrdiff_t)sizeof(bits))
+      return false;
+    std::memcpy(&bits, cur_, sizeof(bits));
+    std::memcpy(&num, &bits, sizeof(num));
+    cur_ += sizeof(bits);
+    return true;
+  }
+
+  bool read(NodeList &list) {
+    uint64_t size;
+    if (!read(size))
+      return false;
+    for (uint64_t i = 0; i < size; ++i) {
+      NodePtr node;
+      if (!read(node) || !node)
+        return false;
+      list.push_back(*node);
+    }
+    return true;
+  }
+
+  bool read(NodePtr &result) {
+    uint64_t kind;
+    if (!read(kind))
+      return false;
+    if (!kind) {
+      result = nullptr;
+      return true;
+    }
+
+    uint8_t parens;
+    SMLoc start, end, debug;
+    if (!readByte(parens) || !readLoc(start) || !readLoc(end) ||
+        !readLoc(debug))
+      return false;
+
+    switch ((NodeKind)(kind - 1)) {
+      default:
+        return false;
+
+#define ESTREE_NODE_0_ARGS(NAME, BASE)    \
+  case NodeKind::NAME:                    \
+    result = new (context_) NAME##Node(); \
+    break;
+
+#define ESTREE_NODE_1_ARGS(NAME, BASE, ARG0TY, ARG0NM, ARG0OPT) \
+  case NodeKind::NAME: {                                        \
+    uint8_t decoration[2]{};                                      \
+    if (!readDecoration<NAME##Node>(decoration))                \
+      return false;                                             \
+    ARG0TY arg0{};                                              \
+    if (!read(arg0))                                            \
+      return false;                                             \
+    result = new (context_) NAME##Node(std::move(arg0));        \
+    decorate(cast<NAME##Node>(result), decoration);             \
+    break;                                                      \
+  }
+
+#define ESTREE_NODE_2_ARGS(                                               \
+    NAME, BASE, ARG0TY, ARG0NM, ARG0OPT, ARG1TY, ARG1NM, ARG1OPT)         \
+  case NodeKind::NAME: {                                                  \
+    uint8_t decoration[2]{};                                                \
+    if (!readDecoration<NAME##Node>(decoration))                          \
+      return false;                                                       \
+    ARG0TY arg0{};                                                        \
+    ARG1TY arg1{};                                                        \
+    if (!read(arg0) || !read(arg1))                                       \
+      return false;                                                       \
+    result = new (context_) NAME##Node(std::move(arg0), std::move(arg1)); \
+    decorate(cast<NAME##Node>(result), decoration);                       \
+    break;                                                                \
+  }
+
+#define ESTREE_NODE_3_ARGS(                                            \
+    NAME,                                                              \
+    BASE,                                                              \
+    ARG0TY,                                                            \
+    ARG0NM,                                                            \
+    ARG0OPT,                                                           \
+    ARG1TY,                                                            \
+    ARG1NM,                                                            \
+    ARG1OPT,                                                           \
+    ARG2TY,                                                            \
+    ARG2NM,                                                            \
+    ARG2OPT)                                                           \
+  case NodeKind::NAME: {                                               \
+    uint8_t decoration[2]{};                                             \
+    if (!readDecoration<NAME##Node>(decoration))                       \
+      return false;                                                    \
+    ARG0TY arg0{};                                                     \
+    ARG1TY arg1{};                                                     \
+    ARG2TY arg2{};                                                     \
+    if (!read(arg0) || !read(arg1) || !read(arg2))                     \
+      return false;                                                    \
+    result = new (context_)                                            \
+        NAME##Node(std::move(arg0), std::move(arg1), std::move(arg2)); \
+    decorate(cast<NAME##Node>(result), decoration);                    \
+    break;                                                             \
+  }
+
+#define ESTREE_NODE_4_ARGS(                                              \
+    NAME,                                                                \
+    BASE,                                                                \
+    ARG0TY,                                                              \
+    ARG0NM,                                                              \
+    ARG0OPT,                                                             \
+    ARG1TY,                                                              \
+    ARG1NM,                                                              \
+    ARG1OPT,                                                             \
+    ARG2TY,                                                              \
+    ARG2NM,                                                              \
+    ARG2OPT,                                                             \
+    ARG3TY,                                                              \
+    ARG3NM,                                                              \
+    ARG3OPT)                                                             \
+  case NodeKind::NAME: {                                                 \
+    uint8_t decoration[2]{};                                               \
+    if (!readDecoration<NAME##Node>(decoration))                         \
+      return false;                                                      \
+    ARG0TY arg0{};                                                       \
+    ARG1TY arg1{};                                                       \
+    ARG2TY arg2{};                                                       \
+    ARG3TY arg3{};                                                       \
+    if (!read(arg0) || !read(arg1) || !read(arg2) || !read(arg3))        \
+      return false;                                                      \
+    result = new (context_) NAME##Node(                                  \
+        std::move(arg0), std::move(arg1), std::move(arg2), std::move(arg3)); \
+    decorate(cast<NAME##Node>(result), decoration);                      \
+    break;                                                               \
+  }
+
+#define ESTREE_NODE_5_ARGS(                                          \
+    NAME,                                                            \
+    BASE,                                                            \
+    ARG0TY,                                                          \
+    ARG0NM,                                                          \
+    ARG0OPT,                                                         \
+    ARG1TY,                                                          \
+    ARG1NM,                                                          \
+    ARG1OPT,                                                         \
+    ARG2TY,                                                          \
+    ARG2NM,                                                          \
+    ARG2OPT,                                                         \
+    ARG3TY,                                                          \
+    ARG3NM,                                                          \
+    ARG3OPT,                                                         \
+    ARG4TY,                                                          \
+    ARG4NM,                                                          \
+    ARG4OPT)                                                         \
+  case NodeKind::NAME: {                                             \
+    uint8_t decoration[2]{};                                           \
+    if (!readDecoration<NAME##Node>(decoration))                     \
+      return false;                                                  \
+    ARG0TY arg0{};                                                   \
+    ARG1TY arg1{};                                                   \
+    ARG2TY arg2{};                                                   \
+    ARG3TY arg3{};                                                   \
+    ARG4TY arg4{};                                                   \
+    if (!read(arg0) || !read(arg1) || !read(arg2) || !read(arg3) ||  \
+        !read(arg4))                                                 \
+      return false;                                                  \
+    result = new (context_) NAME##Node(                              \
+        std::move(arg0),                                             \
+        std::move(arg1),                                             \
+        std::move(arg2),                                             \
+        std::move(arg3),                                             \
+        std::move(arg4));                                            \
+    decorate(cast<NAME##Node>(result), decoration);                  \
+    break;                                                           \
+  }
+
+#include "hermes/AST/ESTree.def"
+    }
+
+    for (unsigned i = 0; i < parens; ++i)
+      result->incParens();
+    result->setSourceRange({start, end});
+    result->setDebugLoc(debug);
+    return true;
+  }
+
+  /// Read the decoration bytes of a node of type \p N, which are written
+  /// before its fields.
+  template <typename N>
+  bool readDecoration(uint8_t (&decoration)[2]) {
+    if (!std::is_base_of<FunctionLikeNode, N>::value)
+      return true;
+    return readByte(decoration[0]) &&
+        decoration[0] <= (uint8_t)Strictness::StrictMode &&
+        readByte(decoration[1]) && decoration[1] <= 1;
+  }
+
+  void decorate(FunctionLikeNode *node, const uint8_t (&decoration)[2]) {
+    node->strictness = (Strictness)decoration[0];
+    node->isMethodDefinition = decoration[1];
+  }
+  void decorate(BlockStatementNode *node, const uint8_t (&)[2]) {
+    node->bufferId = bufId_;
+  }
+  void decorate(Node *, const uint8_t (&)[2]) {}
+};
+
+} // namespace
+
+void serializeESTree(
+    llvm::raw_ostream &os,
+    ESTree::ProgramNode *program,
+    const llvm::MemoryBuffer &buffer,
+    const SerializedESTreeInfo &info) {
+  ESTreeSerializer(os, buffer.getBufferStart()).doIt(program, buffer, info);
+}
+
+ESTree::ProgramNode *deserializeESTree(
+    Context &context,
+    llvm::StringRef data,
+    uint32_t bufId,
+    SerializedESTreeInfo &info) {
+  return ESTreeDeserializer(context, data, bufId).doIt(info);
+}
+
+} // namespace hermes
@@ -11,6 +11,8 @@
 
 #include "llvm/Support/MathExtras.h"
 
+#include <algorithm>
+
 namespace hermes {
 namespace hbc {
 
@@ -295,6 +297,44 @@ warmup(const uint8_t *data, uint32_t size, std::atomic<bool> *abortFlag) {
   }
 }
 
+/// Read the \p pages of the page-aligned region starting at \p base, in the
+/// given order, into the OS page cache, but abort ASAP if another thread sets
+/// \p abortFlag.  Pages at or past \p numPages are ignored.
+static void warmupPages(
+    const uint8_t *base,
+    uint32_t numPages,
+    std::vector<uint32_t> pages,
+    std::atomic<bool> *abortFlag) {
+  const uint32_t PS = oscompat::page_size();
+  // Ask for every run of consecutive pages first, so that the kernel reads
+  // them ahead while the loop below waits for them one by one.
+  for (size_t i = 0, e = pages.size(); i < e;) {
+    size_t j = i + 1;
+    while (j < e && pages[j] == pages[j - 1] + 1) {
+      ++j;
+    }
+    if (pages[i] < numPages) {
+      uint32_t end = std::min(pages[j - 1] + 1, numPages);
+      oscompat::vm_prefetch(
+          const_cast<uint8_t *>(base) + (size_t)pages[i] * PS,
+          (size_t)(end - pages[i]) * PS);
+    }
+    i = j;
+  }
+  // Check abort flag every this many pages, to ensure timely termination.
+  const size_t kAbortCheckInterval = 64;
+  for (size_t i = 0, e = pages.size(); i < e; ++i) {
+    if (pages[i] < numPages) {
+      // volatile to prevent the compiler from optimizing the read away.
+      (void)(((volatile const uint8_t *)base)[(size_t)pages[i] * PS]);
+    }
+    if (i % kAbortCheckInterval == kAbortCheckInterval - 1 &&
+        abortFlag->load(std::memory_order_acquire)) {
+      return;
+    }
+  }
+}
+
 void BCProviderFromBuffer::stopWarmup() {
   if (warmupThread_) {
     warmupAbortFlag_.store(true, std::memory_order_release);
@@ -317,6 +357,27 @@ void BCProviderFromBuffer::startWarmup(uint8_t percent) {
   }
 }
 
+void BCProviderFromBuffer::startWarmupPages(
+    const std::vector<uint32_t> &pages) {
+  if (!warmupThread_ && !pages.empty()) {
+    const uint32_t PS = oscompat::page_size();
+    // Number the whole pages of the buffer as the PageAccessTracker does.
+    const uintptr_t start = reinterpret_cast<uintptr_t>(buffer_->data());
+    const uintptr_t base = llvm::alignTo(start, PS);
+    const uintptr_t end = llvm::alignDown(start + buffer_->size(), PS);
+    if (end <= base) {
+      return;
+    }
+    const uint32_t numPages = (end - base) / PS;
+    warmupThread_ = std::thread(
+        warmupPages,
+        reinterpret_cast<const uint8_t *>(base),
+        numPages,
+        pages,
+        &warmupAbortFlag_);
+  }
+}
+
 namespace {
 
 /// Cast a pointer of any type to a uint8_t pointer.
@@ -333,7 +394,7 @@ inline void pageAlignDown(uint8_t **ptr, size_t *byteLen) {
 
   auto orig = *ptr;
   *ptr = reinterpret_cast<uint8_t *>(llvm::alignAddr(*ptr + 1, PS) - PS);
-  byteLen += orig - *ptr;
+  *byteLen += orig - *ptr;
 }
 
 #ifndef NDEBUG
@@ -492,6 +553,21 @@ SHA1 BCProviderFromBuffer::getSourceHash() const {
       llvm::ArrayRef<uint8_t>(bufferPtr_, buffer_->size()));
 }
 
+bool BCProviderFromBuffer::isFunctionInBounds(uint32_t functionID) const {
+  assert(functionID < functionCount_ && "Invalid functionID");
+  // Compare sizes in 64 bits so that the sums cannot overflow.
+  const uint64_t size = buffer_->size();
+  const hbc::SmallFuncHeader &smallHeader = functionHeaders_[functionID];
+  if (smallHeader.flags.overflowed &&
+      uint64_t(smallHeader.getLargeHeaderOffset()) +
+              sizeof(hbc::FunctionHeader) >
+          size) {
+    return false;
+  }
+  RuntimeFunctionHeader header = getFunctionHeader(functionID);
+  return uint64_t(header.offset()) + header.bytecodeSizeInBytes() <= size;
+}
+
 llvm::ArrayRef<uint8_t> BCProviderFromBuffer::getEpilogueFromBytecode(
     llvm::ArrayRef<uint8_t> buffer) {
   const uint8_t *p = buffer.data();
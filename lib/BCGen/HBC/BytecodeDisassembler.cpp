@@ -15,6 +15,7 @@
 #include "hermes/Support/SHA1.h"
 #include "hermes/Support/UTF8.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <iomanip>
 #include <locale>
@@ -357,11 +358,10 @@ void BytecodeVisitor::visitInstructionsInFunction(unsigned funcId) {
 
   auto ip = bytecodeStart;
   while (ip < bytecodeEnd) {
-    const auto md = inst::getInstMetaData(
-        (reinterpret_cast<const inst::Inst *>(ip))->opCode);
-    OpCode op = md.opCode;
-    auto instLength = md.size;
-    preVisitInstruction(md.opCode, ip, instLength);
+    OpCode op = (reinterpret_cast<const inst::Inst *>(ip))->opCode;
+    const auto &desc = inst::getInstDescriptor(op);
+    auto instLength = desc.size;
+    preVisitInstruction(op, ip, instLength);
 
     // Visit branch targets of the SwitchImm instruction.
     if (op == OpCode::SwitchImm) {
@@ -373,9 +373,9 @@ void BytecodeVisitor::visitInstructionsInFunction(unsigned funcId) {
     }
 
     const uint8_t *operandBuf = ip + sizeof(op);
-    int operandCount = md.numOperands;
+    int operandCount = desc.numOperands;
     for (int operandIndex = 0; operandIndex < operandCount; operandIndex++) {
-      auto operandType = md.operandType[operandIndex];
+      auto operandType = desc.operandType[operandIndex];
 
       visitOperand(ip, operandType, operandBuf, operandIndex);
       operandBuf += getOperandSize(operandType);
@@ -797,9 +797,17 @@ BytecodeSectionWalker::BytecodeSectionWalker(
       bcProvider->getCJSModuleTable().begin(),
       bcProvider->getCJSModuleTable().end());
 
+  // Functions need not be laid out in ID order (see -function-order), so
+  // the sections start at the lowest offsets of any function.
   auto firstFuncStart = bcProvider->getBytecode(0);
-  auto firstFuncHeader = bcProvider->getFunctionHeader(0);
-  auto firstFuncInfoStart = bytecodeStart + firstFuncHeader.infoOffset();
+  auto firstFuncInfoStart =
+      bytecodeStart + bcProvider->getFunctionHeader(0).infoOffset();
+  for (uint32_t i = 1, e = bcProvider->getFunctionCount(); i < e; ++i) {
+    firstFuncStart = std::min(firstFuncStart, bcProvider->getBytecode(i));
+    firstFuncInfoStart = std::min(
+        firstFuncInfoStart,
+        bytecodeStart + bcProvider->getFunctionHeader(i).infoOffset());
+  }
   auto debugInfoStart = bytecodeStart + fileHeader->debugInfoOffset;
   addSection("Function body", firstFuncStart, firstFuncInfoStart);
   addSection("Function info", firstFuncInfoStart, debugInfoStart);
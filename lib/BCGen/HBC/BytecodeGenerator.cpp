@@ -8,6 +8,7 @@
 
 #include "hermes/BCGen/HBC/ConsecutiveStringStorage.h"
 #include "hermes/Inst/Builtins.h"
+#include "hermes/Inst/InstDecode.h"
 #include "hermes/Support/OSCompat.h"
 #include "hermes/Support/UTF8.h"
 
@@ -194,6 +195,117 @@ void BytecodeModuleGenerator::addCJSModuleStatic(
   cjsModulesStatic_.push_back(functionID);
 }
 
+namespace {
+
+/// Points the closures created by every function of a module at a single
+/// copy of each set of identical functions. The serializer already shares one
+/// body among functions with identical bytecode, and this extends it to
+/// functions which only differ in which of several identical copies of a
+/// nested function they create, as written by bundlers inlining the same
+/// helper in many places. The unused copies keep their headers.
+class IdenticalFunctionMerger {
+ public:
+  /// \param mergeDebugInfo whether functions with debug info may be
+  ///   replaced, which changes the source locations of their errors.
+  IdenticalFunctionMerger(BytecodeModule &BM, bool mergeDebugInfo)
+      : BM_(BM),
+        mergeDebugInfo_(mergeDebugInfo),
+        canonical_(BM.getNumFunctions(), kNotVisited) {}
+
+  void run() {
+    for (uint32_t id = 0, e = BM_.getNumFunctions(); id < e; ++id)
+      canonicalize(id);
+  }
+
+ private:
+  static constexpr uint32_t kNotVisited = UINT32_MAX;
+
+  BytecodeModule &BM_;
+  const bool mergeDebugInfo_;
+
+  /// The function which replaces each function, by function ID.
+  std::vector<uint32_t> canonical_;
+
+  /// The first function seen with each key().
+  std::unordered_map<std::string, uint32_t> functionsByKey_{};
+
+  /// Rewrite the closures created by function \p id to their canonical
+  /// functions, which are computed first.
+  /// \return the canonical function of \p id.
+  uint32_t canonicalize(uint32_t id);
+
+  /// \return the header fields, bytecode, jump tables and exception handlers
+  ///   of \p BF, which are equal for functions that behave identically.
+  static std::string key(const BytecodeFunction &BF);
+};
+
+uint32_t IdenticalFunctionMerger::canonicalize(uint32_t id) {
+  if (canonical_[id] != kNotVisited)
+    return canonical_[id];
+  canonical_[id] = id;
+
+  BytecodeFunction &BF = BM_.getFunction(id);
+  llvm::MutableArrayRef<opcode_atom_t> opcodes = BF.getMutableOpcodeArray();
+  for (size_t offset = 0; offset < opcodes.size();) {
+    auto *ip = reinterpret_cast<inst::Inst *>(&opcodes[offset]);
+    switch (ip->opCode) {
+#define REWRITE_CLOSURE(name, limit)                       \
+  case inst::OpCode::name: {                               \
+    uint32_t canonical = canonicalize(ip->i##name.op3);    \
+    if (canonical <= limit)                                \
+      ip->i##name.op3 = canonical;                         \
+    break;                                                 \
+  }
+      REWRITE_CLOSURE(CreateClosure, UINT16_MAX)
+      REWRITE_CLOSURE(CreateClosureLongIndex, UINT32_MAX)
+      REWRITE_CLOSURE(CreateGeneratorClosure, UINT16_MAX)
+      REWRITE_CLOSURE(CreateGeneratorClosureLongIndex, UINT32_MAX)
+      REWRITE_CLOSURE(CreateGenerator, UINT16_MAX)
+      REWRITE_CLOSURE(CreateGeneratorLongIndex, UINT32_MAX)
+#undef REWRITE_CLOSURE
+      default:
+        break;
+    }
+    offset += inst::getInstSize(ip->opCode);
+  }
+
+  // Lazy functions have no bytecode yet.
+  if (BF.isLazy() || (BF.hasDebugInfo() && !mergeDebugInfo_))
+    return id;
+  auto result = functionsByKey_.emplace(key(BF), id);
+  return canonical_[id] = result.first->second;
+}
+
+std::string IdenticalFunctionMerger::key(const BytecodeFunction &BF) {
+  const FunctionHeader &header = BF.getHeader();
+  ArrayRef<opcode_atom_t> opcodes = BF.getOpcodeArray();
+  ArrayRef<uint32_t> jumpTables = BF.getJumpTables();
+  ArrayRef<HBCExceptionHandlerInfo> exceptions = BF.getExceptionHandlers();
+  const uint32_t fields[] = {header.paramCount,
+                             header.functionName,
+                             header.frameSize,
+                             header.environmentSize,
+                             header.highestReadCacheIndex,
+                             header.highestWriteCacheIndex,
+                             header.flags.flags,
+                             (uint32_t)opcodes.size(),
+                             (uint32_t)jumpTables.size(),
+                             (uint32_t)exceptions.size()};
+
+  std::string result;
+  auto append = [&result](const void *data, size_t size) {
+    result.append(static_cast<const char *>(data), size);
+  };
+  append(fields, sizeof(fields));
+  append(opcodes.data(), opcodes.size());
+  append(jumpTables.data(), jumpTables.size() * sizeof(uint32_t));
+  append(
+      exceptions.data(), exceptions.size() * sizeof(HBCExceptionHandlerInfo));
+  return result;
+}
+
+} // namespace
+
 std::unique_ptr<BytecodeModule> BytecodeModuleGenerator::generate() {
   assert(
       valid_ &&
@@ -277,6 +389,10 @@ std::unique_ptr<BytecodeModule> BytecodeModuleGenerator::generate() {
     BM->setFunction(i, std::move(func));
   }
 
+  if (options_.optimizationEnabled) {
+    IdenticalFunctionMerger(*BM, options_.stripDebugInfoSection).run();
+  }
+
   BM->setDebugInfo(debugInfoGen.serializeWithMove());
   return BM;
 }
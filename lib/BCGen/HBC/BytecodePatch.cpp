@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/BCGen/HBC/BytecodePatch.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace hermes;
+using namespace hermes::hbc;
+
+namespace {
+
+/// The bit of the first word of an operation set when its bytes are in the
+/// patch.
+constexpr uint32_t kLiteralBit = 1u << 31;
+
+/// The largest length of an operation.
+constexpr uint32_t kMaxOpLength = kLiteralBit - 1;
+
+/// Copies shorter than this are stored in the patch instead, since they would
+/// take more space in it than their bytes.
+constexpr uint32_t kMinCopyLength = 2 * sizeof(uint32_t);
+
+/// An operation of a patch being created.
+struct PatchOp {
+  /// Whether the bytes are stored in the patch rather than copied.
+  bool literal;
+  /// The offset of the bytes in the new file if literal, in the base file
+  /// otherwise.
+  uint32_t offset;
+  uint32_t length;
+};
+
+/// \return the offsets at which the regions of the bytecode file \p bytes
+/// start, sorted, followed by the length of the file.  The regions are the
+/// sections of the file, the body and large header of every function, and
+/// every string in the string storage, along with the bytes between them.
+/// A file that cannot be interpreted is a single region.
+std::vector<uint32_t> findRegions(llvm::ArrayRef<uint8_t> bytes) {
+  std::vector<uint32_t> starts{0};
+  auto addRange = [&starts, &bytes](const void *data, size_t size) {
+    size_t start = reinterpret_cast<const uint8_t *>(data) - bytes.data();
+    if (size == 0 || start + size > bytes.size())
+      return;
+    starts.push_back(start);
+    starts.push_back(start + size);
+  };
+  auto addOffsetRange = [&addRange, &bytes](size_t offset, size_t size) {
+    if (offset <= bytes.size())
+      addRange(bytes.data() + offset, size);
+  };
+
+  ConstBytecodeFileFields fields;
+  std::string error;
+  if (bytes.size() >= sizeof(BytecodeFileHeader) &&
+      fields.populateFromBuffer(bytes, &error) &&
+      fields.header->fileLength == bytes.size()) {
+    addRange(fields.header, sizeof(BytecodeFileHeader));
+    addRange(
+        fields.functionHeaders.data(),
+        fields.functionHeaders.size() * sizeof(SmallFuncHeader));
+    addRange(
+        fields.stringKinds.data(),
+        fields.stringKinds.size() * sizeof(StringKind::Entry));
+    addRange(
+        fields.identifierTranslations.data(),
+        fields.identifierTranslations.size() * sizeof(uint32_t));
+    addRange(
+        fields.stringTableEntries.data(),
+        fields.stringTableEntries.size() * sizeof(SmallStringTableEntry));
+    addRange(
+        fields.stringTableOverflowEntries.data(),
+        fields.stringTableOverflowEntries.size() *
+            sizeof(OverflowStringTableEntry));
+    addRange(fields.stringStorage.data(), fields.stringStorage.size());
+    addRange(fields.arrayBuffer.data(), fields.arrayBuffer.size());
+    addRange(fields.objKeyBuffer.data(), fields.objKeyBuffer.size());
+    addRange(fields.objValueBuffer.data(), fields.objValueBuffer.size());
+    addRange(
+        fields.regExpTable.data(),
+        fields.regExpTable.size() * sizeof(RegExpTableEntry));
+    addRange(fields.regExpStorage.data(), fields.regExpStorage.size());
+    addRange(
+        fields.cjsModuleTable.data(),
+        fields.cjsModuleTable.size() * sizeof(std::pair<uint32_t, uint32_t>));
+    addRange(
+        fields.cjsModuleTableStatic.data(),
+        fields.cjsModuleTableStatic.size() * sizeof(uint32_t));
+
+    // Split the string storage at every string, so that adding a string only
+    // stores that string in the patch.
+    size_t storageStart = reinterpret_cast<const uint8_t *>(
+                              fields.stringStorage.data()) -
+        bytes.data();
+    for (const SmallStringTableEntry &entry : fields.stringTableEntries) {
+      uint32_t offset = entry.offset;
+      if (entry.isOverflowed()) {
+        if (offset >= fields.stringTableOverflowEntries.size())
+          continue;
+        offset = fields.stringTableOverflowEntries[offset].offset;
+      }
+      if (offset < fields.stringStorage.size())
+        starts.push_back(storageStart + offset);
+    }
+
+    for (const SmallFuncHeader &sfh : fields.functionHeaders) {
+      if (sfh.flags.overflowed) {
+        size_t largeOffset = sfh.getLargeHeaderOffset();
+        if (largeOffset + sizeof(FunctionHeader) > bytes.size())
+          continue;
+        addOffsetRange(largeOffset, sizeof(FunctionHeader));
+        const auto *fh =
+            reinterpret_cast<const FunctionHeader *>(&bytes[largeOffset]);
+        addOffsetRange(fh->offset, fh->bytecodeSizeInBytes);
+      } else {
+        addOffsetRange(sfh.offset, sfh.bytecodeSizeInBytes);
+      }
+    }
+
+    if (fields.header->debugInfoOffset < bytes.size())
+      starts.push_back(fields.header->debugInfoOffset);
+  }
+
+  starts.push_back(bytes.size());
+  std::sort(starts.begin(), starts.end());
+  starts.erase(std::unique(starts.begin(), starts.end()), starts.end());
+  return starts;
+}
+
+/// \return the bytes of \p bytes from \p start to \p end as a StringRef, to
+/// be used as a key.
+llvm::StringRef regionContents(
+    llvm::ArrayRef<uint8_t> bytes,
+    uint32_t start,
+    uint32_t end) {
+  return llvm::StringRef(
+      reinterpret_cast<const char *>(bytes.data()) + start, end - start);
+}
+
+/// Append \p op to \p ops, merging it with the last operation when they
+/// cover contiguous bytes.
+void appendOp(std::vector<PatchOp> &ops, PatchOp op) {
+  if (!ops.empty()) {
+    PatchOp &last = ops.back();
+    if (last.literal == op.literal && last.offset + last.length == op.offset &&
+        last.length <= kMaxOpLength - op.length) {
+      last.length += op.length;
+      return;
+    }
+  }
+  ops.push_back(op);
+}
+
+void appendUInt32(std::vector<uint8_t> &patch, uint32_t value) {
+  uint8_t bytes[sizeof(uint32_t)];
+  std::memcpy(bytes, &value, sizeof(uint32_t));
+  patch.insert(patch.end(), bytes, bytes + sizeof(uint32_t));
+}
+
+/// Read a uint32_t at \p cursor in \p patch, and advance \p cursor past it.
+/// \return false if \p patch ends before it.
+bool readUInt32(
+    llvm::ArrayRef<uint8_t> patch,
+    size_t &cursor,
+    uint32_t &value) {
+  if (patch.size() - cursor < sizeof(uint32_t))
+    return false;
+  std::memcpy(&value, patch.data() + cursor, sizeof(uint32_t));
+  cursor += sizeof(uint32_t);
+  return true;
+}
+
+/// \return the source hash of \p bytes, which must be at least as long as a
+/// file header.
+llvm::ArrayRef<uint8_t> sourceHashOf(llvm::ArrayRef<uint8_t> bytes) {
+  return reinterpret_cast<const BytecodeFileHeader *>(bytes.data())
+      ->sourceHash;
+}
+
+} // namespace
+
+namespace hermes {
+namespace hbc {
+
+bool createBytecodePatch(
+    llvm::ArrayRef<uint8_t> base,
+    llvm::ArrayRef<uint8_t> newFile,
+    std::vector<uint8_t> &patch,
+    std::string *outError) {
+  if (base.size() < sizeof(BytecodeFileHeader) ||
+      newFile.size() < sizeof(BytecodeFileHeader)) {
+    if (outError) {
+      *outError = "Buffer too small";
+    }
+    return false;
+  }
+
+  // Index the regions of the base file by their contents.
+  llvm::DenseMap<llvm::StringRef, uint32_t> baseRegions;
+  std::vector<uint32_t> baseStarts = findRegions(base);
+  for (size_t i = 0, e = baseStarts.size() - 1; i < e; ++i) {
+    baseRegions.insert(
+        {regionContents(base, baseStarts[i], baseStarts[i + 1]),
+         baseStarts[i]});
+  }
+
+  std::vector<PatchOp> ops;
+  std::vector<uint32_t> newStarts = findRegions(newFile);
+  for (size_t i = 0, e = newStarts.size() - 1; i < e; ++i) {
+    uint32_t start = newStarts[i];
+    uint32_t length = newStarts[i + 1] - start;
+    llvm::StringRef contents = regionContents(newFile, start, start + length);
+    // Regions usually follow the same regions as in the base file, so try
+    // extending the last copy first.
+    if (!ops.empty() && !ops.back().literal) {
+      uint32_t next = ops.back().offset + ops.back().length;
+      if (length <= base.size() - next &&
+          regionContents(base, next, next + length) == contents) {
+        appendOp(ops, {false, next, length});
+        continue;
+      }
+    }
+    auto it = baseRegions.find(contents);
+    if (it != baseRegions.end()) {
+      appendOp(ops, {false, it->second, length});
+    } else {
+      appendOp(ops, {true, start, length});
+    }
+  }
+
+  // Store the copies that are too short to be worth it in the patch.
+  std::vector<PatchOp> finalOps;
+  uint32_t newOffset = 0;
+  for (const PatchOp &op : ops) {
+    if (!op.literal && op.length < kMinCopyLength) {
+      appendOp(finalOps, {true, newOffset, op.length});
+    } else {
+      appendOp(finalOps, op);
+    }
+    newOffset += op.length;
+  }
+
+  BytecodePatchHeader header;
+  header.magic = PATCH_MAGIC;
+  header.version = PATCH_VERSION;
+  std::copy_n(
+      sourceHashOf(base).begin(), SHA1_NUM_BYTES, header.baseSourceHash);
+  header.baseFileLength = base.size();
+  header.newFileLength = newFile.size();
+  header.opCount = finalOps.size();
+  const uint8_t *headerBytes = reinterpret_cast<const uint8_t *>(&header);
+  patch.insert(patch.end(), headerBytes, headerBytes + sizeof(header));
+  for (const PatchOp &op : finalOps) {
+    if (op.literal) {
+      appendUInt32(patch, op.length | kLiteralBit);
+      patch.insert(
+          patch.end(),
+          newFile.begin() + op.offset,
+          newFile.begin() + op.offset + op.length);
+    } else {
+      appendUInt32(patch, op.length);
+      appendUInt32(patch, op.offset);
+    }
+  }
+  return true;
+}
+
+bool applyBytecodePatch(
+    llvm::ArrayRef<uint8_t> base,
+    llvm::ArrayRef<uint8_t> patch,
+    llvm::raw_ostream &os,
+    std::string *outError) {
+  auto fail = [outError](const char *message) {
+    if (outError) {
+      *outError = message;
+    }
+    return false;
+  };
+
+  if (patch.size() < sizeof(BytecodePatchHeader)) {
+    return fail("Patch too small");
+  }
+  BytecodePatchHeader header;
+  std::memcpy(&header, patch.data(), sizeof(header));
+  if (header.magic != PATCH_MAGIC) {
+    return fail("Incorrect magic number");
+  }
+  if (header.version != PATCH_VERSION) {
+    return fail("Wrong patch version");
+  }
+  if (base.size() < sizeof(BytecodeFileHeader) ||
+      header.baseFileLength != base.size() ||
+      !std::equal(
+          sourceHashOf(base).begin(),
+          sourceHashOf(base).end(),
+          header.baseSourceHash)) {
+    return fail("The patch was created for a different base file");
+  }
+
+  size_t cursor = sizeof(header);
+  uint64_t written = 0;
+  for (uint32_t i = 0; i < header.opCount; ++i) {
+    uint32_t word;
+    if (!readUInt32(patch, cursor, word)) {
+      return fail("Truncated patch");
+    }
+    uint32_t length = word & ~kLiteralBit;
+    if (written + length > header.newFileLength) {
+      return fail("The patch creates a file longer than expected");
+    }
+    if (word & kLiteralBit) {
+      if (patch.size() - cursor < length) {
+        return fail("Truncated patch");
+      }
+      os.write(reinterpret_cast<const char *>(patch.data() + cursor), length);
+      cursor += length;
+    } else {
+      uint32_t offset;
+      if (!readUInt32(patch, cursor, offset)) {
+        return fail("Truncated patch");
+      }
+      if (offset > base.size() || length > base.size() - offset) {
+        return fail("The patch copies bytes outside of the base file");
+      }
+      os.write(reinterpret_cast<const char *>(base.data() + offset), length);
+    }
+    written += length;
+  }
+  if (cursor != patch.size()) {
+    return fail("Unexpected data after the end of the patch");
+  }
+  if (written != header.newFileLength) {
+    return fail("The patch creates a file shorter than expected");
+  }
+  return true;
+}
+
+} // namespace hbc
+} // namespace hermes
@@ -124,10 +124,14 @@ BCProviderFromSrc::createBCProviderFromSrc(
 
   auto parserMode = parser::FullParse;
   bool useStaticBuiltinDetected = false;
+  bool preParsed = false;
   if (context->isLazyCompilation()) {
-    if (!parser::JSParser::preParseBuffer(
-            *context, fileBufId, useStaticBuiltinDetected)) {
-      return {nullptr, outputManager.getErrorString()};
+    if (!compileFlags.lazySkipPreParse) {
+      if (!parser::JSParser::preParseBuffer(
+              *context, fileBufId, useStaticBuiltinDetected)) {
+        return {nullptr, outputManager.getErrorString()};
+      }
+      preParsed = true;
     }
     parserMode = parser::LazyParse;
   }
@@ -138,9 +142,9 @@ BCProviderFromSrc::createBCProviderFromSrc(
   if (!parsed || !hermes::sem::validateAST(*context, semCtx, *parsed)) {
     return {nullptr, outputManager.getErrorString()};
   }
-  // If we are using lazy parse mode, we should have already detected the 'use
+  // If we pre-parsed the buffer, we should have already detected the 'use
   // static builtin' directive in the pre-parsing stage.
-  if (parserMode != parser::LazyParse) {
+  if (!preParsed) {
     useStaticBuiltinDetected = parser.getUseStaticBuiltin();
   }
   // The compiler flag is not set, automatically detect 'use static builtin'
@@ -6,6 +6,8 @@
  */
 #include "hermes/BCGen/HBC/BytecodeStream.h"
 
+#include "llvm/ADT/BitVector.h"
+
 using namespace hermes;
 using namespace hbc;
 
@@ -41,8 +43,8 @@ void BytecodeSerializer::serialize(BytecodeModule &BM, const SHA1 &sourceHash) {
   visitBytecodeSegmentsInOrder(*this);
   serializeFunctionsBytecode(BM);
 
-  for (auto &entry : BM.getFunctionTable()) {
-    serializeFunctionInfo(*entry);
+  for (BytecodeFunction *BF : functionsInLayoutOrder(BM)) {
+    serializeFunctionInfo(*BF);
   }
 
   serializeDebugInfo(BM);
@@ -152,12 +154,32 @@ void BytecodeSerializer::serializeDebugOffsets(BytecodeFunction &BF) {
 }
 
 // ============================ Function ============================
+std::vector<BytecodeFunction *> BytecodeSerializer::functionsInLayoutOrder(
+    BytecodeModule &BM) {
+  const auto &functions = BM.getFunctionTable();
+  std::vector<BytecodeFunction *> order;
+  order.reserve(functions.size());
+  llvm::BitVector placed(functions.size());
+  for (uint32_t id : options_.functionOrder) {
+    if (id < functions.size() && !placed.test(id)) {
+      placed.set(id);
+      order.push_back(functions[id].get());
+    }
+  }
+  for (uint32_t id = 0, e = functions.size(); id < e; ++id) {
+    if (!placed.test(id)) {
+      order.push_back(functions[id].get());
+    }
+  }
+  return order;
+}
+
 void BytecodeSerializer::serializeFunctionsBytecode(BytecodeModule &BM) {
   // Map from opcodes and jumptables to offsets, used to deduplicate bytecode.
   using DedupKey =
       std::pair<llvm::ArrayRef<opcode_atom_t>, llvm::ArrayRef<uint32_t>>;
   llvm::DenseMap<DedupKey, uint32_t> bcMap;
-  for (auto &entry : BM.getFunctionTable()) {
+  for (BytecodeFunction *entry : functionsInLayoutOrder(BM)) {
     if (options_.optimizationEnabled) {
       // If identical bytecode exists, we'll reuse it.
       bool reuse = false;
@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <climits>
 #include <deque>
+#include <thread>
 
 using namespace hermes;
 using llvm::ArrayRef;
@@ -40,6 +41,10 @@ constexpr size_t npos = ~size_t(0);
 /// Longest string that we'll attempt to pack.
 constexpr size_t kMaximumPackableStringLength = 24 * 1024;
 
+/// Fewest UTF-16 strings for which the optimizing packer handles them on their
+/// own thread, concurrently with the ASCII strings.
+constexpr size_t kMinStringsToPackInParallel = 256;
+
 /// A helper class responsible for deciding how to "pack" strings, that is, lay
 /// out strings in a linear array suitable for ConsecutiveStringStorage. It is
 /// templated on the character type (char or char16_t).
@@ -76,9 +81,13 @@ class StringPacker {
     /// The amount that our chars_ overlaps with prev_->chars_.
     size_t overlapAmount_ = 0;
 
-    /// Entries that may not be set as our next_, because they would introduce
-    /// a cycle.
-    llvm::DenseSet<const StringEntry *> potentialCycles_;
+    /// If we are the last string of a chain of next_ links, its first string.
+    /// Only valid if we have no next_, and null if we have no prev_ either.
+    StringEntry *chainStart_ = nullptr;
+
+    /// If we are the first string of a chain of next_ links, its last string.
+    /// Only valid if we have no prev_, and null if we have no next_ either.
+    StringEntry *chainEnd_ = nullptr;
 
     StringEntry(uint32_t stringID, ArrayRef<CharT> chars)
         : stringID_(stringID), chars_(chars) {}
@@ -392,8 +401,9 @@ class StringPacker {
     if (src->next_ || dst->prev_)
       return false;
 
-    // Would forming src->dst create a cycle?
-    if (src->potentialCycles_.count(dst))
+    // Would forming src->dst create a cycle? src ends its chain and dst
+    // starts one, so only if they are the ends of the same chain.
+    if (src->chainStart_ == dst)
       return false;
 
     // This edge is OK!
@@ -424,15 +434,13 @@ class StringPacker {
             dst->prev_ = src;
             dst->overlapAmount_ = overlapAmount;
 
-            // Traverse to the start and end of our new chain, and mark the fact
-            // that end->start is prohibited because it would produce a cycle.
-            StringEntry *end = dst;
-            while (end->next_)
-              end = end->next_;
-            StringEntry *start = src;
-            while (start->prev_)
-              start = start->prev_;
-            end->potentialCycles_.insert(start);
+            // Link the start and end of our new chain, so that end->start,
+            // which would produce a cycle, is prohibited without traversing
+            // the chain.
+            StringEntry *start = src->chainStart_ ? src->chainStart_ : src;
+            StringEntry *end = dst->chainEnd_ ? dst->chainEnd_ : dst;
+            start->chainEnd_ = end;
+            end->chainStart_ = start;
 
             // We picked an entry to come before dst, so we're done with dst.
             break;
@@ -627,8 +635,22 @@ class StringTableBuilder {
         AreStatisticsEnabled());
     // Note these assignments use efficient move-assignment, not copying.
     if (optimize) {
+      // The two alphabets are packed independently, so pack the UTF-16
+      // strings on another thread if there are enough of them to be worth it.
+      std::thread u16Thread;
+      if (u16Strings_.size() >= kMinStringsToPackInParallel) {
+        u16Thread = std::thread([this, u16Storage] {
+          *u16Storage =
+              StringPacker<char16_t>::optimizingPackStrings(u16Strings_);
+        });
+      }
       *asciiStorage = StringPacker<char>::optimizingPackStrings(asciiStrings_);
-      *u16Storage = StringPacker<char16_t>::optimizingPackStrings(u16Strings_);
+      if (u16Thread.joinable()) {
+        u16Thread.join();
+      } else {
+        *u16Storage =
+            StringPacker<char16_t>::optimizingPackStrings(u16Strings_);
+      }
     } else {
       *asciiStorage = StringPacker<char>::fastPackStrings(asciiStrings_);
       *u16Storage = StringPacker<char16_t>::fastPackStrings(u16Strings_);
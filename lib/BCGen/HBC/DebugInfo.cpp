@@ -9,6 +9,8 @@
 #include "hermes/BCGen/HBC/ConsecutiveStringStorage.h"
 #include "hermes/SourceMap/SourceMapGenerator.h"
 
+#include <algorithm>
+
 using namespace hermes;
 using namespace hbc;
 
@@ -116,20 +118,68 @@ OptValue<uint32_t> DebugInfo::getFilenameForAddress(
   return value;
 }
 
+const std::vector<DebugInfo::FunctionLocation> *
+DebugInfo::getFunctionLocations(uint32_t debugOffset) const {
+  auto it = functionLocations_.find(debugOffset);
+  if (it == functionLocations_.end()) {
+    std::vector<FunctionLocation> locations;
+    FunctionDebugInfoDeserializer fdid(data_.getData(), debugOffset);
+    locations.push_back({fdid.getCurrent(), debugOffset});
+    uint32_t nextLocationOffset = fdid.getOffset();
+    while (auto loc = fdid.next()) {
+      locations.push_back({*loc, nextLocationOffset});
+      nextLocationOffset = fdid.getOffset();
+    }
+    // Locations are emitted in the order of the instructions, but only search
+    // them if they really are sorted.
+    bool sorted = std::is_sorted(
+        locations.begin(),
+        locations.end(),
+        [](const FunctionLocation &a, const FunctionLocation &b) {
+          return a.location.address < b.location.address;
+        });
+    if (!sorted || locations.size() <= kMinIndexedFunctionLocations) {
+      locations.clear();
+    }
+    locations.shrink_to_fit();
+    it = functionLocations_.try_emplace(debugOffset, std::move(locations))
+             .first;
+  }
+  return it->second.empty() ? nullptr : &it->second;
+}
+
 OptValue<DebugSourceLocation> DebugInfo::getLocationForAddress(
     uint32_t debugOffset,
     uint32_t offsetInFunction) const {
   assert(debugOffset < data_.size() && "Debug offset out of range");
-  FunctionDebugInfoDeserializer fdid(data_.getData(), debugOffset);
-  DebugSourceLocation lastLocation = fdid.getCurrent();
-  uint32_t lastLocationOffset = debugOffset;
-  uint32_t nextLocationOffset = fdid.getOffset();
-  while (auto loc = fdid.next()) {
-    if (loc->address > offsetInFunction)
-      break;
-    lastLocation = *loc;
-    lastLocationOffset = nextLocationOffset;
-    nextLocationOffset = fdid.getOffset();
+  DebugSourceLocation lastLocation;
+  uint32_t lastLocationOffset;
+  if (const auto *locations = getFunctionLocations(debugOffset)) {
+    // Find the last location at or before offsetInFunction. The first
+    // location is at address 0, so there always is one.
+    auto it = std::upper_bound(
+        locations->begin(),
+        locations->end(),
+        offsetInFunction,
+        [](uint32_t address, const FunctionLocation &loc) {
+          return address < loc.location.address;
+        });
+    assert(it != locations->begin() && "no location at address 0");
+    --it;
+    lastLocation = it->location;
+    lastLocationOffset = it->offset;
+  } else {
+    FunctionDebugInfoDeserializer fdid(data_.getData(), debugOffset);
+    lastLocation = fdid.getCurrent();
+    lastLocationOffset = debugOffset;
+    uint32_t nextLocationOffset = fdid.getOffset();
+    while (auto loc = fdid.next()) {
+      if (loc->address > offsetInFunction)
+        break;
+      lastLocation = *loc;
+      lastLocationOffset = nextLocationOffset;
+      nextLocationOffset = fdid.getOffset();
+    }
   }
   if (auto file = getFilenameForAddress(lastLocationOffset)) {
     lastLocation.address = offsetInFunction;
@@ -139,10 +189,14 @@ OptValue<DebugSourceLocation> DebugInfo::getLocationForAddress(
   return llvm::None;
 }
 
-OptValue<DebugSearchResult> DebugInfo::getAddressForLocation(
-    uint32_t filenameId,
-    uint32_t targetLine,
-    OptValue<uint32_t> targetColumn) const {
+const std::vector<DebugInfo::FileLocation> &DebugInfo::getFileLocations(
+    uint32_t filenameId) const {
+  auto it = fileLocations_.find(filenameId);
+  if (it != fileLocations_.end()) {
+    return it->second;
+  }
+
+  std::vector<FileLocation> locations;
   // First, get the start/end debug offsets for the given file.
   uint32_t start = 0;
   uint32_t end = 0;
@@ -162,27 +216,46 @@ OptValue<DebugSearchResult> DebugInfo::getAddressForLocation(
       end = lexicalDataOffset_;
     }
   }
-  if (!foundFile) {
-    return llvm::None;
-  }
 
   unsigned offset = start;
-
-  while (offset < end) {
+  while (foundFile && offset < end) {
     FunctionDebugInfoDeserializer fdid(data_.getData(), offset);
     while (auto loc = fdid.next()) {
-      uint32_t line = loc->line;
-      uint32_t column = loc->column;
-      if (line == targetLine &&
-          (!targetColumn.hasValue() || column == *targetColumn)) {
-        // Short-circuit on a precise match.
-        return DebugSearchResult(
-            fdid.getFunctionIndex(), loc->address, line, column);
-      }
+      locations.push_back(
+          {loc->line, loc->column, fdid.getFunctionIndex(), loc->address});
     }
     offset = fdid.getOffset();
   }
 
+  // Keep the order of the data within a line, so that searches find the same
+  // location as a scan would.
+  std::stable_sort(
+      locations.begin(),
+      locations.end(),
+      [](const FileLocation &a, const FileLocation &b) {
+        return a.line < b.line;
+      });
+  locations.shrink_to_fit();
+  return fileLocations_.try_emplace(filenameId, std::move(locations))
+      .first->second;
+}
+
+OptValue<DebugSearchResult> DebugInfo::getAddressForLocation(
+    uint32_t filenameId,
+    uint32_t targetLine,
+    OptValue<uint32_t> targetColumn) const {
+  const std::vector<FileLocation> &locations = getFileLocations(filenameId);
+  auto it = std::lower_bound(
+      locations.begin(),
+      locations.end(),
+      targetLine,
+      [](const FileLocation &loc, uint32_t line) { return loc.line < line; });
+  for (; it != locations.end() && it->line == targetLine; ++it) {
+    if (!targetColumn.hasValue() || it->column == *targetColumn) {
+      return DebugSearchResult(
+          it->functionIndex, it->address, it->line, it->column);
+    }
+  }
   return llvm::None;
 }
 
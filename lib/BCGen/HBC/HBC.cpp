@@ -26,10 +26,18 @@
 #include "hermes/Optimizer/PassManager/Pass.h"
 #include "hermes/Optimizer/PassManager/PassManager.h"
 #include "hermes/Support/PerfSection.h"
+#include "hermes/Support/Statistic.h"
 #include "hermes/Support/UTF8.h"
 
 #define DEBUG_TYPE "hbc-backend"
 
+STATISTIC(
+    NumReleasedFunctions,
+    "Number of functions whose IR was released after generating bytecode");
+STATISTIC(
+    NumReleasedInsts,
+    "Number of instructions released after generating bytecode");
+
 using namespace hermes;
 using namespace hbc;
 
@@ -48,7 +56,7 @@ const uint64_t kRegisterAllocationMemoryLimit = 10L * 1024 * 1024;
 
 void lowerIR(Module *M, const BytecodeGenerationOptions &options) {
   PassManager PM;
-  PM.addPass(new LowerLoadStoreFrameInst());
+  PM.addPass(new LowerLoadStoreFrameInst(options.optimizationEnabled));
   if (options.optimizationEnabled) {
     // OptEnvironmentInit needs to run before LowerConstants.
     PM.addPass(new OptEnvironmentInit());
@@ -64,6 +72,7 @@ void lowerIR(Module *M, const BytecodeGenerationOptions &options) {
   PM.addPass(new DedupReifyArguments());
   PM.addPass(new LowerSwitchIntoJumpTables());
   PM.addPass(new SwitchLowering());
+  PM.addPass(new FuseTypeOfComparisons());
   PM.addPass(new LoadConstants(options.optimizationEnabled));
   PM.addPass(new LoadParameters());
   if (options.optimizationEnabled) {
@@ -80,6 +89,9 @@ void lowerIR(Module *M, const BytecodeGenerationOptions &options) {
     PM.addCSE();
     // Drop unused HBCLoadParamInsts.
     PM.addDCE();
+    // Now that the number of users of each environment is final, load from
+    // the ones that are used once without materializing them.
+    PM.addPass(new FuseOuterEnvironmentLoads());
   }
 
   // Move StartGenerator instructions to the start of functions.
@@ -137,7 +149,12 @@ std::unique_ptr<BytecodeModule> hbc::generateBytecodeModule(
     SourceMapGenerator *sourceMapGen,
     std::unique_ptr<BCProviderBase> baseBCProvider) {
   PerfSection perf("Bytecode Generation");
-  lowerIR(M, options);
+  // Lowering works on the whole module, so when the module is generated one
+  // segment at a time, only do it for the first segment.
+  if (!M->isLowered()) {
+    lowerIR(M, options);
+    M->setLowered(true);
+  }
 
   if (options.format == DumpLIR)
     M->dump();
@@ -218,6 +235,19 @@ std::unique_ptr<BytecodeModule> hbc::generateBytecodeModule(
 
   // Construct the relative function scope depth map.
   FunctionScopeAnalysis scopeAnalysis{entryPoint};
+
+  // When the whole module is generated at once, the IR of a function is not
+  // needed after its bytecode has been generated, so it is released then
+  // instead of with the module, which bounds the peak memory by the largest
+  // function rather than by the whole program. The scope analysis finds the
+  // parent of a function through the instruction creating it, so it must be
+  // computed for all functions first.
+  const bool releaseIR = !range;
+  if (releaseIR) {
+    for (auto &F : *M)
+      scopeAnalysis.getLexicalParent(&F);
+  }
+
   // Bytecode generation for each function.
   for (auto &F : *M) {
     if (!shouldGenerate(&F)) {
@@ -234,6 +264,7 @@ std::unique_ptr<BytecodeModule> hbc::generateBytecodeModule(
         RA.setFastPassThreshold(kFastRegisterAllocationThreshold);
         RA.setMemoryLimit(kRegisterAllocationMemoryLimit);
       }
+      RA.setLinearScanThreshold(options.linearScanThreshold);
       PostOrderAnalysis PO(&F);
       /// The order of the blocks is reverse-post-order, which is a simply
       /// topological sort.
@@ -273,6 +304,13 @@ std::unique_ptr<BytecodeModule> hbc::generateBytecodeModule(
     }
 
     BMGen.setFunctionGenerator(&F, std::move(funcGen));
+
+    if (releaseIR) {
+      ++NumReleasedFunctions;
+      for (auto &BB : F)
+        NumReleasedInsts += BB.getInstList().size();
+      F.eraseBody();
+    }
   }
 
   return BMGen.generate();
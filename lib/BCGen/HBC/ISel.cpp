@@ -469,16 +469,32 @@ void HBCISel::generateBinaryOperatorInst(
       BCFGen_->emitStrictNeq(res, left, right);
       break;
     case OpKind::LessThanKind: // <
-      BCFGen_->emitLess(res, left, right);
+      if (isBothNumber) {
+        BCFGen_->emitLessN(res, left, right);
+      } else {
+        BCFGen_->emitLess(res, left, right);
+      }
       break;
     case OpKind::LessThanOrEqualKind: // <=
-      BCFGen_->emitLessEq(res, left, right);
+      if (isBothNumber) {
+        BCFGen_->emitLessEqN(res, left, right);
+      } else {
+        BCFGen_->emitLessEq(res, left, right);
+      }
       break;
     case OpKind::GreaterThanKind: // >
-      BCFGen_->emitGreater(res, left, right);
+      if (isBothNumber) {
+        BCFGen_->emitGreaterN(res, left, right);
+      } else {
+        BCFGen_->emitGreater(res, left, right);
+      }
       break;
     case OpKind::GreaterThanOrEqualKind: // >=
-      BCFGen_->emitGreaterEq(res, left, right);
+      if (isBothNumber) {
+        BCFGen_->emitGreaterEqN(res, left, right);
+      } else {
+        BCFGen_->emitGreaterEq(res, left, right);
+      }
       break;
     case OpKind::LeftShiftKind: // <<  (<<=)
       BCFGen_->emitLShift(res, left, right);
@@ -533,7 +549,8 @@ void HBCISel::generateBinaryOperatorInst(
       BCFGen_->emitIsIn(res, left, right);
       break;
     case OpKind::InstanceOfKind: // instanceof
-      BCFGen_->emitInstanceOf(res, left, right);
+      BCFGen_->emitInstanceOf(
+          res, left, right, acquireInstanceOfCacheIndex());
       break;
 
     default:
@@ -550,12 +567,16 @@ void HBCISel::generateStorePropertyInst(
   if (auto *Lit = dyn_cast<LiteralString>(prop)) {
     // Property is a string
     auto id = BCFGen_->getIdentifierID(Lit);
-    if (id <= UINT16_MAX)
+    if (id > UINT16_MAX) {
+      BCFGen_->emitPutByIdLong(
+          objReg, valueReg, acquirePropertyWriteCacheIndex(id), id);
+    } else if (id > UINT8_MAX) {
       BCFGen_->emitPutById(
           objReg, valueReg, acquirePropertyWriteCacheIndex(id), id);
-    else
-      BCFGen_->emitPutByIdLong(
+    } else {
+      BCFGen_->emitPutByIdShort(
           objReg, valueReg, acquirePropertyWriteCacheIndex(id), id);
+    }
     return;
   }
 
@@ -887,6 +908,26 @@ void HBCISel::generateThrowIfUndefinedInst(
     hermes::BasicBlock *next) {
   BCFGen_->emitThrowIfUndefinedInst(encodeValue(Inst->getCheckedValue()));
 }
+void HBCISel::generateIteratorBeginInst(
+    hermes::IteratorBeginInst *Inst,
+    hermes::BasicBlock *next) {
+  BCFGen_->emitIteratorBegin(
+      encodeValue(Inst), encodeValue(Inst->getSourceOrNext()));
+}
+void HBCISel::generateIteratorNextInst(
+    hermes::IteratorNextInst *Inst,
+    hermes::BasicBlock *next) {
+  BCFGen_->emitIteratorNext(
+      encodeValue(Inst),
+      encodeValue(Inst->getIterator()),
+      encodeValue(Inst->getSourceOrNext()));
+}
+void HBCISel::generateIteratorCloseInst(
+    hermes::IteratorCloseInst *Inst,
+    hermes::BasicBlock *next) {
+  BCFGen_->emitIteratorClose(
+      encodeValue(Inst->getIterator()), Inst->getIgnoreInnerException());
+}
 void HBCISel::generateSwitchInst(SwitchInst *Inst, BasicBlock *next) {
   llvm_unreachable("SwitchInst should have been lowered");
 }
@@ -1204,27 +1245,33 @@ void HBCISel::generateHBCCallDirectInst(
     BCFGen_->emitCallDirectLongIndex(output, Inst->getNumArguments(), code);
   }
 }
-void HBCISel::generateHBCResolveEnvironment(
-    HBCResolveEnvironment *Inst,
-    BasicBlock *next) {
+Optional<uint32_t> HBCISel::getEnvironmentLevel(VariableScope *scope) {
   // We statically determine the relative depth delta of the current scope
   // and the scope that the variable belongs to. Such delta is used as
   // the operand to get_scope instruction.
-  VariableScope *instScope = Inst->getScope();
-  Optional<int32_t> instScopeDepth = scopeAnalysis_.getScopeDepth(instScope);
+  Optional<int32_t> instScopeDepth = scopeAnalysis_.getScopeDepth(scope);
   Optional<int32_t> curScopeDepth =
       scopeAnalysis_.getScopeDepth(F_->getFunctionScope());
   if (!instScopeDepth || !curScopeDepth) {
     // the function did not have any CreateFunctionInst, this function is dead.
-    emitUnreachableIfDebug();
-    return;
+    return llvm::None;
   }
   assert(
       curScopeDepth && curScopeDepth.getValue() >= instScopeDepth.getValue() &&
       "Cannot access variables in inner scopes");
   int32_t delta = curScopeDepth.getValue() - instScopeDepth.getValue();
   assert(delta > 0 && "HBCResolveEnvironment for current scope");
-  BCFGen_->emitGetEnvironment(encodeValue(Inst), delta - 1);
+  return delta - 1;
+}
+void HBCISel::generateHBCResolveEnvironment(
+    HBCResolveEnvironment *Inst,
+    BasicBlock *next) {
+  Optional<uint32_t> level = getEnvironmentLevel(Inst->getScope());
+  if (!level) {
+    emitUnreachableIfDebug();
+    return;
+  }
+  BCFGen_->emitGetEnvironment(encodeValue(Inst), *level);
 }
 void HBCISel::generateHBCStoreToEnvironmentInst(
     HBCStoreToEnvironmentInst *Inst,
@@ -1260,6 +1307,26 @@ void HBCISel::generateHBCLoadFromEnvironmentInst(
     BCFGen_->emitLoadFromEnvironmentL(dstReg, envReg, varIdx);
   }
 }
+void HBCISel::generateHBCLoadFromOuterEnvironmentInst(
+    HBCLoadFromOuterEnvironmentInst *Inst,
+    BasicBlock *next) {
+  Variable *var = Inst->getResolvedName();
+  Optional<uint32_t> level = getEnvironmentLevel(var->getParent());
+  if (!level) {
+    emitUnreachableIfDebug();
+    return;
+  }
+  auto dstReg = encodeValue(Inst);
+  auto varIdx = encodeValue(var);
+  if (varIdx <= UINT8_MAX) {
+    BCFGen_->emitLoadFromOuterEnvironment(dstReg, *level, varIdx);
+  } else {
+    // The destination holds the environment until it is overwritten by the
+    // value.
+    BCFGen_->emitGetEnvironment(dstReg, *level);
+    BCFGen_->emitLoadFromEnvironmentL(dstReg, dstReg, varIdx);
+  }
+}
 void HBCISel::generateHBCLoadConstInst(
     hermes::HBCLoadConstInst *Inst,
     hermes::BasicBlock *next) {
@@ -1338,6 +1405,14 @@ void HBCISel::generateHBCProfilePointInst(
   BCFGen_->emitProfilePoint(Inst->getPointIndex());
 }
 
+void HBCISel::generateHBCTypeOfIsInst(
+    hermes::HBCTypeOfIsInst *Inst,
+    hermes::BasicBlock *next) {
+  auto dstReg = encodeValue(Inst);
+  auto argReg = encodeValue(Inst->getArgument());
+  BCFGen_->emitTypeOfIs(dstReg, argReg, Inst->getTypes()->asUInt8());
+}
+
 void HBCISel::generateHBCGetGlobalObjectInst(
     hermes::HBCGetGlobalObjectInst *Inst,
     hermes::BasicBlock *next) {
@@ -1386,6 +1461,16 @@ void HBCISel::generateHBCReifyArgumentsInst(
   auto reg = encodeValue(Inst->getLazyRegister());
   BCFGen_->emitReifyArguments(reg);
 }
+void HBCISel::generateHBCCallApplyArgumentsInst(
+    hermes::HBCCallApplyArgumentsInst *Inst,
+    hermes::BasicBlock *next) {
+  auto output = encodeValue(Inst);
+  auto callee = encodeValue(Inst->getCallee());
+  auto thisValue = encodeValue(Inst->getThis());
+  auto thisArg = encodeValue(Inst->getThisArg());
+  auto reg = encodeValue(Inst->getLazyRegister());
+  BCFGen_->emitCallApplyArguments(output, callee, thisValue, thisArg, reg);
+}
 void HBCISel::generateHBCCreateThisInst(
     HBCCreateThisInst *Inst,
     BasicBlock *next) {
@@ -1594,6 +1679,27 @@ uint8_t HBCISel::acquirePropertyReadCacheIndex(unsigned id) {
   return idx;
 }
 
+uint8_t HBCISel::acquireInstanceOfCacheIndex() {
+  const bool reuse = F_->getContext().getOptimizationSettings().reusePropCache;
+  if (reuse && instanceOfCacheIndex_) {
+    ++NumCachedNodes;
+    return instanceOfCacheIndex_;
+  }
+
+  if (LLVM_UNLIKELY(
+          lastPropertyReadCacheIndex_ == std::numeric_limits<uint8_t>::max())) {
+    ++NumUncachedNodes;
+    return PROPERTY_CACHING_DISABLED;
+  }
+
+  ++NumCachedNodes;
+  ++NumCacheSlots;
+  uint8_t idx = ++lastPropertyReadCacheIndex_;
+  if (reuse)
+    instanceOfCacheIndex_ = idx;
+  return idx;
+}
+
 uint8_t HBCISel::acquirePropertyWriteCacheIndex(unsigned id) {
   const bool reuse = F_->getContext().getOptimizationSettings().reusePropCache;
   // Zero is reserved for indicating no-cache, so cannot be a value in the map.
@@ -13,11 +13,19 @@
 #include "hermes/BCGen/HBC/HBC.h"
 #include "hermes/BCGen/HBC/ISel.h"
 #include "hermes/BCGen/Lowering.h"
+#include "hermes/Inst/Inst.h"
+
+#include "hermes/Support/Statistic.h"
 
 #include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/StringSwitch.h"
 
 #define DEBUG_TYPE "hbc-backend"
 
+STATISTIC(
+    NumEnvironmentsRemoved,
+    "Number of functions that don't create an environment");
+
 namespace hermes {
 namespace hbc {
 
@@ -85,6 +93,74 @@ void updateToEntryInsertionPoint(IRBuilder &builder, Function *F) {
   builder.setInsertionPoint(&*it);
 }
 
+/// \returns the function that creates the closures of \p F, or null if there
+/// is not exactly one.
+Function *getEnclosingFunction(Function *F) {
+  Function *enclosing = nullptr;
+  for (auto *user : F->getUsers()) {
+    auto *create = dyn_cast<CreateFunctionInst>(user);
+    if (!create)
+      return nullptr;
+    Function *creator = create->getParent()->getParent();
+    if (enclosing && enclosing != creator)
+      return nullptr;
+    enclosing = creator;
+  }
+  return enclosing;
+}
+
+/// \returns true if \p F needs an environment of its own: when some of its
+/// variables are captured, or when the closures it creates, or the closures
+/// that they create in turn, access the variables of an enclosing function.
+/// Otherwise these closures never look past their own environments, and they
+/// can be given any parent environment.
+bool needsOwnEnvironment(Function *F) {
+  for (auto *var : F->getFunctionScope()->getVariables()) {
+    if (var->hasUsers())
+      return true;
+  }
+
+  // Collect F and the functions nested in it, which should only access each
+  // other's variables.
+  llvm::SmallSetVector<Function *, 8> nested;
+  nested.insert(F);
+  for (size_t i = 0; i < nested.size(); ++i) {
+    Function *fn = nested[i];
+    if (fn->isLazy())
+      return true;
+    for (auto &BB : *fn) {
+      for (auto &I : BB) {
+        if (auto *create = dyn_cast<CreateFunctionInst>(&I))
+          nested.insert(create->getFunctionCode());
+        // Eval may access the variables of any enclosing function.
+        if (isa<DirectEvalInst>(&I))
+          return true;
+      }
+    }
+  }
+
+  // The variables of F itself are unused, so resolving its scope is harmless:
+  // it only happens in nested functions that don't create an environment
+  // either.
+  for (size_t i = 1; i < nested.size(); ++i) {
+    for (auto &BB : *nested[i]) {
+      for (auto &I : BB) {
+        VariableScope *scope = nullptr;
+        if (auto *LFI = dyn_cast<LoadFrameInst>(&I)) {
+          scope = LFI->getLoadVariable()->getParent();
+        } else if (auto *SFI = dyn_cast<StoreFrameInst>(&I)) {
+          scope = SFI->getVariable()->getParent();
+        } else if (auto *RE = dyn_cast<HBCResolveEnvironment>(&I)) {
+          scope = RE->getScope();
+        }
+        if (scope && !nested.count(scope->getFunction()))
+          return true;
+      }
+    }
+  }
+  return false;
+}
+
 } // namespace
 
 bool LoadConstants::operandMustBeLiteral(Instruction *Inst, unsigned opIndex) {
@@ -115,6 +191,11 @@ bool LoadConstants::operandMustBeLiteral(Instruction *Inst, unsigned opIndex) {
     return false;
   }
 
+  // IteratorCloseInst's ignoreInnerException is a boolean constant.
+  if (isa<IteratorCloseInst>(Inst) &&
+      opIndex == IteratorCloseInst::IgnoreInnerExceptionIdx)
+    return true;
+
   // SwitchInst's rest of the operands are case values,
   // hence they will stay as constant.
   if (isa<SwitchInst>(Inst) && opIndex > 0)
@@ -181,6 +262,10 @@ bool LoadConstants::operandMustBeLiteral(Instruction *Inst, unsigned opIndex) {
        opIndex >= SwitchImmInst::FirstCaseIdx))
     return true;
 
+  // The types tested by HBCTypeOfIsInst are encoded in the instruction.
+  if (isa<HBCTypeOfIsInst>(Inst) && opIndex == HBCTypeOfIsInst::TypesIdx)
+    return true;
+
   /// CallBuiltin's callee and "this" should always be literals.
   if (isa<HBCCallBuiltinInst>(Inst) &&
       (opIndex == HBCCallBuiltinInst::CalleeIdx ||
@@ -274,10 +359,14 @@ bool LoadParameters::runOnFunction(Function *F) {
 Instruction *LowerLoadStoreFrameInst::getScope(
     IRBuilder &builder,
     Variable *var,
-    HBCCreateEnvironmentInst *captureScope) {
+    HBCCreateEnvironmentInst *captureScope,
+    const llvm::DenseMap<VariableScope *, Instruction *> &resolvedScopes) {
   if (var->getParent()->getFunction() != builder.getFunction()) {
     // If the variable is neither from the current scope,
     // we should get the proper scope for it.
+    auto it = resolvedScopes.find(var->getParent());
+    if (it != resolvedScopes.end())
+      return it->second;
     return builder.createHBCResolveEnvironment(var->getParent());
   } else {
     // Now we know that the variable belongs to the current scope.
@@ -286,6 +375,7 @@ Instruction *LowerLoadStoreFrameInst::getScope(
     // This will not cause performance issue as long as optimization
     // is enabled, because every variable will be moved to stack
     // if not being captured.
+    assert(captureScope && "variable of a function without an environment");
     return captureScope;
   }
 }
@@ -304,8 +394,49 @@ bool LowerLoadStoreFrameInst::runOnFunction(Function *F) {
   // we currently use only the lexical nesting level to determine which parent
   // environment to use - we don't account for the case when an environment may
   // not be needed somewhere along the chain.
-  HBCCreateEnvironmentInst *captureScope =
-      builder.createHBCCreateEnvironmentInst();
+  HBCCreateEnvironmentInst *captureScope = nullptr;
+  // The environment that the closures created in this function are given.
+  Instruction *closureScope = nullptr;
+  // When optimizing, a function that doesn't need an environment of its own
+  // can instead give the closures that it creates its own parent environment.
+  // Don't do it when the debugger may inspect the variables of the functions
+  // along the chain of environments.
+  Function *enclosing = nullptr;
+  if (optimizationEnabled_ &&
+      F->getContext().getDebugInfoSetting() != DebugInfoSetting::ALL &&
+      !F->isGlobalScope() && (enclosing = getEnclosingFunction(F)) &&
+      !needsOwnEnvironment(F)) {
+    closureScope =
+        builder.createHBCResolveEnvironment(enclosing->getFunctionScope());
+    ++NumEnvironmentsRemoved;
+  } else {
+    captureScope = builder.createHBCCreateEnvironmentInst();
+    closureScope = captureScope;
+  }
+
+  // When optimizing, walk the chain of environments once on entry for each
+  // enclosing scope that the function accesses, instead of once per access.
+  // CodeMotion sinks the ones with a single use back to it, as long as that
+  // doesn't move them into a loop.
+  llvm::DenseMap<VariableScope *, Instruction *> resolvedScopes;
+  if (optimizationEnabled_) {
+    if (enclosing)
+      resolvedScopes[enclosing->getFunctionScope()] = closureScope;
+    for (BasicBlock &BB : F->getBasicBlockList()) {
+      for (Instruction &I : BB) {
+        Variable *var = nullptr;
+        if (auto *LFI = dyn_cast<LoadFrameInst>(&I))
+          var = LFI->getLoadVariable();
+        else if (auto *SFI = dyn_cast<StoreFrameInst>(&I))
+          var = SFI->getVariable();
+        if (!var || var->getParent()->getFunction() == F)
+          continue;
+        Instruction *&scope = resolvedScopes[var->getParent()];
+        if (!scope)
+          scope = builder.createHBCResolveEnvironment(var->getParent());
+      }
+    }
+  }
 
   for (BasicBlock &BB : F->getBasicBlockList()) {
     for (auto I = BB.begin(), E = BB.end(); I != E; /* nothing */) {
@@ -321,7 +452,8 @@ bool LowerLoadStoreFrameInst::runOnFunction(Function *F) {
           auto *var = LFI->getLoadVariable();
 
           builder.setInsertionPoint(Inst);
-          Instruction *scope = getScope(builder, var, captureScope);
+          Instruction *scope =
+              getScope(builder, var, captureScope, resolvedScopes);
           Instruction *newInst =
               builder.createHBCLoadFromEnvironmentInst(scope, var);
 
@@ -336,7 +468,8 @@ bool LowerLoadStoreFrameInst::runOnFunction(Function *F) {
           auto *val = SFI->getValue();
 
           builder.setInsertionPoint(Inst);
-          Instruction *scope = getScope(builder, var, captureScope);
+          Instruction *scope =
+              getScope(builder, var, captureScope, resolvedScopes);
           builder.createHBCStoreToEnvironmentInst(scope, val, var);
 
           Inst->eraseFromParent();
@@ -348,7 +481,7 @@ bool LowerLoadStoreFrameInst::runOnFunction(Function *F) {
 
           builder.setInsertionPoint(Inst);
           auto *newInst = builder.createHBCCreateFunctionInst(
-              CFI->getFunctionCode(), captureScope);
+              CFI->getFunctionCode(), closureScope);
 
           Inst->replaceAllUsesWith(newInst);
           Inst->eraseFromParent();
@@ -360,7 +493,7 @@ bool LowerLoadStoreFrameInst::runOnFunction(Function *F) {
 
           builder.setInsertionPoint(Inst);
           auto *newInst = builder.createHBCCreateGeneratorInst(
-              CFI->getFunctionCode(), captureScope);
+              CFI->getFunctionCode(), closureScope);
 
           Inst->replaceAllUsesWith(newInst);
           Inst->eraseFromParent();
@@ -427,6 +560,28 @@ bool LowerArgumentsArray::runOnFunction(Function *F) {
     }
   }
 
+  // For `fn.apply(thisArg, arguments)`, let the VM pass the arguments along
+  // without creating the array, if `apply` is the built-in one.
+  uniqueUsers.clear();
+  uniqueUsers.insert(
+      createArguments->getUsers().begin(), createArguments->getUsers().end());
+  for (Instruction *user : uniqueUsers) {
+    auto *call = dyn_cast<CallInst>(user);
+    if (!call || call->getKind() != ValueKind::CallInstKind ||
+        call->getNumArguments() != 3 ||
+        call->getArgument(2) != createArguments ||
+        call->getCallee() == createArguments ||
+        call->getThis() == createArguments ||
+        call->getArgument(1) == createArguments)
+      continue;
+    builder.setInsertionPoint(call);
+    builder.setLocation(call->getLocation());
+    auto *apply = builder.createHBCCallApplyArgumentsInst(
+        call->getCallee(), call->getThis(), call->getArgument(1), lazyReg);
+    call->replaceAllUsesWith(apply);
+    call->eraseFromParent();
+  }
+
   uniqueUsers.clear();
   uniqueUsers.insert(
       createArguments->getUsers().begin(), createArguments->getUsers().end());
@@ -475,6 +630,34 @@ bool LowerArgumentsArray::runOnFunction(Function *F) {
   return true;
 }
 
+bool FuseOuterEnvironmentLoads::runOnFunction(Function *F) {
+  IRBuilder builder(F);
+  IRBuilder::InstructionDestroyer destroyer;
+  bool changed = false;
+
+  for (auto &BB : *F) {
+    for (auto &inst : BB.getInstList()) {
+      auto *load = dyn_cast<HBCLoadFromEnvironmentInst>(&inst);
+      if (!load)
+        continue;
+      auto *resolve = dyn_cast<HBCResolveEnvironment>(load->getEnvironment());
+      Variable *var = load->getResolvedName();
+      if (!resolve || !resolve->hasOneUser() ||
+          resolve->getScope() != var->getParent())
+        continue;
+
+      builder.setInsertionPoint(load);
+      builder.setLocation(load->getLocation());
+      load->replaceAllUsesWith(
+          builder.createHBCLoadFromOuterEnvironmentInst(var));
+      destroyer.add(load);
+      destroyer.add(resolve);
+      changed = true;
+    }
+  }
+  return changed;
+}
+
 bool DedupReifyArguments::runOnFunction(Function *F) {
   bool changed = false;
 
@@ -556,6 +739,75 @@ bool LowerConstruction::runOnFunction(Function *F) {
   return true;
 }
 
+/// \return the inst::TypeOfIsTypes bit of the `typeof` result \p name, or 0
+/// if `typeof` never produces it.
+static uint8_t typeOfIsTypeOf(llvm::StringRef name) {
+  return llvm::StringSwitch<uint8_t>(name)
+      .Case("undefined", inst::TypeOfIsUndefined)
+      .Case("object", inst::TypeOfIsObject)
+      .Case("string", inst::TypeOfIsString)
+      .Case("boolean", inst::TypeOfIsBoolean)
+      .Case("symbol", inst::TypeOfIsSymbol)
+      .Case("function", inst::TypeOfIsFunction)
+      .Case("number", inst::TypeOfIsNumber)
+      .Default(0);
+}
+
+bool FuseTypeOfComparisons::runOnFunction(Function *F) {
+  IRBuilder builder(F);
+  IRBuilder::InstructionDestroyer destroyer;
+  bool changed = false;
+
+  for (BasicBlock &BB : F->getBasicBlockList()) {
+    for (Instruction &I : BB) {
+      auto *compare = dyn_cast<BinaryOperatorInst>(&I);
+      if (!compare)
+        continue;
+
+      // typeof always produces a string, so == and === agree.
+      bool negate;
+      switch (compare->getOperatorKind()) {
+        case BinaryOperatorInst::OpKind::EqualKind:
+        case BinaryOperatorInst::OpKind::StrictlyEqualKind:
+          negate = false;
+          break;
+        case BinaryOperatorInst::OpKind::NotEqualKind:
+        case BinaryOperatorInst::OpKind::StrictlyNotEqualKind:
+          negate = true;
+          break;
+        default:
+          continue;
+      }
+
+      auto *typeOf = dyn_cast<UnaryOperatorInst>(compare->getLeftHandSide());
+      auto *name = dyn_cast<LiteralString>(compare->getRightHandSide());
+      if (!typeOf || !name) {
+        typeOf = dyn_cast<UnaryOperatorInst>(compare->getRightHandSide());
+        name = dyn_cast<LiteralString>(compare->getLeftHandSide());
+      }
+      if (!typeOf || !name ||
+          typeOf->getOperatorKind() !=
+              UnaryOperatorInst::OpKind::TypeofKind ||
+          !typeOf->hasOneUser())
+        continue;
+
+      uint8_t types = typeOfIsTypeOf(name->getValue().str());
+      if (negate)
+        types = ~types & inst::TypeOfIsAny;
+
+      builder.setInsertionPoint(compare);
+      builder.setLocation(compare->getLocation());
+      auto *typeOfIs =
+          builder.createHBCTypeOfIsInst(typeOf->getSingleOperand(), types);
+      compare->replaceAllUsesWith(typeOfIs);
+      destroyer.add(compare);
+      destroyer.add(typeOf);
+      changed = true;
+    }
+  }
+  return changed;
+}
+
 bool LowerCalls::runOnFunction(Function *F) {
   IRBuilder builder(F);
   bool changed = false;
@@ -719,6 +971,7 @@ bool SpillRegisters::requiresShortOutput(Instruction *I) {
     case ValueKind::DebuggerInstKind:
     case ValueKind::HBCReifyArgumentsInstKind:
     case ValueKind::HBCStoreToEnvironmentInstKind:
+    case ValueKind::IteratorCloseInstKind:
     case ValueKind::StoreGetterSetterInstKind:
     case ValueKind::StoreOwnPropertyInstKind:
     case ValueKind::StorePropertyInstKind:
@@ -43,6 +43,17 @@ StringLiteralIDMapping::StringLiteralIDMapping(
   }
 }
 
+StringLiteralIDMapping::StringLiteralIDMapping(
+    ConsecutiveStringStorage storage,
+    StringSetVector strings,
+    std::vector<bool> isIdentifier)
+    : storage_(std::move(storage)),
+      strings_(std::move(strings)),
+      isIdentifier_(std::move(isIdentifier)) {
+  assert(strings_.size() == storage_.count());
+  assert(isIdentifier_.size() == storage_.count());
+}
+
 std::vector<uint32_t> StringLiteralTable::getIdentifierTranslations() const {
   std::vector<uint32_t> result;
   assert(strings_.size() == isIdentifier_.size());
@@ -107,13 +118,17 @@ std::vector<StringKind::Entry> StringLiteralTable::getStringKinds() const {
     }
   };
 
-  /// Associates a StringTableEntry with its String Kind.
+  /// Associates a StringTableEntry with its String Kind and its string.
   struct KindedEntry {
     StringKind::Kind kind;
     StringTableEntry entry;
+    llvm::StringRef str;
 
-    KindedEntry(StringKind::Kind kind, StringTableEntry entry)
-        : kind(kind), entry(entry) {}
+    KindedEntry(
+        StringKind::Kind kind,
+        StringTableEntry entry,
+        llvm::StringRef str)
+        : kind(kind), entry(entry), str(str) {}
 
    private:
     // Key for performing comparisons with.  Ordering on this key is used to
@@ -190,7 +205,7 @@ std::vector<StringKind::Entry> StringLiteralTable::getStringKinds() const {
   kindedEntries.reserve(newStrings);
 
   for (size_t i = 0, j = existingStrings; i < newStrings; ++i, ++j) {
-    kindedEntries.emplace_back(indices[i].kind, tableView[j]);
+    kindedEntries.emplace_back(indices[i].kind, tableView[j], indices[i].str);
   }
 
   // Sort index entries within each frequency and kind bucket by their offset
@@ -203,13 +218,20 @@ std::vector<StringKind::Entry> StringLiteralTable::getStringKinds() const {
   std::sort(entriesFrom(UINT8_MAX), entriesFrom(UINT16_MAX));
   std::sort(entriesFrom(UINT16_MAX), entriesFrom(SIZE_MAX));
 
-  // Write the re-ordered entries back into the table.
+  // Write the re-ordered entries back into the table, and list the strings in
+  // their new order, which saves decoding them from the storage.
+  StringSetVector orderedStrings;
+  for (size_t i = 0; i < existingStrings; ++i) {
+    orderedStrings.insert(strings[i]);
+  }
   for (size_t i = 0, j = existingStrings; i < newStrings; ++i, ++j) {
     tableView[j] = kindedEntries[i].entry;
     isIdentifier[j] = kindedEntries[i].kind != StringKind::String;
+    orderedStrings.insert(kindedEntries[i].str);
   }
 
-  return StringLiteralTable{std::move(storage), std::move(isIdentifier)};
+  return StringLiteralTable{
+      std::move(storage), std::move(orderedStrings), std::move(isIdentifier)};
 }
 
 } // namespace hbc
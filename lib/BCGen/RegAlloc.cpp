@@ -16,9 +16,11 @@
 #include "llvm/ADT/PostOrderIterator.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include <queue>
+#include <vector>
 
 #define DEBUG_TYPE "regalloc"
 
@@ -397,7 +399,8 @@ bool RegisterAllocator::isManuallyAllocatedInterval(Instruction *I) {
 
 void RegisterAllocator::coalesce(
     DenseMap<Instruction *, Instruction *> &map,
-    ArrayRef<BasicBlock *> order) {
+    ArrayRef<BasicBlock *> order,
+    bool mergeCopies) {
   // Merge all PHI nodes into a single interval. This part is required for
   // correctness because it bounds the MOV and the PHIs into a single interval.
   for (BasicBlock *BB : order) {
@@ -454,6 +457,9 @@ void RegisterAllocator::coalesce(
     }
   }
 
+  if (!mergeCopies)
+    return;
+
   // Optimize the program by coalescing multiple live intervals into a single
   // long interval. This phase is optional.
   for (BasicBlock *BB : order) {
@@ -572,18 +578,17 @@ void RegisterAllocator::allocate(ArrayRef<BasicBlock *> order) {
   // Lower PHI nodes into a sequence of MOVs.
   lowerPhis(order);
 
+  // We have two forms of register allocation: classic and fast pass.
+  // Classic allocation calculates and merges liveness intervals, fast pass
+  // just assigns sequentually. The fast pass can be enabled for small
+  // functions where runtime memory savings will be small, and for large
+  // functions where degenerate behavior can inflate compile time memory
+  // usage.
+  unsigned int instructionCount = 0;
+  for (const auto &BB : order) {
+    instructionCount += BB->getInstList().size();
+  }
   {
-    // We have two forms of register allocation: classic and fast pass.
-    // Classic allocation calculates and merges liveness intervals, fast pass
-    // just assigns sequentually. The fast pass can be enabled for small
-    // functions where runtime memory savings will be small, and for large
-    // functions where degenerate behavior can inflate compile time memory
-    // usage.
-
-    unsigned int instructionCount = 0;
-    for (const auto &BB : order) {
-      instructionCount += BB->getInstList().size();
-    }
     // We allocate five bits per instruction per basicblock in our liveness
     // sets.
     uint64_t estimatedMemoryUsage =
@@ -595,6 +600,11 @@ void RegisterAllocator::allocate(ArrayRef<BasicBlock *> order) {
     }
   }
 
+  // Classic allocation of huge functions skips the liveness sets, whose size
+  // grows with the number of blocks times the number of instructions, and
+  // computes conservative intervals instead.
+  bool linearScan = instructionCount >= linearScanThreshold;
+
   // Number instructions:
   for (auto *BB : order) {
     for (auto &it : *BB) {
@@ -605,29 +615,35 @@ void RegisterAllocator::allocate(ArrayRef<BasicBlock *> order) {
     }
   }
 
-  // Init the basic block liveness data structure and calculate the local
-  // liveness for each basic block.
-  unsigned maxIdx = getMaxInstrIndex();
-  for (auto *BB : order) {
-    blockLiveness_[BB].init(maxIdx);
-  }
-  for (auto *BB : order) {
-    calculateLocalLiveness(blockLiveness_[BB], BB);
-  }
+  if (linearScan) {
+    calculateLinearIntervals(order);
+  } else {
+    // Init the basic block liveness data structure and calculate the local
+    // liveness for each basic block.
+    unsigned maxIdx = getMaxInstrIndex();
+    for (auto *BB : order) {
+      blockLiveness_[BB].init(maxIdx);
+    }
+    for (auto *BB : order) {
+      calculateLocalLiveness(blockLiveness_[BB], BB);
+    }
 
-  // Propagate the local liveness information across the whole function.
-  calculateGlobalLiveness(order);
+    // Propagate the local liveness information across the whole function.
+    calculateGlobalLiveness(order);
 
-  // Calculate the live intervals for each instruction.
-  calculateLiveIntervals(order);
+    // Calculate the live intervals for each instruction.
+    calculateLiveIntervals(order);
 
-  // Free the memory used for liveness.
-  blockLiveness_.clear();
+    // Free the memory used for liveness.
+    blockLiveness_.clear();
+  }
 
   // Maps coalesced instructions. First uses the register allocated for Second.
   DenseMap<Instruction *, Instruction *> coalesced;
 
-  coalesce(coalesced, order);
+  // Merging copies rewrites the map for every merged interval, which is
+  // quadratic in the worst case.
+  coalesce(coalesced, order, !linearScan);
 
   // Compare two intervals and return the one that starts first.
   auto startsFirst = [&](unsigned a, unsigned b) {
@@ -831,6 +847,101 @@ void RegisterAllocator::calculateLiveIntervals(ArrayRef<BasicBlock *> order) {
   } // for each block.
 }
 
+void RegisterAllocator::calculateLinearIntervals(ArrayRef<BasicBlock *> order) {
+  unsigned numInsts = getMaxInstrIndex();
+  // The bounds of the interval of each instruction. As in
+  // calculateLiveIntervals(), a value starts to live on the next instruction.
+  llvm::SmallVector<unsigned, 32> starts(numInsts);
+  llvm::SmallVector<unsigned, 32> ends(numInsts);
+  for (unsigned i = 0; i < numInsts; ++i) {
+    starts[i] = i + 1;
+    ends[i] = i + 1;
+  }
+
+  // Maps the index of the first instruction of each loop header to the end of
+  // its latest back edge. Blocks are numbered in reverse post order, so a back
+  // edge is an edge to a block that starts at or before its source.
+  llvm::SmallVector<unsigned, 32> loopEnd(numInsts, 0);
+
+  for (BasicBlock *BB : order) {
+    TerminatorInst *term = BB->getTerminator();
+    unsigned termIdx = getInstructionNumber(term);
+    for (unsigned i = 0, e = term->getNumSuccessors(); i < e; ++i) {
+      Instruction *first = &*term->getSuccessor(i)->begin();
+      if (!hasInstructionNumber(first))
+        continue;
+      unsigned headerIdx = getInstructionNumber(first);
+      if (headerIdx <= termIdx)
+        loopEnd[headerIdx] = std::max(loopEnd[headerIdx], termIdx + 1);
+    }
+
+    for (auto &it : *BB) {
+      auto instOffset = getInstructionNumber(&it);
+
+      // Extend the lifetime of the operands to reach this instruction.
+      for (int i = 0, e = it.getNumOperands(); i < e; i++) {
+        auto instOp = dyn_cast<Instruction>(it.getOperand(i));
+        if (!instOp || !hasInstructionNumber(instOp))
+          continue;
+        auto operandIdx = getInstructionNumber(instOp);
+        ends[operandIdx] = std::max(ends[operandIdx], instOffset + 1);
+      }
+
+      // Extend the lifetime of the PHI and of its operands to the ends of the
+      // source basic blocks.
+      if (auto *P = dyn_cast<PhiInst>(&it)) {
+        for (int i = 0, e = P->getNumEntries(); i < e; i++) {
+          auto E = P->getEntry(i);
+          if (!hasInstructionNumber(E.second->getTerminator()))
+            continue;
+
+          unsigned termIdx = getInstructionNumber(E.second->getTerminator());
+          starts[instOffset] = std::min(starts[instOffset], termIdx);
+          ends[instOffset] = std::max(ends[instOffset], termIdx + 1);
+
+          auto *instOp = dyn_cast<Instruction>(E.first);
+          if (instOp && hasInstructionNumber(instOp)) {
+            auto predIdx = getInstructionNumber(instOp);
+            ends[predIdx] = std::max(ends[predIdx], termIdx);
+          }
+        }
+      }
+    }
+  }
+
+  // Build a sparse table to find the latest loop end among the headers in a
+  // range of indices: level k holds the maximum of each range of 2^k entries.
+  std::vector<llvm::SmallVector<unsigned, 32>> maxLoopEnd;
+  maxLoopEnd.push_back(loopEnd);
+  for (unsigned width = 1; width * 2 <= numInsts; width *= 2) {
+    auto &prev = maxLoopEnd.back();
+    llvm::SmallVector<unsigned, 32> next(numInsts - width * 2 + 1);
+    for (unsigned i = 0, e = next.size(); i < e; ++i)
+      next[i] = std::max(prev[i], prev[i + width]);
+    maxLoopEnd.push_back(std::move(next));
+  }
+  // Return the latest end of the loops with headers in [first, last].
+  auto getMaxLoopEnd = [&maxLoopEnd](unsigned first, unsigned last) {
+    unsigned level = llvm::Log2_32(last - first + 1);
+    return std::max(
+        maxLoopEnd[level][first], maxLoopEnd[level][last + 1 - (1u << level)]);
+  };
+
+  // A value that is defined before a loop header and used after it is live
+  // around the whole loop. Extending the interval may reach more loops.
+  // Values that are defined inside a loop don't live across its back edge,
+  // because their definition dominates their uses.
+  for (unsigned i = 0; i < numInsts; ++i) {
+    while (ends[i] > starts[i]) {
+      unsigned end = getMaxLoopEnd(starts[i], ends[i] - 1);
+      if (end <= ends[i])
+        break;
+      ends[i] = end;
+    }
+    instructionInterval_[i] = Interval(starts[i], ends[i]);
+  }
+}
+
 struct LivenessRegAllocIRPrinter : IRPrinter {
   RegisterAllocator &allocator;
 
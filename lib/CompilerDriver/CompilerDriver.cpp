@@ -9,6 +9,7 @@
 #include "hermes/AST/CommonJS.h"
 #include "hermes/AST/Context.h"
 #include "hermes/AST/ESTreeJSONDumper.h"
+#include "hermes/AST/ESTreeSerializer.h"
 #include "hermes/AST/SemValidate.h"
 #include "hermes/BCGen/HBC/BytecodeDisassembler.h"
 #include "hermes/BCGen/HBC/HBC.h"
@@ -32,6 +33,7 @@
 #include "hermes/Support/Algorithms.h"
 #include "hermes/Support/MemoryBuffer.h"
 #include "hermes/Support/OSCompat.h"
+#include "hermes/Support/Statistic.h"
 #include "hermes/Support/Warning.h"
 #include "hermes/Utils/Dumper.h"
 #include "hermes/Utils/Options.h"
@@ -39,6 +41,7 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
@@ -47,7 +50,10 @@
 
 #include "zip/src/zip.h"
 
+#include <atomic>
+#include <chrono>
 #include <sstream>
+#include <thread>
 
 #define DEBUG_TYPE "hermes"
 
@@ -62,6 +68,10 @@ using llvm::sys::fs::F_Text;
 using namespace hermes;
 using namespace hermes::driver;
 
+STATISTIC(NumASTKilobytes, "Peak kilobytes of memory used by the AST");
+STATISTIC(PeakRSSKilobytes, "Peak resident set size in kilobytes");
+STATISTIC(CompileMilliseconds, "Milliseconds spent compiling the sources");
+
 namespace cl {
 using llvm::cl::desc;
 using llvm::cl::Hidden;
@@ -233,6 +243,14 @@ static opt<bool> LazyCompilation(
     init(false),
     desc("Compile source lazily when executing (HBC only)"));
 
+static opt<bool> LazySkipPreParse(
+    "lazy-skip-preparse",
+    init(false),
+    desc(
+        "With -lazy, find lazy functions by matching brackets instead of "
+        "pre-parsing, and only report their syntax errors when called"),
+    Hidden);
+
 /// The following flags are exported so it may be used by the VM driver as well.
 opt<bool> BasicBlockProfiling(
     "basic-block-profiling",
@@ -382,6 +400,35 @@ static opt<bool> ReusePropCache(
 
 static CLFlag Inline('f', "inline", true, "inlining of functions");
 
+static opt<std::string> InliningProfile(
+    "inline-profile",
+    desc(
+        "Also inline functions at the call sites that this profile shows are "
+        "hot. Each line of the file holds '<file>:<line>:<column> <count>': "
+        "the number of times the call at that location of the source ran, as "
+        "reported for the calling frame in the stack traces of the same "
+        "source."),
+    init(""));
+
+static opt<unsigned> InliningMinHotCount(
+    "inline-min-hot-count",
+    init(InliningSettings{}.minHotCount),
+    desc("Minimum count in -inline-profile for a call site to be hot"),
+    Hidden);
+
+static opt<unsigned> InliningMaxHotCalleeSize(
+    "inline-max-hot-callee-size",
+    init(InliningSettings{}.maxHotCalleeSize),
+    desc("Maximum number of instructions of a function inlined at hot sites"),
+    Hidden);
+
+static opt<unsigned> InliningHotGrowthPercent(
+    "inline-hot-growth",
+    init(InliningSettings{}.hotGrowthPercent),
+    desc(
+        "Maximum growth of the code from inlining at hot call sites, in "
+        "percent"));
+
 static CLFlag
     Outline('f', "outline", false, "IR outlining to reduce code size");
 
@@ -442,6 +489,48 @@ static opt<unsigned> PadFunctionBodiesPercent(
     init(0),
     Hidden);
 
+static opt<unsigned> LinearScanThreshold(
+    "linear-scan-threshold",
+    desc(
+        "Allocate registers in a single scan in functions with at least this "
+        "many instructions."),
+    init(BytecodeGenerationOptions::defaults().linearScanThreshold),
+    Hidden);
+
+static opt<unsigned> ParallelParseThreads(
+    "parallel-parse-threads",
+    desc(
+        "Parse CommonJS modules on this many threads. 0 or 1 parses them "
+        "sequentially."),
+    init(0),
+    Hidden);
+
+static opt<std::string> FunctionOrderFile(
+    "function-order",
+    desc(
+        "Lay out the bodies of the functions listed in this file first, in "
+        "the order they are listed. The file holds one function ID per line, "
+        "as output by 'hbc-read-trace --function-order' from a page access "
+        "trace of a previous build of the same source."),
+    init(""));
+
+static opt<std::string> CacheDir(
+    "cache-dir",
+    desc(
+        "Keep the compiled bundles in this directory, keyed by the hash of "
+        "the input files and of the command line, and copy the bundle of an "
+        "identical earlier compilation to -out instead of compiling again."),
+    init(""));
+
+static opt<std::string> ASTCacheDir(
+    "ast-cache-dir",
+    desc(
+        "Keep the ASTs of the parsed files in this directory, keyed by the "
+        "hash of their contents, and read them back instead of parsing "
+        "identical files again."),
+    init(""),
+    Hidden);
+
 } // namespace cl
 
 namespace {
@@ -570,9 +659,154 @@ SourceErrorOutputOptions guessErrorOutputOptions() {
   return result;
 }
 
+/// A program parsed on a worker thread by parseSourcesInParallel(), in a
+/// Context of its own.
+struct ParallelParseResult {
+  /// Owns the AST and the strings it refers to, until they are moved to the
+  /// main Context by parseJS().
+  std::unique_ptr<Context> context{};
+
+  /// The parsed program, or nullptr if the parser reported any message. The
+  /// file is then parsed again on the main thread to report them.
+  ESTree::ProgramNode *ast{nullptr};
+
+  /// The ID of the source buffer in the SourceErrorManager of \c context.
+  uint32_t bufId{0};
+
+  /// Whether the 'use static builtin' directive was found.
+  bool useStaticBuiltin{false};
+};
+
+/// Visitor moving the labels of an AST parsed by parseSourcesInParallel() to
+/// the string table of the main Context, and pointing its function bodies at
+/// the buffer in the main SourceErrorManager.
+struct AdoptParsedAST {
+  Context &context;
+  uint32_t bufId;
+
+  bool shouldVisit(ESTree::Node *) {
+    return true;
+  }
+  void enter(ESTree::Node *node) {
+    if (auto *block = dyn_cast<ESTree::BlockStatementNode>(node))
+      block->bufferId = bufId;
+  }
+  void leave(ESTree::Node *) {}
+};
+
+/// Found by ADL instead of the generic overload, which skips labels.
+void ESTreeVisit(AdoptParsedAST &V, ESTree::NodeLabel &label) {
+  if (label)
+    label = V.context.getStringTable().getString(label->str());
+}
+
+/// Parse the source buffers \p bufs on \p numThreads threads, each of them
+/// in a new Context using the strictness of \p context. The buffers are not
+/// copied, so they must outlive the returned ASTs.
+/// \return the result for each buffer, in the same order.
+std::vector<ParallelParseResult> parseSourcesInParallel(
+    const Context &context,
+    ArrayRef<const llvm::MemoryBuffer *> bufs,
+    unsigned numThreads) {
+  std::vector<ParallelParseResult> results(bufs.size());
+  std::atomic<size_t> nextBuf{0};
+
+  auto parseBuffers = [&]() {
+    for (size_t i; (i = nextBuf++) < bufs.size();) {
+      ParallelParseResult &result = results[i];
+      result.context = llvm::make_unique<Context>();
+      result.context->setStrictMode(context.isStrictMode());
+      auto &sm = result.context->getSourceErrorManager();
+      // Messages are only counted here. They are printed, in order, when the
+      // file is parsed again.
+      sm.setDiagHandler([](const llvm::SMDiagnostic &, void *) {});
+      result.bufId = sm.addNewSourceBuffer(
+          llvm::MemoryBuffer::getMemBuffer(bufs[i]->getMemBufferRef()));
+
+      parser::JSParser jsParser(
+          *result.context, result.bufId, parser::FullParse);
+      auto parsedJs = jsParser.parse();
+      if (!parsedJs || sm.getErrorCount() || sm.getWarningCount() ||
+          sm.getMessageCount(SourceErrorManager::DK_Note))
+        continue;
+      result.ast = parsedJs.getValue();
+      result.useStaticBuiltin = jsParser.getUseStaticBuiltin();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned i = 1; i < std::min<size_t>(numThreads, bufs.size()); ++i)
+    threads.emplace_back(parseBuffers);
+  parseBuffers();
+  for (auto &thread : threads)
+    thread.join();
+
+  return results;
+}
+
+/// \return the path of the file in -ast-cache-dir holding the AST of
+/// \p fileBuf parsed in \p context.
+std::string getASTCachePath(
+    const Context &context,
+    const llvm::MemoryBuffer &fileBuf) {
+  llvm::SHA1 hasher;
+  auto update = [&hasher](llvm::StringRef str) {
+    hasher.update(str);
+    hasher.update(llvm::StringRef("", 1));
+  };
+#ifdef HERMES_RELEASE_VERSION
+  update(HERMES_RELEASE_VERSION);
+#endif
+  update(oscompat::to_string(hbc::BYTECODE_VERSION));
+  update(context.isStrictMode() ? "strict" : "sloppy");
+  update(fileBuf.getBuffer());
+
+  std::string key;
+  llvm::raw_string_ostream keyOS{key};
+  for (unsigned char c : hasher.final()) {
+    keyOS << llvm::format_hex_no_prefix(c, 2);
+  }
+  llvm::SmallString<64> path{cl::ASTCacheDir};
+  llvm::sys::path::append(path, keyOS.str() + ".ast");
+  return path.str().str();
+}
+
+/// Write \p program, parsed from \p fileBuf, to \p cachePath.  Failing to
+/// do so is not an error, since the file has been parsed.
+void addToASTCache(
+    llvm::StringRef cachePath,
+    ESTree::ProgramNode *program,
+    const llvm::MemoryBuffer &fileBuf,
+    const SerializedESTreeInfo &info) {
+  if (llvm::sys::fs::create_directories(cl::ASTCacheDir)) {
+    return;
+  }
+  // Write to a temporary file first, so that a compilation running
+  // concurrently never reads a partial AST.
+  int fd;
+  llvm::SmallString<64> tmpPath;
+  if (llvm::sys::fs::createUniqueFile(cachePath + "-%%%%%%%%", fd, tmpPath)) {
+    return;
+  }
+  bool failed;
+  {
+    llvm::raw_fd_ostream os{fd, /* shouldClose */ true};
+    serializeESTree(os, program, fileBuf, info);
+    os.close();
+    failed = os.has_error();
+    os.clear_error();
+  }
+  if (failed || llvm::sys::fs::rename(tmpPath, cachePath)) {
+    llvm::sys::fs::remove(tmpPath);
+  }
+}
+
 /// Parse the given files and return a single AST pointer.
 /// \p sourceMap any parsed source map associated with \p fileBuf.
 /// \p sourceMapTranslator input source map coordinate translator.
+/// \p parallelResult if non-null and successful, the AST of \p fileBuf
+/// already parsed by parseSourcesInParallel(), which is used instead of
+/// parsing it again.
 /// \return A pointer to the new validated AST, nullptr if parsing failed.
 /// If using CJS modules, return a FunctionExpressionNode, else a ProgramNode.
 ESTree::NodePtr parseJS(
@@ -581,7 +815,8 @@ ESTree::NodePtr parseJS(
     std::unique_ptr<llvm::MemoryBuffer> fileBuf,
     std::unique_ptr<SourceMap> sourceMap = nullptr,
     std::shared_ptr<SourceMapTranslator> sourceMapTranslator = nullptr,
-    bool wrapCJSModule = false) {
+    bool wrapCJSModule = false,
+    const ParallelParseResult *parallelResult = nullptr) {
   assert(fileBuf && "Need a file to compile");
   assert(context && "Need a context to compile using");
   // This value will be set to true if the parser detected the 'use static
@@ -596,34 +831,96 @@ ESTree::NodePtr parseJS(
 
   auto mode = parser::FullParse;
 
+  bool preParsed = false;
   if (context->isLazyCompilation()) {
-    if (!parser::JSParser::preParseBuffer(
-            *context, fileBufId, useStaticBuiltinDetected)) {
-      return nullptr;
+    if (!cl::LazySkipPreParse) {
+      if (!parser::JSParser::preParseBuffer(
+              *context, fileBufId, useStaticBuiltinDetected)) {
+        return nullptr;
+      }
+      preParsed = true;
     }
     mode = parser::LazyParse;
   }
 
   Optional<ESTree::ProgramNode *> parsedJs;
+  auto &sm = context->getSourceErrorManager();
 
+  // Only ASTs of fully parsed files are cached, since lazy ones refer to the
+  // pre-parsed information of their buffer.
+  std::string astCachePath;
+  bool useASTCache = !cl::ASTCacheDir.empty() && mode == parser::FullParse;
 #ifdef HERMES_USE_FLOWPARSER
-  if (cl::FlowParser) {
-    parsedJs = parser::parseFlowParser(*context, fileBufId);
-  } else
+  useASTCache = useASTCache && !cl::FlowParser;
 #endif
-  {
-    parser::JSParser jsParser(*context, fileBufId, mode);
-    parsedJs = jsParser.parse();
-    // If we are using lazy parse mode, we should have already detected the 'use
-    // static builtin' directive in the pre-parsing stage.
-    if (mode != parser::LazyParse) {
-      useStaticBuiltinDetected = jsParser.getUseStaticBuiltin();
+  if (useASTCache) {
+    astCachePath = getASTCachePath(*context, *sm.getSourceBuffer(fileBufId));
+    if (auto cached = llvm::MemoryBuffer::getFile(astCachePath)) {
+      SerializedESTreeInfo info;
+      if (auto *program = deserializeESTree(
+              *context, cached.get()->getBuffer(), fileBufId, info)) {
+        if (!info.sourceMappingUrl.empty())
+          sm.setSourceMappingUrl(fileBufId, info.sourceMappingUrl);
+        parsedJs = program;
+        useStaticBuiltinDetected = info.useStaticBuiltin;
+        // The cached AST is up to date, don't write it again.
+        astCachePath.clear();
+      }
+    }
+  }
+
+  // Messages of the parser are not cached, so the AST is only written when
+  // there are none.
+  auto countMessages = [&sm]() {
+    return sm.getErrorCount() + sm.getWarningCount() +
+        sm.getMessageCount(SourceErrorManager::DK_Note);
+  };
+  const unsigned numMessages = countMessages();
+
+  if (parsedJs) {
+    // Read from the AST cache.
+  } else if (parallelResult && parallelResult->ast) {
+    assert(mode == parser::FullParse && "lazy files are not parsed in advance");
+    AdoptParsedAST adopt{*context, (uint32_t)fileBufId};
+    ESTreeVisit(adopt, parallelResult->ast);
+    auto url =
+        parallelResult->context->getSourceErrorManager().getSourceMappingUrl(
+            parallelResult->bufId);
+    if (!url.empty())
+      context->getSourceErrorManager().setSourceMappingUrl(fileBufId, url);
+    parsedJs = parallelResult->ast;
+    useStaticBuiltinDetected = parallelResult->useStaticBuiltin;
+  } else {
+#ifdef HERMES_USE_FLOWPARSER
+    if (cl::FlowParser) {
+      parsedJs = parser::parseFlowParser(*context, fileBufId);
+    } else
+#endif
+    {
+      parser::JSParser jsParser(*context, fileBufId, mode);
+      parsedJs = jsParser.parse();
+      // If we pre-parsed the buffer, we should have already detected the 'use
+      // static builtin' directive in the pre-parsing stage.
+      if (!preParsed) {
+        useStaticBuiltinDetected = jsParser.getUseStaticBuiltin();
+      }
     }
   }
   if (!parsedJs)
     return nullptr;
   ESTree::NodePtr parsedAST = parsedJs.getValue();
 
+  if (!astCachePath.empty() && countMessages() == numMessages) {
+    SerializedESTreeInfo info;
+    info.useStaticBuiltin = useStaticBuiltinDetected;
+    info.sourceMappingUrl = sm.getSourceMappingUrl(fileBufId);
+    addToASTCache(
+        astCachePath,
+        parsedJs.getValue(),
+        *sm.getSourceBuffer(fileBufId),
+        info);
+  }
+
   if (cl::StaticBuiltins == cl::StaticBuiltinSetting::AutoDetect) {
     context->setStaticBuiltinOptimization(useStaticBuiltinDetected);
   }
@@ -717,6 +1014,8 @@ bool validateFlags() {
       err("-lazy doesn't support CommonJS modules");
     }
   }
+  if (cl::LazySkipPreParse && !cl::LazyCompilation)
+    err("-lazy-skip-preparse requires -lazy");
 
   // Validate flags for more than one input file.
   if (cl::InputFilenames.size() > 1) {
@@ -738,6 +1037,14 @@ bool validateFlags() {
       err("-output-source-map only works with -emit-binary");
   }
 
+  // Validate compilation cache flags.
+  if (!cl::CacheDir.empty()) {
+    if (cl::DumpTarget != EmitBundle || cl::BytecodeOutputFilename.empty())
+      err("-cache-dir requires -emit-binary and -out to be set");
+    if (cl::OutputSourceMap)
+      err("-cache-dir does not work with -output-source-map");
+  }
+
   // Validate bytecode dumping flags.
   if (cl::BytecodeMode && cl::DumpTarget != None) {
     if (cl::BytecodeFormat != cl::BytecodeFormatKind::HBC)
@@ -749,8 +1056,37 @@ bool validateFlags() {
   return !errored;
 }
 
+/// Read the call counts of the profile at \p inputPath into \p counts.
+/// \return true on success, false if the file could not be read or parsed.
+bool readInliningProfile(
+    llvm::StringMap<uint64_t> &counts,
+    llvm::StringRef inputPath) {
+  auto fileBuf = memoryBufferFromFile(inputPath);
+  if (!fileBuf) {
+    return false;
+  }
+  llvm::SmallVector<llvm::StringRef, 64> lines;
+  fileBuf->getBuffer().split(lines, '\n', -1, false);
+  for (llvm::StringRef line : lines) {
+    line = line.trim();
+    if (line.empty()) {
+      continue;
+    }
+    // The location may contain spaces, the count cannot.
+    auto parts = line.rsplit(' ');
+    uint64_t count;
+    if (parts.first.empty() || parts.second.getAsInteger(10, count)) {
+      llvm::errs() << "Error! Invalid call count in " << inputPath << ": "
+                   << line << '\n';
+      return false;
+    }
+    counts[parts.first.rtrim()] += count;
+  }
+  return true;
+}
+
 /// Create a Context, respecting the command line flags.
-/// \return the Context.
+/// \return the Context, or nullptr if the files it needs could not be read.
 std::shared_ptr<Context> createContext(
     std::unique_ptr<Context::ResolutionTable> resolutionTable,
     std::vector<Context::SegmentRange> segmentRanges) {
@@ -779,6 +1115,17 @@ std::shared_ptr<Context> createContext(
 
   optimizationOpts.inlining = cl::OptimizationLevel != cl::OptLevel::O0 &&
       cl::BytecodeFormat == cl::BytecodeFormatKind::HBC && cl::Inline;
+  if (!cl::InliningProfile.empty() &&
+      !readInliningProfile(
+          optimizationOpts.inliningSettings.callCounts,
+          cl::InliningProfile)) {
+    return nullptr;
+  }
+  optimizationOpts.inliningSettings.minHotCount = cl::InliningMinHotCount;
+  optimizationOpts.inliningSettings.maxHotCalleeSize =
+      cl::InliningMaxHotCalleeSize;
+  optimizationOpts.inliningSettings.hotGrowthPercent =
+      cl::InliningHotGrowthPercent;
   optimizationOpts.outlining =
       cl::OptimizationLevel != cl::OptLevel::O0 && cl::Outline;
 
@@ -1065,6 +1412,35 @@ bool readBaseBytecodeFromDirectoryOrZip(
   return true;
 }
 
+/// Read the function IDs listed in the file at \p inputPath, one per line,
+/// into \p order. Blank lines are ignored.
+/// Prints out error messages to stderr in case of failure.
+/// \return whether it succeeded.
+bool readFunctionOrder(
+    std::vector<uint32_t> &order,
+    llvm::StringRef inputPath) {
+  auto fileBuf = memoryBufferFromFile(inputPath);
+  if (!fileBuf) {
+    return false;
+  }
+  llvm::SmallVector<llvm::StringRef, 64> lines;
+  fileBuf->getBuffer().split(lines, '\n', -1, false);
+  for (llvm::StringRef line : lines) {
+    line = line.trim();
+    if (line.empty()) {
+      continue;
+    }
+    uint32_t id;
+    if (line.getAsInteger(10, id)) {
+      llvm::errs() << "Error! Invalid function ID in " << inputPath << ": "
+                   << line << '\n';
+      return false;
+    }
+    order.push_back(id);
+  }
+  return true;
+}
+
 /// Read base bytecode and returns whether it succeeded.
 bool readBaseBytecodeMap(
     BaseBytecodeMap &map,
@@ -1180,16 +1556,38 @@ bool generateIRForSourcesAsCJSModules(
   inputSourceMaps.push_back(nullptr);
   std::vector<std::string> sources{"<global>"};
 
+  // Parse the modules in parallel up front if requested. The ASTs must stay
+  // alive until the IR has been generated for them.
+  std::vector<ParallelParseResult> parallelResults{};
+  bool parseInParallel = cl::ParallelParseThreads > 1 &&
+      !context->isLazyCompilation() && !cl::FlowParser;
+  if (parseInParallel) {
+    std::vector<const llvm::MemoryBuffer *> bufs{};
+    for (auto &entry : fileBufs) {
+      for (auto &fileBufAndMap : entry.second)
+        bufs.push_back(fileBufAndMap.file.get());
+    }
+    parallelResults =
+        parseSourcesInParallel(*context, bufs, cl::ParallelParseThreads);
+  }
+
   Function *topLevelFunction = M.getTopLevelFunction();
+  size_t fileIndex = 0;
   for (auto &entry : fileBufs) {
     for (auto &fileBufAndMap : entry.second) {
       auto &fileBuf = fileBufAndMap.file;
+      const ParallelParseResult *parallelResult =
+          parseInParallel ? &parallelResults[fileIndex] : nullptr;
+      ++fileIndex;
       llvm::SmallString<64> filename{fileBuf->getBufferIdentifier()};
       if (sourceMapGen) {
         sources.push_back(fileBuf->getBufferIdentifier());
       }
       llvm::sys::path::replace_path_prefix(
           filename, rootPath, "./", llvm::sys::path::Style::posix);
+      // The AST of a module is not needed once its IR has been generated, so
+      // reuse its memory for the next module.
+      AllocationScope astScope(context->getAllocator());
       // TODO: use sourceMapTranslator for CJS module.
       auto *ast = parseJS(
           context,
@@ -1197,7 +1595,8 @@ bool generateIRForSourcesAsCJSModules(
           std::move(fileBuf),
           /*sourceMap*/ nullptr,
           /*sourceMapTranslator*/ nullptr,
-          /*wrapCJSModule*/ true);
+          /*wrapCJSModule*/ true,
+          parallelResult);
       if (!ast) {
         return false;
       }
@@ -1359,12 +1758,92 @@ CompileResult generateBytecodeForSerialization(
   return Success;
 }
 
+/// \return the path in -cache-dir of the bundle compiled from \p fileBufs
+/// with the command line \p args and the context \p context, or an empty
+/// string if the compilation is not cached.
+std::string getBundleCachePath(
+    const Context &context,
+    const SegmentTable &fileBufs,
+    llvm::ArrayRef<const char *> args) {
+  if (cl::CacheDir.empty() || args.empty() ||
+      context.getSegmentRanges().size() > 1) {
+    return "";
+  }
+
+  // The key covers everything the bundle depends on: the compiler, its
+  // arguments and the contents of every file that they name.
+  llvm::SHA1 hasher;
+  auto update = [&hasher](llvm::StringRef str) {
+    hasher.update(str);
+    // Separate the strings so that their boundaries are part of the key.
+    hasher.update(llvm::StringRef("", 1));
+  };
+#ifdef HERMES_RELEASE_VERSION
+  update(HERMES_RELEASE_VERSION);
+#endif
+  update(oscompat::to_string(hbc::BYTECODE_VERSION));
+  for (const char *arg : args) {
+    update(arg);
+  }
+  for (const auto &entry : fileBufs) {
+    for (const auto &fileAndMap : entry.second) {
+      update(fileAndMap.file->getBuffer());
+      update(fileAndMap.sourceMap ? fileAndMap.sourceMap->getBuffer() : "");
+    }
+  }
+  std::vector<std::string> namedFiles(
+      cl::IncludeGlobals.begin(), cl::IncludeGlobals.end());
+  namedFiles.push_back(cl::FunctionOrderFile);
+  namedFiles.push_back(cl::BaseBytecodeFile);
+  namedFiles.push_back(cl::InliningProfile);
+  for (const std::string &fileName : namedFiles) {
+    if (fileName.empty()) {
+      continue;
+    }
+    auto fileBuf = llvm::MemoryBuffer::getFile(fileName);
+    if (!fileBuf) {
+      // Compilation will report the error.
+      return "";
+    }
+    update(fileBuf.get()->getBuffer());
+  }
+
+  std::string key;
+  llvm::raw_string_ostream keyOS{key};
+  for (unsigned char c : hasher.final()) {
+    keyOS << llvm::format_hex_no_prefix(c, 2);
+  }
+  llvm::SmallString<64> path{cl::CacheDir};
+  llvm::sys::path::append(path, keyOS.str() + ".hbc");
+  return path.str().str();
+}
+
+/// Copy the bundle written to -out into the cache at \p cachePath.  Failing
+/// to do so is not an error, since the bundle has been compiled.
+void addToBundleCache(llvm::StringRef cachePath) {
+  if (llvm::sys::fs::create_directories(cl::CacheDir)) {
+    return;
+  }
+  // Copy to a temporary file first, so that a compilation running
+  // concurrently never sees a partial bundle.
+  llvm::SmallString<64> tmpPath;
+  if (llvm::sys::fs::createUniqueFile(cachePath + "-%%%%%%%%", tmpPath)) {
+    return;
+  }
+  if (llvm::sys::fs::copy_file(cl::BytecodeOutputFilename, tmpPath) ||
+      llvm::sys::fs::rename(tmpPath, cachePath)) {
+    llvm::sys::fs::remove(tmpPath);
+  }
+}
+
 /// Compiles the given files \p fileBufs with the context \p context,
-/// respecting the command line flags.
+/// respecting the command line flags.  \p args is the command line, which
+/// keys the compilation cache.
 /// \return a CompileResult containing the compilation status and artifacts.
 CompileResult processSourceFiles(
     std::shared_ptr<Context> context,
-    SegmentTable fileBufs) {
+    SegmentTable fileBufs,
+    llvm::ArrayRef<const char *> args) {
   assert(!fileBufs.empty() && "Need at least one file to compile");
   assert(context && "Need a context to compile using");
   assert(!cl::BytecodeMode && "Input files must not be bytecode");
@@ -1382,6 +1861,17 @@ CompileResult processSourceFiles(
   assert(
       rawFinalHash.size() == SHA1_NUM_BYTES && "Incorrect length of SHA1 hash");
   std::copy(rawFinalHash.begin(), rawFinalHash.end(), sourceHash.begin());
+
+  // Reuse the bundle of an identical earlier compilation if there is one.
+  const std::string cachePath = getBundleCachePath(*context, fileBufs, args);
+  if (!cachePath.empty() && llvm::sys::fs::exists(cachePath)) {
+    if (llvm::sys::fs::copy_file(cachePath, cl::BytecodeOutputFilename)) {
+      llvm::errs() << "Error: Could not copy " << cachePath << " to "
+                   << cl::BytecodeOutputFilename << '\n';
+      return OutputFileError;
+    }
+    return Success;
+  }
 #ifndef NDEBUG
   if (cl::LexerOnly) {
     unsigned count = 0;
@@ -1543,6 +2033,11 @@ CompileResult processSourceFiles(
   // options parsing and js parsing. Set the bytecode header flag here.
   genOptions.staticBuiltinsEnabled = context->getStaticBuiltinOptimization();
   genOptions.padFunctionBodiesPercent = cl::PadFunctionBodiesPercent;
+  genOptions.linearScanThreshold = cl::LinearScanThreshold;
+  if (!cl::FunctionOrderFile.empty() &&
+      !readFunctionOrder(genOptions.functionOrder, cl::FunctionOrderFile)) {
+    return InputFileError;
+  }
 
   // If the user requests to output a source map, then do not also emit debug
   // info into the bytecode.
@@ -1588,6 +2083,11 @@ CompileResult processSourceFiles(
     if (result.status != Success) {
       return result;
     }
+    if (!cachePath.empty()) {
+      // Close the bundle before copying it.
+      fileOS.reset();
+      addToBundleCache(cachePath);
+    }
   } else {
     std::string manifestStr;
     llvm::raw_string_ostream manifestOS{manifestStr};
@@ -1624,6 +2124,10 @@ CompileResult processSourceFiles(
       manifest.emitKeyValue("resource", llvm::sys::path::filename(base));
       manifest.emitKeyValue("flavor", flavor);
       manifest.emitKeyValue("location", llvm::sys::path::filename(filename));
+      // The IDs of the modules in the segment, which are the IDs passed to
+      // requireFast when require is resolved statically.
+      manifest.emitKeyValue("firstModule", range.first);
+      manifest.emitKeyValue("lastModule", range.last);
 
       manifest.closeDict();
     }
@@ -1693,7 +2197,7 @@ void printHermesREPLVersion(llvm::raw_ostream &s) {
   printHermesVersion(s, " REPL", false);
 }
 
-CompileResult compileFromCommandLineOptions() {
+CompileResult compileFromCommandLineOptions(llvm::ArrayRef<const char *> args) {
 #if !defined(NDEBUG) || defined(LLVM_ENABLE_STATS)
   if (cl::PrintStats)
     hermes::EnableStatistics();
@@ -1773,7 +2277,18 @@ CompileResult compileFromCommandLineOptions() {
   } else {
     std::shared_ptr<Context> context =
         createContext(std::move(resolutionTable), std::move(segmentRanges));
-    return processSourceFiles(context, std::move(fileBufs));
+    if (!context)
+      return InputFileError;
+    auto start = std::chrono::steady_clock::now();
+    CompileResult result =
+        processSourceFiles(context, std::move(fileBufs), args);
+    CompileMilliseconds =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count();
+    NumASTKilobytes = context->getAllocator().getSlabBytes() / 1024;
+    PeakRSSKilobytes = oscompat::peak_rss() / 1024;
+    return result;
   }
 }
 } // namespace driver
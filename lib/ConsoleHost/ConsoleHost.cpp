@@ -7,10 +7,12 @@
 #include "hermes/ConsoleHost/ConsoleHost.h"
 
 #include "hermes/CompilerDriver/CompilerDriver.h"
+#include "hermes/Support/AsyncOStream.h"
 #include "hermes/Support/MemoryBuffer.h"
 #include "hermes/Support/UTF8.h"
 #include "hermes/VM/Callable.h"
 #include "hermes/VM/Domain.h"
+#include "hermes/VM/JSLib.h"
 #include "hermes/VM/JSObject.h"
 #include "hermes/VM/NativeArgs.h"
 #include "hermes/VM/Profiler/SamplingProfiler.h"
@@ -19,6 +21,10 @@
 #include "hermes/VM/StringView.h"
 #include "hermes/VM/instrumentation/PerfEvents.h"
 
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
 namespace hermes {
 
 /// Raises an uncatchable quit exception.
@@ -27,6 +33,18 @@ quit(void *, vm::Runtime *runtime, vm::NativeArgs) {
   return runtime->raiseQuitError();
 }
 
+/// print(), writing to the raw_ostream \p ctx without flushing it.
+static vm::CallResult<vm::HermesValue>
+printToStream(void *ctx, vm::Runtime *runtime, vm::NativeArgs args) {
+  if (LLVM_UNLIKELY(
+          vm::printArgs(
+              runtime, args, *static_cast<llvm::raw_ostream *>(ctx)) ==
+          vm::ExecutionStatus::EXCEPTION)) {
+    return vm::ExecutionStatus::EXCEPTION;
+  }
+  return vm::HermesValue::encodeUndefinedValue();
+}
+
 static void printStats(vm::Runtime *runtime, llvm::raw_ostream &os) {
   std::string stats;
   {
@@ -103,10 +121,37 @@ loadSegment(void *ctx, vm::Runtime *runtime, vm::NativeArgs args) {
   return HermesValue::encodeUndefinedValue();
 }
 
+/// \return the bytecode of the segment next to \p baseFilename that defines
+/// the CJS module with ID \p moduleID, or null if there is none.  Segments are
+/// named as hermesc writes them, "<baseFilename>.<segment>", and numbered from
+/// 1.
+static std::shared_ptr<hbc::BCProvider> findSegmentForModule(
+    const std::string &baseFilename,
+    uint32_t moduleID) {
+  for (uint32_t segment = 1;; ++segment) {
+    auto fileBufRes = llvm::MemoryBuffer::getFile(
+        Twine(baseFilename) + "." + Twine(segment));
+    if (!fileBufRes) {
+      return nullptr;
+    }
+    auto ret = hbc::BCProviderFromBuffer::createBCProviderFromBuffer(
+        llvm::make_unique<OwnedMemoryBuffer>(std::move(*fileBufRes)));
+    if (!ret.first) {
+      return nullptr;
+    }
+    const uint32_t first = ret.first->getCJSModuleOffset();
+    if (moduleID >= first &&
+        moduleID - first < ret.first->getCJSModuleTableStatic().size()) {
+      return std::move(ret.first);
+    }
+  }
+}
+
 void installConsoleBindings(
     vm::Runtime *runtime,
     vm::StatSamplingThread *statSampler,
-    const std::string *filename) {
+    const std::string *filename,
+    llvm::raw_ostream *printStream) {
   vm::DefinePropertyFlags normalDPF{};
   normalDPF.setEnumerable = 1;
   normalDPF.setWritable = 1;
@@ -138,6 +183,13 @@ void installConsoleBindings(
       createHeapSnapshot,
       nullptr,
       2);
+  if (printStream) {
+    defineGlobalFunc(
+        vm::Predefined::getSymbolID(vm::Predefined::print),
+        printToStream,
+        printStream,
+        1);
+  }
 
   // Define the 'loadSegment' function.
   defineGlobalFunc(
@@ -166,14 +218,36 @@ bool executeHBCBytecode(
   auto runtime = vm::Runtime::create(options.runtimeConfig);
   runtime->getJITContext().setDumpJITCode(options.dumpJITCode);
   runtime->getJITContext().setCrashOnError(options.jitCrashOnError);
+  if (!options.jitProfileFile.empty()) {
+    // The profile doesn't exist before the first run.
+    if (auto profile = llvm::MemoryBuffer::getFile(options.jitProfileFile)) {
+      runtime->getJITContext().setProfile(llvm::ArrayRef<uint8_t>(
+          reinterpret_cast<const uint8_t *>((*profile)->getBufferStart()),
+          (*profile)->getBufferSize()));
+    }
+  }
 
   if (shouldRecordGCStats) {
     statSampler = llvm::make_unique<vm::StatSamplingThread>(
         std::chrono::milliseconds(100));
   }
 
+  // The JIT dumps its code to stdout while the script runs, so it can't share
+  // it with the writer thread.
+  std::unique_ptr<AsyncOStream> printStream;
+  if (options.bufferedOutput && !options.dumpJITCode) {
+    printStream = llvm::make_unique<AsyncOStream>(llvm::outs());
+  }
+
   vm::GCScope scope(runtime.get());
-  installConsoleBindings(runtime.get(), statSampler.get(), filename);
+  installConsoleBindings(
+      runtime.get(), statSampler.get(), filename, printStream.get());
+  if (filename) {
+    // Load the segments of statically required modules on demand.
+    runtime->setSegmentLoader([filename](uint32_t moduleID) {
+      return findSegmentForModule(*filename, moduleID);
+    });
+  }
 
   vm::RuntimeModuleFlags flags;
   flags.persistent = true;
@@ -202,6 +276,9 @@ bool executeHBCBytecode(
       flags,
       sourceURL,
       runtime->makeNullHandle<vm::Environment>());
+  // Run the promise jobs queued by the script.
+  bool threwException = status == vm::ExecutionStatus::EXCEPTION ||
+      runtime->drainJobs() == vm::ExecutionStatus::EXCEPTION;
 
   if (options.runtimeConfig.getEnableSampleProfiling()) {
     auto profiler = vm::SamplingProfiler::getInstance();
@@ -210,7 +287,10 @@ bool executeHBCBytecode(
     profiler->disable();
   }
 
-  bool threwException = status == vm::ExecutionStatus::EXCEPTION;
+  // Nothing else may write to stdout until the printed output is written.
+  if (printStream) {
+    printStream->sync();
+  }
 
   if (threwException) {
     // Make sure stdout catches up to stderr.
@@ -219,6 +299,19 @@ bool executeHBCBytecode(
         llvm::errs(), runtime->makeHandle(runtime->getThrownValue()));
   }
 
+  if (!options.jitProfileFile.empty()) {
+    std::vector<uint8_t> profile;
+    runtime->getJITContext().getProfile(profile);
+    std::error_code EC;
+    llvm::raw_fd_ostream os(options.jitProfileFile, EC, llvm::sys::fs::F_None);
+    if (EC) {
+      llvm::errs() << "Error: fail to open file " << options.jitProfileFile
+                   << ": " << EC.message() << '\n';
+    } else {
+      os.write(reinterpret_cast<const char *>(profile.data()), profile.size());
+    }
+  }
+
 #ifdef HERMESVM_PROFILER_OPCODE
   runtime->dumpOpcodeStats(llvm::outs());
 #endif
@@ -581,6 +581,30 @@ ThrowIfUndefinedInst *IRBuilder::createThrowIfUndefinedInst(
   return inst;
 }
 
+IteratorBeginInst *IRBuilder::createIteratorBeginInst(
+    AllocStackInst *sourceOrNext) {
+  auto *inst = new IteratorBeginInst(sourceOrNext);
+  insert(inst);
+  return inst;
+}
+
+IteratorNextInst *IRBuilder::createIteratorNextInst(
+    AllocStackInst *iterator,
+    AllocStackInst *sourceOrNext) {
+  auto *inst = new IteratorNextInst(iterator, sourceOrNext);
+  insert(inst);
+  return inst;
+}
+
+IteratorCloseInst *IRBuilder::createIteratorCloseInst(
+    Value *iterator,
+    bool ignoreInnerException) {
+  auto *inst = new IteratorCloseInst(
+      iterator, getLiteralBool(ignoreInnerException));
+  insert(inst);
+  return inst;
+}
+
 HBCGetGlobalObjectInst *IRBuilder::createHBCGetGlobalObjectInst() {
   auto inst = new HBCGetGlobalObjectInst();
   insert(inst);
@@ -752,6 +776,13 @@ HBCLoadFromEnvironmentInst *IRBuilder::createHBCLoadFromEnvironmentInst(
   return GSI;
 }
 
+HBCLoadFromOuterEnvironmentInst *
+IRBuilder::createHBCLoadFromOuterEnvironmentInst(Variable *var) {
+  auto GSI = new HBCLoadFromOuterEnvironmentInst(var);
+  insert(GSI);
+  return GSI;
+}
+
 SwitchImmInst *IRBuilder::createSwitchImmInst(
     Value *input,
     BasicBlock *defaultBlock,
@@ -813,6 +844,16 @@ HBCReifyArgumentsInst *IRBuilder::createHBCReifyArgumentsInst(
   insert(inst);
   return inst;
 }
+HBCCallApplyArgumentsInst *IRBuilder::createHBCCallApplyArgumentsInst(
+    Value *callee,
+    Value *thisValue,
+    Value *thisArg,
+    AllocStackInst *lazyReg) {
+  auto inst =
+      new HBCCallApplyArgumentsInst(callee, thisValue, thisArg, lazyReg);
+  insert(inst);
+  return inst;
+}
 HBCCreateThisInst *IRBuilder::createHBCCreateThisInst(
     Value *prototype,
     Value *closure) {
@@ -843,6 +884,14 @@ HBCProfilePointInst *IRBuilder::createHBCProfilePointInst(uint16_t pointIndex) {
   return inst;
 }
 
+HBCTypeOfIsInst *IRBuilder::createHBCTypeOfIsInst(
+    Value *argument,
+    uint8_t types) {
+  auto inst = new HBCTypeOfIsInst(argument, getLiteralNumber(types));
+  insert(inst);
+  return inst;
+}
+
 HBCCallBuiltinInst *IRBuilder::createHBCCallBuiltinInst(
     int builtinIndex,
     ArrayRef<Value *> arguments) {
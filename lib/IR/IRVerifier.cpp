@@ -256,6 +256,7 @@ void Verifier::beforeVisitInstruction(const Instruction &Inst) {
       Assert(
           isa<LoadFrameInst>(Inst) || isa<StoreFrameInst>(Inst) ||
               isa<HBCLoadFromEnvironmentInst>(Inst) ||
+              isa<HBCLoadFromOuterEnvironmentInst>(Inst) ||
               isa<HBCStoreToEnvironmentInst>(Inst),
           "Variable can only be accessed in "
           "LoadFrame/StoreFrame/HBCLoadFromEnvironmentInst/HBCStoreToEnvironmentInst Inst.");
@@ -266,9 +267,11 @@ void Verifier::beforeVisitInstruction(const Instruction &Inst) {
               isa<CatchInst>(Inst) || isa<GetPNamesInst>(Inst) ||
               isa<CheckHasInstanceInst>(Inst) || isa<GetNextPNameInst>(Inst) ||
               isa<ResumeGeneratorInst>(Inst) ||
+              isa<IteratorBeginInst>(Inst) || isa<IteratorNextInst>(Inst) ||
               isa<HBCGetArgumentsPropByValInst>(Inst) ||
               isa<HBCGetArgumentsLengthInst>(Inst) ||
-              isa<HBCReifyArgumentsInst>(Inst),
+              isa<HBCReifyArgumentsInst>(Inst) ||
+              isa<HBCCallApplyArgumentsInst>(Inst),
           "Stack variable can only be accessed in certain instructions.");
     }
   }
@@ -322,6 +325,13 @@ void Verifier::visitHBCLoadFromEnvironmentInst(
     const HBCLoadFromEnvironmentInst &Inst) {
   // Nothing to verify at this point.
 }
+void Verifier::visitHBCLoadFromOuterEnvironmentInst(
+    const HBCLoadFromOuterEnvironmentInst &Inst) {
+  Assert(
+      Inst.getResolvedName()->getParent()->getFunction() !=
+          Inst.getParent()->getParent(),
+      "HBCLoadFromOuterEnvironmentInst must load from an enclosing function");
+}
 void Verifier::visitHBCResolveEnvironment(const HBCResolveEnvironment &Inst) {
   // Nothing to verify at this point.
 }
@@ -720,6 +730,12 @@ void Verifier::visitHBCProfilePointInst(const HBCProfilePointInst &Inst) {
   // Nothing to verify at this point.
 }
 
+void Verifier::visitHBCTypeOfIsInst(const HBCTypeOfIsInst &Inst) {
+  Assert(
+      Inst.getTypes()->isUInt8Representible(),
+      "HBCTypeOfIsInst's types are not a uint8");
+}
+
 void Verifier::visitHBCAllocObjectFromBufferInst(
     const hermes::HBCAllocObjectFromBufferInst &Inst) {
   LiteralNumber *size = Inst.getSizeHint();
@@ -776,6 +792,12 @@ void Verifier::visitHBCGetArgumentsLengthInst(
 void Verifier::visitHBCReifyArgumentsInst(const HBCReifyArgumentsInst &Inst) {
   // Nothing to verify at this point.
 }
+void Verifier::visitHBCCallApplyArgumentsInst(
+    const HBCCallApplyArgumentsInst &Inst) {
+  Assert(
+      isa<AllocStackInst>(Inst.getLazyRegister()),
+      "HBCCallApplyArgumentsInst must use the lazy arguments register");
+}
 void Verifier::visitHBCConstructInst(const HBCConstructInst &Inst) {}
 void Verifier::visitHBCCreateThisInst(const HBCCreateThisInst &Inst) {}
 void Verifier::visitHBCGetConstructedObjectInst(
@@ -796,6 +818,23 @@ void Verifier::visitGetNewTargetInst(GetNewTargetInst const &Inst) {
 }
 
 void Verifier::visitThrowIfUndefinedInst(ThrowIfUndefinedInst const &Inst) {}
+void Verifier::visitIteratorBeginInst(IteratorBeginInst const &Inst) {
+  Assert(
+      isa<AllocStackInst>(Inst.getSourceOrNext()),
+      "IteratorBeginInst must take its source from a stack location");
+}
+void Verifier::visitIteratorNextInst(IteratorNextInst const &Inst) {
+  Assert(
+      isa<AllocStackInst>(Inst.getIterator()) &&
+          isa<AllocStackInst>(Inst.getSourceOrNext()),
+      "IteratorNextInst must operate on stack locations");
+}
+void Verifier::visitIteratorCloseInst(IteratorCloseInst const &Inst) {
+  Assert(
+      isa<LiteralBool>(
+          Inst.getOperand(IteratorCloseInst::IgnoreInnerExceptionIdx)),
+      "IteratorCloseInst's ignoreInnerException must be a literal bool");
+}
 
 } // namespace
 
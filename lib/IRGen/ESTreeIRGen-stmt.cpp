@@ -465,19 +465,17 @@ void ESTreeIRGen::genForOfStatement(ESTree::ForOfStatementNode *forOfStmt) {
   curFunction()->initLabel(forOfStmt, exitBlock, getNextBlock);
 
   auto *exprValue = genExpression(forOfStmt->_right);
-  auto iteratorRecord = emitGetIterator(exprValue);
+  auto iteratorRecord = emitGetIteratorFast(exprValue);
 
   Builder.createBranchInst(getNextBlock);
 
   Builder.setInsertionBlock(getNextBlock);
-  auto *nextResult = emitIteratorNext(iteratorRecord);
-  auto *done = emitIteratorComplete(nextResult);
+  auto *nextValue = emitIteratorNextFast(iteratorRecord);
+  auto *done = emitIteratorCompleteFast(iteratorRecord);
   Builder.createCondBranchInst(done, exitBlock, bodyBlock);
 
   Builder.setInsertionBlock(bodyBlock);
 
-  auto *nextValue = emitIteratorValue(nextResult);
-
   emitTryCatchScaffolding(
       getNextBlock,
       // emitBody.
@@ -489,7 +487,7 @@ void ESTreeIRGen::genForOfStatement(ESTree::ForOfStatementNode *forOfStmt) {
             {},
             [this, &iteratorRecord](ESTree::Node *, ControlFlowChange cfc) {
               if (cfc == ControlFlowChange::Break)
-                emitIteratorClose(iteratorRecord, false);
+                emitIteratorCloseFast(iteratorRecord, false);
             }};
 
         // Note: obtaing the value is not protected, but storing it is.
@@ -504,7 +502,7 @@ void ESTreeIRGen::genForOfStatement(ESTree::ForOfStatementNode *forOfStmt) {
       // emitHandler.
       [this, &iteratorRecord](BasicBlock *) {
         auto *catchReg = Builder.createCatchInst();
-        emitIteratorClose(iteratorRecord, true);
+        emitIteratorCloseFast(iteratorRecord, true);
         Builder.createThrowInst(catchReg);
       });
 
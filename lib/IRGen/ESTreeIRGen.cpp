@@ -673,6 +673,39 @@ void ESTreeIRGen::emitIteratorClose(
   Builder.setInsertionBlock(noReturn);
 }
 
+ESTreeIRGen::IteratorRecordFast ESTreeIRGen::emitGetIteratorFast(
+    Value *obj) {
+  auto *iterStorage =
+      Builder.createAllocStackInst(genAnonymousLabelName("iter"));
+  auto *sourceOrNext =
+      Builder.createAllocStackInst(genAnonymousLabelName("sourceOrNext"));
+  Builder.createStoreStackInst(obj, sourceOrNext);
+  auto *iter = Builder.createIteratorBeginInst(sourceOrNext);
+  Builder.createStoreStackInst(iter, iterStorage);
+  return {iterStorage, sourceOrNext};
+}
+
+Value *ESTreeIRGen::emitIteratorNextFast(IteratorRecordFast iteratorRecord) {
+  return Builder.createIteratorNextInst(
+      iteratorRecord.iterStorage, iteratorRecord.sourceOrNext);
+}
+
+Value *ESTreeIRGen::emitIteratorCompleteFast(
+    IteratorRecordFast iteratorRecord) {
+  return Builder.createBinaryOperatorInst(
+      Builder.createLoadStackInst(iteratorRecord.iterStorage),
+      Builder.getLiteralUndefined(),
+      BinaryOperatorInst::OpKind::StrictlyEqualKind);
+}
+
+void ESTreeIRGen::emitIteratorCloseFast(
+    IteratorRecordFast iteratorRecord,
+    bool ignoreInnerException) {
+  Builder.createIteratorCloseInst(
+      Builder.createLoadStackInst(iteratorRecord.iterStorage),
+      ignoreInnerException);
+}
+
 void ESTreeIRGen::emitDestructuringAssignment(
     bool declInit,
     ESTree::PatternNode *target,
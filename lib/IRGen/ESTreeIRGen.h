@@ -788,6 +788,33 @@ class ESTreeIRGen {
       IteratorRecord iteratorRecord,
       bool ignoreInnerException);
 
+  /// The state of a for-of loop, which the VM may iterate without creating
+  /// the iterator object, see IteratorBeginInst.
+  struct IteratorRecordFast {
+    /// The result of IteratorBeginInst, set to undefined when the iteration
+    /// is done.
+    AllocStackInst *iterStorage;
+    /// The iterated value or the next() method of the iterator.
+    AllocStackInst *sourceOrNext;
+  };
+
+  /// Begin the iteration of \p obj with IteratorBeginInst.
+  IteratorRecordFast emitGetIteratorFast(Value *obj);
+
+  /// \return the next value of the iteration, which is undefined when the
+  ///   iteration is done.
+  Value *emitIteratorNextFast(IteratorRecordFast iteratorRecord);
+
+  /// \return whether the iteration is done, which must be checked after
+  ///   emitIteratorNextFast().
+  Value *emitIteratorCompleteFast(IteratorRecordFast iteratorRecord);
+
+  /// Close the iteration when the loop is exited early, see
+  /// emitIteratorClose().
+  void emitIteratorCloseFast(
+      IteratorRecordFast iteratorRecord,
+      bool ignoreInnerException);
+
   /// Generate code for destructuring assignment to ArrayPattern or
   /// ObjectPattern.
   void emitDestructuringAssignment(
@@ -14,70 +14,23 @@
 namespace hermes {
 namespace inst {
 
-/// Store the structure of each opcode: size, number of operands and their
-/// types.
-static const struct {
-  /// Size of the entire instruction in bytes.
-  uint8_t size;
-  /// Number of operands.
-  uint8_t numOperands;
-  /// The type of each operand.
-  OperandType operandType[INST_MAX_OPERANDS];
-} meta[] = {
-#define DEFINE_OPCODE_0(name) {sizeof(inst::name##Inst), 0, {}},
-#define DEFINE_OPCODE_1(name, t1) \
-  {sizeof(inst::name##Inst), 1, {OperandType::t1}},
-#define DEFINE_OPCODE_2(name, t1, t2) \
-  {sizeof(inst::name##Inst), 2, {OperandType::t1, OperandType::t2}},
-#define DEFINE_OPCODE_3(name, t1, t2, t3) \
-  {sizeof(inst::name##Inst),              \
-   3,                                     \
-   {OperandType::t1, OperandType::t2, OperandType::t3}},
-#define DEFINE_OPCODE_4(name, t1, t2, t3, t4) \
-  {sizeof(inst::name##Inst),                  \
-   4,                                         \
-   {OperandType::t1, OperandType::t2, OperandType::t3, OperandType::t4}},
-#define DEFINE_OPCODE_5(name, t1, t2, t3, t4, t5) \
-  {sizeof(inst::name##Inst),                      \
-   5,                                             \
-   {OperandType::t1,                              \
-    OperandType::t2,                              \
-    OperandType::t3,                              \
-    OperandType::t4,                              \
-    OperandType::t5}},
-#define DEFINE_OPCODE_6(name, t1, t2, t3, t4, t5, t6) \
-  {sizeof(inst::name##Inst),                          \
-   6,                                                 \
-   {OperandType::t1,                                  \
-    OperandType::t2,                                  \
-    OperandType::t3,                                  \
-    OperandType::t4,                                  \
-    OperandType::t5,                                  \
-    OperandType::t6}},
-
-#include "hermes/BCGen/HBC/BytecodeList.def"
-};
+constexpr InstDescriptor detail::InstDescriptorTable::table[];
 
 InstMetaData getInstMetaData(OpCode opCode) {
   assert(opCode < OpCode::_last && "invalid OpCode");
 
-  const auto *pm = meta + (int)opCode;
+  const InstDescriptor &desc = getInstDescriptor(opCode);
   InstMetaData res;
 
   res.opCode = opCode;
-  res.size = pm->size;
-  res.numOperands = pm->numOperands;
+  res.size = desc.size;
+  res.numOperands = desc.numOperands;
   std::copy(
-      pm->operandType, pm->operandType + pm->numOperands, res.operandType);
+      desc.operandType, desc.operandType + desc.numOperands, res.operandType);
 
   return res;
 }
 
-uint8_t getInstSize(OpCode opCode) {
-  assert(opCode < OpCode::_last && "invalid OpCode");
-  return meta[(int)opCode].size;
-}
-
 uint8_t getOperandSize(OperandType type) {
 #define DEFINE_OPERAND_TYPE(name, ctype) \
   case OperandType::name:                \
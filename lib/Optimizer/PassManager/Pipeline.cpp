@@ -52,6 +52,10 @@ void hermes::runFullOptimizationPasses(Module &M) {
   // staticrequire creates some dead instructions (namely frame loads) which
   // need to be eliminated now, or the "require" parameter cannot be promoted.
   PM.addDCE();
+  // Once every require() is resolved, the modules that are never required are
+  // known. Removing them before the closure analysis makes it more precise.
+  PM.addDeadModuleElimination();
+  PM.addDCE();
 
   PM.addTypeInference();
   PM.addSimplifyCFG();
@@ -68,6 +72,9 @@ void hermes::runFullOptimizationPasses(Module &M) {
   PM.addCSE();
   PM.addTDZDedup();
   PM.addSimplifyCFG();
+  // Objects whose accesses were only split across blocks by inlining are in
+  // one block again after SimplifyCFG.
+  PM.addScalarReplacement();
 
   PM.addTypeInferenceWithCLA();
   PM.addConstantPropertyOpts();
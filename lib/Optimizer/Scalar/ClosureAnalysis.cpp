@@ -187,6 +187,21 @@ static void generateInstructionConstraints(
     }
     case ValueKind::AllocStackInstKind:
       break;
+    case ValueKind::IteratorBeginInstKind: {
+      // The iterated value escapes, and the iterator and the next() method
+      // stored to the stack come from unknown code.
+      auto *IBI = cast<IteratorBeginInst>(&I);
+      ap->addUnknownDst(IBI->getSourceOrNext());
+      ap->addUnknownSrc(IBI->getSourceOrNext());
+      ap->addUnknownSrc(IBI);
+      break;
+    }
+    case ValueKind::IteratorNextInstKind:
+      ap->addUnknownSrc(&I);
+      break;
+    case ValueKind::IteratorCloseInstKind:
+      ap->addUnknownDst(cast<IteratorCloseInst>(&I)->getIterator());
+      break;
     case ValueKind::AllocObjectInstKind: {
       auto *AI = cast<AllocObjectInst>(&I);
       llvm::DenseSet<Literal *> props;
@@ -232,6 +247,8 @@ static void generateInstructionConstraints(
       break;
     case ValueKind::HBCLoadFromEnvironmentInstKind:
       break;
+    case ValueKind::HBCLoadFromOuterEnvironmentInstKind:
+      break;
     case ValueKind::CreateFunctionInstKind: {
       CreateFunctionInst *CFI = cast<CreateFunctionInst>(&I);
       Function *F = CFI->getFunctionCode();
@@ -297,6 +314,7 @@ static void generateInstructionConstraints(
     case ValueKind::HBCGetArgumentsPropByValInstKind:
     case ValueKind::HBCGetArgumentsLengthInstKind:
     case ValueKind::HBCReifyArgumentsInstKind:
+    case ValueKind::HBCCallApplyArgumentsInstKind:
     case ValueKind::HBCGetConstructedObjectInstKind:
     case ValueKind::HBCSpillMovInstKind:
       llvm_unreachable("Target specific instructions in Optimizer phase.");
@@ -13,6 +13,7 @@
 #include "hermes/Support/Statistic.h"
 
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/Support/Debug.h"
 
 #include <algorithm>
@@ -24,6 +25,7 @@ using llvm::isa;
 STATISTIC(NumCM, "Number of instructions moved");
 STATISTIC(NumHoistedCond, "Number of instructions hoisted from conditionals");
 STATISTIC(NumHoistedLoop, "Number of instructions hoisted from loops");
+STATISTIC(NumHoistedLength, "Number of array lengths hoisted from loops");
 STATISTIC(NumSunk, "Number of instructions sunk");
 
 /// Search the \p searchBudget instructions following \p copy in search of
@@ -106,17 +108,60 @@ static bool hoistCBI(CondBranchInst *CBI) {
   }
 }
 
+/// \returns true if \p inst reads the length of an array allocated by
+/// AllocArrayInst. The length of an array is a non-configurable data property,
+/// so reading it can neither throw nor execute any code, and its value only
+/// changes when something writes to the array.
+static bool isArrayLengthLoad(Instruction *inst) {
+  auto *LPI = dyn_cast<LoadPropertyInst>(inst);
+  if (!LPI || !isa<AllocArrayInst>(LPI->getObject()))
+    return false;
+  auto *prop = dyn_cast<LiteralString>(LPI->getProperty());
+  return prop && prop->getValue().str() == "length";
+}
+
+/// \returns true if some instruction in the loop with header \p header may
+/// write to memory. The blocks of the loop are those that can reach one of its
+/// back edges without going through the header.
+static bool loopMayWrite(BasicBlock *header, const DominanceInfo &dominance) {
+  llvm::SmallPtrSet<BasicBlock *, 16> visited{header};
+  llvm::SmallVector<BasicBlock *, 16> worklist;
+  for (auto *pred : predecessors(header)) {
+    if (dominance.dominates(header, pred) && visited.insert(pred).second)
+      worklist.push_back(pred);
+  }
+  while (!worklist.empty()) {
+    BasicBlock *BB = worklist.pop_back_val();
+    for (auto *pred : predecessors(BB)) {
+      if (visited.insert(pred).second)
+        worklist.push_back(pred);
+    }
+  }
+
+  for (auto *BB : visited) {
+    for (auto &I : *BB) {
+      if (I.mayWriteMemory() && !isArrayLengthLoad(&I))
+        return true;
+    }
+  }
+  return false;
+}
+
 /// Check whether \p inst, an instruction in a loop, can be hoisted to just
 /// before \p branchInst, the last instruction in the preheader of the loop.
 /// Only certain types of instructions can be hoisted, and their dependencies
 /// must dominate \p branchInst.
 /// \param dominance the dominance tree for the function
+/// \param readOnlyLoop whether nothing in the loop writes to memory, in which
+///   case the length of an array is invariant and can be hoisted too.
 /// \returns true if \p inst is safe to hoist.
 static bool canHoistFromLoop(
     Instruction *inst,
     Instruction *branchInst,
-    const DominanceInfo &dominance) {
-  if (!isSimpleSideEffectFreeInstruction(inst)) {
+    const DominanceInfo &dominance,
+    bool readOnlyLoop) {
+  if (!isSimpleSideEffectFreeInstruction(inst) &&
+      !(readOnlyLoop && isArrayLengthLoad(inst))) {
     return false;
   }
   for (int i = 0, e = inst->getNumOperands(); i < e; ++i) {
@@ -129,11 +174,14 @@ static bool canHoistFromLoop(
 }
 
 /// Try to hoist instructions from a loop block to the preheader.
+/// \param readOnlyLoops caches the result of loopMayWrite() (negated) for
+///   each loop header.
 /// \returns true if some instructions were hoisted.
 static bool hoistInstructionsFromLoop(
     BasicBlock *BB,
     const DominanceInfo &dominance,
-    const LoopAnalysis &loops) {
+    const LoopAnalysis &loops,
+    llvm::DenseMap<BasicBlock *, bool> &readOnlyLoops) {
   bool changed = false;
   BasicBlock *preheader = loops.getLoopPreheader(BB);
   if (!preheader) {
@@ -145,12 +193,23 @@ static bool hoistInstructionsFromLoop(
   }
   Instruction *branchInst = &preheader->back();
 
+  BasicBlock *header = loops.getLoopHeader(BB);
+  auto cached = readOnlyLoops.find(header);
+  if (cached == readOnlyLoops.end()) {
+    cached =
+        readOnlyLoops.try_emplace(header, !loopMayWrite(header, dominance))
+            .first;
+  }
+  const bool readOnlyLoop = cached->second;
+
   for (auto it = BB->begin(), e = BB->end(); it != e;) {
     // Save the advanced iterator here since calling inst->moveBefore below
     // invalidates the iterator.
     auto nextIt = std::next(it);
     Instruction *inst = &*it;
-    if (canHoistFromLoop(inst, branchInst, dominance)) {
+    if (canHoistFromLoop(inst, branchInst, dominance, readOnlyLoop)) {
+      if (isArrayLengthLoad(inst))
+        ++NumHoistedLength;
       inst->moveBefore(branchInst);
       changed = true;
       ++NumCM;
@@ -213,6 +272,7 @@ bool CodeMotion::runOnFunction(Function *F) {
 
   DominanceInfo dominance(F);
   LoopAnalysis loops(F, dominance);
+  llvm::DenseMap<BasicBlock *, bool> readOnlyLoops;
 
   // Scan the function in post order (from end to start) and:
   //
@@ -229,7 +289,7 @@ bool CodeMotion::runOnFunction(Function *F) {
   // loops last, but post-order doesn't guarantee that.
   for (auto *BB : PO) {
     changed |= sinkInstructionsInBlock(BB, dominance, loops);
-    changed |= hoistInstructionsFromLoop(BB, dominance, loops);
+    changed |= hoistInstructionsFromLoop(BB, dominance, loops, readOnlyLoops);
   }
 
   return changed;
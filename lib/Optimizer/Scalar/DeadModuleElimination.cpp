@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#define DEBUG_TYPE "deadmodules"
+
+#include "hermes/Optimizer/Scalar/DeadModuleElimination.h"
+#include "hermes/IR/IRBuilder.h"
+#include "hermes/IR/Instrs.h"
+#include "hermes/Support/Statistic.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Debug.h"
+
+using namespace hermes;
+using llvm::dbgs;
+using llvm::dyn_cast;
+using llvm::isa;
+
+STATISTIC(NumDeadModules, "Number of unreachable CJS modules removed");
+
+/// The name of the function that ResolveStaticRequire calls instead of
+/// require().
+static constexpr llvm::StringLiteral kRequireFast{"requireFast"};
+
+/// \return true if \p LPI loads HermesInternal.requireFast.
+static bool isRequireFast(LoadPropertyInst *LPI) {
+  auto *name = dyn_cast<LiteralString>(LPI->getProperty());
+  return name && name->getValue().str() == kRequireFast;
+}
+
+/// \return true if a property of the "require" parameter of \p moduleFunction
+/// is read. This is how require.context() loads segments, which may require
+/// any module.
+static bool readsRequireProperty(Function *moduleFunction) {
+  llvm::SmallSetVector<Value *, 8> values;
+  values.insert(moduleFunction->getParameters()[1]);
+  for (size_t i = 0; i < values.size(); ++i) {
+    Value *V = values[i];
+    for (Instruction *I : V->getUsers()) {
+      if (auto *SS = dyn_cast<StoreStackInst>(I)) {
+        if (SS->getValue() == V)
+          values.insert(SS->getPtr());
+      } else if (auto *SF = dyn_cast<StoreFrameInst>(I)) {
+        if (SF->getValue() == V)
+          values.insert(SF->getVariable());
+      } else if (isa<LoadStackInst>(I) || isa<LoadFrameInst>(I)) {
+        values.insert(I);
+      } else if (auto *LPI = dyn_cast<LoadPropertyInst>(I)) {
+        if (LPI->getObject() == V)
+          return true;
+      }
+    }
+  }
+  return false;
+}
+
+/// Add to \p edges an edge from every function of \p M to the functions it
+/// creates, and to the modules that it requires.
+/// \return false if a call to requireFast() could not be resolved to a module.
+static bool buildUseGraph(
+    Module *M,
+    llvm::DenseMap<Function *, llvm::SmallVector<Function *, 2>> &edges) {
+  for (Function &F : *M) {
+    for (Instruction *user : F.getUsers())
+      edges[user->getParent()->getParent()].push_back(&F);
+
+    for (BasicBlock &BB : F) {
+      for (Instruction &I : BB) {
+        auto *LPI = dyn_cast<LoadPropertyInst>(&I);
+        if (!LPI || !isRequireFast(LPI))
+          continue;
+        // requireFast() must only be called directly, with a literal module
+        // ID.
+        for (Instruction *callUser : LPI->getUsers()) {
+          auto *call = dyn_cast<CallInst>(callUser);
+          if (!call || call->getCallee() != LPI ||
+              call->getNumArguments() < 2)
+            return false;
+          auto *id = dyn_cast<LiteralNumber>(call->getArgument(1));
+          auto modules = M->getCJSModules();
+          if (!id || !id->isUInt32Representible() ||
+              id->asUInt32() >= modules.end() - modules.begin())
+            return false;
+          edges[&F].push_back(modules.begin()[id->asUInt32()].function);
+        }
+      }
+    }
+  }
+  return true;
+}
+
+/// Replace the body of the module function \p F with a throw, so that the
+/// functions it creates become dead. The function itself stays in place to
+/// preserve the module IDs.
+static void removeModuleBody(Function *F) {
+  LLVM_DEBUG(
+      dbgs() << "Removing the body of module " << F->getInternalName()
+             << "\n");
+  ++NumDeadModules;
+
+  while (F->begin() != F->end()) {
+    F->begin()->replaceAllUsesWith(nullptr);
+    F->begin()->eraseFromParent();
+  }
+
+  IRBuilder B(F);
+  BasicBlock *BB = B.createBasicBlock(F);
+  B.setInsertionBlock(BB);
+  B.createThrowInst(B.getLiteralString(F->getInternalName()));
+}
+
+bool DeadModuleElimination::runOnModule(Module *M) {
+  // Only the first module is run on startup, and every other module must be
+  // reached through a resolved require() call. Segments are loaded by other
+  // means, so leave them alone.
+  if (!M->getCJSModulesResolved() ||
+      !M->getContext().getSegmentRanges().empty() ||
+      M->getCJSModules().empty())
+    return false;
+
+  for (const auto &module : M->getCJSModules()) {
+    if (readsRequireProperty(module.function))
+      return false;
+  }
+
+  llvm::DenseMap<Function *, llvm::SmallVector<Function *, 2>> edges;
+  if (!buildUseGraph(M, edges))
+    return false;
+
+  // Find the functions reachable from the entry points: the first module, and
+  // any code that is not in a module.
+  llvm::SmallSetVector<Function *, 16> reachable;
+  reachable.insert(M->getCJSModules().begin()->function);
+  for (Function &F : *M) {
+    if (F.isGlobalScope() && !M->findCJSModule(&F))
+      reachable.insert(&F);
+  }
+  for (size_t i = 0; i < reachable.size(); ++i) {
+    auto it = edges.find(reachable[i]);
+    if (it == edges.end())
+      continue;
+    for (Function *target : it->second)
+      reachable.insert(target);
+  }
+
+  bool changed = false;
+  for (const auto &module : M->getCJSModules()) {
+    if (!reachable.count(module.function)) {
+      removeModuleBody(module.function);
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+Pass *hermes::createDeadModuleElimination() {
+  return new DeadModuleElimination();
+}
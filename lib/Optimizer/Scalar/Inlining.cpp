@@ -13,6 +13,9 @@
 #include "hermes/Support/Statistic.h"
 
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
 
 using llvm::cast;
 using llvm::dyn_cast;
@@ -254,6 +257,126 @@ static Value *inlineFunction(
   return returnValue ? returnValue : cast<Value>(builder.getLiteralUndefined());
 }
 
+/// Inline \p FC, the direct callee of \p CI, at the place of the call.
+static void inlineCall(CallInst *CI, Function *FC) {
+  Function *intoFunction = CI->getParent()->getParent();
+  LLVM_DEBUG(llvm::dbgs() << "Inlining function '" << FC->getInternalNameStr()
+                          << "' ";
+             FC->getContext().getSourceErrorManager().dumpCoords(
+                 llvm::dbgs(), FC->getSourceRange().Start);
+             llvm::dbgs() << " into function '"
+                          << intoFunction->getInternalNameStr() << "' ";
+             FC->getContext().getSourceErrorManager().dumpCoords(
+                 llvm::dbgs(), intoFunction->getSourceRange().Start);
+             llvm::dbgs() << "\n";);
+
+  IRBuilder builder(intoFunction->getParent());
+
+  // Split the block in two and move all instructions following the call
+  // to the new block.
+  BasicBlock *nextBlock = builder.createBasicBlock(intoFunction);
+  builder.setInsertionBlock(nextBlock);
+
+  // Move the rest of the instructions.
+  auto it = CI->getIterator();
+  ++it; // Skip over the call.
+  auto e = CI->getParent()->end();
+  while (it != e)
+    builder.transferInstructionToCurrentBlock(&*it++);
+
+  // Perform the inlining.
+  builder.setInsertionPointAfter(CI);
+
+  auto *returnValue = inlineFunction(builder, FC, CI, nextBlock);
+  CI->replaceAllUsesWith(returnValue);
+  CI->eraseFromParent();
+
+  ++NumInlinedCalls;
+}
+
+/// \return the number of instructions in the reachable blocks of \p F.
+static unsigned countInstructions(Function *F) {
+  unsigned count = 0;
+  for (BasicBlock *BB : orderDFS(F))
+    count += BB->getInstList().size();
+  return count;
+}
+
+/// Inline the direct callees of the call sites that the profile in the
+/// inlining settings shows are hot, hottest first, for as long as the growth
+/// of the module stays within the budget.  The callees may be called from
+/// other places, which keep calling them.
+static bool inlineHotCalls(Module *M) {
+  const InliningSettings &settings =
+      M->getContext().getOptimizationSettings().inliningSettings;
+  if (settings.callCounts.empty())
+    return false;
+
+  SourceErrorManager &sm = M->getContext().getSourceErrorManager();
+
+  struct HotCall {
+    CallInst *CI;
+    uint64_t count;
+  };
+  llvm::SmallVector<HotCall, 8> hotCalls{};
+  uint64_t moduleSize = 0;
+  for (Function &F : *M) {
+    // Skip the functions left unused by the inlining of single calls.
+    if (!F.isGlobalScope() && !F.hasUsers() && !M->findCJSModule(&F))
+      continue;
+    for (BasicBlock &BB : F) {
+      moduleSize += BB.getInstList().size();
+      for (Instruction &I : BB) {
+        if (I.getKind() != ValueKind::CallInstKind)
+          continue;
+        auto *CI = cast<CallInst>(&I);
+        auto *CFI = dyn_cast<CreateFunctionInst>(CI->getCallee());
+        if (!CFI || CFI->getKind() != ValueKind::CreateFunctionInstKind ||
+            !isDirectCallee(CFI, CI))
+          continue;
+
+        SourceErrorManager::SourceCoords coords;
+        if (!CI->hasLocation() ||
+            !sm.findBufferLineAndLoc(CI->getLocation(), coords))
+          continue;
+        std::string key;
+        llvm::raw_string_ostream keyOS{key};
+        keyOS << sm.getBufferIdentifier(coords.bufId) << ':' << coords.line
+              << ':' << coords.col;
+        auto countIt = settings.callCounts.find(keyOS.str());
+        if (countIt == settings.callCounts.end() ||
+            countIt->second < settings.minHotCount)
+          continue;
+        hotCalls.push_back({CI, countIt->second});
+      }
+    }
+  }
+
+  std::stable_sort(
+      hotCalls.begin(),
+      hotCalls.end(),
+      [](const HotCall &a, const HotCall &b) { return a.count > b.count; });
+
+  const uint64_t budget = moduleSize * settings.hotGrowthPercent / 100;
+  uint64_t growth = 0;
+  bool changed = false;
+  for (const HotCall &hotCall : hotCalls) {
+    CallInst *CI = hotCall.CI;
+    Function *FC = cast<CreateFunctionInst>(CI->getCallee())->getFunctionCode();
+    if (!canBeInlined(FC, CI->getParent()->getParent()))
+      continue;
+    unsigned size = countInstructions(FC);
+    if (size > settings.maxHotCalleeSize || growth + size > budget)
+      continue;
+
+    inlineCall(CI, FC);
+    growth += size;
+    changed = true;
+  }
+
+  return changed;
+}
+
 bool Inlining::runOnModule(Module *M) {
   if (!M->getContext().getOptimizationSettings().inlining)
     return false;
@@ -284,42 +407,13 @@ bool Inlining::runOnModule(Module *M) {
       if (!canBeInlined(FC, intoFunction))
         continue;
 
-      LLVM_DEBUG(llvm::dbgs() << "Inlining function '"
-                              << FC->getInternalNameStr() << "' ";
-                 FC->getContext().getSourceErrorManager().dumpCoords(
-                     llvm::dbgs(), FC->getSourceRange().Start);
-                 llvm::dbgs() << " into function '"
-                              << intoFunction->getInternalNameStr() << "' ";
-                 FC->getContext().getSourceErrorManager().dumpCoords(
-                     llvm::dbgs(), intoFunction->getSourceRange().Start);
-                 llvm::dbgs() << "\n";);
-
-      IRBuilder builder(M);
-
-      // Split the block in two and move all instructions following the call
-      // to the new block.
-      BasicBlock *nextBlock = builder.createBasicBlock(intoFunction);
-      builder.setInsertionBlock(nextBlock);
-
-      // Move the rest of the instructions.
-      auto it = CI->getIterator();
-      ++it; // Skip over the call.
-      auto e = CI->getParent()->end();
-      while (it != e)
-        builder.transferInstructionToCurrentBlock(&*it++);
-
-      // Perform the inlining.
-      builder.setInsertionPointAfter(CI);
-
-      auto *returnValue = inlineFunction(builder, FC, CI, nextBlock);
-      CI->replaceAllUsesWith(returnValue);
-      CI->eraseFromParent();
-
-      ++NumInlinedCalls;
+      inlineCall(CI, FC);
       changed = true;
     }
   }
 
+  changed |= inlineHotCalls(M);
+
   return changed;
 }
 
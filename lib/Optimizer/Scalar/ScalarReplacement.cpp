@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#define DEBUG_TYPE "scalarreplacement"
+
+#include "hermes/Optimizer/Scalar/ScalarReplacement.h"
+#include "hermes/IR/Instrs.h"
+#include "hermes/Support/Statistic.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Debug.h"
+
+using namespace hermes;
+using llvm::dbgs;
+using llvm::dyn_cast;
+using llvm::isa;
+
+STATISTIC(NumObjectsReplaced, "Number of objects replaced by their fields");
+STATISTIC(NumLoadsReplaced, "Number of property loads replaced");
+
+/// \return the name of the property that \p I accesses on \p obj if \p I is
+/// a store or a load that only uses \p obj as the object, or nullptr if \p I
+/// uses \p obj in any other way.
+static LiteralString *getAccessedName(Instruction *I, AllocObjectInst *obj) {
+  Value *object;
+  Value *property;
+  Value *storedValue = nullptr;
+  switch (I->getKind()) {
+    case ValueKind::StoreNewOwnPropertyInstKind:
+    case ValueKind::StoreOwnPropertyInstKind: {
+      auto *SOP = cast<StoreOwnPropertyInst>(I);
+      object = SOP->getObject();
+      property = SOP->getProperty();
+      storedValue = SOP->getStoredValue();
+      break;
+    }
+    case ValueKind::StorePropertyInstKind: {
+      auto *SPI = cast<StorePropertyInst>(I);
+      object = SPI->getObject();
+      property = SPI->getProperty();
+      storedValue = SPI->getStoredValue();
+      break;
+    }
+    case ValueKind::LoadPropertyInstKind: {
+      auto *LPI = cast<LoadPropertyInst>(I);
+      object = LPI->getObject();
+      property = LPI->getProperty();
+      break;
+    }
+    default:
+      return nullptr;
+  }
+  if (object != obj || property == obj || storedValue == obj)
+    return nullptr;
+  return dyn_cast<LiteralString>(property);
+}
+
+/// Replace the object \p obj if it does not escape, which is when it is only
+/// accessed in its own block, by loads and stores of constant property names.
+/// Every load must read a property that the block has defined on the object
+/// before, so that no lookup ever reaches the prototype: the value loaded is
+/// then the last one stored.
+/// \return true if the object was replaced.
+static bool replaceObject(AllocObjectInst *obj) {
+  BasicBlock *BB = obj->getParent();
+  for (Instruction *user : obj->getUsers()) {
+    if (user->getParent() != BB || !getAccessedName(user, obj))
+      return false;
+  }
+
+  // Walk the block to check that every access can be resolved, and record
+  // the value that each load reads.
+  llvm::SmallDenseMap<LiteralString *, Value *, 8> fields{};
+  llvm::SmallVector<std::pair<Instruction *, Value *>, 8> loads{};
+  llvm::SmallVector<Instruction *, 8> stores{};
+  // The value of each load, so that storing the result of a load of the same
+  // object stores the value that it reads instead.
+  llvm::SmallDenseMap<Value *, Value *, 8> loadValues{};
+  auto resolve = [&loadValues](Value *V) {
+    auto loadIt = loadValues.find(V);
+    return loadIt == loadValues.end() ? V : loadIt->second;
+  };
+  unsigned numUsersSeen = 0;
+  for (auto it = std::next(obj->getIterator()), e = BB->end();
+       it != e && numUsersSeen < obj->getNumUsers();
+       ++it) {
+    Instruction *I = &*it;
+    LiteralString *name = getAccessedName(I, obj);
+    if (!name)
+      continue;
+    ++numUsersSeen;
+    switch (I->getKind()) {
+      case ValueKind::StoreNewOwnPropertyInstKind:
+      case ValueKind::StoreOwnPropertyInstKind:
+        // Defining an own property of an extensible object always succeeds.
+        fields[name] =
+            resolve(cast<StoreOwnPropertyInst>(I)->getStoredValue());
+        stores.push_back(I);
+        break;
+      case ValueKind::StorePropertyInstKind: {
+        // Writing a property that is not an own one may call a setter of the
+        // prototype.
+        auto fieldIt = fields.find(name);
+        if (fieldIt == fields.end())
+          return false;
+        fieldIt->second =
+            resolve(cast<StorePropertyInst>(I)->getStoredValue());
+        stores.push_back(I);
+        break;
+      }
+      default: {
+        auto fieldIt = fields.find(name);
+        if (fieldIt == fields.end())
+          return false;
+        loads.push_back({I, fieldIt->second});
+        loadValues[I] = fieldIt->second;
+        break;
+      }
+    }
+  }
+  assert(
+      numUsersSeen == obj->getNumUsers() &&
+      "users of the object must follow it in its block");
+
+  LLVM_DEBUG(
+      dbgs() << "Replacing an object in function "
+             << BB->getParent()->getInternalNameStr() << "\n");
+  for (auto &load : loads) {
+    load.first->replaceAllUsesWith(load.second);
+    load.first->eraseFromParent();
+    ++NumLoadsReplaced;
+  }
+  for (Instruction *store : stores)
+    store->eraseFromParent();
+  obj->eraseFromParent();
+  ++NumObjectsReplaced;
+  return true;
+}
+
+bool ScalarReplacement::runOnFunction(Function *F) {
+  llvm::SmallVector<AllocObjectInst *, 8> objects{};
+  for (BasicBlock &BB : *F) {
+    for (Instruction &I : BB) {
+      if (auto *AOI = dyn_cast<AllocObjectInst>(&I))
+        objects.push_back(AOI);
+    }
+  }
+
+  bool changed = false;
+  for (AllocObjectInst *obj : objects)
+    changed |= replaceObject(obj);
+  return changed;
+}
+
+Pass *hermes::createScalarReplacement() {
+  return new ScalarReplacement();
+}
@@ -12,18 +12,21 @@
 #include "hermes/Optimizer/Scalar/Utils.h"
 #include "hermes/Support/Statistic.h"
 
+#include "llvm/ADT/BitVector.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
-#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/STLExtras.h"
-#include "llvm/ADT/ScopedHashTable.h"
 #include "llvm/Support/Debug.h"
-#include "llvm/Support/RecyclingAllocator.h"
+
+#include <algorithm>
 
 STATISTIC(NumTDZFrameDedup, "Number of TDZ frame checks eliminated");
 STATISTIC(NumTDZStackDedup, "Number of TDZ stack checks eliminated");
 STATISTIC(NumTDZOtherDedup, "Number of TDZ other checks eliminated");
 STATISTIC(NumTDZDedup, "Number of TDZ instructions eliminated");
+STATISTIC(
+    NumTDZClosureDedup,
+    "Number of TDZ instructions eliminated in closures");
 
 namespace hermes {
 
@@ -32,167 +35,330 @@ using llvm::isa;
 
 namespace {
 
-class TDZDedupContext;
-
-using TDZDedupValueHTType = llvm::ScopedHashTableVal<Value *, Value *>;
-using AllocatorTy =
-    llvm::RecyclingAllocator<llvm::BumpPtrAllocator, TDZDedupValueHTType>;
-using ScopedHTType = llvm::
-    ScopedHashTable<Value *, Value *, llvm::DenseMapInfo<Value *>, AllocatorTy>;
-
-// StackNode - contains all the needed information to create a stack for doing
-// a depth first traversal of the tree. This includes scopes for values and
-// loads as well as the generation. There is a child iterator so that the
-// children do not need to be store spearately.
-class StackNode : public DomTreeDFS::StackNode<TDZDedupContext> {
+/// TDZDedupContext - This pass does a forward dataflow analysis of every
+/// function, computing the TDZ flags which are known to be set at each point,
+/// and eliminates the checks and the stores of flags which are already set.
+/// TDZ flags are unique in the sense that once they are set, they can never go
+/// back to undefined, except in the prologue of the function owning them. So
+/// a flag is known to be set in a block if it is set at the end of all its
+/// predecessors. A closure can only run after it has been created, so the
+/// frame flags known to be set wherever it is created are also known to be set
+/// when it is entered.
+class TDZDedupContext {
  public:
-  inline StackNode(TDZDedupContext *ctx, DominanceInfoNode *n);
+  explicit TDZDedupContext(Module *M) : M_(M) {}
+
+  bool run();
 
  private:
-  /// RAII to create and pop a scope when the stack node is created and
-  /// destroyed.
-  ScopedHTType::ScopeTy scope_;
-};
+  enum class State { NotStarted, InProgress, Done };
 
-/// TDZDedupContext - This pass does a simple depth-first walk of the dominator
-/// tree, eliminating trivially redundant instructions.
-class TDZDedupContext : public DomTreeDFS::Visitor<TDZDedupContext, StackNode> {
- public:
-  TDZDedupContext(Function *F, DominanceInfo &DT)
-      : DomTreeDFS::Visitor<TDZDedupContext, StackNode>(DT), F_(F) {}
+  /// \return the TDZ storage checked by \p TIU: a Variable, an
+  ///   AllocStackInst, or the checked value itself if it has been SSA-ed.
+  static Value *getCheckedStorage(ThrowIfUndefinedInst *TIU);
 
-  bool run();
+  /// Collect the TDZ state variables of the module and the frame flags which
+  /// are stored a value which may be undefined after a closure may have been
+  /// created.
+  void collect();
 
-  bool processNode(StackNode *SN);
+  /// Analyze \p F, after the functions creating it, and eliminate its
+  /// redundant checks.
+  void runOnFunction(Function *F);
 
- private:
-  friend StackNode;
+  /// \return the frame flags known to be set at every instruction creating
+  ///   \p F, or nothing if it may be entered in another way.
+  llvm::SmallVector<Variable *, 4> getEntryFacts(Function *F);
 
-  Function *const F_;
+  /// Apply the effect of the instructions of \p BB to \p known, whose bits
+  /// correspond to the storages in \p index. If \p destroyer is not null,
+  /// also eliminate the redundant instructions and record the frame flags
+  /// known at the creation of closures.
+  bool transfer(
+      BasicBlock *BB,
+      const llvm::DenseMap<Value *, unsigned> &index,
+      llvm::BitVector &known,
+      IRBuilder::InstructionDestroyer *destroyer);
+
+  Module *const M_;
 
   /// All TDZ state variables are collected here.
   llvm::DenseSet<Value *> tdzState_{};
 
-  /// AvailableValues - This scoped hash table contains the TDZ flags that are
-  /// known to be true. It is instances of Variable, AllocStackInst, or
-  /// theoretically an Instruction * if the value has been SSA-ed.
-  /// TDZ values are unique in the sense that once they are set to true, or
-  /// detected to be true, they can never go back to undefined. So, a check
-  /// that is dominated by a another check of the same value or storing true
-  /// to the same value, is always safe to eliminate.
-  ScopedHTType availableValues_{};
-};
+  /// The frame flags which may go back to undefined after a closure has been
+  /// created, so they must not be assumed to be set in closures.
+  llvm::DenseSet<Value *> notMonotonic_{};
 
-inline StackNode::StackNode(TDZDedupContext *ctx, DominanceInfoNode *n)
-    : DomTreeDFS::StackNode<TDZDedupContext>(ctx, n),
-      scope_{ctx->availableValues_} {}
+  /// The progress of the analysis of each function.
+  llvm::DenseMap<Function *, State> state_{};
 
-bool TDZDedupContext::run() {
-  // First, collect all TDZ state variables.
-  for (auto &BB : *F_) {
-    for (auto &I : BB) {
-      auto *TIU = dyn_cast<ThrowIfUndefinedInst>(&I);
-      if (!TIU)
-        continue;
+  /// The frame flags known to be set at each instruction creating a closure.
+  llvm::DenseMap<CreateFunctionInst *, llvm::SmallVector<Variable *, 4>>
+      creationFacts_{};
 
-      Value *checkedValue = TIU->getCheckedValue();
-      Value *tdzStorage;
+  bool changed_{false};
+};
 
-      if (auto *LFI = dyn_cast<LoadFrameInst>(checkedValue)) {
-        tdzStorage = LFI->getSingleOperand();
-      } else if (auto *LSI = dyn_cast<LoadStackInst>(checkedValue)) {
-        tdzStorage = LSI->getSingleOperand();
-      } else {
-        continue;
+Value *TDZDedupContext::getCheckedStorage(ThrowIfUndefinedInst *TIU) {
+  Value *checkedValue = TIU->getCheckedValue();
+  if (auto *LFI = dyn_cast<LoadFrameInst>(checkedValue))
+    return LFI->getSingleOperand();
+  if (auto *LSI = dyn_cast<LoadStackInst>(checkedValue))
+    return LSI->getSingleOperand();
+  return checkedValue;
+}
+
+void TDZDedupContext::collect() {
+  for (auto &F : *M_) {
+    for (auto &BB : F) {
+      for (auto &I : BB) {
+        if (auto *TIU = dyn_cast<ThrowIfUndefinedInst>(&I))
+          tdzState_.insert(getCheckedStorage(TIU));
       }
+    }
+  }
 
-      tdzState_.insert(tdzStorage);
+  // The owner of a flag initializes it to undefined in its prologue, before
+  // creating any closure. Any other store which may be undefined prevents
+  // assuming the flag in closures.
+  for (auto &F : *M_) {
+    bool createdClosure = false;
+    for (auto &BB : F) {
+      for (auto &I : BB) {
+        if (isa<CreateFunctionInst>(&I)) {
+          createdClosure = true;
+          continue;
+        }
+        auto *SF = dyn_cast<StoreFrameInst>(&I);
+        if (!SF || !SF->getValue()->getType().canBeUndefined())
+          continue;
+        Variable *var = SF->getVariable();
+        if (!tdzState_.count(var))
+          continue;
+        if (createdClosure || &BB != &*F.begin() ||
+            var->getParent()->getFunction() != &F) {
+          notMonotonic_.insert(var);
+        }
+      }
     }
   }
+}
 
-  return DFS();
+llvm::SmallVector<Variable *, 4> TDZDedupContext::getEntryFacts(Function *F) {
+  llvm::SmallVector<Instruction *, 2> creators{
+      F->getUsers().begin(), F->getUsers().end()};
+  llvm::SmallVector<Variable *, 4> facts{};
+  bool first = true;
+  for (Instruction *user : creators) {
+    auto *CFI = dyn_cast<CreateFunctionInst>(user);
+    if (!CFI || CFI->getFunctionCode() != F)
+      return {};
+    Function *creator = CFI->getParent()->getParent();
+    State creatorState = state_.lookup(creator);
+    if (creatorState == State::InProgress)
+      return {};
+    if (creatorState == State::NotStarted)
+      runOnFunction(creator);
+
+    auto it = creationFacts_.find(CFI);
+    if (it == creationFacts_.end())
+      return {};
+    if (first) {
+      facts = it->second;
+      first = false;
+    } else {
+      const auto &siteFacts = it->second;
+      facts.erase(
+          std::remove_if(
+              facts.begin(),
+              facts.end(),
+              [&siteFacts](Variable *var) {
+                return std::find(siteFacts.begin(), siteFacts.end(), var) ==
+                    siteFacts.end();
+              }),
+          facts.end());
+    }
+  }
+  return facts;
 }
 
-bool TDZDedupContext::processNode(StackNode *SN) {
-  BasicBlock *BB = SN->node()->getBlock();
+bool TDZDedupContext::transfer(
+    BasicBlock *BB,
+    const llvm::DenseMap<Value *, unsigned> &index,
+    llvm::BitVector &known,
+    IRBuilder::InstructionDestroyer *destroyer) {
   bool changed = false;
-
-  // Keep a list of instructions that should be deleted when the basic block
-  // is processed.
-  IRBuilder::InstructionDestroyer destroyer;
-
-  // See if any instructions in the block can be eliminated.  If so, do it.  If
-  // not, add them to AvailableValues.
   for (auto &inst : *BB) {
+    if (auto *CFI = dyn_cast<CreateFunctionInst>(&inst)) {
+      if (destroyer) {
+        auto &facts = creationFacts_[CFI];
+        for (auto &entry : index) {
+          auto *var = dyn_cast<Variable>(entry.first);
+          if (var && known.test(entry.second) && !notMonotonic_.count(var))
+            facts.push_back(var);
+        }
+      }
+      continue;
+    }
+
     Value *checkedValue = nullptr;
     Value *tdzStorage = nullptr;
+    bool sets = true;
     if (auto *TIU = dyn_cast<ThrowIfUndefinedInst>(&inst)) {
       checkedValue = TIU->getCheckedValue();
-
-      if (auto *LFI = dyn_cast<LoadFrameInst>(checkedValue)) {
-        tdzStorage = LFI->getSingleOperand();
-      } else if (auto *LSI = dyn_cast<LoadStackInst>(checkedValue)) {
-        tdzStorage = LSI->getSingleOperand();
-      } else {
-        tdzStorage = checkedValue;
-      }
+      tdzStorage = getCheckedStorage(TIU);
     } else if (auto *SF = dyn_cast<StoreFrameInst>(&inst)) {
-      // Check whether it is setting the target to non-undefined.
-      if (SF->getValue()->getType().canBeUndefined())
-        continue;
       tdzStorage = SF->getVariable();
-      // Is the target a TDZ state variable?
-      if (!tdzState_.count(tdzStorage))
-        continue;
-    } else if (auto *SS = dyn_cast<StoreStackInst>(&inst)) {
       // Check whether it is setting the target to non-undefined.
-      if (SS->getValue()->getType().canBeUndefined())
-        continue;
+      sets = !SF->getValue()->getType().canBeUndefined();
+    } else if (auto *SS = dyn_cast<StoreStackInst>(&inst)) {
       tdzStorage = SS->getPtr();
-      // Is the target a TDZ state variable?
-      if (!tdzState_.count(tdzStorage))
-        continue;
+      // Check whether it is setting the target to non-undefined.
+      sets = !SS->getValue()->getType().canBeUndefined();
     } else {
       continue;
     }
 
-    // If the tdz state is not already known to be set to true, add it to
-    // the map.
-    if (!availableValues_.count(tdzStorage)) {
-      availableValues_.insert(tdzStorage, tdzStorage);
+    // Is the target a TDZ state variable?
+    auto it = index.find(tdzStorage);
+    if (it == index.end())
+      continue;
+    if (!sets) {
+      known.reset(it->second);
+      continue;
+    }
+    // If the tdz state is not already known to be set to true, it is now.
+    if (!known.test(it->second)) {
+      known.set(it->second);
       continue;
     }
+    if (!destroyer)
+      continue;
 
     // The TDZ state is known to be true, so we can eliminate the instruction,
     // which is either a check, or a store to set the state to true.
-    destroyer.add(&inst);
+    destroyer->add(&inst);
     changed = true;
     ++NumTDZDedup;
+    if (auto *var = dyn_cast<Variable>(tdzStorage)) {
+      if (var->getParent()->getFunction() != BB->getParent())
+        ++NumTDZClosureDedup;
+    }
 
     // Attempt to destroy the load too, to save work in other passes.
     if (checkedValue) {
       if (auto *LFI = dyn_cast<LoadFrameInst>(checkedValue)) {
         ++NumTDZFrameDedup;
         if (LFI->hasOneUser())
-          destroyer.add(LFI);
+          destroyer->add(LFI);
       } else if (auto *LSI = dyn_cast<LoadStackInst>(checkedValue)) {
         ++NumTDZStackDedup;
         if (LSI->hasOneUser())
-          destroyer.add(LSI);
+          destroyer->add(LSI);
       } else {
         ++NumTDZOtherDedup;
       }
     }
   }
-
   return changed;
 }
 
+void TDZDedupContext::runOnFunction(Function *F) {
+  state_[F] = State::InProgress;
+  llvm::SmallVector<Variable *, 4> entryFacts = getEntryFacts(F);
+
+  // Number the TDZ storages used in the function, including the flags known
+  // on entry, which must reach the closures it creates even if it doesn't use
+  // them.
+  llvm::DenseMap<Value *, unsigned> index{};
+  for (Variable *var : entryFacts)
+    index.try_emplace(var, index.size());
+  for (auto &BB : *F) {
+    for (auto &I : BB) {
+      Value *storage = nullptr;
+      if (auto *TIU = dyn_cast<ThrowIfUndefinedInst>(&I))
+        storage = getCheckedStorage(TIU);
+      else if (auto *SF = dyn_cast<StoreFrameInst>(&I))
+        storage = SF->getVariable();
+      else if (auto *SS = dyn_cast<StoreStackInst>(&I))
+        storage = SS->getPtr();
+      if (storage && tdzState_.count(storage))
+        index.try_emplace(storage, index.size());
+    }
+  }
+  if (index.empty()) {
+    state_[F] = State::Done;
+    return;
+  }
+
+  // The order of the blocks is reverse-post-order, so that most predecessors
+  // are visited before their successors. Unreachable blocks are ignored.
+  PostOrderAnalysis PO(F);
+  llvm::SmallVector<BasicBlock *, 16> order(PO.rbegin(), PO.rend());
+  BasicBlock *entry = &*F->begin();
+  const unsigned numStorages = index.size();
+
+  llvm::BitVector entryKnown(numStorages);
+  for (Variable *var : entryFacts)
+    entryKnown.set(index[var]);
+
+  // The flags known to be set at the end of each reachable block. They start
+  // as all set, and only decrease until the fixed point.
+  llvm::DenseMap<BasicBlock *, llvm::BitVector> out{};
+  for (BasicBlock *BB : order)
+    out[BB] = llvm::BitVector(numStorages, true);
+
+  auto knownOnEntry = [&](BasicBlock *BB) {
+    llvm::BitVector known =
+        BB == entry ? entryKnown : llvm::BitVector(numStorages, true);
+    for (BasicBlock *pred : predecessors(BB)) {
+      auto it = out.find(pred);
+      if (it != out.end())
+        known &= it->second;
+    }
+    return known;
+  };
+
+  bool iterate = true;
+  while (iterate) {
+    iterate = false;
+    for (BasicBlock *BB : order) {
+      llvm::BitVector known = knownOnEntry(BB);
+      transfer(BB, index, known, nullptr);
+      llvm::BitVector &blockOut = out[BB];
+      if (known != blockOut) {
+        blockOut = std::move(known);
+        iterate = true;
+      }
+    }
+  }
+
+  for (BasicBlock *BB : order) {
+    // Keep a list of instructions that should be deleted when the basic block
+    // is processed.
+    IRBuilder::InstructionDestroyer destroyer;
+    llvm::BitVector known = knownOnEntry(BB);
+    changed_ |= transfer(BB, index, known, &destroyer);
+  }
+  state_[F] = State::Done;
+}
+
+bool TDZDedupContext::run() {
+  collect();
+  if (tdzState_.empty())
+    return false;
+
+  for (auto &F : *M_) {
+    if (state_.lookup(&F) == State::NotStarted)
+      runOnFunction(&F);
+  }
+  return changed_;
+}
+
 } // end anonymous namespace
 
-bool TDZDedup::runOnFunction(Function *F) {
-  DominanceInfo DT{F};
-  TDZDedupContext CCtx{F, DT};
+bool TDZDedup::runOnModule(Module *M) {
+  TDZDedupContext CCtx{M};
   return CCtx.run();
 }
 
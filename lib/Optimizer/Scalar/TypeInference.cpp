@@ -516,6 +516,17 @@ bool TypeInferenceImpl::inferLoadPropertyInst(LoadPropertyInst *LPI) {
   Type originalTy = LPI->getType();
   bool unique = true;
 
+  // The length of an array is always a number.
+  if (isa<AllocArrayInst>(LPI->getObject())) {
+    auto *prop = dyn_cast<LiteralString>(LPI->getProperty());
+    if (prop && prop->getValue().str() == "length") {
+      if (originalTy.isNumberType())
+        return false;
+      LPI->setType(Type::createNumber());
+      return true;
+    }
+  }
+
   // Bail out if there are unknown receivers.
   if (cgp_->hasUnknownReceivers(LPI))
     return false;
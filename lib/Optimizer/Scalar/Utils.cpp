@@ -65,7 +65,8 @@ Value *hermes::isStoreOnceStackLocation(AllocStackInst *AS) {
       continue;
     }
 
-    llvm_unreachable("invalid user!");
+    // Other instructions, like IteratorBeginInst, may write to the location.
+    return nullptr;
   }
 
   return res;
@@ -10,6 +10,15 @@
 #include "hermes/dtoa/dtoa.h"
 
 #include "llvm/ADT/StringSwitch.h"
+#include "llvm/Support/MathExtras.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HERMES_LEXER_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define HERMES_LEXER_NEON
+#endif
 
 using llvm::Twine;
 
@@ -41,6 +50,141 @@ inline bool matchUnicodeLineTerminatorOffset1(const char *curCharPtr_) {
       ((unsigned char)curCharPtr_[2] == 0xa8 ||
        (unsigned char)curCharPtr_[2] == 0xa9);
 }
+
+// Runs of plain bytes in comments, strings, identifiers and whitespace are
+// skipped a chunk at a time. The chunk scans never look past the end of the
+// buffer: they stop when fewer than a chunk of bytes remain, and the regular
+// byte-at-a-time code takes over from there.
+#if defined(HERMES_LEXER_SSE2) || defined(HERMES_LEXER_NEON)
+/// The number of bytes examined at once.
+constexpr ptrdiff_t kChunkSize = 16;
+
+// Each lane of a ByteMask is either all ones or all zeros.
+#ifdef HERMES_LEXER_SSE2
+using ByteVec = __m128i;
+using ByteMask = __m128i;
+
+inline ByteVec loadChunk(const char *p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+inline ByteMask equals(ByteVec v, char c) {
+  return _mm_cmpeq_epi8(v, _mm_set1_epi8(c));
+}
+/// \return the lanes of \p v in the range [lo, lo + width].
+inline ByteMask inRange(ByteVec v, char lo, unsigned char width) {
+  ByteVec d = _mm_sub_epi8(v, _mm_set1_epi8(lo));
+  return _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(width)), d);
+}
+inline ByteMask nonASCII(ByteVec v) {
+  return _mm_cmplt_epi8(v, _mm_setzero_si128());
+}
+inline ByteVec splat(char c) {
+  return _mm_set1_epi8(c);
+}
+inline ByteVec bitOr(ByteVec a, ByteVec b) {
+  return _mm_or_si128(a, b);
+}
+inline ByteVec bitNot(ByteVec v) {
+  return _mm_xor_si128(v, _mm_set1_epi8(-1));
+}
+/// \return the index of the first set lane of \p m, or kChunkSize.
+inline ptrdiff_t firstSetLane(ByteMask m) {
+  unsigned bits = _mm_movemask_epi8(m);
+  return bits ? llvm::countTrailingZeros(bits) : kChunkSize;
+}
+#else
+using ByteVec = uint8x16_t;
+using ByteMask = uint8x16_t;
+
+inline ByteVec loadChunk(const char *p) {
+  return vld1q_u8(reinterpret_cast<const uint8_t *>(p));
+}
+inline ByteMask equals(ByteVec v, char c) {
+  return vceqq_u8(v, vdupq_n_u8((uint8_t)c));
+}
+/// \return the lanes of \p v in the range [lo, lo + width].
+inline ByteMask inRange(ByteVec v, char lo, unsigned char width) {
+  return vcleq_u8(vsubq_u8(v, vdupq_n_u8((uint8_t)lo)), vdupq_n_u8(width));
+}
+inline ByteMask nonASCII(ByteVec v) {
+  return vcgeq_u8(v, vdupq_n_u8(0x80));
+}
+inline ByteVec splat(char c) {
+  return vdupq_n_u8((uint8_t)c);
+}
+inline ByteVec bitOr(ByteVec a, ByteVec b) {
+  return vorrq_u8(a, b);
+}
+inline ByteVec bitNot(ByteVec v) {
+  return vmvnq_u8(v);
+}
+/// \return the index of the first set lane of \p m, or kChunkSize.
+inline ptrdiff_t firstSetLane(ByteMask m) {
+  // Narrow every lane to four bits, since there is no movemask.
+  uint64_t bits = vget_lane_u64(
+      vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+  return bits ? llvm::countTrailingZeros(bits) / 4 : kChunkSize;
+}
+#endif
+
+/// Skip whole chunks starting at \p p while \p match(chunk) has no set
+/// lane. \return the first matching byte, or the position where fewer than a
+/// chunk of bytes remain before \p end.
+template <typename Match>
+inline const char *skipChunks(const char *p, const char *end, Match match) {
+  while (end - p >= kChunkSize) {
+    ptrdiff_t i = firstSetLane(match(loadChunk(p)));
+    if (i != kChunkSize)
+      return p + i;
+    p += kChunkSize;
+  }
+  return p;
+}
+
+/// \return the first byte from \p p that is \p a, \p b, \p c, \p d or not
+/// ASCII, or a position near \p end.
+inline const char *
+skipToSpecial(const char *p, const char *end, char a, char b, char c, char d) {
+  return skipChunks(p, end, [=](ByteVec v) {
+    ByteMask ab = bitOr(equals(v, a), equals(v, b));
+    ByteMask cd = bitOr(equals(v, c), equals(v, d));
+    return bitOr(bitOr(ab, cd), nonASCII(v));
+  });
+}
+
+/// \return the first byte from \p p that is not an ASCII identifier part,
+/// or a position near \p end.
+inline const char *skipIdentifierChunks(const char *p, const char *end) {
+  return skipChunks(p, end, [](ByteVec v) {
+    // The same test as scanIdentifierFastPath(): letters in either case map
+    // to the range of the lower case letters.
+    ByteMask letter = inRange(bitOr(v, splat(32)), 'a', 'z' - 'a');
+    ByteMask idPart = bitOr(
+        bitOr(letter, inRange(v, '0', 9)),
+        bitOr(equals(v, '_'), equals(v, '$')));
+    return bitNot(idPart);
+  });
+}
+
+/// \return the first byte from \p p that is not a space or a tab, or a
+/// position near \p end.
+inline const char *skipBlankChunks(const char *p, const char *end) {
+  return skipChunks(p, end, [](ByteVec v) {
+    return bitNot(bitOr(equals(v, ' '), equals(v, '\t')));
+  });
+}
+#else
+inline const char *
+skipToSpecial(const char *p, const char *, char, char, char, char) {
+  return p;
+}
+inline const char *skipIdentifierChunks(const char *p, const char *) {
+  return p;
+}
+inline const char *skipBlankChunks(const char *p, const char *) {
+  return p;
+}
+#endif
 } // namespace
 
 const char *tokenKindStr(TokenKind kind) {
@@ -242,9 +386,9 @@ const Token *JSLexer::advance(GrammarContext grammarContext) {
       case '\t':
       case ' ':
         // Spaces frequently come in groups, so use a tight inner loop to skip.
-        do
+        curCharPtr_ = skipBlankChunks(curCharPtr_ + 1, bufferEnd_);
+        while (*curCharPtr_ == '\t' || *curCharPtr_ == ' ')
           ++curCharPtr_;
-        while (*curCharPtr_ == '\t' || *curCharPtr_ == ' ');
         continue;
 
       // No-break space \u00A0 is UTF8 encoded as: c2 a0
@@ -490,9 +634,9 @@ bool JSLexer::isCurrentTokenADirective() {
       case '\t':
       case ' ':
         // Spaces frequently come in groups, so use a tight inner loop to skip.
-        do
+        ptr = skipBlankChunks(ptr + 1, bufferEnd_);
+        while (*ptr == '\t' || *ptr == ' ')
           ++ptr;
-        while (*ptr == '\t' || *ptr == ' ');
         continue;
 
       // No-break space \u00A0 is UTF8 encoded as: c2 a0
@@ -723,7 +867,7 @@ const char *JSLexer::skipLineComment(const char *start) {
         if (LLVM_UNLIKELY(isUTF8Start(*start)))
           _decodeUTF8SlowPath(start);
         else
-          ++start;
+          start = skipToSpecial(start + 1, bufferEnd_, '\n', '\r', '\n', '\r');
         break;
     }
   }
@@ -777,7 +921,7 @@ const char *JSLexer::skipBlockComment(const char *start) {
         if (LLVM_UNLIKELY(isUTF8Start(*start)))
           _decodeUTF8SlowPath(start);
         else
-          ++start;
+          start = skipToSpecial(start + 1, bufferEnd_, '*', '\n', '\r', '*');
         break;
     }
   }
@@ -985,14 +1129,12 @@ TokenKind JSLexer::scanReservedWord(const char *start, unsigned length) {
 }
 
 void JSLexer::scanIdentifierFastPath(const char *start) {
-  const char *end = start;
-
   // Quickly consume the ASCII identifier part.
-  char ch;
-  do
-    ch = (unsigned char)*++end;
+  const char *end = skipIdentifierChunks(start + 1, bufferEnd_);
+  char ch = (unsigned char)*end;
   while (ch == '_' || ch == '$' || ((ch | 32) >= 'a' && (ch | 32) <= 'z') ||
-         (ch >= '0' && ch <= '9'));
+         (ch >= '0' && ch <= '9'))
+    ch = (unsigned char)*++end;
 
   // Check whether a slow part of the identifier follows.
   if (LLVM_UNLIKELY(ch == '\\')) {
@@ -1165,7 +1307,11 @@ void JSLexer::scanString() {
         // storage
         appendUnicodeToStorage(_decodeUTF8SlowPath(curCharPtr_));
       } else {
-        tmpStorage_.push_back(*curCharPtr_++);
+        // Append the run of plain characters that follows at once.
+        const char *runEnd = skipToSpecial(
+            curCharPtr_ + 1, bufferEnd_, quoteCh, '\\', '\n', '\r');
+        tmpStorage_.append(curCharPtr_, runEnd);
+        curCharPtr_ = runEnd;
       }
     }
   }
@@ -470,8 +470,16 @@ Optional<ESTree::BlockStatementNode *> JSParserImpl::parseFunctionBody(
     bool parseDirectives) {
   if (pass_ == LazyParse && !eagerly) {
     auto startLoc = tok_->getStartLoc();
-    assert(preParsed_->bodyStartToEnd.count(startLoc) == 1);
-    auto endLoc = preParsed_->bodyStartToEnd[startLoc];
+    auto it = preParsed_->bodyStartToEnd.find(startLoc);
+    if (it == preParsed_->bodyStartToEnd.end()) {
+      // The buffer was not pre-parsed, so find the end of the body now.
+      auto optEnd = scanFunctionBodyEnd();
+      if (!optEnd)
+        return None;
+      it = preParsed_->bodyStartToEnd.insert({startLoc, *optEnd}).first;
+      seek(startLoc);
+    }
+    auto endLoc = it->second;
     if (endLoc.getPointer() - startLoc.getPointer() >
         PreemptiveCompilationThresholdBytes) {
       lexer_.seek(endLoc);
@@ -495,6 +503,68 @@ Optional<ESTree::BlockStatementNode *> JSParserImpl::parseFunctionBody(
   return body;
 }
 
+Optional<SMLoc> JSParserImpl::scanFunctionBodyEnd() {
+  assert(check(TokenKind::l_brace) && "function body must start with '{'");
+  SMLoc startLoc = tok_->getStartLoc();
+  unsigned braceDepth = 0;
+  // For every open parenthesis, whether it encloses the condition of a
+  // statement, after which a '/' starts a regexp instead of a division.
+  llvm::SmallVector<bool, 8> conditionParens{};
+  TokenKind prevKind = TokenKind::none;
+
+  for (;;) {
+    TokenKind kind = tok_->getKind();
+    auto grammarContext = JSLexer::AllowRegExp;
+    switch (kind) {
+      case TokenKind::eof:
+        errorExpected(
+            TokenKind::r_brace,
+            "at end of function body",
+            "location of '{'",
+            startLoc);
+        return None;
+
+      case TokenKind::l_brace:
+        ++braceDepth;
+        break;
+      case TokenKind::r_brace:
+        if (--braceDepth == 0)
+          return tok_->getEndLoc();
+        break;
+
+      case TokenKind::l_paren:
+        conditionParens.push_back(
+            prevKind == TokenKind::rw_if || prevKind == TokenKind::rw_while ||
+            prevKind == TokenKind::rw_for || prevKind == TokenKind::rw_with);
+        break;
+      case TokenKind::r_paren:
+        if (conditionParens.empty() || !conditionParens.pop_back_val())
+          grammarContext = JSLexer::AllowDiv;
+        break;
+
+      // Tokens which end an operand.
+      case TokenKind::identifier:
+      case TokenKind::numeric_literal:
+      case TokenKind::string_literal:
+      case TokenKind::regexp_literal:
+      case TokenKind::r_square:
+      case TokenKind::rw_this:
+      case TokenKind::rw_null:
+      case TokenKind::rw_true:
+      case TokenKind::rw_false:
+      case TokenKind::plusplus:
+      case TokenKind::minusminus:
+        grammarContext = JSLexer::AllowDiv;
+        break;
+
+      default:
+        break;
+    }
+    prevKind = kind;
+    advance(grammarContext);
+  }
+}
+
 Optional<ESTree::Node *> JSParserImpl::parseDeclaration(Param param) {
   assert(checkDeclaration() && "invalid start for declaration");
 
@@ -443,6 +443,13 @@ class JSParserImpl {
       JSLexer::GrammarContext grammarContext = JSLexer::AllowRegExp,
       bool parseDirectives = false);
 
+  /// Find the end of the function body starting at the current '{' by
+  /// matching brackets, without parsing it. This is used in \p LazyParse mode
+  /// for functions which were not pre-parsed, leaving their validation to the
+  /// time they are compiled.
+  /// \return the end location of the closing '}', or None on error.
+  Optional<SMLoc> scanFunctionBodyEnd();
+
   /// Parse a declaration.
   /// \param param [Yield]
   Optional<ESTree::Node *> parseDeclaration(Param param);
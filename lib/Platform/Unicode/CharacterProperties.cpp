@@ -26,8 +26,21 @@ struct UnicodeRangeComp {
 };
 } // namespace
 
+/// \return whether \p cp is in \p table, whose code points below
+/// UNICODE_CATEGORY_TRIE_LIMIT are those with \p flag in the category trie.
 template <typename UnicodeRangeTable>
-inline bool lookup(const UnicodeRangeTable &table, const uint32_t cp) {
+inline bool lookup(
+    const UnicodeRangeTable &table,
+    UnicodeCategoryFlag flag,
+    const uint32_t cp) {
+  if (cp < UNICODE_CATEGORY_TRIE_LIMIT) {
+    constexpr uint32_t blockMask = (1u << UNICODE_CATEGORY_TRIE_SHIFT) - 1;
+    uint32_t block =
+        UNICODE_CATEGORY_TRIE_INDEX[cp >> UNICODE_CATEGORY_TRIE_SHIFT];
+    return UNICODE_CATEGORY_TRIE_BLOCKS
+               [(block << UNICODE_CATEGORY_TRIE_SHIFT) | (cp & blockMask)] &
+        flag;
+  }
   return std::binary_search(
       std::begin(table), std::end(table), cp, UnicodeRangeComp());
 }
@@ -40,7 +53,7 @@ bool isUnicodeOnlyLetter(uint32_t cp) {
   if (cp <= 0x7F)
     return false;
 
-  return lookup(UNICODE_LETTERS, cp);
+  return lookup(UNICODE_LETTERS, UNICODE_LETTERS_FLAG, cp);
 }
 
 // Special cased due to small number of separate values.
@@ -76,19 +89,24 @@ bool isUnicodeOnlySpace(uint32_t cp) {
 bool isUnicodeCombiningMark(uint32_t cp) {
   // "any character in the Unicode categories “Non-spacing mark (Mn)” or
   // “Combining spacing mark (Mc)”"
-  return lookup(UNICODE_COMBINING_MARK, cp);
+  return lookup(UNICODE_COMBINING_MARK, UNICODE_COMBINING_MARK_FLAG, cp);
 }
 
 bool isUnicodeDigit(uint32_t cp) {
   // "any character in the Unicode category “Decimal number (Nd)”"
   // 0-9 is the common case.
-  return (cp >= '0' && cp <= '9') || lookup(UNICODE_DIGIT, cp);
+  return (cp >= '0' && cp <= '9') ||
+      lookup(UNICODE_DIGIT, UNICODE_DIGIT_FLAG, cp);
 };
 
 bool isUnicodeConnectorPunctuation(uint32_t cp) {
   // "any character in the Unicode category “Connector punctuation (Pc)"
   // _ is the common case.
-  return cp == '_' || lookup(UNICODE_CONNECTOR_PUNCTUATION, cp);
+  return cp == '_' ||
+      lookup(
+             UNICODE_CONNECTOR_PUNCTUATION,
+             UNICODE_CONNECTOR_PUNCTUATION_FLAG,
+             cp);
 }
 
 // Predicate used to enable binary search on mappings.
@@ -10,6 +10,9 @@
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/TrailingObjects.h"
 
+#include <algorithm>
+#include <cstring>
+
 // This file contains the machinery for executing a regexp compiled to bytecode.
 
 namespace hermes {
@@ -18,6 +21,9 @@ namespace regex {
 template <class Traits>
 struct State;
 
+template <class Traits>
+class NFAMatcher;
+
 /// \return whether a regex match performed using the given \p flags can
 /// possibly match the given \p constraints.
 inline bool flagsSatisfyConstraints(
@@ -34,6 +40,17 @@ inline bool flagsSatisfyConstraints(
   return true;
 }
 
+/// \return the first occurrence of \p c in the range [\p first, \p last), or
+/// \p last if there is none.
+inline const char *findChar(const char *first, const char *last, char c) {
+  const void *found = std::memchr(first, c, last - first);
+  return found ? static_cast<const char *>(found) : last;
+}
+inline const char16_t *
+findChar(const char16_t *first, const char16_t *last, char16_t c) {
+  return std::find(first, last, c);
+}
+
 /// The kind of error that occurred when trying to find a match.
 enum class MatchRuntimeErrorType {
   /// No error occurred.
@@ -42,6 +59,9 @@ enum class MatchRuntimeErrorType {
   /// Reached maximum stack depth while searching for match.
   MaxStackDepth,
 
+  /// Backtracked more times than allowed by Context::backtracksLeft_.
+  BacktrackLimit,
+
 };
 
 /// An enum describing Width1 opcodes. This is the set of regex opcodes which
@@ -230,6 +250,11 @@ struct Context {
   /// Whether an error occurred during the regex matching.
   MatchRuntimeErrorType error_ = MatchRuntimeErrorType::None;
 
+  /// The number of times the match may still backtrack. It is only limited
+  /// when the bytecode can also be matched without backtracking, which is
+  /// then done instead.
+  uint64_t backtracksLeft_ = UINT64_MAX;
+
   Context(
       llvm::ArrayRef<uint8_t> bytecodeStream,
       constants::MatchFlagType flags,
@@ -280,6 +305,9 @@ struct Context {
     return true;
   }
 
+  /// \return whether \p c matches the Width1 instruction \p insn.
+  bool matchesWidth1(const Insn *insn, CharT c) const;
+
   /// Run the given Width1Loop \p insn on the given state \p s with the
   /// backtrack stack \p bts.
   /// \return true on success, false if we should backtrack.
@@ -289,6 +317,8 @@ struct Context {
       BacktrackStack &bts);
 
  private:
+  friend class NFAMatcher<Traits>;
+
   /// Do initialization of the given state before it enters the loop body
   /// described by the LoopInsn \p loop, including setting up any backtracking
   /// state.
@@ -308,6 +338,28 @@ struct Context {
   template <Width1Opcode w1opcode>
   inline uint32_t
   matchWidth1LoopBody(const Insn *loopBody, const CharT *pos, uint32_t max);
+
+  /// Given a Width1Opcode \p w1opcode, \return the first character at or
+  /// after \p pos which matches the instruction \p insn, or last_.
+  template <Width1Opcode w1opcode>
+  inline const CharT *findWidth1(const Insn *insn, const CharT *pos) const;
+
+  /// Follow the bytecode from \p ip up to its first instruction which isn't
+  /// a MatchChar, and store the characters matched before it in \p prefix.
+  /// Only capture group boundaries may come before them, so that every match
+  /// starts with \p prefix. \return nullptr if \p prefix isn't empty, or if
+  /// the first instruction isn't a Width1 instruction; otherwise \return it.
+  const Insn *scanMatchStart(
+      const uint8_t *ip,
+      llvm::SmallVectorImpl<CharT> &prefix) const;
+
+  /// \return the first location at or after \p pos where a match can start,
+  /// given the \p prefix and \p firstInsn found by scanMatchStart(), or
+  /// nullptr if there is none.
+  const CharT *findMatchStart(
+      const CharT *pos,
+      llvm::ArrayRef<CharT> prefix,
+      const Insn *firstInsn) const;
 };
 
 /// We store loop and captured range data contiguously in a single allocation at
@@ -400,6 +452,22 @@ bool matchesRightAnchor(Context<Traits> &ctx, State<Traits> &s) {
   return matchesAnchor;
 }
 
+/// \return whether the position of \p s is a word boundary.
+template <class Traits>
+bool matchesWordBoundary(Context<Traits> &ctx, State<Traits> &s) {
+  bool prevIsWordchar = false;
+  if (s.current_ != ctx.first_ ||
+      (ctx.flags_ & constants::matchPreviousCharAvailable))
+    prevIsWordchar =
+        ctx.traits_.characterHasType(s.current_[-1], CharacterClass::Words);
+
+  bool currentIsWordchar = false;
+  if (s.current_ != ctx.last_)
+    currentIsWordchar =
+        ctx.traits_.characterHasType(s.current_[0], CharacterClass::Words);
+  return prevIsWordchar != currentIsWordchar;
+}
+
 /// \return true if the character \p ch matches a bracket instruction \p insn,
 /// containing the bracket ranges \p ranges. Note the count of ranges is given
 /// in \p insn.
@@ -484,6 +552,11 @@ bool Context<Traits>::performEnterNonGreedyLoop(
 
 template <class Traits>
 bool Context<Traits>::backtrack(BacktrackStack &bts, State<Traits> *s) {
+  if (LLVM_UNLIKELY(backtracksLeft_ == 0)) {
+    error_ = MatchRuntimeErrorType::BacktrackLimit;
+    return false;
+  }
+  backtracksLeft_--;
   while (!bts.empty()) {
     BacktrackInsn &binsn = bts.back();
     switch (binsn.op) {
@@ -591,6 +664,26 @@ bool Context<Traits>::matchWidth1(const Insn *base, CharT c) const {
   llvm_unreachable("Invalid width 1 opcode");
 }
 
+template <class Traits>
+bool Context<Traits>::matchesWidth1(const Insn *insn, CharT c) const {
+  using W1 = Width1Opcode;
+  switch (static_cast<Width1Opcode>(insn->opcode)) {
+    case W1::MatchChar8:
+      return matchWidth1<W1::MatchChar8>(insn, c);
+    case W1::MatchChar16:
+      return matchWidth1<W1::MatchChar16>(insn, c);
+    case W1::MatchCharICase8:
+      return matchWidth1<W1::MatchCharICase8>(insn, c);
+    case W1::MatchCharICase16:
+      return matchWidth1<W1::MatchCharICase16>(insn, c);
+    case W1::MatchAnyButNewline:
+      return matchWidth1<W1::MatchAnyButNewline>(insn, c);
+    case W1::Bracket:
+      return matchWidth1<W1::Bracket>(insn, c);
+  }
+  llvm_unreachable("Invalid width 1 opcode");
+}
+
 template <class Traits>
 template <Width1Opcode w1opcode>
 uint32_t Context<Traits>::matchWidth1LoopBody(
@@ -605,6 +698,93 @@ uint32_t Context<Traits>::matchWidth1LoopBody(
   return iters;
 }
 
+template <class Traits>
+template <Width1Opcode w1opcode>
+auto Context<Traits>::findWidth1(const Insn *insn, const CharT *pos) const
+    -> const CharT * {
+  while (pos != last_ && !matchWidth1<w1opcode>(insn, *pos))
+    pos++;
+  return pos;
+}
+
+template <class Traits>
+const Insn *Context<Traits>::scanMatchStart(
+    const uint8_t *ip,
+    llvm::SmallVectorImpl<CharT> &prefix) const {
+  for (;;) {
+    const Insn *insn = reinterpret_cast<const Insn *>(ip);
+    switch (insn->opcode) {
+      case Opcode::BeginMarkedSubexpression:
+        ip += sizeof(BeginMarkedSubexpressionInsn);
+        break;
+      case Opcode::EndMarkedSubexpression:
+        ip += sizeof(EndMarkedSubexpressionInsn);
+        break;
+      case Opcode::MatchChar8:
+        prefix.push_back(llvm::cast<MatchChar8Insn>(insn)->c);
+        ip += sizeof(MatchChar8Insn);
+        break;
+      case Opcode::MatchChar16:
+        // An ASCII input can't contain the character, which is left to the
+        // Width1 check below.
+        if (sizeof(CharT) == 1)
+          return prefix.empty() ? insn : nullptr;
+        prefix.push_back(llvm::cast<MatchChar16Insn>(insn)->c);
+        ip += sizeof(MatchChar16Insn);
+        break;
+      case Opcode::MatchCharICase8:
+      case Opcode::MatchCharICase16:
+      case Opcode::MatchAnyButNewline:
+      case Opcode::Bracket:
+        return prefix.empty() ? insn : nullptr;
+      default:
+        return nullptr;
+    }
+  }
+}
+
+template <class Traits>
+auto Context<Traits>::findMatchStart(
+    const CharT *pos,
+    llvm::ArrayRef<CharT> prefix,
+    const Insn *firstInsn) const -> const CharT * {
+  if (!prefix.empty()) {
+    if ((size_t)(last_ - pos) < prefix.size())
+      return nullptr;
+    // Look for the first character of the prefix, and then compare the rest.
+    const CharT *end = last_ - (prefix.size() - 1);
+    for (;; pos++) {
+      pos = findChar(pos, end, prefix[0]);
+      if (pos == end)
+        return nullptr;
+      if (std::equal(prefix.begin() + 1, prefix.end(), pos + 1))
+        return pos;
+    }
+  }
+  using W1 = Width1Opcode;
+  switch (static_cast<Width1Opcode>(firstInsn->opcode)) {
+    case W1::MatchChar8:
+      pos = findWidth1<W1::MatchChar8>(firstInsn, pos);
+      break;
+    case W1::MatchChar16:
+      pos = findWidth1<W1::MatchChar16>(firstInsn, pos);
+      break;
+    case W1::MatchCharICase8:
+      pos = findWidth1<W1::MatchCharICase8>(firstInsn, pos);
+      break;
+    case W1::MatchCharICase16:
+      pos = findWidth1<W1::MatchCharICase16>(firstInsn, pos);
+      break;
+    case W1::MatchAnyButNewline:
+      pos = findWidth1<W1::MatchAnyButNewline>(firstInsn, pos);
+      break;
+    case W1::Bracket:
+      pos = findWidth1<W1::Bracket>(firstInsn, pos);
+      break;
+  }
+  return pos == last_ ? nullptr : pos;
+}
+
 template <class Traits>
 bool Context<Traits>::matchWidth1Loop(
     const Width1LoopInsn *insn,
@@ -698,6 +878,13 @@ auto Context<Traits>::match(
   // Note that we do want to check the empty range [last_, last_)
   const size_t locsToCheckCount = onlyAtStart ? 1 : 1 + (last_ - startLoc);
 
+  // Find what every match starts with, so that the locations where a match
+  // can't start are skipped without running the bytecode.
+  llvm::SmallVector<CharT, 16> prefix;
+  const Insn *firstInsn =
+      onlyAtStart ? nullptr : scanMatchStart(&bytecode[startIp], prefix);
+  const bool skipLocations = !prefix.empty() || firstInsn;
+
   // Macro used when a state fails to match.
 #define BACKTRACK()                   \
   do {                                \
@@ -707,6 +894,13 @@ auto Context<Traits>::match(
   } while (0)
 
   for (size_t locIndex = 0; locIndex < locsToCheckCount; locIndex++) {
+    if (skipLocations) {
+      const CharT *next =
+          findMatchStart(startLoc + locIndex, prefix, firstInsn);
+      if (!next)
+        break;
+      locIndex = next - startLoc;
+    }
     const CharT *potentialMatchLocation = startLoc + locIndex;
     s->current_ = potentialMatchLocation;
     s->ip_ = startIp;
@@ -817,18 +1011,7 @@ auto Context<Traits>::match(
 
         case Opcode::WordBoundary: {
           const WordBoundaryInsn *insn = llvm::cast<WordBoundaryInsn>(base);
-          bool prevIsWordchar = false;
-          if (s->current_ != first_ ||
-              (flags_ & constants::matchPreviousCharAvailable))
-            prevIsWordchar = traits_.characterHasType(
-                s->current_[-1], CharacterClass::Words);
-
-          bool currentIsWordchar = false;
-          if (s->current_ != last_)
-            currentIsWordchar =
-                traits_.characterHasType(s->current_[0], CharacterClass::Words);
-          bool isWordBoundary = (prevIsWordchar != currentIsWordchar);
-          if (isWordBoundary ^ insn->invert)
+          if (matchesWordBoundary(*this, *s) ^ insn->invert)
             s->ip_ += sizeof(WordBoundaryInsn);
           else
             BACKTRACK();
@@ -1082,12 +1265,523 @@ auto Context<Traits>::match(
     }
   // The search failed at this location.
   backtrackingExhausted:
+    if (error_ != MatchRuntimeErrorType::None)
+      return nullptr;
     continue;
   }
   // The match failed.
   return nullptr;
 }
 
+/// What the NFA matcher needs to know about a loop.
+struct NFALoop {
+  /// Minimum number of iterations.
+  uint32_t min;
+
+  /// Iteration counts above this one lead to the same matches as this one.
+  uint32_t maxDistinct;
+
+  /// Whether the loop is a BeginLoop, which fails an iteration matching the
+  /// empty string once the minimum has been reached.
+  bool checksEmpty;
+
+  /// The number of loop states of the loops before this one.
+  uint32_t multiplier;
+};
+
+/// NFAMatcher runs bytecode without backtracking, by simulating the
+/// nondeterministic automaton it describes in a single pass over the input
+/// (a Pike VM). Every thread which is at the same instruction, with the same
+/// loop state, at the same position, leads to the same matches, so only the
+/// one with the highest priority is kept. This bounds the number of threads
+/// and makes matching linear in the length of the input.
+///
+/// Threads are kept in the order in which backtracking would try them, so
+/// that the match and its capture groups are the same as those found by
+/// Context::match(). Backreferences and lookaheads are not supported.
+template <class Traits>
+class NFAMatcher {
+  using CharT = typename Traits::char_type;
+
+ public:
+  /// Maximum number of (instruction, loop state) pairs, so that the memory
+  /// used is bounded by the size of the bytecode.
+  static constexpr uint32_t kMaxStates = 1 << 16;
+
+  /// \return whether the instructions \p insns, which contain \p loopCount
+  /// loops, can be matched by an NFAMatcher, and are worth matching with it
+  /// because they contain alternations or loops. If so, set \p loops to the
+  /// loops, and \p numLoopStates to the number of distinct loop states.
+  static bool canMatch(
+      llvm::ArrayRef<uint8_t> insns,
+      uint32_t loopCount,
+      std::vector<NFALoop> &loops,
+      uint32_t &numLoopStates);
+
+  NFAMatcher(
+      Context<Traits> &ctx,
+      std::vector<NFALoop> loops,
+      uint32_t numLoopStates)
+      : ctx_(ctx),
+        insns_(&ctx.bytecodeStream_[sizeof(RegexBytecodeHeader)]),
+        loops_(std::move(loops)),
+        numLoopStates_(numLoopStates),
+        visited_(
+            (ctx.bytecodeStream_.size() - sizeof(RegexBytecodeHeader)) *
+                numLoopStates,
+            0) {}
+
+  /// Search for a match starting at or after \p startLoc, or only at it if
+  /// \p onlyAtStart is set, and behave like Context::match() otherwise.
+  const CharT *match(State<Traits> *s, const CharT *startLoc, bool onlyAtStart);
+
+ private:
+  /// A thread of the automaton. Its state's ip_ is an instruction which
+  /// matches a character, or the next one to run in addThread().
+  struct Thread {
+    State<Traits> state;
+
+    /// Where the match started.
+    const CharT *start;
+
+    /// Whether the thread is inside of a Width1Loop, either at the loop
+    /// instruction after matching its body, or at its body.
+    bool inWidth1Loop;
+  };
+
+  const Insn *insnAt(uint32_t ip) const {
+    return reinterpret_cast<const Insn *>(&insns_[ip]);
+  }
+
+  /// \return the index of the loop state of \p s at \p pos, which is equal
+  /// for states which lead to the same matches.
+  uint32_t loopState(const State<Traits> &s, const CharT *pos) const;
+
+  /// Add \p thread at \p pos to \p list, or rather, the threads reached from
+  /// it without matching a character, in priority order.
+  /// \return true if one of them reached the goal, in which case the lower
+  /// priority ones aren't added.
+  bool addThread(std::vector<Thread> &list, Thread thread, const CharT *pos);
+
+  /// Run the instructions of \p t from its ip up to one which matches a
+  /// character, at \p pos. Alternatives with a lower priority are pushed to
+  /// stack_. \return true if \p t reached the goal.
+  bool follow(std::vector<Thread> &list, Thread &t, const CharT *pos);
+
+  /// Run the BeginLoop \p loop at the ip of \p t, whose loop data has been
+  /// initialized. \return false if \p t fails.
+  bool runLoop(Thread &t, const BeginLoopInsn *loop, const CharT *pos);
+
+  /// Move \p t into the body of \p loop, like prepareToEnterLoopBody().
+  void enterLoopBody(Thread &t, const BeginLoopInsn *loop, const CharT *pos);
+
+  /// Move \p t to \p notTakenTarget, out of the loop \p loopId. Its loop
+  /// data is reset, so that the loop state doesn't depend on it.
+  static void exitLoop(Thread &t, uint32_t loopId, uint32_t notTakenTarget) {
+    t.state.getLoop(loopId) = {0, 0};
+    t.state.ip_ = notTakenTarget;
+    t.inWidth1Loop = false;
+  }
+
+  Context<Traits> &ctx_;
+
+  /// The instructions, following the header.
+  const uint8_t *const insns_;
+
+  /// The loops, indexed by loop ID.
+  const std::vector<NFALoop> loops_;
+
+  /// The number of distinct loop states.
+  const uint32_t numLoopStates_;
+
+  /// For each instruction and loop state, the generation in which a thread
+  /// last reached them.
+  std::vector<uint32_t> visited_;
+
+  /// The generation of the position the threads are being added at.
+  uint32_t generation_{1};
+
+  /// Threads which have yet to be followed by addThread().
+  std::vector<Thread> stack_{};
+
+  /// The thread which reached the goal with the highest priority.
+  llvm::Optional<Thread> goal_{};
+
+  /// The position at which goal_ reached the goal.
+  const CharT *goalPos_{nullptr};
+};
+
+template <class Traits>
+bool NFAMatcher<Traits>::canMatch(
+    llvm::ArrayRef<uint8_t> insns,
+    uint32_t loopCount,
+    std::vector<NFALoop> &loops,
+    uint32_t &numLoopStates) {
+  loops.assign(loopCount, NFALoop{0, 0, false, 0});
+  bool branches = false;
+  uint64_t states = 1;
+  for (uint32_t ip = 0; ip < insns.size();) {
+    const Insn *base = reinterpret_cast<const Insn *>(&insns[ip]);
+    switch (base->opcode) {
+      case Opcode::BackRef:
+      case Opcode::Lookahead:
+        return false;
+      case Opcode::Alternation:
+      case Opcode::BeginSimpleLoop:
+        branches = true;
+        break;
+      case Opcode::BeginLoop: {
+        const auto *loop = llvm::cast<BeginLoopInsn>(base);
+        // An unbounded loop only needs to tell whether it exceeded its
+        // minimum, which the empty iteration check depends on.
+        loops[loop->loopId] = NFALoop{
+            loop->min,
+            loop->max == UINT32_MAX ? loop->min + 1 : loop->max,
+            true,
+            0};
+        branches = true;
+        break;
+      }
+      case Opcode::Width1Loop: {
+        const auto *loop = llvm::cast<Width1LoopInsn>(base);
+        loops[loop->loopId] = NFALoop{
+            loop->min,
+            loop->max == UINT32_MAX ? loop->min : loop->max,
+            false,
+            0};
+        branches = true;
+        break;
+      }
+      default:
+        break;
+    }
+    ip += insnWidth(base);
+  }
+  for (NFALoop &loop : loops) {
+    loop.multiplier = states;
+    states *= ((uint64_t)loop.maxDistinct + 1) * (loop.checksEmpty ? 2 : 1);
+    if (states * insns.size() > kMaxStates)
+      return false;
+  }
+  numLoopStates = states;
+  return branches;
+}
+
+template <class Traits>
+uint32_t NFAMatcher<Traits>::loopState(
+    const State<Traits> &s,
+    const CharT *pos) const {
+  uint32_t index = 0;
+  for (uint32_t id = 0, e = loops_.size(); id < e; ++id) {
+    const NFALoop &loop = loops_[id];
+    const LoopData &loopData = s.loopDatas_[id];
+    uint32_t digit = std::min(loopData.iterations, loop.maxDistinct);
+    if (loop.checksEmpty) {
+      bool emptySoFar = loopData.iterations > loop.min &&
+          ctx_.first_ + loopData.entryPosition == pos;
+      digit = digit * 2 + emptySoFar;
+    }
+    index += digit * loop.multiplier;
+  }
+  return index;
+}
+
+template <class Traits>
+void NFAMatcher<Traits>::enterLoopBody(
+    Thread &t,
+    const BeginLoopInsn *loop,
+    const CharT *pos) {
+  LoopData &loopData = t.state.getLoop(loop->loopId);
+  loopData.iterations++;
+  loopData.entryPosition = pos - ctx_.first_;
+  for (uint32_t mexp = loop->mexpBegin; mexp != loop->mexpEnd; mexp++)
+    t.state.getCapturedRange(mexp) = {kNotMatched, kNotMatched};
+  t.state.ip_ += sizeof(BeginLoopInsn);
+}
+
+template <class Traits>
+bool NFAMatcher<Traits>::runLoop(
+    Thread &t,
+    const BeginLoopInsn *loop,
+    const CharT *pos) {
+  LoopData &loopData = t.state.getLoop(loop->loopId);
+  uint32_t iteration = loopData.iterations;
+  // See the empty iteration check in Context::match().
+  if (iteration > loop->min &&
+      ctx_.first_ + loopData.entryPosition == pos)
+    return false;
+
+  bool doLoopBody = iteration < loop->max;
+  bool doNotTaken = iteration >= loop->min;
+  if (doLoopBody && doNotTaken) {
+    // Leave the alternative with the lower priority for later.
+    stack_.push_back(t);
+    if (loop->greedy) {
+      exitLoop(stack_.back(), loop->loopId, loop->notTakenTarget);
+      enterLoopBody(t, loop, pos);
+    } else {
+      enterLoopBody(stack_.back(), loop, pos);
+      exitLoop(t, loop->loopId, loop->notTakenTarget);
+    }
+  } else if (doLoopBody) {
+    enterLoopBody(t, loop, pos);
+  } else if (doNotTaken) {
+    exitLoop(t, loop->loopId, loop->notTakenTarget);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+template <class Traits>
+bool NFAMatcher<Traits>::follow(
+    std::vector<Thread> &list,
+    Thread &t,
+    const CharT *pos) {
+  State<Traits> &s = t.state;
+  s.current_ = pos;
+  for (;;) {
+    const Insn *base = insnAt(s.ip_);
+    if (base->opcode == Opcode::Width1Loop && !t.inWidth1Loop) {
+      // Entering the loop, rather than running it after its body.
+      s.getLoop(llvm::cast<Width1LoopInsn>(base)->loopId).iterations = 0;
+      t.inWidth1Loop = true;
+    }
+
+    // A thread with a higher priority already got here.
+    uint32_t &visited = visited_[s.ip_ * numLoopStates_ + loopState(s, pos)];
+    if (visited == generation_)
+      return false;
+    visited = generation_;
+
+    switch (base->opcode) {
+      case Opcode::Goal:
+        goal_ = std::move(t);
+        goalPos_ = pos;
+        return true;
+
+      case Opcode::LeftAnchor:
+        if (!matchesLeftAnchor(ctx_, s))
+          return false;
+        s.ip_ += sizeof(LeftAnchorInsn);
+        break;
+
+      case Opcode::RightAnchor:
+        if (!matchesRightAnchor(ctx_, s))
+          return false;
+        s.ip_ += sizeof(RightAnchorInsn);
+        break;
+
+      case Opcode::MatchAnyButNewline:
+      case Opcode::MatchChar8:
+      case Opcode::MatchChar16:
+      case Opcode::MatchCharICase8:
+      case Opcode::MatchCharICase16:
+      case Opcode::Bracket:
+        list.push_back(std::move(t));
+        return false;
+
+      case Opcode::Alternation: {
+        const AlternationInsn *alt = llvm::cast<AlternationInsn>(base);
+        bool primaryViable =
+            flagsSatisfyConstraints(ctx_.flags_, alt->primaryConstraints);
+        bool secondaryViable =
+            flagsSatisfyConstraints(ctx_.flags_, alt->secondaryConstraints);
+        if (primaryViable && secondaryViable) {
+          stack_.push_back(t);
+          stack_.back().state.ip_ = alt->secondaryBranch;
+          s.ip_ += sizeof(AlternationInsn);
+        } else if (primaryViable) {
+          s.ip_ += sizeof(AlternationInsn);
+        } else if (secondaryViable) {
+          s.ip_ = alt->secondaryBranch;
+        } else {
+          return false;
+        }
+        break;
+      }
+
+      case Opcode::Jump32:
+        s.ip_ = llvm::cast<Jump32Insn>(base)->target;
+        break;
+
+      case Opcode::WordBoundary:
+        if (!(matchesWordBoundary(ctx_, s) ^
+              llvm::cast<WordBoundaryInsn>(base)->invert))
+          return false;
+        s.ip_ += sizeof(WordBoundaryInsn);
+        break;
+
+      case Opcode::BeginMarkedSubexpression: {
+        const auto *insn = llvm::cast<BeginMarkedSubexpressionInsn>(base);
+        s.getCapturedRange(insn->mexp - 1).start = pos - ctx_.first_;
+        s.ip_ += sizeof(BeginMarkedSubexpressionInsn);
+        break;
+      }
+
+      case Opcode::EndMarkedSubexpression: {
+        const auto *insn = llvm::cast<EndMarkedSubexpressionInsn>(base);
+        s.getCapturedRange(insn->mexp - 1).end = pos - ctx_.first_;
+        s.ip_ += sizeof(EndMarkedSubexpressionInsn);
+        break;
+      }
+
+      case Opcode::BackRef:
+      case Opcode::Lookahead:
+        llvm_unreachable("Instruction not supported by NFAMatcher");
+
+      case Opcode::BeginLoop: {
+        const BeginLoopInsn *loop = llvm::cast<BeginLoopInsn>(base);
+        s.getLoop(loop->loopId).iterations = 0;
+        if (!flagsSatisfyConstraints(ctx_.flags_, loop->loopeeConstraints)) {
+          if (loop->min > 0)
+            return false;
+          s.ip_ = loop->notTakenTarget;
+          break;
+        }
+        if (!runLoop(t, loop, pos))
+          return false;
+        break;
+      }
+
+      case Opcode::EndLoop:
+        s.ip_ = llvm::cast<EndLoopInsn>(base)->target;
+        if (!runLoop(t, llvm::cast<BeginLoopInsn>(insnAt(s.ip_)), pos))
+          return false;
+        break;
+
+      case Opcode::BeginSimpleLoop:
+      case Opcode::EndSimpleLoop: {
+        const bool entering = base->opcode == Opcode::BeginSimpleLoop;
+        if (!entering) {
+          s.ip_ = llvm::cast<EndSimpleLoopInsn>(base)->target;
+          base = insnAt(s.ip_);
+        }
+        const auto *loop = llvm::cast<BeginSimpleLoopInsn>(base);
+        if (entering &&
+            !flagsSatisfyConstraints(ctx_.flags_, loop->loopeeConstraints)) {
+          s.ip_ = loop->notTakenTarget;
+          break;
+        }
+        // Simple loops are always greedy.
+        stack_.push_back(t);
+        stack_.back().state.ip_ = loop->notTakenTarget;
+        s.ip_ += sizeof(BeginSimpleLoopInsn);
+        break;
+      }
+
+      case Opcode::Width1Loop: {
+        const auto *loop = llvm::cast<Width1LoopInsn>(base);
+        LoopData &loopData = s.getLoop(loop->loopId);
+        bool doLoopBody = loopData.iterations < loop->max;
+        bool doNotTaken = loopData.iterations >= loop->min;
+        // The body follows the loop instruction.
+        const uint32_t bodyIp = s.ip_ + sizeof(Width1LoopInsn);
+        if (doLoopBody && doNotTaken) {
+          stack_.push_back(t);
+          if (loop->greedy) {
+            exitLoop(stack_.back(), loop->loopId, loop->notTakenTarget);
+            s.ip_ = bodyIp;
+          } else {
+            stack_.back().state.ip_ = bodyIp;
+            exitLoop(t, loop->loopId, loop->notTakenTarget);
+          }
+        } else if (doLoopBody) {
+          s.ip_ = bodyIp;
+        } else if (doNotTaken) {
+          exitLoop(t, loop->loopId, loop->notTakenTarget);
+        } else {
+          return false;
+        }
+        break;
+      }
+    }
+  }
+}
+
+template <class Traits>
+bool NFAMatcher<Traits>::addThread(
+    std::vector<Thread> &list,
+    Thread thread,
+    const CharT *pos) {
+  stack_.push_back(std::move(thread));
+  while (!stack_.empty()) {
+    Thread t = std::move(stack_.back());
+    stack_.pop_back();
+    if (follow(list, t, pos)) {
+      stack_.clear();
+      return true;
+    }
+  }
+  return false;
+}
+
+template <class Traits>
+auto NFAMatcher<Traits>::match(
+    State<Traits> *s,
+    const CharT *startLoc,
+    bool onlyAtStart) -> const CharT * {
+  llvm::SmallVector<CharT, 16> prefix;
+  const Insn *firstInsn =
+      onlyAtStart ? nullptr : ctx_.scanMatchStart(insns_, prefix);
+  const bool skipLocations = !prefix.empty() || firstInsn;
+
+  const Thread initial{*s, nullptr, false};
+  std::vector<Thread> threads, nextThreads;
+  for (const CharT *pos = startLoc;; ++pos) {
+    // Start a match at this position, with the lowest priority, unless a
+    // match was already found.
+    if (!goal_ && (pos == startLoc || !onlyAtStart)) {
+      if (threads.empty() && skipLocations) {
+        const CharT *next = ctx_.findMatchStart(pos, prefix, firstInsn);
+        if (!next)
+          break;
+        if (next != pos) {
+          pos = next;
+          ++generation_;
+        }
+      }
+      Thread t = initial;
+      t.start = pos;
+      addThread(threads, std::move(t), pos);
+    }
+    if (pos == ctx_.last_ || (threads.empty() && (goal_ || onlyAtStart)))
+      break;
+
+    // Advance the threads over the character at pos, in priority order. Once
+    // one of them reaches the goal, the ones after it can be dropped.
+    ++generation_;
+    nextThreads.clear();
+    for (Thread &t : threads) {
+      const Insn *insn = insnAt(t.state.ip_);
+      if (!ctx_.matchesWidth1(insn, *pos))
+        continue;
+      if (t.inWidth1Loop) {
+        t.state.ip_ -= sizeof(Width1LoopInsn);
+        auto *loop = llvm::cast<Width1LoopInsn>(insnAt(t.state.ip_));
+        t.state.getLoop(loop->loopId).iterations++;
+      } else {
+        t.state.ip_ += insnWidth(insn);
+      }
+      if (addThread(nextThreads, std::move(t), pos + 1))
+        break;
+    }
+    std::swap(threads, nextThreads);
+  }
+
+  if (!goal_)
+    return nullptr;
+  *s = std::move(goal_->state);
+  s->current_ = goalPos_;
+  return goal_->start;
+}
+
+/// The number of times a match may backtrack before it is restarted without
+/// backtracking, when that is possible: kMinBacktracks, plus
+/// kBacktracksPerChar for each character of the input.
+static constexpr uint64_t kMinBacktracks = 1024;
+static constexpr uint64_t kBacktracksPerChar = 16;
+
 /// Entry point for searching a string via regex compiled bytecode.
 /// Given the bytecode \p bytecode, search the range starting at \p first up to
 /// (not including) \p last with the flags \p matchFlags. If the search
@@ -1122,7 +1816,28 @@ MatchRuntimeResult searchWithBytecodeImpl(
   State<Traits> state{markedCount, loopCount};
   bool onlyAtStart = header->constraints & MatchConstraintAnchoredAtStart;
   auto result = MatchRuntimeResult::NoMatch;
-  if (const CharT *matchStartLoc = ctx.match(&state, ctx.first_, onlyAtStart)) {
+  // Backtracking is usually faster, but can take exponential time. When the
+  // bytecode can be matched without backtracking, limit the number of
+  // backtracks to a few per character of the input, and match without
+  // backtracking if they run out.
+  std::vector<NFALoop> nfaLoops;
+  uint32_t numLoopStates = 0;
+  bool canMatchNFA = NFAMatcher<Traits>::canMatch(
+      bytecode.drop_front(sizeof(RegexBytecodeHeader)),
+      loopCount,
+      nfaLoops,
+      numLoopStates);
+  if (canMatchNFA)
+    ctx.backtracksLeft_ = kMinBacktracks + kBacktracksPerChar * (last - first);
+  const CharT *matchStartLoc = ctx.match(&state, ctx.first_, onlyAtStart);
+  if (canMatchNFA && ctx.error_ != MatchRuntimeErrorType::None) {
+    // This also recovers from running out of backtracking stack.
+    ctx.error_ = MatchRuntimeErrorType::None;
+    state = State<Traits>{markedCount, loopCount};
+    NFAMatcher<Traits> nfa(ctx, std::move(nfaLoops), numLoopStates);
+    matchStartLoc = nfa.match(&state, ctx.first_, onlyAtStart);
+  }
+  if (matchStartLoc) {
     // Match succeeded.
     m.resize(1 + markedCount);
     m[0].first = matchStartLoc;
@@ -1165,5 +1880,22 @@ MatchRuntimeResult searchWithBytecode(
       bytecode, first, last, m, matchFlags);
 }
 
+void getWidth1ASCIITable(
+    llvm::ArrayRef<uint8_t> bytecode,
+    const Insn *insn,
+    uint8_t table[128]) {
+  auto header = reinterpret_cast<const RegexBytecodeHeader *>(bytecode.data());
+  Context<ASCIIRegexTraits> ctx(
+      bytecode,
+      constants::matchDefault | constants::matchInputAllAscii,
+      static_cast<constants::SyntaxFlags>(header->syntaxFlags),
+      nullptr,
+      nullptr,
+      header->markedCount,
+      header->loopCount);
+  for (unsigned c = 0; c < 128; ++c)
+    table[c] = ctx.matchesWidth1(insn, (char)c);
+}
+
 } // namespace regex
 } // namespace hermes
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/SourceMap/IndexedSourceMap.h"
+
+#include <algorithm>
+
+namespace hermes {
+
+namespace {
+
+/// Identifies the binary format of writeIndex().
+constexpr char kIndexMagic[4] = {'H', 'S', 'M', 'I'};
+
+/// Bumped whenever the binary format of writeIndex() changes.
+constexpr uint32_t kIndexVersion = 1;
+
+/// Write \p val to \p OS in little-endian order.
+void writeU32(llvm::raw_ostream &OS, uint32_t val) {
+  for (unsigned i = 0; i < 4; ++i) {
+    OS << (char)(val >> (i * 8));
+  }
+}
+
+/// Write the length of \p str followed by its contents to \p OS.
+void writeString(llvm::raw_ostream &OS, llvm::StringRef str) {
+  writeU32(OS, str.size());
+  OS << str;
+}
+
+/// Reads the values written by writeU32() and writeString(). Reading past
+/// the end of the data yields zeros and empty strings, and sets a flag.
+class IndexReader {
+ public:
+  explicit IndexReader(llvm::StringRef data) : data_(data) {}
+
+  /// \return whether an earlier read went past the end of the data.
+  bool failed() const {
+    return failed_;
+  }
+
+  uint32_t readU32() {
+    if (data_.size() < 4) {
+      failed_ = true;
+      return 0;
+    }
+    uint32_t val = 0;
+    for (unsigned i = 0; i < 4; ++i) {
+      val |= (uint32_t)(uint8_t)data_[i] << (i * 8);
+    }
+    data_ = data_.drop_front(4);
+    return val;
+  }
+
+  llvm::StringRef readString() {
+    uint32_t size = readU32();
+    if (data_.size() < size) {
+      failed_ = true;
+      return {};
+    }
+    llvm::StringRef str = data_.take_front(size);
+    data_ = data_.drop_front(size);
+    return str;
+  }
+
+ private:
+  /// The data left to read.
+  llvm::StringRef data_;
+
+  /// Whether a read went past the end of the data.
+  bool failed_{false};
+};
+
+} // namespace
+
+IndexedSourceMap::IndexedSourceMap(
+    std::string sourceRoot,
+    std::vector<std::string> sources,
+    std::string mappings)
+    : sourceRoot_(std::move(sourceRoot)),
+      sources_(std::move(sources)),
+      mappings_(std::move(mappings)) {
+  // Source map mappings may omit ";" for the last line.
+  for (size_t start = 0; start < mappings_.size();) {
+    lineStarts_.push_back(start);
+    size_t end = mappings_.find(';', start);
+    if (end == std::string::npos) {
+      break;
+    }
+    start = end + 1;
+  }
+}
+
+llvm::Optional<SourceMapTextLocation> IndexedSourceMap::getLocationForAddress(
+    uint32_t line,
+    uint32_t column) {
+  const SourceMap::Segment *target = getSegmentForAddress(line, column);
+  // Unmapped location
+  if (!target || !target->representedLocation.hasValue()) {
+    return llvm::None;
+  }
+  // Unlike in SourceMap, segments are only checked when decoded.
+  if ((uint32_t)target->representedLocation->sourceIndex >= sources_.size()) {
+    return llvm::None;
+  }
+  return SourceMapTextLocation{
+      getSourceFullPath(target->representedLocation->sourceIndex),
+      (uint32_t)target->representedLocation->lineIndex + 1,
+      (uint32_t)target->representedLocation->columnIndex + 1};
+}
+
+const SourceMap::Segment *IndexedSourceMap::getSegmentForAddress(
+    uint32_t line,
+    uint32_t column) {
+  if (line == 0 || line > lineStarts_.size()) {
+    return nullptr;
+  }
+  // line is 1-based.
+  const SourceMap::SegmentList *segments = getLine(line - 1);
+  return segments ? SourceMap::findSegmentForColumn(*segments, column)
+                  : nullptr;
+}
+
+bool IndexedSourceMap::decodeLine(
+    uint32_t lineIndex,
+    State &state,
+    SourceMap::SegmentList *segments) const {
+  const char *pCur = mappings_.data() + lineStarts_[lineIndex];
+  const char *pLineEnd =
+      std::find(pCur, mappings_.data() + mappings_.size(), ';');
+  if (pCur == pLineEnd) {
+    // The line is empty.
+    return true;
+  }
+  for (;;) {
+    const char *pSegEnd = std::find(pCur, pLineEnd, ',');
+    llvm::Optional<SourceMap::Segment> segmentOpt =
+        SourceMapParser::parseSegment(state, pCur, pSegEnd);
+    if (!segmentOpt.hasValue()) {
+      return false;
+    }
+    SourceMapParser::updateState(state, segmentOpt.getValue());
+    if (segments) {
+      segments->push_back(segmentOpt.getValue());
+    }
+    if (pSegEnd == pLineEnd) {
+      // generated column should be reset for new line.
+      state.generatedColumn = 0;
+      return true;
+    }
+    pCur = pSegEnd + 1;
+  }
+}
+
+llvm::Optional<IndexedSourceMap::State> IndexedSourceMap::getLineStartState(
+    uint32_t lineIndex) {
+  while (lineStartStates_.size() <= lineIndex) {
+    if (malformed_) {
+      return llvm::None;
+    }
+    // Skip over the last line whose start state is known, without keeping
+    // its segments.
+    State state = lineStartStates_.back();
+    if (!decodeLine(lineStartStates_.size() - 1, state, nullptr)) {
+      malformed_ = true;
+      return llvm::None;
+    }
+    lineStartStates_.push_back(state);
+  }
+  return lineStartStates_[lineIndex];
+}
+
+const SourceMap::SegmentList *IndexedSourceMap::getLine(uint32_t lineIndex) {
+  auto it = decodedLines_.find(lineIndex);
+  if (it != decodedLines_.end()) {
+    return &it->second;
+  }
+  llvm::Optional<State> state = getLineStartState(lineIndex);
+  if (!state.hasValue()) {
+    return nullptr;
+  }
+  SourceMap::SegmentList segments;
+  if (!decodeLine(lineIndex, *state, &segments)) {
+    return nullptr;
+  }
+  return &(decodedLines_[lineIndex] = std::move(segments));
+}
+
+void IndexedSourceMap::writeIndex(llvm::raw_ostream &OS) {
+  // Skip over all the lines, so that readers don't need to. Where the lines
+  // start is not written, since finding it is much faster than reading the
+  // segments.
+  if (!lineStarts_.empty()) {
+    getLineStartState(lineStarts_.size() - 1);
+  }
+
+  OS.write(kIndexMagic, sizeof(kIndexMagic));
+  writeU32(OS, kIndexVersion);
+  writeString(OS, sourceRoot_);
+  writeU32(OS, sources_.size());
+  for (const std::string &source : sources_) {
+    writeString(OS, source);
+  }
+  writeString(OS, mappings_);
+
+  // The generated column is always 0 at the start of a line.
+  writeU32(OS, lineStartStates_.size());
+  for (const State &state : lineStartStates_) {
+    writeU32(OS, state.sourceIndex);
+    writeU32(OS, state.representedLine);
+    writeU32(OS, state.representedColumn);
+    writeU32(OS, state.nameIndex);
+  }
+}
+
+std::unique_ptr<IndexedSourceMap> IndexedSourceMap::readIndex(
+    llvm::StringRef data) {
+  if (!data.startswith(llvm::StringRef(kIndexMagic, sizeof(kIndexMagic)))) {
+    return nullptr;
+  }
+  IndexReader reader{data.drop_front(sizeof(kIndexMagic))};
+  if (reader.readU32() != kIndexVersion) {
+    return nullptr;
+  }
+
+  std::string sourceRoot = reader.readString().str();
+  uint32_t numSources = reader.readU32();
+  std::vector<std::string> sources;
+  for (uint32_t i = 0; i < numSources && !reader.failed(); ++i) {
+    sources.push_back(reader.readString().str());
+  }
+  llvm::StringRef mappings = reader.readString();
+  if (reader.failed()) {
+    return nullptr;
+  }
+
+  // The count is checked before the states are read, so that a malformed
+  // index can't make this allocate more than the data it is read from.
+  auto result = llvm::make_unique<IndexedSourceMap>(
+      std::move(sourceRoot), std::move(sources), mappings.str());
+  std::vector<State> lineStartStates;
+  uint32_t numStates = reader.readU32();
+  if (numStates == 0 || numStates > result->getNumLines() + 1) {
+    return nullptr;
+  }
+  for (uint32_t i = 0; i < numStates && !reader.failed(); ++i) {
+    State state;
+    state.sourceIndex = reader.readU32();
+    state.representedLine = reader.readU32();
+    state.representedColumn = reader.readU32();
+    state.nameIndex = reader.readU32();
+    lineStartStates.push_back(state);
+  }
+  if (reader.failed()) {
+    return nullptr;
+  }
+  result->lineStartStates_ = std::move(lineStartStates);
+  return result;
+}
+
+} // namespace hermes
@@ -10,18 +10,22 @@ using namespace hermes;
 
 namespace hermes {
 
-llvm::Optional<SourceMapTextLocation> SourceMap::getLocationForAddress(
+const SourceMap::Segment *SourceMap::getSegmentForAddress(
     uint32_t line,
-    uint32_t column) {
+    uint32_t column) const {
   if (line == 0 || line > lines_.size()) {
-    return llvm::None;
+    return nullptr;
   }
 
   // line is 1-based.
-  uint32_t lineIndex = line - 1;
-  auto &segments = lines_[lineIndex];
+  return findSegmentForColumn(lines_[line - 1], column);
+}
+
+const SourceMap::Segment *SourceMap::findSegmentForColumn(
+    const SegmentList &segments,
+    uint32_t column) {
   if (segments.empty()) {
-    return llvm::None;
+    return nullptr;
   }
   assert(column >= 1 && "the column argument to this function is 1-based");
   uint32_t columnIndex = column - 1;
@@ -39,25 +43,30 @@ llvm::Optional<SourceMapTextLocation> SourceMap::getLocationForAddress(
       });
   // The found sentinal segment is the first one. No covering segment.
   if (segIter == segments.begin()) {
-    return llvm::None;
+    return nullptr;
   }
   // Move back one slot.
-  const Segment &target =
-      segIter == segments.end() ? segments.back() : *(--segIter);
+  return segIter == segments.end() ? &segments.back() : &*(--segIter);
+}
+
+llvm::Optional<SourceMapTextLocation> SourceMap::getLocationForAddress(
+    uint32_t line,
+    uint32_t column) {
+  const Segment *target = getSegmentForAddress(line, column);
   // Unmapped location
-  if (!target.representedLocation.hasValue()) {
+  if (!target || !target->representedLocation.hasValue()) {
     return llvm::None;
   }
   // parseSegment() should have validated this.
   assert(
-      (size_t)target.representedLocation->sourceIndex < sources_.size() &&
+      (size_t)target->representedLocation->sourceIndex < sources_.size() &&
       "SourceIndex is out-of-range.");
   std::string fileName =
-      getSourceFullPath(target.representedLocation->sourceIndex);
+      getSourceFullPath(target->representedLocation->sourceIndex);
   return SourceMapTextLocation{
       std::move(fileName),
-      (uint32_t)target.representedLocation->lineIndex + 1,
-      (uint32_t)target.representedLocation->columnIndex + 1};
+      (uint32_t)target->representedLocation->lineIndex + 1,
+      (uint32_t)target->representedLocation->columnIndex + 1};
 }
 
 } // namespace hermes
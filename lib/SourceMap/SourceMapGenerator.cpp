@@ -25,52 +25,138 @@ struct VLQ {
 llvm::raw_ostream &operator<<(llvm::raw_ostream &OS, VLQ vlq) {
   return base64vlq::encode(OS, vlq.val);
 }
+
+/// Translates the represented locations of segments to the sources of the
+/// input source maps, if they map them. The merged list of sources is built
+/// in order of first use, and the index of each source in it is remembered,
+/// so that translating a segment only takes a binary search in its input
+/// source map.
+class InputSourceMapMerger {
+ public:
+  /// \p inputMaps are the input source maps of \p sources, or nullptr for the
+  /// sources without one.
+  InputSourceMapMerger(
+      llvm::ArrayRef<std::unique_ptr<SourceMap>> inputMaps,
+      llvm::ArrayRef<llvm::StringRef> sources)
+      : inputMaps_(inputMaps),
+        sources_(sources),
+        mergedIndexes_(sources.size(), -1),
+        inputMergedIndexes_(inputMaps.size()) {
+    for (uint32_t i = 0, e = inputMaps.size(); i < e; ++i) {
+      if (inputMaps[i]) {
+        inputMergedIndexes_[i].resize(inputMaps[i]->getNumSources(), -1);
+      }
+    }
+  }
+
+  /// \return \p seg, with its represented location in the merged sources.
+  SourceMap::Segment translate(const SourceMap::Segment &seg) {
+    SourceMap::Segment newSeg = seg;
+    if (!seg.representedLocation.hasValue()) {
+      return newSeg;
+    }
+    const auto &loc = *seg.representedLocation;
+    assert(loc.sourceIndex >= 0 && "Negative source index");
+
+    if ((uint32_t)loc.sourceIndex < inputMaps_.size() &&
+        inputMaps_[loc.sourceIndex]) {
+      const SourceMap &inputMap = *inputMaps_[loc.sourceIndex];
+      const SourceMap::Segment *inputSeg = inputMap.getSegmentForAddress(
+          loc.lineIndex + 1, loc.columnIndex + 1);
+      if (inputSeg && inputSeg->representedLocation.hasValue()) {
+        // We have an input source map and were able to find a merged source
+        // location.
+        const auto &inputLoc = *inputSeg->representedLocation;
+        int32_t &index =
+            inputMergedIndexes_[loc.sourceIndex][inputLoc.sourceIndex];
+        if (index < 0) {
+          index = merged_.insert(
+              inputMap.getSourceFullPath(inputLoc.sourceIndex));
+        }
+        newSeg.representedLocation = SourceMap::Segment::SourceLocation(
+            index, inputLoc.lineIndex, inputLoc.columnIndex
+            // TODO: Handle name index
+        );
+        return newSeg;
+      }
+    }
+
+    // Failed to find a merge location. Use the existing location, but with the
+    // index of its source file in the merged sources.
+    int32_t &index = mergedIndexes_[loc.sourceIndex];
+    if (index < 0) {
+      index = merged_.insert(sources_[loc.sourceIndex]);
+    }
+    newSeg.representedLocation->sourceIndex = index;
+    return newSeg;
+  }
+
+  /// \return the merged list of sources, in order.
+  std::vector<llvm::StringRef> getMergedSources() const {
+    return std::vector<llvm::StringRef>(merged_.begin(), merged_.end());
+  }
+
+ private:
+  /// The input source maps, indexed by source.
+  llvm::ArrayRef<std::unique_ptr<SourceMap>> inputMaps_;
+
+  /// The sources of the generated code.
+  llvm::ArrayRef<llvm::StringRef> sources_;
+
+  /// The merged list of sources.
+  StringSetVector merged_{};
+
+  /// The index in merged_ of each of sources_, or -1 if not added yet.
+  std::vector<int32_t> mergedIndexes_;
+
+  /// The index in merged_ of each source of each input source map, or -1 if
+  /// not added yet.
+  std::vector<std::vector<int32_t>> inputMergedIndexes_;
+};
+
 } // namespace
 
-SourceMapGenerator::State SourceMapGenerator::encodeSourceLocations(
-    const SourceMapGenerator::State &lastState,
-    llvm::ArrayRef<SourceMap::Segment> segments,
+void SourceMapGenerator::encodeSegment(
+    SourceMapGenerator::State &state,
+    const SourceMap::Segment &seg,
     llvm::raw_ostream &OS) {
-  // Currently we only support a single source, so the source ID (and its delta)
-  // is always 0.
-  SourceMapGenerator::State state = lastState, prevState = lastState;
-  bool first = true;
-  for (const SourceMap::Segment &seg : segments) {
-    // Segments are separated by commas.
-    state.generatedColumn = seg.generatedColumn;
-    OS << (first ? "" : ",")
-       << VLQ{state.generatedColumn - prevState.generatedColumn};
-    if (seg.representedLocation.hasValue()) {
-      state.sourceIndex = seg.representedLocation->sourceIndex;
-      state.representedLine = seg.representedLocation->lineIndex;
-      state.representedColumn = seg.representedLocation->columnIndex;
-      OS << VLQ{state.sourceIndex - prevState.sourceIndex}
-         << VLQ{state.representedLine - prevState.representedLine}
-         << VLQ{state.representedColumn - prevState.representedColumn};
-
-      if (seg.representedLocation->nameIndex.hasValue()) {
-        state.nameIndex = seg.representedLocation->nameIndex.getValue();
-        OS << VLQ{state.nameIndex - prevState.nameIndex};
-      }
+  SourceMapGenerator::State prevState = state;
+  state.generatedColumn = seg.generatedColumn;
+  OS << VLQ{state.generatedColumn - prevState.generatedColumn};
+  if (seg.representedLocation.hasValue()) {
+    state.sourceIndex = seg.representedLocation->sourceIndex;
+    state.representedLine = seg.representedLocation->lineIndex;
+    state.representedColumn = seg.representedLocation->columnIndex;
+    OS << VLQ{state.sourceIndex - prevState.sourceIndex}
+       << VLQ{state.representedLine - prevState.representedLine}
+       << VLQ{state.representedColumn - prevState.representedColumn};
+
+    if (seg.representedLocation->nameIndex.hasValue()) {
+      state.nameIndex = seg.representedLocation->nameIndex.getValue();
+      OS << VLQ{state.nameIndex - prevState.nameIndex};
     }
-    first = false;
-    prevState = state;
   }
-  return prevState;
 }
 
-std::string SourceMapGenerator::getVLQMappingsString() const {
-  std::string result;
-  llvm::raw_string_ostream OS(result);
+void SourceMapGenerator::encodeMappings(
+    llvm::function_ref<SourceMap::Segment(const SourceMap::Segment &)>
+        translate,
+    llvm::raw_ostream &OS) const {
   State state;
   for (const SourceMap::SegmentList &segments : lines_) {
     // The generated column (unlike other fields) resets with each new line.
     state.generatedColumn = 0;
-    state = encodeSourceLocations(state, segments, OS);
+    bool first = true;
+    for (const SourceMap::Segment &seg : segments) {
+      // Segments are separated by commas.
+      if (!first) {
+        OS << ',';
+      }
+      encodeSegment(state, translate(seg), OS);
+      first = false;
+    }
     OS << ';';
   }
-  OS.flush();
-  return result;
 }
 
 std::vector<llvm::StringRef> SourceMapGenerator::getSources() const {
@@ -78,71 +164,44 @@ std::vector<llvm::StringRef> SourceMapGenerator::getSources() const {
       filenameTable_.begin(), filenameTable_.end());
 }
 
-SourceMapGenerator SourceMapGenerator::mergedWithInputSourceMaps() const {
-  assert(
-      !inputSourceMaps_.empty() &&
-      "Cannot merge source maps without input source maps");
-
+void SourceMapGenerator::outputAsJSON(llvm::raw_ostream &OS) const {
   auto sources = getSources();
-
-  // Create a new SourceMapGenerator with the merged data.
-  SourceMapGenerator merged;
-
-  for (uint32_t i = 0, e = lines_.size(); i < e; ++i) {
-    SourceMap::SegmentList newLine{};
-
-    for (const auto &seg : lines_[i]) {
-      SourceMap::Segment newSeg = seg;
-
-      if (auto loc = getInputLocationForSegment(seg)) {
-        // We have an input source map and were able to find a merged source
-        // location.
-        assert(loc->line >= 1 && "line numbers in debug info must be 1-based");
-        assert(
-            loc->column >= 1 && "column numbers in debug info must be 1-based");
-        newSeg.representedLocation = SourceMap::Segment::SourceLocation(
-            merged.addSource(loc->fileName), loc->line - 1, loc->column - 1
-            // TODO: Handle name index
-        );
-      } else {
-        // Failed to find a merge location. Use the existing location,
-        // but copy over the source file name.
-        if (seg.representedLocation.hasValue()) {
-          newSeg.representedLocation->sourceIndex =
-              merged.addSource(sources[seg.representedLocation->sourceIndex]);
-        }
+  llvm::Optional<InputSourceMapMerger> merger;
+  if (!inputSourceMaps_.empty()) {
+    // The merged sources are listed before the mappings, so translate every
+    // segment once to collect them. Only the indexes of the sources are kept,
+    // the mappings are translated again as they are written.
+    merger.emplace(inputSourceMaps_, sources);
+    for (const SourceMap::SegmentList &segments : lines_) {
+      for (const SourceMap::Segment &seg : segments) {
+        merger->translate(seg);
       }
-
-      newLine.push_back(std::move(newSeg));
     }
-
-    merged.addMappingsLine(std::move(newLine), i);
   }
 
-  return merged;
-}
-
-void SourceMapGenerator::outputAsJSON(llvm::raw_ostream &OS) const {
-  if (inputSourceMaps_.empty()) {
-    this->outputAsJSONImpl(OS);
-  } else {
-    // If there are input source maps, we must merge them into a new
-    // SourceMapGenerator before output.
-    mergedWithInputSourceMaps().outputAsJSONImpl(OS);
-  }
-}
-
-void SourceMapGenerator::outputAsJSONImpl(llvm::raw_ostream &OS) const {
   JSONEmitter json(OS);
   json.openDict();
   json.emitKeyValue("version", 3);
 
   json.emitKey("sources");
   json.openArray();
-  json.emitValues(llvm::makeArrayRef(getSources()));
+  if (merger) {
+    json.emitValues(llvm::makeArrayRef(merger->getMergedSources()));
+  } else {
+    json.emitValues(llvm::makeArrayRef(sources));
+  }
   json.closeArray();
 
-  json.emitKeyValue("mappings", getVLQMappingsString());
+  json.emitKey("mappings");
+  json.emitRawStringValue([&](llvm::raw_ostream &OS) {
+    if (merger) {
+      encodeMappings(
+          [&](const SourceMap::Segment &seg) { return merger->translate(seg); },
+          OS);
+    } else {
+      encodeMappings([](const SourceMap::Segment &seg) { return seg; }, OS);
+    }
+  });
   json.closeDict();
   OS.flush();
 }
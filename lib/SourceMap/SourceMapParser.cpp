@@ -7,6 +7,7 @@
 #include "hermes/SourceMap/SourceMapParser.h"
 
 #include "hermes/Parser/JSONParser.h"
+#include "hermes/SourceMap/IndexedSourceMap.h"
 #include "hermes/Support/Base64vlq.h"
 
 #include <algorithm>
@@ -16,8 +17,12 @@ using namespace hermes::parser;
 
 namespace hermes {
 
-std::unique_ptr<SourceMap> SourceMapParser::parse(
-    llvm::StringRef sourceMapContent) {
+bool SourceMapParser::parseJSON(
+    llvm::StringRef sourceMapContent,
+    llvm::function_ref<bool(
+        std::string &sourceRoot,
+        std::vector<std::string> &sources,
+        llvm::StringRef mappings)> onParsed) {
   parser::JSLexer::Allocator alloc;
   parser::JSONFactory factory(alloc);
   SourceErrorManager sm;
@@ -25,7 +30,7 @@ std::unique_ptr<SourceMap> SourceMapParser::parse(
 
   llvm::Optional<JSONValue *> parsedMap = jsonParser.parse();
   if (!parsedMap.hasValue()) {
-    return nullptr;
+    return false;
   }
 
   // Parse for JavaScript version 3 source map https://sourcemaps.info/spec.html
@@ -37,15 +42,15 @@ std::unique_ptr<SourceMap> SourceMapParser::parse(
   //  5. Facebook segments extension.
   auto *json = llvm::dyn_cast_or_null<JSONObject>(parsedMap.getValue());
   if (json == nullptr) {
-    return nullptr;
+    return false;
   }
 
   auto *version = llvm::dyn_cast_or_null<JSONNumber>(json->get("version"));
   if (version == nullptr) {
-    return nullptr;
+    return false;
   }
   if ((uint64_t)version->getValue() != 3) {
-    return nullptr;
+    return false;
   }
 
   // sourceRoot is optional.
@@ -58,30 +63,61 @@ std::unique_ptr<SourceMap> SourceMapParser::parse(
 
   auto *sourcesJson = llvm::dyn_cast_or_null<JSONArray>(json->get("sources"));
   if (sourcesJson == nullptr) {
-    return nullptr;
+    return false;
   }
 
   std::vector<std::string> sources(sourcesJson->size());
   for (unsigned i = 0, e = sources.size(); i < e; ++i) {
     auto *file = llvm::dyn_cast_or_null<JSONString>(sourcesJson->at(i));
     if (file == nullptr) {
-      return nullptr;
+      return false;
     }
     sources[i] = file->str();
   }
 
   auto *mappings = llvm::dyn_cast_or_null<JSONString>(json->get("mappings"));
   if (mappings == nullptr) {
-    return nullptr;
+    return false;
   }
 
-  std::vector<SourceMap::SegmentList> lines;
-  bool succeed = parseMappings(mappings->str(), lines);
-  if (!succeed) {
-    return nullptr;
-  }
-  return llvm::make_unique<SourceMap>(
-      sourceRoot, std::move(sources), std::move(lines));
+  return onParsed(sourceRoot, sources, mappings->str());
+}
+
+std::unique_ptr<SourceMap> SourceMapParser::parse(
+    llvm::StringRef sourceMapContent) {
+  std::unique_ptr<SourceMap> result;
+  parseJSON(
+      sourceMapContent,
+      [&result](
+          std::string &sourceRoot,
+          std::vector<std::string> &sources,
+          llvm::StringRef mappings) {
+        std::vector<SourceMap::SegmentList> lines;
+        bool succeed = parseMappings(mappings, lines);
+        if (!succeed) {
+          return false;
+        }
+        result = llvm::make_unique<SourceMap>(
+            sourceRoot, std::move(sources), std::move(lines));
+        return true;
+      });
+  return result;
+}
+
+std::unique_ptr<IndexedSourceMap> SourceMapParser::parseIndexed(
+    llvm::StringRef sourceMapContent) {
+  std::unique_ptr<IndexedSourceMap> result;
+  parseJSON(
+      sourceMapContent,
+      [&result](
+          std::string &sourceRoot,
+          std::vector<std::string> &sources,
+          llvm::StringRef mappings) {
+        result = llvm::make_unique<IndexedSourceMap>(
+            std::move(sourceRoot), std::move(sources), mappings.str());
+        return true;
+      });
+  return result;
 }
 
 bool SourceMapParser::parseMappings(
@@ -117,17 +153,7 @@ bool SourceMapParser::parseMappings(
         return false;
       }
 
-      state.generatedColumn = segmentOpt->generatedColumn;
-      if (segmentOpt->representedLocation.hasValue()) {
-        state.sourceIndex = segmentOpt->representedLocation->sourceIndex;
-        state.representedLine = segmentOpt->representedLocation->lineIndex;
-        state.representedColumn = segmentOpt->representedLocation->columnIndex;
-
-        if (segmentOpt->representedLocation->nameIndex.hasValue()) {
-          state.nameIndex =
-              segmentOpt->representedLocation->nameIndex.getValue();
-        }
-      }
+      updateState(state, segmentOpt.getValue());
 
       segments.emplace_back(segmentOpt.getValue());
 
@@ -145,6 +171,21 @@ bool SourceMapParser::parseMappings(
   return true;
 }
 
+void SourceMapParser::updateState(
+    State &state,
+    const SourceMap::Segment &segment) {
+  state.generatedColumn = segment.generatedColumn;
+  if (segment.representedLocation.hasValue()) {
+    state.sourceIndex = segment.representedLocation->sourceIndex;
+    state.representedLine = segment.representedLocation->lineIndex;
+    state.representedColumn = segment.representedLocation->columnIndex;
+
+    if (segment.representedLocation->nameIndex.hasValue()) {
+      state.nameIndex = segment.representedLocation->nameIndex.getValue();
+    }
+  }
+}
+
 llvm::Optional<SourceMap::Segment> SourceMapParser::parseSegment(
     const SourceMapParser::State &state,
     const char *&pCur,
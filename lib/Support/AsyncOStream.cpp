@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/Support/AsyncOStream.h"
+
+namespace hermes {
+
+constexpr size_t AsyncOStream::kWakeSize;
+constexpr size_t AsyncOStream::kMaxPendingSize;
+
+AsyncOStream::AsyncOStream(
+    llvm::raw_ostream &out,
+    std::chrono::milliseconds interval)
+    : out_(out), interval_(interval), writer_([this]() { run(); }) {}
+
+AsyncOStream::~AsyncOStream() {
+  flush();
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    stopping_ = true;
+  }
+  wakeWriter_.notify_one();
+  writer_.join();
+}
+
+void AsyncOStream::sync() {
+  flush();
+  std::unique_lock<std::mutex> lk(mutex_);
+  auto isWritten = [this]() { return pending_.empty() && !writing_; };
+  if (isWritten())
+    return;
+  syncing_ = true;
+  wakeWriter_.notify_one();
+  written_.wait(lk, isWritten);
+}
+
+void AsyncOStream::write_impl(const char *ptr, size_t size) {
+  std::unique_lock<std::mutex> lk(mutex_);
+  if (pending_.size() >= kMaxPendingSize) {
+    wakeWriter_.notify_one();
+    written_.wait(lk, [this]() { return pending_.size() < kMaxPendingSize; });
+  }
+  pending_.append(ptr, size);
+  pos_ += size;
+  if (pending_.size() >= kWakeSize)
+    wakeWriter_.notify_one();
+}
+
+void AsyncOStream::run() {
+  std::string chunk;
+  std::unique_lock<std::mutex> lk(mutex_);
+  for (;;) {
+    wakeWriter_.wait_for(lk, interval_, [this]() {
+      return stopping_ || syncing_ || pending_.size() >= kWakeSize;
+    });
+    syncing_ = false;
+    if (!pending_.empty()) {
+      // Write outside of the lock, keeping the allocation of the previous
+      // chunk for the next output.
+      chunk.clear();
+      chunk.swap(pending_);
+      writing_ = true;
+      lk.unlock();
+      out_.write(chunk.data(), chunk.size());
+      out_.flush();
+      lk.lock();
+      writing_ = false;
+    }
+    written_.notify_all();
+    if (stopping_ && pending_.empty())
+      return;
+  }
+}
+
+} // namespace hermes
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/Support/CallbackOStream.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace hermes {
+
+constexpr size_t CallbackOStream::kDefaultChunkSize;
+
+CallbackOStream::CallbackOStream(Callback callback, size_t chunkSize)
+    : callback_(std::move(callback)), chunkSize_(chunkSize) {
+  assert(chunkSize > 0 && "Chunks must not be empty");
+  SetBufferSize(chunkSize);
+}
+
+CallbackOStream::~CallbackOStream() {
+  flush();
+}
+
+void CallbackOStream::write_impl(const char *ptr, size_t size) {
+  // Writes bigger than the buffer bypass it, so split them up.
+  while (size) {
+    const size_t chunk = std::min(size, chunkSize_);
+    callback_(ptr, chunk);
+    ptr += chunk;
+    size -= chunk;
+    pos_ += chunk;
+  }
+}
+
+} // namespace hermes
@@ -76,6 +76,14 @@ void JSONEmitter::emitValue(llvm::StringRef val) {
   primitiveEmitString(val);
 }
 
+void JSONEmitter::emitRawStringValue(
+    llvm::function_ref<void(llvm::raw_ostream &)> contents) {
+  willEmitValue();
+  OS << '"';
+  contents(OS);
+  OS << '"';
+}
+
 void JSONEmitter::emitNullValue() {
   willEmitValue();
   OS << "null";
@@ -244,8 +244,9 @@ void vm_name(void *p, size_t sz, const char *name) {
 #endif // __ANDROID__
 }
 
-bool vm_protect(void *p, size_t sz, ProtectMode) {
-  int err = mprotect(p, sz, PROT_WRITE | PROT_READ);
+bool vm_protect(void *p, size_t sz, ProtectMode mode) {
+  int err = mprotect(
+      p, sz, mode == ProtectMode::None ? PROT_NONE : PROT_WRITE | PROT_READ);
   return err != -1;
 }
 
@@ -265,6 +266,13 @@ bool vm_madvise(void *p, size_t sz, MAdvice advice) {
     case MAdvice::Sequential:
       param = MADV_SEQUENTIAL;
       break;
+    case MAdvice::HugePage:
+#ifdef MADV_HUGEPAGE
+      param = MADV_HUGEPAGE;
+      break;
+#else
+      return false;
+#endif
   }
   return madvise(p, sz, param) == 0;
 }
@@ -0,0 +1,474 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/Support/StringSearch.h"
+
+#include "llvm/Support/MathExtras.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HERMES_STRINGSEARCH_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define HERMES_STRINGSEARCH_NEON
+#endif
+
+namespace hermes {
+
+namespace {
+
+/// Needles at least this long are searched with Horspool's algorithm, whose
+/// skips grow with the length of the needle, instead of a chunk at a time.
+constexpr size_t kHorspoolMinNeedle = 32;
+
+/// \return whether the \p length characters at \p a and \p b are the same.
+template <typename T>
+inline bool charsEqual(const T *a, const T *b, size_t length) {
+  return std::memcmp(a, b, length * sizeof(T)) == 0;
+}
+
+#if defined(HERMES_STRINGSEARCH_SSE2) || defined(HERMES_STRINGSEARCH_NEON)
+// The vectors below hold 16 bytes, so 16 chars or 8 char16_ts. Comparing them
+// gives a lane of all ones or all zeros for each character, which laneBits()
+// turns into one bit per lane, at bit (lane * kBitsPerLane<T>::value).
+constexpr size_t kChunkSize = 16;
+
+template <typename T>
+struct Lanes {
+  static constexpr size_t count = kChunkSize / sizeof(T);
+};
+
+#ifdef HERMES_STRINGSEARCH_SSE2
+using Vec = __m128i;
+
+/// movemask gives a bit for each byte.
+constexpr unsigned kBitsPerByte = 1;
+
+inline Vec loadChunk(const void *p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+/// Load 8 chars from \p p, zero-extended to char16_t.
+inline Vec loadWidened(const char *p) {
+  return _mm_unpacklo_epi8(
+      _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)),
+      _mm_setzero_si128());
+}
+inline Vec splat(char c) {
+  return _mm_set1_epi8(c);
+}
+inline Vec splat(char16_t c) {
+  return _mm_set1_epi16((short)c);
+}
+inline Vec equals(Vec a, Vec b, char) {
+  return _mm_cmpeq_epi8(a, b);
+}
+inline Vec equals(Vec a, Vec b, char16_t) {
+  return _mm_cmpeq_epi16(a, b);
+}
+inline Vec bitAnd(Vec a, Vec b) {
+  return _mm_and_si128(a, b);
+}
+inline Vec bitOr(Vec a, Vec b) {
+  return _mm_or_si128(a, b);
+}
+inline Vec subtract(Vec a, Vec b, char) {
+  return _mm_sub_epi8(a, b);
+}
+inline Vec subtract(Vec a, Vec b, char16_t) {
+  return _mm_sub_epi16(a, b);
+}
+/// Unsigned a <= b, as a saturating a - b giving zero.
+inline Vec atMost(Vec a, Vec b, char) {
+  return _mm_cmpeq_epi8(_mm_subs_epu8(a, b), _mm_setzero_si128());
+}
+inline Vec atMost(Vec a, Vec b, char16_t) {
+  return _mm_cmpeq_epi16(_mm_subs_epu16(a, b), _mm_setzero_si128());
+}
+inline uint64_t byteBits(Vec m) {
+  return (unsigned)_mm_movemask_epi8(m);
+}
+/// The lowest bit of each lane's bits.
+inline uint64_t laneMask(char) {
+  return 0xffff;
+}
+inline uint64_t laneMask(char16_t) {
+  return 0x5555;
+}
+#else
+using Vec = uint8x16_t;
+
+/// There is no movemask, so every byte is narrowed to four bits.
+constexpr unsigned kBitsPerByte = 4;
+
+inline Vec loadChunk(const void *p) {
+  return vld1q_u8(reinterpret_cast<const uint8_t *>(p));
+}
+/// Load 8 chars from \p p, zero-extended to char16_t.
+inline Vec loadWidened(const char *p) {
+  return vreinterpretq_u8_u16(
+      vmovl_u8(vld1_u8(reinterpret_cast<const uint8_t *>(p))));
+}
+inline Vec splat(char c) {
+  return vdupq_n_u8((uint8_t)c);
+}
+inline Vec splat(char16_t c) {
+  return vreinterpretq_u8_u16(vdupq_n_u16(c));
+}
+inline Vec equals(Vec a, Vec b, char) {
+  return vceqq_u8(a, b);
+}
+inline Vec equals(Vec a, Vec b, char16_t) {
+  return vreinterpretq_u8_u16(
+      vceqq_u16(vreinterpretq_u16_u8(a), vreinterpretq_u16_u8(b)));
+}
+inline Vec bitAnd(Vec a, Vec b) {
+  return vandq_u8(a, b);
+}
+inline Vec bitOr(Vec a, Vec b) {
+  return vorrq_u8(a, b);
+}
+inline Vec subtract(Vec a, Vec b, char) {
+  return vsubq_u8(a, b);
+}
+inline Vec subtract(Vec a, Vec b, char16_t) {
+  return vreinterpretq_u8_u16(
+      vsubq_u16(vreinterpretq_u16_u8(a), vreinterpretq_u16_u8(b)));
+}
+/// Unsigned a <= b.
+inline Vec atMost(Vec a, Vec b, char) {
+  return vcleq_u8(a, b);
+}
+inline Vec atMost(Vec a, Vec b, char16_t) {
+  return vreinterpretq_u8_u16(
+      vcleq_u16(vreinterpretq_u16_u8(a), vreinterpretq_u16_u8(b)));
+}
+inline uint64_t byteBits(Vec m) {
+  return vget_lane_u64(
+      vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+}
+/// The lowest bit of each lane's bits.
+inline uint64_t laneMask(char) {
+  return 0x1111111111111111ull;
+}
+inline uint64_t laneMask(char16_t) {
+  return 0x0101010101010101ull;
+}
+#endif
+
+/// \return the comparison result \p m as one bit per lane of type T.
+template <typename T>
+inline uint64_t laneBits(Vec m) {
+  return byteBits(m) & laneMask(T{});
+}
+
+/// \return the lane of the lowest bit of \p bits from laneBits().
+template <typename T>
+inline size_t lowestLane(uint64_t bits) {
+  return llvm::countTrailingZeros(bits) / (kBitsPerByte * sizeof(T));
+}
+
+/// \return the lane of the highest bit of \p bits from laneBits().
+template <typename T>
+inline size_t highestLane(uint64_t bits) {
+  return (63 - llvm::countLeadingZeros(bits)) / (kBitsPerByte * sizeof(T));
+}
+
+/// \return the lanes of \p v that have to be escaped in a JSON string.
+template <typename T>
+inline Vec jsonEscapeLanes(Vec v) {
+  // Control characters are the ones with no bits set above the lowest five.
+  Vec control = equals(bitAnd(v, splat(T(~0x1f))), splat(T(0)), T{});
+  return bitOr(
+      control,
+      bitOr(equals(v, splat(T('"')), T{}), equals(v, splat(T('\\')), T{})));
+}
+
+/// \return the lanes of \p v that are ASCII letters or digits.
+template <typename T>
+inline Vec alphanumericLanes(Vec v) {
+  // Setting bit 5 maps upper case letters to lower case ones, and nothing
+  // else to a letter. Subtracting the first character of a range makes the
+  // characters below it wrap around, so one unsigned comparison checks both
+  // bounds.
+  Vec lower = subtract(bitOr(v, splat(T(0x20))), splat(T('a')), T{});
+  Vec digit = subtract(v, splat(T('0')), T{});
+  return bitOr(
+      atMost(lower, splat(T('z' - 'a')), T{}),
+      atMost(digit, splat(T('9' - '0')), T{}));
+}
+#endif
+
+/// \return whether \p c is an ASCII letter or digit.
+template <typename T>
+inline bool isAlphanumeric(T c) {
+  return (uint16_t)((c | 0x20) - 'a') <= 'z' - 'a' ||
+      (uint16_t)(c - '0') <= '9' - '0';
+}
+
+template <typename T>
+size_t findMismatchImpl(const T *a, const T *b, size_t length) {
+  size_t i = 0;
+#if defined(HERMES_STRINGSEARCH_SSE2) || defined(HERMES_STRINGSEARCH_NEON)
+  for (; length - i >= Lanes<T>::count; i += Lanes<T>::count) {
+    uint64_t bits =
+        laneBits<T>(equals(loadChunk(a + i), loadChunk(b + i), T{}));
+    if (bits != laneMask(T{}))
+      return i + lowestLane<T>(~bits & laneMask(T{}));
+  }
+#endif
+  for (; i < length; ++i) {
+    if (a[i] != b[i])
+      return i;
+  }
+  return length;
+}
+
+/// Horspool's algorithm, which looks at the last character of the window and
+/// skips to where that character can line up with the needle. Characters are
+/// bucketed by their low byte, so a bucket's skip is the smallest of its
+/// characters' skips.
+template <typename T>
+size_t findSubstringHorspool(
+    llvm::ArrayRef<T> haystack,
+    llvm::ArrayRef<T> needle,
+    size_t start) {
+  const size_t m = needle.size();
+  size_t skip[256];
+  std::fill(std::begin(skip), std::end(skip), m);
+  for (size_t i = 0; i + 1 < m; ++i)
+    skip[(uint8_t)needle[i]] = m - 1 - i;
+
+  const T last = needle[m - 1];
+  for (size_t i = start; haystack.size() - i >= m;) {
+    T c = haystack[i + m - 1];
+    if (c == last && charsEqual(haystack.data() + i, needle.data(), m - 1))
+      return i;
+    i += skip[(uint8_t)c];
+  }
+  return kSubstringNotFound;
+}
+
+template <typename T>
+size_t findSubstringImpl(
+    llvm::ArrayRef<T> haystack,
+    llvm::ArrayRef<T> needle,
+    size_t start) {
+  const size_t n = haystack.size();
+  const size_t m = needle.size();
+  if (start > n || n - start < m)
+    return kSubstringNotFound;
+  if (m == 0)
+    return start;
+  if (m >= kHorspoolMinNeedle)
+    return findSubstringHorspool(haystack, needle, start);
+
+  const T *hay = haystack.data();
+  size_t i = start;
+#if defined(HERMES_STRINGSEARCH_SSE2) || defined(HERMES_STRINGSEARCH_NEON)
+  // Find the positions in a chunk where both the first and the last
+  // character of the needle match, and only compare the rest of the needle
+  // at those.
+  const Vec first = splat(needle.front());
+  const Vec last = splat(needle.back());
+  for (; n - i - (m - 1) >= Lanes<T>::count; i += Lanes<T>::count) {
+    uint64_t bits = laneBits<T>(bitAnd(
+        equals(loadChunk(hay + i), first, T{}),
+        equals(loadChunk(hay + i + m - 1), last, T{})));
+    for (; bits; bits &= bits - 1) {
+      size_t pos = i + lowestLane<T>(bits);
+      if (charsEqual(hay + pos, needle.data(), m))
+        return pos;
+    }
+  }
+#endif
+  for (; n - i >= m; ++i) {
+    if (hay[i] == needle.front() && charsEqual(hay + i, needle.data(), m))
+      return i;
+  }
+  return kSubstringNotFound;
+}
+
+template <typename T>
+size_t findLastSubstringImpl(
+    llvm::ArrayRef<T> haystack,
+    llvm::ArrayRef<T> needle,
+    size_t start) {
+  const size_t m = needle.size();
+  if (m > haystack.size())
+    return kSubstringNotFound;
+  // The last position to check, counted from the start plus one, so that the
+  // loops below can stop at zero.
+  size_t end = std::min(start, haystack.size() - m) + 1;
+  if (m == 0)
+    return end - 1;
+
+  const T *hay = haystack.data();
+#if defined(HERMES_STRINGSEARCH_SSE2) || defined(HERMES_STRINGSEARCH_NEON)
+  const Vec first = splat(needle.front());
+  const Vec last = splat(needle.back());
+  for (; end >= Lanes<T>::count; end -= Lanes<T>::count) {
+    size_t i = end - Lanes<T>::count;
+    uint64_t bits = laneBits<T>(bitAnd(
+        equals(loadChunk(hay + i), first, T{}),
+        equals(loadChunk(hay + i + m - 1), last, T{})));
+    while (bits) {
+      size_t lane = highestLane<T>(bits);
+      if (charsEqual(hay + i + lane, needle.data(), m))
+        return i + lane;
+      bits &= ~((uint64_t)1 << (lane * kBitsPerByte * sizeof(T)));
+    }
+  }
+#endif
+  for (; end > 0; --end) {
+    size_t i = end - 1;
+    if (hay[i] == needle.front() && charsEqual(hay + i, needle.data(), m))
+      return i;
+  }
+  return kSubstringNotFound;
+}
+
+template <typename T>
+size_t findJSONEscapeImpl(llvm::ArrayRef<T> str) {
+  const T *p = str.data();
+  const size_t n = str.size();
+  size_t i = 0;
+#if defined(HERMES_STRINGSEARCH_SSE2) || defined(HERMES_STRINGSEARCH_NEON)
+  for (; n - i >= Lanes<T>::count; i += Lanes<T>::count) {
+    uint64_t bits = laneBits<T>(jsonEscapeLanes<T>(loadChunk(p + i)));
+    if (bits)
+      return i + lowestLane<T>(bits);
+  }
+#endif
+  for (; i < n; ++i) {
+    if ((uint16_t)p[i] < u' ' || p[i] == '"' || p[i] == '\\')
+      return i;
+  }
+  return n;
+}
+
+template <typename T>
+size_t findCharacterImpl(llvm::ArrayRef<T> str, T c, size_t start) {
+  const T *p = str.data();
+  const size_t n = str.size();
+  size_t i = start;
+#if defined(HERMES_STRINGSEARCH_SSE2) || defined(HERMES_STRINGSEARCH_NEON)
+  const Vec needle = splat(c);
+  for (; n - i >= Lanes<T>::count; i += Lanes<T>::count) {
+    uint64_t bits = laneBits<T>(equals(loadChunk(p + i), needle, T{}));
+    if (bits)
+      return i + lowestLane<T>(bits);
+  }
+#endif
+  for (; i < n; ++i) {
+    if (p[i] == c)
+      return i;
+  }
+  return n;
+}
+
+template <typename T>
+size_t findNonAlphanumericImpl(llvm::ArrayRef<T> str, size_t start) {
+  const T *p = str.data();
+  const size_t n = str.size();
+  size_t i = start;
+#if defined(HERMES_STRINGSEARCH_SSE2) || defined(HERMES_STRINGSEARCH_NEON)
+  for (; n - i >= Lanes<T>::count; i += Lanes<T>::count) {
+    uint64_t bits = laneBits<T>(alphanumericLanes<T>(loadChunk(p + i)));
+    if (bits != laneMask(T{}))
+      return i + lowestLane<T>(~bits & laneMask(T{}));
+  }
+#endif
+  for (; i < n; ++i) {
+    if (!isAlphanumeric(p[i]))
+      return i;
+  }
+  return n;
+}
+
+} // namespace
+
+size_t findMismatch(const char *a, const char *b, size_t length) {
+  return findMismatchImpl(a, b, length);
+}
+
+size_t findMismatch(const char16_t *a, const char16_t *b, size_t length) {
+  return findMismatchImpl(a, b, length);
+}
+
+size_t findMismatch(const char *a, const char16_t *b, size_t length) {
+  size_t i = 0;
+#if defined(HERMES_STRINGSEARCH_SSE2) || defined(HERMES_STRINGSEARCH_NEON)
+  using T = char16_t;
+  for (; length - i >= Lanes<T>::count; i += Lanes<T>::count) {
+    uint64_t bits =
+        laneBits<T>(equals(loadWidened(a + i), loadChunk(b + i), T{}));
+    if (bits != laneMask(T{}))
+      return i + lowestLane<T>(~bits & laneMask(T{}));
+  }
+#endif
+  for (; i < length; ++i) {
+    if ((unsigned char)a[i] != b[i])
+      return i;
+  }
+  return length;
+}
+
+size_t findSubstring(
+    llvm::ArrayRef<char> haystack,
+    llvm::ArrayRef<char> needle,
+    size_t start) {
+  return findSubstringImpl(haystack, needle, start);
+}
+
+size_t findSubstring(
+    llvm::ArrayRef<char16_t> haystack,
+    llvm::ArrayRef<char16_t> needle,
+    size_t start) {
+  return findSubstringImpl(haystack, needle, start);
+}
+
+size_t findLastSubstring(
+    llvm::ArrayRef<char> haystack,
+    llvm::ArrayRef<char> needle,
+    size_t start) {
+  return findLastSubstringImpl(haystack, needle, start);
+}
+
+size_t findLastSubstring(
+    llvm::ArrayRef<char16_t> haystack,
+    llvm::ArrayRef<char16_t> needle,
+    size_t start) {
+  return findLastSubstringImpl(haystack, needle, start);
+}
+
+size_t findJSONEscape(llvm::ArrayRef<char> str) {
+  return findJSONEscapeImpl(str);
+}
+
+size_t findJSONEscape(llvm::ArrayRef<char16_t> str) {
+  return findJSONEscapeImpl(str);
+}
+
+size_t findCharacter(llvm::ArrayRef<char> str, char c, size_t start) {
+  return findCharacterImpl(str, c, start);
+}
+
+size_t findCharacter(llvm::ArrayRef<char16_t> str, char16_t c, size_t start) {
+  return findCharacterImpl(str, c, start);
+}
+
+size_t findNonAlphanumeric(llvm::ArrayRef<char> str, size_t start) {
+  return findNonAlphanumericImpl(str, start);
+}
+
+size_t findNonAlphanumeric(llvm::ArrayRef<char16_t> str, size_t start) {
+  return findNonAlphanumericImpl(str, start);
+}
+
+} // namespace hermes
@@ -672,8 +672,17 @@ CallResult<HermesValue> BoundFunction::_boundCall(
         ? callerFrame.getScratchRef()
         : self->getArgsWithThis(runtime)[0];
 
-    res =
-        Callable::call(newCalleeFrame.getCalleeClosureHandleUnsafe(), runtime);
+    // Enter plain JS functions directly, like the interpreter does, instead of
+    // dispatching through the vtable: bound functions are mostly callbacks.
+    Callable *target = self->getTarget(runtime);
+    if (target->getKind() == CellKind::FunctionKind) {
+      CodeBlock *codeBlock = vmcast<JSFunction>(target)->getCodeBlock();
+      runtime->potentiallyMoveHeap();
+      res = runtime->interpretFunction(codeBlock);
+    } else {
+      res = Callable::call(
+          newCalleeFrame.getCalleeClosureHandleUnsafe(), runtime);
+    }
 
     assert(
         runtime->getCurrentFrame() == callerFrame &&
@@ -895,8 +904,11 @@ CallResult<HermesValue> JSFunction::_callImpl(
     Handle<Callable> selfHandle,
     Runtime *runtime) {
   auto *self = vmcast<JSFunction>(selfHandle.get());
-  if (auto *jitPtr = self->getCodeBlock()->getJITCompiled())
-    return (*jitPtr)(runtime);
+  // Compiled code doesn't record code coverage.
+  if (auto *jitPtr = self->getCodeBlock()->getJITCompiled()) {
+    if (LLVM_LIKELY(!runtime->isCodeCoverageEnabled()))
+      return (*jitPtr)(runtime);
+  }
   return runtime->interpretFunction(self->getCodeBlock());
 }
 
@@ -1068,12 +1080,13 @@ void GeneratorInnerFunction::saveStack(Runtime *runtime) {
   PinnedHermesValue *first = StackFrameLayout::StackIncrement > 0
       ? runtime->getCurrentFrame().ptr()
       : runtime->getCurrentFrame().ptr() - frameSize;
-  // Use GCHermesValue::copy to ensure write barriers are executed.
-  GCHermesValue::copy(
-      first,
-      first + frameSize,
-      &savedContext_.get(runtime)->at(frameOffset),
-      &runtime->getHeap());
+  // Copy the registers in bulk and execute a single range write barrier,
+  // instead of a barrier per register: generators may yield many times and
+  // the frame is saved every time.
+  GCHermesValue *dst = &savedContext_.get(runtime)->at(frameOffset);
+  std::memcpy(
+      reinterpret_cast<void *>(dst), first, frameSize * sizeof(GCHermesValue));
+  runtime->getHeap().writeBarrierRange(dst, frameSize);
 }
 
 } // namespace vm
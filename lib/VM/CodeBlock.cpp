@@ -11,6 +11,7 @@
 #include "hermes/BCGen/HBC/Bytecode.h"
 #include "hermes/BCGen/HBC/HBC.h"
 #include "hermes/IRGen/IRGen.h"
+#include "hermes/Inst/InstDecode.h"
 #include "hermes/Support/Conversions.h"
 #include "hermes/Support/OSCompat.h"
 #include "hermes/Support/PerfSection.h"
@@ -22,6 +23,8 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MathExtras.h"
 
+#include <algorithm>
+
 namespace hermes {
 namespace vm {
 
@@ -155,9 +158,56 @@ CodeBlock *CodeBlock::createCodeBlock(
       runtimeModule, header, bytecode, functionID, cacheSize, readCacheSize);
 }
 
-int32_t CodeBlock::findCatchTargetOffset(uint32_t exceptionOffset) {
-  return runtimeModule_->getBytecode()->findCatchTargetOffset(
-      functionID_, exceptionOffset);
+void CodeBlock::buildHandlerIndex() {
+  handlerIndex_.clear();
+  if (isLazy() || !headerFlags_.hasExceptionHandler)
+    return;
+
+  // Handler ranges are either nested or disjoint, and the exception table
+  // lists inner handlers first. Split the function at every range boundary,
+  // so that each piece is covered by the same handlers throughout, and give
+  // each piece the first handler covering it.
+  auto table = runtimeModule_->getBytecode()->getExceptionTable(functionID_);
+  std::vector<uint32_t> bounds;
+  bounds.reserve(table.size() * 2);
+  for (const auto &handler : table) {
+    bounds.push_back(handler.start);
+    bounds.push_back(handler.end);
+  }
+  std::sort(bounds.begin(), bounds.end());
+  bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+  for (size_t i = 1; i < bounds.size(); ++i) {
+    uint32_t start = bounds[i - 1];
+    uint32_t end = bounds[i];
+    for (const auto &handler : table) {
+      if (handler.start > start || end > handler.end)
+        continue;
+      if (!handlerIndex_.empty() && handlerIndex_.back().end == start &&
+          handlerIndex_.back().target == handler.target) {
+        handlerIndex_.back().end = end;
+      } else {
+        handlerIndex_.push_back({start, end, handler.target});
+      }
+      break;
+    }
+  }
+  handlerIndex_.shrink_to_fit();
+}
+
+int32_t CodeBlock::findCatchTargetOffset(uint32_t exceptionOffset) const {
+  // Find the last range starting at or before the offset.
+  auto it = std::upper_bound(
+      handlerIndex_.begin(),
+      handlerIndex_.end(),
+      exceptionOffset,
+      [](uint32_t offset, const hbc::HBCExceptionHandlerInfo &handler) {
+        return offset < handler.start;
+      });
+  if (it == handlerIndex_.begin())
+    return -1;
+  --it;
+  return exceptionOffset < it->end ? it->target : -1;
 }
 
 SLP CodeBlock::getArrayBufferIter(uint32_t idx, unsigned int numLiterals)
@@ -266,9 +316,9 @@ void CodeBlock::lazyCompileImpl(Runtime *runtime) {
   // Reset all meta data of the CodeBlock to point to the newly
   // generated bytecode module.
   functionID_ = runtimeModule_->getBytecode()->getGlobalFunctionIndex();
-  functionHeader_ =
-      runtimeModule_->getBytecode()->getFunctionHeader(functionID_);
+  setHeader(runtimeModule_->getBytecode()->getFunctionHeader(functionID_));
   bytecode_ = runtimeModule_->getBytecode()->getBytecode(functionID_);
+  buildHandlerIndex();
 #ifdef HERMES_ENABLE_DEBUGGER
   runtime->getDebugger().resolveBreakpoints(this);
 #endif
@@ -278,8 +328,22 @@ void CodeBlock::lazyCompileImpl(Runtime *runtime) {
 void CodeBlock::markCachedHiddenClasses(SlotAcceptor &acceptor) {
   for (auto &prop :
        llvm::makeMutableArrayRef(propertyCache(), propertyCacheSize_)) {
-    if (prop.clazz) {
-      acceptor.accept(reinterpret_cast<void *&>(prop.clazz));
+    for (auto &way : prop.ways) {
+      if (way.clazz) {
+        acceptor.accept(reinterpret_cast<void *&>(way.clazz));
+      }
+    }
+  }
+  for (auto &proto :
+       llvm::makeMutableArrayRef(protoPropertyCache(), writePropCacheOffset_)) {
+    if (proto.receiverClass) {
+      acceptor.accept(reinterpret_cast<void *&>(proto.receiverClass));
+    }
+    if (proto.intermediateClass) {
+      acceptor.accept(reinterpret_cast<void *&>(proto.intermediateClass));
+    }
+    if (proto.holderClass) {
+      acceptor.accept(reinterpret_cast<void *&>(proto.holderClass));
     }
   }
 }
@@ -289,6 +353,71 @@ uint32_t CodeBlock::getVirtualOffset() const {
       functionID_);
 }
 
+size_t CodeBlock::releaseDerivedData() {
+  assert(
+      !getJITQueued() && !getJITCompiled() &&
+      "the JIT may be reading the type feedback");
+  size_t size = 0;
+  if (typeFeedback_) {
+    size += typeFeedback_->size() * (sizeof(uint32_t) + sizeof(uint8_t));
+    typeFeedback_.reset();
+  }
+#ifdef HERMESVM_INDIRECT_THREADING
+  if (threadedCode_) {
+    size += getOpcodeArray().size() * sizeof(void *);
+    threadedCode_.reset();
+  }
+#endif
+  return size;
+}
+
+#ifdef HERMESVM_INDIRECT_THREADING
+void CodeBlock::buildThreadedCode(Runtime *runtime, void *const *handlers) {
+  assert(!isLazy() && "lazy functions have no bytecode");
+  auto opcodes = getOpcodeArray();
+  // Only the entries at the start of instructions are ever read.
+  threadedCode_.reset(new void *[opcodes.size()]);
+  threadedHandlers_ = handlers;
+  for (uint32_t offset = 0; offset < opcodes.size();) {
+    auto opCode = reinterpret_cast<const Inst *>(&opcodes[offset])->opCode;
+    assert(opCode < OpCode::_last && "invalid opcode");
+    threadedCode_[offset] = handlers[(unsigned)opCode];
+#ifdef HERMES_ENABLE_DEBUGGER
+    // A breakpoint dispatches to the Debugger handler, but the instruction it
+    // replaced determines where the next one starts.
+    if (opCode == OpCode::Debugger) {
+      if (auto loc =
+              runtime->getDebugger().getBreakpointLocation(this, offset))
+        opCode = static_cast<OpCode>(loc->opCode);
+    }
+#endif
+    offset += getInstSize(opCode);
+  }
+}
+#endif
+
+void CodeBlock::createTypeFeedback(Runtime *runtime) {
+  assert(!isLazy() && "lazy functions have no bytecode");
+  auto opcodes = getOpcodeArray();
+  llvm::SmallVector<uint32_t, 32> siteOffsets;
+  for (uint32_t offset = 0; offset < opcodes.size();) {
+    auto opCode = reinterpret_cast<const Inst *>(&opcodes[offset])->opCode;
+#ifdef HERMES_ENABLE_DEBUGGER
+    // Decode the instruction a breakpoint replaced.
+    if (opCode == OpCode::Debugger) {
+      if (auto loc =
+              runtime->getDebugger().getBreakpointLocation(this, offset))
+        opCode = static_cast<OpCode>(loc->opCode);
+    }
+#endif
+    assert(opCode < OpCode::_last && "invalid opcode");
+    if (TypeFeedbackVector::isFeedbackSite(opCode))
+      siteOffsets.push_back(offset);
+    offset += getInstSize(opCode);
+  }
+  typeFeedback_.reset(new TypeFeedbackVector(siteOffsets));
+}
+
 #ifdef HERMES_ENABLE_DEBUGGER
 
 uint32_t CodeBlock::getNextOffset(uint32_t offset) const {
@@ -298,12 +427,7 @@ uint32_t CodeBlock::getNextOffset(uint32_t offset) const {
   auto opCode = reinterpret_cast<const Inst *>(&opcodes[offset])->opCode;
   assert(opCode < OpCode::_last && "invalid opecode");
 
-  static const uint8_t sizes[] = {
-#define DEFINE_OPCODE(name) sizeof(inst::name##Inst),
-#include "hermes/BCGen/HBC/BytecodeList.def"
-  };
-
-  return offset + sizes[(unsigned)opCode];
+  return offset + getInstSize(opCode);
 }
 
 /// Makes the page that \p address is in writable.
@@ -339,6 +463,12 @@ void CodeBlock::installBreakpointAtOffset(uint32_t offset) {
 
   makeWritable(address, sizeof(inst::DebuggerInst));
   *address = debuggerOpcode;
+#ifdef HERMESVM_INDIRECT_THREADING
+  // Frames running this function dispatch through the threaded code, which
+  // must see the breakpoint too.
+  if (threadedCode_)
+    threadedCode_[offset] = threadedHandlers_[(unsigned)OpCode::Debugger];
+#endif
 }
 
 void CodeBlock::uninstallBreakpointAtOffset(
@@ -355,6 +485,10 @@ void CodeBlock::uninstallBreakpointAtOffset(
   // This is valid because we can only uninstall breakpoints that we installed.
   // Therefore, the page here must be writable.
   *address = opCode;
+#ifdef HERMESVM_INDIRECT_THREADING
+  if (threadedCode_)
+    threadedCode_[offset] = threadedHandlers_[opCode];
+#endif
 }
 
 #endif
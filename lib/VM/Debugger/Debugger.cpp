@@ -9,6 +9,7 @@
 #include "hermes/VM/Debugger/Debugger.h"
 
 #include "hermes/Support/UTF8.h"
+#include "hermes/Inst/InstDecode.h"
 #include "hermes/VM/Callable.h"
 #include "hermes/VM/CodeBlock.h"
 #include "hermes/VM/JSError.h"
@@ -33,6 +34,21 @@ static inline bool shouldSingleStep(OpCode opCode) {
   return opCode == OpCode::Throw || opCode == OpCode::SwitchImm;
 }
 
+/// \return whether the instruction \p opCode may continue anywhere other than
+/// at the next instruction of the same frame, without throwing.
+static bool mayTransferControl(OpCode opCode) {
+  if (getInstDescriptor(opCode).flags & (InstFlagBranch | InstFlagTerminator))
+    return true;
+  switch (opCode) {
+    case OpCode::StartGenerator:
+    case OpCode::ResumeGenerator:
+    case OpCode::CompleteGenerator:
+      return true;
+    default:
+      return false;
+  }
+}
+
 static StringView getFunctionName(
     Runtime *runtime,
     const CodeBlock *codeBlock) {
@@ -80,8 +96,12 @@ static llvm::Optional<ScopeChain> scopeChainForBlock(
     if (!parentId || *parentId == bytecode->getGlobalFunctionIndex())
       break;
 
-    lexicalDataOffset = runtimeModule->getCodeBlockMayAllocate(*parentId)
-                            ->getDebugLexicalDataOffset();
+    CodeBlock *parent = runtimeModule->getCodeBlockMayAllocate(*parentId);
+    if (!parent) {
+      // The parent lies outside of the bytecode.
+      return llvm::None;
+    }
+    lexicalDataOffset = parent->getDebugLexicalDataOffset();
   }
   return {std::move(scopeChain)};
 }
@@ -118,12 +138,30 @@ void Debugger::breakAtJumpTarget(InterpreterState &state) {
 }
 
 void Debugger::breakAtPossibleNextInstructions(InterpreterState &state) {
-  auto nextOffset = state.codeBlock->getNextOffset(state.offset);
-  // Set a breakpoint at the next instruction in the code block if this is not
-  // the last instruction.
-  if (nextOffset < state.codeBlock->getOpcodeArray().size()) {
-    setStepBreakpoint(
-        state.codeBlock, nextOffset, runtime_->getCurrentFrameOffset());
+  CodeBlock *codeBlock = state.codeBlock;
+  const uint32_t end = codeBlock->getOpcodeArray().size();
+  // Skip the following instructions that would only make the step continue
+  // when stopping there, instead of stopping at each of them in turn.
+  uint32_t nextOffset = codeBlock->getNextOffset(state.offset);
+  while (nextOffset < end) {
+    auto locationOpt = getSourceLocation(codeBlock, nextOffset);
+    if (locationOpt.hasValue() && locationOpt->statement != 0 &&
+        !sameStatementDifferentInstruction(
+            InterpreterState(codeBlock, nextOffset), preStepState_)) {
+      break;
+    }
+    // Read the opcode a breakpoint may have replaced.
+    auto breakpointOpt = getBreakpointLocation(codeBlock, nextOffset);
+    auto opCode = breakpointOpt ? static_cast<OpCode>(breakpointOpt->opCode)
+                                : codeBlock->getOpCode(nextOffset);
+    if (mayTransferControl(opCode)) {
+      break;
+    }
+    nextOffset += getInstSize(opCode);
+  }
+  // Set a breakpoint there if this is not past the last instruction.
+  if (nextOffset < end) {
+    setStepBreakpoint(codeBlock, nextOffset, runtime_->getCurrentFrameOffset());
   }
   // If the instruction is a jump, set a break point at the possible
   // jump target; otherwise, only break at the next instruction.
@@ -432,6 +470,11 @@ void Debugger::willExecuteModule(RuntimeModule *module, CodeBlock *codeBlock) {
   // Add a breakpoint on the first opcode of its global function.
   auto globalFunctionIndex = module->getBytecode()->getGlobalFunctionIndex();
   auto globalCode = module->getCodeBlockMayAllocate(globalFunctionIndex);
+  if (!globalCode) {
+    // The global function lies outside of the bytecode, so the module fails
+    // to run before it could pause.
+    return;
+  }
   setOnLoadBreakpoint(globalCode, 0);
 }
 
@@ -909,7 +952,6 @@ HermesValue Debugger::evalInFrame(
   }
 
   MutableHandle<> resultHandle(runtime_);
-  bool singleFunction = false;
 
   // Environment may be undefined if it has not been created yet.
   Handle<Environment> env =
@@ -930,13 +972,16 @@ HermesValue Debugger::evalInFrame(
     return HermesValue::encodeUndefinedValue();
   }
 
-  CallResult<HermesValue> result = evalInEnvironment(
-      runtime_,
-      src,
+  auto bytecodeRes = getEvalBytecode(src, *scopeChain);
+  if (bytecodeRes == ExecutionStatus::EXCEPTION)
+    return getExceptionAsEvalResult(outMetadata);
+
+  CallResult<HermesValue> result = runtime_->runBytecode(
+      std::move(*bytecodeRes),
+      RuntimeModuleFlags{},
+      llvm::StringRef{},
       env,
-      *scopeChain,
-      Handle<>(&frameInfo->frame->getThisArgRef()),
-      singleFunction);
+      Handle<>(&frameInfo->frame->getThisArgRef()));
 
   // Check if an exception was thrown.
   if (result.getStatus() == ExecutionStatus::EXCEPTION)
@@ -949,6 +994,35 @@ HermesValue Debugger::evalInFrame(
   return *resultHandle;
 }
 
+CallResult<std::shared_ptr<hbc::BCProvider>> Debugger::getEvalBytecode(
+    const std::string &src,
+    const ScopeChain &scopeChain) {
+  // Identifiers are resolved when compiling, so the bytecode only depends on
+  // the names in scope, which can't contain the separators.
+  std::string key;
+  for (const ScopeChainItem &item : scopeChain.functions) {
+    for (llvm::StringRef name : item.variables) {
+      key += name;
+      key += ',';
+    }
+    key += ';';
+  }
+  key += '\0';
+  key += src;
+
+  auto it = evalCache_.find(key);
+  if (it != evalCache_.end())
+    return it->second;
+
+  auto bytecodeRes = compileEvalSource(runtime_, src, scopeChain, false);
+  if (bytecodeRes == ExecutionStatus::EXCEPTION)
+    return ExecutionStatus::EXCEPTION;
+  if (evalCache_.size() >= kMaxEvalCacheSize)
+    evalCache_.clear();
+  evalCache_[key] = *bytecodeRes;
+  return bytecodeRes;
+}
+
 llvm::Optional<std::pair<InterpreterState, uint32_t>> Debugger::findCatchTarget(
     const InterpreterState &state) const {
   auto *codeBlock = state.codeBlock;
@@ -1120,6 +1194,10 @@ bool Debugger::resolveBreakpointLocation(Breakpoint &breakpoint) const {
     if (locationOpt.hasValue()) {
       breakpoint.codeBlock =
           runtimeModule.getCodeBlockMayAllocate(locationOpt->functionIndex);
+      if (!breakpoint.codeBlock) {
+        // The function lies outside of the bytecode.
+        continue;
+      }
       breakpoint.offset = locationOpt->bytecodeOffset;
 
       SourceLocation resolvedLocation;
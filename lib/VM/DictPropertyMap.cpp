@@ -197,27 +197,33 @@ DictPropertyMap::findOrAdd(
 
   // We want to grow the hash table if the number of occupied hash entries
   // exceeds 75% of capacity or if the descriptor array is full. Since the
-  // capacity of the table is 4/3 of the capacity of the descriptor array, it is
+  // capacity of the table is 4/3 of the capacity of the descriptor array, and
+  // the deleted hash entries are never more than the descriptors, it is
   // sufficient to only check for the latter.
 
   if (self->numDescriptors_ == self->descriptorCapacity_) {
+    // The descriptors which have to be kept: the valid ones, the deleted
+    // list and the new property. The invalid ones, and the deleted hash
+    // entries, are dropped by grow().
+    size_type needed = self->numProperties_ + self->deletedListSize_ + 1;
     size_type newCapacity;
-    if (self->numProperties_ == self->descriptorCapacity_) {
-      // Double the new capacity, up to kMaxCapacity. However make sure that
-      // we try to allocate at least one extra property. If we are already
-      // exactly at kMaxCapacity, there is nothing we can do, so grow() will
-      // simply fail.
-      newCapacity = self->numProperties_ * 2;
-      if (newCapacity > detail::kMaxCapacity)
-        newCapacity =
-            std::max(toRValue(detail::kMaxCapacity), self->numProperties_ + 1);
+    if (needed > self->descriptorCapacity_) {
+      // Double the capacity.
+      newCapacity = self->descriptorCapacity_ * 2;
     } else {
-      // Calculate the new capacity to be exactly as much as we need to
-      // accomodate the deleted list plus one extra property. It it happens
-      // to exceed kMaxCapacity, there is nothing we can do, so grow() will
-      // raise an exception.
-      newCapacity = self->numProperties_ + 1 + self->deletedListSize_;
+      // Some descriptors are invalid, because properties were deleted and
+      // their slots reused. Leave room for half as many new properties as
+      // are kept, so that the cost of compacting the map is amortized when
+      // properties are repeatedly added and deleted, like in an object used
+      // as a hash map. If most of the descriptors are invalid, the map
+      // shrinks.
+      newCapacity = std::max(needed + needed / 2, toRValue(DEFAULT_CAPACITY));
     }
+    // Stay below kMaxCapacity, but make sure that we try to allocate at least
+    // the needed capacity. If it exceeds kMaxCapacity, there is nothing we can
+    // do, so grow() will raise an exception.
+    if (newCapacity > detail::kMaxCapacity)
+      newCapacity = std::max(toRValue(detail::kMaxCapacity), needed);
 
     if (LLVM_UNLIKELY(
             grow(selfHandleRef, runtime, newCapacity) ==
@@ -241,6 +247,7 @@ DictPropertyMap::findOrAdd(
 
   descPair->first = id;
   ++self->numDescriptors_;
+  runtime->getHeap().writeBarrierSymbol(id);
 
   return std::make_pair(&descPair->second, true);
 }
@@ -9,6 +9,7 @@
 
 #include "hermes/Platform/Logging.h"
 #include "hermes/Support/ErrorHandling.h"
+#include "hermes/Support/JSONEmitter.h"
 
 #include "hermes/Support/OSCompat.h"
 #include "hermes/VM/CellKind.h"
@@ -51,6 +52,7 @@ GCBase::GCBase(
 #ifdef HERMESVM_MEMORY_PROFILER
       memEventTracker_(gcConfig.getMemEventTracker()),
 #endif
+      cycleEventCallback_(gcConfig.getCycleEventCallback()),
       tripwireCallback_(gcConfig.getTripwireConfig().getCallback()),
       tripwireLimit_(gcConfig.getTripwireConfig().getLimit()),
       tripwireCooldown_(gcConfig.getTripwireConfig().getCooldown())
@@ -89,14 +91,36 @@ GCBase::GCBase(
   }
   randomEngine_.seed(seed);
 #endif
+  if (gcConfig.getShouldRecordTelemetry())
+    telemetry_.reset(new Telemetry());
 }
 
-GCBase::GCCycle::GCCycle(GCBase *gc) : gc_(gc) {
+GCBase::GCCycle::GCCycle(GCBase *gc) : gc_(gc), nested_(gc->inGC_) {
   gc_->inGC_ = true;
+  if (!nested_)
+    gc_->gcCallbacks_->onGCCycle(true);
 }
 
 GCBase::GCCycle::~GCCycle() {
   gc_->inGC_ = false;
+  if (!nested_)
+    gc_->gcCallbacks_->onGCCycle(false);
+}
+
+bool GCBase::runDeferredFinalizers(
+    std::chrono::steady_clock::time_point deadline) {
+  while (!deferredFinalizers_.empty()) {
+    if (deadline != std::chrono::steady_clock::time_point::max() &&
+        std::chrono::steady_clock::now() >= deadline) {
+      return true;
+    }
+    // Dequeue first, so that the queue stays consistent if the release queues
+    // more.
+    std::function<void()> release = std::move(deferredFinalizers_.front());
+    deferredFinalizers_.pop_front();
+    release();
+  }
+  return false;
 }
 
 void GCBase::runtimeWillExecute() {
@@ -118,6 +142,16 @@ bool GCBase::createSnapshotToFile(const std::string &fileName, bool compact) {
   return true;
 }
 
+bool GCBase::createSnapshotToFileDescriptor(int fd, bool compact) {
+  llvm::raw_fd_ostream os(fd, /* shouldClose */ false);
+  createSnapshot(os, compact);
+  os.flush();
+  const bool failed = os.has_error();
+  // The stream reports errors that are not cleared when it is destroyed.
+  os.clear_error();
+  return !failed;
+}
+
 void GCBase::checkTripwire(
     size_t dataSize,
     std::chrono::time_point<std::chrono::steady_clock> now) {
@@ -144,6 +178,79 @@ void GCBase::checkTripwire(
   nextTripwireMinTime_ = now + tripwireCooldown_;
 }
 
+constexpr size_t GCBase::kNumRecentCycleEvents;
+
+void GCBase::beginCycleEvent(
+    const char *kind,
+    const char *cause,
+    uint64_t allocatedBefore,
+    uint64_t sizeBefore) {
+  assert(!recordingCycleEvent_ && "Collections do not nest");
+  if (!cycleEventCallback_ && !recordGcStats_) {
+    return;
+  }
+  recordingCycleEvent_ = true;
+  currentCycleEvent_ = GCCycleEvent();
+  currentCycleEvent_.kind = kind;
+  currentCycleEvent_.cause = cause;
+  currentCycleEvent_.allocatedBefore = allocatedBefore;
+  currentCycleEvent_.sizeBefore = sizeBefore;
+}
+
+void GCBase::endCycleEvent(
+    double wallTime,
+    double cpuTime,
+    uint64_t allocatedAfter,
+    uint64_t sizeAfter) {
+  if (!recordingCycleEvent_) {
+    return;
+  }
+  recordingCycleEvent_ = false;
+  currentCycleEvent_.wallTime = wallTime;
+  currentCycleEvent_.cpuTime = cpuTime;
+  currentCycleEvent_.allocatedAfter = allocatedAfter;
+  currentCycleEvent_.sizeAfter = sizeAfter;
+  if (cycleEventCallback_) {
+    cycleEventCallback_(currentCycleEvent_);
+  }
+  if (recordGcStats_) {
+    if (recentCycleEvents_.size() == kNumRecentCycleEvents) {
+      recentCycleEvents_.pop_front();
+    }
+    recentCycleEvents_.push_back(std::move(currentCycleEvent_));
+  }
+}
+
+void GCBase::printCycleEvents(llvm::raw_ostream &os, bool trailingComma)
+    const {
+  os << "\t\"collections\": [";
+  bool firstEvent = true;
+  for (const GCCycleEvent &event : recentCycleEvents_) {
+    os << (firstEvent ? "\n" : ",\n");
+    firstEvent = false;
+    os << "\t\t{\"kind\": \"" << event.kind << "\", \"cause\": \""
+       << event.cause << "\", \"wallTime\": " << event.wallTime
+       << ", \"cpuTime\": " << event.cpuTime
+       << ", \"allocatedBefore\": " << event.allocatedBefore
+       << ", \"sizeBefore\": " << event.sizeBefore
+       << ", \"allocatedAfter\": " << event.allocatedAfter
+       << ", \"sizeAfter\": " << event.sizeAfter
+       << ", \"promotedBytes\": " << event.promotedBytes << ", \"phases\": [";
+    bool firstPhase = true;
+    for (const auto &phase : event.phases) {
+      os << (firstPhase ? "" : ", ") << "[\"" << phase.first << "\", "
+         << phase.second << "]";
+      firstPhase = false;
+    }
+    os << "]}";
+  }
+  os << (firstEvent ? "]" : "\n\t]");
+  if (trailingComma) {
+    os << ",";
+  }
+  os << "\n";
+}
+
 void GCBase::printAllCollectedStats(llvm::raw_ostream &os) {
   if (!recordGcStats_)
     return;
@@ -153,10 +260,55 @@ void GCBase::printAllCollectedStats(llvm::raw_ostream &os) {
      << "{\n"
      << "\t\"type\": \"hermes\",\n"
      << "\t\"version\": 0,\n";
-  printStats(os, false);
+  printStats(os, true);
+  printCycleEvents(os, false);
   os << "}\n";
 }
 
+void GCBase::printTelemetry(llvm::raw_ostream &os) const {
+  JSONEmitter json(os);
+  json.openDict();
+  if (!telemetry_) {
+    json.closeDict();
+    return;
+  }
+  auto emitHistogram = [&json](const char *name, const Histogram &histogram) {
+    json.emitKey(name);
+    json.openDict();
+    json.emitKeyValue("count", histogram.stats().count());
+    json.emitKeyValue("min", histogram.stats().min());
+    json.emitKeyValue("max", histogram.stats().max());
+    json.emitKeyValue("mean", histogram.stats().average());
+    // Each bucket counts the samples at most its upper bound "le", and
+    // greater than the bound of the previous one.  The last bucket has no
+    // bound.
+    json.emitKey("buckets");
+    json.openArray();
+    for (unsigned i = 0, e = histogram.numBuckets(); i < e; ++i) {
+      json.openDict();
+      if (i + 1 < e)
+        json.emitKeyValue("le", histogram.upperBound(i));
+      json.emitKeyValue("count", histogram.count(i));
+      json.closeDict();
+    }
+    json.closeArray();
+    json.closeDict();
+  };
+  emitHistogram("allocationRate", telemetry_->allocationRate);
+  emitHistogram("youngGenSurvival", telemetry_->youngGenSurvival);
+  emitHistogram("promotionAge", telemetry_->promotionAge);
+  json.emitKey("allocatedBytesByKind");
+  json.openDict();
+  for (size_t i = 0; i < Telemetry::kNumCellKinds; ++i) {
+    if (telemetry_->allocatedBytesByKind[i])
+      json.emitKeyValue(
+          cellKindStr(static_cast<CellKind>(i)),
+          telemetry_->allocatedBytesByKind[i]);
+  }
+  json.closeDict();
+  json.closeDict();
+}
+
 void GCBase::getHeapInfo(HeapInfo &info) {
   info.numCollections = cumStats_.numCollections;
 }
@@ -227,6 +379,9 @@ void GCBase::printStats(llvm::raw_ostream &os, bool trailingComma) {
      << "\t\t\"Heap size\": " << info.heapSize << ",\n"
      << "\t\t\"Allocated bytes\": " << info.allocatedBytes << ",\n"
      << "\t\t\"Num collections\": " << info.numCollections << ",\n"
+     << "\t\t\"VA\": " << info.va << ",\n"
+     << "\t\t\"VA span\": " << info.vaSpan << ",\n"
+     << "\t\t\"Huge page bytes\": " << info.hugePageBytes << ",\n"
      << "\t\t\"Malloc size\": " << info.mallocSizeEstimate << "\n"
      << "\t},\n";
 
@@ -11,6 +11,7 @@
 #include "hermes/Support/UTF8.h"
 #include "hermes/VM/StringPrimitive.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 
@@ -267,6 +268,8 @@ void rawHeapSnapshot(
 
 const uint32_t V8_SNAPSHOT_NODE_FIELD_COUNT = 6;
 
+constexpr uint32_t V8HeapSnapshot::kMaxStringValueLength;
+
 V8HeapSnapshot::V8HeapSnapshot(JSONEmitter &json) : json_(json) {
   json_.openDict();
   emitMeta();
@@ -573,6 +576,17 @@ std::string converter(const StringPrimitive *str) {
   convertUTF16ToUTF8WithReplacements(out, UTF16Ref(buf));
   return out;
 }
+std::string converter(const StringPrimitive *str, uint32_t maxLength) {
+  const uint32_t length = std::min(str->getStringLength(), maxLength);
+  std::string out;
+  if (str->isASCII()) {
+    out.assign(str->getStringRef<char>().data(), length);
+  } else {
+    convertUTF16ToUTF8WithReplacements(
+        out, str->getStringRef<char16_t>().slice(0, length));
+  }
+  return out;
+}
 std::string converter(const UTF16Ref ref) {
   std::string out;
   convertUTF16ToUTF8WithReplacements(out, ref);
@@ -33,11 +33,26 @@ void HiddenClassBuildMeta(const GCCell *cell, Metadata::Builder &mb) {
   mb.addField("@family", &self->family_);
   mb.addField("@propertyMap", &self->propertyMap_);
   mb.addField("@forInCache", &self->forInCache_);
+  mb.addField("@jsonCache", &self->jsonCache_);
+  mb.addField("@ownPropertiesCache", &self->ownPropertiesCache_);
 }
 
 void HiddenClass::_markWeakImpl(GCCell *cell, GC *gc) {
   auto *self = vmcast_during_gc<HiddenClass>(cell, gc);
   self->transitionMap_.markWeakRefs(gc);
+
+  // Free the property map of a class with children if it hasn't been used
+  // since the previous collection. It is rebuilt if it is needed again.
+  // Dictionaries own the only copy of their map, and the map of a leaf is
+  // likely to be handed to a new child soon.
+  if (self->propertyMap_ && !self->propertyMapUsed_ && !self->isDictionary() &&
+      !self->transitionMap_.isKnownEmpty()) {
+    LLVM_DEBUG(
+        dbgs() << "Class:" << self->getDebugAllocationId()
+               << " freeing unused map\n");
+    self->propertyMap_ = nullptr;
+  }
+  self->propertyMapUsed_ = false;
 }
 
 void HiddenClass::_finalizeImpl(GCCell *cell, GC *) {
@@ -75,11 +90,18 @@ CallResult<HermesValue> HiddenClass::create(
 Handle<HiddenClass> HiddenClass::convertToDictionary(
     Handle<HiddenClass> selfHandle,
     Runtime *runtime) {
-  assert(!selfHandle->isDictionary() && "class already in dictionary mode");
+  assert(
+      selfHandle->isCacheable() && "class already in dictionary mode");
 
   auto newFlags = selfHandle->flags_;
   newFlags.dictionaryMode = true;
 
+  // Get the property map before allocating: the caller may hold a position in
+  // it, and the GC may free the map of a class with children.
+  if (LLVM_UNLIKELY(!selfHandle->propertyMap_))
+    initializeMissingPropertyMap(selfHandle, runtime);
+  auto mapHandle = runtime->makeHandle(selfHandle->propertyMap_);
+
   /// Allocate a new class without a parent.
   auto newClassHandle = runtime->makeHandle<HiddenClass>(
       runtime->ignoreAllocationFailure(HiddenClass::create(
@@ -90,12 +112,8 @@ Handle<HiddenClass> HiddenClass::convertToDictionary(
           PropertyFlags{},
           selfHandle->numProperties_)));
 
-  // Optionally allocate the property map and move it to the new class.
-  if (LLVM_UNLIKELY(!selfHandle->propertyMap_))
-    initializeMissingPropertyMap(selfHandle, runtime);
-
-  newClassHandle->propertyMap_.set(
-      runtime, selfHandle->propertyMap_.get(runtime), &runtime->getHeap());
+  // Move the property map to the new class.
+  newClassHandle->propertyMap_.set(runtime, *mapHandle, &runtime->getHeap());
   selfHandle->propertyMap_ = nullptr;
 
   LLVM_DEBUG(
@@ -118,24 +136,21 @@ OptValue<HiddenClass::PropertyPos> HiddenClass::findProperty(
     // transition with name and the flags. The presence of such a transition
     // indicates that this is a new property and we don't have to build the map
     // in order to look for it (since we wouldn't find it anyway).
-    if (expectedFlags.isValid()) {
-      auto it = self->transitionMap_.find({name, expectedFlags});
-
-      if (it != self->transitionMap_.end()) {
-        LLVM_DEBUG(
-            dbgs() << "Property " << runtime->formatSymbolID(name)
-                   << " NOT FOUND in Class:" << self->getDebugAllocationId()
-                   << " due to existing transition to Class:"
-                   << it->second.get(runtime)->getDebugAllocationId() << "\n");
+    if (expectedFlags.isValid() &&
+        self->transitionMap_.containsKey({name, expectedFlags})) {
+      LLVM_DEBUG(
+          dbgs() << "Property " << runtime->formatSymbolID(name)
+                 << " NOT FOUND in Class:" << self->getDebugAllocationId()
+                 << " due to existing transition\n");
 
-        return llvm::None;
-      }
+      return llvm::None;
     }
 
     auto selfHandle = toHandle(runtime, std::move(self));
     initializeMissingPropertyMap(selfHandle, runtime);
     self = selfHandle;
   }
+  self->propertyMapUsed_ = true;
 
   auto found =
       DictPropertyMap::find(self->propertyMap_.getNonNull(runtime), name);
@@ -165,11 +180,23 @@ bool HiddenClass::debugIsPropertyDefined(
   return false;
 }
 
+Handle<HiddenClass> HiddenClass::makeCacheableDictionary(
+    Handle<HiddenClass> selfHandle,
+    Runtime *runtime) {
+  auto newHandle = selfHandle->isDictionary()
+      ? selfHandle
+      : convertToDictionary(selfHandle, runtime);
+  newHandle->flags_.cacheableDictionary = true;
+  return newHandle;
+}
+
 Handle<HiddenClass> HiddenClass::deleteProperty(
     Handle<HiddenClass> selfHandle,
     Runtime *runtime,
     PropertyPos pos) {
-  auto newHandle = LLVM_UNLIKELY(!selfHandle->flags_.dictionaryMode)
+  // Cached slots of a cacheable dictionary must not be reused by a later
+  // addition, so it is replaced as well.
+  auto newHandle = LLVM_UNLIKELY(selfHandle->isCacheable())
       ? convertToDictionary(selfHandle, runtime)
       : selfHandle;
 
@@ -197,6 +224,7 @@ CallResult<std::pair<Handle<HiddenClass>, SlotIndex>> HiddenClass::addProperty(
             runtime->getIdentifierTable().getStringView(runtime, name))) {
       selfHandle->flags_.hasIndexLikeProperties = true;
     }
+    selfHandle->noteWellKnownSymbol(name);
 
     // Allocate a new slot.
     // TODO: this changes the property map, so if we want to support OOM
@@ -269,6 +297,7 @@ CallResult<std::pair<Handle<HiddenClass>, SlotIndex>> HiddenClass::addProperty(
             runtime->getIdentifierTable().getStringView(runtime, name))) {
       childHandle->flags_.hasIndexLikeProperties = true;
     }
+    childHandle->noteWellKnownSymbol(name);
 
     // Add the property to the child.
     if (LLVM_UNLIKELY(
@@ -302,10 +331,19 @@ CallResult<std::pair<Handle<HiddenClass>, SlotIndex>> HiddenClass::addProperty(
       inserted &&
       "transition already exists when adding a new property to hidden class");
 
+  // Record the size of the new class in its ancestors.
+  const auto childSize = childHandle->maxDescendantProperties_;
+  for (HiddenClass *cur = *selfHandle;
+       cur && cur->maxDescendantProperties_ < childSize;
+       cur = cur->parent_.get(runtime)) {
+    cur->maxDescendantProperties_ = childSize;
+  }
+
   if (toArrayIndex(
           runtime->getIdentifierTable().getStringView(runtime, name))) {
     childHandle->flags_.hasIndexLikeProperties = true;
   }
+  childHandle->noteWellKnownSymbol(name);
 
   if (selfHandle->propertyMap_) {
     assert(
@@ -351,19 +389,30 @@ Handle<HiddenClass> HiddenClass::updateProperty(
     PropertyFlags newFlags) {
   assert(newFlags.isValid() && "newFlags must be valid");
 
-  // In dictionary mode we simply update our map (which must exist).
+  // In dictionary mode we simply update our map (which must exist), after
+  // moving it to a new class if the dictionary is cacheable.
   if (LLVM_UNLIKELY(selfHandle->flags_.dictionaryMode)) {
     assert(
         selfHandle->propertyMap_ &&
         "propertyMap must exist in dictionary mode");
+    auto *descPair = DictPropertyMap::getDescriptorPair(
+        selfHandle->propertyMap_.get(runtime), pos);
+    if (descPair->second.flags == newFlags)
+      return selfHandle;
+    if (!selfHandle->flags_.cacheableDictionary) {
+      descPair->second.flags = newFlags;
+      return selfHandle;
+    }
+    auto newHandle = convertToDictionary(selfHandle, runtime);
     DictPropertyMap::getDescriptorPair(
-        selfHandle->propertyMap_.get(runtime), pos)
+        newHandle->propertyMap_.get(runtime), pos)
         ->second.flags = newFlags;
-    return selfHandle;
+    return newHandle;
   }
 
   assert(
       selfHandle->propertyMap_ && "propertyMap must exist in updateProperty()");
+  selfHandle->propertyMapUsed_ = true;
 
   auto *descPair = DictPropertyMap::getDescriptorPair(
       selfHandle->propertyMap_.get(runtime), pos);
@@ -408,8 +457,9 @@ Handle<HiddenClass> HiddenClass::updateProperty(
   }
 
   // We are updating the existing property and adding a transition to a new
-  // hidden class.
+  // hidden class. Keep the map alive across the allocation of the child.
   descPair->second.flags = newFlags;
+  auto mapHandle = runtime->makeHandle(selfHandle->propertyMap_);
 
   // Allocate the child.
   auto childHandle = runtime->makeHandle<HiddenClass>(
@@ -440,8 +490,7 @@ Handle<HiddenClass> HiddenClass::updateProperty(
              << childHandle->getDebugAllocationId() << "\n");
 
   // Move the updated map to the child class.
-  childHandle->propertyMap_.set(
-      runtime, selfHandle->propertyMap_.get(runtime), &runtime->getHeap());
+  childHandle->propertyMap_.set(runtime, *mapHandle, &runtime->getHeap());
   selfHandle->propertyMap_ = nullptr;
 
   return childHandle;
@@ -554,11 +603,11 @@ Handle<HiddenClass> HiddenClass::updatePropertyFlagsWithoutTransitions(
     initializeMissingPropertyMap(selfHandle, runtime);
 
   MutableHandle<HiddenClass> classHandle{runtime};
-  if (selfHandle->isDictionary()) {
+  if (!selfHandle->isCacheable()) {
     classHandle = *selfHandle;
   } else {
     // To create an orphan hidden class with updated properties, first clone the
-    // old one, and make it a root.
+    // old one, and make it a root. A cacheable dictionary stays one.
     classHandle = vmcast<HiddenClass>(
         runtime->ignoreAllocationFailure(HiddenClass::create(
             runtime,
@@ -719,6 +768,7 @@ void HiddenClass::initializeMissingPropertyMap(
   }
 
   selfHandle->propertyMap_.set(runtime, *mapHandle, &runtime->getHeap());
+  selfHandle->propertyMapUsed_ = true;
 }
 
 void HiddenClass::stealPropertyMapFromParent(
@@ -741,6 +791,7 @@ void HiddenClass::stealPropertyMapFromParent(
       self->parent_.get(runtime)->propertyMap_.get(runtime),
       &runtime->getHeap());
   self->parent_.get(runtime)->propertyMap_ = nullptr;
+  self->propertyMapUsed_ = true;
 
   // Does our class add a new property?
   if (LLVM_LIKELY(!self->propertyFlags_.flagsTransition)) {
@@ -773,5 +824,132 @@ void HiddenClass::stealPropertyMapFromParent(
   }
 }
 
+struct HiddenClass::TransitionMap::LargeTable
+    : public llvm::DenseMap<Transition, WeakRefSlot *> {
+  using DenseMap::DenseMap;
+};
+
+HiddenClass::TransitionMap::TransitionMap() = default;
+HiddenClass::TransitionMap::~TransitionMap() = default;
+
+bool HiddenClass::TransitionMap::insertNew(
+    GC *gc,
+    const Transition &key,
+    Handle<HiddenClass> value) {
+  if (findSlot(key))
+    return false;
+  WeakRefSlot *slot = WeakRef<HiddenClass>(gc, value).unsafeGetSlot();
+
+  if (LLVM_LIKELY(isKnownEmpty())) {
+    singleKey_ = key;
+    singleSlot_ = slot;
+    return true;
+  }
+
+  // Move the single transition to a small table.
+  if (singleSlot_) {
+    small_.reset(new SmallTable());
+    small_->entries[small_->size++] = {singleKey_, singleSlot_};
+    singleSlot_ = nullptr;
+  }
+
+  if (small_) {
+    if (small_->size == kMaxSmallSize)
+      pruneSmall(nullptr);
+    if (small_->size < kMaxSmallSize) {
+      small_->entries[small_->size++] = {key, slot};
+      return true;
+    }
+    // The small table is full: move its transitions to a hash table.
+    large_.reset(new LargeTable(2 * kMaxSmallSize));
+    for (const Entry &entry : small_->entries)
+      large_->try_emplace(entry.key, entry.slot);
+    small_.reset();
+  }
+
+  large_->try_emplace(key, slot);
+  return true;
+}
+
+void HiddenClass::TransitionMap::markWeakRefs(GC *gc) {
+  if (singleSlot_) {
+    if (WeakRef<HiddenClass>::isSlotValid(singleSlot_))
+      gc->markWeakRef(WeakRef<HiddenClass>(singleSlot_));
+    else
+      singleSlot_ = nullptr;
+  } else if (small_) {
+    pruneSmall(gc);
+    if (!small_->size)
+      small_.reset();
+  } else if (large_) {
+    for (auto it = large_->begin(), e = large_->end(); it != e; ++it) {
+      // NOTE: DenseMap's erase() operation doesn't invalidate any iterators.
+      if (WeakRef<HiddenClass>::isSlotValid(it->second))
+        gc->markWeakRef(WeakRef<HiddenClass>(it->second));
+      else
+        large_->erase(it);
+    }
+  }
+}
+
+size_t HiddenClass::TransitionMap::getMemorySize() const {
+  if (small_)
+    return sizeof(SmallTable);
+  if (large_)
+    return sizeof(LargeTable) + large_->getMemorySize();
+  return 0;
+}
+
+WeakRefSlot *HiddenClass::TransitionMap::findSlot(const Transition &key) {
+  if (singleSlot_) {
+    if (!(singleKey_ == key))
+      return nullptr;
+    if (LLVM_UNLIKELY(!WeakRef<HiddenClass>::isSlotValid(singleSlot_))) {
+      singleSlot_ = nullptr;
+      return nullptr;
+    }
+    return singleSlot_;
+  }
+
+  if (small_) {
+    for (unsigned i = 0, e = small_->size; i != e; ++i) {
+      if (!(small_->entries[i].key == key))
+        continue;
+      WeakRefSlot *slot = small_->entries[i].slot;
+      if (LLVM_UNLIKELY(!WeakRef<HiddenClass>::isSlotValid(slot))) {
+        small_->entries[i] = small_->entries[--small_->size];
+        return nullptr;
+      }
+      return slot;
+    }
+    return nullptr;
+  }
+
+  if (large_) {
+    auto it = large_->find(key);
+    if (it == large_->end())
+      return nullptr;
+    if (LLVM_UNLIKELY(!WeakRef<HiddenClass>::isSlotValid(it->second))) {
+      large_->erase(it);
+      return nullptr;
+    }
+    return it->second;
+  }
+
+  return nullptr;
+}
+
+void HiddenClass::TransitionMap::pruneSmall(GC *gc) {
+  unsigned size = 0;
+  for (unsigned i = 0, e = small_->size; i != e; ++i) {
+    if (!WeakRef<HiddenClass>::isSlotValid(small_->entries[i].slot))
+      continue;
+    if (gc)
+      gc->markWeakRef(WeakRef<HiddenClass>(small_->entries[i].slot));
+    small_->entries[size++] = small_->entries[i];
+  }
+  small_->size = size;
+}
+
 } // namespace vm
 } // namespace hermes
@@ -111,8 +111,12 @@ CallResult<HermesValue> HostObject::createWithoutPrototype(
   return HermesValue::encodeObjectValue(hostObj);
 }
 
-void HostObject::_finalizeImpl(GCCell *cell, GC *) {
+void HostObject::_finalizeImpl(GCCell *cell, GC *gc) {
   auto *self = vmcast<HostObject>(cell);
+  // The proxy's destructor is the embedder's, and may be slow: drop the
+  // reference after the collection.
+  gc->deferFinalization(
+      [proxy = std::move(self->proxy_)]() mutable { proxy.reset(); });
   // Destruct the object.
   self->~HostObject();
 }
@@ -10,9 +10,11 @@
     (!defined(__ANDROID__) || defined(ANDROID_LINUX_PERF_PATH))
 #include "llvm/Support/raw_ostream.h"
 
+#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
 #include <sys/ioctl.h>
 #include <unistd.h>
 
@@ -117,6 +119,72 @@ bool PerfEvents::endAndInsertStats(std::string &jsonStats) {
   return true;
 }
 
+const char *const ThreadPerfCounters::kNames[kNumCounters] = {
+    "cycles",
+    "instructions",
+    "cacheMisses",
+    "branchMisses",
+};
+
+ThreadPerfCounters::~ThreadPerfCounters() {
+  for (int fd : fds_) {
+    if (fd != -1)
+      close(fd);
+  }
+}
+
+bool ThreadPerfCounters::open(uint64_t tid) {
+  static const uint64_t configs[kNumCounters] = {
+      PERF_COUNT_HW_CPU_CYCLES,
+      PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_CACHE_MISSES,
+      PERF_COUNT_HW_BRANCH_MISSES,
+  };
+  assert(fds_[0] == -1 && "Counters are already open");
+  for (unsigned i = 0; i < kNumCounters; ++i) {
+    perf_event_attr pe;
+    memset(&pe, 0, sizeof(perf_event_attr));
+    pe.type = PERF_TYPE_HARDWARE;
+    pe.size = sizeof(perf_event_attr);
+    pe.config = configs[i];
+    // Only the leader is enabled, which starts the whole group.
+    pe.disabled = i == 0;
+    pe.exclude_kernel = 1;
+    pe.exclude_hv = 1;
+    pe.read_format = PERF_FORMAT_GROUP;
+    fds_[i] = syscall(
+        __NR_perf_event_open,
+        &pe,
+        static_cast<pid_t>(tid),
+        -1, /* any CPU */
+        fds_[0], /* group leader, or none for the leader itself */
+        0 /* flags */);
+    if (fds_[i] == -1) {
+      for (unsigned j = 0; j < i; ++j) {
+        close(fds_[j]);
+        fds_[j] = -1;
+      }
+      return false;
+    }
+  }
+  ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  return true;
+}
+
+bool ThreadPerfCounters::read(Values &values) const {
+  if (fds_[0] == -1)
+    return false;
+  // With PERF_FORMAT_GROUP, the leader reads the number of counters followed
+  // by their values.
+  uint64_t buf[1 + kNumCounters];
+  if (::read(fds_[0], buf, sizeof(buf)) != sizeof(buf) ||
+      buf[0] != kNumCounters)
+    return false;
+  std::copy(buf + 1, buf + 1 + kNumCounters, values.begin());
+  return true;
+}
+
 } // namespace instrumentation
 } // namespace vm
 } // namespace hermes
@@ -137,6 +205,23 @@ bool PerfEvents::endAndInsertStats(std::string &jsonStats) {
   return false;
 }
 
+const char *const ThreadPerfCounters::kNames[kNumCounters] = {
+    "cycles",
+    "instructions",
+    "cacheMisses",
+    "branchMisses",
+};
+
+ThreadPerfCounters::~ThreadPerfCounters() {}
+
+bool ThreadPerfCounters::open(uint64_t tid) {
+  return false;
+}
+
+bool ThreadPerfCounters::read(Values &values) const {
+  return false;
+}
+
 } // namespace instrumentation
 } // namespace vm
 } // namespace hermes
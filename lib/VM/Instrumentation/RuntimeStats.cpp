@@ -6,6 +6,7 @@
  */
 #include "hermes/VM/instrumentation/RuntimeStats.h"
 
+#include "hermes/Support/JSONEmitter.h"
 #include "hermes/Support/OSCompat.h"
 
 namespace hermes {
@@ -18,6 +19,29 @@ void RuntimeStats::flushPendingTimers() {
   }
 }
 
+void RuntimeStats::printStartupStats(llvm::raw_ostream &os) const {
+  JSONEmitter json(os);
+  auto emitPhase = [&json](const char *name, const Statistic &stat) {
+    json.emitKey(name);
+    json.openDict();
+    json.emitKeyValue("wallTime", stat.wallDuration);
+    json.emitKeyValue("cpuTime", stat.cpuDuration);
+    json.emitKeyValue("minorFaults", stat.sampled.threadMinorFaults);
+    json.emitKeyValue("majorFaults", stat.sampled.threadMajorFaults);
+    json.emitKeyValue("count", stat.count);
+    json.closeDict();
+  };
+  json.openDict();
+  emitPhase("runtimeCreation", startup.runtimeCreation);
+  emitPhase("predefinedStrings", startup.predefinedStrings);
+  emitPhase("jslibInit", startup.jslibInit);
+  emitPhase("bytecodeMapping", startup.bytecodeMapping);
+  emitPhase("stringTableRegistration", startup.stringTableRegistration);
+  emitPhase("globalFunction", startup.globalFunction);
+  emitPhase("firstGC", startup.firstGC);
+  json.closeDict();
+}
+
 RuntimeStats::Sampled RAIITimer::trySampling() const {
   if (!runtimeStats_.shouldSample)
     return {};
@@ -75,6 +99,44 @@ RAIITimer::~RAIITimer() {
   runtimeStats_.timerStack = parent_;
 }
 
+StartupTimer::StartupTimer(RuntimeStats::Statistic *stat)
+    : stat_(stat),
+      wallTimeStart_(std::chrono::steady_clock::now()),
+      cpuTimeStart_(oscompat::thread_cpu_time()) {
+  if (!oscompat::thread_page_fault_count(
+          &sampledStart_.threadMinorFaults, &sampledStart_.threadMajorFaults))
+    sampledStart_ = {};
+}
+
+void StartupTimer::stop(RuntimeStats::Statistic &stat) {
+  assert(!stopped_ && "StartupTimer stopped twice");
+  stopped_ = true;
+  auto currentCPUTime = oscompat::thread_cpu_time();
+  auto currentWallTime = std::chrono::steady_clock::now();
+  RuntimeStats::Sampled currentSampled{};
+  // Only count the faults when both samples succeeded.
+  if (oscompat::thread_page_fault_count(
+          &currentSampled.threadMinorFaults,
+          &currentSampled.threadMajorFaults) &&
+      (sampledStart_.threadMinorFaults || sampledStart_.threadMajorFaults)) {
+    stat.sampled.threadMinorFaults +=
+        currentSampled.threadMinorFaults - sampledStart_.threadMinorFaults;
+    stat.sampled.threadMajorFaults +=
+        currentSampled.threadMajorFaults - sampledStart_.threadMajorFaults;
+  }
+  stat.wallDuration +=
+      std::chrono::duration<double>(currentWallTime - wallTimeStart_).count();
+  stat.cpuDuration +=
+      std::chrono::duration<double>(currentCPUTime - cpuTimeStart_).count();
+  stat.count += 1;
+}
+
+StartupTimer::~StartupTimer() {
+  if (stat_ && !stopped_)
+    stop(*stat_);
+  assert(stopped_ && "StartupTimer without a statistic was never stopped");
+}
+
 } // namespace instrumentation
 } // namespace vm
 } // namespace hermes
@@ -8,6 +8,7 @@
 #include "hermes/VM/Interpreter.h"
 #include "hermes/VM/Runtime.h"
 
+#include "hermes/Inst/Builtins.h"
 #include "hermes/Inst/InstDecode.h"
 #include "hermes/Support/Conversions.h"
 #include "hermes/Support/SlowAssert.h"
@@ -18,8 +19,11 @@
 #include "hermes/VM/JSArray.h"
 #include "hermes/VM/JSError.h"
 #include "hermes/VM/JSGenerator.h"
+#include "hermes/VM/JSLib.h"
+#include "hermes/VM/JSMapImpl.h"
 #include "hermes/VM/JSRegExp.h"
 #include "hermes/VM/Operations.h"
+#include "hermes/VM/PrimitiveBox.h"
 #include "hermes/VM/Profiler.h"
 #include "hermes/VM/Runtime-inline.h"
 #include "hermes/VM/RuntimeModule-inline.h"
@@ -46,8 +50,14 @@ HERMES_SLOW_STATISTIC(
     NumGetByIdProtoHits,
     "NumGetByIdProtoHits: Number of property 'read by id' cache hits for the prototype");
 HERMES_SLOW_STATISTIC(
-    NumGetByIdCacheEvicts,
-    "NumGetByIdCacheEvicts: Number of property 'read by id' cache evictions");
+    NumGetByIdProtoChainHits,
+    "NumGetByIdProtoChainHits: Number of property 'read by id' prototype-chain cache hits");
+HERMES_SLOW_STATISTIC(
+    NumGetByIdMegamorphicHits,
+    "NumGetByIdMegamorphicHits: Number of property 'read by id' hits in the shared megamorphic cache");
+HERMES_SLOW_STATISTIC(
+    NumGetByIdCacheMegamorphic,
+    "NumGetByIdCacheMegamorphic: Number of property 'read by id' cache sites becoming megamorphic");
 HERMES_SLOW_STATISTIC(
     NumGetByIdFastPaths,
     "NumGetByIdFastPaths: Number of property 'read by id' fast paths");
@@ -71,8 +81,11 @@ HERMES_SLOW_STATISTIC(
     NumPutByIdCacheHits,
     "NumPutByIdCacheHits: Number of property 'write by id' cache hits");
 HERMES_SLOW_STATISTIC(
-    NumPutByIdCacheEvicts,
-    "NumPutByIdCacheEvicts: Number of property 'write by id' cache evictions");
+    NumPutByIdMegamorphicHits,
+    "NumPutByIdMegamorphicHits: Number of property 'write by id' hits in the shared megamorphic cache");
+HERMES_SLOW_STATISTIC(
+    NumPutByIdCacheMegamorphic,
+    "NumPutByIdCacheMegamorphic: Number of property 'write by id' cache sites becoming megamorphic");
 HERMES_SLOW_STATISTIC(
     NumPutByIdFastPaths,
     "NumPutByIdFastPaths: Number of property 'write by id' fast paths");
@@ -80,6 +93,10 @@ HERMES_SLOW_STATISTIC(
     NumPutByIdTransient,
     "NumPutByIdTransient: Number of property 'write by id' to non-objects");
 
+HERMES_SLOW_STATISTIC(
+    NumInstanceOfCacheHits,
+    "NumInstanceOfCacheHits: Number of 'instanceof' prototype slot cache hits");
+
 HERMES_SLOW_STATISTIC(
     NumNativeFunctionCalls,
     "NumNativeFunctionCalls: Number of native function calls");
@@ -117,19 +134,39 @@ static const WrapperFunc interpWrappers[] = {PROFILER_SYMBOLS(LIST_ITEM)};
   do {                                                      \
     strictMode = (codeBlock)->isStrictMode();               \
     defaultPropOpFlags = DEFAULT_PROP_OP_FLAGS(strictMode); \
+    INIT_THREADED_CODE(codeBlock);                          \
   } while (0)
 
+#ifdef HERMESVM_INDIRECT_THREADING
+/// In ThreadedDispatch mode, point threadedBias at the threaded code of
+/// \p codeBlock, biased so that the handler of the instruction at address ip
+/// is at address threadedBias + ip * sizeof(void *). The arithmetic is done on
+/// integers since the intermediate values are not valid pointers.
+#define INIT_THREADED_CODE(codeBlock)                                        \
+  do {                                                                       \
+    if (ThreadedDispatch)                                                    \
+      threadedBias =                                                         \
+          (uintptr_t)(codeBlock)->getThreadedCode(runtime, opcodeDispatch) - \
+          (uintptr_t)(codeBlock)->begin() * sizeof(void *);                  \
+  } while (0)
+#else
+#define INIT_THREADED_CODE(codeBlock) (void)0
+#endif
+
 CallResult<HermesValue> Interpreter::createGeneratorClosure(
     Runtime *runtime,
     RuntimeModule *runtimeModule,
     unsigned funcIndex,
     Handle<Environment> envHandle) {
+  CodeBlock *codeBlock = runtimeModule->getCodeBlockMayAllocate(funcIndex);
+  if (LLVM_UNLIKELY(!codeBlock))
+    return runtimeModule->raiseMalformedFunction(funcIndex);
   return JSGeneratorFunction::create(
       runtime,
       runtimeModule->getDomain(runtime),
       Handle<JSObject>::vmcast(&runtime->generatorFunctionPrototype),
       envHandle,
-      runtimeModule->getCodeBlockMayAllocate(funcIndex));
+      codeBlock);
 }
 
 CallResult<HermesValue> Interpreter::createGenerator_RJS(
@@ -138,12 +175,15 @@ CallResult<HermesValue> Interpreter::createGenerator_RJS(
     unsigned funcIndex,
     Handle<Environment> envHandle,
     NativeArgs args) {
+  CodeBlock *codeBlock = runtimeModule->getCodeBlockMayAllocate(funcIndex);
+  if (LLVM_UNLIKELY(!codeBlock))
+    return runtimeModule->raiseMalformedFunction(funcIndex);
   auto gifRes = GeneratorInnerFunction::create(
       runtime,
       runtimeModule->getDomain(runtime),
       Handle<JSObject>::vmcast(&runtime->functionPrototype),
       envHandle,
-      runtimeModule->getCodeBlockMayAllocate(funcIndex),
+      codeBlock,
       args);
   if (LLVM_UNLIKELY(gifRes == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
@@ -269,6 +309,243 @@ CallResult<HermesValue> Interpreter::getArgumentsPropByValSlowPath_RJS(
       runtime, lazyReg, valueReg, curFunction, strictMode);
 }
 
+CallResult<HermesValue> Interpreter::callApplyArguments_RJS(
+    Runtime *runtime,
+    PinnedHermesValue *lazyReg,
+    Handle<> callee,
+    Handle<> thisVal,
+    Handle<> thisArg,
+    bool strictMode) {
+  auto frame = runtime->getCurrentFrame();
+  if (lazyReg->isUndefined() &&
+      callee->getRaw() == runtime->functionPrototypeApply.getRaw() &&
+      vmisa<Callable>(*thisVal)) {
+    // This is what apply() would do with a reified arguments object.
+    uint32_t argCount = frame.getArgCount();
+    ScopedNativeCallFrame newFrame{runtime,
+                                   argCount,
+                                   *thisVal,
+                                   HermesValue::encodeUndefinedValue(),
+                                   *thisArg};
+    if (LLVM_UNLIKELY(newFrame.overflowed()))
+      return runtime->raiseStackOverflow(
+          Runtime::StackOverflowKind::NativeStack);
+    for (uint32_t argIndex = 0; argIndex < argCount; ++argIndex)
+      newFrame->getArgRef(argIndex) = frame.getArgRef(argIndex);
+    return Callable::call(Handle<Callable>::vmcast(thisVal), runtime);
+  }
+
+  if (lazyReg->isUndefined()) {
+    auto argRes = reifyArgumentsSlowPath(
+        runtime, frame.getCalleeClosureHandleUnsafe(), strictMode);
+    if (LLVM_UNLIKELY(argRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    *lazyReg = *argRes;
+  }
+  auto function = Handle<Callable>::dyn_vmcast(runtime, callee);
+  if (LLVM_UNLIKELY(!function)) {
+    return runtime->raiseTypeErrorForValue(callee, " is not a function");
+  }
+  return Callable::executeCall2(function, runtime, thisVal, *thisArg, *lazyReg);
+}
+
+/// \return true if for-of loops can iterate \p array by index, which is the
+///   case when its @@iterator is the built-in Array.prototype.values and the
+///   next() method of array iterators is the built-in one. Accessors are not
+///   called, since the generic path would call them again.
+static bool hasBuiltinArrayIterator(Runtime *runtime, Handle<JSArray> array) {
+  NamedPropertyDescriptor desc;
+  JSObject *owner = JSObject::getNamedDescriptor(
+      array,
+      runtime,
+      Predefined::getSymbolID(Predefined::SymbolIterator),
+      desc);
+  if (!owner || desc.flags.accessor || desc.flags.hostObject ||
+      JSObject::getNamedSlotValue(owner, runtime, desc).getRaw() !=
+          runtime->arrayPrototypeValues.getRaw()) {
+    return false;
+  }
+  owner = JSObject::getNamedDescriptor(
+      Handle<JSObject>::vmcast(&runtime->arrayIteratorPrototype),
+      runtime,
+      Predefined::getSymbolID(Predefined::next),
+      desc);
+  return owner && !desc.flags.accessor && !desc.flags.hostObject &&
+      JSObject::getNamedSlotValue(owner, runtime, desc).getRaw() ==
+      runtime->arrayIteratorPrototypeNext.getRaw();
+}
+
+CallResult<HermesValue> Interpreter::iteratorBegin_RJS(
+    Runtime *runtime,
+    PinnedHermesValue *sourceOrNext) {
+  Handle<> source{sourceOrNext};
+  if (auto array = Handle<JSArray>::dyn_vmcast(runtime, source)) {
+    if (LLVM_LIKELY(hasBuiltinArrayIterator(runtime, array))) {
+      return HermesValue::encodeNumberValue(0);
+    }
+  }
+
+  auto iteratorSym = Predefined::getSymbolID(Predefined::SymbolIterator);
+  auto methodRes = source->isObject()
+      ? JSObject::getNamed_RJS(
+            Handle<JSObject>::vmcast(source), runtime, iteratorSym)
+      : getByIdTransient_RJS(runtime, source, iteratorSym);
+  if (LLVM_UNLIKELY(methodRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  auto method = runtime->makeHandle(*methodRes);
+  if (LLVM_UNLIKELY(!vmisa<Callable>(*method))) {
+    return runtime->raiseTypeErrorForValue(method, " is not a function");
+  }
+  auto iteratorRes =
+      Callable::executeCall0(Handle<Callable>::vmcast(method), runtime, source);
+  if (LLVM_UNLIKELY(iteratorRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (LLVM_UNLIKELY(!iteratorRes->isObject())) {
+    return runtime->raiseTypeError("iterator is not an object");
+  }
+  auto iterator = runtime->makeHandle<JSObject>(*iteratorRes);
+  auto nextRes = JSObject::getNamed_RJS(
+      iterator, runtime, Predefined::getSymbolID(Predefined::next));
+  if (LLVM_UNLIKELY(nextRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  *sourceOrNext = *nextRes;
+  return iterator.getHermesValue();
+}
+
+CallResult<HermesValue> Interpreter::iteratorNext_RJS(
+    Runtime *runtime,
+    PinnedHermesValue *iterator,
+    Handle<> sourceOrNext) {
+  if (iterator->isNumber()) {
+    // Do what the built-in array iterator would do.
+    auto array = Handle<JSArray>::vmcast(sourceOrNext);
+    uint32_t index = iterator->getNumber();
+    if (index >= JSArray::getLength(array.get())) {
+      *iterator = HermesValue::encodeUndefinedValue();
+      return HermesValue::encodeUndefinedValue();
+    }
+    *iterator = HermesValue::encodeNumberValue(index + 1);
+    if (LLVM_LIKELY(JSArray::isPacked(array.get()))) {
+      return array->at(runtime, index);
+    }
+    return JSObject::getComputed_RJS(
+        array,
+        runtime,
+        runtime->makeHandle(HermesValue::encodeNumberValue(index)));
+  }
+  if (!iterator->isObject()) {
+    // The iteration is already done.
+    return HermesValue::encodeUndefinedValue();
+  }
+
+  // Built-in iterators are advanced without creating the result object.
+  CallResult<HermesValue> valueRes{ExecutionStatus::EXCEPTION};
+  HermesValue next = *sourceOrNext;
+  if (next.getRaw() == runtime->arrayIteratorPrototypeNext.getRaw() &&
+      vmisa<JSArrayIterator>(*iterator)) {
+    valueRes = JSArrayIterator::nextValue(
+        Handle<JSArrayIterator>::vmcast(iterator), runtime);
+  } else if (
+      next.getRaw() == runtime->stringIteratorPrototypeNext.getRaw() &&
+      vmisa<JSStringIterator>(*iterator)) {
+    valueRes = JSStringIterator::nextValue(
+        Handle<JSStringIterator>::vmcast(iterator), runtime);
+  } else if (
+      next.getRaw() == runtime->mapIteratorPrototypeNext.getRaw() &&
+      vmisa<JSMapIterator>(*iterator) &&
+      vmcast<JSMapIterator>(*iterator)->isInitialized()) {
+    valueRes = JSMapIterator::nextValue(
+        Handle<JSMapIterator>::vmcast(iterator), runtime);
+  } else if (
+      next.getRaw() == runtime->setIteratorPrototypeNext.getRaw() &&
+      vmisa<JSSetIterator>(*iterator) &&
+      vmcast<JSSetIterator>(*iterator)->isInitialized()) {
+    valueRes = JSSetIterator::nextValue(
+        Handle<JSSetIterator>::vmcast(iterator), runtime);
+  } else {
+    if (LLVM_UNLIKELY(!vmisa<Callable>(next))) {
+      return runtime->raiseTypeErrorForValue(
+          sourceOrNext, " is not a function");
+    }
+    auto resultRes = Callable::executeCall0(
+        Handle<Callable>::vmcast(sourceOrNext), runtime, Handle<>(iterator));
+    if (LLVM_UNLIKELY(resultRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    if (LLVM_UNLIKELY(!resultRes->isObject())) {
+      return runtime->raiseTypeError(
+          "iterator.next() did not return an object");
+    }
+    auto result = runtime->makeHandle<JSObject>(*resultRes);
+    auto doneRes = JSObject::getNamed_RJS(
+        result, runtime, Predefined::getSymbolID(Predefined::done));
+    if (LLVM_UNLIKELY(doneRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    if (toBoolean(*doneRes)) {
+      valueRes = HermesValue::encodeEmptyValue();
+    } else {
+      valueRes = JSObject::getNamed_RJS(
+          result, runtime, Predefined::getSymbolID(Predefined::value));
+    }
+  }
+  if (LLVM_UNLIKELY(valueRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (valueRes->isEmpty()) {
+    *iterator = HermesValue::encodeUndefinedValue();
+    return HermesValue::encodeUndefinedValue();
+  }
+  return *valueRes;
+}
+
+ExecutionStatus Interpreter::iteratorClose_RJS(
+    Runtime *runtime,
+    Handle<> iterator,
+    bool ignoreInnerException) {
+  // Arrays iterated by index have no iterator object to close.
+  if (!iterator->isObject()) {
+    return ExecutionStatus::RETURNED;
+  }
+  CallResult<HermesValue> innerRes{ExecutionStatus::EXCEPTION};
+  auto returnRes = getMethod(
+      runtime,
+      iterator,
+      runtime->makeHandle(Predefined::getSymbolID(Predefined::returnStr)));
+  if (LLVM_LIKELY(returnRes != ExecutionStatus::EXCEPTION)) {
+    if (!vmisa<Callable>(returnRes->get())) {
+      return ExecutionStatus::RETURNED;
+    }
+    innerRes = Callable::executeCall0(
+        runtime->makeHandle(vmcast<Callable>(returnRes->get())),
+        runtime,
+        iterator);
+  }
+  if (ignoreInnerException) {
+    // The exception which exited the loop is rethrown instead, unless this
+    // one can't be caught.
+    if (innerRes == ExecutionStatus::EXCEPTION) {
+      if (isUncatchableError(runtime->getThrownValue())) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      runtime->clearThrownValue();
+    }
+    return ExecutionStatus::RETURNED;
+  }
+  if (LLVM_UNLIKELY(innerRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (LLVM_UNLIKELY(!innerRes->isObject())) {
+    return runtime->raiseTypeError(
+        "iterator.close() did not return an object");
+  }
+  return ExecutionStatus::RETURNED;
+}
+
 ExecutionStatus Interpreter::handleGetPNameList(
     Runtime *runtime,
     PinnedHermesValue *frameRegs,
@@ -327,6 +604,59 @@ inline OptValue<HermesValue> Interpreter::tryGetPrimitiveOwnPropertyById(
   return llvm::None;
 }
 
+OptValue<HermesValue> Interpreter::tryCallBuiltinInline(
+    unsigned builtinMethodID,
+    NativeArgs args) {
+  // The static builtins can't be overwritten, so this only has to agree with
+  // the native implementations for the argument types it accepts.
+  const unsigned argCount = args.getArgCount();
+  switch (builtinMethodID) {
+#define MATH_FUNCTION_1ARG(name, func)                             \
+  case BuiltinMethod::Math_##name:                                 \
+    if (LLVM_LIKELY(argCount >= 1 && args.getArg(0).isNumber())) { \
+      double num = args.getArg(0).getNumber();                     \
+      return HermesValue::encodeDoubleValue(func(num));            \
+    }                                                              \
+    break;
+    MATH_FUNCTION_1ARG(abs, std::fabs)
+    MATH_FUNCTION_1ARG(ceil, std::ceil)
+    MATH_FUNCTION_1ARG(floor, std::floor)
+    MATH_FUNCTION_1ARG(sqrt, std::sqrt)
+#undef MATH_FUNCTION_1ARG
+
+    case BuiltinMethod::Math_max:
+    case BuiltinMethod::Math_min: {
+      const bool isMax = builtinMethodID == BuiltinMethod::Math_max;
+      double result = isMax ? -std::numeric_limits<double>::infinity()
+                            : std::numeric_limits<double>::infinity();
+      for (unsigned i = 0; i != argCount; ++i) {
+        HermesValue arg = args.getArg(i);
+        if (LLVM_UNLIKELY(!arg.isNumber()))
+          return llvm::None;
+        double num = arg.getNumber();
+        if (std::isnan(result)) {
+          continue;
+        } else if (std::isnan(num)) {
+          result = std::numeric_limits<double>::quiet_NaN();
+        } else if (
+            isMax
+                ? num > result || std::signbit(num) < std::signbit(result)
+                : num < result || std::signbit(num) > std::signbit(result)) {
+          result = num;
+        }
+      }
+      return HermesValue::encodeDoubleValue(result);
+    }
+
+    case BuiltinMethod::Array_isArray:
+      return HermesValue::encodeBoolValue(vmisa<JSArray>(args.getArg(0)));
+
+    default:
+      break;
+  }
+  return llvm::None;
+}
+
 CallResult<HermesValue> Interpreter::getByIdTransient_RJS(
     Runtime *runtime,
     Handle<> base,
@@ -532,24 +862,66 @@ ExecutionStatus Interpreter::putByValTransient_RJS(
   return putByIdTransient_RJS(runtime, base, **idRes, value, strictMode);
 }
 
+/// \return the values that \p iter decodes from a literal buffer, cached in
+/// \p runtimeModule with \p key from the second instantiation of the buffer
+/// on, so that later instantiations copy them instead of decoding them again.
+/// \return null if the buffer must be decoded by the caller: on its first
+/// instantiation, or if the values could not be allocated.
+static ArrayStorage *getLiteralValues(
+    Runtime *runtime,
+    RuntimeModule *runtimeModule,
+    uint64_t key,
+    SerializedLiteralParser iter,
+    unsigned numLiterals) {
+  bool shouldCache;
+  if (auto *values = runtimeModule->findCachedLiteralValues(key, shouldCache))
+    return values;
+  if (!shouldCache || numLiterals == 0)
+    return nullptr;
+
+  // The values live as long as the module.
+  auto arrRes = ArrayStorage::createLongLived(runtime, numLiterals);
+  if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION)) {
+    runtime->clearThrownValue();
+    return nullptr;
+  }
+  auto values = runtime->makeHandle<ArrayStorage>(*arrRes);
+  ArrayStorage::resizeWithinCapacity(
+      createPseudoHandle(values.get()), runtime, numLiterals);
+  for (unsigned i = 0; iter.hasNext(); ++i) {
+    // Decoding a string may allocate, so get the value before the storage.
+    auto value = iter.get(runtime);
+    values->at(i).set(value, &runtime->getHeap());
+  }
+  runtimeModule->cacheLiteralValues(key, values.get());
+  return values.get();
+}
+
 CallResult<HermesValue> Interpreter::createObjectFromBuffer(
     Runtime *runtime,
     CodeBlock *curCodeBlock,
     unsigned numLiterals,
     unsigned keyBufferIndex,
-    unsigned valBufferIndex) {
+    unsigned valBufferIndex,
+    AllocationSite *site) {
   // Fetch any cached hidden class first.
   auto *runtimeModule = curCodeBlock->getRuntimeModule();
   const llvm::Optional<Handle<HiddenClass>> optCachedHiddenClassHandle =
       runtimeModule->findCachedLiteralHiddenClass(keyBufferIndex, numLiterals);
   // Create a new object using the built-in constructor or cached hidden class.
   // Note that the built-in constructor is empty, so we don't actually need to
-  // call it.
-  auto obj = toHandle(
-      runtime,
-      optCachedHiddenClassHandle.hasValue()
-          ? JSObject::create(runtime, optCachedHiddenClassHandle.getValue())
-          : JSObject::create(runtime, numLiterals));
+  // call it.  If the objects of this instruction tend to survive young-gen
+  // collections, allocate it where it would end up anyway.
+  PseudoHandle<JSObject> newObj = site->isPretenured()
+      ? (optCachedHiddenClassHandle.hasValue()
+             ? JSObject::createLongLived(
+                   runtime, optCachedHiddenClassHandle.getValue())
+             : JSObject::createLongLived(runtime, numLiterals))
+      : (optCachedHiddenClassHandle.hasValue()
+             ? JSObject::create(runtime, optCachedHiddenClassHandle.getValue())
+             : JSObject::create(runtime, numLiterals));
+  runtime->getHeap().trackAllocationSite(newObj.get(), site);
+  auto obj = toHandle(runtime, std::move(newObj));
 
   MutableHandle<> tmpHandleKey(runtime);
   MutableHandle<> tmpHandleVal(runtime);
@@ -561,7 +933,24 @@ CallResult<HermesValue> Interpreter::createObjectFromBuffer(
   auto keyGen = genPair.first;
   auto valGen = genPair.second;
 
-  if (optCachedHiddenClassHandle.hasValue()) {
+  // Objects of a cached class have their values in the order of its slots, so
+  // the values can be copied from their decoded form.
+  ArrayStorage *values = optCachedHiddenClassHandle.hasValue()
+      ? getLiteralValues(
+            runtime,
+            runtimeModule,
+            RuntimeModule::getLiteralValuesKey(
+                false, valBufferIndex, numLiterals),
+            valGen,
+            numLiterals)
+      : nullptr;
+
+  if (values) {
+    for (uint32_t propIndex = 0; propIndex < numLiterals; ++propIndex) {
+      JSObject::setNamedSlotValue(
+          obj.get(), runtime, propIndex, values->at(propIndex));
+    }
+  } else if (optCachedHiddenClassHandle.hasValue()) {
     uint32_t propIndex = 0;
     // keyGen should always have the same amount of elements as valGen
     while (valGen.hasNext()) {
@@ -663,18 +1052,34 @@ CallResult<HermesValue> Interpreter::createArrayFromBuffer(
     CodeBlock *curCodeBlock,
     unsigned numElements,
     unsigned numLiterals,
-    unsigned bufferIndex) {
+    unsigned bufferIndex,
+    AllocationSite *site) {
   // Create a new array using the built-in constructor, and initialize
   // the elements from a literal array buffer.
-  auto arrRes = JSArray::create(runtime, numElements, numElements);
+  auto arrRes = site->isPretenured()
+      ? JSArray::createLongLived(runtime, numElements, numElements)
+      : JSArray::create(runtime, numElements, numElements);
   if (arrRes == ExecutionStatus::EXCEPTION) {
     return ExecutionStatus::EXCEPTION;
   }
+  runtime->getHeap().trackAllocationSite(arrRes->get(), site);
   // Resize the array storage in advance.
   auto arr = toHandle(runtime, std::move(*arrRes));
   JSArray::setStorageEndIndex(arr, runtime, numElements);
 
   auto iter = curCodeBlock->getArrayBufferIter(bufferIndex, numLiterals);
+  if (ArrayStorage *values = getLiteralValues(
+          runtime,
+          curCodeBlock->getRuntimeModule(),
+          RuntimeModule::getLiteralValuesKey(true, bufferIndex, numLiterals),
+          iter,
+          numLiterals)) {
+    for (JSArray::size_type i = 0; i < numLiterals; ++i) {
+      JSArray::unsafeSetExistingElementAt(*arr, runtime, i, values->at(i));
+    }
+    return HermesValue::encodeObjectValue(*arr);
+  }
+
   JSArray::size_type i = 0;
   while (iter.hasNext()) {
     // NOTE: we must get the value in a separate step to guarantee ordering.
@@ -817,10 +1222,21 @@ static inline const Inst *nextInstCall(const Inst *ip) {
 CallResult<HermesValue> Runtime::interpretFunctionImpl(
     CodeBlock *newCodeBlock) {
   InterpreterState state{newCodeBlock, 0};
+#ifdef HERMESVM_INDIRECT_THREADING
+  // Breakpoints patch the threaded code along with the bytecode, so builds
+  // with the debugger dispatch as fast as others until one is set.
+  if (getVMExperimentFlags() & experiments::ThreadedDispatch)
+    return Interpreter::interpretFunction<false, true>(this, state);
+#endif
   return Interpreter::interpretFunction<false>(this, state);
 }
 
 CallResult<HermesValue> Runtime::interpretFunction(CodeBlock *newCodeBlock) {
+  // Go back to charging the caller when the function returns.
+  ScopedTimeAttribution timeScope(
+      getTimeAttribution(),
+      newCodeBlock,
+      FunctionTimeAttribution::Category::Interpreter);
 #ifdef HERMESVM_PROFILER_EXTERN
   auto id = getProfilerID(newCodeBlock);
   if (id >= NUM_PROFILER_SYMBOLS) {
@@ -838,6 +1254,41 @@ ExecutionStatus Runtime::stepFunction(InterpreterState &state) {
 }
 #endif
 
+/// If the function profile attributes time, charge the time from now on to
+/// the interpreted code of \p codeBlock.
+static inline void attributeTimeTo(Runtime *runtime, CodeBlock *codeBlock) {
+  if (LLVM_UNLIKELY(runtime->getTimeAttribution() != nullptr)) {
+    runtime->getTimeAttribution()->switchTo(
+        {codeBlock, FunctionTimeAttribution::Category::Interpreter});
+  }
+}
+
+/// \return true if an exception thrown at \p ip in \p codeBlock is caught by
+/// a handler of that frame, or of its caller, whose frame is \p frame.
+static bool isCaughtInFrameOrCaller(
+    CodeBlock *codeBlock,
+    const Inst *ip,
+    StackFramePtr frame) {
+  if (codeBlock->hasExceptionHandlers() &&
+      codeBlock->findCatchTargetOffset(codeBlock->getOffsetOf(ip)) != -1)
+    return true;
+  CodeBlock *caller = frame.getSavedCodeBlock();
+  return caller && caller->hasExceptionHandlers() &&
+      caller->findCatchTargetOffset(
+          caller->getOffsetOf(frame.getSavedIP())) != -1;
+}
+
+/// \return the compiled body of \p codeBlock, compiling it if it is hot, or
+/// null if it is to be interpreted. Nothing runs compiled while code coverage
+/// is recorded, since compiled code doesn't record it.
+static inline JITCompiledFunctionPtr jitCompile(
+    Runtime *runtime,
+    CodeBlock *codeBlock) {
+  if (LLVM_UNLIKELY(runtime->isCodeCoverageEnabled()))
+    return nullptr;
+  return runtime->getJITContext().compile(runtime, codeBlock);
+}
+
 /// \return the quotient of x divided by y.
 static double doDiv(double x, double y)
     LLVM_NO_SANITIZE("float-divide-by-zero");
@@ -861,12 +1312,16 @@ static inline double doSub(double x, double y) {
   return x - y;
 }
 
-template <bool SingleStep>
+template <bool SingleStep, bool ThreadedDispatch>
 CallResult<HermesValue> Interpreter::interpretFunction(
     Runtime *runtime,
     InterpreterState &state) {
 #ifndef HERMES_ENABLE_DEBUGGER
   static_assert(!SingleStep, "can't use single-step mode without the debugger");
+#endif
+#ifndef HERMESVM_INDIRECT_THREADING
+  static_assert(
+      !ThreadedDispatch, "threaded dispatch requires indirect threading");
 #endif
   // Make sure that the cache can use an optimization by avoiding a branch to
   // access the property storage.
@@ -886,6 +1341,16 @@ CallResult<HermesValue> Interpreter::interpretFunction(
   // Default flags when accessing properties.
   PropOpFlags defaultPropOpFlags;
 
+#ifdef HERMESVM_INDIRECT_THREADING
+  static void *opcodeDispatch[] = {
+#define DEFINE_OPCODE(name) &&case_##name,
+#include "hermes/BCGen/HBC/BytecodeList.def"
+      &&case__last};
+  // The threaded code of the current function, biased by its bytecode, see
+  // INIT_THREADED_CODE.
+  uintptr_t threadedBias = 0;
+#endif
+
   LLVM_DEBUG(dbgs() << "interpretFunction() called\n");
 
   ScopedNativeDepthTracker depthTracker{runtime};
@@ -895,8 +1360,13 @@ CallResult<HermesValue> Interpreter::interpretFunction(
 
   if (!SingleStep) {
     curCodeBlock->lazyCompile(runtime);
-    if (auto jitPtr = runtime->jitContext_.compile(runtime, curCodeBlock))
+    if (auto jitPtr = jitCompile(runtime, curCodeBlock)) {
+      ScopedTimeAttribution timeScope(
+          runtime->getTimeAttribution(),
+          curCodeBlock,
+          FunctionTimeAttribution::Category::JIT);
       return (*jitPtr)(runtime);
+    }
   }
 
   GCScope gcScope(runtime);
@@ -914,6 +1384,23 @@ CallResult<HermesValue> Interpreter::interpretFunction(
 
   INIT_OPCODE_PROFILER;
 
+/// If code coverage is being recorded, record that execution reached \p dest,
+/// the first instruction of a basic block.
+#define RECORD_COVERAGE(dest)                               \
+  {                                                         \
+    if (LLVM_UNLIKELY(runtime->isCodeCoverageEnabled()))    \
+      curCodeBlock->markCovered(                            \
+          (const uint8_t *)(dest) - curCodeBlock->begin()); \
+  }
+
+/// Record that the slow path of the current instruction observed \p types.
+#define RECORD_FEEDBACK(types) \
+  curCodeBlock->recordTypeFeedback(runtime, CUROFFSET, (types))
+
+/// Record the types of the operands of the binary instruction \p name.
+#define RECORD_BINOP_FEEDBACK(name) \
+  RECORD_FEEDBACK(feedbackTypeOf(O2REG(name)) | feedbackTypeOf(O3REG(name)))
+
 #if !defined(HERMESVM_PROFILER_EXTERN)
 tailCall:
 #endif
@@ -926,6 +1413,12 @@ tailCall:
   // Update function executionCount_ count
   curCodeBlock->incrementExecutionCount();
 
+  // Feed the function profile.
+  curCodeBlock->incrementInvocationCount();
+  if (LLVM_UNLIKELY(runtime->testAndClearFunctionProfileTick()))
+    curCodeBlock->incrementProfileSamples();
+  attributeTimeTo(runtime, curCodeBlock);
+
   if (!SingleStep) {
     auto newFrame = runtime->setCurrentFrameToTopOfStack();
     runtime->saveCallerIPInStackFrame();
@@ -958,14 +1451,15 @@ tailCall:
     }
 #endif
 
-    // Allocate the registers for the new frame.
-    if (LLVM_UNLIKELY(!runtime->checkAndAllocStack(
+    // Allocate the registers for the new frame. The arguments are already in
+    // place: they are the outgoing registers at the top of the caller's frame.
+    if (LLVM_UNLIKELY(!runtime->allocFrameRegisters(
             curCodeBlock->getFrameSize() +
-                StackFrameLayout::CalleeExtraRegistersAtStart,
-            HermesValue::encodeUndefinedValue())))
+            StackFrameLayout::CalleeExtraRegistersAtStart)))
       goto stackOverflow;
 
     ip = (Inst const *)curCodeBlock->begin();
+    RECORD_COVERAGE(ip);
 
     // Check for invalid invocation.
     if (LLVM_UNLIKELY(curCodeBlock->getHeaderFlags().isCallProhibited(
@@ -1000,10 +1494,11 @@ tailCall:
   }
 
 #ifdef HERMESVM_INDIRECT_THREADING
-  static void *opcodeDispatch[] = {
-#define DEFINE_OPCODE(name) &&case_##name,
-#include "hermes/BCGen/HBC/BytecodeList.def"
-      &&case__last};
+/// The handler of the instruction at ip.
+#define DISPATCH_TARGET                                                  \
+  (ThreadedDispatch                                                      \
+       ? *(void *const *)(threadedBias + (uintptr_t)ip * sizeof(void *)) \
+       : opcodeDispatch[(unsigned)ip->opCode])
 
 #define CASE(name) case_##name:
 #define DISPATCH                                \
@@ -1013,7 +1508,7 @@ tailCall:
     state.offset = CUROFFSET;                   \
     return HermesValue::encodeUndefinedValue(); \
   }                                             \
-  goto *opcodeDispatch[(unsigned)ip->opCode]
+  goto *DISPATCH_TARGET
 
 #else // HERMESVM_INDIRECT_THREADING
 
@@ -1032,7 +1527,7 @@ tailCall:
     BEFORE_OP_CODE;
 
 #ifdef HERMESVM_INDIRECT_THREADING
-    goto *opcodeDispatch[(unsigned)ip->opCode];
+    goto *DISPATCH_TARGET;
 #else
     switch (ip->opCode)
 #endif
@@ -1081,6 +1576,7 @@ tailCall:
         DISPATCH;                                                        \
       }                                                                  \
     }                                                                    \
+    RECORD_BINOP_FEEDBACK(name);                                         \
     runtime->storeCallerIP(ip);                                          \
     res = toNumber_RJS(runtime, Handle<>(&O2REG(name)));                 \
     runtime->clearCallerIP();                                            \
@@ -1122,6 +1618,7 @@ tailCall:
       ip = NEXTINST(name);                                                \
       DISPATCH;                                                           \
     }                                                                     \
+    RECORD_BINOP_FEEDBACK(name);                                          \
     runtime->storeCallerIP(ip);                                           \
     res = lConv(runtime, Handle<>(&O2REG(name)));                         \
     runtime->clearCallerIP();                                             \
@@ -1158,6 +1655,7 @@ tailCall:
       ip = NEXTINST(name);                                                     \
       DISPATCH;                                                                \
     }                                                                          \
+    RECORD_BINOP_FEEDBACK(name);                                               \
     runtime->storeCallerIP(ip);                                                \
     res = toInt32_RJS(runtime, Handle<>(&O2REG(name)));                        \
     runtime->clearCallerIP();                                                  \
@@ -1178,8 +1676,10 @@ tailCall:
     DISPATCH;                                                                  \
   }
 
-/// Implement a comparison instruction.
-/// \param name the name of the instruction.
+/// Implement a comparison instruction with a fast path where both operands
+/// are numbers.
+/// \param name the name of the instruction. The fast path case will have a
+///     "N" appended to the name.
 /// \param oper the C++ operator to use to actually perform the fast arithmetic
 ///     comparison.
 /// \param operFuncName  function to call for the slow-path comparison.
@@ -1187,11 +1687,14 @@ tailCall:
   CASE(name) {                                                                 \
     if (LLVM_LIKELY(O2REG(name).isNumber() && O3REG(name).isNumber())) {       \
       /* Fast-path. */                                                         \
-      O1REG(name) = HermesValue::encodeBoolValue(                              \
-          O2REG(name).getNumber() oper O3REG(name).getNumber());               \
-      ip = NEXTINST(name);                                                     \
-      DISPATCH;                                                                \
+      CASE(name##N) {                                                          \
+        O1REG(name##N) = HermesValue::encodeBoolValue(                         \
+            O2REG(name##N).getNumber() oper O3REG(name##N).getNumber());       \
+        ip = NEXTINST(name##N);                                                \
+        DISPATCH;                                                              \
+      }                                                                        \
     }                                                                          \
+    RECORD_BINOP_FEEDBACK(name);                                               \
     runtime->storeCallerIP(ip);                                                \
     boolRes =                                                                  \
         operFuncName(runtime, Handle<>(&O2REG(name)), Handle<>(&O3REG(name))); \
@@ -1204,6 +1707,30 @@ tailCall:
     DISPATCH;                                                                  \
   }
 
+#ifdef HERMESVM_JIT
+/// Continue execution at \p dest. A jump to an earlier instruction is a loop
+/// back-edge, which goes through backEdge to feed the JIT.
+#define JUMP_TO(dest)                  \
+  {                                    \
+    nextIP = (dest);                   \
+    RECORD_COVERAGE(nextIP);           \
+    if (LLVM_UNLIKELY(nextIP <= ip)) { \
+      ip = nextIP;                     \
+      goto backEdge;                   \
+    }                                  \
+    ip = nextIP;                       \
+    DISPATCH;                          \
+  }
+#else
+/// Continue execution at \p dest.
+#define JUMP_TO(dest)    \
+  {                      \
+    ip = (dest);         \
+    RECORD_COVERAGE(ip); \
+    DISPATCH;            \
+  }
+#endif
+
 /// Implement a comparison conditional jump with a fast path where both
 /// operands are numbers.
 /// \param name the name of the instruction. The fast path case will have a
@@ -1224,13 +1751,12 @@ tailCall:
         if (O2REG(name##N##suffix)                                        \
                 .getNumber() oper O3REG(name##N##suffix)                  \
                 .getNumber()) {                                           \
-          ip = trueDest;                                                  \
-          DISPATCH;                                                       \
+          JUMP_TO(trueDest);                                              \
         }                                                                 \
-        ip = falseDest;                                                   \
-        DISPATCH;                                                         \
+        JUMP_TO(falseDest);                                               \
       }                                                                   \
     }                                                                     \
+    RECORD_BINOP_FEEDBACK(name##suffix);                                  \
     runtime->storeCallerIP(ip);                                           \
     boolRes = operFuncName(                                               \
         runtime,                                                          \
@@ -1241,11 +1767,9 @@ tailCall:
       goto exception;                                                     \
     gcScope.flushToSmallCount(KEEP_HANDLES);                              \
     if (boolRes.getValue()) {                                             \
-      ip = trueDest;                                                      \
-      DISPATCH;                                                           \
+      JUMP_TO(trueDest);                                                  \
     }                                                                     \
-    ip = falseDest;                                                       \
-    DISPATCH;                                                             \
+    JUMP_TO(falseDest);                                                   \
   }
 
 /// Implement a strict equality conditional jump
@@ -1256,11 +1780,9 @@ tailCall:
 #define JCOND_STRICT_EQ_IMPL(name, suffix, trueDest, falseDest)         \
   CASE(name##suffix) {                                                  \
     if (strictEqualityTest(O2REG(name##suffix), O3REG(name##suffix))) { \
-      ip = trueDest;                                                    \
-      DISPATCH;                                                         \
+      JUMP_TO(trueDest);                                                \
     }                                                                   \
-    ip = falseDest;                                                     \
-    DISPATCH;                                                           \
+    JUMP_TO(falseDest);                                                 \
   }
 
 /// Implement an equality conditional jump
@@ -1281,11 +1803,9 @@ tailCall:
     }                                                    \
     gcScope.flushToSmallCount(KEEP_HANDLES);             \
     if (res->getBool()) {                                \
-      ip = trueDest;                                     \
-      DISPATCH;                                          \
+      JUMP_TO(trueDest);                                 \
     }                                                    \
-    ip = falseDest;                                      \
-    DISPATCH;                                            \
+    JUMP_TO(falseDest);                                  \
   }
 
 /// Implement the long and short forms of a conditional jump, and its negation.
@@ -1295,14 +1815,14 @@ tailCall:
       ,                                 \
       oper,                             \
       operFuncName,                     \
-      IPADD(ip->iJ##name.op1),          \
+      IPADD(ip->iJ##name.op1),         \
       NEXTINST(J##name));               \
   JCOND_IMPL(                           \
       J##name,                          \
       Long,                             \
       oper,                             \
       operFuncName,                     \
-      IPADD(ip->iJ##name##Long.op1),    \
+      IPADD(ip->iJ##name##Long.op1),   \
       NEXTINST(J##name##Long));         \
   JCOND_IMPL(                           \
       JNot##name,                       \
@@ -1310,7 +1830,7 @@ tailCall:
       oper,                             \
       operFuncName,                     \
       NEXTINST(JNot##name),             \
-      IPADD(ip->iJNot##name.op1));      \
+      IPADD(ip->iJNot##name.op1));     \
   JCOND_IMPL(                           \
       JNot##name,                       \
       Long,                             \
@@ -1524,8 +2044,14 @@ tailCall:
         ip = nextIP;
         DISPATCH;
 #else
-        if (auto jitPtr = runtime->jitContext_.compile(runtime, calleeBlock)) {
-          res = (*jitPtr)(runtime);
+        if (auto jitPtr = jitCompile(runtime, calleeBlock)) {
+          {
+            ScopedTimeAttribution timeScope(
+                runtime->getTimeAttribution(),
+                calleeBlock,
+                FunctionTimeAttribution::Category::JIT);
+            res = (*jitPtr)(runtime);
+          }
           if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
             goto exception;
           O1REG(Call) = *res;
@@ -1540,6 +2066,19 @@ tailCall:
         goto tailCall;
 #endif
       }
+      RECORD_FEEDBACK(feedbackTypeOf(O2REG(Call)));
+      if (auto *native = dyn_vmcast<NativeFunction>(O2REG(Call))) {
+        NativeArgs nativeArgs = newFrame.getNativeArgs();
+        auto dataViewRes = tryDataViewAccessInline(runtime, native, nativeArgs);
+        auto inlined = dataViewRes
+            ? dataViewRes
+            : tryStringCharCodeAtInline(native, nativeArgs);
+        if (inlined) {
+          O1REG(Call) = *inlined;
+          ip = nextIP;
+          DISPATCH;
+        }
+      }
       res = Interpreter::handleCallSlowPath(runtime, &O2REG(Call));
       if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
         goto exception;
@@ -1571,11 +2110,17 @@ tailCall:
 #endif
         runtime->storeCallerIP(ip);
 
-        CodeBlock *calleeBlock = ip->opCode == OpCode::CallDirect
-            ? curCodeBlock->getRuntimeModule()->getCodeBlockMayAllocate(
-                  ip->iCallDirect.op3)
-            : curCodeBlock->getRuntimeModule()->getCodeBlockMayAllocate(
-                  ip->iCallDirectLongIndex.op3);
+        uint32_t calleeIndex = ip->opCode == OpCode::CallDirect
+            ? ip->iCallDirect.op3
+            : ip->iCallDirectLongIndex.op3;
+        CodeBlock *calleeBlock =
+            curCodeBlock->getRuntimeModule()->getCodeBlockMayAllocate(
+                calleeIndex);
+        if (LLVM_UNLIKELY(!calleeBlock)) {
+          curCodeBlock->getRuntimeModule()->raiseMalformedFunction(
+              calleeIndex);
+          goto exception;
+        }
 
         auto newFrame = StackFramePtr::initFrame(
             runtime->stackPointer_,
@@ -1603,8 +2148,14 @@ tailCall:
                                               : NEXTINST(CallDirectLongIndex);
         DISPATCH;
 #else
-        if (auto jitPtr = runtime->jitContext_.compile(runtime, calleeBlock)) {
-          res = (*jitPtr)(runtime);
+        if (auto jitPtr = jitCompile(runtime, calleeBlock)) {
+          {
+            ScopedTimeAttribution timeScope(
+                runtime->getTimeAttribution(),
+                calleeBlock,
+                FunctionTimeAttribution::Category::JIT);
+            res = (*jitPtr)(runtime);
+          }
           if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
             goto exception;
           O1REG(CallDirect) = *res;
@@ -1633,10 +2184,16 @@ tailCall:
             (uint32_t)ip->iCallBuiltin.op3 - 1,
             nf,
             false);
-        (void)newFrame;
 
         SLOW_DEBUG(dumpCallArguments(dbgs(), runtime, newFrame));
 
+        if (auto inlined = Interpreter::tryCallBuiltinInline(
+                ip->iCallBuiltin.op2, newFrame.getNativeArgs())) {
+          O1REG(CallBuiltin) = *inlined;
+          ip = NEXTINST(CallBuiltin);
+          DISPATCH;
+        }
+
         runtime->storeCallerIP(ip);
         res = NativeFunction::_nativeCall(nf, runtime);
         runtime->clearCallerIP();
@@ -1676,6 +2233,7 @@ tailCall:
       innerFn->setNextIP(nextIP);
       innerFn->setState(GeneratorInnerFunction::State::SuspendedYield);
       ip = NEXTINST(SaveGenerator);
+      RECORD_COVERAGE(ip);
       DISPATCH;
     }
 
@@ -1688,6 +2246,7 @@ tailCall:
         } else {
           nextIP = innerFn->getNextIP();
           innerFn->restoreStack(runtime);
+          RECORD_COVERAGE(nextIP);
         }
         innerFn->setState(GeneratorInnerFunction::State::Executing);
         ip = nextIP;
@@ -1747,6 +2306,12 @@ tailCall:
           return res;
         }
 
+        // Charge a pending function profile tick to the caller, so that the
+        // time spent between its calls is seen.
+        if (LLVM_UNLIKELY(runtime->testAndClearFunctionProfileTick()))
+          curCodeBlock->incrementProfileSamples();
+        attributeTimeTo(runtime, curCodeBlock);
+
 // Return because of recursive calling structure
 #if defined(HERMESVM_PROFILER_EXTERN)
         return res;
@@ -1897,12 +2462,17 @@ tailCall:
       }
     createClosure : {
       auto *runtimeModule = curCodeBlock->getRuntimeModule();
+      CodeBlock *calleeBlock = runtimeModule->getCodeBlockMayAllocate(idVal);
+      if (LLVM_UNLIKELY(!calleeBlock)) {
+        runtimeModule->raiseMalformedFunction(idVal);
+        goto exception;
+      }
       res = JSFunction::create(
           runtime,
           runtimeModule->getDomain(runtime),
           Handle<JSObject>::vmcast(&runtime->functionPrototype),
           Handle<Environment>::vmcast(&O2REG(CreateClosure)),
-          runtimeModule->getCodeBlockMayAllocate(idVal));
+          calleeBlock);
       if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
         goto exception;
       }
@@ -2059,6 +2629,20 @@ tailCall:
         DISPATCH;
       }
 
+      CASE(LoadFromOuterEnvironment) {
+        Environment *curEnv =
+            FRAME.getCalleeClosureUnsafe()->getEnvironment(runtime);
+        for (unsigned level = ip->iLoadFromOuterEnvironment.op2; level;
+             --level) {
+          assert(curEnv && "invalid environment relative level");
+          curEnv = curEnv->getParentEnvironment(runtime);
+        }
+        O1REG(LoadFromOuterEnvironment) =
+            curEnv->slot(ip->iLoadFromOuterEnvironment.op3);
+        ip = NEXTINST(LoadFromOuterEnvironment);
+        DISPATCH;
+      }
+
       CASE(GetGlobalObject) {
         O1REG(GetGlobalObject) = runtime->global_;
         ip = NEXTINST(GetGlobalObject);
@@ -2154,15 +2738,74 @@ tailCall:
 
         // If we have a cache hit, reuse the cached offset and immediately
         // return the property.
-        if (LLVM_LIKELY(cacheEntry->clazz == clazz)) {
+        PropertyCacheEntry *way = cacheEntry->find(clazz);
+        if (LLVM_LIKELY(way != nullptr)) {
           ++NumGetByIdCacheHits;
+          curCodeBlock->recordPropertyCacheHit();
           O1REG(GetById) =
               JSObject::getNamedSlotValue<PropStorage::Inline::Yes>(
-                  obj, runtime, cacheEntry->slot);
+                  obj, runtime, way->slot);
           ip = nextIP;
           DISPATCH;
         }
+
+        // Method calls usually find the property on the prototype chain. The
+        // prototype-chain cache is keyed on the class of the receiver, so a
+        // hit avoids any lookup in the receiver.
+        ProtoPropertyCacheEntry *protoEntry = nullptr;
+        if (LLVM_LIKELY(cacheIdx != hbc::PROPERTY_CACHING_DISABLED)) {
+          protoEntry = curCodeBlock->getProtoCacheEntry(cacheIdx);
+          JSObject *holder;
+          if (protoEntry->receiverClass == clazz &&
+              (holder =
+                   JSObject::getProtoCacheHolder(obj, runtime, *protoEntry))) {
+            ++NumGetByIdProtoChainHits;
+            curCodeBlock->recordPropertyCacheHit();
+            HermesValue slotValue =
+                JSObject::getNamedSlotValue(holder, runtime, protoEntry->slot);
+            if (LLVM_LIKELY(!protoEntry->accessor)) {
+              O1REG(GetById) = slotValue;
+              ip = nextIP;
+              DISPATCH;
+            }
+            // Call the getter of a cached accessor directly on the receiver.
+            auto *accessor = vmcast<PropertyAccessor>(slotValue);
+            if (!accessor->getter) {
+              O1REG(GetById) = HermesValue::encodeUndefinedValue();
+              ip = nextIP;
+              DISPATCH;
+            }
+            runtime->storeCallerIP(ip);
+            propRes = Callable::executeCall0(
+                runtime->makeHandle(accessor->getter),
+                runtime,
+                Handle<>(&O2REG(GetById)));
+            runtime->clearCallerIP();
+            if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
+              goto exception;
+            }
+            O1REG(GetById) = *propRes;
+            gcScope.flushToSmallCount(KEEP_HANDLES);
+            ip = nextIP;
+            DISPATCH;
+          }
+        }
+
         auto id = ID(idVal);
+
+        // Sites which have seen too many classes share a runtime-wide cache.
+        auto &megaCache = runtime->getMegamorphicPropertyCache();
+        if (LLVM_UNLIKELY(cacheEntry->megamorphic)) {
+          if (const auto *megaEntry = megaCache.find(clazz, id)) {
+            ++NumGetByIdMegamorphicHits;
+            curCodeBlock->recordPropertyCacheHit();
+            O1REG(GetById) =
+                JSObject::getNamedSlotValue(obj, runtime, megaEntry->slot);
+            ip = nextIP;
+            DISPATCH;
+          }
+        }
+
         NamedPropertyDescriptor desc;
         OptValue<bool> fastPathResult =
             JSObject::tryGetOwnNamedDescriptorFast(obj, runtime, id, desc);
@@ -2173,17 +2816,20 @@ tailCall:
 
           // cacheIdx == 0 indicates no caching so don't update the cache in
           // those cases.
-          if (LLVM_LIKELY(!clazz->isDictionary()) &&
+          if (LLVM_LIKELY(clazz->isCacheable()) &&
               LLVM_LIKELY(cacheIdx != hbc::PROPERTY_CACHING_DISABLED)) {
-#ifdef HERMES_SLOW_DEBUG
-            if (cacheEntry->clazz && cacheEntry->clazz != clazz)
-              ++NumGetByIdCacheEvicts;
-#else
-            (void)NumGetByIdCacheEvicts;
-#endif
+            curCodeBlock->recordPropertyCacheMiss(cacheEntry);
             // Cache the class, id and property slot.
-            cacheEntry->clazz = clazz;
-            cacheEntry->slot = desc.slot;
+            bool wasMegamorphic = cacheEntry->megamorphic;
+            if (!cacheEntry->insert(clazz, desc.slot)) {
+              if (!wasMegamorphic)
+                ++NumGetByIdCacheMegamorphic;
+              megaCache.insert(
+                  clazz,
+                  id,
+                  desc.slot,
+                  desc.flags.writable && !desc.flags.internalSetter);
+            }
           }
 
           O1REG(GetById) = JSObject::getNamedSlotValue(obj, runtime, desc);
@@ -2200,16 +2846,23 @@ tailCall:
           // having no properties and therefore cannot contain the property.
           // This check does not belong here, it should be merged into
           // tryGetOwnNamedDescriptorFast().
-          if (parent && cacheEntry->clazz == parent->getClass(runtime) &&
+          PropertyCacheEntry *parentWay;
+          if (parent &&
+              (parentWay = cacheEntry->find(parent->getClass(runtime))) &&
               LLVM_LIKELY(!obj->isLazy())) {
             ++NumGetByIdProtoHits;
+            curCodeBlock->recordPropertyCacheHit();
             O1REG(GetById) =
-                JSObject::getNamedSlotValue(parent, runtime, cacheEntry->slot);
+                JSObject::getNamedSlotValue(parent, runtime, parentWay->slot);
             ip = nextIP;
             DISPATCH;
           }
         }
 
+        if (cacheIdx != hbc::PROPERTY_CACHING_DISABLED)
+          curCodeBlock->recordPropertyCacheMiss(cacheEntry);
+        RECORD_FEEDBACK(FeedbackObject);
+
 #ifdef HERMES_SLOW_DEBUG
         JSObject *propObj = JSObject::getNamedDescriptor(
             Handle<JSObject>::vmcast(&O2REG(GetById)), runtime, id, desc);
@@ -2232,7 +2885,8 @@ tailCall:
             runtime,
             id,
             !tryProp ? defaultPropOpFlags : defaultPropOpFlags.plusMustExist(),
-            cacheIdx != hbc::PROPERTY_CACHING_DISABLED ? cacheEntry : nullptr);
+            cacheIdx != hbc::PROPERTY_CACHING_DISABLED ? cacheEntry : nullptr,
+            protoEntry);
         runtime->clearCallerIP();
         if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
           goto exception;
@@ -2241,6 +2895,7 @@ tailCall:
         ++NumGetByIdTransient;
         assert(!tryProp && "TryGetById can only be used on the global object");
         /* Slow path. */
+        RECORD_FEEDBACK(feedbackTypeOf(O2REG(GetById)));
         runtime->storeCallerIP(ip);
         propRes = Interpreter::getByIdTransient_RJS(
             runtime, Handle<>(&O2REG(GetById)), ID(idVal));
@@ -2267,6 +2922,12 @@ tailCall:
         nextIP = NEXTINST(PutByIdLong);
         goto putById;
       }
+      CASE(PutByIdShort) {
+        tryProp = false;
+        idVal = ip->iPutByIdShort.op4;
+        nextIP = NEXTINST(PutByIdShort);
+        goto putById;
+      }
       CASE(TryPutById) {
         tryProp = true;
         idVal = ip->iTryPutById.op4;
@@ -2288,14 +2949,31 @@ tailCall:
 
         // If we have a cache hit, reuse the cached offset and immediately
         // return the property.
-        if (LLVM_LIKELY(cacheEntry->clazz == clazz)) {
+        PropertyCacheEntry *way = cacheEntry->find(clazz);
+        if (LLVM_LIKELY(way != nullptr)) {
           ++NumPutByIdCacheHits;
+          curCodeBlock->recordPropertyCacheHit();
           JSObject::setNamedSlotValue<PropStorage::Inline::Yes>(
-              obj, runtime, cacheEntry->slot, O2REG(PutById));
+              obj, runtime, way->slot, O2REG(PutById));
           ip = nextIP;
           DISPATCH;
         }
         auto id = ID(idVal);
+
+        // Sites which have seen too many classes share a runtime-wide cache.
+        auto &megaCache = runtime->getMegamorphicPropertyCache();
+        if (LLVM_UNLIKELY(cacheEntry->megamorphic)) {
+          const auto *megaEntry = megaCache.find(clazz, id);
+          if (megaEntry && megaEntry->writable) {
+            ++NumPutByIdMegamorphicHits;
+            curCodeBlock->recordPropertyCacheHit();
+            JSObject::setNamedSlotValue(
+                obj, runtime, megaEntry->slot, O2REG(PutById));
+            ip = nextIP;
+            DISPATCH;
+          }
+        }
+
         NamedPropertyDescriptor desc;
         OptValue<bool> hasOwnProp =
             JSObject::tryGetOwnNamedDescriptorFast(obj, runtime, id, desc);
@@ -2306,17 +2984,16 @@ tailCall:
 
           // cacheIdx == 0 indicates no caching so don't update the cache in
           // those cases.
-          if (LLVM_LIKELY(!clazz->isDictionary()) &&
+          if (LLVM_LIKELY(clazz->isCacheable()) &&
               LLVM_LIKELY(cacheIdx != hbc::PROPERTY_CACHING_DISABLED)) {
-#ifdef HERMES_SLOW_DEBUG
-            if (cacheEntry->clazz && cacheEntry->clazz != clazz)
-              ++NumPutByIdCacheEvicts;
-#else
-            (void)NumPutByIdCacheEvicts;
-#endif
+            curCodeBlock->recordPropertyCacheMiss(cacheEntry);
             // Cache the class and property slot.
-            cacheEntry->clazz = clazz;
-            cacheEntry->slot = desc.slot;
+            bool wasMegamorphic = cacheEntry->megamorphic;
+            if (!cacheEntry->insert(clazz, desc.slot)) {
+              if (!wasMegamorphic)
+                ++NumPutByIdCacheMegamorphic;
+              megaCache.insert(clazz, id, desc.slot, /* writable */ true);
+            }
           }
 
           JSObject::setNamedSlotValue(obj, runtime, desc.slot, O2REG(PutById));
@@ -2324,6 +3001,9 @@ tailCall:
           DISPATCH;
         }
 
+        if (cacheIdx != hbc::PROPERTY_CACHING_DISABLED)
+          curCodeBlock->recordPropertyCacheMiss(cacheEntry);
+        RECORD_FEEDBACK(FeedbackObject);
         runtime->storeCallerIP(ip);
         auto putRes = JSObject::putNamed_RJS(
             Handle<JSObject>::vmcast(&O1REG(PutById)),
@@ -2338,6 +3018,7 @@ tailCall:
       } else {
         ++NumPutByIdTransient;
         assert(!tryProp && "TryPutById can only be used on the global object");
+        RECORD_FEEDBACK(feedbackTypeOf(O1REG(PutById)));
         runtime->storeCallerIP(ip);
         auto retStatus = Interpreter::putByIdTransient_RJS(
             runtime,
@@ -2357,6 +3038,19 @@ tailCall:
 
       CASE(GetByVal) {
         CallResult<HermesValue> propRes{ExecutionStatus::EXCEPTION};
+        // Fast path for reading an element of a packed array, which can't be
+        // a hole or an accessor.
+        if (auto *arr = dyn_vmcast<JSArray>(O2REG(GetByVal))) {
+          OptValue<uint32_t> idx = toArrayIndexFastPath(O3REG(GetByVal));
+          if (LLVM_LIKELY(
+                  idx && *idx < JSArray::getLength(arr) &&
+                  JSArray::isPacked(arr))) {
+            O1REG(GetByVal) = arr->at(runtime, *idx);
+            ip = NEXTINST(GetByVal);
+            DISPATCH;
+          }
+        }
+        RECORD_FEEDBACK(feedbackTypeOf(O2REG(GetByVal)));
         if (LLVM_LIKELY(O2REG(GetByVal).isObject())) {
           runtime->storeCallerIP(ip);
           propRes = JSObject::getComputed_RJS(
@@ -2384,6 +3078,20 @@ tailCall:
       }
 
       CASE(PutByVal) {
+        // Fast path for overwriting an element of a packed array, which is a
+        // writable data property unless the array is sealed or frozen.
+        if (auto *arr = dyn_vmcast<JSArray>(O1REG(PutByVal))) {
+          OptValue<uint32_t> idx = toArrayIndexFastPath(O2REG(PutByVal));
+          if (LLVM_LIKELY(
+                  idx && *idx < JSArray::getLength(arr) &&
+                  JSArray::isPacked(arr) && arr->isExtensible())) {
+            JSArray::unsafeSetExistingElementAt(
+                arr, runtime, *idx, O3REG(PutByVal));
+            ip = NEXTINST(PutByVal);
+            DISPATCH;
+          }
+        }
+        RECORD_FEEDBACK(feedbackTypeOf(O1REG(PutByVal)));
         if (LLVM_LIKELY(O1REG(PutByVal).isObject())) {
           runtime->storeCallerIP(ip);
           auto putRes = JSObject::putComputed_RJS(
@@ -2459,9 +3167,12 @@ tailCall:
           uint32_t idx = O4REG(GetNextPName).getNumber();
           uint32_t size = O5REG(GetNextPName).getNumber();
           MutableHandle<JSObject> propObj{runtime};
+          const uint32_t ownEnd = getForInCachedOwnEnd(runtime, *obj, *arr);
           // Loop until we find a property which is present.
           while (idx < size) {
             tmpHandle = arr->at(idx);
+            if (idx < ownEnd)
+              break;
             ComputedPropertyDescriptor desc;
             JSObject::getComputedPrimitiveDescriptor(
                 obj, runtime, tmpHandle, propObj, desc);
@@ -2492,6 +3203,58 @@ tailCall:
         DISPATCH;
       }
 
+      CASE(IteratorBegin) {
+        runtime->storeCallerIP(ip);
+        res = iteratorBegin_RJS(runtime, &O2REG(IteratorBegin));
+        runtime->clearCallerIP();
+        if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+          goto exception;
+        }
+        gcScope.flushToSmallCount(KEEP_HANDLES);
+        O1REG(IteratorBegin) = *res;
+        ip = NEXTINST(IteratorBegin);
+        DISPATCH;
+      }
+
+      CASE(IteratorNext) {
+        // Fast path for the next element of a packed array iterated by index.
+        if (O2REG(IteratorNext).isNumber()) {
+          auto *arr = vmcast<JSArray>(O3REG(IteratorNext));
+          uint32_t idx = O2REG(IteratorNext).getNumber();
+          if (LLVM_LIKELY(
+                  idx < JSArray::getLength(arr) && JSArray::isPacked(arr))) {
+            O1REG(IteratorNext) = arr->at(runtime, idx);
+            O2REG(IteratorNext) = HermesValue::encodeNumberValue(idx + 1);
+            ip = NEXTINST(IteratorNext);
+            DISPATCH;
+          }
+        }
+        runtime->storeCallerIP(ip);
+        res = iteratorNext_RJS(
+            runtime, &O2REG(IteratorNext), Handle<>(&O3REG(IteratorNext)));
+        runtime->clearCallerIP();
+        if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+          goto exception;
+        }
+        gcScope.flushToSmallCount(KEEP_HANDLES);
+        O1REG(IteratorNext) = *res;
+        ip = NEXTINST(IteratorNext);
+        DISPATCH;
+      }
+
+      CASE(IteratorClose) {
+        runtime->storeCallerIP(ip);
+        auto closeRes = iteratorClose_RJS(
+            runtime, Handle<>(&O1REG(IteratorClose)), ip->iIteratorClose.op2);
+        runtime->clearCallerIP();
+        if (LLVM_UNLIKELY(closeRes == ExecutionStatus::EXCEPTION)) {
+          goto exception;
+        }
+        gcScope.flushToSmallCount(KEEP_HANDLES);
+        ip = NEXTINST(IteratorClose);
+        DISPATCH;
+      }
+
       CASE(ToNumber) {
         if (LLVM_LIKELY(O2REG(ToNumber).isNumber())) {
           O1REG(ToNumber) = O2REG(ToNumber);
@@ -2547,55 +3310,92 @@ tailCall:
       }
 
       CASE(Jmp) {
-        ip = IPADD(ip->iJmp.op1);
-        DISPATCH;
+        JUMP_TO(IPADD(ip->iJmp.op1));
       }
       CASE(JmpLong) {
-        ip = IPADD(ip->iJmpLong.op1);
-        DISPATCH;
+        JUMP_TO(IPADD(ip->iJmpLong.op1));
       }
       CASE(JmpTrue) {
         if (toBoolean(O2REG(JmpTrue)))
-          ip = IPADD(ip->iJmpTrue.op1);
-        else
-          ip = NEXTINST(JmpTrue);
-        DISPATCH;
+          JUMP_TO(IPADD(ip->iJmpTrue.op1));
+        JUMP_TO(NEXTINST(JmpTrue));
       }
       CASE(JmpTrueLong) {
         if (toBoolean(O2REG(JmpTrueLong)))
-          ip = IPADD(ip->iJmpTrueLong.op1);
-        else
-          ip = NEXTINST(JmpTrueLong);
-        DISPATCH;
+          JUMP_TO(IPADD(ip->iJmpTrueLong.op1));
+        JUMP_TO(NEXTINST(JmpTrueLong));
       }
       CASE(JmpFalse) {
         if (!toBoolean(O2REG(JmpFalse)))
-          ip = IPADD(ip->iJmpFalse.op1);
-        else
-          ip = NEXTINST(JmpFalse);
-        DISPATCH;
+          JUMP_TO(IPADD(ip->iJmpFalse.op1));
+        JUMP_TO(NEXTINST(JmpFalse));
       }
       CASE(JmpFalseLong) {
         if (!toBoolean(O2REG(JmpFalseLong)))
-          ip = IPADD(ip->iJmpFalseLong.op1);
-        else
-          ip = NEXTINST(JmpFalseLong);
-        DISPATCH;
+          JUMP_TO(IPADD(ip->iJmpFalseLong.op1));
+        JUMP_TO(NEXTINST(JmpFalseLong));
       }
       CASE(JmpUndefined) {
         if (O2REG(JmpUndefined).isUndefined())
-          ip = IPADD(ip->iJmpUndefined.op1);
-        else
-          ip = NEXTINST(JmpUndefined);
-        DISPATCH;
+          JUMP_TO(IPADD(ip->iJmpUndefined.op1));
+        JUMP_TO(NEXTINST(JmpUndefined));
       }
       CASE(JmpUndefinedLong) {
         if (O2REG(JmpUndefinedLong).isUndefined())
-          ip = IPADD(ip->iJmpUndefinedLong.op1);
-        else
-          ip = NEXTINST(JmpUndefinedLong);
-        DISPATCH;
+          JUMP_TO(IPADD(ip->iJmpUndefinedLong.op1));
+        JUMP_TO(NEXTINST(JmpUndefinedLong));
       }
+#ifdef HERMESVM_JIT
+    backEdge : {
+      // ip is the header of a loop whose back-edge was just taken. Once the
+      // loop is hot, leave the interpreter and continue it in native code.
+      curCodeBlock->incrementBackEdgeCount();
+      if (LLVM_UNLIKELY(runtime->testAndClearFunctionProfileTick()))
+        curCodeBlock->incrementProfileSamples();
+      if (!SingleStep && LLVM_LIKELY(!runtime->isCodeCoverageEnabled())) {
+        if (auto osrPtr = runtime->jitContext_.compileOSR(
+                runtime, curCodeBlock, CUROFFSET)) {
+          runtime->restoreCallerIPFromStackFrame();
+
+          PROFILER_EXIT_FUNCTION(curCodeBlock);
+
+          // Pop the interpreter frame. The native code pushes an identical
+          // frame on top of the same registers, and pops it when it returns.
+          CodeBlock *osrBlock = curCodeBlock;
+          ip = FRAME.getSavedIP();
+          curCodeBlock = FRAME.getSavedCodeBlock();
+          frameRegs =
+              &runtime->restoreStackAndPreviousFrame(FRAME).getFirstLocalRef();
+
+          {
+            ScopedTimeAttribution timeScope(
+                runtime->getTimeAttribution(),
+                osrBlock,
+                FunctionTimeAttribution::Category::JIT);
+            res = (*osrPtr)(runtime);
+          }
+
+          // Are we returning to native code?
+          if (!curCodeBlock)
+            return res;
+          attributeTimeTo(runtime, curCodeBlock);
+
+// Return because of recursive calling structure
+#if defined(HERMESVM_PROFILER_EXTERN)
+          return res;
+#endif
+
+          if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+            goto exception;
+          INIT_STATE_FOR_CODEBLOCK(curCodeBlock);
+          O1REG(Call) = res.getValue();
+          gcScope.flushToSmallCount(KEEP_HANDLES);
+          ip = nextInstCall(ip);
+        }
+      }
+      DISPATCH;
+    }
+#endif
       CASE(Add) {
         if (LLVM_LIKELY(
                 O2REG(Add).isNumber() &&
@@ -2607,6 +3407,7 @@ tailCall:
             DISPATCH;
           }
         }
+        RECORD_BINOP_FEEDBACK(Add);
         runtime->storeCallerIP(ip);
         res = addOp_RJS(runtime, Handle<>(&O2REG(Add)), Handle<>(&O3REG(Add)));
         runtime->clearCallerIP();
@@ -2719,6 +3520,25 @@ tailCall:
         DISPATCH;
       }
 
+      CASE(CallApplyArguments) {
+        runtime->storeCallerIP(ip);
+        res = callApplyArguments_RJS(
+            runtime,
+            &O5REG(CallApplyArguments),
+            Handle<>(&O2REG(CallApplyArguments)),
+            Handle<>(&O3REG(CallApplyArguments)),
+            Handle<>(&O4REG(CallApplyArguments)),
+            strictMode);
+        runtime->clearCallerIP();
+        if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+          goto exception;
+        }
+        gcScope.flushToSmallCount(KEEP_HANDLES);
+        O1REG(CallApplyArguments) = *res;
+        ip = NEXTINST(CallApplyArguments);
+        DISPATCH;
+      }
+
       CASE(NewObject) {
         // Create a new object using the built-in constructor. Note that the
         // built-in constructor is empty, so we don't actually need to call
@@ -2753,7 +3573,8 @@ tailCall:
             curCodeBlock,
             ip->iNewObjectWithBuffer.op3,
             ip->iNewObjectWithBuffer.op4,
-            ip->iNewObjectWithBuffer.op5);
+            ip->iNewObjectWithBuffer.op5,
+            curCodeBlock->getAllocationSite(CUROFFSET));
         if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
           goto exception;
         }
@@ -2769,7 +3590,8 @@ tailCall:
             curCodeBlock,
             ip->iNewObjectWithBufferLong.op3,
             ip->iNewObjectWithBufferLong.op4,
-            ip->iNewObjectWithBufferLong.op5);
+            ip->iNewObjectWithBufferLong.op5,
+            curCodeBlock->getAllocationSite(CUROFFSET));
         if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
           goto exception;
         }
@@ -2800,7 +3622,8 @@ tailCall:
             curCodeBlock,
             ip->iNewArrayWithBuffer.op2,
             ip->iNewArrayWithBuffer.op3,
-            ip->iNewArrayWithBuffer.op4);
+            ip->iNewArrayWithBuffer.op4,
+            curCodeBlock->getAllocationSite(CUROFFSET));
         if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
           goto exception;
         }
@@ -2817,7 +3640,8 @@ tailCall:
             curCodeBlock,
             ip->iNewArrayWithBufferLong.op2,
             ip->iNewArrayWithBufferLong.op3,
-            ip->iNewArrayWithBufferLong.op4);
+            ip->iNewArrayWithBufferLong.op4,
+            curCodeBlock->getAllocationSite(CUROFFSET));
         if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
           goto exception;
         }
@@ -2912,6 +3736,12 @@ tailCall:
         ip = NEXTINST(TypeOf);
         DISPATCH;
       }
+      CASE(TypeOfIs) {
+        O1REG(TypeOfIs) = HermesValue::encodeBoolValue(
+            (typeOfIsType(O2REG(TypeOfIs)) & ip->iTypeOfIs.op3) != 0);
+        ip = NEXTINST(TypeOfIs);
+        DISPATCH;
+      }
       CASE(Mod) {
         // We use fmod here for simplicity. Theoretically fmod behaves slightly
         // differently than the ECMAScript Spec. fmod applies round-towards-zero
@@ -2928,6 +3758,7 @@ tailCall:
           ip = NEXTINST(Mod);
           DISPATCH;
         }
+        RECORD_BINOP_FEEDBACK(Mod);
         runtime->storeCallerIP(ip);
         res = toNumber_RJS(runtime, Handle<>(&O2REG(Mod)));
         runtime->clearCallerIP();
@@ -2946,6 +3777,32 @@ tailCall:
         DISPATCH;
       }
       CASE(InstanceOf) {
+        // A JSFunction has the default @@hasInstance, so once the slot of
+        // its "prototype" is cached by its class, instanceof only walks the
+        // parent chain of the object.
+        auto cacheIdx = ip->iInstanceOf.op4;
+        auto *cacheEntry = curCodeBlock->getReadCacheEntry(cacheIdx);
+        if (LLVM_LIKELY(O2REG(InstanceOf).isObject()) &&
+            vmisa<JSFunction>(O3REG(InstanceOf))) {
+          auto *ctor = vmcast<JSObject>(O3REG(InstanceOf));
+          PropertyCacheEntry *way = cacheEntry->find(ctor->getClass(runtime));
+          // A prototype which is not an object throws in the slow path.
+          JSObject *ctorPrototype = way
+              ? dyn_vmcast<JSObject>(
+                    JSObject::getNamedSlotValue(ctor, runtime, way->slot))
+              : nullptr;
+          if (LLVM_LIKELY(ctorPrototype != nullptr)) {
+            ++NumInstanceOfCacheHits;
+            curCodeBlock->recordPropertyCacheHit();
+            JSObject *obj =
+                vmcast<JSObject>(O2REG(InstanceOf))->getParent(runtime);
+            while (obj && obj != ctorPrototype)
+              obj = obj->getParent(runtime);
+            O1REG(InstanceOf) = HermesValue::encodeBoolValue(obj != nullptr);
+            ip = NEXTINST(InstanceOf);
+            DISPATCH;
+          }
+        }
         runtime->storeCallerIP(ip);
         auto result = instanceOfOperator_RJS(
             runtime,
@@ -2956,6 +3813,22 @@ tailCall:
           goto exception;
         }
         O1REG(InstanceOf) = HermesValue::encodeBoolValue(*result);
+        if (LLVM_LIKELY(cacheIdx != hbc::PROPERTY_CACHING_DISABLED) &&
+            vmisa<JSFunction>(O3REG(InstanceOf))) {
+          auto *ctor = vmcast<JSObject>(O3REG(InstanceOf));
+          auto *clazz = ctor->getClass(runtime);
+          NamedPropertyDescriptor desc;
+          OptValue<bool> found = JSObject::tryGetOwnNamedDescriptorFast(
+              ctor,
+              runtime,
+              Predefined::getSymbolID(Predefined::prototype),
+              desc);
+          if (LLVM_LIKELY(clazz->isCacheable()) && found.hasValue() &&
+              found.getValue() && !desc.flags.accessor) {
+            curCodeBlock->recordPropertyCacheMiss(cacheEntry);
+            cacheEntry->insert(clazz, desc.slot);
+          }
+        }
         gcScope.flushToSmallCount(KEEP_HANDLES);
         ip = NEXTINST(InstanceOf);
         DISPATCH;
@@ -3154,13 +4027,11 @@ tailCall:
             const uint32_t *loc =
                 (const uint32_t *)tablestart + uintVal - ip->iSwitchImm.op4;
 
-            ip = IPADD(*loc);
-            DISPATCH;
+            JUMP_TO(IPADD(*loc));
           }
         }
         // Wrong type or out of range, jump to default.
-        ip = IPADD(ip->iSwitchImm.op3);
-        DISPATCH;
+        JUMP_TO(IPADD(ip->iSwitchImm.op3));
       }
       LOAD_CONST(
           LoadConstUInt8,
@@ -3208,7 +4079,10 @@ tailCall:
       JCOND(GreaterEqual, >=, greaterEqualOp_RJS);
 
       JCOND_STRICT_EQ_IMPL(
-          JStrictEqual, , IPADD(ip->iJStrictEqual.op1), NEXTINST(JStrictEqual));
+          JStrictEqual,
+          ,
+          IPADD(ip->iJStrictEqual.op1),
+          NEXTINST(JStrictEqual));
       JCOND_STRICT_EQ_IMPL(
           JStrictEqual,
           Long,
@@ -3282,7 +4156,11 @@ tailCall:
     // access to the current codeblock and IP, so collect the stack trace here.
     if (auto *jsError = dyn_vmcast<JSError>(runtime->thrownValue_)) {
       catchable = jsError->catchable();
-      if (!jsError->getStackTrace()) {
+      if (!jsError->getStackTrace() &&
+          !(catchable &&
+            (runtime->getVMExperimentFlags() &
+             experiments::SkipStackTraceForLocalCatch) &&
+            isCaughtInFrameOrCaller(curCodeBlock, ip, FRAME))) {
         // Temporarily clear the thrown value for following operations.
         auto errorHandle =
             runtime->makeHandle(vmcast<JSError>(runtime->thrownValue_));
@@ -3340,10 +4218,11 @@ tailCall:
 
     int32_t handlerOffset = 0;
 
-    // If the exception is not catchable, skip found catch blocks.
-    while (((handlerOffset = curCodeBlock->findCatchTargetOffset(CUROFFSET)) ==
-            -1) ||
-           !catchable) {
+    // If the exception is not catchable, skip found catch blocks. Frames of
+    // functions without handlers are popped without a lookup.
+    while (!catchable || !curCodeBlock->hasExceptionHandlers() ||
+           (handlerOffset = curCodeBlock->findCatchTargetOffset(CUROFFSET)) ==
+               -1) {
       PROFILER_EXIT_FUNCTION(curCodeBlock);
 
       // Restore the code block and IP.
@@ -3377,8 +4256,10 @@ tailCall:
     }
 
     INIT_STATE_FOR_CODEBLOCK(curCodeBlock);
+    attributeTimeTo(runtime, curCodeBlock);
 
     ip = IPADD(handlerOffset - CUROFFSET);
+    RECORD_COVERAGE(ip);
   }
 }
 
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/VM/JIT/CodeCache.h"
+
+#define DEBUG_TYPE "jit"
+
+#include "hermes/VM/Callable.h"
+#include "hermes/VM/CodeBlock.h"
+#include "hermes/VM/Runtime.h"
+#include "hermes/VM/StackFrame-inline.h"
+
+#include "llvm/Support/Debug.h"
+
+#include <algorithm>
+
+namespace hermes {
+namespace vm {
+
+void CodeCache::add(
+    CodeBlock *codeBlock,
+    ExecHeap::BlockPair blocks,
+    ExecHeap::SizePair sizes) {
+  // An empty part of the blocks has already been returned to the heap.
+  entries_.push_back({codeBlock,
+                      {sizes.first ? blocks.first : nullptr,
+                       sizes.second ? blocks.second : nullptr},
+                      sizes});
+  stats_.bytesUsed += sizes.first + sizes.second;
+  if (evicted_.erase(codeBlock))
+    ++stats_.recompilations;
+}
+
+bool CodeCache::evict(
+    Runtime *runtime,
+    ExecHeap &heap,
+    ExecHeap::SizePair sizes) {
+  if (heap.canAlloc(sizes))
+    return true;
+
+  // Native code of functions with a frame on the stack may still be running,
+  // or be returned to.
+  llvm::DenseSet<CodeBlock *> active{};
+  for (auto frame : runtime->getStackFrames()) {
+    if (auto *codeBlock = frame.getCalleeCodeBlock())
+      active.insert(codeBlock);
+  }
+
+  // Evict the least recently used functions first.
+  std::sort(
+      entries_.begin(), entries_.end(), [](const Entry &a, const Entry &b) {
+        return a.codeBlock->getJITLastUse() < b.codeBlock->getJITLastUse();
+      });
+
+  auto it = entries_.begin();
+  bool fits = false;
+  while (it != entries_.end() && !fits) {
+    if (active.count(it->codeBlock)) {
+      ++it;
+      continue;
+    }
+    LLVM_DEBUG(
+        llvm::dbgs() << "JIT evicting FunctionID "
+                     << it->codeBlock->getFunctionID() << "\n");
+    it->codeBlock->setJITCompiled(nullptr);
+    it->codeBlock->clearOSREntries();
+    it->codeBlock->setJITQueued(false);
+    // The function must become hot again before it is recompiled.
+    it->codeBlock->clearExecutionCount();
+    it->codeBlock->clearBackEdgeCount();
+    evicted_.insert(it->codeBlock);
+    heap.free(it->blocks);
+    stats_.bytesUsed -= it->sizes.first + it->sizes.second;
+    ++stats_.evictions;
+    it = entries_.erase(it);
+    fits = heap.canAlloc(sizes);
+  }
+  return fits;
+}
+
+void CodeCache::removeRuntimeModule(
+    RuntimeModule *runtimeModule,
+    ExecHeap &heap) {
+  entries_.erase(
+      std::remove_if(
+          entries_.begin(),
+          entries_.end(),
+          [this, runtimeModule, &heap](const Entry &entry) {
+            if (entry.codeBlock->getRuntimeModule() != runtimeModule)
+              return false;
+            heap.free(entry.blocks);
+            stats_.bytesUsed -= entry.sizes.first + entry.sizes.second;
+            return true;
+          }),
+      entries_.end());
+  for (auto it = evicted_.begin(), e = evicted_.end(); it != e;) {
+    auto cur = it++;
+    if ((*cur)->getRuntimeModule() == runtimeModule)
+      evicted_.erase(cur);
+  }
+}
+
+void CodeCache::printStats(llvm::raw_ostream &os) const {
+  os << "JIT code cache stats:\n"
+     << "  Bytes used: " << stats_.bytesUsed << "\n"
+     << "  Functions compiled: " << entries_.size() << "\n"
+     << "  Evictions: " << stats_.evictions << "\n"
+     << "  Recompilations: " << stats_.recompilations << "\n";
+}
+
+} // namespace vm
+} // namespace hermes
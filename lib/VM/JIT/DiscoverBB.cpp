@@ -17,16 +17,18 @@ namespace hermes {
 namespace vm {
 using hermes::inst::Inst;
 using hermes::inst::OpCode;
-using hermes::inst::OperandType;
 
 void discoverBasicBlocks(
     CodeBlock *codeBlock,
     std::vector<uint32_t> &basicBlocks,
-    llvm::DenseMap<uint32_t, unsigned> &labels) {
+    llvm::DenseMap<uint32_t, unsigned> &labels,
+    std::vector<unsigned> *loopHeaders) {
   auto const begin = codeBlock->begin();
   auto const end = codeBlock->end();
 
   llvm::DenseSet<uint32_t> labelSet{};
+  // Targets of backward branches.
+  llvm::DenseSet<uint32_t> loopHeaderSet{};
 
   auto addLabel = [begin, &labelSet](const uint8_t *label) {
     labelSet.insert((uint32_t)(label - begin));
@@ -37,31 +39,29 @@ void discoverBasicBlocks(
   addLabel(ip);
 
   while (ip != end) {
-    auto decoded = decodeInstruction((const Inst *)ip);
-    bool branch = false;
+    auto opCode = ((const Inst *)ip)->opCode;
     // FIXME: implement SwitchImm.
-    assert(
-        decoded.meta.opCode != OpCode::SwitchImm &&
-        "SwitchImm not implemented yet");
-    if (decoded.meta.opCode == OpCode::Catch) {
+    assert(opCode != OpCode::SwitchImm && "SwitchImm not implemented yet");
+    if (opCode == OpCode::Catch)
       addLabel(ip);
-      ip += decoded.meta.size;
+    // Only branches need their operands decoded.
+    if (!inst::isBranchOpCode(opCode)) {
+      ip += inst::getInstSize(opCode);
       continue;
     }
+    auto decoded = decodeInstruction((const Inst *)ip);
     for (unsigned i = 0; i < decoded.meta.numOperands; ++i) {
-      int32_t offset;
-      if (decoded.meta.operandType[i] == OperandType::Addr8 ||
-          decoded.meta.operandType[i] == OperandType::Addr32) {
-        offset = decoded.operandValue[i].integer;
+      if (inst::isOperandTypeAddr(decoded.meta.operandType[i])) {
+        int32_t offset = decoded.operandValue[i].integer;
         // Add the branch destination as a label.
         addLabel(ip + offset);
-        branch = true;
+        if (offset <= 0)
+          loopHeaderSet.insert((uint32_t)(ip + offset - begin));
       }
     }
     ip += decoded.meta.size;
-    // If this was a branch, add the next instruction as a label.
-    if (branch)
-      addLabel(ip);
+    // This was a branch, so add the next instruction as a label.
+    addLabel(ip);
   }
 
   // Add the end of the bytecode
@@ -81,6 +81,14 @@ void discoverBasicBlocks(
     labels.try_emplace(basicBlocks[i], i);
     LLVM_DEBUG(llvm::dbgs() << "  BB" << i << " at " << basicBlocks[i] << "\n");
   }
+
+  if (loopHeaders) {
+    loopHeaders->clear();
+    loopHeaders->reserve(loopHeaderSet.size());
+    for (uint32_t offset : loopHeaderSet)
+      loopHeaders->push_back(labels[offset]);
+    std::sort(loopHeaders->begin(), loopHeaders->end());
+  }
 }
 
 } // namespace vm
@@ -16,10 +16,12 @@ namespace vm {
 ExecHeap::ExecHeap(
     size_t firstHeapSize,
     size_t secondHeapSize,
-    size_t maxMemory)
+    size_t maxMemory,
+    bool writeXorExecute)
     : firstHeapSize_(firstHeapSize),
       secondHeapSize_(secondHeapSize),
-      maxPools_(maxMemory / (firstHeapSize + secondHeapSize)) {}
+      maxPools_(maxMemory / (firstHeapSize + secondHeapSize)),
+      writeXorExecute_(writeXorExecute) {}
 
 ExecHeap::~ExecHeap() = default;
 
@@ -30,10 +32,14 @@ ExecHeap::DualPool *ExecHeap::addPool() {
 
   // Allocate a new one.
   std::error_code EC;
-  const unsigned kRWX = llvm::sys::Memory::MF_READ |
-      llvm::sys::Memory::MF_WRITE | llvm::sys::Memory::MF_EXEC;
+  const unsigned kRW =
+      llvm::sys::Memory::MF_READ | llvm::sys::Memory::MF_WRITE;
+  // A W^X pool starts out writable, since the first thing that happens to it
+  // is emitting code.
+  const unsigned flags =
+      writeXorExecute_ ? kRW : kRW | llvm::sys::Memory::MF_EXEC;
   llvm::sys::OwningMemoryBlock mb{llvm::sys::Memory::allocateMappedMemory(
-      firstHeapSize_ + secondHeapSize_, nullptr, kRWX, EC)};
+      firstHeapSize_ + secondHeapSize_, nullptr, flags, EC)};
   if (!mb.base())
     return nullptr;
 
@@ -61,6 +67,18 @@ llvm::Optional<ExecHeap::BlockPair> ExecHeap::alloc(SizePair sizes) {
   return llvm::None;
 }
 
+bool ExecHeap::canAlloc(SizePair sizes) const {
+  if (sizes.first > firstHeapSize_ || sizes.second > secondHeapSize_)
+    return false;
+  if (pools_.size() < maxPools_)
+    return true;
+  for (const auto &pool : pools_) {
+    if (pool.canAlloc(sizes))
+      return true;
+  }
+  return false;
+}
+
 void ExecHeap::free(BlockPair blocks) {
   // If nothing is requested, do nothing.
   if (!blocks.first && !blocks.second)
@@ -79,6 +97,25 @@ void ExecHeap::freeRemaining(BlockPair blocks, SizePair keepSizes) {
     pools_.erase(pool);
 }
 
+bool ExecHeap::makeWritable(BlockPair blocks) {
+  if (!writeXorExecute_)
+    return true;
+  return findPool(blocks)->protect(
+      llvm::sys::Memory::MF_READ | llvm::sys::Memory::MF_WRITE);
+}
+
+bool ExecHeap::makeExecutable(BlockPair blocks, SizePair sizes) {
+  if (writeXorExecute_ &&
+      !findPool(blocks)->protect(
+          llvm::sys::Memory::MF_READ | llvm::sys::Memory::MF_EXEC))
+    return false;
+  if (sizes.first)
+    invalidateInstructionCache(blocks.first, sizes.first);
+  if (sizes.second)
+    invalidateInstructionCache(blocks.second, sizes.second);
+  return true;
+}
+
 ExecHeap::PoolList::iterator ExecHeap::findPool(BlockPair blocks) {
   assert((blocks.first || blocks.second) && "at least one block must be valid");
 
@@ -154,6 +191,11 @@ llvm::Optional<ExecHeap::BlockPair> ExecHeap::DualPool::alloc(SizePair sizes) {
   return BlockPair{(uint8_t *)first, (uint8_t *)second};
 }
 
+bool ExecHeap::DualPool::protect(unsigned flags) {
+  llvm::sys::MemoryBlock mb{memBlock_.base(), memBlock_.size()};
+  return !llvm::sys::Memory::protectMappedMemory(mb, flags);
+}
+
 void ExecHeap::DualPool::free(BlockPair blocks) {
   firstHeap_.free(blocks.first);
   secondHeap_.free(blocks.second);
@@ -7,9 +7,11 @@
 #include "ExternalCalls.h"
 
 #include "hermes/VM/JSArray.h"
+#include "hermes/VM/JSLib.h"
 #include "hermes/VM/JSObject.h"
 #include "hermes/VM/JSRegExp.h"
 #include "hermes/VM/Operations.h"
+#include "hermes/VM/Runtime-inline.h"
 #include "hermes/VM/RuntimeModule-inline.h"
 
 namespace hermes {
@@ -54,7 +56,7 @@ ExecutionStatus externCallDeclareGlobalVar(
              runtime->getCurrentFrame()
                  ->getCalleeCodeBlock()
                  ->getRuntimeModule()
-                 ->getSymbolIDMustExist(stringID),
+                 ->getIdentifierSymbolID(stringID),
              dpf,
              runtime->getUndefinedValue(),
              PropOpFlags().plusThrowOnError())
@@ -110,9 +112,11 @@ ExecutionStatus externPutById(
 
     // If we have a cache hit, reuse the cached offset and immediately
     // return the property.
-    if (LLVM_LIKELY(cacheEntry->clazz == clazz)) {
+    PropertyCacheEntry *way = cacheEntry->find(clazz);
+    if (LLVM_LIKELY(way != nullptr)) {
+      codeBlock->recordPropertyCacheHit();
       JSObject::setNamedSlotValue<PropStorage::Inline::Yes>(
-          obj, runtime, cacheEntry->slot, *prop);
+          obj, runtime, way->slot, *prop);
       return ExecutionStatus::RETURNED;
     }
     auto id = SymbolID::unsafeCreate(sid);
@@ -123,11 +127,11 @@ ExecutionStatus externPutById(
         !desc.flags.internalSetter) {
       // cacheIdx == 0 indicates no caching so don't update the cache in
       // those cases.
-      if (LLVM_LIKELY(!clazz->isDictionary()) &&
+      if (LLVM_LIKELY(clazz->isCacheable()) &&
           LLVM_LIKELY(cacheIdx != hbc::PROPERTY_CACHING_DISABLED)) {
+        codeBlock->recordPropertyCacheMiss(cacheEntry);
         // Cache the class and property slot.
-        cacheEntry->clazz = clazz;
-        cacheEntry->slot = desc.slot;
+        cacheEntry->insert(clazz, desc.slot);
       }
 
       JSObject::setNamedSlotValue(obj, runtime, desc.slot, *prop);
@@ -167,9 +171,11 @@ CallResult<HermesValue> externGetById(
 
     // If we have a cache hit, reuse the cached offset and immediately
     // return the property.
-    if (LLVM_LIKELY(cacheEntry->clazz == clazz)) {
+    PropertyCacheEntry *way = cacheEntry->find(clazz);
+    if (LLVM_LIKELY(way != nullptr)) {
+      codeBlock->recordPropertyCacheHit();
       return JSObject::getNamedSlotValue<PropStorage::Inline::Yes>(
-          obj, runtime, cacheEntry->slot);
+          obj, runtime, way->slot);
     }
     auto id = SymbolID::unsafeCreate(sid);
     NamedPropertyDescriptor desc;
@@ -179,11 +185,11 @@ CallResult<HermesValue> externGetById(
         !desc.flags.accessor) {
       // cacheIdx == 0 indicates no caching so don't update the cache in
       // those cases.
-      if (LLVM_LIKELY(!clazz->isDictionary()) &&
+      if (LLVM_LIKELY(clazz->isCacheable()) &&
           LLVM_LIKELY(cacheIdx != hbc::PROPERTY_CACHING_DISABLED)) {
+        codeBlock->recordPropertyCacheMiss(cacheEntry);
         // Cache the class, id and property slot.
-        cacheEntry->clazz = clazz;
-        cacheEntry->slot = desc.slot;
+        cacheEntry->insert(clazz, desc.slot);
       }
 
       return JSObject::getNamedSlotValue(obj, runtime, desc);
@@ -198,9 +204,12 @@ CallResult<HermesValue> externGetById(
       // having no properties and therefore cannot contain the property.
       // This check does not belong here, it should be merged into
       // tryGetOwnNamedDescriptorFast().
-      if (parent && cacheEntry->clazz == parent->getClass(runtime) &&
+      PropertyCacheEntry *parentWay;
+      if (parent &&
+          (parentWay = cacheEntry->find(parent->getClass(runtime))) &&
           LLVM_LIKELY(!obj->isLazy())) {
-        return JSObject::getNamedSlotValue(parent, runtime, cacheEntry->slot);
+        codeBlock->recordPropertyCacheHit();
+        return JSObject::getNamedSlotValue(parent, runtime, parentWay->slot);
       }
     }
 
@@ -227,7 +236,7 @@ CallResult<HermesValue> externCall(
         Handle<>(callable), " is not a function");
 
   StackFramePtr frame(previousFrame);
-  (void)StackFramePtr::initFrame(
+  auto newFrame = StackFramePtr::initFrame(
       stackPointer,
       frame,
       ip,
@@ -239,7 +248,31 @@ CallResult<HermesValue> externCall(
       argCount - 1,
       *callable,
       HermesValue::encodeUndefinedValue());
+  if (auto *native = dyn_vmcast<NativeFunction>(*callable)) {
+    NativeArgs nativeArgs = newFrame.getNativeArgs();
+    auto dataViewRes = tryDataViewAccessInline(runtime, native, nativeArgs);
+    auto inlined = dataViewRes ? dataViewRes
+                               : tryStringCharCodeAtInline(native, nativeArgs);
+    if (inlined)
+      return *inlined;
+  }
   runtime->storeCallerIP(ip);
+  // Enter an already compiled plain JS function directly instead of
+  // dispatching through its vtable. Compiled code doesn't record code
+  // coverage, so leave that to the interpreter.
+  auto *callee = vmcast<Callable>(*callable);
+  if (callee->getKind() == CellKind::FunctionKind &&
+      LLVM_LIKELY(!runtime->isCodeCoverageEnabled())) {
+    if (auto *jitPtr =
+            vmcast<JSFunction>(callee)->getCodeBlock()->getJITCompiled()) {
+      runtime->getJITContext().noteUse(
+          vmcast<JSFunction>(callee)->getCodeBlock());
+      runtime->potentiallyMoveHeap();
+      auto res = (*jitPtr)(runtime);
+      runtime->clearCallerIP();
+      return res;
+    }
+  }
   auto res = Callable::call(Handle<Callable>::vmcast(callable), runtime);
   runtime->clearCallerIP();
   return res;
@@ -277,6 +310,33 @@ CallResult<HermesValue> externConstruct(
   return res;
 }
 
+CallResult<HermesValue> externCallBuiltin(
+    Runtime *runtime,
+    uint32_t builtinMethodID,
+    uint32_t argCount,
+    PinnedHermesValue *stackPointer,
+    const Inst *ip,
+    PinnedHermesValue *previousFrame) {
+  NativeFunction *nf = runtime->getBuiltinNativeFunction(builtinMethodID);
+  auto newFrame = StackFramePtr::initFrame(
+      stackPointer,
+      StackFramePtr(previousFrame),
+      ip,
+      nullptr, /* SavedCodeBlock */
+      argCount - 1,
+      nf,
+      false);
+  if (auto inlined = Interpreter::tryCallBuiltinInline(
+          builtinMethodID, newFrame.getNativeArgs()))
+    return *inlined;
+
+  GCScopeMarkerRAII marker{runtime};
+  runtime->storeCallerIP(ip);
+  auto res = NativeFunction::_nativeCall(nf, runtime);
+  runtime->clearCallerIP();
+  return res;
+}
+
 /// Implement a slow path call for a binary operator.
 /// \param name the name of the slow path call
 /// \param oper the binary operator to use against numbers.
@@ -341,6 +401,11 @@ HermesValue externTypeOf(Runtime *runtime, PinnedHermesValue *src) {
   }
 }
 
+HermesValue
+externTypeOfIs(Runtime *runtime, PinnedHermesValue *src, uint8_t types) {
+  return HermesValue::encodeBoolValue((typeOfIsType(*src) & types) != 0);
+}
+
 #define PROXY_EXTERN_CMP(slowPathName, OpName)                            \
   CallResult<HermesValue> slowPathName(                                   \
       Runtime *runtime, PinnedHermesValue *op1, PinnedHermesValue *op2) { \
@@ -466,6 +531,16 @@ CallResult<HermesValue> externGetByVal(
     Runtime *runtime,
     PinnedHermesValue *target,
     PinnedHermesValue *nameVal) {
+  // Same fast path as the interpreter, for loops over packed arrays with
+  // integer indices.
+  if (auto *arr = dyn_vmcast<JSArray>(*target)) {
+    OptValue<uint32_t> idx = toArrayIndexFastPath(*nameVal);
+    if (LLVM_LIKELY(
+            idx && *idx < JSArray::getLength(arr) && JSArray::isPacked(arr))) {
+      return arr->at(runtime, *idx);
+    }
+  }
+
   GCScopeMarkerRAII marker{runtime};
 
   if (LLVM_LIKELY(target->isObject())) {
@@ -484,6 +559,16 @@ ExecutionStatus externPutByVal(
     PinnedHermesValue *nameVal,
     PinnedHermesValue *value,
     PropOpFlags flags) {
+  if (auto *arr = dyn_vmcast<JSArray>(*target)) {
+    OptValue<uint32_t> idx = toArrayIndexFastPath(*nameVal);
+    if (LLVM_LIKELY(
+            idx && *idx < JSArray::getLength(arr) && JSArray::isPacked(arr) &&
+            arr->isExtensible())) {
+      JSArray::unsafeSetExistingElementAt(arr, runtime, *idx, *value);
+      return ExecutionStatus::RETURNED;
+    }
+  }
+
   GCScopeMarkerRAII marker{runtime};
 
   if (LLVM_LIKELY(target->isObject())) {
@@ -671,15 +756,30 @@ HermesValue externGetEnvironment(
   return HermesValue::encodeObjectValue(curEnv);
 }
 
+HermesValue externLoadFromOuterEnvironment(
+    Runtime *runtime,
+    PinnedHermesValue *frame,
+    uint32_t numLevel,
+    uint32_t idx) {
+  return vmcast<Environment>(externGetEnvironment(runtime, frame, numLevel))
+      ->slot(idx);
+}
+
 CallResult<HermesValue> externNewObjectWithBuffer(
     Runtime *runtime,
     CodeBlock *curCodeBlock,
     uint32_t numLiterals,
     uint32_t keyBufferIndex,
-    uint32_t valBufferIndex) {
+    uint32_t valBufferIndex,
+    uint32_t offset) {
   GCScopeMarkerRAII marker{runtime};
   return Interpreter::createObjectFromBuffer(
-      runtime, curCodeBlock, numLiterals, keyBufferIndex, valBufferIndex);
+      runtime,
+      curCodeBlock,
+      numLiterals,
+      keyBufferIndex,
+      valBufferIndex,
+      curCodeBlock->getAllocationSite(offset));
 }
 
 CallResult<HermesValue> externNewArrayWithBuffer(
@@ -687,10 +787,16 @@ CallResult<HermesValue> externNewArrayWithBuffer(
     CodeBlock *curCodeBlock,
     uint32_t numElements,
     uint32_t numLiterals,
-    uint32_t bufferIndex) {
+    uint32_t bufferIndex,
+    uint32_t offset) {
   GCScopeMarkerRAII marker{runtime};
   return Interpreter::createArrayFromBuffer(
-      runtime, curCodeBlock, numElements, numLiterals, bufferIndex);
+      runtime,
+      curCodeBlock,
+      numElements,
+      numLiterals,
+      bufferIndex,
+      curCodeBlock->getAllocationSite(offset));
 }
 
 CallResult<HermesValue> slowPathNegate(
@@ -777,6 +883,52 @@ CallResult<HermesValue> externSlowPathGetArgumentsPropByVal(
       isStrict);
 }
 
+CallResult<HermesValue> externCallApplyArguments(
+    Runtime *runtime,
+    PinnedHermesValue *lazyReg,
+    PinnedHermesValue *callee,
+    PinnedHermesValue *thisVal,
+    PinnedHermesValue *thisArg,
+    bool isStrict) {
+  GCScopeMarkerRAII marker{runtime};
+
+  return Interpreter::callApplyArguments_RJS(
+      runtime,
+      lazyReg,
+      Handle<>(callee),
+      Handle<>(thisVal),
+      Handle<>(thisArg),
+      isStrict);
+}
+
+CallResult<HermesValue> externIteratorBegin(
+    Runtime *runtime,
+    PinnedHermesValue *sourceOrNext) {
+  GCScopeMarkerRAII marker{runtime};
+
+  return Interpreter::iteratorBegin_RJS(runtime, sourceOrNext);
+}
+
+CallResult<HermesValue> externIteratorNext(
+    Runtime *runtime,
+    PinnedHermesValue *iterator,
+    PinnedHermesValue *sourceOrNext) {
+  GCScopeMarkerRAII marker{runtime};
+
+  return Interpreter::iteratorNext_RJS(
+      runtime, iterator, Handle<>(sourceOrNext));
+}
+
+ExecutionStatus externIteratorClose(
+    Runtime *runtime,
+    PinnedHermesValue *iterator,
+    bool ignoreInnerException) {
+  GCScopeMarkerRAII marker{runtime};
+
+  return Interpreter::iteratorClose_RJS(
+      runtime, Handle<>(iterator), ignoreInnerException);
+}
+
 CallResult<HermesValue> externSlowPathBitNot(
     Runtime *runtime,
     PinnedHermesValue *op) {
@@ -111,6 +111,21 @@ CallResult<HermesValue> externConstruct(
     Inst const *ip,
     PinnedHermesValue *previousFrame);
 
+/// An external call invoked by JIT compiled code to call a builtin method,
+/// see Interpreter::tryCallBuiltinInline().
+/// \param builtinMethodID the index of the builtin method
+/// \param argCount the count of arguments, including the "thisArg"
+/// \param stackPointer the runtime stack pointer
+/// \param ip the ip in the caller code block to be saved before the call
+/// \param previousFrame the previous frame to be saved before the call
+CallResult<HermesValue> externCallBuiltin(
+    Runtime *runtime,
+    uint32_t builtinMethodID,
+    uint32_t argCount,
+    PinnedHermesValue *stackPointer,
+    Inst const *ip,
+    PinnedHermesValue *previousFrame);
+
 /// An slow path invoked by JIT compiled code to convert operands to number
 /// and do subtraction (op1 - op2)
 CallResult<HermesValue>
@@ -142,6 +157,12 @@ HermesValue externLoadConstStringMayAllocate(
 /// given hermes register \p src.
 HermesValue externTypeOf(Runtime *runtime, PinnedHermesValue *src);
 
+/// An external call invoked by JIT compiled code to \return whether the JS
+/// type of a given hermes register \p src is one of the inst::TypeOfIsTypes
+/// bits in \p types.
+HermesValue
+externTypeOfIs(Runtime *runtime, PinnedHermesValue *src, uint8_t types);
+
 /// An slow path invoked by JIT compiled code to call Operation::lessOp
 CallResult<HermesValue>
 slowPathLess(Runtime *runtime, PinnedHermesValue *op1, PinnedHermesValue *op2);
@@ -302,23 +323,36 @@ HermesValue externGetEnvironment(
     PinnedHermesValue *frame,
     uint32_t numLevel);
 
+/// An external call invoked by JIT compiled code to \return the value in slot
+/// \p idx of the environment \p numLevel levels up the stack, as in
+/// externGetEnvironment().
+HermesValue externLoadFromOuterEnvironment(
+    Runtime *runtime,
+    PinnedHermesValue *frame,
+    uint32_t numLevel,
+    uint32_t idx);
+
 /// A wrapper to call Interpreter::createObjectFromBuffer, so that we could add
-/// GC scope marker before the call.
+/// GC scope marker before the call.  \p offset is the bytecode offset of the
+/// instruction, which identifies its allocation site.
 CallResult<HermesValue> externNewObjectWithBuffer(
     Runtime *runtime,
     CodeBlock *curCodeBlock,
     uint32_t numLiterals,
     uint32_t keyBufferIndex,
-    uint32_t valBufferIndex);
+    uint32_t valBufferIndex,
+    uint32_t offset);
 
 /// A wrapper to call Interpreter::createArrayFromBuffer, so that we could add
-/// GC scope marker before the call.
+/// GC scope marker before the call.  \p offset is the bytecode offset of the
+/// instruction, which identifies its allocation site.
 CallResult<HermesValue> externNewArrayWithBuffer(
     Runtime *runtime,
     CodeBlock *curCodeBlock,
     uint32_t numElements,
     uint32_t numLiterals,
-    uint32_t bufferIndex);
+    uint32_t bufferIndex,
+    uint32_t offset);
 
 /// A slow path invoked by JIT compiled code to do unary minus
 /// \return -op1
@@ -356,6 +390,36 @@ CallResult<HermesValue> externSlowPathGetArgumentsPropByVal(
     PinnedHermesValue *currentFrame,
     bool isStrict);
 
+/// An external call invoked by JIT compiled code to implement
+/// CallApplyArguments, see Interpreter::callApplyArguments_RJS().
+CallResult<HermesValue> externCallApplyArguments(
+    Runtime *runtime,
+    PinnedHermesValue *lazyReg,
+    PinnedHermesValue *callee,
+    PinnedHermesValue *thisVal,
+    PinnedHermesValue *thisArg,
+    bool isStrict);
+
+/// An external call invoked by JIT compiled code to implement IteratorBegin,
+/// see Interpreter::iteratorBegin_RJS().
+CallResult<HermesValue> externIteratorBegin(
+    Runtime *runtime,
+    PinnedHermesValue *sourceOrNext);
+
+/// An external call invoked by JIT compiled code to implement IteratorNext,
+/// see Interpreter::iteratorNext_RJS().
+CallResult<HermesValue> externIteratorNext(
+    Runtime *runtime,
+    PinnedHermesValue *iterator,
+    PinnedHermesValue *sourceOrNext);
+
+/// An external call invoked by JIT compiled code to implement IteratorClose,
+/// see Interpreter::iteratorClose_RJS().
+ExecutionStatus externIteratorClose(
+    Runtime *runtime,
+    PinnedHermesValue *iterator,
+    bool ignoreInnerException);
+
 /// A slow path invoked by JIT compiled code to do bitwise not
 /// \return ~op
 CallResult<HermesValue> externSlowPathBitNot(
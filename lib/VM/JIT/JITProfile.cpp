@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/VM/JIT/JITProfile.h"
+
+#include "hermes/VM/CodeBlock.h"
+#include "hermes/VM/RuntimeModule.h"
+
+#include "llvm/ADT/Optional.h"
+
+#include <cstring>
+
+namespace hermes {
+namespace vm {
+
+constexpr uint32_t JITProfile::kMagic;
+constexpr uint32_t JITProfile::kVersion;
+
+/// \return the source hash of the file of \p codeBlock, or None if it has
+///   none, in which case the function can't be identified across runs.
+static llvm::Optional<SHA1> fileHashOf(const CodeBlock *codeBlock) {
+  if (codeBlock->isLazy())
+    return llvm::None;
+  SHA1 hash = codeBlock->getRuntimeModule()->getBytecode()->getSourceHash();
+  if (hash == SHA1{})
+    return llvm::None;
+  return hash;
+}
+
+/// \return the FNV-1a hash of the bytecode of \p codeBlock, which detects
+///   functions whose ID now refers to different code.
+static uint32_t checksumOf(const CodeBlock *codeBlock) {
+  uint32_t hash = 2166136261u;
+  for (uint8_t byte : codeBlock->getOpcodeArray()) {
+    hash ^= byte;
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+static void appendUInt32(std::vector<uint8_t> &out, uint32_t value) {
+  const auto *bytes = reinterpret_cast<const uint8_t *>(&value);
+  out.insert(out.end(), bytes, bytes + sizeof(value));
+}
+
+/// Read a uint32_t from the start of \p data and drop it.
+/// \return false if \p data is too short.
+static bool readUInt32(llvm::ArrayRef<uint8_t> &data, uint32_t &value) {
+  if (data.size() < sizeof(value))
+    return false;
+  std::memcpy(&value, data.data(), sizeof(value));
+  data = data.drop_front(sizeof(value));
+  return true;
+}
+
+bool JITProfile::deserialize(llvm::ArrayRef<uint8_t> data) {
+  files_.clear();
+  uint32_t magic, version, numFiles;
+  if (!readUInt32(data, magic) || magic != kMagic ||
+      !readUInt32(data, version) || version != kVersion ||
+      !readUInt32(data, numFiles))
+    return false;
+  for (uint32_t i = 0; i < numFiles; ++i) {
+    SHA1 hash;
+    uint32_t numFunctions;
+    if (data.size() < hash.size()) {
+      files_.clear();
+      return false;
+    }
+    std::copy(data.begin(), data.begin() + hash.size(), hash.begin());
+    data = data.drop_front(hash.size());
+    if (!readUInt32(data, numFunctions) ||
+        data.size() / (2 * sizeof(uint32_t)) < numFunctions) {
+      files_.clear();
+      return false;
+    }
+    FunctionMap &functions = files_[hash];
+    for (uint32_t j = 0; j < numFunctions; ++j) {
+      uint32_t functionID, checksum;
+      readUInt32(data, functionID);
+      readUInt32(data, checksum);
+      functions[functionID] = checksum;
+    }
+  }
+  if (!data.empty()) {
+    files_.clear();
+    return false;
+  }
+  return true;
+}
+
+void JITProfile::serialize(std::vector<uint8_t> &out) const {
+  appendUInt32(out, kMagic);
+  appendUInt32(out, kVersion);
+  appendUInt32(out, files_.size());
+  for (const auto &file : files_) {
+    out.insert(out.end(), file.first.begin(), file.first.end());
+    appendUInt32(out, file.second.size());
+    for (const auto &function : file.second) {
+      appendUInt32(out, function.first);
+      appendUInt32(out, function.second);
+    }
+  }
+}
+
+void JITProfile::add(const CodeBlock *codeBlock) {
+  if (auto hash = fileHashOf(codeBlock))
+    files_[*hash][codeBlock->getFunctionID()] = checksumOf(codeBlock);
+}
+
+bool JITProfile::contains(const CodeBlock *codeBlock) const {
+  auto hash = fileHashOf(codeBlock);
+  if (!hash)
+    return false;
+  auto fileIt = files_.find(*hash);
+  if (fileIt == files_.end())
+    return false;
+  auto it = fileIt->second.find(codeBlock->getFunctionID());
+  return it != fileIt->second.end() && it->second == checksumOf(codeBlock);
+}
+
+} // namespace vm
+} // namespace hermes
@@ -49,6 +49,15 @@ void *PoolHeap::alloc(size_t size) {
   return nullptr;
 }
 
+bool PoolHeap::canAlloc(size_t size) const {
+  size = llvm::alignTo<kAlignment>(size);
+  for (const auto &block : freeList_) {
+    if (block.second >= size)
+      return true;
+  }
+  return false;
+}
+
 void PoolHeap::freeRemaining(void *block, size_t keepSize) {
   assert(block && "block must be valid");
 
@@ -4,8 +4,8 @@
  * This source code is licensed under the MIT license found in the LICENSE
  * file in the root directory of this source tree.
  */
-#ifndef HERMES_VM_JIT_X86_64_RUNTIMEOFFSETS_H
-#define HERMES_VM_JIT_X86_64_RUNTIMEOFFSETS_H
+#ifndef HERMES_VM_JIT_RUNTIMEOFFSETS_H
+#define HERMES_VM_JIT_RUNTIMEOFFSETS_H
 
 #include "hermes/VM/Runtime.h"
 
@@ -20,6 +20,11 @@ struct RuntimeOffsets {
   static constexpr uint32_t currentFrame = offsetof(Runtime, currentFrame_);
   static constexpr uint32_t globalObject = offsetof(Runtime, global_);
   static constexpr uint32_t thrownValue = offsetof(Runtime, thrownValue_);
+
+  /// Fields of JSObject read by the inline property cache checks.
+  static constexpr uint32_t objectClass = offsetof(JSObject, clazz_);
+  static constexpr uint32_t objectDirectProps =
+      offsetof(JSObject, directProps_);
 };
 
 #pragma GCC diagnostic pop
@@ -27,4 +32,4 @@ struct RuntimeOffsets {
 } // namespace vm
 } // namespace hermes
 
-#endif // HERMES_VM_JIT_X86_64_RUNTIMEOFFSETS_H
+#endif // HERMES_VM_JIT_RUNTIMEOFFSETS_H
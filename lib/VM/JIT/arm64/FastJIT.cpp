@@ -0,0 +1,2408 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "FastJIT.h"
+
+#include "../ExternalCalls.h"
+#include "../RuntimeOffsets.h"
+#include "hermes/Inst/InstDecode.h"
+#include "hermes/VM/JIT/DiscoverBB.h"
+#include "hermes/VM/Operations.h"
+
+#define DEBUG_TYPE "jit"
+
+namespace hermes {
+namespace vm {
+namespace arm64 {
+using hermes::inst::Inst;
+
+/// Size of the native stack frame: the frame record (x29, x30), the two
+/// callee-saved registers we use, and the saved runtime->currentFrame_,
+/// rounded up to keep sp 16-byte aligned.
+static constexpr int32_t kNativeFrameSize = 48;
+/// Offset of the saved callee-saved registers in the native frame.
+static constexpr int32_t kSavedRegsOffset = 16;
+/// Offset of the saved runtime->currentFrame_ in the native frame.
+static constexpr int32_t kSavedCurrentFrameOffset = 32;
+
+FastJIT::FastJIT(JITContext *context, CodeBlock *codeBlock)
+    : context_(context), codeBlock_(codeBlock) {}
+
+void FastJIT::compile() {
+  LLVM_DEBUG(
+      llvm::dbgs() << "JIT compilation of FunctionID "
+                   << codeBlock_->getFunctionID() << "\n");
+
+  discoverBasicBlocks(
+      codeBlock_, bcBasicBlocks_, bcLabels_, &bcLoopHeaders_);
+
+  ExecHeap::SizePair sizes;
+  auto blocks = allocCode(codeBlock_->getOpcodeArray().size(), sizes);
+  if (!blocks)
+    return;
+
+  fast_ = llvm::makeMutableArrayRef(blocks->first, sizes.first);
+  slow_ = llvm::makeMutableArrayRef(blocks->second, sizes.second);
+
+  Emitters emit{Emitter{fast_.begin()}, Emitter{slow_.begin()}};
+  emit = emitPrologue(emit);
+
+  nativeBBAddress_.resize(bcBasicBlocks_.size());
+
+  // Compile every basic block and record its starting address.
+  unsigned bcBasicBlocksCount = bcBasicBlocks_.size() - 1;
+  for (curBytecodeBBIndex_ = 0; curBytecodeBBIndex_ != bcBasicBlocksCount;
+       ++curBytecodeBBIndex_) {
+    nativeBBAddress_[curBytecodeBBIndex_] = emit.fast.current();
+
+    emit = compileBB(emit);
+  }
+
+  // Emit the function epilogue.
+  nativeBBAddress_[curBytecodeBBIndex_] = emit.fast.current();
+  emit = emitEpilogue(emit);
+  emit = emitOSREntries(emit);
+
+  resolveRelocations();
+
+  LLVM_DEBUG(disassembleResult(emit, llvm::dbgs(), true));
+  if (context_->getDumpJITCode())
+    disassembleResult(emit, llvm::outs(), false);
+
+  ExecHeap::SizePair used{0, 0};
+  if (!error_) {
+    used = {emit.fast.current() - fast_.data(),
+            emit.slow.current() - slow_.data()};
+  }
+  // The pool may contain other functions which are currently on the stack, so
+  // it must become executable again even if this compilation failed.
+  if (!context_->getHeap().makeExecutable(*blocks, used))
+    hermes_fatal("cannot make JIT code executable");
+
+  if (!error_) {
+    context_->getHeap().freeRemaining(*blocks, used);
+    context_->getCodeCache().add(codeBlock_, *blocks, used);
+    for (unsigned i = 0, e = bcLoopHeaders_.size(); i != e; ++i) {
+      codeBlock_->setOSREntry(
+          bcBasicBlocks_[bcLoopHeaders_[i]],
+          (JITCompiledFunctionPtr)nativeOSREntryAddress_[i]);
+    }
+    codeBlock_->setJITCompiled((JITCompiledFunctionPtr)fast_.data());
+
+    // Dump the heap at the end.
+    LLVM_DEBUG(context_->getHeap().dump(llvm::dbgs()));
+  } else {
+    context_->getHeap().free(*blocks);
+    if (context_->getCrashOnError()) {
+      hermes_fatal(errorMsg_.c_str());
+    }
+  }
+}
+
+void FastJIT::error(const llvm::Twine &msg) {
+  if (!error_)
+    codeBlock_->setDontJIT(true);
+  error_ = true;
+  if (errorMsg_.empty())
+    errorMsg_ = msg.str();
+  LLVM_DEBUG(llvm::dbgs() << "FastJIT error: " << msg << "\n");
+}
+
+ExecHeap::SizePair FastJIT::estimateSizes(size_t bytecodeLength) {
+  // A64 instructions are larger than their x86-64 counterparts on average,
+  // so reserve more space per bytecode byte.
+  return {bytecodeLength * 64 + kMinInstructionSpace,
+          bytecodeLength * 64 + kMinInstructionSpace};
+}
+
+llvm::Optional<ExecHeap::BlockPair> FastJIT::allocCode(
+    size_t bytecodeLength,
+    ExecHeap::SizePair &sizes) {
+  sizes = estimateSizes(bytecodeLength);
+
+  auto blocks = context_->getHeap().alloc(sizes);
+  // If the allocation failed, add a new pool, initialize it and retry.
+  if (!blocks) {
+    auto newPool = context_->getHeap().addPool();
+    if (!newPool) {
+      error("out of executable memory");
+      return llvm::None;
+    }
+    initializeNewPool(newPool);
+
+    blocks = newPool->alloc(sizes);
+    if (!blocks) {
+      error("bytecode size too large");
+      return llvm::None;
+    }
+  }
+
+  assert(blocks && "allocation should have succeeded");
+  if (!context_->getHeap().makeWritable(*blocks)) {
+    context_->getHeap().free(*blocks);
+    error("cannot make executable memory writable");
+    return llvm::None;
+  }
+  return blocks;
+}
+
+void FastJIT::initializeNewPool(ExecHeap::DualPool *pool) {}
+
+void FastJIT::disassembleRange(
+    const uint8_t *from,
+    const uint8_t *to,
+    llvm::raw_ostream &OS,
+    bool withAddr) const {
+  if (to != from) {
+    context_->getDisassembler().disassembleBuffer(
+        OS, {from, to}, from - fast_.data(), withAddr);
+  }
+}
+
+void FastJIT::disassembleResult(
+    Emitters emit,
+    llvm::raw_ostream &OS,
+    bool withAddr) const {
+  OS << "\n\nCompiled Code of FunctionID: " << codeBlock_->getFunctionID()
+     << "\n";
+  auto *last = fast_.data();
+
+  for (size_t i = 0; i < nativeBBAddress_.size(); ++i) {
+    disassembleRange(last, nativeBBAddress_[i], OS, withAddr);
+    last = nativeBBAddress_[i];
+    OS << "BB" << i << ":\n";
+  }
+  disassembleRange(last, emit.fast.current(), OS, withAddr);
+
+#ifndef NDEBUG
+  OS << "\n;SLOW PATHS\n";
+
+  for (const auto sec : slowPathSections_) {
+    if (sec.data)
+      continue;
+    disassembleRange(sec.start, sec.end, OS, withAddr);
+    OS << "\n";
+  }
+#endif
+}
+
+void FastJIT::applyRelocation(const Relo &relo, const uint8_t *target) {
+  switch (relo.kind) {
+    case ReloKind::Branch26:
+      assert(
+          Emitter::inBranchRange(26, relo.address, target) &&
+          "branch26 relocation overflow");
+      Emitter::patchBranch(relo.address, target);
+      break;
+
+    case ReloKind::Branch19:
+      assert(
+          Emitter::inBranchRange(19, relo.address, target) &&
+          "branch19 relocation overflow");
+      Emitter::patchBranch(relo.address, target);
+      break;
+
+    case ReloKind::None:
+      llvm_unreachable("ReloKind::None can not be relocated. ");
+  }
+}
+
+void FastJIT::resolveRelocations() {
+  for (const auto &relo : relocs_)
+    applyRelocation(relo, nativeBBAddress_[relo.targetBCBBIndex]);
+  relocs_.clear();
+}
+
+#ifndef NDEBUG
+void FastJIT::describeSlowPathSection(Emitter slow, bool data) {
+  const uint8_t *last =
+      slowPathSections_.empty() ? slow_.data() : slowPathSections_.back().end;
+
+  if (slow.current() <= last)
+    return;
+
+  // Merge data sections together.
+  if (data && !slowPathSections_.empty() &&
+      slowPathSections_.back().data == data)
+    slowPathSections_.back().end = slow.current();
+  else
+    slowPathSections_.emplace_back(data, last, slow.current());
+}
+#endif
+
+template <W w>
+Emitter FastJIT::ldrMem(Emitter emit, Reg reg, Reg base, int32_t offset) {
+  constexpr int32_t size = w == W::Q ? 8 : 4;
+  if (offset >= 0 && offset % size == 0 && offset / size < 4096) {
+    emit.ldrImm<w>(reg, base, offset);
+  } else if (isIntN(9, offset)) {
+    emit.ldur<w>(reg, base, offset);
+  } else {
+    emit.movImm(RegOffset, (int64_t)offset);
+    emit.ldrReg<w>(reg, base, RegOffset);
+  }
+  return emit;
+}
+
+template <W w>
+Emitter FastJIT::strMem(Emitter emit, Reg reg, Reg base, int32_t offset) {
+  constexpr int32_t size = w == W::Q ? 8 : 4;
+  if (offset >= 0 && offset % size == 0 && offset / size < 4096) {
+    emit.strImm<w>(reg, base, offset);
+  } else if (isIntN(9, offset)) {
+    emit.stur<w>(reg, base, offset);
+  } else {
+    emit.movImm(RegOffset, (int64_t)offset);
+    emit.strReg<w>(reg, base, RegOffset);
+  }
+  return emit;
+}
+
+Emitter FastJIT::ldrMem(Emitter emit, FReg reg, Reg base, int32_t offset) {
+  if (offset >= 0 && offset % 8 == 0 && offset / 8 < 4096) {
+    emit.ldrfpImm(reg, base, offset);
+  } else if (isIntN(9, offset)) {
+    emit.ldurfp(reg, base, offset);
+  } else {
+    emit.movImm(RegOffset, (int64_t)offset);
+    emit.ldrfpReg(reg, base, RegOffset);
+  }
+  return emit;
+}
+
+Emitter FastJIT::strMem(Emitter emit, FReg reg, Reg base, int32_t offset) {
+  if (offset >= 0 && offset % 8 == 0 && offset / 8 < 4096) {
+    emit.strfpImm(reg, base, offset);
+  } else if (isIntN(9, offset)) {
+    emit.sturfp(reg, base, offset);
+  } else {
+    emit.movImm(RegOffset, (int64_t)offset);
+    emit.strfpReg(reg, base, RegOffset);
+  }
+  return emit;
+}
+
+Emitter FastJIT::addOffset(Emitter emit, Reg reg, Reg base, int32_t offset) {
+  if (offset >= 0 && isAddSubImm(offset)) {
+    emit.addImm(reg, base, offset);
+  } else if (offset < 0 && isAddSubImm(-(int64_t)offset)) {
+    emit.subImm(reg, base, -offset);
+  } else {
+    emit.movImm(RegOffset, (int64_t)offset);
+    emit.addReg(reg, base, RegOffset);
+  }
+  return emit;
+}
+
+Emitters FastJIT::emitPrologue(Emitters emit, bool clearRegisters) {
+  if (!checkSpace(emit))
+    return emit;
+
+  // Push the frame record and save the callee-saved registers.
+  emit.fast.stpPre(Reg::x29, Reg::x30, Reg::sp, -kNativeFrameSize);
+  emit.fast.movSP(Reg::sp, Reg::x29);
+  emit.fast.stp(RegRuntime, RegFrame, Reg::sp, kSavedRegsOffset);
+
+  // Move the first parameter (Runtime *) into its register.
+  emit.fast.movRegToReg(Reg::x0, RegRuntime);
+
+  // Save runtime->currentFrame in the native frame.
+  emit.fast =
+      ldrMem(emit.fast, Reg::x9, RegRuntime, RuntimeOffsets::currentFrame);
+  emit.fast.strImm(Reg::x9, Reg::sp, kSavedCurrentFrameOffset);
+
+  // Load runtime->stackPointer_ top into RegFrame
+  emit.fast =
+      ldrMem(emit.fast, RegFrame, RegRuntime, RuntimeOffsets::stackPointer);
+  // Store RegFrame into runtime->currentFrame_.
+  emit.fast =
+      strMem(emit.fast, RegFrame, RegRuntime, RuntimeOffsets::currentFrame);
+
+  // Allocate and clear registers for the frame and update the top of the stack.
+  // runtime->stackPointer = RegFrame - 8*numRegsNeeded.
+  const int numRegsNeeded = codeBlock_->getFrameSize() +
+      StackFrameLayout::CalleeExtraRegistersAtStart;
+  emit.fast = addOffset(
+      emit.fast,
+      Reg::x10,
+      RegFrame,
+      -(int32_t)sizeof(HermesValue) * numRegsNeeded);
+  if (clearRegisters) {
+    emit = loadConstantIntoNativeReg(
+        emit, HermesValue::encodeUndefinedValue(), Reg::x9);
+    int i = 0;
+    // STP reaches 64 registers from the new top of the stack.
+    for (; i + 1 < numRegsNeeded && i < 64; i += 2)
+      emit.fast.stp(Reg::x9, Reg::x9, Reg::x10, i * sizeof(HermesValue));
+    for (; i < numRegsNeeded; ++i)
+      emit.fast =
+          strMem(emit.fast, Reg::x9, Reg::x10, i * sizeof(HermesValue));
+  }
+  emit.fast =
+      strMem(emit.fast, Reg::x10, RegRuntime, RuntimeOffsets::stackPointer);
+
+  return emit;
+}
+
+Emitters FastJIT::emitEpilogue(Emitters emit) {
+  if (!checkSpace(emit))
+    return emit;
+
+  // The result is in w0 (status) and x1 (value) and must be preserved.
+
+  // Restore the VM stack pointer: runtime->stackPointer = RegFrame.
+  emit.fast =
+      strMem(emit.fast, RegFrame, RegRuntime, RuntimeOffsets::stackPointer);
+
+  // Restore runtime->currentFrame_ from the native frame.
+  emit.fast.ldrImm(Reg::x9, Reg::sp, kSavedCurrentFrameOffset);
+  emit.fast =
+      strMem(emit.fast, Reg::x9, RegRuntime, RuntimeOffsets::currentFrame);
+
+  // Restore callee saved registers and pop the frame record.
+  emit.fast.ldp(RegRuntime, RegFrame, Reg::sp, kSavedRegsOffset);
+  emit.fast.ldpPost(Reg::x29, Reg::x30, Reg::sp, kNativeFrameSize);
+  emit.fast.ret();
+
+  return emit;
+}
+
+// Calculate the address of the next instruction given the name of the current
+// one.
+#define NEXTINST(name) ((const Inst *)(&ip->i##name + 1))
+
+Emitters FastJIT::compileBB(Emitters emit) {
+  auto *ip = reinterpret_cast<const Inst *>(
+      codeBlock_->begin() + bcBasicBlocks_[curBytecodeBBIndex_]);
+  auto *to = reinterpret_cast<const Inst *>(
+      codeBlock_->begin() + bcBasicBlocks_[curBytecodeBBIndex_ + 1]);
+
+  while (ip != to) {
+    if (!checkSpace(emit))
+      return emit;
+
+    LLVM_DEBUG(llvm::dbgs() << ";   " << decodeInstruction(ip) << "\n");
+#ifndef NDEBUG
+    auto sav = emit;
+#endif
+
+    switch (ip->opCode) {
+#define CASE(name)                  \
+  case OpCode::name:                \
+    emit = compile##name(emit, ip); \
+    ip = NEXTINST(name);            \
+    break
+
+/// Implement a comparison jump with a fast path, a slow path, and a long
+/// version \param name the name of the instruction. The fast path case will
+/// have a
+///     "N" appended to the name.
+/// \param suffix  Optional suffix to be added to the end (e.g. Long)
+/// \param cc the condition indicating when to jump after FCMP.
+/// \param slowPathCall function to call for the slow-path comparison.
+#define JCOND_IMPL(name, suffix, cc, slowPathCall) \
+  case OpCode::name##suffix:                       \
+    emit = compileCondJump(                        \
+        emit,                                      \
+        ip,                                        \
+        ip->i##name##suffix.op1,                   \
+        ip->i##name##suffix.op2,                   \
+        ip->i##name##suffix.op3,                   \
+        cc,                                        \
+        (void *)slowPathCall);                     \
+    ip = NEXTINST(name##suffix);                   \
+    break;                                         \
+  case OpCode::name##N##suffix:                    \
+    emit = compileCondJumpN(                       \
+        emit,                                      \
+        ip,                                        \
+        ip->i##name##N##suffix.op1,                \
+        ip->i##name##N##suffix.op2,                \
+        ip->i##name##N##suffix.op3,                \
+        cc);                                       \
+    ip = NEXTINST(name##N##suffix);                \
+    break
+
+#define JCOND(name, cc, slowPathCall)   \
+  JCOND_IMPL(name, , cc, slowPathCall); \
+  JCOND_IMPL(name, Long, cc, slowPathCall);
+
+/// Implement a jump based on equality test and its long version
+/// \param name the name of the instruction.
+/// \param cc the condition indicating when to jump.
+/// \param compilation the compilation function for this instruction.
+#define JEQ(name, cc, compilation)                                            \
+  case OpCode::name: {                                                        \
+    emit = compilation(                                                       \
+        emit, ip, ip->i##name.op1, ip->i##name.op2, ip->i##name.op3, cc);     \
+    ip = NEXTINST(name);                                                      \
+    break;                                                                    \
+  }                                                                           \
+  case OpCode::name##Long: {                                                  \
+    emit = compilation(                                                       \
+        emit,                                                                 \
+        ip,                                                                   \
+        ip->i##name##Long.op1,                                                \
+        ip->i##name##Long.op2,                                                \
+        ip->i##name##Long.op3,                                                \
+        cc);                                                                  \
+    ip = NEXTINST(name##Long);                                                \
+    break;                                                                    \
+  }
+
+/// Implement a bool jump instruction and its long version.
+/// \param name the name of the instruction.
+/// \param cc the condition indicating when to jump.
+#define JBOOL(name, cc)                                                     \
+  case OpCode::name:                                                        \
+    emit = compileBoolJmp(emit, ip, ip->i##name.op1, ip->i##name.op2, cc);  \
+    ip = NEXTINST(name);                                                    \
+    break;                                                                  \
+  case OpCode::name##Long:                                                  \
+    emit = compileBoolJmp(                                                  \
+        emit, ip, ip->i##name##Long.op1, ip->i##name##Long.op2, cc);        \
+    ip = NEXTINST(name##Long);                                              \
+    break
+
+#define BINOP(name)                                                    \
+  case OpCode::name:                                                   \
+    emit = compileBinOp(                                               \
+        emit, ip, (void *)slowPath##name, &FastJIT::compile##name##N); \
+    ip = NEXTINST(name);                                               \
+    break
+
+#define COND_OP(name, cc)                                       \
+  case OpCode::name:                                            \
+    emit = compileCondOp(emit, ip, cc, (void *)slowPath##name); \
+    ip = NEXTINST(name);                                        \
+    break;                                                      \
+  case OpCode::name##N:                                         \
+    emit = compileCondOpN(emit, ip, cc);                        \
+    ip = NEXTINST(name##N);                                     \
+    break
+
+#define LOAD_CONST_STRING(name)                               \
+  case OpCode::name:                                          \
+    emit = compileLoadConstString(emit, ip, ip->i##name.op2); \
+    ip = NEXTINST(name);                                      \
+    break
+
+#define LOAD_CONST_INT(name, val)                               \
+  case OpCode::name:                                            \
+    emit = loadHermesValueConstant(emit, ip->i##name.op1, val); \
+    ip = NEXTINST(name);                                        \
+    break
+
+#define EQ_TEST(name, isNeq)                     \
+  case OpCode::name:                             \
+    emit = compileEqTest(emit, ip, isNeq);       \
+    ip = NEXTINST(name);                         \
+    break;                                       \
+  case OpCode::Strict##name:                     \
+    emit = compileStrictEqTest(emit, ip, isNeq); \
+    ip = NEXTINST(Strict##name);                 \
+    break
+
+/// Compile an instruction and its long or short version.
+/// It can only be used when the variable length operand is the last operand,
+/// otherwise the offsets of other operands are wrong.
+/// \param name the name of the short version instruction.
+/// \param suffix  Optional suffix to be added to the end (e.g. Long, Short, L)
+/// \param op the variable length operand, it could be UInt8/16/32, or Addr8/32
+#define CASE_WITH_SUFFIX(name, suffix, op)                  \
+  case OpCode::name##suffix:                                \
+    emit = compile##name(emit, ip, ip->i##name##suffix.op); \
+    ip = NEXTINST(name##suffix);                            \
+    break
+
+/// Compile instructions with the layout (name, Reg8, Reg8, Reg8)
+#define CASE_3REG(name)                                      \
+  case OpCode::name:                                         \
+    emit = compile3RegsInst(emit, ip, (void *)extern##name); \
+    ip = NEXTINST(name);                                     \
+    break
+
+      CASE(DeclareGlobalVar);
+      CASE(CreateEnvironment);
+      CASE(CreateClosure);
+      CASE(GetGlobalObject);
+      CASE(PutById);
+      CASE(PutByIdShort);
+      CASE(TryPutById);
+      CASE(PutByIdLong);
+      CASE(TryPutByIdLong);
+      CASE(GetById);
+      CASE(GetByIdLong);
+      CASE(GetByIdShort);
+      CASE(TryGetById);
+      CASE(TryGetByIdLong);
+      CASE(Call);
+      CASE(CallLong);
+      CASE(Construct);
+      CASE(ConstructLong);
+      CASE(CallBuiltin);
+      CASE(LoadConstZero);
+      LOAD_CONST_STRING(LoadConstString);
+      LOAD_CONST_STRING(LoadConstStringLongIndex);
+      CASE(LoadParam);
+      BINOP(Add);
+      CASE(AddN);
+      BINOP(Sub);
+      CASE(SubN);
+      BINOP(Mul);
+      CASE(MulN);
+      BINOP(Div);
+      CASE(DivN);
+      CASE(TypeOf);
+      CASE(TypeOfIs);
+      CASE(Mov);
+      CASE(MovLong);
+      CASE(ToNumber);
+      CASE(AddEmptyString);
+      CASE(Ret);
+
+      // FCMP sets C and V for unordered operands, so the "not" forms must
+      // jump on NaN and the others must not.
+      JCOND(JLess, Cond::MI, slowPathLess);
+      JCOND(JLessEqual, Cond::LS, slowPathLessEq);
+      JCOND(JGreater, Cond::GT, slowPathGreater);
+      JCOND(JGreaterEqual, Cond::GE, slowPathGreaterEq);
+      JCOND(JNotLess, Cond::PL, slowPathGreaterEq);
+      JCOND(JNotLessEqual, Cond::HI, slowPathGreater);
+      JCOND(JNotGreater, Cond::LE, slowPathLessEq);
+      JCOND(JNotGreaterEqual, Cond::LT, slowPathLess);
+
+      // JEqual jumps when the equality test returns non-zero (true)
+      JEQ(JEqual, Cond::NE, compileEqJump);
+      // JNotEqual jumps when the equality test returns zero (false)
+      JEQ(JNotEqual, Cond::EQ, compileEqJump);
+      JEQ(JStrictEqual, Cond::NE, compileStrictEqJump);
+      JEQ(JStrictNotEqual, Cond::EQ, compileStrictEqJump);
+
+      // JmpTrue jumps when the operand register is non-zero (true)
+      JBOOL(JmpTrue, Cond::NE);
+      // JmpFalse jumps when the equality test returns zero (false)
+      JBOOL(JmpFalse, Cond::EQ);
+      CASE_WITH_SUFFIX(Jmp, , op1);
+      CASE_WITH_SUFFIX(Jmp, Long, op1);
+      CASE(JmpUndefined);
+      CASE(JmpUndefinedLong);
+
+      EQ_TEST(Eq, /*isNeq*/ false);
+      EQ_TEST(Neq, /*isNeq*/ true);
+
+      COND_OP(Less, Cond::MI);
+      COND_OP(LessEq, Cond::LS);
+      COND_OP(Greater, Cond::GT);
+      COND_OP(GreaterEq, Cond::GE);
+
+      LOAD_CONST_INT(
+          LoadConstInt, HermesValue::encodeDoubleValue(ip->iLoadConstInt.op2));
+      LOAD_CONST_INT(
+          LoadConstUInt8,
+          HermesValue::encodeDoubleValue(ip->iLoadConstUInt8.op2));
+      LOAD_CONST_INT(
+          LoadConstDouble,
+          HermesValue::encodeDoubleValue(ip->iLoadConstDouble.op2));
+      LOAD_CONST_INT(LoadConstUndefined, HermesValue::encodeUndefinedValue());
+      LOAD_CONST_INT(LoadConstTrue, HermesValue::encodeBoolValue(true));
+      LOAD_CONST_INT(LoadConstFalse, HermesValue::encodeBoolValue(false));
+      LOAD_CONST_INT(LoadConstNull, HermesValue::encodeNullValue());
+
+      CASE(NewObject);
+      CASE_3REG(CreateThis);
+      CASE(SelectObject);
+      CASE(NewArray);
+      CASE_WITH_SUFFIX(NewArrayWithBuffer, , op4);
+      CASE_WITH_SUFFIX(NewArrayWithBuffer, Long, op4);
+      CASE_WITH_SUFFIX(PutOwnByIndex, , op3);
+      CASE_WITH_SUFFIX(PutOwnByIndex, L, op3);
+      CASE_WITH_SUFFIX(PutNewOwnById, , op3);
+      CASE_WITH_SUFFIX(PutNewOwnById, Short, op3);
+      CASE_WITH_SUFFIX(PutNewOwnById, Long, op3);
+      CASE(LoadThisNS);
+      CASE(CoerceThisNS);
+      CASE(Throw);
+      CASE(NewObjectWithBuffer);
+      CASE(NewObjectWithBufferLong);
+      CASE_3REG(GetByVal);
+      CASE(PutByVal);
+      CASE(DelByVal);
+      CASE(StoreToEnvironment);
+      CASE(StoreToEnvironmentL);
+      CASE(StoreNPToEnvironment);
+      CASE(StoreNPToEnvironmentL);
+      CASE_WITH_SUFFIX(LoadFromEnvironment, , op3);
+      CASE_WITH_SUFFIX(LoadFromEnvironment, L, op3);
+      CASE(LoadFromOuterEnvironment);
+      CASE_3REG(Mod);
+      CASE(Not);
+      CASE_3REG(LShift);
+      CASE_3REG(RShift);
+      CASE_3REG(URshift);
+      CASE_3REG(BitAnd);
+      CASE_3REG(BitOr);
+      CASE_3REG(BitXor);
+      CASE(GetEnvironment);
+      CASE(Catch);
+      CASE(Negate);
+      CASE(GetPNameList);
+      CASE(GetNextPName);
+      CASE(IteratorBegin);
+      CASE(IteratorNext);
+      CASE(IteratorClose);
+      CASE(ReifyArguments);
+      CASE(GetArgumentsPropByVal);
+      CASE(CallApplyArguments);
+      CASE(BitNot);
+      CASE(GetArgumentsLength);
+      CASE_3REG(IsIn);
+      CASE_3REG(InstanceOf);
+      CASE(CreateRegExp);
+
+      default:
+        error(
+            llvm::Twine("unsupported opcode ") + llvm::Twine((int)ip->opCode)
+#ifndef NDEBUG
+            + " " + getOpCodeString(ip->opCode)
+#endif
+        );
+        return emit;
+    }
+#undef CASE
+
+    LLVM_DEBUG(
+        disassembleRange(
+            sav.fast.current(), emit.fast.current(), llvm::dbgs(), true);
+        if (sav.slow.current() != emit.slow.current() &&
+            !slowPathSections_.back().data) {
+          llvm::dbgs() << "; SLOW PATH\n";
+          disassembleRange(
+              sav.slow.current(), emit.slow.current(), llvm::dbgs(), true);
+        });
+  }
+
+  return emit;
+}
+
+Emitter FastJIT::getConstant(Emitter slow, uint64_t cval, uint8_t *&constAddr) {
+  // Find or emit the actual constant as a number.
+  auto it = doubleConstants_.find(cval);
+  if (it == doubleConstants_.end()) {
+    // Add a new constant.
+    slow.align<sizeof(uint64_t)>();
+    constAddr = slow.current();
+    slow.numericConst(cval);
+    describeSlowPathSection(slow, true);
+
+    doubleConstants_.try_emplace(cval, constAddr);
+  } else {
+    constAddr = it->second;
+  }
+
+  return slow;
+}
+
+Emitter
+FastJIT::loadConstant(Emitter emit, const uint8_t *constAddr, Reg reg) {
+  // Constants are 8-byte aligned, so the page offset is a valid scaled
+  // offset for LDR.
+  emit.adrp(reg, constAddr);
+  emit.ldrImm(reg, reg, (uintptr_t)constAddr & 0xfff);
+  return emit;
+}
+
+Emitters
+FastJIT::loadConstantIntoNativeReg(Emitters emit, HermesValue cval, Reg reg) {
+  // Most HermesValue constants (small numbers and the non-pointer tags) need
+  // only one or two MOVZ/MOVK, which is cheaper than a load.
+  if (Emitter::movImmLength(cval.getRaw()) <= 2) {
+    emit.fast.movImm(reg, cval.getRaw());
+    return emit;
+  }
+
+  uint8_t *constAddr;
+  emit.slow = getConstant(emit.slow, cval, constAddr);
+  emit.fast = loadConstant(emit.fast, constAddr, reg);
+  return emit;
+}
+
+Emitters
+FastJIT::loadConstantAddrIntoNativeReg(Emitters emit, void *addr, Reg reg) {
+  uint8_t *constAddr;
+  emit.slow = getConstant(emit.slow, addr, constAddr);
+  emit.fast = loadConstant(emit.fast, constAddr, reg);
+  return emit;
+}
+
+Emitters FastJIT::loadHermesValueConstant(
+    Emitters emit,
+    OperandReg32 hermesReg,
+    HermesValue value) {
+  // +0.0 is all zero bits.
+  if (value.getRaw() == 0) {
+    emit.fast = movNativeRegToHermesReg(emit.fast, Reg::zr, hermesReg);
+    return emit;
+  }
+  emit = loadConstantIntoNativeReg(emit, value, Reg::x9);
+  emit.fast = movNativeRegToHermesReg(emit.fast, Reg::x9, hermesReg);
+  return emit;
+}
+
+inline Emitter FastJIT::movNativeRegToHermesReg(
+    Emitter emit,
+    Reg nativeReg,
+    OperandReg32 hermesReg) {
+  return strMem(
+      emit, nativeReg, RegFrame, localHermesRegByteOffset(hermesReg));
+}
+
+inline Emitter FastJIT::movNativeRegToHermesReg(
+    Emitter emit,
+    FReg nativeReg,
+    OperandReg32 hermesReg) {
+  return strMem(
+      emit, nativeReg, RegFrame, localHermesRegByteOffset(hermesReg));
+}
+
+inline Emitter FastJIT::movHermesRegToNativeReg(
+    Emitter emit,
+    OperandReg32 hermesReg,
+    Reg nativeReg) {
+  return ldrMem(
+      emit, nativeReg, RegFrame, localHermesRegByteOffset(hermesReg));
+}
+
+inline Emitter FastJIT::movHermesRegToNativeReg(
+    Emitter emit,
+    OperandReg32 hermesReg,
+    FReg nativeReg) {
+  return ldrMem(
+      emit, nativeReg, RegFrame, localHermesRegByteOffset(hermesReg));
+}
+
+Emitter FastJIT::movHermesRegToHermesReg(
+    Emitter emit,
+    OperandReg32 src,
+    OperandReg32 dst) {
+  if (src == dst)
+    return emit;
+  emit = movHermesRegToNativeReg(emit, src, Reg::x9);
+  emit = movNativeRegToHermesReg(emit, Reg::x9, dst);
+  return emit;
+}
+
+inline Emitter
+FastJIT::leaHermesReg(Emitter emit, OperandReg32 hermesReg, Reg nativeReg) {
+  return addOffset(
+      emit, nativeReg, RegFrame, localHermesRegByteOffset(hermesReg));
+}
+
+Emitters FastJIT::compileTypeOf(Emitters emit, const Inst *ip) {
+  emit.fast = leaHermesReg(emit.fast, ip->iTypeOf.op2, Reg::x1);
+
+  uint8_t *constAddr;
+  emit.slow = getConstant(emit.slow, (void *)externTypeOf, constAddr);
+  emit.fast =
+      callExternalWithReturnedVal(emit.fast, constAddr, ip->iTypeOf.op1);
+  return emit;
+}
+
+Emitters FastJIT::compileTypeOfIs(Emitters emit, const Inst *ip) {
+  emit.fast = leaHermesReg(emit.fast, ip->iTypeOfIs.op2, Reg::x1);
+  emit.fast.movImm(Reg::x2, ip->iTypeOfIs.op3);
+
+  uint8_t *constAddr;
+  emit.slow = getConstant(emit.slow, (void *)externTypeOfIs, constAddr);
+  emit.fast =
+      callExternalWithReturnedVal(emit.fast, constAddr, ip->iTypeOfIs.op1);
+  return emit;
+}
+
+inline Emitter FastJIT::callAbsolute(Emitter emit, const uint8_t *dest) {
+  emit = loadConstant(emit, dest, RegScratch);
+  emit.blr(RegScratch);
+  return emit;
+}
+
+Emitter FastJIT::callExternal(
+    Emitter emit,
+    const uint8_t *dest,
+    OperandReg32 resultReg,
+    const Inst *ip) {
+  // Runtime -> arg1.
+  emit.movRegToReg(RegRuntime, Reg::x0);
+
+  emit = callAbsolute(emit, dest);
+
+  // w0: status
+  // x1: HermesValue
+
+  // Exception?
+  emit.cmpImm<W::L>(Reg::x0, 0);
+  emit = cjmpToBytecodeBB(emit, Cond::EQ, getCatchHandlerBBIndex(ip));
+
+  // Move the result value to the destination register.
+  emit = movNativeRegToHermesReg(emit, Reg::x1, resultReg);
+
+  return emit;
+}
+
+Emitter FastJIT::callExternalNoReturnedVal(
+    Emitter emit,
+    const uint8_t *dest,
+    const Inst *ip) {
+  // Runtime -> arg1.
+  emit.movRegToReg(RegRuntime, Reg::x0);
+
+  emit = callAbsolute(emit, dest);
+
+  // w0: status
+  // Exception?
+  emit.cmpImm<W::L>(Reg::x0, 0);
+  emit = cjmpToBytecodeBB(emit, Cond::EQ, getCatchHandlerBBIndex(ip));
+
+  return emit;
+}
+
+Emitter FastJIT::callExternalWithReturnedVal(
+    Emitter emit,
+    const uint8_t *dest,
+    OperandReg32 resultReg) {
+  // Runtime -> arg1.
+  emit.movRegToReg(RegRuntime, Reg::x0);
+
+  emit = callAbsolute(emit, dest);
+
+  // Move the result value to the destination register.
+  emit = movNativeRegToHermesReg(emit, Reg::x0, resultReg);
+
+  return emit;
+}
+
+Emitters FastJIT::callHelper(
+    Emitters emit,
+    const Inst *ip,
+    uint32_t argCount,
+    bool isConstruct) {
+  //&callable -> arg2
+  emit.fast = leaHermesReg(emit.fast, ip->iCall.op2, Reg::x1);
+
+  // argCount (uint32_t) -> arg3
+  emit.fast.movImm(Reg::x2, argCount);
+
+  // stack pointer -> arg4
+  emit.fast =
+      ldrMem(emit.fast, Reg::x3, RegRuntime, RuntimeOffsets::stackPointer);
+
+  // ip -> arg5
+  emit = loadConstantAddrIntoNativeReg(emit, (void *)ip, Reg::x4);
+
+  // currentFrame -> arg6
+  emit.fast.movRegToReg(RegFrame, Reg::x5);
+
+  uint8_t *constAddr;
+  emit.slow = getConstant(
+      emit.slow,
+      isConstruct ? (void *)externConstruct : (void *)externCall,
+      constAddr);
+  emit.fast = callExternal(emit.fast, constAddr, ip->iCall.op1, ip);
+  return emit;
+}
+
+Emitters FastJIT::compileCall(Emitters emit, const Inst *ip) {
+  return callHelper(emit, ip, ip->iCall.op3, false);
+}
+Emitters FastJIT::compileCallLong(Emitters emit, const Inst *ip) {
+  return callHelper(emit, ip, ip->iCallLong.op3, false);
+}
+Emitters FastJIT::compileConstruct(Emitters emit, const Inst *ip) {
+  return callHelper(emit, ip, ip->iConstruct.op3, true);
+}
+Emitters FastJIT::compileConstructLong(Emitters emit, const Inst *ip) {
+  return callHelper(emit, ip, ip->iConstructLong.op3, true);
+}
+
+Emitters FastJIT::compileCallBuiltin(Emitters emit, const Inst *ip) {
+  // builtinMethodID -> arg2
+  emit.fast.movImm(Reg::x1, ip->iCallBuiltin.op2);
+
+  // argCount (uint32_t) -> arg3
+  emit.fast.movImm(Reg::x2, ip->iCallBuiltin.op3);
+
+  // stack pointer -> arg4
+  emit.fast =
+      ldrMem(emit.fast, Reg::x3, RegRuntime, RuntimeOffsets::stackPointer);
+
+  // ip -> arg5
+  emit = loadConstantAddrIntoNativeReg(emit, (void *)ip, Reg::x4);
+
+  // currentFrame -> arg6
+  emit.fast.movRegToReg(RegFrame, Reg::x5);
+
+  uint8_t *constAddr;
+  emit.slow = getConstant(emit.slow, (void *)externCallBuiltin, constAddr);
+  emit.fast = callExternal(emit.fast, constAddr, ip->iCallBuiltin.op1, ip);
+  return emit;
+}
+
+Emitters FastJIT::emitOSREntries(Emitters emit) {
+  nativeOSREntryAddress_.resize(bcLoopHeaders_.size());
+  for (unsigned i = 0, e = bcLoopHeaders_.size(); i != e; ++i) {
+    if (!checkSpace(emit))
+      return emit;
+    nativeOSREntryAddress_[i] = emit.fast.current();
+    // The interpreter has already popped its frame, leaving the registers in
+    // place. Push it again, re-using them, and continue at the loop header.
+    emit = emitPrologue(emit, false);
+    emit.fast = jmpToBytecodeBB(emit.fast, bcLoopHeaders_[i]);
+  }
+  return emit;
+}
+
+Emitter FastJIT::jmpToBytecodeBB(Emitter emit, unsigned bytecodeBB) {
+  // If jumping to the next BB, do nothing.
+  if (bytecodeBB == curBytecodeBBIndex_ + 1)
+    return emit;
+
+  // Backwards branch doesn't need a relocation and we can determine the offset.
+  if (bytecodeBB <= curBytecodeBBIndex_) {
+    emit.b(nativeBBAddress_[bytecodeBB]);
+  } else {
+    // Forward branch: emit a jump to itself and record a relocation.
+    relocs_.emplace_back(ReloKind::Branch26, emit.current(), bytecodeBB);
+    emit.b(emit.current());
+  }
+  return emit;
+}
+
+Emitter FastJIT::cjmpToBytecodeBB(Emitter emit, Cond cc, unsigned bytecodeBB) {
+  // Backwards branch doesn't need a relocation and we can determine the offset.
+  if (bytecodeBB <= curBytecodeBBIndex_)
+    return cjmpTo(emit, cc, nativeBBAddress_[bytecodeBB]);
+
+  // Forward branch: the target may be out of range of B.cond, so skip over an
+  // unconditional branch which is relocated later.
+  emit.bcond(invert(cc), emit.current() + 8);
+  relocs_.emplace_back(ReloKind::Branch26, emit.current(), bytecodeBB);
+  emit.b(emit.current());
+  return emit;
+}
+
+Emitter FastJIT::cjmpTo(Emitter emit, Cond cc, const uint8_t *target) {
+  if (Emitter::inBranchRange(19, emit.current(), target)) {
+    emit.bcond(cc, target);
+  } else {
+    emit.bcond(invert(cc), emit.current() + 8);
+    emit.b(target);
+  }
+  return emit;
+}
+
+Emitters FastJIT::compileCondOp(
+    Emitters emit,
+    const Inst *ip,
+    Cond cc,
+    void *slowPathCall) {
+  uint8_t *slowPathConstAddr;
+  emit.slow = getConstant(emit.slow, slowPathCall, slowPathConstAddr);
+  uint8_t *slowPathAddr = emit.slow.current();
+
+  emit = callSlowPathBinOp(emit, ip, slowPathConstAddr);
+  // Since slow path is emitted earlier, we need to relocate its last
+  // jump-back-to-fast-path instruction.
+  Relo relo{ReloKind::Branch26, emit.slow.current() - 4, 0};
+
+  // isNumber op2?
+  emit.fast = isNumber(emit.fast, ip->iLess.op2, slowPathAddr);
+  // isNumber op3?
+  emit.fast = isNumber(emit.fast, ip->iLess.op3, slowPathAddr);
+  // Fast path
+  emit = compileCondOpN(emit, ip, cc);
+
+  applyRelocation(relo, emit.fast.current());
+
+  return emit;
+}
+
+Emitters FastJIT::compileCondOpN(Emitters emit, const Inst *ip, Cond cc) {
+  emit.fast = movHermesRegToNativeReg(emit.fast, ip->iLess.op2, FReg::d0);
+  emit.fast = movHermesRegToNativeReg(emit.fast, ip->iLess.op3, FReg::d1);
+  emit.fast.fcmp(FReg::d0, FReg::d1);
+
+  emit.fast.cset(Reg::x9, cc);
+  emit.fast = encodeBoolHVInNativeReg(emit.fast, Reg::x9);
+
+  // store the bool to result Hermes register
+  emit.fast = movNativeRegToHermesReg(emit.fast, Reg::x9, ip->iLess.op1);
+  return emit;
+}
+
+Emitters FastJIT::emitPropertyCacheGuard(
+    Emitters emit,
+    uint32_t objReg,
+    const uint8_t *cacheConstAddr,
+    const uint8_t *slowPathAddr) {
+#ifdef HERMESVM_COMPRESSED_POINTERS
+  uint8_t *pointerBaseConstAddr;
+  emit.slow = getConstant(
+      emit.slow, (void *)context_->getPointerBase(), pointerBaseConstAddr);
+#endif
+
+  // Is it an object?
+  emit.fast = cmpSomeTag(emit.fast, objReg, ObjectTag);
+  emit.fast = cjmpTo(emit.fast, Cond::NE, slowPathAddr);
+
+  // Strip the tag, leaving the JSObject pointer in x9.
+  emit.fast.ubfm(Reg::x9, Reg::x9, 0, HermesValue::kNumDataBits - 1);
+
+  // Does the hidden class match the first way of the cache?
+  emit.fast = loadConstant(emit.fast, cacheConstAddr, Reg::x12);
+#ifdef HERMESVM_COMPRESSED_POINTERS
+  // The object holds its class as an offset from the PointerBase, while the
+  // cache holds the pointer. A class is never null, so decoding it is just
+  // adding the base.
+  emit.fast = loadConstant(emit.fast, pointerBaseConstAddr, Reg::x11);
+  emit.fast =
+      ldrMem<W::L>(emit.fast, Reg::x10, Reg::x9, RuntimeOffsets::objectClass);
+  emit.fast.addReg(Reg::x10, Reg::x10, Reg::x11);
+#else
+  emit.fast = ldrMem(emit.fast, Reg::x10, Reg::x9, RuntimeOffsets::objectClass);
+#endif
+  emit.fast = ldrMem(
+      emit.fast, Reg::x11, Reg::x12, offsetof(PropertyCacheEntry, clazz));
+  emit.fast.cmpReg(Reg::x10, Reg::x11);
+  emit.fast = cjmpTo(emit.fast, Cond::NE, slowPathAddr);
+
+  // Only slots stored directly in the object are accessed inline.
+  emit.fast = ldrMem<W::L>(
+      emit.fast, Reg::x11, Reg::x12, offsetof(PropertyCacheEntry, slot));
+  emit.fast.cmpImm<W::L>(Reg::x11, JSObject::DIRECT_PROPERTY_SLOTS);
+  emit.fast = cjmpTo(emit.fast, Cond::HS, slowPathAddr);
+
+  emit.fast = addOffset(
+      emit.fast, Reg::x10, Reg::x9, RuntimeOffsets::objectDirectProps);
+  return emit;
+}
+
+inline Emitters FastJIT::getByIdHelper(
+    Emitters emit,
+    const Inst *ip,
+    bool tryProp,
+    uint32_t idVal) {
+  auto defaultPropOpFlags = codeBlock_->isStrictMode()
+      ? PropOpFlags().plusThrowOnError()
+      : PropOpFlags();
+  auto flags =
+      !tryProp ? defaultPropOpFlags : defaultPropOpFlags.plusMustExist();
+  // The symbol must already exist in the string id map, so we could just pass
+  // the IdentifierID
+  uint32_t symbolIdx = codeBlock_->getRuntimeModule()
+                           ->getIdentifierSymbolID(idVal)
+                           .unsafeGetIndex();
+  auto cacheIdx = ip->iGetById.op3;
+
+  uint8_t *codeBlockConstAddr;
+  emit.slow = getConstant(emit.slow, (void *)codeBlock_, codeBlockConstAddr);
+  uint8_t *constAddr;
+  emit.slow = getConstant(emit.slow, (void *)externGetById, constAddr);
+
+  auto callGetById = [&](Emitter e) {
+    // PropOpFlags  -> arg2
+    e.movImm(Reg::x1, flags.getRaw());
+    // IdentifierID (uint32_t) -> arg3
+    e.movImm(Reg::x2, symbolIdx);
+    //&target -> arg4
+    e = leaHermesReg(e, ip->iGetById.op2, Reg::x3);
+    // cacheIdx -> arg5
+    e.movImm(Reg::x4, cacheIdx);
+    // current code block -> arg6
+    e = loadConstant(e, codeBlockConstAddr, Reg::x5);
+    return callExternal(e, constAddr, ip->iGetById.op1, ip);
+  };
+
+  if (cacheIdx == hbc::PROPERTY_CACHING_DISABLED) {
+    emit.fast = callGetById(emit.fast);
+    return emit;
+  }
+
+  // Check the first way of the read cache inline, and only call out to the
+  // runtime when it misses.
+  uint8_t *cacheConstAddr;
+  emit.slow = getConstant(
+      emit.slow,
+      (void *)&codeBlock_->getReadCacheEntry(cacheIdx)->ways[0],
+      cacheConstAddr);
+
+  uint8_t *slowPathAddr = emit.slow.current();
+  emit.slow = callGetById(emit.slow);
+  Relo relo{ReloKind::Branch26, emit.slow.current(), 0};
+  emit.slow.b(emit.slow.current());
+  describeSlowPathSection(emit.slow, false);
+
+  emit = emitPropertyCacheGuard(
+      emit, ip->iGetById.op2, cacheConstAddr, slowPathAddr);
+  emit.fast.ldrReg(Reg::x9, Reg::x10, Reg::x11, /* scaled */ true);
+  emit.fast = movNativeRegToHermesReg(emit.fast, Reg::x9, ip->iGetById.op1);
+
+  applyRelocation(relo, emit.fast.current());
+  return emit;
+}
+
+Emitters FastJIT::compileGetById(Emitters emit, const Inst *ip) {
+  return getByIdHelper(emit, ip, false, ip->iGetById.op4);
+}
+Emitters FastJIT::compileGetByIdShort(Emitters emit, const Inst *ip) {
+  return getByIdHelper(emit, ip, false, ip->iGetByIdShort.op4);
+}
+Emitters FastJIT::compileGetByIdLong(Emitters emit, const Inst *ip) {
+  return getByIdHelper(emit, ip, false, ip->iGetByIdLong.op4);
+}
+Emitters FastJIT::compileTryGetById(Emitters emit, const Inst *ip) {
+  return getByIdHelper(emit, ip, true, ip->iTryGetById.op4);
+}
+Emitters FastJIT::compileTryGetByIdLong(Emitters emit, const Inst *ip) {
+  return getByIdHelper(emit, ip, true, ip->iTryGetByIdLong.op4);
+}
+
+inline Emitters FastJIT::putByIdHelper(
+    Emitters emit,
+    const Inst *ip,
+    bool tryProp,
+    uint32_t idVal) {
+  auto defaultPropOpFlags = codeBlock_->isStrictMode()
+      ? PropOpFlags().plusThrowOnError()
+      : PropOpFlags();
+  auto flags =
+      !tryProp ? defaultPropOpFlags : defaultPropOpFlags.plusMustExist();
+  // The symbol must already exist in the map, so we could just pass the
+  // IdentifierID
+  uint32_t symbolIdx = codeBlock_->getRuntimeModule()
+                           ->getIdentifierSymbolID(idVal)
+                           .unsafeGetIndex();
+  auto cacheIdx = ip->iPutById.op3;
+
+  uint8_t *constAddr;
+  emit.slow = getConstant(emit.slow, (void *)externPutById, constAddr);
+
+  auto callPutById = [&](Emitter e) {
+    // PropOpFlags  -> arg2
+    e.movImm(Reg::x1, flags.getRaw());
+    // IdentifierID (uint32_t) -> arg3
+    e.movImm(Reg::x2, symbolIdx);
+    //&target -> arg4
+    e = leaHermesReg(e, ip->iPutById.op1, Reg::x3);
+    //&prop -> arg5
+    e = leaHermesReg(e, ip->iPutById.op2, Reg::x4);
+    // cacheIdx -> arg6
+    e.movImm(Reg::x5, cacheIdx);
+    return callExternalNoReturnedVal(e, constAddr, ip);
+  };
+
+  if (cacheIdx == hbc::PROPERTY_CACHING_DISABLED) {
+    emit.fast = callPutById(emit.fast);
+    return emit;
+  }
+
+  // Check the first way of the write cache inline. Stores of pointer values
+  // need a write barrier, so they always go through the runtime.
+  uint8_t *cacheConstAddr;
+  emit.slow = getConstant(
+      emit.slow,
+      (void *)&codeBlock_->getWriteCacheEntry(cacheIdx)->ways[0],
+      cacheConstAddr);
+
+  uint8_t *slowPathAddr = emit.slow.current();
+  emit.slow = callPutById(emit.slow);
+  Relo relo{ReloKind::Branch26, emit.slow.current(), 0};
+  emit.slow.b(emit.slow.current());
+  describeSlowPathSection(emit.slow, false);
+
+  // Pointer tags are the largest, so their complements are the smallest.
+  emit.fast = movHermesRegToNativeReg(emit.fast, ip->iPutById.op2, Reg::x9);
+  emit.fast = invertedTag(emit.fast, Reg::x9, Reg::x9);
+  emit.fast.cmpImm(Reg::x9, invertTag(FirstPointerTag));
+  emit.fast = cjmpTo(emit.fast, Cond::LS, slowPathAddr);
+
+  emit = emitPropertyCacheGuard(
+      emit, ip->iPutById.op1, cacheConstAddr, slowPathAddr);
+  emit.fast = movHermesRegToNativeReg(emit.fast, ip->iPutById.op2, Reg::x9);
+  emit.fast.strReg(Reg::x9, Reg::x10, Reg::x11, /* scaled */ true);
+
+  applyRelocation(relo, emit.fast.current());
+  return emit;
+}
+
+Emitters FastJIT::compilePutById(Emitters emit, const Inst *ip) {
+  return putByIdHelper(emit, ip, false, ip->iPutById.op4);
+}
+Emitters FastJIT::compilePutByIdShort(Emitters emit, const Inst *ip) {
+  return putByIdHelper(emit, ip, false, ip->iPutByIdShort.op4);
+}
+Emitters FastJIT::compilePutByIdLong(Emitters emit, const Inst *ip) {
+  return putByIdHelper(emit, ip, false, ip->iPutByIdLong.op4);
+}
+Emitters FastJIT::compileTryPutById(Emitters emit, const Inst *ip) {
+  return putByIdHelper(emit, ip, true, ip->iTryPutById.op4);
+}
+Emitters FastJIT::compileTryPutByIdLong(Emitters emit, const Inst *ip) {
+  return putByIdHelper(emit, ip, true, ip->iTryPutByIdLong.op4);
+}
+
+Emitters FastJIT::compileDeclareGlobalVar(Emitters emit, const Inst *ip) {
+  // StringID (uint32_t) -> arg2
+  emit.fast.movImm(Reg::x1, ip->iDeclareGlobalVar.op1);
+
+  uint8_t *constAddr;
+  emit.slow =
+      getConstant(emit.slow, (void *)externCallDeclareGlobalVar, constAddr);
+  emit.fast = callExternalNoReturnedVal(emit.fast, constAddr, ip);
+  return emit;
+}
+
+Emitters FastJIT::compileCreateEnvironment(Emitters emit, const Inst *ip) {
+  // current frame -> arg2
+  emit.fast.movRegToReg(RegFrame, Reg::x1);
+
+  // uint32_t envSize -> arg3
+  emit.fast.movImm(Reg::x2, codeBlock_->getEnvironmentSize());
+
+  uint8_t *constAddr;
+  emit.slow =
+      getConstant(emit.slow, (void *)externCreateEnvironment, constAddr);
+  emit.fast =
+      callExternal(emit.fast, constAddr, ip->iCreateEnvironment.op1, ip);
+  return emit;
+}
+
+Emitters FastJIT::compileCreateClosure(Emitters emit, const Inst *ip) {
+  // Code blocks are allocated in C heap, so their addresses are constant,
+  // and can be embedded in JIT'ed code.
+  // &calleeCodeBlock  -> arg2
+  CodeBlock *calleeBlock =
+      codeBlock_->getRuntimeModule()->getCodeBlockMayAllocate(
+          ip->iCreateClosure.op3);
+  // Leave a function outside of the bytecode to the interpreter to report.
+  if (!calleeBlock) {
+    error("closure lies outside of the bytecode");
+    return emit;
+  }
+  emit = loadConstantAddrIntoNativeReg(emit, calleeBlock, Reg::x1);
+
+  //&env -> arg3
+  emit.fast = leaHermesReg(emit.fast, ip->iCreateClosure.op2, Reg::x2);
+
+  uint8_t *constAddr;
+  emit.slow = getConstant(emit.slow, (void *)externCreateClosure, constAddr);
+  emit.fast = callExternal(emit.fast, constAddr, ip->iCreateClosure.op1, ip);
+  return emit;
+}
+
+Emitters FastJIT::compileGetGlobalObject(Emitters emit, const Inst *ip) {
+  emit.fast = movRuntimeVarToHermesReg(
+      emit.fast, RuntimeOffsets::globalObject, ip->iGetGlobalObject.op1);
+  return emit;
+}
+
+Emitters FastJIT::compileLoadConstZero(Emitters emit, const Inst *ip) {
+  emit.fast =
+      movNativeRegToHermesReg(emit.fast, Reg::zr, ip->iLoadConstZero.op1);
+  return emit;
+}
+
+Emitters FastJIT::compileLoadConstString(
+    Emitters emit,
+    const Inst *ip,
+    uint32_t stringID) {
+  // stringID -> arg1
+  emit.fast.movImm(Reg::x0, stringID);
+  // runtime module -> arg2
+  emit = loadConstantAddrIntoNativeReg(
+      emit, codeBlock_->getRuntimeModule(), Reg::x1);
+
+  uint8_t *constAddr;
+  emit.slow = getConstant(
+      emit.slow, (void *)externLoadConstStringMayAllocate, constAddr);
+  emit.fast = callAbsolute(emit.fast, constAddr);
+
+  // Move the result value to the destination register.
+  emit.fast =
+      movNativeRegToHermesReg(emit.fast, Reg::x0, ip->iLoadConstString.op1);
+
+  return emit;
+}
+
+Emitters FastJIT::compileStrictEqJump(
+    Emitters emit,
+    const Inst *ip,
+    uint32_t ipOffset,
+    uint32_t reg1,
+    uint32_t reg2,
+    Cond cc) {
+  emit = callExternStrictEqTest(emit, ip, reg1, reg2);
+  emit.fast = cjmpToBytecodeBB(emit.fast, cc, getBBIndex(ip, ipOffset));
+  return emit;
+}
+Emitters
+FastJIT::compileStrictEqTest(Emitters emit, const Inst *ip, bool isNeq) {
+  emit = callExternStrictEqTest(emit, ip, ip->iStrictEq.op2, ip->iStrictEq.op3);
+
+  emit.fast.cset(Reg::x9, isNeq ? Cond::EQ : Cond::NE);
+  emit.fast = encodeBoolHVInNativeReg(emit.fast, Reg::x9);
+
+  emit.fast = movNativeRegToHermesReg(emit.fast, Reg::x9, ip->iStrictEq.op1);
+  return emit;
+}
+Emitters FastJIT::callExternStrictEqTest(
+    Emitters emit,
+    const Inst *ip,
+    uint32_t reg1,
+    uint32_t reg2) {
+  // arg1
+  emit.fast = movHermesRegToNativeReg(emit.fast, reg1, Reg::x0);
+  // arg2
+  emit.fast = movHermesRegToNativeReg(emit.fast, reg2, Reg::x1);
+
+  uint8_t *constAddr;
+  emit.slow = getConstant(emit.slow, (void *)strictEqualityTest, constAddr);
+  emit.fast = callAbsolute(emit.fast, constAddr);
+
+  // Only the low 8 bits of a returned bool are defined.
+  emit.fast.uxtb(Reg::x0, Reg::x0);
+  emit.fast.cmpImm<W::L>(Reg::x0, 0);
+  return emit;
+}
+
+Emitters FastJIT::callExternEqTest(
+    Emitters emit,
+    const Inst *ip,
+    uint32_t reg1,
+    uint32_t reg2) {
+  // arg2
+  emit.fast = leaHermesReg(emit.fast, reg1, Reg::x1);
+  // arg3
+  emit.fast = leaHermesReg(emit.fast, reg2, Reg::x2);
+
+  uint8_t *slowPathConstAddr;
+  emit.slow = getConstant(
+      emit.slow, (void *)externAbstractEqualityTest, slowPathConstAddr);
+  // Call external AbstractEqualityTest, which actually returns a bool
+  // HermesValue, but we can't store it to the result reg directly, since we may
+  // need to toggle it.
+  emit.fast = callExternalNoReturnedVal(emit.fast, slowPathConstAddr, ip);
+  return emit;
+}
+
+Emitters FastJIT::compileEqJump(
+    Emitters emit,
+    const Inst *ip,
+    uint32_t ipOffset,
+    uint32_t reg1,
+    uint32_t reg2,
+    Cond cc) {
+  emit = callExternEqTest(emit, ip, reg1, reg2);
+
+  // Whether the return value is true, namely whether its lower 32 bits is 0x01.
+  // w1 : bool (The tag is in the higher 32 bit of x1, w1 is 1 or 0.)
+  emit.fast.cmpImm<W::L>(Reg::x1, 0);
+
+  emit.fast = cjmpToBytecodeBB(emit.fast, cc, getBBIndex(ip, ipOffset));
+  return emit;
+}
+
+Emitters FastJIT::compileEqTest(Emitters emit, const Inst *ip, bool isNeq) {
+  emit = callExternEqTest(emit, ip, ip->iEq.op2, ip->iEq.op3);
+
+  // x1 is the returned bool HermesValue
+  if (isNeq) {
+    emit.fast.cmpImm<W::L>(Reg::x1, 0);
+    emit.fast.cset(Reg::x1, Cond::EQ);
+    emit.fast = encodeBoolHVInNativeReg(emit.fast, Reg::x1);
+  }
+  emit.fast = movNativeRegToHermesReg(emit.fast, Reg::x1, ip->iEq.op1);
+  return emit;
+}
+
+Emitters FastJIT::compileBoolJmp(
+    Emitters emit,
+    const Inst *ip,
+    uint32_t ipOffset,
+    uint32_t regIdx,
+    Cond cc) {
+  uint8_t *slowPathConstAddr;
+  emit.slow = getConstant(emit.slow, (void *)toBoolean, slowPathConstAddr);
+  uint8_t *slowPathAddr = emit.slow.current();
+
+  // Fast path: the operand is a boolean
+  emit.fast = cmpSomeTag(emit.fast, regIdx, BoolTag);
+  emit.fast = cjmpTo(emit.fast, Cond::NE, slowPathAddr);
+
+  // Compare the lowest 32 bits (the bool value) of the HermesValue
+  emit.fast.cmpImm<W::L>(Reg::x9, 0);
+  emit.fast = cjmpToBytecodeBB(emit.fast, cc, getBBIndex(ip, ipOffset));
+
+  // Slow path: emit an external call to toBoolean
+  emit.slow = movHermesRegToNativeReg(emit.slow, regIdx, Reg::x0);
+  emit.slow = callAbsolute(emit.slow, slowPathConstAddr);
+  emit.slow.uxtb(Reg::x0, Reg::x0);
+  emit.slow.cmpImm<W::L>(Reg::x0, 0);
+  emit.slow = cjmpToBytecodeBB(emit.slow, cc, getBBIndex(ip, ipOffset));
+  emit.slow.b(emit.fast.current());
+  describeSlowPathSection(emit.slow, false);
+
+  return emit;
+}
+
+inline Emitter FastJIT::invertedTag(Emitter emit, Reg src, Reg dst) {
+  emit.mvnReg(dst, src);
+  emit.lsrImm(dst, dst, HermesValue::kNumDataBits);
+  return emit;
+}
+
+inline Emitter
+FastJIT::cmpSomeTag(Emitter emit, uint32_t regIndex, TagKind tag) {
+  emit = movHermesRegToNativeReg(emit, regIndex, Reg::x9);
+  emit = invertedTag(emit, Reg::x9, Reg::x10);
+  emit.cmpImm(Reg::x10, invertTag(tag));
+  return emit;
+}
+
+inline Emitters FastJIT::jmpUndefinedHelper(
+    Emitters emit,
+    const Inst *ip,
+    uint32_t ipOffset,
+    uint32_t regIndex) {
+  emit.fast = cmpSomeTag(emit.fast, regIndex, UndefinedTag);
+  emit.fast = cjmpToBytecodeBB(emit.fast, Cond::EQ, getBBIndex(ip, ipOffset));
+  return emit;
+}
+Emitters FastJIT::compileJmpUndefined(Emitters emit, const Inst *ip) {
+  return jmpUndefinedHelper(
+      emit, ip, ip->iJmpUndefined.op1, ip->iJmpUndefined.op2);
+}
+Emitters FastJIT::compileJmpUndefinedLong(Emitters emit, const Inst *ip) {
+  return jmpUndefinedHelper(
+      emit, ip, ip->iJmpUndefinedLong.op1, ip->iJmpUndefinedLong.op2);
+}
+
+Emitters FastJIT::compileLoadParam(Emitters emit, const Inst *ip) {
+  // x9 = undefined
+  emit = loadConstantIntoNativeReg(
+      emit, HermesValue::encodeUndefinedValue(), Reg::x9);
+  // The argument count is in the low 32 bits of its slot.
+  emit.fast = ldrMem<W::L>(
+      emit.fast,
+      Reg::x10,
+      RegFrame,
+      sizeof(HermesValue) * StackFrameLayout::ArgCount);
+  emit.fast.cmpImm<W::L>(Reg::x10, ip->iLoadParam.op2);
+
+  Relo relo{ReloKind::Branch19, emit.fast.current(), 0};
+  emit.fast.bcond(Cond::LO, emit.fast.current());
+
+  emit.fast = ldrMem(
+      emit.fast,
+      Reg::x9,
+      RegFrame,
+      sizeof(HermesValue) * StackFrameLayout::argOffset(ip->iLoadParam.op2 - 1));
+
+  applyRelocation(relo, emit.fast.current());
+
+  emit.fast = movNativeRegToHermesReg(emit.fast, Reg::x9, ip->iLoadParam.op1);
+  return emit;
+}
+
+Emitters FastJIT::compileBinOp(
+    Emitters emit,
+    const Inst *ip,
+    void *slowPathBinOp,
+    compileBinOpNPtr binOpNPtr) {
+  uint8_t *externAddr;
+  emit.slow = getConstant(emit.slow, slowPathBinOp, externAddr);
+  uint8_t *slowPathAddr = emit.slow.current();
+
+  // isNumber op2?
+  emit.fast = isNumber(emit.fast, ip->iSub.op2, slowPathAddr);
+  // isNumber op3?
+  emit.fast = isNumber(emit.fast, ip->iSub.op3, slowPathAddr);
+  emit = (this->*binOpNPtr)(emit, ip);
+  return callSlowPathBinOp(emit, ip, externAddr);
+}
+
+Emitters FastJIT::compileAddN(Emitters emit, const Inst *ip) {
+  emit.fast = movHermesRegToNativeReg(emit.fast, ip->iAdd.op2, FReg::d0);
+  emit.fast = movHermesRegToNativeReg(emit.fast, ip->iAdd.op3, FReg::d1);
+  emit.fast.fadd(FReg::d0, FReg::d0, FReg::d1);
+  emit.fast = movNativeRegToHermesReg(emit.fast, FReg::d0, ip->iAdd.op1);
+  return emit;
+}
+
+Emitters FastJIT::compileSubN(Emitters emit, const Inst *ip) {
+  emit.fast = movHermesRegToNativeReg(emit.fast, ip->iSub.op2, FReg::d0);
+  emit.fast = movHermesRegToNativeReg(emit.fast, ip->iSub.op3, FReg::d1);
+  emit.fast.fsub(FReg::d0, FReg::d0, FReg::d1);
+  emit.fast = movNativeRegToHermesReg(emit.fast, FReg::d0, ip->iSub.op1);
+  return emit;
+}
+
+Emitters FastJIT::compileMulN(Emitters emit, const Inst *ip) {
+  emit.fast = movHermesRegToNativeReg(emit.fast, ip->iMul.op2, FReg::d0);
+  emit.fast = movHermesRegToNativeReg(emit.fast, ip->iMul.op3, FReg::d1);
+  emit.fast.fmul(FReg::d0, FReg::d0, FReg::d1);
+  emit.fast = movNativeRegToHermesReg(emit.fast, FReg::d0, ip->iMul.op1);
+  return emit;
+}
+
+Emitters FastJIT::compileDivN(Emitters emit, const Inst *ip) {
+  emit.fast = movHermesRegToNativeReg(emit.fast, ip->iDiv.op2, FReg::d0);
+  emit.fast = movHermesRegToNativeReg(emit.fast, ip->iDiv.op3, FReg::d1);
+  emit.fast.fdiv(FReg::d0, FReg::d0, FReg::d1);
+  emit.fast = movNativeRegToHermesReg(emit.fast, FReg::d0, ip->iDiv.op1);
+  return emit;
+}
+
+Emitter FastJIT::isNumber(Emitter emit, uint32_t regIndex, uint8_t *callStub) {
+  emit = movHermesRegToNativeReg(emit, regIndex, Reg::x9);
+  emit = invertedTag(emit, Reg::x9, Reg::x9);
+  // The complement of every tag is at most invertTag(FirstTag).
+  emit.cmpImm(Reg::x9, invertTag(FirstTag));
+  emit = cjmpTo(emit, Cond::LS, callStub);
+  return emit;
+}
+
+Emitter FastJIT::isString(Emitter emit, uint32_t regIndex, uint8_t *callStub) {
+  emit = cmpSomeTag(emit, regIndex, StrTag);
+  emit = cjmpTo(emit, Cond::NE, callStub);
+  return emit;
+}
+
+Emitters FastJIT::callSlowPathBinOp(
+    Emitters emit,
+    const Inst *ip,
+    const uint8_t *externBinOp) {
+  // Emit the slow path.
+  // &op2 -> arg2, &op3 -> arg3
+  emit.slow = leaHermesReg(emit.slow, ip->iAdd.op2, Reg::x1);
+  emit.slow = leaHermesReg(emit.slow, ip->iAdd.op3, Reg::x2);
+
+  // Call slowPath binary operation
+  emit.slow = callExternal(emit.slow, externBinOp, ip->iAdd.op1, ip);
+
+  emit.slow.b(emit.fast.current());
+
+  describeSlowPathSection(emit.slow, false);
+  return emit;
+}
+
+Emitters FastJIT::compileMov(Emitters emit, const Inst *ip) {
+  emit.fast = movHermesRegToNativeReg(emit.fast, ip->iMov.op2, Reg::x9);
+  emit.fast = movNativeRegToHermesReg(emit.fast, Reg::x9, ip->iMov.op1);
+  return emit;
+}
+Emitters FastJIT::compileMovLong(Emitters emit, const Inst *ip) {
+  emit.fast = movHermesRegToNativeReg(emit.fast, ip->iMovLong.op2, Reg::x9);
+  emit.fast = movNativeRegToHermesReg(emit.fast, Reg::x9, ip->iMovLong.op1);
+  return emit;
+}
+
+Emitters FastJIT::compileToNumber(Emitters emit, const Inst *ip) {
+  // Put the external call stub at the beginning of the slow path
+  uint8_t *constAddr;
+  emit.slow = getConstant(emit.slow, (void *)slowPathToNumber, constAddr);
+
+  // isNumber op2?
+  emit.fast = isNumber(emit.fast, ip->iToNumber.op2, emit.slow.current());
+
+  emit.fast =
+      movHermesRegToHermesReg(emit.fast, ip->iToNumber.op2, ip->iToNumber.op1);
+
+  // Emit the slow path.
+  // &Source -> arg2.
+  emit.slow = leaHermesReg(emit.slow, ip->iToNumber.op2, Reg::x1);
+
+  // Call toNumber
+  emit.slow = callExternal(emit.slow, constAddr, ip->iToNumber.op1, ip);
+
+  emit.slow.b(emit.fast.current());
+
+  describeSlowPathSection(emit.slow, false);
+
+  return emit;
+}
+
+Emitters FastJIT::compileAddEmptyString(Emitters emit, const Inst *ip) {
+  // Put the external call stub at the beginning of the slow path
+  uint8_t *constAddr;
+  emit.slow = getConstant(emit.slow, (void *)slowPathAddEmptyString, constAddr);
+
+  // isString op2?
+  emit.fast = isString(emit.fast, ip->iAddEmptyString.op2, emit.slow.current());
+
+  emit.fast = movHermesRegToHermesReg(
+      emit.fast, ip->iAddEmptyString.op2, ip->iAddEmptyString.op1);
+
+  // Emit the slow path.
+  // &Source -> arg2.
+  emit.slow = leaHermesReg(emit.slow, ip->iAddEmptyString.op2, Reg::x1);
+
+  // Call slowPathAddEmptyString
+  emit.slow = callExternal(emit.slow, constAddr, ip->iAddEmptyString.op1, ip);
+
+  emit.slow.b(emit.fast.current());
+
+  describeSlowPathSection(emit.slow, false);
+
+  return emit;
+}
+
+Emitters FastJIT::compileRet(Emitters emit, const Inst *ip) {
+  emit.fast = movHermesRegToNativeReg(emit.fast, ip->iRet.op1, Reg::x1);
+  emit.fast.movz<W::L>(Reg::x0, 1);
+
+  emit.fast = jmpToBytecodeBB(emit.fast, bcBasicBlocks_.size() - 1);
+
+  return emit;
+}
+
+Emitters FastJIT::compileJmp(Emitters emit, const Inst *ip, uint32_t ipOffset) {
+  emit.fast = jmpToBytecodeBB(emit.fast, getBBIndex(ip, ipOffset));
+  return emit;
+}
+
+Emitters FastJIT::compileCondJumpN(
+    Emitters emit,
+    const Inst *ip,
+    uint32_t ipOffset,
+    uint32_t reg1,
+    uint32_t reg2,
+    Cond cc) {
+  emit.fast = movHermesRegToNativeReg(emit.fast, reg1, FReg::d0);
+  emit.fast = movHermesRegToNativeReg(emit.fast, reg2, FReg::d1);
+  emit.fast.fcmp(FReg::d0, FReg::d1);
+
+  emit.fast = cjmpToBytecodeBB(emit.fast, cc, getBBIndex(ip, ipOffset));
+
+  return emit;
+}
+
+Emitters FastJIT::compileCondJump(
+    Emitters emit,
+    const Inst *ip,
+    uint32_t ipOffset,
+    uint32_t reg1,
+    uint32_t reg2,
+    Cond cc,
+    void *slowPathCall) {
+  uint8_t *slowPathConstAddr;
+  emit.slow = getConstant(emit.slow, slowPathCall, slowPathConstAddr);
+  uint8_t *slowPathAddr = emit.slow.current();
+
+  emit.fast = isNumber(emit.fast, reg1, slowPathAddr);
+  emit.fast = isNumber(emit.fast, reg2, slowPathAddr);
+
+  // Fast path
+  emit = compileCondJumpN(emit, ip, ipOffset, reg1, reg2, cc);
+
+  // Slow path
+  emit.slow = leaHermesReg(emit.slow, reg1, Reg::x1);
+  emit.slow = leaHermesReg(emit.slow, reg2, Reg::x2);
+
+  // Call slowPath comparison operation, which actually returns a bool
+  // HermesValue, but we don't need to store it to a Hermes reg, instead, we
+  // need to examine it explicitly.
+  emit.slow = callExternalNoReturnedVal(emit.slow, slowPathConstAddr, ip);
+
+  // Whether the return value is true, namely whether its lower 32 bits is 0x01.
+  // w1 : bool (The tag is in the higher 32 bit of x1, w1 is 1 or 0.)
+  emit.slow.cmpImm<W::L>(Reg::x1, 0);
+
+  // Jump to the target BB if true
+  emit.slow =
+      cjmpToBytecodeBB(emit.slow, Cond::NE, getBBIndex(ip, ipOffset));
+  // Jump to next ip if false
+  emit.slow.b(emit.fast.current());
+
+  describeSlowPathSection(emit.slow, false);
+  return emit;
+}
+
+Emitters FastJIT::compileNewObject(Emitters emit, const Inst *ip) {
+  uint8_t *constAddr;
+  emit.slow = getConstant(emit.slow, (void *)externNewObject, constAddr);
+  emit.fast =
+      callExternalWithReturnedVal(emit.fast, constAddr, ip->iNewObject.op1);
+  return emit;
+}
+
+Emitters
+FastJIT::compile3RegsInst(Emitters emit, const Inst *ip, void *externCallAddr) {
+  emit.fast = leaHermesReg(emit.fast, ip->iCreateThis.op2, Reg::x1);
+  emit.fast = leaHermesReg(emit.fast, ip->iCreateThis.op3, Reg::x2);
+
+  uint8_t *constAddr;
+  emit.slow = getConstant(emit.slow, externCallAddr, constAddr);
+
+  emit.fast = callExternal(emit.fast, constAddr, ip->iCreateThis.op1, ip);
+  return emit;
+}
+
+Emitters FastJIT::compileSelectObject(Emitters emit, const Inst *ip) {
+  // x9 = op3.
+  emit.fast = cmpSomeTag(emit.fast, ip->iSelectObject.op3, ObjectTag);
+
+  // Every case only skips over a couple of instructions, so no slow path is
+  // needed.
+  if (ip->iSelectObject.op1 == ip->iSelectObject.op3) {
+    // If op3 is object, jump to the end, since we don't need to mov between two
+    // same regs op1 and op3
+    Relo reloToEnd{ReloKind::Branch19, emit.fast.current(), 0};
+    emit.fast.bcond(Cond::EQ, emit.fast.current());
+    // else if op3 is not object
+    emit.fast = movHermesRegToHermesReg(
+        emit.fast, ip->iSelectObject.op2, ip->iSelectObject.op1);
+
+    applyRelocation(reloToEnd, emit.fast.current());
+  } else if (ip->iSelectObject.op1 == ip->iSelectObject.op2) {
+    // If op3 is not object, do nothing, since we don't need to mov between two
+    // same regs op1 and op2.
+    Relo reloToEnd{ReloKind::Branch19, emit.fast.current(), 0};
+    emit.fast.bcond(Cond::NE, emit.fast.current());
+    emit.fast =
+        movNativeRegToHermesReg(emit.fast, Reg::x9, ip->iSelectObject.op1);
+
+    applyRelocation(reloToEnd, emit.fast.current());
+  } else {
+    // If op3 is not object, the result is op2.
+    Relo reloToStore{ReloKind::Branch19, emit.fast.current(), 0};
+    emit.fast.bcond(Cond::EQ, emit.fast.current());
+    emit.fast =
+        movHermesRegToNativeReg(emit.fast, ip->iSelectObject.op2, Reg::x9);
+
+    applyRelocation(reloToStore, emit.fast.current());
+    // store the result
+    emit.fast =
+        movNativeRegToHermesReg(emit.fast, Reg::x9, ip->iSelectObject.op1);
+  }
+
+  return emit;
+}
+
+Emitters FastJIT::compileNewArray(Emitters emit, const Inst *ip) {
+  emit.fast.movImm(Reg::x1, ip->iNewArray.op2);
+
+  uint8_t *constAddr;
+  emit.slow = getConstant(emit.slow, (void *)externNewArray, constAddr);
+  emit.fast = callExternal(emit.fast, constAddr, ip->iNewArray.op1, ip);
+  return emit;
+}
+
+Emitters FastJIT::compileNewArrayWithBuffer(
+    Emitters emit,
+    const Inst *ip,
+    uint32_t idx) {
+  // current  code block -> arg2
+  emit = loadConstantAddrIntoNativeReg(emit, codeBlock_, Reg::x1);
+  //  a preallocation size hint (uint16_t) -> arg3
+  emit.fast.movImm(Reg::x2, ip->iNewArrayWithBuffer.op2);
+  // the number of static elements(uint16_t) -> arg4
+  emit.fast.movImm(Reg::x3, ip->iNewArrayWithBuffer.op3);
+  // the index in the array buffer table (uint16_t/uint32_t) -> arg5
+  emit.fast.movImm(Reg::x4, idx);
+  // the bytecode offset of the instruction -> arg6
+  emit.fast.movImm(Reg::x5, codeBlock_->getOffsetOf(ip));
+
+  uint8_t *constAddr;
+  emit.slow =
+      getConstant(emit.slow, (void *)externNewArrayWithBuffer, constAddr);
+  emit.fast =
+      callExternal(emit.fast, constAddr, ip->iNewArrayWithBuffer.op1, ip);
+  return emit;
+}
+
+Emitters
+FastJIT::compilePutOwnByIndex(Emitters emit, const Inst *ip, uint32_t idx) {
+  // Object to put in -> arg2
+  emit.fast = leaHermesReg(emit.fast, ip->iPutOwnByIndex.op1, Reg::x1);
+  // Property to be put -> arg3
+  emit.fast = leaHermesReg(emit.fast, ip->iPutOwnByIndex.op2, Reg::x2);
+  // Property index -> arg4
+  emit.fast.movImm(Reg::x3, idx);
+
+  uint8_t *constAddr;
+  emit.slow = getConstant(emit.slow, (void *)externPutOwnByIndex, constAddr);
+  emit.fast = callExternalNoReturnedVal(emit.fast, constAddr, ip);
+
+  return emit;
+}
+
+Emitters
+FastJIT::compilePutNewOwnById(Emitters emit, const Inst *ip, uint32_t idx) {
+  // Object to put property in -> arg2
+  emit.fast = leaHermesReg(emit.fast, ip->iPutOwnByIndex.op1, Reg::x1);
+  // Property to be put -> arg3
+  emit.fast = leaHermesReg(emit.fast, ip->iPutOwnByIndex.op2, Reg::x2);
+  // The symbol must already exist in the map, so we could just pass the
+  // IdentifierID
+  emit.fast.movImm(
+      Reg::x3,
+      codeBlock_->getRuntimeModule()
+          ->getIdentifierSymbolID(idx)
+          .unsafeGetIndex());
+
+  uint8_t *constAddr;
+  emit.slow = getConstant(emit.slow, (void *)externPutNewOwnById, constAddr);
+  emit.fast = callExternalNoReturnedVal(emit.fast, constAddr, ip);
+
+  return emit;
+}
+
+Emitters FastJIT::compileLoadThisNS(Emitters emit, const Inst *ip) {
+  // StackFrameLayout::ThisArg is not technically a local register, but we could
+  // still use the same way to read it.
+  return coerceThisHelper(
+      emit, ip, StackFrameLayout::FirstLocal - StackFrameLayout::ThisArg);
+}
+Emitters FastJIT::compileCoerceThisNS(Emitters emit, const Inst *ip) {
+  return coerceThisHelper(emit, ip, ip->iCoerceThisNS.op2);
+}
+
+Emitter FastJIT::cmpNullOrUndefinedTag(Emitter emit, uint32_t regIdx) {
+  constexpr uint16_t undefinedOrNullTag =
+      (uint16_t)(((uint32_t)UndefinedTag & NullTag) >> 1);
+  // The complement of the highest 16 bits, so it fits in the CMP immediate.
+  constexpr uint16_t invertedUndefinedOrNullTag =
+      (uint16_t)~undefinedOrNullTag;
+  static_assert(
+      isAddSubImm(invertedUndefinedOrNullTag),
+      "inverted tag must fit in an immediate");
+
+  emit = movHermesRegToNativeReg(emit, regIdx, Reg::x9);
+  emit.mvnReg(Reg::x9, Reg::x9);
+  emit.lsrImm(Reg::x9, Reg::x9, 48);
+  emit.cmpImm(Reg::x9, invertedUndefinedOrNullTag);
+  return emit;
+}
+
+Emitters
+FastJIT::coerceThisHelper(Emitters emit, const Inst *ip, uint32_t regIndex) {
+  uint8_t *slowPathConstAddr;
+  emit.slow =
+      getConstant(emit.slow, (void *)slowPathCoerceThis, slowPathConstAddr);
+  uint8_t *slowPathAddr = emit.slow.current();
+
+  // Fast path: objects are used as they are. x9 = the value.
+  emit.fast = cmpSomeTag(emit.fast, regIndex, ObjectTag);
+  emit.fast = cjmpTo(emit.fast, Cond::NE, slowPathAddr);
+  if (regIndex != ip->iLoadThisNS.op1)
+    emit.fast =
+        movNativeRegToHermesReg(emit.fast, Reg::x9, ip->iLoadThisNS.op1);
+
+  // Slow path:
+  // If regIndex is null or undefined
+  emit.slow = cmpNullOrUndefinedTag(emit.slow, regIndex);
+
+  Relo reloToElse{ReloKind::Branch19, emit.slow.current(), 0};
+  emit.slow.bcond(Cond::NE, emit.slow.current());
+
+  emit.slow = movRuntimeVarToHermesReg(
+      emit.slow, RuntimeOffsets::globalObject, ip->iLoadThisNS.op1);
+  emit.slow.b(emit.fast.current());
+
+  applyRelocation(reloToElse, emit.slow.current());
+  // Else: emit the actual slow path call
+  emit.slow = leaHermesReg(emit.slow, regIndex, Reg::x1);
+  emit.slow =
+      callExternal(emit.slow, slowPathConstAddr, ip->iLoadThisNS.op1, ip);
+  emit.slow.b(emit.fast.current());
+  describeSlowPathSection(emit.slow, false);
+
+  return emit;
+}
+
+inline Emitter FastJIT::movRuntimeVarToHermesReg(
+    Emitter emit,
+    uint32_t runtimeVar,
+    OperandReg32 dst) {
+  emit = ldrMem(emit, Reg::x9, RegRuntime, runtimeVar);
+  emit = movNativeRegToHermesReg(emit, Reg::x9, dst);
+  return emit;
+}
+
+inline Emitter FastJIT::movHermesRegToRuntimeVar(
+    Emitter emit,
+    uint32_t runtimeVar,
+    OperandReg32 src) {
+  emit = movHermesRegToNativeReg(emit, src, Reg::x9);
+  emit = strMem(emit, Reg::x9, RegRuntime, runtimeVar);
+  return emit;
+}
+
+unsigned FastJIT::getCatchHandlerBBIndex(const Inst *ip) {
+  // The offset between catch handler ip and codeBlock_->begin()
+  int32_t handlerOffset = codeBlock_->findCatchTargetOffset(
+      (const uint8_t *)ip - (const uint8_t *)codeBlock_->begin());
+  assert(
+      bcBasicBlocks_.size() > 0 &&
+      "We should at least have one BB which is epilogue.");
+  if (handlerOffset == -1)
+    return bcBasicBlocks_.size() - 1; // exit block
+  else {
+    // The last BB is the epilogue which could not be a catch handler BB.
+    assert(
+        handlerOffset >= 0 && (uint32_t)handlerOffset < bcBasicBlocks_.back() &&
+        "The catch handler basic block offset is out of bound.");
+    assert(
+        bcLabels_.find(handlerOffset) != bcLabels_.end() &&
+        "handlerOffset not in bcLabels_");
+    return bcLabels_[handlerOffset];
+  }
+}
+
+Emitters FastJIT::compileCatch(Emitters emit, const Inst *ip) {
+  emit.fast = movRuntimeVarToHermesReg(
+      emit.fast, RuntimeOffsets::thrownValue, ip->iCatch.op1);
+  // Clear Runtime::thrownValue_
+  emit = loadConstantIntoNativeReg(
+      emit, HermesValue::encodeEmptyValue(), Reg::x9);
+  emit.fast =
+      strMem(emit.fast, Reg::x9, RegRuntime, RuntimeOffsets::thrownValue);
+
+  return emit;
+}
+
+Emitters FastJIT::compileThrow(Emitters emit, const Inst *ip) {
+  emit.fast = movHermesRegToRuntimeVar(
+      emit.fast, RuntimeOffsets::thrownValue, ip->iThrow.op1);
+
+  // return exception
+  emit.fast.movz<W::L>(Reg::x0, 0);
+  emit.fast = jmpToBytecodeBB(emit.fast, bcBasicBlocks_.size() - 1);
+  return emit;
+}
+
+Emitters FastJIT::compileNewObjectWithBuffer(Emitters emit, const Inst *ip) {
+  return newObjectWithBufferHelper(
+      emit, ip, ip->iNewObjectWithBuffer.op4, ip->iNewObjectWithBuffer.op5);
+}
+Emitters FastJIT::compileNewObjectWithBufferLong(
+    Emitters emit,
+    const Inst *ip) {
+  return newObjectWithBufferHelper(
+      emit,
+      ip,
+      ip->iNewObjectWithBufferLong.op4,
+      ip->iNewObjectWithBufferLong.op5);
+}
+Emitters FastJIT::newObjectWithBufferHelper(
+    Emitters emit,
+    const Inst *ip,
+    uint32_t keyIdx,
+    uint32_t valIdx) {
+  // current  code block -> arg2
+  emit = loadConstantAddrIntoNativeReg(emit, codeBlock_, Reg::x1);
+  // the number of static elements. (uint16_t) -> arg3
+  emit.fast.movImm(Reg::x2, ip->iNewObjectWithBuffer.op3);
+  // the index in the object key buffer table (uint16_t/uint32_t) -> arg4
+  emit.fast.movImm(Reg::x3, keyIdx);
+  // the index in the object val buffer table (uint16_t/uint32_t) -> arg5
+  emit.fast.movImm(Reg::x4, valIdx);
+  // the bytecode offset of the instruction -> arg6
+  emit.fast.movImm(Reg::x5, codeBlock_->getOffsetOf(ip));
+
+  uint8_t *constAddr;
+  emit.slow =
+      getConstant(emit.slow, (void *)externNewObjectWithBuffer, constAddr);
+  emit.fast =
+      callExternal(emit.fast, constAddr, ip->iNewObjectWithBuffer.op1, ip);
+  return emit;
+}
+
+Emitters FastJIT::compilePutByVal(Emitters emit, const Inst *ip) {
+  // object -> arg2
+  emit.fast = leaHermesReg(emit.fast, ip->iPutByVal.op1, Reg::x1);
+  // nameVal -> arg3
+  emit.fast = leaHermesReg(emit.fast, ip->iPutByVal.op2, Reg::x2);
+  // property value -> arg4
+  emit.fast = leaHermesReg(emit.fast, ip->iPutByVal.op3, Reg::x3);
+  // PropOpFlags -> arg5
+  auto defaultPropOpFlags = codeBlock_->isStrictMode()
+      ? PropOpFlags().plusThrowOnError()
+      : PropOpFlags();
+  emit.fast.movImm(Reg::x4, defaultPropOpFlags.getRaw());
+
+  uint8_t *constAddr;
+  emit.slow = getConstant(emit.slow, (void *)externPutByVal, constAddr);
+  emit.fast = callExternalNoReturnedVal(emit.fast, constAddr, ip);
+  return emit;
+}
+
+Emitters FastJIT::compileDelByVal(Emitters emit, const Inst *ip) {
+  // PropOpFlags -> arg4
+  auto defaultPropOpFlags = codeBlock_->isStrictMode()
+      ? PropOpFlags().plusThrowOnError()
+      : PropOpFlags();
+  emit.fast.movImm(Reg::x3, defaultPropOpFlags.getRaw());
+  return compile3RegsInst(emit, ip, (void *)externDelByVal);
+}
+
+Emitters FastJIT::storeToEnvironmentHelper(
+    Emitters emit,
+    uint32_t op1,
+    uint32_t idx,
+    uint32_t op3,
+    bool isNP) {
+  // environment -> arg1
+  emit.fast = leaHermesReg(emit.fast, op1, Reg::x0);
+  // slot index -> arg2
+  emit.fast.movImm(Reg::x1, idx);
+  // value -> arg3
+  emit.fast = leaHermesReg(emit.fast, op3, Reg::x2);
+
+  if (!isNP)
+    // runtime -> arg4
+    emit.fast.movRegToReg(RegRuntime, Reg::x3);
+
+  uint8_t *constAddr;
+  emit.slow = getConstant(
+      emit.slow,
+      isNP ? (void *)externStoreNPToEnvironment
+           : (void *)externStoreToEnvironment,
+      constAddr);
+  emit.fast = callAbsolute(emit.fast, constAddr);
+  // the external call returns void
+
+  return emit;
+}
+Emitters FastJIT::compileStoreToEnvironment(Emitters emit, const Inst *ip) {
+  return storeToEnvironmentHelper(
+      emit,
+      ip->iStoreToEnvironment.op1,
+      ip->iStoreToEnvironment.op2,
+      ip->iStoreToEnvironment.op3,
+      false);
+}
+Emitters FastJIT::compileStoreToEnvironmentL(Emitters emit, const Inst *ip) {
+  return storeToEnvironmentHelper(
+      emit,
+      ip->iStoreToEnvironmentL.op1,
+      ip->iStoreToEnvironmentL.op2,
+      ip->iStoreToEnvironmentL.op3,
+      false);
+}
+Emitters FastJIT::compileStoreNPToEnvironment(Emitters emit, const Inst *ip) {
+  return storeToEnvironmentHelper(
+      emit,
+      ip->iStoreNPToEnvironment.op1,
+      ip->iStoreNPToEnvironment.op2,
+      ip->iStoreNPToEnvironment.op3,
+      true);
+}
+Emitters FastJIT::compileStoreNPToEnvironmentL(Emitters emit, const Inst *ip) {
+  return storeToEnvironmentHelper(
+      emit,
+      ip->iStoreNPToEnvironmentL.op1,
+      ip->iStoreNPToEnvironmentL.op2,
+      ip->iStoreNPToEnvironmentL.op3,
+      true);
+}
+
+Emitters FastJIT::compileLoadFromEnvironment(
+    Emitters emit,
+    const Inst *ip,
+    uint32_t idx) {
+  emit.fast = leaHermesReg(emit.fast, ip->iLoadFromEnvironment.op2, Reg::x0);
+  emit.fast.movImm(Reg::x1, idx);
+  uint8_t *constAddr;
+  emit.slow =
+      getConstant(emit.slow, (void *)externLoadFromEnvironment, constAddr);
+  emit.fast = callAbsolute(emit.fast, constAddr);
+
+  emit.fast = movNativeRegToHermesReg(
+      emit.fast, Reg::x0, ip->iLoadFromEnvironment.op1);
+  return emit;
+}
+
+Emitters FastJIT::compileNot(Emitters emit, const Inst *ip) {
+  uint8_t *slowPathConstAddr;
+  emit.slow = getConstant(emit.slow, (void *)toBoolean, slowPathConstAddr);
+  uint8_t *slowPathAddr = emit.slow.current();
+
+  // Fast Path: check if op2 is a bool
+  emit.fast = cmpSomeTag(emit.fast, ip->iNot.op2, BoolTag);
+  emit.fast = cjmpTo(emit.fast, Cond::NE, slowPathAddr);
+  emit.fast.cmpImm<W::L>(Reg::x9, 0);
+
+  // Both paths join here with the flags set by comparing the bool with 0.
+  uint8_t *jmpBacktoFp = emit.fast.current();
+  emit.fast.cset(Reg::x9, Cond::EQ);
+  emit.fast = encodeBoolHVInNativeReg(emit.fast, Reg::x9);
+  emit.fast = movNativeRegToHermesReg(emit.fast, Reg::x9, ip->iNot.op1);
+
+  // Slow path: emit the external call to toBoolean
+  emit.slow = movHermesRegToNativeReg(emit.slow, ip->iNot.op2, Reg::x0);
+  emit.slow = callAbsolute(emit.slow, slowPathConstAddr);
+  emit.slow.uxtb(Reg::x0, Reg::x0);
+  emit.slow.cmpImm<W::L>(Reg::x0, 0);
+  emit.slow.b(jmpBacktoFp);
+
+  describeSlowPathSection(emit.slow, false);
+
+  return emit;
+}
+
+inline Emitter FastJIT::encodeBoolHVInNativeReg(Emitter emit, Reg nativeReg) {
+  constexpr uint64_t tagq = (uint64_t)BoolTag << HermesValue::kNumDataBits;
+  // The tag occupies only the highest 16 bits, so a single MOVZ loads it.
+  emit.movImm(RegScratch, tagq);
+  emit.orrReg(nativeReg, nativeReg, RegScratch);
+  return emit;
+}
+
+Emitters FastJIT::compileGetEnvironment(Emitters emit, const Inst *ip) {
+  // TODO: emit sequential inline code when levels are small, e.g. 1-3;
+  // TODO: otherwise emit a compact loop instead of external call
+  emit.fast.movRegToReg(RegRuntime, Reg::x0);
+  emit.fast.movRegToReg(RegFrame, Reg::x1);
+  emit.fast.movImm(Reg::x2, ip->iGetEnvironment.op2);
+
+  uint8_t *constAddr;
+  emit.slow = getConstant(emit.slow, (void *)externGetEnvironment, constAddr);
+  emit.fast = callAbsolute(emit.fast, constAddr);
+
+  emit.fast =
+      movNativeRegToHermesReg(emit.fast, Reg::x0, ip->iGetEnvironment.op1);
+  return emit;
+}
+
+Emitters FastJIT::compileLoadFromOuterEnvironment(
+    Emitters emit,
+    const Inst *ip) {
+  emit.fast.movRegToReg(RegRuntime, Reg::x0);
+  emit.fast.movRegToReg(RegFrame, Reg::x1);
+  emit.fast.movImm(Reg::x2, ip->iLoadFromOuterEnvironment.op2);
+  emit.fast.movImm(Reg::x3, ip->iLoadFromOuterEnvironment.op3);
+
+  uint8_t *constAddr;
+  emit.slow = getConstant(
+      emit.slow, (void *)externLoadFromOuterEnvironment, constAddr);
+  emit.fast = callAbsolute(emit.fast, constAddr);
+
+  emit.fast = movNativeRegToHermesReg(
+      emit.fast, Reg::x0, ip->iLoadFromOuterEnvironment.op1);
+  return emit;
+}
+
+Emitters FastJIT::compileNegate(Emitters emit, const Inst *ip) {
+  uint8_t *externAddr;
+  emit.slow = getConstant(emit.slow, (void *)slowPathNegate, externAddr);
+  uint8_t *slowPathAddr = emit.slow.current();
+
+  // isNumber op2?
+  emit.fast = isNumber(emit.fast, ip->iNegate.op2, slowPathAddr);
+
+  emit.fast = movHermesRegToNativeReg(emit.fast, ip->iNegate.op2, FReg::d0);
+  emit.fast.fneg(FReg::d0, FReg::d0);
+  emit.fast = movNativeRegToHermesReg(emit.fast, FReg::d0, ip->iNegate.op1);
+
+  // slow path
+  emit.slow = leaHermesReg(emit.slow, ip->iNegate.op2, Reg::x1);
+  emit.slow = callExternal(emit.slow, externAddr, ip->iNegate.op1, ip);
+  emit.slow.b(emit.fast.current());
+  describeSlowPathSection(emit.slow, false);
+
+  return emit;
+}
+
+Emitters FastJIT::compileGetPNameList(Emitters emit, const Inst *ip) {
+  uint8_t *externAddr;
+  emit.slow = getConstant(
+      emit.slow, (void *)Interpreter::handleGetPNameList, externAddr);
+  // The frameRegs used in Interpreter::handleGetPNameList is actually the first
+  // local variable, not the stack pointer; so we just pass the address of r0.
+  emit.fast = leaHermesReg(emit.fast, 0, Reg::x1);
+  emit = loadConstantAddrIntoNativeReg(emit, (void *)ip, Reg::x2);
+  emit.fast = callExternalNoReturnedVal(emit.fast, externAddr, ip);
+  return emit;
+}
+
+Emitters FastJIT::compileGetNextPName(Emitters emit, const Inst *ip) {
+  uint8_t *externAddr;
+  emit.slow = getConstant(emit.slow, (void *)externGetNextPName, externAddr);
+
+  // array of props -> arg2
+  emit.fast = leaHermesReg(emit.fast, ip->iGetNextPName.op2, Reg::x1);
+  // object -> arg3
+  emit.fast = leaHermesReg(emit.fast, ip->iGetNextPName.op3, Reg::x2);
+  // iterating index reg -> arg4
+  emit.fast = leaHermesReg(emit.fast, ip->iGetNextPName.op4, Reg::x3);
+  // size of the property list -> arg5
+  emit.fast = leaHermesReg(emit.fast, ip->iGetNextPName.op5, Reg::x4);
+
+  emit.fast =
+      callExternalWithReturnedVal(emit.fast, externAddr, ip->iGetNextPName.op1);
+
+  return emit;
+}
+
+Emitters FastJIT::compileIteratorBegin(Emitters emit, const Inst *ip) {
+  emit.fast = leaHermesReg(emit.fast, ip->iIteratorBegin.op2, Reg::x1);
+
+  uint8_t *externConstAddr;
+  emit.slow =
+      getConstant(emit.slow, (void *)externIteratorBegin, externConstAddr);
+  emit.fast =
+      callExternal(emit.fast, externConstAddr, ip->iIteratorBegin.op1, ip);
+  return emit;
+}
+
+Emitters FastJIT::compileIteratorNext(Emitters emit, const Inst *ip) {
+  emit.fast = leaHermesReg(emit.fast, ip->iIteratorNext.op2, Reg::x1);
+  emit.fast = leaHermesReg(emit.fast, ip->iIteratorNext.op3, Reg::x2);
+
+  uint8_t *externConstAddr;
+  emit.slow =
+      getConstant(emit.slow, (void *)externIteratorNext, externConstAddr);
+  emit.fast =
+      callExternal(emit.fast, externConstAddr, ip->iIteratorNext.op1, ip);
+  return emit;
+}
+
+Emitters FastJIT::compileIteratorClose(Emitters emit, const Inst *ip) {
+  emit.fast = leaHermesReg(emit.fast, ip->iIteratorClose.op1, Reg::x1);
+  emit.fast.movImm(Reg::x2, ip->iIteratorClose.op2);
+
+  uint8_t *externConstAddr;
+  emit.slow =
+      getConstant(emit.slow, (void *)externIteratorClose, externConstAddr);
+  emit.fast = callExternalNoReturnedVal(emit.fast, externConstAddr, ip);
+  return emit;
+}
+
+Emitters FastJIT::compileReifyArguments(Emitters emit, const Inst *ip) {
+  uint8_t *externConstAddr;
+  emit.slow = getConstant(
+      emit.slow, (void *)externSlowPathReifyArguments, externConstAddr);
+  uint8_t *slowPathAddr = emit.slow.current();
+
+  emit.fast = cmpSomeTag(emit.fast, ip->iReifyArguments.op1, UndefinedTag);
+  emit.fast = cjmpTo(emit.fast, Cond::EQ, slowPathAddr);
+  // Fast path: if the arguments object was already created, do nothing.
+
+  // Slow path
+  emit.slow.movRegToReg(RegFrame, Reg::x1);
+  emit.slow.movImm(Reg::x2, codeBlock_->isStrictMode());
+  emit.slow =
+      callExternal(emit.slow, externConstAddr, ip->iReifyArguments.op1, ip);
+  emit.slow.b(emit.fast.current());
+  describeSlowPathSection(emit.slow, false);
+
+  return emit;
+}
+
+Emitters FastJIT::compileGetArgumentsPropByVal(Emitters emit, const Inst *ip) {
+  // TODO: Add a fast path similar to the interpreter one.
+  emit.fast = leaHermesReg(emit.fast, ip->iGetArgumentsPropByVal.op3, Reg::x1);
+  emit.fast = leaHermesReg(emit.fast, ip->iGetArgumentsPropByVal.op2, Reg::x2);
+  emit.fast.movRegToReg(RegFrame, Reg::x3);
+  emit.fast.movImm(Reg::x4, codeBlock_->isStrictMode());
+
+  uint8_t *externConstAddr;
+  emit.slow = getConstant(
+      emit.slow, (void *)externSlowPathGetArgumentsPropByVal, externConstAddr);
+  emit.fast = callExternal(
+      emit.fast, externConstAddr, ip->iGetArgumentsPropByVal.op1, ip);
+  return emit;
+}
+
+Emitters FastJIT::compileCallApplyArguments(Emitters emit, const Inst *ip) {
+  emit.fast = leaHermesReg(emit.fast, ip->iCallApplyArguments.op5, Reg::x1);
+  emit.fast = leaHermesReg(emit.fast, ip->iCallApplyArguments.op2, Reg::x2);
+  emit.fast = leaHermesReg(emit.fast, ip->iCallApplyArguments.op3, Reg::x3);
+  emit.fast = leaHermesReg(emit.fast, ip->iCallApplyArguments.op4, Reg::x4);
+  emit.fast.movImm(Reg::x5, codeBlock_->isStrictMode());
+
+  uint8_t *externConstAddr;
+  emit.slow = getConstant(
+      emit.slow, (void *)externCallApplyArguments, externConstAddr);
+  emit.fast = callExternal(
+      emit.fast, externConstAddr, ip->iCallApplyArguments.op1, ip);
+  return emit;
+}
+
+Emitters FastJIT::compileBitNot(Emitters emit, const Inst *ip) {
+  uint8_t *slowPathConstAddr;
+  emit.slow =
+      getConstant(emit.slow, (void *)externSlowPathBitNot, slowPathConstAddr);
+  uint8_t *slowPathAddr = emit.slow.current();
+
+  emit.fast = isNumber(emit.fast, ip->iBitNot.op2, slowPathAddr);
+  emit.fast = movHermesRegToNativeReg(emit.fast, ip->iBitNot.op2, FReg::d0);
+  // Convert to a signed integer, rounding towards zero, and back.
+  emit.fast.fcvtzsToW(Reg::x9, FReg::d0);
+  emit.fast.scvtfFromW(FReg::d1, Reg::x9);
+  emit.fast.fcmp(FReg::d0, FReg::d1);
+  // if op2 is not already a int32, jump to slow path
+  emit.fast = cjmpTo(emit.fast, Cond::NE, slowPathAddr);
+  emit.fast.mvnReg<W::L>(Reg::x9, Reg::x9);
+  emit.fast.scvtfFromW(FReg::d0, Reg::x9);
+  emit.fast = movNativeRegToHermesReg(emit.fast, FReg::d0, ip->iBitNot.op1);
+
+  // Slow path
+  emit.slow = leaHermesReg(emit.slow, ip->iBitNot.op2, Reg::x1);
+  emit.slow = callExternal(emit.slow, slowPathConstAddr, ip->iBitNot.op1, ip);
+  emit.slow.b(emit.fast.current());
+  describeSlowPathSection(emit.slow, false);
+
+  return emit;
+}
+
+Emitters FastJIT::compileGetArgumentsLength(Emitters emit, const Inst *ip) {
+  uint8_t *slowPathConstAddr;
+  emit.slow = getConstant(
+      emit.slow, (void *)slowPathGetArgumentsLength, slowPathConstAddr);
+  uint8_t *slowPathAddr = emit.slow.current();
+
+  // Fast path: when op2 is undefined
+  emit.fast = cmpSomeTag(emit.fast, ip->iGetArgumentsLength.op2, UndefinedTag);
+  emit.fast = cjmpTo(emit.fast, Cond::NE, slowPathAddr);
+  // We only load the lower 32 bits value which are the real arg count, while
+  // the higher 32 bits are the native tag
+  emit.fast = ldrMem<W::L>(
+      emit.fast,
+      Reg::x9,
+      RegFrame,
+      sizeof(HermesValue) * StackFrameLayout::ArgCount);
+  emit.fast.ucvtfFromW(FReg::d0, Reg::x9);
+  emit.fast = movNativeRegToHermesReg(
+      emit.fast, FReg::d0, ip->iGetArgumentsLength.op1);
+
+  // Slow path:
+  emit.slow = leaHermesReg(emit.slow, ip->iGetArgumentsLength.op2, Reg::x1);
+  emit.slow = callExternal(
+      emit.slow, slowPathConstAddr, ip->iGetArgumentsLength.op1, ip);
+  emit.slow.b(emit.fast.current());
+  describeSlowPathSection(emit.slow, false);
+
+  return emit;
+}
+
+Emitters FastJIT::compileCreateRegExp(Emitters emit, const Inst *ip) {
+  emit.fast.movImm(Reg::x1, ip->iCreateRegExp.op2);
+  emit.fast.movImm(Reg::x2, ip->iCreateRegExp.op3);
+  emit.fast.movImm(Reg::x3, ip->iCreateRegExp.op4);
+  emit = loadConstantAddrIntoNativeReg(emit, codeBlock_, Reg::x4);
+
+  uint8_t *externConstAddr;
+  emit.slow = getConstant(
+      emit.slow, (void *)externCreateRegExpMayAllocate, externConstAddr);
+  emit.fast =
+      callExternal(emit.fast, externConstAddr, ip->iCreateRegExp.op1, ip);
+  return emit;
+}
+
+} // namespace arm64
+} // namespace vm
+} // namespace hermes
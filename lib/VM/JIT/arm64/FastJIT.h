@@ -0,0 +1,644 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_VM_JIT_ARM64_FASTJIT_H
+#define HERMES_VM_JIT_ARM64_FASTJIT_H
+
+#include "hermes/BCGen/HBC/StackFrameLayout.h"
+#include "hermes/VM/JIT/DenseUInt64.h"
+#include "hermes/VM/JIT/arm64/Emitter.h"
+#include "hermes/VM/JIT/arm64/JIT.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Support/Debug.h"
+
+namespace hermes {
+namespace vm {
+
+using hermes::hbc::StackFrameLayout;
+using namespace hermes::inst;
+
+namespace arm64 {
+
+/// Encodes the kind of operation the relocation performs.
+enum class ReloKind : uint8_t {
+  None = 0,
+  /// The imm26 field of the B instruction at relo.address.
+  Branch26,
+  /// The imm19 field of the B.cond, CBZ or CBNZ instruction at relo.address.
+  Branch19,
+};
+
+/// Information about a single relocation in the executable code.
+/// A relocation encodes an operation that is applied to the executable code
+/// after a target address becomes known.
+struct Relo {
+  /// What kind of operation the relocation performs.
+  ReloKind kind;
+  /// The instruction which is updated when the relocation is applied.
+  uint8_t *address;
+  /// The relocation target, in other words, the address that wasn't yet known
+  /// when the relocation was created.
+  unsigned targetBCBBIndex;
+
+  Relo(ReloKind kind, uint8_t *address, unsigned int targetBCBBIndex)
+      : kind(kind), address(address), targetBCBBIndex(targetBCBBIndex) {}
+  Relo() = default;
+};
+
+/// A pair of emitters for the fast path and the slow path. This class must be
+/// passed and returned only by value (for performance reasons).
+class Emitters {
+ public:
+  Emitter fast;
+  Emitter slow;
+} HERMES_ATTRIBUTE_WARN_UNUSED_RESULT_TYPE;
+
+/// An instance of this class is constructed to compile a single CodeBlock to
+/// native code.
+/// The generated code follows the same structure as the x86-64 backend: a
+/// fast path buffer with the inline code of every basic block, and a slow
+/// path buffer holding out of line code and the constant pool. Both buffers
+/// belong to the same ExecHeap pool, so they are always within range of
+/// unconditional branches and ADRP; conditional branches, which only reach
+/// +-1MB, are emitted as an inverted conditional branch over a B when the
+/// target may be further away.
+class FastJIT {
+ public:
+  FastJIT(JITContext *context, CodeBlock *codeBlock);
+
+  /// Attempt to compile the associated CodeBlock. On success, the JIT function
+  /// pointer in the CodeBlock will be set to the compiled body.
+  void compile();
+
+  /// \return the conservative sizes of the fast and slow path blocks that are
+  ///     allocated to compile \p bytecodeLength bytes of bytecode.
+  static ExecHeap::SizePair estimateSizes(size_t bytecodeLength);
+
+  /// A pointer to binOpN instruction's compilation function.
+  typedef Emitters (FastJIT::*compileBinOpNPtr)(Emitters emit, const Inst *ip);
+
+ private:
+  /// Raise the error flag and record an error message.
+  void error(const llvm::Twine &msg);
+
+  /// Allocate executable memory using a conservative size estimate based on
+  /// bytecode length and make it writable. On failure it sets the error
+  /// message and flag.
+  /// \param bytecodeLength the length of the bytecode we will be compiling.
+  /// \param[out] sizes on successful exit contains the size of the two
+  ///     allocated memory blocks (fast paths and slow paths). Undefined
+  ///     on failure.
+  /// \return pointers to both allocated blocks on success.
+  llvm::Optional<ExecHeap::BlockPair> allocCode(
+      size_t bytecodeLength,
+      ExecHeap::SizePair &sizes);
+
+  /// Initialize a newly allocated executable memory pool, for example by pre-
+  /// allocating some blocks and initializing their contents.
+  void initializeNewPool(ExecHeap::DualPool *pool);
+
+  /// Disassemble a range of executable code.
+  /// \param withAddr whether to dump the addresses and bytes of instructions.
+  void disassembleRange(
+      const uint8_t *from,
+      const uint8_t *to,
+      llvm::raw_ostream &OS,
+      bool withAddr) const;
+
+  /// Disassemble the entire compiled function.
+  /// \param withAddr whether to dump the addresses and bytes of instructions.
+  void disassembleResult(Emitters emit, llvm::raw_ostream &OS, bool withAddr)
+      const;
+
+  /// Apply a single relocation with an already resolved address \p target.
+  void applyRelocation(const Relo &relo, const uint8_t *target);
+
+  /// Resolve all recorded relocations and clear the relocation list \c relocs_.
+  void resolveRelocations();
+
+  /// \return true if we can safely write at least \c kMinInstructionSpace of
+  ///   bytes in the fast and slow path buffers. Set the error flag and message
+  ///   and return false otherwise.
+  inline bool checkSpace(const Emitters &emit);
+
+  /// \return the offset in bytes from RegFrame to access the specified local
+  ///   Hermes register.
+  static inline int32_t localHermesRegByteOffset(uint32_t regIndex) {
+    return sizeof(HermesValue) * StackFrameLayout::localOffset(regIndex);
+  }
+
+  /// \return the complement of the tag \p tag, as computed by
+  ///   \c invertedTag().
+  static constexpr uint32_t invertTag(TagKind tag) {
+    return LastTag - tag;
+  }
+
+#ifndef NDEBUG
+  /// Add a descriptor for the last emitted section in the slow path, so it
+  /// can be disassembled correctly.
+  /// \param slow the current slow emitter.
+  /// \param data whether the section was code or data.
+  void describeSlowPathSection(Emitter slow, bool data);
+#else
+  void describeSlowPathSection(Emitter slow, bool data) {}
+#endif
+
+  /// @name Emitters
+  /// Every emitter function receives Emitters as a first parameter
+  /// and returns it after updating it internally. Emitter function assume that
+  /// checkSpace() has already been called, except where noted.
+  /// @{
+
+  /// Emit the function prologue. Calls checkSpace() before emitting.
+  /// \param clearRegisters whether to initialize the Hermes registers of the
+  ///     new frame to undefined. OSR entries keep the values left there by the
+  ///     interpreter.
+  Emitters emitPrologue(Emitters emit, bool clearRegisters = true);
+  /// Emit the function epilogue. Calls checkSpace() before emitting.
+  Emitters emitEpilogue(Emitters emit);
+  /// Emit an OSR entry for every loop header: a prologue which adopts the
+  /// registers of the interpreter frame, followed by a jump into the loop.
+  /// Calls checkSpace() before emitting every entry.
+  Emitters emitOSREntries(Emitters emit);
+
+  /// Emit the code for a basic block. Calls checkSpace() before processing
+  /// every bytecode instruction.
+  Emitters compileBB(Emitters emit);
+
+  /// Lookup or add the specified constant and return its offset.
+  /// \param slow the slow-path emitter.
+  /// \param cval the constant
+  /// \param[out] constAddr will be initialized with the address of the
+  ///     constant.
+  /// \return the updated slow-path emitter.
+  Emitter getConstant(Emitter slow, uint64_t cval, uint8_t *&constAddr);
+  Emitter getConstant(Emitter slow, HermesValue hv, uint8_t *&constAddr) {
+    return getConstant(slow, hv.getRaw(), constAddr);
+  }
+  Emitter getConstant(Emitter slow, void *addr, uint8_t *&constAddr) {
+    return getConstant(slow, (uint64_t)addr, constAddr);
+  }
+
+  /// Load the constant at \p constAddr in the constant pool into \p reg.
+  static Emitter loadConstant(Emitter emit, const uint8_t *constAddr, Reg reg);
+
+  /// \return the basic block's index according to the current \p ip and
+  /// the offset \p ipOffset.
+  unsigned getBBIndex(const Inst *ip, uint32_t ipOffset) {
+    uint32_t bcOffset = (const uint8_t *)ip + ipOffset - codeBlock_->begin();
+    return bcLabels_[bcOffset];
+  }
+
+  /// Load \p reg from, or store it to, \p base + \p offset, choosing the
+  /// shortest addressing form which can encode the offset. Offsets which
+  /// don't fit in the instruction are first materialized in RegOffset.
+  template <W w = W::Q>
+  static Emitter ldrMem(Emitter emit, Reg reg, Reg base, int32_t offset);
+  template <W w = W::Q>
+  static Emitter strMem(Emitter emit, Reg reg, Reg base, int32_t offset);
+  static Emitter ldrMem(Emitter emit, FReg reg, Reg base, int32_t offset);
+  static Emitter strMem(Emitter emit, FReg reg, Reg base, int32_t offset);
+
+  /// Set \p reg to \p base + \p offset. Uses RegOffset if the offset doesn't
+  /// fit in an ADD or SUB immediate.
+  static Emitter addOffset(Emitter emit, Reg reg, Reg base, int32_t offset);
+
+  /// Load the specified HermesValue constant \p cval into the specified native
+  /// register \p reg. Short constants are encoded as immediates, the rest
+  /// are loaded from the constant pool.
+  Emitters loadConstantIntoNativeReg(Emitters emit, HermesValue cval, Reg reg);
+  /// Load the specified address constant \p addr into the specified native
+  /// register \p reg. The address must be in the C heap, which is constant
+  /// and non-movable by GC.
+  Emitters loadConstantAddrIntoNativeReg(Emitters emit, void *addr, Reg reg);
+
+  /// Load the specified HermesValue constant \p value into Hermes register
+  /// \p hermesReg.
+  Emitters loadHermesValueConstant(
+      Emitters emit,
+      OperandReg32 hermesReg,
+      HermesValue value);
+
+  /// Mov the specified native register \p nativeReg to hermes register \p
+  /// hermesReg.
+  Emitter
+  movNativeRegToHermesReg(Emitter emit, Reg nativeReg, OperandReg32 hermesReg);
+  Emitter
+  movNativeRegToHermesReg(Emitter emit, FReg nativeReg, OperandReg32 hermesReg);
+
+  /// Mov the specified hermes register \p hermesReg to native register \p
+  /// nativeReg.
+  Emitter
+  movHermesRegToNativeReg(Emitter emit, OperandReg32 hermesReg, Reg nativeReg);
+  Emitter
+  movHermesRegToNativeReg(Emitter emit, OperandReg32 hermesReg, FReg nativeReg);
+
+  /// Move hermes reg \p src to hermes reg \p dst.
+  Emitter
+  movHermesRegToHermesReg(Emitter emit, OperandReg32 src, OperandReg32 dst);
+
+  /// Move a Runtime member variable \p runtimeVar to hermes reg \p dst.
+  Emitter
+  movRuntimeVarToHermesReg(Emitter emit, uint32_t runtimeVar, OperandReg32 dst);
+
+  /// Move a hermes reg \p src to a Runtime member variable \p runtimeVar.
+  Emitter
+  movHermesRegToRuntimeVar(Emitter emit, uint32_t runtimeVar, OperandReg32 src);
+
+  /// Load the address of the specified hermes register \p hermesReg into the
+  /// native register \p nativeReg.
+  Emitter leaHermesReg(Emitter emit, OperandReg32 hermesReg, Reg nativeReg);
+
+  /// Encode the \p nativeReg with a bool HermesValue tag.
+  /// The \p nativeReg must already contain a bool value (0 or 1).
+  Emitter encodeBoolHVInNativeReg(Emitter emit, Reg nativeReg);
+
+  /// Emit a call to the external function whose address is stored at \p dest
+  /// in the constant pool. The arguments must already be loaded.
+  Emitter callAbsolute(Emitter emit, const uint8_t *dest);
+
+  /// Load x0 with the Runtime register and emit a call to an external
+  /// function, check for exception and store the successful result in
+  /// \p resultReg.
+  /// \param dest the address of the location in the contant pool whose
+  /// value points to the address of the external call
+  /// \param ip the current ip used to find the corresponding catch handler if
+  /// an exception is returned by the external call.
+  Emitter callExternal(
+      Emitter emit,
+      const uint8_t *dest,
+      OperandReg32 resultReg,
+      const Inst *ip);
+
+  /// Load x0 with the Runtime register and emit a call to an external
+  /// function, check for exception, no return value.
+  /// \param dest the address of the location in the contant pool whose
+  /// value points to the address of the external call
+  /// \param ip the current ip used to find the corresponding catch handler if
+  /// an exception is returned by the external call.
+  Emitter
+  callExternalNoReturnedVal(Emitter emit, const uint8_t *dest, const Inst *ip);
+
+  /// Load x0 with the Runtime register and emit a call to an external
+  /// function whose address \p dest is in the constant pool, storing
+  /// the result in \p resultReg, and no execution exception.
+  Emitter callExternalWithReturnedVal(
+      Emitter emit,
+      const uint8_t *dest,
+      OperandReg32 resultReg);
+
+  /// Load x1 and x2 with the second and third operand of the binary operation
+  /// instruction, and emit an external slow path call at \p externBinOp.
+  /// \param externBinOp an address in the constant pool whose value points to a
+  /// slow-path binary operation function defined in ExternalCalls.h
+  Emitters
+  callSlowPathBinOp(Emitters emit, const Inst *ip, const uint8_t *externBinOp);
+
+  /// Load x1 and x2 with the second and third operand of the equality
+  /// test/jump instructions, emit an external call to
+  /// externAbstractEqualityTest, and check the returned ExecutionStatus.
+  Emitters
+  callExternEqTest(Emitters emit, const Inst *ip, uint32_t reg1, uint32_t reg2);
+
+  /// Load x0 and x1 with the second and third operand of the strict equality
+  /// test/jump instructions, emit an external call to StrictEqualityTest, and
+  /// set the flags by comparing the returned bool with zero.
+  Emitters callExternStrictEqTest(
+      Emitters emit,
+      const Inst *ip,
+      uint32_t reg1,
+      uint32_t reg2);
+
+  /// Emit a jump to a bytecode block.
+  /// Receives and \returns the fast path emitter.
+  Emitter jmpToBytecodeBB(Emitter emit, unsigned bytecodeBB);
+
+  /// Emit a conditional jump to a bytecode block.
+  Emitter cjmpToBytecodeBB(Emitter emit, Cond cc, unsigned bytecodeBB);
+
+  /// Emit a conditional jump to the already known address \p target, which
+  /// may be out of the range of B.cond.
+  static Emitter cjmpTo(Emitter emit, Cond cc, const uint8_t *target);
+
+  /// Emit the inline check of a GetById/PutById property cache into the fast
+  /// path: the Hermes register \p objReg must hold an object whose hidden
+  /// class is cached in the first way of the cache entry whose address is
+  /// stored at \p cacheConstAddr, and the cached slot must be stored directly
+  /// in the object. Otherwise control transfers to \p slowPathAddr.
+  /// On success x10 holds the address of the direct property slots and x11
+  /// the slot index. Clobbers x9, x10, x11 and x12.
+  Emitters emitPropertyCacheGuard(
+      Emitters emit,
+      uint32_t objReg,
+      const uint8_t *cacheConstAddr,
+      const uint8_t *slowPathAddr);
+
+  Emitters
+  getByIdHelper(Emitters emit, const Inst *ip, bool tryProp, uint32_t idVal);
+  Emitters
+  putByIdHelper(Emitters emit, const Inst *ip, bool tryProp, uint32_t idVal);
+  Emitters callHelper(
+      Emitters emit,
+      const Inst *ip,
+      uint32_t argCount,
+      bool isConstruct);
+  Emitters jmpUndefinedHelper(
+      Emitters emit,
+      const Inst *ip,
+      uint32_t ipOffset,
+      uint32_t regIndex);
+
+  /// In the fast path, check whether the value in hermes reg \p regIndex is an
+  /// object and if so copy it to the result reg; otherwise jump to the slow
+  /// path.
+  /// In the slow path, store runtime->global_ to the result reg if the value
+  /// is null or undefined, or the result of slowPathCoerceThis otherwise, and
+  /// jump back.
+  Emitters coerceThisHelper(Emitters emit, const Inst *ip, uint32_t regIndex);
+
+  /// Emit an external call to Interpreter::createObjectFromBuffer.
+  /// \param keyIdx index in the object key buffer table.
+  /// \param valIdx index in the object value buffer table.
+  Emitters newObjectWithBufferHelper(
+      Emitters emit,
+      const Inst *ip,
+      uint32_t keyIdx,
+      uint32_t valIdx);
+
+  /// Emit an external call to externStoreToEnvironment or
+  /// externStoreNPToEnvironment depending on if the value \p op3 is a pointer.
+  /// \param op1 the Hermes reg containing the environment
+  /// \param idx the environment index slot number
+  /// \param op3 the Hermes reg containing the value to be stored
+  /// \param isNP if the current instruction is StoreNPToEnvironment
+  Emitters storeToEnvironmentHelper(
+      Emitters emit,
+      uint32_t op1,
+      uint32_t idx,
+      uint32_t op3,
+      bool isNP);
+
+  // Individual instruction emitters
+  Emitters compileTypeOf(Emitters emit, const Inst *ip);
+  Emitters compileTypeOfIs(Emitters emit, const Inst *ip);
+
+  Emitters compileGetById(Emitters emit, const Inst *ip);
+  Emitters compileGetByIdLong(Emitters emit, const Inst *ip);
+  Emitters compileGetByIdShort(Emitters emit, const Inst *ip);
+  Emitters compileTryGetById(Emitters emit, const Inst *ip);
+  Emitters compileTryGetByIdLong(Emitters emit, const Inst *ip);
+
+  Emitters compilePutById(Emitters emit, const Inst *ip);
+  Emitters compilePutByIdShort(Emitters emit, const Inst *ip);
+  Emitters compilePutByIdLong(Emitters emit, const Inst *ip);
+  Emitters compileTryPutById(Emitters emit, const Inst *ip);
+  Emitters compileTryPutByIdLong(Emitters emit, const Inst *ip);
+
+  Emitters compileCall(Emitters emit, const Inst *ip);
+  Emitters compileCallLong(Emitters emit, const Inst *ip);
+  Emitters compileConstruct(Emitters emit, const Inst *ip);
+  Emitters compileConstructLong(Emitters emit, const Inst *ip);
+  Emitters compileCallBuiltin(Emitters emit, const Inst *ip);
+
+  /// Load into \p dst the complemented tag of the HermesValue in \p src:
+  /// (~src) >> kNumDataBits. Every tag then becomes a small number which
+  /// can be compared as an immediate (\c invertTag()), and every double is
+  /// larger than \c invertTag(FirstTag).
+  static Emitter invertedTag(Emitter emit, Reg src, Reg dst);
+
+  /// Emit a check that whether the value in the Hermes register \p regIndex is
+  /// a number; if not, emit a jump to the slow path \p callStub.
+  Emitter isNumber(Emitter emit, uint32_t regIndex, uint8_t *callStub);
+
+  /// Emit a check that whether the value in the Hermes register \p regIndex is
+  /// a string; if not, emit a jump to the slow path \p callStub.
+  Emitter isString(Emitter emit, uint32_t regIndex, uint8_t *callStub);
+
+  /// Load the value in the Hermes register \p regIndex into x9 and set the
+  /// flags by comparing its tag with \p tag, so that EQ means the value has
+  /// that tag. Clobbers x10.
+  Emitter cmpSomeTag(Emitter emit, uint32_t regIndex, TagKind tag);
+
+  /// If a value is undefined or null, its highest 17 bits are 0x1fff2 or
+  /// 0x1fff3, so we only need to check if its highest 16 bits are 0xfff9.
+  /// Set the flags so that EQ means the Hermes reg \p regIdx is null or
+  /// undefined. Clobbers x9.
+  Emitter cmpNullOrUndefinedTag(Emitter emit, uint32_t regIdx);
+
+  // Individual instruction emitters.
+  Emitters compileDeclareGlobalVar(Emitters emit, const Inst *ip);
+  Emitters compileCreateEnvironment(Emitters emit, const Inst *ip);
+  Emitters compileCreateClosure(Emitters emit, const Inst *ip);
+  Emitters compileGetGlobalObject(Emitters emit, const Inst *ip);
+  Emitters compileLoadConstZero(Emitters emit, const Inst *ip);
+  Emitters compileLoadParam(Emitters emit, const Inst *ip);
+  Emitters compileBinOp(
+      Emitters emit,
+      const Inst *ip,
+      void *slowPathBinOp,
+      compileBinOpNPtr binOpNPtr);
+  Emitters compileAddN(Emitters emit, const Inst *ip);
+  Emitters compileSubN(Emitters emit, const Inst *ip);
+  Emitters compileMulN(Emitters emit, const Inst *ip);
+  Emitters compileDivN(Emitters emit, const Inst *ip);
+  Emitters compileMov(Emitters emit, const Inst *ip);
+  Emitters compileMovLong(Emitters emit, const Inst *ip);
+  Emitters compileToNumber(Emitters emit, const Inst *ip);
+  Emitters compileAddEmptyString(Emitters emit, const Inst *ip);
+  Emitters compileRet(Emitters emit, const Inst *ip);
+  Emitters compileCondJumpN(
+      Emitters emit,
+      const Inst *ip,
+      uint32_t ipOffset,
+      uint32_t reg1,
+      uint32_t reg2,
+      Cond cc);
+  Emitters compileCondJump(
+      Emitters emit,
+      const Inst *ip,
+      uint32_t ipOffset,
+      uint32_t reg1,
+      uint32_t reg2,
+      Cond cc,
+      void *slowPathCall);
+  Emitters
+  compileLoadConstString(Emitters emit, const Inst *ip, uint32_t stringID);
+  Emitters compileStrictEqJump(
+      Emitters emit,
+      const Inst *ip,
+      uint32_t ipOffset,
+      uint32_t reg1,
+      uint32_t reg2,
+      Cond cc);
+  Emitters compileEqJump(
+      Emitters emit,
+      const Inst *ip,
+      uint32_t ipOffset,
+      uint32_t reg1,
+      uint32_t reg2,
+      Cond cc);
+
+  /// Fast path emits a check that if the value in hermes reg \p regIdx is a
+  /// bool HermesValue: if yes, directly jump according to the bool value; if
+  /// not, jump to the slow path.
+  /// Slow path emits an external call to Operation::toBoolean.
+  Emitters compileBoolJmp(
+      Emitters emit,
+      const Inst *ip,
+      uint32_t ipOffset,
+      uint32_t regIdx,
+      Cond cc);
+  Emitters compileJmpUndefined(Emitters emit, const Inst *ip);
+  Emitters compileJmpUndefinedLong(Emitters emit, const Inst *ip);
+  Emitters compileEqTest(Emitters emit, const Inst *ip, bool isNeq);
+  Emitters compileStrictEqTest(Emitters emit, const Inst *ip, bool isNeq);
+  Emitters compileJmp(Emitters emit, const Inst *ip, uint32_t ipOffset);
+  Emitters
+  compileCondOp(Emitters emit, const Inst *ip, Cond cc, void *slowPathCall);
+  Emitters compileCondOpN(Emitters emit, const Inst *ip, Cond cc);
+  Emitters compileNewObject(Emitters emit, const Inst *ip);
+
+  /// Compile instructions with the layout (name, Reg8, Reg8, Reg8).
+  /// Load x1 and x2 with the second and third operand, and emit an external
+  /// call at \p externCallAddr.
+  Emitters
+  compile3RegsInst(Emitters emit, const Inst *ip, void *externCallAddr);
+
+  Emitters compileSelectObject(Emitters emit, const Inst *ip);
+  Emitters compileNewArray(Emitters emit, const Inst *ip);
+  Emitters
+  compileNewArrayWithBuffer(Emitters emit, const Inst *ip, uint32_t idx);
+  Emitters compilePutOwnByIndex(Emitters emit, const Inst *ip, uint32_t idx);
+  Emitters compilePutNewOwnById(Emitters emit, const Inst *ip, uint32_t idx);
+  Emitters compileLoadThisNS(Emitters emit, const Inst *ip);
+  Emitters compileCoerceThisNS(Emitters emit, const Inst *ip);
+
+  /// \return the corresponding catch handler basic block index if it exists;
+  /// or \return the index of the exit block if not. (The caller will continue
+  /// to recursively finding the catch hanlder.)
+  unsigned getCatchHandlerBBIndex(const Inst *ip);
+  Emitters compileCatch(Emitters emit, const Inst *ip);
+  Emitters compileThrow(Emitters emit, const Inst *ip);
+  Emitters compileNewObjectWithBuffer(Emitters emit, const Inst *ip);
+  Emitters compileNewObjectWithBufferLong(Emitters emit, const Inst *ip);
+  Emitters compilePutByVal(Emitters emit, const Inst *ip);
+  Emitters compileDelByVal(Emitters emit, const Inst *ip);
+  Emitters compileStoreToEnvironment(Emitters emit, const Inst *ip);
+  Emitters compileStoreToEnvironmentL(Emitters emit, const Inst *ip);
+  Emitters compileStoreNPToEnvironment(Emitters emit, const Inst *ip);
+  Emitters compileStoreNPToEnvironmentL(Emitters emit, const Inst *ip);
+  Emitters
+  compileLoadFromEnvironment(Emitters emit, const Inst *ip, uint32_t idx);
+  Emitters compileNot(Emitters emit, const Inst *ip);
+  Emitters compileGetEnvironment(Emitters emit, const Inst *ip);
+  Emitters compileLoadFromOuterEnvironment(Emitters emit, const Inst *ip);
+  Emitters compileNegate(Emitters emit, const Inst *ip);
+  Emitters compileGetPNameList(Emitters emit, const Inst *ip);
+  Emitters compileGetNextPName(Emitters emit, const Inst *ip);
+  Emitters compileIteratorBegin(Emitters emit, const Inst *ip);
+  Emitters compileIteratorNext(Emitters emit, const Inst *ip);
+  Emitters compileIteratorClose(Emitters emit, const Inst *ip);
+  Emitters compileReifyArguments(Emitters emit, const Inst *ip);
+  Emitters compileGetArgumentsPropByVal(Emitters emit, const Inst *ip);
+  Emitters compileCallApplyArguments(Emitters emit, const Inst *ip);
+  Emitters compileBitNot(Emitters emit, const Inst *ip);
+  Emitters compileGetArgumentsLength(Emitters emit, const Inst *ip);
+  Emitters compileCreateRegExp(Emitters emit, const Inst *ip);
+
+  /// @}
+
+ private:
+  /// The JITContect we are associated with.
+  JITContext *const context_;
+  /// The CodeBlock we are compiling.
+  CodeBlock *const codeBlock_;
+
+  /// Minimum number of instruction buffer space we need available at any
+  /// point.
+  static constexpr unsigned kMinInstructionSpace = 1024;
+
+  /// The starting offset of every bytecode basic block in order. The last
+  /// entry is the end of the bytecode.
+  std::vector<uint32_t> bcBasicBlocks_{};
+
+  /// Map from a bytecode target label offset to a basic block index.
+  llvm::DenseMap<uint32_t, unsigned> bcLabels_{};
+
+  /// Index of every bytecode basic block which is the target of a backward
+  /// branch, in order.
+  std::vector<unsigned> bcLoopHeaders_{};
+
+  /// The native code offset of every compiled bc BB.
+  std::vector<uint8_t *> nativeBBAddress_{};
+
+  /// The native OSR entry of every loop header in \c bcLoopHeaders_.
+  std::vector<uint8_t *> nativeOSREntryAddress_{};
+
+  /// Relocations.
+  std::vector<Relo> relocs_{};
+
+  /// Index of the bytecode basic block (in \c bcBasicBlocks_) that we are
+  /// currently compiling.
+  unsigned curBytecodeBBIndex_ = 0;
+
+  /// Set if an error occurred.
+  bool error_ = false;
+  /// Optional error message, set the first time we record an error.
+  std::string errorMsg_{};
+
+  // The fast-path execution region.
+  llvm::MutableArrayRef<uint8_t> fast_;
+  // The slow-path execution region.
+  llvm::MutableArrayRef<uint8_t> slow_;
+
+  llvm::DenseMap<DenseUInt64, uint8_t *> doubleConstants_{};
+
+#ifndef NDEBUG
+  /// A section describing a section of code for disassembly.
+  struct Section {
+    // Is the section code or data.
+    bool data;
+    const uint8_t *start;
+    const uint8_t *end;
+
+    Section(bool data, uint8_t const *start, uint8_t const *end)
+        : data(data), start(start), end(end) {}
+  };
+
+  // Keep track of slow path sections for disassembly.
+  std::vector<Section> slowPathSections_{};
+#endif
+};
+
+inline bool FastJIT::checkSpace(const Emitters &emit) {
+  if (LLVM_UNLIKELY(fast_.end() - emit.fast.current() < kMinInstructionSpace)) {
+    error("fast-path overflow");
+    return false;
+  }
+  if (LLVM_UNLIKELY(slow_.end() - emit.slow.current() < kMinInstructionSpace)) {
+    error("slow-path overflow");
+    return false;
+  }
+  return true;
+}
+
+/// Callee-save register pointing to "Runtime" throughout the function.
+constexpr auto RegRuntime = Reg::x19;
+/// Callee-save register pointing to the first local Hermes register.
+constexpr auto RegFrame = Reg::x20;
+/// Scratch register holding external call targets and constant pool pages.
+constexpr auto RegScratch = Reg::x16;
+/// Scratch register holding memory offsets which don't fit in an
+/// instruction.
+constexpr auto RegOffset = Reg::x17;
+
+} // namespace arm64
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_JIT_ARM64_FASTJIT_H
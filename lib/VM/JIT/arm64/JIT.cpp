@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/VM/JIT/arm64/JIT.h"
+
+#include "FastJIT.h"
+
+namespace hermes {
+namespace vm {
+namespace arm64 {
+
+JITContext::JITContext(bool enable, size_t blockSize, size_t maxMemory)
+    : enabled_(enable),
+      heap_(
+          blockSize / 2,
+          blockSize / 2,
+          maxMemory,
+          /* writeXorExecute */ true) {}
+
+JITContext::~JITContext() = default;
+
+JITCompiledFunctionPtr JITContext::compileImpl(
+    Runtime *runtime,
+    CodeBlock *codeBlock) {
+  ++useClock_;
+  codeCache_.evict(
+      runtime,
+      heap_,
+      FastJIT::estimateSizes(codeBlock->getOpcodeArray().size()));
+  FastJIT impl{this, codeBlock};
+  impl.compile();
+  if (!codeBlock->getDontJIT())
+    profile_.add(codeBlock);
+  return codeBlock->getJITCompiled();
+}
+
+void JITContext::removeRuntimeModule(RuntimeModule *runtimeModule) {
+  codeCache_.removeRuntimeModule(runtimeModule, heap_);
+}
+
+void JITContext::printStats(llvm::raw_ostream &os) {
+  codeCache_.printStats(os);
+}
+
+} // namespace arm64
+} // namespace vm
+} // namespace hermes
@@ -7,7 +7,7 @@
 #include "FastJIT.h"
 
 #include "../ExternalCalls.h"
-#include "RuntimeOffsets.h"
+#include "../RuntimeOffsets.h"
 #include "hermes/Inst/InstDecode.h"
 #include "hermes/VM/JIT/DiscoverBB.h"
 #include "hermes/VM/Operations.h"
@@ -41,17 +41,57 @@ static constexpr uint32_t BoolTagHW =
 FastJIT::FastJIT(JITContext *context, CodeBlock *codeBlock)
     : context_(context), codeBlock_(codeBlock) {}
 
+void FastJIT::prepareForCompile(CodeBlock *codeBlock) {
+  auto *runtimeModule = codeBlock->getRuntimeModule();
+  for (auto ip = codeBlock->begin(), end = codeBlock->end(); ip != end;) {
+    auto *inst = (const Inst *)ip;
+    auto decoded = decodeInstruction(inst);
+    switch (decoded.meta.opCode) {
+      case OpCode::CreateClosure:
+        runtimeModule->getCodeBlockMayAllocate(inst->iCreateClosure.op3);
+        break;
+// Register the identifiers that compile() embeds as SymbolIDs.
+#define CASE_IDENTIFIER(name, operand)                           \
+  case OpCode::name:                                             \
+    runtimeModule->getIdentifierSymbolID(inst->i##name.operand); \
+    break;
+      CASE_IDENTIFIER(GetById, op4)
+      CASE_IDENTIFIER(GetByIdShort, op4)
+      CASE_IDENTIFIER(GetByIdLong, op4)
+      CASE_IDENTIFIER(TryGetById, op4)
+      CASE_IDENTIFIER(TryGetByIdLong, op4)
+      CASE_IDENTIFIER(PutById, op4)
+      CASE_IDENTIFIER(PutByIdShort, op4)
+      CASE_IDENTIFIER(PutByIdLong, op4)
+      CASE_IDENTIFIER(TryPutById, op4)
+      CASE_IDENTIFIER(TryPutByIdLong, op4)
+      CASE_IDENTIFIER(PutNewOwnById, op3)
+      CASE_IDENTIFIER(PutNewOwnByIdShort, op3)
+      CASE_IDENTIFIER(PutNewOwnByIdLong, op3)
+#undef CASE_IDENTIFIER
+      default:
+        break;
+    }
+    ip += decoded.meta.size;
+  }
+}
+
 void FastJIT::compile() {
   LLVM_DEBUG(
       llvm::dbgs() << "JIT compilation of FunctionID "
                    << codeBlock_->getFunctionID() << "\n");
 
-  discoverBasicBlocks(codeBlock_, bcBasicBlocks_, bcLabels_);
+  discoverBasicBlocks(
+      codeBlock_, bcBasicBlocks_, bcLabels_, &bcLoopHeaders_);
 
+  // The heap is shared with the JS thread, which may evict code from it,
+  // when compiling in the background.
+  std::unique_lock<std::mutex> heapLock{context_->getHeapMutex()};
   ExecHeap::SizePair sizes;
   auto blocks = allocRWX(codeBlock_->getOpcodeArray().size(), sizes);
   if (!blocks)
     return;
+  heapLock.unlock();
 
   fast_ = llvm::makeMutableArrayRef(blocks->first, sizes.first);
   slow_ = llvm::makeMutableArrayRef(blocks->second, sizes.second);
@@ -80,6 +120,7 @@ void FastJIT::compile() {
   // Emit the function epilogue.
   nativeBBAddress_[curBytecodeBBIndex_] = emit.fast.current();
   emit = emitEpilogue(emit);
+  emit = emitOSREntries(emit);
 
   resolveRelocations();
 
@@ -87,11 +128,17 @@ void FastJIT::compile() {
   if (context_->getDumpJITCode())
     disassembleResult(emit, llvm::outs(), false);
 
+  heapLock.lock();
   if (!error_) {
-    context_->getHeap().freeRemaining(
-        *blocks,
-        {emit.fast.current() - fast_.data(),
-         emit.slow.current() - slow_.data()});
+    ExecHeap::SizePair used{emit.fast.current() - fast_.data(),
+                            emit.slow.current() - slow_.data()};
+    context_->getHeap().freeRemaining(*blocks, used);
+    context_->getCodeCache().add(codeBlock_, *blocks, used);
+    for (unsigned i = 0, e = bcLoopHeaders_.size(); i != e; ++i) {
+      codeBlock_->setOSREntry(
+          bcBasicBlocks_[bcLoopHeaders_[i]],
+          (JITCompiledFunctionPtr)nativeOSREntryAddress_[i]);
+    }
     codeBlock_->setJITCompiled((JITCompiledFunctionPtr)fast_.data());
 
     // Dump the heap at the end.
@@ -113,17 +160,28 @@ void FastJIT::error(const llvm::Twine &msg) {
   LLVM_DEBUG(llvm::dbgs() << "FastJIT error: " << msg << "\n");
 }
 
+ExecHeap::SizePair FastJIT::estimateSizes(size_t bytecodeLength) {
+  return {bytecodeLength * 50 + kMinInstructionSpace,
+          bytecodeLength * 50 + kMinInstructionSpace};
+}
+
 llvm::Optional<ExecHeap::BlockPair> FastJIT::allocRWX(
     size_t bytecodeLength,
     ExecHeap::SizePair &sizes) {
-  sizes = ExecHeap::SizePair{bytecodeLength * 50 + kMinInstructionSpace,
-                             bytecodeLength * 50 + kMinInstructionSpace};
+  sizes = estimateSizes(bytecodeLength);
 
   auto blocks = context_->getHeap().alloc(sizes);
   // If the allocation failed, add a new pool, initialize it and retry.
   if (!blocks) {
     auto newPool = context_->getHeap().addPool();
     if (!newPool) {
+      if (context_->getBackgroundCompilation()) {
+        // The JS thread made room for this function when queueing it, but the
+        // functions queued with it were checked against the same free memory.
+        // Let it evict code and queue this one again.
+        outOfMemory_ = true;
+        return llvm::None;
+      }
       error("out of executable memory");
       return llvm::None;
     }
@@ -227,7 +285,7 @@ void FastJIT::describeSlowPathSection(Emitter slow, bool data) {
 }
 #endif
 
-Emitters FastJIT::emitPrologue(Emitters emit) {
+Emitters FastJIT::emitPrologue(Emitters emit, bool clearRegisters) {
   if (!checkSpace(emit))
     return emit;
 
@@ -256,11 +314,13 @@ Emitters FastJIT::emitPrologue(Emitters emit) {
   // runtime->stackPointer = RegFrame - 8*numRegsNeeded.
   const int numRegsNeeded = codeBlock_->getFrameSize() +
       StackFrameLayout::CalleeExtraRegistersAtStart;
-  emit = loadConstantIntoNativeReg(
-      emit, HermesValue::encodeUndefinedValue(), Reg::rax);
-  for (int i = 1; i <= numRegsNeeded; ++i) {
-    emit.fast.movRegToRM<S::Q>(
-        Reg::rax, RegFrame, Reg::NoIndex, -i * sizeof(HermesValue));
+  if (clearRegisters) {
+    emit = loadConstantIntoNativeReg(
+        emit, HermesValue::encodeUndefinedValue(), Reg::rax);
+    for (int i = 1; i <= numRegsNeeded; ++i) {
+      emit.fast.movRegToRM<S::Q>(
+          Reg::rax, RegFrame, Reg::NoIndex, -i * sizeof(HermesValue));
+    }
   }
   emit.fast.leaRMToReg<S::Q>(
       RegFrame,
@@ -306,9 +366,12 @@ Emitters FastJIT::compileBB(Emitters emit) {
   auto *to = reinterpret_cast<const Inst *>(
       codeBlock_->begin() + bcBasicBlocks_[curBytecodeBBIndex_ + 1]);
 
+  // Other blocks may jump here with anything in XMM0.
+  xmm0HermesReg_ = llvm::None;
   while (ip != to) {
     if (!checkSpace(emit))
       return emit;
+    const OpCode opCode = ip->opCode;
 
     LLVM_DEBUG(llvm::dbgs() << ";   " << decodeInstruction(ip) << "\n");
 #ifndef NDEBUG
@@ -414,6 +477,10 @@ Emitters FastJIT::compileBB(Emitters emit) {
   case OpCode::name:                                                         \
     emit = compileCondOp(emit, ip, CJumpOp<cc>::OP, (void *)slowPath##name); \
     ip = NEXTINST(name);                                                     \
+    break;                                                                   \
+  case OpCode::name##N:                                                      \
+    emit = compileCondOpN(emit, ip, CJumpOp<cc>::OP);                        \
+    ip = NEXTINST(name##N);                                                  \
     break
 
 #define LOAD_CONST_STRING(name)                               \
@@ -462,6 +529,7 @@ Emitters FastJIT::compileBB(Emitters emit) {
       CASE(CreateClosure);
       CASE(GetGlobalObject);
       CASE(PutById);
+      CASE(PutByIdShort);
       CASE(TryPutById);
       CASE(PutByIdLong);
       CASE(TryPutByIdLong);
@@ -474,6 +542,7 @@ Emitters FastJIT::compileBB(Emitters emit) {
       CASE(CallLong);
       CASE(Construct);
       CASE(ConstructLong);
+      CASE(CallBuiltin);
       CASE(LoadConstZero);
       LOAD_CONST_STRING(LoadConstString);
       LOAD_CONST_STRING(LoadConstStringLongIndex);
@@ -487,6 +556,7 @@ Emitters FastJIT::compileBB(Emitters emit) {
       BINOP(Div);
       CASE(DivN);
       CASE(TypeOf);
+      CASE(TypeOfIs);
       CASE(Mov);
       CASE(MovLong);
       CASE(ToNumber);
@@ -564,6 +634,7 @@ Emitters FastJIT::compileBB(Emitters emit) {
       CASE(StoreNPToEnvironmentL);
       CASE_WITH_SUFFIX(LoadFromEnvironment, , op3);
       CASE_WITH_SUFFIX(LoadFromEnvironment, L, op3);
+      CASE(LoadFromOuterEnvironment);
       CASE_3REG(Mod);
       CASE(Not);
       CASE_3REG(LShift);
@@ -577,8 +648,12 @@ Emitters FastJIT::compileBB(Emitters emit) {
       CASE(Negate);
       CASE(GetPNameList);
       CASE(GetNextPName);
+      CASE(IteratorBegin);
+      CASE(IteratorNext);
+      CASE(IteratorClose);
       CASE(ReifyArguments);
       CASE(GetArgumentsPropByVal);
+      CASE(CallApplyArguments);
       CASE(BitNot);
       CASE(GetArgumentsLength);
       CASE_3REG(IsIn);
@@ -596,6 +671,23 @@ Emitters FastJIT::compileBB(Emitters emit) {
     }
 #undef CASE
 
+    // Any other instruction may clobber XMM0 or the register it was loaded
+    // from. The generic arithmetic forget it when their slow path returns.
+    switch (opCode) {
+      case OpCode::Add:
+      case OpCode::AddN:
+      case OpCode::Sub:
+      case OpCode::SubN:
+      case OpCode::Mul:
+      case OpCode::MulN:
+      case OpCode::Div:
+      case OpCode::DivN:
+        break;
+      default:
+        xmm0HermesReg_ = llvm::None;
+        break;
+    }
+
     LLVM_DEBUG(
         disassembleRange(
             sav.fast.current(), emit.fast.current(), llvm::dbgs(), true);
@@ -708,6 +800,12 @@ inline Emitter FastJIT::movHermesRegToNativeReg(
   return emit;
 }
 
+Emitter FastJIT::movNumberToXMM0(Emitter emit, OperandReg32 hermesReg) {
+  if (xmm0HermesReg_ == hermesReg)
+    return emit;
+  return movHermesRegToNativeReg<true>(emit, hermesReg, Reg::XMM0);
+}
+
 Emitter FastJIT::movHermesRegToHermesReg(
     Emitter emit,
     OperandReg32 src,
@@ -735,6 +833,17 @@ Emitters FastJIT::compileTypeOf(Emitters emit, const Inst *ip) {
   return emit;
 }
 
+Emitters FastJIT::compileTypeOfIs(Emitters emit, const Inst *ip) {
+  emit.fast = leaHermesReg(emit.fast, ip->iTypeOfIs.op2, Reg::rsi);
+  emit.fast.movImmToReg<S::L>(ip->iTypeOfIs.op3, Reg::edx);
+
+  uint8_t *constAddr;
+  emit.slow = getConstant(emit.slow, (void *)externTypeOfIs, constAddr);
+  emit.fast =
+      callExternalWithReturnedVal(emit.fast, constAddr, ip->iTypeOfIs.op1);
+  return emit;
+}
+
 inline Emitter FastJIT::callAbsolute(Emitter emit, const void *dest) {
   emit.movqImmToReg((uint64_t)dest, Reg::rax);
   emit.callReg(Reg::rax);
@@ -846,6 +955,43 @@ Emitters FastJIT::compileConstructLong(Emitters emit, const Inst *ip) {
   return callHelper(emit, ip, ip->iConstructLong.op3, true);
 }
 
+Emitters FastJIT::compileCallBuiltin(Emitters emit, const Inst *ip) {
+  // builtinMethodID -> arg2
+  emit.fast.movImmToReg<S::L>(ip->iCallBuiltin.op2, Reg::esi);
+
+  // argCount (uint32_t) -> arg3
+  emit.fast.movImmToReg<S::L>(ip->iCallBuiltin.op3, Reg::edx);
+
+  // stack pointer -> arg4
+  emit.fast.movRMToReg<S::Q>(
+      RegRuntime, Reg::NoIndex, RuntimeOffsets::stackPointer, Reg::rcx);
+
+  // ip -> arg5
+  emit = loadConstantAddrIntoNativeReg(emit, (void *)ip, Reg::r8);
+
+  // currentFrame -> arg6
+  emit.fast.movRegToReg<S::Q>(RegFrame, Reg::r9);
+
+  uint8_t *constAddr;
+  emit.slow = getConstant(emit.slow, (void *)externCallBuiltin, constAddr);
+  emit.fast = callExternal(emit.fast, constAddr, ip->iCallBuiltin.op1, ip);
+  return emit;
+}
+
+Emitters FastJIT::emitOSREntries(Emitters emit) {
+  nativeOSREntryAddress_.resize(bcLoopHeaders_.size());
+  for (unsigned i = 0, e = bcLoopHeaders_.size(); i != e; ++i) {
+    if (!checkSpace(emit))
+      return emit;
+    nativeOSREntryAddress_[i] = emit.fast.current();
+    // The interpreter has already popped its frame, leaving the registers in
+    // place. Push it again, re-using them, and continue at the loop header.
+    emit = emitPrologue(emit, false);
+    emit.fast = jmpToBytecodeBB(emit.fast, bcLoopHeaders_[i]);
+  }
+  return emit;
+}
+
 Emitter FastJIT::jmpToBytecodeBB(Emitter emit, unsigned bytecodeBB) {
   // If jumping to the next BB, do nothing.
   if (bytecodeBB == curBytecodeBBIndex_ + 1)
@@ -927,6 +1073,60 @@ FastJIT::compileCondOpN(Emitters emit, const Inst *ip, uint8_t opCode) {
   return emit;
 }
 
+Emitters FastJIT::emitPropertyCacheGuard(
+    Emitters emit,
+    uint32_t objReg,
+    const uint8_t *cacheConstAddr,
+    const uint8_t *slowPathAddr) {
+#ifdef HERMESVM_COMPRESSED_POINTERS
+  uint8_t *pointerBaseConstAddr;
+  emit.slow = getConstant(
+      emit.slow, (void *)context_->getPointerBase(), pointerBaseConstAddr);
+#endif
+
+  // Is it an object?
+  emit.fast = movHermesRegToNativeReg(emit.fast, objReg, Reg::rdx);
+  emit.fast.movRegToReg<S::Q>(Reg::rdx, Reg::rax);
+  emit.fast.shrImm8ToReg(HermesValue::kNumDataBits, Reg::rax);
+  emit.fast.cmpImmToRM<S::L, ScaleRegAccess>(
+      ObjectTag, Reg::eax, Reg::none, 0);
+  emit.fast.cjump<CCode::NE, OffsetType::Int32>(slowPathAddr);
+
+  // Strip the tag, leaving the JSObject pointer in %rdx.
+  emit.fast.shlImm8ToReg(HermesValue::kNumTagExpBits, Reg::rdx);
+  emit.fast.shrImm8ToReg(HermesValue::kNumTagExpBits, Reg::rdx);
+
+  // Does the hidden class match the first way of the cache?
+  emit.fast.movRMToReg<S::Q, ScaleRIPAddr32>(
+      Reg::none, Reg::NoIndex, 0, Reg::r8);
+  applyRIP32Offset(emit.fast.current(), cacheConstAddr);
+#ifdef HERMESVM_COMPRESSED_POINTERS
+  // The object holds its class as an offset from the PointerBase, while the
+  // cache holds the pointer. A class is never null, so decoding it is just
+  // adding the base.
+  emit.fast.movRMToReg<S::Q, ScaleRIPAddr32>(
+      Reg::none, Reg::NoIndex, 0, Reg::r9);
+  applyRIP32Offset(emit.fast.current(), pointerBaseConstAddr);
+  emit.fast.movRMToReg<S::L>(
+      Reg::rdx, Reg::NoIndex, RuntimeOffsets::objectClass, Reg::eax);
+  emit.fast.leaRMToReg<S::Q, S::Q, 1>(Reg::r9, Reg::rax, 0, Reg::rax);
+#else
+  emit.fast.movRMToReg<S::Q>(
+      Reg::rdx, Reg::NoIndex, RuntimeOffsets::objectClass, Reg::rax);
+#endif
+  emit.fast.cmpRMToReg<S::Q>(
+      Reg::r8, Reg::NoIndex, offsetof(PropertyCacheEntry, clazz), Reg::rax);
+  emit.fast.cjump<CCode::NE, OffsetType::Int32>(slowPathAddr);
+
+  // Only slots stored directly in the object are accessed inline.
+  emit.fast.movRMToReg<S::L>(
+      Reg::r8, Reg::NoIndex, offsetof(PropertyCacheEntry, slot), Reg::eax);
+  emit.fast.cmpImmToRM<S::L, ScaleRegAccess>(
+      JSObject::DIRECT_PROPERTY_SLOTS, Reg::eax, Reg::none, 0);
+  emit.fast.cjump<CCode::AE, OffsetType::Int32>(slowPathAddr);
+  return emit;
+}
+
 inline Emitters FastJIT::getByIdHelper(
     Emitters emit,
     const Inst *ip,
@@ -937,28 +1137,60 @@ inline Emitters FastJIT::getByIdHelper(
       : PropOpFlags();
   auto flags =
       !tryProp ? defaultPropOpFlags : defaultPropOpFlags.plusMustExist();
-  // PropOpFlags  -> arg2
-  emit.fast.movImmToReg<S::L>(flags.getRaw(), Reg::esi);
-
-  // IdentifierID (uint32_t) -> arg3
   // The symbol must already exist in the string id map, so we could just pass
   // the IdentifierID
-  emit.fast.movImmToReg<S::L>(
-      codeBlock_->getRuntimeModule()
-          ->getSymbolIDMustExist(idVal)
-          .unsafeGetIndex(),
-      Reg::edx);
-  //&target -> arg4
-  emit.fast = leaHermesReg(emit.fast, ip->iGetById.op2, Reg::rcx);
-  // cacheIdx -> arg5
-  // cacheIdx is uint8_t, but it's more efficient to just set whole 32 bits
-  emit.fast.movImmToReg<S::L>(ip->iGetById.op3, Reg::r8d);
-  // current code block -> arg6
-  emit = loadConstantAddrIntoNativeReg(emit, codeBlock_, Reg::r9);
+  uint32_t symbolIdx = codeBlock_->getRuntimeModule()
+                           ->getSymbolIDMustExist(idVal)
+                           .unsafeGetIndex();
+  auto cacheIdx = ip->iGetById.op3;
 
+  uint8_t *codeBlockConstAddr;
+  emit.slow = getConstant(emit.slow, (void *)codeBlock_, codeBlockConstAddr);
   uint8_t *constAddr;
   emit.slow = getConstant(emit.slow, (void *)externGetById, constAddr);
-  emit.fast = callExternal(emit.fast, constAddr, ip->iGetById.op1, ip);
+
+  auto callGetById = [&](Emitter e) {
+    // PropOpFlags  -> arg2
+    e.movImmToReg<S::L>(flags.getRaw(), Reg::esi);
+    // IdentifierID (uint32_t) -> arg3
+    e.movImmToReg<S::L>(symbolIdx, Reg::edx);
+    //&target -> arg4
+    e = leaHermesReg(e, ip->iGetById.op2, Reg::rcx);
+    // cacheIdx -> arg5
+    // cacheIdx is uint8_t, but it's more efficient to just set whole 32 bits
+    e.movImmToReg<S::L>(cacheIdx, Reg::r8d);
+    // current code block -> arg6
+    e.movRMToReg<S::Q, ScaleRIPAddr32>(Reg::none, Reg::NoIndex, 0, Reg::r9);
+    applyRIP32Offset(e.current(), codeBlockConstAddr);
+    return callExternal(e, constAddr, ip->iGetById.op1, ip);
+  };
+
+  if (cacheIdx == hbc::PROPERTY_CACHING_DISABLED) {
+    emit.fast = callGetById(emit.fast);
+    return emit;
+  }
+
+  // Check the first way of the read cache inline, and only call out to the
+  // runtime when it misses.
+  uint8_t *cacheConstAddr;
+  emit.slow = getConstant(
+      emit.slow,
+      (void *)&codeBlock_->getReadCacheEntry(cacheIdx)->ways[0],
+      cacheConstAddr);
+
+  uint8_t *slowPathAddr = emit.slow.current();
+  emit.slow = callGetById(emit.slow);
+  emit.slow.jmp<OffsetType::Int32>(emit.slow.current());
+  Relo relo{ReloKind::Int32, emit.slow.current() - 4, 0};
+  describeSlowPathSection(emit.slow, false);
+
+  emit = emitPropertyCacheGuard(
+      emit, ip->iGetById.op2, cacheConstAddr, slowPathAddr);
+  emit.fast.movRMToReg<S::Q, 8>(
+      Reg::rdx, Reg::rax, RuntimeOffsets::objectDirectProps, Reg::rax);
+  emit.fast = movNativeRegToHermesReg(emit.fast, Reg::rax, ip->iGetById.op1);
+
+  applyRelocation(relo, emit.fast.current());
   return emit;
 }
 
@@ -988,33 +1220,72 @@ inline Emitters FastJIT::putByIdHelper(
       : PropOpFlags();
   auto flags =
       !tryProp ? defaultPropOpFlags : defaultPropOpFlags.plusMustExist();
-  // PropOpFlags  -> arg2
-  emit.fast.movImmToReg<S::L>(flags.getRaw(), Reg::esi);
-  // IdentifierID (uint32_t) -> arg3
   // The symbol must already exist in the map, so we could just pass the
   // IdentifierID
-  emit.fast.movImmToReg<S::L>(
-      codeBlock_->getRuntimeModule()
-          ->getSymbolIDMustExist(idVal)
-          .unsafeGetIndex(),
-      Reg::edx);
-  //&target -> arg4
-  emit.fast = leaHermesReg(emit.fast, ip->iPutById.op1, Reg::rcx);
-  //&prop -> arg5
-  emit.fast = leaHermesReg(emit.fast, ip->iPutById.op2, Reg::r8);
-  // cacheIdx -> arg6
-  // cacheIdx is uint8_t, but it's more efficient to just set whole 32 bits
-  emit.fast.movImmToReg<S::L>(ip->iPutById.op3, Reg::r9d);
+  uint32_t symbolIdx = codeBlock_->getRuntimeModule()
+                           ->getSymbolIDMustExist(idVal)
+                           .unsafeGetIndex();
+  auto cacheIdx = ip->iPutById.op3;
 
   uint8_t *constAddr;
   emit.slow = getConstant(emit.slow, (void *)externPutById, constAddr);
-  emit.fast = callExternalNoReturnedVal(emit.fast, constAddr, ip);
+
+  auto callPutById = [&](Emitter e) {
+    // PropOpFlags  -> arg2
+    e.movImmToReg<S::L>(flags.getRaw(), Reg::esi);
+    // IdentifierID (uint32_t) -> arg3
+    e.movImmToReg<S::L>(symbolIdx, Reg::edx);
+    //&target -> arg4
+    e = leaHermesReg(e, ip->iPutById.op1, Reg::rcx);
+    //&prop -> arg5
+    e = leaHermesReg(e, ip->iPutById.op2, Reg::r8);
+    // cacheIdx -> arg6
+    // cacheIdx is uint8_t, but it's more efficient to just set whole 32 bits
+    e.movImmToReg<S::L>(cacheIdx, Reg::r9d);
+    return callExternalNoReturnedVal(e, constAddr, ip);
+  };
+
+  if (cacheIdx == hbc::PROPERTY_CACHING_DISABLED) {
+    emit.fast = callPutById(emit.fast);
+    return emit;
+  }
+
+  // Check the first way of the write cache inline. Stores of pointer values
+  // need a write barrier, so they always go through the runtime.
+  uint8_t *cacheConstAddr;
+  emit.slow = getConstant(
+      emit.slow,
+      (void *)&codeBlock_->getWriteCacheEntry(cacheIdx)->ways[0],
+      cacheConstAddr);
+
+  uint8_t *slowPathAddr = emit.slow.current();
+  emit.slow = callPutById(emit.slow);
+  emit.slow.jmp<OffsetType::Int32>(emit.slow.current());
+  Relo relo{ReloKind::Int32, emit.slow.current() - 4, 0};
+  describeSlowPathSection(emit.slow, false);
+
+  emit.fast = movHermesRegToNativeReg(emit.fast, ip->iPutById.op2, Reg::rax);
+  emit.fast.shrImm8ToReg(HermesValue::kNumDataBits, Reg::rax);
+  emit.fast.cmpImmToRM<S::L, ScaleRegAccess>(
+      FirstPointerTag, Reg::eax, Reg::none, 0);
+  emit.fast.cjump<CCode::AE, OffsetType::Int32>(slowPathAddr);
+
+  emit = emitPropertyCacheGuard(
+      emit, ip->iPutById.op1, cacheConstAddr, slowPathAddr);
+  emit.fast = movHermesRegToNativeReg(emit.fast, ip->iPutById.op2, Reg::rcx);
+  emit.fast.movRegToRM<S::Q, 8>(
+      Reg::rcx, Reg::rdx, Reg::rax, RuntimeOffsets::objectDirectProps);
+
+  applyRelocation(relo, emit.fast.current());
   return emit;
 }
 
 Emitters FastJIT::compilePutById(Emitters emit, const Inst *ip) {
   return putByIdHelper(emit, ip, false, ip->iPutById.op4);
 }
+Emitters FastJIT::compilePutByIdShort(Emitters emit, const Inst *ip) {
+  return putByIdHelper(emit, ip, false, ip->iPutByIdShort.op4);
+}
 Emitters FastJIT::compilePutByIdLong(Emitters emit, const Inst *ip) {
   return putByIdHelper(emit, ip, false, ip->iPutByIdLong.op4);
 }
@@ -1058,6 +1329,11 @@ Emitters FastJIT::compileCreateClosure(Emitters emit, const Inst *ip) {
   CodeBlock *calleeBlock =
       codeBlock_->getRuntimeModule()->getCodeBlockMayAllocate(
           ip->iCreateClosure.op3);
+  // Leave a function outside of the bytecode to the interpreter to report.
+  if (!calleeBlock) {
+    error("closure lies outside of the bytecode");
+    return emit;
+  }
   emit = loadConstantAddrIntoNativeReg(emit, calleeBlock, Reg::rsi);
 
   //&env -> arg3
@@ -1298,6 +1574,18 @@ Emitters FastJIT::compileBinOp(
     compileBinOpNPtr binOpNPtr) {
   uint8_t *externAddr;
   emit.slow = getConstant(emit.slow, slowPathBinOp, externAddr);
+
+  // If the interpreter saw operands other than numbers here, checking for
+  // numbers would most likely only delay the call.
+  uint32_t offset = (const uint8_t *)ip - codeBlock_->begin();
+  if (codeBlock_->isGenericArithmetic(offset)) {
+    emit.fast = leaHermesReg(emit.fast, ip->iAdd.op2, Reg::rsi);
+    emit.fast = leaHermesReg(emit.fast, ip->iAdd.op3, Reg::rdx);
+    emit.fast = callExternal(emit.fast, externAddr, ip->iAdd.op1, ip);
+    xmm0HermesReg_ = llvm::None;
+    return emit;
+  }
+
   uint8_t *slowPathAddr = emit.slow.current();
 
   // isNumber op2?
@@ -1309,46 +1597,53 @@ Emitters FastJIT::compileBinOp(
 }
 
 Emitters FastJIT::compileAddN(Emitters emit, const Inst *ip) {
-  emit.fast = movHermesRegToNativeReg<true>(emit.fast, ip->iAdd.op2, Reg::XMM0);
+  // Addition is commutative, so either operand can be the one in XMM0.
+  OperandReg32 op2 = ip->iAdd.op2;
+  OperandReg32 op3 = ip->iAdd.op3;
+  if (xmm0HermesReg_ == op3)
+    std::swap(op2, op3);
+  emit.fast = movNumberToXMM0(emit.fast, op2);
   emit.fast.addfpRMToReg(
-      RegFrame,
-      Reg::NoIndex,
-      localHermesRegByteOffset(ip->iAdd.op3),
-      Reg::XMM0);
+      RegFrame, Reg::NoIndex, localHermesRegByteOffset(op3), Reg::XMM0);
   emit.fast = movNativeRegToHermesReg<true>(emit.fast, Reg::XMM0, ip->iAdd.op1);
+  xmm0HermesReg_ = ip->iAdd.op1;
   return emit;
 }
 
 Emitters FastJIT::compileSubN(Emitters emit, const Inst *ip) {
-  emit.fast = movHermesRegToNativeReg<true>(emit.fast, ip->iAdd.op2, Reg::XMM0);
+  emit.fast = movNumberToXMM0(emit.fast, ip->iAdd.op2);
   emit.fast.subfpRMFromReg(
       RegFrame,
       Reg::NoIndex,
       localHermesRegByteOffset(ip->iSubN.op3),
       Reg::XMM0);
   emit.fast = movNativeRegToHermesReg<true>(emit.fast, Reg::XMM0, ip->iAdd.op1);
+  xmm0HermesReg_ = ip->iAdd.op1;
   return emit;
 }
 
 Emitters FastJIT::compileMulN(Emitters emit, const Inst *ip) {
-  emit.fast = movHermesRegToNativeReg<true>(emit.fast, ip->iAdd.op2, Reg::XMM0);
+  OperandReg32 op2 = ip->iMul.op2;
+  OperandReg32 op3 = ip->iMul.op3;
+  if (xmm0HermesReg_ == op3)
+    std::swap(op2, op3);
+  emit.fast = movNumberToXMM0(emit.fast, op2);
   emit.fast.mulfpRMToReg(
-      RegFrame,
-      Reg::NoIndex,
-      localHermesRegByteOffset(ip->iMul.op3),
-      Reg::XMM0);
+      RegFrame, Reg::NoIndex, localHermesRegByteOffset(op3), Reg::XMM0);
   emit.fast = movNativeRegToHermesReg<true>(emit.fast, Reg::XMM0, ip->iAdd.op1);
+  xmm0HermesReg_ = ip->iAdd.op1;
   return emit;
 }
 
 Emitters FastJIT::compileDivN(Emitters emit, const Inst *ip) {
-  emit.fast = movHermesRegToNativeReg<true>(emit.fast, ip->iDiv.op2, Reg::XMM0);
+  emit.fast = movNumberToXMM0(emit.fast, ip->iDiv.op2);
   emit.fast.divfpRMFromReg(
       RegFrame,
       Reg::NoIndex,
       localHermesRegByteOffset(ip->iDiv.op3),
       Reg::XMM0);
   emit.fast = movNativeRegToHermesReg<true>(emit.fast, Reg::XMM0, ip->iDiv.op1);
+  xmm0HermesReg_ = ip->iDiv.op1;
   return emit;
 }
 
@@ -1382,6 +1677,8 @@ Emitters FastJIT::callSlowPathBinOp(
   emit.slow = callExternal(emit.slow, externBinOp, ip->iAdd.op1, ip);
 
   emit.slow.jmp<OffsetType::Auto>(emit.fast.current());
+  // The result of the slow path is only in the frame.
+  xmm0HermesReg_ = llvm::None;
 
   describeSlowPathSection(emit.slow, false);
   return emit;
@@ -1616,6 +1913,8 @@ Emitters FastJIT::compileNewArrayWithBuffer(
   emit.fast.movImmToReg<S::L>(ip->iNewArrayWithBuffer.op3, Reg::ecx);
   // the index in the array buffer table (uint16_t/uint32_t) -> arg5
   emit.fast.movImmToReg<S::L>(idx, Reg::r8d);
+  // the bytecode offset of the instruction -> arg6
+  emit.fast.movImmToReg<S::L>(codeBlock_->getOffsetOf(ip), Reg::r9d);
 
   uint8_t *constAddr;
   emit.slow =
@@ -1840,6 +2139,8 @@ Emitters FastJIT::newObjectWithBufferHelper(
   emit.fast.movImmToReg<S::L>(keyIdx, Reg::ecx);
   // the index in the object val buffer table (uint16_t/uint32_t) -> arg5
   emit.fast.movImmToReg<S::L>(valIdx, Reg::r8d);
+  // the bytecode offset of the instruction -> arg6
+  emit.fast.movImmToReg<S::L>(codeBlock_->getOffsetOf(ip), Reg::r9d);
 
   uint8_t *constAddr;
   emit.slow =
@@ -2023,8 +2324,9 @@ inline Emitters FastJIT::encodeBoolHVInNativeReg(Emitters emit, Reg nativeReg) {
 Emitters FastJIT::compileGetEnvironment(Emitters emit, const Inst *ip) {
   // TODO: emit sequential inline code when levels are small, e.g. 1-3;
   // TODO: otherwise emit a compact loop instead of external call
-  emit.fast.movRegToReg<S::Q>(RegFrame, Reg::rdi);
-  emit.fast.movImmToReg<S::L>(ip->iGetEnvironment.op2, Reg::rsi);
+  emit.fast.movRegToReg<S::Q>(RegRuntime, Reg::rdi);
+  emit.fast.movRegToReg<S::Q>(RegFrame, Reg::rsi);
+  emit.fast.movImmToReg<S::L>(ip->iGetEnvironment.op2, Reg::rdx);
 
   uint8_t *constAddr;
   emit.slow = getConstant(emit.slow, (void *)externGetEnvironment, constAddr);
@@ -2036,6 +2338,25 @@ Emitters FastJIT::compileGetEnvironment(Emitters emit, const Inst *ip) {
   return emit;
 }
 
+Emitters FastJIT::compileLoadFromOuterEnvironment(
+    Emitters emit,
+    const Inst *ip) {
+  emit.fast.movRegToReg<S::Q>(RegRuntime, Reg::rdi);
+  emit.fast.movRegToReg<S::Q>(RegFrame, Reg::rsi);
+  emit.fast.movImmToReg<S::L>(ip->iLoadFromOuterEnvironment.op2, Reg::rdx);
+  emit.fast.movImmToReg<S::L>(ip->iLoadFromOuterEnvironment.op3, Reg::rcx);
+
+  uint8_t *constAddr;
+  emit.slow = getConstant(
+      emit.slow, (void *)externLoadFromOuterEnvironment, constAddr);
+  emit.fast.callRM<ScaleRIPAddr32>(Reg::none, Reg::NoIndex, 0);
+  applyRIP32Offset(emit.fast.current(), constAddr);
+
+  emit.fast = movNativeRegToHermesReg(
+      emit.fast, Reg::rax, ip->iLoadFromOuterEnvironment.op1);
+  return emit;
+}
+
 Emitters FastJIT::compileNegate(Emitters emit, const Inst *ip) {
   uint8_t *externAddr;
   emit.slow = getConstant(emit.slow, (void *)slowPathNegate, externAddr);
@@ -2104,6 +2425,40 @@ Emitters FastJIT::compileGetNextPName(Emitters emit, const Inst *ip) {
   return emit;
 }
 
+Emitters FastJIT::compileIteratorBegin(Emitters emit, const Inst *ip) {
+  emit.fast = leaHermesReg(emit.fast, ip->iIteratorBegin.op2, Reg::rsi);
+
+  uint8_t *externConstAddr;
+  emit.slow =
+      getConstant(emit.slow, (void *)externIteratorBegin, externConstAddr);
+  emit.fast =
+      callExternal(emit.fast, externConstAddr, ip->iIteratorBegin.op1, ip);
+  return emit;
+}
+
+Emitters FastJIT::compileIteratorNext(Emitters emit, const Inst *ip) {
+  emit.fast = leaHermesReg(emit.fast, ip->iIteratorNext.op2, Reg::rsi);
+  emit.fast = leaHermesReg(emit.fast, ip->iIteratorNext.op3, Reg::rdx);
+
+  uint8_t *externConstAddr;
+  emit.slow =
+      getConstant(emit.slow, (void *)externIteratorNext, externConstAddr);
+  emit.fast =
+      callExternal(emit.fast, externConstAddr, ip->iIteratorNext.op1, ip);
+  return emit;
+}
+
+Emitters FastJIT::compileIteratorClose(Emitters emit, const Inst *ip) {
+  emit.fast = leaHermesReg(emit.fast, ip->iIteratorClose.op1, Reg::rsi);
+  emit.fast.movImmToReg<S::L>(ip->iIteratorClose.op2, Reg::edx);
+
+  uint8_t *externConstAddr;
+  emit.slow =
+      getConstant(emit.slow, (void *)externIteratorClose, externConstAddr);
+  emit.fast = callExternalNoReturnedVal(emit.fast, externConstAddr, ip);
+  return emit;
+}
+
 Emitters FastJIT::compileReifyArguments(Emitters emit, const Inst *ip) {
   uint8_t *externConstAddr;
   emit.slow = getConstant(
@@ -2140,6 +2495,21 @@ Emitters FastJIT::compileGetArgumentsPropByVal(Emitters emit, const Inst *ip) {
   return emit;
 }
 
+Emitters FastJIT::compileCallApplyArguments(Emitters emit, const Inst *ip) {
+  emit.fast = leaHermesReg(emit.fast, ip->iCallApplyArguments.op5, Reg::rsi);
+  emit.fast = leaHermesReg(emit.fast, ip->iCallApplyArguments.op2, Reg::rdx);
+  emit.fast = leaHermesReg(emit.fast, ip->iCallApplyArguments.op3, Reg::rcx);
+  emit.fast = leaHermesReg(emit.fast, ip->iCallApplyArguments.op4, Reg::r8);
+  emit.fast.movImmToReg<S::Q>(codeBlock_->isStrictMode(), Reg::r9);
+
+  uint8_t *externConstAddr;
+  emit.slow = getConstant(
+      emit.slow, (void *)externCallApplyArguments, externConstAddr);
+  emit.fast = callExternal(
+      emit.fast, externConstAddr, ip->iCallApplyArguments.op1, ip);
+  return emit;
+}
+
 Emitters FastJIT::compileBitNot(Emitters emit, const Inst *ip) {
   uint8_t *slowPathConstAddr;
   emit.slow =
@@ -69,6 +69,25 @@ class FastJIT {
   /// pointer in the CodeBlock will be set to the compiled body.
   void compile();
 
+  /// \return true if compile() failed only because the executable heap was
+  ///     full while compiling in the background. The function may be compiled
+  ///     again once the JS thread has evicted code.
+  bool isOutOfMemory() const {
+    return outOfMemory_;
+  }
+
+  /// Perform the parts of compiling \p codeBlock which may allocate or
+  /// otherwise modify runtime state, so that \c compile() only reads it and
+  /// can afterwards run on a thread other than the one executing JavaScript.
+  /// This creates the CodeBlocks of the closures it creates and registers the
+  /// identifiers its property accesses use. It must be called on the JS
+  /// thread before every \c compile() of \p codeBlock.
+  static void prepareForCompile(CodeBlock *codeBlock);
+
+  /// \return the conservative sizes of the fast and slow path blocks that are
+  ///     allocated to compile \p bytecodeLength bytes of bytecode.
+  static ExecHeap::SizePair estimateSizes(size_t bytecodeLength);
+
   /// A pointer to binOpN instruction's compilation function.
   typedef Emitters (FastJIT::*compileBinOpNPtr)(Emitters emit, const Inst *ip);
 
@@ -144,9 +163,16 @@ class FastJIT {
   /// @{
 
   /// Emit the function prologue. Calls checkSpace() before emitting.
-  Emitters emitPrologue(Emitters emit);
+  /// \param clearRegisters whether to initialize the Hermes registers of the
+  ///     new frame to undefined. OSR entries keep the values left there by the
+  ///     interpreter.
+  Emitters emitPrologue(Emitters emit, bool clearRegisters = true);
   /// Emit the function epilogue. Calls checkSpace() before emitting.
   Emitters emitEpilogue(Emitters emit);
+  /// Emit an OSR entry for every loop header: a prologue which adopts the
+  /// registers of the interpreter frame, followed by a jump into the loop.
+  /// Calls checkSpace() before emitting every entry.
+  Emitters emitOSREntries(Emitters emit);
 
   /// Emit the code for a basic block. Calls checkSpace() before processing
   /// every bytecode instruction.
@@ -206,6 +232,9 @@ class FastJIT {
   template <bool fp = false>
   Emitter
   movHermesRegToNativeReg(Emitter emit, OperandReg32 hermesReg, Reg nativeReg);
+  /// Load the number in the hermes register \p hermesReg into XMM0, unless
+  /// XMM0 already holds it according to \c xmm0HermesReg_.
+  Emitter movNumberToXMM0(Emitter emit, OperandReg32 hermesReg);
 
   /// Move hermes reg \p src to hermes reg \p dst.
   Emitter
@@ -289,6 +318,19 @@ class FastJIT {
   /// Receives and \returns the fast path emitter.
   Emitter cjmpToBytecodeBB(Emitter emit, uint8_t opCode, unsigned bytecodeBB);
 
+  /// Emit the inline check of a GetById/PutById property cache into the fast
+  /// path: the Hermes register \p objReg must hold an object whose hidden
+  /// class is cached in the first way of the cache entry whose address is
+  /// stored at \p cacheConstAddr, and the cached slot must be stored directly
+  /// in the object. Otherwise control transfers to \p slowPathAddr.
+  /// On success %rdx holds the object pointer and %rax the slot index.
+  /// Clobbers %rax, %rdx and %r8, and %r9 with compressed pointers.
+  Emitters emitPropertyCacheGuard(
+      Emitters emit,
+      uint32_t objReg,
+      const uint8_t *cacheConstAddr,
+      const uint8_t *slowPathAddr);
+
   Emitters
   getByIdHelper(Emitters emit, const Inst *ip, bool tryProp, uint32_t idVal);
   Emitters
@@ -353,6 +395,7 @@ class FastJIT {
 
   // Individual instruction emitters
   Emitters compileTypeOf(Emitters emit, const Inst *ip);
+  Emitters compileTypeOfIs(Emitters emit, const Inst *ip);
 
   Emitters compileGetById(Emitters emit, const Inst *ip);
   Emitters compileGetByIdLong(Emitters emit, const Inst *ip);
@@ -361,6 +404,7 @@ class FastJIT {
   Emitters compileTryGetByIdLong(Emitters emit, const Inst *ip);
 
   Emitters compilePutById(Emitters emit, const Inst *ip);
+  Emitters compilePutByIdShort(Emitters emit, const Inst *ip);
   Emitters compilePutByIdLong(Emitters emit, const Inst *ip);
   Emitters compileTryPutById(Emitters emit, const Inst *ip);
   Emitters compileTryPutByIdLong(Emitters emit, const Inst *ip);
@@ -369,6 +413,7 @@ class FastJIT {
   Emitters compileCallLong(Emitters emit, const Inst *ip);
   Emitters compileConstruct(Emitters emit, const Inst *ip);
   Emitters compileConstructLong(Emitters emit, const Inst *ip);
+  Emitters compileCallBuiltin(Emitters emit, const Inst *ip);
 
   /// Emit a check that whether the value in the Hermes register \p regIndex is
   /// a number; if not, emit a jump to the slow path \p callStub.
@@ -507,11 +552,16 @@ class FastJIT {
   compileLoadFromEnvironment(Emitters emit, const Inst *ip, uint32_t idx);
   Emitters compileNot(Emitters emit, const Inst *ip);
   Emitters compileGetEnvironment(Emitters emit, const Inst *ip);
+  Emitters compileLoadFromOuterEnvironment(Emitters emit, const Inst *ip);
   Emitters compileNegate(Emitters emit, const Inst *ip);
   Emitters compileGetPNameList(Emitters emit, const Inst *ip);
   Emitters compileGetNextPName(Emitters emit, const Inst *ip);
+  Emitters compileIteratorBegin(Emitters emit, const Inst *ip);
+  Emitters compileIteratorNext(Emitters emit, const Inst *ip);
+  Emitters compileIteratorClose(Emitters emit, const Inst *ip);
   Emitters compileReifyArguments(Emitters emit, const Inst *ip);
   Emitters compileGetArgumentsPropByVal(Emitters emit, const Inst *ip);
+  Emitters compileCallApplyArguments(Emitters emit, const Inst *ip);
   Emitters compileBitNot(Emitters emit, const Inst *ip);
   Emitters compileGetArgumentsLength(Emitters emit, const Inst *ip);
   Emitters compileCreateRegExp(Emitters emit, const Inst *ip);
@@ -535,9 +585,16 @@ class FastJIT {
   /// Map from a bytecode target label offset to a basic block index.
   llvm::DenseMap<uint32_t, unsigned> bcLabels_{};
 
+  /// Index of every bytecode basic block which is the target of a backward
+  /// branch, in order.
+  std::vector<unsigned> bcLoopHeaders_{};
+
   /// The native code offset of every compiled bc BB.
   std::vector<uint8_t *> nativeBBAddress_{};
 
+  /// The native OSR entry of every loop header in \c bcLoopHeaders_.
+  std::vector<uint8_t *> nativeOSREntryAddress_{};
+
   /// Relocations.
   std::vector<Relo> relocs_{};
 
@@ -545,8 +602,17 @@ class FastJIT {
   /// currently compiling.
   unsigned curBytecodeBBIndex_ = 0;
 
+  /// The hermes register whose number XMM0 still holds on the fast path,
+  /// because the last instruction compiled in the basic block was arithmetic
+  /// with that register as result. The result is still stored in the frame,
+  /// so nothing needs to be spilled when this is forgotten.
+  llvm::Optional<uint32_t> xmm0HermesReg_{};
+
   /// Set if an error occurred.
   bool error_ = false;
+  /// Set if the executable heap was full when compiling in the background,
+  /// which isn't an error.
+  bool outOfMemory_ = false;
   /// Optional error message, set the first time we record an error.
   std::string errorMsg_{};
 
@@ -7,24 +7,169 @@
 #include "hermes/VM/JIT/x86-64/JIT.h"
 
 #include "FastJIT.h"
+#include "RegexJIT.h"
+
+#include <algorithm>
 
 namespace hermes {
 namespace vm {
 namespace x86_64 {
 
+/// Maximum number of regex bytecodes whose searches are counted.
+static constexpr size_t kMaxRegexEntries = 256;
+
+/// Number of frames of the backtracking stack of regexes.
+static constexpr size_t kRegexStackFrames = 4096;
+
+/// The native code of a regex gives up after backtracking this many times,
+/// plus a few times per character, and lets the interpreter search instead.
+static constexpr uint64_t kRegexMinBacktracks = 1024;
+static constexpr uint64_t kRegexBacktracksPerChar = 16;
+
 JITContext::JITContext(bool enable, size_t blockSize, size_t maxMemory)
     : enabled_(enable), heap_(blockSize / 2, blockSize / 2, maxMemory) {}
 
-JITContext::~JITContext() = default;
+JITContext::~JITContext() {
+  if (!worker_.joinable())
+    return;
+  {
+    std::lock_guard<std::mutex> lock{queueMutex_};
+    stopWorker_ = true;
+  }
+  queueCond_.notify_one();
+  worker_.join();
+}
 
 JITCompiledFunctionPtr JITContext::compileImpl(
     Runtime *runtime,
     CodeBlock *codeBlock) {
+  ++useClock_;
+  bool fits;
+  {
+    // Evicting code requires walking the stack, so it must happen on the JS
+    // thread even when compiling in the background.
+    std::lock_guard<std::mutex> lock{heapMutex_};
+    fits = codeCache_.evict(
+        runtime,
+        heap_,
+        FastJIT::estimateSizes(codeBlock->getOpcodeArray().size()));
+  }
+  if (background_) {
+    if (!fits) {
+      // Give up like a synchronous compilation would, rather than queueing
+      // the function again on every call.
+      codeBlock->setDontJIT(true);
+      return nullptr;
+    }
+    profile_.add(codeBlock);
+    enqueue(codeBlock);
+    return nullptr;
+  }
+  FastJIT::prepareForCompile(codeBlock);
   FastJIT impl{this, codeBlock};
   impl.compile();
+  if (!codeBlock->getDontJIT())
+    profile_.add(codeBlock);
   return codeBlock->getJITCompiled();
 }
 
+RegexJITFunction JITContext::compileRegexImpl(
+    RegexJITEntry *&entry,
+    llvm::ArrayRef<uint8_t> bytecode) {
+  if (!entry) {
+    std::string key(bytecode.begin(), bytecode.end());
+    auto it = regexEntries_.find(key);
+    if (it != regexEntries_.end())
+      entry = &it->second;
+    else if (regexEntries_.size() < kMaxRegexEntries)
+      entry = &regexEntries_[std::move(key)];
+    else
+      entry = &noRegexEntry_;
+    return compileRegex(entry, bytecode);
+  }
+  std::lock_guard<std::mutex> lock{heapMutex_};
+  RegexJIT impl{this, bytecode};
+  entry->code = impl.compile();
+  entry->dontJIT = !entry->code;
+  return entry->code;
+}
+
+int JITContext::runRegex(
+    RegexJITFunction code,
+    const char *first,
+    const char *last,
+    const char *start,
+    const char **captures) {
+  if (regexStack_.empty())
+    regexStack_.resize(3 * kRegexStackFrames);
+  RegexJITStack stack{regexStack_.data(),
+                      regexStack_.data() + regexStack_.size(),
+                      kRegexMinBacktracks +
+                          kRegexBacktracksPerChar * (uint64_t)(last - start)};
+  return code(first, last, start, captures, &stack);
+}
+
+void JITContext::removeRuntimeModule(RuntimeModule *runtimeModule) {
+  if (worker_.joinable()) {
+    std::unique_lock<std::mutex> lock{queueMutex_};
+    queue_.erase(
+        std::remove_if(
+            queue_.begin(),
+            queue_.end(),
+            [runtimeModule](CodeBlock *codeBlock) {
+              return codeBlock->getRuntimeModule() == runtimeModule;
+            }),
+        queue_.end());
+    doneCond_.wait(lock, [this, runtimeModule]() {
+      return !compiling_ || compiling_->getRuntimeModule() != runtimeModule;
+    });
+  }
+  std::lock_guard<std::mutex> lock{heapMutex_};
+  codeCache_.removeRuntimeModule(runtimeModule, heap_);
+}
+
+void JITContext::printStats(llvm::raw_ostream &os) {
+  std::lock_guard<std::mutex> lock{heapMutex_};
+  codeCache_.printStats(os);
+}
+
+void JITContext::enqueue(CodeBlock *codeBlock) {
+  // Anything that touches the runtime must happen here, on the JS thread.
+  FastJIT::prepareForCompile(codeBlock);
+  codeBlock->setJITQueued(true);
+  {
+    std::lock_guard<std::mutex> lock{queueMutex_};
+    queue_.push_back(codeBlock);
+  }
+  if (!worker_.joinable())
+    worker_ = std::thread(&JITContext::runWorker, this);
+  else
+    queueCond_.notify_one();
+}
+
+void JITContext::runWorker() {
+  std::unique_lock<std::mutex> lock{queueMutex_};
+  for (;;) {
+    queueCond_.wait(lock, [this]() { return stopWorker_ || !queue_.empty(); });
+    if (stopWorker_)
+      return;
+    compiling_ = queue_.front();
+    queue_.pop_front();
+    lock.unlock();
+
+    FastJIT impl{this, compiling_};
+    impl.compile();
+    // Functions queued together may have counted on the same free memory.
+    // The next call queues this one again, after evicting code.
+    if (impl.isOutOfMemory())
+      compiling_->setJITQueued(false);
+
+    lock.lock();
+    compiling_ = nullptr;
+    doneCond_.notify_all();
+  }
+}
+
 } // namespace x86_64
 } // namespace vm
 } // namespace hermes
@@ -0,0 +1,609 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "RegexJIT.h"
+
+#include "hermes/Regex/Compiler.h"
+#include "hermes/Regex/Executor.h"
+#include "hermes/Support/ErrorHandling.h"
+
+#include "llvm/Support/raw_ostream.h"
+
+#include <cstring>
+
+namespace hermes {
+namespace vm {
+namespace x86_64 {
+
+using namespace hermes::regex;
+
+/// The start of the input. Only needed to test what precedes a position.
+static constexpr Reg kFirst = Reg::rdi;
+/// The end of the input.
+static constexpr Reg kLast = Reg::rsi;
+/// The input position.
+static constexpr Reg kPos = Reg::rdx;
+/// The captures.
+static constexpr Reg kCaptures = Reg::rcx;
+/// The top of the backtracking stack. On entry, the RegexJITStack.
+static constexpr Reg kTop = Reg::r8;
+/// The end of the backtracking stack.
+static constexpr Reg kStackEnd = Reg::r9;
+/// The location where the current attempt to match started.
+static constexpr Reg kStart = Reg::r10;
+/// The limit of a Width1Loop, or the character preceding a word boundary.
+static constexpr Reg kLimit = Reg::r11;
+/// The table of the Width1 instruction being matched. Callee-saved.
+static constexpr Reg kTable = Reg::rbx;
+/// The start of the backtracking stack. Callee-saved.
+static constexpr Reg kStackBegin = Reg::r12;
+/// The number of times the search may still backtrack. Callee-saved.
+static constexpr Reg kBacktracksLeft = Reg::r13;
+/// A scratch register, which also holds the result.
+static constexpr Reg kScratch = Reg::rax;
+
+/// Offsets of the fields of a backtracking frame.
+static constexpr int32_t kFrameCode = 0;
+static constexpr int32_t kFramePos = 8;
+static constexpr int32_t kFrameAux = 16;
+
+/// Upper bound of the size of the code emitted by emitPrologue().
+static constexpr size_t kMaxPrologueSize = 512;
+/// Upper bound of the size of the code of an instruction.
+static constexpr size_t kMaxInsnSize = 256;
+/// The size of a table of ASCII characters.
+static constexpr size_t kTableSize = 128;
+
+/// Loops with at least that many iterations are considered unbounded, since
+/// no string is that long.
+static constexpr uint32_t kUnboundedLoop = 1u << 31;
+
+/// \return whether \p insn matches exactly one character.
+static bool isWidth1(const Insn *insn) {
+  switch (insn->opcode) {
+    case Opcode::MatchAnyButNewline:
+    case Opcode::MatchChar8:
+    case Opcode::MatchChar16:
+    case Opcode::MatchCharICase8:
+    case Opcode::MatchCharICase16:
+    case Opcode::Bracket:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// \return whether an ASCII string can satisfy the constraints \p constraints.
+static bool isViable(MatchConstraintSet constraints) {
+  return !(constraints & MatchConstraintNonASCII);
+}
+
+RegexJIT::RegexJIT(JITContext *context, llvm::ArrayRef<uint8_t> bytecode)
+    : context_(context),
+      bytecode_(bytecode),
+      header_(reinterpret_cast<const RegexBytecodeHeader *>(bytecode.data())) {
+}
+
+RegexJITFunction RegexJIT::compile() {
+  if (!isViable(header_->constraints) || !scanInstructions())
+    return nullptr;
+
+  ExecHeap &heap = context_->getHeap();
+  ExecHeap::SizePair sizes{kMaxPrologueSize + 16 * header_->markedCount +
+                               kMaxInsnSize * numInsns_,
+                           kTableSize * (numTables_ + 1)};
+  auto blocks = heap.alloc(sizes);
+  // If the allocation failed, add a new pool and retry.
+  if (!blocks) {
+    auto newPool = heap.addPool();
+    if (!newPool)
+      return nullptr;
+    blocks = newPool->alloc(sizes);
+    if (!blocks)
+      return nullptr;
+  }
+  if (!heap.makeWritable(*blocks)) {
+    heap.free(*blocks);
+    return nullptr;
+  }
+
+  emit_ = Emitter{blocks->first};
+  codeEnd_ = blocks->first + sizes.first;
+  data_ = blocks->second;
+  dataEnd_ = blocks->second + sizes.second;
+
+  emitPrologue();
+
+  const uint8_t *insns = bytecode_.data() + sizeof(RegexBytecodeHeader);
+  uint32_t size = bytecode_.size() - sizeof(RegexBytecodeHeader);
+  bool fallsThrough = false;
+  for (uint32_t ip = 0; ip < size;) {
+    const Insn *insn = reinterpret_cast<const Insn *>(insns + ip);
+    if (alternationTargets_.count(ip)) {
+      // Don't restore the input position when falling through.
+      uint8_t *skip = fallsThrough ? emitJumpForward() : nullptr;
+      alternationCode_[ip] = emit_.current();
+      emit_.movRMToReg<S::Q>(kTop, Reg::NoIndex, kFramePos, kPos);
+      if (skip)
+        patchJump(skip);
+    }
+    insnCode_[ip] = emit_.current();
+    emitInstruction(insn);
+    assert(
+        emit_.current() <= codeEnd_ && "instruction size was underestimated");
+
+    fallsThrough = insn->opcode != Opcode::Goal &&
+        insn->opcode != Opcode::Jump32 &&
+        !(insn->opcode == Opcode::Alternation &&
+          !isViable(llvm::cast<AlternationInsn>(insn)->primaryConstraints));
+    if (const auto *loop = llvm::dyn_cast<Width1LoopInsn>(insn))
+      ip = loop->notTakenTarget;
+    else
+      ip += insnWidth(insn);
+  }
+
+  for (const Fixup &fixup : fixups_) {
+    if (fixup.isAddress)
+      patchAddress(fixup.location, alternationCode_[fixup.target]);
+    else
+      patchJump(fixup.location, insnCode_[fixup.target]);
+  }
+
+  if (context_->getDumpJITCode())
+    dump(blocks->first, emit_.current());
+
+  ExecHeap::SizePair used{emit_.current() - blocks->first,
+                          data_ - blocks->second};
+  if (!heap.makeExecutable(*blocks, used))
+    hermes_fatal("cannot make JIT code executable");
+  heap.freeRemaining(*blocks, used);
+  return reinterpret_cast<RegexJITFunction>(blocks->first);
+}
+
+bool RegexJIT::scanInstructions() {
+  const uint8_t *insns = bytecode_.data() + sizeof(RegexBytecodeHeader);
+  uint32_t size = bytecode_.size() - sizeof(RegexBytecodeHeader);
+  for (uint32_t ip = 0; ip < size;) {
+    const Insn *insn = reinterpret_cast<const Insn *>(insns + ip);
+    ip += insnWidth(insn);
+    ++numInsns_;
+    if (isWidth1(insn))
+      ++numTables_;
+    switch (insn->opcode) {
+      case Opcode::BackRef:
+      case Opcode::Lookahead:
+      case Opcode::BeginLoop:
+      case Opcode::EndLoop:
+      case Opcode::BeginSimpleLoop:
+      case Opcode::EndSimpleLoop:
+        return false;
+      case Opcode::Alternation:
+        alternationTargets_.insert(
+            llvm::cast<AlternationInsn>(insn)->secondaryBranch);
+        break;
+      default:
+        break;
+    }
+  }
+  return true;
+}
+
+void RegexJIT::emitPrologue() {
+  emit_.pushqReg(kTable);
+  emit_.pushqReg(kStackBegin);
+  emit_.pushqReg(kBacktracksLeft);
+  emit_.movRMToReg<S::Q>(
+      kTop, Reg::NoIndex, offsetof(RegexJITStack, begin), kStackBegin);
+  emit_.movRMToReg<S::Q>(
+      kTop, Reg::NoIndex, offsetof(RegexJITStack, end), kStackEnd);
+  emit_.movRMToReg<S::Q>(
+      kTop,
+      Reg::NoIndex,
+      offsetof(RegexJITStack, backtracksLeft),
+      kBacktracksLeft);
+  emit_.movRegToReg<S::Q>(kPos, kStart);
+
+  // No capture group has matched yet.
+  emit_.xorRegToReg<S::L>(kScratch, kScratch);
+  for (uint32_t mexp = 1; mexp <= header_->markedCount; ++mexp) {
+    emit_.movRegToRM<S::Q>(kScratch, kCaptures, Reg::NoIndex, 16 * mexp);
+    emit_.movRegToRM<S::Q>(kScratch, kCaptures, Reg::NoIndex, 16 * mexp + 8);
+  }
+  uint8_t *toAttempt = emitJumpForward();
+
+  // Pop the top frame and resume the search there.
+  fail_ = emit_.current();
+  emit_.testRegToReg<S::Q>(kBacktracksLeft, kBacktracksLeft);
+  uint8_t *exhausted = emitCondJumpForward<CCode::E>();
+  emit_.leaRMToReg<S::Q>(kBacktracksLeft, Reg::NoIndex, -1, kBacktracksLeft);
+  emit_.leaRMToReg<S::Q>(kTop, Reg::NoIndex, -kFrameSize, kTop);
+  emit_.jmpRM(kTop, Reg::NoIndex, kFrameCode);
+
+  patchJump(exhausted);
+  giveUp_ = emit_.current();
+  emit_.movImmToReg<S::L>((uint32_t)RegexJITGiveUp, kScratch);
+  uint8_t *giveUpExit = emitJumpForward();
+
+  goal_ = emit_.current();
+  emit_.movRegToRM<S::Q>(kStart, kCaptures, Reg::NoIndex, 0);
+  emit_.movRegToRM<S::Q>(kPos, kCaptures, Reg::NoIndex, 8);
+  emit_.movImmToReg<S::L>(RegexJITMatch, kScratch);
+  uint8_t *goalExit = emitJumpForward();
+
+  noMatch_ = emit_.current();
+  emit_.xorRegToReg<S::L>(kScratch, kScratch);
+  patchJump(giveUpExit);
+  patchJump(goalExit);
+  emit_.popqReg(kBacktracksLeft);
+  emit_.popqReg(kStackBegin);
+  emit_.popqReg(kTable);
+  emit_.retq();
+
+  // The code of the bottom frame of every attempt, which moves on to the
+  // next location.
+  const uint8_t *nextStart = emit_.current();
+  if (header_->constraints & MatchConstraintAnchoredAtStart) {
+    (void)emit_.jmp<OffsetType::Auto>(noMatch_);
+  } else {
+    emit_.cmpRMToReg<S::Q, ScaleRegAccess>(kLast, Reg::NoIndex, 0, kStart);
+    (void)emit_.cjump<CCode::AE, OffsetType::Auto>(noMatch_);
+    emit_.leaRMToReg<S::Q>(kStart, Reg::NoIndex, 1, kStart);
+  }
+
+  patchJump(toAttempt);
+  if (!(header_->constraints & MatchConstraintAnchoredAtStart)) {
+    emitFindMatchStart(reinterpret_cast<const Insn *>(
+        bytecode_.data() + sizeof(RegexBytecodeHeader)));
+  }
+  emit_.movRegToReg<S::Q>(kStart, kPos);
+  emit_.movRegToReg<S::Q>(kStackBegin, kTop);
+  // The stack always has room for one frame.
+  emit_.movImmToReg<S::Q>((uint64_t)nextStart, kScratch);
+  emit_.movRegToRM<S::Q>(kScratch, kTop, Reg::NoIndex, kFrameCode);
+  emit_.leaRMToReg<S::Q>(kTop, Reg::NoIndex, kFrameSize, kTop);
+}
+
+void RegexJIT::emitFindMatchStart(const Insn *insn) {
+  // Skip the instructions which don't consume input.
+  while (llvm::isa<BeginMarkedSubexpressionInsn>(insn))
+    insn = reinterpret_cast<const Insn *>(
+        reinterpret_cast<const uint8_t *>(insn) + insnWidth(insn));
+  if (const auto *loop = llvm::dyn_cast<Width1LoopInsn>(insn)) {
+    if (loop->min == 0)
+      return;
+    insn = reinterpret_cast<const Insn *>(loop + 1);
+  }
+  if (!isWidth1(insn))
+    return;
+
+  emitLoadTable(insn);
+  uint8_t *toCheck = emitJumpForward();
+  const uint8_t *advance = emit_.current();
+  emit_.leaRMToReg<S::Q>(kStart, Reg::NoIndex, 1, kStart);
+  patchJump(toCheck);
+  emit_.cmpRMToReg<S::Q, ScaleRegAccess>(kLast, Reg::NoIndex, 0, kStart);
+  (void)emit_.cjump<CCode::AE, OffsetType::Auto>(noMatch_);
+  emitMatchWidth1(insn, kStart, advance, false);
+}
+
+void RegexJIT::emitInstruction(const Insn *insn) {
+  switch (insn->opcode) {
+    case Opcode::Goal:
+      (void)emit_.jmp<OffsetType::Auto>(goal_);
+      break;
+
+    case Opcode::LeftAnchor: {
+      // Matches at the start of the input or, in multiline mode, after a line
+      // terminator.
+      emit_.cmpRMToReg<S::Q, ScaleRegAccess>(kFirst, Reg::NoIndex, 0, kPos);
+      uint8_t *atStart = emitCondJumpForward<CCode::E>();
+      if (header_->syntaxFlags & constants::multiline) {
+        emit_.movzbRMToReg(kPos, Reg::NoIndex, -1, kScratch);
+        emit_.cmpImmToRM<S::B, ScaleRegAccess>('\n', kScratch, Reg::NoIndex, 0);
+        uint8_t *afterLF = emitCondJumpForward<CCode::E>();
+        emit_.cmpImmToRM<S::B, ScaleRegAccess>('\r', kScratch, Reg::NoIndex, 0);
+        (void)emit_.cjump<CCode::NE, OffsetType::Int32>(fail_);
+        patchJump(afterLF);
+      } else {
+        (void)emit_.jmp<OffsetType::Int32>(fail_);
+      }
+      patchJump(atStart);
+      break;
+    }
+
+    case Opcode::RightAnchor: {
+      // Matches at the end of the input or, in multiline mode, before a line
+      // terminator.
+      emit_.cmpRMToReg<S::Q, ScaleRegAccess>(kLast, Reg::NoIndex, 0, kPos);
+      uint8_t *atEnd = emitCondJumpForward<CCode::E>();
+      if (header_->syntaxFlags & constants::multiline) {
+        emit_.movzbRMToReg(kPos, Reg::NoIndex, 0, kScratch);
+        emit_.cmpImmToRM<S::B, ScaleRegAccess>('\n', kScratch, Reg::NoIndex, 0);
+        uint8_t *beforeLF = emitCondJumpForward<CCode::E>();
+        emit_.cmpImmToRM<S::B, ScaleRegAccess>('\r', kScratch, Reg::NoIndex, 0);
+        (void)emit_.cjump<CCode::NE, OffsetType::Int32>(fail_);
+        patchJump(beforeLF);
+      } else {
+        (void)emit_.jmp<OffsetType::Int32>(fail_);
+      }
+      patchJump(atEnd);
+      break;
+    }
+
+    case Opcode::MatchAnyButNewline:
+    case Opcode::MatchChar8:
+    case Opcode::MatchChar16:
+    case Opcode::MatchCharICase8:
+    case Opcode::MatchCharICase16:
+    case Opcode::Bracket:
+      emit_.cmpRMToReg<S::Q, ScaleRegAccess>(kLast, Reg::NoIndex, 0, kPos);
+      (void)emit_.cjump<CCode::AE, OffsetType::Int32>(fail_);
+      emitMatchWidth1(insn, kPos, fail_);
+      emit_.leaRMToReg<S::Q>(kPos, Reg::NoIndex, 1, kPos);
+      break;
+
+    case Opcode::Alternation: {
+      const auto *alt = llvm::cast<AlternationInsn>(insn);
+      bool primary = isViable(alt->primaryConstraints);
+      bool secondary = isViable(alt->secondaryConstraints);
+      if (primary && secondary) {
+        // Try the primary branch, and the secondary one when backtracking.
+        emitCheckStack();
+        fixups_.push_back({emitPushFrame(), alt->secondaryBranch, true});
+      } else if (secondary) {
+        fixups_.push_back({emitJumpForward(), alt->secondaryBranch, false});
+      } else if (!primary) {
+        (void)emit_.jmp<OffsetType::Int32>(fail_);
+      }
+      break;
+    }
+
+    case Opcode::Jump32:
+      fixups_.push_back(
+          {emitJumpForward(), llvm::cast<Jump32Insn>(insn)->target, false});
+      break;
+
+    case Opcode::BeginMarkedSubexpression: {
+      int32_t offset =
+          16 * llvm::cast<BeginMarkedSubexpressionInsn>(insn)->mexp;
+      emitCheckStack();
+      uint8_t *restoreAddress = emitPushFrame();
+      emit_.movRegToRM<S::Q>(kPos, kCaptures, Reg::NoIndex, offset);
+      uint8_t *skip = emitJumpForward();
+
+      // Forget the capture group when backtracking.
+      patchAddress(restoreAddress, emit_.current());
+      emit_.xorRegToReg<S::L>(kScratch, kScratch);
+      emit_.movRegToRM<S::Q>(kScratch, kCaptures, Reg::NoIndex, offset);
+      emit_.movRegToRM<S::Q>(kScratch, kCaptures, Reg::NoIndex, offset + 8);
+      (void)emit_.jmp<OffsetType::Int32>(fail_);
+      patchJump(skip);
+      break;
+    }
+
+    case Opcode::EndMarkedSubexpression:
+      emit_.movRegToRM<S::Q>(
+          kPos,
+          kCaptures,
+          Reg::NoIndex,
+          16 * llvm::cast<EndMarkedSubexpressionInsn>(insn)->mexp + 8);
+      break;
+
+    case Opcode::WordBoundary: {
+      // Compare whether the characters before and after the position are word
+      // characters, 0 standing for the ends of the input.
+      emit_.movImmToReg<S::Q>((uint64_t)getWordTable(), kTable);
+      emit_.xorRegToReg<S::L>(kLimit, kLimit);
+      emit_.cmpRMToReg<S::Q, ScaleRegAccess>(kFirst, Reg::NoIndex, 0, kPos);
+      uint8_t *atStart = emitCondJumpForward<CCode::E>();
+      emit_.movzbRMToReg(kPos, Reg::NoIndex, -1, kScratch);
+      emit_.movzbRMToReg<1>(kTable, kScratch, 0, kLimit);
+      patchJump(atStart);
+      // This doesn't change the flags.
+      emit_.movImmToReg<S::L>(0, kScratch);
+      emit_.cmpRMToReg<S::Q, ScaleRegAccess>(kLast, Reg::NoIndex, 0, kPos);
+      uint8_t *atEnd = emitCondJumpForward<CCode::E>();
+      emit_.movzbRMToReg(kPos, Reg::NoIndex, 0, kScratch);
+      emit_.movzbRMToReg<1>(kTable, kScratch, 0, kScratch);
+      patchJump(atEnd);
+      emit_.cmpRMToReg<S::L, ScaleRegAccess>(kLimit, Reg::NoIndex, 0, kScratch);
+      if (llvm::cast<WordBoundaryInsn>(insn)->invert)
+        (void)emit_.cjump<CCode::NE, OffsetType::Int32>(fail_);
+      else
+        (void)emit_.cjump<CCode::E, OffsetType::Int32>(fail_);
+      break;
+    }
+
+    case Opcode::Width1Loop:
+      emitWidth1Loop(llvm::cast<Width1LoopInsn>(insn));
+      break;
+
+    case Opcode::BackRef:
+    case Opcode::Lookahead:
+    case Opcode::BeginLoop:
+    case Opcode::EndLoop:
+    case Opcode::BeginSimpleLoop:
+    case Opcode::EndSimpleLoop:
+      llvm_unreachable("unsupported instructions are rejected by the scan");
+  }
+}
+
+uint8_t *RegexJIT::emitMatchWidth1(
+    const Insn *insn,
+    Reg pos,
+    const uint8_t *noMatch,
+    bool loadTable) {
+  if (const auto *match = llvm::dyn_cast<MatchChar8Insn>(insn)) {
+    emit_.cmpImmToRM<S::B>(match->c, pos, Reg::NoIndex, 0);
+    if (!noMatch)
+      return emitCondJumpForward<CCode::NE>();
+    (void)emit_.cjump<CCode::NE, OffsetType::Auto>(noMatch);
+    return nullptr;
+  }
+  if (loadTable)
+    emitLoadTable(insn);
+  emit_.movzbRMToReg(pos, Reg::NoIndex, 0, kScratch);
+  emit_.cmpImmToRM<S::B, 1>(0, kTable, kScratch, 0);
+  if (!noMatch)
+    return emitCondJumpForward<CCode::E>();
+  (void)emit_.cjump<CCode::E, OffsetType::Auto>(noMatch);
+  return nullptr;
+}
+
+void RegexJIT::emitLoadTable(const Insn *insn) {
+  if (!llvm::isa<MatchChar8Insn>(insn))
+    emit_.movImmToReg<S::Q>((uint64_t)getWidth1Table(insn), kTable);
+}
+
+void RegexJIT::emitWidth1Loop(const Width1LoopInsn *loop) {
+  const Insn *body = reinterpret_cast<const Insn *>(loop + 1);
+  if (loop->min >= kUnboundedLoop) {
+    (void)emit_.jmp<OffsetType::Int32>(fail_);
+    return;
+  }
+  int32_t min = loop->min;
+
+  if (loop->greedy) {
+    // Match as many characters as possible, and push a frame which gives
+    // one back each time it is resumed, down to the minimum kept in the frame.
+    emitLoopLimit(loop->max);
+    emitCheckStack();
+    emit_.leaRMToReg<S::Q>(kPos, Reg::NoIndex, min, kScratch);
+    emit_.movRegToRM<S::Q>(kScratch, kTop, Reg::NoIndex, kFrameAux);
+    emitLoadTable(body);
+    const uint8_t *check = emit_.current();
+    emit_.cmpRMToReg<S::Q, ScaleRegAccess>(kLimit, Reg::NoIndex, 0, kPos);
+    uint8_t *atLimit = emitCondJumpForward<CCode::AE>();
+    uint8_t *mismatch = emitMatchWidth1(body, kPos, nullptr, false);
+    emit_.leaRMToReg<S::Q>(kPos, Reg::NoIndex, 1, kPos);
+    (void)emit_.jmp<OffsetType::Auto>(check);
+    patchJump(atLimit);
+    patchJump(mismatch);
+
+    emit_.cmpRMToReg<S::Q>(kTop, Reg::NoIndex, kFrameAux, kPos);
+    (void)emit_.cjump<CCode::B, OffsetType::Int32>(fail_);
+    uint8_t *atMin = emitCondJumpForward<CCode::E>();
+    uint8_t *resumeAddress = emitPushFrame();
+    uint8_t *toContinue = emitJumpForward();
+
+    patchAddress(resumeAddress, emit_.current());
+    emit_.movRMToReg<S::Q>(kTop, Reg::NoIndex, kFramePos, kPos);
+    emit_.leaRMToReg<S::Q>(kPos, Reg::NoIndex, -1, kPos);
+    emit_.cmpRMToReg<S::Q>(kTop, Reg::NoIndex, kFrameAux, kPos);
+    uint8_t *resumedAtMin = emitCondJumpForward<CCode::E>();
+    emit_.movRegToRM<S::Q>(kPos, kTop, Reg::NoIndex, kFramePos);
+    emit_.leaRMToReg<S::Q>(kTop, Reg::NoIndex, kFrameSize, kTop);
+
+    patchJump(atMin);
+    patchJump(toContinue);
+    patchJump(resumedAtMin);
+    return;
+  }
+
+  // Match the minimum number of characters, and push a frame which matches
+  // one more each time it is resumed, up to the limit kept in the frame.
+  emitCheckStack();
+  emitLoopLimit(loop->max);
+  emit_.movRegToRM<S::Q>(kLimit, kTop, Reg::NoIndex, kFrameAux);
+  if (min) {
+    emit_.leaRMToReg<S::Q>(kPos, Reg::NoIndex, min, kScratch);
+    emit_.cmpRMToReg<S::Q, ScaleRegAccess>(kLimit, Reg::NoIndex, 0, kScratch);
+    (void)emit_.cjump<CCode::A, OffsetType::Int32>(fail_);
+    emit_.movRegToReg<S::Q>(kScratch, kLimit);
+    emitLoadTable(body);
+    const uint8_t *next = emit_.current();
+    emitMatchWidth1(body, kPos, fail_, false);
+    emit_.leaRMToReg<S::Q>(kPos, Reg::NoIndex, 1, kPos);
+    emit_.cmpRMToReg<S::Q, ScaleRegAccess>(kLimit, Reg::NoIndex, 0, kPos);
+    (void)emit_.cjump<CCode::B, OffsetType::Auto>(next);
+  }
+  emit_.cmpRMToReg<S::Q>(kTop, Reg::NoIndex, kFrameAux, kPos);
+  uint8_t *atMax = emitCondJumpForward<CCode::E>();
+  uint8_t *resumeAddress = emitPushFrame();
+  uint8_t *toContinue = emitJumpForward();
+
+  patchAddress(resumeAddress, emit_.current());
+  emit_.movRMToReg<S::Q>(kTop, Reg::NoIndex, kFramePos, kPos);
+  emitMatchWidth1(body, kPos, fail_);
+  emit_.leaRMToReg<S::Q>(kPos, Reg::NoIndex, 1, kPos);
+  emit_.cmpRMToReg<S::Q>(kTop, Reg::NoIndex, kFrameAux, kPos);
+  uint8_t *resumedAtMax = emitCondJumpForward<CCode::E>();
+  emit_.movRegToRM<S::Q>(kPos, kTop, Reg::NoIndex, kFramePos);
+  emit_.leaRMToReg<S::Q>(kTop, Reg::NoIndex, kFrameSize, kTop);
+
+  patchJump(atMax);
+  patchJump(toContinue);
+  patchJump(resumedAtMax);
+}
+
+void RegexJIT::emitLoopLimit(uint32_t max) {
+  emit_.movRegToReg<S::Q>(kLast, kLimit);
+  if (max >= kUnboundedLoop)
+    return;
+  emit_.leaRMToReg<S::Q>(kPos, Reg::NoIndex, (int32_t)max, kScratch);
+  emit_.cmpRMToReg<S::Q, ScaleRegAccess>(kLimit, Reg::NoIndex, 0, kScratch);
+  uint8_t *pastEnd = emitCondJumpForward<CCode::AE>();
+  emit_.movRegToReg<S::Q>(kScratch, kLimit);
+  patchJump(pastEnd);
+}
+
+void RegexJIT::emitCheckStack() {
+  emit_.cmpRMToReg<S::Q, ScaleRegAccess>(kStackEnd, Reg::NoIndex, 0, kTop);
+  (void)emit_.cjump<CCode::AE, OffsetType::Int32>(giveUp_);
+}
+
+uint8_t *RegexJIT::emitPushFrame() {
+  emit_.movImmToReg<S::Q>(0, kScratch);
+  uint8_t *address = emit_.current() - sizeof(uint64_t);
+  emit_.movRegToRM<S::Q>(kScratch, kTop, Reg::NoIndex, kFrameCode);
+  emit_.movRegToRM<S::Q>(kPos, kTop, Reg::NoIndex, kFramePos);
+  emit_.leaRMToReg<S::Q>(kTop, Reg::NoIndex, kFrameSize, kTop);
+  return address;
+}
+
+void RegexJIT::patchJump(uint8_t *jumpEnd, const uint8_t *target) {
+  int32_t offset = target - jumpEnd;
+  std::memcpy(jumpEnd - sizeof(int32_t), &offset, sizeof(int32_t));
+}
+
+void RegexJIT::patchAddress(uint8_t *address, const uint8_t *target) {
+  uint64_t value = (uint64_t)target;
+  std::memcpy(address, &value, sizeof(uint64_t));
+}
+
+const uint8_t *RegexJIT::getWidth1Table(const Insn *insn) {
+  const uint8_t *&table = tables_[insn];
+  if (table)
+    return table;
+  assert(data_ + kTableSize <= dataEnd_ && "too many tables");
+  getWidth1ASCIITable(bytecode_, insn, data_);
+  table = data_;
+  data_ += kTableSize;
+  return table;
+}
+
+const uint8_t *RegexJIT::getWordTable() {
+  if (wordTable_)
+    return wordTable_;
+  assert(data_ + kTableSize <= dataEnd_ && "too many tables");
+  uint8_t *table = data_;
+  data_ += kTableSize;
+  for (unsigned c = 0; c < kTableSize; ++c) {
+    table[c] = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+        (c >= '0' && c <= '9') || c == '_';
+  }
+  return wordTable_ = table;
+}
+
+void RegexJIT::dump(const uint8_t *start, const uint8_t *end) const {
+  llvm::outs() << "\n\nCompiled Code of RegExp\n";
+  context_->getDisassembler().disassembleBuffer(
+      llvm::outs(), {start, end}, 0, false);
+}
+
+} // namespace x86_64
+} // namespace vm
+} // namespace hermes
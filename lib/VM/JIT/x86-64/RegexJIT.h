@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_VM_JIT_X86_64_REGEXJIT_H
+#define HERMES_VM_JIT_X86_64_REGEXJIT_H
+
+#include "hermes/Regex/RegexBytecode.h"
+#include "hermes/VM/JIT/RegexJIT.h"
+#include "hermes/VM/JIT/x86-64/Emitter.h"
+#include "hermes/VM/JIT/x86-64/JIT.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+
+#include <vector>
+
+namespace hermes {
+namespace vm {
+namespace x86_64 {
+
+/// An instance of this class is constructed to compile the bytecode of a regex
+/// to native code which searches ASCII strings.
+///
+/// The native code backtracks like the interpreter, but its backtracking stack
+/// only contains frames of three words: the address of the code which resumes
+/// the search, the input position to resume at, and a word whose meaning
+/// depends on that code. Failing to match pops the top frame and jumps to its
+/// code. Every attempt to match at a new location starts with a frame which
+/// moves on to the next location.
+///
+/// Only the instructions which don't need the loop data or the nested matches
+/// of the interpreter are supported: bytecode containing backreferences,
+/// lookaheads or loops other than Width1Loop is always interpreted.
+class RegexJIT {
+ public:
+  RegexJIT(JITContext *context, llvm::ArrayRef<uint8_t> bytecode);
+
+  /// Compile the bytecode. The caller must hold the heap mutex of the
+  /// context.
+  /// \return the native code, or nullptr if the bytecode contains an
+  ///   unsupported instruction or there is not enough executable memory.
+  RegexJITFunction compile();
+
+ private:
+  /// The size of a backtracking frame, in bytes.
+  static constexpr int32_t kFrameSize = 3 * sizeof(uintptr_t);
+
+  /// Check that every instruction is supported, and record the targets of the
+  /// alternations. \return false if an instruction is unsupported.
+  bool scanInstructions();
+
+  /// Emit the code which starts the search and the code shared by all
+  /// instructions.
+  void emitPrologue();
+
+  /// Emit the code which skips the locations where the first instruction
+  /// \p insn can't match, or nothing if it isn't a Width1 instruction.
+  void emitFindMatchStart(const regex::Insn *insn);
+
+  /// Emit the code of the instruction \p insn.
+  void emitInstruction(const regex::Insn *insn);
+
+  /// Emit the code which checks whether the Width1 instruction \p insn
+  /// matches the character at the position held by the register \p pos,
+  /// which must be before the end of the input. The code jumps to \p noMatch
+  /// if the character doesn't match, and falls through otherwise. If
+  /// \p noMatch is nullptr, it jumps to a forward jump which is returned.
+  /// If \p loadTable is false, the table of \p insn must already be in the
+  /// table register.
+  uint8_t *emitMatchWidth1(
+      const regex::Insn *insn,
+      Reg pos,
+      const uint8_t *noMatch,
+      bool loadTable = true);
+
+  /// Emit the code which loads the table of the Width1 instruction \p insn
+  /// in the table register, if it needs one.
+  void emitLoadTable(const regex::Insn *insn);
+
+  /// Emit the code of the Width1Loop \p loop.
+  void emitWidth1Loop(const regex::Width1LoopInsn *loop);
+
+  /// Emit the code which sets the limit register to the end of the input, or
+  /// to \p max characters after the input position if that is before.
+  void emitLoopLimit(uint32_t max);
+
+  /// Emit a jump to the code which gives up if the backtracking stack is
+  /// full.
+  void emitCheckStack();
+
+  /// Emit the code which pushes a frame resuming at the input position, with
+  /// the code which hasn't been emitted yet.
+  /// \return the location of the address of that code, to pass to
+  ///   patchAddress().
+  uint8_t *emitPushFrame();
+
+  /// Emit a jump, with the condition \p cc, to a location which isn't known
+  /// yet. \return the end of the jump, to pass to patchJump().
+  template <CCode cc>
+  uint8_t *emitCondJumpForward() {
+    (void)emit_.cjump<cc, OffsetType::Int32>(emit_.current());
+    return emit_.current();
+  }
+
+  /// Emit a jump to a location which isn't known yet. \return the end of the
+  /// jump, to pass to patchJump().
+  uint8_t *emitJumpForward() {
+    (void)emit_.jmp<OffsetType::Int32>(emit_.current());
+    return emit_.current();
+  }
+
+  /// Make the jump ending at \p jumpEnd target the current location.
+  void patchJump(uint8_t *jumpEnd) {
+    patchJump(jumpEnd, emit_.current());
+  }
+
+  /// Make the jump ending at \p jumpEnd target \p target.
+  static void patchJump(uint8_t *jumpEnd, const uint8_t *target);
+
+  /// Store \p target at the location \p address returned by emitPushFrame().
+  static void patchAddress(uint8_t *address, const uint8_t *target);
+
+  /// \return a table of 128 bytes telling whether the Width1 instruction
+  /// \p insn matches each ASCII character, allocated in the data block the
+  /// first time it is needed.
+  const uint8_t *getWidth1Table(const regex::Insn *insn);
+
+  /// \return a table of 128 bytes telling whether each ASCII character is a
+  /// word character, allocated in the data block.
+  const uint8_t *getWordTable();
+
+  /// Print the code from \p start to \p end.
+  void dump(const uint8_t *start, const uint8_t *end) const;
+
+  /// The context, which owns the executable heap.
+  JITContext *const context_;
+
+  /// The whole bytecode, including the header.
+  llvm::ArrayRef<uint8_t> bytecode_;
+
+  /// The header of the bytecode.
+  const regex::RegexBytecodeHeader *header_;
+
+  /// The code being emitted.
+  Emitter emit_{nullptr};
+
+  /// The end of the block where the code is emitted.
+  uint8_t *codeEnd_{nullptr};
+
+  /// The next free location and the end of the block where the tables are
+  /// allocated.
+  uint8_t *data_{nullptr};
+  uint8_t *dataEnd_{nullptr};
+
+  /// The tables of the Width1 instructions allocated so far.
+  llvm::DenseMap<const regex::Insn *, const uint8_t *> tables_{};
+
+  /// The table of word characters, once allocated.
+  const uint8_t *wordTable_{nullptr};
+
+  /// The code which pops a frame and resumes the search there.
+  const uint8_t *fail_{nullptr};
+
+  /// The code which records the end of the match and returns it.
+  const uint8_t *goal_{nullptr};
+
+  /// The code which gives up the search.
+  const uint8_t *giveUp_{nullptr};
+
+  /// The code which returns that there is no match.
+  const uint8_t *noMatch_{nullptr};
+
+  /// The offsets of the instructions which are the secondary branch of an
+  /// alternation.
+  llvm::DenseSet<uint32_t> alternationTargets_{};
+
+  /// The code of the instructions emitted so far, by offset.
+  llvm::DenseMap<uint32_t, const uint8_t *> insnCode_{};
+
+  /// The code which precedes each alternation target and restores the input
+  /// position, by offset. It is pushed as the code of a frame by the
+  /// alternation.
+  llvm::DenseMap<uint32_t, const uint8_t *> alternationCode_{};
+
+  /// The number of instructions, to estimate the size of the code.
+  uint32_t numInsns_{0};
+
+  /// The number of Width1 instructions, to estimate the size of the tables.
+  uint32_t numTables_{0};
+
+  /// A jump or address which refers to an instruction that hasn't been
+  /// emitted yet.
+  struct Fixup {
+    /// The end of the jump, or the location of the address.
+    uint8_t *location;
+    /// Offset of the target instruction.
+    uint32_t target;
+    /// Whether the location is an address rather than a jump. An address
+    /// refers to the alternation code of the target, a jump to its code.
+    bool isAddress;
+  };
+  std::vector<Fixup> fixups_{};
+};
+
+} // namespace x86_64
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_VM_JIT_X86_64_REGEXJIT_H
@@ -74,6 +74,71 @@ std::pair<uint32_t, uint32_t> ArrayImpl::_getOwnIndexedRangeImpl(
   return {self->beginIndex_, self->endIndex_};
 }
 
+void ArrayImpl::noteNewEndIndex(Runtime *runtime, uint32_t newEndIndex) {
+  if (newEndIndex <= beginIndex_) {
+    // The storage becomes empty.
+    numHoles_ = 0;
+    onlyNumbers_ = true;
+  } else if (newEndIndex >= endIndex_) {
+    numHoles_ += newEndIndex - endIndex_;
+  } else if (numHoles_) {
+    // Don't count the holes that are removed.
+    auto *storage = indexedStorage_.getNonNull(runtime);
+    for (uint32_t i = newEndIndex; i != endIndex_; ++i) {
+      if (storage->at(i - beginIndex_).isEmpty())
+        --numHoles_;
+    }
+  }
+}
+
+void ArrayImpl::unsafeCopyExistingElements(
+    ArrayImpl *self,
+    Runtime *runtime,
+    size_type index,
+    ArrayImpl *src,
+    size_type srcIndex,
+    size_type count) {
+  assert(!self->flags_.noExtend && "this array cannot be extended");
+  assert(
+      index >= self->beginIndex_ && count <= self->endIndex_ - index &&
+      "destination out of range");
+  assert(
+      srcIndex >= src->beginIndex_ && count <= src->endIndex_ - srcIndex &&
+      "source out of range");
+  assert(self != src && "cannot copy within an array");
+  auto *dst = self->indexedStorage_.getNonNull(runtime);
+  auto *from = src->indexedStorage_.getNonNull(runtime);
+  index -= self->beginIndex_;
+  srcIndex -= src->beginIndex_;
+
+  // Only the holes that are overwritten need to be counted, since none are
+  // copied.
+  if (self->numHoles_) {
+    for (size_type i = 0; i < count; ++i) {
+      if (dst->at(index + i).isEmpty())
+        --self->numHoles_;
+    }
+  }
+  self->onlyNumbers_ = self->onlyNumbers_ && src->onlyNumbers_;
+
+  while (count) {
+    size_type n = std::min(
+        count,
+        std::min(
+            StorageType::contiguousLengthAt(index),
+            StorageType::contiguousLengthAt(srcIndex)));
+    GCHermesValue *first = &from->at(srcIndex);
+    assert(
+        std::none_of(
+            first, first + n, [](HermesValue hv) { return hv.isEmpty(); }) &&
+        "copied elements must be present");
+    GCHermesValue::copy(first, first + n, &dst->at(index), &runtime->getHeap());
+    index += n;
+    srcIndex += n;
+    count -= n;
+  }
+}
+
 HermesValue ArrayImpl::_getOwnIndexedImpl(
     JSObject *selfObj,
     Runtime *runtime,
@@ -104,6 +169,7 @@ ExecutionStatus ArrayImpl::setStorageEndIndex(
         runtime, newStorage.get(), &runtime->getHeap());
     selfHandle->beginIndex_ = 0;
     selfHandle->endIndex_ = newLength;
+    selfHandle->numHoles_ = newLength;
     return ExecutionStatus::RETURNED;
   }
 
@@ -115,12 +181,14 @@ ExecutionStatus ArrayImpl::setStorageEndIndex(
 
   if (newLength < beginIndex) {
     // the new length is prior to beginIndex, clearing the storage.
+    self->noteNewEndIndex(runtime, newLength);
     selfHandle->endIndex_ = beginIndex;
     StorageType::resizeWithinCapacity(std::move(indexedStorage), runtime, 0);
     return ExecutionStatus::RETURNED;
   } else if (
       newLength - beginIndex <=
       self->indexedStorage_.getNonNull(runtime)->capacity()) {
+    self->noteNewEndIndex(runtime, newLength);
     selfHandle->endIndex_ = newLength;
     StorageType::resizeWithinCapacity(
         std::move(indexedStorage), runtime, newLength - beginIndex);
@@ -135,6 +203,7 @@ ExecutionStatus ArrayImpl::setStorageEndIndex(
       ExecutionStatus::EXCEPTION) {
     return ExecutionStatus::EXCEPTION;
   }
+  selfHandle->noteNewEndIndex(runtime, newLength);
   selfHandle->endIndex_ = newLength;
   selfHandle->indexedStorage_.set(
       runtime, indexedStorageHandle.get(), &runtime->getHeap());
@@ -155,12 +224,16 @@ CallResult<bool> ArrayImpl::_setOwnIndexedImpl(
 
   // Check whether the index is within the storage.
   if (LLVM_LIKELY(index >= beginIndex && index < endIndex)) {
-    self->indexedStorage_.getNonNull(runtime)
-        ->at(index - beginIndex)
-        .set(value.get(), &runtime->getHeap());
+    auto &elem =
+        self->indexedStorage_.getNonNull(runtime)->at(index - beginIndex);
+    self->noteStore(elem, value.get());
+    elem.set(value.get(), &runtime->getHeap());
     return true;
   }
 
+  // Each of the paths below adds the element to the storage as a hole, and
+  // then stores the value over it.
+
   // If indexedStorage hasn't even been allocated.
   if (LLVM_UNLIKELY(!self->indexedStorage_)) {
     // Allocate storage with capacity for 4 elements and length 1.
@@ -175,6 +248,8 @@ CallResult<bool> ArrayImpl::_setOwnIndexedImpl(
     self->indexedStorage_.set(runtime, newStorage.get(), &runtime->getHeap());
     self->beginIndex_ = index;
     self->endIndex_ = index + 1;
+    self->numHoles_ = 1;
+    self->noteStore(HermesValue::encodeEmptyValue(), value.get());
     newStorage->at(0).set(value.get(), &runtime->getHeap());
     return true;
   }
@@ -184,6 +259,8 @@ CallResult<bool> ArrayImpl::_setOwnIndexedImpl(
 
   // Can we do it without reallocation for sure?
   if (index >= endIndex && index - beginIndex < indexedStorage->capacity()) {
+    self->noteNewEndIndex(runtime, index + 1);
+    self->noteStore(HermesValue::encodeEmptyValue(), value.get());
     self->endIndex_ = index + 1;
     StorageType::resizeWithinCapacity(
         std::move(indexedStorage), runtime, index - beginIndex + 1);
@@ -210,6 +287,8 @@ CallResult<bool> ArrayImpl::_setOwnIndexedImpl(
     self = vmcast<ArrayImpl>(selfHandle.get());
     self->beginIndex_ = index;
     self->endIndex_ = index + 1;
+    self->numHoles_ = 1;
+    self->noteStore(HermesValue::encodeEmptyValue(), value.get());
   } else if (LLVM_UNLIKELY(
                  (index > endIndex && index - endIndex > shiftLimit) ||
                  (index < beginIndex && beginIndex - index > shiftLimit))) {
@@ -243,6 +322,8 @@ CallResult<bool> ArrayImpl::_setOwnIndexedImpl(
       return ExecutionStatus::EXCEPTION;
     }
     self = vmcast<ArrayImpl>(selfHandle.get());
+    self->noteNewEndIndex(runtime, index + 1);
+    self->noteStore(HermesValue::encodeEmptyValue(), value.get());
     self->endIndex_ = index + 1;
     indexedStorageHandle->at(index - beginIndex)
         .set(value.get(), &runtime->getHeap());
@@ -258,6 +339,8 @@ CallResult<bool> ArrayImpl::_setOwnIndexedImpl(
       return ExecutionStatus::EXCEPTION;
     }
     self = vmcast<ArrayImpl>(selfHandle.get());
+    self->numHoles_ += beginIndex - index;
+    self->noteStore(HermesValue::encodeEmptyValue(), value.get());
     self->beginIndex_ = index;
     indexedStorageHandle->at(0).set(value.get(), &runtime->getHeap());
   }
@@ -283,6 +366,7 @@ bool ArrayImpl::_deleteOwnIndexedImpl(
       if (!elem.isEmpty())
         return false;
 
+    self->noteStore(elem, HermesValue::encodeEmptyValue());
     elem.setNonPtr(HermesValue::encodeEmptyValue());
   }
 
@@ -462,6 +546,22 @@ CallResult<HermesValue> JSArray::create(
     Handle<HiddenClass> classHandle,
     size_type capacity,
     size_type length) {
+  return createImpl(
+      runtime,
+      prototypeHandle,
+      classHandle,
+      capacity,
+      length,
+      /* longLived */ false);
+}
+
+CallResult<HermesValue> JSArray::createImpl(
+    Runtime *runtime,
+    Handle<JSObject> prototypeHandle,
+    Handle<HiddenClass> classHandle,
+    size_type capacity,
+    size_type length,
+    bool longLived) {
   assert(length <= capacity && "length must be <= capacity");
 
   // Allocate property storage with size corresponding to number of properties
@@ -475,21 +575,36 @@ CallResult<HermesValue> JSArray::create(
   if (capacity) {
     if (LLVM_UNLIKELY(capacity > StorageType::maxElements()))
       return runtime->raiseRangeError("Out of memory for array elements");
-    auto arrRes = StorageType::create(runtime, capacity);
+    auto arrRes = longLived ? StorageType::createLongLived(runtime, capacity)
+                            : StorageType::create(runtime, capacity);
     if (arrRes == ExecutionStatus::EXCEPTION) {
       return ExecutionStatus::EXCEPTION;
     }
     indexedStorage = vmcast<StorageType>(*arrRes);
   }
 
-  void *mem = runtime->alloc(sizeof(JSArray));
-  JSArray *self = JSObject::allocateSmallPropStorage<JSArrayPropertyCount>(
-      new (mem) JSArray(
-          runtime,
-          *prototypeHandle,
-          *classHandle,
-          *indexedStorage,
-          GCPointerBase::NoBarriers()));
+  JSArray *self;
+  if (longLived) {
+    // The prototype, class and storage may be in the young gen, so the
+    // stores need barriers.
+    void *mem = runtime->allocLongLived(sizeof(JSArray));
+    self = JSObject::allocateSmallPropStorage<JSArrayPropertyCount>(
+        new (mem) JSArray(
+            runtime,
+            *prototypeHandle,
+            *classHandle,
+            *indexedStorage,
+            GCPointerBase::YesBarriers()));
+  } else {
+    void *mem = runtime->alloc(sizeof(JSArray));
+    self = JSObject::allocateSmallPropStorage<JSArrayPropertyCount>(
+        new (mem) JSArray(
+            runtime,
+            *prototypeHandle,
+            *classHandle,
+            *indexedStorage,
+            GCPointerBase::NoBarriers()));
+  }
 
   putLength(self, runtime, length);
 
@@ -509,6 +624,22 @@ JSArray::create(Runtime *runtime, size_type capacity, size_type length) {
   return PseudoHandle<JSArray>::create(vmcast<JSArray>(*res));
 }
 
+CallResult<PseudoHandle<JSArray>> JSArray::createLongLived(
+    Runtime *runtime,
+    size_type capacity,
+    size_type length) {
+  auto res = JSArray::createImpl(
+      runtime,
+      Handle<JSObject>::vmcast(&runtime->arrayPrototype),
+      Handle<HiddenClass>::vmcast(&runtime->arrayClass),
+      capacity,
+      length,
+      /* longLived */ true);
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  return PseudoHandle<JSArray>::create(vmcast<JSArray>(*res));
+}
+
 CallResult<bool> JSArray::setLength(
     Handle<JSArray> selfHandle,
     Runtime *runtime,
@@ -686,15 +817,28 @@ CallResult<HermesValue> JSArrayIterator::create(
   return HermesValue::encodeObjectValue(self);
 }
 
-/// Iterate to the next element and return.
 CallResult<HermesValue> JSArrayIterator::nextElement(
     Handle<JSArrayIterator> self,
     Runtime *runtime) {
-  if (!self->iteratedObject_) {
-    // 5. If a is undefined, return CreateIterResultObject(undefined, true).
+  auto valueRes = nextValue(self, runtime);
+  if (LLVM_UNLIKELY(valueRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (valueRes->isEmpty()) {
     return createIterResultObject(runtime, runtime->getUndefinedValue(), true)
         .getHermesValue();
   }
+  return createIterResultObject(runtime, runtime->makeHandle(*valueRes), false)
+      .getHermesValue();
+}
+
+CallResult<HermesValue> JSArrayIterator::nextValue(
+    Handle<JSArrayIterator> self,
+    Runtime *runtime) {
+  if (!self->iteratedObject_) {
+    // 5. If a is undefined, return CreateIterResultObject(undefined, true).
+    return HermesValue::encodeEmptyValue();
+  }
 
   // 4. Let a be the value of the [[IteratedObject]] internal slot of O.
   Handle<JSObject> a = runtime->makeHandle(self->iteratedObject_);
@@ -728,8 +872,7 @@ CallResult<HermesValue> JSArrayIterator::nextElement(
     // undefined.
     self->iteratedObject_ = nullptr;
     // b. Return CreateIterResultObject(undefined, true).
-    return createIterResultObject(runtime, runtime->getUndefinedValue(), true)
-        .getHermesValue();
+    return HermesValue::encodeEmptyValue();
   }
 
   // 11. Set the value of the [[ArrayIteratorNextIndex]] internal slot of O to
@@ -740,7 +883,7 @@ CallResult<HermesValue> JSArrayIterator::nextElement(
 
   if (self->iterationKind_ == IterationKind::Key) {
     // 12. If itemKind is "key", return CreateIterResultObject(index, false).
-    return createIterResultObject(runtime, indexHandle, false).getHermesValue();
+    return indexHandle.getHermesValue();
   }
 
   // 13. Let elementKey be ToString(index).
@@ -757,8 +900,7 @@ CallResult<HermesValue> JSArrayIterator::nextElement(
       return HermesValue::encodeEmptyValue();
     case IterationKind::Value:
       // 16. If itemKind is "value", let result be elementValue.
-      return createIterResultObject(runtime, valueHandle, false)
-          .getHermesValue();
+      return valueHandle.getHermesValue();
     case IterationKind::Entry:
       // 17. b. Let result be CreateArrayFromList(«index, elementValue»).
       auto resultRes = JSArray::create(runtime, 2, 2);
@@ -769,7 +911,7 @@ CallResult<HermesValue> JSArrayIterator::nextElement(
       JSArray::setElementAt(result, runtime, 0, indexHandle);
       JSArray::setElementAt(result, runtime, 1, valueHandle);
       // 18. Return CreateIterResultObject(result, false).
-      return createIterResultObject(runtime, result, false).getHermesValue();
+      return result.getHermesValue();
   }
 
   llvm_unreachable("Invalid iteration kind");
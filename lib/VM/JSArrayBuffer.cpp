@@ -105,7 +105,9 @@ JSArrayBuffer::JSArrayBuffer(
     : JSObject(runtime, &vt.base, parent, clazz),
       data_(nullptr),
       size_(0),
-      attached_(false) {}
+      attached_(false),
+      externalRelease_(nullptr),
+      externalContext_(nullptr) {}
 
 JSArrayBuffer::~JSArrayBuffer() {
   // We expect this finalizer to be called only by _finalizerImpl,
@@ -116,6 +118,24 @@ JSArrayBuffer::~JSArrayBuffer() {
 
 void JSArrayBuffer::_finalizeImpl(GCCell *cell, GC *gc) {
   auto *self = vmcast<JSArrayBuffer>(cell);
+  if (self->data_) {
+    // Only the accounting must be done during the collection: free the data,
+    // or hand it back to the host, after it.
+    gc->debitExternalMemory(self, self->size_);
+    gc->deferFinalization([data = self->data_,
+                           release = self->externalRelease_,
+                           context = self->externalContext_]() {
+      if (release) {
+        release(context, data);
+      } else {
+        free(data);
+      }
+    });
+    self->data_ = nullptr;
+    self->size_ = 0;
+    self->externalRelease_ = nullptr;
+    self->externalContext_ = nullptr;
+  }
   self->detach(gc);
   self->~JSArrayBuffer();
 }
@@ -128,7 +148,13 @@ size_t JSArrayBuffer::_mallocSizeImpl(GCCell *cell) {
 void JSArrayBuffer::detach(GC *gc) {
   if (data_) {
     gc->debitExternalMemory(this, size_);
-    free(data_);
+    if (externalRelease_) {
+      externalRelease_(externalContext_, data_);
+      externalRelease_ = nullptr;
+      externalContext_ = nullptr;
+    } else {
+      free(data_);
+    }
     data_ = nullptr;
     size_ = 0;
   } else {
@@ -171,5 +197,75 @@ JSArrayBuffer::createDataBlock(Runtime *runtime, size_type size, bool zero) {
   }
 }
 
+ExecutionStatus
+JSArrayBuffer::adoptDataBlock(Runtime *runtime, char *data, size_type size) {
+  detach(&runtime->getHeap());
+  if (LLVM_UNLIKELY(!runtime->getHeap().canAllocExternalMemory(size))) {
+    free(data);
+    return runtime->raiseRangeError(
+        "Cannot allocate a data block for the ArrayBuffer");
+  }
+  data_ = size ? data : nullptr;
+  size_ = size;
+  attached_ = true;
+  if (size) {
+    runtime->getHeap().creditExternalMemory(this, size);
+  } else {
+    free(data);
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+CallResult<std::pair<char *, JSArrayBuffer::size_type>>
+JSArrayBuffer::releaseDataBlock(Runtime *runtime) {
+  assert(attached() && "Cannot release the block of a detached ArrayBuffer");
+  std::pair<char *, size_type> block{data_, size_};
+  if (externalRelease_) {
+    block.first = static_cast<char *>(malloc(size_));
+    if (!block.first) {
+      return runtime->raiseRangeError(
+          "Cannot allocate a data block for the ArrayBuffer");
+    }
+    memcpy(block.first, data_, size_);
+    detach(&runtime->getHeap());
+    return block;
+  }
+  if (data_) {
+    runtime->getHeap().debitExternalMemory(this, size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  attached_ = false;
+  return block;
+}
+
+ExecutionStatus JSArrayBuffer::setExternalDataBlock(
+    Runtime *runtime,
+    char *data,
+    size_type size,
+    void *context,
+    ExternalReleaseCallback release) {
+  assert(release && "An external data block needs a release callback");
+  detach(&runtime->getHeap());
+  if (size == 0) {
+    // Nothing to hold on to, so hand the block back immediately.
+    release(context, data);
+    attached_ = true;
+    return ExecutionStatus::RETURNED;
+  }
+  if (LLVM_UNLIKELY(!runtime->getHeap().canAllocExternalMemory(size))) {
+    release(context, data);
+    return runtime->raiseRangeError(
+        "Cannot attach a data block of this size to the ArrayBuffer");
+  }
+  data_ = data;
+  size_ = size;
+  attached_ = true;
+  externalRelease_ = release;
+  externalContext_ = context;
+  runtime->getHeap().creditExternalMemory(this, size);
+  return ExecutionStatus::RETURNED;
+}
+
 } // namespace vm
 } // namespace hermes
@@ -33,7 +33,7 @@ ObjectVTable JSError::vt{
 void ErrorBuildMeta(const GCCell *cell, Metadata::Builder &mb) {
   ObjectBuildMeta(cell, mb);
   const auto *self = static_cast<const JSError *>(cell);
-  mb.addField("@funcNames", &self->funcNames_);
+  mb.addField("@callees", &self->callees_);
   mb.addField("@domains", &self->domains_);
 }
 
@@ -148,14 +148,14 @@ ExecutionStatus JSError::setMessage(
       .getStatus();
 }
 
-/// \return a list of function names associated with the call stack \p frames.
-/// Function names are read out of the 'name' property of each Callable on the
-/// stack, except that accessors are skipped. If a Callable does not have a
-/// name, or if the name is an accessor, undefined is set. Names are returned in
-/// reverse order (topmost frame is first).
+/// \return a list of the callees of the call stack, whose names are read when
+/// the stack trace is formatted. Callables are stored as they are, so that
+/// capturing the stack doesn't look up their 'name' property. Frames without a
+/// Callable store the name of their CodeBlock, or undefined. Callees are
+/// returned in reverse order (topmost frame is first).
 /// In case of error returns a nullptr handle.
 /// \param skipTopFrame if true, skip the top frame.
-static Handle<PropStorage> getCallStackFunctionNames(
+static Handle<PropStorage> getCallStackCallees(
     Runtime *runtime,
     bool skipTopFrame,
     size_t sizeHint) {
@@ -164,47 +164,39 @@ static Handle<PropStorage> getCallStackFunctionNames(
     runtime->clearThrownValue();
     return runtime->makeNullHandle<PropStorage>();
   }
-  MutableHandle<PropStorage> names{runtime, vmcast<PropStorage>(*arrRes)};
+  MutableHandle<PropStorage> callees{runtime, vmcast<PropStorage>(*arrRes)};
 
   GCScope gcScope(runtime);
-  MutableHandle<> name{runtime};
+  MutableHandle<> callee{runtime};
   auto marker = gcScope.createMarker();
 
   uint32_t frameIndex = 0;
-  uint32_t namesIndex = 0;
+  uint32_t calleesIndex = 0;
   for (StackFramePtr cf : runtime->getStackFrames()) {
     if (frameIndex++ == 0 && skipTopFrame)
       continue;
 
-    name = HermesValue::encodeUndefinedValue();
-    if (auto callableHandle = Handle<Callable>::dyn_vmcast(
-            runtime, Handle<>(&cf.getCalleeClosureOrCBRef()))) {
-      NamedPropertyDescriptor desc;
-      JSObject *propObj = JSObject::getNamedDescriptor(
-          callableHandle,
-          runtime,
-          Predefined::getSymbolID(Predefined::name),
-          desc);
-      if (propObj && !desc.flags.accessor)
-        name = JSObject::getNamedSlotValue(propObj, runtime, desc);
+    callee = HermesValue::encodeUndefinedValue();
+    if (vmisa<Callable>(cf.getCalleeClosureOrCBRef())) {
+      callee = cf.getCalleeClosureOrCBRef();
     } else if (cf.getCalleeClosureOrCBRef().isNativeValue()) {
       auto *cb =
           cf.getCalleeClosureOrCBRef().getNativePointer<const CodeBlock>();
       if (cb->getNameMayAllocate().isValid())
-        name = HermesValue::encodeStringValue(
+        callee = HermesValue::encodeStringValue(
             runtime->getStringPrimFromSymbolID(cb->getNameMayAllocate()));
     }
-    if (PropStorage::resize(names, runtime, namesIndex + 1) ==
+    if (PropStorage::resize(callees, runtime, calleesIndex + 1) ==
         ExecutionStatus::EXCEPTION) {
       runtime->clearThrownValue();
       return runtime->makeNullHandle<PropStorage>();
     }
-    names->at(namesIndex).set(name.getHermesValue(), &runtime->getHeap());
-    ++namesIndex;
+    callees->at(calleesIndex).set(callee.getHermesValue(), &runtime->getHeap());
+    ++calleesIndex;
     gcScope.flushToMarker(marker);
   }
 
-  return std::move(names);
+  return std::move(callees);
 }
 
 ExecutionStatus JSError::recordStackTrace(
@@ -279,16 +271,15 @@ ExecutionStatus JSError::recordStackTrace(
   // Remove the last entry.
   stack->pop_back();
 
-  auto funcNames =
-      getCallStackFunctionNames(runtime, skipTopFrame, stack->size());
+  auto callees = getCallStackCallees(runtime, skipTopFrame, stack->size());
 
-  // Either the function names is empty, or they have the same count.
+  // Either the callees are empty, or they have the same count.
   assert(
-      (!funcNames || funcNames->size() == stack->size()) &&
-      "Function names and stack trace must have same size.");
+      (!callees || callees->size() == stack->size()) &&
+      "Callees and stack trace must have same size.");
 
   selfHandle->stacktrace_ = std::move(stack);
-  selfHandle->funcNames_.set(runtime, *funcNames, &runtime->getHeap());
+  selfHandle->callees_.set(runtime, *callees, &runtime->getHeap());
   return ExecutionStatus::RETURNED;
 }
 
@@ -316,13 +307,27 @@ bool JSError::appendFunctionNameAtIndex(
   MutableHandle<StringPrimitive> name{
       runtime, runtime->getPredefinedString(Predefined::emptyString)};
 
-  // If funcNames_ is set and contains a string primitive, use that.
-  if (selfHandle->funcNames_) {
+  // If callees_ is set, use the 'name' property of the Callable, unless it is
+  // an accessor, or the name stored instead of it, if they are strings.
+  if (selfHandle->callees_) {
     assert(
-        index < selfHandle->funcNames_.get(runtime)->size() &&
+        index < selfHandle->callees_.get(runtime)->size() &&
         "Index out of bounds");
-    name = dyn_vmcast<StringPrimitive>(
-        selfHandle->funcNames_.get(runtime)->at(index));
+    Handle<> callee =
+        runtime->makeHandle(selfHandle->callees_.get(runtime)->at(index));
+    name = dyn_vmcast<StringPrimitive>(*callee);
+    if (auto callableHandle = Handle<Callable>::dyn_vmcast(runtime, callee)) {
+      NamedPropertyDescriptor desc;
+      JSObject *propObj = JSObject::getNamedDescriptor(
+          callableHandle,
+          runtime,
+          Predefined::getSymbolID(Predefined::name),
+          desc);
+      name = propObj && !desc.flags.accessor
+          ? dyn_vmcast<StringPrimitive>(
+                JSObject::getNamedSlotValue(propObj, runtime, desc))
+          : nullptr;
+    }
   }
 
   if (!name || name->getStringLength() == 0) {
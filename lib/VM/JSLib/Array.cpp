@@ -11,6 +11,7 @@
 #include "JSLibInternal.h"
 #include "Sorting.h"
 
+#include "hermes/Support/Conversions.h"
 #include "hermes/VM/Operations.h"
 #include "hermes/VM/StringBuilder.h"
 #include "hermes/VM/StringRefUtils.h"
@@ -839,6 +840,15 @@ arrayPrototypeConcat(void *, Runtime *runtime, NativeArgs args) {
         }
       }
 
+      if (LLVM_LIKELY(arrHandle) && JSArray::isPacked(*arrHandle) &&
+          n + len <= A->getEndIndex()) {
+        // Fast path: no element is missing, so they are copied in bulk.
+        JSArray::unsafeCopyExistingElements(
+            A.get(), runtime, n, *arrHandle, 0, len);
+        n += len;
+        continue;
+      }
+
       // Note that we must increase n every iteration even if nothing was
       // appended to the result array.
       // 7.d.v. Repeat, while k < len
@@ -1088,6 +1098,61 @@ arrayPrototypeCopyWithin(void *, Runtime *runtime, NativeArgs args) {
   return O.getHermesValue();
 }
 
+/// Join the first \p len elements of the packed array \p arr with \p sep, if
+/// they are all strings or numbers, which are converted without allocating.
+/// The length of the result is computed by a first pass, so that it is
+/// allocated once, as an ASCII string if every part is ASCII, and the second
+/// pass copies the parts into it.
+/// \return the joined string, or empty if an element has another type, in
+///   which case nothing was done.
+static CallResult<HermesValue> joinPackedArray(
+    Runtime *runtime,
+    Handle<JSArray> arr,
+    uint32_t len,
+    Handle<StringPrimitive> sep) {
+  assert(
+      JSArray::isPacked(*arr) && len <= JSArray::getLength(*arr) &&
+      "array must be packed");
+  char buf[NUMBER_TO_STRING_BUF_SIZE];
+  SafeUInt32 size;
+  bool isASCII = sep->isASCII();
+  for (uint32_t i = 0; i < len; ++i) {
+    if (i)
+      size.add(sep->getStringLength());
+    HermesValue elem = arr->at(runtime, i);
+    if (elem.isString()) {
+      size.add(elem.getString()->getStringLength());
+      isASCII = isASCII && elem.getString()->isASCII();
+    } else if (elem.isNumber()) {
+      size.add(numberToString(elem.getNumber(), buf, sizeof(buf)));
+    } else {
+      return HermesValue::encodeEmptyValue();
+    }
+    if (size.isOverflowed()) {
+      return runtime->raiseRangeError("String is too long");
+    }
+  }
+
+  auto builder = StringBuilder::createStringBuilder(runtime, size, isASCII);
+  if (builder == ExecutionStatus::EXCEPTION) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  MutableHandle<StringPrimitive> element{runtime};
+  for (uint32_t i = 0; i < len; ++i) {
+    if (i)
+      builder->appendStringPrim(sep);
+    HermesValue elem = arr->at(runtime, i);
+    if (elem.isString()) {
+      element = elem.getString();
+      builder->appendStringPrim(element);
+    } else {
+      builder->appendASCIIRef(
+          ASCIIRef(buf, numberToString(elem.getNumber(), buf, sizeof(buf))));
+    }
+  }
+  return HermesValue::encodeStringValue(*builder->getStringPrimitive());
+}
+
 /// ES5.1 15.4.4.5.
 static CallResult<HermesValue>
 arrayPrototypeJoin(void *, Runtime *runtime, NativeArgs args) {
@@ -1133,6 +1198,20 @@ arrayPrototypeJoin(void *, Runtime *runtime, NativeArgs args) {
         runtime->getPredefinedString(Predefined::emptyString));
   }
 
+  // Fast path: the elements of a packed array are read directly, as long as
+  // converting the separator didn't shrink it.
+  if (auto arr = Handle<JSArray>::dyn_vmcast(runtime, O)) {
+    if (JSArray::isPacked(*arr) && JSArray::getLength(*arr) >= len) {
+      auto joinRes = joinPackedArray(runtime, arr, len, sep);
+      if (LLVM_UNLIKELY(joinRes == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      if (!joinRes->isEmpty()) {
+        return *joinRes;
+      }
+    }
+  }
+
   // Track the size of the resultant string. Use a 64-bit value to detect
   // overflow.
   SafeUInt32 size;
@@ -1882,6 +1961,171 @@ class StandardSortModel : public SortModel {
 };
 } // anonymous namespace
 
+/// Sort the elements [0, \p len) of the packed array \p arr in the \p order
+/// of a recognized compare function, without calling it.
+/// \return false if some element isn't a number, or is NaN, for which the
+///   compare function doesn't define an order, in which case nothing was done.
+static bool sortDenseNumbers(
+    Runtime *runtime,
+    Handle<JSArray> arr,
+    uint32_t len,
+    NumericCompareFn order) {
+  std::vector<double> values;
+  values.reserve(len);
+  for (uint32_t i = 0; i < len; ++i) {
+    HermesValue value = arr->at(runtime, i);
+    if (!value.isNumber() || std::isnan(value.getNumber())) {
+      return false;
+    }
+    values.push_back(value.getNumber());
+  }
+  // The compare function considers -0 and +0 equal, so the sort must be
+  // stable to keep them in order.
+  if (order == NumericCompareFn::Ascending) {
+    std::stable_sort(values.begin(), values.end(), std::less<double>());
+  } else {
+    std::stable_sort(values.begin(), values.end(), std::greater<double>());
+  }
+  for (uint32_t i = 0; i < len; ++i) {
+    JSArray::unsafeSetExistingElementAt(
+        arr.get(), runtime, i, HermesValue::encodeNumberValue(values[i]));
+  }
+  return true;
+}
+
+/// Sort the elements [0, \p len) of \p O with a stable TimSort over a copy of
+/// them, and write them back once, if \p O is an array which has all of them
+/// in its indexed storage.
+/// Without \p compareFn, the elements must also all be primitives other than
+/// symbols, whose strings are then computed once instead of for every
+/// comparison. With a \p compareFn that just subtracts its arguments, arrays
+/// of numbers are sorted without calling it.
+/// \return false if \p O doesn't qualify, in which case nothing was done.
+static CallResult<bool> sortDenseArray(
+    Runtime *runtime,
+    Handle<JSObject> O,
+    uint64_t len,
+    Handle<Callable> compareFn) {
+  auto arr = Handle<JSArray>::dyn_vmcast(runtime, O);
+  if (!arr || !JSArray::isPacked(arr.get()) || !arr->isExtensible() ||
+      len > arr->getEndIndex()) {
+    return false;
+  }
+  if (compareFn) {
+    NumericCompareFn order =
+        recognizeNumericCompareFn(runtime, compareFn.get());
+    if (order != NumericCompareFn::None &&
+        sortDenseNumbers(runtime, arr, len, order)) {
+      return true;
+    }
+  }
+  if (!compareFn && !arr->hasOnlyNumbers()) {
+    for (uint32_t i = 0; i < len; ++i) {
+      HermesValue value = arr->at(runtime, i);
+      if (value.isObject() || value.isSymbol()) {
+        return false;
+      }
+    }
+  }
+
+  GCScope gcScope(runtime);
+  auto valuesRes = ArrayStorage::create(runtime, len, len);
+  if (LLVM_UNLIKELY(valuesRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  auto values = runtime->makeHandle<ArrayStorage>(*valuesRes);
+  // The indices of the elements which aren't undefined. Undefined is greater
+  // than everything, so those are the only ones that are compared.
+  std::vector<uint32_t> order;
+  for (uint32_t i = 0; i < len; ++i) {
+    HermesValue value = arr->at(runtime, i);
+    values->at(i).set(value, &runtime->getHeap());
+    if (!value.isUndefined()) {
+      order.push_back(i);
+    }
+  }
+
+  // The strings the elements are compared by, without compareFn.
+  MutableHandle<ArrayStorage> keys{runtime};
+  MutableHandle<> tmpHandle{runtime};
+  auto marker = gcScope.createMarker();
+  if (!compareFn) {
+    auto keysRes = ArrayStorage::create(runtime, len, len);
+    if (LLVM_UNLIKELY(keysRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    keys = vmcast<ArrayStorage>(*keysRes);
+    for (uint32_t i : order) {
+      gcScope.flushToMarker(marker);
+      tmpHandle = values->at(i);
+      auto strRes = toString_RJS(runtime, tmpHandle);
+      if (LLVM_UNLIKELY(strRes == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      keys->at(i).set(strRes->getHermesValue(), &runtime->getHeap());
+    }
+  }
+
+  llvm::Optional<RepeatedCall> compare;
+  if (compareFn)
+    compare.emplace(runtime, compareFn, runtime->getUndefinedValue(), 2);
+  auto less = [&](uint32_t a, uint32_t b) -> CallResult<bool> {
+    if (!compareFn) {
+      return keys->at(a).getString()->compare(keys->at(b).getString()) < 0;
+    }
+    GCScopeMarkerRAII gcMarker{gcScope, marker};
+    auto callRes = compare->call(values->at(a), values->at(b));
+    if (LLVM_UNLIKELY(callRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    auto intRes = toNumber_RJS(runtime, runtime->makeHandle(*callRes));
+    if (LLVM_UNLIKELY(intRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    return intRes->getNumber() < 0;
+  };
+  if (LLVM_UNLIKELY(timSort(order, less) == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+
+  // Fast path: compareFn didn't change the array, so the elements can be
+  // written directly.
+  if (LLVM_LIKELY(
+          arr->hasFastIndexProperties() && arr->isExtensible() &&
+          arr->getBeginIndex() == 0 && len <= arr->getEndIndex())) {
+    uint32_t k = 0;
+    for (uint32_t i : order) {
+      JSArray::unsafeSetExistingElementAt(
+          arr.get(), runtime, k++, values->at(i));
+    }
+    for (; k < len; ++k) {
+      JSArray::unsafeSetExistingElementAt(
+          arr.get(), runtime, k, HermesValue::encodeUndefinedValue());
+    }
+    return true;
+  }
+
+  MutableHandle<> kHandle{runtime};
+  auto writeMarker = gcScope.createMarker();
+  for (uint32_t k = 0; k < len; ++k) {
+    gcScope.flushToMarker(writeMarker);
+    kHandle = HermesValue::encodeNumberValue(k);
+    tmpHandle = k < order.size() ? values->at(order[k])
+                                 : HermesValue::encodeUndefinedValue();
+    if (LLVM_UNLIKELY(
+            JSObject::putComputed_RJS(
+                O,
+                runtime,
+                kHandle,
+                tmpHandle,
+                PropOpFlags().plusThrowOnError()) ==
+            ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+  }
+  return true;
+}
+
 /// ES5.1 15.4.4.11.
 static CallResult<HermesValue>
 arrayPrototypeSort(void *, Runtime *runtime, NativeArgs args) {
@@ -1909,6 +2153,14 @@ arrayPrototypeSort(void *, Runtime *runtime, NativeArgs args) {
   }
   uint64_t len = *intRes;
 
+  auto sortedRes = sortDenseArray(runtime, O, len, compareFn);
+  if (LLVM_UNLIKELY(sortedRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (*sortedRes) {
+    return O.getHermesValue();
+  }
+
   StandardSortModel sm(runtime, O, compareFn);
 
   // Use our custom sort routine. We can't use std::sort because it performs
@@ -2407,6 +2659,54 @@ arrayPrototypeLastIndexOf(void *, Runtime *runtime, NativeArgs args) {
   return indexOfHelper(runtime, args, true);
 }
 
+/// \return ToLength(Get(O, "length")) for \p O, which is read directly if
+/// \p O is an array.
+static CallResult<uint64_t> getArrayLikeLength(
+    Runtime *runtime,
+    Handle<JSObject> O) {
+  if (auto *arr = dyn_vmcast<JSArray>(O.get())) {
+    // Fast path: the length of an array is always an own data property.
+    return JSArray::getLength(arr);
+  }
+  auto propRes = JSObject::getNamed_RJS(
+      O, runtime, Predefined::getSymbolID(Predefined::length));
+  if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  return toLengthU64(runtime, runtime->makeHandle(*propRes));
+}
+
+/// Get the element at index \p k of \p O, for the methods which iterate over
+/// an array and skip the indices it doesn't have.
+/// Elements in the indexed storage of an array are read directly. Holes, and
+/// arrays with index-like named properties such as getters, fall back to the
+/// generic lookup along the prototype chain, using \p descObjHandle.
+/// The storage is read again for every index, so this also works when the
+/// callback changes the array.
+/// \return the element, or an empty value if \p O has no property \p k.
+static CallResult<HermesValue> getElementIfPresent(
+    Runtime *runtime,
+    Handle<JSObject> O,
+    Handle<> k,
+    MutableHandle<JSObject> &descObjHandle) {
+  auto *arr = dyn_vmcast<JSArray>(O.get());
+  if (LLVM_LIKELY(arr && arr->hasFastIndexProperties())) {
+    // Fast path: k is a valid array index, since it is less than the length
+    // of some array.
+    HermesValue value = arr->at(runtime, (uint32_t)k->getNumber());
+    if (LLVM_LIKELY(!value.isEmpty())) {
+      return value;
+    }
+  }
+
+  ComputedPropertyDescriptor desc;
+  JSObject::getComputedPrimitiveDescriptor(O, runtime, k, descObjHandle, desc);
+  if (!descObjHandle) {
+    return HermesValue::encodeEmptyValue();
+  }
+  return JSObject::getComputedPropertyValue(O, runtime, descObjHandle, desc);
+}
+
 /// Helper function for every/some.
 /// \param every true if calling every(), false if calling some().
 static inline CallResult<HermesValue>
@@ -2418,12 +2718,7 @@ everySomeHelper(Runtime *runtime, NativeArgs args, const bool every) {
   }
   auto O = runtime->makeHandle<JSObject>(objRes.getValue());
 
-  auto propRes = JSObject::getNamed_RJS(
-      O, runtime, Predefined::getSymbolID(Predefined::length));
-  if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
-    return ExecutionStatus::EXCEPTION;
-  }
-  auto intRes = toLengthU64(runtime, runtime->makeHandle(*propRes));
+  auto intRes = getArrayLikeLength(runtime, O);
   if (LLVM_UNLIKELY(intRes == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
@@ -2442,30 +2737,22 @@ everySomeHelper(Runtime *runtime, NativeArgs args, const bool every) {
   MutableHandle<JSObject> descObjHandle{runtime};
   MutableHandle<> kValue{runtime};
 
+  RepeatedCall callback{runtime, callbackFn, args.getArgHandle(runtime, 1), 3};
+
   // Loop through and run the callback.
   auto marker = gcScope.createMarker();
   while (k->getDouble() < len) {
     gcScope.flushToMarker(marker);
 
-    ComputedPropertyDescriptor desc;
-    JSObject::getComputedPrimitiveDescriptor(
-        O, runtime, k, descObjHandle, desc);
+    auto propRes = getElementIfPresent(runtime, O, k, descObjHandle);
+    if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
 
-    if (descObjHandle) {
+    if (!propRes->isEmpty()) {
       // kPresent is true, call the callback on the kth element.
-      if ((propRes = JSObject::getComputedPropertyValue(
-               O, runtime, descObjHandle, desc)) ==
-          ExecutionStatus::EXCEPTION) {
-        return ExecutionStatus::EXCEPTION;
-      }
       kValue = propRes.getValue();
-      auto callRes = Callable::executeCall3(
-          callbackFn,
-          runtime,
-          args.getArgHandle(runtime, 1),
-          kValue.get(),
-          k.get(),
-          O.getHermesValue());
+      auto callRes = callback.call(kValue.get(), k.get(), O.getHermesValue());
       if (LLVM_UNLIKELY(callRes == ExecutionStatus::EXCEPTION)) {
         return ExecutionStatus::EXCEPTION;
       }
@@ -2510,12 +2797,7 @@ arrayPrototypeForEach(void *, Runtime *runtime, NativeArgs args) {
   }
   auto O = runtime->makeHandle<JSObject>(objRes.getValue());
 
-  auto propRes = JSObject::getNamed_RJS(
-      O, runtime, Predefined::getSymbolID(Predefined::length));
-  if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
-    return ExecutionStatus::EXCEPTION;
-  }
-  auto intRes = toLengthU64(runtime, runtime->makeHandle(*propRes));
+  auto intRes = getArrayLikeLength(runtime, O);
   if (LLVM_UNLIKELY(intRes == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
@@ -2532,32 +2814,24 @@ arrayPrototypeForEach(void *, Runtime *runtime, NativeArgs args) {
 
   MutableHandle<JSObject> descObjHandle{runtime};
 
+  RepeatedCall callback{runtime, callbackFn, args.getArgHandle(runtime, 1), 3};
+
   // Loop through and execute the callback on all existing values.
-  // TODO: Implement a fast path for actual arrays.
   auto marker = gcScope.createMarker();
   while (k->getDouble() < len) {
     gcScope.flushToMarker(marker);
 
-    ComputedPropertyDescriptor desc;
-    JSObject::getComputedPrimitiveDescriptor(
-        O, runtime, k, descObjHandle, desc);
+    auto propRes = getElementIfPresent(runtime, O, k, descObjHandle);
+    if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
 
-    if (descObjHandle) {
+    if (!propRes->isEmpty()) {
       // kPresent is true, execute callback.
-      if ((propRes = JSObject::getComputedPropertyValue(
-               O, runtime, descObjHandle, desc)) ==
-          ExecutionStatus::EXCEPTION) {
-        return ExecutionStatus::EXCEPTION;
-      }
       auto kValue = propRes.getValue();
       if (LLVM_UNLIKELY(
-              Callable::executeCall3(
-                  callbackFn,
-                  runtime,
-                  args.getArgHandle(runtime, 1),
-                  kValue,
-                  k.get(),
-                  O.getHermesValue()) == ExecutionStatus::EXCEPTION)) {
+              callback.call(kValue, k.get(), O.getHermesValue()) ==
+              ExecutionStatus::EXCEPTION)) {
         return ExecutionStatus::EXCEPTION;
       }
     }
@@ -2577,12 +2851,7 @@ arrayPrototypeMap(void *, Runtime *runtime, NativeArgs args) {
   }
   auto O = runtime->makeHandle<JSObject>(objRes.getValue());
 
-  auto propRes = JSObject::getNamed_RJS(
-      O, runtime, Predefined::getSymbolID(Predefined::length));
-  if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
-    return ExecutionStatus::EXCEPTION;
-  }
-  auto intRes = toLengthU64(runtime, runtime->makeHandle(*propRes));
+  auto intRes = getArrayLikeLength(runtime, O);
   if (LLVM_UNLIKELY(intRes == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
@@ -2603,42 +2872,42 @@ arrayPrototypeMap(void *, Runtime *runtime, NativeArgs args) {
     return ExecutionStatus::EXCEPTION;
   }
   auto A = toHandle(runtime, std::move(*arrRes));
+  // Allocate all of A's elements up front, so they can be set directly. The
+  // indices the callback isn't called on are left empty.
+  if (LLVM_UNLIKELY(
+          JSArray::setStorageEndIndex(A, runtime, len) ==
+          ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
 
   // Current index to execute callback on.
   MutableHandle<> k{runtime, HermesValue::encodeDoubleValue(0)};
 
   MutableHandle<JSObject> descObjHandle{runtime};
 
+  RepeatedCall callback{runtime, callbackFn, args.getArgHandle(runtime, 1), 3};
+
   // Main loop to execute callback and store the results in A.
-  // TODO: Implement a fast path for actual arrays.
   auto marker = gcScope.createMarker();
   while (k->getDouble() < len) {
     gcScope.flushToMarker(marker);
 
-    ComputedPropertyDescriptor desc;
-    JSObject::getComputedPrimitiveDescriptor(
-        O, runtime, k, descObjHandle, desc);
+    auto propRes = getElementIfPresent(runtime, O, k, descObjHandle);
+    if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
 
-    if (descObjHandle) {
+    if (!propRes->isEmpty()) {
       // kPresent is true, execute callback and store result in A[k].
-      if ((propRes = JSObject::getComputedPropertyValue(
-               O, runtime, descObjHandle, desc)) ==
-          ExecutionStatus::EXCEPTION) {
-        return ExecutionStatus::EXCEPTION;
-      }
       auto kValue = propRes.getValue();
-      auto callRes = Callable::executeCall3(
-          callbackFn,
-          runtime,
-          args.getArgHandle(runtime, 1),
-          kValue,
-          k.get(),
-          O.getHermesValue());
+      auto callRes = callback.call(kValue, k.get(), O.getHermesValue());
       if (LLVM_UNLIKELY(callRes == ExecutionStatus::EXCEPTION)) {
         return ExecutionStatus::EXCEPTION;
       }
-      JSArray::setElementAt(
-          A, runtime, k->getDouble(), runtime->makeHandle(*callRes));
+      // A is not reachable from the callback, so its storage can't have
+      // changed.
+      JSArray::unsafeSetExistingElementAt(
+          A.get(), runtime, (uint32_t)k->getDouble(), *callRes);
     }
 
     k = HermesValue::encodeDoubleValue(k->getDouble() + 1);
@@ -2656,12 +2925,7 @@ arrayPrototypeFilter(void *, Runtime *runtime, NativeArgs args) {
   }
   auto O = runtime->makeHandle<JSObject>(objRes.getValue());
 
-  auto propRes = JSObject::getNamed_RJS(
-      O, runtime, Predefined::getSymbolID(Predefined::length));
-  if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
-    return ExecutionStatus::EXCEPTION;
-  }
-  auto intRes = toLengthU64(runtime, runtime->makeHandle(*propRes));
+  auto intRes = getArrayLikeLength(runtime, O);
   if (LLVM_UNLIKELY(intRes == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
@@ -2691,30 +2955,22 @@ arrayPrototypeFilter(void *, Runtime *runtime, NativeArgs args) {
   MutableHandle<JSObject> descObjHandle{runtime};
   MutableHandle<> kValue{runtime};
 
+  RepeatedCall callback{runtime, callbackFn, args.getArgHandle(runtime, 1), 3};
+
   auto marker = gcScope.createMarker();
   while (k->getDouble() < len) {
     gcScope.flushToMarker(marker);
 
-    ComputedPropertyDescriptor desc;
-    JSObject::getComputedPrimitiveDescriptor(
-        O, runtime, k, descObjHandle, desc);
+    auto propRes = getElementIfPresent(runtime, O, k, descObjHandle);
+    if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
 
-    if (descObjHandle) {
+    if (!propRes->isEmpty()) {
       // kPresent is true
-      if ((propRes = JSObject::getComputedPropertyValue(
-               O, runtime, descObjHandle, desc)) ==
-          ExecutionStatus::EXCEPTION) {
-        return ExecutionStatus::EXCEPTION;
-      }
       kValue = propRes.getValue();
       // Call the callback.
-      auto callRes = Callable::executeCall3(
-          callbackFn,
-          runtime,
-          args.getArgHandle(runtime, 1),
-          kValue.get(),
-          k.get(),
-          O.getHermesValue());
+      auto callRes = callback.call(kValue.get(), k.get(), O.getHermesValue());
       if (LLVM_UNLIKELY(callRes == ExecutionStatus::EXCEPTION)) {
         return ExecutionStatus::EXCEPTION;
       }
@@ -2827,6 +3083,7 @@ arrayPrototypeFind(void *ctx, Runtime *runtime, NativeArgs args) {
 
   MutableHandle<> kHandle{runtime, HermesValue::encodeNumberValue(0)};
   MutableHandle<> kValue{runtime};
+  RepeatedCall callback{runtime, predicate, T, 3};
   auto marker = gcScope.createMarker();
   while (kHandle->getNumber() < len) {
     gcScope.flushToMarker(marker);
@@ -2836,10 +3093,7 @@ arrayPrototypeFind(void *ctx, Runtime *runtime, NativeArgs args) {
       return ExecutionStatus::EXCEPTION;
     }
     kValue = *propRes;
-    auto callRes = Callable::executeCall3(
-        predicate,
-        runtime,
-        T,
+    auto callRes = callback.call(
         kValue.getHermesValue(),
         kHandle.getHermesValue(),
         O.getHermesValue());
@@ -2872,12 +3126,7 @@ reduceHelper(Runtime *runtime, NativeArgs args, const bool reverse) {
   }
   auto O = runtime->makeHandle<JSObject>(objRes.getValue());
 
-  auto propRes = JSObject::getNamed_RJS(
-      O, runtime, Predefined::getSymbolID(Predefined::length));
-  if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
-    return ExecutionStatus::EXCEPTION;
-  }
-  auto intRes = toLengthU64(runtime, runtime->makeHandle(*propRes));
+  auto intRes = getArrayLikeLength(runtime, O);
   if (LLVM_UNLIKELY(intRes == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
@@ -2926,16 +3175,12 @@ reduceHelper(Runtime *runtime, NativeArgs args, const bool reverse) {
           break;
         }
       }
-      ComputedPropertyDescriptor kDesc;
-      JSObject::getComputedPrimitiveDescriptor(
-          O, runtime, k, kDescObjHandle, kDesc);
-      kPresent = !!kDescObjHandle;
+      auto propRes = getElementIfPresent(runtime, O, k, kDescObjHandle);
+      if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      kPresent = !propRes->isEmpty();
       if (kPresent) {
-        if ((propRes = JSObject::getComputedPropertyValue(
-                 O, runtime, kDescObjHandle, kDesc)) ==
-            ExecutionStatus::EXCEPTION) {
-          return ExecutionStatus::EXCEPTION;
-        }
         accumulator = propRes.getValue();
       }
       k = HermesValue::encodeDoubleValue(k->getDouble() + increment);
@@ -2946,6 +3191,8 @@ reduceHelper(Runtime *runtime, NativeArgs args, const bool reverse) {
     }
   }
 
+  RepeatedCall callback{runtime, callbackFn, runtime->getUndefinedValue(), 4};
+
   // Perform the reduce.
   while (true) {
     gcScope.flushToMarker(marker);
@@ -2959,25 +3206,15 @@ reduceHelper(Runtime *runtime, NativeArgs args, const bool reverse) {
       }
     }
 
-    ComputedPropertyDescriptor kDesc;
-    JSObject::getComputedPrimitiveDescriptor(
-        O, runtime, k, kDescObjHandle, kDesc);
-    if (kDescObjHandle) {
+    auto propRes = getElementIfPresent(runtime, O, k, kDescObjHandle);
+    if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    if (!propRes->isEmpty()) {
       // kPresent is true, run the accumulation step.
-      if ((propRes = JSObject::getComputedPropertyValue(
-               O, runtime, kDescObjHandle, kDesc)) ==
-          ExecutionStatus::EXCEPTION) {
-        return ExecutionStatus::EXCEPTION;
-      }
       auto kValue = propRes.getValue();
-      auto callRes = Callable::executeCall4(
-          callbackFn,
-          runtime,
-          runtime->getUndefinedValue(),
-          accumulator.get(),
-          kValue,
-          k.get(),
-          O.getHermesValue());
+      auto callRes = callback.call(
+          accumulator.get(), kValue, k.get(), O.getHermesValue());
       if (LLVM_UNLIKELY(callRes == ExecutionStatus::EXCEPTION)) {
         return ExecutionStatus::EXCEPTION;
       }
@@ -113,6 +113,51 @@ dataViewPrototypeSet(void *, Runtime *runtime, NativeArgs args) {
 
 /// @}
 
+/// \return true if \p arg is the byte offset of a \p size bytes access
+/// within \p self, which is attached, as an integer number which ToIndex()
+/// would leave as it is, and set \p offset to it.
+bool getInlineByteOffset(
+    Runtime *runtime,
+    JSDataView *self,
+    HermesValue arg,
+    size_t size,
+    JSDataView::size_type &offset) {
+  if (LLVM_UNLIKELY(!arg.isNumber()))
+    return false;
+  double num = arg.getNumber();
+  // Also rejects NaN.
+  if (LLVM_UNLIKELY(!(num >= 0 && num + size <= self->byteLength())))
+    return false;
+  offset = (JSDataView::size_type)num;
+  return offset == num && self->attached(runtime);
+}
+
+template <typename T>
+OptValue<HermesValue>
+dataViewGetInline(Runtime *runtime, JSDataView *self, NativeArgs args) {
+  JSDataView::size_type offset;
+  if (!getInlineByteOffset(runtime, self, args.getArg(0), sizeof(T), offset))
+    return llvm::None;
+  return SafeNumericEncoder<T>::encode(
+      self->get<T>(runtime, offset, toBoolean(args.getArg(1))));
+}
+
+template <typename T, CellKind C>
+OptValue<HermesValue>
+dataViewSetInline(Runtime *runtime, JSDataView *self, NativeArgs args) {
+  JSDataView::size_type offset;
+  HermesValue value = args.getArg(1);
+  if (!value.isNumber() ||
+      !getInlineByteOffset(runtime, self, args.getArg(0), sizeof(T), offset))
+    return llvm::None;
+  self->set<T>(
+      runtime,
+      offset,
+      JSTypedArray<T, C>::toDestType(value.getNumber()),
+      toBoolean(args.getArg(2)));
+  return HermesValue::encodeUndefinedValue();
+}
+
 // ES 2018 24.3.2.1
 CallResult<HermesValue>
 dataViewConstructor(void *, Runtime *runtime, NativeArgs args) {
@@ -175,6 +220,25 @@ dataViewConstructor(void *, Runtime *runtime, NativeArgs args) {
 
 } // namespace
 
+OptValue<HermesValue> tryDataViewAccessInline(
+    Runtime *runtime,
+    NativeFunction *native,
+    NativeArgs args) {
+  auto *self = dyn_vmcast<JSDataView>(args.getThisArg());
+  if (!self || args.isConstructorCall())
+    return llvm::None;
+  NativeFunctionPtr functionPtr = native->getFunctionPtr();
+#define TYPED_ARRAY(name, type)                                            \
+  if (functionPtr == dataViewPrototypeGet<type>)                           \
+    return dataViewGetInline<type>(runtime, self, args);                   \
+  if (functionPtr == dataViewPrototypeSet<type, CellKind::name##ArrayKind>) \
+    return dataViewSetInline<type, CellKind::name##ArrayKind>(             \
+        runtime, self, args);
+#define TYPED_ARRAY_NO_CLAMP
+#include "hermes/VM/TypedArrays.def"
+  return llvm::None;
+}
+
 Handle<JSObject> createDataViewConstructor(Runtime *runtime) {
   auto proto = Handle<JSObject>::vmcast(&runtime->dataViewPrototype);
   auto cons = defineSystemConstructor<JSDataView>(
@@ -522,7 +522,7 @@ dateConstructor(void *, Runtime *runtime, NativeArgs args) {
       // makeTimeFromArgs interprets arguments as UTC.
       // We want them as local time, so pretend that they are,
       // and call utcTime to get the final UTC value we want to store.
-      finalDate = timeClip(utcTime(*cr));
+      finalDate = timeClip(runtime->getLocalTimeCache().utcTime(*cr));
     }
 
     JSDate::setPrimitiveValue(
@@ -538,7 +538,7 @@ dateConstructor(void *, Runtime *runtime, NativeArgs args) {
   } else {
 #endif
     double t = curTime();
-    double local = localTime(t);
+    double local = runtime->getLocalTimeCache().localTime(t);
     datetimeToUTCString(local, local - t, str);
 #ifdef HERMESVM_SYNTH_REPLAY
   }
@@ -620,7 +620,7 @@ datePrototypeToStringHelper(void *ctx, Runtime *runtime, NativeArgs args) {
   }
   llvm::SmallString<32> str{};
   if (!opts->isUTC) {
-    double local = localTime(t);
+    double local = runtime->getLocalTimeCache().localTime(t);
     opts->toStringFn(local, local - t, str);
   } else {
     opts->toStringFn(t, 0, str);
@@ -678,7 +678,7 @@ datePrototypeGetterHelper(void *ctx, Runtime *runtime, NativeArgs args) {
   // Store the original value of t to be used in offset calculations.
   double utc = t;
   if (!opts->isUTC) {
-    t = localTime(t);
+    t = runtime->getLocalTimeCache().localTime(t);
   }
 
   double result{std::numeric_limits<double>::quiet_NaN()};
@@ -745,7 +745,7 @@ datePrototypeSetMilliseconds(void *ctx, Runtime *runtime, NativeArgs args) {
   }
   double t = JSDate::getPrimitiveValue(self.get(), runtime).getNumber();
   if (!isUTC) {
-    t = localTime(t);
+    t = runtime->getLocalTimeCache().localTime(t);
   }
   auto res = toNumber_RJS(runtime, args.getArgHandle(runtime, 0));
   if (res == ExecutionStatus::EXCEPTION) {
@@ -756,7 +756,8 @@ datePrototypeSetMilliseconds(void *ctx, Runtime *runtime, NativeArgs args) {
       day(t), makeTime(hourFromTime(t), minFromTime(t), secFromTime(t), ms));
   PinnedHermesValue v;
   if (!isUTC) {
-    v = HermesValue::encodeDoubleValue(timeClip(utcTime(date)));
+    v = HermesValue::encodeDoubleValue(
+        timeClip(runtime->getLocalTimeCache().utcTime(date)));
   } else {
     v = HermesValue::encodeDoubleValue(timeClip(date));
   }
@@ -776,7 +777,7 @@ datePrototypeSetSeconds(void *ctx, Runtime *runtime, NativeArgs args) {
   }
   double t = JSDate::getPrimitiveValue(self.get(), runtime).getNumber();
   if (!isUTC) {
-    t = localTime(t);
+    t = runtime->getLocalTimeCache().localTime(t);
   }
   auto res = toNumber_RJS(runtime, args.getArgHandle(runtime, 0));
   if (res == ExecutionStatus::EXCEPTION) {
@@ -798,7 +799,8 @@ datePrototypeSetSeconds(void *ctx, Runtime *runtime, NativeArgs args) {
       makeDate(day(t), makeTime(hourFromTime(t), minFromTime(t), s, milli));
   PinnedHermesValue v;
   if (!isUTC) {
-    v = HermesValue::encodeDoubleValue(timeClip(utcTime(date)));
+    v = HermesValue::encodeDoubleValue(
+        timeClip(runtime->getLocalTimeCache().utcTime(date)));
   } else {
     v = HermesValue::encodeDoubleValue(timeClip(date));
   }
@@ -818,7 +820,7 @@ datePrototypeSetMinutes(void *ctx, Runtime *runtime, NativeArgs args) {
   }
   double t = JSDate::getPrimitiveValue(self.get(), runtime).getNumber();
   if (!isUTC) {
-    t = localTime(t);
+    t = runtime->getLocalTimeCache().localTime(t);
   }
   auto res = toNumber_RJS(runtime, args.getArgHandle(runtime, 0));
   if (res == ExecutionStatus::EXCEPTION) {
@@ -849,7 +851,8 @@ datePrototypeSetMinutes(void *ctx, Runtime *runtime, NativeArgs args) {
   double date = makeDate(day(t), makeTime(hourFromTime(t), m, s, milli));
   PinnedHermesValue v;
   if (!isUTC) {
-    v = HermesValue::encodeDoubleValue(timeClip(utcTime(date)));
+    v = HermesValue::encodeDoubleValue(
+        timeClip(runtime->getLocalTimeCache().utcTime(date)));
   } else {
     v = HermesValue::encodeDoubleValue(timeClip(date));
   }
@@ -869,7 +872,7 @@ datePrototypeSetHours(void *ctx, Runtime *runtime, NativeArgs args) {
   }
   double t = JSDate::getPrimitiveValue(self.get(), runtime).getNumber();
   if (!isUTC) {
-    t = localTime(t);
+    t = runtime->getLocalTimeCache().localTime(t);
   }
   auto res = toNumber_RJS(runtime, args.getArgHandle(runtime, 0));
   if (res == ExecutionStatus::EXCEPTION) {
@@ -910,7 +913,8 @@ datePrototypeSetHours(void *ctx, Runtime *runtime, NativeArgs args) {
   double date = makeDate(day(t), makeTime(h, m, s, milli));
   PinnedHermesValue v;
   if (!isUTC) {
-    v = HermesValue::encodeDoubleValue(timeClip(utcTime(date)));
+    v = HermesValue::encodeDoubleValue(
+        timeClip(runtime->getLocalTimeCache().utcTime(date)));
   } else {
     v = HermesValue::encodeDoubleValue(timeClip(date));
   }
@@ -929,7 +933,7 @@ datePrototypeSetDate(void *ctx, Runtime *runtime, NativeArgs args) {
   }
   double t = JSDate::getPrimitiveValue(self.get(), runtime).getNumber();
   if (!isUTC) {
-    t = localTime(t);
+    t = runtime->getLocalTimeCache().localTime(t);
   }
   auto res = toNumber_RJS(runtime, args.getArgHandle(runtime, 0));
   if (res == ExecutionStatus::EXCEPTION) {
@@ -940,7 +944,8 @@ datePrototypeSetDate(void *ctx, Runtime *runtime, NativeArgs args) {
       makeDay(yearFromTime(t), monthFromTime(t), dt), timeWithinDay(t));
   PinnedHermesValue v;
   if (!isUTC) {
-    v = HermesValue::encodeDoubleValue(timeClip(utcTime(newDate)));
+    v = HermesValue::encodeDoubleValue(
+        timeClip(runtime->getLocalTimeCache().utcTime(newDate)));
   } else {
     v = HermesValue::encodeDoubleValue(timeClip(newDate));
   }
@@ -960,7 +965,7 @@ datePrototypeSetMonth(void *ctx, Runtime *runtime, NativeArgs args) {
   }
   double t = JSDate::getPrimitiveValue(self.get(), runtime).getNumber();
   if (!isUTC) {
-    t = localTime(t);
+    t = runtime->getLocalTimeCache().localTime(t);
   }
   auto res = toNumber_RJS(runtime, args.getArgHandle(runtime, 0));
   if (res == ExecutionStatus::EXCEPTION) {
@@ -980,7 +985,8 @@ datePrototypeSetMonth(void *ctx, Runtime *runtime, NativeArgs args) {
   double newDate = makeDate(makeDay(yearFromTime(t), m, dt), timeWithinDay(t));
   PinnedHermesValue v;
   if (!isUTC) {
-    v = HermesValue::encodeDoubleValue(timeClip(utcTime(newDate)));
+    v = HermesValue::encodeDoubleValue(
+        timeClip(runtime->getLocalTimeCache().utcTime(newDate)));
   } else {
     v = HermesValue::encodeDoubleValue(timeClip(newDate));
   }
@@ -1000,7 +1006,7 @@ datePrototypeSetFullYear(void *ctx, Runtime *runtime, NativeArgs args) {
   }
   double t = JSDate::getPrimitiveValue(self.get(), runtime).getNumber();
   if (!isUTC) {
-    t = localTime(t);
+    t = runtime->getLocalTimeCache().localTime(t);
   }
   if (std::isnan(t)) {
     t = 0;
@@ -1033,7 +1039,8 @@ datePrototypeSetFullYear(void *ctx, Runtime *runtime, NativeArgs args) {
   double newDate = makeDate(makeDay(y, m, dt), timeWithinDay(t));
   PinnedHermesValue v;
   if (!isUTC) {
-    v = HermesValue::encodeDoubleValue(timeClip(utcTime(newDate)));
+    v = HermesValue::encodeDoubleValue(
+        timeClip(runtime->getLocalTimeCache().utcTime(newDate)));
   } else {
     v = HermesValue::encodeDoubleValue(timeClip(newDate));
   }
@@ -1052,7 +1059,7 @@ datePrototypeSetYear(void *ctx, Runtime *runtime, NativeArgs args) {
         "Date.prototype.setYear() called on non-Date object");
   }
   double t = JSDate::getPrimitiveValue(self.get(), runtime).getNumber();
-  t = localTime(t);
+  t = runtime->getLocalTimeCache().localTime(t);
   if (std::isnan(t)) {
     t = 0;
   }
@@ -1068,7 +1075,7 @@ datePrototypeSetYear(void *ctx, Runtime *runtime, NativeArgs args) {
   }
   double yint = oscompat::trunc(y);
   double yr = 0 <= yint && yint <= 99 ? yint + 1900 : y;
-  double date = utcTime(makeDate(
+  double date = runtime->getLocalTimeCache().utcTime(makeDate(
       makeDay(yr, monthFromTime(t), dateFromTime(t)), timeWithinDay(t)));
   auto v = HermesValue::encodeDoubleValue(timeClip(date));
   JSDate::setPrimitiveValue(self.get(), runtime, v);
@@ -10,6 +10,7 @@
 #include "hermes/Support/Compiler.h"
 #include "hermes/Support/OSCompat.h"
 #include "hermes/VM/CallResult.h"
+#include "hermes/VM/JSLib/LocalTimeCache.h"
 #include "hermes/VM/JSLib/RuntimeCommonStorage.h"
 #include "hermes/VM/SmallXString.h"
 
@@ -17,6 +18,7 @@
 #include "llvm/Support/Format.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <ctime>
@@ -369,13 +371,25 @@ int32_t detail::equivalentTime(int64_t epochSecs) {
   return (eqYearAsEpochDays + dayOfYear) * SECS_PER_DAY + secsOfDay;
 }
 
+/// \return the daylight saving time adjustment at \p epochSecs seconds since
+/// the epoch, which must be within the time range.
+static double daylightSavingTAForSecs(int64_t epochSecs) {
+  ::tzset();
+
+  time_t local = detail::equivalentTime(epochSecs);
+  std::tm *brokenTime = std::localtime(&local);
+  if (!brokenTime) {
+    // Local time is invalid.
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  return brokenTime->tm_isdst ? MS_PER_HOUR : 0;
+}
+
 double daylightSavingTA(double t) {
   if (!std::isfinite(t)) {
     return std::numeric_limits<double>::quiet_NaN();
   }
 
-  ::tzset();
-
   // Convert t to seconds and get the actual time needed.
   const double seconds = t / MS_PER_SECOND;
   // If the number of seconds is higher or lower than a unix timestamp can
@@ -383,21 +397,13 @@ double daylightSavingTA(double t) {
   // Invalid Date) breaks date construction entirely. Clamping only results in
   // small errors in daylight savings time. This is only a problem in systems
   // with a 32-bit time_t, like some Android systems.
-  time_t local = 0;
   if (seconds > TIME_RANGE_SECS || seconds < -TIME_RANGE_SECS) {
     // Return NaN if input is outside Time Range allowed in ES5.1
     return std::numeric_limits<double>::quiet_NaN();
   }
   // This will truncate any fractional seconds, which is ok for daylight
   // savings time calculations.
-  local = detail::equivalentTime(static_cast<int64_t>(seconds));
-
-  std::tm *brokenTime = std::localtime(&local);
-  if (!brokenTime) {
-    // Local time is invalid.
-    return std::numeric_limits<double>::quiet_NaN();
-  }
-  return brokenTime->tm_isdst ? MS_PER_HOUR : 0;
+  return daylightSavingTAForSecs(static_cast<int64_t>(seconds));
 }
 
 //===----------------------------------------------------------------------===//
@@ -414,6 +420,82 @@ double utcTime(double t) {
   return t - ltza - daylightSavingTA(t - ltza);
 }
 
+//===----------------------------------------------------------------------===//
+// LocalTimeCache
+
+double LocalTimeCache::computeLocalTZA() {
+  return vm::localTZA();
+}
+
+double LocalTimeCache::cachedDaylightSavingTA(double t) {
+  const double seconds = t / MS_PER_SECOND;
+  // NaN and the times outside the time range are not cached.
+  if (!(seconds >= -TIME_RANGE_SECS && seconds <= TIME_RANGE_SECS)) {
+    return vm::daylightSavingTA(t);
+  }
+
+  // Truncate like daylightSavingTA(), so that the result is the same.
+  int64_t secs = static_cast<int64_t>(seconds);
+  Range *lru = &ranges_[0];
+  for (Range &range : ranges_) {
+    if (range.lastUse && range.start <= secs && secs <= range.end) {
+      range.lastUse = ++useCounter_;
+      return range.dst;
+    }
+    if (range.lastUse < lru->lastUse) {
+      lru = &range;
+    }
+  }
+
+  // Replace the least recently used range with the range around secs.
+  double dst = daylightSavingTAForSecs(secs);
+  if (std::isnan(dst)) {
+    return dst;
+  }
+  lru->start = extendRange(secs, -kProbeSecs, dst);
+  lru->end = extendRange(secs, kProbeSecs, dst);
+  lru->dst = dst;
+  lru->lastUse = ++useCounter_;
+  return dst;
+}
+
+void LocalTimeCache::clear() {
+  for (Range &range : ranges_) {
+    range.lastUse = 0;
+  }
+  tzaValid_ = false;
+}
+
+void LocalTimeCache::checkTimeZone() {
+  const char *tz = ::getenv("TZ");
+  if (tz ? hasTZ_ && tz_ == tz : !hasTZ_) {
+    return;
+  }
+  clear();
+  hasTZ_ = tz != nullptr;
+  tz_ = tz ? tz : "";
+}
+
+int64_t LocalTimeCache::extendRange(int64_t secs, int64_t delta, double dst) {
+  int64_t good = secs;
+  int64_t bad =
+      std::min(TIME_RANGE_SECS, std::max(-TIME_RANGE_SECS, secs + delta));
+  if (daylightSavingTAForSecs(bad) == dst) {
+    return bad;
+  }
+  // There is a transition between good and bad: find the last second before
+  // it.
+  while (bad - good > 1 || good - bad > 1) {
+    int64_t mid = good + (bad - good) / 2;
+    if (daylightSavingTAForSecs(mid) == dst) {
+      good = mid;
+    } else {
+      bad = mid;
+    }
+  }
+  return good;
+}
+
 //===----------------------------------------------------------------------===//
 // ES5.1 15.9.1.10
 
@@ -609,7 +691,96 @@ static bool scanInt(InputIter &it, const InputIter end, int32_t &x) {
   return !ref.getAsInteger(10, x);
 }
 
+/// Parse the strict ISO 8601 format of Date.prototype.toISOString(), with
+/// fixed-width fields, in [\p chars, \p chars + len): YYYY-MM-DD, optionally
+/// followed by THH:mm, :ss, .sss and Z or +HH:mm / -HH:mm.
+/// This is the format of almost all the strings which are parsed, and it is
+/// parsed in one pass without copying the digits.
+/// \param[out] t the parsed time, if successful.
+/// \return false if the string isn't in that format, in which case the
+///   general parser must be used.
+template <typename CharT>
+static bool parseISODateFast(const CharT *chars, size_t len, double &t) {
+  // Read the \p n digits at \p pos, or return -1 if they aren't all digits.
+  auto digits = [chars](size_t pos, size_t n) -> int32_t {
+    int32_t x = 0;
+    for (size_t i = 0; i < n; ++i) {
+      CharT c = chars[pos + i];
+      if (c < '0' || c > '9') {
+        return -1;
+      }
+      x = x * 10 + (c - '0');
+    }
+    return x;
+  };
+
+  if (len < 10 || chars[4] != '-' || chars[7] != '-') {
+    return false;
+  }
+  int32_t y = digits(0, 4), m = digits(5, 2), d = digits(8, 2);
+  if ((y | m | d) < 0) {
+    return false;
+  }
+
+  int32_t h = 0, min = 0, s = 0, ms = 0, tzh = 0, tzm = 0;
+  if (len > 10) {
+    if (len < 16 || chars[10] != 'T' || chars[13] != ':') {
+      return false;
+    }
+    h = digits(11, 2);
+    min = digits(14, 2);
+    if ((h | min) < 0) {
+      return false;
+    }
+    size_t pos = 16;
+    if (pos < len && chars[pos] == ':') {
+      if (len < pos + 3 || (s = digits(pos + 1, 2)) < 0) {
+        return false;
+      }
+      pos += 3;
+      if (pos < len && chars[pos] == '.') {
+        // Other numbers of digits are left to the general parser.
+        if (len < pos + 4 || (ms = digits(pos + 1, 3)) < 0) {
+          return false;
+        }
+        pos += 4;
+      }
+    }
+    if (pos < len && chars[pos] == 'Z') {
+      ++pos;
+    } else if (pos < len && (chars[pos] == '+' || chars[pos] == '-')) {
+      if (len < pos + 6 || chars[pos + 3] != ':') {
+        return false;
+      }
+      tzh = digits(pos + 1, 2);
+      tzm = digits(pos + 4, 2);
+      if ((tzh | tzm) < 0) {
+        return false;
+      }
+      if (chars[pos] == '-') {
+        tzh = -tzh;
+        tzm = -tzm;
+      }
+      pos += 6;
+    }
+    if (pos != len) {
+      return false;
+    }
+  }
+
+  // Account for the fact that m was 1-indexed and the timezone offset.
+  t = makeDate(makeDay(y, m - 1, d), makeTime(h - tzh, min - tzm, s, ms));
+  return true;
+}
+
 double parseDate(StringView u16str) {
+  double t;
+  if (u16str.isASCII()
+          ? parseISODateFast(u16str.castToCharPtr(), u16str.length(), t)
+          : parseISODateFast(u16str.castToChar16Ptr(), u16str.length(), t)) {
+    return t;
+  }
+
   const double nan = std::numeric_limits<double>::quiet_NaN();
 
   auto it = u16str.begin();
@@ -703,6 +874,7 @@ double parseDate(StringView u16str) {
       if (!scanInt(it, end, tzm)) {
         return nan;
       }
+      tzm *= sign;
     }
   }
 
@@ -125,8 +125,14 @@ static CallResult<HermesValue> constructErrorObject(
     selfHandle = vmcast<JSError>(*errRes);
   }
 
-  // Record the stack trace, skipping this entry.
-  JSError::recordStackTrace(selfHandle, runtime, true);
+  // Record the stack trace, skipping this entry. If the error is created by
+  // the interpreter, it can be left to the throw, which doesn't record it if
+  // the error is caught close by.
+  if (!(runtime->getVMExperimentFlags() &
+        experiments::SkipStackTraceForLocalCatch) ||
+      !runtime->getStackFrames().begin()->getSavedCodeBlock()) {
+    JSError::recordStackTrace(selfHandle, runtime, true);
+  }
   // Initialize stack accessor.
   JSError::setupStack(selfHandle, runtime);
 
@@ -13,6 +13,8 @@
 #include "hermes/Regex/Executor.h"
 #include "hermes/Regex/RegexTraits.h"
 #include "hermes/VM/Callable.h"
+#include "hermes/VM/JSArray.h"
+#include "hermes/VM/JSLib.h"
 #include "hermes/VM/Operations.h"
 #include "hermes/VM/StringBuilder.h"
 #include "hermes/VM/StringView.h"
@@ -86,6 +88,11 @@ Handle<JSObject> createFunctionConstructor(Runtime *runtime) {
       nullptr,
       functionPrototypeApply,
       2);
+  runtime->functionPrototypeApply =
+      runtime->ignoreAllocationFailure(JSObject::getNamed_RJS(
+          functionPrototype,
+          runtime,
+          Predefined::getSymbolID(Predefined::apply)));
   defineMethod(
       runtime,
       functionPrototype,
@@ -203,6 +210,29 @@ functionPrototypeApply(void *, Runtime *runtime, NativeArgs args) {
         "Can't apply() with non-object arguments list");
   }
 
+  // Fast path: the elements of a packed array are copied straight into the
+  // new frame. Its length can't be an accessor and nothing can allocate while
+  // copying, so the arguments don't need to be filled first.
+  if (auto argArray = Handle<JSArray>::dyn_vmcast(runtime, argObj)) {
+    if (JSArray::isPacked(*argArray)) {
+      // String.fromCharCode.apply() is how arrays of code units are decoded,
+      // so build that string straight from the elements.
+      auto strRes = tryStringFromCharCodeApply(runtime, func, argArray);
+      if (LLVM_UNLIKELY(strRes == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      if (!strRes->isEmpty())
+        return *strRes;
+      uint32_t n = JSArray::getLength(*argArray);
+      ScopedNativeCallFrame newFrame{runtime, n, *func, false, args.getArg(0)};
+      if (LLVM_UNLIKELY(newFrame.overflowed()))
+        return runtime->raiseStackOverflow(
+            Runtime::StackOverflowKind::NativeStack);
+      for (uint32_t argIdx = 0; argIdx < n; ++argIdx)
+        newFrame->getArgRef(argIdx) = argArray->at(runtime, argIdx);
+      return Callable::call(func, runtime);
+    }
+  }
+
   auto propRes = JSObject::getNamed_RJS(
       argObj, runtime, Predefined::getSymbolID(Predefined::length));
   if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
@@ -58,6 +58,41 @@ static bool isValidRadixChar(char16_t c, int radix) {
   return (radix > 10 && c >= 'a' && c < 'a' + radix - 10);
 }
 
+/// \return whether \p c is whitespace skipped by parseInt() and parseFloat().
+static inline bool isWhiteSpaceOrLineTerminator(char16_t c) {
+  return isWhiteSpaceChar(c) || isLineTerminatorChar(c);
+}
+
+/// Parse \p str as parseInt() does with radix 10, when it is a decimal
+/// integer with at most 15 digits, which is accumulated exactly in an integer.
+/// \param stripPrefix whether a "0x" prefix would select radix 16.
+/// \return the number, or llvm::None if \p str has no digits, more than 15
+///   digits, or a "0x" prefix that must be stripped.
+static OptValue<double> parseShortDecimalInt(ASCIIRef str, bool stripPrefix) {
+  const char *p = str.begin();
+  const char *end = str.end();
+  while (p != end && isWhiteSpaceOrLineTerminator(*p))
+    ++p;
+  bool negative = false;
+  if (p != end && (*p == '+' || *p == '-')) {
+    negative = *p == '-';
+    ++p;
+  }
+  const char *digits = p;
+  uint64_t result = 0;
+  for (; p != end && '0' <= *p && *p <= '9'; ++p) {
+    if (p - digits == 15)
+      return llvm::None;
+    result = result * 10 + (*p - '0');
+  }
+  if (p == digits ||
+      (stripPrefix && p - digits == 1 && *digits == '0' && p != end &&
+       letterToLower(*p) == 'x')) {
+    return llvm::None;
+  }
+  return negative ? -(double)result : (double)result;
+}
+
 /// ES5.1 15.1.2.2 parseInt(string, radix)
 static CallResult<HermesValue>
 parseInt(void *, Runtime *runtime, NativeArgs args) {
@@ -86,6 +121,12 @@ parseInt(void *, Runtime *runtime, NativeArgs args) {
     }
   }
 
+  if (radix == 10 && str->isASCII()) {
+    auto fast = parseShortDecimalInt(str->getStringRef<char>(), stripPrefix);
+    if (fast)
+      return HermesValue::encodeDoubleValue(*fast);
+  }
+
   auto strView = StringPrimitive::createStringView(runtime, str);
   auto begin = strView.begin();
   auto end = strView.end();
@@ -146,6 +187,36 @@ static bool isPrefix(StringView str1, StringView str2) {
   return true;
 }
 
+/// \return the end of the longest prefix of [\p first, \p last) which is a
+///   decimal literal: an optional sign, digits with an optional decimal point,
+///   and an optional exponent. \return \p first if there is none.
+static const char *scanDecimalLiteral(const char *first, const char *last) {
+  auto isDigit = [](char c) { return '0' <= c && c <= '9'; };
+  const char *p = first;
+  if (p != last && (*p == '+' || *p == '-'))
+    ++p;
+  bool sawDigit = false;
+  for (; p != last && isDigit(*p); ++p)
+    sawDigit = true;
+  if (p != last && *p == '.') {
+    for (++p; p != last && isDigit(*p); ++p)
+      sawDigit = true;
+  }
+  if (!sawDigit)
+    return first;
+  // The exponent is part of the literal only if it has digits.
+  if (p != last && letterToLower(*p) == 'e') {
+    const char *exp = p + 1;
+    if (exp != last && (*exp == '+' || *exp == '-'))
+      ++exp;
+    if (exp != last && isDigit(*exp)) {
+      for (p = exp; p != last && isDigit(*p); ++p) {
+      }
+    }
+  }
+  return p;
+}
+
 /// ES5.1 15.1.2.3 parseFloat(string)
 static CallResult<HermesValue>
 parseFloat(void *, Runtime *runtime, NativeArgs args) {
@@ -156,6 +227,21 @@ parseFloat(void *, Runtime *runtime, NativeArgs args) {
   }
 
   auto strHandle = toHandle(runtime, std::move(*res));
+
+  // Parse the longest prefix of an ASCII string which is a decimal literal
+  // directly, when it has few enough digits.
+  if (strHandle->isASCII()) {
+    auto ascii = strHandle->getStringRef<char>();
+    const char *begin = ascii.begin();
+    while (begin != ascii.end() && isWhiteSpaceOrLineTerminator(*begin))
+      ++begin;
+    const char *literalEnd = scanDecimalLiteral(begin, ascii.end());
+    if (literalEnd != begin) {
+      if (auto fast = parseDecimalFast(begin, literalEnd))
+        return HermesValue::encodeDoubleValue(*fast);
+    }
+  }
+
   auto origStr = StringPrimitive::createStringView(runtime, strHandle);
 
   auto &idTable = runtime->getIdentifierTable();
@@ -501,6 +587,15 @@ void initGlobalObject(Runtime *runtime) {
   // "Forward declaration" of WeakSet.prototype.
   runtime->weakSetPrototype = JSObject::create(runtime).getHermesValue();
 
+  // "Forward declaration" of Promise.prototype.
+  runtime->promisePrototype = JSObject::create(runtime).getHermesValue();
+
+  // "Forward declaration" of TextEncoder.prototype.
+  runtime->textEncoderPrototype = JSObject::create(runtime).getHermesValue();
+
+  // "Forward declaration" of TextDecoder.prototype.
+  runtime->textDecoderPrototype = JSObject::create(runtime).getHermesValue();
+
   // "Forward declaration" of %ArrayIteratorPrototype%.
   runtime->arrayIteratorPrototype =
       JSObject::create(
@@ -593,6 +688,17 @@ void initGlobalObject(Runtime *runtime) {
     createSymbolConstructor(runtime);
   }
 
+  // Promise constructor.
+  if (runtime->hasES6Promise()) {
+    createPromiseConstructor(runtime);
+  }
+
+  // TextEncoder constructor.
+  createTextEncoderConstructor(runtime);
+
+  // TextDecoder constructor.
+  createTextDecoderConstructor(runtime);
+
   /// %IteratorPrototype%.
   populateIteratorPrototype(runtime);
 
@@ -683,6 +789,12 @@ void initGlobalObject(Runtime *runtime) {
       encodeURIComponent,
       1);
 
+  // Define the 'atob' function.
+  defineGlobalFunc(Predefined::getSymbolID(Predefined::atob), atob, 1);
+
+  // Define the 'btoa' function.
+  defineGlobalFunc(Predefined::getSymbolID(Predefined::btoa), btoa, 1);
+
   // Define the 'require' function.
   runtime->requireFunction =
       NativeFunction::create(
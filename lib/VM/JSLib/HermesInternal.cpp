@@ -9,6 +9,7 @@
 #include "hermes/BCGen/HBC/BytecodeFileFormat.h"
 #include "hermes/Support/Base64vlq.h"
 #include "hermes/VM/JSArrayBuffer.h"
+#include "hermes/VM/JSLib/RuntimeCommonStorage.h"
 #include "hermes/VM/JSTypedArray.h"
 #include "hermes/VM/JSWeakMapImpl.h"
 
@@ -239,6 +240,14 @@ hermesInternalGetInstrumentedStats(void *, Runtime *runtime, NativeArgs args) {
     SET_PROP_NEW("js_totalAllocatedBytes", info.totalAllocatedBytes);
   }
 
+  {
+    const auto &cacheStats = runtime->collectPropertyCacheStats();
+    SET_PROP_NEW("js_propertyCacheHits", cacheStats.hits);
+    SET_PROP_NEW("js_propertyCacheMisses", cacheStats.misses);
+    SET_PROP_NEW(
+        "js_propertyCacheMegamorphicMisses", cacheStats.megamorphicMisses);
+  }
+
   if (stats.shouldSample) {
     SET_PROP_NEW(
         "js_hermesVolCtxSwitches",
@@ -593,6 +602,49 @@ hermesInternalCopyDataProperties(void *, Runtime *runtime, NativeArgs args) {
   MutableHandle<> nameHandle{runtime};
   MutableHandle<> valueHandle{runtime};
 
+  // Fast path: the properties of source are all enumerable data properties
+  // with string names cached in its class, and defining them can't run any
+  // code. An empty target, as in object spread, can even take the class of
+  // source.
+  auto cacheRes = getOwnPropertiesCache(runtime, source);
+  if (LLVM_UNLIKELY(cacheRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  Handle<ArrayStorage> cache = *cacheRes;
+  if (cache && cache->at(kOwnPropsAllDefault).getBool()) {
+    HiddenClass *clazz = target->getClass(runtime);
+    if (!excludedItems && target->getKind() == CellKind::ObjectKind &&
+        !target->isHostObject() && !target->isLazy() &&
+        target->isExtensible() && !clazz->isDictionary() &&
+        clazz->getNumProperties() == 0) {
+      JSObject::adoptClassAndSlots(target, runtime, source);
+      return target.getHermesValue();
+    }
+    GCScopeMarkerRAII marker{runtime};
+    for (uint32_t i = kOwnPropsHeaderSize, e = cache->size(); i < e;
+         i += kOwnPropsEntrySize) {
+      marker.flush();
+      SymbolID sym = cache->at(i + kOwnPropsSymbol).getSymbol();
+      if (excludedItems &&
+          JSObject::hasNamedOrIndexed(excludedItems, runtime, sym)) {
+        continue;
+      }
+      valueHandle = JSObject::getNamedSlotValue(
+          *source,
+          runtime,
+          cache->at(i + kOwnPropsSlot).getNumberAs<SlotIndex>());
+      if (LLVM_UNLIKELY(
+              JSObject::defineOwnProperty(
+                  target,
+                  runtime,
+                  sym,
+                  DefinePropertyFlags::getDefaultNewPropertyFlags(),
+                  valueHandle) == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+    }
+    return target.getHermesValue();
+  }
+
   // Process all named properties/symbols.
   bool success = JSObject::forEachOwnPropertyWhile(
       source,
@@ -812,6 +864,28 @@ hermesInternalExportAll(void *, Runtime *runtime, NativeArgs args) {
   return HermesValue::encodeUndefinedValue();
 }
 
+/// HermesInternal.fillRandom(array)
+/// Fill the Float64Array \p array with numbers from the same generator and in
+/// the same sequence as Math.random(), without a call per number.
+/// \return the array.
+CallResult<HermesValue>
+hermesInternalFillRandom(void *, Runtime *runtime, NativeArgs args) {
+  auto array = args.dyncastArg<Float64Array>(runtime, 0);
+  if (LLVM_UNLIKELY(!array)) {
+    return runtime->raiseTypeError(
+        "fillRandom() argument must be Float64Array");
+  }
+  if (LLVM_UNLIKELY(!array->attached(runtime))) {
+    return runtime->raiseTypeError(
+        "fillRandom() argument must have an attached buffer");
+  }
+  XorShift128Plus &engine = runtime->getCommonStorage()->getRandomEngine();
+  for (double *it = array->begin(), *e = array->end(); it != e; ++it) {
+    *it = engine.nextDouble();
+  }
+  return array.getHermesValue();
+}
+
 #ifdef HERMESVM_EXCEPTION_ON_OOM
 /// Gets the current call stack as a JS String value.  Intended (only)
 /// to allow testing of Runtime::callStack() from JS code.
@@ -884,6 +958,7 @@ Handle<JSObject> createHermesInternalObject(Runtime *runtime) {
   defineInternMethod(P::ttiReached, hermesInternalTTIReached);
   defineInternMethod(P::ttrcReached, hermesInternalTTRCReached);
   defineInternMethod(P::exportAll, hermesInternalExportAll);
+  defineInternMethod(P::fillRandom, hermesInternalFillRandom, 1);
 #ifdef HERMESVM_EXCEPTION_ON_OOM
   defineInternMethodAndSymbol("getCallStack", hermesInternalGetCallStack, 0);
 #endif // HERMESVM_EXCEPTION_ON_OOM
@@ -11,6 +11,7 @@
 #include "hermes/VM/JSDate.h"
 #include "hermes/VM/JSError.h"
 #include "hermes/VM/JSMapImpl.h"
+#include "hermes/VM/JSPromise.h"
 #include "hermes/VM/JSRegExp.h"
 
 namespace hermes {
@@ -220,11 +221,50 @@ ExecutionStatus iteratorCloseAndRethrow(
 /// \return the global Object constructor.
 Handle<JSObject> createObjectConstructor(Runtime *runtime);
 
+/// Layout of the cache of the enumerable own properties of the objects of a
+/// class, returned by getOwnPropertiesCache(): a header, then an entry per
+/// property, in the order of JSObject::getOwnPropertyNames().
+enum OwnPropertiesCacheLayout : uint32_t {
+  /// Header: whether the enumerable properties are all data properties, which
+  /// the rest of the cache describes. Otherwise it is empty.
+  kOwnPropsAllData,
+  /// Header: whether every property of the class, enumerable or not, is a
+  /// writable, enumerable and configurable data property with a string name,
+  /// so that creating them in order in an empty object gives it this class.
+  kOwnPropsAllDefault,
+  kOwnPropsHeaderSize,
+
+  /// Entry: the name, as a string.
+  kOwnPropsName = 0,
+  /// Entry: the name, as a symbol.
+  kOwnPropsSymbol,
+  /// Entry: the slot of the value.
+  kOwnPropsSlot,
+  kOwnPropsEntrySize,
+};
+
+/// \return the cache of the enumerable own properties of \p obj, shared by
+/// the objects of its class, if they are all data properties described by
+/// the class, or a null handle otherwise. See OwnPropertiesCacheLayout.
+CallResult<Handle<ArrayStorage>> getOwnPropertiesCache(
+    Runtime *runtime,
+    Handle<JSObject> obj);
+
 /// Built-in Object.prototype.toString.
 CallResult<HermesValue> directObjectPrototypeToString(
     Runtime *runtime,
     Handle<> arg);
 
+/// ES5.1 15.2.4.2.
+/// Used by ordinaryToPrimitive() to recognize the built-in function.
+CallResult<HermesValue>
+objectPrototypeToString(void *, Runtime *runtime, NativeArgs args);
+
+/// ES5.1 15.2.4.4 Object.prototype.valueOf.
+/// Used by ordinaryToPrimitive() to recognize the built-in function.
+CallResult<HermesValue>
+objectPrototypeValueOf(void *, Runtime *runtime, NativeArgs args);
+
 /// Create and initialize the global Error constructor, as well as all
 /// the native error constructors. Populate the instance and prototype methods.
 #define ALL_ERROR_TYPE(name) \
@@ -306,6 +346,10 @@ CallResult<HermesValue> getSubstitution(
     Handle<ArrayStorage> captures,
     Handle<StringPrimitive> replacement);
 
+/// \return true if the replacement string \p replacement may contain $
+/// replacement strings, false if GetSubstitution() would return it unchanged.
+bool hasSubstitutions(Runtime *runtime, Handle<StringPrimitive> replacement);
+
 /// Main logic for String.prototype.split and RegExp.prototype[Symbol.split].
 /// Returns an array of splitted strings.
 CallResult<HermesValue> splitInternal(
@@ -356,6 +400,15 @@ Handle<JSObject> createWeakSetConstructor(Runtime *runtime);
 /// Create the Symbol constructor and populate methods.
 Handle<JSObject> createSymbolConstructor(Runtime *runtime);
 
+/// Create the Promise constructor and populate methods.
+Handle<JSObject> createPromiseConstructor(Runtime *runtime);
+
+/// Create the TextEncoder constructor and populate methods.
+Handle<JSObject> createTextEncoderConstructor(Runtime *runtime);
+
+/// Create the TextDecoder constructor and populate methods.
+Handle<JSObject> createTextDecoderConstructor(Runtime *runtime);
+
 /// Create the GeneratorFunction constructor and populate methods.
 Handle<JSObject> createGeneratorFunctionConstructor(Runtime *runtime);
 
@@ -412,6 +465,14 @@ CallResult<HermesValue> encodeURI(void *, Runtime *runtime, NativeArgs args);
 CallResult<HermesValue>
 encodeURIComponent(void *, Runtime *runtime, NativeArgs args);
 
+/// The 'atob' global function, which decodes base64 into a string of Latin-1
+/// characters. HTML Living Standard 8.3.
+CallResult<HermesValue> atob(void *, Runtime *runtime, NativeArgs args);
+
+/// The 'btoa' global function, which encodes a string of Latin-1 characters
+/// as base64. HTML Living Standard 8.3.
+CallResult<HermesValue> btoa(void *, Runtime *runtime, NativeArgs args);
+
 /// The require() function.
 /// Given a string containing a relative path to a module,
 /// require first checks the CommonJS module table to see if the module
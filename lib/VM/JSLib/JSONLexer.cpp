@@ -6,9 +6,12 @@
  */
 #include "JSONLexer.h"
 
+#include "hermes/Support/Conversions.h"
 #include "hermes/VM/StringPrimitive.h"
 #include "hermes/dtoa/dtoa.h"
 
+#include <cstring>
+
 namespace hermes {
 namespace vm {
 
@@ -21,8 +24,43 @@ static bool isJSONWhiteSpace(char16_t ch) {
   return (ch == u'\t' || ch == u'\r' || ch == u'\n' || ch == u' ');
 }
 
-ExecutionStatus JSONLexer::advance() {
-  // Skip whitespaces.
+/// \return whether \p ch stands for itself in a JSONString, i.e. it doesn't
+/// end the string, start an escape sequence, or make the string invalid.
+static bool isPlainStringChar(char16_t ch) {
+  return ch != u'"' && ch != u'\\' && ch > u'\u001F';
+}
+
+/// \return the end of the run of plain string characters starting at \p ptr
+/// and ending at most at \p end.
+static const char16_t *scanPlainStringChars(
+    const char16_t *ptr,
+    const char16_t *end) {
+  // Check four characters at a time while possible. Each 16-bit lane of the
+  // expressions below has its top bit set if the lane is '"', '\\' or less
+  // than 0x20. A borrow only crosses into the next lane from a lane which is
+  // set itself, so the word is plain iff none are set.
+  constexpr uint64_t kOnes = 0x0001000100010001ull;
+  constexpr uint64_t kHighs = 0x8000800080008000ull;
+  constexpr ptrdiff_t kLanes = sizeof(uint64_t) / sizeof(char16_t);
+  while (end - ptr >= kLanes) {
+    uint64_t word;
+    std::memcpy(&word, ptr, sizeof(word));
+    uint64_t quote = word ^ (kOnes * u'"');
+    uint64_t backslash = word ^ (kOnes * u'\\');
+    uint64_t special = ((quote - kOnes) & ~quote) |
+        ((backslash - kOnes) & ~backslash) | ((word - kOnes * 0x20) & ~word);
+    if (special & kHighs) {
+      break;
+    }
+    ptr += kLanes;
+  }
+  while (ptr < end && isPlainStringChar(*ptr)) {
+    ++ptr;
+  }
+  return ptr;
+}
+
+bool JSONLexer::skipWhiteSpace() {
   while (curCharPtr_ < bufferEnd_ && isJSONWhiteSpace(*curCharPtr_)) {
     curCharPtr_++;
   }
@@ -30,10 +68,26 @@ ExecutionStatus JSONLexer::advance() {
   // End of buffer.
   if (curCharPtr_ == bufferEnd_) {
     token_.setEof();
+    return false;
+  }
+  token_.setLoc(curCharPtr_);
+  return true;
+}
+
+ExecutionStatus JSONLexer::advanceStrAsSymbol() {
+  if (!skipWhiteSpace()) {
     return ExecutionStatus::RETURNED;
   }
+  if (*curCharPtr_ == u'"') {
+    return scanString(true);
+  }
+  return advance();
+}
 
-  token_.setLoc(curCharPtr_);
+ExecutionStatus JSONLexer::advance() {
+  if (!skipWhiteSpace()) {
+    return ExecutionStatus::RETURNED;
+  }
 
 #define PUNC(ch, tok)          \
   case ch:                     \
@@ -64,7 +118,7 @@ ExecutionStatus JSONLexer::advance() {
       return scanNumber();
 
     case u'"':
-      return scanString();
+      return scanString(false);
 
     default:
       return errorWithChar(u"Unexpected token: ", *curCharPtr_);
@@ -110,6 +164,11 @@ ExecutionStatus JSONLexer::scanNumber() {
     return errorWithChar(u"Unexpected token in number: ", *(start + 1));
   }
 
+  if (auto fast = parseDecimalFast(start, curCharPtr_)) {
+    token_.setNumber(*fast);
+    return ExecutionStatus::RETURNED;
+  }
+
   // copy 16 bit chars into 8 bit chars and call g_strtod.
   llvm::SmallVector<char, 32> str8;
   str8.insert(str8.begin(), start, start + len);
@@ -125,21 +184,44 @@ ExecutionStatus JSONLexer::scanNumber() {
   return ExecutionStatus::RETURNED;
 }
 
-ExecutionStatus JSONLexer::scanString() {
+ExecutionStatus JSONLexer::setStringToken(UTF16Ref str, bool asSymbol) {
+  if (asSymbol && !toArrayIndex(str.begin(), str.end())) {
+    auto symRes = runtime_->getIdentifierTable().getSymbolHandle(runtime_, str);
+    if (LLVM_UNLIKELY(symRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    token_.setSymbol(*symRes);
+    return ExecutionStatus::RETURNED;
+  }
+  auto strRes = StringPrimitive::create(runtime_, str);
+  if (LLVM_UNLIKELY(strRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  token_.setString(runtime_->makeHandle<StringPrimitive>(*strRes));
+  return ExecutionStatus::RETURNED;
+}
+
+ExecutionStatus JSONLexer::scanString(bool asSymbol) {
   assert(*curCharPtr_ == '"');
   ++curCharPtr_;
+
+  // Most strings have no escape sequences, so their contents can be used
+  // directly from the buffer.
+  const char16_t *start = curCharPtr_;
+  curCharPtr_ = scanPlainStringChars(curCharPtr_, bufferEnd_);
+  if (curCharPtr_ < bufferEnd_ && *curCharPtr_ == '"') {
+    ++curCharPtr_;
+    return setStringToken(UTF16Ref(start, curCharPtr_ - 1 - start), asSymbol);
+  }
+
   SmallU16String<32> tmpStorage;
+  tmpStorage.append(UTF16Ref(start, curCharPtr_));
 
   while (curCharPtr_ < bufferEnd_) {
     if (*curCharPtr_ == '"') {
       // End of string.
-      auto strRes = StringPrimitive::create(runtime_, tmpStorage.arrayRef());
-      if (LLVM_UNLIKELY(strRes == ExecutionStatus::EXCEPTION)) {
-        return ExecutionStatus::EXCEPTION;
-      }
-      token_.setString(runtime_->makeHandle<StringPrimitive>(*strRes));
       ++curCharPtr_;
-      return ExecutionStatus::RETURNED;
+      return setStringToken(tmpStorage.arrayRef(), asSymbol);
     } else if (*curCharPtr_ <= '\u001F') {
       return error(u"U+0000 thru U+001F is not allowed in string");
     }
@@ -190,7 +272,9 @@ ExecutionStatus JSONLexer::scanString() {
           return errorWithChar(u"Invalid escape sequence: ", *curCharPtr_);
       }
     } else {
-      tmpStorage.push_back(*curCharPtr_++);
+      const char16_t *runStart = curCharPtr_;
+      curCharPtr_ = scanPlainStringChars(curCharPtr_, bufferEnd_);
+      tmpStorage.append(UTF16Ref(runStart, curCharPtr_));
     }
   }
   return error("Unexpected end of input");
@@ -44,6 +44,10 @@ class JSONToken {
   JSONTokenKind kind_{JSONTokenKind::None};
   double numberValue_{};
   MutableHandle<StringPrimitive> stringValue_;
+  MutableHandle<SymbolID> symbolValue_;
+
+  /// Whether the String token was created by setSymbol().
+  bool isSymbol_{false};
 
   /// The starting location of this token.
   const char16_t *loc_{};
@@ -52,7 +56,8 @@ class JSONToken {
   const JSONToken &operator=(const JSONToken &) = delete;
 
  public:
-  explicit JSONToken(Runtime *runtime) : stringValue_(runtime) {}
+  explicit JSONToken(Runtime *runtime)
+      : stringValue_(runtime), symbolValue_(runtime) {}
 
   JSONTokenKind getKind() const {
     return kind_;
@@ -64,10 +69,22 @@ class JSONToken {
   }
 
   Handle<StringPrimitive> getString() const {
-    assert(getKind() == JSONTokenKind::String);
+    assert(getKind() == JSONTokenKind::String && !isSymbol_);
     return stringValue_;
   }
 
+  /// \return whether the String token holds a SymbolID rather than a
+  ///   StringPrimitive.
+  bool isSymbol() const {
+    assert(getKind() == JSONTokenKind::String);
+    return isSymbol_;
+  }
+
+  Handle<SymbolID> getSymbol() const {
+    assert(getKind() == JSONTokenKind::String && isSymbol_);
+    return symbolValue_;
+  }
+
   const char16_t *getLoc() const {
     return loc_;
   }
@@ -92,8 +109,14 @@ class JSONToken {
   }
   void setString(Handle<StringPrimitive> str) {
     kind_ = JSONTokenKind::String;
+    isSymbol_ = false;
     stringValue_ = str.get();
   }
+  void setSymbol(Handle<SymbolID> sym) {
+    kind_ = JSONTokenKind::String;
+    isSymbol_ = true;
+    symbolValue_ = sym.get();
+  }
 };
 
 class JSONLexer {
@@ -131,6 +154,12 @@ class JSONLexer {
   /// All whitespace is skipped before the new token.
   LLVM_NODISCARD ExecutionStatus advance();
 
+  /// Like advance(), but if the new token is a string which is not an array
+  /// index, store it as a SymbolID instead of a StringPrimitive. This is meant
+  /// for object keys, which mostly repeat, and so are mostly already in the
+  /// identifier table.
+  LLVM_NODISCARD ExecutionStatus advanceStrAsSymbol();
+
   /// Raise a JSON parse exception with message \p msg.
   /// token_ will also be invalidated.
   LLVM_NODISCARD ExecutionStatus error(const TwineChar16 &msg) {
@@ -150,8 +179,17 @@ class JSONLexer {
   /// Parse a JSONNumber.
   LLVM_NODISCARD ExecutionStatus scanNumber();
 
-  /// Parse a JSONString.
-  LLVM_NODISCARD ExecutionStatus scanString();
+  /// Skip whitespace before the next token.
+  /// \return false if the end of the input was reached.
+  bool skipWhiteSpace();
+
+  /// Parse a JSONString. If \p asSymbol is true, store it as a SymbolID,
+  /// unless it is an array index.
+  LLVM_NODISCARD ExecutionStatus scanString(bool asSymbol);
+
+  /// Store the contents of a JSONString \p str in token_, as a SymbolID if
+  /// \p asSymbol is true and it is not an array index.
+  LLVM_NODISCARD ExecutionStatus setStringToken(UTF16Ref str, bool asSymbol);
 
   /// Parse a reserved keyword.
   LLVM_NODISCARD ExecutionStatus scanWord(const char *word, JSONTokenKind kind);
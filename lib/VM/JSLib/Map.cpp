@@ -311,7 +311,10 @@ mapPrototypeClear(void *, Runtime *runtime, NativeArgs args) {
     return runtime->raiseTypeError(
         "Method Map.prototype.clear called on incompatible receiver");
   }
-  JSMap::clear(selfHandle, runtime);
+  if (LLVM_UNLIKELY(
+          JSMap::clear(selfHandle, runtime) == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
   return HermesValue::encodeUndefinedValue();
 }
 
@@ -436,11 +439,14 @@ mapPrototypeSet(void *, Runtime *runtime, NativeArgs args) {
     return runtime->raiseTypeError(
         "Method Map.prototype.set called on incompatible receiver");
   }
-  JSMap::addValue(
-      selfHandle,
-      runtime,
-      args.getArgHandle(runtime, 0),
-      args.getArgHandle(runtime, 1));
+  if (LLVM_UNLIKELY(
+          JSMap::addValue(
+              selfHandle,
+              runtime,
+              args.getArgHandle(runtime, 0),
+              args.getArgHandle(runtime, 1)) == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
   return selfHandle.getHermesValue();
 }
 
@@ -491,6 +497,9 @@ Handle<JSObject> createMapIteratorPrototype(Runtime *runtime) {
       nullptr,
       mapIteratorPrototypeNext,
       0);
+  runtime->mapIteratorPrototypeNext =
+      runtime->ignoreAllocationFailure(JSObject::getNamed_RJS(
+          parentHandle, runtime, Predefined::getSymbolID(Predefined::next)));
 
   auto dpf = DefinePropertyFlags::getDefaultNewPropertyFlags();
   dpf.writable = 0;
@@ -18,7 +18,6 @@
 #define _USE_MATH_DEFINES
 #include <float.h>
 #include <math.h>
-#include <random>
 #include "hermes/Support/OSCompat.h"
 
 #include "llvm/Support/MathExtras.h"
@@ -195,23 +194,8 @@ mathPow(void *, Runtime *runtime, NativeArgs args) {
 // Returns a Hermes-encoded pseudo-random number uniformly chosen from [0, 1)
 static CallResult<HermesValue>
 mathRandom(void *, Runtime *runtime, NativeArgs) {
-  RuntimeCommonStorage *storage = runtime->getCommonStorage();
-  if (!storage->randomEngineSeeded_) {
-#ifdef HERMESVM_SYNTH_REPLAY
-    std::minstd_rand::result_type seed = storage->env.mathRandomSeed;
-#else
-    std::minstd_rand::result_type seed = std::random_device()();
-#endif
-    storage->randomEngine_.seed(seed);
-    storage->randomEngineSeeded_ = true;
-#ifdef HERMESVM_API_TRACE
-    // Math.random() is a source of unpredictable behavior in JS, which needs to
-    // be mocked for synthetic benchmarks.
-    storage->tracedEnv.mathRandomSeed = seed;
-#endif
-  }
-  std::uniform_real_distribution<> dist(0.0, 1.0);
-  return HermesValue::encodeDoubleValue(dist(storage->randomEngine_));
+  return HermesValue::encodeDoubleValue(
+      runtime->getCommonStorage()->getRandomEngine().nextDouble());
 }
 
 // ES6.0 20.2.2.17
@@ -114,18 +114,10 @@ objectSetPrototypeOf(void *, Runtime *runtime, NativeArgs args);
 /// @name Object.prototype
 /// @{
 
-/// ES5.1 15.2.4.2.
-static CallResult<HermesValue>
-objectPrototypeToString(void *, Runtime *runtime, NativeArgs args);
-
 /// ES5.1 15.2.4.3.
 static CallResult<HermesValue>
 objectPrototypeToLocaleString(void *, Runtime *runtime, NativeArgs args);
 
-/// ES55.1 15.2.4.4 Object.prototype.valueOf.
-static CallResult<HermesValue>
-objectPrototypeValueOf(void *, Runtime *runtime, NativeArgs args);
-
 /// ES5.1 15.2.4.5.
 static CallResult<HermesValue>
 objectPrototypeHasOwnProperty(void *, Runtime *runtime, NativeArgs args);
@@ -1036,6 +1028,74 @@ objectIsExtensible(void *, Runtime *runtime, NativeArgs args) {
   return HermesValue::encodeBoolValue(obj->isExtensible());
 }
 
+CallResult<Handle<ArrayStorage>> getOwnPropertiesCache(
+    Runtime *runtime,
+    Handle<JSObject> obj) {
+  // Only the properties of plain objects are all described by their class,
+  // and only outside of dictionary mode is the class unchanged as long as the
+  // properties are. Index-like names would have to be sorted first.
+  if (obj->getKind() != CellKind::ObjectKind || obj->isHostObject() ||
+      obj->isLazy()) {
+    return runtime->makeNullHandle<ArrayStorage>();
+  }
+  auto clazz = runtime->makeHandle(obj->getClass(runtime));
+  if (clazz->isDictionary() || clazz->getHasIndexLikeProperties()) {
+    return runtime->makeNullHandle<ArrayStorage>();
+  }
+  if (ArrayStorage *cache = clazz->getOwnPropertiesCache(runtime)) {
+    return cache->at(kOwnPropsAllData).getBool()
+        ? runtime->makeHandle(cache)
+        : runtime->makeNullHandle<ArrayStorage>();
+  }
+
+  // Collect the properties listed by getOwnPropertyNames(), in the same
+  // order.
+  llvm::SmallVector<std::pair<SymbolID, SlotIndex>, 16> props{};
+  bool allData = true;
+  bool allDefault = true;
+  HiddenClass::forEachProperty(
+      clazz,
+      runtime,
+      [&props, &allData, &allDefault](
+          SymbolID id, NamedPropertyDescriptor desc) {
+        allDefault &= isPropertyNamePrimitive(id) &&
+            desc.flags == PropertyFlags::defaultNewNamedPropertyFlags();
+        if (isPropertyNamePrimitive(id) && desc.flags.enumerable) {
+          allData &= !desc.flags.accessor && !desc.flags.internalSetter;
+          props.push_back({id, desc.slot});
+        }
+      });
+  if (!allData)
+    props.clear();
+
+  auto arrRes = ArrayStorage::createLongLived(
+      runtime, kOwnPropsHeaderSize + props.size() * kOwnPropsEntrySize);
+  if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  MutableHandle<ArrayStorage> cache{runtime};
+  cache = vmcast<ArrayStorage>(*arrRes);
+  MutableHandle<> tmp{runtime};
+  auto push = [runtime, &cache, &tmp](HermesValue value) {
+    tmp = value;
+    return ArrayStorage::push_back(cache, runtime, tmp);
+  };
+  // The capacity is exact, so these can't fail.
+  (void)push(HermesValue::encodeBoolValue(allData));
+  (void)push(HermesValue::encodeBoolValue(allData && allDefault));
+  GCScopeMarkerRAII marker{runtime};
+  for (const auto &prop : props) {
+    marker.flush();
+    (void)push(HermesValue::encodeStringValue(
+        runtime->getStringPrimFromSymbolID(prop.first)));
+    (void)push(HermesValue::encodeSymbolValue(prop.first));
+    (void)push(HermesValue::encodeNumberValue(prop.second));
+  }
+  clazz->setOwnPropertiesCache(*cache, runtime);
+  return allData ? Handle<ArrayStorage>(cache)
+                 : runtime->makeNullHandle<ArrayStorage>();
+}
+
 namespace {
 /// "Kind" provided to enumerableOwnProperties to request different
 /// representation of the properties in the object.
@@ -1046,6 +1106,52 @@ enum class EnumerableOwnPropertiesKind {
 };
 } // namespace
 
+/// EnumerableOwnProperties of \p obj from \p cache, the result of
+/// getOwnPropertiesCache() for it.
+static CallResult<HermesValue> enumerableOwnPropertiesFromCache(
+    Runtime *runtime,
+    Handle<JSObject> obj,
+    Handle<ArrayStorage> cache,
+    EnumerableOwnPropertiesKind kind) {
+  const uint32_t len =
+      (cache->size() - kOwnPropsHeaderSize) / kOwnPropsEntrySize;
+  auto propertiesRes = JSArray::create(runtime, len, len);
+  if (LLVM_UNLIKELY(propertiesRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  auto properties = toHandle(runtime, std::move(*propertiesRes));
+
+  MutableHandle<> name{runtime};
+  MutableHandle<> value{runtime};
+  MutableHandle<> entry{runtime};
+  GCScopeMarkerRAII marker{runtime};
+  for (uint32_t i = 0; i < len; ++i) {
+    marker.flush();
+    const uint32_t base = kOwnPropsHeaderSize + i * kOwnPropsEntrySize;
+    name = cache->at(base + kOwnPropsName);
+    if (kind != EnumerableOwnPropertiesKind::Key) {
+      value = JSObject::getNamedSlotValue(
+          *obj,
+          runtime,
+          cache->at(base + kOwnPropsSlot).getNumberAs<SlotIndex>());
+    }
+    if (kind == EnumerableOwnPropertiesKind::KeyValue) {
+      auto entryRes = JSArray::create(runtime, 2, 2);
+      if (LLVM_UNLIKELY(entryRes == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      entry = entryRes->getHermesValue();
+      JSArray::setElementAt(Handle<JSArray>::vmcast(entry), runtime, 0, name);
+      JSArray::setElementAt(Handle<JSArray>::vmcast(entry), runtime, 1, value);
+    } else {
+      entry = kind == EnumerableOwnPropertiesKind::Key ? name.get()
+                                                       : value.get();
+    }
+    JSArray::setElementAt(properties, runtime, i, entry);
+  }
+  return properties.getHermesValue();
+}
+
 /// ES8.0 7.3.21.
 /// EnumerableOwnProperties gets the requested properties based on \p kind.
 static CallResult<HermesValue> enumerableOwnProperties(
@@ -1060,6 +1166,16 @@ static CallResult<HermesValue> enumerableOwnProperties(
   }
   auto objHandle = runtime->makeHandle<JSObject>(objRes.getValue());
 
+  // Fast path: the names and slots of the properties are cached in the class,
+  // and reading data properties can't run any code.
+  auto cacheRes = getOwnPropertiesCache(runtime, objHandle);
+  if (LLVM_UNLIKELY(cacheRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (Handle<ArrayStorage> cache = *cacheRes) {
+    return enumerableOwnPropertiesFromCache(runtime, objHandle, cache, kind);
+  }
+
   auto namesRes =
       getOwnPropertyNamesAsStrings(objHandle, runtime, true /*onlyEnumerable*/);
   if (namesRes == ExecutionStatus::EXCEPTION) {
@@ -1162,6 +1278,85 @@ objectEntries(void *, Runtime *runtime, NativeArgs args) {
       runtime, args, EnumerableOwnPropertiesKind::KeyValue);
 }
 
+/// \return whether giving \p to the class and the property values of an
+/// object described by \p cache, the result of getOwnPropertiesCache(), is
+/// the same as Object.assign() from that object to \p to.
+static bool
+canAdoptProperties(Runtime *runtime, JSObject *to, Handle<ArrayStorage> cache) {
+  if (!cache->at(kOwnPropsAllDefault).getBool() ||
+      to->getKind() != CellKind::ObjectKind || to->isHostObject() ||
+      to->isLazy() || !to->isExtensible()) {
+    return false;
+  }
+  HiddenClass *clazz = to->getClass(runtime);
+  if (clazz->isDictionary() || clazz->getNumProperties() != 0) {
+    return false;
+  }
+  // Set() would call the setters of the prototypes, or fail because of their
+  // read-only properties.
+  for (JSObject *proto = to->getParent(runtime); proto;
+       proto = proto->getParent(runtime)) {
+    if (proto->isHostObject())
+      return false;
+  }
+  if (!to->getParent(runtime))
+    return true;
+  auto parent = runtime->makeHandle(to->getParent(runtime));
+  GCScopeMarkerRAII marker{runtime};
+  for (uint32_t i = kOwnPropsHeaderSize, e = cache->size(); i < e;
+       i += kOwnPropsEntrySize) {
+    marker.flush();
+    NamedPropertyDescriptor desc;
+    if (JSObject::getNamedDescriptor(
+            parent, runtime, cache->at(i + kOwnPropsSymbol).getSymbol(), desc))
+      return false;
+  }
+  return true;
+}
+
+/// Object.assign() from \p from, described by \p cache, the result of
+/// getOwnPropertiesCache(), to \p to.
+static ExecutionStatus assignFromCache(
+    Runtime *runtime,
+    Handle<JSObject> to,
+    Handle<JSObject> from,
+    Handle<ArrayStorage> cache) {
+  // The setters of \p to may change \p from, after which its properties are
+  // looked up as usual.
+  auto clazz = runtime->makeHandle(from->getClass(runtime));
+  MutableHandle<> value{runtime};
+  GCScopeMarkerRAII marker{runtime};
+  for (uint32_t i = kOwnPropsHeaderSize, e = cache->size(); i < e;
+       i += kOwnPropsEntrySize) {
+    marker.flush();
+    SymbolID sym = cache->at(i + kOwnPropsSymbol).getSymbol();
+    if (LLVM_LIKELY(from->getClass(runtime) == *clazz)) {
+      value = JSObject::getNamedSlotValue(
+          *from,
+          runtime,
+          cache->at(i + kOwnPropsSlot).getNumberAs<SlotIndex>());
+    } else {
+      NamedPropertyDescriptor desc;
+      if (!JSObject::getOwnNamedDescriptor(from, runtime, sym, desc) ||
+          !desc.flags.enumerable) {
+        continue;
+      }
+      auto propRes = JSObject::getNamedPropertyValue(from, runtime, from, desc);
+      if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      value = *propRes;
+    }
+    if (LLVM_UNLIKELY(
+            JSObject::putNamed_RJS(
+                to, runtime, sym, value, PropOpFlags().plusThrowOnError()) ==
+            ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+  }
+  return ExecutionStatus::RETURNED;
+}
+
 static CallResult<HermesValue>
 objectAssign(void *, Runtime *runtime, NativeArgs args) {
   vm::GCScope gcScope(runtime);
@@ -1206,6 +1401,23 @@ objectAssign(void *, Runtime *runtime, NativeArgs args) {
     }
     fromHandle = vmcast<JSObject>(objRes.getValue());
 
+    // Fast paths: the names and slots of the properties of from are cached in
+    // its class. An empty object can even take the class of from.
+    auto cacheRes = getOwnPropertiesCache(runtime, fromHandle);
+    if (LLVM_UNLIKELY(cacheRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    if (Handle<ArrayStorage> cache = *cacheRes) {
+      if (canAdoptProperties(runtime, *toHandle, cache)) {
+        JSObject::adoptClassAndSlots(toHandle, runtime, fromHandle);
+      } else if (LLVM_UNLIKELY(
+                     assignFromCache(runtime, toHandle, fromHandle, cache) ==
+                     ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      continue;
+    }
+
     // 5.b.ii. Let keys be from.[[OwnPropertyKeys]]().
     auto cr = JSObject::getOwnPropertyNames(fromHandle, runtime, true);
     if (LLVM_UNLIKELY(cr == ExecutionStatus::EXCEPTION)) {
@@ -1316,10 +1528,14 @@ CallResult<HermesValue> directObjectPrototypeToString(
 
     auto O = runtime->makeHandle<JSObject>(res.getValue());
     // 16. Let tag be Get (O, @@toStringTag).
-    auto tagRes = JSObject::getNamed_RJS(
-        O, runtime, Predefined::getSymbolID(Predefined::SymbolToStringTag));
-    if (LLVM_UNLIKELY(tagRes == ExecutionStatus::EXCEPTION)) {
-      return ExecutionStatus::EXCEPTION;
+    CallResult<HermesValue> tagRes{HermesValue::encodeUndefinedValue()};
+    if (JSObject::mayHaveWellKnownSymbol(
+            *O, runtime, Predefined::SymbolToStringTag)) {
+      tagRes = JSObject::getNamed_RJS(
+          O, runtime, Predefined::getSymbolID(Predefined::SymbolToStringTag));
+      if (LLVM_UNLIKELY(tagRes == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
     }
 
     if (tagRes->isString()) {
@@ -1380,7 +1596,7 @@ CallResult<HermesValue> directObjectPrototypeToString(
   return HermesValue::encodeStringValue(str);
 }
 
-static CallResult<HermesValue>
+CallResult<HermesValue>
 objectPrototypeToString(void *, Runtime *runtime, NativeArgs args) {
   return directObjectPrototypeToString(runtime, args.getThisHandle());
 }
@@ -1405,7 +1621,7 @@ objectPrototypeToLocaleString(void *, Runtime *runtime, NativeArgs args) {
   return runtime->raiseTypeError("toString must be callable");
 }
 
-static CallResult<HermesValue>
+CallResult<HermesValue>
 objectPrototypeValueOf(void *, Runtime *runtime, NativeArgs args) {
   auto res = toObject(runtime, args.getThisHandle());
   if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
@@ -0,0 +1,1054 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+//===----------------------------------------------------------------------===//
+/// \file
+/// ES6.0 25.4 Promise objects, and the promise job queue (ES6.0 8.4).
+///
+/// The VM owns the job queue, Runtime::promiseJobQueue, which the embedder
+/// drains with Runtime::drainJobs(). Jobs are stored as plain values rather
+/// than as closures, and the promises derived by then() are settled directly
+/// instead of through resolving functions, so a `then` callback hop allocates
+/// no function objects.
+//===----------------------------------------------------------------------===//
+#include "JSLibInternal.h"
+
+#include "hermes/VM/ArrayStorage.h"
+#include "hermes/VM/JSArray.h"
+#include "hermes/VM/Operations.h"
+#include "hermes/VM/StackFrame-inline.h"
+
+namespace hermes {
+namespace vm {
+
+namespace {
+
+/// The fields of a PromiseReaction record (ES6.0 25.4.1.2), stored
+/// consecutively in the reactions of a pending promise. A reaction is
+/// registered for both outcomes at once, so it holds both handlers, which are
+/// undefined when they are not callable.
+enum ReactionField : unsigned {
+  ReactionOnFulfilled,
+  ReactionOnRejected,
+  /// The promise, resolve and reject fields of the capability of the reaction,
+  /// see PromiseCapability.
+  ReactionPromise,
+  ReactionResolve,
+  ReactionReject,
+  ReactionSize
+};
+
+/// The kinds of jobs of the promise job queue.
+enum class JobKind : uint32_t {
+  /// PromiseReactionJob, ES6.0 25.4.2.1, for a fulfilled promise.
+  Fulfill,
+  /// PromiseReactionJob, ES6.0 25.4.2.1, for a rejected promise.
+  Reject,
+  /// PromiseResolveThenableJob, ES6.0 25.4.2.2.
+  ResolveThenable,
+};
+
+/// The number of values of each job in the job queue. The first one is the
+/// JobKind, the others are:
+/// - Fulfill and Reject: the handler of the reaction, the promise, resolve and
+///   reject fields of its capability, and the argument.
+/// - ResolveThenable: the promise to resolve, the thenable and its `then`
+///   function.
+constexpr unsigned kJobSize = 6;
+
+/// The slots of the Environment of the resolving functions of a promise, ES6.0
+/// 25.4.1.3.
+enum ResolvingSlot : unsigned {
+  ResolvingPromise,
+  ResolvingAlreadyResolved,
+  ResolvingSize
+};
+
+/// The slots of the Environment of a GetCapabilitiesExecutor function, ES6.0
+/// 25.4.1.5.1.
+enum ExecutorSlot : unsigned { ExecutorResolve, ExecutorReject, ExecutorSize };
+
+/// The slots of the Environment shared by the resolve element functions of a
+/// Promise.all() call, ES6.0 25.4.4.1.2.
+enum AllSlot : unsigned { AllValues, AllResolve, AllRemaining, AllSize };
+
+/// The slots of the Environment of each resolve element function. Its parent
+/// is the shared Environment.
+enum ElementSlot : unsigned { ElementIndex, ElementAlreadyCalled, ElementSize };
+
+/// The slots of the Environment of the functions created by
+/// Promise.prototype.finally().
+enum FinallySlot : unsigned {
+  /// The onFinally argument, or the value to return or throw, for the
+  /// functions that onFinally's result is chained to.
+  FinallyValue,
+  FinallyConstructor,
+  FinallySize
+};
+
+/// A PromiseCapability record, ES6.0 25.4.1.1. When the capability was created
+/// for %Promise% and its functions are not needed, resolve and reject are
+/// undefined, and the promise is a JSPromise that is settled directly.
+struct PromiseCapability {
+  Handle<JSObject> promise;
+  Handle<> resolve;
+  Handle<> reject;
+};
+
+} // namespace
+
+/// \return the Environment of the native function being executed, which holds
+/// the values that it closes over.
+static Handle<Environment> getClosureEnvironment(Runtime *runtime) {
+  return runtime->makeHandle(
+      runtime->getCurrentFrame().getCalleeClosureUnsafe()->getEnvironment(
+          runtime));
+}
+
+/// Create an anonymous native function closing over \p env.
+static Handle<NativeFunction> createClosure(
+    Runtime *runtime,
+    Handle<Environment> env,
+    NativeFunctionPtr functionPtr,
+    unsigned paramCount) {
+  return NativeFunction::create(
+      runtime,
+      Handle<JSObject>::vmcast(&runtime->functionPrototype),
+      env,
+      nullptr,
+      functionPtr,
+      Predefined::getSymbolID(Predefined::emptyString),
+      paramCount,
+      Handle<JSObject>(runtime));
+}
+
+static void enqueueJob(
+    Runtime *runtime,
+    JobKind kind,
+    HermesValue a,
+    HermesValue b,
+    HermesValue c,
+    HermesValue d = HermesValue::encodeUndefinedValue(),
+    HermesValue e = HermesValue::encodeUndefinedValue()) {
+  auto &queue = runtime->promiseJobQueue;
+  queue.emplace_back(
+      HermesValue::encodeNativeUInt32(static_cast<uint32_t>(kind)));
+  queue.emplace_back(a);
+  queue.emplace_back(b);
+  queue.emplace_back(c);
+  queue.emplace_back(d);
+  queue.emplace_back(e);
+}
+
+/// FulfillPromise and RejectPromise, ES6.0 25.4.1.4 and 25.4.1.7: settle the
+/// pending \p promise and enqueue a job for each of its reactions.
+static void settlePromise(
+    Runtime *runtime,
+    Handle<JSObject> promise,
+    JSPromise::State state,
+    Handle<> value) {
+  assert(
+      JSPromise::getState(*promise, runtime) == JSPromise::State::Pending &&
+      "only pending promises can be settled");
+  HermesValue reactionsValue = JSPromise::getReactions(*promise, runtime);
+  JSPromise::settle(*promise, runtime, state, *value);
+  if (reactionsValue.isUndefined())
+    return;
+
+  // Enqueuing the jobs doesn't allocate in the heap.
+  auto *reactions = vmcast<ArrayStorage>(reactionsValue);
+  const bool fulfilled = state == JSPromise::State::Fulfilled;
+  for (ArrayStorage::size_type i = 0, e = reactions->size(); i < e;
+       i += ReactionSize) {
+    enqueueJob(
+        runtime,
+        fulfilled ? JobKind::Fulfill : JobKind::Reject,
+        reactions->at(
+            i + (fulfilled ? ReactionOnFulfilled : ReactionOnRejected)),
+        reactions->at(i + ReactionPromise),
+        reactions->at(i + ReactionResolve),
+        reactions->at(i + ReactionReject),
+        *value);
+  }
+}
+
+/// Clear the thrown value and return it, or return None if it is uncatchable
+/// and must be propagated.
+static llvm::Optional<Handle<>> catchThrownValue(Runtime *runtime) {
+  if (isUncatchableError(runtime->getThrownValue()))
+    return llvm::None;
+  auto thrown = runtime->makeHandle(runtime->getThrownValue());
+  runtime->clearThrownValue();
+  return thrown;
+}
+
+/// Reject \p promise with the thrown value.
+static ExecutionStatus rejectWithThrownValue(
+    Runtime *runtime,
+    Handle<JSObject> promise) {
+  auto thrown = catchThrownValue(runtime);
+  if (!thrown)
+    return ExecutionStatus::EXCEPTION;
+  settlePromise(runtime, promise, JSPromise::State::Rejected, *thrown);
+  return ExecutionStatus::RETURNED;
+}
+
+/// Resolve \p promise with \p resolution: steps 6 to 13 of the promise resolve
+/// functions, ES6.0 25.4.1.3.2, without the [[AlreadyResolved]] check.
+static ExecutionStatus resolvePromise(
+    Runtime *runtime,
+    Handle<JSObject> promise,
+    Handle<> resolution) {
+  if (resolution->isObject() && resolution->getObject() == promise.get()) {
+    runtime->raiseTypeError("Promise cannot be resolved with itself");
+    return rejectWithThrownValue(runtime, promise);
+  }
+  if (!resolution->isObject()) {
+    settlePromise(runtime, promise, JSPromise::State::Fulfilled, resolution);
+    return ExecutionStatus::RETURNED;
+  }
+
+  auto thenRes = JSObject::getNamed_RJS(
+      Handle<JSObject>::vmcast(resolution),
+      runtime,
+      Predefined::getSymbolID(Predefined::then));
+  if (LLVM_UNLIKELY(thenRes == ExecutionStatus::EXCEPTION))
+    return rejectWithThrownValue(runtime, promise);
+  if (!vmisa<Callable>(*thenRes)) {
+    settlePromise(runtime, promise, JSPromise::State::Fulfilled, resolution);
+    return ExecutionStatus::RETURNED;
+  }
+  enqueueJob(
+      runtime,
+      JobKind::ResolveThenable,
+      promise.getHermesValue(),
+      *resolution,
+      *thenRes);
+  return ExecutionStatus::RETURNED;
+}
+
+/// The promise resolve and reject functions, ES6.0 25.4.1.3.1 and 25.4.1.3.2.
+static CallResult<HermesValue>
+promiseResolvingFunction(Runtime *runtime, NativeArgs args, bool reject) {
+  auto env = getClosureEnvironment(runtime);
+  if (env->slot(ResolvingAlreadyResolved).getBool())
+    return HermesValue::encodeUndefinedValue();
+  env->slot(ResolvingAlreadyResolved)
+      .setNonPtr(HermesValue::encodeBoolValue(true));
+
+  auto promise = runtime->makeHandle(
+      vmcast<JSObject>(env->slot(ResolvingPromise)));
+  if (reject) {
+    settlePromise(
+        runtime,
+        promise,
+        JSPromise::State::Rejected,
+        args.getArgHandle(runtime, 0));
+  } else if (LLVM_UNLIKELY(
+                 resolvePromise(
+                     runtime, promise, args.getArgHandle(runtime, 0)) ==
+                 ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  return HermesValue::encodeUndefinedValue();
+}
+
+static CallResult<HermesValue>
+promiseResolveFunction(void *, Runtime *runtime, NativeArgs args) {
+  return promiseResolvingFunction(runtime, args, false);
+}
+
+static CallResult<HermesValue>
+promiseRejectFunction(void *, Runtime *runtime, NativeArgs args) {
+  return promiseResolvingFunction(runtime, args, true);
+}
+
+/// CreateResolvingFunctions, ES6.0 25.4.1.3.
+/// \return the resolve and reject functions of \p promise.
+static CallResult<std::pair<Handle<Callable>, Handle<Callable>>>
+createResolvingFunctions(Runtime *runtime, Handle<JSObject> promise) {
+  auto envRes = Environment::create(
+      runtime, runtime->makeNullHandle<Environment>(), ResolvingSize);
+  if (LLVM_UNLIKELY(envRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  auto env = runtime->makeHandle<Environment>(*envRes);
+  env->slot(ResolvingPromise)
+      .set(promise.getHermesValue(), &runtime->getHeap());
+  env->slot(ResolvingAlreadyResolved)
+      .setNonPtr(HermesValue::encodeBoolValue(false));
+
+  auto resolve = createClosure(runtime, env, promiseResolveFunction, 1);
+  auto reject = createClosure(runtime, env, promiseRejectFunction, 1);
+  return std::make_pair(Handle<Callable>(resolve), Handle<Callable>(reject));
+}
+
+/// GetCapabilitiesExecutor functions, ES6.0 25.4.1.5.1.
+static CallResult<HermesValue>
+getCapabilitiesExecutor(void *, Runtime *runtime, NativeArgs args) {
+  auto env = getClosureEnvironment(runtime);
+  if (!env->slot(ExecutorResolve).isUndefined() ||
+      !env->slot(ExecutorReject).isUndefined()) {
+    return runtime->raiseTypeError("Promise executor called more than once");
+  }
+  env->slot(ExecutorResolve).set(args.getArg(0), &runtime->getHeap());
+  env->slot(ExecutorReject).set(args.getArg(1), &runtime->getHeap());
+  return HermesValue::encodeUndefinedValue();
+}
+
+/// NewPromiseCapability, ES6.0 25.4.1.5, for the constructor \p C.
+/// \param needFunctions whether the capability must have resolve and reject
+///   functions. Otherwise, when \p C is %Promise%, they are left undefined
+///   and the new promise must be settled directly, at most once.
+static CallResult<PromiseCapability> newPromiseCapability(
+    Runtime *runtime,
+    Handle<> C,
+    bool needFunctions) {
+  if (!needFunctions && C->getRaw() == runtime->promiseConstructor.getRaw()) {
+    auto promiseRes = JSPromise::create(
+        runtime, Handle<JSObject>::vmcast(&runtime->promisePrototype));
+    if (LLVM_UNLIKELY(promiseRes == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    return PromiseCapability{runtime->makeHandle<JSObject>(*promiseRes),
+                             runtime->getUndefinedValue(),
+                             runtime->getUndefinedValue()};
+  }
+
+  if (!isConstructor(runtime, *C))
+    return runtime->raiseTypeError("Promise constructor is not a constructor");
+  auto envRes = Environment::create(
+      runtime, runtime->makeNullHandle<Environment>(), ExecutorSize);
+  if (LLVM_UNLIKELY(envRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  auto env = runtime->makeHandle<Environment>(*envRes);
+  auto executor = createClosure(runtime, env, getCapabilitiesExecutor, 2);
+
+  auto promiseRes = Callable::executeConstruct1(
+      Handle<Callable>::vmcast(C), runtime, executor);
+  if (LLVM_UNLIKELY(promiseRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  auto promise = runtime->makeHandle<JSObject>(*promiseRes);
+  auto resolve = runtime->makeHandle(env->slot(ExecutorResolve));
+  auto reject = runtime->makeHandle(env->slot(ExecutorReject));
+  if (!vmisa<Callable>(*resolve) || !vmisa<Callable>(*reject)) {
+    return runtime->raiseTypeError(
+        "Promise executor was not called with resolve and reject functions");
+  }
+  return PromiseCapability{promise, resolve, reject};
+}
+
+/// Resolve the promise of \p capability with \p value.
+static ExecutionStatus resolveCapability(
+    Runtime *runtime,
+    const PromiseCapability &capability,
+    Handle<> value) {
+  if (capability.resolve->isUndefined())
+    return resolvePromise(runtime, capability.promise, value);
+  return Callable::executeCall1(
+             Handle<Callable>::vmcast(capability.resolve),
+             runtime,
+             runtime->getUndefinedValue(),
+             *value)
+      .getStatus();
+}
+
+/// Reject the promise of \p capability with \p reason.
+static ExecutionStatus rejectCapability(
+    Runtime *runtime,
+    const PromiseCapability &capability,
+    Handle<> reason) {
+  if (capability.reject->isUndefined()) {
+    settlePromise(
+        runtime, capability.promise, JSPromise::State::Rejected, reason);
+    return ExecutionStatus::RETURNED;
+  }
+  return Callable::executeCall1(
+             Handle<Callable>::vmcast(capability.reject),
+             runtime,
+             runtime->getUndefinedValue(),
+             *reason)
+      .getStatus();
+}
+
+/// IfAbruptRejectPromise, ES6.0 25.4.1.1.1: reject the promise of
+/// \p capability with the thrown value and return the promise.
+static CallResult<HermesValue> rejectCapabilityWithThrownValue(
+    Runtime *runtime,
+    const PromiseCapability &capability) {
+  auto thrown = catchThrownValue(runtime);
+  if (!thrown)
+    return ExecutionStatus::EXCEPTION;
+  if (LLVM_UNLIKELY(
+          rejectCapability(runtime, capability, *thrown) ==
+          ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  return capability.promise.getHermesValue();
+}
+
+/// PerformPromiseThen, ES6.0 25.4.5.3.1.
+static ExecutionStatus performPromiseThen(
+    Runtime *runtime,
+    Handle<JSObject> promise,
+    Handle<> onFulfilled,
+    Handle<> onRejected,
+    const PromiseCapability &capability) {
+  auto fulfilledHandler = vmisa<Callable>(*onFulfilled)
+      ? onFulfilled
+      : runtime->getUndefinedValue();
+  auto rejectedHandler = vmisa<Callable>(*onRejected)
+      ? onRejected
+      : runtime->getUndefinedValue();
+
+  switch (JSPromise::getState(*promise, runtime)) {
+    case JSPromise::State::Pending: {
+      MutableHandle<ArrayStorage> reactions{runtime};
+      HermesValue reactionsValue = JSPromise::getReactions(*promise, runtime);
+      if (reactionsValue.isUndefined()) {
+        auto arrRes = ArrayStorage::create(runtime, ReactionSize);
+        if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION))
+          return ExecutionStatus::EXCEPTION;
+        reactions = vmcast<ArrayStorage>(*arrRes);
+      } else {
+        reactions = vmcast<ArrayStorage>(reactionsValue);
+      }
+      for (Handle<> field : {fulfilledHandler,
+                             rejectedHandler,
+                             Handle<>(capability.promise),
+                             capability.resolve,
+                             capability.reject}) {
+        if (LLVM_UNLIKELY(
+                ArrayStorage::push_back(reactions, runtime, field) ==
+                ExecutionStatus::EXCEPTION))
+          return ExecutionStatus::EXCEPTION;
+      }
+      // Appending may have reallocated the reactions.
+      JSPromise::setReactions(*promise, runtime, reactions.getHermesValue());
+      break;
+    }
+    case JSPromise::State::Fulfilled:
+      enqueueJob(
+          runtime,
+          JobKind::Fulfill,
+          *fulfilledHandler,
+          capability.promise.getHermesValue(),
+          *capability.resolve,
+          *capability.reject,
+          JSPromise::getResult(*promise, runtime));
+      break;
+    case JSPromise::State::Rejected:
+      enqueueJob(
+          runtime,
+          JobKind::Reject,
+          *rejectedHandler,
+          capability.promise.getHermesValue(),
+          *capability.resolve,
+          *capability.reject,
+          JSPromise::getResult(*promise, runtime));
+      break;
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+/// Invoke, ES6.0 7.3.18: call the method \p name of \p value with \p args.
+static CallResult<HermesValue> invokeMethod(
+    Runtime *runtime,
+    Handle<> value,
+    Predefined::Str name,
+    std::initializer_list<HermesValue> args) {
+  auto objRes = toObject(runtime, value);
+  if (LLVM_UNLIKELY(objRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  auto propRes = JSObject::getNamed_RJS(
+      runtime->makeHandle<JSObject>(*objRes),
+      runtime,
+      Predefined::getSymbolID(name));
+  if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  auto method =
+      Handle<Callable>::dyn_vmcast(runtime, runtime->makeHandle(*propRes));
+  if (!method) {
+    return runtime->raiseTypeErrorForValue(
+        runtime->makeHandle(*propRes), " is not a function");
+  }
+
+  assert(args.size() <= 2 && "too many arguments");
+  auto argIt = args.begin();
+  if (args.size() == 1)
+    return Callable::executeCall1(method, runtime, value, argIt[0]);
+  return Callable::executeCall2(method, runtime, value, argIt[0], argIt[1]);
+}
+
+/// PromiseReactionJob, ES6.0 25.4.2.1.
+static ExecutionStatus runReactionJob(
+    Runtime *runtime,
+    JobKind kind,
+    Handle<> handler,
+    const PromiseCapability &capability,
+    Handle<> argument) {
+  if (handler->isUndefined()) {
+    return kind == JobKind::Fulfill
+        ? resolveCapability(runtime, capability, argument)
+        : rejectCapability(runtime, capability, argument);
+  }
+  auto res = Callable::executeCall1(
+      Handle<Callable>::vmcast(handler),
+      runtime,
+      runtime->getUndefinedValue(),
+      *argument);
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+    auto thrown = catchThrownValue(runtime);
+    if (!thrown)
+      return ExecutionStatus::EXCEPTION;
+    return rejectCapability(runtime, capability, *thrown);
+  }
+  return resolveCapability(runtime, capability, runtime->makeHandle(*res));
+}
+
+/// PromiseResolveThenableJob, ES6.0 25.4.2.2.
+static ExecutionStatus runResolveThenableJob(
+    Runtime *runtime,
+    Handle<JSObject> promise,
+    Handle<> thenable,
+    Handle<Callable> then) {
+  auto fnsRes = createResolvingFunctions(runtime, promise);
+  if (LLVM_UNLIKELY(fnsRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  auto res = Callable::executeCall2(
+      then,
+      runtime,
+      thenable,
+      fnsRes->first.getHermesValue(),
+      fnsRes->second.getHermesValue());
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+    auto thrown = catchThrownValue(runtime);
+    if (!thrown)
+      return ExecutionStatus::EXCEPTION;
+    return Callable::executeCall1(
+               fnsRes->second, runtime, runtime->getUndefinedValue(), **thrown)
+        .getStatus();
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+ExecutionStatus drainPromiseJobs(Runtime *runtime) {
+  auto &queue = runtime->promiseJobQueue;
+  GCScope gcScope{runtime};
+  auto marker = gcScope.createMarker();
+  while (!queue.empty()) {
+    gcScope.flushToMarker(marker);
+    assert(queue.size() >= kJobSize && "incomplete job in the queue");
+    // Move the job to handles before running it, since it may enqueue more.
+    auto kind = static_cast<JobKind>(queue[0].getNativeUInt32());
+    Handle<> a = runtime->makeHandle(queue[1]);
+    Handle<> b = runtime->makeHandle(queue[2]);
+    Handle<> c = runtime->makeHandle(queue[3]);
+    Handle<> d = runtime->makeHandle(queue[4]);
+    Handle<> e = runtime->makeHandle(queue[5]);
+    queue.erase(queue.begin(), queue.begin() + kJobSize);
+
+    ExecutionStatus status;
+    if (kind == JobKind::ResolveThenable) {
+      status = runResolveThenableJob(
+          runtime, Handle<JSObject>::vmcast(a), b, Handle<Callable>::vmcast(c));
+    } else {
+      status = runReactionJob(
+          runtime, kind, a, {Handle<JSObject>::vmcast(b), c, d}, e);
+    }
+    if (LLVM_UNLIKELY(status == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+/// PromiseResolve: the steps of Promise.resolve(x) after checking that the
+/// constructor \p C is an object, ES6.0 25.4.4.5.
+static CallResult<HermesValue>
+promiseResolve(Runtime *runtime, Handle<> C, Handle<> x) {
+  if (vmisa<JSPromise>(*x)) {
+    auto consRes = JSObject::getNamed_RJS(
+        Handle<JSObject>::vmcast(x),
+        runtime,
+        Predefined::getSymbolID(Predefined::constructor));
+    if (LLVM_UNLIKELY(consRes == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    if (isSameValue(*consRes, *C))
+      return *x;
+  }
+  auto capRes = newPromiseCapability(runtime, C, false);
+  if (LLVM_UNLIKELY(capRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  if (LLVM_UNLIKELY(
+          resolveCapability(runtime, *capRes, x) == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  return capRes->promise.getHermesValue();
+}
+
+/// ES6.0 25.4.3.1
+static CallResult<HermesValue>
+promiseConstructor(void *, Runtime *runtime, NativeArgs args) {
+  GCScope gcScope{runtime};
+  if (LLVM_UNLIKELY(!args.isConstructorCall())) {
+    return runtime->raiseTypeError("Promise must be called as a constructor");
+  }
+  auto executor = args.dyncastArg<Callable>(runtime, 0);
+  if (LLVM_UNLIKELY(!executor)) {
+    return runtime->raiseTypeError("Promise executor is not a function");
+  }
+  auto selfHandle = args.dyncastThis<JSPromise>(runtime);
+  if (LLVM_UNLIKELY(!selfHandle)) {
+    return runtime->raiseTypeError(
+        "Promise constructor called on a non-promise");
+  }
+
+  auto fnsRes = createResolvingFunctions(runtime, selfHandle);
+  if (LLVM_UNLIKELY(fnsRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  auto res = Callable::executeCall2(
+      executor,
+      runtime,
+      runtime->getUndefinedValue(),
+      fnsRes->first.getHermesValue(),
+      fnsRes->second.getHermesValue());
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+    auto thrown = catchThrownValue(runtime);
+    if (!thrown)
+      return ExecutionStatus::EXCEPTION;
+    if (LLVM_UNLIKELY(
+            Callable::executeCall1(
+                fnsRes->second,
+                runtime,
+                runtime->getUndefinedValue(),
+                **thrown) == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+  }
+  return selfHandle.getHermesValue();
+}
+
+/// Promise.all resolve element functions, ES6.0 25.4.4.1.2.
+static CallResult<HermesValue>
+promiseAllResolveElement(void *, Runtime *runtime, NativeArgs args) {
+  auto env = getClosureEnvironment(runtime);
+  if (env->slot(ElementAlreadyCalled).getBool())
+    return HermesValue::encodeUndefinedValue();
+  env->slot(ElementAlreadyCalled)
+      .setNonPtr(HermesValue::encodeBoolValue(true));
+
+  auto shared = runtime->makeHandle(env->getParentEnvironment(runtime));
+  auto values = runtime->makeHandle(
+      vmcast<JSArray>(shared->slot(AllValues)));
+  JSArray::setElementAt(
+      values,
+      runtime,
+      env->slot(ElementIndex).getNumberAs<uint32_t>(),
+      args.getArgHandle(runtime, 0));
+  double remaining = shared->slot(AllRemaining).getNumber() - 1;
+  shared->slot(AllRemaining)
+      .setNonPtr(HermesValue::encodeNumberValue(remaining));
+  if (remaining == 0) {
+    return Callable::executeCall1(
+        Handle<Callable>::vmcast(runtime->makeHandle(shared->slot(AllResolve))),
+        runtime,
+        runtime->getUndefinedValue(),
+        values.getHermesValue());
+  }
+  return HermesValue::encodeUndefinedValue();
+}
+
+/// The loop of PerformPromiseAll and PerformPromiseRace, ES6.0 25.4.4.1.1 and
+/// 25.4.4.3.1, over the iterator \p iteratorRecord. Promise.all() passes the
+/// Environment shared by its resolve element functions as \p allEnv, and
+/// Promise.race() passes null.
+/// \return the promise of \p capability, or EXCEPTION if something threw.
+static CallResult<HermesValue> performPromiseAllOrRace(
+    Runtime *runtime,
+    const IteratorRecord &iteratorRecord,
+    Handle<> C,
+    const PromiseCapability &capability,
+    Handle<Environment> allEnv) {
+  GCScope gcScope{runtime};
+  MutableHandle<> nextValue{runtime};
+  MutableHandle<> nextPromise{runtime};
+  MutableHandle<> resolveElement{runtime};
+  auto marker = gcScope.createMarker();
+  for (uint32_t index = 0;; ++index) {
+    gcScope.flushToMarker(marker);
+    // Errors while stepping the iterator don't close it.
+    auto nextRes = iteratorStep(runtime, iteratorRecord);
+    if (LLVM_UNLIKELY(nextRes == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    if (!*nextRes)
+      break;
+    auto valueRes = JSObject::getNamed_RJS(
+        *nextRes, runtime, Predefined::getSymbolID(Predefined::value));
+    if (LLVM_UNLIKELY(valueRes == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    nextValue = *valueRes;
+
+    if (allEnv) {
+      auto values = runtime->makeHandle(
+          vmcast<JSArray>(allEnv->slot(AllValues)));
+      JSArray::setElementAt(
+          values, runtime, index, runtime->getUndefinedValue());
+      if (LLVM_UNLIKELY(
+              JSArray::setLengthProperty(values, runtime, index + 1) ==
+              ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+    }
+
+    auto promiseRes =
+        invokeMethod(runtime, C, Predefined::resolve, {*nextValue});
+    if (LLVM_UNLIKELY(promiseRes == ExecutionStatus::EXCEPTION))
+      return iteratorCloseAndRethrow(runtime, iteratorRecord.iterator);
+    nextPromise = *promiseRes;
+
+    if (allEnv) {
+      auto envRes = Environment::create(runtime, allEnv, ElementSize);
+      if (LLVM_UNLIKELY(envRes == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      auto env = runtime->makeHandle<Environment>(*envRes);
+      env->slot(ElementIndex)
+          .setNonPtr(HermesValue::encodeNumberValue(index));
+      env->slot(ElementAlreadyCalled)
+          .setNonPtr(HermesValue::encodeBoolValue(false));
+      resolveElement =
+          createClosure(runtime, env, promiseAllResolveElement, 1)
+              .getHermesValue();
+      allEnv->slot(AllRemaining)
+          .setNonPtr(HermesValue::encodeNumberValue(
+              allEnv->slot(AllRemaining).getNumber() + 1));
+    } else {
+      resolveElement = *capability.resolve;
+    }
+
+    if (LLVM_UNLIKELY(
+            invokeMethod(
+                runtime,
+                nextPromise,
+                Predefined::then,
+                {*resolveElement, *capability.reject}) ==
+            ExecutionStatus::EXCEPTION))
+      return iteratorCloseAndRethrow(runtime, iteratorRecord.iterator);
+  }
+
+  if (allEnv) {
+    double remaining = allEnv->slot(AllRemaining).getNumber() - 1;
+    allEnv->slot(AllRemaining)
+        .setNonPtr(HermesValue::encodeNumberValue(remaining));
+    if (remaining == 0) {
+      auto values = runtime->makeHandle(allEnv->slot(AllValues));
+      if (LLVM_UNLIKELY(
+              resolveCapability(runtime, capability, values) ==
+              ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+    }
+  }
+  return capability.promise.getHermesValue();
+}
+
+/// Promise.all and Promise.race, ES6.0 25.4.4.1 and 25.4.4.3.
+static CallResult<HermesValue>
+promiseAllOrRace(Runtime *runtime, NativeArgs args, bool all) {
+  GCScope gcScope{runtime};
+  auto C = args.getThisHandle();
+  if (!C->isObject())
+    return runtime->raiseTypeError("Promise constructor must be an object");
+  auto capRes = newPromiseCapability(runtime, C, true);
+  if (LLVM_UNLIKELY(capRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  const PromiseCapability &capability = *capRes;
+
+  auto iterRes = getIterator(runtime, args.getArgHandle(runtime, 0));
+  if (LLVM_UNLIKELY(iterRes == ExecutionStatus::EXCEPTION))
+    return rejectCapabilityWithThrownValue(runtime, capability);
+
+  Handle<Environment> allEnv = runtime->makeNullHandle<Environment>();
+  if (all) {
+    auto envRes = Environment::create(
+        runtime, runtime->makeNullHandle<Environment>(), AllSize);
+    if (LLVM_UNLIKELY(envRes == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    allEnv = runtime->makeHandle<Environment>(*envRes);
+    auto valuesRes = JSArray::create(runtime, 0, 0);
+    if (LLVM_UNLIKELY(valuesRes == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+    allEnv->slot(AllValues)
+        .set(valuesRes->getHermesValue(), &runtime->getHeap());
+    allEnv->slot(AllResolve).set(*capability.resolve, &runtime->getHeap());
+    allEnv->slot(AllRemaining).setNonPtr(HermesValue::encodeNumberValue(1));
+  }
+
+  auto res =
+      performPromiseAllOrRace(runtime, *iterRes, C, capability, allEnv);
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return rejectCapabilityWithThrownValue(runtime, capability);
+  return *res;
+}
+
+/// ES6.0 25.4.4.1
+static CallResult<HermesValue>
+promiseAll(void *, Runtime *runtime, NativeArgs args) {
+  return promiseAllOrRace(runtime, args, true);
+}
+
+/// ES6.0 25.4.4.3
+static CallResult<HermesValue>
+promiseRace(void *, Runtime *runtime, NativeArgs args) {
+  return promiseAllOrRace(runtime, args, false);
+}
+
+/// ES6.0 25.4.4.4
+static CallResult<HermesValue>
+promiseReject(void *, Runtime *runtime, NativeArgs args) {
+  GCScope gcScope{runtime};
+  auto C = args.getThisHandle();
+  if (!C->isObject())
+    return runtime->raiseTypeError("Promise constructor must be an object");
+  auto capRes = newPromiseCapability(runtime, C, false);
+  if (LLVM_UNLIKELY(capRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  if (LLVM_UNLIKELY(
+          rejectCapability(runtime, *capRes, args.getArgHandle(runtime, 0)) ==
+          ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  return capRes->promise.getHermesValue();
+}
+
+/// ES6.0 25.4.4.5
+static CallResult<HermesValue>
+promiseResolveMethod(void *, Runtime *runtime, NativeArgs args) {
+  GCScope gcScope{runtime};
+  auto C = args.getThisHandle();
+  if (!C->isObject())
+    return runtime->raiseTypeError("Promise constructor must be an object");
+  return promiseResolve(runtime, C, args.getArgHandle(runtime, 0));
+}
+
+/// ES6.0 25.4.5.1
+static CallResult<HermesValue>
+promisePrototypeCatch(void *, Runtime *runtime, NativeArgs args) {
+  GCScope gcScope{runtime};
+  return invokeMethod(
+      runtime,
+      args.getThisHandle(),
+      Predefined::then,
+      {HermesValue::encodeUndefinedValue(), args.getArg(0)});
+}
+
+/// ES6.0 25.4.5.3
+static CallResult<HermesValue>
+promisePrototypeThen(void *, Runtime *runtime, NativeArgs args) {
+  GCScope gcScope{runtime};
+  auto promise = args.dyncastThis<JSPromise>(runtime);
+  if (LLVM_UNLIKELY(!promise)) {
+    return runtime->raiseTypeError(
+        "Promise.prototype.then called on a non-promise");
+  }
+  auto consRes = speciesConstructor(
+      promise,
+      runtime,
+      Handle<Callable>::vmcast(&runtime->promiseConstructor));
+  if (LLVM_UNLIKELY(consRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  auto capRes = newPromiseCapability(runtime, *consRes, false);
+  if (LLVM_UNLIKELY(capRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  if (LLVM_UNLIKELY(
+          performPromiseThen(
+              runtime,
+              promise,
+              args.getArgHandle(runtime, 0),
+              args.getArgHandle(runtime, 1),
+              *capRes) == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  return capRes->promise.getHermesValue();
+}
+
+/// The function returned by a thunk created by Promise.prototype.finally(),
+/// which returns the value it closes over, or throws it.
+static CallResult<HermesValue>
+promiseFinallyThunk(Runtime *runtime, bool throws) {
+  auto env = getClosureEnvironment(runtime);
+  if (throws)
+    return runtime->setThrownValue(env->slot(FinallyValue));
+  return HermesValue{env->slot(FinallyValue)};
+}
+
+static CallResult<HermesValue>
+promiseFinallyValueThunk(void *, Runtime *runtime, NativeArgs) {
+  return promiseFinallyThunk(runtime, false);
+}
+
+static CallResult<HermesValue>
+promiseFinallyThrower(void *, Runtime *runtime, NativeArgs) {
+  return promiseFinallyThunk(runtime, true);
+}
+
+/// The Then Finally and Catch Finally functions, ES2018 25.6.5.3.1 and
+/// 25.6.5.3.2: call onFinally, wait for its result, then return the value or
+/// throw the reason passed to this function.
+static CallResult<HermesValue>
+promiseFinallyFunction(Runtime *runtime, NativeArgs args, bool reject) {
+  GCScope gcScope{runtime};
+  auto env = getClosureEnvironment(runtime);
+  auto onFinally = Handle<Callable>::vmcast(
+      runtime->makeHandle(env->slot(FinallyValue)));
+  auto C = runtime->makeHandle(env->slot(FinallyConstructor));
+  auto result = Callable::executeCall0(
+      onFinally, runtime, runtime->getUndefinedValue());
+  if (LLVM_UNLIKELY(result == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  auto promiseRes = promiseResolve(runtime, C, runtime->makeHandle(*result));
+  if (LLVM_UNLIKELY(promiseRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  auto promise = runtime->makeHandle(*promiseRes);
+
+  auto thunkEnvRes = Environment::create(
+      runtime, runtime->makeNullHandle<Environment>(), FinallySize);
+  if (LLVM_UNLIKELY(thunkEnvRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  auto thunkEnv = runtime->makeHandle<Environment>(*thunkEnvRes);
+  thunkEnv->slot(FinallyValue).set(args.getArg(0), &runtime->getHeap());
+  auto thunk = createClosure(
+      runtime,
+      thunkEnv,
+      reject ? promiseFinallyThrower : promiseFinallyValueThunk,
+      0);
+  return invokeMethod(
+      runtime, promise, Predefined::then, {thunk.getHermesValue()});
+}
+
+static CallResult<HermesValue>
+promiseThenFinally(void *, Runtime *runtime, NativeArgs args) {
+  return promiseFinallyFunction(runtime, args, false);
+}
+
+static CallResult<HermesValue>
+promiseCatchFinally(void *, Runtime *runtime, NativeArgs args) {
+  return promiseFinallyFunction(runtime, args, true);
+}
+
+/// ES2018 25.6.5.3
+static CallResult<HermesValue>
+promisePrototypeFinally(void *, Runtime *runtime, NativeArgs args) {
+  GCScope gcScope{runtime};
+  auto promise = args.dyncastThis<JSObject>(runtime);
+  if (LLVM_UNLIKELY(!promise)) {
+    return runtime->raiseTypeError(
+        "Promise.prototype.finally called on a non-object");
+  }
+  auto consRes = speciesConstructor(
+      promise,
+      runtime,
+      Handle<Callable>::vmcast(&runtime->promiseConstructor));
+  if (LLVM_UNLIKELY(consRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+
+  auto onFinally = args.getArgHandle(runtime, 0);
+  if (!vmisa<Callable>(*onFinally)) {
+    return invokeMethod(
+        runtime, promise, Predefined::then, {*onFinally, *onFinally});
+  }
+  auto envRes = Environment::create(
+      runtime, runtime->makeNullHandle<Environment>(), FinallySize);
+  if (LLVM_UNLIKELY(envRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  auto env = runtime->makeHandle<Environment>(*envRes);
+  env->slot(FinallyValue).set(*onFinally, &runtime->getHeap());
+  env->slot(FinallyConstructor)
+      .set(consRes->getHermesValue(), &runtime->getHeap());
+  auto thenFinally = createClosure(runtime, env, promiseThenFinally, 1);
+  auto catchFinally = createClosure(runtime, env, promiseCatchFinally, 1);
+  return invokeMethod(
+      runtime,
+      promise,
+      Predefined::then,
+      {thenFinally.getHermesValue(), catchFinally.getHermesValue()});
+}
+
+Handle<JSObject> createPromiseConstructor(Runtime *runtime) {
+  auto promisePrototype = Handle<JSObject>::vmcast(&runtime->promisePrototype);
+
+  defineMethod(
+      runtime,
+      promisePrototype,
+      Predefined::getSymbolID(Predefined::then),
+      nullptr,
+      promisePrototypeThen,
+      2);
+  defineMethod(
+      runtime,
+      promisePrototype,
+      Predefined::getSymbolID(Predefined::catchStr),
+      nullptr,
+      promisePrototypeCatch,
+      1);
+  defineMethod(
+      runtime,
+      promisePrototype,
+      Predefined::getSymbolID(Predefined::finallyStr),
+      nullptr,
+      promisePrototypeFinally,
+      1);
+
+  DefinePropertyFlags dpf = DefinePropertyFlags::getDefaultNewPropertyFlags();
+  dpf.writable = 0;
+  dpf.enumerable = 0;
+  defineProperty(
+      runtime,
+      promisePrototype,
+      Predefined::getSymbolID(Predefined::SymbolToStringTag),
+      runtime->getPredefinedStringHandle(Predefined::Promise),
+      dpf);
+
+  auto cons = defineSystemConstructor<JSPromise>(
+      runtime,
+      Predefined::getSymbolID(Predefined::Promise),
+      promiseConstructor,
+      promisePrototype,
+      1,
+      CellKind::PromiseKind);
+  runtime->promiseConstructor = cons.getHermesValue();
+
+  defineMethod(
+      runtime,
+      cons,
+      Predefined::getSymbolID(Predefined::all),
+      nullptr,
+      promiseAll,
+      1);
+  defineMethod(
+      runtime,
+      cons,
+      Predefined::getSymbolID(Predefined::race),
+      nullptr,
+      promiseRace,
+      1);
+  defineMethod(
+      runtime,
+      cons,
+      Predefined::getSymbolID(Predefined::reject),
+      nullptr,
+      promiseReject,
+      1);
+  defineMethod(
+      runtime,
+      cons,
+      Predefined::getSymbolID(Predefined::resolve),
+      nullptr,
+      promiseResolveMethod,
+      1);
+
+  // ES6.0 25.4.5.2
+  defineProperty(
+      runtime,
+      promisePrototype,
+      Predefined::getSymbolID(Predefined::constructor),
+      cons);
+
+  return cons;
+}
+
+} // namespace vm
+} // namespace hermes
@@ -13,6 +13,7 @@
 
 #include "hermes/VM/Operations.h"
 #include "hermes/VM/SmallXString.h"
+#include "hermes/VM/StringBuilder.h"
 #include "hermes/VM/StringPrimitive.h"
 #include "hermes/VM/StringView.h"
 
@@ -454,12 +455,15 @@ setLastIndex(Handle<JSObject> regexp, Runtime *runtime, double value) {
   return setLastIndex(regexp, runtime, HermesValue::encodeNumberValue(value));
 }
 
-CallResult<Handle<JSArray>> directRegExpExec(
+/// Perform the search of RegExp.prototype.exec() (ES5.1 15.10.6.2) with a
+/// this value of \p regexp and the argument \p S, including the reads and
+/// updates of lastIndex, without creating the result array.
+/// \return the match, which is empty if there is none.
+static CallResult<RegExpMatch> directRegExpSearch(
     Handle<JSRegExp> regexp,
     Runtime *runtime,
     Handle<StringPrimitive> S) {
   uint32_t length = S->getStringLength();
-  MutableHandle<JSArray> A{runtime};
   GCScope gcScope{runtime};
 
   // "Let lastIndex be the result of calling the [[Get]] internal method
@@ -505,7 +509,7 @@ CallResult<Handle<JSArray>> directRegExpExec(
             setLastIndex(regexp, runtime, 0) == ExecutionStatus::EXCEPTION)) {
       return ExecutionStatus::EXCEPTION;
     }
-    return runtime->makeNullHandle<JSArray>();
+    return match;
   }
 
   // We have a match!
@@ -520,6 +524,23 @@ CallResult<Handle<JSArray>> directRegExpExec(
       return ExecutionStatus::EXCEPTION;
     }
   }
+  return match;
+}
+
+CallResult<Handle<JSArray>> directRegExpExec(
+    Handle<JSRegExp> regexp,
+    Runtime *runtime,
+    Handle<StringPrimitive> S) {
+  MutableHandle<JSArray> A{runtime};
+  GCScope gcScope{runtime};
+
+  auto matchResult = directRegExpSearch(regexp, runtime, S);
+  if (LLVM_UNLIKELY(matchResult == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  auto match = *matchResult;
+  if (match.empty()) {
+    return runtime->makeNullHandle<JSArray>();
+  }
 
   const auto dpf = DefinePropertyFlags::getDefaultNewPropertyFlags();
 
@@ -1295,6 +1316,100 @@ CallResult<HermesValue> getSubstitution(
   return StringPrimitive::create(runtime, result);
 }
 
+bool hasSubstitutions(Runtime *runtime, Handle<StringPrimitive> replacement) {
+  auto view = StringPrimitive::createStringView(runtime, replacement);
+  return std::find(view.begin(), view.end(), u'$') != view.end();
+}
+
+/// \return true if the exec property of \p R is a data property holding the
+/// built-in RegExp.prototype.exec, so that RegExpExec(R, S) is unobservable
+/// apart from the accesses to lastIndex.
+static bool hasBuiltinExec(Runtime *runtime, Handle<JSObject> R) {
+  NamedPropertyDescriptor desc;
+  JSObject *owner = JSObject::getNamedDescriptor(
+      R, runtime, Predefined::getSymbolID(Predefined::exec), desc);
+  if (!owner || desc.flags.accessor || desc.flags.hostObject)
+    return false;
+  auto *exec = dyn_vmcast<NativeFunction>(
+      JSObject::getNamedSlotValue(owner, runtime, desc));
+  return exec && exec->getFunctionPtr() == regExpPrototypeExec;
+}
+
+/// Steps 11 to 18 of RegExp.prototype[@@replace] for a RegExp \p regexp with
+/// the built-in exec, and a replacement string \p replacement without $
+/// replacement strings. No user code can run between the searches, so the
+/// result arrays are not created: the matches are only recorded as ranges,
+/// and the result is written into a single StringBuilder.
+static CallResult<HermesValue> regExpReplaceWithoutSubstitutions(
+    Runtime *runtime,
+    Handle<JSRegExp> regexp,
+    Handle<StringPrimitive> S,
+    Handle<StringPrimitive> replacement,
+    bool global) {
+  uint32_t lengthS = S->getStringLength();
+  uint32_t replacementLength = replacement->getStringLength();
+  llvm::SmallVector<RegExpMatchRange, 8> matches{};
+  uint32_t matchedLength = 0;
+  {
+    GCScopeMarkerRAII marker{runtime};
+    while (true) {
+      marker.flush();
+      auto matchRes = directRegExpSearch(regexp, runtime, S);
+      if (LLVM_UNLIKELY(matchRes == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      if (matchRes->empty()) {
+        break;
+      }
+      RegExpMatchRange range = *matchRes->front();
+      // Every search starts after the previous match, so the matches don't
+      // overlap and are in order.
+      matches.push_back(range);
+      matchedLength += range.length;
+      if (!global) {
+        break;
+      }
+      if (range.length == 0) {
+        // lastIndex is the end of the empty match, move past it.
+        auto setStatus = setLastIndex(
+            regexp,
+            runtime,
+            advanceStringIndex(runtime, S, range.location, false));
+        if (LLVM_UNLIKELY(setStatus == ExecutionStatus::EXCEPTION)) {
+          return ExecutionStatus::EXCEPTION;
+        }
+      }
+    }
+  }
+  if (matches.empty()) {
+    return S.getHermesValue();
+  }
+
+  SafeUInt32 size{lengthS - matchedLength};
+  for (size_t i = 0, e = matches.size(); i < e; ++i) {
+    size.add(replacementLength);
+  }
+  if (size.isZero()) {
+    return HermesValue::encodeStringValue(
+        runtime->getPredefinedString(Predefined::emptyString));
+  }
+  auto builder = StringBuilder::createStringBuilder(
+      runtime, size, S->isASCII() && replacement->isASCII());
+  if (LLVM_UNLIKELY(builder == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  uint32_t nextSourcePosition = 0;
+  for (const auto &range : matches) {
+    builder->appendSubstring(
+        S, nextSourcePosition, range.location - nextSourcePosition);
+    builder->appendStringPrim(replacement);
+    nextSourcePosition = range.location + range.length;
+  }
+  builder->appendSubstring(
+      S, nextSourcePosition, lengthS - nextSourcePosition);
+  return builder->getStringPrimitive().getHermesValue();
+}
+
 /// ES6.0 21.2.5.8
 static CallResult<HermesValue>
 regExpPrototypeSymbolReplace(void *, Runtime *runtime, NativeArgs args) {
@@ -1351,6 +1466,13 @@ regExpPrototypeSymbolReplace(void *, Runtime *runtime, NativeArgs args) {
       return ExecutionStatus::EXCEPTION;
     }
   }
+  if (auto regexp = Handle<JSRegExp>::dyn_vmcast(runtime, rx)) {
+    if (!replaceFn && !hasSubstitutions(runtime, replaceValueStr) &&
+        hasBuiltinExec(runtime, rx)) {
+      return regExpReplaceWithoutSubstitutions(
+          runtime, regexp, S, replaceValueStr, global);
+    }
+  }
   // 11. Let results be a new empty List.
   auto arrRes = ArrayStorage::create(runtime, 16 /* capacity */);
   if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION)) {
@@ -7,6 +7,7 @@
 #include "hermes/VM/JSLib/RuntimeCommonStorage.h"
 
 #include <memory>
+#include <random>
 
 #include "hermes/VM/JSLib.h"
 
@@ -20,6 +21,21 @@ std::shared_ptr<RuntimeCommonStorage> createRuntimeCommonStorage() {
 RuntimeCommonStorage::RuntimeCommonStorage() {}
 RuntimeCommonStorage::~RuntimeCommonStorage() {}
 
+void RuntimeCommonStorage::seedRandomEngine() {
+#ifdef HERMESVM_SYNTH_REPLAY
+  std::minstd_rand::result_type seed = env.mathRandomSeed;
+#else
+  std::minstd_rand::result_type seed = std::random_device()();
+#endif
+  randomEngine_.seed(seed);
+  randomEngineSeeded_ = true;
+#ifdef HERMESVM_API_TRACE
+  // Math.random() is a source of unpredictable behavior in JS, which needs to
+  // be mocked for synthetic benchmarks.
+  tracedEnv.mathRandomSeed = seed;
+#endif
+}
+
 #ifdef __APPLE__
 /// Create the locale used for date formatting and collation. \return the
 /// locale, transferring ownership to the caller (the "create" rule).
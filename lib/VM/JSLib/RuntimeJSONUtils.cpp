@@ -6,6 +6,7 @@
  */
 #include "hermes/VM/JSLib/RuntimeJSONUtils.h"
 
+#include "hermes/Support/Conversions.h"
 #include "hermes/Support/JSON.h"
 #include "hermes/VM/ArrayStorage.h"
 #include "hermes/VM/Callable.h"
@@ -47,6 +48,10 @@ class RuntimeJSONParser {
   /// If it drops below 0 while parsing, raise a stack overflow.
   int32_t remainingDepth_{512};
 
+  /// How many named keys of an object parseObject() keeps track of, to add
+  /// them without checking whether they are already defined.
+  static constexpr unsigned kMaxTrackedKeys = 32;
+
  public:
   explicit RuntimeJSONParser(
       Runtime *runtime,
@@ -133,6 +138,10 @@ class JSONStringifyer {
   /// Handle used by operationJO to store K.
   MutableHandle<JSArray> operationJOK_;
 
+  /// Handle used by operationJO to store the class cache of the object, when
+  /// it is used instead of K.
+  MutableHandle<ArrayStorage> operationJOCache_;
+
   /// The holder argument passed to operationStr.
   /// We define a member variable here to avoid creating a new handle
   /// each time we are calling operationStr.
@@ -142,8 +151,10 @@ class JSONStringifyer {
   /// recursions. We track it using the number of gaps in the indent.
   uint32_t indentGapCount_{0};
 
-  /// The output buffer. The serialization process will append into it.
-  llvm::SmallVector<char16_t, 32> output_{};
+  /// The output buffer. The serialization process will append into it, and
+  /// it is moved into the result when it is large enough to be an external
+  /// string.
+  std::u16string output_{};
 
  public:
   explicit JSONStringifyer(Runtime *runtime)
@@ -157,6 +168,7 @@ class JSONStringifyer {
         tmpHandle2_(runtime),
         operationStrValue_(runtime),
         operationJOK_(runtime),
+        operationJOCache_(runtime),
         operationStrHolder_(runtime) {}
 
   LLVM_NODISCARD ExecutionStatus init(Handle<> replacer, Handle<> space) {
@@ -200,6 +212,10 @@ class JSONStringifyer {
   /// \return whether the result is not undefined.
   CallResult<bool> operationStr(HermesValue key);
 
+  /// Same as operationStr(key), where \p value is the value of holder[key],
+  /// which has already been read.
+  CallResult<bool> operationStr(HermesValue key, HermesValue value);
+
   /// Implement the abstract operation Quote(value).
   /// It wraps a String value in double quotes and escapes characters within it.
   void operationQuote(StringView value);
@@ -214,6 +230,16 @@ class JSONStringifyer {
   /// It serializes an object.
   ExecutionStatus operationJO();
 
+  /// The number of elements of a class cache per property: its name, its
+  /// quoted name, and its slot if it is a data property or undefined.
+  static constexpr uint32_t kClassCacheEntrySize = 3;
+
+  /// Set operationJOCache_ to the cache of the enumerable properties held by
+  /// the class of \p obj, creating it if needed. Set it to nullptr if the
+  /// class doesn't describe all the own properties of obj, in which case the
+  /// keys have to be obtained from getOwnPropertyNames().
+  ExecutionStatus initClassCache(Handle<JSObject> obj);
+
   /// Append '\n' and indent to output_.
   /// The indent is constructed according to indentGapCount_.
   void indent();
@@ -375,11 +401,19 @@ CallResult<HermesValue> RuntimeJSONParser::parseObject() {
       "Wrong entrance to parseObject");
   auto object = toHandle(runtime_, JSObject::create(runtime_));
 
-  if (LLVM_UNLIKELY(lexer_.advance() == ExecutionStatus::EXCEPTION)) {
+  if (LLVM_UNLIKELY(
+          lexer_.advanceStrAsSymbol() == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
   if (lexer_.getCurToken()->getKind() != JSONTokenKind::RBrace) {
     MutableHandle<StringPrimitive> key{runtime_};
+    MutableHandle<SymbolID> keySym{runtime_};
+    // The named keys added so far, while there are few enough of them to
+    // search. A key which is not among them can be added without looking it
+    // up first, which goes straight to the hidden class transition. Objects
+    // with the same keys in the same order share those transitions, so
+    // repeated records only look up the cached hidden class for each key.
+    llvm::SmallVector<SymbolID, kMaxTrackedKeys> addedKeys;
     GCScope gcScope{runtime_};
     auto marker = gcScope.createMarker();
     for (;;) {
@@ -389,7 +423,12 @@ CallResult<HermesValue> RuntimeJSONParser::parseObject() {
               lexer_.getCurToken()->getKind() != JSONTokenKind::String)) {
         return lexer_.error("Expect a string key in JSON object");
       }
-      key = lexer_.getCurToken()->getString().get();
+      bool isSymbol = lexer_.getCurToken()->isSymbol();
+      if (isSymbol) {
+        keySym = lexer_.getCurToken()->getSymbol().get();
+      } else {
+        key = lexer_.getCurToken()->getString().get();
+      }
 
       if (LLVM_UNLIKELY(lexer_.advance() == ExecutionStatus::EXCEPTION)) {
         return ExecutionStatus::EXCEPTION;
@@ -408,15 +447,41 @@ CallResult<HermesValue> RuntimeJSONParser::parseObject() {
         return ExecutionStatus::EXCEPTION;
       }
 
-      (void)JSObject::defineOwnComputedPrimitive(
-          object,
-          runtime_,
-          key,
-          DefinePropertyFlags::getDefaultNewPropertyFlags(),
-          runtime_->makeHandle(*parRes));
+      if (!isSymbol) {
+        // Array indexes are stored apart from the named properties.
+        (void)JSObject::defineOwnComputedPrimitive(
+            object,
+            runtime_,
+            key,
+            DefinePropertyFlags::getDefaultNewPropertyFlags(),
+            runtime_->makeHandle(*parRes));
+      } else if (
+          addedKeys.size() < kMaxTrackedKeys &&
+          !llvm::is_contained(addedKeys, keySym.get())) {
+        addedKeys.push_back(keySym.get());
+        if (LLVM_UNLIKELY(
+                JSObject::defineNewOwnProperty(
+                    object,
+                    runtime_,
+                    keySym.get(),
+                    PropertyFlags::defaultNewNamedPropertyFlags(),
+                    runtime_->makeHandle(*parRes)) ==
+                ExecutionStatus::EXCEPTION)) {
+          return ExecutionStatus::EXCEPTION;
+        }
+      } else {
+        // A repeated key replaces the earlier value.
+        (void)JSObject::defineOwnProperty(
+            object,
+            runtime_,
+            keySym.get(),
+            DefinePropertyFlags::getDefaultNewPropertyFlags(),
+            runtime_->makeHandle(*parRes));
+      }
 
       if (lexer_.getCurToken()->getKind() == JSONTokenKind::Comma) {
-        if (LLVM_UNLIKELY(lexer_.advance() == ExecutionStatus::EXCEPTION)) {
+        if (LLVM_UNLIKELY(
+                lexer_.advanceStrAsSymbol() == ExecutionStatus::EXCEPTION)) {
           return ExecutionStatus::EXCEPTION;
         }
         continue;
@@ -678,7 +743,16 @@ CallResult<bool> JSONStringifyer::operationStr(HermesValue key) {
   if (LLVM_UNLIKELY(propRes == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
-  operationStrValue_.set(*propRes);
+  return operationStr(*tmpHandle_, *propRes);
+}
+
+CallResult<bool> JSONStringifyer::operationStr(
+    HermesValue key,
+    HermesValue value) {
+  GCScopeMarkerRAII marker{runtime_};
+  tmpHandle_ = key;
+  operationStrValue_.set(value);
+  CallResult<HermesValue> propRes{ExecutionStatus::EXCEPTION};
 
   if (auto valueObj =
           Handle<JSObject>::dyn_vmcast(runtime_, operationStrValue_)) {
@@ -771,11 +845,11 @@ CallResult<bool> JSONStringifyer::operationStr(HermesValue key) {
   // Str.9.
   if (operationStrValue_->isNumber()) {
     if (std::isfinite(operationStrValue_->getNumber())) {
-      auto status = toString_RJS(runtime_, operationStrValue_);
-      assert(
-          status != ExecutionStatus::EXCEPTION &&
-          "toString on a number cannot fail");
-      appendToOutput(status->get());
+      // Format the number in place rather than creating a string for it.
+      char buf[NUMBER_TO_STRING_BUF_SIZE];
+      size_t len = numberToString(
+          operationStrValue_->getNumber(), buf, NUMBER_TO_STRING_BUF_SIZE);
+      output_.append(buf, buf + len);
     } else {
       appendToOutput(Predefined::getSymbolID(Predefined::null));
     }
@@ -814,7 +888,13 @@ CallResult<bool> JSONStringifyer::operationStr(HermesValue key) {
 }
 
 void JSONStringifyer::operationQuote(StringView value) {
-  quoteStringForJSON(output_, value);
+  if (value.isASCII()) {
+    quoteStringRefForJSON(
+        output_, ASCIIRef(value.castToCharPtr(), value.length()));
+  } else {
+    quoteStringRefForJSON(
+        output_, UTF16Ref(value.castToChar16Ptr(), value.length()));
+  }
 }
 
 ExecutionStatus JSONStringifyer::operationJA() {
@@ -885,26 +965,40 @@ ExecutionStatus JSONStringifyer::operationJO() {
   auto beginningLoc = output_.size();
   indent();
 
+  operationJOCache_ = nullptr;
   if (propertyList_) {
     // JO.5.
     operationJOK_ = propertyList_.get();
   } else {
     // JO.6.
     tmpHandle_ = stackValue_->at(stackValue_->size() - 1);
-    auto cr = JSObject::getOwnPropertyNames(
-        Handle<JSObject>::vmcast(tmpHandle_), runtime_, true);
-    if (cr == ExecutionStatus::EXCEPTION) {
+    if (LLVM_UNLIKELY(
+            initClassCache(Handle<JSObject>::vmcast(tmpHandle_)) ==
+            ExecutionStatus::EXCEPTION)) {
       return ExecutionStatus::EXCEPTION;
     }
-    operationJOK_ = **cr;
+    if (!operationJOCache_) {
+      auto cr = JSObject::getOwnPropertyNames(
+          Handle<JSObject>::vmcast(tmpHandle_), runtime_, true);
+      if (cr == ExecutionStatus::EXCEPTION) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      operationJOK_ = **cr;
+    }
   }
 
   marker.flush();
 
+  // With a class cache, the keys are the names of the cached properties,
+  // already quoted.
+  const bool useCache = operationJOCache_.get() != nullptr;
+  const uint32_t len = useCache
+      ? operationJOCache_->size() / kClassCacheEntrySize
+      : operationJOK_->getEndIndex();
+
   // JO.8.
   bool hasElement = false;
-  for (uint32_t index = 0, len = operationJOK_->getEndIndex(); index < len;
-       ++index) {
+  for (uint32_t index = 0; index < len; ++index) {
     // JO.8.a.
     // We are speculating that the Str operation will not return undefined,
     // and just append the key/value pair to the output. If it turns out
@@ -918,23 +1012,30 @@ ExecutionStatus JSONStringifyer::operationJO() {
       indent();
     }
 
-    tmpHandle_ = operationJOK_->at(runtime_, index);
-    if (LLVM_UNLIKELY(!tmpHandle_->isString())) {
-      // property may come from getOwnPropertyNames, which may contain numbers.
-      // getOwnPropertyNames and propertyList_ are both only populated
-      // with strings, numbers, and undefined only.
-      // None of them are objects, so toString cannot throw.
-      assert(!tmpHandle_->isObject() && "property name is an object");
-      auto status = toString_RJS(runtime_, tmpHandle_);
-      assert(
-          status != ExecutionStatus::EXCEPTION &&
-          "toString on a property cannot fail");
-      tmpHandle_ = status->getHermesValue();
+    if (useCache) {
+      uint32_t entry = index * kClassCacheEntrySize;
+      tmpHandle_ = operationJOCache_->at(entry);
+      // JO.8.b.i
+      appendToOutput(vmcast<StringPrimitive>(operationJOCache_->at(entry + 1)));
+    } else {
+      tmpHandle_ = operationJOK_->at(runtime_, index);
+      if (LLVM_UNLIKELY(!tmpHandle_->isString())) {
+        // property may come from getOwnPropertyNames, which may contain
+        // numbers. getOwnPropertyNames and propertyList_ are both only
+        // populated with strings, numbers, and undefined only.
+        // None of them are objects, so toString cannot throw.
+        assert(!tmpHandle_->isObject() && "property name is an object");
+        auto status = toString_RJS(runtime_, tmpHandle_);
+        assert(
+            status != ExecutionStatus::EXCEPTION &&
+            "toString on a property cannot fail");
+        tmpHandle_ = status->getHermesValue();
+      }
+      // tmpHandle now contains property as string.
+      // JO.8.b.i
+      operationQuote(StringPrimitive::createStringView(
+          runtime_, Handle<StringPrimitive>::vmcast(tmpHandle_)));
     }
-    // tmpHandle now contains property as string.
-    // JO.8.b.i
-    operationQuote(StringPrimitive::createStringView(
-        runtime_, Handle<StringPrimitive>::vmcast(tmpHandle_)));
     // JO.8.b.ii
     output_.push_back(u':');
     // JO.8.b.iii
@@ -946,7 +1047,11 @@ ExecutionStatus JSONStringifyer::operationJO() {
     operationStrHolder_ =
         vmcast<JSObject>(stackValue_->at(stackValue_->size() - 1));
 
-    tmpHandle2_ = operationJOK_.getHermesValue();
+    if (useCache) {
+      tmpHandle2_ = operationJOCache_.getHermesValue();
+    } else {
+      tmpHandle2_ = operationJOK_.getHermesValue();
+    }
     if (propStoragePushBack(stackJO_, runtime_, tmpHandle2_) ==
         ExecutionStatus::EXCEPTION) {
       return ExecutionStatus::EXCEPTION;
@@ -954,9 +1059,32 @@ ExecutionStatus JSONStringifyer::operationJO() {
 
     // Flush just before recursion (propStoragePushBack may create handles).
     marker.flush();
-    auto result = operationStr(*tmpHandle_);
+    CallResult<bool> result{ExecutionStatus::EXCEPTION};
+    HermesValue slot = useCache
+        ? operationJOCache_->at(index * kClassCacheEntrySize + 2)
+        : HermesValue::encodeUndefinedValue();
+    // A data property is read directly from its slot, as long as the object
+    // still has the class of the cache: toJSON or the replacer function may
+    // have changed it while serializing the previous properties.
+    if (slot.isNumber() &&
+        operationStrHolder_->getClass(runtime_)->getJSONCache(runtime_) ==
+            operationJOCache_.get()) {
+      result = operationStr(
+          *tmpHandle_,
+          JSObject::getNamedSlotValue(
+              operationStrHolder_.get(),
+              runtime_,
+              slot.getNumberAs<SlotIndex>()));
+    } else {
+      result = operationStr(*tmpHandle_);
+    }
 
-    operationJOK_ = vmcast<JSArray>(stackJO_->at(stackJO_->size() - 1));
+    tmpHandle2_ = stackJO_->at(stackJO_->size() - 1);
+    if (useCache) {
+      operationJOCache_ = vmcast<ArrayStorage>(*tmpHandle2_);
+    } else {
+      operationJOK_ = vmcast<JSArray>(*tmpHandle2_);
+    }
     assert(stackJO_->size() && "Cannot pop from an empty stack");
     PropStorage::resizeWithinCapacity(stackJO_, runtime_, stackJO_->size() - 1);
 
@@ -985,6 +1113,82 @@ ExecutionStatus JSONStringifyer::operationJO() {
   return ExecutionStatus::RETURNED;
 }
 
+ExecutionStatus JSONStringifyer::initClassCache(Handle<JSObject> obj) {
+  operationJOCache_ = nullptr;
+  // Only the properties of plain objects are all described by their class,
+  // and only outside of dictionary mode is the class unchanged as long as the
+  // properties are. Index-like names would have to be sorted first.
+  if (obj->getKind() != CellKind::ObjectKind || obj->isHostObject() ||
+      obj->isLazy()) {
+    return ExecutionStatus::RETURNED;
+  }
+  auto clazz = runtime_->makeHandle(obj->getClass(runtime_));
+  if (clazz->isDictionary() || clazz->getHasIndexLikeProperties()) {
+    return ExecutionStatus::RETURNED;
+  }
+  if (ArrayStorage *cache = clazz->getJSONCache(runtime_)) {
+    operationJOCache_ = cache;
+    return ExecutionStatus::RETURNED;
+  }
+
+  // Collect the properties listed by getOwnPropertyNames(), in the same
+  // order.
+  llvm::SmallVector<std::pair<SymbolID, NamedPropertyDescriptor>, 16> props{};
+  HiddenClass::forEachProperty(
+      clazz, runtime_, [&props](SymbolID id, NamedPropertyDescriptor desc) {
+        if (isPropertyNamePrimitive(id) && desc.flags.enumerable) {
+          props.push_back({id, desc});
+        }
+      });
+  auto arrRes = ArrayStorage::createLongLived(
+      runtime_, props.size() * kClassCacheEntrySize);
+  if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  operationJOCache_ = vmcast<ArrayStorage>(*arrRes);
+
+  llvm::SmallVector<char16_t, 32> quoted{};
+  GCScopeMarkerRAII marker{runtime_};
+  for (const auto &prop : props) {
+    marker.flush();
+    // The name.
+    tmpHandle2_ = HermesValue::encodeStringValue(
+        runtime_->getStringPrimFromSymbolID(prop.first));
+    if (LLVM_UNLIKELY(
+            ArrayStorage::push_back(operationJOCache_, runtime_, tmpHandle2_) ==
+            ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    // The quoted name.
+    quoted.clear();
+    quoteStringForJSON(
+        quoted,
+        runtime_->getIdentifierTable().getStringView(runtime_, prop.first));
+    auto strRes = StringPrimitive::createEfficient(runtime_, quoted);
+    if (LLVM_UNLIKELY(strRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    tmpHandle2_ = *strRes;
+    if (LLVM_UNLIKELY(
+            ArrayStorage::push_back(operationJOCache_, runtime_, tmpHandle2_) ==
+            ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    // The slot, or undefined for an accessor which has to be called.
+    const NamedPropertyDescriptor &desc = prop.second;
+    tmpHandle2_ = desc.flags.accessor
+        ? HermesValue::encodeUndefinedValue()
+        : HermesValue::encodeNumberValue(desc.slot);
+    if (LLVM_UNLIKELY(
+            ArrayStorage::push_back(operationJOCache_, runtime_, tmpHandle2_) ==
+            ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+  }
+  clazz->setJSONCache(*operationJOCache_, runtime_);
+  return ExecutionStatus::RETURNED;
+}
+
 void JSONStringifyer::indent() {
   if (gap_.get()) {
     output_.push_back(u'\n');
@@ -1022,7 +1226,13 @@ void JSONStringifyer::appendToOutput(SymbolID identifierID) {
 }
 
 void JSONStringifyer::appendToOutput(const StringPrimitive *str) {
-  str->copyUTF16String(output_);
+  if (str->isASCII()) {
+    auto ref = str->getStringRef<char>();
+    output_.append(ref.begin(), ref.end());
+  } else {
+    auto ref = str->getStringRef<char16_t>();
+    output_.append(ref.begin(), ref.end());
+  }
 }
 
 CallResult<HermesValue> JSONStringifyer::stringify(Handle<> value) {
@@ -1050,7 +1260,7 @@ CallResult<HermesValue> JSONStringifyer::stringify(Handle<> value) {
     return ExecutionStatus::EXCEPTION;
   }
   if (status.getValue()) {
-    return StringPrimitive::create(runtime_, output_);
+    return StringPrimitive::createEfficient(runtime_, std::move(output_));
   } else {
     return HermesValue::encodeUndefinedValue();
   }
@@ -278,7 +278,11 @@ setPrototypeAdd(void *, Runtime *runtime, NativeArgs args) {
         "Method Set.prototype.add called on incompatible receiver");
   }
   auto valueHandle = args.getArgHandle(runtime, 0);
-  JSSet::addValue(selfHandle, runtime, valueHandle, valueHandle);
+  if (LLVM_UNLIKELY(
+          JSSet::addValue(selfHandle, runtime, valueHandle, valueHandle) ==
+          ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
   return selfHandle.getHermesValue();
 }
 
@@ -293,7 +297,10 @@ setPrototypeClear(void *, Runtime *runtime, NativeArgs args) {
     return runtime->raiseTypeError(
         "Method Set.prototype.clear called on incompatible receiver");
   }
-  JSSet::clear(selfHandle, runtime);
+  if (LLVM_UNLIKELY(
+          JSSet::clear(selfHandle, runtime) == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
   return HermesValue::encodeUndefinedValue();
 }
 
@@ -419,6 +426,9 @@ Handle<JSObject> createSetIteratorPrototype(Runtime *runtime) {
       nullptr,
       setIteratorPrototypeNext,
       0);
+  runtime->setIteratorPrototypeNext =
+      runtime->ignoreAllocationFailure(JSObject::getNamed_RJS(
+          parentHandle, runtime, Predefined::getSymbolID(Predefined::next)));
 
   auto dpf = DefinePropertyFlags::getDefaultNewPropertyFlags();
   dpf.writable = 0;
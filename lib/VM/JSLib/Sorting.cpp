@@ -6,11 +6,18 @@
  */
 #include "Sorting.h"
 
+#include "hermes/Inst/InstDecode.h"
 #include "hermes/Support/Compiler.h"
+#include "hermes/VM/Callable.h"
+#include "hermes/VM/CodeBlock.h"
+#include "hermes/VM/Runtime.h"
 
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/MathExtras.h"
 
+#include <algorithm>
 #include <cstdio>
+#include <vector>
 
 namespace hermes {
 namespace vm {
@@ -264,6 +271,191 @@ quicksort_top:
   return ExecutionStatus::RETURNED;
 }
 
+/// Runs shorter than this are extended with binary insertion sort.
+const uint32_t TIMSORT_MIN_MERGE = 32;
+
+/// The state of one call to timSort().
+class TimSorter {
+ public:
+  using LessFn = llvm::function_ref<CallResult<bool>(uint32_t, uint32_t)>;
+
+  TimSorter(llvm::MutableArrayRef<uint32_t> order, LessFn less)
+      : order_(order), less_(less) {}
+
+  ExecutionStatus sort() {
+    uint32_t size = order_.size();
+    uint32_t minRun = minRunLength(size);
+    for (uint32_t lo = 0; lo < size;) {
+      CallResult<uint32_t> runEnd = countRunAndMakeAscending(lo);
+      if (LLVM_UNLIKELY(runEnd == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      // Extend short runs to minRun elements.
+      uint32_t end = *runEnd;
+      if (end - lo < minRun) {
+        uint32_t forced = std::min(size, lo + minRun);
+        if (binaryInsertionSort(lo, forced, end) ==
+            ExecutionStatus::EXCEPTION) {
+          return ExecutionStatus::EXCEPTION;
+        }
+        end = forced;
+      }
+      runs_.push_back({lo, end - lo});
+      if (mergeCollapse() == ExecutionStatus::EXCEPTION) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      lo = end;
+    }
+
+    // Merge the remaining runs, from the top of the stack.
+    while (runs_.size() > 1) {
+      size_t n = runs_.size() - 2;
+      if (n > 0 && runs_[n - 1].length < runs_[n + 1].length) {
+        --n;
+      }
+      if (mergeAt(n) == ExecutionStatus::EXCEPTION) {
+        return ExecutionStatus::EXCEPTION;
+      }
+    }
+    return ExecutionStatus::RETURNED;
+  }
+
+ private:
+  /// A sorted run of order_.
+  struct Run {
+    uint32_t base;
+    uint32_t length;
+  };
+
+  /// \return the minimum run length for sorting \p n elements, so that the
+  /// number of runs is a power of two, or slightly less than one.
+  static uint32_t minRunLength(uint32_t n) {
+    uint32_t r = 0;
+    while (n >= TIMSORT_MIN_MERGE) {
+      r |= n & 1;
+      n >>= 1;
+    }
+    return n + r;
+  }
+
+  /// Find the run starting at \p lo, reversing it if it is strictly
+  /// descending, so that reversing it keeps the sort stable.
+  /// \return the end of the run.
+  CallResult<uint32_t> countRunAndMakeAscending(uint32_t lo) {
+    uint32_t size = order_.size();
+    uint32_t run = lo + 1;
+    if (run == size) {
+      return run;
+    }
+    CallResult<bool> res = less_(order_[run], order_[lo]);
+    if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    bool descending = *res;
+    for (++run; run < size; ++run) {
+      res = less_(order_[run], order_[run - 1]);
+      if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      if (*res != descending) {
+        break;
+      }
+    }
+    if (descending) {
+      std::reverse(order_.begin() + lo, order_.begin() + run);
+    }
+    return run;
+  }
+
+  /// Sort [lo, hi), whose elements [lo, start) are already sorted.
+  ExecutionStatus
+  binaryInsertionSort(uint32_t lo, uint32_t hi, uint32_t start) {
+    for (uint32_t i = start; i < hi; ++i) {
+      uint32_t pivot = order_[i];
+      // Find the position after all the elements that pivot isn't less than.
+      uint32_t left = lo;
+      uint32_t right = i;
+      while (left < right) {
+        uint32_t mid = left + (right - left) / 2;
+        CallResult<bool> res = less_(pivot, order_[mid]);
+        if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+          return ExecutionStatus::EXCEPTION;
+        }
+        if (*res) {
+          right = mid;
+        } else {
+          left = mid + 1;
+        }
+      }
+      std::move_backward(
+          order_.begin() + left, order_.begin() + i, order_.begin() + i + 1);
+      order_[left] = pivot;
+    }
+    return ExecutionStatus::RETURNED;
+  }
+
+  /// Merge runs until the lengths on the stack decrease faster than the
+  /// Fibonacci numbers, which keeps the merges balanced.
+  ExecutionStatus mergeCollapse() {
+    while (runs_.size() > 1) {
+      size_t n = runs_.size() - 2;
+      if ((n > 0 &&
+           runs_[n - 1].length <= runs_[n].length + runs_[n + 1].length) ||
+          (n > 1 &&
+           runs_[n - 2].length <= runs_[n - 1].length + runs_[n].length)) {
+        if (runs_[n - 1].length < runs_[n + 1].length) {
+          --n;
+        }
+      } else if (runs_[n].length > runs_[n + 1].length) {
+        break;
+      }
+      if (mergeAt(n) == ExecutionStatus::EXCEPTION) {
+        return ExecutionStatus::EXCEPTION;
+      }
+    }
+    return ExecutionStatus::RETURNED;
+  }
+
+  /// Merge the runs at \p n and \p n + 1 of the stack.
+  ExecutionStatus mergeAt(size_t n) {
+    Run a = runs_[n];
+    Run b = runs_[n + 1];
+    runs_[n].length = a.length + b.length;
+    runs_.erase(runs_.begin() + n + 1);
+
+    // Copy the first run out, and merge into its place. Elements of the
+    // second run only go first if they are less, which keeps it stable.
+    tmp_.assign(order_.begin() + a.base, order_.begin() + a.base + a.length);
+    uint32_t *out = order_.begin() + a.base;
+    uint32_t *left = tmp_.data();
+    uint32_t *leftEnd = left + a.length;
+    uint32_t *right = order_.begin() + b.base;
+    uint32_t *rightEnd = right + b.length;
+    while (left != leftEnd && right != rightEnd) {
+      CallResult<bool> res = less_(*right, *left);
+      if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      *out++ = *res ? *right++ : *left++;
+    }
+    // Whatever is left of the second run is already in place.
+    std::copy(left, leftEnd, out);
+    return ExecutionStatus::RETURNED;
+  }
+
+  /// The indices being sorted.
+  llvm::MutableArrayRef<uint32_t> order_;
+
+  /// Compares the elements at two indices.
+  LessFn less_;
+
+  /// The stack of runs that haven't been merged yet.
+  llvm::SmallVector<Run, 16> runs_{};
+
+  /// Holds the first of the two runs being merged.
+  std::vector<uint32_t> tmp_{};
+};
+
 } // namespace
 
 ExecutionStatus quickSort(SortModel *sm, uint32_t begin, uint32_t end) {
@@ -274,5 +466,78 @@ ExecutionStatus quickSort(SortModel *sm, uint32_t begin, uint32_t end) {
   }
 }
 
+ExecutionStatus timSort(
+    llvm::MutableArrayRef<uint32_t> order,
+    llvm::function_ref<CallResult<bool>(uint32_t a, uint32_t b)> less) {
+  return TimSorter(order, less).sort();
+}
+
+NumericCompareFn recognizeNumericCompareFn(
+    Runtime *runtime,
+    Callable *compareFn) {
+  using inst::Inst;
+  using inst::OpCode;
+
+  auto *func = dyn_vmcast_or_null<JSFunction>(compareFn);
+  if (!func) {
+    return NumericCompareFn::None;
+  }
+#ifdef HERMES_ENABLE_DEBUGGER
+  if (runtime->getDebugger().getIsDebuggerAttached()) {
+    return NumericCompareFn::None;
+  }
+#endif
+  CodeBlock *codeBlock = func->getCodeBlock();
+  if (codeBlock->isLazy()) {
+    return NumericCompareFn::None;
+  }
+
+  // What each register is known to hold. The function must be straight-line
+  // code which only loads its parameters, moves them, subtracts them and
+  // returns the difference.
+  enum Value : uint8_t { Unknown, FirstParam, SecondParam, Diff, NegDiff };
+  Value regs[256] = {};
+  const uint8_t *ip = codeBlock->begin();
+  const uint8_t *end = codeBlock->end();
+  while (ip < end) {
+    auto *inst = reinterpret_cast<const Inst *>(ip);
+    switch (inst->opCode) {
+      case OpCode::LoadParam: {
+        uint8_t param = inst->iLoadParam.op2;
+        regs[inst->iLoadParam.op1] = param == 1
+            ? FirstParam
+            : param == 2 ? SecondParam : Unknown;
+        break;
+      }
+      case OpCode::Mov:
+        regs[inst->iMov.op1] = regs[inst->iMov.op2];
+        break;
+      case OpCode::Sub:
+      case OpCode::SubN: {
+        // Sub and SubN have the same operands.
+        Value a = regs[inst->iSub.op2];
+        Value b = regs[inst->iSub.op3];
+        regs[inst->iSub.op1] = a == FirstParam && b == SecondParam
+            ? Diff
+            : a == SecondParam && b == FirstParam ? NegDiff : Unknown;
+        break;
+      }
+      case OpCode::Ret:
+        switch (regs[inst->iRet.op1]) {
+          case Diff:
+            return NumericCompareFn::Ascending;
+          case NegDiff:
+            return NumericCompareFn::Descending;
+          default:
+            return NumericCompareFn::None;
+        }
+      default:
+        return NumericCompareFn::None;
+    }
+    ip += inst::getInstSize(inst->opCode);
+  }
+  return NumericCompareFn::None;
+}
+
 } // namespace vm
 } // namespace hermes
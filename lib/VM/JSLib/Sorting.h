@@ -11,6 +11,9 @@
 
 #include "hermes/VM/CallResult.h"
 
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
+
 /// Defines custom sorting routines used in cases that we can't use std::sort.
 /// std::sort doesn't always use std::swap, performing operations that bypass
 /// the user-defined swap routines. When calling [[Put]] and [[Delete]], we
@@ -20,6 +23,9 @@
 namespace hermes {
 namespace vm {
 
+class Callable;
+class Runtime;
+
 /// Abstraction to define a comparison-based sorting routine.
 /// The SortModel has two operations: swap and compare.
 class SortModel {
@@ -37,6 +43,37 @@ class SortModel {
 /// with ExecutionStatus::EXCEPTION if any compare or swap operations fail.
 ExecutionStatus quickSort(SortModel *sm, uint32_t begin, uint32_t end);
 
+/// Stable TimSort of the indices in \p order, where \p less(a, b) tells
+/// whether the element at index a comes before the one at index b. Unlike
+/// quickSort, this sorts a list of indices instead of swapping the elements,
+/// so the caller can sort a copy of the elements and write them back once.
+/// Returns immediately with ExecutionStatus::EXCEPTION if any comparison
+/// fails, leaving \p order in an unspecified order.
+ExecutionStatus timSort(
+    llvm::MutableArrayRef<uint32_t> order,
+    llvm::function_ref<CallResult<bool>(uint32_t a, uint32_t b)> less);
+
+/// The order that a compare function for sort() is known to impose on
+/// numbers without calling it.
+enum class NumericCompareFn {
+  /// Nothing is known about the function.
+  None,
+  /// The function is `(a, b) => a - b`.
+  Ascending,
+  /// The function is `(a, b) => b - a`.
+  Descending,
+};
+
+/// Recognize a \p compareFn whose bytecode only returns the difference of its
+/// first two parameters. When both arguments are numbers, such a function has
+/// no side effects and its result is negative exactly when a < b (or b < a),
+/// so the sort can compare the numbers itself instead of calling it.
+/// Nothing is recognized while a debugger is attached, since it could stop in
+/// the function.
+NumericCompareFn recognizeNumericCompareFn(
+    Runtime *runtime,
+    Callable *compareFn);
+
 } // namespace vm
 } // namespace hermes
 
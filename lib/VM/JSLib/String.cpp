@@ -11,6 +11,7 @@
 #include "JSLibInternal.h"
 
 #include "hermes/Platform/Unicode/PlatformUnicode.h"
+#include "hermes/VM/JSArray.h"
 #include "hermes/VM/JSLib/RuntimeCommonStorage.h"
 #include "hermes/VM/Operations.h"
 #include "hermes/VM/PrimitiveBox.h"
@@ -174,6 +175,66 @@ stringPrototypeSymbolIterator(void *, Runtime *runtime, NativeArgs args);
 
 /// @}
 
+/// Create the string of the code units \p get(0) to \p get(n - 1) if they are
+/// all numbers, whose conversion can't run user code, in a single allocation
+/// which is ASCII when possible. \p get is called again once the string is
+/// allocated, so it must not hold raw pointers into the heap.
+/// \return the string, or an empty value if some code unit is not a number.
+template <typename Get>
+static CallResult<HermesValue>
+fromNumericCharCodes(Runtime *runtime, uint32_t n, const Get &get) {
+  bool isASCII = true;
+  for (uint32_t i = 0; i < n; ++i) {
+    HermesValue code = get(i);
+    if (!code.isNumber())
+      return HermesValue::encodeEmptyValue();
+    isASCII &= (char16_t)truncateToUInt32(code.getNumber()) < 128;
+  }
+  auto builder =
+      StringBuilder::createStringBuilder(runtime, SafeUInt32{n}, isASCII);
+  if (LLVM_UNLIKELY(builder == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  for (uint32_t i = 0; i < n; ++i)
+    builder->appendCharacter(truncateToUInt32(get(i).getNumber()));
+  return HermesValue::encodeStringValue(*builder->getStringPrimitive());
+}
+
+OptValue<HermesValue> tryStringCharCodeAtInline(
+    NativeFunction *native,
+    NativeArgs args) {
+  if (native->getFunctionPtr() != stringPrototypeCharCodeAt ||
+      !args.getThisArg().isString() || args.isConstructorCall())
+    return llvm::None;
+  double position = 0;
+  if (args.getArgCount() > 0) {
+    HermesValue arg = args.getArg(0);
+    if (arg.isNumber()) {
+      // ToInteger(NaN) is 0.
+      position = std::isnan(arg.getNumber()) ? 0 : std::trunc(arg.getNumber());
+    } else if (!arg.isUndefined()) {
+      return llvm::None;
+    }
+  }
+  const StringPrimitive *str = args.getThisArg().getString();
+  if (position < 0 || position >= str->getStringLength())
+    return HermesValue::encodeNaNValue();
+  return HermesValue::encodeDoubleValue(str->at(position));
+}
+
+CallResult<HermesValue> tryStringFromCharCodeApply(
+    Runtime *runtime,
+    Handle<Callable> func,
+    Handle<JSArray> arr) {
+  auto *native = dyn_vmcast<NativeFunction>(*func);
+  if (!native || native->getFunctionPtr() != stringFromCharCode)
+    return HermesValue::encodeEmptyValue();
+  return fromNumericCharCodes(
+      runtime, JSArray::getLength(*arr), [runtime, arr](uint32_t i) {
+        return arr->at(runtime, i);
+      });
+}
+
 //===----------------------------------------------------------------------===//
 /// String.
 
@@ -478,6 +539,14 @@ static CallResult<HermesValue>
 stringFromCharCode(void *, Runtime *runtime, NativeArgs args) {
   GCScope gcScope(runtime);
   uint32_t n = args.getArgCount();
+  auto numericRes = fromNumericCharCodes(
+      runtime, n, [&args](uint32_t i) { return args.getArg(i); });
+  if (LLVM_UNLIKELY(numericRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (!numericRes->isEmpty()) {
+    return *numericRes;
+  }
   auto builder = StringBuilder::createStringBuilder(runtime, SafeUInt32{n});
   if (builder == ExecutionStatus::EXCEPTION) {
     return ExecutionStatus::EXCEPTION;
@@ -944,6 +1013,72 @@ static CallResult<RegExpMatch> splitMatch(
   return match;
 }
 
+/// The main loop of splitInternal() for a string \p separator: split the
+/// non-empty string \p S into at most \p lim elements added to the empty
+/// array \p A. The separators are searched for directly in the characters of
+/// S, and the storage of A is resized once all the elements are known.
+static CallResult<HermesValue> splitOnString(
+    Runtime *runtime,
+    Handle<JSArray> A,
+    Handle<StringPrimitive> S,
+    Handle<StringPrimitive> separator,
+    uint32_t lim) {
+  uint32_t s = S->getStringLength();
+  uint32_t r = separator->getStringLength();
+  assert(s != 0 && lim != 0 && "splitOnString() requires elements");
+
+  // Locations of the separators, which are the ends of the elements. Only the
+  // first lim separators matter.
+  llvm::SmallVector<uint32_t, 16> matches{};
+  if (r == 0) {
+    // The empty separator matches between all the characters.
+    for (uint32_t i = 1; i < s && matches.size() < lim; ++i) {
+      matches.push_back(i);
+    }
+  } else {
+    auto SStr = StringPrimitive::createStringView(runtime, S);
+    auto RStr = StringPrimitive::createStringView(runtime, separator);
+    for (auto it = SStr.begin(); matches.size() < lim; it += r) {
+      it = std::search(it, SStr.end(), RStr.begin(), RStr.end());
+      if (it == SStr.end()) {
+        break;
+      }
+      matches.push_back(it - SStr.begin());
+    }
+  }
+  // Unless the limit was reached, the rest of S after the last separator is
+  // the last element.
+  uint32_t lengthA = matches.size();
+  if (lengthA < lim) {
+    matches.push_back(s);
+    ++lengthA;
+  }
+  if (LLVM_UNLIKELY(
+          JSArray::setStorageEndIndex(A, runtime, lengthA) ==
+          ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+
+  GCScopeMarkerRAII gcMarker{runtime};
+  // Start of the current element.
+  uint32_t p = 0;
+  for (uint32_t i = 0; i < lengthA; ++i) {
+    gcMarker.flush();
+    auto strRes = StringPrimitive::slice(runtime, S, p, matches[i] - p);
+    if (LLVM_UNLIKELY(strRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    JSArray::setElementAt(
+        A, runtime, i, runtime->makeHandle<StringPrimitive>(*strRes));
+    p = matches[i] + r;
+  }
+  if (LLVM_UNLIKELY(
+          JSArray::setLengthProperty(A, runtime, lengthA) ==
+          ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  return A.getHermesValue();
+}
+
 CallResult<HermesValue> splitInternal(
     Runtime *runtime,
     Handle<> string,
@@ -1022,6 +1157,10 @@ CallResult<HermesValue> splitInternal(
     return A.getHermesValue();
   }
 
+  if (auto separatorStr = Handle<StringPrimitive>::dyn_vmcast(runtime, R)) {
+    return splitOnString(runtime, A, S, separatorStr, lim);
+  }
+
   // End of the last match.
   uint32_t p = 0;
   // Place to attempt the start of the next match.
@@ -1563,32 +1702,8 @@ stringDirectedIndexOf(Runtime *runtime, NativeArgs args, bool reverse) {
   double len = S->getStringLength();
   uint32_t start = static_cast<uint32_t>(std::min(std::max(pos, 0.), len));
 
-  // TODO: good candidate for Boyer-Moore on large needles/haystacks
-  // TODO: good candidate for memchr on length-1 needles
-  auto SView = StringPrimitive::createStringView(runtime, S);
-  auto searchStrView = StringPrimitive::createStringView(runtime, searchStr);
-  double ret = -1;
-  if (reverse) {
-    uint32_t lastPossibleMatchEnd =
-        std::min(SView.length(), start + searchStrView.length());
-    auto foundIter = std::search(
-        SView.rbegin() + (SView.length() - lastPossibleMatchEnd),
-        SView.rend(),
-        searchStrView.rbegin(),
-        searchStrView.rend());
-    if (foundIter != SView.rend() || searchStrView.empty()) {
-      ret = SView.rend() - foundIter - searchStrView.length();
-    }
-  } else {
-    auto foundIter = std::search(
-        SView.begin() + start,
-        SView.end(),
-        searchStrView.begin(),
-        searchStrView.end());
-    if (foundIter != SView.end() || searchStrView.empty()) {
-      ret = foundIter - SView.begin();
-    }
-  }
+  double ret = reverse ? S->lastIndexOf(*searchStr, start)
+                       : S->indexOf(*searchStr, start);
   return HermesValue::encodeDoubleValue(ret);
 }
 
@@ -2033,6 +2148,9 @@ stringPrototypeReplace(void *, Runtime *runtime, NativeArgs args) {
       return ExecutionStatus::EXCEPTION;
     }
     replStr = replStrRes->get();
+  } else if (!hasSubstitutions(runtime, replaceValueStr)) {
+    // GetSubstitution() would return replaceValue unchanged.
+    replStr = replaceValueStr.get();
   } else {
     // 12. Else,
     // a. Let captures be an empty List.
@@ -2052,13 +2170,24 @@ stringPrototypeReplace(void *, Runtime *runtime, NativeArgs args) {
   // units of string, replStr, and the trailing substring of string starting at
   // index tailPos. If pos is 0, the first element of the concatenation will be
   // the empty String.
-  SmallU16String<32> newString{};
-  strView.slice(0, pos).copyUTF16String(newString);
-  StringPrimitive::createStringView(runtime, replStr)
-      .copyUTF16String(newString);
-  strView.slice(tailPos).copyUTF16String(newString);
+  uint32_t stringLength = string->getStringLength();
+  SafeUInt32 size{pos};
+  size.add(replStr->getStringLength());
+  size.add(stringLength - tailPos);
+  if (size.isZero()) {
+    return HermesValue::encodeStringValue(
+        runtime->getPredefinedString(Predefined::emptyString));
+  }
+  auto builder = StringBuilder::createStringBuilder(
+      runtime, size, string->isASCII() && replStr->isASCII());
+  if (LLVM_UNLIKELY(builder == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  builder->appendStringPrim(string, pos);
+  builder->appendStringPrim(replStr);
+  builder->appendSubstring(string, tailPos, stringLength - tailPos);
   // 15. Return newString.
-  return StringPrimitive::create(runtime, newString);
+  return builder->getStringPrimitive().getHermesValue();
 }
 
 static CallResult<HermesValue>
@@ -2271,12 +2400,7 @@ static CallResult<HermesValue> stringPrototypeIncludesOrStartsWith(
   // than searchLen, the code unit at index k+j of S is the same as the code
   // unit at index j of searchStr, return true; but if there is no such integer
   // k, return false.
-  for (double k = start; k + searchLength <= len; ++k) {
-    if (S->sliceEquals(k, searchLength, *searchStr)) {
-      return HermesValue::encodeBoolValue(true);
-    }
-  }
-  return HermesValue::encodeBoolValue(false);
+  return HermesValue::encodeBoolValue(S->indexOf(*searchStr, start) >= 0);
 }
 
 static CallResult<HermesValue>
@@ -31,6 +31,9 @@ void populateStringIteratorPrototype(Runtime *runtime) {
       nullptr,
       stringIteratorPrototypeNext,
       0);
+  runtime->stringIteratorPrototypeNext =
+      runtime->ignoreAllocationFailure(JSObject::getNamed_RJS(
+          proto, runtime, Predefined::getSymbolID(Predefined::next)));
 
   auto dpf = DefinePropertyFlags::getDefaultNewPropertyFlags();
   dpf.writable = 0;
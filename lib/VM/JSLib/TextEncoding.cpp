@@ -0,0 +1,803 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+//===----------------------------------------------------------------------===//
+/// \file
+/// TextEncoder and TextDecoder of the WHATWG Encoding Standard, for UTF-8.
+//===----------------------------------------------------------------------===//
+#include "JSLibInternal.h"
+
+#include "hermes/Platform/Unicode/CharacterProperties.h"
+#include "hermes/Support/UTF8.h"
+#include "hermes/VM/JSArrayBuffer.h"
+#include "hermes/VM/JSDataView.h"
+#include "hermes/VM/JSTextEncoding.h"
+#include "hermes/VM/JSTypedArray.h"
+#include "hermes/VM/Operations.h"
+#include "hermes/VM/StringPrimitive.h"
+#include "hermes/VM/StringView.h"
+
+#include <cstring>
+
+namespace hermes {
+namespace vm {
+
+using Uint8Array = JSTypedArray<uint8_t, CellKind::Uint8ArrayKind>;
+
+/// @name TextEncoder
+/// @{
+
+/// Encoding 8.2.1 new TextEncoder()
+static CallResult<HermesValue>
+textEncoderConstructor(void *, Runtime *runtime, NativeArgs args);
+
+/// Encoding 8.2.2 get TextEncoder.prototype.encoding
+static CallResult<HermesValue>
+textEncoderPrototypeEncoding(void *, Runtime *runtime, NativeArgs args);
+
+/// Encoding 8.2.3 TextEncoder.prototype.encode(input)
+static CallResult<HermesValue>
+textEncoderPrototypeEncode(void *, Runtime *runtime, NativeArgs args);
+
+/// Encoding 8.2.3 TextEncoder.prototype.encodeInto(source, destination)
+static CallResult<HermesValue>
+textEncoderPrototypeEncodeInto(void *, Runtime *runtime, NativeArgs args);
+
+/// @}
+
+/// @name TextDecoder
+/// @{
+
+/// Encoding 8.1.3 new TextDecoder(label, options)
+static CallResult<HermesValue>
+textDecoderConstructor(void *, Runtime *runtime, NativeArgs args);
+
+/// Encoding 8.1.3 get TextDecoder.prototype.encoding
+static CallResult<HermesValue>
+textDecoderPrototypeEncoding(void *, Runtime *runtime, NativeArgs args);
+
+/// Encoding 8.1.3 get TextDecoder.prototype.fatal
+static CallResult<HermesValue>
+textDecoderPrototypeFatal(void *, Runtime *runtime, NativeArgs args);
+
+/// Encoding 8.1.3 get TextDecoder.prototype.ignoreBOM
+static CallResult<HermesValue>
+textDecoderPrototypeIgnoreBOM(void *, Runtime *runtime, NativeArgs args);
+
+/// Encoding 8.1.3 TextDecoder.prototype.decode(input, options)
+static CallResult<HermesValue>
+textDecoderPrototypeDecode(void *, Runtime *runtime, NativeArgs args);
+
+/// @}
+
+/// Define the methods and accessors of \p proto, which is also given its
+/// @@toStringTag \p name, and the constructor \p name, whose instances have
+/// the kind \p kind.
+template <class NativeClass>
+static Handle<JSObject> defineTextCodingConstructor(
+    Runtime *runtime,
+    Handle<JSObject> proto,
+    Predefined::Str name,
+    NativeFunctionPtr constructor,
+    unsigned paramCount,
+    CellKind kind) {
+  DefinePropertyFlags dpf = DefinePropertyFlags::getDefaultNewPropertyFlags();
+  dpf.writable = 0;
+  dpf.enumerable = 0;
+  defineProperty(
+      runtime,
+      proto,
+      Predefined::getSymbolID(Predefined::SymbolToStringTag),
+      runtime->getPredefinedStringHandle(name),
+      dpf);
+
+  auto cons = defineSystemConstructor<NativeClass>(
+      runtime,
+      Predefined::getSymbolID(name),
+      constructor,
+      proto,
+      paramCount,
+      kind);
+
+  defineProperty(
+      runtime,
+      proto,
+      Predefined::getSymbolID(Predefined::constructor),
+      cons);
+
+  return cons;
+}
+
+Handle<JSObject> createTextEncoderConstructor(Runtime *runtime) {
+  auto proto = Handle<JSObject>::vmcast(&runtime->textEncoderPrototype);
+
+  defineAccessor(
+      runtime,
+      proto,
+      Predefined::getSymbolID(Predefined::encoding),
+      nullptr,
+      textEncoderPrototypeEncoding,
+      nullptr,
+      false,
+      true);
+  defineMethod(
+      runtime,
+      proto,
+      Predefined::getSymbolID(Predefined::encode),
+      nullptr,
+      textEncoderPrototypeEncode,
+      0);
+  defineMethod(
+      runtime,
+      proto,
+      Predefined::getSymbolID(Predefined::encodeInto),
+      nullptr,
+      textEncoderPrototypeEncodeInto,
+      2);
+
+  return defineTextCodingConstructor<JSTextEncoder>(
+      runtime,
+      proto,
+      Predefined::TextEncoder,
+      textEncoderConstructor,
+      0,
+      CellKind::TextEncoderKind);
+}
+
+Handle<JSObject> createTextDecoderConstructor(Runtime *runtime) {
+  auto proto = Handle<JSObject>::vmcast(&runtime->textDecoderPrototype);
+
+  defineAccessor(
+      runtime,
+      proto,
+      Predefined::getSymbolID(Predefined::encoding),
+      nullptr,
+      textDecoderPrototypeEncoding,
+      nullptr,
+      false,
+      true);
+  defineAccessor(
+      runtime,
+      proto,
+      Predefined::getSymbolID(Predefined::fatal),
+      nullptr,
+      textDecoderPrototypeFatal,
+      nullptr,
+      false,
+      true);
+  defineAccessor(
+      runtime,
+      proto,
+      Predefined::getSymbolID(Predefined::ignoreBOM),
+      nullptr,
+      textDecoderPrototypeIgnoreBOM,
+      nullptr,
+      false,
+      true);
+  defineMethod(
+      runtime,
+      proto,
+      Predefined::getSymbolID(Predefined::decode),
+      nullptr,
+      textDecoderPrototypeDecode,
+      0);
+
+  return defineTextCodingConstructor<JSTextDecoder>(
+      runtime,
+      proto,
+      Predefined::TextDecoder,
+      textDecoderConstructor,
+      0,
+      CellKind::TextDecoderKind);
+}
+
+//===----------------------------------------------------------------------===//
+// Encoding
+
+/// The byte order mark, which the decoder strips from the start of a stream.
+static constexpr char16_t kByteOrderMark = 0xFEFF;
+
+static inline bool isHighSurrogate(char16_t c) {
+  return UNICODE_SURROGATE_FIRST <= c && c < UTF16_LOW_SURROGATE;
+}
+
+static inline bool isLowSurrogate(char16_t c) {
+  return UTF16_LOW_SURROGATE <= c && c <= UNICODE_SURROGATE_LAST;
+}
+
+/// \return the length of the UTF-8 encoding of the code point starting at
+/// \p str[i], and set \p units to the number of code units it takes in
+/// \p str. Unpaired surrogates are encoded as U+FFFD.
+static inline unsigned
+utf8SequenceAt(UTF16Ref str, size_t i, uint32_t &cp, unsigned &units) {
+  char16_t c = str[i];
+  units = 1;
+  if (c < 0x80) {
+    cp = c;
+    return 1;
+  }
+  if (c < 0x800) {
+    cp = c;
+    return 2;
+  }
+  if (isHighSurrogate(c) && i + 1 < str.size() &&
+      isLowSurrogate(str[i + 1])) {
+    cp = ((c - UTF16_HIGH_SURROGATE) << 10) +
+        (str[i + 1] - UTF16_LOW_SURROGATE) + 0x10000;
+    units = 2;
+    return 4;
+  }
+  cp = isHighSurrogate(c) || isLowSurrogate(c) ? UNICODE_REPLACEMENT_CHARACTER
+                                               : c;
+  return 3;
+}
+
+/// \return the length of the UTF-8 encoding of \p str.
+static size_t utf8Length(UTF16Ref str) {
+  size_t length = 0;
+  uint32_t cp;
+  unsigned units;
+  for (size_t i = 0, e = str.size(); i < e; i += units) {
+    length += utf8SequenceAt(str, i, cp, units);
+  }
+  return length;
+}
+
+/// Encode as much of \p str as fits in \p capacity bytes as UTF-8 into
+/// \p dst, without splitting code points.
+/// \return the number of code units of \p str which were encoded, and set
+///   \p written to the number of bytes.
+static size_t
+encodeUTF8Into(UTF16Ref str, char *dst, size_t capacity, size_t &written) {
+  char *const start = dst;
+  uint32_t cp;
+  unsigned units;
+  size_t i = 0;
+  for (size_t e = str.size(); i < e; i += units) {
+    // Copy runs of ASCII directly.
+    if (str[i] < 0x80) {
+      if ((size_t)(dst - start) == capacity)
+        break;
+      *dst++ = (char)str[i];
+      units = 1;
+      continue;
+    }
+    unsigned length = utf8SequenceAt(str, i, cp, units);
+    if ((size_t)(dst - start) + length > capacity)
+      break;
+    encodeUTF8(dst, cp);
+  }
+  written = dst - start;
+  return i;
+}
+
+static CallResult<HermesValue>
+textEncoderConstructor(void *, Runtime *runtime, NativeArgs args) {
+  if (LLVM_UNLIKELY(!args.isConstructorCall())) {
+    return runtime->raiseTypeError(
+        "TextEncoder must be called as a constructor");
+  }
+  return args.getThisArg();
+}
+
+static CallResult<HermesValue>
+textEncoderPrototypeEncoding(void *, Runtime *runtime, NativeArgs args) {
+  if (LLVM_UNLIKELY(!vmisa<JSTextEncoder>(args.getThisArg()))) {
+    return runtime->raiseTypeError(
+        "TextEncoder.prototype.encoding called on a non-TextEncoder");
+  }
+  return HermesValue::encodeStringValue(
+      runtime->getPredefinedString(Predefined::utf8));
+}
+
+/// \return the argument \p arg converted to a string, or the empty string if
+/// it is undefined.
+static CallResult<Handle<StringPrimitive>> argToString(
+    Runtime *runtime,
+    Handle<> arg) {
+  if (arg->isUndefined()) {
+    return runtime->getPredefinedStringHandle(Predefined::emptyString);
+  }
+  auto res = toString_RJS(runtime, arg);
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  return toHandle(runtime, std::move(*res));
+}
+
+static CallResult<HermesValue>
+textEncoderPrototypeEncode(void *, Runtime *runtime, NativeArgs args) {
+  if (LLVM_UNLIKELY(!vmisa<JSTextEncoder>(args.getThisArg()))) {
+    return runtime->raiseTypeError(
+        "TextEncoder.prototype.encode called on a non-TextEncoder");
+  }
+  auto strRes = argToString(runtime, args.getArgHandle(runtime, 0));
+  if (LLVM_UNLIKELY(strRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  Handle<StringPrimitive> str = *strRes;
+
+  // ASCII strings are their own UTF-8 encoding.
+  size_t length = str->isASCII() ? str->getStringLength()
+                                 : utf8Length(str->getStringRef<char16_t>());
+  auto arrRes = Uint8Array::allocate(runtime, length);
+  if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  Handle<JSTypedArrayBase> arr = *arrRes;
+  if (length == 0) {
+    return arr.getHermesValue();
+  }
+
+  // The allocation may have moved the string.
+  if (str->isASCII()) {
+    std::memcpy(arr->begin(), str->getStringRef<char>().data(), length);
+  } else {
+    size_t written;
+    encodeUTF8Into(
+        str->getStringRef<char16_t>(), arr->begin(), length, written);
+    assert(written == length && "UTF-8 length mismatch");
+  }
+  return arr.getHermesValue();
+}
+
+static CallResult<HermesValue>
+textEncoderPrototypeEncodeInto(void *, Runtime *runtime, NativeArgs args) {
+  if (LLVM_UNLIKELY(!vmisa<JSTextEncoder>(args.getThisArg()))) {
+    return runtime->raiseTypeError(
+        "TextEncoder.prototype.encodeInto called on a non-TextEncoder");
+  }
+  auto strRes = argToString(runtime, args.getArgHandle(runtime, 0));
+  if (LLVM_UNLIKELY(strRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  Handle<StringPrimitive> str = *strRes;
+  auto dest = args.dyncastArg<Uint8Array>(runtime, 1);
+  if (LLVM_UNLIKELY(!dest)) {
+    return runtime->raiseTypeError(
+        "TextEncoder.prototype.encodeInto requires a Uint8Array destination");
+  }
+
+  auto resultRes = JSObject::create(runtime);
+  Handle<JSObject> result = toHandle(runtime, std::move(resultRes));
+
+  size_t read = 0;
+  size_t written = 0;
+  if (dest->attached(runtime) && dest->getLength() != 0) {
+    size_t capacity = dest->getLength();
+    char *dst = reinterpret_cast<char *>(dest->begin());
+    if (str->isASCII()) {
+      read = written = std::min<size_t>(capacity, str->getStringLength());
+      std::memcpy(dst, str->getStringRef<char>().data(), written);
+    } else {
+      read = encodeUTF8Into(
+          str->getStringRef<char16_t>(), dst, capacity, written);
+    }
+  }
+
+  auto readHandle = runtime->makeHandle(HermesValue::encodeNumberValue(read));
+  auto writtenHandle =
+      runtime->makeHandle(HermesValue::encodeNumberValue(written));
+  if (LLVM_UNLIKELY(
+          JSObject::defineNewOwnProperty(
+              result,
+              runtime,
+              Predefined::getSymbolID(Predefined::read),
+              PropertyFlags::defaultNewNamedPropertyFlags(),
+              readHandle) == ExecutionStatus::EXCEPTION ||
+          JSObject::defineNewOwnProperty(
+              result,
+              runtime,
+              Predefined::getSymbolID(Predefined::written),
+              PropertyFlags::defaultNewNamedPropertyFlags(),
+              writtenHandle) == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  return result.getHermesValue();
+}
+
+//===----------------------------------------------------------------------===//
+// Decoding
+
+namespace {
+
+/// The UTF-8 decoder of the Encoding Standard, 9.1.1, which replaces each
+/// maximal invalid subsequence with U+FFFD and can be fed input in chunks.
+class UTF8Decoder {
+ public:
+  /// Start with the \p pending bytes of JSTextDecoder::getPendingBytes().
+  explicit UTF8Decoder(uint32_t pending) {
+    for (unsigned i = 0, e = pending >> 24; i < e; ++i) {
+      bool ok = feed((uint8_t)(pending >> (8 * i)));
+      assert(ok && "pending bytes must be a valid prefix");
+      (void)ok;
+    }
+  }
+
+  /// Decode \p bytes, appending the result to out_.
+  /// \return false if an error was found and \p fatal is set.
+  bool decode(const uint8_t *bytes, size_t size, bool fatal) {
+    const uint8_t *const end = bytes + size;
+    while (bytes != end) {
+      // Copy runs of ASCII directly.
+      if (bytesNeeded_ == 0 && *bytes < 0x80) {
+        const uint8_t *run = bytes;
+        while (run != end && *run < 0x80)
+          ++run;
+        out_.append(bytes, run);
+        bytes = run;
+        continue;
+      }
+      if (!feed(*bytes)) {
+        if (fatal)
+          return false;
+        out_.push_back(UNICODE_REPLACEMENT_CHARACTER);
+        // A lead byte is consumed by the error, an unexpected continuation
+        // byte is processed again.
+        if (errorConsumedByte_)
+          ++bytes;
+        continue;
+      }
+      ++bytes;
+    }
+    return true;
+  }
+
+  /// Flush the end of the stream.
+  /// \return false if it ends in an incomplete sequence and \p fatal is set.
+  bool finish(bool fatal) {
+    if (bytesNeeded_ == 0)
+      return true;
+    reset();
+    if (fatal)
+      return false;
+    out_.push_back(UNICODE_REPLACEMENT_CHARACTER);
+    return true;
+  }
+
+  /// \return the bytes of the incomplete sequence at the end of the input, in
+  ///   the format of JSTextDecoder::getPendingBytes().
+  uint32_t getPendingBytes() const {
+    if (bytesNeeded_ == 0)
+      return 0;
+    uint32_t result = (uint32_t)(bytesSeen_ + 1) << 24;
+    for (unsigned i = 0; i <= bytesSeen_; ++i)
+      result |= (uint32_t)sequence_[i] << (8 * i);
+    return result;
+  }
+
+  std::u16string &out() {
+    return out_;
+  }
+
+ private:
+  /// Process one byte.
+  /// \return false on error, with errorConsumedByte_ telling whether the
+  ///   byte was consumed.
+  bool feed(uint8_t byte) {
+    if (bytesNeeded_ == 0) {
+      if (byte < 0x80) {
+        out_.push_back(byte);
+      } else if (byte >= 0xC2 && byte <= 0xDF) {
+        bytesNeeded_ = 1;
+        codePoint_ = byte & 0x1F;
+      } else if (byte >= 0xE0 && byte <= 0xEF) {
+        if (byte == 0xE0)
+          lowerBoundary_ = 0xA0;
+        if (byte == 0xED)
+          upperBoundary_ = 0x9F;
+        bytesNeeded_ = 2;
+        codePoint_ = byte & 0xF;
+      } else if (byte >= 0xF0 && byte <= 0xF4) {
+        if (byte == 0xF0)
+          lowerBoundary_ = 0x90;
+        if (byte == 0xF4)
+          upperBoundary_ = 0x8F;
+        bytesNeeded_ = 3;
+        codePoint_ = byte & 0x7;
+      } else {
+        errorConsumedByte_ = true;
+        return false;
+      }
+      sequence_[0] = byte;
+      return true;
+    }
+
+    if (byte < lowerBoundary_ || byte > upperBoundary_) {
+      reset();
+      errorConsumedByte_ = false;
+      return false;
+    }
+    lowerBoundary_ = 0x80;
+    upperBoundary_ = 0xBF;
+    codePoint_ = (codePoint_ << 6) | (byte & 0x3F);
+    sequence_[++bytesSeen_] = byte;
+    if (bytesSeen_ != bytesNeeded_)
+      return true;
+
+    char16_t *out = nullptr;
+    char16_t units[2];
+    out = units;
+    encodeUTF16(out, codePoint_);
+    out_.append(units, out);
+    reset();
+    return true;
+  }
+
+  void reset() {
+    codePoint_ = 0;
+    bytesSeen_ = 0;
+    bytesNeeded_ = 0;
+    lowerBoundary_ = 0x80;
+    upperBoundary_ = 0xBF;
+  }
+
+  uint32_t codePoint_ = 0;
+  uint8_t bytesSeen_ = 0;
+  uint8_t bytesNeeded_ = 0;
+  uint8_t lowerBoundary_ = 0x80;
+  uint8_t upperBoundary_ = 0xBF;
+  bool errorConsumedByte_ = false;
+
+  /// The bytes of the current sequence.
+  uint8_t sequence_[4];
+
+  std::u16string out_{};
+};
+
+} // namespace
+
+/// \return the decoder which is the this of \p args, or raise a TypeError
+/// naming \p method.
+static CallResult<Handle<JSTextDecoder>>
+thisDecoder(Runtime *runtime, NativeArgs args, const char *method) {
+  auto self = args.dyncastThis<JSTextDecoder>(runtime);
+  if (LLVM_UNLIKELY(!self)) {
+    return runtime->raiseTypeError(
+        TwineChar16("TextDecoder.prototype.") + method +
+        " called on a non-TextDecoder");
+  }
+  return self;
+}
+
+/// \return whether \p label, trimmed and lowercased, is a label of UTF-8 in
+/// the Encoding Standard.
+static bool isUTF8Label(StringView label) {
+  static const char *const labels[] = {"unicode-1-1-utf-8",
+                                       "unicode11utf8",
+                                       "unicode20utf8",
+                                       "utf-8",
+                                       "utf8",
+                                       "x-unicode20utf8"};
+  auto isWhitespace = [](char16_t c) {
+    return c == u' ' || c == u'\t' || c == u'\n' || c == u'\f' || c == u'\r';
+  };
+  size_t begin = 0;
+  size_t end = label.length();
+  while (begin < end && isWhitespace(label[begin]))
+    ++begin;
+  while (end > begin && isWhitespace(label[end - 1]))
+    --end;
+
+  for (const char *candidate : labels) {
+    size_t length = std::strlen(candidate);
+    if (length != end - begin)
+      continue;
+    size_t i = 0;
+    while (i < length) {
+      char16_t c = label[begin + i];
+      if (c >= u'A' && c <= u'Z')
+        c += u'a' - u'A';
+      if (c != (char16_t)candidate[i])
+        break;
+      ++i;
+    }
+    if (i == length)
+      return true;
+  }
+  return false;
+}
+
+/// Read the boolean property \p name of the dictionary \p options, which may
+/// be undefined or null. \return false if it is missing.
+static CallResult<bool>
+getBooleanOption(Runtime *runtime, Handle<> options, Predefined::Str name) {
+  if (options->isUndefined() || options->isNull()) {
+    return false;
+  }
+  auto obj = Handle<JSObject>::dyn_vmcast(runtime, options);
+  if (LLVM_UNLIKELY(!obj)) {
+    return runtime->raiseTypeError("options must be an object");
+  }
+  auto res =
+      JSObject::getNamed_RJS(obj, runtime, Predefined::getSymbolID(name));
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  return toBoolean(*res);
+}
+
+static CallResult<HermesValue>
+textDecoderConstructor(void *, Runtime *runtime, NativeArgs args) {
+  if (LLVM_UNLIKELY(!args.isConstructorCall())) {
+    return runtime->raiseTypeError(
+        "TextDecoder must be called as a constructor");
+  }
+  auto self = args.dyncastThis<JSTextDecoder>(runtime);
+
+  auto label = args.getArgHandle(runtime, 0);
+  if (!label->isUndefined()) {
+    auto strRes = toString_RJS(runtime, label);
+    if (LLVM_UNLIKELY(strRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    auto str = toHandle(runtime, std::move(*strRes));
+    if (!isUTF8Label(StringPrimitive::createStringView(runtime, str))) {
+      return runtime->raiseRangeError(
+          TwineChar16("TextDecoder: unsupported encoding: ") + str.get());
+    }
+  }
+
+  auto options = args.getArgHandle(runtime, 1);
+  auto fatalRes = getBooleanOption(runtime, options, Predefined::fatal);
+  if (LLVM_UNLIKELY(fatalRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  auto ignoreBOMRes = getBooleanOption(runtime, options, Predefined::ignoreBOM);
+  if (LLVM_UNLIKELY(ignoreBOMRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  JSTextDecoder::setFlags(
+      *self,
+      runtime,
+      (*fatalRes ? JSTextDecoder::Fatal : 0) |
+          (*ignoreBOMRes ? JSTextDecoder::IgnoreBOM : 0));
+  return self.getHermesValue();
+}
+
+static CallResult<HermesValue>
+textDecoderPrototypeEncoding(void *, Runtime *runtime, NativeArgs args) {
+  auto selfRes = thisDecoder(runtime, args, "encoding");
+  if (LLVM_UNLIKELY(selfRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  return HermesValue::encodeStringValue(
+      runtime->getPredefinedString(Predefined::utf8));
+}
+
+static CallResult<HermesValue>
+textDecoderPrototypeFatal(void *, Runtime *runtime, NativeArgs args) {
+  auto selfRes = thisDecoder(runtime, args, "fatal");
+  if (LLVM_UNLIKELY(selfRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  return HermesValue::encodeBoolValue(
+      JSTextDecoder::getFlags(**selfRes, runtime) & JSTextDecoder::Fatal);
+}
+
+static CallResult<HermesValue>
+textDecoderPrototypeIgnoreBOM(void *, Runtime *runtime, NativeArgs args) {
+  auto selfRes = thisDecoder(runtime, args, "ignoreBOM");
+  if (LLVM_UNLIKELY(selfRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  return HermesValue::encodeBoolValue(
+      JSTextDecoder::getFlags(**selfRes, runtime) & JSTextDecoder::IgnoreBOM);
+}
+
+/// Get the bytes of the BufferSource \p input, which are empty if it is
+/// undefined or detached, into \p bytes and \p size.
+/// \return false if \p input is not a BufferSource.
+static bool getBufferSourceBytes(
+    Runtime *runtime,
+    Handle<> input,
+    const uint8_t *&bytes,
+    size_t &size) {
+  bytes = nullptr;
+  size = 0;
+  if (input->isUndefined()) {
+    return true;
+  }
+  if (auto buffer = dyn_vmcast<JSArrayBuffer>(*input)) {
+    if (buffer->attached() && buffer->size()) {
+      bytes = reinterpret_cast<const uint8_t *>(buffer->getDataBlock());
+      size = buffer->size();
+    }
+    return true;
+  }
+  if (auto view = dyn_vmcast<JSTypedArrayBase>(*input)) {
+    if (view->attached(runtime) && view->getByteLength()) {
+      bytes = reinterpret_cast<const uint8_t *>(view->begin());
+      size = view->getByteLength();
+    }
+    return true;
+  }
+  if (auto view = dyn_vmcast<JSDataView>(*input)) {
+    if (view->attached(runtime) && view->byteLength()) {
+      bytes = reinterpret_cast<const uint8_t *>(
+                  view->getBuffer(runtime)->getDataBlock()) +
+          view->byteOffset();
+      size = view->byteLength();
+    }
+    return true;
+  }
+  return false;
+}
+
+static CallResult<HermesValue>
+textDecoderPrototypeDecode(void *, Runtime *runtime, NativeArgs args) {
+  auto selfRes = thisDecoder(runtime, args, "decode");
+  if (LLVM_UNLIKELY(selfRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  Handle<JSTextDecoder> self = *selfRes;
+
+  // Read the options first, since it may run arbitrary code which could
+  // detach the input.
+  auto streamRes = getBooleanOption(
+      runtime, args.getArgHandle(runtime, 1), Predefined::stream);
+  if (LLVM_UNLIKELY(streamRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  bool stream = *streamRes;
+
+  const uint8_t *bytes;
+  size_t size;
+  if (LLVM_UNLIKELY(!getBufferSourceBytes(
+          runtime, args.getArgHandle(runtime, 0), bytes, size))) {
+    return runtime->raiseTypeError(
+        "TextDecoder.prototype.decode requires an ArrayBuffer or a view");
+  }
+
+  uint8_t flags = JSTextDecoder::getFlags(*self, runtime);
+  bool fatal = flags & JSTextDecoder::Fatal;
+  uint32_t pending = JSTextDecoder::getPendingBytes(*self, runtime);
+
+  // Once the stream is over, the next call starts a new one.
+  auto endStream = [runtime, self, flags]() {
+    JSTextDecoder::setFlags(
+        *self, runtime, flags & ~JSTextDecoder::BOMSeen);
+    JSTextDecoder::setPendingBytes(*self, runtime, 0);
+  };
+
+  // Fast path: the whole input is ASCII, which has no byte order mark.
+  if (pending == 0 && isAllASCII(bytes, bytes + size)) {
+    if (!stream) {
+      endStream();
+    } else if (size) {
+      JSTextDecoder::setFlags(*self, runtime, flags | JSTextDecoder::BOMSeen);
+    }
+    return StringPrimitive::createEfficient(
+        runtime, ASCIIRef(reinterpret_cast<const char *>(bytes), size));
+  }
+
+  UTF8Decoder decoder{pending};
+  if (LLVM_UNLIKELY(
+          !decoder.decode(bytes, size, fatal) ||
+          (!stream && !decoder.finish(fatal)))) {
+    endStream();
+    return runtime->raiseTypeError(
+        "TextDecoder.prototype.decode: the data is not valid UTF-8");
+  }
+
+  std::u16string &out = decoder.out();
+  if (!(flags & (JSTextDecoder::IgnoreBOM | JSTextDecoder::BOMSeen)) &&
+      !out.empty()) {
+    if (out[0] == kByteOrderMark)
+      out.erase(0, 1);
+    flags |= JSTextDecoder::BOMSeen;
+  }
+  if (stream) {
+    JSTextDecoder::setFlags(*self, runtime, flags);
+    JSTextDecoder::setPendingBytes(*self, runtime, decoder.getPendingBytes());
+  } else {
+    endStream();
+  }
+  return StringPrimitive::createEfficient(runtime, std::move(out));
+}
+
+} // namespace vm
+} // namespace hermes
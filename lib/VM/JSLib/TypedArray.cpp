@@ -16,6 +16,13 @@
 #include "hermes/VM/StringBuilder.h"
 #include "hermes/VM/StringView.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
 namespace hermes {
 namespace vm {
 
@@ -500,44 +507,20 @@ typedArrayPrototypeCopyWithin(void *, Runtime *runtime, NativeArgs args) {
   // 14. Let count be min(final-from, len-to).
   double count = std::min(fin - from, len - to);
 
-  int direction;
-  if (from < to && to < from + count) {
-    // 15. If from<to and to<from+count
-    // a. Let direction be -1.
-    direction = -1;
-    // b. Let from be from + count -1.
-    from = from + count - 1;
-    // c. Let to be to + count -1.
-    to = to + count - 1;
-  } else {
-    // 16. Else,
-    // a. Let direction = 1.
-    direction = 1;
-  }
-
-  // Need to case on the TypedArray type to avoid encoding using HermesValues.
-  // We need to preserve the bit-level encoding of values, and HermesValues
-  // destroy information, e.g. which NaN is being used.
-#define TYPED_ARRAY(name, type)                                            \
-  case CellKind::name##ArrayKind: {                                        \
-    auto *arr = vmcast<JSTypedArray<type, CellKind::name##ArrayKind>>(*O); \
-    if (!arr->attached(runtime)) {                                         \
-      return runtime->raiseTypeError(                                      \
-          "Underlying ArrayBuffer detached after calling copyWithin");     \
-    }                                                                      \
-    while (count > 0) {                                                    \
-      arr->at<type>(runtime, to) = arr->at<type>(runtime, from);           \
-      from += direction;                                                   \
-      to += direction;                                                     \
-      --count;                                                             \
-    }                                                                      \
-    break;                                                                 \
-  }
-
-  switch (O->getKind()) {
-#include "hermes/VM/TypedArrays.def"
-    default:
-      llvm_unreachable("Invalid TypedArray after ValidateTypedArray call");
+  if (!O->attached(runtime)) {
+    return runtime->raiseTypeError(
+        "Underlying ArrayBuffer detached after calling copyWithin");
+  }
+
+  // 15-17. Copying element by element in the direction which doesn't
+  // overwrite the source before it is read is what memmove does. Copying the
+  // bytes preserves the bit-level encoding of values, e.g. which NaN is used.
+  if (count > 0) {
+    const size_t width = O->getByteWidth();
+    std::memmove(
+        O->begin() + (size_t)to * width,
+        O->begin() + (size_t)from * width,
+        (size_t)count * width);
   }
 
   return O.getHermesValue();
@@ -847,6 +830,65 @@ typedArrayPrototypeForEach(void *, Runtime *runtime, NativeArgs args) {
   return HermesValue::encodeUndefinedValue();
 }
 
+/// Search the \p len elements at \p data for \p target, starting from
+/// index \p k and going backwards if \p backwards. Elements are compared with
+/// strict equality, or with SameValueZero if \p sameValueZero.
+/// \return the index of the first element found, or -1.
+template <typename T>
+static double searchTypedArray(
+    const T *data,
+    double len,
+    double k,
+    bool backwards,
+    double target,
+    bool sameValueZero) {
+  using Limits = std::numeric_limits<T>;
+  if (backwards) {
+    k = std::min(k, len - 1);
+  } else {
+    k = std::max(k, 0.0);
+  }
+  if (std::isnan(target)) {
+    // Only SameValueZero finds NaN, which integer elements can't be.
+    if (!sameValueZero || Limits::is_integer) {
+      return -1;
+    }
+    for (; backwards ? k >= 0 : k < len; k += backwards ? -1 : 1) {
+      if (std::isnan(data[(size_t)k])) {
+        return k;
+      }
+    }
+    return -1;
+  }
+  // Only a target which the element type represents exactly can be equal to
+  // an element. Check the range first, since converting a double outside of
+  // it is undefined.
+  bool inRange = Limits::is_integer
+      ? target >= (double)Limits::lowest() && target <= (double)Limits::max()
+      : std::fabs(target) <= (double)Limits::max() || std::isinf(target);
+  if (!inRange) {
+    return -1;
+  }
+  const T elem = static_cast<T>(target);
+  if (static_cast<double>(elem) != target) {
+    return -1;
+  }
+  if (!backwards) {
+    if (k >= len) {
+      return -1;
+    }
+    const T *end = data + (size_t)len;
+    const T *it = std::find(data + (size_t)k, end, elem);
+    return it == end ? -1 : it - data;
+  }
+  for (; k >= 0; --k) {
+    if (data[(size_t)k] == elem) {
+      return k;
+    }
+  }
+  return -1;
+}
+
 enum class IndexOfMode { includes, indexOf, lastIndexOf };
 CallResult<HermesValue>
 typedArrayPrototypeIndexOf(void *ctxVoid, Runtime *runtime, NativeArgs args) {
@@ -897,24 +939,25 @@ typedArrayPrototypeIndexOf(void *ctxVoid, Runtime *runtime, NativeArgs args) {
   } else {
     k = fromIndex >= 0 ? fromIndex : std::max(len + fromIndex, 0.0);
   }
-  auto delta = ctx == IndexOfMode::lastIndexOf ? -1 : 1;
-  auto inRange = [ctx](double k, double len) {
-    if (ctx == IndexOfMode::lastIndexOf) {
-      return k >= 0;
-    } else {
-      return k < len;
-    }
-  };
-  for (; inRange(k, len); k += delta) {
-    auto curr = JSObject::getOwnIndexed(*self, runtime, k);
-    bool comp = ctx == IndexOfMode::includes
-        ? isSameValueZero(curr, searchElement)
-        : strictEqualityTest(curr, searchElement);
-    if (comp) {
-      return ret(true, k);
-    }
+  // Compare the elements in their own type, instead of encoding each of them
+  // as a HermesValue.
+  double found = -1;
+  switch (self->getKind()) {
+#define TYPED_ARRAY(name, type)                        \
+  case CellKind::name##ArrayKind:                      \
+    found = searchTypedArray(                          \
+        reinterpret_cast<const type *>(self->begin()), \
+        len,                                           \
+        k,                                             \
+        ctx == IndexOfMode::lastIndexOf,               \
+        searchElement.getNumber(),                     \
+        ctx == IndexOfMode::includes);                 \
+    break;
+#include "hermes/VM/TypedArrays.def"
+    default:
+      llvm_unreachable("Invalid TypedArray after ValidateTypedArray call");
   }
-  return ret();
+  return found < 0 ? ret() : ret(true, found);
 }
 
 CallResult<HermesValue>
@@ -1069,22 +1112,22 @@ typedArrayPrototypeReverse(void *, Runtime *runtime, NativeArgs args) {
     return ExecutionStatus::EXCEPTION;
   }
   auto self = args.vmcastThis<JSTypedArrayBase>();
-  const JSTypedArrayBase::size_type len = self->getLength();
-  const JSTypedArrayBase::size_type middle = len / 2;
-  MutableHandle<> lowerHandle(runtime);
-  MutableHandle<> upperHandle(runtime);
-  for (JSTypedArrayBase::size_type lower = 0; lower != middle; ++lower) {
-    auto upper = len - lower - 1;
-    lowerHandle = JSObject::getOwnIndexed(*self, runtime, lower);
-    upperHandle = JSObject::getOwnIndexed(*self, runtime, upper);
-    if (JSObject::setOwnIndexed(self, runtime, lower, upperHandle) ==
-        ExecutionStatus::EXCEPTION) {
-      return ExecutionStatus::EXCEPTION;
-    }
-    if (JSObject::setOwnIndexed(self, runtime, upper, lowerHandle) ==
-        ExecutionStatus::EXCEPTION) {
-      return ExecutionStatus::EXCEPTION;
-    }
+  if (self->getLength() == 0) {
+    return self.getHermesValue();
+  }
+
+  // Swap the elements in place, without encoding them as HermesValues.
+#define TYPED_ARRAY(name, type)                           \
+  case CellKind::name##ArrayKind: {                       \
+    auto *data = reinterpret_cast<type *>(self->begin()); \
+    std::reverse(data, data + self->getLength());         \
+    break;                                                \
+  }
+
+  switch (self->getKind()) {
+#include "hermes/VM/TypedArrays.def"
+    default:
+      llvm_unreachable("Invalid TypedArray after ValidateTypedArray call");
   }
   return self.getHermesValue();
 }
@@ -1172,6 +1215,45 @@ class TypedArraySortModel : public SortModel {
   }
 };
 
+/// \return whether \p a comes before \p b when a TypedArray is sorted without
+/// a compare function: numerically, except that -0 comes before +0 and NaN
+/// comes last.
+template <typename T>
+static bool typedArrayElementLess(T a, T b) {
+  if (std::is_floating_point<T>::value) {
+    if (std::isnan(b))
+      return !std::isnan(a);
+    if (a == b)
+      return std::signbit(a) && !std::signbit(b);
+  }
+  return a < b;
+}
+
+/// Sort the \p len elements at \p data in place, in the default order if
+/// \p order is None, or else in the order of the recognized compare function.
+/// \return false if the compare function doesn't define an order for the
+///   elements because some of them are NaN, in which case nothing was done.
+template <typename T>
+static bool
+sortTypedArrayElements(T *data, uint32_t len, NumericCompareFn order) {
+  if (order == NumericCompareFn::None) {
+    std::sort(data, data + len, typedArrayElementLess<T>);
+    return true;
+  }
+  if (std::is_floating_point<T>::value &&
+      std::any_of(data, data + len, [](T x) { return std::isnan(x); })) {
+    return false;
+  }
+  // The compare function considers -0 and +0 equal, so the sort must be
+  // stable to keep them in order.
+  if (order == NumericCompareFn::Ascending) {
+    std::stable_sort(data, data + len, std::less<T>());
+  } else {
+    std::stable_sort(data, data + len, std::greater<T>());
+  }
+  return true;
+}
+
 /// ES7 22.2.3.26
 CallResult<HermesValue>
 typedArrayPrototypeSort(void *, Runtime *runtime, NativeArgs args) {
@@ -1189,6 +1271,28 @@ typedArrayPrototypeSort(void *, Runtime *runtime, NativeArgs args) {
     return runtime->raiseTypeError("TypedArray sort argument must be callable");
   }
 
+  // The elements are numbers, so without a compare function, or with one that
+  // just subtracts its arguments, they can be sorted in place.
+  NumericCompareFn order = compareFn
+      ? recognizeNumericCompareFn(runtime, compareFn.get())
+      : NumericCompareFn::None;
+  if (!compareFn || order != NumericCompareFn::None) {
+    bool sorted = false;
+    switch (self->getKind()) {
+#define TYPED_ARRAY(name, type)                               \
+  case CellKind::name##ArrayKind:                             \
+    sorted = sortTypedArrayElements(                          \
+        reinterpret_cast<type *>(self->begin()), len, order); \
+    break;
+#include "hermes/VM/TypedArrays.def"
+      default:
+        llvm_unreachable("Invalid TypedArray after ValidateTypedArray call");
+    }
+    if (sorted) {
+      return self.getHermesValue();
+    }
+  }
+
   // Use our custom sort routine. We can't use std::sort because it performs
   // optimizations that allow it to bypass calls to std::swap, but our swap
   // function is special, since it needs to use the internal Object functions.
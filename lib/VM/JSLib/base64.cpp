@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "JSLibInternal.h"
+
+#include "hermes/VM/Operations.h"
+#include "hermes/VM/StringPrimitive.h"
+#include "hermes/VM/StringView.h"
+
+namespace hermes {
+namespace vm {
+
+static const char kBase64Alphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/// \return the value of the base64 digit \p c, or -1 if it is not one.
+static inline int fromBase64Char(char16_t c) {
+  if (u'A' <= c && c <= u'Z')
+    return c - u'A';
+  if (u'a' <= c && c <= u'z')
+    return c - u'a' + 26;
+  if (u'0' <= c && c <= u'9')
+    return c - u'0' + 52;
+  if (c == u'+')
+    return 62;
+  if (c == u'/')
+    return 63;
+  return -1;
+}
+
+/// \return true if \p c is ASCII whitespace, which atob() ignores.
+static inline bool isBase64Whitespace(char16_t c) {
+  return c == u' ' || c == u'\t' || c == u'\n' || c == u'\f' || c == u'\r';
+}
+
+CallResult<HermesValue> btoa(void *, Runtime *runtime, NativeArgs args) {
+  auto res = toString_RJS(runtime, args.getArgHandle(runtime, 0));
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  auto str = toHandle(runtime, std::move(*res));
+  auto view = StringPrimitive::createStringView(runtime, str);
+
+  std::string output;
+  output.reserve((view.length() + 2) / 3 * 4);
+  uint32_t group = 0;
+  unsigned groupSize = 0;
+  for (char16_t c : view) {
+    if (LLVM_UNLIKELY(c > 0xFF)) {
+      return runtime->raiseRangeError(
+          "btoa: the string contains characters outside of Latin-1");
+    }
+    group = (group << 8) | c;
+    if (++groupSize == 3) {
+      output.push_back(kBase64Alphabet[(group >> 18) & 0x3F]);
+      output.push_back(kBase64Alphabet[(group >> 12) & 0x3F]);
+      output.push_back(kBase64Alphabet[(group >> 6) & 0x3F]);
+      output.push_back(kBase64Alphabet[group & 0x3F]);
+      group = 0;
+      groupSize = 0;
+    }
+  }
+  if (groupSize == 1) {
+    output.push_back(kBase64Alphabet[(group >> 2) & 0x3F]);
+    output.push_back(kBase64Alphabet[(group << 4) & 0x3F]);
+    output.append("==");
+  } else if (groupSize == 2) {
+    output.push_back(kBase64Alphabet[(group >> 10) & 0x3F]);
+    output.push_back(kBase64Alphabet[(group >> 4) & 0x3F]);
+    output.push_back(kBase64Alphabet[(group << 2) & 0x3F]);
+    output.push_back('=');
+  }
+  return StringPrimitive::createEfficient(runtime, std::move(output));
+}
+
+CallResult<HermesValue> atob(void *, Runtime *runtime, NativeArgs args) {
+  auto res = toString_RJS(runtime, args.getArgHandle(runtime, 0));
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  auto str = toHandle(runtime, std::move(*res));
+  auto view = StringPrimitive::createStringView(runtime, str);
+
+  // The forgiving-base64 decode of the Infra Standard: whitespace is
+  // ignored, and so is the padding if it completes the last group.
+  std::u16string input;
+  input.reserve(view.length());
+  for (char16_t c : view) {
+    if (!isBase64Whitespace(c))
+      input.push_back(c);
+  }
+  if (input.size() % 4 == 0) {
+    for (unsigned i = 0; i < 2 && !input.empty() && input.back() == u'='; ++i)
+      input.pop_back();
+  }
+  if (LLVM_UNLIKELY(input.size() % 4 == 1)) {
+    return runtime->raiseSyntaxError("atob: the string is not valid base64");
+  }
+
+  std::string output;
+  output.reserve(input.size() / 4 * 3 + 2);
+  bool isASCII = true;
+  uint32_t group = 0;
+  unsigned groupSize = 0;
+  for (char16_t c : input) {
+    int digit = fromBase64Char(c);
+    if (LLVM_UNLIKELY(digit < 0)) {
+      return runtime->raiseSyntaxError("atob: the string is not valid base64");
+    }
+    group = (group << 6) | digit;
+    if (++groupSize == 4) {
+      output.push_back((char)(group >> 16));
+      output.push_back((char)(group >> 8));
+      output.push_back((char)group);
+      isASCII &= !(group & 0x808080);
+      group = 0;
+      groupSize = 0;
+    }
+  }
+  // The remaining bits past the last whole byte are dropped.
+  if (groupSize == 2) {
+    output.push_back((char)(group >> 4));
+    isASCII &= !(group & 0x800);
+  } else if (groupSize == 3) {
+    output.push_back((char)(group >> 10));
+    output.push_back((char)(group >> 2));
+    isASCII &= !(group & 0x20200);
+  }
+
+  if (isASCII) {
+    return StringPrimitive::createEfficient(runtime, std::move(output));
+  }
+  // Each byte is the Latin-1 character with the same value.
+  std::u16string latin1(output.size(), u'\0');
+  for (size_t i = 0, e = output.size(); i < e; ++i)
+    latin1[i] = (uint8_t)output[i];
+  return StringPrimitive::createEfficient(runtime, std::move(latin1));
+}
+
+} // namespace vm
+} // namespace hermes
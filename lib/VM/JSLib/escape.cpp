@@ -6,10 +6,11 @@
  */
 #include "JSLibInternal.h"
 
+#include "hermes/Support/StringSearch.h"
 #include "hermes/Support/UTF8.h"
 #include "hermes/VM/Operations.h"
 #include "hermes/VM/SmallXString.h"
-#include "hermes/VM/StringView.h"
+#include "hermes/VM/StringBuilder.h"
 
 #include "llvm/Support/ConvertUTF.h"
 
@@ -56,78 +57,137 @@ static inline int fromHexChar(char16_t c) {
   return c - u'a' + 10;
 }
 
-/// Convert the argument to string and escape unicode characters.
-CallResult<HermesValue> escape(void *, Runtime *runtime, NativeArgs args) {
-  auto res = toString_RJS(runtime, args.getArgHandle(runtime, 0));
-  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
-    return ExecutionStatus::EXCEPTION;
+/// Append \p c, which must be escaped by escape(), to \p builder.
+static void appendEscaped(StringBuilder &builder, char16_t c) {
+  if (c < 256) {
+    // "%xy" where xy is the 2 bytes of c.
+    char escaped[3] = {
+        '%', (char)toHexChar((c >> 4) & 0xf), (char)toHexChar(c & 0xf)};
+    builder.appendASCIIRef({escaped, 3});
+  } else {
+    // "%uwxyz" where wxyz is the 4 bytes of c.
+    char escaped[6] = {
+        '%',
+        'u',
+        (char)toHexChar((c >> 12) & 0xf),
+        (char)toHexChar((c >> 8) & 0xf),
+        (char)toHexChar((c >> 4) & 0xf),
+        (char)toHexChar(c & 0xf)};
+    builder.appendASCIIRef({escaped, 6});
+  }
+}
+
+/// Escape \p strHandle, whose characters are stored as T. Runs of letters and
+/// digits are found a chunk at a time and copied at once, and the length of
+/// the result is computed first so that it is allocated once.
+template <typename T>
+static CallResult<HermesValue> escapeImpl(
+    Runtime *runtime,
+    Handle<StringPrimitive> strHandle) {
+  auto str = strHandle->getStringRef<T>();
+  const size_t len = str.size();
+  SafeUInt32 resultLength{};
+  for (size_t i = 0; i < len; ++i) {
+    size_t next = findNonAlphanumeric(str, i);
+    resultLength.add(next - i);
+    if ((i = next) == len)
+      break;
+    char16_t c = str[i];
+    resultLength.add(noEscape(c) ? 1 : c < 256 ? 3 : 6);
+  }
+  if (!resultLength.isOverflowed() && *resultLength == len) {
+    // Nothing needs to be escaped.
+    return strHandle.getHermesValue();
   }
-  auto string = toHandle(runtime, std::move(*res));
-  auto len = string->getStringLength();
-  SmallU16String<32> R{};
-  R.reserve(len);
 
-  for (char16_t c : StringPrimitive::createStringView(runtime, string)) {
+  auto builder =
+      StringBuilder::createStringBuilder(runtime, resultLength, true);
+  if (LLVM_UNLIKELY(builder == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  // The allocation may have moved the string.
+  str = strHandle->getStringRef<T>();
+  for (size_t i = 0; i < len; ++i) {
+    size_t next = findNonAlphanumeric(str, i);
+    builder->appendASCIIChars(str.slice(i, next - i));
+    if ((i = next) == len)
+      break;
+    char16_t c = str[i];
     if (noEscape(c)) {
-      // Just append.
-      R.push_back(c);
-    } else if (c < 256) {
-      // R += "%xy" where xy is the 2 bytes of c.
-      R.push_back(u'%');
-      R.push_back(toHexChar((c >> 4) & 0xf));
-      R.push_back(toHexChar(c & 0xf));
+      builder->appendCharacter(c);
     } else {
-      // R += "%uwxyz" where wxyz is the 4 bytes of c.
-      R.append(u"%u");
-      R.push_back(toHexChar((c >> 12) & 0xf));
-      R.push_back(toHexChar((c >> 8) & 0xf));
-      R.push_back(toHexChar((c >> 4) & 0xf));
-      R.push_back(toHexChar(c & 0xf));
+      appendEscaped(*builder, c);
     }
   }
-
-  return StringPrimitive::create(runtime, R);
+  return builder->getStringPrimitive().getHermesValue();
 }
 
-/// Convert the argument to string and unescape unicode characters.
-CallResult<HermesValue> unescape(void *, Runtime *runtime, NativeArgs args) {
+/// Convert the argument to string and escape unicode characters.
+CallResult<HermesValue> escape(void *, Runtime *runtime, NativeArgs args) {
   auto res = toString_RJS(runtime, args.getArgHandle(runtime, 0));
   if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
-  auto strPrim = toHandle(runtime, std::move(*res));
-  auto len = strPrim->getStringLength();
+  auto string = toHandle(runtime, std::move(*res));
+  return string->isASCII() ? escapeImpl<char>(runtime, string)
+                           : escapeImpl<char16_t>(runtime, string);
+}
+
+/// Unescape \p strPrim, whose characters are stored as T. The characters
+/// between escape sequences are copied a run at a time, and a string without
+/// any '%' is returned as is.
+template <typename T>
+static CallResult<HermesValue> unescapeImpl(
+    Runtime *runtime,
+    Handle<StringPrimitive> strPrim) {
+  auto str = strPrim->getStringRef<T>();
+  const uint32_t len = str.size();
+  uint32_t k = findCharacter(str, T('%'));
+  if (k == len) {
+    return strPrim.getHermesValue();
+  }
   SmallU16String<32> R{};
   R.reserve(len);
+  R.append(str.begin(), str.begin() + k);
 
-  uint32_t k = 0;
-  auto str = StringPrimitive::createStringView(runtime, strPrim);
   while (k < len) {
-    char16_t c = str[k];
+    // str[k] is a '%'.
     // Resultant char to append to R.
-    char16_t r = c;
-    if (c == u'%') {
-      // Try to read a hex string instead.
-      if (k + 6 <= len && str[k + 1] == u'u' &&
-          std::all_of(str.begin() + k + 2, str.begin() + k + 6, isHexChar)) {
-        // Long form %uwxyz
-        r = (fromHexChar(str[k + 2]) << 12) | (fromHexChar(str[k + 3]) << 8) |
-            (fromHexChar(str[k + 4]) << 4) | fromHexChar(str[k + 5]);
-        k += 5;
-      } else if (
-          k + 3 <= len && isHexChar(str[k + 1]) && isHexChar(str[k + 2])) {
-        // Short form %xy
-        r = (fromHexChar(str[k + 1]) << 4) | fromHexChar(str[k + 2]);
-        k += 2;
-      }
+    char16_t r = u'%';
+    // Try to read a hex string instead.
+    if (k + 6 <= len && str[k + 1] == u'u' &&
+        std::all_of(str.begin() + k + 2, str.begin() + k + 6, isHexChar)) {
+      // Long form %uwxyz
+      r = (fromHexChar(str[k + 2]) << 12) | (fromHexChar(str[k + 3]) << 8) |
+          (fromHexChar(str[k + 4]) << 4) | fromHexChar(str[k + 5]);
+      k += 5;
+    } else if (
+        k + 3 <= len && isHexChar(str[k + 1]) && isHexChar(str[k + 2])) {
+      // Short form %xy
+      r = (fromHexChar(str[k + 1]) << 4) | fromHexChar(str[k + 2]);
+      k += 2;
     }
     R.push_back(r);
     ++k;
+    uint32_t next = findCharacter(str, T('%'), k);
+    R.append(str.begin() + k, str.begin() + next);
+    k = next;
   }
 
   return StringPrimitive::create(runtime, R);
 }
 
+/// Convert the argument to string and unescape unicode characters.
+CallResult<HermesValue> unescape(void *, Runtime *runtime, NativeArgs args) {
+  auto res = toString_RJS(runtime, args.getArgHandle(runtime, 0));
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  auto strPrim = toHandle(runtime, std::move(*res));
+  return strPrim->isASCII() ? unescapeImpl<char>(runtime, strPrim)
+                            : unescapeImpl<char16_t>(runtime, strPrim);
+}
+
 /// Removes one character from the end of \p str.
 /// Used to remove the null terminator when UTF16Ref is constructed from
 /// literals.
@@ -168,61 +228,101 @@ static bool reservedURISet(char16_t c) {
   return uriReserved(c) || c == '#';
 }
 
+/// Append the escape sequences of the UTF-8 encoding of code point \p V to
+/// \p builder.
+static void appendUTF8Escaped(StringBuilder &builder, uint32_t V) {
+  char octets[UNI_MAX_UTF8_BYTES_PER_CODE_POINT];
+  char *targetStart = octets;
+  hermes::encodeUTF8(targetStart, V);
+  for (const char *octet = octets; octet != targetStart; ++octet) {
+    char escaped[3] = {
+        '%',
+        (char)toHexChar((*octet >> 4) & 0xf),
+        (char)toHexChar(*octet & 0xf)};
+    builder.appendASCIIRef({escaped, 3});
+  }
+}
+
 /// ES 5.1 15.1.3
 /// Encode abstract method, takes a string and URI encodes it.
+/// The characters of \p strHandle are stored as T. Runs of letters and digits
+/// are found a chunk at a time and copied at once, and the input is validated
+/// and the length of the result computed first, so that the result is
+/// allocated once. A string which needs no escaping is returned as is.
 /// \param unescapedSet a function indicating which characters to not escape.
-static CallResult<Handle<StringPrimitive>> encode(
+template <typename T>
+static CallResult<HermesValue> encodeImpl(
     Runtime *runtime,
     Handle<StringPrimitive> strHandle,
     CharSetFn unescapedSet) {
-  auto str = StringPrimitive::createStringView(runtime, strHandle);
-  auto strLen = str.length();
-  SmallU16String<32> R{};
-  R.reserve(strLen);
-  for (auto itr = str.begin(), e = str.end(); itr != e;) {
+  auto str = strHandle->getStringRef<T>();
+  const size_t len = str.size();
+  SafeUInt32 resultLength{};
+  for (size_t i = 0; i < len; ++i) {
+    size_t next = findNonAlphanumeric(str, i);
+    resultLength.add(next - i);
+    if ((i = next) == len)
+      break;
     // Use int32_t to allow for arithmetic past 16 bits.
-    uint32_t C = *itr;
+    uint32_t C = str[i];
     if (unescapedSet(C)) {
-      R.push_back(C);
+      resultLength.add(1);
+    } else if (C < 0x80) {
+      resultLength.add(3);
+    } else if (C < 0x800) {
+      resultLength.add(6);
+    } else if (C < 0xd800 || C > 0xdfff) {
+      resultLength.add(9);
     } else {
-      if (C >= 0xdc00 && C <= 0xdfff) {
+      // A surrogate pair encodes a code point past 0xffff, in 4 octets.
+      if (C >= 0xdc00 || i + 1 == len) {
         return runtime->raiseURIError("Malformed encodeURI input");
       }
-      // Code point to convert to UTF8.
-      uint32_t V;
-      if (C < 0xd800 || C > 0xdbff) {
-        V = C;
-      } else {
-        ++itr;
-        if (itr == e) {
-          return runtime->raiseURIError("Malformed encodeURI input");
-        }
-        uint32_t kChar = *itr;
-        if (kChar < 0xdc00 || kChar > 0xdfff) {
-          return runtime->raiseURIError("Malformed encodeURI input");
-        }
-        V = (C - 0xd800) * 0x400 + (kChar - 0xdc00) + 0x10000;
-      }
-      char octets[UNI_MAX_UTF8_BYTES_PER_CODE_POINT];
-      char *targetStart = octets;
-      hermes::encodeUTF8(targetStart, V);
-      // Length of the octets array.
-      uint32_t L = targetStart - octets;
-      for (uint32_t j = 0; j < L; ++j) {
-        auto jOctet = octets[j];
-        R.push_back(u'%');
-        R.push_back(toHexChar((jOctet >> 4) & 0xf));
-        R.push_back(toHexChar(jOctet & 0xf));
+      uint32_t kChar = str[++i];
+      if (kChar < 0xdc00 || kChar > 0xdfff) {
+        return runtime->raiseURIError("Malformed encodeURI input");
       }
+      resultLength.add(12);
     }
-    ++itr;
+  }
+  if (!resultLength.isOverflowed() && *resultLength == len) {
+    return strHandle.getHermesValue();
   }
 
-  auto finalStr = StringPrimitive::create(runtime, R);
-  if (LLVM_UNLIKELY(finalStr == ExecutionStatus::EXCEPTION)) {
+  auto builder =
+      StringBuilder::createStringBuilder(runtime, resultLength, true);
+  if (LLVM_UNLIKELY(builder == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
-  return runtime->makeHandle<StringPrimitive>(*finalStr);
+  // The allocation may have moved the string.
+  str = strHandle->getStringRef<T>();
+  for (size_t i = 0; i < len; ++i) {
+    size_t next = findNonAlphanumeric(str, i);
+    builder->appendASCIIChars(str.slice(i, next - i));
+    if ((i = next) == len)
+      break;
+    uint32_t C = str[i];
+    if (unescapedSet(C)) {
+      builder->appendCharacter(C);
+    } else if (C < 0xd800 || C > 0xdbff) {
+      appendUTF8Escaped(*builder, C);
+    } else {
+      // The pair was validated above.
+      uint32_t kChar = str[++i];
+      appendUTF8Escaped(
+          *builder, (C - 0xd800) * 0x400 + (kChar - 0xdc00) + 0x10000);
+    }
+  }
+  return builder->getStringPrimitive().getHermesValue();
+}
+
+static CallResult<HermesValue> encode(
+    Runtime *runtime,
+    Handle<StringPrimitive> strHandle,
+    CharSetFn unescapedSet) {
+  return strHandle->isASCII()
+      ? encodeImpl<char>(runtime, strHandle, unescapedSet)
+      : encodeImpl<char16_t>(runtime, strHandle, unescapedSet);
 }
 
 CallResult<HermesValue> encodeURI(void *, Runtime *runtime, NativeArgs args) {
@@ -230,11 +330,8 @@ CallResult<HermesValue> encodeURI(void *, Runtime *runtime, NativeArgs args) {
   if (LLVM_UNLIKELY(strRes == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
-  auto res =
-      encode(runtime, toHandle(runtime, std::move(*strRes)), unescapedURISet);
-  if (res == ExecutionStatus::EXCEPTION)
-    return ExecutionStatus::EXCEPTION;
-  return res->getHermesValue();
+  return encode(
+      runtime, toHandle(runtime, std::move(*strRes)), unescapedURISet);
 }
 
 CallResult<HermesValue>
@@ -243,114 +340,127 @@ encodeURIComponent(void *, Runtime *runtime, NativeArgs args) {
   if (LLVM_UNLIKELY(strRes == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
-  auto res =
-      encode(runtime, toHandle(runtime, std::move(*strRes)), uriUnescaped);
-  if (res == ExecutionStatus::EXCEPTION)
-    return ExecutionStatus::EXCEPTION;
-  return res->getHermesValue();
+  return encode(runtime, toHandle(runtime, std::move(*strRes)), uriUnescaped);
 }
 
 /// ES 5.1 15.1.3
 /// Decode abstract method, takes a string and URI decodes it.
+/// The characters of \p strHandle are stored as T. The characters between
+/// escape sequences are copied a run at a time, and a string without any '%'
+/// is returned as is.
 /// \param reservedSet a function indicating which characters to not escape.
-static CallResult<Handle<StringPrimitive>> decode(
+template <typename T>
+static CallResult<HermesValue> decodeImpl(
     Runtime *runtime,
     Handle<StringPrimitive> strHandle,
     CharSetFn reservedSet) {
-  auto str = StringPrimitive::createStringView(runtime, strHandle);
-  auto strLen = str.length();
+  auto str = strHandle->getStringRef<T>();
+  auto strLen = str.size();
+  if (findCharacter(str, T('%')) == strLen) {
+    return strHandle.getHermesValue();
+  }
   SmallU16String<32> R{};
   R.reserve(strLen);
   for (auto itr = str.begin(), e = str.end(); itr != e;) {
     char16_t C = *itr;
     if (C != u'%') {
-      // Regular character, continue.
-      R.push_back(C);
+      // Regular characters, copy up to the next escape sequence.
+      auto next = str.begin() + findCharacter(str, T('%'), itr - str.begin());
+      R.append(itr, next);
+      itr = next;
+      continue;
+    }
+    auto start = itr;
+    if (itr + 2 >= e || !(isHexChar(*(itr + 1)) && isHexChar(*(itr + 2)))) {
+      return runtime->raiseURIError("Malformed decodeURI input");
+    }
+    uint8_t B = (fromHexChar(*(itr + 1)) << 4) | fromHexChar(*(itr + 2));
+    itr += 2;
+    if ((B & 0x80) == 0) {
+      // Most significant bit of B is 0.
+      C = B;
+      if (!reservedSet(C)) {
+        R.push_back(C);
+      } else {
+        R.insert(R.end(), start, itr + 1);
+      }
     } else {
-      auto start = itr;
-      if (itr + 2 >= e || !(isHexChar(*(itr + 1)) && isHexChar(*(itr + 2)))) {
+      // Most significant bit of B is 1.
+      uint32_t n = 0;
+      // Set n to be smallest such that (B << n) & 0x80 is 0.
+      // n is set to the number of leading 1s in B.
+      for (; n <= 8 && (((B << n) & 0x80) != 0); ++n) {
+      }
+      if (n == 1 || n > 4) {
         return runtime->raiseURIError("Malformed decodeURI input");
       }
-      uint8_t B = (fromHexChar(*(itr + 1)) << 4) | fromHexChar(*(itr + 2));
-      itr += 2;
-      if ((B & 0x80) == 0) {
-        // Most significant bit of B is 0.
-        C = B;
-        if (!reservedSet(C)) {
-          R.push_back(C);
-        } else {
-          R.insert(R.end(), start, itr + 1);
-        }
-      } else {
-        // Most significant bit of B is 1.
-        uint32_t n = 0;
-        // Set n to be smallest such that (B << n) & 0x80 is 0.
-        // n is set to the number of leading 1s in B.
-        for (; n <= 8 && (((B << n) & 0x80) != 0); ++n) {
-        }
-        if (n == 1 || n > 4) {
-          return runtime->raiseURIError("Malformed decodeURI input");
-        }
-        // Safe because we ensure that n <= 4.
-        UTF8 octets[4]{B};
-        // Not enough bytes to fill all n octets.
-        if ((itr + (3 * (n - 1))) >= e) {
+      // Safe because we ensure that n <= 4.
+      UTF8 octets[4]{B};
+      // Not enough bytes to fill all n octets.
+      if ((itr + (3 * (n - 1))) >= e) {
+        return runtime->raiseURIError("Malformed decodeURI input");
+      }
+      // Populate octets.
+      for (uint32_t j = 1; j < n; ++j) {
+        ++itr;
+        if (*itr != u'%' ||
+            !(isHexChar(*(itr + 1)) && isHexChar(*(itr + 2)))) {
           return runtime->raiseURIError("Malformed decodeURI input");
         }
-        // Populate octets.
-        for (uint32_t j = 1; j < n; ++j) {
-          ++itr;
-          if (*itr != u'%' ||
-              !(isHexChar(*(itr + 1)) && isHexChar(*(itr + 2)))) {
-            return runtime->raiseURIError("Malformed decodeURI input");
-          }
-          B = (fromHexChar(*(itr + 1)) << 4) | fromHexChar(*(itr + 2));
-          if (((B >> 6) & 0x3) != 0x2) {
-            // The highest two bits aren't 10.
-            return runtime->raiseURIError("Malformed decodeURI input");
-          }
-          itr += 2;
-          octets[j] = B;
-        }
-        // Code point encoded by the n octets.
-        uint32_t V;
-        const UTF8 *sourceStart = octets;
-        const UTF8 *sourceEnd = octets + n;
-        UTF32 *targetStart = &V;
-        UTF32 *targetEnd = &V + 1;
-        ConversionResult cRes = ConvertUTF8toUTF32(
-            &sourceStart,
-            sourceEnd,
-            &targetStart,
-            targetEnd,
-            llvm::strictConversion);
-        if (cRes != ConversionResult::conversionOK) {
+        B = (fromHexChar(*(itr + 1)) << 4) | fromHexChar(*(itr + 2));
+        if (((B >> 6) & 0x3) != 0x2) {
+          // The highest two bits aren't 10.
           return runtime->raiseURIError("Malformed decodeURI input");
         }
-        if (V < 0x10000) {
-          // Safe to cast.
-          C = static_cast<char16_t>(V);
-          if (!reservedSet(C)) {
-            R.push_back(C);
-          } else {
-            R.insert(R.end(), start, itr + 1);
-          }
+        itr += 2;
+        octets[j] = B;
+      }
+      // Code point encoded by the n octets.
+      uint32_t V;
+      const UTF8 *sourceStart = octets;
+      const UTF8 *sourceEnd = octets + n;
+      UTF32 *targetStart = &V;
+      UTF32 *targetEnd = &V + 1;
+      ConversionResult cRes = ConvertUTF8toUTF32(
+          &sourceStart,
+          sourceEnd,
+          &targetStart,
+          targetEnd,
+          llvm::strictConversion);
+      if (cRes != ConversionResult::conversionOK) {
+        return runtime->raiseURIError("Malformed decodeURI input");
+      }
+      if (V < 0x10000) {
+        // Safe to cast.
+        C = static_cast<char16_t>(V);
+        if (!reservedSet(C)) {
+          R.push_back(C);
         } else {
-          // V >= 0x10000
-          // Notice that L and H are both only 2 byte values,
-          // because of they way that they're computed.
-          char16_t L = ((V - 0x10000) & 0x3ff) + 0xdc00;
-          char16_t H = (((V - 0x10000) >> 10) & 0x3ff) + 0xd800;
-          R.push_back(H);
-          R.push_back(L);
+          R.insert(R.end(), start, itr + 1);
         }
+      } else {
+        // V >= 0x10000
+        // Notice that L and H are both only 2 byte values,
+        // because of they way that they're computed.
+        char16_t L = ((V - 0x10000) & 0x3ff) + 0xdc00;
+        char16_t H = (((V - 0x10000) >> 10) & 0x3ff) + 0xd800;
+        R.push_back(H);
+        R.push_back(L);
       }
     }
     ++itr;
   }
 
-  return runtime->makeHandle<StringPrimitive>(
-      *StringPrimitive::create(runtime, R));
+  return StringPrimitive::create(runtime, R);
+}
+
+static CallResult<HermesValue> decode(
+    Runtime *runtime,
+    Handle<StringPrimitive> strHandle,
+    CharSetFn reservedSet) {
+  return strHandle->isASCII()
+      ? decodeImpl<char>(runtime, strHandle, reservedSet)
+      : decodeImpl<char16_t>(runtime, strHandle, reservedSet);
 }
 
 CallResult<HermesValue> decodeURI(void *, Runtime *runtime, NativeArgs args) {
@@ -358,11 +468,8 @@ CallResult<HermesValue> decodeURI(void *, Runtime *runtime, NativeArgs args) {
   if (LLVM_UNLIKELY(strRes == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
-  auto res =
-      decode(runtime, toHandle(runtime, std::move(*strRes)), reservedURISet);
-  if (res == ExecutionStatus::EXCEPTION)
-    return ExecutionStatus::EXCEPTION;
-  return res->getHermesValue();
+  return decode(
+      runtime, toHandle(runtime, std::move(*strRes)), reservedURISet);
 }
 
 CallResult<HermesValue>
@@ -372,10 +479,7 @@ decodeURIComponent(void *, Runtime *runtime, NativeArgs args) {
     return ExecutionStatus::EXCEPTION;
   }
   auto emptySet = [](char16_t) { return false; };
-  auto res = decode(runtime, toHandle(runtime, std::move(*strRes)), emptySet);
-  if (res == ExecutionStatus::EXCEPTION)
-    return ExecutionStatus::EXCEPTION;
-  return res->getHermesValue();
+  return decode(runtime, toHandle(runtime, std::move(*strRes)), emptySet);
 }
 
 } // namespace vm
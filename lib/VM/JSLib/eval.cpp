@@ -45,15 +45,21 @@ bool isSingleFunctionExpression(ESTree::NodePtr ast) {
   return isa<ESTree::FunctionExpressionNode>(exprStatement->_expression) ||
       isa<ESTree::ArrowFunctionExpressionNode>(exprStatement->_expression);
 }
+
+/// \return the bytes of bytecode of the functions of \p bytecode.
+size_t bytecodeSizeOf(const hbc::BCProvider &bytecode) {
+  size_t size = 0;
+  for (uint32_t i = 0, e = bytecode.getFunctionCount(); i < e; ++i)
+    size += bytecode.getFunctionHeader(i).bytecodeSizeInBytes();
+  return size;
+}
 #endif
 } // namespace
 
-CallResult<HermesValue> evalInEnvironment(
+CallResult<std::shared_ptr<hbc::BCProvider>> compileEvalSource(
     Runtime *runtime,
     llvm::StringRef utf8code,
-    Handle<Environment> environment,
     const ScopeChain &scopeChain,
-    Handle<> thisArg,
     bool singleFunction) {
 #ifdef HERMESVM_LEAN
   return runtime->raiseEvalUnsupported(utf8code);
@@ -61,6 +67,27 @@ CallResult<HermesValue> evalInEnvironment(
   if (!runtime->enableEval) {
     return runtime->raiseEvalUnsupported(utf8code);
   }
+
+  // When none of the variables of the enclosing functions are visible, the
+  // bytecode only depends on the source, singleFunction and the number of
+  // enclosing functions, so it can be shared by every evaluation of the same
+  // source. Breakpoints are written into the bytecode, so it isn't shared
+  // while a debugger is attached.
+  bool cacheable = scopeChain.functions.size() < 0x80 &&
+      std::all_of(scopeChain.functions.begin(),
+                  scopeChain.functions.end(),
+                  [](const ScopeChainItem &item) {
+                    return item.variables.empty();
+                  });
+#ifdef HERMES_ENABLE_DEBUGGER
+  cacheable &= !runtime->getDebugger().getIsDebuggerAttached();
+#endif
+  uint8_t cacheFlags = (scopeChain.functions.size() << 1) | singleFunction;
+  if (cacheable) {
+    if (auto bytecode = runtime->getEvalCache().find(utf8code, cacheFlags))
+      return bytecode;
+  }
+
   CodeGenerationSettings codeGenOpts;
   codeGenOpts.unlimitedRegisters = false;
   auto context = std::make_shared<Context>(codeGenOpts);
@@ -99,19 +126,39 @@ CallResult<HermesValue> evalInEnvironment(
 
   auto bytecodeOptions = BytecodeGenerationOptions::defaults();
   bytecodeOptions.verifyIR = runtime->verifyEvalIR;
-  auto bytecode = hbc::BCProviderFromSrc::createBCProviderFromSrc(
-      hbc::generateBytecodeModule(
-          &M, M.getTopLevelFunction(), bytecodeOptions));
+  std::shared_ptr<hbc::BCProvider> bytecode{
+      hbc::BCProviderFromSrc::createBCProviderFromSrc(
+          hbc::generateBytecodeModule(
+              &M, M.getTopLevelFunction(), bytecodeOptions))};
+  if (cacheable) {
+    runtime->getEvalCache().insert(
+        utf8code, cacheFlags, bytecode, bytecodeSizeOf(*bytecode));
+  }
+  return bytecode;
+#endif
+}
+
+CallResult<HermesValue> evalInEnvironment(
+    Runtime *runtime,
+    llvm::StringRef utf8code,
+    Handle<Environment> environment,
+    const ScopeChain &scopeChain,
+    Handle<> thisArg,
+    bool singleFunction) {
+  auto bytecodeRes =
+      compileEvalSource(runtime, utf8code, scopeChain, singleFunction);
+  if (LLVM_UNLIKELY(bytecodeRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
 
   // TODO: pass a sourceURL derived from a '//# sourceURL' comment.
   llvm::StringRef sourceURL{};
   return runtime->runBytecode(
-      std::move(bytecode),
+      std::move(*bytecodeRes),
       RuntimeModuleFlags{},
       sourceURL,
       environment,
       thisArg);
-#endif
 }
 
 CallResult<HermesValue> directEval(
@@ -6,6 +6,7 @@
  */
 #include "JSLibInternal.h"
 
+#include "hermes/VM/JSLib.h"
 #include "hermes/VM/Operations.h"
 #include "hermes/VM/StringView.h"
 
@@ -16,6 +17,17 @@ namespace vm {
 
 /// Convert all arguments to string and print them followed by new line.
 CallResult<HermesValue> print(void *, Runtime *runtime, NativeArgs args) {
+  if (LLVM_UNLIKELY(
+          printArgs(runtime, args, llvm::outs()) ==
+          ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  llvm::outs().flush();
+  return HermesValue::encodeUndefinedValue();
+}
+
+ExecutionStatus
+printArgs(Runtime *runtime, NativeArgs args, llvm::raw_ostream &os) {
   GCScope scope(runtime);
   auto marker = scope.createMarker();
   bool first = true;
@@ -27,17 +39,16 @@ CallResult<HermesValue> print(void *, Runtime *runtime, NativeArgs args) {
       return ExecutionStatus::EXCEPTION;
 
     if (!first)
-      llvm::outs() << " ";
+      os << " ";
     SmallU16String<32> tmp;
-    llvm::outs() << StringPrimitive::createStringView(
-                        runtime, toHandle(runtime, std::move(*res)))
-                        .getUTF16Ref(tmp);
+    os << StringPrimitive::createStringView(
+              runtime, toHandle(runtime, std::move(*res)))
+              .getUTF16Ref(tmp);
     first = false;
   }
 
-  llvm::outs() << "\n";
-  llvm::outs().flush();
-  return HermesValue::encodeUndefinedValue();
+  os << "\n";
+  return ExecutionStatus::RETURNED;
 }
 
 } // namespace vm
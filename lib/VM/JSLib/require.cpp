@@ -91,9 +91,12 @@ CallResult<HermesValue> runRequireCall(
     requireFn = domain->getThrowingRequire(runtime).get();
   }
 
-  CodeBlock *codeBlock = domain->getRuntimeModule(runtime, cjsModuleOffset)
-                             ->getCodeBlockMayAllocate(domain->getFunctionIndex(
-                                 runtime, cjsModuleOffset));
+  RuntimeModule *runtimeModule =
+      domain->getRuntimeModule(runtime, cjsModuleOffset);
+  uint32_t functionIndex = domain->getFunctionIndex(runtime, cjsModuleOffset);
+  CodeBlock *codeBlock = runtimeModule->getCodeBlockMayAllocate(functionIndex);
+  if (LLVM_UNLIKELY(!codeBlock))
+    return runtimeModule->raiseMalformedFunction(functionIndex);
 
   auto funcRes = JSFunction::create(
       runtime,
@@ -142,20 +145,41 @@ CallResult<HermesValue> requireFast(void *, Runtime *runtime, NativeArgs args) {
                                      .begin()
                                      ->getSavedCodeBlock()
                                      ->getRuntimeModule();
-  auto domain = runtimeModule->getDomain(runtime);
-
   uint32_t index = args.getArg(0).getNumberAs<uint32_t>();
+  HermesValue cachedExports =
+      runtimeModule->findCachedRequireFastExports(index);
+  if (LLVM_LIKELY(!cachedExports.isEmpty())) {
+    return cachedExports;
+  }
+
+  auto domain = runtimeModule->getDomain(runtime);
   OptValue<uint32_t> cjsModuleOffset =
       domain->getCJSModuleOffset(runtime, index);
+  if (LLVM_UNLIKELY(!cjsModuleOffset)) {
+    // The segment of the module may not have been loaded yet.
+    auto loadRes = runtime->loadSegmentForModule(domain, index);
+    if (LLVM_UNLIKELY(loadRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    if (*loadRes) {
+      cjsModuleOffset = domain->getCJSModuleOffset(runtime, index);
+    }
+  }
   if (LLVM_UNLIKELY(!cjsModuleOffset)) {
     return runtime->raiseTypeError(
         TwineChar16("Unable to find module with ID: ") + index);
   }
-  return runRequireCall(
+  auto res = runRequireCall(
       runtime,
       runtime->makeNullHandle<RequireContext>(),
       domain,
       *cjsModuleOffset);
+  if (LLVM_LIKELY(res != ExecutionStatus::EXCEPTION) &&
+      !domain->getCachedExports(runtime, *cjsModuleOffset)->isEmpty()) {
+    // The module is initialized, so its exports will not change anymore.
+    runtimeModule->cacheRequireFastExports(index, *res);
+  }
+  return res;
 }
 
 static llvm::SmallString<32> canonicalizePath(
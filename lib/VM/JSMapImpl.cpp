@@ -70,7 +70,7 @@ void JSMapIteratorImpl<C>::MapOrSetIteratorBuildMeta(
   ObjectBuildMeta(cell, mb);
   const auto *self = static_cast<const JSMapIteratorImpl<C> *>(cell);
   mb.addField("@data", &self->data_);
-  mb.addField("@itr", &self->itr_);
+  mb.addField("@itrEntries", &self->itrEntries_);
 }
 
 void MapIteratorBuildMeta(const GCCell *cell, Metadata::Builder &mb) {
@@ -127,6 +127,42 @@ PseudoHandle<JSObject> JSObject::create(
   return obj;
 }
 
+PseudoHandle<JSObject> JSObject::createLongLived(
+    Runtime *runtime,
+    unsigned propertyCount) {
+  void *mem = runtime->allocLongLived(sizeof(JSObject));
+  JSObject *objProto = runtime->objectPrototypeRawPtr;
+  // The parent and the class may be in the young gen, so the stores need
+  // barriers.
+  auto self = createPseudoHandle(new (mem) JSObject(
+      runtime,
+      &vt.base,
+      objProto,
+      runtime->getHiddenClassForPrototypeRaw(objProto),
+      GCPointerBase::YesBarriers()));
+  if (LLVM_LIKELY(propertyCount <= DIRECT_PROPERTY_SLOTS))
+    return self;
+
+  auto selfHandle = toHandle(runtime, std::move(self));
+  const auto size = propertyCount - DIRECT_PROPERTY_SLOTS;
+  auto *storage = vmcast<PropStorage>(runtime->ignoreAllocationFailure(
+      PropStorage::createLongLived(runtime, size)));
+  PropStorage::resizeWithinCapacity(
+      createPseudoHandle(storage), runtime, size);
+  selfHandle->propStorage_.set(runtime, storage, &runtime->getHeap());
+  return PseudoHandle<JSObject>(selfHandle);
+}
+
+PseudoHandle<JSObject> JSObject::createLongLived(
+    Runtime *runtime,
+    Handle<HiddenClass> clazz) {
+  auto obj = JSObject::createLongLived(runtime, clazz->getNumProperties());
+  obj->clazz_.set(runtime, *clazz, &runtime->getHeap());
+  if (LLVM_UNLIKELY(obj->clazz_.get(runtime)->getHasIndexLikeProperties()))
+    obj->flags_.fastIndexProperties = false;
+  return obj;
+}
+
 CallResult<HermesValue> JSObject::createWithException(
     Runtime *runtime,
     Handle<JSObject> parentHandle) {
@@ -195,10 +231,17 @@ void JSObject::allocateNewSlotStorage(
 
   // Allocate a new property storage if not already allocated.
   if (LLVM_UNLIKELY(!selfHandle->propStorage_)) {
-    // Allocate new storage.
+    // Allocate new storage. Make room for the properties that the objects of
+    // this class have been seen to get, so that objects built one property at
+    // a time (e.g. in constructors) don't have to grow it repeatedly.
     assert(newSlotIndex == 0 && "allocated slot must be at end");
-    auto arrRes = runtime->ignoreAllocationFailure(
-        PropStorage::create(runtime, DEFAULT_PROPERTY_CAPACITY));
+    unsigned maxProps =
+        selfHandle->clazz_.getNonNull(runtime)->getMaxDescendantProperties();
+    auto arrRes = runtime->ignoreAllocationFailure(PropStorage::create(
+        runtime,
+        maxProps > DIRECT_PROPERTY_SLOTS + DEFAULT_PROPERTY_CAPACITY
+            ? maxProps - DIRECT_PROPERTY_SLOTS
+            : DEFAULT_PROPERTY_CAPACITY));
     selfHandle->propStorage_.set(
         runtime, vmcast<PropStorage>(arrRes), &runtime->getHeap());
   } else if (LLVM_UNLIKELY(
@@ -228,6 +271,41 @@ void JSObject::allocateNewSlotStorage(
       .set(*valueHandle, &runtime->getHeap());
 }
 
+void JSObject::adoptClassAndSlots(
+    Handle<JSObject> selfHandle,
+    Runtime *runtime,
+    Handle<JSObject> source) {
+  assert(
+      !source->clazz_.getNonNull(runtime)->isDictionary() &&
+      "a dictionary can't be shared");
+  assert(
+      selfHandle->clazz_.getNonNull(runtime)->getNumProperties() == 0 &&
+      "the object must have no properties");
+  const unsigned numProps =
+      source->clazz_.getNonNull(runtime)->getNumProperties();
+  if (numProps > DIRECT_PROPERTY_SLOTS) {
+    const auto size = numProps - DIRECT_PROPERTY_SLOTS;
+    PropStorage *storage = selfHandle->propStorage_.get(runtime);
+    if (!storage || storage->capacity() < size) {
+      storage = vmcast<PropStorage>(runtime->ignoreAllocationFailure(
+          PropStorage::create(runtime, size)));
+      selfHandle->propStorage_.set(runtime, storage, &runtime->getHeap());
+    }
+    PropStorage::resizeWithinCapacity(
+        createPseudoHandle(storage), runtime, size);
+  }
+
+  for (SlotIndex i = 0; i < numProps; ++i) {
+    setNamedSlotValue(
+        selfHandle.get(),
+        runtime,
+        i,
+        getNamedSlotValue(source.get(), runtime, i));
+  }
+  selfHandle->clazz_.set(
+      runtime, source->clazz_.getNonNull(runtime), &runtime->getHeap());
+}
+
 SlotIndex JSObject::addInternalProperty(
     Handle<JSObject> selfHandle,
     Runtime *runtime,
@@ -829,12 +907,52 @@ ExecutionStatus JSObject::getComputedDescriptor(
   return ExecutionStatus::RETURNED;
 }
 
+/// \return true if the class of \p obj alone determines its own named
+/// properties, so that it can be part of a prototype-chain cache entry.
+static bool isCacheableOnProtoChain(JSObject *obj, Runtime *runtime) {
+  return !obj->isLazy() && !obj->isHostObject() &&
+      !obj->getClass(runtime)->isDictionary();
+}
+
+/// Populate \p entry with the lookup of a property of \p self which was found
+/// at \p slot in \p holder, if the holder is at most two levels up the
+/// prototype chain and every object involved is cacheable. \p accessor
+/// indicates an accessor property, which may also be owned by \p self.
+static void tryCacheProtoProperty(
+    JSObject *self,
+    Runtime *runtime,
+    JSObject *holder,
+    SlotIndex slot,
+    bool accessor,
+    ProtoPropertyCacheEntry &entry) {
+  if (!isCacheableOnProtoChain(self, runtime) ||
+      !isCacheableOnProtoChain(holder, runtime))
+    return;
+  JSObject *parent = self->getParent(runtime);
+  HiddenClass *intermediateClass = nullptr;
+  if (holder == self) {
+    assert(accessor && "own data properties use the class cache");
+  } else if (parent != holder) {
+    if (!parent || !isCacheableOnProtoChain(parent, runtime) ||
+        parent->getParent(runtime) != holder)
+      return;
+    intermediateClass = parent->getClass(runtime);
+  }
+  entry.receiverClass = self->getClass(runtime);
+  entry.intermediateClass = intermediateClass;
+  entry.holderClass = holder->getClass(runtime);
+  entry.slot = slot;
+  entry.accessor = accessor;
+  entry.ownProperty = holder == self;
+}
+
 CallResult<HermesValue> JSObject::getNamed_RJS(
     Handle<JSObject> selfHandle,
     Runtime *runtime,
     SymbolID name,
     PropOpFlags opFlags,
-    PropertyCacheEntry *cacheEntry) {
+    PolyPropertyCacheEntry *cacheEntry,
+    ProtoPropertyCacheEntry *protoCacheEntry) {
   NamedPropertyDescriptor desc;
 
   // Locate the descriptor. propObj contains the object which may be anywhere
@@ -852,14 +970,21 @@ CallResult<HermesValue> JSObject::getNamed_RJS(
 
   if (LLVM_LIKELY(!desc.flags.accessor && !desc.flags.hostObject)) {
     // Populate the cache if requested.
-    if (cacheEntry && !propObj->getClass(runtime)->isDictionary()) {
-      cacheEntry->clazz = propObj->getClass(runtime);
-      cacheEntry->slot = desc.slot;
+    if (cacheEntry && propObj->getClass(runtime)->isCacheable()) {
+      cacheEntry->insert(propObj->getClass(runtime), desc.slot);
+    }
+    if (protoCacheEntry && propObj != *selfHandle) {
+      tryCacheProtoProperty(
+          *selfHandle, runtime, propObj, desc.slot, false, *protoCacheEntry);
     }
     return getNamedSlotValue(propObj, runtime, desc);
   }
 
   if (desc.flags.accessor) {
+    if (protoCacheEntry) {
+      tryCacheProtoProperty(
+          *selfHandle, runtime, propObj, desc.slot, true, *protoCacheEntry);
+    }
     auto *accessor =
         vmcast<PropertyAccessor>(getNamedSlotValue(propObj, runtime, desc));
     if (!accessor->getter)
@@ -1386,7 +1511,7 @@ CallResult<bool> JSObject::deleteNamed(
     }
   }
   // If the property isn't configurable, fail.
-  if (LLVM_UNLIKELY(!desc.flags.configurable)) {
+  if (LLVM_UNLIKELY(!desc.flags.configurable && !opFlags.getInternalForce())) {
     if (opFlags.getThrowOnError()) {
       return runtime->raiseTypeError(
           TwineChar16("Property '") +
@@ -1904,6 +2029,14 @@ void JSObject::updatePropertyFlagsWithoutTransitions(
   selfHandle->clazz_.set(runtime, *newClazz, &runtime->getHeap());
 }
 
+void JSObject::makeCacheableDictionary(
+    Handle<JSObject> selfHandle,
+    Runtime *runtime) {
+  auto newClazz = HiddenClass::makeCacheableDictionary(
+      runtime->makeHandle(selfHandle->clazz_), runtime);
+  selfHandle->clazz_.set(runtime, *newClazz, &runtime->getHeap());
+}
+
 bool JSObject::isSealed(PseudoHandle<JSObject> self, Runtime *runtime) {
   if (self->flags_.sealed)
     return true;
@@ -2267,11 +2400,13 @@ namespace {
 /// Helper function to add all the property names of an object to an
 /// array, starting at the given index. Only enumerable properties are
 /// incluced. Returns the index after the last property added, but...
+/// \param[out] ownEnd the index after the last property of obj itself.
 CallResult<uint32_t> appendAllPropertyNames(
     Handle<JSObject> obj,
     Runtime *runtime,
     MutableHandle<BigStorage> &arr,
-    uint32_t beginIndex) {
+    uint32_t beginIndex,
+    uint32_t &ownEnd) {
   uint32_t size = beginIndex;
   // We know that duplicate property names can only exist between objects in
   // the prototype chain. Hence there should not be duplicated properties
@@ -2343,6 +2478,8 @@ CallResult<uint32_t> appendAllPropertyNames(
         ++size;
       }
     }
+    if (!needDedup)
+      ownEnd = size;
     // Continue to follow the prototype chain.
     head = head->getParent(runtime);
     needDedup = true;
@@ -2350,9 +2487,9 @@ CallResult<uint32_t> appendAllPropertyNames(
   return size;
 }
 
-/// Adds the hidden classes of the prototype chain of obj to arr,
-/// starting with the prototype of obj at index 0, etc., and
-/// terminates with null.
+/// Adds the hidden classes of the prototype chain of obj to arr, after a
+/// slot for the end of the own properties of obj, starting with the
+/// prototype of obj at index 1, etc., and terminates with null.
 ///
 /// \param obj The object whose prototype chain should be output
 /// \param[out] arr The array where the classes will be appended. This
@@ -2362,14 +2499,21 @@ ExecutionStatus setProtoClasses(
     Handle<JSObject> obj,
     MutableHandle<BigStorage> &arr) {
   // Layout of a JSArray stored in the for-in cache:
-  // [class(proto(obj)), class(proto(proto(obj))), ..., null, prop0, prop1, ...]
+  // [ownEnd, class(proto(obj)), class(proto(proto(obj))), ..., null,
+  //  prop0, prop1, ...]
+  // where ownEnd is the index after the last property of obj itself.
 
   if (!obj->shouldCacheForIn(runtime)) {
     arr->clear();
     return ExecutionStatus::RETURNED;
   }
   MutableHandle<JSObject> head(runtime, obj->getParent(runtime));
-  MutableHandle<> clazz(runtime);
+  MutableHandle<> clazz(runtime, HermesValue::encodeNumberValue(0));
+  if (LLVM_UNLIKELY(
+          BigStorage::push_back(arr, runtime, clazz) ==
+          ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
   GCScopeMarkerRAII marker{runtime};
   while (head.get()) {
     if (!head->shouldCacheForIn(runtime)) {
@@ -2401,7 +2545,7 @@ uint32_t matchesProtoClasses(
     Handle<JSObject> obj,
     Handle<BigStorage> arr) {
   MutableHandle<JSObject> head(runtime, obj->getParent(runtime));
-  uint32_t i = 0;
+  uint32_t i = 1;
   while (head.get()) {
     HermesValue protoCls = arr->at(i++);
     if (protoCls.isNull() || protoCls.getObject() != head->getClass(runtime)) {
@@ -2458,7 +2602,8 @@ CallResult<Handle<BigStorage>> getForInPropertyNames(
   // If obj or any of its prototypes are unsuitable for caching, then
   // beginIndex is 0 and we return an array with only the property names.
   bool canCache = beginIndex;
-  auto end = appendAllPropertyNames(obj, runtime, arr, beginIndex);
+  uint32_t ownEnd = beginIndex;
+  auto end = appendAllPropertyNames(obj, runtime, arr, beginIndex, ownEnd);
   if (end == ExecutionStatus::EXCEPTION) {
     return ExecutionStatus::EXCEPTION;
   }
@@ -2471,6 +2616,7 @@ CallResult<Handle<BigStorage>> getForInPropertyNames(
 #ifdef HERMES_SLOW_DEBUG
     assert(beginIndex == matchesProtoClasses(runtime, obj, arr) && "matches");
 #endif
+    arr->at(0).set(HermesValue::encodeNumberValue(ownEnd), &runtime->getHeap());
     clazz->setForInCache(*arr, runtime);
   }
   return arr;
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/VM/JSPromise.h"
+
+#include "hermes/VM/BuildMetadata.h"
+
+namespace hermes {
+namespace vm {
+
+//===----------------------------------------------------------------------===//
+// class JSPromise
+
+ObjectVTable JSPromise::vt{
+    VTable(CellKind::PromiseKind, sizeof(JSPromise)),
+    JSPromise::_getOwnIndexedRangeImpl,
+    JSPromise::_haveOwnIndexedImpl,
+    JSPromise::_getOwnIndexedPropertyFlagsImpl,
+    JSPromise::_getOwnIndexedImpl,
+    JSPromise::_setOwnIndexedImpl,
+    JSPromise::_deleteOwnIndexedImpl,
+    JSPromise::_checkAllOwnIndexedImpl,
+};
+
+void PromiseBuildMeta(const GCCell *cell, Metadata::Builder &mb) {
+  ObjectBuildMeta(cell, mb);
+}
+
+CallResult<HermesValue> JSPromise::create(
+    Runtime *runtime,
+    Handle<JSObject> parentHandle) {
+  void *mem = runtime->alloc(sizeof(JSPromise));
+  auto selfHandle = runtime->makeHandle(
+      JSObject::allocateSmallPropStorage<NEEDED_PROPERTY_SLOTS>(
+          new (mem) JSPromise(
+              runtime,
+              *parentHandle,
+              runtime->getHiddenClassForPrototypeRaw(*parentHandle))));
+  // The state is Pending (zero), and the result and reactions are undefined.
+  JSObject::addInternalProperties(
+      selfHandle, runtime, 3, runtime->getUndefinedValue());
+  JSObject::setInternalProperty(
+      *selfHandle,
+      runtime,
+      stateIndex,
+      HermesValue::encodeNumberValue(static_cast<double>(State::Pending)));
+  return selfHandle.getHermesValue();
+}
+
+} // namespace vm
+} // namespace hermes
@@ -102,8 +102,10 @@ ExecutionStatus JSRegExp::initialize(
       res != ExecutionStatus::EXCEPTION && *res &&
       "defineOwnProperty() failed");
 
+  selfHandle->jitEntry_ = nullptr;
   if (bytecode) {
-    selfHandle->bytecode_ = *bytecode;
+    selfHandle->bytecode_ = std::make_shared<const std::vector<uint8_t>>(
+        bytecode->begin(), bytecode->end());
   } else {
     regex::constants::SyntaxFlags nativeFlags = {};
     if (fbits->ignoreCase)
@@ -115,6 +117,13 @@ ExecutionStatus JSRegExp::initialize(
     llvm::SmallVector<char16_t, 16> patternText16;
     patternText.copyUTF16String(patternText16);
 
+    // Only the syntax flags affect the bytecode.
+    RegExpCache &cache = runtime->getRegExpCache();
+    if (RegExpBytecode cached = cache.find(patternText16, nativeFlags)) {
+      selfHandle->bytecode_ = std::move(cached);
+      return ExecutionStatus::RETURNED;
+    }
+
     // Build the regex.
     regex::Regex<regex::U16RegexTraits> regex(
         patternText16.begin(), patternText16.end(), nativeFlags);
@@ -126,7 +135,9 @@ ExecutionStatus JSRegExp::initialize(
       return ExecutionStatus::EXCEPTION;
     }
     // The regex is valid. Compile and store its bytecode.
-    selfHandle->bytecode_ = llvm::makeArrayRef(regex.compile());
+    selfHandle->bytecode_ =
+        std::make_shared<const std::vector<uint8_t>>(regex.compile());
+    cache.insert(patternText16, nativeFlags, selfHandle->bytecode_);
   }
 
   return ExecutionStatus::RETURNED;
@@ -209,12 +220,53 @@ CallResult<RegExpMatch> performSearch(
   return match;
 }
 
+/// Search the ASCII string \p start of length \p stringLength from
+/// \p searchStartOffset with the native code \p code compiled from
+/// \p bytecode.
+/// \return the match, or llvm::None if the native code gave up and the search
+///   must be interpreted.
+static llvm::Optional<RegExpMatch> performJITSearch(
+    Runtime *runtime,
+    RegexJITFunction code,
+    llvm::ArrayRef<uint8_t> bytecode,
+    const char *start,
+    uint32_t stringLength,
+    uint32_t searchStartOffset) {
+  uint16_t markedCount =
+      reinterpret_cast<const regex::RegexBytecodeHeader *>(bytecode.data())
+          ->markedCount;
+  llvm::SmallVector<const char *, 8> captures(2 * (markedCount + 1));
+  int result = runtime->getJITContext().runRegex(
+      code,
+      start,
+      start + stringLength,
+      start + searchStartOffset,
+      captures.data());
+  if (result == RegexJITGiveUp)
+    return llvm::None;
+  if (result == RegexJITNoMatch)
+    return RegExpMatch{}; // not found.
+  RegExpMatch match;
+  match.reserve(markedCount + 1);
+  for (size_t i = 0, e = captures.size(); i != e; i += 2) {
+    if (!captures[i]) {
+      assert(i > 0 && "match_result[0] should always match");
+      match.push_back(llvm::None);
+    } else {
+      uint32_t pos = captures[i] - start;
+      uint32_t length = captures[i + 1] - captures[i];
+      match.push_back(RegExpMatchRange{pos, length});
+    }
+  }
+  return match;
+}
+
 CallResult<RegExpMatch> JSRegExp::search(
     Handle<JSRegExp> selfHandle,
     Runtime *runtime,
     Handle<StringPrimitive> strHandle,
     uint32_t searchStartOffset) {
-  assert(!selfHandle->bytecode_.empty() && "Missing bytecode");
+  assert(selfHandle->bytecode_ && "Missing bytecode");
   auto input = StringPrimitive::createStringView(runtime, strHandle);
 
   // Note we may still have a match if searchStartOffset == str.size(),
@@ -232,11 +284,28 @@ CallResult<RegExpMatch> JSRegExp::search(
   }
 
   CallResult<RegExpMatch> matchResult = RegExpMatch{};
+  // The native code only searches ASCII strings. If it gives up, the search
+  // is interpreted.
+  llvm::Optional<RegExpMatch> jitMatch;
   if (input.isASCII()) {
+    if (RegexJITFunction code = runtime->getJITContext().compileRegex(
+            selfHandle->jitEntry_, *selfHandle->bytecode_)) {
+      jitMatch = performJITSearch(
+          runtime,
+          code,
+          *selfHandle->bytecode_,
+          input.castToCharPtr(),
+          input.length(),
+          searchStartOffset);
+    }
+  }
+  if (jitMatch) {
+    matchResult = std::move(*jitMatch);
+  } else if (input.isASCII()) {
     matchFlags |= regex::constants::matchInputAllAscii;
     matchResult = performSearch<char, regex::ASCIIRegexTraits>(
         runtime,
-        selfHandle->bytecode_,
+        *selfHandle->bytecode_,
         input.castToCharPtr(),
         input.length(),
         searchStartOffset,
@@ -244,7 +313,7 @@ CallResult<RegExpMatch> JSRegExp::search(
   } else {
     matchResult = performSearch<char16_t, regex::U16RegexTraits>(
         runtime,
-        selfHandle->bytecode_,
+        *selfHandle->bytecode_,
         input.castToChar16Ptr(),
         input.length(),
         searchStartOffset,
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/VM/JSTextEncoding.h"
+
+#include "hermes/VM/BuildMetadata.h"
+
+namespace hermes {
+namespace vm {
+
+//===----------------------------------------------------------------------===//
+// class JSTextEncoder
+
+ObjectVTable JSTextEncoder::vt{
+    VTable(CellKind::TextEncoderKind, sizeof(JSTextEncoder)),
+    JSTextEncoder::_getOwnIndexedRangeImpl,
+    JSTextEncoder::_haveOwnIndexedImpl,
+    JSTextEncoder::_getOwnIndexedPropertyFlagsImpl,
+    JSTextEncoder::_getOwnIndexedImpl,
+    JSTextEncoder::_setOwnIndexedImpl,
+    JSTextEncoder::_deleteOwnIndexedImpl,
+    JSTextEncoder::_checkAllOwnIndexedImpl,
+};
+
+void TextEncoderBuildMeta(const GCCell *cell, Metadata::Builder &mb) {
+  ObjectBuildMeta(cell, mb);
+}
+
+CallResult<HermesValue> JSTextEncoder::create(
+    Runtime *runtime,
+    Handle<JSObject> parentHandle) {
+  void *mem = runtime->alloc(sizeof(JSTextEncoder));
+  return HermesValue::encodeObjectValue(
+      JSObject::allocateSmallPropStorage<NEEDED_PROPERTY_SLOTS>(
+          new (mem) JSTextEncoder(
+              runtime,
+              *parentHandle,
+              runtime->getHiddenClassForPrototypeRaw(*parentHandle))));
+}
+
+//===----------------------------------------------------------------------===//
+// class JSTextDecoder
+
+ObjectVTable JSTextDecoder::vt{
+    VTable(CellKind::TextDecoderKind, sizeof(JSTextDecoder)),
+    JSTextDecoder::_getOwnIndexedRangeImpl,
+    JSTextDecoder::_haveOwnIndexedImpl,
+    JSTextDecoder::_getOwnIndexedPropertyFlagsImpl,
+    JSTextDecoder::_getOwnIndexedImpl,
+    JSTextDecoder::_setOwnIndexedImpl,
+    JSTextDecoder::_deleteOwnIndexedImpl,
+    JSTextDecoder::_checkAllOwnIndexedImpl,
+};
+
+void TextDecoderBuildMeta(const GCCell *cell, Metadata::Builder &mb) {
+  ObjectBuildMeta(cell, mb);
+}
+
+CallResult<HermesValue> JSTextDecoder::create(
+    Runtime *runtime,
+    Handle<JSObject> parentHandle) {
+  void *mem = runtime->alloc(sizeof(JSTextDecoder));
+  auto selfHandle = runtime->makeHandle(
+      JSObject::allocateSmallPropStorage<NEEDED_PROPERTY_SLOTS>(
+          new (mem) JSTextDecoder(
+              runtime,
+              *parentHandle,
+              runtime->getHiddenClassForPrototypeRaw(*parentHandle))));
+  // No flags and no pending bytes.
+  JSObject::addInternalProperties(
+      selfHandle,
+      runtime,
+      2,
+      runtime->makeHandle(HermesValue::encodeNumberValue(0)));
+  return selfHandle.getHermesValue();
+}
+
+} // namespace vm
+} // namespace hermes
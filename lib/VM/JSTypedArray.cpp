@@ -12,6 +12,41 @@
 namespace hermes {
 namespace vm {
 
+namespace {
+
+/// Store the \p count elements at \p src into \p dst, converted to the
+/// element type of JSTypedArray<T, C> the same way storing each of them as a
+/// number would. The loop has no calls or branches on the kinds, so that it
+/// can be vectorized.
+template <typename T, CellKind C, typename S>
+void copyConverted(T *dst, const S *src, JSTypedArrayBase::size_type count) {
+  for (JSTypedArrayBase::size_type i = 0; i < count; ++i) {
+    dst[i] = JSTypedArray<T, C>::toDestType(static_cast<double>(src[i]));
+  }
+}
+
+/// Dispatch copyConverted() on the kind of \p dst, writing from index
+/// \p dstIndex.
+template <typename S>
+void copyConvertedTo(
+    JSTypedArrayBase *dst,
+    JSTypedArrayBase::size_type dstIndex,
+    const S *src,
+    JSTypedArrayBase::size_type count) {
+  switch (dst->getKind()) {
+#define TYPED_ARRAY(name, type)                                         \
+  case CellKind::name##ArrayKind:                                       \
+    copyConverted<type, CellKind::name##ArrayKind>(                     \
+        reinterpret_cast<type *>(dst->begin()) + dstIndex, src, count); \
+    break;
+#include "hermes/VM/TypedArrays.def"
+    default:
+      llvm_unreachable("Invalid TypedArray kind");
+  }
+}
+
+} // namespace
+
 /// @name JSTypedArrayBase
 /// @{
 
@@ -187,14 +222,19 @@ ExecutionStatus JSTypedArrayBase::setToCopyOfTypedArray(
     JSTypedArrayBase::setToCopyOfBytes(
         runtime, dst, dstIndex, src, srcIndex, count);
   } else {
-    // Else must do type conversions.
-    MutableHandle<> storage(runtime);
-    for (auto k = srcIndex; k < srcIndex + count; ++k) {
-      storage = JSObject::getOwnIndexed(*src, runtime, k);
-      if (JSObject::setOwnIndexed(dst, runtime, dstIndex++, storage) ==
-          ExecutionStatus::EXCEPTION) {
-        return ExecutionStatus::EXCEPTION;
-      }
+    // Else must do type conversions, of numbers only, which can't fail.
+    switch (src->getKind()) {
+#define TYPED_ARRAY(name, type)                                  \
+  case CellKind::name##ArrayKind:                                \
+    copyConvertedTo(                                             \
+        *dst,                                                    \
+        dstIndex,                                                \
+        reinterpret_cast<const type *>(src->begin()) + srcIndex, \
+        count);                                                  \
+    break;
+#include "hermes/VM/TypedArrays.def"
+      default:
+        llvm_unreachable("Invalid TypedArray kind");
     }
   }
   return ExecutionStatus::RETURNED;
@@ -99,31 +99,16 @@ HermesValue JSWeakMapImplBase::getValue(
 /// Mark weak references and remove any invalid weak refs.
 void JSWeakMapImplBase::markWeakRefs(GC *gc) {
   for (auto it = map_.begin(); it != map_.end(); ++it) {
-    // We must mark the weak ref regardless of whether the ref is valid here,
-    // because JSWeakMapImplBase still has a pointer from map_ into the
-    // reference. If we were to skip marking this particular ref, it could be
-    // freed before we have a chance to remove the pointer from map_.
-    // Then, if the GC runs before we call deleteInternal on the ref,
-    // we would attempt to call markWeakRef on a freed ref, which is a violation
-    // of the markWeakRef contract.
-    gc->markWeakRef(it->first.ref);
     if (!it->first.ref.isValid()) {
-      // Set the hasFreeableSlots_ to indicate that this slot can be
-      // cleaned up the next time we add an element to this map.
-      hasFreeableSlots_ = true;
-    }
-  }
-}
-
-/// Mark weak references and remove any invalid weak refs.
-void JSWeakMapImplBase::findAndDeleteFreeSlots(PointerBase *base) {
-  for (auto it = map_.begin(); it != map_.end(); ++it) {
-    if (!it->first.ref.isValid()) {
-      // If invalid, clear the value and remove the key from the map.
-      deleteInternal(base, it);
+      // The key died in an earlier collection.  Remove the entry now, so that
+      // this collection frees its weak ref slot: a ref that map_ still points
+      // to must be marked, since calling markWeakRef on a freed ref violates
+      // its contract.  Erasing doesn't invalidate the other iterators.
+      deleteInternal(gc->getPointerBase(), it);
+      continue;
     }
+    gc->markWeakRef(it->first.ref);
   }
-  hasFreeableSlots_ = false;
 }
 
 void JSWeakMapImplBase::deleteInternal(
@@ -140,12 +125,6 @@ void JSWeakMapImplBase::deleteInternal(
 CallResult<uint32_t> JSWeakMapImplBase::getFreeValueStorageIndex(
     Handle<JSWeakMapImplBase> self,
     Runtime *runtime) {
-  if (self->freeListHead_ == kFreeListInvalid && self->hasFreeableSlots_) {
-    // No elements in the free list and there are freeable slots.
-    // Try to find some.
-    self->findAndDeleteFreeSlots(runtime);
-  }
-
   // Index in valueStorage_ in which to place the new element.
   uint32_t i;
   // True if using the nextIndex field to get i.
@@ -6,6 +6,9 @@
  */
 #include "hermes/VM/Operations.h"
 
+#include "JSLib/JSLibInternal.h"
+
+#include "hermes/Inst/Inst.h"
 #include "hermes/Support/Conversions.h"
 #include "hermes/Support/OSCompat.h"
 #include "hermes/VM/Callable.h"
@@ -33,6 +36,17 @@ namespace vm {
 CallResult<Handle<SymbolID>> stringToSymbolID(
     Runtime *runtime,
     PseudoHandle<StringPrimitive> strPrim) {
+  // Small indices have cached identifiers, which are cheaper to find than
+  // the entry of the string in the identifier table.
+  if (!strPrim->isUniqued()) {
+    auto index = shortStringToArrayIndex(strPrim.get());
+    if (index && *index < Runtime::kNumIndexSymbols) {
+      auto symRes = runtime->getIndexSymbol(*index);
+      if (LLVM_UNLIKELY(symRes == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      return runtime->makeHandle(*symRes);
+    }
+  }
   // Unique the string.
   return runtime->getIdentifierTable().getSymbolHandleFromPrimitive(
       runtime, std::move(strPrim));
@@ -44,6 +58,16 @@ CallResult<Handle<SymbolID>> valueToSymbolID(
   if (nameValHnd->isSymbol()) {
     return Handle<SymbolID>::vmcast(nameValHnd);
   }
+  // Small indices don't need to be converted to a string.
+  if (nameValHnd->isNumber()) {
+    auto index = hermes::doubleToArrayIndex(nameValHnd->getNumber());
+    if (index && *index < Runtime::kNumIndexSymbols) {
+      auto symRes = runtime->getIndexSymbol(*index);
+      if (LLVM_UNLIKELY(symRes == ExecutionStatus::EXCEPTION))
+        return ExecutionStatus::EXCEPTION;
+      return runtime->makeHandle(*symRes);
+    }
+  }
   // Convert the value to a string.
   auto res = toString_RJS(runtime, nameValHnd);
   if (res == ExecutionStatus::EXCEPTION)
@@ -92,6 +116,27 @@ HermesValue typeOf(Runtime *runtime, Handle<> valueHandle) {
   }
 }
 
+uint8_t typeOfIsType(HermesValue value) {
+  switch (value.getTag()) {
+    case UndefinedTag:
+      return inst::TypeOfIsUndefined;
+    case NullTag:
+      return inst::TypeOfIsObject;
+    case StrTag:
+      return inst::TypeOfIsString;
+    case BoolTag:
+      return inst::TypeOfIsBoolean;
+    case SymbolTag:
+      return inst::TypeOfIsSymbol;
+    case ObjectTag:
+      return vmisa<Callable>(value) ? inst::TypeOfIsFunction
+                                    : inst::TypeOfIsObject;
+    default:
+      assert(value.isNumber() && "Invalid type.");
+      return inst::TypeOfIsNumber;
+  }
+}
+
 OptValue<uint32_t> toArrayIndex(
     Runtime *runtime,
     Handle<StringPrimitive> strPrim) {
@@ -99,6 +144,20 @@ OptValue<uint32_t> toArrayIndex(
   return toArrayIndex(view);
 }
 
+OptValue<uint32_t> shortStringToArrayIndex(const StringPrimitive *str) {
+  // The largest index, 2**32-2, has 10 digits.
+  constexpr uint32_t kMaxIndexLength = 10;
+  uint32_t len = str->getStringLength();
+  if (len == 0 || len > kMaxIndexLength)
+    return llvm::None;
+  if (str->isASCII()) {
+    ASCIIRef ref = str->getStringRef<char>();
+    return hermes::toArrayIndex(ref.begin(), ref.end());
+  }
+  UTF16Ref ref = str->getStringRef<char16_t>();
+  return hermes::toArrayIndex(ref.begin(), ref.end());
+}
+
 OptValue<uint32_t> toArrayIndex(StringView str) {
   auto len = str.length();
   if (str.isASCII()) {
@@ -163,6 +222,12 @@ bool isPrimitive(HermesValue val) {
   }
 }
 
+/// \return whether \p value is a native function which calls \p functionPtr.
+static bool isNativeFunction(HermesValue value, NativeFunctionPtr functionPtr) {
+  auto *native = dyn_vmcast<NativeFunction>(value);
+  return native && native->getFunctionPtr() == functionPtr;
+}
+
 CallResult<HermesValue> ordinaryToPrimitive(
     Handle<JSObject> selfHandle,
     Runtime *runtime,
@@ -178,6 +243,11 @@ CallResult<HermesValue> ordinaryToPrimitive(
           selfHandle, runtime, Predefined::getSymbolID(Predefined::toString));
       if (propRes == ExecutionStatus::EXCEPTION)
         return ExecutionStatus::EXCEPTION;
+      // The built-in Object.prototype.toString, which gives "[object Object]"
+      // for most objects, is called without setting up a call frame. It
+      // always returns a string.
+      if (isNativeFunction(*propRes, objectPrototypeToString))
+        return directObjectPrototypeToString(runtime, selfHandle);
       if (auto funcHandle = Handle<Callable>::dyn_vmcast(
               runtime, runtime->makeHandle(*propRes))) {
         auto callRes =
@@ -195,6 +265,12 @@ CallResult<HermesValue> ordinaryToPrimitive(
           selfHandle, runtime, Predefined::getSymbolID(Predefined::valueOf));
       if (propRes == ExecutionStatus::EXCEPTION)
         return ExecutionStatus::EXCEPTION;
+      // The built-in Object.prototype.valueOf returns the object itself, which
+      // isn't primitive, so it doesn't need to be called.
+      if (isNativeFunction(*propRes, objectPrototypeValueOf)) {
+        preferredType = PreferredType::STRING;
+        continue;
+      }
       if (auto funcHandle = Handle<Callable>::dyn_vmcast(
               runtime, runtime->makeHandle(*propRes))) {
         auto callRes =
@@ -223,6 +299,17 @@ toPrimitive_RJS(Runtime *runtime, Handle<> valueHandle, PreferredType hint) {
     case NativeValueTag:
       llvm_unreachable("native value");
     case ObjectTag: {
+      // Ordinary objects have no @@toPrimitive anywhere in their prototype
+      // chain, so the lookup can be skipped.
+      if (LLVM_LIKELY(!JSObject::mayHaveWellKnownSymbol(
+              vmcast<JSObject>(*valueHandle),
+              runtime,
+              Predefined::SymbolToPrimitive))) {
+        return ordinaryToPrimitive(
+            Handle<JSObject>::vmcast(valueHandle),
+            runtime,
+            hint == PreferredType::NONE ? PreferredType::NUMBER : hint);
+      }
       // 4. Let exoticToPrim be GetMethod(input, @@toPrimitive).
       auto exoticToPrim = getMethod(
           runtime,
@@ -308,6 +395,17 @@ static CallResult<PseudoHandle<StringPrimitive>> numberToString(
   // Optimization: Fast-case for positive integers < 2^31
   int32_t n = static_cast<int32_t>(m);
   if (m == static_cast<double>(n) && n > 0) {
+    // Small integers are the strings of the cached index identifiers, which
+    // are only allocated once.
+    if (n < (int32_t)Runtime::kNumIndexSymbols) {
+      auto symRes = runtime->getIndexSymbol(n);
+      if (LLVM_UNLIKELY(symRes == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      return createPseudoHandle(
+          runtime->getIdentifierTable().getStringPrim(runtime, *symRes));
+    }
+
     // Write base 10 digits in reverse from end of buf8.
     char *p = buf8 + sizeof(buf8);
     do {
@@ -346,10 +444,11 @@ static CallResult<PseudoHandle<StringPrimitive>> numberToString(
   return createPseudoHandle(vmcast<StringPrimitive>(*result));
 }
 
-CallResult<PseudoHandle<StringPrimitive>> toString_RJS(
+/// Convert the primitive \p value to a string without creating handles. Only
+/// numbers which are not small integers allocate a new string.
+static CallResult<PseudoHandle<StringPrimitive>> primitiveToString(
     Runtime *runtime,
-    Handle<> valueHandle) {
-  HermesValue value = valueHandle.get();
+    HermesValue value) {
   StringPrimitive *result;
   switch (value.getTag()) {
     case EmptyTag:
@@ -370,13 +469,8 @@ CallResult<PseudoHandle<StringPrimitive>> toString_RJS(
           ? runtime->getPredefinedString(Predefined::trueStr)
           : runtime->getPredefinedString(Predefined::falseStr);
       break;
-    case ObjectTag: {
-      auto res = toPrimitive_RJS(runtime, valueHandle, PreferredType::STRING);
-      if (res == ExecutionStatus::EXCEPTION) {
-        return ExecutionStatus::EXCEPTION;
-      }
-      return toString_RJS(runtime, runtime->makeHandle(res.getValue()));
-    }
+    case ObjectTag:
+      llvm_unreachable("not a primitive");
     case SymbolTag:
       return runtime->raiseTypeError("Cannot convert Symbol to string");
     default:
@@ -386,6 +480,19 @@ CallResult<PseudoHandle<StringPrimitive>> toString_RJS(
   return createPseudoHandle(result);
 }
 
+CallResult<PseudoHandle<StringPrimitive>> toString_RJS(
+    Runtime *runtime,
+    Handle<> valueHandle) {
+  if (LLVM_LIKELY(!valueHandle->isObject())) {
+    return primitiveToString(runtime, *valueHandle);
+  }
+  auto res = toPrimitive_RJS(runtime, valueHandle, PreferredType::STRING);
+  if (res == ExecutionStatus::EXCEPTION) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  return primitiveToString(runtime, *res);
+}
+
 double parseIntWithRadix(const StringView str, int radix) {
   auto res = hermes::parseIntWithRadix(str, radix);
   return res ? res.getValue() : std::numeric_limits<double>::quiet_NaN();
@@ -395,6 +502,14 @@ double parseIntWithRadix(const StringView str, int radix) {
 static inline double stringToNumber(
     Runtime *runtime,
     Handle<StringPrimitive> strPrim) {
+  // Most strings converted to numbers are ASCII decimal literals without
+  // whitespace, which need none of the checks below.
+  if (strPrim->isASCII()) {
+    auto ascii = strPrim->getStringRef<char>();
+    if (auto fast = parseDecimalFast(ascii.begin(), ascii.end()))
+      return *fast;
+  }
+
   auto &idTable = runtime->getIdentifierTable();
 
   // Fast check for special values (no extraneous whitespace).
@@ -467,6 +582,10 @@ static inline double stringToNumber(
     }
   }
 
+  // Most numbers are converted exactly without dtoa.
+  if (auto fast = parseDecimalFast(str16.begin(), str16.end()))
+    return *fast;
+
   // Finally, copy 16 bit chars into 8 bit chars and call dtoa.
   llvm::SmallVector<char, 32> str8(len + 1);
   uint32_t i = 0;
@@ -768,42 +887,57 @@ ExecutionStatus amendPropAccessErrorMsgWithPropName(
       valueStr);
 }
 
+/// Convert \p valueHandle to a primitive with \p hint, creating a handle for
+/// the result only if it is an object, which is the only case where the
+/// conversion doesn't return the value itself.
+static CallResult<Handle<>> toPrimitiveHandle(
+    Runtime *runtime,
+    Handle<> valueHandle,
+    PreferredType hint) {
+  if (LLVM_LIKELY(!valueHandle->isObject()))
+    return valueHandle;
+  auto res = toPrimitive_RJS(runtime, valueHandle, hint);
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  return runtime->makeHandle(*res);
+}
+
 /// Implement a comparison operator. First both operands a converted to
 /// primitives. If they both end up being strings, a lexicographical comparison
 /// is performed. Otherwise both operands are converted to numbers and the
-/// values are compared.
+/// values are compared. Handles are only created for the primitive values of
+/// objects.
 /// \param oper is the comparison operator to use when comparing numbers.
-#define IMPLEMENT_COMPARISON_OP(name, oper)                           \
-  CallResult<bool> name(                                              \
-      Runtime *runtime, Handle<> leftHandle, Handle<> rightHandle) {  \
-    auto resLeft =                                                    \
-        toPrimitive_RJS(runtime, leftHandle, PreferredType::NUMBER);  \
-    if (resLeft == ExecutionStatus::EXCEPTION)                        \
-      return ExecutionStatus::EXCEPTION;                              \
-    MutableHandle<> left(runtime, resLeft.getValue());                \
-                                                                      \
-    auto resRight =                                                   \
-        toPrimitive_RJS(runtime, rightHandle, PreferredType::NUMBER); \
-    if (resRight == ExecutionStatus::EXCEPTION)                       \
-      return ExecutionStatus::EXCEPTION;                              \
-    MutableHandle<> right(runtime, resRight.getValue());              \
-                                                                      \
-    /* If both are strings, we must do a string comparison.*/         \
-    if (left->isString() && right->isString()) {                      \
-      return left->getString()->compare(right->getString()) oper 0;   \
-    }                                                                 \
-                                                                      \
-    /* Convert both to a number and compare the numbers. */           \
-    resLeft = toNumber_RJS(runtime, left);                            \
-    if (resLeft == ExecutionStatus::EXCEPTION)                        \
-      return ExecutionStatus::EXCEPTION;                              \
-    left = resLeft.getValue();                                        \
-    resRight = toNumber_RJS(runtime, right);                          \
-    if (resRight == ExecutionStatus::EXCEPTION)                       \
-      return ExecutionStatus::EXCEPTION;                              \
-    right = resRight.getValue();                                      \
-                                                                      \
-    return left->getNumber() oper right->getNumber();                 \
+#define IMPLEMENT_COMPARISON_OP(name, oper)                                  \
+  CallResult<bool> name(                                                     \
+      Runtime *runtime, Handle<> leftHandle, Handle<> rightHandle) {         \
+    if (leftHandle->isNumber() && rightHandle->isNumber())                   \
+      return leftHandle->getNumber() oper rightHandle->getNumber();          \
+                                                                             \
+    auto left =                                                              \
+        toPrimitiveHandle(runtime, leftHandle, PreferredType::NUMBER);       \
+    if (left == ExecutionStatus::EXCEPTION)                                  \
+      return ExecutionStatus::EXCEPTION;                                     \
+    auto right =                                                             \
+        toPrimitiveHandle(runtime, rightHandle, PreferredType::NUMBER);      \
+    if (right == ExecutionStatus::EXCEPTION)                                 \
+      return ExecutionStatus::EXCEPTION;                                     \
+                                                                             \
+    /* If both are strings, we must do a string comparison.*/                \
+    if ((*left)->isString() && (*right)->isString()) {                       \
+      return (*left)->getString()->compare((*right)->getString()) oper 0;    \
+    }                                                                        \
+                                                                             \
+    /* Convert both to a number and compare the numbers. */                  \
+    auto resLeft = toNumber_RJS(runtime, *left);                             \
+    if (resLeft == ExecutionStatus::EXCEPTION)                               \
+      return ExecutionStatus::EXCEPTION;                                     \
+    double leftNum = resLeft->getNumber();                                   \
+    auto resRight = toNumber_RJS(runtime, *right);                           \
+    if (resRight == ExecutionStatus::EXCEPTION)                              \
+      return ExecutionStatus::EXCEPTION;                                     \
+                                                                             \
+    return leftNum oper resRight->getNumber();                               \
   }
 
 IMPLEMENT_COMPARISON_OP(lessOp_RJS, <);
@@ -812,6 +946,17 @@ IMPLEMENT_COMPARISON_OP(lessEqualOp_RJS, <=);
 IMPLEMENT_COMPARISON_OP(greaterEqualOp_RJS, >=);
 CallResult<HermesValue>
 abstractEqualityTest_RJS(Runtime *runtime, Handle<> xHandle, Handle<> yHandle) {
+  // Values of the same type are compared like with ===, and null and
+  // undefined are equal, without creating handles.
+  if (xHandle->getTag() == yHandle->getTag() ||
+      (xHandle->isNumber() && yHandle->isNumber())) {
+    return HermesValue::encodeBoolValue(strictEqualityTest(*xHandle, *yHandle));
+  }
+  if ((xHandle->isNull() || xHandle->isUndefined()) &&
+      (yHandle->isNull() || yHandle->isUndefined())) {
+    return HermesValue::encodeBoolValue(true);
+  }
+
   MutableHandle<> x{runtime, xHandle.get()};
   MutableHandle<> y{runtime, yHandle.get()};
 
@@ -956,45 +1101,54 @@ bool strictEqualityTest(HermesValue x, HermesValue y) {
   return false;
 }
 
+/// Convert the primitive \p value to a string, reusing its handle if it is
+/// already a string.
+static CallResult<Handle<StringPrimitive>> toStringHandle(
+    Runtime *runtime,
+    Handle<> value) {
+  if (value->isString())
+    return Handle<StringPrimitive>::vmcast(value);
+  auto res = primitiveToString(runtime, *value);
+  if (LLVM_UNLIKELY(res == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  return toHandle(runtime, std::move(*res));
+}
+
 CallResult<HermesValue>
 addOp_RJS(Runtime *runtime, Handle<> xHandle, Handle<> yHandle) {
-  auto resX = toPrimitive_RJS(runtime, xHandle, PreferredType::NONE);
-  if (resX == ExecutionStatus::EXCEPTION) {
+  auto xRes = toPrimitiveHandle(runtime, xHandle, PreferredType::NONE);
+  if (xRes == ExecutionStatus::EXCEPTION) {
     return ExecutionStatus::EXCEPTION;
   }
-  auto x = runtime->makeHandle(resX.getValue());
+  Handle<> x = *xRes;
 
-  auto resY = toPrimitive_RJS(runtime, yHandle, PreferredType::NONE);
-  if (resY == ExecutionStatus::EXCEPTION) {
+  auto yRes = toPrimitiveHandle(runtime, yHandle, PreferredType::NONE);
+  if (yRes == ExecutionStatus::EXCEPTION) {
     return ExecutionStatus::EXCEPTION;
   }
-  auto y = runtime->makeHandle(resY.getValue());
+  Handle<> y = *yRes;
 
   // If one of the values is a string, concatenate as strings.
   if (x->isString() || y->isString()) {
-    auto resX = toString_RJS(runtime, x);
-    if (resX == ExecutionStatus::EXCEPTION) {
+    auto xStr = toStringHandle(runtime, x);
+    if (xStr == ExecutionStatus::EXCEPTION) {
       return ExecutionStatus::EXCEPTION;
     }
-    auto xStr = toHandle(runtime, std::move(*resX));
-
-    auto resY = toString_RJS(runtime, y);
-    if (resY == ExecutionStatus::EXCEPTION) {
+    auto yStr = toStringHandle(runtime, y);
+    if (yStr == ExecutionStatus::EXCEPTION) {
       return ExecutionStatus::EXCEPTION;
     }
-    auto yStr = toHandle(runtime, std::move(*resY));
-
-    return StringPrimitive::concat(runtime, xStr, yStr);
+    return StringPrimitive::concat(runtime, *xStr, *yStr);
   }
 
   // Add the numbers since neither are strings.
-  resX = toNumber_RJS(runtime, x);
+  auto resX = toNumber_RJS(runtime, x);
   if (LLVM_UNLIKELY(resX == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
   auto xNum = resX.getValue().getNumber();
 
-  resY = toNumber_RJS(runtime, y);
+  auto resY = toNumber_RJS(runtime, y);
   if (LLVM_UNLIKELY(resY == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
@@ -1553,6 +1707,10 @@ CallResult<bool> isConcatSpreadable(Runtime *runtime, Handle<> value) {
   if (!O) {
     return false;
   }
+  if (!JSObject::mayHaveWellKnownSymbol(
+          *O, runtime, Predefined::SymbolIsConcatSpreadable)) {
+    return vmisa<JSArray>(*O);
+  }
 
   CallResult<HermesValue> spreadable = JSObject::getNamed_RJS(
       O,
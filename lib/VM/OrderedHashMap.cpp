@@ -13,25 +13,6 @@
 
 namespace hermes {
 namespace vm {
-//===----------------------------------------------------------------------===//
-// class HashMapEntry
-
-VTable HashMapEntry::vt{CellKind::HashMapEntryKind, sizeof(HashMapEntry)};
-
-void HashMapEntryBuildMeta(const GCCell *cell, Metadata::Builder &mb) {
-  const auto *self = static_cast<const HashMapEntry *>(cell);
-  mb.addField("@key", &self->key);
-  mb.addField("@value", &self->value);
-  mb.addField("@prevIterationEntry", &self->prevIterationEntry);
-  mb.addField("@nextIterationEntry", &self->nextIterationEntry);
-  mb.addField("@nextEntryInBucket", &self->nextEntryInBucket);
-}
-
-CallResult<HermesValue> HashMapEntry::create(Runtime *runtime) {
-  void *mem = runtime->alloc(sizeof(HashMapEntry));
-  return HermesValue::encodeObjectValue(new (mem) HashMapEntry(runtime));
-}
-
 //===----------------------------------------------------------------------===//
 // class OrderedHashMap
 
@@ -39,145 +20,139 @@ VTable OrderedHashMap::vt{CellKind::OrderedHashMapKind, sizeof(OrderedHashMap)};
 
 void OrderedHashMapBuildMeta(const GCCell *cell, Metadata::Builder &mb) {
   const auto *self = static_cast<const OrderedHashMap *>(cell);
+  mb.addField("@entries", &self->entries_);
   mb.addField("@hashTable", &self->hashTable_);
-  mb.addField("@firstIterationEntry", &self->firstIterationEntry_);
-  mb.addField("@lastIterationEntry", &self->lastIterationEntry_);
 }
 
 OrderedHashMap::OrderedHashMap(
     Runtime *runtime,
-    Handle<ArrayStorage> hashTableStorage)
+    Handle<ArrayStorage> entries,
+    Handle<ArrayStorage> hashTable)
     : GCCell(&runtime->getHeap(), &vt),
-      hashTable_(runtime, hashTableStorage.get(), &runtime->getHeap()) {
-  ArrayStorage::resizeWithinCapacity(
-      hashTableStorage, runtime, INITIAL_CAPACITY);
-}
+      entries_(runtime, entries.get(), &runtime->getHeap()),
+      hashTable_(runtime, hashTable.get(), &runtime->getHeap()) {}
 
 CallResult<HermesValue> OrderedHashMap::create(Runtime *runtime) {
-  auto arrRes = ArrayStorage::create(runtime, INITIAL_CAPACITY);
-  if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION)) {
+  const uint32_t entriesSize = keyIndex(INITIAL_CAPACITY);
+  auto entriesRes = ArrayStorage::create(runtime, entriesSize, entriesSize);
+  if (LLVM_UNLIKELY(entriesRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  auto entries = runtime->makeHandle<ArrayStorage>(*entriesRes);
+  auto tableRes =
+      ArrayStorage::create(runtime, INITIAL_CAPACITY * 2, INITIAL_CAPACITY * 2);
+  if (LLVM_UNLIKELY(tableRes == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
-  auto hashTableStorage = runtime->makeHandle<ArrayStorage>(*arrRes);
+  auto hashTable = runtime->makeHandle<ArrayStorage>(*tableRes);
 
   void *mem = runtime->alloc(sizeof(OrderedHashMap));
   return HermesValue::encodeObjectValue(
-      new (mem) OrderedHashMap(runtime, hashTableStorage));
+      new (mem) OrderedHashMap(runtime, entries, hashTable));
 }
 
-void OrderedHashMap::removeLinkedListNode(
+uint32_t OrderedHashMap::lookup(
     Runtime *runtime,
-    HashMapEntry *entry,
-    GC *gc) {
-  assert(
-      entry != lastIterationEntry_.get(runtime) &&
-      "Cannot remove the last entry");
-  if (entry->prevIterationEntry) {
-    entry->prevIterationEntry.get(runtime)->nextIterationEntry.set(
-        runtime, entry->nextIterationEntry, gc);
-  }
-  if (entry->nextIterationEntry) {
-    entry->nextIterationEntry.get(runtime)->prevIterationEntry.set(
-        runtime, entry->prevIterationEntry, gc);
-  }
-  if (entry == firstIterationEntry_.get(runtime)) {
-    firstIterationEntry_.set(runtime, entry->nextIterationEntry, gc);
+    HermesValue key,
+    uint32_t hash) const {
+  ArrayStorage *table = hashTable_.get(runtime);
+  ArrayStorage *entries = entries_.get(runtime);
+  const uint32_t mask = table->size() - 1;
+  // The table always has empty slots, since it has twice as many slots as
+  // there are entries.
+  for (uint32_t i = hash & mask;; i = (i + 1) & mask) {
+    HermesValue slot = table->at(i);
+    if (slot.isEmpty()) {
+      return NOT_FOUND;
+    }
+    auto entry = (uint32_t)slot.getNumber();
+    // Deleted entries have an empty key, which is never the same as key.
+    // Comparing the hashes first avoids comparing most strings.
+    if (entries->at(keyIndex(entry) + 2).getNumber() == hash &&
+        isSameValueZero(entries->at(keyIndex(entry)), key)) {
+      return entry;
+    }
   }
-  entry->prevIterationEntry = nullptr;
 }
 
-HashMapEntry *OrderedHashMap::lookupInBucket(
+void OrderedHashMap::addToHashTable(
     Runtime *runtime,
-    uint32_t bucket,
-    HermesValue key) {
-  assert(
-      hashTable_.get(runtime)->size() == capacity_ && "Inconsistent capacity");
-  auto *entry = dyn_vmcast<HashMapEntry>(hashTable_.get(runtime)->at(bucket));
-  while (entry && !isSameValueZero(entry->key, key)) {
-    entry = entry->nextEntryInBucket.get(runtime);
+    uint32_t entry,
+    uint32_t hash) {
+  ArrayStorage *table = hashTable_.get(runtime);
+  ArrayStorage *entries = entries_.get(runtime);
+  const uint32_t mask = table->size() - 1;
+  // A slot of a deleted entry can be reused, since that entry is never looked
+  // up again.
+  uint32_t i = hash & mask;
+  for (;; i = (i + 1) & mask) {
+    HermesValue slot = table->at(i);
+    if (slot.isEmpty() ||
+        entries->at(keyIndex((uint32_t)slot.getNumber())).isEmpty()) {
+      break;
+    }
   }
-  return entry;
+  table->at(i).setNonPtr(HermesValue::encodeNumberValue(entry));
 }
 
-ExecutionStatus OrderedHashMap::rehashIfNecessary(
+ExecutionStatus OrderedHashMap::rehash(
     Handle<OrderedHashMap> self,
-    Runtime *runtime) {
-  uint32_t newCapacity = self->capacity_;
-  // NOTE: we have ensured that self->capacity_ * 4 never overflows uint32_t by
-  // setting MAX_CAPACITY to the apropriate value. self->size_ is always <=
-  // self->capacity_, so this applies to self->size_ as well.
-  static_assert(
-      MAX_CAPACITY < UINT32_MAX / 4,
-      "Avoid overflow checks on multiplying capacity by 4");
-  if (self->size_ * 4 > self->capacity_ * 3) {
-    // Load factor is more than 0.75, need to increase the capacity.
-    newCapacity = self->capacity_ * 2;
-    if (LLVM_UNLIKELY(newCapacity > MAX_CAPACITY)) {
-      // We maintain the invariant that the capacity_ is a power of two.
-      // Therefore, if doubling would exceed the max, we revert to the
-      // previous value.  (Assert the invariant to make it clear.)
-      assert(
-          (self->capacity_ & (self->capacity_ - 1)) == 0 &&
-          "capacity_ must be power of 2");
-      newCapacity = self->capacity_;
-    }
-  } else if (
-      self->size_ * 4 < self->capacity_ && self->capacity_ > INITIAL_CAPACITY) {
-    // Load factor is less than 0.25, and we are not at initial cap.
-    newCapacity = self->capacity_ / 2;
-  }
-  if (newCapacity == self->capacity_) {
-    // No need to rehash.
-    return ExecutionStatus::RETURNED;
-  }
+    Runtime *runtime,
+    uint32_t newCapacity) {
   assert(
-      self->size_ && self->firstIterationEntry_ && self->lastIterationEntry_ &&
-      "We should never be rehashing when there are no elements");
-
-  // Set new capacity first to update the hash function.
-  self->capacity_ = newCapacity;
+      (newCapacity & (newCapacity - 1)) == 0 &&
+      "capacity must be a power of 2");
+  assert(newCapacity >= self->size_ && "new capacity is too small");
+  if (LLVM_UNLIKELY(newCapacity > MAX_CAPACITY)) {
+    return runtime->raiseRangeError("Too many elements in Map or Set");
+  }
 
-  // Create a new hash table.
-  auto arrRes = ArrayStorage::create(runtime, newCapacity, newCapacity);
-  if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION)) {
+  const uint32_t entriesSize = keyIndex(newCapacity);
+  auto entriesRes = ArrayStorage::create(runtime, entriesSize, entriesSize);
+  if (LLVM_UNLIKELY(entriesRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  auto newEntries = runtime->makeHandle<ArrayStorage>(*entriesRes);
+  auto tableRes =
+      ArrayStorage::create(runtime, newCapacity * 2, newCapacity * 2);
+  if (LLVM_UNLIKELY(tableRes == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
-  auto newHashTable = runtime->makeHandle<ArrayStorage>(*arrRes);
-
-  // Now re-add all entries to the hash table.
-  MutableHandle<HashMapEntry> entry{runtime};
-  MutableHandle<HashMapEntry> oldNextInBucket{runtime};
-  MutableHandle<> keyHandle{runtime};
-  GCScopeMarkerRAII marker{runtime};
-  for (unsigned i = 0, len = self->hashTable_.get(runtime)->size(); i < len;
-       ++i) {
-    entry = dyn_vmcast<HashMapEntry>(self->hashTable_.get(runtime)->at(i));
-    while (entry) {
-      marker.flush();
-      keyHandle = entry->key;
-      uint32_t bucket = hashToBucket(self, runtime, keyHandle);
-      oldNextInBucket = entry->nextEntryInBucket.get(runtime);
-      if (newHashTable->at(bucket).isEmpty()) {
-        // Empty bucket.
-        entry->nextEntryInBucket = nullptr;
-      } else {
-        // There are already a bucket head.
-        entry->nextEntryInBucket.set(
-            runtime,
-            vmcast<HashMapEntry>(newHashTable->at(bucket)),
-            &runtime->getHeap());
-      }
-      // Update bucket head to the new entry.
-      newHashTable->at(bucket).set(entry.getHermesValue(), &runtime->getHeap());
 
-      entry = *oldNextInBucket;
+  // No allocation happens below.
+  ArrayStorage *oldEntries = self->entries_.get(runtime);
+  GC *gc = &runtime->getHeap();
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < self->numEntries_; ++i) {
+    uint32_t from = keyIndex(i);
+    HermesValue key = oldEntries->at(from);
+    if (!key.isEmpty()) {
+      uint32_t to = keyIndex(count);
+      newEntries->at(to).set(key, gc);
+      newEntries->at(to + 1).set(oldEntries->at(from + 1), gc);
+      newEntries->at(to + 2).setNonPtr(oldEntries->at(from + 2));
+    }
+    // Leave the index the entry, or the next one which wasn't deleted, has in
+    // the new storage, for the iterators.
+    oldEntries->at(from).setNonPtr(HermesValue::encodeNumberValue(count));
+    oldEntries->at(from + 1).setNonPtr(HermesValue::encodeEmptyValue());
+    if (!key.isEmpty()) {
+      ++count;
     }
   }
+  assert(count == self->size_ && "inconsistent number of entries");
+  oldEntries->at(ForwardSlot).set(newEntries.getHermesValue(), gc);
+  oldEntries->at(ForwardEndSlot)
+      .setNonPtr(HermesValue::encodeNumberValue(count));
 
-  self->hashTable_.set(runtime, newHashTable.get(), &runtime->getHeap());
-  assert(
-      self->hashTable_.get(runtime)->size() == self->capacity_ &&
-      "Inconsistent capacity");
+  self->entries_.set(runtime, newEntries.get(), gc);
+  self->hashTable_.set(runtime, vmcast<ArrayStorage>(*tableRes), gc);
+  self->capacity_ = newCapacity;
+  self->numEntries_ = count;
+  for (uint32_t i = 0; i < count; ++i) {
+    self->addToHashTable(
+        runtime, i, (uint32_t)newEntries->at(keyIndex(i) + 2).getNumber());
+  }
   return ExecutionStatus::RETURNED;
 }
 
@@ -185,27 +160,28 @@ bool OrderedHashMap::has(
     Handle<OrderedHashMap> self,
     Runtime *runtime,
     Handle<> key) {
-  auto bucket = hashToBucket(self, runtime, key);
-  return self->lookupInBucket(runtime, bucket, key.getHermesValue());
+  uint32_t hash = hashKey(runtime, key);
+  return self->lookup(runtime, key.get(), hash) != NOT_FOUND;
 }
 
-HashMapEntry *OrderedHashMap::find(
+HermesValue OrderedHashMap::find(
     Handle<OrderedHashMap> self,
     Runtime *runtime,
     Handle<> key) {
-  auto bucket = hashToBucket(self, runtime, key);
-  return self->lookupInBucket(runtime, bucket, key.getHermesValue());
+  uint32_t hash = hashKey(runtime, key);
+  uint32_t entry = self->lookup(runtime, key.get(), hash);
+  if (entry == NOT_FOUND) {
+    return HermesValue::encodeEmptyValue();
+  }
+  return self->entries_.get(runtime)->at(keyIndex(entry) + 1);
 }
 
 HermesValue OrderedHashMap::get(
     Handle<OrderedHashMap> self,
     Runtime *runtime,
     Handle<> key) {
-  auto *entry = find(self, runtime, key);
-  if (!entry) {
-    return HermesValue::encodeUndefinedValue();
-  }
-  return entry->value;
+  HermesValue value = find(self, runtime, key);
+  return value.isEmpty() ? HermesValue::encodeUndefinedValue() : value;
 }
 
 ExecutionStatus OrderedHashMap::insert(
@@ -213,158 +189,108 @@ ExecutionStatus OrderedHashMap::insert(
     Runtime *runtime,
     Handle<> key,
     Handle<> value) {
-  uint32_t bucket = hashToBucket(self, runtime, key);
-  if (auto *entry =
-          self->lookupInBucket(runtime, bucket, key.getHermesValue())) {
+  uint32_t hash = hashKey(runtime, key);
+  uint32_t entry = self->lookup(runtime, key.get(), hash);
+  if (entry != NOT_FOUND) {
     // Element already exists, update value and return.
-    entry->value.set(value.get(), &runtime->getHeap());
+    self->entries_.get(runtime)->at(keyIndex(entry) + 1).set(
+        value.get(), &runtime->getHeap());
     return ExecutionStatus::RETURNED;
   }
-  // Create a new entry, set the key and value.
-  auto crtRes = HashMapEntry::create(runtime);
-  if (LLVM_UNLIKELY(crtRes == ExecutionStatus::EXCEPTION)) {
-    return ExecutionStatus::EXCEPTION;
-  }
-  auto newMapEntry = runtime->makeHandle<HashMapEntry>(*crtRes);
-  newMapEntry->key.set(key.get(), &runtime->getHeap());
-  newMapEntry->value.set(value.get(), &runtime->getHeap());
-  auto *curBucketFront =
-      dyn_vmcast<HashMapEntry>(self->hashTable_.get(runtime)->at(bucket));
-  if (curBucketFront) {
-    // If the bucket we are inserting to is not empty, we maintain the
-    // linked list properly.
-    newMapEntry->nextEntryInBucket.set(
-        runtime, curBucketFront, &runtime->getHeap());
-  }
-  // Set the newly inserted entry as the front of this bucket chain.
-  self->hashTable_.get(runtime)->at(bucket).set(
-      newMapEntry.getHermesValue(), &runtime->getHeap());
 
-  if (!self->firstIterationEntry_) {
-    // If we are inserting the first ever element, update
-    // first iteration entry pointer.
-    self->firstIterationEntry_.set(
-        runtime, newMapEntry.get(), &runtime->getHeap());
-    self->lastIterationEntry_.set(
-        runtime, newMapEntry.get(), &runtime->getHeap());
-  } else {
-    // Connect the new entry with the last entry.
-    self->lastIterationEntry_.get(runtime)->nextIterationEntry.set(
-        runtime, newMapEntry.get(), &runtime->getHeap());
-    newMapEntry->prevIterationEntry.set(
-        runtime, self->lastIterationEntry_, &runtime->getHeap());
-
-    HashMapEntry *previousLastEntry = self->lastIterationEntry_.get(runtime);
-    self->lastIterationEntry_.set(
-        runtime, newMapEntry.get(), &runtime->getHeap());
-
-    if (previousLastEntry && previousLastEntry->isDeleted()) {
-      // If the last entry was a deleted entry, we no longer need to keep it.
-      self->removeLinkedListNode(
-          runtime, previousLastEntry, &runtime->getHeap());
+  if (self->numEntries_ == self->capacity_) {
+    // Grow if at least half the entries are alive, otherwise only move them
+    // to drop the deleted ones.
+    uint32_t newCapacity = self->size_ >= self->capacity_ / 2
+        ? self->capacity_ * 2
+        : self->capacity_;
+    if (LLVM_UNLIKELY(
+            rehash(self, runtime, newCapacity) == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
     }
   }
 
+  entry = self->numEntries_++;
+  ArrayStorage *entries = self->entries_.get(runtime);
+  entries->at(keyIndex(entry)).set(key.get(), &runtime->getHeap());
+  entries->at(keyIndex(entry) + 1).set(value.get(), &runtime->getHeap());
+  entries->at(keyIndex(entry) + 2)
+      .setNonPtr(HermesValue::encodeNumberValue(hash));
+  self->addToHashTable(runtime, entry, hash);
   self->size_++;
-  return self->rehashIfNecessary(self, runtime);
+  return ExecutionStatus::RETURNED;
 }
 
 bool OrderedHashMap::erase(
     Handle<OrderedHashMap> self,
     Runtime *runtime,
     Handle<> key) {
-  uint32_t bucket = hashToBucket(self, runtime, key);
-  HashMapEntry *prevEntry = nullptr;
-  auto *entry =
-      dyn_vmcast<HashMapEntry>(self->hashTable_.get(runtime)->at(bucket));
-  while (entry && !isSameValueZero(entry->key, key.getHermesValue())) {
-    prevEntry = entry;
-    entry = entry->nextEntryInBucket.get(runtime);
-  }
-  if (!entry) {
+  uint32_t hash = hashKey(runtime, key);
+  uint32_t entry = self->lookup(runtime, key.get(), hash);
+  if (entry == NOT_FOUND) {
     // Element does not exist.
     return false;
   }
 
-  if (prevEntry) {
-    // The entry we are deleting has a previous entry, update the link.
-    prevEntry->nextEntryInBucket.set(
-        runtime, entry->nextEntryInBucket, &runtime->getHeap());
-  } else {
-    // The entry we are erasing is the front entry in the bucket, we need
-    // to update the bucket head to the next entry in the bucket, if not
-    // any, set to empty value.
-    self->hashTable_.get(runtime)->at(bucket).set(
-        entry->nextEntryInBucket ? HermesValue::encodeObjectValue(
-                                       entry->nextEntryInBucket.get(runtime))
-                                 : HermesValue::encodeEmptyValue(),
-        &runtime->getHeap());
-  }
-
-  entry->markDeleted();
+  // Its slot in the hash table is left to point to it, until it is reused.
+  ArrayStorage *entries = self->entries_.get(runtime);
+  entries->at(keyIndex(entry)).setNonPtr(HermesValue::encodeEmptyValue());
+  entries->at(keyIndex(entry) + 1).setNonPtr(HermesValue::encodeEmptyValue());
   self->size_--;
 
-  // Now delete the entry from the iteration linked list.
-  // If we are deleting the last entry, don't remove it from the list yet.
-  // This will ensure that if any iterator out there is currently pointing to
-  // this entry, it will be able to follow on if we add new entries in the
-  // future.
-  if (entry != self->lastIterationEntry_.get(runtime)) {
-    self->removeLinkedListNode(runtime, entry, &runtime->getHeap());
+  if (self->size_ * 4 < self->capacity_ &&
+      self->capacity_ > INITIAL_CAPACITY) {
+    // Less than a quarter of the capacity is used, shrink the storage. A
+    // failure leaves the map as it was, which is still valid.
+    if (LLVM_UNLIKELY(
+            rehash(self, runtime, self->capacity_ / 2) ==
+            ExecutionStatus::EXCEPTION)) {
+      runtime->clearThrownValue();
+    }
   }
-
-  self->rehashIfNecessary(self, runtime);
-
   return true;
 }
 
-HashMapEntry *OrderedHashMap::iteratorNext(
-    Runtime *runtime,
-    HashMapEntry *entry) const {
-  if (entry == nullptr) {
-    // Starting a new iteration from the first entry.
-    entry = firstIterationEntry_.get(runtime);
-  } else {
-    // Advance to the next entry.
-    entry = entry->nextIterationEntry.get(runtime);
+ExecutionStatus OrderedHashMap::clear(
+    Handle<OrderedHashMap> self,
+    Runtime *runtime) {
+  if (!self->numEntries_) {
+    // Nothing was ever added since the last rehash.
+    return ExecutionStatus::RETURNED;
   }
-
-  // Make sure the entry we returned (if not nullptr) must not be deleted.
-  while (entry && entry->isDeleted()) {
-    entry = entry->nextIterationEntry.get(runtime);
+  ArrayStorage *entries = self->entries_.get(runtime);
+  for (uint32_t i = 0; i < self->numEntries_; ++i) {
+    entries->at(keyIndex(i)).setNonPtr(HermesValue::encodeEmptyValue());
+    entries->at(keyIndex(i) + 1).setNonPtr(HermesValue::encodeEmptyValue());
   }
-  return entry;
+  self->size_ = 0;
+  // Move to storages of the initial size. The iterators which haven't reached
+  // the end continue with the entries added afterwards.
+  return rehash(self, runtime, INITIAL_CAPACITY);
 }
 
-void OrderedHashMap::clear(Runtime *runtime) {
-  if (!firstIterationEntry_) {
-    // Empty set.
-    return;
+bool OrderedHashMap::iteratorNext(
+    Runtime *runtime,
+    ArrayStorage *&entries,
+    uint32_t &index) {
+  // Follow the storages which replaced this one, to the one in use.
+  while (!entries->at(ForwardSlot).isEmpty()) {
+    HermesValue moved = keyIndex(index) < entries->size()
+        ? entries->at(keyIndex(index))
+        : HermesValue::encodeEmptyValue();
+    // Entries which were never added have no index.
+    index = moved.isEmpty() ? (uint32_t)entries->at(ForwardEndSlot).getNumber()
+                            : (uint32_t)moved.getNumber();
+    entries = vmcast<ArrayStorage>(entries->at(ForwardSlot));
   }
 
-  // Clear the hash table.
-  for (unsigned i = 0; i < capacity_; ++i) {
-    auto entry = dyn_vmcast<HashMapEntry>(hashTable_.get(runtime)->at(i));
-    // Delete every element reachable from the hash table.
-    while (entry) {
-      entry->markDeleted();
-      entry = entry->nextEntryInBucket.get(runtime);
+  // Entries which were deleted, or were never added, have an empty key.
+  for (uint32_t e = entries->size(); keyIndex(index) < e; ++index) {
+    if (!entries->at(keyIndex(index)).isEmpty()) {
+      return true;
     }
-    // Clear every element in the hash table.
-    hashTable_.get(runtime)->at(i).setNonPtr(HermesValue::encodeEmptyValue());
   }
-  // Resize the hash table to the initial size.
-  ArrayStorage::resizeWithinCapacity(
-      createPseudoHandle(hashTable_.get(runtime)), runtime, INITIAL_CAPACITY);
-  capacity_ = INITIAL_CAPACITY;
-
-  // After clearing, we will still keep the last deleted entry
-  // in case there is an iterator out there
-  // pointing to the middle of the iteration chain. We need it to be
-  // able to merge back eventually.
-  firstIterationEntry_.set(runtime, lastIterationEntry_, &runtime->getHeap());
-  firstIterationEntry_.get(runtime)->prevIterationEntry = nullptr;
-  size_ = 0;
+  return false;
 }
 
 } // namespace vm
@@ -201,12 +201,26 @@ CallResult<HermesValue> JSStringIterator::create(
 CallResult<HermesValue> JSStringIterator::nextElement(
     Handle<JSStringIterator> self,
     Runtime *runtime) {
+  auto valueRes = nextValue(self, runtime);
+  if (LLVM_UNLIKELY(valueRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  if (valueRes->isEmpty()) {
+    return createIterResultObject(runtime, runtime->getUndefinedValue(), true)
+        .getHermesValue();
+  }
+  return createIterResultObject(runtime, runtime->makeHandle(*valueRes), false)
+      .getHermesValue();
+}
+
+CallResult<HermesValue> JSStringIterator::nextValue(
+    Handle<JSStringIterator> self,
+    Runtime *runtime) {
   // 4. Let s be the value of the [[IteratedString]] internal slot of O.
   auto s = runtime->makeHandle(self->iteratedString_);
   if (!s) {
     // 5. If s is undefined, return CreateIterResultObject(undefined, true).
-    return createIterResultObject(runtime, runtime->getUndefinedValue(), true)
-        .getHermesValue();
+    return HermesValue::encodeEmptyValue();
   }
 
   // 6. Let position be the value of the [[StringIteratorNextIndex]] internal
@@ -220,8 +234,7 @@ CallResult<HermesValue> JSStringIterator::nextElement(
     // undefined.
     self->iteratedString_ = nullptr;
     // 8b. Return CreateIterResultObject(undefined, true).
-    return createIterResultObject(runtime, runtime->getUndefinedValue(), true)
-        .getHermesValue();
+    return HermesValue::encodeEmptyValue();
   }
 
   MutableHandle<StringPrimitive> resultString{runtime};
@@ -256,7 +269,7 @@ CallResult<HermesValue> JSStringIterator::nextElement(
   self->nextIndex_ = position + resultString->getStringLength();
 
   // 14. Return CreateIterResultObject(resultString, false).
-  return createIterResultObject(runtime, resultString, false).getHermesValue();
+  return resultString.getHermesValue();
 }
 
 //===----------------------------------------------------------------------===//
@@ -39,8 +39,13 @@ std::shared_ptr<ChromeStackFrameNode> ChromeStackFrameNode::findOrAddNewChild(
     uint32_t pid,
     const SamplingProfiler::ThreadNamesMap &threadNames,
     const std::vector<SamplingProfiler::StackTrace> &sampledStacks) {
-  ChromeFrameIdGenerator frameIdGen;
   ChromeTraceFormat trace{pid, threadNames};
+  trace.addSamples(sampledStacks);
+  return trace;
+}
+
+void ChromeTraceFormat::addSamples(
+    const std::vector<SamplingProfiler::StackTrace> &sampledStacks) {
   for (const SamplingProfiler::StackTrace &sample : sampledStacks) {
     std::shared_ptr<ChromeStackFrameNode> leafNode;
     assert(sample.stack.size() > 0 && "Why does the sample have no stack?");
@@ -52,20 +57,31 @@ std::shared_ptr<ChromeStackFrameNode> ChromeStackFrameNode::findOrAddNewChild(
          ++iter) {
       const SamplingProfiler::StackFrame &frame = *iter;
       if (isRootFrame) {
-        leafNode = findOrAddNewHelper(frameIdGen, trace.callTrees_, frame);
+        leafNode = findOrAddNewHelper(frameIdGen_, callTrees_, frame);
         isRootFrame = false;
       } else {
-        leafNode = leafNode->findOrAddNewChild(frameIdGen, frame);
+        leafNode = leafNode->findOrAddNewChild(frameIdGen_, frame);
       }
     }
     assert(leafNode != nullptr && "Why can't we find a leaf node?");
-    trace.sampleEvents_.emplace_back(sample.tid, sample.timeStamp, leafNode);
+    sampleEvents_.emplace_back(sample.tid, sample.timeStamp, leafNode);
   }
-  return trace;
 }
 
-ChromeTraceSerializer::ChromeTraceSerializer(ChromeTraceFormat &&chromeTrace)
-    : trace_(std::move(chromeTrace)) {
+std::pair<ChromeTraceFormat, uint32_t> ChromeTraceFormat::takeChunk() {
+  ChromeTraceFormat chunk{pid_, threadNames_};
+  chunk.callTrees_ = callTrees_;
+  chunk.sampleEvents_ = std::move(sampleEvents_);
+  sampleEvents_.clear();
+  uint32_t firstFrameId = firstUnsentFrameId_;
+  firstUnsentFrameId_ = frameIdGen_.peekNextFrameNodeId();
+  return {std::move(chunk), firstFrameId};
+}
+
+ChromeTraceSerializer::ChromeTraceSerializer(
+    ChromeTraceFormat &&chromeTrace,
+    uint32_t firstFrameId)
+    : trace_(std::move(chromeTrace)), firstFrameId_(firstFrameId) {
   firstEventTimeStamp_ = trace_.getSampledEvents().empty()
       ? std::chrono::steady_clock::now()
       : trace_.getSampledEvents()[0].getTimeStamp();
@@ -179,9 +195,13 @@ void ChromeTraceSerializer::serializeSampledEvents(JSONEmitter &json) const {
 
 void ChromeTraceSerializer::serializeStackFrames(JSONEmitter &json) const {
   for (const auto &tree : trace_.getCallTree()) {
-    tree->dfsWalk([&json](
+    tree->dfsWalk([this, &json](
                       const ChromeStackFrameNode &node,
                       const ChromeStackFrameNode *parent) {
+      if (node.getId() < firstFrameId_) {
+        // Already in an earlier chunk.
+        return;
+      }
       json.emitKey(oscompat::to_string(node.getId()));
       json.openDict();
 
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/VM/Profiler/CodeCoverage.h"
+
+#include "hermes/BCGen/HBC/BytecodeDataProvider.h"
+#include "hermes/Inst/InstDecode.h"
+#include "hermes/Support/JSONEmitter.h"
+#include "hermes/VM/CodeBlock.h"
+#include "hermes/VM/Runtime.h"
+
+#include "llvm/Support/MathExtras.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace hermes {
+namespace vm {
+
+using inst::Inst;
+using inst::OpCode;
+using inst::OperandType;
+
+namespace {
+
+/// The basic blocks of a function.
+struct BasicBlocks {
+  /// The offset of the first instruction of every block, in order, followed
+  /// by the offset of the end of the instructions.
+  std::vector<uint32_t> starts;
+  /// Whether the block is entered by falling through from the previous one,
+  /// which the interpreter doesn't record.
+  std::vector<bool> fallsThrough;
+};
+
+/// Find the basic blocks of \p bytecode.
+BasicBlocks discoverBlocks(llvm::ArrayRef<uint8_t> bytecode) {
+  std::vector<uint32_t> labels{0};
+  // The instructions are followed by the jump tables of the switches, if any.
+  uint32_t end = bytecode.size();
+  // Indexed by offset: whether the instruction that ends there continues
+  // with the next one without a branch.
+  std::vector<bool> silentEnd(bytecode.size() + 1, false);
+
+  for (uint32_t offset = 0; offset < end;) {
+    const Inst *ip = reinterpret_cast<const Inst *>(bytecode.data() + offset);
+    auto decoded = inst::decodeInstruction(ip);
+    bool branch = false;
+    if (decoded.meta.opCode == OpCode::Catch) {
+      // Handlers are only entered by an exception.
+      labels.push_back(offset);
+      silentEnd[offset] = false;
+    }
+    for (unsigned i = 0; i < decoded.meta.numOperands; ++i) {
+      if (decoded.meta.operandType[i] == OperandType::Addr8 ||
+          decoded.meta.operandType[i] == OperandType::Addr32) {
+        labels.push_back(offset + decoded.operandValue[i].integer);
+        branch = true;
+      }
+    }
+    if (decoded.meta.opCode == OpCode::SwitchImm) {
+      // Same computation as the interpreter.
+      const uint8_t *table = (const uint8_t *)llvm::alignAddr(
+          (const uint8_t *)ip + ip->iSwitchImm.op2, sizeof(uint32_t));
+      end = std::min(end, (uint32_t)(table - bytecode.data()));
+      const uint32_t *entries = (const uint32_t *)table;
+      for (uint32_t i = 0; i <= ip->iSwitchImm.op5 - ip->iSwitchImm.op4; ++i)
+        labels.push_back(offset + entries[i]);
+    }
+    offset += decoded.meta.size;
+    if (branch) {
+      // Conditional branches record the next instruction when they are not
+      // taken.
+      labels.push_back(offset);
+    } else {
+      switch (decoded.meta.opCode) {
+        case OpCode::Ret:
+        case OpCode::Throw:
+        case OpCode::Unreachable:
+          break;
+        default:
+          silentEnd[offset] = true;
+      }
+    }
+  }
+
+  std::sort(labels.begin(), labels.end());
+  labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+  // Drop the label after the last instruction, if there is one.
+  while (!labels.empty() && labels.back() >= end)
+    labels.pop_back();
+
+  BasicBlocks blocks;
+  blocks.starts = std::move(labels);
+  for (uint32_t start : blocks.starts)
+    blocks.fallsThrough.push_back(silentEnd[start]);
+  blocks.starts.push_back(end);
+  return blocks;
+}
+
+} // namespace
+
+void CodeCoverage::clear(Runtime *runtime) {
+  for (auto &module : runtime->getRuntimeModules()) {
+    for (CodeBlock *codeBlock : module.getFunctionMap()) {
+      if (codeBlock)
+        codeBlock->clearCoverage();
+    }
+  }
+}
+
+void CodeCoverage::serialize(Runtime *runtime, llvm::raw_ostream &os) {
+  JSONEmitter json(os);
+  json.openDict();
+  json.emitKey("functions");
+  json.openArray();
+  for (auto &module : runtime->getRuntimeModules()) {
+    hbc::BCProvider *bcProvider = module.getBytecode();
+    // The functions of lazy modules are listed with the module that they
+    // were compiled for.
+    if (!bcProvider || bcProvider->isLazy())
+      continue;
+    const auto &functionMap = module.getFunctionMap();
+    for (uint32_t functionID = 0, e = bcProvider->getFunctionCount();
+         functionID < e;
+         ++functionID) {
+      CodeBlock *codeBlock =
+          functionID < functionMap.size() ? functionMap[functionID] : nullptr;
+      llvm::ArrayRef<uint8_t> bytecode;
+      const hbc::DebugInfo *debugInfo = nullptr;
+      OptValue<uint32_t> debugOffset;
+      if (codeBlock) {
+        // A function compiled lazily which never ran has no bytecode yet.
+        if (codeBlock->isLazy())
+          continue;
+        bytecode = codeBlock->getOpcodeArray();
+        debugInfo =
+            codeBlock->getRuntimeModule()->getBytecode()->getDebugInfo();
+        debugOffset = codeBlock->getDebugSourceLocationsOffset();
+      } else {
+        if (bcProvider->isFunctionLazy(functionID))
+          continue;
+        bytecode = {
+            bcProvider->getBytecode(functionID),
+            bcProvider->getFunctionHeader(functionID).bytecodeSizeInBytes()};
+        debugInfo = bcProvider->getDebugInfo();
+        const hbc::DebugOffsets *debugOffsets =
+            bcProvider->getDebugOffsets(functionID);
+        if (debugOffsets &&
+            debugOffsets->sourceLocations != hbc::DebugOffsets::NO_OFFSET)
+          debugOffset = debugOffsets->sourceLocations;
+      }
+      auto locationOf = [debugInfo, debugOffset](uint32_t offset) {
+        return debugOffset
+            ? debugInfo->getLocationForAddress(*debugOffset, offset)
+            : OptValue<hbc::DebugSourceLocation>(llvm::None);
+      };
+
+      std::string url;
+      if (auto location = locationOf(0))
+        url = debugInfo->getFilenameByID(location->filenameId);
+      else
+        url = module.getSourceURL().str();
+      const llvm::BitVector *coverage =
+          codeBlock ? codeBlock->getCoverage() : nullptr;
+
+      json.openDict();
+      json.emitKeyValue(
+          "functionName",
+          bcProvider->getStringRefFromID(
+              bcProvider->getFunctionHeader(functionID).functionName()));
+      json.emitKeyValue("functionId", functionID);
+      json.emitKeyValue("url", url);
+      json.emitKey("blocks");
+      json.openArray();
+      BasicBlocks blocks = discoverBlocks(bytecode);
+      bool covered = false;
+      for (size_t i = 0, n = blocks.starts.size() - 1; i < n; ++i) {
+        uint32_t start = blocks.starts[i];
+        covered = coverage &&
+            (coverage->test(start) || (covered && blocks.fallsThrough[i]));
+        json.openDict();
+        json.emitKeyValue("offset", start);
+        json.emitKeyValue("size", blocks.starts[i + 1] - start);
+        // Line and column numbers are 1-based, and 0 when they are not known.
+        auto location = locationOf(start);
+        json.emitKeyValue("line", location ? location->line : 0);
+        json.emitKeyValue("column", location ? location->column : 0);
+        json.emitKeyValue("covered", covered);
+        json.closeDict();
+      }
+      json.closeArray();
+      json.closeDict();
+    }
+  }
+  json.closeArray();
+  json.closeDict();
+}
+
+} // namespace vm
+} // namespace hermes
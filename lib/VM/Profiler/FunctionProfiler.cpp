@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/VM/Profiler/FunctionProfiler.h"
+
+#include "hermes/BCGen/HBC/BytecodeDataProvider.h"
+#include "hermes/Support/JSONEmitter.h"
+#include "hermes/VM/CodeBlock.h"
+#include "hermes/VM/Runtime.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace hermes {
+namespace vm {
+
+FunctionTimeAttribution::State FunctionTimeAttribution::switchTo(
+    State state) {
+  auto now = std::chrono::steady_clock::now();
+  if (current_.codeBlock) {
+    current_.codeBlock->addAttributedTime(
+        current_.category,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - since_)
+            .count());
+  }
+  since_ = now;
+  State previous = current_;
+  current_ = state;
+  return previous;
+}
+
+FunctionProfiler::FunctionProfiler(
+    std::atomic<bool> &tick,
+    std::chrono::microseconds interval)
+    : tick_(tick), interval_(interval) {
+  assert(interval.count() > 0 && "Sampling interval must be positive");
+  timerThread_ = std::thread(&FunctionProfiler::timerLoop, this);
+}
+
+FunctionProfiler::~FunctionProfiler() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  stopCondVar_.notify_one();
+  timerThread_.join();
+}
+
+void FunctionProfiler::timerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stopCondVar_.wait_for(lock, interval_, [this] { return stop_; }))
+    tick_.store(true, std::memory_order_relaxed);
+}
+
+void FunctionProfiler::clear(Runtime *runtime) {
+  for (auto &module : runtime->getRuntimeModules()) {
+    for (CodeBlock *codeBlock : module.getFunctionMap()) {
+      if (codeBlock)
+        codeBlock->clearFunctionProfile();
+    }
+  }
+}
+
+void FunctionProfiler::serialize(
+    Runtime *runtime,
+    std::chrono::microseconds interval,
+    bool attributedTime,
+    llvm::raw_ostream &os) {
+  std::vector<std::pair<RuntimeModule *, CodeBlock *>> functions;
+  for (auto &module : runtime->getRuntimeModules()) {
+    for (CodeBlock *codeBlock : module.getFunctionMap()) {
+      if (codeBlock &&
+          (codeBlock->getInvocationCount() || codeBlock->getProfileSamples() ||
+           codeBlock->getTotalAttributedTime()))
+        functions.emplace_back(&module, codeBlock);
+    }
+  }
+  // Hottest first, which is the order a function layout wants.
+  std::stable_sort(
+      functions.begin(),
+      functions.end(),
+      [attributedTime](
+          const std::pair<RuntimeModule *, CodeBlock *> &a,
+          const std::pair<RuntimeModule *, CodeBlock *> &b) {
+        if (attributedTime &&
+            a.second->getTotalAttributedTime() !=
+                b.second->getTotalAttributedTime())
+          return a.second->getTotalAttributedTime() >
+              b.second->getTotalAttributedTime();
+        if (a.second->getProfileSamples() != b.second->getProfileSamples())
+          return a.second->getProfileSamples() > b.second->getProfileSamples();
+        return a.second->getInvocationCount() > b.second->getInvocationCount();
+      });
+
+  JSONEmitter json(os);
+  json.openDict();
+  json.emitKeyValue("interval", static_cast<double>(interval.count()));
+  json.emitKey("functions");
+  json.openArray();
+  for (const auto &function : functions) {
+    RuntimeModule *module = function.first;
+    CodeBlock *codeBlock = function.second;
+    hbc::BCProvider *bcProvider = module->getBytecode();
+    const uint32_t functionID = codeBlock->getFunctionID();
+
+    std::string url;
+    // Line and column numbers are 1-based, and 0 when they are not known.
+    uint32_t line = 0;
+    uint32_t column = 0;
+    const hbc::DebugOffsets *debugOffsets =
+        bcProvider->getDebugOffsets(functionID);
+    OptValue<hbc::DebugSourceLocation> location;
+    if (debugOffsets &&
+        debugOffsets->sourceLocations != hbc::DebugOffsets::NO_OFFSET) {
+      location = bcProvider->getDebugInfo()->getLocationForAddress(
+          debugOffsets->sourceLocations, 0);
+    }
+    if (location) {
+      url = bcProvider->getDebugInfo()->getFilenameByID(location->filenameId);
+      line = location->line;
+      column = location->column;
+    } else {
+      url = module->getSourceURL().str();
+    }
+
+    json.openDict();
+    json.emitKeyValue(
+        "functionName",
+        bcProvider->getStringRefFromID(
+            bcProvider->getFunctionHeader(functionID).functionName()));
+    json.emitKeyValue("functionId", functionID);
+    json.emitKeyValue("url", url);
+    json.emitKeyValue("line", line);
+    json.emitKeyValue("column", column);
+    json.emitKeyValue("invocations", codeBlock->getInvocationCount());
+    json.emitKeyValue("samples", codeBlock->getProfileSamples());
+    if (attributedTime) {
+      // Self time in microseconds, by what it was spent on.
+      using Category = FunctionTimeAttribution::Category;
+      auto emitTime = [&json, codeBlock](const char *key, Category category) {
+        json.emitKeyValue(
+            key, codeBlock->getAttributedTime(category) / 1000.0);
+      };
+      emitTime("interpreterTime", Category::Interpreter);
+      emitTime("jitTime", Category::JIT);
+      emitTime("nativeTime", Category::Native);
+      emitTime("gcTime", Category::GC);
+    }
+    json.closeDict();
+  }
+  json.closeArray();
+  json.closeDict();
+}
+
+} // namespace vm
+} // namespace hermes
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/VM/Profiler/SamplingHeapProfiler.h"
+
+#include "hermes/BCGen/HBC/BytecodeDataProvider.h"
+#include "hermes/Support/OSCompat.h"
+#include "hermes/VM/Callable.h"
+#include "hermes/VM/CodeBlock.h"
+#include "hermes/VM/RuntimeModule-inline.h"
+#include "hermes/VM/StackFrame-inline.h"
+
+#include <algorithm>
+
+namespace hermes {
+namespace vm {
+
+SamplingHeapProfiler::SamplingHeapProfiler(
+    Runtime *runtime,
+    size_t samplingInterval)
+    : runtime_(runtime), samplingInterval_(samplingInterval) {
+  assert(samplingInterval > 0 && "Sampling interval must be positive");
+}
+
+SamplingHeapProfiler::~SamplingHeapProfiler() = default;
+
+void SamplingHeapProfiler::sample(uint32_t size) {
+  assert(!runtime_->getHeap().inGC() && "Cannot walk the stack in a GC");
+  stack_.clear();
+  for (ConstStackFramePtr frame : runtime_->getStackFrames()) {
+    if (auto *codeBlock = frame.getCalleeCodeBlock()) {
+      RuntimeModule *module = codeBlock->getRuntimeModule();
+      stack_.push_back({module, codeBlock->getFunctionID()});
+      registerDomain(module->getDomainUnsafe());
+    } else if (
+        auto *nativeFunction =
+            dyn_vmcast_or_null<NativeFunction>(frame.getCalleeClosure())) {
+      stack_.push_back(
+          {nullptr,
+           reinterpret_cast<uintptr_t>(nativeFunction->getFunctionPtr())});
+    }
+    // TODO: handle BoundFunction, as the SamplingProfiler does not either.
+  }
+
+  Node *node = &root_;
+  for (auto it = stack_.rbegin(), e = stack_.rend(); it != e; ++it) {
+    node = findOrAddChild(node, *it);
+  }
+  // An allocation smaller than the interval stands for the interval's worth
+  // of allocations that led to it being sampled.  Larger ones are always
+  // sampled, and only stand for themselves.
+  node->selfSize += std::max<uint64_t>(size, samplingInterval_);
+  samples_.push_back({size, node->id});
+}
+
+SamplingHeapProfiler::Node *SamplingHeapProfiler::findOrAddChild(
+    Node *parent,
+    const Frame &frame) {
+  auto it = std::find_if(
+      parent->children.begin(),
+      parent->children.end(),
+      [&frame](const std::unique_ptr<Node> &child) {
+        return child->frame == frame;
+      });
+  if (it != parent->children.end()) {
+    return it->get();
+  }
+  parent->children.emplace_back(new Node(nextNodeId_++, frame));
+  return parent->children.back().get();
+}
+
+void SamplingHeapProfiler::registerDomain(Domain *domain) {
+  if (std::find(domains_.begin(), domains_.end(), domain) == domains_.end()) {
+    domains_.push_back(domain);
+  }
+}
+
+void SamplingHeapProfiler::serialize(llvm::raw_ostream &os) const {
+  JSONEmitter json(os);
+  ScriptIDs ids;
+  json.openDict();
+  json.emitKey("head");
+  serializeNode(json, root_, ids);
+  json.emitKey("samples");
+  json.openArray();
+  for (size_t i = 0, e = samples_.size(); i < e; ++i) {
+    json.openDict();
+    json.emitKeyValue("size", samples_[i].size);
+    json.emitKeyValue("nodeId", samples_[i].nodeId);
+    // Samples are in allocation order.
+    json.emitKeyValue("ordinal", static_cast<double>(i + 1));
+    json.closeDict();
+  }
+  json.closeArray();
+  json.closeDict();
+}
+
+void SamplingHeapProfiler::serializeNode(
+    JSONEmitter &json,
+    const Node &node,
+    ScriptIDs &ids) const {
+  std::string functionName;
+  std::string url;
+  unsigned scriptId = 0;
+  // Line and column numbers are 0-based, and -1 when they are not known.
+  int lineNumber = -1;
+  int columnNumber = -1;
+
+  const Frame &frame = node.frame;
+  if (&node == &root_) {
+    functionName = "(root)";
+  } else if (!frame.module) {
+    functionName = "[Native]" + oscompat::to_string(frame.function);
+  } else {
+    hbc::BCProvider *bcProvider = frame.module->getBytecode();
+    const auto functionID = static_cast<uint32_t>(frame.function);
+    functionName = bcProvider
+                       ->getStringRefFromID(
+                           bcProvider->getFunctionHeader(functionID)
+                               .functionName())
+                       .str();
+    if (functionName.empty()) {
+      functionName = "(anonymous)";
+    }
+    scriptId = ids.insert({frame.module, ids.size() + 1}).first->second;
+
+    // Functions are located by their start, as in the profiles of V8.
+    const hbc::DebugOffsets *debugOffsets =
+        bcProvider->getDebugOffsets(functionID);
+    OptValue<hbc::DebugSourceLocation> location;
+    if (debugOffsets &&
+        debugOffsets->sourceLocations != hbc::DebugOffsets::NO_OFFSET) {
+      location = bcProvider->getDebugInfo()->getLocationForAddress(
+          debugOffsets->sourceLocations, 0);
+    }
+    if (location) {
+      url = bcProvider->getDebugInfo()->getFilenameByID(location->filenameId);
+      lineNumber = static_cast<int>(location->line) - 1;
+      columnNumber = static_cast<int>(location->column) - 1;
+    } else {
+      url = frame.module->getSourceURL().str();
+    }
+  }
+
+  json.openDict();
+  json.emitKey("callFrame");
+  json.openDict();
+  json.emitKeyValue("functionName", functionName);
+  json.emitKeyValue("scriptId", oscompat::to_string(scriptId));
+  json.emitKeyValue("url", url);
+  json.emitKeyValue("lineNumber", lineNumber);
+  json.emitKeyValue("columnNumber", columnNumber);
+  json.closeDict();
+  json.emitKeyValue("selfSize", static_cast<double>(node.selfSize));
+  json.emitKeyValue("id", node.id);
+  json.emitKey("children");
+  json.openArray();
+  for (const auto &child : node.children) {
+    serializeNode(json, *child, ids);
+  }
+  json.closeArray();
+  json.closeDict();
+}
+
+} // namespace vm
+} // namespace hermes
@@ -8,6 +8,7 @@
 
 #include "hermes/VM/Profiler/SamplingProfiler.h"
 
+#include "hermes/Support/JSONEmitter.h"
 #include "hermes/Support/ThreadLocal.h"
 #include "hermes/VM/Callable.h"
 #include "hermes/VM/Profiler/ChromeTraceSerializerPosix.h"
@@ -38,8 +39,17 @@ void SamplingProfiler::registerRuntime(Runtime *runtime) {
 
   // TODO: should we only register runtime when profiler is enabled?
   activeRuntimeThreads_[runtime] = pthread_self();
+  runtimeThreadIds_[runtime] = oscompat::thread_id();
   threadLocalRuntime_.set(runtime);
   threadNames_[oscompat::thread_id()] = oscompat::thread_name();
+  if (enabled_ && capturePerfCounters_)
+    openPerfCounters(runtime);
+}
+
+void SamplingProfiler::openPerfCounters(Runtime *runtime) {
+  auto counters = llvm::make_unique<instrumentation::ThreadPerfCounters>();
+  if (counters->open(runtimeThreadIds_[runtime]))
+    perfCounters_[runtime] = std::move(counters);
 }
 
 void SamplingProfiler::unregisterRuntime(Runtime *runtime) {
@@ -49,6 +59,8 @@ void SamplingProfiler::unregisterRuntime(Runtime *runtime) {
   // register/register -> unregister/unregister call?
   assert(succeed && "How can runtime not registered yet?");
   (void)succeed;
+  runtimeThreadIds_.erase(runtime);
+  perfCounters_.erase(runtime);
 
   threadLocalRuntime_.set(nullptr);
 }
@@ -141,6 +153,10 @@ void SamplingProfiler::profilingSignalHandler(int signo) {
         "Why is sProfilerInstance_ not initialized yet?");
     profilerInstance->sampledStackDepth_ = profilerInstance->walkRuntimeStack(
         curThreadRuntime, profilerInstance->sampleStorage_);
+    profilerInstance->sampledHasCounters_ =
+        profilerInstance->samplePerfCounters_ &&
+        profilerInstance->samplePerfCounters_->read(
+            profilerInstance->sampledCounters_);
   } else {
     // TODO: log "GC in process" meta event.
     profilerInstance->sampledStackDepth_ = 0;
@@ -159,6 +175,9 @@ bool SamplingProfiler::sampleStack() {
 
   for (const auto &entry : activeRuntimeThreads_) {
     auto targetThreadId = entry.second;
+    auto counters = perfCounters_.find(entry.first);
+    samplePerfCounters_ =
+        counters != perfCounters_.end() ? counters->second.get() : nullptr;
     // Signal target runtime thread to sample stack.
     pthread_kill(targetThreadId, SIGPROF);
 
@@ -173,11 +192,10 @@ bool SamplingProfiler::sampleStack() {
       assert(
           sampledStackDepth_ <= sampleStorage_.stack.size() &&
           "How can we sample more frames than storage?");
-      sampledStacks_.emplace_back(
-          sampleStorage_.tid,
-          sampleStorage_.timeStamp,
-          sampleStorage_.stack.begin(),
-          sampleStorage_.stack.begin() + sampledStackDepth_);
+      recordSample(
+          sampleStorage_,
+          sampledStackDepth_,
+          sampledHasCounters_ ? &sampledCounters_ : nullptr);
     }
 
     // Only sample the first thread for now.
@@ -187,11 +205,88 @@ bool SamplingProfiler::sampleStack() {
   return true;
 }
 
+void SamplingProfiler::recordSample(
+    const StackTrace &sample,
+    uint32_t depth,
+    const instrumentation::ThreadPerfCounters::Values *counters) {
+  assert(
+      samples_.size() == kMaxSamples &&
+      sampledFrames_.size() == kMaxSampledFrames &&
+      "Ring buffers should be allocated by enable()");
+  assert(depth <= kMaxStackDepth && "Sample deeper than sampleStorage_?");
+  // Drop the oldest samples to make room.
+  while (numSamples_ == kMaxSamples ||
+         numFrames_ + depth > kMaxSampledFrames) {
+    const SampleRecord &oldest = samples_[firstSample_];
+    firstSample_ = (firstSample_ + 1) % kMaxSamples;
+    --numSamples_;
+    firstFrame_ = (firstFrame_ + oldest.depth) % kMaxSampledFrames;
+    numFrames_ -= oldest.depth;
+  }
+
+  uint32_t firstFrame = (firstFrame_ + numFrames_) % kMaxSampledFrames;
+  for (uint32_t i = 0; i < depth; ++i) {
+    sampledFrames_[(firstFrame + i) % kMaxSampledFrames] = sample.stack[i];
+  }
+  numFrames_ += depth;
+  uint32_t index = (firstSample_ + numSamples_) % kMaxSamples;
+  samples_[index] = SampleRecord{
+      sample.tid, sample.timeStamp, firstFrame, depth, counters != nullptr};
+  if (counters) {
+    assert(
+        sampleCounters_.size() == kMaxSamples &&
+        "Counters captured without storage");
+    sampleCounters_[index] = *counters;
+  }
+  ++numSamples_;
+}
+
+std::vector<SamplingProfiler::StackTrace> SamplingProfiler::getSampledStacks()
+    const {
+  std::vector<StackTrace> stacks;
+  stacks.reserve(numSamples_);
+  for (uint32_t i = 0; i < numSamples_; ++i) {
+    const SampleRecord &record = samples_[(firstSample_ + i) % kMaxSamples];
+    stacks.emplace_back(record.depth);
+    StackTrace &trace = stacks.back();
+    trace.tid = record.tid;
+    trace.timeStamp = record.timeStamp;
+    for (uint32_t j = 0; j < record.depth; ++j) {
+      trace.stack[j] =
+          sampledFrames_[(record.firstFrame + j) % kMaxSampledFrames];
+    }
+  }
+  return stacks;
+}
+
+void SamplingProfiler::maybeStreamChunk() {
+  std::function<void(std::string)> callback;
+  std::string chunk;
+  {
+    std::lock_guard<std::mutex> lockGuard(profilerLock_);
+    if (!chunkCallback_) {
+      return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (now < nextChunkTime_) {
+      return;
+    }
+    nextChunkTime_ = now + chunkInterval_;
+    llvm::raw_string_ostream OS(chunk);
+    writeChromeTraceChunk(OS);
+    OS.flush();
+    callback = chunkCallback_;
+  }
+  // Call it without the lock, so that it can use the profiler.
+  callback(std::move(chunk));
+}
+
 void SamplingProfiler::timerLoop() {
   while (true) {
     if (!sampleStack()) {
       return;
     }
+    maybeStreamChunk();
 
     // TODO: make sampling rate configurable.
     // TODO: add random fluctuation to interval value.
@@ -325,14 +420,17 @@ SamplingProfiler::SamplingProfiler() : sampleStorage_(kMaxStackDepth) {
   sProfilerInstance_.store(this);
 }
 
+SamplingProfiler::~SamplingProfiler() = default;
+
 void SamplingProfiler::dumpSampledStack(llvm::raw_ostream &OS) {
   // TODO: serialize to visualizable trace format.
   std::lock_guard<std::mutex> lockGuard(profilerLock_);
 
+  std::vector<StackTrace> sampledStacks = getSampledStacks();
   OS << "dumpSamples called from runtime\n";
-  OS << "Total " << sampledStacks_.size() << " samples\n";
-  for (unsigned i = 0; i < sampledStacks_.size(); ++i) {
-    auto &sample = sampledStacks_[i];
+  OS << "Total " << sampledStacks.size() << " samples\n";
+  for (unsigned i = 0; i < sampledStacks.size(); ++i) {
+    auto &sample = sampledStacks[i];
     uint64_t timeStamp = sample.timeStamp.time_since_epoch().count();
     OS << "[" << i << "]: tid[" << sample.tid << "], ts[" << timeStamp << "] ";
 
@@ -358,12 +456,132 @@ void SamplingProfiler::dumpChromeTrace(llvm::raw_ostream &OS) {
   std::lock_guard<std::mutex> lockGuard(profilerLock_);
   auto pid = getpid();
   ChromeTraceSerializer serializer(
-      ChromeTraceFormat::create(pid, threadNames_, sampledStacks_));
+      ChromeTraceFormat::create(pid, threadNames_, getSampledStacks()));
   serializer.serialize(OS);
   clear();
 }
 
-bool SamplingProfiler::enable() {
+void SamplingProfiler::dumpPerfCounters(llvm::raw_ostream &OS) {
+  using Values = instrumentation::ThreadPerfCounters::Values;
+  constexpr unsigned kNumCounters =
+      instrumentation::ThreadPerfCounters::kNumCounters;
+  std::lock_guard<std::mutex> lockGuard(profilerLock_);
+
+  /// The counts charged to a function.
+  struct FunctionCounts {
+    StackFrame frame;
+    uint32_t samples{0};
+    Values counts{};
+  };
+  std::vector<FunctionCounts> functions;
+  /// Index in functions of each JS function, by module and function id, and
+  /// of each native function.
+  llvm::DenseMap<std::pair<RuntimeModule *, uint32_t>, size_t> jsIndex;
+  llvm::DenseMap<NativeFunctionFrameInfo, size_t> nativeIndex;
+  /// The counters at the previous sample of each thread.
+  llvm::DenseMap<ThreadId, Values> previous;
+
+  for (uint32_t i = 0; i < numSamples_; ++i) {
+    uint32_t index = (firstSample_ + i) % kMaxSamples;
+    const SampleRecord &record = samples_[index];
+    if (!record.hasCounters)
+      continue;
+    const Values &counters = sampleCounters_[index];
+    auto prevIt = previous.find(record.tid);
+    if (prevIt == previous.end()) {
+      // The first sample of a thread is the baseline.
+      previous[record.tid] = counters;
+      continue;
+    }
+    const StackFrame &leaf = sampledFrames_[record.firstFrame];
+    size_t &slot = leaf.kind == StackFrame::FrameKind::JSFunction
+        ? jsIndex
+              .insert(
+                  {{leaf.jsFrame.module, leaf.jsFrame.functionId},
+                   functions.size()})
+              .first->second
+        : nativeIndex.insert({leaf.nativeFrame, functions.size()})
+              .first->second;
+    if (slot == functions.size()) {
+      functions.emplace_back();
+      functions.back().frame = leaf;
+    }
+    FunctionCounts &function = functions[slot];
+    ++function.samples;
+    for (unsigned c = 0; c < kNumCounters; ++c)
+      function.counts[c] += counters[c] - prevIt->second[c];
+    prevIt->second = counters;
+  }
+  std::stable_sort(
+      functions.begin(),
+      functions.end(),
+      [](const FunctionCounts &a, const FunctionCounts &b) {
+        return a.counts[0] > b.counts[0];
+      });
+
+  JSONEmitter json(OS);
+  json.openDict();
+  json.emitKey("functions");
+  json.openArray();
+  for (const FunctionCounts &function : functions) {
+    json.openDict();
+    if (function.frame.kind == StackFrame::FrameKind::JSFunction) {
+      RuntimeModule *module = function.frame.jsFrame.module;
+      hbc::BCProvider *bcProvider = module->getBytecode();
+      uint32_t functionId = function.frame.jsFrame.functionId;
+      json.emitKeyValue(
+          "functionName",
+          bcProvider->getStringRefFromID(
+              bcProvider->getFunctionHeader(functionId).functionName()));
+      json.emitKeyValue("functionId", functionId);
+      json.emitKeyValue("url", module->getSourceURL());
+    } else {
+      json.emitKeyValue(
+          "functionName",
+          "[Native]" + oscompat::to_string(function.frame.nativeFrame));
+    }
+    json.emitKeyValue("samples", function.samples);
+    for (unsigned c = 0; c < kNumCounters; ++c) {
+      json.emitKeyValue(
+          instrumentation::ThreadPerfCounters::kNames[c],
+          static_cast<double>(function.counts[c]));
+    }
+    json.closeDict();
+  }
+  json.closeArray();
+  json.closeDict();
+}
+
+void SamplingProfiler::dumpChromeTraceChunk(llvm::raw_ostream &OS) {
+  std::lock_guard<std::mutex> lockGuard(profilerLock_);
+  writeChromeTraceChunk(OS);
+}
+
+void SamplingProfiler::writeChromeTraceChunk(llvm::raw_ostream &OS) {
+  if (!chunkedTrace_) {
+    chunkedTrace_.reset(new ChromeTraceFormat(
+        ChromeTraceFormat::create(getpid(), threadNames_, {})));
+  }
+  chunkedTrace_->setThreadNames(threadNames_);
+  chunkedTrace_->addSamples(getSampledStacks());
+  auto chunk = chunkedTrace_->takeChunk();
+  ChromeTraceSerializer serializer(std::move(chunk.first), chunk.second);
+  serializer.serialize(OS);
+  // The frames of the call trees are not symbolicated again, so the samples
+  // and the domains they keep alive can go.
+  clearSamples();
+}
+
+void SamplingProfiler::setChromeTraceChunkCallback(
+    std::function<void(std::string)> callback,
+    std::chrono::milliseconds interval) {
+  std::lock_guard<std::mutex> lockGuard(profilerLock_);
+  chunkCallback_ = std::move(callback);
+  chunkInterval_ = interval;
+  nextChunkTime_ = std::chrono::steady_clock::now() + interval;
+}
+
+bool SamplingProfiler::enable(bool capturePerfCounters) {
   std::lock_guard<std::mutex> lockGuard(profilerLock_);
   if (enabled_) {
     return true;
@@ -374,6 +592,18 @@ bool SamplingProfiler::enable() {
   if (!registerSignalHandlers()) {
     return false;
   }
+  // Allocate the ring buffers here rather than while sampling.
+  samples_.resize(kMaxSamples);
+  sampledFrames_.resize(kMaxSampledFrames);
+  capturePerfCounters_ = capturePerfCounters;
+  if (capturePerfCounters) {
+    sampleCounters_.resize(kMaxSamples);
+    for (const auto &entry : activeRuntimeThreads_)
+      openPerfCounters(entry.first);
+  }
+  // Start a new session of chunks.
+  chunkedTrace_.reset();
+  nextChunkTime_ = std::chrono::steady_clock::now() + chunkInterval_;
   enabled_ = true;
   // Start timer thread.
   std::thread(&SamplingProfiler::timerLoop, this).detach();
@@ -395,18 +625,26 @@ bool SamplingProfiler::disable() {
   }
   // Telling timer thread to exit.
   enabled_ = false;
+  // The timer thread checks enabled_ under the lock before it samples, so the
+  // counters are no longer in use.
+  perfCounters_.clear();
   return true;
 }
 
 void SamplingProfiler::clear() {
-  sampledStacks_.clear();
+  clearSamples();
+  // TODO: keep thread names that are still in use.
+  threadNames_.clear();
+}
+
+void SamplingProfiler::clearSamples() {
+  firstSample_ = numSamples_ = 0;
+  firstFrame_ = numFrames_ = 0;
   // Release all strong roots to domains.
   // Note: we can't clear domains_ because we have to maintain the storage size.
   for (Domain *&domain : domains_) {
     domain = nullptr;
   }
-  // TODO: keep thread names that are still in use.
-  threadNames_.clear();
 }
 
 bool operator==(
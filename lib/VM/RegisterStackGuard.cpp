@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/VM/RegisterStackGuard.h"
+
+#include "hermes/Support/OSCompat.h"
+#include "hermes/VM/HermesValue.h"
+#include "hermes/VM/Runtime.h"
+
+#include "llvm/Support/MathExtras.h"
+
+#ifndef _WINDOWS
+#include <signal.h>
+#endif
+
+#include <mutex>
+
+namespace hermes {
+namespace vm {
+
+constexpr uint32_t RegisterStackGuard::kMaxUncheckedRegisters;
+
+#ifndef _WINDOWS
+namespace {
+
+/// The size of the guard region, before it is rounded up to whole pages.
+constexpr size_t kGuardBytes = 64 * 1024;
+static_assert(
+    (RegisterStackGuard::kMaxUncheckedRegisters + STACK_RESERVE) *
+            sizeof(PinnedHermesValue) <=
+        kGuardBytes / 2,
+    "An unchecked frame must fit in the guard region");
+
+/// A guard region known to the fault handler.
+struct GuardRegion {
+  uintptr_t begin;
+  uintptr_t end;
+  std::atomic<bool> *hit;
+  /// Whether the region is inaccessible.
+  bool armed;
+};
+
+/// The registered guard regions. The fault handler can't allocate or take a
+/// mutex, so they are kept in a fixed array protected by a spin lock, which is
+/// never held while touching a guard region.
+constexpr unsigned kMaxGuards = 64;
+GuardRegion guardRegions[kMaxGuards];
+unsigned numGuardRegions = 0;
+std::atomic_flag guardRegionsLock = ATOMIC_FLAG_INIT;
+
+class GuardRegionsLock {
+ public:
+  GuardRegionsLock() {
+    while (guardRegionsLock.test_and_set(std::memory_order_acquire)) {
+    }
+  }
+  ~GuardRegionsLock() {
+    guardRegionsLock.clear(std::memory_order_release);
+  }
+};
+
+struct sigaction previousSegvAction;
+struct sigaction previousBusAction;
+
+/// Pass the fault \p sig, which isn't in a guard region, to the handler that
+/// was installed before.
+void forwardFault(int sig, siginfo_t *info, void *context) {
+  struct sigaction &previous =
+      sig == SIGBUS ? previousBusAction : previousSegvAction;
+  if (previous.sa_flags & SA_SIGINFO) {
+    previous.sa_sigaction(sig, info, context);
+    return;
+  }
+  if (previous.sa_handler == SIG_DFL || previous.sa_handler == SIG_IGN) {
+    // Restore the default action, which kills the process when the faulting
+    // instruction runs again.
+    signal(sig, SIG_DFL);
+    return;
+  }
+  previous.sa_handler(sig);
+}
+
+void handleFault(int sig, siginfo_t *info, void *context) {
+  const auto addr = reinterpret_cast<uintptr_t>(info->si_addr);
+  {
+    GuardRegionsLock lock;
+    for (unsigned i = 0; i < numGuardRegions; ++i) {
+      GuardRegion &region = guardRegions[i];
+      if (region.armed && addr >= region.begin && addr < region.end) {
+        // Let the write complete, and have the interpreter check the stack
+        // until the region is rearmed.
+        oscompat::vm_protect(
+            reinterpret_cast<void *>(region.begin),
+            region.end - region.begin,
+            oscompat::ProtectMode::ReadWrite);
+        region.armed = false;
+        region.hit->store(true, std::memory_order_relaxed);
+        return;
+      }
+    }
+  }
+  forwardFault(sig, info, context);
+}
+
+void installFaultHandler() {
+  struct sigaction action {};
+  action.sa_sigaction = handleFault;
+  action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+  sigemptyset(&action.sa_mask);
+  sigaction(SIGSEGV, &action, &previousSegvAction);
+  sigaction(SIGBUS, &action, &previousBusAction);
+}
+
+} // namespace
+
+std::unique_ptr<RegisterStackGuard> RegisterStackGuard::create(
+    uint32_t numRegisters,
+    std::atomic<bool> &hit) {
+  static std::once_flag installed;
+  std::call_once(installed, installFaultHandler);
+
+  const size_t pageSize = oscompat::page_size();
+  const size_t guardSize = llvm::alignTo(kGuardBytes, pageSize);
+  const size_t stackSize =
+      llvm::alignTo(sizeof(PinnedHermesValue) * numRegisters, pageSize);
+  auto result = oscompat::vm_allocate(guardSize + stackSize);
+  if (!result)
+    return nullptr;
+  std::unique_ptr<RegisterStackGuard> guard{new RegisterStackGuard(
+      static_cast<char *>(*result), guardSize, stackSize, hit)};
+  if (!oscompat::vm_protect(
+          guard->base_, guardSize, oscompat::ProtectMode::None))
+    return nullptr;
+
+  GuardRegionsLock lock;
+  if (numGuardRegions == kMaxGuards)
+    return nullptr;
+  guardRegions[numGuardRegions++] = GuardRegion{
+      reinterpret_cast<uintptr_t>(guard->base_),
+      reinterpret_cast<uintptr_t>(guard->base_ + guardSize),
+      &hit,
+      true};
+  guard->registered_ = true;
+  return guard;
+}
+
+RegisterStackGuard::~RegisterStackGuard() {
+  if (registered_) {
+    GuardRegionsLock lock;
+    for (unsigned i = 0; i < numGuardRegions; ++i) {
+      if (guardRegions[i].hit == &hit_) {
+        guardRegions[i] = guardRegions[--numGuardRegions];
+        break;
+      }
+    }
+  }
+  oscompat::vm_free(base_, guardSize_ + stackSize_);
+}
+
+void RegisterStackGuard::rearm() {
+  bool armed = false;
+  {
+    GuardRegionsLock lock;
+    for (unsigned i = 0; i < numGuardRegions; ++i) {
+      GuardRegion &region = guardRegions[i];
+      if (region.hit == &hit_) {
+        armed = region.armed = oscompat::vm_protect(
+            base_, guardSize_, oscompat::ProtectMode::None);
+        break;
+      }
+    }
+  }
+  // If the region couldn't be protected, it stays accessible and the flag
+  // keeps the interpreter checking the stack.
+  if (armed)
+    hit_.store(false, std::memory_order_relaxed);
+}
+
+#else // _WINDOWS
+
+std::unique_ptr<RegisterStackGuard> RegisterStackGuard::create(
+    uint32_t,
+    std::atomic<bool> &) {
+  return nullptr;
+}
+
+RegisterStackGuard::~RegisterStackGuard() = default;
+
+void RegisterStackGuard::rearm() {}
+
+#endif // _WINDOWS
+
+} // namespace vm
+} // namespace hermes
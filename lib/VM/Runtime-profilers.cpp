@@ -66,6 +66,38 @@ void Runtime::dumpOpcodeStats(llvm::raw_ostream &os) const {
            << inst::getOpCodeString(static_cast<inst::OpCode>(op)).data()
            << std::setw(22) << t[op] << std::setw(11) << f[op] << "\n";
   }
+
+  // Get all non-zero occurence pairs of opcodes, as (first, second).
+  std::vector<std::pair<size_t, size_t>> pairs;
+  for (size_t i = 0; i < static_cast<uint32_t>(inst::OpCode::_last); ++i) {
+    for (size_t j = 0; j < static_cast<uint32_t>(inst::OpCode::_last); ++j) {
+      if (opcodePairFrequency[i][j])
+        pairs.emplace_back(i, j);
+    }
+  }
+
+  // sort pairs based on frequency.
+  const auto &pf = opcodePairFrequency;
+  sort(
+      pairs.begin(),
+      pairs.end(),
+      [&pf](std::pair<size_t, size_t> p1, std::pair<size_t, size_t> p2) {
+        return pf[p1.first][p1.second] > pf[p2.first][p2.second];
+      });
+
+  stream << "\nOpcode pairs sorted by frequency:\n"
+         << std::left << std::setfill(' ') << std::setw(25) << "==First=="
+         << std::setw(25) << "==Second==" << std::setw(11) << "==Frequency=="
+         << "\n";
+  for (const auto &pair : pairs) {
+    stream << std::left << std::setfill(' ') << std::setw(25)
+           << inst::getOpCodeString(static_cast<inst::OpCode>(pair.first))
+                  .data()
+           << std::setw(25)
+           << inst::getOpCodeString(static_cast<inst::OpCode>(pair.second))
+                  .data()
+           << std::setw(11) << pf[pair.first][pair.second] << "\n";
+  }
   os << stream.str();
 }
 #endif
@@ -33,8 +33,12 @@
 #include "hermes/VM/JSLib/RuntimeCommonStorage.h"
 #include "hermes/VM/Operations.h"
 #include "hermes/VM/PointerBase.h"
+#include "hermes/VM/Profiler/CodeCoverage.h"
+#include "hermes/VM/Profiler/FunctionProfiler.h"
+#include "hermes/VM/Profiler/SamplingHeapProfiler.h"
 #include "hermes/VM/Profiler/SamplingProfiler.h"
 #include "hermes/VM/RuntimeModule-inline.h"
+#include "hermes/VM/RuntimeResetPoint.h"
 #include "hermes/VM/StackFrame-inline.h"
 #include "hermes/VM/StringView.h"
 
@@ -42,6 +46,7 @@
 #include "hermes/Support/MemoryBuffer.h"
 #endif
 
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/Hashing.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
@@ -70,6 +75,7 @@ static const Predefined::Str fixedPropCacheNames[(size_t)PropCacheID::_COUNT] =
 
 /* static */
 std::shared_ptr<Runtime> Runtime::create(const RuntimeConfig &runtimeConfig) {
+  instrumentation::StartupTimer creationTimer{nullptr};
   const GCConfig &gcConfig = runtimeConfig.getGCConfig();
   GC::Size sz{gcConfig.getMinHeapSize(), gcConfig.getMaxHeapSize()};
 #ifdef HERMESVM_COMPRESSED_POINTERS
@@ -79,7 +85,10 @@ std::shared_ptr<Runtime> Runtime::create(const RuntimeConfig &runtimeConfig) {
   // TODO(T31421960): This can become a unique_ptr with C++14 lambda
   // initializers.
   auto storageResult = StorageProvider::preAllocatedProvider(
-      sz.storageFootprint(), sz.minStorageFootprint(), sizeof(Runtime));
+      sz.storageFootprint(),
+      sz.minStorageFootprint(),
+      sizeof(Runtime),
+      gcConfig.getHugePages());
   if (!storageResult) {
     hermes_fatal((llvm::Twine("Could not allocate backing storage for heap: ") +
                   convert_error_to_message(storageResult.getError()) +
@@ -100,6 +109,7 @@ std::shared_ptr<Runtime> Runtime::create(const RuntimeConfig &runtimeConfig) {
   }
   void *storage = *result;
   Runtime *rt = new (storage) Runtime(provider.get(), runtimeConfig);
+  creationTimer.stop(rt->runtimeStats_.startup.runtimeCreation);
   // Return a shared pointer with a custom deleter to delete the underlying
   // storage of the runtime.
   return std::shared_ptr<Runtime>{rt, [provider](Runtime *runtime) {
@@ -109,9 +119,22 @@ std::shared_ptr<Runtime> Runtime::create(const RuntimeConfig &runtimeConfig) {
 #else
   // TODO(T31421960): This can become a unique_ptr with C++14 lambda
   // initializers.
-  std::shared_ptr<StorageProvider> provider{StorageProvider::mmapProvider()};
+  std::shared_ptr<StorageProvider> provider;
+  if (gcConfig.getHugePages()) {
+    // Segments are taken from one reserved region rather than mapped one at
+    // a time. If it can't be reserved, fall back to separate mappings.
+    auto storageResult = StorageProvider::preAllocatedProvider(
+        sz.storageFootprint(), sz.minStorageFootprint(), 0, true);
+    if (storageResult) {
+      provider = std::move(storageResult.get());
+    }
+  }
+  if (!provider) {
+    provider = StorageProvider::mmapProvider();
+  }
   // When not using the flat address space, allocate runtime normally.
   Runtime *rt = new Runtime(provider.get(), runtimeConfig);
+  creationTimer.stop(rt->runtimeStats_.startup.runtimeCreation);
   // Return a shared pointer with a custom deleter to delete the underlying
   // storage of the runtime.
   return std::shared_ptr<Runtime>{rt, [provider](Runtime *runtime) {
@@ -141,7 +164,7 @@ CallResult<HermesValue> Runtime::getNamed(
           JSObject::tryGetOwnNamedDescriptorFast(*obj, this, sym, desc)) &&
       !desc.flags.accessor && desc.flags.writable &&
       !desc.flags.internalSetter) {
-    if (LLVM_LIKELY(!clazz->isDictionary())) {
+    if (LLVM_LIKELY(clazz->isCacheable())) {
       // Cache the class, id and property slot.
       cacheEntry->clazz = clazz;
       cacheEntry->slot = desc.slot;
@@ -168,7 +191,7 @@ ExecutionStatus Runtime::putNamedThrowOnError(
           JSObject::tryGetOwnNamedDescriptorFast(*obj, this, sym, desc)) &&
       !desc.flags.accessor && desc.flags.writable &&
       !desc.flags.internalSetter) {
-    if (LLVM_LIKELY(!clazz->isDictionary())) {
+    if (LLVM_LIKELY(clazz->isCacheable())) {
       // Cache the class and property slot.
       cacheEntry->clazz = clazz;
       cacheEntry->slot = desc.slot;
@@ -192,16 +215,23 @@ Runtime::Runtime(StorageProvider *provider, const RuntimeConfig &runtimeConfig)
           runtimeConfig.getGCConfig(),
           runtimeConfig.getCrashMgr(),
           provider),
-      jitContext_(runtimeConfig.getEnableJIT(), (1 << 20) * 8, (1 << 20) * 32),
+      jitContext_(
+          runtimeConfig.getEnableJIT(),
+          std::min<size_t>((1 << 20) * 8, runtimeConfig.getJITMemoryLimit()),
+          runtimeConfig.getJITMemoryLimit()),
       hasES6Symbol_(runtimeConfig.getES6Symbol()),
+      hasES6Promise_(runtimeConfig.getES6Promise()),
       shouldRandomizeMemoryLayout_(runtimeConfig.getRandomizeMemoryLayout()),
       bytecodeWarmupPercent_(runtimeConfig.getBytecodeWarmupPercent()),
+      bytecodeWarmupPages_(runtimeConfig.getBytecodeWarmupPages()),
       trackIO_(runtimeConfig.getTrackIO()),
       vmExperimentFlags_(runtimeConfig.getVMExperimentFlags()),
+      codeBlockIdleGCs_(runtimeConfig.getCodeBlockIdleGCs()),
       runtimeStats_(runtimeConfig.getEnableSampledStats()),
       commonStorage_(createRuntimeCommonStorage()),
       stackPointer_(),
       crashMgr_(runtimeConfig.getCrashMgr()),
+      evalCache_(runtimeConfig.getEvalCacheBytes()),
       crashCallbackKey_(
           crashMgr_->registerCallback([this](int fd) { crashCallback(fd); })) {
   assert(
@@ -211,14 +241,30 @@ Runtime::Runtime(StorageProvider *provider, const RuntimeConfig &runtimeConfig)
   if (LLVM_UNLIKELY(maxNumRegisters > kMaxSupportedNumRegisters)) {
     hermes_fatal("RuntimeConfig maxNumRegisters too big");
   }
+  jitContext_.setInvocationThreshold(runtimeConfig.getJITInvocationThreshold());
+  jitContext_.setLoopThreshold(runtimeConfig.getJITLoopThreshold());
+  jitContext_.setRegExpThreshold(runtimeConfig.getJITRegExpThreshold());
+  jitContext_.setBackgroundCompilation(
+      runtimeConfig.getJITBackgroundCompilation());
+  jitContext_.setPointerBase(this);
+
   registerStack_ = runtimeConfig.getRegisterStack();
   if (!registerStack_) {
-    // registerStack_ should be allocated with malloc instead of new so that the
-    // default constructors don't run for the whole stack space.
+    if (runtimeConfig.getRegisterStackGuard()) {
+      registerStackGuard_ =
+          RegisterStackGuard::create(maxNumRegisters, checkRegisterStack_);
+    }
     const auto numBytesForRegisters =
         sizeof(PinnedHermesValue) * maxNumRegisters;
-    registerStack_ =
-        static_cast<PinnedHermesValue *>(checkedMalloc(numBytesForRegisters));
+    if (registerStackGuard_) {
+      registerStack_ = registerStackGuard_->getRegisterStack();
+      checkRegisterStack_.store(false, std::memory_order_relaxed);
+    } else {
+      // registerStack_ should be allocated with malloc instead of new so that
+      // the default constructors don't run for the whole stack space.
+      registerStack_ = static_cast<PinnedHermesValue *>(
+          checkedMalloc(numBytesForRegisters));
+    }
     crashMgr_->registerMemory(registerStack_, numBytesForRegisters);
   } else {
     freeRegisterStack_ = false;
@@ -241,7 +287,11 @@ Runtime::Runtime(StorageProvider *provider, const RuntimeConfig &runtimeConfig)
 
   // Initialize Predefined Strings.
   // This function does not do any allocations.
-  initPredefinedStrings();
+  {
+    instrumentation::StartupTimer timer{
+        &runtimeStats_.startup.predefinedStrings};
+    initPredefinedStrings();
+  }
 
   // Initialize special code blocks pointing to their own runtime module.
   // specialCodeBlockRuntimeModule_ will be owned by runtimeModuleList_.
@@ -255,6 +305,9 @@ Runtime::Runtime(StorageProvider *provider, const RuntimeConfig &runtimeConfig)
       "specialCodeBlockRuntimeModule_ not added to runtimeModuleList_");
 
   // At this point, allocations can begin, as all the roots are markable.
+  // Everything allocated until the end of initialization lives as long as the
+  // runtime.
+  heap_.runtimeWillInitialize();
 
   // Initialize the pre-allocated character strings.
   initCharacterStrings();
@@ -264,9 +317,7 @@ Runtime::Runtime(StorageProvider *provider, const RuntimeConfig &runtimeConfig)
   // Explicitly initialize the specialCodeBlockRuntimeModule_ without CJS
   // modules.
   specialCodeBlockRuntimeModule_->initializeWithoutCJSModulesMayAllocate(
-      hbc::BCProviderFromBuffer::createBCProviderFromBuffer(
-          generateSpecialRuntimeBytecode())
-          .first);
+      getSpecialRuntimeBytecode());
   emptyCodeBlock_ = specialCodeBlockRuntimeModule_->getCodeBlockMayAllocate(0);
   returnThisCodeBlock_ =
       specialCodeBlockRuntimeModule_->getCodeBlockMayAllocate(1);
@@ -279,11 +330,18 @@ Runtime::Runtime(StorageProvider *provider, const RuntimeConfig &runtimeConfig)
 
   global_ =
       JSObject::create(this, Handle<JSObject>(this, nullptr)).getHermesValue();
+  // Global variables are never reached through a transition chain, so keep
+  // the global object in a dictionary that the property caches can use.
+  JSObject::makeCacheableDictionary(getGlobal(), this);
 
-  initGlobalObject(this);
+  {
+    instrumentation::StartupTimer timer{&runtimeStats_.startup.jslibInit};
+    initGlobalObject(this);
 
-  // Once the global object has been initialized, populate the builtins table.
-  initBuiltinTable();
+    // Once the global object has been initialized, populate the builtins
+    // table.
+    initBuiltinTable();
+  }
 
   stringCycleCheckVisited_ =
       ignoreAllocationFailure(ArrayStorage::create(this, 8));
@@ -293,7 +351,7 @@ Runtime::Runtime(StorageProvider *provider, const RuntimeConfig &runtimeConfig)
   ignoreAllocationFailure(JSObject::setParent(
       vmcast<JSObject>(global_), this, vmcast<JSObject>(objectPrototype)));
 
-  symbolRegistry_.init(this);
+  heap_.runtimeInitialized();
 
   LLVM_DEBUG(llvm::dbgs() << "Runtime initialized\n");
 
@@ -308,7 +366,9 @@ Runtime::~Runtime() {
   crashMgr_->unregisterCallback(crashCallbackKey_);
   if (freeRegisterStack_) {
     crashMgr_->unregisterMemory(registerStack_);
-    ::free(registerStack_);
+    // The guard owns the stack it precedes.
+    if (!registerStackGuard_)
+      ::free(registerStack_);
   }
   // Remove inter-module dependencies so we can delete them in any order.
   for (auto &module : runtimeModuleList_) {
@@ -321,9 +381,17 @@ Runtime::~Runtime() {
   }
 }
 
+/// The names of the root marking phases, indexed by Runtime::MarkRootsPhase.
+#define MARK_ROOTS_PHASE(phase) "MarkRoots_" #phase,
+static const char *const markRootsPhaseNames[] = {
+#include "hermes/VM/MarkRootsPhases.def"
+};
+#undef MARK_ROOTS_PHASE
+
 /// A helper class used to measure the duration of GC marking different roots.
 /// It accumulates the times in \c Runtime::markRootsPhaseTimes[] and \c
-/// Runtime::totalMarkRootsTime.
+/// Runtime::totalMarkRootsTime, and records them in the GCCycleEvent of the
+/// collection, if any.
 class Runtime::MarkRootsPhaseTimer {
  public:
   MarkRootsPhaseTimer(Runtime *rt, Runtime::MarkRootsPhase phase)
@@ -339,6 +407,7 @@ class Runtime::MarkRootsPhaseTimer {
     start_ = tp;
     unsigned index = static_cast<unsigned>(phase_);
     rt_->markRootsPhaseTimes_[index] += elapsed.count();
+    rt_->heap_.recordCyclePhase(markRootsPhaseNames[index], elapsed.count());
     if (index + 1 ==
         static_cast<unsigned>(Runtime::MarkRootsPhase::NumPhases)) {
       std::chrono::duration<double> totalElapsed =
@@ -374,6 +443,12 @@ void Runtime::markRoots(
     acceptor.acceptPtr(rootClazzRawPtr_, "@rootClass");
     acceptor.accept(stringCycleCheckVisited_, "@stringCycleCheckVisited");
     acceptor.accept(global_, "@global");
+    if (resetPoint_)
+      resetPoint_->markRoots(acceptor);
+    for (SymbolID sym : indexSymbols_) {
+      if (sym.isValid())
+        acceptor.accept(sym, "@indexSymbol");
+    }
 #ifdef HERMES_ENABLE_DEBUGGER
     acceptor.accept(debuggerInternalObject_, "@debuggerInternal");
 #endif // HERMES_ENABLE_DEBUGGER
@@ -430,6 +505,12 @@ void Runtime::markRoots(
     MARK(mapIteratorPrototype);
     MARK(weakMapPrototype);
     MARK(weakSetPrototype);
+    MARK(promisePrototype);
+    MARK(promiseConstructor);
+    MARK(textEncoderPrototype);
+    MARK(textDecoderPrototype);
+    for (auto &hv : promiseJobQueue)
+      acceptor.accept(hv, "@promiseJobQueue");
     MARK(regExpPrototype);
     // Constructors.
     MARK(typedArrayBaseConstructor);
@@ -442,6 +523,11 @@ void Runtime::markRoots(
     MARK(iteratorPrototype);
     MARK(arrayIteratorPrototype);
     MARK(arrayPrototypeValues);
+    MARK(functionPrototypeApply);
+    MARK(arrayIteratorPrototypeNext);
+    MARK(stringIteratorPrototypeNext);
+    MARK(mapIteratorPrototypeNext);
+    MARK(setIteratorPrototypeNext);
     MARK(stringIteratorPrototype);
     MARK(generatorFunctionPrototype);
     MARK(generatorPrototype);
@@ -489,6 +575,9 @@ void Runtime::markRoots(
     if (samplingProfiler_) {
       samplingProfiler_->markRoots(acceptor);
     }
+    if (samplingHeapProfiler_) {
+      samplingHeapProfiler_->markRoots(acceptor);
+    }
   }
 
   {
@@ -498,9 +587,17 @@ void Runtime::markRoots(
   }
 }
 
+ExecutionStatus Runtime::drainJobs() {
+  return drainPromiseJobs(this);
+}
+
 void Runtime::markWeakRoots(GCBase *gc, SlotAcceptorWithNames &acceptor) {
   for (auto &rm : runtimeModuleList_)
     rm.markWeakRoots(acceptor);
+  // The megamorphic cache doesn't keep its classes or symbols alive, and they
+  // may be freed or moved by this collection, so drop all of it. This is also
+  // reached from the reference-updating phase of a compacting collection.
+  megamorphicPropCache_.clear();
 }
 
 void Runtime::visitIdentifiers(
@@ -510,11 +607,10 @@ void Runtime::visitIdentifiers(
 
 void Runtime::printRuntimeGCStats(llvm::raw_ostream &os) const {
   const unsigned kNumPhases = static_cast<unsigned>(MarkRootsPhase::NumPhases);
-#define MARK_ROOTS_PHASE(phase) "MarkRoots_" #phase,
-  static const char *markRootsPhaseNames[kNumPhases] = {
-#include "hermes/VM/MarkRootsPhases.def"
-  };
-#undef MARK_ROOTS_PHASE
+  static_assert(
+      sizeof(markRootsPhaseNames) / sizeof(markRootsPhaseNames[0]) ==
+          kNumPhases,
+      "Every root marking phase must have a name");
   os << "\t\"runtime\": {\n";
   os << "\t\t\"totalMarkRootsTime\": " << formatSecs(totalMarkRootsTime_).secs
      << ",\n";
@@ -533,6 +629,8 @@ void Runtime::printRuntimeGCStats(llvm::raw_ostream &os) const {
 
 void Runtime::printHeapStats(llvm::raw_ostream &os) {
   getHeap().printAllCollectedStats(os);
+  if (jitContext_.isEnabled())
+    jitContext_.printStats(os);
   for (auto &module : getRuntimeModules()) {
     auto tracker = module.getBytecode()->getPageAccessTracker();
     if (tracker) {
@@ -542,6 +640,39 @@ void Runtime::printHeapStats(llvm::raw_ostream &os) {
   }
 }
 
+const PropertyCacheStats &Runtime::collectPropertyCacheStats() {
+  PropertyCacheStats total{};
+  for (auto &module : getRuntimeModules()) {
+    for (CodeBlock *codeBlock : module.getFunctionMap()) {
+      // Lazy CodeBlocks may be shared by several modules; only count them in
+      // the module that owns them.
+      if (codeBlock && codeBlock->getRuntimeModule() == &module)
+        total += codeBlock->getPropertyCacheStats();
+    }
+  }
+  runtimeStats_.propertyCache = total;
+  return runtimeStats_.propertyCache;
+}
+
+void Runtime::dumpPropertyCacheStats(llvm::raw_ostream &os) {
+  os << "Property cache stats (hits / misses / megamorphic misses):\n";
+  std::string name;
+  for (auto &module : getRuntimeModules()) {
+    for (CodeBlock *codeBlock : module.getFunctionMap()) {
+      if (!codeBlock || codeBlock->getRuntimeModule() != &module)
+        continue;
+      const auto &stats = codeBlock->getPropertyCacheStats();
+      if (!stats.hits && !stats.misses && !stats.megamorphicMisses)
+        continue;
+      if (!codeBlock->getNameString(this, name))
+        name = "<non-ascii>";
+      os << "  " << (name.empty() ? "<anonymous>" : name) << " #"
+         << codeBlock->getFunctionID() << ": " << stats.hits << " / "
+         << stats.misses << " / " << stats.megamorphicMisses << "\n";
+    }
+  }
+}
+
 unsigned Runtime::getSymbolsEnd() const {
   return identifierTable_.getSymbolsEnd();
 }
@@ -573,6 +704,140 @@ void Runtime::potentiallyMoveHeap() {
 }
 #endif
 
+void Runtime::handleMemoryPressure(MemoryPressure pressure) {
+  bool critical = pressure == MemoryPressure::Critical;
+  evalCache_.clear();
+  for (auto &rm : runtimeModuleList_)
+    rm.trimCaches(critical);
+  if (critical) {
+    regExpCache_.clear();
+    megamorphicPropCache_.clear();
+    std::fill(std::begin(indexSymbols_), std::end(indexSymbols_), SymbolID{});
+  }
+  heap_.handleMemoryPressure(pressure);
+}
+
+void Runtime::saveResetPoint() {
+  // Mark the new state while it is recorded, since recording it may collect.
+  resetPoint_.reset(new RuntimeResetPoint());
+  resetPoint_->save(this);
+}
+
+ExecutionStatus Runtime::resetToSavedPoint() {
+  if (!resetPoint_)
+    return raiseTypeError("No reset point has been saved");
+  return resetPoint_->restore(this);
+}
+
+void Runtime::enableSamplingHeapProfiler(size_t samplingInterval) {
+  samplingHeapProfiler_.reset(
+      new SamplingHeapProfiler(this, samplingInterval));
+  heap_.setAllocationSamplingInterval(samplingInterval);
+}
+
+void Runtime::disableSamplingHeapProfiler(llvm::raw_ostream &os) {
+  if (!samplingHeapProfiler_) {
+    return;
+  }
+  heap_.setAllocationSamplingInterval(0);
+  samplingHeapProfiler_->serialize(os);
+  samplingHeapProfiler_.reset();
+}
+
+void Runtime::enableFunctionProfiler(
+    std::chrono::microseconds interval,
+    bool attributeTime) {
+  // Stop the old timer before resetting the counters, so that a stale tick
+  // isn't charged to the new profile.
+  disableFunctionProfiler();
+  FunctionProfiler::clear(this);
+  functionProfileInterval_ = interval;
+  functionProfileAttributedTime_ = attributeTime;
+  if (interval.count() > 0)
+    functionProfiler_.reset(
+        new FunctionProfiler(functionProfileTick_, interval));
+  // Time is charged from the next function entry or return on.
+  if (attributeTime)
+    timeAttribution_.reset(new FunctionTimeAttribution());
+}
+
+void Runtime::disableFunctionProfiler() {
+  functionProfiler_.reset();
+  functionProfileTick_.store(false, std::memory_order_relaxed);
+  if (timeAttribution_) {
+    // Charge the time up to now.
+    timeAttribution_->switchTo(
+        {nullptr, FunctionTimeAttribution::Category::Interpreter});
+    timeAttribution_.reset();
+  }
+}
+
+void Runtime::dumpFunctionProfile(llvm::raw_ostream &os) {
+  FunctionProfiler::serialize(
+      this, functionProfileInterval_, functionProfileAttributedTime_, os);
+}
+
+void Runtime::enableCodeCoverage() {
+  CodeCoverage::clear(this);
+  codeCoverageEnabled_ = true;
+}
+
+void Runtime::dumpCodeCoverage(llvm::raw_ostream &os) {
+  CodeCoverage::serialize(this, os);
+}
+
+size_t Runtime::releaseIdleCodeBlockData() {
+  // The interpreter frames of these functions may be using their threaded
+  // code.
+  llvm::DenseSet<const CodeBlock *> onStack;
+  for (auto frame : getStackFrames()) {
+    onStack.insert(frame->getCalleeCodeBlock());
+    onStack.insert(frame->getSavedCodeBlock());
+  }
+  size_t size = 0;
+  for (auto &runtimeModule : getRuntimeModules()) {
+    for (CodeBlock *codeBlock : runtimeModule.getFunctionMap()) {
+      // Lazy code blocks are shared with the module that compiled them.
+      if (!codeBlock || codeBlock->getRuntimeModule() != &runtimeModule)
+        continue;
+      if (codeBlock->checkIdle() && !onStack.count(codeBlock) &&
+          !codeBlock->getJITQueued() && !codeBlock->getJITCompiled())
+        size += codeBlock->releaseDerivedData();
+    }
+  }
+  return size;
+}
+
+void Runtime::onGCCycle(bool start) {
+  if (LLVM_UNLIKELY(runtimeStats_.startup.firstGC.count == 0)) {
+    if (start)
+      firstGCTimer_.emplace(&runtimeStats_.startup.firstGC);
+    else
+      firstGCTimer_.reset();
+  }
+  if (!start && codeBlockIdleGCs_ &&
+      ++gcsSinceCodeBlockRelease_ >= codeBlockIdleGCs_) {
+    gcsSinceCodeBlockRelease_ = 0;
+    releaseIdleCodeBlockData();
+  }
+  if (LLVM_LIKELY(!timeAttribution_))
+    return;
+  if (start) {
+    stateBeforeGC_ = timeAttribution_->switchTo(
+        {timeAttribution_->current().codeBlock,
+         FunctionTimeAttribution::Category::GC});
+  } else {
+    timeAttribution_->switchTo(stateBeforeGC_);
+  }
+}
+
+void Runtime::sampleHeapAllocation(uint32_t size) {
+  assert(
+      samplingHeapProfiler_ &&
+      "Allocations are only sampled while the profiler is enabled");
+  samplingHeapProfiler_->sample(size);
+}
+
 void Runtime::setMockedEnvironment(const MockedEnvironment &env) {
 #ifdef HERMESVM_SYNTH_REPLAY
   getCommonStorage()->env = env;
@@ -670,8 +935,11 @@ CallResult<HermesValue> Runtime::runBytecode(
 
   if (flags.persistent) {
     persistentBCProviders_.push_back(bytecode);
-    if (bytecodeWarmupPercent_ > 0) {
-      // Start the warmup thread for this bytecode if it's a buffer.
+    // Start the warmup thread for this bytecode if it's a buffer.  It reads
+    // the pages while the global function starts executing.
+    if (!bytecodeWarmupPages_.empty()) {
+      bytecode->startWarmupPages(bytecodeWarmupPages_);
+    } else if (bytecodeWarmupPercent_ > 0) {
       bytecode->startWarmup(bytecodeWarmupPercent_);
     }
     if (getVMExperimentFlags() & experiments::MAdviseRandom) {
@@ -704,6 +972,14 @@ CallResult<HermesValue> Runtime::runBytecode(
   }
   auto runtimeModule = *runtimeModuleRes;
   auto globalCode = runtimeModule->getCodeBlockMayAllocate(globalFunctionIndex);
+  if (LLVM_UNLIKELY(!globalCode))
+    return runtimeModule->raiseMalformedFunction(globalFunctionIndex);
+
+  // Only the modules which are loaded for good are part of startup, not the
+  // code of eval.
+  llvm::Optional<instrumentation::StartupTimer> globalFunctionTimer;
+  if (flags.persistent)
+    globalFunctionTimer.emplace(&runtimeStats_.startup.globalFunction);
 
 #ifdef HERMES_ENABLE_DEBUGGER
   // If the debugger is configured to pause on load, give it a chance to pause.
@@ -762,6 +1038,27 @@ ExecutionStatus Runtime::loadSegment(
   return ExecutionStatus::RETURNED;
 }
 
+CallResult<bool> Runtime::loadSegmentForModule(
+    Handle<Domain> domain,
+    uint32_t moduleID) {
+  if (!segmentLoader_) {
+    return false;
+  }
+  std::shared_ptr<hbc::BCProvider> bytecode = segmentLoader_(moduleID);
+  if (!bytecode) {
+    return false;
+  }
+
+  GCScopeMarkerRAII marker{this};
+  if (LLVM_UNLIKELY(
+          RuntimeModule::create(
+              this, domain, std::move(bytecode), segmentLoaderFlags_, "") ==
+          ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  return true;
+}
+
 void Runtime::printException(llvm::raw_ostream &os, Handle<> valueHandle) {
   clearThrownValue();
 
@@ -1066,6 +1363,16 @@ std::unique_ptr<Buffer> Runtime::generateSpecialRuntimeBytecode() {
   return buffer;
 }
 
+std::shared_ptr<hbc::BCProvider> Runtime::getSpecialRuntimeBytecode() {
+  // Initialization of a function-local static is thread safe, so runtimes
+  // created concurrently on different threads still share a single copy.
+  static const std::shared_ptr<hbc::BCProvider> bytecode =
+      hbc::BCProviderFromBuffer::createBCProviderFromBuffer(
+          generateSpecialRuntimeBytecode())
+          .first;
+  return bytecode;
+}
+
 void Runtime::initPredefinedStrings() {
   assert(!getTopGCScope() && "There shouldn't be any handles allocated yet");
 
@@ -1167,6 +1474,23 @@ Handle<StringPrimitive> Runtime::getCharacterString(char16_t ch) {
       ignoreAllocationFailure(StringPrimitive::create(this, UTF16Ref(ch))));
 }
 
+CallResult<SymbolID> Runtime::createIndexSymbol(uint32_t index) {
+  // Write the digits in reverse from the end of buf.
+  char buf[4];
+  static_assert(kNumIndexSymbols <= 10000, "buf is too small");
+  char *p = std::end(buf);
+  uint32_t n = index;
+  do {
+    *--p = '0' + n % 10;
+    n /= 10;
+  } while (n);
+  auto symRes = identifierTable_.getSymbolHandle(
+      this, ASCIIRef(p, std::end(buf) - p));
+  if (LLVM_UNLIKELY(symRes == ExecutionStatus::EXCEPTION))
+    return ExecutionStatus::EXCEPTION;
+  return indexSymbols_[index] = **symRes;
+}
+
 // Store all object and symbol ids in a static table to conserve code size.
 static const struct {
   uint16_t object, method;
@@ -1340,9 +1664,7 @@ uint64_t Runtime::gcStableHashHermesValue(Handle<HermesValue> value) {
     }
     case StrTag: {
       // For strings, we hash the string content.
-      auto strView = StringPrimitive::createStringView(
-          this, Handle<StringPrimitive>::vmcast(value));
-      return llvm::hash_combine_range(strView.begin(), strView.end());
+      return value->getString()->getHash();
     }
     default:
       assert(!value->isPointer() && "Unhandled pointer type");
@@ -1366,12 +1688,23 @@ void Runtime::allocStack(uint32_t count, HermesValue initValue) {
   // Note: it is important that allocStack be defined out-of-line. If inline,
   // constants are propagated into initValue, which enables clang to use
   // memset_pattern_16. This ends up being a significant loss as it is an
-  // indirect call.
-  allocUninitializedStack(count);
+  // indirect call. The registers may be in the guard region of the stack, so
+  // they are only checked by the callers.
+  stackPointer_ -= count;
   // Initialize the new registers.
   std::uninitialized_fill_n(stackPointer_, count, initValue);
 }
 
+bool Runtime::checkAndAllocFrameRegisters(uint32_t count) {
+  if (registerStackGuard_ &&
+      checkRegisterStack_.load(std::memory_order_relaxed) &&
+      stackPointer_ >= registerStack_) {
+    // The frames that overflowed into the guard region were popped.
+    registerStackGuard_->rearm();
+  }
+  return checkAndAllocUndefinedStack(count);
+}
+
 void Runtime::dumpCallFrames(llvm::raw_ostream &OS) {
   OS << "== Call Frames ==\n";
   const PinnedHermesValue *next = getStackPointer();
@@ -16,6 +16,8 @@
 #include "hermes/VM/StringPrimitive.h"
 #include "hermes/VM/StringView.h"
 
+#include <algorithm>
+
 namespace hermes {
 namespace vm {
 
@@ -57,8 +59,32 @@ SymbolID RuntimeModule::createSymbolFromStringIDMayAllocate(
   }
 }
 
+SymbolID RuntimeModule::createLazySymbolFromStringIDMayAllocate(
+    StringID stringID) {
+  OptValue<uint32_t> hash;
+  auto it = std::upper_bound(
+      lazyIdentifierRuns_.begin(),
+      lazyIdentifierRuns_.end(),
+      stringID,
+      [](StringID id, const LazyIdentifierRun &run) {
+        return id < run.firstStringID;
+      });
+  if (it != lazyIdentifierRuns_.begin()) {
+    const LazyIdentifierRun &run = *--it;
+    if (stringID - run.firstStringID < run.count) {
+      hash = bcProvider_->getIdentifierTranslations()
+                 [run.firstTranslation + (stringID - run.firstStringID)];
+    }
+  }
+  return createSymbolFromStringIDMayAllocate(
+      stringID, bcProvider_->getStringTableEntry(stringID), hash);
+}
+
 RuntimeModule::~RuntimeModule() {
   runtime_->removeRuntimeModule(this);
+  // The JIT must neither be compiling our CodeBlocks nor keep their native
+  // code once we delete them.
+  runtime_->getJITContext().removeRuntimeModule(this);
 
   // We may reference other CodeBlocks through lazy compilation, but we only
   // own the ones that reference us.
@@ -120,14 +146,24 @@ CodeBlock *RuntimeModule::getCodeBlockSlowPath(unsigned index) {
     return functionMap_[index];
   }
 #endif
+  // Leave the entry empty, so that every use of a malformed function fails.
+  if (LLVM_UNLIKELY(!bcProvider_->isFunctionInBounds(index)))
+    return nullptr;
   functionMap_[index] = CodeBlock::createCodeBlock(
       this,
       bcProvider_->getFunctionHeader(index),
       bcProvider_->getBytecode(index),
       index);
+  runtime_->getJITContext().noteCodeBlockCreated(functionMap_[index]);
   return functionMap_[index];
 }
 
+ExecutionStatus RuntimeModule::raiseMalformedFunction(unsigned index) {
+  return runtime_->raiseSyntaxError(
+      TwineChar16("Malformed bytecode: function ") + index +
+      " lies outside of the bytecode");
+}
+
 #ifndef HERMESVM_LEAN
 RuntimeModule *RuntimeModule::createLazyModule(
     Runtime *runtime,
@@ -212,18 +248,30 @@ void RuntimeModule::initializeLazyMayAllocate(
 void RuntimeModule::importStringIDMapMayAllocate() {
   assert(bcProvider_ && "Uninitialized RuntimeModule");
   PerfSection perf("Import String ID Map");
+  instrumentation::StartupTimer timer{
+      &runtime_->getRuntimeStats().startup.stringTableRegistration};
   GCScope scope(runtime_);
 
   auto strTableSize = bcProvider_->getStringCount();
 
   stringIDMap_.clear();
+  lazyIdentifierRuns_.clear();
 
   // Populate the string ID map with empty identifiers.
   stringIDMap_.resize(strTableSize, SymbolID::empty());
 
+  // The identifiers of a persistent module are registered when they are first
+  // used, since registering a lazy identifier never allocates in the GC heap.
+  // Startup then only pays for the identifiers that are actually touched,
+  // rather than for the whole string table. Their runs are recorded so that
+  // they can still be registered with the hash precomputed by the compiler.
+  const bool lazyIdentifiers = flags_.persistent;
+
   // Preallocate enough space to store all identifiers to prevent
   // unnecessary allocations.
-  runtime_->getIdentifierTable().reserve(strTableSize);
+  if (!lazyIdentifiers) {
+    runtime_->getIdentifierTable().reserve(strTableSize);
+  }
 
   if (runtime_->getVMExperimentFlags() &
       experiments::MAdviseStringsSequential) {
@@ -252,6 +300,12 @@ void RuntimeModule::importStringIDMapMayAllocate() {
           break;
 
         case StringKind::Identifier:
+          if (lazyIdentifiers) {
+            lazyIdentifierRuns_.push_back({strID, entry.count(), trnID});
+            strID += entry.count();
+            trnID += entry.count();
+            break;
+          }
           for (uint32_t i = 0; i < entry.count(); ++i, ++strID, ++trnID) {
             createSymbolFromStringIDMayAllocate(
                 strID,
@@ -368,8 +422,18 @@ SymbolID RuntimeModule::mapPredefined(StringID stringID, uint32_t rawSymbolID) {
 }
 
 void RuntimeModule::markRoots(SlotAcceptor &acceptor, bool markLongLived) {
-  for (auto &it : templateMap_) {
-    acceptor.acceptPtr(it.second);
+  for (JSObject *&templateObj : templateObjects_) {
+    if (templateObj) {
+      acceptor.acceptPtr(templateObj);
+    }
+  }
+  for (auto &it : requireFastExports_) {
+    acceptor.accept(it.second);
+  }
+  for (auto &it : literalValues_) {
+    if (it.second) {
+      acceptor.acceptPtr(it.second);
+    }
   }
 
   if (markLongLived) {
@@ -400,6 +464,21 @@ void RuntimeModule::markDomainRef(GC *gc) {
   gc->markWeakRef(domain_);
 }
 
+void RuntimeModule::trimCaches(bool all) {
+  // DenseMap's erase() doesn't invalidate any iterators.
+  for (auto it = objectLiteralHiddenClasses_.begin(),
+            e = objectLiteralHiddenClasses_.end();
+       it != e;
+       ++it) {
+    if (!it->second)
+      objectLiteralHiddenClasses_.erase(it);
+  }
+  if (all) {
+    literalValues_.clear();
+    requireFastExports_.clear();
+  }
+}
+
 llvm::Optional<Handle<HiddenClass>> RuntimeModule::findCachedLiteralHiddenClass(
     unsigned keyBufferIndex,
     unsigned numLiterals) const {
@@ -429,9 +508,11 @@ void RuntimeModule::tryCacheLiteralHiddenClass(
 
 size_t RuntimeModule::additionalMemorySize() const {
   size_t total = stringIDMap_.capacity() * sizeof(SymbolID) +
+      lazyIdentifierRuns_.capacity() * sizeof(LazyIdentifierRun) +
       functionMap_.capacity() * sizeof(CodeBlock *) +
       objectLiteralHiddenClasses_.getMemorySize() +
-      templateMap_.getMemorySize();
+      templateObjects_.capacity() * sizeof(JSObject *) +
+      requireFastExports_.getMemorySize() + literalValues_.getMemorySize();
   // Add the size of each CodeBlock
   for (const CodeBlock *cb : functionMap_) {
     // Skip the null code blocks, they are lazily inserted the first time
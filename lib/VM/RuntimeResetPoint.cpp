@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/VM/RuntimeResetPoint.h"
+
+#include "hermes/VM/HiddenClass.h"
+#include "hermes/VM/InternalProperty.h"
+#include "hermes/VM/JSObject.h"
+#include "hermes/VM/Runtime.h"
+#include "hermes/VM/SlotAcceptor.h"
+
+#include "llvm/ADT/DenseMap.h"
+
+namespace hermes {
+namespace vm {
+
+void RuntimeResetPoint::save(Runtime *runtime) {
+  GCScope gcScope{runtime};
+  objects_.clear();
+
+  addObject(runtime, runtime->getGlobal());
+  // objects_ may be reallocated by addObject(), so index it every time.
+  for (size_t i = 0; i < objects_[0].properties.size(); ++i) {
+    const SavedProperty &prop = objects_[0].properties[i];
+    if (!prop.flags.accessor && prop.value.isObject()) {
+      addObject(runtime, runtime->makeHandle<JSObject>(prop.value));
+    }
+  }
+  for (size_t i = 1, e = objects_.size(); i < e; ++i) {
+    for (const SavedProperty &prop : objects_[i].properties) {
+      if (prop.name == Predefined::getSymbolID(Predefined::prototype) &&
+          !prop.flags.accessor && prop.value.isObject()) {
+        addObject(runtime, runtime->makeHandle<JSObject>(prop.value));
+        break;
+      }
+    }
+  }
+}
+
+void RuntimeResetPoint::addObject(Runtime *runtime, Handle<JSObject> obj) {
+  if (obj->isHostObject())
+    return;
+  if (obj->isLazy())
+    JSObject::initializeLazyObject(runtime, obj);
+  for (const SavedObject &saved : objects_) {
+    if (saved.object.getObject() == obj.get())
+      return;
+  }
+  JSObject *parent = obj->getParent(runtime);
+  objects_.emplace_back(
+      obj.getHermesValue(),
+      parent ? HermesValue::encodeObjectValue(parent)
+             : HermesValue::encodeNullValue(),
+      (bool)obj->flags_.noExtend,
+      (bool)obj->flags_.sealed,
+      (bool)obj->flags_.frozen);
+  SavedObject &saved = objects_.back();
+  // Reading the properties doesn't allocate in the heap, so saved and obj
+  // stay valid.
+  HiddenClass::forEachProperty(
+      runtime->makeHandle(obj->getClass(runtime)),
+      runtime,
+      [runtime, obj, &saved](SymbolID id, NamedPropertyDescriptor desc) {
+        if (InternalProperty::isInternal(id))
+          return;
+        saved.properties.push_back(SavedProperty{
+            id, desc.flags, JSObject::getNamedSlotValue(*obj, runtime, desc)});
+      });
+}
+
+ExecutionStatus RuntimeResetPoint::restore(Runtime *runtime) {
+  GCScope gcScope{runtime};
+  runtime->clearThrownValue();
+  runtime->promiseJobQueue.clear();
+  runtime->regExpLastInput = HermesValue::encodeUndefinedValue();
+  runtime->regExpLastRegExp = HermesValue::encodeUndefinedValue();
+
+  // Detach the parents which changed before restoring any of them, so that
+  // a parent restored first can't form a cycle with one which isn't restored
+  // yet. Extensibility is restored last, since it prevents both.
+  for (SavedObject &saved : objects_) {
+    auto *obj = vmcast<JSObject>(saved.object);
+    obj->flags_.noExtend = 0;
+    obj->flags_.sealed = 0;
+    obj->flags_.frozen = 0;
+    if (obj->getParent(runtime) != dyn_vmcast<JSObject>(saved.parent))
+      obj->parent_.set(runtime, nullptr, &runtime->getHeap());
+  }
+  for (SavedObject &saved : objects_) {
+    if (LLVM_UNLIKELY(
+            restoreProperties(runtime, saved) == ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+  }
+  for (SavedObject &saved : objects_) {
+    if (LLVM_UNLIKELY(
+            JSObject::setParent(
+                vmcast<JSObject>(saved.object),
+                runtime,
+                dyn_vmcast<JSObject>(saved.parent)) ==
+            ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+  }
+  for (SavedObject &saved : objects_) {
+    auto *obj = vmcast<JSObject>(saved.object);
+    obj->flags_.noExtend = saved.noExtend;
+    obj->flags_.sealed = saved.sealed;
+    obj->flags_.frozen = saved.frozen;
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+ExecutionStatus RuntimeResetPoint::restoreProperties(
+    Runtime *runtime,
+    SavedObject &saved) {
+  auto obj = runtime->makeHandle<JSObject>(saved.object);
+
+  llvm::DenseMap<SymbolID, unsigned> savedIndex{};
+  for (unsigned i = 0, e = saved.properties.size(); i < e; ++i)
+    savedIndex[saved.properties[i].name] = i;
+
+  // The properties which still have their flags get back their values in
+  // place, which keeps their order. The others are deleted, and the recorded
+  // ones added again. The class can't change while it is being iterated, so
+  // the deletions are done afterwards.
+  std::vector<bool> kept(saved.properties.size());
+  std::vector<SymbolID> deleted{};
+  HiddenClass::forEachProperty(
+      runtime->makeHandle(obj->getClass(runtime)),
+      runtime,
+      [&](SymbolID id, NamedPropertyDescriptor desc) {
+        if (InternalProperty::isInternal(id))
+          return;
+        auto it = savedIndex.find(id);
+        if (it != savedIndex.end() &&
+            saved.properties[it->second].flags == desc.flags) {
+          JSObject::setNamedSlotValue(
+              *obj, runtime, desc, saved.properties[it->second].value);
+          kept[it->second] = true;
+        } else {
+          deleted.push_back(id);
+        }
+      });
+  for (SymbolID id : deleted) {
+    if (LLVM_UNLIKELY(
+            JSObject::deleteNamed(
+                obj, runtime, id, PropOpFlags().plusInternalForce()) ==
+            ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+  }
+
+  MutableHandle<> value{runtime};
+  for (unsigned i = 0, e = saved.properties.size(); i < e; ++i) {
+    if (kept[i])
+      continue;
+    const SavedProperty &prop = saved.properties[i];
+    value = prop.value;
+    if (LLVM_UNLIKELY(
+            JSObject::defineNewOwnProperty(
+                obj, runtime, prop.name, prop.flags, value) ==
+            ExecutionStatus::EXCEPTION))
+      return ExecutionStatus::EXCEPTION;
+  }
+  // The object may have been frozen since, and its properties are not anymore.
+  obj->getClass(runtime)->clearAllNonConfigurableFlags();
+  return ExecutionStatus::RETURNED;
+}
+
+void RuntimeResetPoint::markRoots(SlotAcceptorWithNames &acceptor) {
+  for (SavedObject &saved : objects_) {
+    acceptor.accept(saved.object, "@resetPointObject");
+    acceptor.accept(saved.parent, "@resetPointParent");
+    for (SavedProperty &prop : saved.properties) {
+      acceptor.accept(prop.name);
+      acceptor.accept(prop.value, "@resetPointValue");
+    }
+  }
+}
+
+} // namespace vm
+} // namespace hermes
@@ -16,8 +16,9 @@
 #include "llvm/Support/MathExtras.h"
 
 #include <cassert>
+#include <functional>
 #include <limits>
-#include <stack>
+#include <queue>
 
 namespace hermes {
 namespace vm {
@@ -53,12 +54,16 @@ class MallocStorageProvider final : public StorageProvider {
 
 class PreAllocatedStorageProvider final : public StorageProvider {
  public:
-  PreAllocatedStorageProvider(size_t totalAmount, void *region);
+  PreAllocatedStorageProvider(size_t totalAmount, void *region, bool hugePages);
   ~PreAllocatedStorageProvider();
 
   llvm::ErrorOr<void *> newStorage(const char *name) override;
   void deleteStorage(void *storage) override;
 
+  size_t hugePageBytes() const override {
+    return hugePageBytes_;
+  }
+
  private:
   /// Max amount of bytes ever allocatable.
   const size_t maxBytes_;
@@ -72,11 +77,15 @@ class PreAllocatedStorageProvider final : public StorageProvider {
   /// End of used storages. This can be increased up to end_.
   char *level_;
 
+  /// Bytes of the region that were advised to be backed by huge pages.
+  size_t hugePageBytes_{0};
+
   /// Storages that are not in use, and can be re-assigned.
   /// If empty, take from the level_.
-  /// Since storages all the same size, this is simply re-using the most
-  /// recently deleted storage.
-  std::stack<char *, std::vector<char *>> freeList_;
+  /// The storage with the lowest address is re-used first, which keeps the
+  /// heap packed at the start of the region, spanning fewer (huge) pages.
+  std::priority_queue<char *, std::vector<char *>, std::greater<char *>>
+      freeList_;
 };
 
 llvm::ErrorOr<void *> VMAllocateStorageProvider::newStorage(const char *name) {
@@ -123,12 +132,19 @@ void MallocStorageProvider::deleteStorage(void *storage) {
 
 PreAllocatedStorageProvider::PreAllocatedStorageProvider(
     size_t totalAmount,
-    void *region)
+    void *region,
+    bool hugePages)
     : maxBytes_(totalAmount),
       start_(static_cast<char *>(region)),
       end_(start_ ? start_ + maxBytes_ : nullptr),
       level_(start_) {
   assert(maxBytes_ % AlignedStorage::size() == 0 && "Un-aligned maxBytes");
+  // The region is aligned on AlignedStorage::size(), a multiple of the usual
+  // 2MB huge page size, so releasing a storage doesn't split huge pages.
+  if (hugePages && start_ &&
+      oscompat::vm_madvise(start_, maxBytes_, oscompat::MAdvice::HugePage)) {
+    hugePageBytes_ = maxBytes_;
+  }
 }
 
 PreAllocatedStorageProvider::~PreAllocatedStorageProvider() {
@@ -178,7 +194,8 @@ llvm::ErrorOr<std::unique_ptr<StorageProvider>>
 StorageProvider::preAllocatedProvider(
     size_t amount,
     size_t minAmount,
-    size_t excess) {
+    size_t excess,
+    bool hugePages) {
   assert(
       amount % AlignedStorage::size() == 0 &&
       "amount must be a multiple of AlignedStorage::size()");
@@ -203,7 +220,7 @@ StorageProvider::preAllocatedProvider(
     maxBytes = memAndSz.second;
   }
   return std::unique_ptr<StorageProvider>(
-      new PreAllocatedStorageProvider(maxBytes, region));
+      new PreAllocatedStorageProvider(maxBytes, region, hugePages));
 }
 
 /* static */
@@ -7,9 +7,11 @@
 #include "hermes/VM/StringPrimitive.h"
 
 #include "hermes/Support/Algorithms.h"
+#include "hermes/Support/HashString.h"
 #include "hermes/Support/UTF8.h"
 #include "hermes/VM/BuildMetadata.h"
 #include "hermes/VM/FillerCell.h"
+#include "hermes/VM/GCPointer-inline.h"
 #include "hermes/VM/StringBuilder.h"
 #include "hermes/VM/StringView.h"
 
@@ -56,6 +58,35 @@ void ExternalUTF16StringPrimitiveBuildMeta(
   symbolStringPrimitiveBuildMeta(cell, mb);
 }
 
+// The buffer is outside the JS heap, so only the owner of a slice is marked.
+void BufferedASCIIStringPrimitiveBuildMeta(
+    const GCCell *cell,
+    Metadata::Builder &mb) {
+  const auto *self = static_cast<const BufferedASCIIStringPrimitive *>(cell);
+  mb.addField("owner", &self->owner_);
+}
+
+void BufferedUTF16StringPrimitiveBuildMeta(
+    const GCCell *cell,
+    Metadata::Builder &mb) {
+  const auto *self = static_cast<const BufferedUTF16StringPrimitive *>(cell);
+  mb.addField("owner", &self->owner_);
+}
+
+void SlicedASCIIStringPrimitiveBuildMeta(
+    const GCCell *cell,
+    Metadata::Builder &mb) {
+  const auto *self = static_cast<const SlicedASCIIStringPrimitive *>(cell);
+  mb.addField("parent", &self->parent_);
+}
+
+void SlicedUTF16StringPrimitiveBuildMeta(
+    const GCCell *cell,
+    Metadata::Builder &mb) {
+  const auto *self = static_cast<const SlicedUTF16StringPrimitive *>(cell);
+  mb.addField("parent", &self->parent_);
+}
+
 template <typename T>
 CallResult<HermesValue> StringPrimitive::createEfficientImpl(
     Runtime *runtime,
@@ -147,6 +178,75 @@ bool StringPrimitive::sliceEquals(
       castToUTF16Ref(start, length), other->castToUTF16Ref());
 }
 
+/// Search for \p needle in \p haystack, forwards from \p start, or
+/// backwards if \p reverse is true.
+/// \return the index of the match, or -1.
+template <typename T>
+static int64_t findInStringRef(
+    llvm::ArrayRef<T> haystack,
+    llvm::ArrayRef<T> needle,
+    uint32_t start,
+    bool reverse) {
+  size_t pos = reverse ? findLastSubstring(haystack, needle, start)
+                       : findSubstring(haystack, needle, start);
+  return pos == kSubstringNotFound ? -1 : (int64_t)pos;
+}
+
+int64_t StringPrimitive::find(
+    const StringPrimitive *other,
+    uint32_t start,
+    bool reverse) const {
+  // Convert the needle to the character type of this string, so that the
+  // search compares characters of the same size.
+  if (isASCII()) {
+    if (other->isASCII()) {
+      return findInStringRef(
+          castToASCIIRef(), other->castToASCIIRef(), start, reverse);
+    }
+    // An ASCII string can only contain an ASCII needle.
+    llvm::SmallVector<char, 32> narrow;
+    for (char16_t ch : other->castToUTF16Ref()) {
+      if (ch > 127) {
+        return -1;
+      }
+      narrow.push_back((char)ch);
+    }
+    return findInStringRef(castToASCIIRef(), ASCIIRef(narrow), start, reverse);
+  }
+  if (other->isASCII()) {
+    ASCIIRef ascii = other->castToASCIIRef();
+    llvm::SmallVector<char16_t, 32> wide(ascii.begin(), ascii.end());
+    return findInStringRef(castToUTF16Ref(), UTF16Ref(wide), start, reverse);
+  }
+  return findInStringRef(
+      castToUTF16Ref(), other->castToUTF16Ref(), start, reverse);
+}
+
+int64_t StringPrimitive::indexOf(
+    const StringPrimitive *other,
+    uint32_t start) const {
+  return find(other, start, false);
+}
+
+int64_t StringPrimitive::lastIndexOf(
+    const StringPrimitive *other,
+    uint32_t start) const {
+  return find(other, start, true);
+}
+
+uint32_t StringPrimitive::getHash() const {
+  auto *symbolStr = dyn_vmcast<SymbolStringPrimitive>(this);
+  if (symbolStr && symbolStr->hash_) {
+    return symbolStr->hash_;
+  }
+  uint32_t hash = isASCII() ? hermes::hashString(castToASCIIRef())
+                            : hermes::hashString(castToUTF16Ref());
+  if (symbolStr) {
+    symbolStr->hash_ = hash;
+  }
+  return hash;
+}
+
 bool StringPrimitive::equals(const StringPrimitive *other) const {
   if (this == other) {
     return true;
@@ -191,9 +291,23 @@ CallResult<HermesValue> StringPrimitive::concat(
 
   SafeUInt32 xyLen(xLen);
   xyLen.add(yLen);
+  bool isASCII = xHandle->isASCII() && yHandle->isASCII();
 
-  auto builder = StringBuilder::createStringBuilder(
-      runtime, xyLen, xHandle->isASCII() && yHandle->isASCII());
+  // Short strings are cheap enough to copy, and copying them saves the
+  // separate allocation of a buffer.
+  if (!xyLen.isOverflowed() && *xyLen >= EXTERNAL_STRING_MIN_SIZE) {
+    if (LLVM_UNLIKELY(*xyLen > MAX_STRING_LENGTH)) {
+      return runtime->raiseRangeError("String length exceeds limit");
+    }
+    if (isASCII) {
+      return BufferedASCIIStringPrimitive::concat(
+          runtime, xHandle, yHandle, *xyLen);
+    }
+    return BufferedUTF16StringPrimitive::concat(
+        runtime, xHandle, yHandle, *xyLen);
+  }
+
+  auto builder = StringBuilder::createStringBuilder(runtime, xyLen, isASCII);
   if (builder == ExecutionStatus::EXCEPTION) {
     return ExecutionStatus::EXCEPTION;
   }
@@ -211,6 +325,13 @@ CallResult<HermesValue> StringPrimitive::slice(
   assert(
       start + length <= str->getStringLength() && "Invalid length for slice");
 
+  if (length >= SHARED_SLICE_MIN_SIZE) {
+    HermesValue shared = sliceShared(runtime, str, start, length);
+    if (!shared.isEmpty()) {
+      return shared;
+    }
+  }
+
   SafeUInt32 safeLen(length);
 
   auto builder =
@@ -228,6 +349,26 @@ CallResult<HermesValue> StringPrimitive::slice(
   return HermesValue::encodeStringValue(*builder->getStringPrimitive());
 }
 
+HermesValue StringPrimitive::sliceShared(
+    Runtime *runtime,
+    Handle<StringPrimitive> str,
+    uint32_t start,
+    uint32_t length) {
+  if (str->isBuffered()) {
+    return str->isASCII() ? BufferedASCIIStringPrimitive::sliceShared(
+                                runtime, str, start, length)
+                          : BufferedUTF16StringPrimitive::sliceShared(
+                                runtime, str, start, length);
+  }
+  if (str->isExternal() || str->isSliced()) {
+    return str->isASCII()
+        ? SlicedASCIIStringPrimitive::sliceShared(runtime, str, start, length)
+        : SlicedUTF16StringPrimitive::sliceShared(runtime, str, start, length);
+  }
+  // The characters of other strings move with them.
+  return HermesValue::encodeEmptyValue();
+}
+
 StringView StringPrimitive::createStringView(
     Runtime *runtime,
     Handle<StringPrimitive> self) {
@@ -380,6 +521,10 @@ template <typename T>
 void ExternalStringPrimitive<T>::_finalizeImpl(GCCell *cell, GC *gc) {
   ExternalStringPrimitive<T> *self = vmcast<ExternalStringPrimitive<T>>(cell);
   gc->debitExternalMemory(self, self->getStringByteSize());
+  // External strings are large: free the contents after the collection.
+  gc->deferFinalization([contents = std::move(self->contents_)]() mutable {
+    StdString().swap(contents);
+  });
   self->~ExternalStringPrimitive<T>();
 }
 
@@ -392,5 +537,152 @@ size_t ExternalStringPrimitive<T>::_mallocSizeImpl(GCCell *cell) {
 template class ExternalStringPrimitive<char16_t>;
 template class ExternalStringPrimitive<char>;
 
+/// Append the characters of \p str to \p buffer. They must fit in T.
+template <typename T>
+static void appendToBuffer(
+    std::basic_string<T> &buffer,
+    const StringPrimitive *str) {
+  if (str->isASCII()) {
+    ASCIIRef ref = str->getStringRef<char>();
+    buffer.append(ref.begin(), ref.end());
+  } else {
+    assert(
+        (std::is_same<T, char16_t>::value) &&
+        "UTF-16 string appended to an ASCII buffer");
+    UTF16Ref ref = str->getStringRef<char16_t>();
+    buffer.append(ref.begin(), ref.end());
+  }
+}
+
+template <typename T>
+CallResult<HermesValue> BufferedStringPrimitive<T>::concat(
+    Runtime *runtime,
+    Handle<StringPrimitive> xHandle,
+    Handle<StringPrimitive> yHandle,
+    uint32_t xyLen) {
+  std::shared_ptr<StdString> buffer;
+  uint32_t offset = 0;
+  auto *bufferedX = dyn_vmcast<BufferedStringPrimitive<T>>(xHandle.get());
+  if (bufferedX &&
+      bufferedX->offset_ + bufferedX->getStringLength() ==
+          bufferedX->buffer_->size()) {
+    // x ends its buffer, so y can be appended in place.
+    buffer = bufferedX->buffer_;
+    offset = bufferedX->offset_;
+  } else {
+    buffer = std::make_shared<StdString>();
+  }
+
+  uint32_t externalBytes = (offset + xyLen - buffer->size()) * sizeof(T);
+  if (LLVM_UNLIKELY(
+          !runtime->getHeap().canAllocExternalMemory(externalBytes))) {
+    return runtime->raiseRangeError(
+        "Cannot allocate an external string primitive.");
+  }
+
+  // Grow geometrically, so that repeated appends take amortized linear time.
+  // This also happens before anything is appended, since y may be in the
+  // same buffer, and must not move while it is copied.
+  size_t newSize = (size_t)offset + xyLen;
+  if (buffer->capacity() < newSize) {
+    buffer->reserve(std::max<size_t>(newSize, buffer->capacity() * 2));
+  }
+  if (buffer->empty()) {
+    appendToBuffer(*buffer, xHandle.get());
+  }
+  appendToBuffer(*buffer, yHandle.get());
+  assert(buffer->size() == newSize && "wrong concatenation length");
+
+  return create(
+      runtime,
+      std::move(buffer),
+      offset,
+      xyLen,
+      externalBytes,
+      runtime->makeNullHandle<StringPrimitive>());
+}
+
+template <typename T>
+HermesValue BufferedStringPrimitive<T>::create(
+    Runtime *runtime,
+    std::shared_ptr<StdString> buffer,
+    uint32_t offset,
+    uint32_t length,
+    uint32_t externalBytes,
+    Handle<StringPrimitive> owner) {
+  void *mem = runtime->alloc</*fixedSize*/ true, HasFinalizer::Yes>(
+      sizeof(BufferedStringPrimitive<T>));
+  auto res =
+      HermesValue::encodeStringValue(new (mem) BufferedStringPrimitive<T>(
+          runtime,
+          std::move(buffer),
+          offset,
+          length,
+          externalBytes,
+          owner ? vmcast<BufferedStringPrimitive<T>>(*owner) : nullptr));
+  runtime->getHeap().creditExternalMemory(res.getString(), externalBytes);
+  return res;
+}
+
+template <typename T>
+HermesValue BufferedStringPrimitive<T>::sliceShared(
+    Runtime *runtime,
+    Handle<StringPrimitive> str,
+    uint32_t start,
+    uint32_t length) {
+  auto *self = vmcast<BufferedStringPrimitive<T>>(*str);
+  if (!shouldShareSlice(length, self->buffer_->size())) {
+    return HermesValue::encodeEmptyValue();
+  }
+  auto owner = self->owner_
+      ? runtime->makeHandle<StringPrimitive>(self->owner_.get(runtime))
+      : str;
+  return create(
+      runtime, self->buffer_, self->offset_ + start, length, 0, owner);
+}
+
+template <typename T>
+void BufferedStringPrimitive<T>::_finalizeImpl(GCCell *cell, GC *gc) {
+  BufferedStringPrimitive<T> *self = vmcast<BufferedStringPrimitive<T>>(cell);
+  gc->debitExternalMemory(self, self->externalBytes_);
+  self->~BufferedStringPrimitive<T>();
+}
+
+template <typename T>
+size_t BufferedStringPrimitive<T>::_mallocSizeImpl(GCCell *cell) {
+  return vmcast<BufferedStringPrimitive<T>>(cell)->externalBytes_;
+}
+
+template class BufferedStringPrimitive<char16_t>;
+template class BufferedStringPrimitive<char>;
+
+template <typename T>
+HermesValue SlicedStringPrimitive<T>::sliceShared(
+    Runtime *runtime,
+    Handle<StringPrimitive> str,
+    uint32_t start,
+    uint32_t length) {
+  // A slice of a slice shares the characters of the parent, rather than
+  // keeping a chain of slices alive.
+  auto getParent = [runtime, str]() {
+    if (auto *sliced = dyn_vmcast<SlicedStringPrimitive<T>>(*str)) {
+      return sliced->parent_.get(runtime);
+    }
+    return vmcast<ExternalStringPrimitive<T>>(*str);
+  };
+  if (!shouldShareSlice(length, getParent()->getStringLength())) {
+    return HermesValue::encodeEmptyValue();
+  }
+
+  void *mem = runtime->alloc(sizeof(SlicedStringPrimitive<T>));
+  // The allocation may have moved the parent, but not its characters.
+  const T *chars = str->template getStringRef<T>().data() + start;
+  return HermesValue::encodeStringValue(new (mem) SlicedStringPrimitive<T>(
+      runtime, getParent(), chars, length));
+}
+
+template class SlicedStringPrimitive<char16_t>;
+template class SlicedStringPrimitive<char>;
+
 } // namespace vm
 } // namespace hermes
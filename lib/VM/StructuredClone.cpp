@@ -0,0 +1,613 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/VM/StructuredClone.h"
+
+#include "hermes/VM/ArrayStorage.h"
+#include "hermes/VM/JSArray.h"
+#include "hermes/VM/JSArrayBuffer.h"
+#include "hermes/VM/JSDate.h"
+#include "hermes/VM/JSTypedArray.h"
+#include "hermes/VM/StringPrimitive.h"
+
+#include "llvm/ADT/DenseMap.h"
+
+#include <cstring>
+
+namespace hermes {
+namespace vm {
+
+namespace {
+
+/// The tag that starts every serialized value. The format is only ever read
+/// by the process that wrote it, so numbers are in native byte order and
+/// typed arrays are identified by their CellKind.
+enum class Tag : uint8_t {
+  Undefined,
+  Null,
+  False,
+  True,
+  /// A double.
+  Number,
+  /// A uint32 length followed by the characters.
+  ASCIIString,
+  UTF16String,
+  /// A uint32 property count followed by key/value pairs.
+  Object,
+  /// A uint32 length, then the properties as for Object.
+  Array,
+  /// The time value as a double.
+  Date,
+  /// A uint32 size followed by the contents.
+  ArrayBuffer,
+  /// A uint32 index into the transferred data blocks.
+  TransferredArrayBuffer,
+  /// The CellKind, the uint32 byte offset and length, then the buffer.
+  TypedArray,
+  /// The uint32 index of an object that was already started, in the order
+  /// objects are started.
+  BackReference,
+};
+
+} // namespace
+
+//===----------------------------------------------------------------------===//
+// class SerializedValue::Serializer
+
+class SerializedValue::Serializer {
+ public:
+  Serializer(Runtime *runtime, SerializedValue &out)
+      : runtime_(runtime), out_(out), transfer_(runtime) {}
+
+  /// Record the ArrayBuffers in \p transfer, which is undefined or an array
+  /// of ArrayBuffers, so that they are transferred instead of copied.
+  ExecutionStatus setTransferList(Handle<> transfer);
+
+  /// Append \p value to the output.
+  ExecutionStatus writeValue(Handle<> value);
+
+  /// Detach the ArrayBuffers of the transfer list and move their data blocks
+  /// to the output. Called once the whole value has been written.
+  ExecutionStatus takeTransferredBlocks();
+
+ private:
+  Runtime *const runtime_;
+  SerializedValue &out_;
+
+  /// The transfer list, or null.
+  MutableHandle<JSArray> transfer_;
+
+  /// The index of every ArrayBuffer in the transfer list, by object ID.
+  llvm::DenseMap<ObjectID, uint32_t> transferIndex_{};
+
+  /// The index of every object started so far, by object ID.
+  llvm::DenseMap<ObjectID, uint32_t> memory_{};
+
+  void writeTag(Tag tag) {
+    out_.bytes_.push_back(static_cast<uint8_t>(tag));
+  }
+
+  template <typename T>
+  void writeRaw(const T &value) {
+    writeBytes(&value, sizeof(T));
+  }
+
+  void writeBytes(const void *data, size_t size) {
+    auto &bytes = out_.bytes_;
+    size_t pos = bytes.size();
+    bytes.resize(pos + size);
+    if (size)
+      memcpy(bytes.data() + pos, data, size);
+  }
+
+  void writeString(const StringPrimitive *str);
+
+  ExecutionStatus writeObject(Handle<JSObject> obj);
+
+  /// Write the own enumerable properties of \p obj.
+  ExecutionStatus writeProperties(Handle<JSObject> obj);
+
+  ExecutionStatus writeArrayBuffer(Handle<JSArrayBuffer> buffer);
+};
+
+ExecutionStatus SerializedValue::Serializer::setTransferList(
+    Handle<> transfer) {
+  if (transfer->isUndefined())
+    return ExecutionStatus::RETURNED;
+  transfer_ = dyn_vmcast<JSArray>(*transfer);
+  if (!transfer_) {
+    return runtime_->raiseTypeError("The transfer list must be an array");
+  }
+  for (uint32_t i = 0, e = JSArray::getLength(*transfer_); i < e; ++i) {
+    auto *buffer = dyn_vmcast<JSArrayBuffer>(transfer_->at(runtime_, i));
+    if (!buffer) {
+      return runtime_->raiseTypeError(
+          "Only ArrayBuffers can be in the transfer list");
+    }
+    if (!buffer->attached()) {
+      return runtime_->raiseTypeError(
+          "A detached ArrayBuffer cannot be transferred");
+    }
+    if (!transferIndex_
+             .try_emplace(JSObject::getObjectID(buffer, runtime_), i)
+             .second) {
+      return runtime_->raiseTypeError(
+          "An ArrayBuffer is in the transfer list more than once");
+    }
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+ExecutionStatus SerializedValue::Serializer::takeTransferredBlocks() {
+  if (!transfer_)
+    return ExecutionStatus::RETURNED;
+  GCScope gcScope(runtime_);
+  MutableHandle<JSArrayBuffer> buffer{runtime_};
+  for (uint32_t i = 0, e = JSArray::getLength(*transfer_); i < e; ++i) {
+    buffer = vmcast<JSArrayBuffer>(transfer_->at(runtime_, i));
+    auto blockRes = buffer->releaseDataBlock(runtime_);
+    if (LLVM_UNLIKELY(blockRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    out_.transferred_.push_back(*blockRes);
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+ExecutionStatus SerializedValue::Serializer::writeValue(Handle<> value) {
+  if (value->isUndefined()) {
+    writeTag(Tag::Undefined);
+  } else if (value->isNull()) {
+    writeTag(Tag::Null);
+  } else if (value->isBool()) {
+    writeTag(value->getBool() ? Tag::True : Tag::False);
+  } else if (value->isNumber()) {
+    writeTag(Tag::Number);
+    writeRaw(value->getNumber());
+  } else if (value->isString()) {
+    writeString(value->getString());
+  } else if (value->isObject()) {
+    return writeObject(Handle<JSObject>::vmcast(value));
+  } else {
+    return runtime_->raiseTypeErrorForValue(value, " could not be cloned");
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+void SerializedValue::Serializer::writeString(const StringPrimitive *str) {
+  if (str->isASCII()) {
+    auto ref = str->getStringRef<char>();
+    writeTag(Tag::ASCIIString);
+    writeRaw<uint32_t>(ref.size());
+    writeBytes(ref.data(), ref.size());
+  } else {
+    auto ref = str->getStringRef<char16_t>();
+    writeTag(Tag::UTF16String);
+    writeRaw<uint32_t>(ref.size());
+    writeBytes(ref.data(), ref.size() * sizeof(char16_t));
+  }
+}
+
+ExecutionStatus SerializedValue::Serializer::writeObject(
+    Handle<JSObject> obj) {
+  ScopedNativeDepthTracker depthTracker{runtime_};
+  if (LLVM_UNLIKELY(depthTracker.overflowed())) {
+    return runtime_->raiseStackOverflow(
+        Runtime::StackOverflowKind::NativeStack);
+  }
+
+  ObjectID id = JSObject::getObjectID(*obj, runtime_);
+  auto it = memory_.find(id);
+  if (it != memory_.end()) {
+    writeTag(Tag::BackReference);
+    writeRaw<uint32_t>(it->second);
+    return ExecutionStatus::RETURNED;
+  }
+  memory_.try_emplace(id, memory_.size());
+
+  if (auto buffer = Handle<JSArrayBuffer>::dyn_vmcast(runtime_, obj)) {
+    return writeArrayBuffer(buffer);
+  }
+  if (auto view = Handle<JSTypedArrayBase>::dyn_vmcast(runtime_, obj)) {
+    if (!view->attached(runtime_)) {
+      return runtime_->raiseTypeError(
+          "A typed array with a detached buffer could not be cloned");
+    }
+    writeTag(Tag::TypedArray);
+    writeRaw(static_cast<uint8_t>(view->getKind()));
+    writeRaw<uint32_t>(view->getByteOffset(runtime_));
+    writeRaw<uint32_t>(view->getLength());
+    // The buffer may be shared with other views, so it is an object of its
+    // own.
+    return writeObject(runtime_->makeHandle(view->getBuffer(runtime_)));
+  }
+
+  switch (obj->getKind()) {
+    case CellKind::ObjectKind:
+      writeTag(Tag::Object);
+      return writeProperties(obj);
+    case CellKind::ArrayKind:
+      writeTag(Tag::Array);
+      writeRaw<uint32_t>(JSArray::getLength(vmcast<JSArray>(*obj)));
+      return writeProperties(obj);
+    case CellKind::DateKind:
+      writeTag(Tag::Date);
+      writeRaw(JSDate::getPrimitiveValue(*obj, runtime_).getNumber());
+      return ExecutionStatus::RETURNED;
+    default:
+      return runtime_->raiseTypeErrorForValue(obj, " could not be cloned");
+  }
+}
+
+ExecutionStatus SerializedValue::Serializer::writeProperties(
+    Handle<JSObject> obj) {
+  auto keysRes = JSObject::getOwnPropertyNames(obj, runtime_, true);
+  if (LLVM_UNLIKELY(keysRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  Handle<JSArray> keys = *keysRes;
+  writeRaw<uint32_t>(keys->getEndIndex());
+
+  GCScope gcScope(runtime_);
+  MutableHandle<> key{runtime_};
+  auto marker = gcScope.createMarker();
+  for (uint32_t i = 0, e = keys->getEndIndex(); i < e; ++i) {
+    gcScope.flushToMarker(marker);
+    // Index-like keys are numbers, which are written as such.
+    key = keys->at(runtime_, i);
+    if (LLVM_UNLIKELY(writeValue(key) == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    auto valueRes = JSObject::getComputed_RJS(obj, runtime_, key);
+    if (LLVM_UNLIKELY(valueRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    if (LLVM_UNLIKELY(
+            writeValue(runtime_->makeHandle(*valueRes)) ==
+            ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+ExecutionStatus SerializedValue::Serializer::writeArrayBuffer(
+    Handle<JSArrayBuffer> buffer) {
+  auto transferIt =
+      transferIndex_.find(JSObject::getObjectID(*buffer, runtime_));
+  if (transferIt != transferIndex_.end()) {
+    writeTag(Tag::TransferredArrayBuffer);
+    writeRaw<uint32_t>(transferIt->second);
+    return ExecutionStatus::RETURNED;
+  }
+  if (!buffer->attached()) {
+    return runtime_->raiseTypeError(
+        "A detached ArrayBuffer could not be cloned");
+  }
+  writeTag(Tag::ArrayBuffer);
+  writeRaw<uint32_t>(buffer->size());
+  writeBytes(buffer->getDataBlock(), buffer->size());
+  return ExecutionStatus::RETURNED;
+}
+
+//===----------------------------------------------------------------------===//
+// class SerializedValue::Deserializer
+
+class SerializedValue::Deserializer {
+ public:
+  Deserializer(Runtime *runtime, SerializedValue &in)
+      : runtime_(runtime), in_(in), memory_(runtime), transferred_(runtime) {}
+
+  /// Create the ArrayBuffers that own the transferred data blocks.
+  ExecutionStatus init();
+
+  /// Read the next value from the input.
+  CallResult<HermesValue> readValue();
+
+ private:
+  Runtime *const runtime_;
+  SerializedValue &in_;
+
+  /// The position of the next byte to read.
+  size_t pos_{0};
+
+  /// Every object started so far, in order.
+  MutableHandle<ArrayStorage> memory_;
+
+  /// The ArrayBuffers holding the transferred data blocks.
+  MutableHandle<ArrayStorage> transferred_;
+
+  template <typename T>
+  T readRaw() {
+    T value;
+    readBytes(&value, sizeof(T));
+    return value;
+  }
+
+  void readBytes(void *data, size_t size) {
+    assert(pos_ + size <= in_.bytes_.size() && "Truncated SerializedValue");
+    if (size)
+      memcpy(data, in_.bytes_.data() + pos_, size);
+    pos_ += size;
+  }
+
+  /// Add \p obj to the objects that can be referenced later.
+  ExecutionStatus remember(Handle<> obj) {
+    return ArrayStorage::push_back(memory_, runtime_, obj);
+  }
+
+  /// Read the properties of \p obj.
+  ExecutionStatus readProperties(Handle<JSObject> obj);
+
+  CallResult<HermesValue> readTypedArray();
+};
+
+ExecutionStatus SerializedValue::Deserializer::init() {
+  auto memoryRes = ArrayStorage::create(runtime_, 8);
+  if (LLVM_UNLIKELY(memoryRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  memory_ = vmcast<ArrayStorage>(*memoryRes);
+  auto transferredRes =
+      ArrayStorage::create(runtime_, in_.transferred_.size());
+  if (LLVM_UNLIKELY(transferredRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  transferred_ = vmcast<ArrayStorage>(*transferredRes);
+  if (in_.transferred_.empty())
+    return ExecutionStatus::RETURNED;
+
+  if (in_.transferredTaken_) {
+    return runtime_->raiseTypeError(
+        "Transferred ArrayBuffers can only be deserialized once");
+  }
+  in_.transferredTaken_ = true;
+  GCScope gcScope(runtime_);
+  auto marker = gcScope.createMarker();
+  for (auto &block : in_.transferred_) {
+    gcScope.flushToMarker(marker);
+    auto bufferRes = JSArrayBuffer::create(
+        runtime_, Handle<JSObject>::vmcast(&runtime_->arrayBufferPrototype));
+    if (LLVM_UNLIKELY(bufferRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    auto buffer = runtime_->makeHandle<JSArrayBuffer>(*bufferRes);
+    char *data = block.first;
+    block.first = nullptr;
+    if (LLVM_UNLIKELY(
+            buffer->adoptDataBlock(runtime_, data, block.second) ==
+            ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    if (LLVM_UNLIKELY(
+            ArrayStorage::push_back(transferred_, runtime_, buffer) ==
+            ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+CallResult<HermesValue> SerializedValue::Deserializer::readValue() {
+  switch (readRaw<Tag>()) {
+    case Tag::Undefined:
+      return HermesValue::encodeUndefinedValue();
+    case Tag::Null:
+      return HermesValue::encodeNullValue();
+    case Tag::False:
+      return HermesValue::encodeBoolValue(false);
+    case Tag::True:
+      return HermesValue::encodeBoolValue(true);
+    case Tag::Number:
+      return HermesValue::encodeNumberValue(readRaw<double>());
+    case Tag::ASCIIString: {
+      uint32_t length = readRaw<uint32_t>();
+      assert(pos_ + length <= in_.bytes_.size() && "Truncated SerializedValue");
+      const char *chars =
+          reinterpret_cast<const char *>(in_.bytes_.data() + pos_);
+      pos_ += length;
+      return StringPrimitive::createEfficient(
+          runtime_, ASCIIRef(chars, length));
+    }
+    case Tag::UTF16String: {
+      uint32_t length = readRaw<uint32_t>();
+      // The characters may not be aligned, so copy them out.
+      std::u16string chars(length, u'\0');
+      readBytes(&chars[0], length * sizeof(char16_t));
+      return StringPrimitive::createEfficient(runtime_, std::move(chars));
+    }
+    case Tag::Object: {
+      auto obj = toHandle(runtime_, JSObject::create(runtime_));
+      if (LLVM_UNLIKELY(
+              remember(obj) == ExecutionStatus::EXCEPTION ||
+              readProperties(obj) == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      return obj.getHermesValue();
+    }
+    case Tag::Array: {
+      uint32_t length = readRaw<uint32_t>();
+      auto arrRes = JSArray::create(runtime_, 0, 0);
+      if (LLVM_UNLIKELY(arrRes == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      auto arr = toHandle(runtime_, std::move(*arrRes));
+      if (LLVM_UNLIKELY(
+              remember(arr) == ExecutionStatus::EXCEPTION ||
+              readProperties(arr) == ExecutionStatus::EXCEPTION ||
+              JSArray::setLengthProperty(arr, runtime_, length) ==
+                  ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      return arr.getHermesValue();
+    }
+    case Tag::Date: {
+      auto dateRes = JSDate::create(
+          runtime_,
+          readRaw<double>(),
+          Handle<JSObject>::vmcast(&runtime_->datePrototype));
+      if (LLVM_UNLIKELY(
+              dateRes == ExecutionStatus::EXCEPTION ||
+              remember(runtime_->makeHandle(*dateRes)) ==
+                  ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      return *dateRes;
+    }
+    case Tag::ArrayBuffer: {
+      uint32_t size = readRaw<uint32_t>();
+      auto bufferRes = JSArrayBuffer::create(
+          runtime_,
+          Handle<JSObject>::vmcast(&runtime_->arrayBufferPrototype));
+      if (LLVM_UNLIKELY(bufferRes == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      auto buffer = runtime_->makeHandle<JSArrayBuffer>(*bufferRes);
+      if (LLVM_UNLIKELY(
+              buffer->createDataBlock(runtime_, size, false) ==
+                  ExecutionStatus::EXCEPTION ||
+              remember(buffer) == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      readBytes(buffer->getDataBlock(), size);
+      return buffer.getHermesValue();
+    }
+    case Tag::TransferredArrayBuffer: {
+      auto buffer = runtime_->makeHandle(
+          transferred_->at(readRaw<uint32_t>()));
+      if (LLVM_UNLIKELY(remember(buffer) == ExecutionStatus::EXCEPTION)) {
+        return ExecutionStatus::EXCEPTION;
+      }
+      return buffer.getHermesValue();
+    }
+    case Tag::TypedArray:
+      return readTypedArray();
+    case Tag::BackReference:
+      return memory_->at(readRaw<uint32_t>());
+  }
+  llvm_unreachable("Invalid SerializedValue tag");
+}
+
+ExecutionStatus SerializedValue::Deserializer::readProperties(
+    Handle<JSObject> obj) {
+  uint32_t count = readRaw<uint32_t>();
+  GCScope gcScope(runtime_);
+  MutableHandle<> key{runtime_};
+  auto marker = gcScope.createMarker();
+  for (uint32_t i = 0; i < count; ++i) {
+    gcScope.flushToMarker(marker);
+    auto keyRes = readValue();
+    if (LLVM_UNLIKELY(keyRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    key = *keyRes;
+    auto valueRes = readValue();
+    if (LLVM_UNLIKELY(valueRes == ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+    if (LLVM_UNLIKELY(
+            JSObject::defineOwnComputed(
+                obj,
+                runtime_,
+                key,
+                DefinePropertyFlags::getDefaultNewPropertyFlags(),
+                runtime_->makeHandle(*valueRes)) ==
+            ExecutionStatus::EXCEPTION)) {
+      return ExecutionStatus::EXCEPTION;
+    }
+  }
+  return ExecutionStatus::RETURNED;
+}
+
+CallResult<HermesValue> SerializedValue::Deserializer::readTypedArray() {
+  auto kind = static_cast<CellKind>(readRaw<uint8_t>());
+  uint32_t byteOffset = readRaw<uint32_t>();
+  uint32_t length = readRaw<uint32_t>();
+
+  // The typed array is started before its buffer, so reserve its index.
+  uint32_t index = memory_->size();
+  if (LLVM_UNLIKELY(
+          remember(runtime_->getUndefinedValue()) ==
+          ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  auto bufferRes = readValue();
+  if (LLVM_UNLIKELY(bufferRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  auto buffer = runtime_->makeHandle<JSArrayBuffer>(*bufferRes);
+
+  CallResult<HermesValue> viewRes{ExecutionStatus::EXCEPTION};
+  uint8_t byteWidth = 0;
+  switch (kind) {
+#define TYPED_ARRAY(name, type)                                          \
+  case CellKind::name##ArrayKind:                                        \
+    viewRes =                                                            \
+        name##Array::create(runtime_, name##Array::getPrototype(runtime_)); \
+    byteWidth = sizeof(type);                                            \
+    break;
+#include "hermes/VM/TypedArrays.def"
+    default:
+      llvm_unreachable("Invalid TypedArray kind");
+  }
+  if (LLVM_UNLIKELY(viewRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  auto view = runtime_->makeHandle<JSTypedArrayBase>(*viewRes);
+  if (!buffer->attached() ||
+      byteOffset + (uint64_t)length * byteWidth > buffer->size()) {
+    return runtime_->raiseRangeError(
+        "The buffer of a cloned typed array is too small");
+  }
+  JSTypedArrayBase::setBuffer(
+      runtime_, *view, *buffer, byteOffset, length * byteWidth, byteWidth);
+  memory_->at(index).set(view.getHermesValue(), &runtime_->getHeap());
+  return view.getHermesValue();
+}
+
+//===----------------------------------------------------------------------===//
+// class SerializedValue
+
+SerializedValue::~SerializedValue() {
+  for (auto &block : transferred_)
+    free(block.first);
+}
+
+CallResult<std::unique_ptr<SerializedValue>> SerializedValue::serialize(
+    Runtime *runtime,
+    Handle<> value,
+    Handle<> transfer) {
+  GCScope gcScope(runtime);
+  auto result = std::make_unique<SerializedValue>();
+  Serializer serializer(runtime, *result);
+  if (LLVM_UNLIKELY(
+          serializer.setTransferList(transfer) == ExecutionStatus::EXCEPTION ||
+          serializer.writeValue(value) == ExecutionStatus::EXCEPTION ||
+          serializer.takeTransferredBlocks() == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  result->bytes_.shrink_to_fit();
+  return std::move(result);
+}
+
+CallResult<HermesValue> SerializedValue::deserialize(Runtime *runtime) {
+  GCScope gcScope(runtime);
+  Deserializer deserializer(runtime, *this);
+  if (LLVM_UNLIKELY(deserializer.init() == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  return deserializer.readValue();
+}
+
+size_t SerializedValue::size() const {
+  size_t result = bytes_.size();
+  for (const auto &block : transferred_)
+    result += block.second;
+  return result;
+}
+
+} // namespace vm
+} // namespace hermes
@@ -10,7 +10,6 @@
 #include "hermes/VM/GCPointer.h"
 #include "hermes/VM/Handle-inline.h"
 #include "hermes/VM/HermesValue.h"
-#include "hermes/VM/OrderedHashMap.h"
 #include "hermes/VM/Runtime.h"
 #include "hermes/VM/SlotAcceptor.h"
 #include "hermes/VM/StringPrimitive.h"
@@ -18,23 +17,26 @@
 namespace hermes {
 namespace vm {
 
-void SymbolRegistry::init(Runtime *runtime) {
-  stringMap_ = HermesValue::encodeObjectValue(
-      vmcast<OrderedHashMap>(*OrderedHashMap::create(runtime)));
-}
-
 /// Mark the Strings and Symbols in the registry as roots.
 void SymbolRegistry::markRoots(SlotAcceptor &acceptor) {
-  acceptor.accept(stringMap_);
+  for (auto &entry : keyMap_) {
+    acceptor.accept(entry.first);
+    acceptor.accept(entry.second);
+  }
 }
 
 CallResult<SymbolID> SymbolRegistry::getSymbolForKey(
     Runtime *runtime,
     Handle<StringPrimitive> key) {
-  HashMapEntry *it = OrderedHashMap::find(
-      Handle<OrderedHashMap>::vmcast(&stringMap_), runtime, key);
-  if (it) {
-    return it->value.getSymbol();
+  auto keyRes = runtime->getIdentifierTable().getSymbolHandleFromPrimitive(
+      runtime, createPseudoHandle(key.get()));
+  if (LLVM_UNLIKELY(keyRes == ExecutionStatus::EXCEPTION)) {
+    return ExecutionStatus::EXCEPTION;
+  }
+  Handle<SymbolID> keyID = *keyRes;
+  auto it = keyMap_.find(keyID.get());
+  if (it != keyMap_.end()) {
+    return it->second;
   }
 
   auto symbolRes =
@@ -42,19 +44,11 @@ CallResult<SymbolID> SymbolRegistry::getSymbolForKey(
   if (LLVM_UNLIKELY(symbolRes == ExecutionStatus::EXCEPTION)) {
     return ExecutionStatus::EXCEPTION;
   }
-  Handle<SymbolID> symbol = runtime->makeHandle(*symbolRes);
-
-  if (LLVM_UNLIKELY(
-          OrderedHashMap::insert(
-              Handle<OrderedHashMap>::vmcast(&stringMap_),
-              runtime,
-              key,
-              symbol) == ExecutionStatus::EXCEPTION)) {
-    return ExecutionStatus::EXCEPTION;
-  }
+  SymbolID symbol = *symbolRes;
 
-  registeredSymbols_.insert(symbol.get());
-  return symbol.get();
+  keyMap_[keyID.get()] = symbol;
+  registeredSymbols_.insert(symbol);
+  return symbol;
 }
 
 } // namespace vm
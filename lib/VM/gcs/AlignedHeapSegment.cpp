@@ -88,6 +88,20 @@ void AlignedHeapSegment::resetLevel() {
 template void AlignedHeapSegment::resetLevel<AdviseUnused::Yes>();
 template void AlignedHeapSegment::resetLevel<AdviseUnused::No>();
 
+void AlignedHeapSegment::markUnusedAboveLevel() {
+  // As in setLevel, debug builds keep the free memory cleared instead.
+#ifdef NDEBUG
+  const size_t PS = oscompat::page_size();
+  auto nextPageAfter = reinterpret_cast<char *>(
+      llvm::alignTo(reinterpret_cast<uintptr_t>(level_), PS));
+  auto endPage = reinterpret_cast<char *>(
+      llvm::alignTo(reinterpret_cast<uintptr_t>(end_), PS));
+  if (nextPageAfter < endPage) {
+    storage_.markUnused(nextPageAfter, endPage);
+  }
+#endif
+}
+
 void AlignedHeapSegment::setEffectiveEnd(char *effectiveEnd) {
   assert(
       start() <= effectiveEnd && effectiveEnd <= end() &&
@@ -160,24 +174,40 @@ void AlignedHeapSegment::debitExternalMemory(uint32_t size) {
 }
 
 void AlignedHeapSegment::completeMarking(GC *gc, CompleteMarkState *markState) {
-  assert(!markState->markStackOverflow_);
-
   // Return early if nothing was allocated.
   if (used() == 0) {
     return;
   }
 
+  completeMarkingInRange(gc, markState, start(), level_);
+}
+
+/* static */
+void AlignedHeapSegment::completeMarkingInRange(
+    GC *gc,
+    CompleteMarkState *markState,
+    char *low,
+    char *high) {
+  assert(!markState->markStackOverflow_);
+  assert(low <= high && "Range must not be inverted");
+
+  if (low == high) {
+    return;
+  }
+
+  assert(
+      AlignedStorage::containedInSame(low, high - 1) &&
+      "Range must be contained in one segment");
+
   CompleteMarkState::FullMSCMarkTransitiveAcceptor acceptor(*gc, markState);
 
-  MarkBitArrayNC &markBits = markBitArray();
+  MarkBitArrayNC &markBits = *markBitArrayCovering(low);
 
-  char *ptr = start();
-  size_t ind = markBits.addressToIndex(ptr);
-  assert(level_ > start() && "We return above if level_ == start()");
-  size_t indexLimit = markBits.addressToIndex(level_ - 1) + 1;
+  size_t ind = markBits.addressToIndex(low);
+  size_t indexLimit = markBits.addressToIndex(high - 1) + 1;
   for (ind = markBits.findNextMarkedBitFrom(ind); ind < indexLimit;
        ind = markBits.findNextMarkedBitFrom(ind + 1)) {
-    ptr = markBits.indexToAddress(ind);
+    char *ptr = markBits.indexToAddress(ind);
     GCCell *cell = reinterpret_cast<GCCell *>(ptr);
 
     markState->currentParPointer = cell;
@@ -195,6 +225,8 @@ void AlignedHeapSegment::completeMarking(GC *gc, CompleteMarkState *markState) {
     }
   }
 
+  markState->currentParPointer = reinterpret_cast<GCCell *>(high);
+
   assert(markState->markStack_.empty());
   assert(markState->varSizeMarkStack_.empty());
 }
@@ -272,6 +304,42 @@ void AlignedHeapSegment::sweepAndInstallForwardingPointers(
   }
 }
 
+void AlignedHeapSegment::sweepInPlace(GC *gc, SweepResult *sweepResult) {
+  MarkBitArrayNC &markBits = markBitArray();
+  char *adjacentPtr = start();
+  size_t indexLimit = markBits.addressToIndex(level() - 1) + 1;
+  for (size_t ind = markBits.findNextMarkedBitFrom(
+           markBits.addressToIndex(adjacentPtr));
+       ind < indexLimit;
+       ind = markBits.findNextMarkedBitFrom(ind + 1)) {
+    char *ptr = markBits.indexToAddress(ind);
+    GCCell *cell = reinterpret_cast<GCCell *>(ptr);
+    auto cellSize = cell->getAllocatedSize();
+
+#ifndef NDEBUG
+    assert(generation_ && "Must have an owning generation");
+    generation_->incNumReachableObjects();
+    if (auto *hiddenClass = dyn_vmcast<HiddenClass>(cell)) {
+      generation_->incNumHiddenClasses();
+      generation_->incNumLeafHiddenClasses(hiddenClass->isKnownLeaf());
+    }
+    gc->trackReachable(cell->getKind(), cellSize);
+#endif
+
+    if (ptr != adjacentPtr) {
+      new (adjacentPtr) DeadRegion(ptr - adjacentPtr);
+    }
+
+    sweepResult->displacedVtablePtrs.push_back(cell->getVT());
+    cell->setForwardingPointer(cell);
+    adjacentPtr = ptr + cellSize;
+  }
+
+  if (adjacentPtr < level_) {
+    new (adjacentPtr) DeadRegion(level_ - adjacentPtr);
+  }
+}
+
 void AlignedHeapSegment::updateReferences(
     GC *gc,
     FullMSCUpdateAcceptor *acceptor,
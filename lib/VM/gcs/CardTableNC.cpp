@@ -8,6 +8,8 @@
 
 #include "hermes/VM/CardTableNC.h"
 
+#include "llvm/Support/MathExtras.h"
+
 #include <string.h>
 #include <algorithm>
 #include <cassert>
@@ -32,6 +34,43 @@ OptValue<size_t> CardTable::findNextCardWithStatus(
       : OptValue<size_t>(reinterpret_cast<const CardStatus *>(card) - cards_);
 }
 
+OptValue<size_t> CardTable::findNextDirtyCardSummarized(
+    size_t fromIndex,
+    size_t endIndex) const {
+  size_t index = fromIndex;
+  while (index < endIndex) {
+    size_t bit = index / kCardsPerSummaryBit;
+    uint64_t bits = summary_[bit / 64] >> (bit % 64);
+    if (bits == 0) {
+      // Every card up to the next summary word is clean.
+      index = (bit / 64 + 1) * 64 * kCardsPerSummaryBit;
+      continue;
+    }
+    if (size_t skip = llvm::countTrailingZeros(bits)) {
+      bit += skip;
+      index = bit * kCardsPerSummaryBit;
+    }
+    // The cards of this summary bit may be dirty: scan them a word at a time,
+    // since a clean word is zero.
+    size_t bitEnd = std::min((bit + 1) * kCardsPerSummaryBit, endIndex);
+    while (index < bitEnd) {
+      if (index % kCardsPerWord == 0 && index + kCardsPerWord <= bitEnd) {
+        uint64_t word;
+        memcpy(&word, &cards_[index], sizeof(word));
+        if (word == 0) {
+          index += kCardsPerWord;
+          continue;
+        }
+      }
+      if (cards_[index] == CardStatus::Dirty) {
+        return index;
+      }
+      ++index;
+    }
+  }
+  return OptValue<size_t>();
+}
+
 void CardTable::clear() {
   cleanRange(0, kValidIndices - 1);
 }
@@ -68,8 +107,21 @@ void CardTable::cleanOrDirtyRange(
     size_t from,
     size_t to,
     CardStatus cleanOrDirty) {
-  for (size_t index = from; index <= to; index++) {
-    cards_[index] = cleanOrDirty;
+  static_assert(
+      static_cast<char>(CardStatus::Clean) == 0,
+      "A word of clean cards must be zero");
+  memset(&cards_[from], static_cast<char>(cleanOrDirty), to - from + 1);
+  if (cleanOrDirty == CardStatus::Dirty) {
+    setSummaryBits(from, to);
+    return;
+  }
+  // Only clear the summary bits whose cards are all cleaned; the last bit may
+  // cover fewer cards than the others.
+  size_t firstBit = (from + kCardsPerSummaryBit - 1) / kCardsPerSummaryBit;
+  size_t endBit = to + 1 == kValidIndices ? kSummaryBits
+                                          : (to + 1) / kCardsPerSummaryBit;
+  for (size_t bit = firstBit; bit < endBit; ++bit) {
+    summary_[bit / 64] &= ~(uint64_t(1) << (bit % 64));
   }
 }
 
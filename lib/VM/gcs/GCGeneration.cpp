@@ -48,6 +48,10 @@ uint64_t GCGeneration::extSizeFromFinalizerList() const {
   return extSize;
 }
 
+void GCGeneration::markUnusedAboveLevel() {
+  activeSegment().markUnusedAboveLevel();
+}
+
 #ifdef HERMES_SLOW_DEBUG
 void GCGeneration::checkFinalizableObjectsListWellFormed() const {
   for (GCCell *cell : cellsWithFinalizers()) {
@@ -176,6 +176,7 @@ void GenGC::finalizeAll() {
   resetNumFinalizedObjectsInGens();
   youngGen_.finalizeUnreachableObjects(this, &markBits_);
   oldGen_.finalizeUnreachableObjects(this, &markBits_);
+  runDeferredFinalizers();
 }
 
 void GenGC::collect() {
@@ -292,6 +293,7 @@ void GenGC::collect() {
 
     checkTripwire(usedAfter, steady_clock::now());
   }
+  runDeferredFinalizers();
 }
 
 unsigned GenGC::recordStats(const std::vector<SweepResult> &sweepResults) {
@@ -947,6 +949,7 @@ void GenGC::getHeapInfo(HeapInfo &info) {
   info.heapSize = size();
   info.totalAllocatedBytes = totalAllocatedBytes_ + bytesAllocatedSinceLastGC();
   info.va = maxSize();
+  info.vaSpan = maxSize();
 }
 
 void GenGC::getHeapInfoWithMallocSize(HeapInfo &info) {
@@ -23,6 +23,7 @@
 #include "hermes/VM/GCPointer-inline.h"
 #include "hermes/VM/HeapSnapshot.h"
 #include "hermes/VM/HermesValue-inline.h"
+#include "hermes/VM/ParallelMarkStateNC.h"
 #include "hermes/VM/SnapshotAcceptor.h"
 #include "hermes/VM/SnapshotEdgeAcceptor.h"
 #include "hermes/VM/SnapshotNodeAcceptor.h"
@@ -43,6 +44,8 @@
 #include <cinttypes>
 #include <clocale>
 #include <cstdint>
+#include <limits>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
 #include <utility>
@@ -98,11 +101,19 @@ GenGC::GenGC(
       oldGen_(
           this,
           generationSizes_.oldGenSize(),
-          gcConfig.getShouldReleaseUnused()),
+          gcConfig.getShouldReleaseUnused(),
+          gcConfig.getUnusedSegmentRetention()),
       allocContextFromYG_(gcConfig.getAllocInYoung()),
       revertToYGAtTTI_(gcConfig.getRevertToYGAtTTI()),
       oomThreshold_(gcConfig.getEffectiveOOMThreshold()),
-      weightedUsed_(static_cast<double>(gcConfig.getInitHeapSize())) {
+      weightedUsed_(static_cast<double>(gcConfig.getInitHeapSize())),
+      incrementalMarking_(gcConfig.getIncrementalMarking()),
+      numGCThreads_(std::max(1u, gcConfig.getNumGCThreads())),
+      largeObjectThreshold_(
+          gcConfig.getLargeObjectThreshold()
+              ? gcConfig.getLargeObjectThreshold()
+              : std::numeric_limits<uint32_t>::max()),
+      heapVerificationInterval_(gcConfig.getHeapVerificationInterval()) {
   growTo(gcConfig.getInitHeapSize());
   claimAllocContext();
 }
@@ -197,6 +208,7 @@ void GenGC::finalizeAll() {
   // Must clear the mark bits, so all objects are considered unreachable.
   clearMarkBits();
   finalizeUnreachableObjects();
+  runDeferredFinalizers();
 }
 
 namespace {
@@ -257,6 +269,34 @@ gcheapsize_t GenGC::usedToDesiredSize(size_t usedBytes) {
   return static_cast<gcheapsize_t>(desiredSize);
 }
 
+void GenGC::runtimeWillInitialize() {
+  if (!allocContextFromYG_) {
+    return;
+  }
+  yieldAllocContext();
+  allocContextFromYG_ = false;
+  claimAllocContext();
+  revertToYGAfterInit_ = true;
+}
+
+void GenGC::runtimeInitialized() {
+  if (!revertToYGAfterInit_) {
+    return;
+  }
+  revertToYGAfterInit_ = false;
+  if (allocContextFromYG_) {
+    // A full collection has already reverted to YG allocation.
+    return;
+  }
+  // As in ttiReached(): yield the allocation context, so the heap is
+  // well-formed, and recreate the card object boundaries that direct OG
+  // allocation did not maintain.
+  yieldAllocContext();
+  oldGen_.recreateCardTableBoundaries();
+  allocContextFromYG_ = true;
+  claimAllocContext();
+}
+
 void GenGC::ttiReached() {
   // If we started allocating in the OG, switch back to allocating in the YG.
   if (!allocContextFromYG_ && revertToYGAtTTI_) {
@@ -272,6 +312,13 @@ void GenGC::ttiReached() {
 }
 
 void GenGC::collect(bool canEffectiveOOM) {
+  if (oldGenMarkingActive_) {
+    abandonOldGenMarking();
+  }
+  fullCollect(canEffectiveOOM, canEffectiveOOM ? "allocation" : "explicit");
+}
+
+void GenGC::fullCollect(bool canEffectiveOOM, const char *cause) {
   if (canEffectiveOOM && ++consecFullGCs_ >= oomThreshold_)
     oom(make_error_code(OOMError::Effective));
 
@@ -282,6 +329,10 @@ void GenGC::collect(bool canEffectiveOOM) {
   // Make sure the AllocContext been yielded back to its owner.
   assert(!allocContext_.activeSegment);
 
+  // The young-gen cells sampled for allocation sites are about to be moved,
+  // and their sites may be freed with their code by the finalizers.
+  youngGen_.dropAllocationSiteSamples();
+
   const size_t usedBefore = used();
   const size_t sizeBefore = size();
   cumPreBytes_ += used();
@@ -302,12 +353,16 @@ void GenGC::collect(bool canEffectiveOOM) {
              << ") garbage collection # " << numGCs() << "\n");
 
   {
-    CollectionSection fullCollection(this, "Full collection");
+    CollectionSection fullCollection(this, "Full collection", "full", cause);
 
     fullCollection.addArg("fullGCUsedBefore", usedBefore);
     fullCollection.addArg("fullGCSizeBefore", sizeBefore);
 
-    markPhase();
+    if (oldGenMarkingActive_) {
+      finishOldGenMarking();
+    } else {
+      markPhase();
+    }
 
     finalizeUnreachableObjects();
 
@@ -341,6 +396,7 @@ void GenGC::collect(bool canEffectiveOOM) {
     updateWeightedUsed();
 
     updateHeapSize();
+    oldGen_.releaseIdleSegments(steady_clock::now());
 
     // In case we started in direct OG allocation, we want to revert to YG alloc
     // if we reach a full collection.  (Usually, a TTI call will have already
@@ -366,6 +422,7 @@ void GenGC::collect(bool canEffectiveOOM) {
     checkInvariants(numAllocatedObjectsBefore, usedBefore);
   }
 
+  runDeferredFinalizersAfterCollection();
   checkTripwire(usedAfter, steady_clock::now());
 #ifdef HERMESVM_SIZE_DIAGNOSTIC
   sizeDiagnosticCensus();
@@ -531,13 +588,17 @@ void GenGC::markPhase() {
   auto completeMarkingStart = steady_clock::now();
   {
     PerfSection fullGCCompleteMarkingSystraceRegion("fullGCCompleteMarking");
-    completeMarking();
+    if (numGCThreads_ > 1) {
+      completeMarkingParallel();
+    } else {
+      completeMarking();
+    }
   }
   auto completeMarkingEnd = steady_clock::now();
   markRootsSecs_ +=
-      GCBase::clockDiffSeconds(markRootsStart, completeMarkingStart);
-  markTransitiveSecs_ +=
-      GCBase::clockDiffSeconds(completeMarkingStart, completeMarkingEnd);
+      recordCyclePhase("markRoots", markRootsStart, completeMarkingStart);
+  markTransitiveSecs_ += recordCyclePhase(
+      "markTransitive", completeMarkingStart, completeMarkingEnd);
 }
 
 void GenGC::clearMarkBits() {
@@ -562,6 +623,370 @@ void GenGC::completeMarking() {
   } while (markState_.markStackOverflow_);
 }
 
+template <typename F>
+void GenGC::runOnGCThreads(F work) {
+  std::vector<std::thread> threads;
+  for (unsigned i = 1; i < numGCThreads_; ++i) {
+    threads.emplace_back(work);
+  }
+  work();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+void GenGC::completeMarkingParallel() {
+  ParallelMarkState parallelMarkState(
+      this, numGCThreads_, markedSymbols_.size());
+  // Marking the roots has set the mark bits of the cells they reference
+  // directly; these are where the threads start from.
+  for (auto *segment : segmentIndex_) {
+    MarkBitArrayNC &markBits = segment->markBitArray();
+    const size_t indexLimit = markBits.addressToIndex(segment->level());
+    for (size_t ind = markBits.findNextMarkedBitFrom(
+             markBits.addressToIndex(segment->start()));
+         ind < indexLimit;
+         ind = markBits.findNextMarkedBitFrom(ind + 1)) {
+      parallelMarkState.addGrey(
+          reinterpret_cast<GCCell *>(markBits.indexToAddress(ind)));
+    }
+  }
+  parallelMarkState.run();
+  parallelMarkState.finish();
+}
+
+constexpr double GenGC::kOldGenMarkingStartOccupancy;
+constexpr double GenGC::kOldGenMarkingHeadroomFraction;
+constexpr size_t GenGC::kMinOldGenMarkSlice;
+constexpr double GenGC::kIdleYoungGenCollectOccupancy;
+constexpr size_t GenGC::kMaxIdleDeferredFinalizers;
+
+void GenGC::didYoungGenCollection() {
+  runDeferredFinalizersAfterCollection();
+  oldGen_.releaseIdleSegments(steady_clock::now());
+
+  if (!incrementalMarking_) {
+    return;
+  }
+
+  if (!oldGenMarkingActive_) {
+    const size_t used = oldGen_.used();
+    if (used > 0 && used >= oldGen_.size() * kOldGenMarkingStartOccupancy) {
+      startOldGenMarking();
+    }
+    return;
+  }
+
+  // Pace the marking slices so that the cycle completes by the time the
+  // promotions since its start have used up its headroom: each slice visits
+  // the share of the cycle's bytes that corresponds to the share of the
+  // headroom used since the previous slice.
+  const size_t usedNow = oldGen_.used();
+  const size_t promoted = usedNow > oldGenUsedAtLastMarkSlice_
+      ? usedNow - oldGenUsedAtLastMarkSlice_
+      : 0;
+  oldGenUsedAtLastMarkSlice_ = usedNow;
+  size_t budget = kMinOldGenMarkSlice;
+  if (oldGenMarkHeadroom_ > 0) {
+    budget += static_cast<size_t>(
+        static_cast<double>(oldGenMarkBytes_) * promoted / oldGenMarkHeadroom_);
+  } else {
+    budget = oldGenMarkBytes_;
+  }
+
+  if (advanceOldGenMarking(budget)) {
+    fullCollect(/* canEffectiveOOM */ false, "marking complete");
+  }
+}
+
+void GenGC::startOldGenMarking() {
+  assert(!oldGenMarkingActive_ && "Marking is already in progress");
+  assert(youngGen_.usedDirect() == 0 && "Young gen must have been evacuated");
+
+  GCCycle cycle(this);
+  PerfSection oldGenMarkingStartSystraceRegion("oldGenMarkingStart");
+  auto startTime = steady_clock::now();
+
+  clearMarkBits();
+  markedSymbols_.clear();
+  markedSymbols_.resize(gcCallbacks_->getSymbolsEnd(), false);
+
+  oldGenMarkRegions_.clear();
+  oldGenMarkBytes_ = 0;
+  for (auto *segment : segmentIndex_) {
+    if (youngGen_.contains(segment->start())) {
+      continue;
+    }
+    oldGenMarkRegions_.push_back({segment->start(), segment->level()});
+    oldGenMarkBytes_ += segment->used();
+  }
+  oldGenMarkRegionIdx_ = 0;
+  oldGenMarkNext_ =
+      oldGenMarkRegions_.empty() ? nullptr : oldGenMarkRegions_[0].start;
+
+  const size_t usedNow = oldGen_.used();
+  oldGenUsedAtLastMarkSlice_ = usedNow;
+  oldGenMarkHeadroom_ = usedNow < oldGen_.size()
+      ? static_cast<size_t>(
+            (oldGen_.size() - usedNow) * kOldGenMarkingHeadroomFraction)
+      : 0;
+
+  // With the finger at the bottom of the heap, marking from the roots only
+  // sets mark bits; the slices will visit the marked objects.
+  markState_.markStackOverflow_ = false;
+  markState_.markingVarSizeCell = false;
+  markState_.numPtrsPushedByParent = 0;
+  markState_.currentParPointer = nullptr;
+  {
+    CompleteMarkState::FullMSCMarkTransitiveAcceptor acceptor(
+        *this, &markState_);
+    DroppingAcceptor<CompleteMarkState::FullMSCMarkTransitiveAcceptor>
+        nameAcceptor{acceptor};
+    markRoots(nameAcceptor, /*markLongLived*/ true);
+  }
+
+  oldGenMarkingActive_ = true;
+  incrementalMarkSecs_ +=
+      GCBase::clockDiffSeconds(startTime, steady_clock::now());
+}
+
+bool GenGC::advanceOldGenMarking(size_t budget) {
+  assert(oldGenMarkingActive_ && "No marking in progress");
+
+  GCCycle cycle(this);
+  PerfSection oldGenMarkingSliceSystraceRegion("oldGenMarkingSlice");
+  auto startTime = steady_clock::now();
+
+  // Symbols may have been allocated since the last slice.
+  markedSymbols_.resize(gcCallbacks_->getSymbolsEnd(), false);
+
+  CompleteMarkState::FullMSCMarkTransitiveAcceptor acceptor(*this, &markState_);
+  for (;;) {
+    // Grey objects pushed by the write barrier since the last slice.
+    if (!markState_.markStackOverflow_) {
+      markState_.drainMarkStack(this, acceptor);
+    }
+    // If the mark stack overflowed, either in the write barrier or whilst
+    // marking, some marked objects may not have been visited; restart from
+    // the bottom of the heap, as completeMarking() does.
+    if (LLVM_UNLIKELY(markState_.markStackOverflow_)) {
+      markState_.markStack_.clear();
+      markState_.varSizeMarkStack_.clear();
+      markState_.markStackOverflow_ = false;
+      oldGenMarkRegionIdx_ = 0;
+      oldGenMarkNext_ = oldGenMarkRegions_[0].start;
+      markState_.currentParPointer = nullptr;
+    }
+    if (oldGenMarkRegionIdx_ == oldGenMarkRegions_.size() || budget == 0) {
+      break;
+    }
+
+    const OldGenMarkRegion &region = oldGenMarkRegions_[oldGenMarkRegionIdx_];
+    char *high = region.markStart;
+    if (static_cast<size_t>(high - oldGenMarkNext_) > budget) {
+      high = oldGenMarkNext_ + budget;
+    }
+    budget -= high - oldGenMarkNext_;
+    AlignedHeapSegment::completeMarkingInRange(
+        this, &markState_, oldGenMarkNext_, high);
+    oldGenMarkNext_ = high;
+    if (high == region.markStart &&
+        ++oldGenMarkRegionIdx_ < oldGenMarkRegions_.size()) {
+      oldGenMarkNext_ = oldGenMarkRegions_[oldGenMarkRegionIdx_].start;
+      markState_.currentParPointer =
+          reinterpret_cast<GCCell *>(oldGenMarkNext_);
+    }
+  }
+
+  const bool done = oldGenMarkRegionIdx_ == oldGenMarkRegions_.size();
+  if (done) {
+    // Every object that existed at the start of the cycle is now below the
+    // finger, so anything marked from now on must be pushed.
+    markState_.currentParPointer =
+        reinterpret_cast<GCCell *>(std::numeric_limits<uintptr_t>::max());
+  }
+  // The write barrier marks outside of any object being scanned.
+  markState_.markingVarSizeCell = false;
+  markState_.numPtrsPushedByParent = 0;
+
+  incrementalMarkSecs_ +=
+      GCBase::clockDiffSeconds(startTime, steady_clock::now());
+  return done;
+}
+
+char *GenGC::oldGenMarkStartFor(char *start) const {
+  auto it = std::lower_bound(
+      oldGenMarkRegions_.begin(),
+      oldGenMarkRegions_.end(),
+      start,
+      [](const OldGenMarkRegion &region, char *start) {
+        return region.start < start;
+      });
+  if (it == oldGenMarkRegions_.end() || it->start != start) {
+    // The segment was added to the old generation during the cycle.
+    return start;
+  }
+  return it->markStart;
+}
+
+void GenGC::finishOldGenMarking() {
+  assert(oldGenMarkingActive_ && "No marking in progress");
+  assert(youngGen_.usedDirect() == 0 && "Young gen must have been evacuated");
+
+  auto markRootsStart = steady_clock::now();
+
+  // Symbols stored into the heap during the cycle were marked by the write
+  // barrier, and those only referenced from cells allocated during the cycle
+  // or from the roots are marked below, so unmarked symbols are unreachable.
+  // Stores of weak references have no barrier, so the cycle cannot tell
+  // whether those allocated before the remark are still in use.
+  // Conservatively keep all of them; they are reclaimed by the next full
+  // collection that marks from scratch.
+  markedSymbols_.resize(gcCallbacks_->getSymbolsEnd(), false);
+  for (auto &slot : weakSlots_) {
+    if (slot.extra == WeakSlotState::Unmarked) {
+      slot.extra = WeakSlotState::Marked;
+    }
+  }
+
+  // Young-gen mark bits may have been set by the slices, for objects that
+  // have since been evacuated.
+  for (auto *segment : segmentIndex_) {
+    if (youngGen_.contains(segment->start())) {
+      segment->markBitArray().clear();
+    }
+  }
+
+  CompleteMarkState::FullMSCMarkTransitiveAcceptor acceptor(*this, &markState_);
+  if (markState_.markStackOverflow_) {
+    // The write barrier overflowed the mark stack after the last slice; fall
+    // back to marking from every marked object below.
+    markState_.markStack_.clear();
+    markState_.varSizeMarkStack_.clear();
+  }
+  {
+    PerfSection fullGCMarkRootsSystraceRegion("fullGCMarkRoots");
+    // Everything allocated in the old gen since the start of the cycle is
+    // treated as live, and visited here.
+    oldGen_.forUsedSegments([this, &acceptor](AlignedHeapSegment &segment) {
+      segment.forObjsInRange(
+          [this, &acceptor](GCCell *cell) {
+            // The cell may already be marked, without having been visited.
+            AlignedHeapSegment::setCellMarkBit(cell);
+            if (cell->isVariableSize()) {
+              markState_.varSizeMarkStack_.push_back(cell);
+            } else {
+              markState_.markStack_.push_back(cell);
+            }
+            if (!markState_.markStackOverflow_) {
+              markState_.drainMarkStack(this, acceptor);
+            }
+            if (markState_.markStackOverflow_) {
+              markState_.markStack_.clear();
+              markState_.varSizeMarkStack_.clear();
+            }
+          },
+          oldGenMarkStartFor(segment.start()),
+          segment.level());
+    });
+
+    DroppingAcceptor<CompleteMarkState::FullMSCMarkTransitiveAcceptor>
+        nameAcceptor{acceptor};
+    markRoots(nameAcceptor, /*markLongLived*/ true);
+  }
+
+  auto completeMarkingStart = steady_clock::now();
+  {
+    PerfSection fullGCCompleteMarkingSystraceRegion("fullGCCompleteMarking");
+    if (!markState_.markStackOverflow_) {
+      markState_.drainMarkStack(this, acceptor);
+    }
+    if (markState_.markStackOverflow_) {
+      markState_.markStack_.clear();
+      markState_.varSizeMarkStack_.clear();
+      completeMarking();
+    }
+  }
+  auto completeMarkingEnd = steady_clock::now();
+  markRootsSecs_ +=
+      recordCyclePhase("markRoots", markRootsStart, completeMarkingStart);
+  markTransitiveSecs_ += recordCyclePhase(
+      "markTransitive", completeMarkingStart, completeMarkingEnd);
+
+  oldGenMarkingActive_ = false;
+  oldGenMarkRegions_.clear();
+  ++numIncrementalFullGCs_;
+}
+
+void GenGC::abandonOldGenMarking() {
+  markState_.markStack_.clear();
+  markState_.varSizeMarkStack_.clear();
+  markState_.markStackOverflow_ = false;
+  oldGenMarkingActive_ = false;
+  oldGenMarkRegions_.clear();
+}
+
+bool GenGC::collectIncrementally(steady_clock::time_point deadline) {
+  collectsIncrementally_ = true;
+  // Release what earlier collections finalized before doing more of them.
+  if (runDeferredFinalizers(deadline)) {
+    return true;
+  }
+  oldGen_.releaseIdleSegments(steady_clock::now());
+
+  if (!oldGenMarkingActive_) {
+    // This may start a marking cycle, which is left for later calls.
+    if (youngGen_.used() >= youngGen_.size() * kIdleYoungGenCollectOccupancy &&
+        steady_clock::now() < deadline) {
+      idleYoungGenCollect();
+    }
+    return oldGenMarkingActive_ || !deferredFinalizers_.empty();
+  }
+
+  bool done = false;
+  while (!done && steady_clock::now() < deadline) {
+    done = advanceOldGenMarking(kMinOldGenMarkSlice);
+  }
+  if (done) {
+    // The rest of the cycle is a full collection pause, after the young-gen
+    // collection that begins it.  Only take it if a typical one fits.
+    const double secsLeft =
+        GCBase::clockDiffSeconds(steady_clock::now(), deadline);
+    if (secsLeft >= fullCollectionCumStats_.gcWallTime.average()) {
+      idleYoungGenCollect();
+    }
+  }
+  return oldGenMarkingActive_ || !deferredFinalizers_.empty();
+}
+
+bool GenGC::idleYoungGenCollect() {
+  AllocContextYieldThenClaim yielder(this);
+  if (!oldGen_.ensureFits(youngGen_.usedDirect())) {
+    return false;
+  }
+  youngGen_.collect("idle");
+  didYoungGenCollection();
+  return true;
+}
+
+void GenGC::handleMemoryPressure(MemoryPressure pressure) {
+  if (pressure == MemoryPressure::Critical) {
+    collect();
+  }
+  runDeferredFinalizers();
+  AllocContextYieldThenClaim yielder(this);
+  oldGen_.releaseCachedSegments(steady_clock::time_point::max());
+  youngGen_.markUnusedAboveLevel();
+  oldGen_.markUnusedAboveLevel();
+}
+
+void GenGC::runDeferredFinalizersAfterCollection() {
+  if (!collectsIncrementally_ ||
+      deferredFinalizers_.size() > kMaxIdleDeferredFinalizers) {
+    runDeferredFinalizers();
+  }
+}
+
 void GenGC::finalizeUnreachableObjects() {
   youngGen_.finalizeUnreachableObjects();
   oldGen_.finalizeUnreachableObjects();
@@ -575,7 +1000,7 @@ void GenGC::sweepAndInstallForwardingPointers(SweepResult *sweepResult) {
   oldGen_.sweepAndInstallForwardingPointers(this, sweepResult);
   youngGen_.sweepAndInstallForwardingPointers(this, sweepResult);
 
-  sweepSecs_ += GCBase::clockDiffSeconds(sweepStart, steady_clock::now());
+  sweepSecs_ += recordCyclePhase("sweep", sweepStart, steady_clock::now());
 }
 
 void GenGC::updateReferences(const SweepResult &sweepResult) {
@@ -591,19 +1016,60 @@ void GenGC::updateReferences(const SweepResult &sweepResult) {
   DroppingAcceptor<SlotAcceptor> nameWeakAcceptor{weakAcceptor};
   markWeakRoots(nameWeakAcceptor);
 
-  SweepResult::VTablesRemaining vTables(
-      sweepResult.displacedVtablePtrs.begin(),
-      sweepResult.displacedVtablePtrs.end());
-
-  // We swept the old gen into itself before sweeping the young gen.  We must
-  // preserve this order here, to match up cells with their displaced VTable
-  // pointers.
-  oldGen_.updateReferences(this, vTables);
-  youngGen_.updateReferences(this, vTables);
+  if (numGCThreads_ > 1) {
+    updateHeapReferencesParallel(sweepResult);
+  } else {
+    SweepResult::VTablesRemaining vTables(
+        sweepResult.displacedVtablePtrs.begin(),
+        sweepResult.displacedVtablePtrs.end());
+
+    // We swept the old gen into itself before sweeping the young gen.  We must
+    // preserve this order here, to match up cells with their displaced VTable
+    // pointers.
+    oldGen_.updateReferences(this, vTables);
+    youngGen_.updateReferences(this, vTables);
+  }
 
   updateWeakReferences(/*fullGC*/ true);
-  updateReferencesSecs_ +=
-      GCBase::clockDiffSeconds(updateRefsStart, steady_clock::now());
+  updateReferencesSecs_ += recordCyclePhase(
+      "updateReferences", updateRefsStart, steady_clock::now());
+}
+
+void GenGC::updateHeapReferencesParallel(const SweepResult &sweepResult) {
+  const auto &vtables = sweepResult.displacedVtablePtrs;
+
+  // The segments, in the order they were swept, with the index of the first of
+  // their displaced VTable pointers.  There is one for each marked cell.
+  std::vector<std::pair<AlignedHeapSegment *, size_t>> segments;
+  size_t numVTables = 0;
+  auto addSegment = [&segments, &numVTables](AlignedHeapSegment &segment) {
+    segments.emplace_back(&segment, numVTables);
+    numVTables += segment.markBitArray().countMarkedBits();
+  };
+  oldGen_.forUsedSegments(addSegment);
+  youngGen_.forUsedSegments(addSegment);
+  assert(
+      numVTables == vtables.size() &&
+      "Every marked cell should have a displaced VTable pointer");
+  segments.emplace_back(nullptr, numVTables);
+
+  oldGen_.updateFinalizableCellListReferences();
+  youngGen_.updateFinalizableCellListReferences();
+
+  // Updating a cell only writes to its own fields, and reads the forwarding
+  // pointers of the cells it references, which do not change in this phase.
+  std::atomic<size_t> nextSegment{0};
+  runOnGCThreads([this, &segments, &vtables, &nextSegment]() {
+    auto acceptor = getFullMSCUpdateAcceptor(*this);
+    for (size_t i = nextSegment++; i + 1 < segments.size();
+         i = nextSegment++) {
+      SweepResult::VTablesRemaining vTables(
+          vtables.begin() + segments[i].second,
+          vtables.begin() + segments[i + 1].second);
+      segments[i].first->updateReferences(this, acceptor.get(), vTables);
+      assert(!vTables.hasNext() && "Cells left without a VTable pointer");
+    }
+  });
 }
 
 void GenGC::compact(const SweepResult &sweepResult) {
@@ -649,7 +1115,8 @@ void GenGC::compact(const SweepResult &sweepResult) {
   oldGen_.updateEffectiveEndForExternalMemory();
   youngGen_.updateEffectiveEndForExternalMemory();
 
-  compactSecs_ += GCBase::clockDiffSeconds(compactStart, steady_clock::now());
+  compactSecs_ +=
+      recordCyclePhase("compact", compactStart, steady_clock::now());
 }
 
 void GenGC::markSymbol(SymbolID symbolID) {
@@ -669,6 +1136,15 @@ void GenGC::markSymbol(SymbolID symbolID) {
 #endif
 }
 
+void GenGC::oldGenMarkingSymbolBarrier(SymbolID symbol) {
+  assert(oldGenMarkingActive_ && "No marking in progress");
+  // Symbols may have been allocated since the last slice.
+  if (symbol.isValid() && symbol.unsafeGetIndex() >= markedSymbols_.size()) {
+    markedSymbols_.resize(gcCallbacks_->getSymbolsEnd(), false);
+  }
+  markSymbol(symbol);
+}
+
 void GenGC::markWeakRef(const WeakRefBase &wr) {
   assert(
       wr.slot_->extra <= WeakSlotState::Marked &&
@@ -676,6 +1152,99 @@ void GenGC::markWeakRef(const WeakRefBase &wr) {
   wr.slot_->extra = WeakSlotState::Marked;
 }
 
+namespace {
+
+/// \return true if \p cell has a valid VTable and fits below \p level.
+bool isWellFormedCell(const GCCell *cell, const char *level) {
+  const VTable *vt = cell->getVT();
+  // Don't follow a pointer which can't be a VTable.
+  if (!vt || reinterpret_cast<uintptr_t>(vt) % alignof(VTable) != 0 ||
+      !vt->isValid()) {
+    return false;
+  }
+  uint32_t size = cell->getAllocatedSize();
+  return size >= sizeof(GCCell) && size % HeapAlign == 0 &&
+      size <= static_cast<size_t>(level - reinterpret_cast<const char *>(cell));
+}
+
+/// Records the first slot of the cells it is given which doesn't point to a
+/// well formed cell in the used part of one of the segments of \p index.
+struct VerifyPointersAcceptor final : public SlotAcceptorDefault {
+  static constexpr bool shouldMarkWeak = false;
+
+  using SlotAcceptorDefault::accept;
+
+  VerifyPointersAcceptor(GC &gc, const GCSegmentAddressIndex &index)
+      : SlotAcceptorDefault(gc), index(index) {}
+
+  const GCSegmentAddressIndex &index;
+
+  /// The first bad pointer, or nullptr.
+  const void *badPointer{nullptr};
+
+  void accept(void *&ptr) override {
+    if (!ptr || badPointer)
+      return;
+    const AlignedHeapSegment *segment = index.segmentCovering(ptr);
+    const char *p = static_cast<const char *>(ptr);
+    if (!segment || p < segment->start() || p >= segment->level() ||
+        reinterpret_cast<uintptr_t>(p) % HeapAlign != 0 ||
+        !isWellFormedCell(static_cast<const GCCell *>(ptr), segment->level()))
+      badPointer = ptr;
+  }
+
+  void accept(HermesValue &hv) override {
+    if (hv.isPointer()) {
+      void *ptr = hv.getPointer();
+      accept(ptr);
+    }
+  }
+};
+
+} // namespace
+
+void GenGC::verifyRandomSegment() {
+  std::vector<const AlignedHeapSegment *> segments;
+  auto addSegment = [&segments](const AlignedHeapSegment &segment) {
+    if (segment.level() != segment.start())
+      segments.push_back(&segment);
+  };
+  youngGen_.forUsedSegments(addSegment);
+  oldGen_.forUsedSegments(addSegment);
+  if (segments.empty())
+    return;
+  const AlignedHeapSegment *segment = segments[std::uniform_int_distribution<
+      size_t>(0, segments.size() - 1)(verificationRandom_)];
+
+  auto fail = [segment](const GCCell *cell, const std::string &problem) {
+    hermes_fatal(
+        std::string("Heap verification failed: cell at offset ") +
+        std::to_string(
+            reinterpret_cast<const char *>(cell) - segment->start()) +
+        " of segment " +
+        std::to_string(reinterpret_cast<uintptr_t>(segment->lowLim())) + " " +
+        problem);
+  };
+
+  VerifyPointersAcceptor acceptor(*this, segmentIndex_);
+  char *level = segment->level();
+  for (char *ptr = segment->start(); ptr < level;) {
+    auto *cell = reinterpret_cast<GCCell *>(ptr);
+    if (!isWellFormedCell(cell, level))
+      fail(cell, "is not a valid cell");
+    GCBase::markCell(cell, this, acceptor);
+    if (acceptor.badPointer) {
+      fail(
+          cell,
+          std::string("of kind ") + cellKindStr(cell->getKind()) +
+              " points to invalid cell " +
+              std::to_string(
+                  reinterpret_cast<uintptr_t>(acceptor.badPointer)));
+    }
+    ptr += cell->getAllocatedSize();
+  }
+}
+
 #ifdef HERMES_SLOW_DEBUG
 void GenGC::checkWellFormedHeap() const {
   segmentIndex_.checkConsistency();
@@ -915,7 +1484,7 @@ void GenGC::forAllObjs(const std::function<void(GCCell *)> &callback) {
 #ifndef NDEBUG
 void GenGC::youngGenCollect() {
   AllocContextYieldThenClaim yielder(this);
-  youngGen_.collect();
+  youngGen_.collect("explicit");
 }
 
 unsigned GenGC::computeNumAllocatedObjects() const {
@@ -956,6 +1525,8 @@ void GenGC::setNumAllocatedObjectsAfterFullCollectionNC(
   for (auto &chunk : compactionResult.usedChunks()) {
     chunk.recordNumAllocated();
   }
+  // The live large objects were not compacted into any chunk.
+  oldGen_.incNumAllocatedObjects(oldGen_.numLargeObjects());
 }
 
 void GenGC::trackAlloc(CellKind kind, unsigned sz) {
@@ -981,6 +1552,9 @@ LLVM_ATTRIBUTE_NOINLINE
 void GenGC::writeBarrier(void *loc, HermesValue value) {
   countWriteBarrier(/*hv*/ true, kNumWriteBarrierTotalCountIdx);
   if (!value.isPointer()) {
+    if (LLVM_UNLIKELY(oldGenMarkingActive_) && value.isSymbol()) {
+      oldGenMarkingSymbolBarrier(value.getSymbol());
+    }
     return;
   }
   countWriteBarrier(/*hv*/ true, kNumWriteBarrierOfObjectPtrIdx);
@@ -996,6 +1570,16 @@ void GenGC::writeBarrier(void *loc, void *value) {
 void GenGC::writeBarrierRange(HermesValue *start, uint32_t numHVs) {
   countRangeWriteBarrier();
 
+  if (LLVM_UNLIKELY(oldGenMarkingActive_)) {
+    for (uint32_t i = 0; i < numHVs; ++i) {
+      if (start[i].isPointer()) {
+        oldGenMarkingBarrier(start[i].getPointer());
+      } else if (start[i].isSymbol()) {
+        oldGenMarkingSymbolBarrier(start[i].getSymbol());
+      }
+    }
+  }
+
   // For now, in this case, we'll just dirty the cards in the range.  We could
   // look at the copied contents, or change the interface to take the "from"
   // range, and dirty the cards if the from range has any dirty cards.  But just
@@ -1020,8 +1604,14 @@ void GenGC::writeBarrierRangeFill(
     HermesValue value) {
   countRangeFillWriteBarrier();
   if (!value.isPointer()) {
+    if (LLVM_UNLIKELY(oldGenMarkingActive_) && value.isSymbol()) {
+      oldGenMarkingSymbolBarrier(value.getSymbol());
+    }
     return;
   }
+  if (LLVM_UNLIKELY(oldGenMarkingActive_)) {
+    oldGenMarkingBarrier(value.getPointer());
+  }
 
   char *firstPtr = reinterpret_cast<char *>(start);
   char *lastPtr = reinterpret_cast<char *>(start + numHVs) - 1;
@@ -1031,7 +1621,7 @@ void GenGC::writeBarrierRangeFill(
       AlignedStorage::start(firstPtr) == AlignedStorage::start(lastPtr) &&
       "Range should be contained in the same segment");
 
-  if (youngGen_.contains(valuePtr)) {
+  if (!youngGen_.contains(firstPtr) && youngGen_.contains(valuePtr)) {
     AlignedHeapSegment::cardTableCovering(firstPtr)->dirtyCardsForAddressRange(
         firstPtr, lastPtr);
   }
@@ -1044,6 +1634,12 @@ void GenGC::getHeapInfo(HeapInfo &info) {
   info.heapSize = sizeDirect();
   info.totalAllocatedBytes = totalAllocatedBytes_ + bytesAllocatedSinceLastGC();
   info.va = segmentIndex_.size() * AlignedStorage::size();
+  if (segmentIndex_.size()) {
+    // The index is ordered by address.
+    info.vaSpan = (*(segmentIndex_.end() - 1))->hiLim() -
+        (*segmentIndex_.begin())->lowLim();
+  }
+  info.hugePageBytes = storageProvider_.hugePageBytes();
   info.fullStats = fullCollectionCumStats_;
   info.youngGenStats = youngGenCollectionCumStats_;
 }
@@ -1099,14 +1695,14 @@ void GenGC::dump(llvm::raw_ostream &os, bool verbose) {
      << "\n"
      << "      Value is obj ptr:     "
      << numWriteBarriers_[true][kNumWriteBarrierOfObjectPtrIdx] << "\n"
-     << "      Val/loc in diff segs: "
-     << numWriteBarriers_[true][kNumWriteBarrierWithDifferentSegsIdx] << "\n"
+     << "      Loc in OG:            "
+     << numWriteBarriers_[true][kNumWriteBarrierLocInOGIdx] << "\n"
      << "      Value in YG:          "
      << numWriteBarriers_[true][kNumWriteBarrierPtrInYGIdx] << "\n"
      << "   void*: " << numWriteBarriers_[false][kNumWriteBarrierTotalCountIdx]
      << "\n"
-     << "      Val/loc in diff segs: "
-     << numWriteBarriers_[false][kNumWriteBarrierWithDifferentSegsIdx] << "\n"
+     << "      Loc in OG:            "
+     << numWriteBarriers_[false][kNumWriteBarrierLocInOGIdx] << "\n"
      << "      Value in YG:          "
      << numWriteBarriers_[false][kNumWriteBarrierPtrInYGIdx] << "\n"
      << "Range: " << numRangeBarriers_ << "\n"
@@ -1123,6 +1719,21 @@ void GenGC::updateTotalAllocStats() {
   totalAllocatedBytes_ += bytesAllocatedSinceLastGC();
 }
 
+void GenGC::recordAllocationTelemetry() {
+  const double secs =
+      clockDiffSeconds(telemetry_->lastCollectionEnd, steady_clock::now());
+  if (secs > 0) {
+    telemetry_->allocationRate.record(bytesAllocatedSinceLastGC() / secs);
+  }
+  auto &bytesByKind = telemetry_->allocatedBytesByKind;
+  auto census = [&bytesByKind](GCCell *cell) {
+    bytesByKind[static_cast<size_t>(cell->getKind())] +=
+        cell->getAllocatedSize();
+  };
+  youngGen_.forObjsAllocatedSinceGC(census);
+  oldGen_.forObjsAllocatedSinceGC(census);
+}
+
 void GenGC::yieldAllocContext() {
   // If we're randomizing the alloc space, we don't use the allocation context.
   if (shouldRandomizeAllocSpace()) {
@@ -1202,7 +1813,8 @@ void GenGC::createSnapshot(llvm::raw_ostream &os, bool compact) {
     // If the cell is a string, add a value to be printed.
     // TODO: add other special types here.
     if (const StringPrimitive *str = dyn_vmcast<StringPrimitive>(cell)) {
-      strID = stringToID(converter(str));
+      strID =
+          stringToID(converter(str, V8HeapSnapshot::kMaxStringValueLength));
     } else {
       strID = stringToID("");
     }
@@ -1330,6 +1942,8 @@ void GenGC::printFullCollectionStats(llvm::raw_ostream &os, bool trailingComma)
      << "\t\t\t\"fullSweepTime\": " << sweepSecs_ << ",\n"
      << "\t\t\t\"fullUpdateRefsTime\": " << updateReferencesSecs_ << ",\n"
      << "\t\t\t\"fullCompactTime\": " << compactSecs_ << ",\n"
+     << "\t\t\t\"fullIncrementalMarkTime\": " << incrementalMarkSecs_ << ",\n"
+     << "\t\t\t\"numIncrementalFullGCs\": " << numIncrementalFullGCs_ << ",\n"
      << "\t\t\t\"fullSurvivalPct\": " << fullSurvivalPct;
 
   if (trailingComma) {
@@ -1338,7 +1952,11 @@ void GenGC::printFullCollectionStats(llvm::raw_ostream &os, bool trailingComma)
   os << "\n";
 }
 
-GenGC::CollectionSection::CollectionSection(GenGC *gc, const char *name)
+GenGC::CollectionSection::CollectionSection(
+    GenGC *gc,
+    const char *name,
+    const char *kind,
+    const char *cause)
     : PerfSection(name, gc->getName().c_str()),
       gc_(gc),
       cycle_(gc),
@@ -1353,12 +1971,27 @@ GenGC::CollectionSection::CollectionSection(GenGC *gc, const char *name)
   gc_->doAllocCensus();
 #endif
 
+  if (LLVM_UNLIKELY(gc_->telemetry_ != nullptr)) {
+    gc_->recordAllocationTelemetry();
+  }
   gc_->updateTotalAllocStats();
+  gc_->beginCycleEvent(kind, cause, gc_->usedDirect(), gc_->sizeDirect());
 }
 
 GenGC::CollectionSection::~CollectionSection() {
+  gc_->endCycleEvent(
+      wallElapsedSecs_, cpuElapsedSecs_, gc_->usedDirect(), gc_->sizeDirect());
+
   gc_->youngGen_.didFinishGC();
   gc_->oldGen_.didFinishGC();
+  if (LLVM_UNLIKELY(gc_->telemetry_ != nullptr)) {
+    gc_->telemetry_->lastCollectionEnd = steady_clock::now();
+  }
+  if (LLVM_UNLIKELY(gc_->heapVerificationInterval_ != 0) &&
+      ++gc_->collectionsSinceVerification_ >= gc_->heapVerificationInterval_) {
+    gc_->collectionsSinceVerification_ = 0;
+    gc_->verifyRandomSegment();
+  }
 
 #ifdef HERMES_SLOW_DEBUG
   gc_->checkWellFormedHeap();
@@ -1889,7 +2522,9 @@ void GenGC::sizeDiagnosticCensus() {
 
     if (cell->getKind() == CellKind::DynamicASCIIStringPrimitiveKind ||
         cell->getKind() == CellKind::DynamicUniquedASCIIStringPrimitiveKind ||
-        cell->getKind() == CellKind::ExternalASCIIStringPrimitiveKind) {
+        cell->getKind() == CellKind::ExternalASCIIStringPrimitiveKind ||
+        cell->getKind() == CellKind::BufferedASCIIStringPrimitiveKind ||
+        cell->getKind() == CellKind::SlicedASCIIStringPrimitiveKind) {
       acceptor.diagnostic.asciiStr.count++;
       auto *strprim = vmcast<StringPrimitive>(cell);
       if (strprim->getStringLength() < 8) {
@@ -1899,7 +2534,9 @@ void GenGC::sizeDiagnosticCensus() {
     } else if (
         cell->getKind() == CellKind::DynamicUTF16StringPrimitiveKind ||
         cell->getKind() == CellKind::DynamicUniquedUTF16StringPrimitiveKind ||
-        cell->getKind() == CellKind::ExternalUTF16StringPrimitiveKind) {
+        cell->getKind() == CellKind::ExternalUTF16StringPrimitiveKind ||
+        cell->getKind() == CellKind::BufferedUTF16StringPrimitiveKind ||
+        cell->getKind() == CellKind::SlicedUTF16StringPrimitiveKind) {
       acceptor.diagnostic.utf16Str.count++;
       auto *strprim = vmcast<StringPrimitive>(cell);
       if (strprim->getStringLength() < 8) {
@@ -1948,5 +2585,12 @@ void *GenGC::allocSlow(uint32_t sz, bool fixedSize, HasFinalizer hasFinalizer) {
   return res.ptr;
 }
 
+void *GenGC::allocLarge(uint32_t sz, HasFinalizer hasFinalizer) {
+  AllocContextYieldThenClaim yielder(this);
+  AllocResult res = oldGen_.allocLarge(sz, hasFinalizer);
+  assert(res.success && "Should never fail to allocate at the top level");
+  return res.ptr;
+}
+
 } // namespace vm
 } // namespace hermes
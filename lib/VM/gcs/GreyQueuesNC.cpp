@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/VM/GreyQueuesNC.h"
+
+namespace hermes {
+namespace vm {
+
+constexpr size_t GreyQueues::kPublishThreshold;
+
+GreyQueues::GreyQueues(unsigned numThreads) {
+  assert(numThreads > 0 && "Need at least one thread");
+  for (unsigned i = 0; i < numThreads; ++i) {
+    queues_.emplace_back(new Queue(i));
+  }
+}
+
+void GreyQueues::addInitial(GCCell *cell) {
+  Queue &q = queue(nextInitial_);
+  q.published_.push_back(cell);
+  q.numPublished_.store(q.published_.size(), std::memory_order_relaxed);
+  nextInitial_ = (nextInitial_ + 1) % numThreads();
+}
+
+bool GreyQueues::Queue::take(Queue &victim) {
+  if (victim.numPublished_.load(std::memory_order_relaxed) == 0) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lk{victim.mutex_};
+  auto &stack = victim.published_;
+  if (stack.empty()) {
+    return false;
+  }
+  const size_t n = &victim == this ? stack.size() : (stack.size() + 1) / 2;
+  local_.insert(local_.end(), stack.end() - n, stack.end());
+  stack.resize(stack.size() - n);
+  victim.numPublished_.store(stack.size(), std::memory_order_relaxed);
+  return true;
+}
+
+bool GreyQueues::waitForWork(Queue &self) {
+  // A thread only counts as idle while its queue is empty, and only cells on
+  // the queues of busy threads lead to more, so once every thread is idle
+  // there is nothing left to scan.
+  const unsigned n = numThreads();
+  numIdle_.fetch_add(1);
+  for (;;) {
+    if (numIdle_.load() == n) {
+      return false;
+    }
+    numIdle_.fetch_sub(1);
+    // Start from a different victim for each thread, so they do not all
+    // contend for the same one.
+    for (unsigned i = 1; i < n; ++i) {
+      if (self.take(queue((self.index + i) % n))) {
+        return true;
+      }
+    }
+    numIdle_.fetch_add(1);
+    std::this_thread::yield();
+  }
+}
+
+} // namespace vm
+} // namespace hermes
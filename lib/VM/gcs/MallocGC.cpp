@@ -327,6 +327,7 @@ void MallocGC::collect() {
   double cpuElapsedSecs = GCBase::clockDiffSeconds(cpuStart, cpuEnd);
   recordGCStats(wallElapsedSecs, cpuElapsedSecs, allocatedBytes_);
   checkTripwire(allocatedBytes_, wallEnd);
+  runDeferredFinalizers();
 }
 
 void MallocGC::finalizeAll() {
@@ -334,6 +335,7 @@ void MallocGC::finalizeAll() {
     GCCell *cell = header->data();
     cell->getVT()->finalizeIfExists(cell, this);
   }
+  runDeferredFinalizers();
 }
 
 void MallocGC::printStats(llvm::raw_ostream &os, bool trailingComma) {
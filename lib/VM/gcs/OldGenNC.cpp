@@ -12,6 +12,7 @@
 #include "hermes/VM/AllocResult.h"
 #include "hermes/VM/CompactionResult-inline.h"
 #include "hermes/VM/CompleteMarkState-inline.h"
+#include "hermes/VM/FillerCell.h"
 #include "hermes/VM/GC.h"
 #include "hermes/VM/GCBase-inline.h"
 #include "hermes/VM/GCPointer-inline.h"
@@ -81,8 +82,15 @@ OldGen::Size::adjustSizeWithBounds(size_t desired, size_t min, size_t max) {
   return llvm::alignTo(clamped, alignment);
 }
 
-OldGen::OldGen(GenGC *gc, Size sz, bool releaseUnused)
-    : GCGeneration(gc), sz_(sz), releaseUnused_(releaseUnused) {
+OldGen::OldGen(
+    GenGC *gc,
+    Size sz,
+    bool releaseUnused,
+    std::chrono::milliseconds unusedSegmentRetention)
+    : GCGeneration(gc),
+      sz_(sz),
+      releaseUnused_(releaseUnused),
+      unusedSegmentRetention_(unusedSegmentRetention) {
   auto result = AlignedStorage::create(&gc_->storageProvider_, kSegmentName);
   if (!result) {
     gc_->oom(result.getError());
@@ -194,6 +202,7 @@ void OldGen::forAllObjs(const std::function<void(GCCell *)> &callback) {
 bool OldGen::dbgContains(const void *p) const {
   return gc_->dbgContains(p) && !gc_->youngGen_.dbgContains(p);
 }
+#endif // !NDEBUG
 
 void OldGen::forObjsAllocatedSinceGC(
     const std::function<void(GCCell *)> &callback) {
@@ -212,7 +221,6 @@ void OldGen::forObjsAllocatedSinceGC(
     seg->forAllObjs(callback);
   }
 }
-#endif // !NDEBUG
 
 void OldGen::creditExternalMemory(uint32_t size) {
   GCGeneration::creditExternalMemory(size);
@@ -269,10 +277,11 @@ size_t OldGen::trailingExternalMemory() const {
   // memory for purposes of computing the effective size.  Only the remainder
   // is considered to be "allocated at the end".
   size_t fragLoss = fragmentationLoss();
-  if (fragLoss > externalMemory_) {
+  size_t trailing = externalMemory_ + largeObjectBytes_;
+  if (fragLoss > trailing) {
     return 0;
   } else {
-    return externalMemory_ - fragLoss;
+    return trailing - fragLoss;
   }
 }
 
@@ -294,13 +303,67 @@ void OldGen::updateEffectiveEndForExternalMemory() {
   trueActiveSegment().setEffectiveEnd(clampedEnd.ptr);
 }
 
-void OldGen::markYoungGenPointers(OldGen::Location originalLevel) {
-  if (used() == 0) {
-    // Nothing to do if the old gen is empty.
-    return;
+namespace {
+
+/// Apply \p visitor to the pointers in the dirty cards of [\p start, \p
+/// level), a region of a segment of the old generation, and clear the cards.
+template <typename Acceptor>
+void scanDirtyCards(
+    GC *gc,
+    char *start,
+    const char *level,
+    SlotVisitor<Acceptor> &visitor) {
+  CardTable &cardTable = *AlignedHeapSegment::cardTableCovering(start);
+
+  size_t from = cardTable.addressToIndex(start);
+  size_t to = cardTable.addressToIndex(level - 1) + 1;
+
+  while (const auto oiBegin = cardTable.findNextDirtyCard(from, to)) {
+    const auto iBegin = *oiBegin;
+
+    const auto oiEnd = cardTable.findNextCleanCard(iBegin, to);
+    const auto iEnd = oiEnd ? *oiEnd : to;
+
+    assert(
+        (iEnd == to || !cardTable.isCardForIndexDirty(iEnd)) &&
+        cardTable.isCardForIndexDirty(iEnd - 1) &&
+        "end should either be the end of the card table, or the first "
+        "non-dirty card after a sequence of dirty cards");
+    assert(iBegin < iEnd && "Indices must be apart by at least one");
+
+    const char *const begin = cardTable.indexToAddress(iBegin);
+    const char *const end = cardTable.indexToAddress(iEnd);
+    const void *const boundary = std::min(end, level);
+
+    GCCell *const firstObj = cardTable.firstObjForCard(iBegin);
+    GCCell *obj = firstObj;
+
+    // Mark the first object with respect to the dirty card boundaries.
+    GCBase::markCellWithinRange(visitor, obj, obj->getVT(), gc, begin, end);
+
+    // Mark the objects that are entirely contained within the dirty card
+    // boundaries.
+    for (GCCell *next = obj->nextCell(); next < boundary;
+         next = next->nextCell()) {
+      obj = next;
+      GCBase::markCell(visitor, obj, obj->getVT(), gc);
+    }
+
+    // Mark the final object in the range with respect to the dirty card
+    // boundaries, as long as it does not coincide with the first object.
+    if (LLVM_LIKELY(obj != firstObj)) {
+      GCBase::markCellWithinRange(visitor, obj, obj->getVT(), gc, begin, end);
+    }
+
+    from = iEnd;
   }
+  cardTable.clear();
+}
+
+} // namespace
 
 #ifdef HERMES_SLOW_DEBUG
+void OldGen::verifyCardTableDirty() {
   struct VerifyCardDirtyAcceptor final : public SlotAcceptorDefault {
     using SlotAcceptorDefault::accept;
     using SlotAcceptorDefault::SlotAcceptorDefault;
@@ -348,9 +411,19 @@ void OldGen::markYoungGenPointers(OldGen::Location originalLevel) {
       GCBase::markCell(cell, gc, acceptor);
     });
   }
+}
+#endif // HERMES_SLOW_DEBUG
+
+void OldGen::markYoungGenPointers(OldGen::Location originalLevel) {
+  if (used() == 0) {
+    // Nothing to do if the old gen is empty.
+    return;
+  }
 
+#ifdef HERMES_SLOW_DEBUG
+  verifyCardTableDirty();
   verifyCardTableBoundaries();
-#endif // HERMES_SLOW_DEBUG
+#endif
 
   struct OldGenObjEvacAcceptor final : public SlotAcceptorDefault {
     using SlotAcceptorDefault::accept;
@@ -382,9 +455,19 @@ void OldGen::markYoungGenPointers(OldGen::Location originalLevel) {
   OldGenObjEvacAcceptor acceptor(*gc_);
   SlotVisitor<OldGenObjEvacAcceptor> visitor(acceptor);
 
-  auto segs = GCSegmentRange::concat(
-      OldGenFilledSegmentRange::create(this),
-      GCSegmentRange::singleton(&activeSegment()));
+  for (const auto &region : youngGenPointerRegions(originalLevel)) {
+    scanDirtyCards(gc_, region.first, region.second, visitor);
+  }
+}
+
+std::vector<std::pair<char *, const char *>> OldGen::youngGenPointerRegions(
+    Location originalLevel) {
+  std::vector<std::pair<char *, const char *>> regions;
+  if (used() == 0) {
+    return regions;
+  }
+
+  auto segs = compactedSegments();
 
   size_t i = 0;
   while (AlignedHeapSegment *seg = segs->next()) {
@@ -393,55 +476,23 @@ void OldGen::markYoungGenPointers(OldGen::Location originalLevel) {
 
     const char *const origSegLevel =
         i == originalLevel.segmentNum ? originalLevel.ptr : seg->level();
-
-    auto &cardTable = seg->cardTable();
-
-    size_t from = cardTable.addressToIndex(seg->start());
-    size_t to = cardTable.addressToIndex(origSegLevel - 1) + 1;
-
-    while (const auto oiBegin = cardTable.findNextDirtyCard(from, to)) {
-      const auto iBegin = *oiBegin;
-
-      const auto oiEnd = cardTable.findNextCleanCard(iBegin, to);
-      const auto iEnd = oiEnd ? *oiEnd : to;
-
-      assert(
-          (iEnd == to || !cardTable.isCardForIndexDirty(iEnd)) &&
-          cardTable.isCardForIndexDirty(iEnd - 1) &&
-          "end should either be the end of the card table, or the first "
-          "non-dirty card after a sequence of dirty cards");
-      assert(iBegin < iEnd && "Indices must be apart by at least one");
-
-      const char *const begin = cardTable.indexToAddress(iBegin);
-      const char *const end = cardTable.indexToAddress(iEnd);
-      const void *const boundary = std::min(end, origSegLevel);
-
-      GCCell *const firstObj = cardTable.firstObjForCard(iBegin);
-      GCCell *obj = firstObj;
-
-      // Mark the first object with respect to the dirty card boundaries.
-      GCBase::markCellWithinRange(visitor, obj, obj->getVT(), gc_, begin, end);
-
-      // Mark the objects that are entirely contained within the dirty card
-      // boundaries.
-      for (GCCell *next = obj->nextCell(); next < boundary;
-           next = next->nextCell()) {
-        obj = next;
-        GCBase::markCell(visitor, obj, obj->getVT(), gc_);
-      }
-
-      // Mark the final object in the range with respect to the dirty card
-      // boundaries, as long as it does not coincide with the first object.
-      if (LLVM_LIKELY(obj != firstObj)) {
-        GCBase::markCellWithinRange(
-            visitor, obj, obj->getVT(), gc_, begin, end);
-      }
-
-      from = iEnd;
-    }
-    cardTable.clear();
+    regions.emplace_back(seg->start(), origSegLevel);
     i++;
   }
+
+  // Large objects are only allocated between collections.
+  for (auto &large : largeObjectSegments_) {
+    regions.emplace_back(large.start(), large.level());
+  }
+  return regions;
+}
+
+void OldGen::markYoungGenPointersInRegion(
+    char *start,
+    const char *level,
+    YoungGen::ParallelEvacAcceptor &acceptor) {
+  SlotVisitor<YoungGen::ParallelEvacAcceptor> visitor(acceptor);
+  scanDirtyCards(gc_, start, level, visitor);
 }
 
 void OldGen::youngGenTransitiveClosure(
@@ -514,9 +565,17 @@ void OldGen::verifyCardTableBoundaries() const {
 void OldGen::sweepAndInstallForwardingPointers(
     GC *gc,
     SweepResult *sweepResult) {
-  forUsedSegments([gc, sweepResult](AlignedHeapSegment &segment) {
-    segment.sweepAndInstallForwardingPointers(gc, sweepResult);
-  });
+  auto segs = compactedSegments();
+  while (AlignedHeapSegment *seg = segs->next()) {
+    seg->sweepAndInstallForwardingPointers(gc, sweepResult);
+  }
+
+  // Large objects stay where they are, but their segments are swept after the
+  // others, in the order forUsedSegments visits them, so that their displaced
+  // VTable pointers are found by the later phases.
+  for (auto &large : largeObjectSegments_) {
+    large.sweepInPlace(gc, sweepResult);
+  }
 }
 
 void OldGen::updateReferences(GC *gc, SweepResult::VTablesRemaining &vTables) {
@@ -537,24 +596,24 @@ void OldGen::recordLevelAfterCompaction(
 
   // Some prefix of the used chunks correspond to segments in this generation.
   // The corresponding segments are the used segments after compaction.
-  whileUsedSegments([&](AlignedHeapSegment &segment) {
+  auto segs = compactedSegments();
+  while (AlignedHeapSegment *segment = segs->next()) {
     if (usedSegs >= nChunks || this != chunks.peek().generation()) {
-      return false;
+      break;
     }
 
     if (releaseUnused_)
-      chunks.next().recordLevel<AdviseUnused::Yes>(&segment);
+      chunks.next().recordLevel<AdviseUnused::Yes>(segment);
     else
-      chunks.next().recordLevel<AdviseUnused::No>(&segment);
+      chunks.next().recordLevel<AdviseUnused::No>(segment);
 
     usedInFilledSegments_ += usedInPrev;
-    usedInPrev = segment.used();
+    usedInPrev = segment->used();
     usedSegs++;
-
-    return true;
-  });
+  }
 
   releaseSegments(usedSegs == 0 ? 1 : usedSegs);
+  releaseDeadLargeObjects();
   updateCardTableBoundary();
 }
 
@@ -578,6 +637,60 @@ AllocResult OldGen::fullCollectThenAlloc(
   gc_->oom(make_error_code(OOMError::MaxHeapReached));
 }
 
+AllocResult OldGen::allocLarge(uint32_t size, HasFinalizer hasFinalizer) {
+  assert(ownsAllocContext());
+  // The object must fit in a segment of its own.
+  if (LLVM_UNLIKELY(size > AlignedHeapSegment::maxSize())) {
+    gc_->oom(make_error_code(OOMError::SuperSegmentAlloc));
+  }
+
+  if (size > available()) {
+    gc_->collect(/* canEffectiveOOM */ true);
+  }
+  if (size > available()) {
+    // Unlike growToFit, there is no need to seed the segment cache: the object
+    // gets a segment of its own below.
+    const size_t unavailable = levelOffset() + trailingExternalMemory();
+    const size_t adjusted = adjustSize(unavailable + size);
+    if (adjusted < unavailable + size) {
+      gc_->oom(make_error_code(OOMError::MaxHeapReached));
+    }
+    growTo(adjusted);
+  }
+
+  if (!segmentCache_.empty()) {
+    largeObjectSegments_.push_back(std::move(segmentCache_.back().segment));
+    segmentCache_.pop_back();
+  } else {
+    auto result = AlignedStorage::create(&gc_->storageProvider_, kSegmentName);
+    if (!result) {
+      gc_->oom(result.getError());
+    }
+    largeObjectSegments_.emplace_back(std::move(result.get()), this);
+  }
+  AlignedHeapSegment &segment = largeObjectSegments_.back();
+  segment.growToLimit();
+  gc_->segmentMoved(&segment);
+
+  AllocResult res = segment.alloc(size);
+  assert(res.success && "An empty segment must fit the object");
+  CardTable::Boundary boundary =
+      segment.cardTable().nextBoundary(segment.start());
+  segment.cardTable().updateBoundaries(
+      &boundary, segment.start(), segment.level());
+
+  if (hasFinalizer == HasFinalizer::Yes) {
+    addToFinalizerList(res.ptr);
+  }
+#ifndef NDEBUG
+  incNumAllocatedObjects();
+#endif
+
+  largeObjectBytes_ += size;
+  updateEffectiveEndForExternalMemory();
+  return res;
+}
+
 void OldGen::moveHeap(GC *gc, ptrdiff_t moveHeapDelta) {
   // TODO (T25686322): implement non-contig version of this.
 }
@@ -619,6 +732,7 @@ bool OldGen::seedSegmentCacheForSize(size_t size) {
   const auto cacheBefore = segmentCache_.size();
 
   // Try and seed the segment cache with enough segments to fit the request.
+  const auto now = std::chrono::steady_clock::now();
   for (; segAlloc < segReq; ++segAlloc) {
     auto result = AlignedStorage::create(&gc_->storageProvider_, kSegmentName);
     if (!result) {
@@ -627,8 +741,8 @@ bool OldGen::seedSegmentCacheForSize(size_t size) {
       segmentCache_.resize(cacheBefore);
       return false;
     }
-    segmentCache_.emplace_back(std::move(result.get()), this);
-    segmentCache_.back().growToLimit();
+    segmentCache_.push_back({{std::move(result.get()), this}, now});
+    segmentCache_.back().segment.growToLimit();
   }
 
   assert(committedSegs() >= segReq);
@@ -652,7 +766,8 @@ bool OldGen::materializeNextSegment() {
 
   // Get a new segment from somewhere
   if (!segmentCache_.empty()) {
-    exchangeActiveSegment(std::move(segmentCache_.back()), filledSegSlot);
+    exchangeActiveSegment(
+        std::move(segmentCache_.back().segment), filledSegSlot);
     segmentCache_.pop_back();
   } else {
     auto result = AlignedStorage::create(&gc_->storageProvider_, kSegmentName);
@@ -695,13 +810,14 @@ void OldGen::releaseSegments(size_t from) {
   }
 
   std::vector<const char *> toRelease;
-  const auto release = [&toRelease, this](AlignedHeapSegment &unused) {
+  const auto now = std::chrono::steady_clock::now();
+  const auto release = [&toRelease, now, this](AlignedHeapSegment &unused) {
     toRelease.push_back(unused.lowLim());
     if (!this->releaseUnused_) {
       // Clear the segment and move it to the cache.
       unused.resetLevel();
       assert(unused.used() == 0);
-      this->segmentCache_.emplace_back(std::move(unused));
+      this->segmentCache_.push_back({std::move(unused), now});
     }
   };
 
@@ -721,6 +837,65 @@ void OldGen::releaseSegments(size_t from) {
   filledSegments_.resize(from - 1);
 }
 
+void OldGen::releaseDeadLargeObjects() {
+  if (largeObjectSegments_.empty()) {
+    return;
+  }
+
+  std::vector<const char *> toRelease;
+  const auto now = std::chrono::steady_clock::now();
+  auto live = largeObjectSegments_.begin();
+  for (auto &segment : largeObjectSegments_) {
+    if (AlignedHeapSegment::getCellMarkBit(
+            reinterpret_cast<GCCell *>(segment.start()))) {
+      if (&*live != &segment) {
+        *live = std::move(segment);
+      }
+      ++live;
+      continue;
+    }
+
+    // The object is dead, and has been swept into a DeadRegion.
+    toRelease.push_back(segment.lowLim());
+    largeObjectBytes_ -= segment.used();
+    if (!releaseUnused_) {
+      segment.resetLevel();
+      segmentCache_.push_back({std::move(segment), now});
+    }
+  }
+  largeObjectSegments_.erase(live, largeObjectSegments_.end());
+
+  std::sort(toRelease.begin(), toRelease.end());
+  gc_->forgetSegments(toRelease);
+
+  // The live segments may have moved within the deque.
+  for (auto &segment : largeObjectSegments_) {
+    gc_->segmentMoved(&segment);
+  }
+  updateEffectiveEndForExternalMemory();
+}
+
+void OldGen::releaseCachedSegments(
+    std::chrono::steady_clock::time_point cachedBefore) {
+  // The segments are in the order they were cached in, so the ones to release
+  // are a prefix.
+  auto last = std::find_if(
+      segmentCache_.begin(),
+      segmentCache_.end(),
+      [cachedBefore](const CachedSegment &cached) {
+        return cached.since > cachedBefore;
+      });
+  segmentCache_.erase(segmentCache_.begin(), last);
+}
+
+void OldGen::releaseIdleSegments(std::chrono::steady_clock::time_point now) {
+  if (segmentCache_.empty() ||
+      unusedSegmentRetention_ == std::chrono::milliseconds::max()) {
+    return;
+  }
+  releaseCachedSegments(now - unusedSegmentRetention_);
+}
+
 AllocResult OldGen::allocSlow(uint32_t size, HasFinalizer hasFinalizer) {
   assert(ownsAllocContext());
   AllocResult result = allocRawSlow(size, hasFinalizer);
@@ -771,6 +946,97 @@ void OldGen::checkWellFormed(const GC *gc) const {
 }
 #endif
 
+constexpr uint32_t OldGen::kPromotionChunkSize;
+constexpr uint32_t OldGen::PromotionBuffer::kMaxSharedCellSize;
+constexpr uint32_t OldGen::PromotionBuffer::kMinHoleSize;
+
+char *OldGen::PromotionBuffer::reserveSlow(uint32_t size) {
+  static_assert(
+      sizeof(FillerCell) <= kMinHoleSize, "Holes must be large enough to fill");
+  static_assert(
+      kMaxSharedCellSize + kMinHoleSize <= kPromotionChunkSize,
+      "Shared cells must fit in a chunk");
+  if (large_) {
+    // The last large cell lost the race to be promoted; its chunk is unused.
+    holes_.emplace_back(large_, reserved_);
+    large_ = nullptr;
+    if (fits(size)) {
+      reserved_ = size;
+      return level_;
+    }
+  }
+
+  uint32_t chunkSize;
+  ++numChunks_;
+  reserved_ = size;
+  if (size > kMaxSharedCellSize) {
+    large_ = gen_->allocPromotionChunk(size, size, &chunkSize);
+    assert(chunkSize == size && "Large cells get a chunk of their own");
+    return large_;
+  }
+
+  retire();
+  level_ = gen_->allocPromotionChunk(
+      size + kMinHoleSize, kPromotionChunkSize, &chunkSize);
+  end_ = level_ + chunkSize;
+  cardTable_ = AlignedHeapSegment::cardTableCovering(level_);
+  boundary_ = cardTable_->nextBoundary(level_);
+  assert(fits(size) && "A new chunk must fit the cell");
+  return level_;
+}
+
+void OldGen::PromotionBuffer::retire() {
+  if (large_) {
+    holes_.emplace_back(large_, reserved_);
+    large_ = nullptr;
+  }
+  if (level_ < end_) {
+    if (boundary_.address() < end_) {
+      cardTable_->updateBoundaries(&boundary_, level_, end_);
+    }
+    holes_.emplace_back(level_, end_ - level_);
+  }
+  level_ = end_ = nullptr;
+}
+
+char *OldGen::allocPromotionChunk(
+    uint32_t minSize,
+    uint32_t maxSize,
+    uint32_t *size) {
+  std::lock_guard<std::mutex> lk{promotionMutex_};
+  // Use up the rest of the active segment before moving on to the next.
+  const size_t avail = llvm::alignDown(activeSegment().available(), HeapAlign);
+  *size = avail >= minSize ? std::min<size_t>(maxSize, avail) : maxSize;
+  AllocResult res = allocRaw(*size, HasFinalizer::No);
+  // As in YoungGen::forwardPointer, the space for the collection was ensured
+  // before it started.
+  assert(res.success && "Promotion chunk allocation failed");
+  return reinterpret_cast<char *>(res.ptr);
+}
+
+/* static */ size_t OldGen::promotionSpaceFor(
+    size_t amount,
+    unsigned numThreads) {
+  // A chunk loses less than kMaxSharedCellSize + kMinHoleSize at its end, so
+  // at most an eighth of the chunks that are filled.  Every thread may also
+  // leave most of its last chunk unused.
+  return amount + amount / 8 + numThreads * kPromotionChunkSize;
+}
+
+void OldGen::finishPromotion(PromotionBuffer &buffer) {
+  buffer.retire();
+  for (const auto &hole : buffer.holes_) {
+    new (hole.first) FillerCell(gc_, hole.second);
+  }
+#ifndef NDEBUG
+  // Each chunk was counted as one allocated object.
+  incNumAllocatedObjects(
+      buffer.numCells_ + buffer.holes_.size() - buffer.numChunks_);
+#endif
+  buffer.holes_.clear();
+  buffer.numChunks_ = 0;
+}
+
 void OldGen::didFinishGC() {
   levelAtEndOfLastGC_ = levelDirect();
 }
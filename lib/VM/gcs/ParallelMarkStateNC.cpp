@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/VM/ParallelMarkStateNC.h"
+
+#include "hermes/VM/AlignedHeapSegment.h"
+#include "hermes/VM/GC.h"
+#include "hermes/VM/GCBase-inline.h"
+#include "hermes/VM/HermesValue-inline.h"
+#include "hermes/VM/SlotAcceptorDefault.h"
+
+namespace hermes {
+namespace vm {
+
+struct ParallelMarkState::Worker {
+  /// The SymbolIDs reached by this thread.
+  std::vector<bool> markedSymbols;
+  /// The cells scanned by this thread that have weak references to mark.
+  std::vector<GCCell *> weakCells;
+
+  explicit Worker(size_t numSymbols) : markedSymbols(numSymbols, false) {}
+};
+
+/// Marks the cells that are reached from the fields of scanned cells, and
+/// pushes them on the thread's queue if they were not marked before.
+struct ParallelMarkState::MarkAcceptor final : public SlotAcceptorDefault {
+  /// Weak references are marked by finish(), on the GC's thread.
+  static constexpr bool shouldMarkWeak = false;
+
+  GreyQueues::Queue &queue;
+  Worker &worker;
+  MarkAcceptor(GC &gc, GreyQueues::Queue &queue, Worker &worker)
+      : SlotAcceptorDefault(gc), queue(queue), worker(worker) {}
+
+  using SlotAcceptorDefault::accept;
+
+  void accept(void *&ptr) override {
+    if (ptr) {
+      assert(gc.dbgContains(ptr));
+      MarkBitArrayNC *markBits = AlignedHeapSegment::markBitArrayCovering(ptr);
+      if (markBits->atomicMark(markBits->addressToIndex(ptr))) {
+        queue.push(reinterpret_cast<GCCell *>(ptr));
+      }
+    }
+  }
+  void accept(HermesValue &hv) override {
+    if (hv.isPointer()) {
+      void *cell = hv.getPointer();
+      accept(cell);
+    } else if (hv.isSymbol()) {
+      accept(hv.getSymbol());
+    }
+  }
+  void accept(SymbolID sym) override {
+    if (sym.isInvalid()) {
+      return;
+    }
+    assert(
+        sym.unsafeGetIndex() < worker.markedSymbols.size() &&
+        "symbolID out of reported range");
+    worker.markedSymbols[sym.unsafeGetIndex()] = true;
+  }
+};
+
+ParallelMarkState::ParallelMarkState(
+    GC *gc,
+    unsigned numThreads,
+    size_t numSymbols)
+    : gc_(gc), greyQueues_(numThreads) {
+  for (unsigned i = 0; i < numThreads; ++i) {
+    workers_.emplace_back(new Worker(numSymbols));
+  }
+}
+
+ParallelMarkState::~ParallelMarkState() = default;
+
+void ParallelMarkState::run() {
+  std::vector<std::unique_ptr<MarkAcceptor>> acceptors;
+  std::vector<std::unique_ptr<SlotVisitor<MarkAcceptor>>> visitors;
+  for (unsigned i = 0; i < workers_.size(); ++i) {
+    acceptors.emplace_back(
+        new MarkAcceptor(*gc_, greyQueues_.queue(i), *workers_[i]));
+    visitors.emplace_back(new SlotVisitor<MarkAcceptor>(*acceptors[i]));
+  }
+
+  greyQueues_.run([this, &visitors](unsigned i, GCCell *cell) {
+    const VTable *vt = cell->getVT();
+    GCBase::markCell(*visitors[i], cell, vt, gc_);
+    if (vt->markWeak_) {
+      workers_[i]->weakCells.push_back(cell);
+    }
+  });
+}
+
+void ParallelMarkState::finish() {
+  for (auto &worker : workers_) {
+    for (size_t i = 0, e = worker->markedSymbols.size(); i < e; ++i) {
+      if (worker->markedSymbols[i]) {
+        gc_->markSymbol(SymbolID::unsafeCreate(i));
+      }
+    }
+    for (GCCell *cell : worker->weakCells) {
+      cell->getVT()->markWeakIfExists(cell, gc_);
+    }
+  }
+}
+
+} // namespace vm
+} // namespace hermes
@@ -331,6 +331,7 @@ void YoungGen::collect() {
         "collected objects computed incorrectly");
 #endif
   }
+  gc_->runDeferredFinalizers();
 }
 
 void YoungGen::creditExternalMemory(uint32_t size) {
@@ -13,6 +13,7 @@
 #include "hermes/Support/OSCompat.h"
 #include "hermes/Support/PerfSection.h"
 #include "hermes/VM/AllocResult.h"
+#include "hermes/VM/AllocationSite.h"
 #include "hermes/VM/CompactionResult-inline.h"
 #include "hermes/VM/CompactionResult.h"
 #include "hermes/VM/CompleteMarkState-inline.h"
@@ -179,6 +180,8 @@ void YoungGen::printStats(llvm::raw_ostream &os, bool trailingComma) const {
      << "\t\t\t\"ygScanTransitiveTime\": " << scanTransitiveSecs_ << ",\n"
      << "\t\t\t\"ygUpdateWeakRefsTime\": " << updateWeakRefsSecs_ << ",\n"
      << "\t\t\t\"ygFinalizersTime\": " << finalizersSecs_ << ",\n"
+     << "\t\t\t\"ygNumPretenuredSites\": " << numPretenuredSites_ << ",\n"
+     << "\t\t\t\"ygPretenuredBytes\": " << cumPretenuredBytes_ << ",\n"
      << "\t\t\t\"ygSurvivalPct\": " << youngGenSurvivalPct;
   if (trailingComma) {
     os << ",";
@@ -207,7 +210,10 @@ AllocResult YoungGen::allocSlow(
   // if everything survives?
   if (LLVM_LIKELY(nextGen_->ensureFits(usedDirect()))) {
     // There is enough space; do the young-gen collection.
-    collect();
+    collect("allocation");
+    // With the young gen empty, this is where incremental marking of the old
+    // generation makes progress.
+    gc_->didYoungGenCollection();
     AllocResult res = allocRaw(allocSize, hasFinalizer);
     if (res.success) {
       return res;
@@ -245,7 +251,7 @@ AllocResult YoungGen::fullCollectThenAlloc(
   // Try to grow the next gen to allow young-gen collection, if the allocation
   // can fit into the young generation.
   if (allocSize <= sizeDirect() && nextGen_->growToFit(usedDirect())) {
-    collect();
+    collect("allocation");
     AllocResult res = allocRaw(allocSize, hasFinalizer);
     assert(res.success && "preceding test should guarantee success.");
     return res;
@@ -265,8 +271,9 @@ AllocResult YoungGen::fullCollectThenAlloc(
   gc_->oom(make_error_code(OOMError::MaxHeapReached));
 }
 
-void YoungGen::collect() {
-  GenGC::CollectionSection ygCollection(gc_, "YoungGen collection");
+void YoungGen::collect(const char *cause) {
+  GenGC::CollectionSection ygCollection(
+      gc_, "YoungGen collection", "young", cause);
 
   // Reset the number of consecutive full GCs, because we're about to do a young
   // gen collection.
@@ -297,27 +304,45 @@ void YoungGen::collect() {
   // promoting objects.
   OldGen::Location toScan = nextGen_->levelDirect();
 
-  // We do this first, before marking from the roots, so that we can take
-  // a "snapshot" of the level of the old gen, and only iterate over pointers
-  // in old-gen objects allocated at the start of the collection.
+  // A parallel collection needs more space in the old gen than a serial one,
+  // for the space left at the ends of the threads' promotion chunks.
+  const unsigned numThreads = gc_->numGCThreads_;
+  const bool parallel = numThreads > 1 &&
+      nextGen_->ensureFits(
+          OldGen::promotionSpaceFor(youngGenUsedBefore, numThreads));
+
   auto markOldToYoungStart = steady_clock::now();
-  {
-    PerfSection ygMarkOldToYoungSystraceRegion("ygMarkOldToYoung");
-    nextGen_->markYoungGenPointers(toScan);
-  }
+  auto markRootsStart = markOldToYoungStart;
+  auto scanTransitiveStart = markOldToYoungStart;
+  if (parallel) {
+    // Take the regions to scan for old-to-young pointers while the old gen is
+    // still at toScan: the threads' promotion chunks go above it.
+    evacuateParallel(
+        nextGen_->youngGenPointerRegions(toScan),
+        &markRootsStart,
+        &scanTransitiveStart);
+  } else {
+    // We do this first, before marking from the roots, so that we can take
+    // a "snapshot" of the level of the old gen, and only iterate over pointers
+    // in old-gen objects allocated at the start of the collection.
+    {
+      PerfSection ygMarkOldToYoungSystraceRegion("ygMarkOldToYoung");
+      nextGen_->markYoungGenPointers(toScan);
+    }
 
-  auto markRootsStart = steady_clock::now();
-  EvacAcceptor acceptor(*gc_, *this);
-  DroppingAcceptor<EvacAcceptor> nameAcceptor{acceptor};
-  {
-    PerfSection ygMarkRootsSystraceRegion("ygMarkRoots");
-    gc_->markRoots(nameAcceptor, /*markLongLived*/ false);
-  }
+    markRootsStart = steady_clock::now();
+    EvacAcceptor acceptor(*gc_, *this);
+    DroppingAcceptor<EvacAcceptor> nameAcceptor{acceptor};
+    {
+      PerfSection ygMarkRootsSystraceRegion("ygMarkRoots");
+      gc_->markRoots(nameAcceptor, /*markLongLived*/ false);
+    }
 
-  auto scanTransitiveStart = steady_clock::now();
-  {
-    PerfSection ygScanTransitiveSystraceRegion("ygScanTransitive");
-    nextGen_->youngGenTransitiveClosure(toScan, acceptor);
+    scanTransitiveStart = steady_clock::now();
+    {
+      PerfSection ygScanTransitiveSystraceRegion("ygScanTransitive");
+      nextGen_->youngGenTransitiveClosure(toScan, acceptor);
+    }
   }
 
   // We've now determined reachability; find weak refs to young-gen
@@ -328,6 +353,13 @@ void YoungGen::collect() {
     gc_->updateWeakReferences(/*fullGC*/ false);
   }
 
+  // The sampled cells that survived have been forwarded; the others are
+  // about to be discarded.
+  recordAllocationSiteFates();
+  if (LLVM_UNLIKELY(gc_->telemetry_ != nullptr)) {
+    recordPromotionAges(gc_->telemetry_->promotionAge);
+  }
+
   // Call the finalizers of unreachable objects. Assumes all cells that survived
   // the young gen collection are moved to the old gen collection.
   auto finalizersStart = steady_clock::now();
@@ -374,18 +406,26 @@ void YoungGen::collect() {
 
   ygCollection.recordGCStats(sizeDirect(), &gc_->youngGenCollectionCumStats_);
 
-  markOldToYoungSecs_ +=
-      GCBase::clockDiffSeconds(markOldToYoungStart, markRootsStart);
+  markOldToYoungSecs_ += gc_->recordCyclePhase(
+      "markOldToYoung", markOldToYoungStart, markRootsStart);
   markRootsSecs_ +=
-      GCBase::clockDiffSeconds(markRootsStart, scanTransitiveStart);
-  scanTransitiveSecs_ +=
-      GCBase::clockDiffSeconds(scanTransitiveStart, updateWeakRefsStart);
-  updateWeakRefsSecs_ +=
-      GCBase::clockDiffSeconds(updateWeakRefsStart, finalizersStart);
-  finalizersSecs_ += GCBase::clockDiffSeconds(finalizersStart, finalizersEnd);
+      gc_->recordCyclePhase("markRoots", markRootsStart, scanTransitiveStart);
+  scanTransitiveSecs_ += gc_->recordCyclePhase(
+      "scanTransitive", scanTransitiveStart, updateWeakRefsStart);
+  updateWeakRefsSecs_ += gc_->recordCyclePhase(
+      "updateWeakRefs", updateWeakRefsStart, finalizersStart);
+  finalizersSecs_ +=
+      gc_->recordCyclePhase("finalizers", finalizersStart, finalizersEnd);
   // Track the bytes of promoted objects.
   size_t promotedBytes = (nextGen_->used() - oldGenUsedBefore);
   cumPromotedBytes_ += promotedBytes;
+  if (LLVM_UNLIKELY(gc_->telemetry_ != nullptr) && youngGenUsedBefore) {
+    gc_->telemetry_->youngGenSurvival.record(
+        100.0 * promotedBytes / youngGenUsedBefore);
+  }
+  if (GCCycleEvent *event = gc_->currentCycleEvent()) {
+    event->promotedBytes = promotedBytes;
+  }
   ygCollection.addArg("ygPromoted", promotedBytes);
   ygCollection.addArg("ogUsedAfter", nextGen_->used());
   ygCollection.addArg(
@@ -404,6 +444,88 @@ void YoungGen::collect() {
 #endif
 }
 
+void YoungGen::evacuateParallel(
+    const std::vector<std::pair<char *, const char *>> &regions,
+    std::chrono::steady_clock::time_point *markRootsStart,
+    std::chrono::steady_clock::time_point *scanTransitiveStart) {
+  const unsigned numThreads = gc_->numGCThreads_;
+  GreyQueues greyQueues(numThreads);
+  std::vector<std::unique_ptr<ParallelEvacAcceptor>> acceptors;
+  std::vector<std::unique_ptr<SlotVisitor<ParallelEvacAcceptor>>> visitors;
+  for (unsigned i = 0; i < numThreads; ++i) {
+    acceptors.emplace_back(
+        new ParallelEvacAcceptor(*gc_, *this, greyQueues.queue(i)));
+    visitors.emplace_back(
+        new SlotVisitor<ParallelEvacAcceptor>(*acceptors[i]));
+  }
+
+  *markRootsStart = steady_clock::now();
+  {
+    // The roots are visited by the runtime in a single sequence, so they are
+    // marked on this thread, and the cells it promotes are stolen by the
+    // others.
+    PerfSection ygMarkRootsSystraceRegion("ygMarkRoots");
+    DroppingAcceptor<ParallelEvacAcceptor> nameAcceptor{*acceptors[0]};
+    gc_->markRoots(nameAcceptor, /*markLongLived*/ false);
+  }
+
+  *scanTransitiveStart = steady_clock::now();
+  {
+    // Each thread scans the dirty cards of a region at a time, and then helps
+    // scan the promoted cells.
+    PerfSection ygScanTransitiveSystraceRegion("ygScanTransitive");
+    std::atomic<size_t> nextRegion{0};
+    greyQueues.run(
+        [this, &regions, &acceptors, &nextRegion](unsigned i) {
+          for (size_t r = nextRegion++; r < regions.size(); r = nextRegion++) {
+            nextGen_->markYoungGenPointersInRegion(
+                regions[r].first, regions[r].second, *acceptors[i]);
+          }
+        },
+        [this, &visitors](unsigned i, GCCell *cell) {
+          GCBase::markCell(*visitors[i], cell, cell->getVT(), gc_);
+        });
+  }
+
+  for (auto &acceptor : acceptors) {
+#ifndef NDEBUG
+    numReachableObjects_ += acceptor->buffer.numCells();
+    numHiddenClasses_ += acceptor->numHiddenClasses;
+    numLeafHiddenClasses_ += acceptor->numLeafHiddenClasses;
+#endif
+    nextGen_->finishPromotion(acceptor->buffer);
+  }
+}
+
+GCCell *YoungGen::ParallelEvacAcceptor::forward(GCCell *cell) {
+  assert(gen.contains(cell));
+  const VTable *vtp;
+  if (GCCell *forwarded = cell->getMarkedForwardingPointerAtomic(vtp)) {
+    return forwarded;
+  }
+
+  // Copy the cell before trying to forward it, so that whoever sees the
+  // forwarding pointer sees the copy.
+  const uint32_t size = cell->getAllocatedSize(vtp);
+  char *copy = buffer.reserve(size);
+  memcpy(copy, cell, size);
+  auto *newCell = reinterpret_cast<GCCell *>(copy);
+  GCCell *forwarded = cell->setMarkedForwardingPointerAtomic(vtp, newCell);
+  if (forwarded != newCell) {
+    // Another thread got there first; its copy is the one that counts.
+    return forwarded;
+  }
+  buffer.commit();
+#ifndef NDEBUG
+  if (auto *hiddenClass = dyn_vmcast<HiddenClass>(newCell)) {
+    ++numHiddenClasses;
+    numLeafHiddenClasses += hiddenClass->isKnownLeaf();
+  }
+#endif
+  queue.push(newCell);
+  return newCell;
+}
+
 void YoungGen::creditExternalMemory(uint32_t size) {
   GCGeneration::creditExternalMemory(size);
   trueActiveSegment().creditExternalMemory(size);
@@ -475,6 +597,50 @@ GCCell *YoungGen::forwardPointer(GCCell *ptr) {
   return newCell;
 }
 
+void YoungGen::trackAllocationSite(GCCell *cell, AllocationSite *site) {
+  if (site->isPretenured()) {
+    // Large cells from sites that are not pretenured also end up in the old
+    // gen; only count those that were put there because of the site.
+    if (!contains(cell)) {
+      cumPretenuredBytes_ += cell->getAllocatedSize();
+    }
+  } else if (contains(cell) && site->wantsSample()) {
+    siteSamples_.emplace_back(cell, site);
+  }
+}
+
+void YoungGen::dropAllocationSiteSamples() {
+  for (const auto &sample : siteSamples_) {
+    sample.second->dropSample();
+  }
+  siteSamples_.clear();
+}
+
+void YoungGen::recordAllocationSiteFates() {
+  for (const auto &sample : siteSamples_) {
+    if (sample.second->recordFate(sample.first->hasMarkedForwardingPointer())) {
+      ++numPretenuredSites_;
+    }
+  }
+  siteSamples_.clear();
+}
+
+void YoungGen::recordPromotionAges(Histogram &ages) {
+  char *const level = activeSegment().level();
+  char *ptr = activeSegment().start();
+  while (ptr < level) {
+    GCCell *cell = reinterpret_cast<GCCell *>(ptr);
+    // The header of a promoted cell is overwritten by the forwarding pointer,
+    // so its size is read from the copy.
+    if (cell->hasMarkedForwardingPointer()) {
+      ptr += cell->getMarkedForwardingPointer()->getAllocatedSize();
+      ages.record(level - ptr);
+    } else {
+      ptr += cell->getAllocatedSize();
+    }
+  }
+}
+
 void YoungGen::finalizeUnreachableAndTransferReachableObjects() {
   numFinalizedObjects_ = 0;
   for (const auto &cell : cellsWithFinalizers()) {
@@ -507,13 +673,11 @@ gcheapsize_t YoungGen::bytesAllocatedSinceLastGC() const {
   return trueActiveSegment().level() - levelAtEndOfLastGC_;
 }
 
-#ifndef NDEBUG
 void YoungGen::forObjsAllocatedSinceGC(
     const std::function<void(GCCell *)> &callback) {
   trueActiveSegment().forObjsInRange(
       callback, levelAtEndOfLastGC_, trueAllocContext_->activeSegment.level());
 }
-#endif
 
 void YoungGen::moveHeap(GC *gc, ptrdiff_t moveHeapDelta) {
 #if 0 // TODO (T25686322) Non-contiguous heap does not support moving the heap.
@@ -8,6 +8,7 @@
 #define HERMES_PUBLIC_GCCONFIG_H
 
 #include "hermes/Public/CtorConfig.h"
+#include "hermes/Public/GCCycleEvent.h"
 #include "hermes/Public/GCTripwireContext.h"
 #include "hermes/Public/MemoryEventTracker.h"
 
@@ -29,6 +30,14 @@ namespace vm {
 /// it 32-bit).
 using gcheapsize_t = uint32_t;
 
+/// How urgently the OS asks the process to return memory to it.
+enum class MemoryPressure {
+  /// Memory is running low: give back what is not in use.
+  Moderate,
+  /// Memory is about to run out: also collect garbage to free more.
+  Critical,
+};
+
 /// Parameters to control a tripwire function called when the live set size
 /// surpasses a given threshold after collections.  Check documentation in
 /// README.md
@@ -85,9 +94,20 @@ _HERMES_CTORCONFIG_STRUCT(GCSanitizeConfig, GC_HANDLESAN_FIELDS, {});
   /* Whether to Keep track of GC Statistics. */                            \
   F(bool, ShouldRecordStats, false)                                        \
                                                                            \
+  /* Whether to record the distributions of the allocation rate, the */    \
+  /* survival of young objects and the bytes allocated by cell kind. */    \
+  F(bool, ShouldRecordTelemetry, false)                                    \
+                                                                           \
   /* Whether to return unused memory to the OS. */                         \
   F(bool, ShouldReleaseUnused, true)                                       \
                                                                            \
+  /* How long segments that the heap no longer uses are kept, to be */     \
+  /* reused, before they are returned to the OS, if ShouldReleaseUnused */ \
+  /* is false.  By default, they are kept until memory pressure. */        \
+  F(std::chrono::milliseconds,                                             \
+    UnusedSegmentRetention,                                                \
+    std::chrono::milliseconds::max())                                      \
+                                                                           \
   /* Name for this heap in logs. */                                        \
   F(std::string, Name, "HermesRuntime")                                    \
                                                                            \
@@ -101,6 +121,36 @@ _HERMES_CTORCONFIG_STRUCT(GCSanitizeConfig, GC_HANDLESAN_FIELDS, {});
   /* Whether to revert, if necessary, to young-gen allocation at TTI. */   \
   F(bool, RevertToYGAtTTI, false)                                          \
                                                                            \
+  /* Whether to mark the old gen incrementally, between young-gen */       \
+  /* collections, rather than in one full collection pause. */             \
+  F(bool, IncrementalMarking, false)                                       \
+                                                                           \
+  /* Number of threads (including the mutator's) that mark, and update */  \
+  /* references, in full collections.  1 means single-threaded. */         \
+  F(unsigned, NumGCThreads, 1)                                             \
+                                                                           \
+  /* Variable-sized objects of at least this many bytes are allocated */   \
+  /* in segments of their own, which compactions do not move.  0 means */  \
+  /* that all objects share the generations' segments. */                  \
+  F(gcheapsize_t, LargeObjectThreshold, 0)                                 \
+                                                                           \
+  /* Verify the cells of one heap segment, chosen at random, and the */    \
+  /* cells they point to, after every this many collections, and fail */   \
+  /* fatally if one is corrupt.  Unlike the slow debug checks, this */     \
+  /* works in any build, so that heap corruption can be caught in */       \
+  /* production close to its cause.  0 disables it. */                     \
+  F(unsigned, HeapVerificationInterval, 0)                                 \
+                                                                           \
+  /* Whether to reserve the address space of the maximum heap size up */   \
+  /* front, as one region backed by transparent huge pages where the */    \
+  /* OS supports them, so that the heap needs fewer TLB entries. */        \
+  F(bool, HugePages, false)                                                \
+                                                                           \
+  /* Called with a record of each collection, when it finishes. */         \
+  F(std::function<void(const GCCycleEvent &)>,                             \
+    CycleEventCallback,                                                    \
+    nullptr)                                                               \
+                                                                           \
   /* Pointer to the memory profiler (Memory Event Tracker). */             \
   F(std::shared_ptr<MemoryEventTracker>, MemEventTracker, nullptr)         \
   /* GC_FIELDS END */
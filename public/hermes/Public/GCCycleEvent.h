@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifndef HERMES_PUBLIC_GCCYCLEEVENT_H
+#define HERMES_PUBLIC_GCCYCLEEVENT_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace hermes {
+namespace vm {
+
+/// A record of a single garbage collection, passed to the CycleEventCallback
+/// of the GCConfig when the collection finishes.  Times are in seconds, and
+/// sizes in bytes.  The strings are static.
+struct GCCycleEvent {
+  /// The kind of collection: "young" or "full".
+  const char *kind{""};
+  /// What started the collection: "allocation" when the heap was too full to
+  /// allocate, "explicit" when it was requested, "idle" when it was done in
+  /// idle time, or "marking complete" when the old generation was marked
+  /// incrementally, and only needed to be finished.
+  const char *cause{""};
+
+  /// The wall time and CPU time of the collection pause.
+  double wallTime{0};
+  double cpuTime{0};
+
+  /// The bytes in use, and the size of the heap, before and after the
+  /// collection.
+  uint64_t allocatedBefore{0};
+  uint64_t sizeBefore{0};
+  uint64_t allocatedAfter{0};
+  uint64_t sizeAfter{0};
+
+  /// The bytes that a young collection moved to the old generation.
+  uint64_t promotedBytes{0};
+
+  /// The wall time of each phase of the collection, in the order they
+  /// finished.  This includes the phases of marking the roots
+  /// ("MarkRoots_<Kind>"), every time the roots were visited.
+  std::vector<std::pair<const char *, double>> phases;
+};
+
+} // namespace vm
+} // namespace hermes
+
+#endif // HERMES_PUBLIC_GCCYCLEEVENT_H
@@ -11,7 +11,9 @@
 #include "hermes/Public/CtorConfig.h"
 #include "hermes/Public/GCConfig.h"
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace hermes {
 namespace vm {
@@ -29,18 +31,51 @@ class PinnedHermesValue;
   /* Register Stack Size */                                            \
   F(unsigned, MaxNumRegisters, 1024 * 1024)                            \
                                                                        \
+  /* Precede the register stack with a guard region, detected by a */  \
+  /* SIGSEGV handler, so that most calls don't check its size. */      \
+  /* Only used if the register stack isn't pre-allocated. */          \
+  /* The handler is process-wide and chains to the SIGSEGV and */      \
+  /* SIGBUS handlers installed before the first runtime using it, */   \
+  /* so crash reporters must be installed first, and must not be */    \
+  /* replaced later without chaining to it. */                         \
+  F(bool, RegisterStackGuard, false)                                   \
+                                                                       \
   /* Whether or not the JIT is enabled */                              \
   F(bool, EnableJIT, false)                                            \
                                                                        \
+  /* Number of calls after which the JIT compiles a function */       \
+  F(unsigned, JITInvocationThreshold, 10)                              \
+                                                                       \
+  /* Number of loop back-edges taken in the interpreter after which */ \
+  /* the JIT compiles a function. */                                   \
+  F(unsigned, JITLoopThreshold, 1000)                                  \
+                                                                       \
+  /* Number of searches after which the JIT compiles a regex */        \
+  F(unsigned, JITRegExpThreshold, 10)                                  \
+                                                                       \
+  /* Whether the JIT compiles functions on a background thread */      \
+  F(bool, JITBackgroundCompilation, false)                             \
+                                                                       \
+  /* Maximum bytes of executable memory used by the JIT. The least */  \
+  /* recently used native code is evicted when it is exhausted. */     \
+  F(unsigned, JITMemoryLimit, (1 << 20) * 32)                          \
+                                                                       \
   /* Whether to allow eval and Function ctor */                        \
   F(bool, EnableEval, true)                                            \
                                                                        \
   /* Whether to verify the IR generated by eval and Function ctor */   \
   F(bool, VerifyEvalIR, false)                                         \
                                                                        \
+  /* Maximum bytes of source and bytecode kept by the cache of the */  \
+  /* code compiled by eval and the Function ctor. 0 disables it. */    \
+  F(unsigned, EvalCacheBytes, 1 << 20)                                 \
+                                                                       \
   /* Support for ES6 Symbol. */                                        \
   F(bool, ES6Symbol, true)                                             \
                                                                        \
+  /* Support for ES6 Promise. */                                       \
+  F(bool, ES6Promise, true)                                            \
+                                                                       \
   /* Enable sampling certain statistics. */                            \
   F(bool, EnableSampledStats, false)                                   \
                                                                        \
@@ -53,6 +88,11 @@ class PinnedHermesValue;
   /* Eagerly read bytecode into page cache. */                         \
   F(unsigned, BytecodeWarmupPercent, 0)                                \
                                                                        \
+  /* Pages of the bytecode to read into page cache on a background */  \
+  /* thread, in order, e.g. those first touched by a previous run */   \
+  /* (see TrackIO). Takes precedence over BytecodeWarmupPercent. */    \
+  F(std::vector<uint32_t>, BytecodeWarmupPages)                        \
+                                                                       \
   /* Signal-based I/O tracking. Slows down execution. If enabled, */   \
   /* all bytecode buffers > 64 kB passed to Hermes must be mmap:ed. */ \
   F(bool, TrackIO, false)                                              \
@@ -62,6 +102,11 @@ class PinnedHermesValue;
                                                                        \
   /* The flags passed from a VM experiment */                          \
   F(uint32_t, VMExperimentFlags, 0)                                    \
+                                                                       \
+  /* If non-zero, every this many garbage collections, release the */  \
+  /* data derived from the bytecode of the functions that didn't */    \
+  /* run since the previous release, rebuilt if they run again. */     \
+  F(unsigned, CodeBlockIdleGCs, 0)                                     \
   /* RUNTIME_FIELDS END */
 
 _HERMES_CTORCONFIG_STRUCT(RuntimeConfig, RUNTIME_FIELDS, {});
@@ -0,0 +1,29 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -target=HBC -dump-ra -O %s | %FileCheck --match-full-lines %s
+
+// Forwarding the arguments with apply() doesn't reify them.
+//CHECK-LABEL:function forward(fn){{.*}}
+//CHECK-NEXT:frame = []
+//CHECK-NEXT:%BB0:
+//CHECK-NEXT:  {{.*}} %0 = AllocStackInst $arguments
+//CHECK-NOT:{{.*}}HBCReifyArgumentsInst{{.*}}
+//CHECK:  {{.*}} = HBCCallApplyArgumentsInst {{.*}}, %0
+//CHECK-NOT:{{.*}}HBCReifyArgumentsInst{{.*}}
+//CHECK:function_end
+function forward(fn) {
+  return fn.apply(this, arguments);
+}
+
+// Other uses still reify them.
+//CHECK-LABEL:function forwardTwice(fn){{.*}}
+//CHECK:  {{.*}} = HBCCallApplyArgumentsInst {{.*}}, %0
+//CHECK:  {{.*}} = HBCReifyArgumentsInst %0
+//CHECK:function_end
+function forwardTwice(fn) {
+  fn.apply(this, arguments);
+  return fn.call(this, arguments);
+}
@@ -0,0 +1,32 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -target=HBC -dump-bytecode -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O %s | %FileCheck --check-prefix=CHKRUN --match-full-lines %s
+
+// Both operands are known to be numbers, so the comparisons and the
+// arithmetic skip the type checks.
+function binaryNumber(a, b) {
+  var x = +a, y = +b;
+  print(x < y, x <= y, x > y, x >= y);
+  print(x + y, x - y, x * y, x / y);
+}
+
+binaryNumber(1, "2");
+binaryNumber(3, NaN);
+//CHKRUN:true true false false
+//CHKRUN-NEXT:3 -1 2 0.5
+//CHKRUN-NEXT:false false false false
+//CHKRUN-NEXT:NaN NaN NaN NaN
+
+//CHECK-LABEL:Function<binaryNumber>(3 params, {{.*}} registers, {{.*}} symbols):
+//CHECK:    LessN             r{{.*}}, r{{.*}}, r{{.*}}
+//CHECK:    LessEqN           r{{.*}}, r{{.*}}, r{{.*}}
+//CHECK:    GreaterN          r{{.*}}, r{{.*}}, r{{.*}}
+//CHECK:    GreaterEqN        r{{.*}}, r{{.*}}, r{{.*}}
+//CHECK:    AddN              r{{.*}}, r{{.*}}, r{{.*}}
+//CHECK:    SubN              r{{.*}}, r{{.*}}, r{{.*}}
+//CHECK:    MulN              r{{.*}}, r{{.*}}, r{{.*}}
+//CHECK:    DivN              r{{.*}}, r{{.*}}, r{{.*}}
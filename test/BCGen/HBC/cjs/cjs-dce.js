@@ -59,6 +59,5 @@ foo();
 //CHECK-NEXT:0: start = L4, end = L5, target = L1
 
 // CHECK: Function<foo>(1 params, 1 registers, 0 symbols):
-// CHECK-NEXT:     GetEnvironment    r0, 0
-// CHECK-NEXT:     LoadFromEnvironment r0, r0, 0
+// CHECK-NEXT:     LoadFromOuterEnvironment r0, 0, 0
 // CHECK-NEXT:     Ret               r0
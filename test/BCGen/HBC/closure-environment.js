@@ -0,0 +1,56 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -target=HBC -dump-bytecode -O %s | %FileCheck --match-full-lines --check-prefix=CHKOUTER %s
+// RUN: %hermes -target=HBC -dump-bytecode -O %s | %FileCheck --match-full-lines --check-prefix=CHKNESTED %s
+// RUN: %hermes -target=HBC -dump-bytecode -O %s | %FileCheck --match-full-lines --check-prefix=CHKCAPT %s
+// RUN: %hermes -O %s | %FileCheck --check-prefix=CHKRUN --match-full-lines %s
+
+// The callback captures nothing, so it is given the environment of outer().
+function outer(arr) {
+  return arr.map(function (x) { return x * 2; });
+}
+
+// The closures only capture the variables of the callback.
+function nested(arr) {
+  return arr.map(function (x) {
+    var y = x + 1;
+    return function () { return y; };
+  });
+}
+
+// The callback captures k, which needs an environment.
+function captures(arr) {
+  var k = 3;
+  return arr.map(function (x) { return x * k; });
+}
+
+print(outer([1, 2]), outer([3]));
+print(nested([1, 2])[1](), nested([3])[0]());
+print(captures([1, 2]), captures([3]));
+//CHKRUN:2,4 6
+//CHKRUN-NEXT:3 4
+//CHKRUN-NEXT:3,6 9
+
+//CHKOUTER-LABEL:Function<outer>(2 params, {{.*}} registers, {{.*}} symbols):
+//CHKOUTER-NEXT:Offset in debug table: {{.*}}
+//CHKOUTER-NOT:    CreateEnvironment {{.*}}
+//CHKOUTER:    GetEnvironment    [[ENV:r[0-9]+]], 0
+//CHKOUTER-NOT:    CreateEnvironment {{.*}}
+//CHKOUTER:    CreateClosure     {{r[0-9]+}}, [[ENV]], {{[0-9]+}}
+//CHKOUTER:    Ret               {{r[0-9]+}}
+
+//CHKNESTED-LABEL:Function<nested>(2 params, {{.*}} registers, {{.*}} symbols):
+//CHKNESTED-NEXT:Offset in debug table: {{.*}}
+//CHKNESTED-NOT:    CreateEnvironment {{.*}}
+//CHKNESTED:    GetEnvironment    [[ENV:r[0-9]+]], 0
+//CHKNESTED-NOT:    CreateEnvironment {{.*}}
+//CHKNESTED:    CreateClosure     {{r[0-9]+}}, [[ENV]], {{[0-9]+}}
+//CHKNESTED:    Ret               {{r[0-9]+}}
+
+//CHKCAPT-LABEL:Function<captures>(2 params, {{.*}} registers, {{.*}} symbols):
+//CHKCAPT-NEXT:Offset in debug table: {{.*}}
+//CHKCAPT-NEXT:    CreateEnvironment [[ENV:r[0-9]+]]
+//CHKCAPT:    CreateClosure     {{r[0-9]+}}, [[ENV]], {{[0-9]+}}
@@ -11,7 +11,7 @@
 //CHECK-NEXT:    CreateEnvironment r0
 //CHECK-NEXT:    CreateClosure     r1, r0, 1
 //CHECK-NEXT:    GetGlobalObject   r0
-//CHECK-NEXT:    PutById           r0, r1, 1, "test1"
+//CHECK-NEXT:    PutByIdShort      r0, r1, 1, "test1"
 //CHECK-NEXT:    LoadConstUndefined r0
 //CHECK-NEXT:    DebuggerCheckBreak
 //CHECK-NEXT:    Ret               r0
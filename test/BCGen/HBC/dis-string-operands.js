@@ -17,9 +17,9 @@ delete glob.baz;
 //CHECK:    DeclareGlobalVar  "re"
 //CHECK:    TryGetById        {{r[0-9]+}}, {{r[0-9]+}}, 1, "bar"
 //CHECK:    PutNewOwnByIdShort   {{r[0-9]+}}, {{r[0-9]+}}, "prop"
-//CHECK:    PutById           {{r[0-9]+}}, {{r[0-9]+}}, 1, "glob"
+//CHECK:    PutByIdShort      {{r[0-9]+}}, {{r[0-9]+}}, 1, "glob"
 //CHECK:    CreateRegExp      {{r[0-9]+}}, "foo", "i", 0
-//CHECK:    PutById           {{r[0-9]+}}, {{r[0-9]+}}, 2, "re"
+//CHECK:    PutByIdShort      {{r[0-9]+}}, {{r[0-9]+}}, 2, "re"
 //CHECK:    GetByIdShort      {{r[0-9]+}}, {{r[0-9]+}}, 2, "glob"
 //CHECK:    GetByIdShort      {{r[0-9]+}}, {{r[0-9]+}}, 3, "baz"
 //CHECK:    LoadConstString   {{r[0-9]+}}, "const-string"
@@ -0,0 +1,32 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -target=HBC -dump-bytecode -O %s | %FileCheck --match-full-lines %s
+
+function sum(seq) {
+  var s = 0;
+  for (var x of seq)
+    s += x;
+  return s;
+}
+
+function find(seq, v) {
+  for (var x of seq) {
+    if (x === v)
+      break;
+  }
+}
+
+//CHECK-LABEL:Function<sum>(2 params, {{.*}} registers, 0 symbols):
+//CHECK:    IteratorBegin     [[ITER:r[0-9]+]], [[SRC:r[0-9]+]]
+//CHECK:    IteratorNext      {{r[0-9]+}}, [[ITER]], [[SRC]]
+//CHECK:    IteratorClose     {{r[0-9]+}}, 1
+
+// Breaking out of the loop closes the iterator, propagating exceptions.
+//CHECK-LABEL:Function<find>(3 params, {{.*}} registers, 0 symbols):
+//CHECK:    IteratorBegin     [[ITER:r[0-9]+]], [[SRC:r[0-9]+]]
+//CHECK:    IteratorNext      {{r[0-9]+}}, [[ITER]], [[SRC]]
+//CHECK-DAG:    IteratorClose     {{r[0-9]+}}, 0
+//CHECK-DAG:    IteratorClose     {{r[0-9]+}}, 1
@@ -0,0 +1,34 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: printf "2\n\n1\n2\n100\n" > %t.order
+// RUN: %hermes -O -emit-binary -target=HBC -function-order=%t.order -out=%t.hbc %s
+// RUN: %hermes %t.hbc | %FileCheck --match-full-lines %s
+// RUN: %hbcdump -show-section-ranges %t.hbc | %FileCheck --check-prefix=SECTIONS %s
+// RUN: printf "abc\n" > %t.bad
+// RUN: not %hermes -O -emit-binary -target=HBC -function-order=%t.bad -out=%t.hbc %s 2>&1 | %FileCheck --check-prefix=BAD %s
+
+// Functions laid out out of ID order still run, and the listed IDs that do
+// not exist are ignored.
+
+function first(x) {
+  try {
+    return second(x) + 1;
+  } catch (e) {
+    return -1;
+  }
+}
+
+function second(x) {
+  return x * 2;
+}
+
+print(first(20));
+// CHECK: 41
+
+// SECTIONS: Function body: [{{[0-9]+}}, {{[0-9]+}})
+// SECTIONS: Function info: [{{[0-9]+}}, {{[0-9]+}})
+
+// BAD: Error! Invalid function ID in {{.*}}: abc
@@ -15,7 +15,7 @@ y = x;
 //CHECK-NEXT:    DeclareGlobalVar  "x"
 //CHECK-NEXT:    LoadConstUInt8    r0, 5
 //CHECK-NEXT:    GetGlobalObject   r1
-//CHECK-NEXT:    PutById           r1, r0, 1, "x"
+//CHECK-NEXT:    PutByIdShort      r1, r0, 1, "x"
 //CHECK-NEXT:    TryGetById        r3, r1, 1, "foo"
 //CHECK-NEXT:    GetByIdShort      r2, r1, 2, "x"
 //CHECK-NEXT:    LoadConstUndefined r0
@@ -29,11 +29,11 @@ y = x;
 //CHKNONSTRICT-NEXT:    DeclareGlobalVar  "x"
 //CHKNONSTRICT-NEXT:    LoadConstUInt8    r0, 5
 //CHKNONSTRICT-NEXT:    GetGlobalObject   r1
-//CHKNONSTRICT-NEXT:    PutById           r1, r0, 1, "x"
+//CHKNONSTRICT-NEXT:    PutByIdShort      r1, r0, 1, "x"
 //CHKNONSTRICT-NEXT:    TryGetById        r3, r1, 1, "foo"
 //CHKNONSTRICT-NEXT:    GetByIdShort      r2, r1, 2, "x"
 //CHKNONSTRICT-NEXT:    LoadConstUndefined r0
 //CHKNONSTRICT-NEXT:    Call2             r0, r3, r0, r2
 //CHKNONSTRICT-NEXT:    GetByIdShort      r0, r1, 2, "x"
-//CHKNONSTRICT-NEXT:    PutById           r1, r0, 2, "y"
+//CHKNONSTRICT-NEXT:    PutByIdShort      r1, r0, 2, "y"
 //CHKNONSTRICT-NEXT:    Ret               r0
@@ -0,0 +1,20 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -emit-binary -target=HBC -out=%t.hbc %s
+// RUN: printf '{"samples":[{"sf":1,"weight":"1"},{"sf":2,"weight":"1"},{"sf":2,"weight":"1"}],"stackFrames":{"1":{"name":"global","category":"JavaScript","funcVirtAddr":"0","offset":"0"},"2":{"name":"[Native]1","category":"Native","parent":1}}}' > %t.json
+// RUN: %hbcdump -sampling-profile=%t.json -c "hot;quit" %t.hbc | %FileCheck %s
+
+// The samples of native code count towards the total, and only the functions
+// sampled themselves are ranked.
+
+var sum = 0;
+for (var i = 0; i < 10; ++i) {
+  sum += i;
+}
+print(sum);
+
+// CHECK: Self(%){{ +}}Total(%){{ +}}Samples(#){{ +}}Size{{ +}}Samples/KB{{ +}}Opcodes{{ +}}Flags{{ +}}Function{{ +}}Source
+// CHECK-NEXT: 33.33%{{ +}}100.00%{{ +}}1{{ +}}{{[0-9]+ +[0-9.]+ +.+}}jit{{ +}}global
@@ -0,0 +1,23 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O -dump-bytecode -target=HBC %s | %FileCheck %s
+
+// Both functions create the first copy of the identical inner functions, so
+// their bodies are identical too.
+
+function outer1() {
+  return function() { return 1; };
+}
+
+function outer2() {
+  return function() { return 1; };
+}
+
+//CHECK-LABEL: Function<outer1>{{.*}}:
+//CHECK:    CreateClosure {{r[0-9]+}}, {{r[0-9]+}}, [[INNER:[0-9]+]]
+
+//CHECK-LABEL: Function<outer2>{{.*}}:
+//CHECK:    CreateClosure {{r[0-9]+}}, {{r[0-9]+}}, [[INNER]]
@@ -18,9 +18,8 @@ try {
   //RA-LABEL:function local()
   //RA-NEXT: frame = []
   //RA-NEXT: %BB0:
-  //RA-NEXT:   {{.*}} %0 = HBCResolveEnvironment %global()
-  //RA-NEXT:   {{.*}} %1 = HBCLoadFromEnvironmentInst %0, [?anon_1_e@global]
-  //RA-NEXT:   {{.*}} %2 = ReturnInst %1
+  //RA-NEXT:   {{.*}} %0 = HBCLoadFromOuterEnvironmentInst [?anon_1_e@global]
+  //RA-NEXT:   {{.*}} %1 = ReturnInst %0
   //RA-NEXT: function_end
   local = function() { return e; };
 }
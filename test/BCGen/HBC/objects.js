@@ -21,10 +21,10 @@ function foo(p) {
 //CHECK-NEXT:[@ {{.*}}] NewObject 0<Reg8>
 //CHECK-NEXT:[@ {{.*}}] LoadConstUInt8 2<Reg8>, 1<UInt8>
 //CHECK-NEXT:[@ {{.*}}] PutNewOwnByIdShort 0<Reg8>, 2<Reg8>, 1<UInt8>
-//CHECK-NEXT:[@ {{.*}}] PutById 0<Reg8>, 2<Reg8>,  1<UInt8>, 1<UInt16>
+//CHECK-NEXT:[@ {{.*}}] PutByIdShort 0<Reg8>, 2<Reg8>,  1<UInt8>, 1<UInt8>
 //CHECK-NEXT:[@ {{.*}}] PutByVal 0<Reg8>, 1<Reg8>, 2<Reg8>
 //CHECK-NEXT:[@ {{.*}}] GetByIdShort 2<Reg8>, 0<Reg8>, 1<UInt8>, 1<UInt8>
-//CHECK-NEXT:[@ {{.*}}] PutById 0<Reg8>, 2<Reg8>, 2<UInt8>, 2<UInt16>
+//CHECK-NEXT:[@ {{.*}}] PutByIdShort 0<Reg8>, 2<Reg8>, 2<UInt8>, 2<UInt8>
 //CHECK-NEXT:[@ {{.*}}] GetByVal 3<Reg8>, 0<Reg8>, 1<Reg8>
 //CHECK-NEXT:[@ {{.*}}] LoadConstUInt8 2<Reg8>, 2<UInt8>
 //CHECK-NEXT:[@ {{.*}}] PutByVal 0<Reg8>, 2<Reg8>, 3<Reg8>
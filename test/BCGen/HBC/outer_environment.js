@@ -0,0 +1,61 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -target=HBC -dump-bytecode -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O %s | %FileCheck --check-prefix=CHKRUN --match-full-lines %s
+
+function outer() {
+  var a = 1;
+  var b = 2;
+  function setA(v) { a = v; }
+  // a and b are read on every iteration, but the environment is only
+  // resolved once.
+  function sumLoop(n) {
+    var sum = 0;
+    for (var i = 0; i < n; ++i) {
+      if (i & 1)
+        sum += a;
+      else
+        sum += b;
+    }
+    return sum;
+  }
+  // The environment is only used once, so it isn't kept in a register.
+  function once() { return a; }
+  function deep(c) {
+    return function deepInner() { return b + c; };
+  }
+  return [setA, sumLoop, once, deep];
+}
+
+var fns = outer();
+print(fns[1](4), fns[2](), fns[3](10)());
+fns[0](5);
+print(fns[1](4), fns[2]());
+//CHKRUN:6 1 12
+//CHKRUN-NEXT:14 5
+
+//CHECK-LABEL:Function<sumLoop>(2 params, {{.*}} registers, {{.*}} symbols):
+//CHECK-NEXT:Offset in debug table: {{.*}}
+//CHECK-NOT:    LoadFromOuterEnvironment {{.*}}
+//CHECK:    GetEnvironment    [[ENV:r[0-9]+]], 0
+//CHECK-NOT:    GetEnvironment {{.*}}
+//CHECK:    LoadFromEnvironment {{r[0-9]+}}, [[ENV]], {{[0-9]+}}
+//CHECK-NOT:    GetEnvironment {{.*}}
+//CHECK:    LoadFromEnvironment {{r[0-9]+}}, [[ENV]], {{[0-9]+}}
+//CHECK-NOT:    GetEnvironment {{.*}}
+//CHECK:    Ret               {{r[0-9]+}}
+
+//CHECK-LABEL:Function<once>(1 params, 1 registers, 0 symbols):
+//CHECK-NEXT:Offset in debug table: {{.*}}
+//CHECK-NEXT:    LoadFromOuterEnvironment r0, 0, {{[0-9]+}}
+//CHECK-NEXT:    Ret               r0
+
+//CHECK-LABEL:Function<deepInner>(1 params, {{.*}} registers, 0 symbols):
+//CHECK-NEXT:Offset in debug table: {{.*}}
+//CHECK-NEXT:    LoadFromOuterEnvironment {{r[0-9]+}}, 1, {{[0-9]+}}
+//CHECK-NEXT:    LoadFromOuterEnvironment {{r[0-9]+}}, 0, 0
+//CHECK-NEXT:    Add               {{r[0-9]+}}, {{r[0-9]+}}, {{r[0-9]+}}
+//CHECK-NEXT:    Ret               {{r[0-9]+}}
@@ -0,0 +1,38 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -target=HBC -dump-bytecode -O %s | %FileCheck --match-full-lines %s
+
+function isString(x) {
+  return typeof x === "string";
+}
+
+function isNotFunction(x) {
+  return "function" != typeof x;
+}
+
+function typeAndCheck(x) {
+  var t = typeof x;
+  return [t, t === "number"];
+}
+
+//CHECK-LABEL:Function<isString>(2 params, {{.*}} registers, 0 symbols):
+//CHECK-NEXT:Offset in debug table: {{.*}}
+//CHECK-NEXT:    LoadParam         [[X:r[0-9]+]], 1
+//CHECK-NEXT:    TypeOfIs          [[R:r[0-9]+]], [[X]], 4
+//CHECK-NEXT:    Ret               [[R]]
+
+//CHECK-LABEL:Function<isNotFunction>(2 params, {{.*}} registers, 0 symbols):
+//CHECK-NEXT:Offset in debug table: {{.*}}
+//CHECK-NEXT:    LoadParam         [[X:r[0-9]+]], 1
+//CHECK-NEXT:    TypeOfIs          [[R:r[0-9]+]], [[X]], 95
+//CHECK-NEXT:    Ret               [[R]]
+
+// The typeof is kept when its string is used for more than the comparison.
+//CHECK-LABEL:Function<typeAndCheck>(2 params, {{.*}} registers, 0 symbols):
+//CHECK-NOT:    TypeOfIs {{.*}}
+//CHECK:    TypeOf            {{r[0-9]+}}, {{r[0-9]+}}
+//CHECK-NOT:    TypeOfIs {{.*}}
+//CHECK:    Ret               {{r[0-9]+}}
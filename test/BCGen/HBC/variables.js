@@ -166,8 +166,7 @@ function daa(a) {
 //CHKOPT-LABEL:function daa_capture() : undefined|string|number
 //CHKOPT-NEXT:frame = []
 //CHKOPT-NEXT:%BB0:
-//CHKOPT-NEXT:  %0 = HBCResolveEnvironment %daa()
-//CHKOPT-NEXT:  %1 = HBCLoadFromEnvironmentInst %0, [b@daa] : undefined|string|number
-//CHKOPT-NEXT:  %2 = ReturnInst %1
+//CHKOPT-NEXT:  %0 = HBCLoadFromOuterEnvironmentInst [b@daa] : undefined|string|number
+//CHKOPT-NEXT:  %1 = ReturnInst %0
 //CHKOPT-NEXT:function_end
 
@@ -25,7 +25,7 @@ exports.bar = bar;
 //CHKOPT-NEXT:    CreateEnvironment r0
 //CHKOPT-NEXT:    CreateClosure     r1, r0, 2
 //CHKOPT-NEXT:    LoadParam         r0, 1
-//CHKOPT-NEXT:    PutById           r0, r1, 1, "bar"
+//CHKOPT-NEXT:    PutByIdShort      r0, r1, 1, "bar"
 //CHKOPT-NEXT:    LoadConstUndefined r0
 //CHKOPT-NEXT:    Ret               r0
 
@@ -62,7 +62,7 @@ exports.bar = bar;
 //CHKDBG-NEXT:     Call              r10, r9, 1
 //CHKDBG-NEXT:     LoadFromEnvironment r10, r0, 2
 //CHKDBG-NEXT:     LoadFromEnvironment r11, r0, 1
-//CHKDBG-NEXT:     PutById           r10, r11, 1, "bar"
+//CHKDBG-NEXT:     PutByIdShort      r10, r11, 1, "bar"
 //CHKDBG-NEXT:     Ret               r4
 
 //CHKDBG-LABEL: Function<bar>(1 params, 16 registers, 1 symbols):
@@ -0,0 +1,16 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermesc -commonjs -fstatic-require -dump-bytecode %s %S/m1.js %S/m2.js -O | %FileCheck --match-full-lines %s
+// RUN: %hermes -commonjs -fstatic-require %s %S/m1.js %S/m2.js -O | %FileCheck --match-full-lines --check-prefix=CHKRUN %s
+
+// m2.js is never required, so its module body is removed.
+var m1 = require("./m1.js");
+m1.foo();
+//CHKRUN: foo
+
+//CHECK-NOT:{{.*}}baz{{.*}}
+//CHECK:    Throw {{r[0-9]+}}
+//CHECK-NOT:{{.*}}baz{{.*}}
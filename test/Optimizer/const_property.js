@@ -10,10 +10,7 @@
 //CHECK-LABEL:function module1() : number
 //CHECK-NEXT:frame = []
 //CHECK-NEXT:    %BB0:
-//CHECK-NEXT:%0 = AllocObjectInst 2 : number, empty
-//CHECK-NEXT:%1 = StoreNewOwnPropertyInst 1 : number, %0 : object, "a" : string, true : boolean
-//CHECK-NEXT:%2 = StoreNewOwnPropertyInst 2 : number, %0 : object, "b" : string, true : boolean
-//CHECK-NEXT:%3 = ReturnInst 3 : number
+//CHECK-NEXT:%0 = ReturnInst 3 : number
 //CHECK-NEXT:function_end
 function module1() {
   var o = { a : 1, b : 2 };
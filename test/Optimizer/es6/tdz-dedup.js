@@ -131,3 +131,33 @@ function check_after_check() {
 //CHKOPT-NEXT:%BB4:
 //CHKOPT-NEXT:  %17 = ReturnInst undefined : undefined
 //CHKOPT-NEXT:function_end
+
+function check_after_merge() {
+    function merge_inner(p) {
+        if (p)
+            x;
+        else
+            x;
+        return x;
+    }
+    let x = 0;
+    return merge_inner;
+}
+// The check after the merge is redundant, although no check dominates it.
+//CHKOPT-LABEL:function merge_inner(p)
+//CHKOPT:{{.*}}ThrowIfUndefinedInst{{.*}}
+//CHKOPT:{{.*}}ThrowIfUndefinedInst{{.*}}
+//CHKOPT-NOT:{{.*}}ThrowIfUndefinedInst{{.*}}
+//CHKOPT:function_end
+
+function check_in_closure() {
+    let x = 1;
+    const y = 2;
+    return function closure_inner() {
+        return x + y;
+    };
+}
+// The closure is only created after x and y are initialized.
+//CHKOPT-LABEL:function closure_inner()
+//CHKOPT-NOT:{{.*}}ThrowIfUndefinedInst{{.*}}
+//CHKOPT:function_end
@@ -0,0 +1,39 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -dump-ra %s -O | %FileCheck --match-full-lines %s
+
+// Nothing in the loop writes to memory, so the length of the array is
+// invariant.
+function hoist_length() {
+  var a = [1, 2, 3];
+  var n = 0;
+  for (var i = 0; i < a.length; i++) {
+    n += i;
+  }
+  return n;
+}
+
+//CHECK-LABEL:function hoist_length(){{.*}}
+//CHECK:  {{.*}}  %{{.*}} = AllocArrayInst 3 : number{{.*}}
+//CHECK:  {{.*}}  %{{.*}} = LoadPropertyInst %{{.*}}, "length" : string
+//CHECK-NEXT:  {{.*}}  %{{.*}} = {{.*}}BranchInst {{.*}}
+//CHECK-NOT:  {{.*}}"length"{{.*}}
+//CHECK-LABEL:function_end
+
+// The call may change the length of the array, so it is loaded on every
+// iteration.
+function dont_hoist_length() {
+  var a = [1, 2, 3];
+  for (var i = 0; i < a.length; i++) {
+    a.push(i);
+  }
+}
+
+//CHECK-LABEL:function dont_hoist_length(){{.*}}
+//CHECK:  {{.*}}  %{{.*}} = AllocArrayInst 3 : number{{.*}}
+//CHECK:%BB1:
+//CHECK:  {{.*}}  %{{.*}} = LoadPropertyInst %{{.*}}, "length" : string
+//CHECK-LABEL:function_end
@@ -0,0 +1,32 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: echo "%s:21:15 5000" > %t.profile
+// RUN: echo "%s:21:27 10" >> %t.profile
+// RUN: %hermes -target=HBC -O -dump-ir -inline-profile=%t.profile %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -target=HBC -O -dump-ir %s | %FileCheck --match-full-lines %s -check-prefix NOPROFILE
+// RUN: echo "%s:21:15" > %t.bad
+// RUN: (! %hermes -target=HBC -O -dump-ir -inline-profile=%t.bad %s 2>&1) | %FileCheck --match-full-lines %s -check-prefix BAD
+
+// BAD: Error! Invalid call count in {{.*}}
+
+// Only the first call is hot, so only it is inlined.
+function foo(a) {
+    var add = function(x, y) {
+        return x + y;
+    }
+    // Line 21.
+    return add(a, 1) + add(a, 2);
+}
+//CHECK-LABEL:function foo(a){{.*}}
+//CHECK-NOT:{{.*}}CallInst {{.*}}, %a, 1 : number
+//CHECK:{{.*}} = BinaryOperatorInst '+', %a, 1 : number
+//CHECK:{{.*}} = CallInst %{{[0-9]+}}, undefined : undefined, %a, 2 : number
+//CHECK:function_end
+
+//NOPROFILE-LABEL:function foo(a){{.*}}
+//NOPROFILE:{{.*}} = CallInst %{{[0-9]+}}, undefined : undefined, %a, 1 : number
+//NOPROFILE:{{.*}} = CallInst %{{[0-9]+}}, undefined : undefined, %a, 2 : number
+//NOPROFILE:function_end
@@ -0,0 +1,37 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -target=HBC -O -dump-ir %s | %FileCheck --match-full-lines %s
+
+function sum(a, b) {
+  var o = {x: a, y: b};
+  o.y = o.x;
+  return o.x + o.y;
+}
+//CHECK-LABEL:function sum(a, b) : string|number
+//CHECK-NEXT:frame = []
+//CHECK-NEXT:%BB0:
+//CHECK-NEXT:  %0 = BinaryOperatorInst '+', %a, %a
+//CHECK-NEXT:  %1 = ReturnInst %0 : string|number
+//CHECK-NEXT:function_end
+
+// The prototype may have a property z.
+function missing(a) {
+  var o = {x: a};
+  return o.z;
+}
+//CHECK-LABEL:function missing(a)
+//CHECK:  %0 = AllocObjectInst 1 : number, empty
+//CHECK:function_end
+
+// The object escapes to the call.
+function escapes(a, f) {
+  var o = {x: a};
+  f(o);
+  return o.x;
+}
+//CHECK-LABEL:function escapes(a, f)
+//CHECK:  %0 = AllocObjectInst 1 : number, empty
+//CHECK:function_end
@@ -0,0 +1,15 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermesc -Xlexer-only %s | %FileCheck --match-full-lines %s
+// REQUIRES: debug_options
+
+// Timing this command on a large bundle measures the lexer alone.
+
+var longIdentifierNameForTheLexer = 'a string literal that spans chunks';
+/* a block comment that spans several chunks of the input */
+print(longIdentifierNameForTheLexer);
+
+//CHECK: 10 tokens lexed
@@ -0,0 +1,50 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O -linear-scan-threshold=0 %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O0 -linear-scan-threshold=0 %s | %FileCheck --match-full-lines %s
+// Ensure that the conservative intervals of the linear scan keep the values
+// that are live around loops.
+
+function swap(a, b, n) {
+  var t;
+  for (var i = 0; i < n; ++i) {
+    t = a;
+    a = b;
+    b = t;
+  }
+  return a + "," + b;
+}
+
+function nested(n) {
+  var outer = n * 2;
+  var sum = 0;
+  for (var i = 0; i < n; ++i) {
+    var inner = i + 1;
+    for (var j = 0; j < n; ++j) {
+      sum += outer + inner + j;
+    }
+  }
+  return sum;
+}
+
+function loopExit(arr) {
+  var found;
+  for (var i = 0; i < arr.length; ++i) {
+    var x = arr[i] * 3;
+    if (x > 10) {
+      found = x;
+      break;
+    }
+  }
+  return found + i;
+}
+
+print(swap(1, 2, 3), swap(1, 2, 4));
+//CHECK: 2,1 1,2
+print(nested(3));
+//CHECK-NEXT: 81
+print(loopExit([1, 2, 5, 7]));
+//CHECK-NEXT: 17
@@ -0,0 +1,38 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hdb %s < %s.debug | %FileCheck --match-full-lines %s
+// REQUIRES: debugger
+
+// The same condition is compiled once per set of variables in scope.
+print('conditional break scope');
+// CHECK-LABEL: conditional break scope
+
+var v = 1;
+function f(a) {
+  print('f', a);
+}
+function g(b) {
+  var v = 2;
+  print('g', b);
+}
+
+debugger;
+for (var i = 0; i < 2; ++i) {
+  f(i);
+  g(i);
+}
+// CHECK-NEXT: Break on 'debugger' statement in global: {{.*}}:22:1
+// CHECK-NEXT: Set breakpoint 1 at {{.*}}:15:3 if v === 1
+// CHECK-NEXT: Set breakpoint 2 at {{.*}}:19:3 if v === 1
+// CHECK-NEXT: Continuing execution
+// CHECK-NEXT: Break on breakpoint 1 in f: {{.*}}:15:3
+// CHECK-NEXT: Continuing execution
+// CHECK-NEXT: f 0
+// CHECK-NEXT: g 0
+// CHECK-NEXT: Break on breakpoint 1 in f: {{.*}}:15:3
+// CHECK-NEXT: Continuing execution
+// CHECK-NEXT: f 1
+// CHECK-NEXT: g 1
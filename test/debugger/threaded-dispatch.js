@@ -0,0 +1,29 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hdb -Xvm-experiment-flags=128 --break-at-start %s < %s.debug | %FileCheck --match-full-lines %s
+// REQUIRES: debugger
+
+// Threaded dispatch (experiment flag 1 << 7) with breakpoints installed
+// before the threaded code of the functions is built.
+
+function foo(x) {
+  var y = x * 10 + 1;
+  print('foo', y);
+  return y;
+}
+
+print('result', foo(1) + foo(2));
+
+// CHECK: Break on script load in global: {{.*}}
+// CHECK-NEXT: Set breakpoint 1 at {{.*}}:13:{{[0-9]+}}
+// CHECK-NEXT: Continuing execution
+// CHECK-NEXT: Break on breakpoint 1 in foo: {{.*}}:13:{{[0-9]+}}
+// CHECK-NEXT: Continuing execution
+// CHECK-NEXT: foo 11
+// CHECK-NEXT: Break on breakpoint 1 in foo: {{.*}}:13:{{[0-9]+}}
+// CHECK-NEXT: Continuing execution
+// CHECK-NEXT: foo 21
+// CHECK-NEXT: result 32
@@ -0,0 +1,28 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+
+function greet(name) {
+  return 'Goodbye, ' + name + '!';
+}
+
+function sum(arr) {
+  var total = 0;
+  for (var i = 0; i < arr.length; ++i) {
+    total += arr[i];
+  }
+  return total;
+}
+
+function describe(obj) {
+  var parts = [];
+  for (var key in obj) {
+    parts.push(key + '=' + obj[key]);
+  }
+  return parts.join(', ');
+}
+
+print(greet('world'));
+print(sum([1, 2, 3, 4]));
+print(describe({a: 1, b: 'two', c: [3]}));
@@ -0,0 +1,31 @@
+# Copyright (c) Facebook, Inc. and its affiliates.
+#
+# This source code is licensed under the MIT license found in the LICENSE
+# file in the root directory of this source tree.
+
+# RUN: bash %s %S %T %hbc-patch %hermes
+# shellcheck shell=bash
+
+# Exit on any failure.
+set -e
+set -o pipefail
+
+SRCDIR=$1
+TMPDIR=$2
+PATCH=$3
+HERMES=$4
+
+# Compile two versions of the source, and create a patch between them.
+${HERMES} -emit-binary -out "${TMPDIR}/file1.hbc" "${SRCDIR}/file1.js"
+${HERMES} -emit-binary -out "${TMPDIR}/file2.hbc" "${SRCDIR}/file2.js"
+${PATCH} -base "${TMPDIR}/file1.hbc" "${TMPDIR}/file2.hbc" -out "${TMPDIR}/file2.patch"
+
+# The functions that did not change are not in the patch.
+test "$(wc -c < "${TMPDIR}/file2.patch")" -lt "$(wc -c < "${TMPDIR}/file2.hbc")"
+
+# Apply the patch and verify it matches the new file.
+${PATCH} -base "${TMPDIR}/file1.hbc" -apply "${TMPDIR}/file2.patch" -out "${TMPDIR}/file2-patched.hbc"
+diff -q "${TMPDIR}/file2.hbc" "${TMPDIR}/file2-patched.hbc"
+
+# A patch does not apply to another file.
+! ${PATCH} -base "${TMPDIR}/file2.hbc" -apply "${TMPDIR}/file2.patch" -out "${TMPDIR}/bad.hbc"
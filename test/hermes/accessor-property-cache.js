@@ -0,0 +1,83 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+// Check that cached getters are called on the right receiver and that the
+// cache notices when the accessors change.
+
+function Point(x) {
+  this.x = x;
+}
+Object.defineProperty(Point.prototype, 'double', {
+  get: function() { return this.x * 2; },
+  configurable: true,
+});
+
+function getDouble(o) {
+  return o.double;
+}
+
+var p1 = new Point(1), p2 = new Point(2);
+print(getDouble(p1), getDouble(p2), getDouble(p1));
+// CHECK: 2 4 2
+
+// Replace the getter without changing the shape of the prototype.
+Object.defineProperty(Point.prototype, 'double', {
+  get: function() { return this.x * 20; },
+});
+print(getDouble(p1), getDouble(p2));
+// CHECK-NEXT: 20 40
+
+// Shadow the accessor with a data property on the receiver.
+p2.double = 'own';
+Object.defineProperty(p2, 'double', {value: 'own'});
+print(getDouble(p1), getDouble(p2));
+// CHECK-NEXT: 20 own
+
+// Turn the accessor into a data property.
+Object.defineProperty(Point.prototype, 'double', {value: 'data'});
+print(getDouble(p1), getDouble(new Point(3)));
+// CHECK-NEXT: data data
+
+// Own accessors, as defined by observable models.
+function Model(v) {
+  var value = v;
+  Object.defineProperty(this, 'value', {
+    get: function() { return value; },
+    set: function(nv) { value = nv; },
+    configurable: true,
+  });
+}
+function getValue(o) {
+  return o.value;
+}
+var m1 = new Model('a'), m2 = new Model('b');
+print(getValue(m1), getValue(m2), getValue(m1));
+// CHECK-NEXT: a b a
+m1.value = 'c';
+print(getValue(m1), getValue(m2));
+// CHECK-NEXT: c b
+
+// An accessor without a getter reads as undefined.
+Object.defineProperty(m2, 'value', {get: undefined});
+print(getValue(m2), getValue(m2));
+// CHECK-NEXT: undefined undefined
+
+// Exceptions thrown by cached getters propagate.
+var thrower = {
+  get value() {
+    throw new Error('from getter');
+  },
+};
+for (var i = 0; i < 2; ++i) {
+  try {
+    getValue(thrower);
+  } catch (e) {
+    print(e.message);
+  }
+}
+// CHECK-NEXT: from getter
+// CHECK-NEXT: from getter
@@ -0,0 +1,92 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O0 %s | %FileCheck --match-full-lines %s
+
+print('arguments-apply');
+// CHECK-LABEL: arguments-apply
+
+function show() {
+  return this.name + ':' + arguments.length + ':' +
+      Array.prototype.slice.call(arguments, 1).join(',');
+}
+var obj = {name: 'obj'};
+
+// The arguments are forwarded as they were passed.
+function forward(fn) {
+  return fn.apply(obj, arguments);
+}
+print(forward(show), forward(show, 1, 'two', undefined));
+// CHECK-NEXT: obj:1: obj:4:1,two,
+
+// After the arguments object was created and modified.
+function forwardModified(fn) {
+  arguments[1] = 'changed';
+  return fn.apply(obj, arguments);
+}
+print(forwardModified(show, 'x', 'y'));
+// CHECK-NEXT: obj:3:changed,y
+
+// With apply replaced, or called on something else.
+function forwardTo(target, fn) {
+  return target.apply(fn, arguments);
+}
+var custom = {
+  apply: function(thisArg, args) {
+    return 'custom ' + thisArg.name + ' ' + args.length;
+  },
+};
+print(forwardTo(custom, obj, 1, 2));
+// CHECK-NEXT: custom obj 4
+try {
+  forwardTo({apply: 1}, obj);
+} catch (e) {
+  print(e.name);
+}
+// CHECK-NEXT: TypeError
+try {
+  forward({});
+} catch (e) {
+  print(e.name);
+}
+// CHECK-NEXT: TypeError
+
+// Native targets, and exceptions thrown by the target.
+function max() {
+  return Math.max.apply(null, arguments);
+}
+print(max(3, 9, 4), max());
+// CHECK-NEXT: 9 -Infinity
+try {
+  forward(function() {
+    throw new Error('thrown');
+  });
+} catch (e) {
+  print(e.message);
+}
+// CHECK-NEXT: thrown
+
+// Constructors compiled by Babel forward their arguments to the parent.
+function Base(a, b) {
+  this.sum = a + b;
+}
+function Derived() {
+  return Base.apply(this, arguments) || this;
+}
+print(new Derived(2, 3).sum);
+// CHECK-NEXT: 5
+
+// Arrays, packed or not, are spread into the arguments.
+print(show.apply(obj, [1, 2, 3]), show.apply(obj, [1, , 3]));
+// CHECK-NEXT: obj:3:2,3 obj:3:,3
+Array.prototype[1] = 'proto';
+print(show.apply(obj, [1, , 3]));
+// CHECK-NEXT: obj:3:proto,3
+delete Array.prototype[1];
+var longer = [1, 2];
+longer.length = 4;
+print(show.apply(obj, longer), show.apply(obj, []));
+// CHECK-NEXT: obj:4:2,, obj:0:
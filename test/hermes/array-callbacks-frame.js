@@ -0,0 +1,46 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+print('array-callbacks-frame');
+// CHECK-LABEL: array-callbacks-frame
+
+// The callbacks are called with the same arguments and this every time, even
+// when they modify their arguments or call other built-ins.
+var seen = [];
+[1, 2, 3].forEach(function(v, i, a) {
+  'use strict';
+  seen.push(this + ':' + v + ':' + i + ':' + a.length);
+  v = 10;
+  i = 20;
+  arguments[2] = null;
+  [4].forEach(function(w) {});
+}, 'T');
+print(seen.join(' '));
+// CHECK-NEXT: T:1:0:3 T:2:1:3 T:3:2:3
+print([1, 2, 3].map(function(v, i) { v = 0; return i * 2; }).join());
+// CHECK-NEXT: 0,2,4
+print([1, 2, 3, 4].reduce(function(acc, v) { return acc + v; }));
+// CHECK-NEXT: 10
+print([3, 1, 2].sort(function(a, b) { var d = a - b; a = 0; return d; }).join());
+// CHECK-NEXT: 1,2,3
+print([5, 1, 4].sort(function(a, b) { return a - b; }).join());
+// CHECK-NEXT: 1,4,5
+
+// Callbacks may throw, or be called again after a nested built-in threw.
+try {
+  [1, 2].every(function(v) { throw new Error('thrown ' + v); });
+} catch (e) {
+  print(e.message);
+}
+// CHECK-NEXT: thrown 1
+print([1, 2, 3].filter(function(v) {
+  try {
+    [0].some(function() { throw 0; });
+  } catch (e) {}
+  return v !== 2;
+}).join());
+// CHECK-NEXT: 1,3
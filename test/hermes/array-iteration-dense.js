@@ -0,0 +1,84 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+print('array-iteration-dense');
+// CHECK-LABEL: array-iteration-dense
+
+function show(a) {
+  var parts = [];
+  for (var i = 0; i < a.length; ++i) {
+    parts.push(i in a ? String(a[i]) : '<hole>');
+  }
+  return a.length + ':' + parts.join(',');
+}
+
+// Dense arrays.
+var a = [1, 2, 3, 4];
+print(show(a.map(function(x, i) { return x * 10 + i; })));
+// CHECK-NEXT: 4:10,21,32,43
+print(show(a.filter(function(x) { return x % 2; })));
+// CHECK-NEXT: 2:1,3
+print(a.reduce(function(acc, x) { return acc + x; }));
+// CHECK-NEXT: 10
+print(a.reduceRight(function(acc, x) { return acc + x; }, ''));
+// CHECK-NEXT: 4321
+print(a.every(function(x) { return x < 5; }), a.some(function(x) {
+  return x > 3;
+}));
+// CHECK-NEXT: true true
+
+// Holes are skipped, and stay holes in the result of map.
+var holes = [1, , 3, , 5];
+print(show(holes.map(function(x) { return x + 1; })));
+// CHECK-NEXT: 5:2,<hole>,4,<hole>,6
+var visited = [];
+holes.forEach(function(x, i) { visited.push(i); });
+print(visited.join());
+// CHECK-NEXT: 0,2,4
+print(holes.reduce(function(acc, x) { return acc + x; }));
+// CHECK-NEXT: 9
+print(show([, , 7].filter(function() { return true; })));
+// CHECK-NEXT: 1:7
+
+// Holes are looked up along the prototype chain.
+Array.prototype[1] = 'proto';
+print(show(holes.map(function(x) { return x; })));
+// CHECK-NEXT: 5:1,proto,3,<hole>,5
+delete Array.prototype[1];
+
+// Getters on the array itself.
+var getters = [1, 2, 3];
+Object.defineProperty(getters, 1, {
+  get: function() { return 'getter'; },
+  configurable: true,
+});
+print(show(getters.map(function(x) { return x; })));
+// CHECK-NEXT: 3:1,getter,3
+
+// The callback changes the array it is iterating over.
+var shrinking = [1, 2, 3, 4, 5];
+print(show(shrinking.map(function(x, i, arr) {
+  arr.length = 3;
+  return x;
+})));
+// CHECK-NEXT: 5:1,2,3,<hole>,<hole>
+var growing = [1, 2, 3];
+visited = [];
+growing.forEach(function(x, i, arr) {
+  arr.push(x);
+  arr[i + 1] = 'changed';
+  visited.push(x);
+});
+print(visited.join());
+// CHECK-NEXT: 1,changed,changed
+
+// Array-like objects.
+var arrayLike = {length: 3, 0: 'a', 2: 'c'};
+print(show(Array.prototype.map.call(arrayLike, function(x) {
+  return x + x;
+})));
+// CHECK-NEXT: 3:aa,<hole>,cc
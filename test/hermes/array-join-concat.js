@@ -0,0 +1,40 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+print('array-join-concat');
+// CHECK-LABEL: array-join-concat
+
+// Strings and numbers of a packed array are joined directly.
+print(['a', 1, -0, 1.5, NaN, -Infinity, 'b'].join('-'));
+// CHECK-NEXT: a-1-0-1.5-NaN--Infinity-b
+print(['é', 2].join(), [1, 2].join('—'), ['x'].join());
+// CHECK-NEXT: é,2 1—2 x
+// Other elements use the generic conversion.
+print([1, null, undefined, {toString: function() { return 'o'; }}].join());
+// CHECK-NEXT: 1,,,o
+// Converting the separator can shrink the array.
+var a = [1, 2, 3];
+print(a.join({toString: function() { a.length = 1; return '+'; }}));
+// CHECK-NEXT: 1++
+
+// Packed arrays are concatenated in bulk, across storage segments.
+var big = [];
+for (var i = 0; i < 3000; ++i) big.push(i);
+var c = [0.5].concat(big, ['x'], big);
+print(c.length, c[0], c[1], c[1025], c[3000], c[3001], c[3002], c[6001]);
+// CHECK-NEXT: 6002 0.5 0 1024 2999 x 0 2999
+var sum = 0;
+for (var i = 0; i < c.length; ++i) if (typeof c[i] === 'number') sum += c[i];
+print(sum);
+// CHECK-NEXT: 8997000.5
+// Holes are still read from the prototype.
+Array.prototype[1] = 'proto';
+print([].concat([1, , 3], [4, 5]).join());
+// CHECK-NEXT: 1,proto,3,4,5
+delete Array.prototype[1];
+print([1, 2].concat([3, 4]).join(), [1].concat([]).length);
+// CHECK-NEXT: 1,2,3,4 1
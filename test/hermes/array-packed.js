@@ -0,0 +1,61 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+print('array-packed');
+// CHECK-LABEL: array-packed
+
+// Holes are read from the prototype once an array stops being packed.
+Array.prototype[1] = 'proto';
+var a = [1, 2, 3];
+print(a[1]);
+// CHECK-NEXT: 2
+delete a[1];
+print(a[1]);
+// CHECK-NEXT: proto
+a[1] = 'back';
+print(a[1], [1, , 3][1]);
+// CHECK-NEXT: back proto
+
+// Growing the length adds holes, shrinking it removes them.
+var b = [5, 4, 3];
+b.length = 5;
+print(b[3], b.sort().join());
+// CHECK-NEXT: undefined 3,4,5,,
+b.length = 2;
+b[1] = 7;
+print(b[1], b.sort().join());
+// CHECK-NEXT: 7 3,7
+
+// Filling an array created with a length makes it packed.
+var c = new Array(4);
+for (var i = 0; i < 4; ++i) c[i] = 4 - i;
+print(c[2], c.sort().join());
+// CHECK-NEXT: 2 1,2,3,4
+delete Array.prototype[1];
+
+// Writes to a frozen or sealed array are still rejected.
+var d = Object.freeze([1, 2]);
+d[0] = 9;
+print(d[0]);
+// CHECK-NEXT: 1
+var e = Object.seal([1, 2]);
+e[0] = 9;
+print(e[0]);
+// CHECK-NEXT: 9
+
+// Index-like named properties shadow the elements.
+var f = [1, 2, 3];
+Object.defineProperty(f, '0', {get: function() { return 'getter'; }});
+print(f[0]);
+// CHECK-NEXT: getter
+
+// Elements which aren't numbers are still converted to strings to be sorted.
+var g = [3, 1, 2];
+g[1] = 'x';
+g[1] = 10;
+print(g.sort().join());
+// CHECK-NEXT: 10,2,3
@@ -0,0 +1,92 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+print('array-sort-dense');
+// CHECK-LABEL: array-sort-dense
+
+// The default compare converts the elements to strings.
+print([10, 9, 1, 100, -1, 2.5].sort().join());
+// CHECK-NEXT: -1,1,10,100,2.5,9
+print(['b', undefined, 'a', null, true, 'c', undefined].sort().join('|'));
+// CHECK-NEXT: a|b|c||true||
+
+// Sorting is stable, including for runs long enough to be merged.
+var recs = [];
+for (var i = 0; i < 200; ++i) {
+  recs.push({key: (i * 7) % 5, id: i});
+}
+recs.sort(function(a, b) { return a.key - b.key; });
+var stable = true;
+for (var i = 1; i < recs.length; ++i) {
+  if (recs[i - 1].key > recs[i].key ||
+      (recs[i - 1].key === recs[i].key && recs[i - 1].id > recs[i].id)) {
+    stable = false;
+  }
+}
+print(stable, recs[0].id, recs[199].id);
+// CHECK-NEXT: true 0 197
+
+// Descending and already sorted input.
+var desc = [];
+for (var i = 100; i > 0; --i) {
+  desc.push(i);
+}
+desc.sort(function(a, b) { return a - b; });
+print(desc[0], desc[50], desc[99]);
+// CHECK-NEXT: 1 51 100
+print(desc.sort(function(a, b) { return b - a; }).slice(0, 3).join());
+// CHECK-NEXT: 100,99,98
+
+// undefined goes last and is never passed to compareFn.
+var sawUndefined = false;
+print([3, undefined, 1, 2].sort(function(a, b) {
+  if (a === undefined || b === undefined) sawUndefined = true;
+  return a - b;
+}).join(), sawUndefined);
+// CHECK-NEXT: 1,2,3, false
+
+// Holes go after undefined.
+var holes = [3, , undefined, 1];
+holes.sort();
+print(holes.length, 2 in holes, 3 in holes, holes[0], holes[1]);
+// CHECK-NEXT: 4 true false 1 3
+
+// Objects are converted with toString at each comparison.
+var objs = [{toString: function() { return 'b'; }}, {toString: function() {
+  return 'a';
+}}];
+print(objs.sort().join());
+// CHECK-NEXT: a,b
+
+// Exceptions thrown by compareFn leave the array unchanged.
+var arr = [5, 4, 3, 2, 1];
+try {
+  arr.sort(function(a, b) {
+    if (a === 1 || b === 1) throw new Error('stop');
+    return a - b;
+  });
+} catch (e) {
+  print(e.message, arr.join());
+}
+// CHECK-NEXT: stop 5,4,3,2,1
+
+// compareFn shrinks the array.
+var shrinking = [3, 2, 1];
+shrinking.sort(function(a, b) {
+  shrinking.length = 1;
+  return a - b;
+});
+print(shrinking.length, shrinking.join());
+// CHECK-NEXT: 3 1,2,3
+
+// Frozen arrays can't be sorted.
+try {
+  Object.freeze([2, 1]).sort();
+} catch (e) {
+  print(e.name);
+}
+// CHECK-NEXT: TypeError
@@ -0,0 +1,34 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: rm -rf %t
+// RUN: %hermes -ast-cache-dir=%t %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -ast-cache-dir=%t %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -strict -ast-cache-dir=%t %s | %FileCheck --match-full-lines %s
+
+"use strict";
+
+function Point(x, y) {
+  this.x = x;
+  this.y = y;
+}
+Point.prototype.toString = function () {
+  return `(${this.x}, ${this.y})`;
+};
+
+var o = {a: [1, 2.5, -3], "b": null, get c() { return 'c'; }};
+label: for (var i = 0; i < 3; ++i) {
+  if (i === 1) continue label;
+  print(new Point(i, o.a[i]) + "", o.c, /a+b/g.test("aab"));
+}
+// CHECK: (0, 1) c true
+// CHECK-NEXT: (2, -3) c true
+
+try {
+  undeclared = 1;
+} catch (e) {
+  print(e.name);
+}
+// CHECK-NEXT: ReferenceError
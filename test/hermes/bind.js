@@ -82,3 +82,17 @@ try {
 Object.defineProperty(foo, "length", {value: {valueOf: function() {throw TypeError("HAHA!");}}});
 print(foo.bind(null).length);
 //CHECK-NEXT: 0
+
+// Bound functions calling JS functions, with and without bound arguments, and
+// through a chain of bound functions.
+function sum(a, b, c) {
+    return this.base + a + b + c;
+}
+var bound0 = sum.bind({base: 100});
+var bound2 = sum.bind({base: 200}, 1, 2);
+var chained = bound2.bind({base: 0});
+var total = 0;
+for (var i = 0; i < 1000; ++i)
+    total += bound0(i, 1, 2) + bound2(i) + chained(3);
+print(total);
+//CHECK-NEXT: 1511000
@@ -0,0 +1,27 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: (! %hermes -O -buffered-output %s 2>&1 ) | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -emit-binary -out %t.hbc %s && (! %hermes -buffered-output %t.hbc 2>&1 ) | %FileCheck --match-full-lines %s
+
+print('buffered output');
+// CHECK-LABEL: buffered output
+print('a', 1, {}, undefined);
+// CHECK-NEXT: a 1 [object Object] undefined
+
+var total = 0;
+for (var i = 0; i < 10000; ++i) {
+  print('line', i);
+  total += i;
+}
+// CHECK-NEXT: line 0
+// CHECK-NEXT: line 1
+// CHECK: line 9999
+print('total', total);
+// CHECK-NEXT: total 49995000
+
+// The output printed before an uncaught exception comes first.
+throw new Error('done');
+// CHECK-NEXT: Error: done
@@ -0,0 +1,23 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: rm -rf %t.cache && %hermes -O -emit-binary -cache-dir=%t.cache -out %t.hbc %s
+// RUN: ls %t.cache | %FileCheck --match-full-lines %s -check-prefix CACHE
+// RUN: cp %t.hbc %t.first.hbc
+// RUN: %hermes -O -emit-binary -cache-dir=%t.cache -out %t.hbc %s && cmp %t.first.hbc %t.hbc
+// RUN: %hermes %t.hbc | %FileCheck --match-full-lines %s
+// RUN: %hermes -emit-binary -cache-dir=%t.cache -out %t.hbc %s
+// RUN: ls %t.cache | %FileCheck --match-full-lines %s -check-prefix CACHE2
+
+// CACHE: {{[0-9a-f]{40}}}.hbc
+// CACHE-NOT: {{.}}
+
+// A different command line is a different entry.
+// CACHE2: {{[0-9a-f]{40}}}.hbc
+// CACHE2-NEXT: {{[0-9a-f]{40}}}.hbc
+// CACHE2-NOT: {{.}}
+
+print('cached');
+// CHECK: cached
@@ -4,6 +4,7 @@
 // file in the root directory of this source tree.
 //
 // RUN: %hermes -target=HBC %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -target=HBC -Xvm-experiment-flags=128 %s | %FileCheck --match-full-lines %s
 // REQUIRES: exception_on_oom
 "use strict";
 
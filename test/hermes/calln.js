@@ -5,6 +5,7 @@
 //
 // RUN: %hermes -O %s | %FileCheck --match-full-lines %s
 // RUN: %hermes -O -emit-binary -out %t.hbc %s && %hermes %t.hbc | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -Xvm-experiment-flags=128 %s | %FileCheck --match-full-lines %s
 
 function printer() {
   print(this);
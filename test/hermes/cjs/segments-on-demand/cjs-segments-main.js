@@ -0,0 +1,19 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -commonjs -fstatic-require %S/ -emit-binary -out %T/test.hbc && %hermes %T/test.hbc | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -commonjs -fstatic-require %S/ -emit-binary -out %T/test.hbc && %hermes %T/test.hbc | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -commonjs -fstatic-require %S/ -emit-binary -out %T/test.hbc && rm %T/test.hbc.1 && (! %hermes %T/test.hbc 2>&1 ) | %FileCheck --match-full-lines %s -check-prefix MISSING
+
+// The segment of the lazy module is loaded when it is first required.
+
+print('main: init');
+// CHECK-LABEL: main: init
+// MISSING-LABEL: main: init
+
+print('main: lazy.x =', require('./cjs-segments-lazy.js').x);
+// CHECK-NEXT: lazy: init
+// CHECK-NEXT: main: lazy.x = 42
+// MISSING-NEXT: TypeError: Unable to find module with ID: 1
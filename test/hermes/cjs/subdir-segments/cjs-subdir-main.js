@@ -43,11 +43,15 @@ print(require('./cjs-subdir-2.js').alpha);
 // MANIFEST-NEXT:   {
 // MANIFEST-NEXT:     "resource": "test.hbc",
 // MANIFEST-NEXT:     "flavor": "seg-0",
-// MANIFEST-NEXT:     "location": "test.hbc"
+// MANIFEST-NEXT:     "location": "test.hbc",
+// MANIFEST-NEXT:     "firstModule": 0,
+// MANIFEST-NEXT:     "lastModule": 1
 // MANIFEST-NEXT:   },
 // MANIFEST-NEXT:   {
 // MANIFEST-NEXT:     "resource": "test.hbc",
 // MANIFEST-NEXT:     "flavor": "seg-1",
-// MANIFEST-NEXT:     "location": "test.hbc.1"
+// MANIFEST-NEXT:     "location": "test.hbc.1",
+// MANIFEST-NEXT:     "firstModule": 2,
+// MANIFEST-NEXT:     "lastModule": 3
 // MANIFEST-NEXT:   }
 // MANIFEST-NEXT: ]
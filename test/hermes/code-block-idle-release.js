@@ -0,0 +1,47 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O -code-block-idle-gcs=1 %s | %FileCheck --match-full-lines %s
+
+print('code-block-idle-release');
+// CHECK-LABEL: code-block-idle-release
+
+// Functions whose data was released while they were idle rebuild it when they
+// run again.
+function add(a, b) {
+  return a + b;
+}
+print(add(1, 2), add('a', 'b'));
+// CHECK-NEXT: 3 ab
+gc();
+gc();
+print(add(3, 4), add('c', 'd'));
+// CHECK-NEXT: 7 cd
+
+// Functions with a frame on the stack keep their data while collections run.
+function outer(n) {
+  var s = 0;
+  for (var i = 0; i < n; ++i) {
+    gc();
+    s += add(i, 1);
+  }
+  return s;
+}
+print(outer(3));
+// CHECK-NEXT: 6
+
+function* gen() {
+  yield 1;
+  gc();
+  gc();
+  yield 2;
+}
+var it = gen();
+print(it.next().value);
+// CHECK-NEXT: 1
+gc();
+gc();
+print(it.next().value, it.next().done);
+// CHECK-NEXT: 2 true
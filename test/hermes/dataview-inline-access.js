@@ -0,0 +1,59 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+// The get and set methods of DataView are evaluated without entering the
+// native function when their arguments need no conversion. Check that the
+// results agree with the native functions in and around that case.
+
+var view = new DataView(new ArrayBuffer(12), 2, 8);
+
+print('inline');
+// CHECK-LABEL: inline
+view.setUint32(0, 0x01020304);
+print(view.getUint8(0), view.getUint8(3), view.getUint32(0).toString(16));
+// CHECK-NEXT: 1 4 1020304
+view.setUint32(4, 0x01020304, true);
+print(view.getUint8(4), view.getUint32(4, true).toString(16));
+// CHECK-NEXT: 4 1020304
+view.setFloat64(0, Math.PI);
+print(view.getFloat64(0), view.getFloat64(0, false));
+// CHECK-NEXT: 3.141592653589793 3.141592653589793
+view.setInt16(6, -2, 'yes');
+print(view.getInt16(6, 1), view.getUint16(6, {}));
+// CHECK-NEXT: -2 65534
+view.setInt8(7, 300.7);
+print(view.getInt8(7), view.getUint8(-0));
+// CHECK-NEXT: 44 64
+view.setFloat32(1, NaN);
+print(view.getFloat32(1));
+// CHECK-NEXT: NaN
+
+print('fallback');
+// CHECK-LABEL: fallback
+view.setUint8('3', {valueOf: function() { return 7; }});
+print(view.getUint8(3.9), view.getUint8('3'));
+// CHECK-NEXT: 7 7
+function tryRun(f) {
+  try {
+    return f();
+  } catch (e) {
+    return e.name;
+  }
+}
+print(tryRun(function() { return view.getUint32(5); }));
+// CHECK-NEXT: RangeError
+print(tryRun(function() { return view.getUint8(-1); }));
+// CHECK-NEXT: RangeError
+print(tryRun(function() { return view.setFloat64(1, 0); }));
+// CHECK-NEXT: RangeError
+print(tryRun(function() { return view.getUint8.call({}, 0); }));
+// CHECK-NEXT: TypeError
+print(view.getUint8(NaN), view.getUint8());
+// CHECK-NEXT: 64 64
+HermesInternal.detachArrayBuffer(view.buffer);
+print(tryRun(function() { return view.getUint8(0); }));
+// CHECK-NEXT: TypeError
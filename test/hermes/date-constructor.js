@@ -191,6 +191,20 @@ print(Date.parse('2016T12:30:00.000-07:00'));
 // CHECK-NEXT: 1451676600000
 print(Date.parse('2016T12:30:47.123-07:00'));
 // CHECK-NEXT: 1451676647123
+print(Date.parse('2016-02-15T18:03:57.263Z'));
+// CHECK-NEXT: 1455559437263
+print(Date.parse('2016-02-15T18:03:57.263+05:30'));
+// CHECK-NEXT: 1455539637263
+print(Date.parse('2016-02-15T18:03:57.263-05:30'));
+// CHECK-NEXT: 1455579237263
+print(Date.parse('2016-02-15 18:03:57.263-05:30'));
+// CHECK-NEXT: 1455579237263
+print(Date.parse('2016-02-15T18:03:57Z'), Date.parse('2016-02-15T18:03Z'));
+// CHECK-NEXT: 1455559437000 1455559380000
+print(Date.parse('2016-02-15'), Date.parse('2016-02-15T18:03:57.263Z\u0125'));
+// CHECK-NEXT: 1455494400000 NaN
+print(Date.parse('2016-02-15T18:03:57+0530'), Date.parse('2016-02-1xT18:03Z'));
+// CHECK-NEXT: NaN NaN
 
 // Quick check that getters work; internal functions are unit tested instead.
 print('getters');
@@ -5,6 +5,8 @@
 //
 // RUN: %hermes %s | %FileCheck --match-full-lines %s
 // RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -Xvm-experiment-flags=128 %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -Xvm-experiment-flags=128 %s | %FileCheck --match-full-lines %s
 
 function show(iterResult) {
   print(iterResult.value, '|', iterResult.done);
@@ -39,3 +39,9 @@ print(unescape('asd%u123'));
 // CHECK-NEXT: asd%u123
 print(unescape('asd%u123x'));
 // CHECK-NEXT: asd%u123x
+print(escape('abcdefghijklmnopqrstuvwxyz@*_+-./ Āÿabcdefghijklmnopqrstuvwxyz'));
+// CHECK-NEXT: abcdefghijklmnopqrstuvwxyz@*_+-./%20%u0100%FFabcdefghijklmnopqrstuvwxyz
+print(unescape('abcdefghijklmnopqrstuvwxyz%41abcdefghijklmnopqrstuvwxyz%u0100'));
+// CHECK-NEXT: abcdefghijklmnopqrstuvwxyzAabcdefghijklmnopqrstuvwxyzĀ
+print(unescape('Āabcdefghijklmnopqrstuvwxyz%41%'));
+// CHECK-NEXT: ĀabcdefghijklmnopqrstuvwxyzA%
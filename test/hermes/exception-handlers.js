@@ -0,0 +1,72 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O -target=HBC %s | %FileCheck --match-full-lines --check-prefixes=CHECK,STACK %s
+// RUN: %hermes -O -target=HBC -Xvm-experiment-flags=256 %s | %FileCheck --match-full-lines --check-prefixes=CHECK,NOSTACK %s
+// RUN: %hermes -O -target=HBC -Xvm-experiment-flags=128 %s | %FileCheck --match-full-lines --check-prefixes=CHECK,STACK %s
+
+// Nested handlers: the innermost one covering the throw is used, and code
+// between inner handlers belongs to the outer one.
+function nested(n) {
+  var log = [];
+  try {
+    try {
+      if (n === 0) throw "inner";
+    } catch (e) {
+      log.push("caught " + e + " inner");
+    }
+    if (n === 1) throw "middle";
+    try {
+      if (n === 2) throw "second";
+    } finally {
+      log.push("finally");
+    }
+  } catch (e) {
+    log.push("caught " + e + " outer");
+  }
+  return log.join(", ");
+}
+print(nested(0));
+//CHECK: caught inner inner, finally
+print(nested(1));
+//CHECK-NEXT: caught middle outer
+print(nested(2));
+//CHECK-NEXT: finally, caught second outer
+print(nested(3));
+//CHECK-NEXT: finally
+
+// Unwinding through frames without handlers.
+function thrower(depth) {
+  if (depth === 0) throw new Error("deep");
+  return thrower(depth - 1) + 1;
+}
+try {
+  thrower(10);
+} catch (e) {
+  print(e.message, e.stack !== "");
+}
+//CHECK-NEXT: deep true
+
+// Errors caught in the throwing frame or its caller.
+function local() {
+  try {
+    throw new Error("local");
+  } catch (e) {
+    return e.stack !== "";
+  }
+}
+function raise() {
+  undefined.x;
+}
+function caller() {
+  try {
+    raise();
+  } catch (e) {
+    return e.stack !== "";
+  }
+}
+print(local(), caller());
+//STACK-NEXT: true true
+//NOSTACK-NEXT: false false
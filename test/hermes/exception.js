@@ -5,6 +5,7 @@
 //
 // RUN: %hermes -O -target=HBC %s | %FileCheck --match-full-lines %s
 // RUN: %hermes -O -target=HBC -emit-binary -out %t.hbc %s && %hermes %t.hbc | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -target=HBC -Xvm-experiment-flags=128 %s | %FileCheck --match-full-lines %s
 
 try {
   throw "test";
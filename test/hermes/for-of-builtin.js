@@ -0,0 +1,129 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes %s | %FileCheck --match-full-lines %s
+
+// Built-in iterables are iterated without iterator result objects, which
+// must not be observable.
+
+function collect(seq) {
+  var ar = [];
+  for (var x of seq)
+    ar.push(x);
+  return ar;
+}
+
+print('arrays');
+//CHECK-LABEL: arrays
+print(collect([1, 2, 3]).join());
+//CHECK-NEXT: 1,2,3
+print(collect([1, , 3]).join());
+//CHECK-NEXT: 1,,3
+print(collect([]).length);
+//CHECK-NEXT: 0
+
+// Elements appended during the iteration are visited.
+var grow = [1, 2];
+var seen = [];
+for (var x of grow) {
+  seen.push(x);
+  if (grow.length < 4)
+    grow.push(x * 10);
+}
+print(seen.join());
+//CHECK-NEXT: 1,2,10,20
+
+// Elements found on the prototype of a hole are visited.
+Array.prototype[1] = 'proto';
+print(collect([1, , 3]).join());
+//CHECK-NEXT: 1,proto,3
+delete Array.prototype[1];
+
+print('strings');
+//CHECK-LABEL: strings
+print(collect('ab\ud83d\ude00c').length);
+//CHECK-NEXT: 4
+
+print('maps and sets');
+//CHECK-LABEL: maps and sets
+var m = new Map([[1, 'a'], [2, 'b']]);
+print(collect(m).join(';'));
+//CHECK-NEXT: 1,a;2,b
+print(collect(m.keys()).join());
+//CHECK-NEXT: 1,2
+print(collect(new Set([3, 4, 3])).join());
+//CHECK-NEXT: 3,4
+
+print('patched');
+//CHECK-LABEL: patched
+var own = [1, 2];
+own[Symbol.iterator] = function* () {
+  yield 'own';
+};
+print(collect(own).join());
+//CHECK-NEXT: own
+
+var arrayIteratorProto = Object.getPrototypeOf([][Symbol.iterator]());
+var arrayNext = arrayIteratorProto.next;
+arrayIteratorProto.next = function() {
+  var res = arrayNext.call(this);
+  if (!res.done)
+    res.value *= 2;
+  return res;
+};
+print(collect([1, 2]).join());
+//CHECK-NEXT: 2,4
+arrayIteratorProto.next = arrayNext;
+
+var setIteratorProto = Object.getPrototypeOf(new Set()[Symbol.iterator]());
+var setNext = setIteratorProto.next;
+setIteratorProto.next = function() {
+  return {done: true};
+};
+print(collect(new Set([1])).length);
+//CHECK-NEXT: 0
+setIteratorProto.next = setNext;
+
+var arrayValues = Array.prototype[Symbol.iterator];
+Array.prototype[Symbol.iterator] = function* () {
+  yield 'patched';
+};
+print(collect([1, 2]).join());
+//CHECK-NEXT: patched
+Array.prototype[Symbol.iterator] = arrayValues;
+print(collect([1, 2]).join());
+//CHECK-NEXT: 1,2
+
+print('close');
+//CHECK-LABEL: close
+function* gen() {
+  try {
+    yield 1;
+    yield 2;
+  } finally {
+    print('finally');
+  }
+}
+for (var x of gen()) {
+  print(x);
+  break;
+}
+//CHECK-NEXT: 1
+//CHECK-NEXT: finally
+try {
+  for (var x of gen())
+    throw new Error('thrown');
+} catch (e) {
+  print(e.message);
+}
+//CHECK-NEXT: finally
+//CHECK-NEXT: thrown
+for (var x of [1, 2, 3]) {
+  if (x === 2)
+    break;
+}
+print(x);
+//CHECK-NEXT: 2
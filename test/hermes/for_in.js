@@ -122,3 +122,32 @@ for (var p in a) {
 }
 print(t);
 //CHECK: 1000000
+
+// Cached own names, while the object changes during the loop.
+function ownNames(o) {
+  var names = [];
+  for (var k in o) {
+    if (k === 'a') {
+      delete o.b;
+      o.d = 4;
+    }
+    names.push(k);
+  }
+  return names.join();
+}
+function Shaped() {
+  this.a = 1;
+  this.b = 2;
+  this.c = 3;
+}
+Shaped.prototype.p = 0;
+print(ownNames(new Shaped()));
+//CHECK: a,c,p
+print(ownNames(new Shaped()));
+//CHECK: a,c,p
+var unchanged = new Shaped();
+var seen = [];
+for (var k in unchanged) seen.push(k);
+for (var k in unchanged) seen.push(k);
+print(seen.join());
+//CHECK: a,b,c,p,a,b,c,p
@@ -0,0 +1,73 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O0 %s | %FileCheck --match-full-lines %s
+
+// Check that the property caches of global variables are invalidated when a
+// global is deleted or reconfigured, and stay valid when globals are added.
+
+var global = this;
+var a = 1;
+global.b = 2;
+
+function readA() {
+  return a;
+}
+function readB() {
+  try {
+    return b;
+  } catch (e) {
+    return e.name;
+  }
+}
+function writeA(v) {
+  a = v;
+}
+
+// Populate the caches.
+print(readA(), readA(), readB(), readB());
+// CHECK: 1 1 2 2
+
+// Adding globals doesn't move the existing ones.
+for (var i = 0; i < 100; ++i)
+  global['g' + i] = i;
+writeA(3);
+print(readA(), readB(), g99);
+// CHECK-NEXT: 3 2 99
+
+// Deleting a global, then adding another one that may reuse its slot.
+delete global.b;
+global.c = 4;
+print(readB(), readA());
+// CHECK-NEXT: ReferenceError 3
+global.b = 5;
+print(readB(), readB(), c);
+// CHECK-NEXT: 5 5 4
+
+// Turning a global into an accessor.
+Object.defineProperty(global, 'b', {
+  get: function() {
+    return 'getter';
+  },
+  configurable: true,
+});
+print(readB(), readB());
+// CHECK-NEXT: getter getter
+
+// Making a global read-only.
+Object.defineProperty(global, 'a', {writable: false});
+writeA(6);
+print(readA());
+// CHECK-NEXT: 3
+
+// Freezing the global object.
+Object.defineProperty(global, 'b', {value: 7});
+print(readB());
+// CHECK-NEXT: 7
+Object.freeze(global);
+global.b = 8;
+print(readB(), Object.isFrozen(global));
+// CHECK-NEXT: 7 true
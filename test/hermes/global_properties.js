@@ -115,6 +115,13 @@ print(parseInt("-123"));
 print(parseInt("abc"))
 // CHECK-NEXT: NaN
 
+print(parseInt(" \n+42px"), 1 / parseInt("-0"), parseInt("0x1F"));
+// CHECK-NEXT: 42 -Infinity 31
+print(parseInt("0x1F", 10), parseInt("123456789012345"));
+// CHECK-NEXT: 0 123456789012345
+print(parseInt("9007199254740993"), parseInt("-0001234567890123456"));
+// CHECK-NEXT: 9007199254740992 -1234567890123456
+
 print('parseFloat');
 // CHECK-LABEL: parseFloat
 
@@ -160,6 +167,17 @@ print(parseFloat("-55e.5"));
 print(parseFloat('+'));
 // CHECK-NEXT: NaN
 
+print(parseFloat("  3.25e-1x"), parseFloat("1.e2"), parseFloat(".5e"));
+// CHECK-NEXT: 0.325 100 0.5
+print(parseFloat("0.30000000000000004,"), parseFloat("1e23;"));
+// CHECK-NEXT: 0.30000000000000004 1e+23
+print(parseFloat("2.2250738585072011e-308"), parseFloat("5e-324"));
+// CHECK-NEXT: 2.225073858507201e-308 5e-324
+print(Number("12.5"), Number("-0.1e1"), Number("1e23"), Number("7."));
+// CHECK-NEXT: 12.5 -1 1e+23 7
+print(Number(" 12 "), Number("12x"), Number("."), 1 / Number("-0"));
+// CHECK-NEXT: 12 NaN NaN -Infinity
+
 try {
   new isNaN();
 } catch (e) {
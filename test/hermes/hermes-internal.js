@@ -26,3 +26,11 @@ try {
   print('caught', e.name);
 }
 // CHECK-NEXT: caught TypeError
+
+var randoms = HermesInternal.fillRandom(new Float64Array(100));
+print(randoms.length, randoms.every(function(x) { return 0 <= x && x < 1; }));
+// CHECK-NEXT: 100 true
+print(new Set(randoms).size > 90);
+// CHECK-NEXT: true
+try { HermesInternal.fillRandom([0]); } catch (e) { print('caught', e.name); }
+// CHECK-NEXT: caught TypeError
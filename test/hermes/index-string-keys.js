@@ -0,0 +1,36 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O -target=HBC %s | %FileCheck --match-full-lines %s
+"use strict";
+
+print('index string keys');
+// CHECK-LABEL: index string keys
+
+var arr = [10, 20, 30];
+print(arr["1"], arr["01"], arr["3"], arr["-0"]);
+// CHECK-NEXT: 20 undefined undefined undefined
+arr["2"] = 33;
+arr["01"] = 'x';
+print(arr.length, arr[2], arr["01"], Object.keys(arr).join());
+// CHECK-NEXT: 3 33 x 0,1,2,01
+arr["4294967294"] = 'last';
+arr["4294967295"] = 'named';
+print(arr.length, arr[4294967294], arr[4294967295]);
+// CHECK-NEXT: 4294967295 last named
+
+var obj = {};
+obj[7] = 'seven';
+obj["8"] = 'eight';
+obj[100000] = 'big';
+print(obj["7"], obj[8], obj["100000"], obj[7.0], obj["7.0"]);
+// CHECK-NEXT: seven eight big seven undefined
+print(Object.keys(obj).join());
+// CHECK-NEXT: 7,8,100000
+print("8" in obj, 9 in obj, delete obj["8"], 8 in obj);
+// CHECK-NEXT: true false true false
+
+print('abc'["1"], 'abc'["3"]);
+// CHECK-NEXT: b undefined
@@ -0,0 +1,39 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O -fstatic-builtins %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -fno-static-builtins %s | %FileCheck --match-full-lines %s
+
+// The builtins that CallBuiltin evaluates without a native call must agree
+// with the native functions, which still handle the other argument types.
+
+function show(x) {
+  return 1 / x === -Infinity ? '-0' : String(x);
+}
+
+print(show(Math.floor(-1.5)), show(Math.ceil(-0.5)), show(Math.floor(-0)));
+// CHECK: -2 -0 -0
+print(show(Math.abs(-0)), show(Math.abs(-3)), show(Math.sqrt(-1)));
+// CHECK-NEXT: 0 3 NaN
+print(show(Math.floor()), show(Math.sqrt('16')), show(Math.abs(null)));
+// CHECK-NEXT: NaN 4 0
+
+print(show(Math.max()), show(Math.min()));
+// CHECK-NEXT: -Infinity Infinity
+print(show(Math.max(-0, 0)), show(Math.max(0, -0)), show(Math.min(0, -0)));
+// CHECK-NEXT: 0 0 -0
+print(show(Math.max(1, NaN)), show(Math.min(NaN, 1)), show(Math.max(2, 5, 3)));
+// CHECK-NEXT: NaN NaN 5
+print(show(Math.max(1, '7')), show(Math.min(4, true)));
+// CHECK-NEXT: 7 1
+
+// Conversions of non-number arguments are still observable.
+var calls = 0;
+var obj = {valueOf: function() { ++calls; return 10; }};
+print(Math.max(1, obj, NaN, obj), calls);
+// CHECK-NEXT: NaN 2
+
+print(Array.isArray([]), Array.isArray({length: 0}), Array.isArray());
+// CHECK-NEXT: true false false
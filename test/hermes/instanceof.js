@@ -52,3 +52,24 @@ print( (new ChildObj()) instanceof BoundBase);
 //CHECK-NEXT: true
 print( (new ChildObj()) instanceof BoundChild);
 //CHECK-NEXT: true
+
+// The same site sees changes to the prototype of a cached constructor.
+function isA(o, C) { return o instanceof C; }
+function Cached() {}
+var cachedObj = new Cached();
+for (var i = 0; i < 3; ++i)
+    isA(cachedObj, Cached);
+print(isA(cachedObj, Cached), isA({}, Cached), isA(1, Cached));
+//CHECK-NEXT: true false false
+Cached.prototype = {};
+print(isA(cachedObj, Cached), isA(new Cached(), Cached));
+//CHECK-NEXT: false true
+Cached.prototype = 2;
+try {
+    isA(cachedObj, Cached);
+} catch (e) {
+    print("caught", e.name, e.message);
+}
+//CHECK-NEXT: caught TypeError function's '.prototype' is not an object in 'instanceof'
+print(isA(new ChildObj(), BaseObj), isA(new BaseObj(), ChildObj));
+//CHECK-NEXT: true false
@@ -0,0 +1,68 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+print('json-parse-shapes');
+// CHECK-LABEL: json-parse-shapes
+
+// Records with the same keys, and with the keys in another order.
+var recs = JSON.parse(
+  '[{"id":1,"name":"a","tags":[]},{"id":2,"name":"b","tags":["x"]},' +
+  '{"name":"c","id":3,"tags":null},{"id":4,"name":"d","tags":[]}]');
+for (var i = 0; i < recs.length; ++i) {
+  print(Object.keys(recs[i]).join(), JSON.stringify(recs[i]));
+}
+// CHECK-NEXT: id,name,tags {"id":1,"name":"a","tags":[]}
+// CHECK-NEXT: id,name,tags {"id":2,"name":"b","tags":["x"]}
+// CHECK-NEXT: name,id,tags {"name":"c","id":3,"tags":null}
+// CHECK-NEXT: id,name,tags {"id":4,"name":"d","tags":[]}
+
+// A repeated key keeps its position and takes the last value, also when
+// it is escaped.
+var o = JSON.parse('{"a":1,"b":2,"a":3,"\\u0062":4}');
+print(Object.keys(o).join(), o.a, o.b);
+// CHECK-NEXT: a,b 3 4
+
+// Array index keys.
+o = JSON.parse('{"x":1,"1":2,"0":3,"01":4,"4294967295":5,"1":6}');
+print(Object.keys(o).join(), o[1], o["01"]);
+// CHECK-NEXT: 0,1,x,01,4294967295 6 4
+
+// __proto__ is an own data property.
+o = JSON.parse('{"__proto__":{"p":1},"q":2}');
+print(Object.getPrototypeOf(o) === Object.prototype, o.p, o.hasOwnProperty('__proto__'));
+// CHECK-NEXT: true undefined true
+
+// Many keys, repeating one defined after the first few dozen.
+var parts = [];
+for (var i = 0; i < 50; ++i) {
+  parts.push('"k' + i + '":' + i);
+}
+parts.push('"k40":"again"');
+parts.push('"k3":"again"');
+o = JSON.parse('{' + parts.join() + '}');
+print(Object.keys(o).length, o.k3, o.k40, o.k49);
+// CHECK-NEXT: 50 again again 49
+
+// Strings with long runs of plain characters around escapes.
+var s = JSON.parse('"abcdefghij\\"klmnopqrstuvwxyz\\\\0123456789\\u0041中end"');
+print(s, s.length);
+// CHECK-NEXT: abcdefghij"klmnopqrstuvwxyz\0123456789A中end 43
+print(JSON.parse('"' + 'x'.repeat(37) + '"').length);
+// CHECK-NEXT: 37
+
+try {
+  JSON.parse('"abcdefgh\u0001"');
+} catch (e) {
+  print(e.message);
+}
+// CHECK-NEXT: JSON Parse error: U+0000 thru U+001F is not allowed in string
+try {
+  JSON.parse('{"abcdefgh');
+} catch (e) {
+  print(e.message);
+}
+// CHECK-NEXT: JSON Parse error: Unexpected end of input
@@ -0,0 +1,68 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+print('json-stringify-shapes');
+// CHECK-LABEL: json-stringify-shapes
+
+// Objects with the same properties share the cached keys of their class.
+var recs = [];
+for (var i = 0; i < 3; ++i) {
+  recs.push({id: i, 'na"me': 'n' + i, nested: {x: -0, y: 1.5e300}});
+}
+print(JSON.stringify(recs));
+// CHECK-NEXT: [{"id":0,"na\"me":"n0","nested":{"x":0,"y":1.5e+300}},{"id":1,"na\"me":"n1","nested":{"x":0,"y":1.5e+300}},{"id":2,"na\"me":"n2","nested":{"x":0,"y":1.5e+300}}]
+print(JSON.stringify(recs[1], null, 2));
+// CHECK-NEXT: {
+// CHECK-NEXT:   "id": 1,
+// CHECK-NEXT:   "na\"me": "n1",
+// CHECK-NEXT:   "nested": {
+// CHECK-NEXT:     "x": 0,
+// CHECK-NEXT:     "y": 1.5e+300
+// CHECK-NEXT:   }
+// CHECK-NEXT: }
+
+// Non-enumerable properties, accessors, undefined and functions.
+var o = {a: 1, f: function() {}, u: undefined};
+Object.defineProperty(o, 'hidden', {value: 2, enumerable: false});
+Object.defineProperty(o, 'g', {get: function() { return 'got'; }, enumerable: true});
+print(JSON.stringify(o), JSON.stringify(o));
+// CHECK-NEXT: {"a":1,"g":"got"} {"a":1,"g":"got"}
+
+// Properties deleted or changed while the object is serialized.
+var p = {
+  a: {toJSON: function() { delete p.b; p.c = 'new'; return 'a'; }},
+  b: 2,
+  c: 3,
+};
+print(JSON.stringify(p));
+// CHECK-NEXT: {"a":"a","c":"new"}
+var q = {a: {toJSON: function() { q.b = 'changed'; return 1; }}, b: 2};
+print(JSON.stringify(q));
+// CHECK-NEXT: {"a":1,"b":"changed"}
+
+// Index-like keys come first, in order.
+print(JSON.stringify({b: 1, 2: 2, a: 3, 1: 4}));
+// CHECK-NEXT: {"1":4,"2":2,"b":1,"a":3}
+
+// Replacer functions and property lists.
+print(JSON.stringify({a: 1, b: 2}, function(k, v) { return k === 'a' ? 10 : v; }));
+// CHECK-NEXT: {"a":10,"b":2}
+print(JSON.stringify({a: 1, b: 2, c: 3}, ['c', 'a']));
+// CHECK-NEXT: {"c":3,"a":1}
+
+// Numbers, strings and large outputs.
+print(JSON.stringify([0, -1, 0.1, 1e21, NaN, -Infinity, 123456789012]));
+// CHECK-NEXT: [0,-1,0.1,1e+21,null,null,123456789012]
+print(JSON.stringify('é\n'), JSON.stringify({'ключ': 'значение'}));
+// CHECK-NEXT: "é\n" {"ключ":"значение"}
+var big = [];
+for (var i = 0; i < 1000; ++i) {
+  big.push({k: i});
+}
+var s = JSON.stringify(big);
+print(s.length, s.slice(-10), JSON.parse(s)[999].k);
+// CHECK-NEXT: 9891 {"k":999}] 999
@@ -0,0 +1,40 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -lazy -lazy-skip-preparse %s | %FileCheck --match-full-lines %s
+
+function brackets(x) {
+    // Braces in strings, comments and regexps don't count: { {
+    var s = "}}" + '{';
+    if (x) /}/.test(s);
+    var r = /[}]/g;
+    var d = (x + 4) / 2 / 1;
+    var o = {a: {b: [x / 2]}};
+    return s.replace(r, "") + " " + d + " " + o.a.b[0];
+}
+
+function broken() {
+    var x = ;
+    /* Some text to pad out the function so that it won't be eagerly compiled
+     * for being too short. Lorem ipsum dolor sit amet, consectetur adipiscing
+     * elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.
+     */
+}
+
+print("main");
+// CHECK: main
+
+print(brackets(6));
+// CHECK-NEXT: { 5 3
+
+try {
+    broken();
+} catch(e) {
+    print("caught", e.name);
+}
+// CHECK-NEXT: caught SyntaxError
+
+print("end");
+// CHECK-NEXT: end
@@ -0,0 +1,55 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+print('map-iteration-compaction');
+// CHECK-LABEL: map-iteration-compaction
+
+// Iterators continue in the right place after the entries are moved.
+var m = new Map();
+for (var i = 0; i < 20; ++i) m.set(i, 'v' + i);
+var it = m.entries();
+print(it.next().value, it.next().value);
+// CHECK-NEXT: 0,v0 1,v1
+for (var i = 0; i < 18; ++i) if (i !== 5) m.delete(i);
+print(m.size, it.next().value, it.next().value);
+// CHECK-NEXT: 3 5,v5 18,v18
+for (var i = 20; i < 60; ++i) m.set(i, 'v' + i);
+print(it.next().value, it.next().value, m.size);
+// CHECK-NEXT: 19,v19 20,v20 43
+
+// Deleting while iterating visits every element left exactly once.
+var s = new Set();
+for (var i = 0; i < 100; ++i) s.add(i);
+var seen = [];
+s.forEach(function(v) {
+  seen.push(v);
+  s.delete(v);
+  if (v % 10 === 0) s.delete(v + 1);
+});
+print(seen.length, s.size, seen.indexOf(1), seen.indexOf(2));
+// CHECK-NEXT: 90 0 -1 1
+
+// Entries added after clear() are visited by existing iterators.
+var c = new Set(['a', 'b', 'c']);
+var ci = c.values();
+print(ci.next().value);
+// CHECK-NEXT: a
+c.clear();
+c.add('d');
+print(ci.next().value, ci.next().done, c.size);
+// CHECK-NEXT: d true 1
+
+// Lookups after many deletions and reinsertions.
+var r = new Map();
+for (var round = 0; round < 5; ++round) {
+  for (var i = 0; i < 200; ++i) r.set('k' + i, round);
+  for (var i = 0; i < 200; i += 2) r.delete('k' + i);
+}
+print(r.size, r.get('k1'), r.has('k2'), r.get(NaN), r.set(-0, 1).get(0));
+// CHECK-NEXT: 100 4 false undefined 1
+print(Array.from(r.keys()).slice(0, 3).join());
+// CHECK-NEXT: k1,k3,k5
@@ -0,0 +1,80 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+print('map-key-hashing');
+// CHECK-LABEL: map-key-hashing
+
+// Equal strings are the same key however they were created.
+var long = 'x'.repeat(200);
+var m = new Map();
+m.set('hello', 1);
+m.set(long, 2);
+m.set('ሴa', 3);
+var parts = ['hel', 'lo'];
+print(m.get(parts.join('')), m.get('hel' + 'lo'), m.get('xhello'.slice(1)));
+// CHECK-NEXT: 1 1 1
+print(m.get('x'.repeat(100) + 'x'.repeat(100)), m.get(('y' + long).slice(1)));
+// CHECK-NEXT: 2 2
+print(m.get(String.fromCharCode(0x1234, 97)), m.has('ሴ'));
+// CHECK-NEXT: 3 false
+
+// Numbers, including +0 and -0 and NaN.
+var n = new Map();
+n.set(-0, 'zero');
+n.set(NaN, 'nan');
+n.set(1.5, 'frac');
+n.set(Math.pow(2, 53), 'big');
+print(n.get(0), n.get(-0), n.get(0 / 0), n.get(Math.sqrt(-1)));
+// CHECK-NEXT: zero zero nan nan
+print(n.get(3 / 2), n.get(Math.pow(2, 53) + 1), n.get('1.5'), n.size);
+// CHECK-NEXT: frac big undefined 4
+print(Object.is(n.keys().next().value, 0));
+// CHECK-NEXT: true
+
+var s = new Set();
+for (var i = 0; i < 1000; ++i) {
+  s.add(i);
+  s.add(i + 0.5);
+  s.add('k' + i);
+}
+var found = 0;
+for (var i = 0; i < 1000; ++i) {
+  if (s.has(i) && s.has(i + 0.5) && s.has('k' + i) && !s.has(String(i)))
+    ++found;
+}
+print(s.size, found);
+// CHECK-NEXT: 3000 1000
+
+// forEach sees entries added and deleted during the iteration.
+var f = new Map([[1, 'a'], [2, 'b'], [3, 'c']]);
+var seen = [];
+f.forEach(function(value, key, map) {
+  seen.push(this.prefix + key + value + (map === f));
+  if (key === 1) {
+    map.delete(2);
+    map.set(4, 'd');
+  }
+}, {prefix: '#'});
+print(seen.join(' '));
+// CHECK-NEXT: #1atrue #3ctrue #4dtrue
+
+seen = [];
+new Set(['x', 'y']).forEach(function(value, key) {
+  seen.push(value + key);
+});
+print(seen.join(' '));
+// CHECK-NEXT: xx yy
+
+try {
+  f.forEach(function(value, key) {
+    if (key === 3)
+      throw new Error('stop at ' + key);
+  });
+} catch (e) {
+  print(e.message);
+}
+// CHECK-NEXT: stop at 3
@@ -447,3 +447,51 @@ function testObjectAssignModifications() {
 }
 testObjectAssignModifications()
 //CHECK-NEXT: {"a":10,"c":32}
+
+function testShapeCachedProperties() {
+  // Same-shaped objects share the cache of their class.
+  function make(i) {
+    var o = {x: i, y: i + 1, z: i + 2, w: i + 3, v: i + 4, u: i + 5, t: i + 6};
+    Object.defineProperty(o, 'hidden', {value: 0, enumerable: false});
+    return o;
+  }
+  for (var i = 0; i < 2; ++i) {
+    var o = make(i);
+    print(Object.keys(o), Object.values(o), JSON.stringify(Object.entries(o)));
+  }
+
+  // An empty target takes the class of the source, and both can then change
+  // on their own.
+  var src = {a: 1, b: 2, c: 3, d: 4, e: 5, f: 6, g: 7, h: 8};
+  var copy = Object.assign({}, src);
+  copy.a = 10;
+  copy.i = 9;
+  delete src.h;
+  print(JSON.stringify(src), JSON.stringify(copy));
+  var spread = {...src};
+  spread.b = 20;
+  print(JSON.stringify(src), JSON.stringify(spread));
+  var {a, ...rest} = src;
+  print(a, JSON.stringify(rest));
+
+  // The setters of the prototype chain still run.
+  var proto = {set b(v) { print('set b', v); }};
+  var target = Object.create(proto);
+  Object.assign(target, {a: 1, b: 2});
+  print(JSON.stringify(target));
+
+  // A setter of the target removes a property of the source.
+  var from = {a: 1, b: 2, c: 3};
+  var to = {set a(v) { delete from.b; }};
+  Object.assign(to, from);
+  print(Object.keys(to));
+}
+testShapeCachedProperties()
+//CHECK-NEXT: x,y,z,w,v,u,t 0,1,2,3,4,5,6 [["x",0],["y",1],["z",2],["w",3],["v",4],["u",5],["t",6]]
+//CHECK-NEXT: x,y,z,w,v,u,t 1,2,3,4,5,6,7 [["x",1],["y",2],["z",3],["w",4],["v",5],["u",6],["t",7]]
+//CHECK-NEXT: {"a":1,"b":2,"c":3,"d":4,"e":5,"f":6,"g":7} {"a":10,"b":2,"c":3,"d":4,"e":5,"f":6,"g":7,"h":8,"i":9}
+//CHECK-NEXT: {"a":1,"b":2,"c":3,"d":4,"e":5,"f":6,"g":7} {"a":1,"b":20,"c":3,"d":4,"e":5,"f":6,"g":7}
+//CHECK-NEXT: 1 {"b":2,"c":3,"d":4,"e":5,"f":6,"g":7}
+//CHECK-NEXT: set b 2
+//CHECK-NEXT: {"a":1}
+//CHECK-NEXT: a,c
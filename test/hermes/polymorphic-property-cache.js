@@ -0,0 +1,82 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+// Exercise a single property access site with an increasing number of
+// shapes, through the monomorphic, polymorphic and megamorphic states.
+
+function getX(o) {
+  return o.x;
+}
+
+function setY(o, v) {
+  o.y = v;
+}
+
+var shapes = [
+  {x: 1},
+  {a: 0, x: 2},
+  {a: 0, b: 0, x: 3},
+  {a: 0, b: 0, c: 0, x: 4},
+  {a: 0, b: 0, c: 0, d: 0, x: 5},
+  {a: 0, b: 0, c: 0, d: 0, e: 0, x: 6},
+];
+
+for (var round = 0; round < 3; ++round) {
+  var sum = 0;
+  for (var i = 0; i < shapes.length; ++i) {
+    sum += getX(shapes[i]);
+    setY(shapes[i], i * round);
+  }
+  print(sum);
+}
+// CHECK: 21
+// CHECK-NEXT: 21
+// CHECK-NEXT: 21
+
+var ys = [];
+for (var i = 0; i < shapes.length; ++i) {
+  ys.push(shapes[i].y);
+}
+print(ys.join(','));
+// CHECK-NEXT: 0,2,4,6,8,10
+
+// A prototype hit must not be confused with an own property of another
+// shape cached at the same site.
+var proto = {x: 'proto'};
+var child = Object.create(proto);
+print(getX(child));
+// CHECK-NEXT: proto
+child.x = 'own';
+print(getX(child));
+// CHECK-NEXT: own
+
+// Drive a site megamorphic with many shapes, and make sure shapes that
+// share the runtime-wide cache still see their own layout, including across
+// a garbage collection.
+function makeShape(n) {
+  var o = {};
+  for (var i = 0; i < n; ++i) o['f' + i] = i;
+  o.x = n;
+  return o;
+}
+var many = [];
+for (var i = 0; i < 20; ++i) many.push(makeShape(i));
+function sumX() {
+  var s = 0;
+  for (var i = 0; i < many.length; ++i) s += getX(many[i]);
+  return s;
+}
+print(sumX());
+// CHECK-NEXT: 190
+gc();
+for (var i = 0; i < many.length; ++i) setY(many[i], 1);
+print(sumX());
+// CHECK-NEXT: 190
+Object.freeze(many[3]);
+setY(many[3], 2);
+print(many[3].y);
+// CHECK-NEXT: 1
@@ -0,0 +1,78 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+print('primitive-conversions');
+// CHECK-LABEL: primitive-conversions
+
+// Small integers and other numbers.
+print(String(0), String(-0), String(7), String(1023), String(1024), String(-7));
+// CHECK-NEXT: 0 0 7 1023 1024 -7
+print('' + 42, 42 + '', 1.5 + '', String(1e21));
+// CHECK-NEXT: 42 42 1.5 1e+21
+var obj = {};
+obj[5] = 'five';
+print(obj['' + 5], obj[String(2 + 3)]);
+// CHECK-NEXT: five five
+
+// Objects with the built-in toString and valueOf.
+print(String({}), '' + {}, {} + 1, [1, 2] + '');
+// CHECK-NEXT: [object Object] [object Object] [object Object]1 1,2
+var tagged = {};
+tagged[Symbol.toStringTag] = 'Tagged';
+print(String(tagged));
+// CHECK-NEXT: [object Tagged]
+
+// User-defined valueOf and toString are still called, in the right order.
+var log = [];
+var custom = {
+  valueOf: function() {
+    log.push('valueOf');
+    return 10;
+  },
+  toString: function() {
+    log.push('toString');
+    return 'custom';
+  },
+};
+print(custom + 1, String(custom), custom < 11, custom == 10, log.join());
+// CHECK-NEXT: 11 custom true true valueOf,toString,valueOf,valueOf
+var proto = {
+  toString: function() {
+    return 'from proto';
+  },
+};
+print('' + Object.create(proto));
+// CHECK-NEXT: from proto
+var noPrimitive = {
+  valueOf: function() {
+    return {};
+  },
+  toString: function() {
+    return {};
+  },
+};
+try {
+  '' + noPrimitive;
+} catch (e) {
+  print(e.name);
+}
+// CHECK-NEXT: TypeError
+
+// Comparisons.
+print('10' < '9', 10 < '9', '10' < 9, 'a' < 'b', null < 1, undefined < 1);
+// CHECK-NEXT: true false false true true false
+print([2] > 1, {} < {}, NaN <= NaN, '' >= 0);
+// CHECK-NEXT: true false false true
+
+// Abstract equality.
+print(null == undefined, undefined == null, null == 0, '1' == 1, true == 1);
+// CHECK-NEXT: true true false true true
+print(NaN == NaN, 0 == -0, 'a' == 'a', {} == '[object Object]', [1] == 1);
+// CHECK-NEXT: false true true true true
+var sym = Symbol('s');
+print(sym == sym, Object(sym) == sym, sym == 's');
+// CHECK-NEXT: true true false
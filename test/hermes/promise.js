@@ -0,0 +1,98 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -Xvm-experiment-flags=128 %s | %FileCheck --match-full-lines %s
+
+print('promise');
+// CHECK-LABEL: promise
+
+print(typeof Promise, Promise.length, Object.prototype.toString.call(Promise.resolve()));
+// CHECK-NEXT: function 1 [object Promise]
+try {
+  Promise(function() {});
+} catch (e) {
+  print(e.name);
+}
+// CHECK-NEXT: TypeError
+try {
+  new Promise(1);
+} catch (e) {
+  print(e.name);
+}
+// CHECK-NEXT: TypeError
+
+// Jobs run after the script, in order.
+var log = [];
+var p = new Promise(function(resolve) {
+  log.push('executor');
+  resolve(1);
+});
+p.then(function(v) { log.push('a' + v); });
+p.then(function(v) { log.push('b' + v); return v + 1; })
+  .then(function(v) { log.push('c' + v); });
+Promise.resolve().then(function() { log.push('d'); });
+log.push('sync');
+
+// Rejections, catch and the handlers passed through.
+Promise.reject(new Error('boom'))
+  .then(function() { print('not called'); })
+  .catch(function(e) { print('caught', e.message); return 'recovered'; })
+  .then(function(v) { print('then', v); });
+new Promise(function() { throw 'thrown'; })
+  .then(null, function(e) { print('executor threw', e); });
+Promise.resolve(5).then().then(function(v) { print('passed through', v); });
+
+// Only the first resolution counts.
+new Promise(function(resolve, reject) {
+  resolve('first');
+  reject('second');
+  resolve('third');
+}).then(function(v) { print('settled', v); });
+
+// Thenables and self-resolution.
+Promise.resolve({then: function(resolve) { resolve('thenable'); }})
+  .then(function(v) { print('resolved', v); });
+var self = new Promise(function(resolve) {
+  resolveLater(function() { resolve(self); });
+});
+function resolveLater(f) { Promise.resolve().then(f); }
+self.catch(function(e) { print('self', e.name); });
+print(Promise.resolve(p) === p);
+// CHECK-NEXT: true
+
+// finally.
+Promise.resolve('kept').finally(function() { print('finally'); return 'ignored'; })
+  .then(function(v) { print('after finally', v); });
+Promise.reject('reason').finally(function() {})
+  .catch(function(e) { print('after finally', e); });
+
+// all and race.
+Promise.all([1, Promise.resolve(2), {then: function(r) { r(3); }}])
+  .then(function(v) { print('all', v.join()); });
+Promise.all([]).then(function(v) { print('all empty', v.length); });
+Promise.all([Promise.reject('no'), 1]).catch(function(e) { print('all rejected', e); });
+Promise.race([new Promise(function() {}), Promise.resolve('fast')])
+  .then(function(v) { print('race', v); });
+Promise.all(5).catch(function(e) { print('all', e.name); });
+
+Promise.resolve().then(function() {}).then(function() {}).then(function() {})
+  .then(function() { print(log.join()); });
+// CHECK-NEXT: executor threw thrown
+// CHECK-NEXT: settled first
+// CHECK-NEXT: finally
+// CHECK-NEXT: all empty 0
+// CHECK-NEXT: all TypeError
+// CHECK-NEXT: caught boom
+// CHECK-NEXT: passed through 5
+// CHECK-NEXT: resolved thenable
+// CHECK-NEXT: self TypeError
+// CHECK-NEXT: all rejected no
+// CHECK-NEXT: race fast
+// CHECK-NEXT: then recovered
+// CHECK-NEXT: all 1,2,3
+// CHECK-NEXT: after finally kept
+// CHECK-NEXT: after finally reason
+// CHECK-NEXT: executor,sync,a1,b1,d,c2
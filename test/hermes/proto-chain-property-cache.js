@@ -0,0 +1,69 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+// Check that the prototype-chain property cache is invalidated by every kind
+// of change to the objects on the chain.
+
+function Base() {}
+Base.prototype.name = function() { return 'base'; };
+
+function Derived() {}
+Derived.prototype = Object.create(Base.prototype);
+
+function callName(o) {
+  return o.name();
+}
+
+var b = new Base();
+var d = new Derived();
+
+// Populate the cache for a method on the parent and on the grandparent.
+print(callName(b), callName(b));
+// CHECK: base base
+print(callName(d), callName(d));
+// CHECK-NEXT: base base
+
+// Shadow the method on the intermediate prototype.
+Derived.prototype.name = function() { return 'derived'; };
+print(callName(d), callName(b));
+// CHECK-NEXT: derived base
+
+// Remove the shadowing method again.
+delete Derived.prototype.name;
+print(callName(d));
+// CHECK-NEXT: base
+
+// Replace the method on the holder.
+Base.prototype.name = function() { return 'base2'; };
+print(callName(b), callName(d));
+// CHECK-NEXT: base2 base2
+
+// Change the prototype of the receiver without changing its class.
+var other = { name: function() { return 'other'; } };
+Object.setPrototypeOf(b, other);
+print(callName(b));
+// CHECK-NEXT: other
+
+// Shadow the method on the receiver itself.
+d.name = function() { return 'own'; };
+print(callName(d));
+// CHECK-NEXT: own
+
+// Turn the holder into a dictionary and delete the property.
+var holder = {};
+for (var i = 0; i < 100; ++i) holder['p' + i] = i;
+holder.name = function() { return 'dict'; };
+var recv = Object.create(holder);
+print(callName(recv), callName(recv));
+// CHECK-NEXT: dict dict
+delete holder.name;
+try {
+  callName(recv);
+} catch (e) {
+  print('caught', e.constructor.name);
+}
+// CHECK-NEXT: caught TypeError
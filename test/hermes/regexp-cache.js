@@ -0,0 +1,39 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+print('regexp-cache');
+// CHECK-LABEL: regexp-cache
+
+// RegExps built from the same pattern share their bytecode, but not their
+// flags or lastIndex.
+var src = 'a(b)';
+var plain = new RegExp(src);
+var global = new RegExp(src, 'g');
+var icase = new RegExp(src, 'i');
+print(plain.exec('xAbab'), global.exec('xAbab').index, icase.exec('xAbab'));
+// CHECK-NEXT: ab,b 3 Ab,b
+print(global.lastIndex, plain.lastIndex, new RegExp(src, 'gi').global);
+// CHECK-NEXT: 5 0 true
+print(new RegExp('^b', 'm').test('a\nb'), new RegExp('^b').test('a\nb'));
+// CHECK-NEXT: true false
+
+// Invalid patterns are rejected every time.
+for (var i = 0; i < 2; i++) {
+  try {
+    new RegExp('a(');
+  } catch (e) {
+    print(e.name);
+  }
+}
+// CHECK-NEXT: SyntaxError
+// CHECK-NEXT: SyntaxError
+
+// Many distinct patterns, and the first one again.
+for (var i = 0; i < 200; i++)
+  new RegExp('p' + i);
+print(new RegExp('p0').test('p0'), new RegExp(src).source);
+// CHECK-NEXT: true a(b)
@@ -0,0 +1,48 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+print('regexp-match-start');
+// CHECK-LABEL: regexp-match-start
+
+// Regexps starting with literal characters.
+var log = 'id=1 level=warn msg=a\nid=2 level=error msg=b\nid=3 level=err';
+var re = /level=(\w+)/g;
+var m;
+while ((m = re.exec(log)))
+  print(m.index, m[1]);
+// CHECK-NEXT: 5 warn
+// CHECK-NEXT: 27 error
+// CHECK-NEXT: 50 err
+print(/((ab)c)d/.exec('abcabcabcd'));
+// CHECK-NEXT: abcd,abc,ab
+print(/aab/.exec('aaaab').index, /ab/.exec('a'), /ab/.exec('xxa'));
+// CHECK-NEXT: 2 null null
+print(/\u0100\u0101/.exec('x\u0100\u0100\u0101').index, /\u0100/.exec('a'));
+// CHECK-NEXT: 2 null
+print(/\u00e9/.exec('caf\u00e9').index, /x\u0100/.test('xx'));
+// CHECK-NEXT: 3 false
+
+// Regexps starting with a single character test.
+print(/[0-9]+/.exec('abc 123 45'), /\bq./i.exec('xQ qz').index);
+// CHECK-NEXT: 123 3
+print(/Q/i.exec('aaaqQ').index, /.b/.exec('\n\nab').index, /[^a]/.exec('aa'));
+// CHECK-NEXT: 3 2 null
+
+// Regexps which can start anywhere.
+print(/a|b/.exec('xxb').index, /a*/.exec('xyz').index, /$/.exec('abc').index);
+// CHECK-NEXT: 2 0 3
+print(/(?=c)/.exec('abc').index, /x?y/.exec('aay').index);
+// CHECK-NEXT: 2 2
+
+// Sticky regexps only match at lastIndex.
+var sticky = /ab/y;
+sticky.lastIndex = 1;
+print(sticky.test('xxab'), sticky.lastIndex);
+// CHECK-NEXT: false 0
+sticky.lastIndex = 2;
+print(sticky.test('xxab'), sticky.lastIndex);
+// CHECK-NEXT: true 4
@@ -0,0 +1,32 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+print('regexp-nfa');
+// CHECK-LABEL: regexp-nfa
+
+// Patterns whose backtracking takes exponential time.
+var as = 'a'.repeat(40);
+print(/(a+)+b/.exec(as), /(a|aa)*c/.test(as), /^(a*)*$/.test(as + 'b'));
+// CHECK-NEXT: null false false
+print(/(x+x+)+y/.test('x'.repeat(50)), /(\w+\s?)+$/.test(as + '!'));
+// CHECK-NEXT: false false
+print(/(a+)+b/.exec(as + 'b')[1].length, /(a+?)+?b/.exec(as + 'b')[1]);
+// CHECK-NEXT: 40 a
+var m = /((a)|(b))+c/.exec('ab'.repeat(30) + 'c');
+print(m.index, m[1], m[2], m[3]);
+// CHECK-NEXT: 0 b undefined b
+m = /(a|ab)(c|bcd)(d*)+e/.exec('abcd'.repeat(10) + 'abcde');
+print(m.index, m[0], m[1], m[2], m[3].length);
+// CHECK-NEXT: 40 abcde a bcd 0
+
+// The same results as backtracking on patterns that backtrack little.
+print(/(a|ab)(c|bcd)(d*)/.exec('abcd'), /(a*?)(a*)/.exec('aaa'));
+// CHECK-NEXT: abcd,a,bcd, aaa,,aaa
+print(/(?:(a)|b)+/.exec('ab'), /(a{2,3}?)+$/.exec('aaaaa'));
+// CHECK-NEXT: ab, aaaaa,aaa
+print(/(z)((a+)?(b+)?(c))*/.exec('zaacbbbcac'));
+// CHECK-NEXT: zaacbbbcac,z,ac,a,,c
@@ -0,0 +1,46 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O -Xregister-stack-guard %s | %FileCheck --match-full-lines %s
+// RUN: %hermes -O -emit-binary -out %t.hbc %s && %hermes -Xregister-stack-guard %t.hbc | %FileCheck --match-full-lines %s
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+"use strict";
+
+print('register stack guard');
+// CHECK-LABEL: register stack guard
+
+function recurse(n) {
+  return recurse(n + 1) + 1;
+}
+
+function overflow() {
+  try {
+    recurse(0);
+  } catch (e) {
+    return e instanceof RangeError ? e.message : 'unexpected ' + e;
+  }
+}
+
+print(overflow());
+// CHECK-NEXT: Maximum call stack size exceeded
+// The guard region is protected again once the frames in it are popped.
+print(overflow());
+// CHECK-NEXT: Maximum call stack size exceeded
+
+// The frames near the end of the stack catch the overflow and call again,
+// which overflows until enough frames are popped.
+var overflows = 0;
+function retry() {
+  try {
+    retry();
+  } catch (e) {
+    ++overflows;
+    recurse.length.toString();
+    (function() {})();
+  }
+}
+retry();
+print(overflows > 0, overflow());
+// CHECK-NEXT: true Maximum call stack size exceeded
@@ -0,0 +1,48 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+// TypedArrays without a compare function, and arrays of numbers with one that
+// just subtracts its arguments, are sorted without calling back into JS.
+// Check that the order is the one the compare function would give.
+
+function signs(arr) {
+  return Array.prototype.map.call(arr, function(x) {
+    return x === 0 ? (1 / x > 0 ? '+0' : '-0') : String(x);
+  }).join(',');
+}
+
+print('typed');
+// CHECK-LABEL: typed
+print(new Int8Array([3, -1, 127, -128, 0]).sort().join(','));
+// CHECK-NEXT: -128,-1,0,3,127
+print(new Uint32Array([4294967295, 0, 7]).sort().join(','));
+// CHECK-NEXT: 0,7,4294967295
+print(signs(new Float64Array([3, NaN, 0, -0, -Infinity, 1]).sort()));
+// CHECK-NEXT: -Infinity,-0,+0,1,3,NaN
+print(new Int16Array([3, 1, 2]).sort(function(a, b) { return b - a; }).join());
+// CHECK-NEXT: 3,2,1
+print(signs(new Float32Array([1, 0, -0, -1]).sort((a, b) => a - b)));
+// CHECK-NEXT: -1,+0,-0,1
+
+print('array');
+// CHECK-LABEL: array
+print([10, 9, 1, 100].sort((a, b) => a - b).join());
+// CHECK-NEXT: 1,9,10,100
+print([10, 9, 1, 100].sort(function(x, y) { return y - x; }).join());
+// CHECK-NEXT: 100,10,9,1
+print(signs([0, 1, -0, -1].sort((a, b) => a - b)));
+// CHECK-NEXT: -1,+0,-0,1
+print([3, '1', 2].sort((a, b) => a - b).join());
+// CHECK-NEXT: 1,2,3
+
+var calls = 0;
+[3, 1, 2].sort(function(a, b) {
+  ++calls;
+  return a - b;
+});
+print(calls > 0);
+// CHECK-NEXT: true
@@ -0,0 +1,37 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O -target=HBC -fno-inline %s | %FileCheck --match-full-lines %s
+
+// The names of the functions on the stack are read when the stack is first
+// formatted, not when the error is thrown.
+
+function thrower() {
+  throw new Error("lazy");
+}
+
+function caller() {
+  thrower();
+}
+
+var err;
+try {
+  caller();
+} catch (e) {
+  err = e;
+}
+Object.defineProperty(caller, "name", {value: "renamedCaller"});
+Object.defineProperty(thrower, "name", {get: function() { return "nope"; }});
+print(err.stack);
+//CHECK-LABEL: Error: lazy
+//CHECK-NEXT:     at thrower ({{.*}}stacktrace-lazy-names.js:12:18)
+//CHECK-NEXT:     at renamedCaller ({{.*}}stacktrace-lazy-names.js:16:10)
+
+// The stack is formatted once.
+Object.defineProperty(caller, "name", {value: "again"});
+print(err.stack === err.stack);
+//CHECK: true
+print(err.stack.indexOf("again"));
+//CHECK-NEXT: -1
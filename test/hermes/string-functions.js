@@ -33,6 +33,22 @@ print('empty', String.fromCharCode());
 // CHECK-NEXT: empty
 print(String.fromCharCode(0xff0048, 0xe8, 114, 109, 101, 115));
 // CHECK-NEXT: Hèrmes
+print(String.fromCharCode(72, 105, -1, NaN, Infinity).length);
+// CHECK-NEXT: 5
+print(String.fromCharCode(72, '105', {valueOf: function() { return 33; }}));
+// CHECK-NEXT: Hi!
+var codes = [];
+for (var i = 0; i < 10000; ++i)
+  codes.push(97 + i % 26);
+var applied = String.fromCharCode.apply(null, codes);
+print(applied.length, applied.slice(0, 5), applied.charCodeAt(9999));
+// CHECK-NEXT: 10000 abcde 112
+codes[9999] = 0x416;
+applied = String.fromCharCode.apply(undefined, codes);
+print(applied.length, applied.charCodeAt(9999));
+// CHECK-NEXT: 10000 1046
+print(String.fromCharCode.apply(null, [72, '105']));
+// CHECK-NEXT: Hi
 
 print('fromCodePoint');
 // CHECK-LABEL: fromCodePoint
@@ -96,6 +112,12 @@ print("💩".charCodeAt(0))
 // CHECK-NEXT: 55357
 print("💩".charCodeAt(1))
 // CHECK-NEXT: 56489
+print('abc'.charCodeAt(), 'abc'.charCodeAt(NaN), 'abc'.charCodeAt(-0.5));
+// CHECK-NEXT: 97 97 97
+print('abc'.charCodeAt('2'), 'abc'.charCodeAt(Infinity));
+// CHECK-NEXT: 99 NaN
+print(String.prototype.charCodeAt.call(123, 1));
+// CHECK-NEXT: 50
 
 print('codePointAt');
 // CHECK-LABEL: codePointAt
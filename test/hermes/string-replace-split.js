@@ -0,0 +1,65 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+print('string-replace-split');
+// CHECK-LABEL: string-replace-split
+
+// String patterns, with and without $ replacement strings.
+print('abcabc'.replace('b', 'X'), 'abc'.replace('c', ''));
+// CHECK-NEXT: aXcabc ab
+print('abc'.replace('', '-'), 'abc'.replace('d', 'x'));
+// CHECK-NEXT: -abc abc
+print('abc'.replace('b', '[$&$`$\'$$]'), 'abc'.replace('b', '$'));
+// CHECK-NEXT: a[bac$]c a$c
+print('[' + 'abc'.replace('abc', '') + ']', ''.replace('', 'x'));
+// CHECK-NEXT: [] x
+print('héllo'.replace('l', '世'), 'abc'.replace('b', 'é'));
+// CHECK-NEXT: hé世lo aéc
+print('abc'.replace('b', function(m, pos) { return m + pos; }));
+// CHECK-NEXT: ab1c
+
+// RegExp patterns with the built-in exec.
+print('aXbXc'.replace(/X/g, '--'), 'aXbXc'.replace(/X/, '--'));
+// CHECK-NEXT: a--b--c a--bXc
+print('abc'.replace(/x*/g, '-'), 'abc'.replace(/$/g, '!'));
+// CHECK-NEXT: -a-b-c- abc!
+print('[' + 'aaa'.replace(/a/g, '') + ']', 'aaa'.replace(/a/, ''));
+// CHECK-NEXT: [] aa
+print('a1b22'.replace(/(\d)+/g, '<$1>'), 'aéb'.replace(/b/g, '世'));
+// CHECK-NEXT: a<1>b<2> aé世
+
+// lastIndex is reset by global searches and ignored by the others.
+var re = /b/g;
+re.lastIndex = 2;
+print('abab'.replace(re, 'X'), re.lastIndex);
+// CHECK-NEXT: aXaX 0
+re = /b/;
+re.lastIndex = 2;
+print('abab'.replace(re, 'X'), re.lastIndex);
+// CHECK-NEXT: aXab 2
+
+// A user-defined exec is called for every match.
+re = /b/g;
+var calls = 0;
+re.exec = function(s) {
+  calls++;
+  return RegExp.prototype.exec.call(this, s);
+};
+print('abcb'.replace(re, 'X'), calls);
+// CHECK-NEXT: aXcX 3
+
+// String separators.
+print(JSON.stringify('a,b,,c'.split(',')), JSON.stringify('a,b'.split(',', 1)));
+// CHECK-NEXT: ["a","b","","c"] ["a"]
+print(JSON.stringify('abc'.split('')), JSON.stringify('abc'.split('', 2)));
+// CHECK-NEXT: ["a","b","c"] ["a","b"]
+print(JSON.stringify(',a,'.split(',')), JSON.stringify('a--b--'.split('--')));
+// CHECK-NEXT: ["","a",""] ["a","b",""]
+print(JSON.stringify('abc'.split('abcd')), JSON.stringify(''.split('')));
+// CHECK-NEXT: ["abc"] []
+print(JSON.stringify('aébé'.split('é')), 'abc'.split('b', 0).length);
+// CHECK-NEXT: ["a","b",""] 0
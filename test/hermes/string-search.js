@@ -0,0 +1,51 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: LANG=en_US.UTF-8 %hermes -O %s | %FileCheck --match-full-lines %s
+
+print('string-search');
+// CHECK-LABEL: string-search
+
+// Haystacks longer than a chunk, with near matches before the match.
+var hay = 'ab'.repeat(40) + 'abc' + 'ab'.repeat(40) + 'abc';
+print(hay.indexOf('abc'), hay.lastIndexOf('abc'), hay.indexOf('abc', 84));
+// CHECK-NEXT: 80 163 163
+print(hay.indexOf('ca'), hay.indexOf('cb'), hay.lastIndexOf('ab', 3));
+// CHECK-NEXT: 82 -1 2
+print(hay.includes('abc', 164), hay.includes('bab'), hay.includes('bb'));
+// CHECK-NEXT: false true false
+print(hay.indexOf(''), hay.indexOf('', 1000), hay.lastIndexOf('', 5));
+// CHECK-NEXT: 0 166 5
+
+// Needles long enough to skip through the haystack.
+var needle = 'x'.repeat(39) + 'y';
+var longHay = 'x'.repeat(500) + needle + 'x'.repeat(100);
+print(longHay.indexOf(needle), longHay.lastIndexOf(needle));
+// CHECK-NEXT: 500 500
+print(longHay.indexOf(needle, 501), longHay.includes(needle + 'x'));
+// CHECK-NEXT: -1 true
+
+// ASCII needles in UTF-16 haystacks and the other way around.
+var wide = 'Ţ'.repeat(30) + 'abcŢ' + 'b'.repeat(30);
+print(wide.indexOf('abc'), wide.lastIndexOf('b'), wide.indexOf('cŢ'));
+// CHECK-NEXT: 30 63 32
+print(hay.indexOf('abŢ'), hay.includes('Ţ'), wide.indexOf('bb', 40));
+// CHECK-NEXT: -1 false 40
+print('b'.repeat(20).indexOf('Ţ'), wide.lastIndexOf('ŢŢ', 10));
+// CHECK-NEXT: -1 10
+
+// Comparison of strings that only differ after a chunk.
+var a = 'q'.repeat(40) + 'a';
+var b = 'q'.repeat(40) + 'b';
+print(a < b, b < a, a === 'q'.repeat(40) + 'a', a < a + 'a');
+// CHECK-NEXT: true false true true
+print(a < 'q'.repeat(40) + 'Ţ', 'Ţ'.repeat(20) < a);
+// CHECK-NEXT: true false
+
+// Escapes after runs of characters that don't need them.
+print(JSON.stringify('x'.repeat(20) + '"\n' + 'y'.repeat(20) + '\\\u0001'));
+// CHECK-NEXT: "xxxxxxxxxxxxxxxxxxxx\"\nyyyyyyyyyyyyyyyyyyyy\\\u0001"
+print(JSON.stringify('Ģ'.repeat(17) + '\t'));
+// CHECK-NEXT: "ĢĢĢĢĢĢĢĢĢĢĢĢĢĢĢĢĢ\t"
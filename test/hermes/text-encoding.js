@@ -0,0 +1,110 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: LC_ALL=en_US.UTF-8 %hermes -O -target=HBC %s | %FileCheck --match-full-lines %s
+"use strict";
+
+function bytes(arr) {
+  return Array.prototype.join.call(arr, ',');
+}
+
+function codes(str) {
+  var result = [];
+  for (var i = 0; i < str.length; ++i)
+    result.push(str.charCodeAt(i).toString(16));
+  return result.join(',');
+}
+
+function tryRun(f) {
+  try {
+    return f();
+  } catch (e) {
+    return e.name;
+  }
+}
+
+print('TextEncoder');
+// CHECK-LABEL: TextEncoder
+var enc = new TextEncoder();
+print(enc.encoding, Object.prototype.toString.call(enc));
+// CHECK-NEXT: utf-8 [object TextEncoder]
+print(bytes(enc.encode('abc')));
+// CHECK-NEXT: 97,98,99
+print(enc.encode().length, enc.encode('').length);
+// CHECK-NEXT: 0 0
+print(bytes(enc.encode('é€😀')));
+// CHECK-NEXT: 195,169,226,130,172,240,159,152,128
+print(bytes(enc.encode('\ud800x\udc00')));
+// CHECK-NEXT: 239,191,189,120,239,191,189
+print(tryRun(function() { return TextEncoder(); }));
+// CHECK-NEXT: TypeError
+
+var dest = new Uint8Array(5);
+var res = enc.encodeInto('a€b', dest);
+print(res.read, res.written, bytes(dest));
+// CHECK-NEXT: 3 5 97,226,130,172,98
+dest = new Uint8Array(3);
+res = enc.encodeInto('a€', dest);
+print(res.read, res.written, bytes(dest));
+// CHECK-NEXT: 1 1 97,0,0
+print(tryRun(function() { return enc.encodeInto('a', []); }));
+// CHECK-NEXT: TypeError
+
+print('TextDecoder');
+// CHECK-LABEL: TextDecoder
+var dec = new TextDecoder();
+print(dec.encoding, dec.fatal, dec.ignoreBOM);
+// CHECK-NEXT: utf-8 false false
+print(new TextDecoder(' UTF8 ', {fatal: true}).fatal);
+// CHECK-NEXT: true
+print(tryRun(function() { return new TextDecoder('latin1'); }));
+// CHECK-NEXT: RangeError
+print(dec.decode(new Uint8Array([104, 105])));
+// CHECK-NEXT: hi
+print(dec.decode(), dec.decode(new ArrayBuffer(0)).length);
+// CHECK-NEXT:  0
+print(codes(dec.decode(new Uint8Array([0xef, 0xbb, 0xbf, 0x41]))));
+// CHECK-NEXT: 41
+print(codes(new TextDecoder('utf-8', {ignoreBOM: true}).decode(
+    new Uint8Array([0xef, 0xbb, 0xbf, 0x41]))));
+// CHECK-NEXT: feff,41
+print(codes(dec.decode(new Uint8Array([0xf0, 0x9f, 0x98, 0x80]).buffer)));
+// CHECK-NEXT: d83d,de00
+var view = new DataView(new Uint8Array([0, 0xc3, 0xa9]).buffer, 1);
+print(codes(dec.decode(view)));
+// CHECK-NEXT: e9
+print(codes(dec.decode(new Uint8Array([0x61, 0xc3, 0x62, 0xed, 0xa0, 0x80]))));
+// CHECK-NEXT: 61,fffd,62,fffd,fffd,fffd
+print(codes(dec.decode(new Uint8Array([0xe2, 0x82]))));
+// CHECK-NEXT: fffd
+print(tryRun(function() {
+  return new TextDecoder('utf-8', {fatal: true}).decode(new Uint8Array([0xff]));
+}));
+// CHECK-NEXT: TypeError
+print(tryRun(function() { return dec.decode('abc'); }));
+// CHECK-NEXT: TypeError
+
+var euro = enc.encode('€€');
+var parts = [];
+for (var i = 0; i < euro.length; ++i)
+  parts.push(dec.decode(euro.subarray(i, i + 1), {stream: true}));
+parts.push(dec.decode());
+print(codes(parts.join('')));
+// CHECK-NEXT: 20ac,20ac
+
+print('base64');
+// CHECK-LABEL: base64
+print(btoa(''), btoa('f'), btoa('fo'), btoa('foo'), btoa('\xff\xfe'));
+// CHECK-NEXT:  Zg== Zm8= Zm9v //4=
+print(atob('Zm9v'), atob('Zm8='), atob(' Zg = = '), atob('Zm8'));
+// CHECK-NEXT: foo fo f fo
+print(codes(atob('//4=')));
+// CHECK-NEXT: ff,fe
+print(tryRun(function() { return btoa('Ā'); }));
+// CHECK-NEXT: RangeError
+print(tryRun(function() { return atob('Z'); }));
+// CHECK-NEXT: SyntaxError
+print(tryRun(function() { return atob('Zm9v!'); }));
+// CHECK-NEXT: SyntaxError
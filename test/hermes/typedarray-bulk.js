@@ -0,0 +1,59 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+print('typedarray-bulk');
+// CHECK-LABEL: typedarray-bulk
+
+// Copies between different kinds convert each element.
+var f = new Float64Array([1.5, -1, 300, NaN, -0, 1e10]);
+print(new Int8Array(f).join());
+// CHECK-NEXT: 1,-1,44,0,0,0
+print(new Uint8ClampedArray(f).join());
+// CHECK-NEXT: 2,0,255,0,0,255
+var u = new Uint32Array(3);
+u.set(new Int16Array([-1, 2, -3]));
+print(u.join());
+// CHECK-NEXT: 4294967295,2,4294967293
+print(new Float32Array(u).join());
+// CHECK-NEXT: 4294967296,2,4294967296
+print(new Int32Array(2).fill(7).slice(0).join());
+// CHECK-NEXT: 7,7
+
+// Overlapping copies in both directions.
+var c = new Int16Array([0, 1, 2, 3, 4, 5]);
+print(c.copyWithin(2, 0, 4).join());
+// CHECK-NEXT: 0,1,0,1,2,3
+print(c.copyWithin(0, 2).join());
+// CHECK-NEXT: 0,1,2,3,2,3
+print(c.copyWithin(1, 3, 2).join());
+// CHECK-NEXT: 0,1,2,3,2,3
+
+print(new Float32Array([1, 2, 3, 4, 5]).reverse().join());
+// CHECK-NEXT: 5,4,3,2,1
+print(new Uint8Array(0).reverse().length);
+// CHECK-NEXT: 0
+
+// Searches compare values of the element type.
+var i8 = new Int8Array([1, 0, -128, 1, 0]);
+print(i8.indexOf(1), i8.lastIndexOf(1), i8.indexOf(1, 1), i8.lastIndexOf(1, 2));
+// CHECK-NEXT: 0 3 3 0
+print(i8.indexOf(-0), i8.lastIndexOf(0, -2), i8.includes(-128));
+// CHECK-NEXT: 1 1 true
+print(i8.indexOf(129), i8.indexOf(1.5), i8.indexOf(NaN), i8.includes(NaN));
+// CHECK-NEXT: -1 -1 -1 false
+print(i8.indexOf(0, 10), i8.lastIndexOf(0, -10), i8.indexOf(0, -2));
+// CHECK-NEXT: -1 -1 4
+var f32 = new Float32Array([0.5, NaN, -0, 0.1, Infinity]);
+print(f32.indexOf(NaN), f32.includes(NaN), f32.indexOf(0), f32.lastIndexOf(-0));
+// CHECK-NEXT: -1 true 2 2
+print(f32.indexOf(0.1), f32.indexOf(Math.fround(0.1)), f32.indexOf(Infinity));
+// CHECK-NEXT: -1 3 4
+print(f32.includes(1e300), f32.indexOf('0.5'), f32.indexOf(0.5, 1));
+// CHECK-NEXT: false -1 -1
+var u32 = new Uint32Array([4294967295, 0]);
+print(u32.indexOf(-1), u32.indexOf(4294967295), u32.includes(-0));
+// CHECK-NEXT: -1 0 true
@@ -55,3 +55,33 @@ print(type_of_number(4));
 
 print(type_of_object(4));
 //CHECK: object
+
+// Comparisons of typeof with a string literal.
+function checks(x) {
+  return [
+    typeof x === "number",
+    typeof x == "string",
+    "object" === typeof x,
+    typeof x !== "function",
+    typeof x != "undefined",
+    typeof x === "boolean",
+    typeof x === "symbol",
+    typeof x === "bogus",
+    typeof x !== "bogus",
+  ].join();
+}
+
+print(checks(1));
+//CHECK: true,false,false,true,true,false,false,false,true
+print(checks("a"));
+//CHECK: false,true,false,true,true,false,false,false,true
+print(checks(null));
+//CHECK: false,false,true,true,true,false,false,false,true
+print(checks(print));
+//CHECK: false,false,false,false,true,false,false,false,true
+print(checks(undefined));
+//CHECK: false,false,false,true,false,false,false,false,true
+print(checks(false));
+//CHECK: false,false,false,true,true,true,false,false,true
+print(checks(Symbol()));
+//CHECK: false,false,false,true,true,false,true,false,true
@@ -92,3 +92,23 @@ try { print(decodeURIComponent('%c3%f0')); } catch (e) { print('caught', e) }
 // CHECK-NEXT: caught URIError: {{.*}}
 try { print(decodeURIComponent('%c3%NO')); } catch (e) { print('caught', e) }
 // CHECK-NEXT: caught URIError: {{.*}}
+
+print('long');
+// CHECK-LABEL: long
+var a = 'abcdefghijklmnopqrstuvwxyz';
+print(encodeURIComponent(a) === a, decodeURIComponent(a) === a);
+// CHECK-NEXT: true true
+print(encodeURIComponent(a + ' ' + a.toUpperCase() + '0123456789/é'));
+// CHECK-NEXT: abcdefghijklmnopqrstuvwxyz%20ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789%2F%C3%A9
+print(encodeURI('Ā' + a + '-_.!~*\'();/?:@&=+$,#[' + a));
+// CHECK-NEXT: %C4%80abcdefghijklmnopqrstuvwxyz-_.!~*'();/?:@&=+$,#%5Babcdefghijklmnopqrstuvwxyz
+print(encodeURIComponent(a + '📓' + a));
+// CHECK-NEXT: abcdefghijklmnopqrstuvwxyz%F0%9F%93%93abcdefghijklmnopqrstuvwxyz
+try { print(encodeURIComponent(a + '\ud83d')); } catch (e) { print(e.name) }
+// CHECK-NEXT: URIError
+try { print(encodeURIComponent(a + '\udcd3' + a)); } catch (e) { print(e.name) }
+// CHECK-NEXT: URIError
+print(decodeURIComponent(a + '%20' + a + '%41'));
+// CHECK-NEXT: abcdefghijklmnopqrstuvwxyz abcdefghijklmnopqrstuvwxyzA
+print(decodeURI('Ā' + a + '%23' + a + '%C3%A9'));
+// CHECK-NEXT: Āabcdefghijklmnopqrstuvwxyz%23abcdefghijklmnopqrstuvwxyzé
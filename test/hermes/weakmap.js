@@ -128,3 +128,19 @@ print(m.get(a));
 // Ensure some reuse occurred.
 print(HermesInternal.getWeakSize(m) < 10000);
 // CHECK-NEXT: true
+
+print('gc without insertions');
+// CHECK-LABEL: gc without insertions
+var m2 = new WeakMap();
+m2.set(a, 1);
+(function() {
+  for (var i = 0; i < 10000; ++i) {
+    m2.set({}, i);
+  }
+})();
+// The first collection finds the keys dead, the second removes their entries,
+// without waiting for another insertion.
+gc();
+gc();
+print(HermesInternal.getWeakSize(m2) < 100, m2.get(a));
+// CHECK-NEXT: true 1
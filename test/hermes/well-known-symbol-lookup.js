@@ -0,0 +1,74 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+
+// Lookups of well-known symbols are skipped for objects whose classes, and
+// those of their prototypes, never had them. Check that adding them at any
+// point of the chain is still seen.
+
+print('toPrimitive');
+// CHECK-LABEL: toPrimitive
+var obj = {valueOf: function() { return 1; }};
+print(obj + 1);
+// CHECK-NEXT: 2
+obj[Symbol.toPrimitive] = function(hint) { return hint; };
+print(obj + 1, `${obj}`);
+// CHECK-NEXT: default1 string
+
+var proto = {};
+var child = Object.create(proto);
+print(+child);
+// CHECK-NEXT: NaN
+proto[Symbol.toPrimitive] = function() { return 42; };
+print(+child);
+// CHECK-NEXT: 42
+
+// Many properties turn the class into a dictionary.
+var dict = {};
+for (var i = 0; i < 100; ++i) dict['p' + i] = i;
+dict[Symbol.toPrimitive] = function() { return 'dict'; };
+print(String(dict));
+// CHECK-NEXT: dict
+delete dict[Symbol.toPrimitive];
+print(String(dict));
+// CHECK-NEXT: [object Object]
+
+Object.prototype[Symbol.toPrimitive] = function() { return 'global'; };
+print(`${{}}`);
+// CHECK-NEXT: global
+delete Object.prototype[Symbol.toPrimitive];
+print(`${{}}`);
+// CHECK-NEXT: [object Object]
+
+print('toStringTag');
+// CHECK-LABEL: toStringTag
+var tagged = {};
+print(Object.prototype.toString.call(tagged));
+// CHECK-NEXT: [object Object]
+Object.defineProperty(tagged, Symbol.toStringTag, {get: () => 'Tagged'});
+print(Object.prototype.toString.call(tagged));
+// CHECK-NEXT: [object Tagged]
+print(Object.prototype.toString.call(Math));
+// CHECK-NEXT: [object Math]
+
+print('isConcatSpreadable');
+// CHECK-LABEL: isConcatSpreadable
+var arrayLike = {length: 2, 0: 'a', 1: 'b'};
+print([].concat(arrayLike).length);
+// CHECK-NEXT: 1
+arrayLike[Symbol.isConcatSpreadable] = true;
+print([].concat(arrayLike).join());
+// CHECK-NEXT: a,b
+
+print('Symbol.for');
+// CHECK-LABEL: Symbol.for
+var a = Symbol.for('key');
+print(a === Symbol.for('key'), a === Symbol.for('other'));
+// CHECK-NEXT: true false
+print(Symbol.keyFor(a), Symbol.keyFor(Symbol('key')));
+// CHECK-NEXT: key undefined
+print(Symbol.for('ke' + 'y') === a, Symbol.for(1) === Symbol.for('1'));
+// CHECK-NEXT: true true
@@ -0,0 +1,166 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+/*
+RUN: %hermes -O -jit -jit-crash-on-error -jit-threshold=0 %s \
+RUN:     | %FileCheck --match-full-lines %s
+RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+REQUIRES: jit
+*/
+
+// GetByVal and PutByVal in compiled code only handle in-bounds integer
+// indices of packed arrays inline; everything else must fall back to the
+// generic property access.
+
+function get(a, i) {
+  return a[i];
+}
+
+function put(a, i, v) {
+  "use strict";
+  a[i] = v;
+}
+
+function sloppyPut(a, i, v) {
+  a[i] = v;
+}
+
+function tryPut(a, i, v) {
+  try {
+    put(a, i, v);
+    print("stored");
+  } catch (e) {
+    print(e.name);
+  }
+}
+
+print("packed");
+// CHECK-LABEL: packed
+var a = [1, 2, 3];
+print(get(a, 0), get(a, 2));
+// CHECK-NEXT: 1 3
+put(a, 1, 20);
+print(a);
+// CHECK-NEXT: 1,20,3
+
+print("holes");
+// CHECK-LABEL: holes
+var holey = [1, , 3];
+print(get(holey, 1));
+// CHECK-NEXT: undefined
+Array.prototype[1] = "proto";
+print(get(holey, 1));
+// CHECK-NEXT: proto
+delete Array.prototype[1];
+put(holey, 1, 2);
+print(holey, holey.length);
+// CHECK-NEXT: 1,2,3 3
+
+print("out of bounds");
+// CHECK-LABEL: out of bounds
+var b = [1, 2, 3];
+print(get(b, 3), get(b, -1), get(b, 1.5), get(b, 4294967295));
+// CHECK-NEXT: undefined undefined undefined undefined
+put(b, 3, 4);
+print(b, b.length);
+// CHECK-NEXT: 1,2,3,4 4
+put(b, 6, 7);
+print(b, b.length);
+// CHECK-NEXT: 1,2,3,4,,,7 7
+put(b, -1, "neg");
+print(b.length, get(b, -1));
+// CHECK-NEXT: 7 neg
+Object.defineProperty(Array.prototype, 10, {
+  set: function(v) {
+    print("setter", v);
+  },
+  configurable: true,
+});
+put(b, 10, "x");
+// CHECK-NEXT: setter x
+print(b.length);
+// CHECK-NEXT: 7
+delete Array.prototype[10];
+
+print("frozen");
+// CHECK-LABEL: frozen
+var frozen = Object.freeze([1, 2, 3]);
+print(get(frozen, 1));
+// CHECK-NEXT: 2
+tryPut(frozen, 1, 20);
+// CHECK-NEXT: TypeError
+tryPut(frozen, 3, 4);
+// CHECK-NEXT: TypeError
+sloppyPut(frozen, 1, 20);
+print(frozen, frozen.length);
+// CHECK-NEXT: 1,2,3 3
+
+print("sealed");
+// CHECK-LABEL: sealed
+var sealed = Object.seal([1, 2, 3]);
+tryPut(sealed, 1, 20);
+// CHECK-NEXT: stored
+tryPut(sealed, 3, 4);
+// CHECK-NEXT: TypeError
+print(sealed, sealed.length);
+// CHECK-NEXT: 1,20,3 3
+
+print("non-writable");
+// CHECK-LABEL: non-writable
+var readOnly = [1, 2, 3];
+Object.defineProperty(readOnly, 1, {writable: false});
+tryPut(readOnly, 1, 20);
+// CHECK-NEXT: TypeError
+tryPut(readOnly, 2, 30);
+// CHECK-NEXT: stored
+print(readOnly);
+// CHECK-NEXT: 1,2,30
+var withGetter = [1, 2, 3];
+Object.defineProperty(withGetter, 0, {
+  get: function() {
+    return "getter";
+  },
+});
+print(get(withGetter, 0), get(withGetter, 1));
+// CHECK-NEXT: getter 2
+tryPut(withGetter, 0, 10);
+// CHECK-NEXT: TypeError
+
+print("non-index keys");
+// CHECK-LABEL: non-index keys
+var c = [1, 2, 3];
+print(get(c, "1"), get(c, "length"), get(c, "foo"));
+// CHECK-NEXT: 2 3 undefined
+var key = {
+  toString: function() {
+    return "2";
+  },
+};
+print(get(c, key));
+// CHECK-NEXT: 3
+put(c, "foo", "bar");
+print(get(c, "foo"), c.length);
+// CHECK-NEXT: bar 3
+put(c, "1", 20);
+print(c);
+// CHECK-NEXT: 1,20,3
+put(c, "length", 1);
+print(c, c.length);
+// CHECK-NEXT: 1 1
+var sym = Symbol("s");
+put(c, sym, "symbol");
+print(get(c, sym));
+// CHECK-NEXT: symbol
+
+print("non-arrays");
+// CHECK-LABEL: non-arrays
+print(get("abc", 1), get({0: "zero"}, 0), get(new Int8Array([5, 6]), 1));
+// CHECK-NEXT: b zero 6
+var obj = {};
+put(obj, 0, "x");
+print(get(obj, 0));
+// CHECK-NEXT: x
+tryPut("abc", 1, "x");
+// CHECK-NEXT: TypeError
@@ -0,0 +1,33 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+/*
+RUN: %hermes -O -jit-background -jit-threshold=2 -jit-loop-threshold=5 %s \
+RUN:     | %FileCheck --match-full-lines %s
+REQUIRES: jit
+*/
+
+var logger = typeof print === "undefined"
+    ? console.log
+    : print;
+
+// The interpreter keeps running these while they are being compiled, so the
+// results must be the same whichever of them ends up running native code.
+function add(a, b) {
+    return a + b;
+}
+
+function sumTo(n) {
+    var sum = 0;
+    for (var i = 0; i < n; ++i)
+        sum = add(sum, i);
+    return sum;
+}
+
+var total = 0;
+for (var i = 0; i < 100; ++i)
+    total += sumTo(1000);
+logger(total);
+//CHECK:49950000
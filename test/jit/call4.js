@@ -4,7 +4,7 @@
 // file in the root directory of this source tree.
 //
 /*
-RUN: %hermes -O -jit %s
+RUN: %hermes -O -jit -jit-threshold=0 %s
 REQUIRES: jit
 */
 
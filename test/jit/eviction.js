@@ -0,0 +1,42 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+/*
+RUN: %hermes -O -jit -jit-threshold=0 -jit-memory-limit=65536 %s \
+RUN:     | %FileCheck --match-full-lines %s
+RUN: %hermes -O -jit -jit-threshold=0 -jit-memory-limit=65536 -gc-print-stats \
+RUN:     %s 2>&1 >/dev/null | %FileCheck --match-full-lines -check-prefix STATS %s
+REQUIRES: jit
+*/
+
+var logger = typeof print === "undefined"
+    ? console.log
+    : print;
+
+// Create many distinct functions whose code cannot all fit in the executable
+// memory at once.
+var body = "var r = 0;";
+for (var i = 0; i < 40; ++i)
+    body += "r = r * b + a - " + i + ";";
+body += "return r;";
+
+var fns = [];
+for (var i = 0; i < 32; ++i)
+    fns.push(new Function("a", "b", body));
+
+// Every round evicts older functions, which are then compiled again on the
+// next one.
+var total = 0;
+for (var round = 0; round < 3; ++round)
+    for (var i = 0; i < fns.length; ++i)
+        total += fns[i](i, 1);
+logger(total);
+//CHECK:-15360
+
+//STATS:JIT code cache stats:
+//STATS-NEXT:  Bytes used: {{[0-9]+}}
+//STATS-NEXT:  Functions compiled: {{[0-9]+}}
+//STATS-NEXT:  Evictions: {{[1-9][0-9]*}}
+//STATS-NEXT:  Recompilations: {{[1-9][0-9]*}}
@@ -6,7 +6,7 @@
 /*
 RUN: %hermes -O -dump-bytecode %s \
 RUN:     | %FileCheck --match-full-lines -check-prefix HBC %s
-RUN: %hermes -O -dump-jitcode %s \
+RUN: %hermes -O -dump-jitcode -jit-threshold=0 %s \
 RUN:     | %FileCheck --match-full-lines -check-prefix JIT %s
 REQUIRES: jit, jit_dis
 */
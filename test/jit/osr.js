@@ -0,0 +1,38 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+/*
+RUN: %hermes -O -jit-threshold=100 -jit-loop-threshold=5 %s \
+RUN:     | %FileCheck --match-full-lines %s
+REQUIRES: jit
+*/
+
+var logger = typeof print === "undefined"
+    ? console.log
+    : print;
+
+// Called only once, so the loop must switch from the interpreter to the
+// compiled code while it is running, keeping the values of its locals.
+function sumTo(n) {
+    var sum = 0;
+    for (var i = 0; i < n; ++i)
+        sum += i;
+    return sum;
+}
+
+logger(sumTo(1000));
+//CHECK:499500
+
+// A nested loop enters the compiled code at the header of the inner loop.
+function nested(n) {
+    var count = 0;
+    for (var i = 0; i < n; ++i)
+        for (var j = 0; j < i; ++j)
+            count += 2;
+    return count;
+}
+
+logger(nested(50));
+//CHECK-NEXT:2450
@@ -0,0 +1,33 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+/*
+RUN: %hermes -O -emit-binary -out %t.hbc %s
+RUN: rm -f %t.profile
+RUN: %hermes -jit -jit-threshold=2 -jit-profile=%t.profile %t.hbc
+RUN: %hermes -dump-jitcode -jit-threshold=1000 -jit-profile=%t.profile %t.hbc \
+RUN:     | %FileCheck --match-full-lines %s
+REQUIRES: jit, jit_dis
+*/
+
+// Hot in the first run, so it is compiled on its first call in the second
+// run despite the higher threshold.
+function calledOften(x) {
+  return x + 1;
+}
+
+// Never hot enough to be compiled.
+function cold(x) {
+  return x - 1;
+}
+
+calledOften(1);
+calledOften(2);
+calledOften(3);
+cold(1);
+
+//CHECK-NOT:Compiled Code of FunctionID: 0
+//CHECK:Compiled Code of FunctionID: 1
+//CHECK-NOT:Compiled Code of FunctionID: {{[02]}}
@@ -0,0 +1,103 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+/*
+RUN: %hermes -O -jit -jit-crash-on-error -jit-threshold=0 %s \
+RUN:     | %FileCheck --match-full-lines %s
+RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+RUN: %hermes -O -dump-jitcode -jit-threshold=0 %s \
+RUN:     | %FileCheck -check-prefix JIT %s
+REQUIRES: jit, jit_dis
+*/
+
+// Compiled GetById and PutById compare the hidden class of the object with the
+// first way of their property cache inline, including when objects store
+// their class as a compressed pointer.
+
+function getX(o) {
+  return o.x;
+}
+
+function setX(o, v) {
+  o.x = v;
+}
+
+function point(x, y) {
+  return {x: x, y: y};
+}
+
+print("hits");
+// CHECK-LABEL: hits
+var p = point(1, 2);
+var q = point(3, 4);
+print(getX(p), getX(q), getX(p));
+// CHECK-NEXT: 1 3 1
+setX(p, 10);
+setX(q, 30);
+print(getX(p), getX(q));
+// CHECK-NEXT: 10 30
+
+print("misses");
+// CHECK-LABEL: misses
+var swapped = {y: 2, x: 5};
+print(getX(swapped), getX(p));
+// CHECK-NEXT: 5 10
+print(getX(Object.create({x: "proto"})), getX({}));
+// CHECK-NEXT: proto undefined
+print(getX("abc"), getX(7));
+// CHECK-NEXT: undefined undefined
+setX(swapped, 50);
+print(swapped.x, p.x);
+// CHECK-NEXT: 50 10
+
+print("pointer values");
+// CHECK-LABEL: pointer values
+setX(p, "str");
+setX(q, {v: 1});
+print(getX(p), getX(q).v);
+// CHECK-NEXT: str 1
+
+print("indirect slots");
+// CHECK-LABEL: indirect slots
+var wide = {a: 1, b: 2, c: 3, d: 4, e: 5, f: 6, g: 7, x: 8};
+print(getX(wide), getX(wide));
+// CHECK-NEXT: 8 8
+setX(wide, 80);
+print(getX(wide));
+// CHECK-NEXT: 80
+
+print("class changes");
+// CHECK-LABEL: class changes
+var r = point(1, 2);
+print(getX(r));
+// CHECK-NEXT: 1
+r.z = 3;
+print(getX(r));
+// CHECK-NEXT: 1
+delete r.x;
+print(getX(r));
+// CHECK-NEXT: undefined
+setX(r, 4);
+print(getX(r), Object.keys(r).join());
+// CHECK-NEXT: 4 y,z,x
+Object.defineProperty(r, "x", {
+  get: function() {
+    return "getter";
+  },
+});
+print(getX(r));
+// CHECK-NEXT: getter
+var frozen = Object.freeze(point(1, 2));
+setX(frozen, 9);
+print(getX(frozen));
+// CHECK-NEXT: 1
+
+// The class of the object is compared with the cached class.
+// JIT-LABEL: Compiled Code of FunctionID: 1
+// JIT: cmpq (%r8), %rax
+// JIT-NEXT: jne
+// JIT-LABEL: Compiled Code of FunctionID: 2
+// JIT: cmpq (%r8), %rax
+// JIT-NEXT: jne
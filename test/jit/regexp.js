@@ -0,0 +1,51 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+/*
+RUN: %hermes -jit -jit-regexp-threshold=0 %s \
+RUN:     | %FileCheck --match-full-lines %s
+REQUIRES: jit
+*/
+
+print('regexp');
+// CHECK-LABEL: regexp
+
+// Search each string with the same regex.
+function execAll(re, inputs) {
+  var results = [];
+  for (var i = 0; i < inputs.length; ++i)
+    results.push(JSON.stringify(re.exec(inputs[i])));
+  return results.join(' ');
+}
+
+print(execAll(/a(b|c)d/, ['xabd', 'acd', 'ad', 'abéd']));
+// CHECK-NEXT: ["abd","b"] ["acd","c"] null null
+print(execAll(/^(\w+)\s*=\s*(\d*)$/m, ['x = 1', 'y=\nfoo=42', '=3']));
+// CHECK-NEXT: ["x = 1","x","1"] ["y=","y",""] null
+print(execAll(/\b([a-z]{2,3}?)(x*)\b/i, ['abXX', ' ABCD xy', 'a-b']));
+// CHECK-NEXT: ["abXX","ab","XX"] ["xy","xy",""] null
+print(execAll(/(a|ab)(c|bcd)(d?)/, ['abcd', 'abcdd', 'abc']));
+// CHECK-NEXT: ["abcd","a","bcd",""] ["abcdd","a","bcd","d"] ["abc","ab","c",""]
+print(execAll(/[^ab]+?c|(x)/, ['abddc', 'xc', 'ab']));
+// CHECK-NEXT: ["ddc",null] ["xc",null] null
+
+// Searching from lastIndex.
+var re = /a+/g;
+var s = 'aa-a-aaa';
+var found = [];
+for (var m; (m = re.exec(s)); )
+  found.push(m.index + ':' + m[0]);
+print(found.join(' '));
+// CHECK-NEXT: 0:aa 3:a 5:aaa
+
+re = /^a|b$/g;
+print('aab\nab'.replace(re, '_'));
+// CHECK-NEXT: _ab
+// CHECK-NEXT: a_
+
+// The native code gives up and the interpreter takes over.
+var as = 'a'.repeat(60);
+print(/a*a*a*a*b/.test(as), /a*a*a*a*b/.test(as + 'b'));
+// CHECK-NEXT: false true
@@ -0,0 +1,42 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+/*
+RUN: %hermes -dump-jitcode -jit-threshold=2 -jit-loop-threshold=5 %s \
+RUN:     | %FileCheck --match-full-lines %s
+REQUIRES: jit, jit_dis
+*/
+
+// Only called often enough to be compiled on the third call.
+function calledOften(x) {
+  return x + 1;
+}
+
+// Called once, but its loop makes it hot enough to be compiled on the next
+// call.
+function hotLoop(n) {
+  var sum = 0;
+  for (var i = 0; i < n; i = i + 1)
+    sum = sum + i;
+  return sum;
+}
+
+// Called once without a loop, so it is never compiled.
+function cold(x) {
+  return x - 1;
+}
+
+calledOften(1);
+calledOften(2);
+calledOften(3);
+hotLoop(10);
+hotLoop(10);
+cold(1);
+
+//CHECK-NOT:Compiled Code of FunctionID: 0
+//CHECK:Compiled Code of FunctionID: 1
+//CHECK-NOT:Compiled Code of FunctionID: 0
+//CHECK:Compiled Code of FunctionID: 2
+//CHECK-NOT:Compiled Code of FunctionID: {{[03]}}
@@ -0,0 +1,142 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+/*
+RUN: %hermes -O -jit -jit-crash-on-error -jit-threshold=0 %s \
+RUN:     | %FileCheck --match-full-lines %s
+RUN: %hermes -O %s | %FileCheck --match-full-lines %s
+RUN: %hermes -O -dump-jitcode -jit-threshold=0 %s \
+RUN:     | %FileCheck -check-prefix JIT %s
+REQUIRES: jit, jit_dis
+*/
+
+// Within a basic block, the x86-64 JIT keeps the result of AddN, SubN, MulN
+// and DivN in XMM0 for the next numeric instruction. These functions give it
+// chances to use a stale or misplaced XMM0.
+
+// The product is used from XMM0 without reloading it.
+function chain(a, b) {
+  var x = +a;
+  var y = +b;
+  return x * y + x;
+}
+
+// XMM0 holds the second operand of the subtraction, so the first one must be
+// loaded over it.
+function subCachedSecond(a, b) {
+  var x = +a;
+  var y = +b;
+  var t = x * y;
+  return x - t;
+}
+
+function divCachedSecond(a, b) {
+  var x = +a;
+  var y = +b;
+  var t = x * y;
+  return x / t;
+}
+
+function subCachedFirst(a, b) {
+  var x = +a;
+  var y = +b;
+  var t = x * y;
+  return t - x;
+}
+
+function subSelf(a) {
+  var x = +a;
+  var t = x * x;
+  return t - t;
+}
+
+// The register holding the product is overwritten by instructions that are
+// not arithmetic, while XMM0 still holds the product.
+function overwriteByLoad(a, b, o) {
+  var x = +a;
+  var y = +b;
+  var t = x * y;
+  o.w = t;
+  t = o.v;
+  return t - x;
+}
+
+function overwriteByConst(a, b, o) {
+  var x = +a;
+  var y = +b;
+  var t = x * y;
+  o.w = t;
+  t = 0.5;
+  return t * x;
+}
+
+// The generic arithmetic leave their result only in the frame when they take
+// the slow path.
+function afterSlowPath(a, b, c) {
+  var x = +c;
+  var t = a * b;
+  return t * x - x;
+}
+
+function slowPathBetween(a, b) {
+  var x = +a;
+  var s = x * x;
+  var t = s + b;
+  return s * x + t;
+}
+
+// Blocks may be entered from several predecessors, with different values in
+// XMM0.
+function branch(a, b, c) {
+  var x = +a;
+  var y = +b;
+  var t = x * y;
+  if (c)
+    t = x + y;
+  return t - x;
+}
+
+function loop(a, n) {
+  var x = +a;
+  var s = 0;
+  for (var i = 0; i < n; i++)
+    s = s * x + i;
+  return s;
+}
+
+print(chain(3, 4));
+// CHECK: 15
+print(subCachedSecond(5, 2));
+// CHECK-NEXT: -5
+print(divCachedSecond(5, 2));
+// CHECK-NEXT: 0.5
+print(subCachedFirst(5, 2));
+// CHECK-NEXT: 5
+print(subSelf(3));
+// CHECK-NEXT: 0
+var o = {v: 100};
+print(overwriteByLoad(3, 4, o), o.w);
+// CHECK-NEXT: 97 12
+print(overwriteByConst(3, 4, o), o.w);
+// CHECK-NEXT: 1.5 12
+print(afterSlowPath(3, 4, 2), afterSlowPath("3", 4, 2));
+// CHECK-NEXT: 22 22
+print(slowPathBetween(3, 1), slowPathBetween(3, "1"));
+// CHECK-NEXT: 37 2791
+print(branch(3, 4, true), branch(3, 4, false));
+// CHECK-NEXT: 4 9
+print(loop(2, 5));
+// CHECK-NEXT: 26
+
+// JIT-LABEL: Compiled Code of FunctionID: 1
+// JIT: mulsd
+// JIT-NEXT: movsd
+// JIT-NEXT: addsd
+
+// JIT-LABEL: Compiled Code of FunctionID: 2
+// JIT: mulsd
+// JIT-NEXT: movsd
+// JIT-NEXT: movsd
+// JIT-NEXT: subsd
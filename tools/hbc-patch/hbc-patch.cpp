@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/PrettyStackTrace.h"
+#include "llvm/Support/Signals.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "hermes/BCGen/HBC/BytecodePatch.h"
+
+using namespace hermes::hbc;
+
+static llvm::cl::opt<std::string> BaseFilename(
+    "base",
+    llvm::cl::Required,
+    llvm::cl::desc("Bytecode file the patch applies to"));
+
+static llvm::cl::opt<bool> Apply(
+    "apply",
+    llvm::cl::desc(
+        "Apply the input patch to the base file, instead of creating a patch "
+        "from the base file to the input bytecode file"));
+
+static llvm::cl::opt<std::string> InputFilename(
+    llvm::cl::desc("input file"),
+    llvm::cl::Required,
+    llvm::cl::Positional);
+
+static llvm::cl::opt<std::string> OutputFilename(
+    "out",
+    llvm::cl::Required,
+    llvm::cl::desc("Output file name"));
+
+/// Read the file \p filename into \p buffer.
+/// \return false on error, which has been reported.
+static bool readFile(
+    const std::string &filename,
+    std::unique_ptr<llvm::MemoryBuffer> &buffer) {
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> fileBufOrErr =
+      llvm::MemoryBuffer::getFile(
+          filename, -1, false /* RequiresNullTerminator */);
+  if (!fileBufOrErr) {
+    llvm::errs() << "Error: fail to open file: " << filename << ": "
+                 << fileBufOrErr.getError().message() << "\n";
+    return false;
+  }
+  buffer = std::move(*fileBufOrErr);
+  return true;
+}
+
+static llvm::ArrayRef<uint8_t> bytesOf(const llvm::MemoryBuffer &buffer) {
+  return {reinterpret_cast<const uint8_t *>(buffer.getBufferStart()),
+          buffer.getBufferSize()};
+}
+
+int main(int argc, char **argv) {
+  // Normalize the arg vector.
+  llvm::InitLLVM initLLVM(argc, argv);
+  llvm::sys::PrintStackTraceOnErrorSignal("hbc-patch");
+  llvm::PrettyStackTraceProgram X(argc, argv);
+  llvm::llvm_shutdown_obj Y;
+  llvm::cl::ParseCommandLineOptions(argc, argv, "Hermes bytecode patch tool\n");
+
+  std::unique_ptr<llvm::MemoryBuffer> baseBuf;
+  std::unique_ptr<llvm::MemoryBuffer> inputBuf;
+  if (!readFile(BaseFilename, baseBuf) || !readFile(InputFilename, inputBuf)) {
+    return -1;
+  }
+
+  std::error_code EC;
+  llvm::raw_fd_ostream fileOS(OutputFilename.data(), EC, llvm::sys::fs::F_None);
+  if (EC) {
+    llvm::errs() << "Error: fail to open file " << OutputFilename << ": "
+                 << EC.message() << '\n';
+    return -1;
+  }
+
+  std::string error;
+  if (Apply) {
+    // The new file is written as it is reconstructed.
+    if (!applyBytecodePatch(
+            bytesOf(*baseBuf), bytesOf(*inputBuf), fileOS, &error)) {
+      llvm::errs() << "Error: failed to apply patch " << InputFilename << ": "
+                   << error << '\n';
+      return -1;
+    }
+    return 0;
+  }
+
+  std::vector<uint8_t> patch;
+  if (!createBytecodePatch(
+          bytesOf(*baseBuf), bytesOf(*inputBuf), patch, &error)) {
+    llvm::errs() << "Error: failed to create patch to " << InputFilename
+                 << ": " << error << '\n';
+    return -1;
+  }
+  fileOS.write(reinterpret_cast<const char *>(patch.data()), patch.size());
+  return 0;
+}
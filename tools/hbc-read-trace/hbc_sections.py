@@ -5,6 +5,7 @@
 
 from __future__ import absolute_import, division, print_function, unicode_literals
 
+import json
 import re
 import subprocess
 from bisect import bisect_right
@@ -14,6 +15,7 @@ from operator import attrgetter
 
 _RE_SECT = re.compile(r"(?P<title>.+): \[(?P<start>\d+), (?P<end>\d+)\)")
 Section = namedtuple("Section", "start end label")
+FunctionBody = namedtuple("FunctionBody", "start end id")
 
 
 class HBCSections:
@@ -94,6 +96,27 @@ def raw_sections(hbcdump, bytecode):
             yield sect
 
 
+def function_bodies(hbcdump, bytecode):
+    """The byte ranges of the function bodies in bytecode.
+
+    hbcdump  -- Path to the hbcdump binary to use to read the bytecode file.
+    bytecode -- Path to the bytecode file to extract function bodies from.
+
+    Returns a list of function bodies sorted by starting address.  Functions
+    whose bytecode was deduplicated share the same range.
+    """
+    offsets = subprocess.check_output(
+        [hbcdump, "-c", "offsets -json;quit", bytecode]
+    )
+
+    bodies = [
+        FunctionBody(f["Offset"], f["Offset"] + f["Size"], f["FunctionID"])
+        for f in json.loads(offsets.decode())
+    ]
+    bodies.sort(key=attrgetter("start", "id"))
+    return bodies
+
+
 _RE_WS = re.compile(r"\s+")
 
 
@@ -7,11 +7,12 @@
 from __future__ import absolute_import, division, print_function, unicode_literals
 
 import argparse
+from bisect import bisect_left
 from collections import namedtuple
 from itertools import groupby
 from sys import stdin
 
-from hbc_sections import HBCSections
+from hbc_sections import HBCSections, function_bodies
 
 
 Access = namedtuple("Access", "page time")
@@ -44,6 +45,31 @@ def grouped_section_access_info(sections):
     return groups
 
 
+def function_order(bodies, pagesz=4096):
+    """The IDs of the functions whose bodies were read, in the order they were
+    first read.  Suitable for hermesc's -function-order option.
+
+    bodies -- The function bodies of the bytecode, sorted by starting address.
+    pagesz -- The size of an individual page in bytes.  Defaults to 4096.
+    """
+    starts = [b.start for b in bodies]
+    seen = set()
+    for access in page_accesses():
+        page_start = access.page * pagesz
+        page_end = page_start + pagesz
+
+        # Bodies starting before the page may extend into it.
+        i = bisect_left(starts, page_start)
+        while i > 0 and bodies[i - 1].end > page_start:
+            i -= 1
+        while i < len(bodies) and bodies[i].start < page_end:
+            body = bodies[i]
+            if body.end > page_start and body.id not in seen:
+                seen.add(body.id)
+                yield body.id
+            i += 1
+
+
 MAX_LABEL_WIDTH = 25
 
 
@@ -151,9 +177,27 @@ if __name__ == "__main__":
         help="Verbose output.  Each access is emitted on its own line.",
     )
 
-    args = parser.parse_args()
-    sections = HBCSections.from_bytecode(args.hbcdump, args.bytecode)
-    accesses = grouped_section_access_info(sections)
-    display = display_all if args.verbose else display_brief
+    parser.add_argument(
+        "-F",
+        "--function-order",
+        action="store_true",
+        help=(
+            "Instead of annotating the trace, output the IDs of the functions "
+            "whose bodies were read, one per line, in the order they were "
+            "first read.  Passing this file to hermesc's -function-order "
+            "option when recompiling the same source lays those functions "
+            "out first."
+        ),
+    )
 
-    display(accesses, args.display_offsets, args.display_time)
+    args = parser.parse_args()
+    if args.function_order:
+        bodies = function_bodies(args.hbcdump, args.bytecode)
+        for function_id in function_order(bodies):
+            print(function_id)
+    else:
+        sections = HBCSections.from_bytecode(args.hbcdump, args.bytecode)
+        accesses = grouped_section_access_info(sections)
+        display = display_all if args.verbose else display_brief
+
+        display(accesses, args.display_offsets, args.display_time)
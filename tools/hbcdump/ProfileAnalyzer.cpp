@@ -852,6 +852,279 @@ void ProfileAnalyzer::dumpFunctionOffsets(
   printer.closeDict();
 }
 
+/// Visitor to count the opcodes of a function and find whether it loops.
+class OpcodeMixVisitor : public hermes::hbc::BytecodeVisitor {
+ private:
+  // Maps <opcode => static_instruction_count>.
+  std::unordered_map<OpCode, uint32_t> &opcodeCounts_;
+  // Set when a branch jumps backwards.
+  bool &hasLoop_;
+
+ protected:
+  void preVisitInstruction(inst::OpCode opcode, const uint8_t *ip, int length) {
+    ++opcodeCounts_[opcode];
+  }
+
+  void visitOperand(
+      const uint8_t *ip,
+      OperandType operandType,
+      const uint8_t *operandBuf,
+      int operandIndex) {
+    int32_t offset = 0;
+    if (operandType == OperandType::Addr8) {
+      int8_t shortOffset;
+      decodeOperand(operandBuf, &shortOffset);
+      offset = shortOffset;
+    } else if (operandType == OperandType::Addr32) {
+      decodeOperand(operandBuf, &offset);
+    }
+    if (offset < 0) {
+      hasLoop_ = true;
+    }
+  }
+
+ public:
+  OpcodeMixVisitor(
+      std::shared_ptr<hbc::BCProvider> bcProvider,
+      std::unordered_map<OpCode, uint32_t> &opcodeCounts,
+      bool &hasLoop)
+      : BytecodeVisitor(bcProvider),
+        opcodeCounts_(opcodeCounts),
+        hasLoop_(hasLoop) {}
+};
+
+void ProfileAnalyzer::loadSamplingProfile(
+    std::unique_ptr<llvm::MemoryBuffer> profileBuffer) {
+  JSLexer::Allocator alloc;
+  JSONFactory factory(alloc);
+  SourceErrorManager sm;
+  JSONParser jsonParser(factory, profileBuffer->getBuffer(), sm);
+
+  auto checkInvalidProfileObjectAndExit = [](const void *json,
+                                             const char *details) {
+    if (json == nullptr) {
+      llvm::errs() << "Invalid sampling profile format: " << details << "\n";
+      exit(-3);
+    }
+  };
+  // The profiler writes the numbers of the stack frames as strings.
+  auto getInteger = [](const JSONValue *value) -> llvm::Optional<uint64_t> {
+    if (const auto *number = llvm::dyn_cast_or_null<JSONNumber>(value)) {
+      return (uint64_t)number->getValue();
+    }
+    uint64_t result;
+    if (const auto *str = llvm::dyn_cast_or_null<JSONString>(value)) {
+      if (!str->str().getAsInteger(10, result)) {
+        return result;
+      }
+    }
+    return llvm::None;
+  };
+
+  auto *json = llvm::dyn_cast_or_null<JSONObject>(
+      jsonParser.parse().getValueOr(nullptr));
+  checkInvalidProfileObjectAndExit(json, "root is not JSONObject");
+  auto *stackFrames =
+      llvm::dyn_cast_or_null<JSONObject>(json->get("stackFrames"));
+  checkInvalidProfileObjectAndExit(
+      stackFrames, "fail to fetch 'stackFrames' entry from root object");
+  auto *samples = llvm::dyn_cast_or_null<JSONArray>(json->get("samples"));
+  checkInvalidProfileObjectAndExit(
+      samples, "fail to fetch 'samples' entry from root object");
+
+  // Functions are identified by their virtual offset when the bytecode has no
+  // debug info, and by the source location of their start otherwise.
+  std::shared_ptr<hbc::BCProvider> bcProvider = hbcParser_.getBCProvider();
+  std::unordered_map<uint64_t, uint32_t> funcIdByStartLocation;
+  for (uint32_t funcId = 0, e = bcProvider->getFunctionCount(); funcId < e;
+       ++funcId) {
+    if (auto loc = hbcParser_.getSourceLocation(funcId, 0)) {
+      funcIdByStartLocation.emplace(
+          ((uint64_t)loc->line << 32) | loc->column, funcId);
+    }
+  }
+
+  /// A stack frame of the profile.
+  struct Frame {
+    llvm::Optional<uint32_t> funcId;
+    llvm::Optional<uint64_t> parent;
+  };
+  std::unordered_map<uint64_t, Frame> frames;
+  for (auto entry : *stackFrames) {
+    auto frameId = getInteger(entry.first);
+    auto *frameObj = llvm::dyn_cast<JSONObject>(entry.second);
+    checkInvalidProfileObjectAndExit(frameObj, "fail to fetch stack frame");
+    Frame frame;
+    frame.parent = getInteger(frameObj->get("parent"));
+    if (auto funcVirtAddr = getInteger(frameObj->get("funcVirtAddr"))) {
+      frame.funcId = getFunctionFromVirtualOffset(*funcVirtAddr);
+    } else {
+      auto funcLine = getInteger(frameObj->get("funcLine"));
+      auto funcColumn = getInteger(frameObj->get("funcColumn"));
+      if (funcLine && funcColumn) {
+        auto it = funcIdByStartLocation.find((*funcLine << 32) | *funcColumn);
+        if (it != funcIdByStartLocation.end()) {
+          frame.funcId = it->second;
+        }
+      }
+    }
+    if (frameId) {
+      frames[*frameId] = frame;
+    }
+  }
+
+  funcSamplesOpt_.emplace();
+  auto &funcSamples = funcSamplesOpt_.getValue();
+  totalSampleCount_ = 0;
+  std::unordered_set<uint32_t> funcsInStack;
+  for (size_t i = 0; i < samples->size(); ++i) {
+    auto *sample = llvm::dyn_cast<JSONObject>(samples->at(i));
+    checkInvalidProfileObjectAndExit(sample, "fail to fetch sample entry");
+    auto leafId = getInteger(sample->get("sf"));
+    checkInvalidProfileObjectAndExit(
+        leafId.hasValue() ? sample : nullptr, "fail to fetch 'sf' field");
+    uint64_t weight = getInteger(sample->get("weight")).getValueOr(1);
+    totalSampleCount_ += weight;
+
+    // Charge the leaf function, then every function in the stack once, so
+    // that recursion is not counted several times.
+    funcsInStack.clear();
+    bool isLeaf = true;
+    for (llvm::Optional<uint64_t> frameId = leafId; frameId;) {
+      auto it = frames.find(*frameId);
+      if (it == frames.end()) {
+        break;
+      }
+      if (auto funcId = it->second.funcId) {
+        if (isLeaf) {
+          funcSamples[*funcId].self += weight;
+        }
+        if (funcsInStack.insert(*funcId).second) {
+          funcSamples[*funcId].total += weight;
+        }
+      }
+      isLeaf = false;
+      frameId = it->second.parent;
+    }
+  }
+}
+
+void ProfileAnalyzer::dumpHotFunctions() {
+  if (!funcSamplesOpt_.hasValue()) {
+    os_ << "This command requires a sampling profile to run.\n";
+    return;
+  }
+  if (totalSampleCount_ == 0) {
+    os_ << "The sampling profile has no samples.\n";
+    return;
+  }
+  std::shared_ptr<hbc::BCProvider> bcProvider = hbcParser_.getBCProvider();
+  auto getSize = [&bcProvider](uint32_t funcId) {
+    // Count empty functions as one byte to rank them.
+    return std::max(
+        bcProvider->getFunctionHeader(funcId).bytecodeSizeInBytes(), 1u);
+  };
+
+  // Rank the functions which were sampled themselves by samples per byte, so
+  // the functions with the most time to save per byte come first.
+  std::vector<std::pair<uint32_t, FunctionSamples>> sortedElements;
+  for (const auto &entry : funcSamplesOpt_.getValue()) {
+    if (entry.second.self > 0) {
+      sortedElements.push_back(entry);
+    }
+  }
+  std::sort(
+      sortedElements.begin(),
+      sortedElements.end(),
+      [&getSize](
+          const std::pair<uint32_t, FunctionSamples> &x,
+          const std::pair<uint32_t, FunctionSamples> &y) {
+        return x.second.self * getSize(y.first) >
+            y.second.self * getSize(x.first);
+      });
+
+  // A function is hot when it takes at least this share of the samples.
+  const double hotPercentage = 1.0;
+  // Hot functions up to this size are worth inlining into their callers.
+  const uint32_t inlineMaxSize = 32;
+
+  int maxOutputCount = 100;
+  // Put function name as the last column because its length varies a lot.
+  os_ << llvm::left_justify("Self(%)", 10) << llvm::left_justify("Total(%)", 10)
+      << llvm::left_justify("Samples(#)", 12) << llvm::left_justify("Size", 8)
+      << llvm::left_justify("Samples/KB", 12)
+      << llvm::left_justify("Opcodes", 48) << llvm::left_justify("Flags", 12)
+      << llvm::left_justify("Function", 24) << "Source\n";
+  for (const auto &entry : sortedElements) {
+    if (maxOutputCount-- == 0) {
+      break;
+    }
+    const uint32_t funcId = entry.first;
+    const FunctionSamples &samples = entry.second;
+    uint32_t funcSize = getSize(funcId);
+    double selfPercentage = 100.0 * samples.self / totalSampleCount_;
+    os_ << llvm::left_justify(formatString("%.2f%%", selfPercentage), 10)
+        << llvm::left_justify(
+               formatString(
+                   "%.2f%%", 100.0 * samples.total / totalSampleCount_),
+               10)
+        << llvm::left_justify(std::to_string(samples.self), 12)
+        << llvm::left_justify(std::to_string(funcSize), 8)
+        << llvm::left_justify(
+               formatString("%.1f", 1024.0 * samples.self / funcSize), 12);
+
+    // Print the three most frequent opcodes of the function.
+    std::unordered_map<OpCode, uint32_t> opcodeCounts;
+    bool hasLoop = false;
+    OpcodeMixVisitor opcodeMixVisitor(bcProvider, opcodeCounts, hasLoop);
+    opcodeMixVisitor.visitInstructionsInFunction(funcId);
+    std::vector<std::pair<OpCode, uint32_t>> opcodes(
+        opcodeCounts.begin(), opcodeCounts.end());
+    std::sort(
+        opcodes.begin(),
+        opcodes.end(),
+        [](const std::pair<OpCode, uint32_t> &x,
+           const std::pair<OpCode, uint32_t> &y) {
+          return x.second > y.second ||
+              (x.second == y.second && x.first < y.first);
+        });
+    uint32_t instCount = 0;
+    for (const auto &opcode : opcodes) {
+      instCount += opcode.second;
+    }
+    std::string opcodeMix;
+    for (size_t i = 0; i < opcodes.size() && i < 3; ++i) {
+      if (i > 0) {
+        opcodeMix += ' ';
+      }
+      opcodeMix += getOpCodeString(opcodes[i].first).str() + ":" +
+          std::to_string(100 * opcodes[i].second / instCount) + "%";
+    }
+    os_ << llvm::left_justify(opcodeMix, 48);
+
+    // Hot loops gain the most from compilation, and small hot functions from
+    // saving the cost of the calls.
+    std::string flags;
+    if (selfPercentage >= hotPercentage) {
+      if (hasLoop) {
+        flags += "jit ";
+      }
+      if (funcSize <= inlineMaxSize) {
+        flags += "inline";
+      }
+    }
+    os_ << llvm::left_justify(flags, 12);
+
+    os_ << llvm::left_justify(getFunctionName(bcProvider, funcId), 24);
+    if (auto funcStartSourceLocOpt = hbcParser_.getSourceLocation(funcId, 0)) {
+      os_ << funcStartSourceLocOpt->fileName << ":"
+          << funcStartSourceLocOpt->line << ":"
+          << funcStartSourceLocOpt->column;
+    }
+    os_ << "\n";
+  }
+}
+
 llvm::Optional<uint32_t> ProfileAnalyzer::getFunctionFromVirtualOffset(
     uint32_t virtualOffset) {
   auto bcProvider = hbcParser_.getBCProvider();
@@ -42,6 +42,14 @@ struct FunctionRuntimeStatistics {
   std::unordered_map<uint16_t, uint64_t> basicBlockStats;
 };
 
+/// Samples of a function in a sampling profile.
+struct FunctionSamples {
+  // Samples taken in the function itself.
+  uint64_t self{0};
+  // Samples taken in the function or in the functions it called.
+  uint64_t total{0};
+};
+
 /// Analyzer for basic block profile trace.
 class ProfileAnalyzer {
  private:
@@ -54,6 +62,12 @@ class ProfileAnalyzer {
   std::unordered_map<unsigned, FunctionRuntimeStatistics> funcRuntimeStats_;
   // Caches any unused function checksums in profile trace.
   std::unordered_set<std::string> unusedChecksumsInTrace_;
+  // Maps from function_id to its samples in the sampling profile, if loaded.
+  llvm::Optional<std::unordered_map<uint32_t, FunctionSamples>>
+      funcSamplesOpt_;
+  // Total number of samples in the sampling profile, including the samples
+  // of native code.
+  uint64_t totalSampleCount_{0};
 
   ProfileData deserializeTrace(
       std::unique_ptr<llvm::MemoryBuffer> profileBuffer);
@@ -147,6 +161,13 @@ class ProfileAnalyzer {
   void dumpEpilogue();
   // Print a high-level summary for the profile trace.
   void dumpSummary();
+  // Read the sampling profile in \p profileBuffer, in the Chrome trace format
+  // written by the sampling profiler.
+  void loadSamplingProfile(std::unique_ptr<llvm::MemoryBuffer> profileBuffer);
+  // Print the sampled functions ranked by samples per byte of bytecode, with
+  // their opcode mix, flagging the hot loops worth compiling and the hot
+  // functions small enough to inline.
+  void dumpHotFunctions();
   // Print offsets of a function.
   void dumpFunctionOffsets(uint32_t funcId, StructuredPrinter &printer);
   // Print offsets for all functions in bundle.
@@ -67,6 +67,12 @@ static llvm::cl::opt<std::string> ProfileFile(
     llvm::cl::desc(
         "Log file in json format generated by basic block profiler"));
 
+static llvm::cl::opt<std::string> SamplingProfileFile(
+    "sampling-profile",
+    llvm::cl::desc(
+        "Profile in Chrome trace format generated by the sampling profiler, "
+        "for the 'hot' command"));
+
 static llvm::cl::opt<bool> ShowSectionRanges(
     "show-section-ranges",
     llvm::cl::init(false),
@@ -134,6 +140,12 @@ static void printHelp(llvm::Optional<llvm::StringRef> command = llvm::None) {
       {"block",
        "Display top hot basic blocks in sorted order.\n\n"
        "USAGE: block\n"},
+      {"hot",
+       "Rank the functions sampled by the sampling profiler by samples per "
+       "byte of bytecode, with their opcode mix. Hot functions with loops are "
+       "flagged 'jit', and small hot functions 'inline'. Requires "
+       "-sampling-profile.\n\n"
+       "USAGE: hot\n"},
       {"at-virtual",
        "Display information about the function at a given virtual offset.\n\n"
        "USAGE: at-virtual <OFFSET> [-json]\n"},
@@ -183,6 +195,16 @@ static void enterCommandLoop(
           ? llvm::Optional<std::unique_ptr<llvm::MemoryBuffer>>(
                 std::move(profileBufferOpt.getValue()))
           : llvm::None);
+  if (!SamplingProfileFile.empty()) {
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> samplingProfileBuffer =
+        llvm::MemoryBuffer::getFile(SamplingProfileFile);
+    if (!samplingProfileBuffer) {
+      llvm::errs() << "Error: fail to open file: " << SamplingProfileFile
+                   << samplingProfileBuffer.getError().message() << "\n";
+      exit(-1);
+    }
+    analyzer.loadSamplingProfile(std::move(samplingProfileBuffer.get()));
+  }
 
   // Process startup commands.
   bool terminateLoop = false;
@@ -325,6 +347,8 @@ static bool executeCommand(
     analyzer.dumpSummary();
   } else if (command == "block") {
     analyzer.dumpBasicBlockStats();
+  } else if (command == "hot") {
+    analyzer.dumpHotFunctions();
   } else if (command == "at_virtual" || command == "at-virtual") {
     bool json = findAndRemoveOne(commandTokens, "-json");
     std::unique_ptr<StructuredPrinter> printer =
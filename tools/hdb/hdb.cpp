@@ -21,6 +21,7 @@ int main(void) {
 #include <signal.h>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <deque>
 #include <fstream>
@@ -131,7 +132,8 @@ std::string chompToken(std::string *str, const char *separators = " \t") {
 
 void printUsageAndExit() {
   std::cerr
-      << "USAGE: hdb [--break-at-start] [--break-after <secs>] [--lazy] <input JS file>\n";
+      << "USAGE: hdb [--break-at-start] [--break-after <secs>] [--lazy] "
+         "[-Xvm-experiment-flags=<flags>] <input JS file>\n";
   exit(EXIT_FAILURE);
 }
 
@@ -140,6 +142,7 @@ struct Options {
   bool breakAtStart{false};
   bool lazy{false};
   double breakAfterDelay{-1.}; // -1 disables breakAfterDelay
+  uint32_t vmExperimentFlags{0};
 };
 
 Options getCommandLineOptions(int argc, char **argv) {
@@ -175,6 +178,14 @@ Options getCommandLineOptions(int argc, char **argv) {
         exit(EXIT_FAILURE);
       }
       result.breakAfterDelay = breakAfterDelay;
+    } else if (strncmp(arg, "-Xvm-experiment-flags=", 22) == 0) {
+      char *endptr = nullptr;
+      unsigned long flags = std::strtoul(arg + 22, &endptr, 0);
+      if (*endptr != '\0' || arg[22] == '\0' || flags > UINT32_MAX) {
+        std::cerr << "Invalid VM experiment flags: " << arg + 22 << std::endl;
+        exit(EXIT_FAILURE);
+      }
+      result.vmExperimentFlags = flags;
     } else {
       printUsageAndExit();
     }
@@ -738,7 +749,10 @@ int main(int argc, char **argv) {
       (std::istreambuf_iterator<char>(fileStream)),
       std::istreambuf_iterator<char>());
 
-  std::unique_ptr<HermesRuntime> runtime = makeHermesRuntime();
+  std::unique_ptr<HermesRuntime> runtime = makeHermesRuntime(
+      ::hermes::vm::RuntimeConfig::Builder()
+          .withVMExperimentFlags(options.vmExperimentFlags)
+          .build());
   HDBDebugger debugger(*runtime);
   runtime->getDebugger().setEventObserver(&debugger);
   runtime->getDebugger().setShouldPauseOnScriptLoad(options.breakAtStart);
@@ -41,6 +41,39 @@ static opt<bool> JITCrashOnError(
     llvm::cl::desc("crash on any JIT compilation error"),
     llvm::cl::init(false));
 
+static opt<unsigned> JITThreshold(
+    "jit-threshold",
+    llvm::cl::desc("number of calls after which a function is JIT compiled"),
+    llvm::cl::init(10));
+
+static opt<unsigned> JITLoopThreshold(
+    "jit-loop-threshold",
+    llvm::cl::desc(
+        "number of loop iterations after which a function is JIT compiled"),
+    llvm::cl::init(1000));
+
+static opt<unsigned> JITRegExpThreshold(
+    "jit-regexp-threshold",
+    llvm::cl::desc("number of searches after which a regex is JIT compiled"),
+    llvm::cl::init(10));
+
+static opt<unsigned> JITMemoryLimit(
+    "jit-memory-limit",
+    llvm::cl::desc("maximum bytes of executable memory used by the JIT"),
+    llvm::cl::init((1 << 20) * 32));
+
+static opt<bool> JITBackground(
+    "jit-background",
+    llvm::cl::desc("compile functions on a background thread"),
+    llvm::cl::init(false));
+
+static opt<std::string> JITProfile(
+    "jit-profile",
+    llvm::cl::desc(
+        "file recording the functions compiled by the JIT, which are "
+        "compiled on their first call in later runs"),
+    llvm::cl::value_desc("filename"));
+
 static opt<unsigned> Repeat(
     "Xrepeat",
     llvm::cl::desc("Repeat execution N number of times"),
@@ -66,6 +99,34 @@ static opt<bool> GCRevertToYGAtTTI(
     cat(GCCategory),
     init(false));
 
+static opt<bool> GCIncrementalMarking(
+    "gc-incremental-marking",
+    desc("Mark the old generation incrementally, between young generation "
+         "collections"),
+    cat(GCCategory),
+    init(false));
+
+static opt<unsigned> GCThreads(
+    "gc-threads",
+    desc("Number of threads that mark, and update references, in full "
+         "garbage collections"),
+    cat(GCCategory),
+    init(1));
+
+static opt<bool> GCHugePages(
+    "gc-huge-pages",
+    desc("Reserve the maximum heap size up front, backed by transparent huge "
+         "pages where supported"),
+    cat(GCCategory),
+    init(false));
+
+static opt<unsigned> CodeBlockIdleGCs(
+    "code-block-idle-gcs",
+    desc("Every this many collections, release the threaded code and type "
+         "feedback of the functions that didn't run since the last release"),
+    cat(GCCategory),
+    init(0));
+
 static opt<bool> GCPrintStats(
     "gc-print-stats",
     desc("Output summary garbage collection statistics at exit"),
@@ -97,12 +158,23 @@ static int executeHBCBytecodeFromCL(
                   .withShouldReleaseUnused(false)
                   .withAllocInYoung(cl::GCAllocYoung)
                   .withRevertToYGAtTTI(cl::GCRevertToYGAtTTI)
+                  .withIncrementalMarking(cl::GCIncrementalMarking)
+                  .withNumGCThreads(cl::GCThreads)
+                  .withHugePages(cl::GCHugePages)
                   .build())
           .withEnableJIT(cl::DumpJITCode || cl::EnableJIT)
+          .withJITInvocationThreshold(cl::JITThreshold)
+          .withJITLoopThreshold(cl::JITLoopThreshold)
+          .withJITRegExpThreshold(cl::JITRegExpThreshold)
+          .withJITBackgroundCompilation(cl::JITBackground)
+          .withJITMemoryLimit(cl::JITMemoryLimit)
           .withEnableEval(cl::EnableEval)
           .withVerifyEvalIR(cl::VerifyIR)
           .withVMExperimentFlags(cl::VMExperimentFlags)
+          .withCodeBlockIdleGCs(cl::CodeBlockIdleGCs)
           .withES6Symbol(cl::ES6Symbol)
+          .withES6Promise(cl::ES6Promise)
+          .withRegisterStackGuard(cl::RegisterStackGuard)
           .withEnableSampleProfiling(cl::SampleProfiling)
           .withRandomizeMemoryLayout(cl::RandomizeMemoryLayout)
           .withTrackIO(cl::TrackBytecodeIO)
@@ -117,7 +189,9 @@ static int executeHBCBytecodeFromCL(
 #endif
   options.dumpJITCode = cl::DumpJITCode;
   options.jitCrashOnError = cl::JITCrashOnError;
+  options.jitProfileFile = cl::JITProfile;
   options.stopAfterInit = cl::StopAfterInit;
+  options.bufferedOutput = cl::BufferedOutput;
 
   bool success;
   if (cl::Repeat <= 1) {
@@ -154,7 +228,8 @@ int main(int argc, char **argv) {
   // (Initialize this here, after llvm stuff above -- captures current
   // alt signal stack.)
   oscompat::SigAltStackDeleter sigAltDeleter;
-  driver::CompileResult res = driver::compileFromCommandLineOptions();
+  driver::CompileResult res = driver::compileFromCommandLineOptions(
+      llvm::ArrayRef<const char *>(argv, argc));
   if (res.bytecodeProvider) {
     auto ret = executeHBCBytecodeFromCL(
         std::move(res.bytecodeProvider), res.bytecodeBufferInfo);
@@ -0,0 +1,36 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+function Record(i) {
+    this.id = i;
+    this.name = "r";
+    this.x = i * 0.5;
+    this.y = i * 2;
+    this.z = 0;
+    this.flags = i & 7;
+    this.parent = null;
+    this.next = null;
+    this.weight = 1;
+    this.color = "red";
+    this.size = i % 13;
+    this.visited = false;
+    this.depth = 0;
+    this.tag = i;
+}
+
+function run(n) {
+    var sum = 0;
+    for (var i = 0; i < n; i++) {
+        var r = new Record(i);
+        sum += r.size + r.depth + r.tag;
+    }
+    return sum;
+}
+
+var total = 0;
+for (var j = 0; j < 10; j++) {
+    total += run(100000);
+}
+print(total);
@@ -0,0 +1,17 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+var stamps = [];
+for (var i = 0; i < 1000; i++) {
+    stamps.push(new Date(1500000000000 + i * 86399123).toISOString());
+}
+
+var total = 0;
+for (var j = 0; j < 1000; j++) {
+    for (var i = 0; i < stamps.length; i++) {
+        total += Date.parse(stamps[i]) % 1000;
+    }
+}
+print(total);
@@ -0,0 +1,27 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+function churn(n) {
+    var cache = {};
+    for (var i = 0; i < 200; i++) {
+        cache["live" + i] = i;
+    }
+    var hits = 0;
+    for (var i = 0; i < n; i++) {
+        var key = "k" + i;
+        cache[key] = i;
+        if (cache["live" + (i % 200)] !== undefined) {
+            hits++;
+        }
+        delete cache[key];
+    }
+    return hits + Object.keys(cache).length;
+}
+
+var total = 0;
+for (var j = 0; j < 10; j++) {
+    total += churn(100000);
+}
+print(total);
@@ -0,0 +1,28 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// Resumes generators with many live locals, so that most of the time is spent
+// suspending and resuming their frames.
+function* counter(n) {
+    var a = 1, b = 2, c = 3, d = 4, e = 5, f = 6, g = 7, h = 8;
+    var obj = {a: a, b: b};
+    for (var i = 0; i < n; i++) {
+        var x = yield i + a + b + c + d + e + f + g + h;
+        if (x) {
+            obj = {a: x, b: obj};
+        }
+    }
+    return obj.a;
+}
+
+var total = 0;
+for (var j = 0; j < 20; j++) {
+    var gen = counter(100000);
+    for (var r = gen.next(); !r.done; r = gen.next(r.value & 1)) {
+        total += r.value;
+    }
+    total += r.value;
+}
+print(total);
@@ -31,6 +31,9 @@
 ///
 /// If, on the other hand, it is faster, then we can focus on higher level
 /// optimizations.
+///
+/// With -compare, the benchmark runs once with the default dispatch and once
+/// with experiments::ThreadedDispatch, and prints the time of each.
 //===----------------------------------------------------------------------===//
 #include "hermes/BCGen/HBC/BytecodeGenerator.h"
 #include "hermes/VM/CodeBlock.h"
@@ -41,11 +44,13 @@
 #include "hermes/VM/StringView.h"
 
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/Signals.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <chrono>
 #include <map>
 
 using namespace hermes::vm;
@@ -180,32 +185,61 @@ static llvm::cl::opt<double> LoopCount{llvm::cl::Positional,
 static llvm::cl::opt<int> FactValue{llvm::cl::Positional,
                                     llvm::cl::init(100),
                                     llvm::cl::desc("(factorial value)")};
-
-int main(int argc, char **argv) {
-  // Print a stack trace if we signal out.
-  llvm::sys::PrintStackTraceOnErrorSignal("Hermes driver");
-  llvm::PrettyStackTraceProgram X(argc, argv);
-  // Call llvm_shutdown() on exit to print stats and free memory.
-  llvm::llvm_shutdown_obj Y;
-  llvm::cl::ParseCommandLineOptions(argc, argv, "Hermes vm driver\n");
-
-  llvm::outs() << "Running " << (uint64_t)LoopCount << " loops of factorial("
-               << FactValue << ")\n";
-
+static llvm::cl::opt<bool> ThreadedDispatch{
+    "threaded-dispatch",
+    llvm::cl::init(false),
+    llvm::cl::desc("Dispatch through the direct-threaded bytecode")};
+static llvm::cl::opt<bool> Compare{
+    "compare",
+    llvm::cl::init(false),
+    llvm::cl::desc("Time the default and the threaded dispatch")};
+
+/// Run the benchmark in a new runtime with \p flags, print its result, and
+/// \return the time it took in milliseconds.
+static double runBenchmark(experiments::VMExperimentFlags flags) {
   auto runtime =
       Runtime::create(RuntimeConfig::Builder()
                           .withGCConfig(GCConfig::Builder()
                                             .withInitHeapSize(1 << 16)
                                             .withMaxHeapSize(1 << 19)
                                             .build())
+                          .withVMExperimentFlags(flags)
                           .build());
 
   GCScope scope(runtime.get());
+  auto start = std::chrono::steady_clock::now();
   auto res = benchmark(runtime.get(), LoopCount, FactValue);
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
   SmallU16String<32> tmp;
   llvm::outs()
       << StringPrimitive::createStringView(runtime.get(), res).getUTF16Ref(tmp)
       << "\n";
+  return elapsed.count();
+}
+
+int main(int argc, char **argv) {
+  // Print a stack trace if we signal out.
+  llvm::sys::PrintStackTraceOnErrorSignal("Hermes driver");
+  llvm::PrettyStackTraceProgram X(argc, argv);
+  // Call llvm_shutdown() on exit to print stats and free memory.
+  llvm::llvm_shutdown_obj Y;
+  llvm::cl::ParseCommandLineOptions(argc, argv, "Hermes vm driver\n");
+
+  llvm::outs() << "Running " << (uint64_t)LoopCount << " loops of factorial("
+               << FactValue << ")\n";
+
+  if (Compare) {
+    double baseline = runBenchmark(experiments::Default);
+    double threaded = runBenchmark(experiments::ThreadedDispatch);
+    llvm::outs() << "default dispatch: " << llvm::format("%.1f", baseline)
+                 << " ms\nthreaded dispatch: "
+                 << llvm::format("%.1f", threaded) << " ms\n";
+  } else {
+    runBenchmark(
+        ThreadedDispatch ? experiments::ThreadedDispatch
+                         : experiments::Default);
+  }
 #ifdef HERMESVM_OPCODE_STATS
   Runtime::dumpOpcodeStats(llvm::outs());
 #endif
@@ -0,0 +1,31 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// Calls small JS functions with various numbers of arguments, so that most
+// of the time is spent setting up and tearing down frames.
+function add(a, b) {
+    return a + b;
+}
+
+function add3(a, b, c) {
+    return a + b + c;
+}
+
+function missing(a, b, c, d) {
+    return d === undefined ? a : b;
+}
+
+function fib(n) {
+    return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+
+var total = 0;
+for (var i = 0; i < 3000000; i++) {
+    total = add(total, 1);
+    total = add3(total, i & 1, -(i & 1));
+    total = missing(total, 0);
+}
+total += fib(25);
+print(total);
@@ -0,0 +1,30 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// Serialize and parse a payload shaped like a typical API response.
+function makeItem(i) {
+    return {
+        id: i,
+        name: "item " + i,
+        price: i * 1.25,
+        available: i % 3 !== 0,
+        tags: ["tag" + (i % 7), "tag" + (i % 11)],
+        owner: {id: i % 97, name: "owner " + (i % 97), verified: i % 2 === 0},
+    };
+}
+
+var items = [];
+for (var i = 0; i < 1000; i++) {
+    items.push(makeItem(i));
+}
+var payload = {page: 1, total: items.length, items: items};
+
+var checksum = 0;
+for (var round = 0; round < 100; round++) {
+    var text = JSON.stringify(payload);
+    var parsed = JSON.parse(text);
+    checksum += text.length + parsed.items[round].owner.id;
+}
+print(checksum);
@@ -0,0 +1,28 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// Insert into and delete from Maps and Sets, as caches and subscriptions do.
+var cache = new Map();
+var live = new Set();
+var hits = 0;
+for (var i = 0; i < 1000000; i++) {
+    var key = "k" + (i % 5000);
+    var entry = cache.get(key);
+    if (entry !== undefined) {
+        hits++;
+        if (i % 7 === 0) {
+            cache.delete(key);
+        }
+    } else {
+        cache.set(key, {value: i});
+    }
+    var obj = {id: i};
+    live.add(obj);
+    if (live.size > 1000) {
+        // Drop the oldest entry.
+        live.delete(live.values().next().value);
+    }
+}
+print(hits, cache.size, live.size);
@@ -0,0 +1,21 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+function formatNumbers(n) {
+    var len = 0;
+    var x = 0.1;
+    for (var i = 0; i < n; i++) {
+        x = x * 1.0001 + 0.37;
+        len += String(x).length + String(-i).length;
+        len += Number("" + i / 8) > 0 ? 1 : 0;
+    }
+    return len + JSON.stringify([x, n / 3, 1e-7]).length;
+}
+
+var total = 0;
+for (var j = 0; j < 20; j++) {
+    total += formatNumbers(100000);
+}
+print(total);
@@ -0,0 +1,25 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// Builds long chains of then() callbacks, so that most of the time is spent
+// creating promises and running the jobs that settle them.
+var total = 0;
+
+function step(v) {
+    total += v & 7;
+    return v + 1;
+}
+
+var chains = [];
+for (var j = 0; j < 20; j++) {
+    var p = Promise.resolve(j);
+    for (var i = 0; i < 20000; i++) {
+        p = p.then(step);
+    }
+    chains.push(p);
+}
+Promise.all(chains).then(function() {
+    print(total);
+});
@@ -0,0 +1,81 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// Render a tree of elements and diff it against the previous render, the
+// way a React-like reconciler does.
+function h(type, props, children) {
+    return {type: type, props: props, children: children || []};
+}
+
+function render(rows, version) {
+    var children = [];
+    for (var i = 0; i < rows.length; i++) {
+        var row = rows[i];
+        var props = {key: row.id, selected: row.id === version % 50};
+        children.push(h("row", props, [
+            h("label", {text: row.label}),
+            h("button", {onPress: null, title: "remove " + row.id}),
+        ]));
+    }
+    return h("list", {count: rows.length}, children);
+}
+
+function diffProps(prev, next, patches) {
+    for (var key in next) {
+        if (prev[key] !== next[key]) {
+            patches.push(key);
+        }
+    }
+    for (var key in prev) {
+        if (!(key in next)) {
+            patches.push(key);
+        }
+    }
+}
+
+function diff(prev, next, patches) {
+    if (prev.type !== next.type) {
+        patches.push(next.type);
+        return;
+    }
+    diffProps(prev.props, next.props, patches);
+    var prevByKey = new Map();
+    for (var i = 0; i < prev.children.length; i++) {
+        var child = prev.children[i];
+        var key = child.props.key !== undefined ? child.props.key : i;
+        prevByKey.set(key, child);
+    }
+    for (var i = 0; i < next.children.length; i++) {
+        var child = next.children[i];
+        var key = child.props.key !== undefined ? child.props.key : i;
+        var old = prevByKey.get(key);
+        if (old) {
+            diff(old, child, patches);
+        } else {
+            patches.push(child.type);
+        }
+    }
+}
+
+var rows = [];
+for (var i = 0; i < 500; i++) {
+    rows.push({id: i, label: "row " + i});
+}
+
+var tree = render(rows, 0);
+var numPatches = 0;
+for (var version = 1; version < 200; version++) {
+    // Move a row, relabel another, and replace a third.
+    rows.push(rows.shift());
+    rows[version % rows.length] = {id: rows[version % rows.length].id,
+                                   label: "row " + version};
+    rows[(version * 7) % rows.length] = {id: 1000 + version, label: "new"};
+    var next = render(rows, version);
+    var patches = [];
+    diff(tree, next, patches);
+    numPatches += patches.length;
+    tree = next;
+}
+print(numPatches);
@@ -0,0 +1,35 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+// Parse log lines with regular expressions.
+var lines = [];
+for (var i = 0; i < 2000; i++) {
+    lines.push("2019-07-" + (10 + i % 20) + "T12:" + (10 + i % 50) +
+               ":00Z [" + (i % 5 === 0 ? "ERROR" : "INFO") + "] " +
+               "request id=" + i + " path=/api/v1/items/" + (i % 37) +
+               " took " + (i % 300) + "ms user=\"user" + (i % 13) + "\"");
+}
+
+var lineRe = /^(\d{4})-(\d\d)-(\d\d)T(\d\d):(\d\d):(\d\d)Z \[(\w+)\] (.*)$/;
+var fieldRe = /(\w+)=("[^"]*"|\S+)/g;
+var errors = 0;
+var totalMs = 0;
+var fields = 0;
+for (var round = 0; round < 20; round++) {
+    for (var i = 0; i < lines.length; i++) {
+        var m = lineRe.exec(lines[i]);
+        if (m[7] === "ERROR") {
+            errors++;
+        }
+        var f;
+        fieldRe.lastIndex = 0;
+        while ((f = fieldRe.exec(m[8])) !== null) {
+            fields++;
+        }
+        totalMs += parseInt(m[8].replace(/.* took (\d+)ms.*/, "$1"), 10);
+        fields += m[8].split(/\s+/).length;
+    }
+}
+print(errors, totalMs, fields);
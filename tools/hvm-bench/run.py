@@ -0,0 +1,204 @@
+#!/usr/bin/env python
+# Copyright (c) Facebook, Inc. and its affiliates.
+#
+# This source code is licensed under the MIT license found in the LICENSE
+# file in the root directory of this source tree.
+
+# -*- coding: utf-8 -*-
+
+""" Benchmark runner for the Hermes VM.
+
+The 'run' command runs the benchmarks of this directory, or the given ones,
+with a hermes binary, and prints their time, allocations, GC pauses and peak
+RSS as JSON, each summarized over several repetitions.
+The 'compare' command prints the differences between the medians of two such
+JSON outputs, typically from two builds.
+"""
+
+from __future__ import absolute_import, division, print_function, unicode_literals
+
+import argparse
+import glob
+import json
+import os
+import re
+import subprocess
+import sys
+import time
+from collections import OrderedDict
+
+
+JSON_INDENT = 2
+BENCH_DIR = os.path.dirname(os.path.abspath(__file__))
+
+# Realistic workloads, as opposed to the microbenchmarks, which are all the
+# other .js files of this directory.
+WORKLOADS = [
+    "jsonRoundTrip",
+    "reconcile",
+    "stringConcat",
+    "regexParse",
+    "mapSetChurn",
+]
+
+# The metrics reported by -gc-print-stats, by the name they are given in the
+# output of this script.
+GC_METRICS = OrderedDict(
+    [
+        ("totalTime", "totalTime"),
+        ("totalCPUTime", "totalCPUTime"),
+        ("numCollections", "numCollections"),
+        ("totalGCTime", "totalGCTime"),
+        ("maxGCPause", "maxGCPause"),
+        ("avgGCPause", "avgGCPause"),
+        ("totalAllocatedBytes", "totalAllocatedBytes"),
+        ("finalHeapSize", "finalHeapSize"),
+        ("peakRSS", "Peak RSS"),
+    ]
+)
+
+# Lower is better for all the metrics, so the comparison only needs to flag
+# changes larger than this, as a fraction of the baseline.
+NOISE_THRESHOLD = 0.03
+
+
+def list_benchmarks():
+    """ Return the names of all the benchmarks, workloads first. """
+    names = sorted(
+        os.path.splitext(os.path.basename(path))[0]
+        for path in glob.glob(os.path.join(BENCH_DIR, "*.js"))
+    )
+    return WORKLOADS + [name for name in names if name not in WORKLOADS]
+
+
+def parse_gc_stats(text):
+    """ Extract the metrics of GC_METRICS from the output of -gc-print-stats,
+        which is JSON preceded by headers.
+    """
+    metrics = OrderedDict()
+    for (name, key) in GC_METRICS.items():
+        match = re.search(r'"%s":\s*(-?[0-9.eE+]+)' % re.escape(key), text)
+        if match:
+            metrics[name] = float(match.group(1))
+    return metrics
+
+
+def run_once(hermes, path, extra_args):
+    """ Run the benchmark at path once, returning its metrics. """
+    start = time.time()
+    proc = subprocess.Popen(
+        [hermes, "-gc-print-stats"] + extra_args + [path],
+        stdout=subprocess.PIPE,
+        stderr=subprocess.PIPE,
+    )
+    _, err = proc.communicate()
+    wall_time = time.time() - start
+    if proc.returncode != 0:
+        raise RuntimeError(
+            "%s failed with status %d:\n%s"
+            % (path, proc.returncode, err.decode("utf-8", "replace"))
+        )
+    metrics = OrderedDict([("wallTime", wall_time)])
+    metrics.update(parse_gc_stats(err.decode("utf-8", "replace")))
+    return metrics
+
+
+def summarize(samples):
+    """ Summarize the values of a metric over the repetitions. """
+    samples = sorted(samples)
+    result = OrderedDict()
+    result["min"] = samples[0]
+    result["median"] = samples[(len(samples) - 1) // 2]
+    result["max"] = samples[-1]
+    result["mean"] = sum(samples) / len(samples)
+    return result
+
+
+def subcommand_run(args):
+    """ Implementation of run subcommand
+        Runs the benchmarks specified in args.BENCHMARKS, or all of them.
+    """
+    names = args.BENCHMARKS or list_benchmarks()
+    extra_args = args.hermes_args.split() if args.hermes_args else []
+    results = OrderedDict()
+    results["hermes"] = os.path.abspath(args.hermes)
+    results["reps"] = args.reps
+    results["benchmarks"] = OrderedDict()
+    for name in names:
+        path = os.path.join(BENCH_DIR, name + ".js")
+        print("Running %s" % name, file=sys.stderr)
+        for _ in range(args.warmup):
+            run_once(args.hermes, path, extra_args)
+        reps = [run_once(args.hermes, path, extra_args) for _ in range(args.reps)]
+        summary = OrderedDict()
+        for metric in reps[0]:
+            summary[metric] = summarize(
+                [rep[metric] for rep in reps if metric in rep]
+            )
+        results["benchmarks"][name] = summary
+    output = json.dumps(results, indent=JSON_INDENT)
+    if args.out:
+        with open(args.out, "w") as out_fd:
+            out_fd.write(output + "\n")
+    else:
+        print(output)
+
+
+def subcommand_compare(args):
+    """ Implementation of compare subcommand
+        Compares the medians of the two result files in args.FILES.
+    """
+    before_path, after_path = args.FILES
+    with open(before_path) as before_fd:
+        before = json.load(before_fd)["benchmarks"]
+    with open(after_path) as after_fd:
+        after = json.load(after_fd)["benchmarks"]
+    print(
+        "%-20s %-20s %16s %16s %9s"
+        % ("benchmark", "metric", "before", "after", "change")
+    )
+    for name, metrics in after.items():
+        if name not in before:
+            continue
+        for metric, summary in metrics.items():
+            if metric not in before[name]:
+                continue
+            old = before[name][metric]["median"]
+            new = summary["median"]
+            if old == 0:
+                change = "-"
+            else:
+                ratio = (new - old) / old
+                change = "%+.1f%%" % (ratio * 100)
+                if abs(ratio) > NOISE_THRESHOLD:
+                    change += " !" if ratio > 0 else " *"
+            print("%-20s %-20s %16.4f %16.4f %9s" % (name, metric, old, new, change))
+
+
+USAGE = r"""run.py run --hermes HERMES [--reps N] [--out FILE] [BENCHMARK...]
+       run.py compare BEFORE_FILE AFTER_FILE
+
+  In its first form, run the given benchmarks of this directory (by default,
+  all of them) with the given hermes binary, and output their metrics as JSON.
+
+  In its second form, output the changes in the median of every metric between
+  two outputs of the first form. Changes larger than 3% are marked with ! when
+  they are regressions, and * when they are improvements.
+"""
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(usage=USAGE)
+    subparsers = parser.add_subparsers()
+    run_parser = subparsers.add_parser("run")
+    run_parser.add_argument("--hermes", required=True)
+    run_parser.add_argument("--hermes-args", default="")
+    run_parser.add_argument("--reps", type=int, default=5)
+    run_parser.add_argument("--warmup", type=int, default=1)
+    run_parser.add_argument("--out")
+    run_parser.add_argument("BENCHMARKS", nargs="*")
+    run_parser.set_defaults(func=subcommand_run)
+    compare_parser = subparsers.add_parser("compare")
+    compare_parser.add_argument("FILES", nargs=2)
+    compare_parser.set_defaults(func=subcommand_compare)
+    pargs = parser.parse_args()
+    pargs.func(pargs)
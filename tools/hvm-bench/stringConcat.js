@@ -0,0 +1,18 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+//
+// This source code is licensed under the MIT license found in the LICENSE
+// file in the root directory of this source tree.
+//
+function buildString(n) {
+    var s = "";
+    for (var i = 0; i < n; i++) {
+        s += "line " + i + "\n";
+    }
+    return s;
+}
+
+var total = 0;
+for (var j = 0; j < 20; j++) {
+    total += buildString(100000).length;
+}
+print(total);
@@ -119,10 +119,13 @@ int main(int argc, char **argv) {
                   .withName("hvm")
                   .build())
           .withES6Symbol(cl::ES6Symbol)
+          .withES6Promise(cl::ES6Promise)
+          .withRegisterStackGuard(cl::RegisterStackGuard)
           .withTrackIO(cl::TrackBytecodeIO)
           .build();
 
   options.stopAfterInit = cl::StopAfterInit;
+  options.bufferedOutput = cl::BufferedOutput;
 #ifdef HERMESVM_PROFILER_EXTERN
   options.patchProfilerSymbols = cl::PatchProfilerSymbols;
   options.profilerSymbolsFile = cl::ProfilerSymbolsFile;
@@ -243,6 +243,7 @@ int main(int argc, char **argv) {
                             .withShouldRecordStats(GCPrintStats)
                             .build())
           .withES6Symbol(cl::ES6Symbol)
+          .withES6Promise(cl::ES6Promise)
           .build());
 
   vm::GCScope gcScope(runtime.get());
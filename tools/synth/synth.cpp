@@ -57,6 +57,19 @@ static opt<int> Reps(
         "rep with the median \"totalTime\"."),
     init(1));
 
+static opt<bool> Benchmark(
+    "benchmark",
+    desc("Instead of the GC stats, print percentiles over the reps of the "
+         "latency of each phase of the replay, of the GC metrics, and the "
+         "peak RSS, as JSON"),
+    init(false));
+
+static opt<std::string> BenchmarkBaseline(
+    "benchmark-baseline",
+    desc("With -benchmark, a report printed by another build to compare "
+         "this one against. The comparison is printed to stderr"),
+    init(""));
+
 /// @}
 
 /// @name Common flags from Hermes VM
@@ -102,6 +115,7 @@ int main(int argc, char **argv) {
     options.bytecodeWarmupPercent = cl::BytecodeWarmupPercent;
     options.sanitizeRate = cl::GCSanitizeRate;
     options.sanitizeRandomSeed = cl::GCSanitizeRandomSeed;
+    options.benchmark = cl::Benchmark;
 #if !defined(NDEBUG) || defined(LLVM_ENABLE_STATS)
     if (cl::PrintStats)
       llvm::EnableStatistics();
@@ -114,9 +128,19 @@ int main(int argc, char **argv) {
         cl::TraceFile, cl::BytecodeFile, options, llvm::outs());
     llvm::outs() << "\n";
 #else
-    llvm::outs() << TraceInterpreter::execAndGetStats(
-                        cl::TraceFile, cl::BytecodeFile, options)
-                 << "\n";
+    std::string stats = TraceInterpreter::execAndGetStats(
+        cl::TraceFile, cl::BytecodeFile, options);
+    llvm::outs() << stats << "\n";
+    if (cl::Benchmark && !cl::BenchmarkBaseline.empty()) {
+      auto baseline = llvm::MemoryBuffer::getFile(cl::BenchmarkBaseline);
+      if (!baseline) {
+        throw std::system_error(baseline.getError());
+      }
+      TraceInterpreter::compareBenchmarks(
+          std::move(baseline.get()),
+          llvm::MemoryBuffer::getMemBufferCopy(stats),
+          llvm::errs());
+    }
 #endif
 #if !defined(NDEBUG) || defined(LLVM_ENABLE_STATS)
     if (cl::PrintStats)
@@ -7,6 +7,18 @@
 #include <gtest/gtest.h>
 #include <hermes/CompileJS.h>
 #include <hermes/hermes.h>
+#include <jsi/threadsafe.h>
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <cstdio>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 using namespace facebook::jsi;
 using namespace facebook::hermes;
@@ -99,6 +111,38 @@ TEST_F(HermesRuntimeTest, BytecodeTest) {
   EXPECT_EQ(rt->global().getProperty(*rt, "x").getNumber(), 1);
 }
 
+TEST_F(HermesRuntimeTest, MappedBytecodeTest) {
+  std::string bytecode;
+  ASSERT_TRUE(hermes::compileJS("x = 1", bytecode));
+
+  // Store the bytecode after some other data, as in an APK.
+  const char padding[8] = {};
+  FILE *file = tmpfile();
+  ASSERT_NE(nullptr, file);
+  ASSERT_EQ(1u, fwrite(padding, sizeof(padding), 1, file));
+  ASSERT_EQ(1u, fwrite(bytecode.data(), bytecode.size(), 1, file));
+  ASSERT_EQ(0, fflush(file));
+
+  std::string error;
+  EXPECT_EQ(
+      nullptr,
+      HermesRuntime::mapHermesBytecode(
+          fileno(file), 2, bytecode.size(), &error));
+  EXPECT_FALSE(error.empty());
+  EXPECT_EQ(
+      nullptr,
+      HermesRuntime::mapHermesBytecode(
+          fileno(file), 0, bytecode.size(), &error));
+
+  auto mapped = HermesRuntime::mapHermesBytecode(
+      fileno(file), sizeof(padding), bytecode.size());
+  fclose(file);
+  ASSERT_NE(nullptr, mapped);
+  ASSERT_EQ(bytecode.size(), mapped->size());
+  rt->evaluateJavaScript(std::move(mapped), "");
+  EXPECT_EQ(rt->global().getProperty(*rt, "x").getNumber(), 1);
+}
+
 TEST_F(HermesRuntimeTest, PreparedJavaScriptBytecodeTest) {
   eval("var q = 0;");
   std::string bytecode;
@@ -112,6 +156,73 @@ TEST_F(HermesRuntimeTest, PreparedJavaScriptBytecodeTest) {
   EXPECT_EQ(rt->global().getProperty(*rt, "q").getNumber(), 2);
 }
 
+TEST_F(HermesRuntimeTest, PreparedJavaScriptSharedByRuntimesTest) {
+  std::string bytecode;
+  ASSERT_TRUE(hermes::compileJS("var q = (this.q || 0) + 1; q", bytecode));
+  auto prep =
+      rt->prepareJavaScript(std::make_unique<StringBuffer>(bytecode), "");
+  // The prepared bytecode is loaded once and used by both runtimes, which
+  // keep separate globals.
+  std::shared_ptr<HermesRuntime> other = makeHermesRuntime();
+  EXPECT_EQ(rt->evaluatePreparedJavaScript(prep).getNumber(), 1);
+  EXPECT_EQ(rt->evaluatePreparedJavaScript(prep).getNumber(), 2);
+  EXPECT_EQ(other->evaluatePreparedJavaScript(prep).getNumber(), 1);
+  rt.reset();
+  EXPECT_EQ(other->evaluatePreparedJavaScript(prep).getNumber(), 2);
+}
+
+TEST_F(HermesRuntimeTest, CodeCacheTest) {
+  llvm::SmallString<64> dir;
+  ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory("hermes-code-cache", dir));
+  auto entries = [&dir] {
+    std::vector<std::string> paths;
+    std::error_code ec;
+    for (llvm::sys::fs::directory_iterator it(dir, ec), end; !ec && it != end;
+         it.increment(ec)) {
+      paths.push_back(it->path());
+    }
+    return paths;
+  };
+  const std::string source = "var n = (this.n || 0) + 1; n";
+  auto run = [&source](HermesRuntime &runtime, const char *url) {
+    return runtime
+        .evaluateJavaScript(std::make_unique<StringBuffer>(source), url)
+        .getNumber();
+  };
+
+  rt->setCodeCacheDirectory(dir.str().str());
+  EXPECT_EQ(run(*rt, "a.js"), 1);
+  auto paths = entries();
+  ASSERT_EQ(paths.size(), 1u);
+  auto cached = llvm::MemoryBuffer::getFile(paths[0]);
+  ASSERT_TRUE(static_cast<bool>(cached));
+  EXPECT_TRUE(HermesRuntime::isHermesBytecode(
+      reinterpret_cast<const uint8_t *>(cached.get()->getBufferStart()),
+      cached.get()->getBufferSize()));
+
+  // Replace the entry to see that later runs use it instead of compiling.
+  std::string bytecode;
+  ASSERT_TRUE(hermes::compileJS("42", bytecode));
+  {
+    std::error_code ec;
+    llvm::raw_fd_ostream os(paths[0], ec, llvm::sys::fs::F_None);
+    ASSERT_FALSE(ec);
+    os << bytecode;
+  }
+  EXPECT_EQ(run(*rt, "a.js"), 42);
+  std::shared_ptr<HermesRuntime> other = makeHermesRuntime();
+  other->setCodeCacheDirectory(dir.str().str());
+  EXPECT_EQ(run(*other, "a.js"), 42);
+
+  // A different URL is a different entry, and no directory, no cache.
+  EXPECT_EQ(run(*rt, "b.js"), 2);
+  EXPECT_EQ(entries().size(), 2u);
+  other->setCodeCacheDirectory("");
+  EXPECT_EQ(run(*other, "a.js"), 1);
+
+  llvm::sys::fs::remove_directories(dir);
+}
+
 TEST_F(HermesRuntimeTest, PreparedJavaScriptInvalidSourceThrows) {
   const char *badSource = "this is definitely not valid javascript";
   bool caught = false;
@@ -123,6 +234,35 @@ TEST_F(HermesRuntimeTest, PreparedJavaScriptInvalidSourceThrows) {
   EXPECT_TRUE(caught) << "prepareJavaScript should have thrown an exception";
 }
 
+TEST_F(HermesRuntimeTest, PrepareJavaScriptAsyncTest) {
+  auto prepared = HermesRuntime::prepareJavaScriptAsync(
+      std::make_shared<StringBuffer>("[1, 2, 3].map(x => x * 2).join()"),
+      "async.js");
+  // The runtime can be used while the source compiles.
+  EXPECT_EQ(eval("6 * 7").getNumber(), 42);
+  EXPECT_EQ(
+      rt->evaluatePreparedJavaScript(prepared.get()).getString(*rt).utf8(*rt),
+      "2,4,6");
+
+  std::string bytecode;
+  ASSERT_TRUE(hermes::compileJS("'from bytecode'", bytecode));
+  auto fromBytecode = HermesRuntime::prepareJavaScriptOnAnyThread(
+      std::make_shared<StringBuffer>(bytecode), "bytecode.js");
+  EXPECT_EQ(
+      rt->evaluatePreparedJavaScript(fromBytecode).getString(*rt).utf8(*rt),
+      "from bytecode");
+
+  // Errors are in the future.
+  auto bad = HermesRuntime::prepareJavaScriptAsync(
+      std::make_shared<StringBuffer>("this is not valid javascript"), "");
+  EXPECT_THROW(bad.get(), JSIException);
+  bytecode.resize(bytecode.size() / 2);
+  EXPECT_THROW(
+      HermesRuntime::prepareJavaScriptOnAnyThread(
+          std::make_shared<StringBuffer>(bytecode), ""),
+      JSIException);
+}
+
 TEST_F(HermesRuntimeTest, NoCorruptionOnJSError) {
   // If the test crashes or infinite loops, the likely cause is that
   // Hermes API library is not built with proper compiler flags
@@ -372,6 +512,84 @@ TEST_F(HermesRuntimeTest, HostObjectAsParentTest) {
       eval("var subClass = {__proto__: ho}; subClass.prop1 == 10;").getBool());
 }
 
+TEST_F(HermesRuntimeTest, PropNameIDKeyTest) {
+  class HostObjectWithKeys : public HostObject {
+   public:
+    explicit HostObjectWithKeys(const std::vector<PropNameID> &names) {
+      for (const PropNameID &name : names)
+        keys_.emplace(HermesRuntime::getPropNameIDKey(name), keys_.size());
+    }
+    Value get(Runtime &runtime, const PropNameID &name) override {
+      auto it = keys_.find(HermesRuntime::getPropNameIDKey(name));
+      return it == keys_.end() ? Value() : Value((int)it->second);
+    }
+
+   private:
+    std::unordered_map<uint32_t, size_t> keys_;
+  };
+
+  // The names must stay alive for their keys to remain valid.
+  std::vector<PropNameID> names;
+  for (const char *name : {"x", "y", "z"})
+    names.push_back(PropNameID::forAscii(*rt, name));
+  Object ho = Object::createFromHostObject(
+      *rt, std::make_shared<HostObjectWithKeys>(names));
+  rt->global().setProperty(*rt, "ho", ho);
+  EXPECT_TRUE(eval("var s = 'z'; ho.x === 0 && ho.y === 1 && ho[s] === 2 && "
+                   "ho.w === undefined")
+                  .getBool());
+  EXPECT_EQ(
+      HermesRuntime::getPropNameIDKey(PropNameID::forUtf8(*rt, "x")),
+      HermesRuntime::getPropNameIDKey(names[0]));
+  EXPECT_NE(
+      HermesRuntime::getPropNameIDKey(names[0]),
+      HermesRuntime::getPropNameIDKey(names[1]));
+}
+
+TEST_F(HermesRuntimeTest, StructuredCloneTest) {
+  eval(
+      "var buffer = new ArrayBuffer(8);"
+      "var bytes = new Uint8Array(buffer);"
+      "bytes[1] = 7;"
+      "var msg = {n: 1.5, s: 'caf\\u00e9', list: [1, , 'x'], when: new Date(5),"
+      "           bytes: bytes, words: new Uint16Array(buffer, 2, 3)};"
+      "msg.self = msg;");
+  Value msg = rt->global().getProperty(*rt, "msg");
+  Array transfer = Array::createWithElements(
+      *rt, {rt->global().getPropertyAsObject(*rt, "buffer")});
+  auto serialized = rt->serialize(msg, transfer);
+  EXPECT_TRUE(eval("buffer.byteLength === 0").getBool());
+
+  // Process the message in a runtime of its own on another thread, and send
+  // the result back.
+  std::shared_ptr<::hermes::vm::SerializedValue> reply;
+  std::thread worker([&] {
+    std::shared_ptr<HermesRuntime> workerRt = makeHermesRuntime();
+    workerRt->global().setProperty(
+        *workerRt, "msg", workerRt->deserialize(serialized));
+    Value result = workerRt->global()
+                       .getPropertyAsFunction(*workerRt, "eval")
+                       .call(
+                           *workerRt,
+                           "msg.words[0] = 0xffff;"
+                           "[msg.self === msg, msg.n, msg.s, 1 in msg.list,"
+                           " msg.list.length, msg.when.getTime(), msg.bytes[1],"
+                           " msg.bytes.buffer == msg.words.buffer, msg.bytes]");
+    reply = workerRt->serialize(result);
+  });
+  worker.join();
+
+  rt->global().setProperty(*rt, "r", rt->deserialize(reply));
+  EXPECT_TRUE(eval("r[0] === true && r[1] === 1.5 && r[2] === 'caf\\u00e9' &&"
+                   "r[3] === false && r[4] === 3 && r[5] === 5 && r[6] === 7 &&"
+                   "r[7] === true && r[8][2] === 0xff && r[8][3] === 0xff")
+                  .getBool());
+
+  // The transferred contents only go to the first copy.
+  EXPECT_THROW(rt->deserialize(serialized), JSError);
+  EXPECT_THROW(rt->serialize(eval("(function() {})")), JSError);
+}
+
 TEST_F(HermesRuntimeTest, GlobalObjectTest) {
   rt->global().setProperty(*rt, "a", 5);
   eval("f = function(b) { return a + b; }");
@@ -379,4 +597,438 @@ TEST_F(HermesRuntimeTest, GlobalObjectTest) {
   EXPECT_EQ(eval("f(10)").getNumber(), 15);
 }
 
+TEST_F(HermesRuntimeTest, SamplingHeapProfilerTest) {
+  // Sample every allocation.
+  rt->enableSamplingHeapProfiler(1);
+  rt->evaluateJavaScript(
+      std::make_unique<StringBuffer>(R"(
+function allocateMany() {
+  var a = [];
+  for (var i = 0; i < 100; ++i) a.push({x: i});
+  return a;
+}
+allocateMany();
+)"),
+      "//SamplingHeapProfilerTest/URL");
+  std::ostringstream os;
+  rt->disableSamplingHeapProfiler(os);
+
+  const std::string profile = os.str();
+  EXPECT_NE(std::string::npos, profile.find("\"head\""));
+  EXPECT_NE(std::string::npos, profile.find("\"samples\""));
+  EXPECT_NE(std::string::npos, profile.find("\"allocateMany\""));
+  EXPECT_NE(std::string::npos, profile.find("//SamplingHeapProfilerTest/URL"));
+
+  // Disabling again does nothing.
+  std::ostringstream empty;
+  rt->disableSamplingHeapProfiler(empty);
+  EXPECT_TRUE(empty.str().empty());
+}
+
+TEST_F(HermesRuntimeTest, FunctionProfilerTest) {
+  rt->enableFunctionProfiler(std::chrono::microseconds(100));
+  rt->evaluateJavaScript(
+      std::make_unique<StringBuffer>(R"(
+function profiledCallee(x) { return x + 1; }
+function profiledCaller() {
+  var sum = 0;
+  for (var i = 0; i < 10; ++i) sum = profiledCallee(sum);
+  return sum;
+}
+profiledCaller();
+)"),
+      "//FunctionProfilerTest/URL");
+  rt->disableFunctionProfiler();
+
+  std::ostringstream os;
+  rt->dumpFunctionProfile(os);
+  const std::string profile = os.str();
+  EXPECT_NE(std::string::npos, profile.find("\"interval\":100"));
+  auto callee = profile.find("\"functionName\":\"profiledCallee\"");
+  ASSERT_NE(std::string::npos, callee);
+  EXPECT_NE(std::string::npos, profile.find("\"invocations\":10", callee));
+  auto caller = profile.find("\"functionName\":\"profiledCaller\"");
+  ASSERT_NE(std::string::npos, caller);
+  EXPECT_NE(std::string::npos, profile.find("\"invocations\":1,", caller));
+  EXPECT_NE(std::string::npos, profile.find("//FunctionProfilerTest/URL"));
+
+  // Enabling again resets the counters.
+  rt->enableFunctionProfiler(std::chrono::microseconds(0));
+  std::ostringstream empty;
+  rt->dumpFunctionProfile(empty);
+  EXPECT_EQ(std::string::npos, empty.str().find("profiledCallee"));
+}
+
+TEST_F(HermesRuntimeTest, FunctionTimeAttributionTest) {
+  rt->global().setProperty(
+      *rt,
+      "slowNative",
+      Function::createFromHostFunction(
+          *rt,
+          PropNameID::forAscii(*rt, "slowNative"),
+          0,
+          [](Runtime &, const Value &, const Value *, size_t) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            return Value();
+          }));
+  rt->global().setProperty(
+      *rt,
+      "collect",
+      Function::createFromHostFunction(
+          *rt,
+          PropNameID::forAscii(*rt, "collect"),
+          0,
+          [](Runtime &runtime, const Value &, const Value *, size_t) {
+            runtime.instrumentation().collectGarbage();
+            return Value();
+          }));
+  rt->enableFunctionProfiler(std::chrono::microseconds(0), true);
+  eval(R"(
+function callsNative() { slowNative(); }
+function collects() { collect(); }
+callsNative();
+collects();
+)");
+  rt->disableFunctionProfiler();
+
+  std::ostringstream os;
+  rt->dumpFunctionProfile(os);
+  rt->global().setProperty(
+      *rt, "profile", String::createFromUtf8(*rt, os.str()));
+  auto times = [this](const char *name) {
+    return eval((std::string("JSON.parse(profile).functions.find(f => "
+                             "f.functionName === '") +
+                 name + "')")
+                    .c_str())
+        .getObject(*rt);
+  };
+  Object native = times("callsNative");
+  EXPECT_GE(native.getProperty(*rt, "nativeTime").getNumber(), 20000);
+  EXPECT_LT(native.getProperty(*rt, "interpreterTime").getNumber(), 20000);
+  EXPECT_GT(times("collects").getProperty(*rt, "gcTime").getNumber(), 0);
+}
+
+TEST_F(HermesRuntimeTest, CodeCoverageTest) {
+  rt->enableCodeCoverage();
+  eval(R"(
+function branches(x) {
+  if (x) {
+    return 'taken';
+  }
+  return 'not taken';
+}
+function neverCalled() { return 1; }
+branches(true);
+)");
+  rt->disableCodeCoverage();
+
+  std::ostringstream os;
+  rt->dumpCodeCoverage(os);
+  rt->global().setProperty(
+      *rt, "coverage", String::createFromUtf8(*rt, os.str()));
+  auto count = [this](const char *name, bool covered) {
+    return eval((std::string("JSON.parse(coverage).functions.find(f => "
+                             "f.functionName === '") +
+                 name + "').blocks.filter(b => b.covered === " +
+                 (covered ? "true" : "false") + ").length")
+                    .c_str())
+        .getNumber();
+  };
+  EXPECT_GE(count("branches", true), 2);
+  EXPECT_GE(count("branches", false), 1);
+  EXPECT_EQ(0, count("neverCalled", true));
+  EXPECT_GE(count("neverCalled", false), 1);
+
+  // Enabling again forgets what was recorded.
+  rt->enableCodeCoverage();
+  std::ostringstream again;
+  rt->dumpCodeCoverage(again);
+  EXPECT_EQ(std::string::npos, again.str().find("\"covered\":true"));
+}
+
+TEST_F(HermesRuntimeTest, StartupStatsTest) {
+  rt->evaluateJavaScript(std::make_unique<StringBuffer>("var x = 1;"), "");
+  std::string stats = rt->getInstrumentedStats();
+  // \return the count of \p phase.
+  auto countOf = [&stats](const char *phase) {
+    auto pos = stats.find(std::string("\"") + phase + "\"");
+    EXPECT_NE(std::string::npos, pos) << phase;
+    const char *key = "\"count\":";
+    pos = stats.find(key, pos) + strlen(key);
+    return std::strtoul(stats.c_str() + pos, nullptr, 10);
+  };
+  EXPECT_EQ(1u, countOf("runtimeCreation"));
+  EXPECT_EQ(1u, countOf("predefinedStrings"));
+  EXPECT_EQ(1u, countOf("jslibInit"));
+  // The special runtime module and the evaluated code.
+  EXPECT_LE(2u, countOf("stringTableRegistration"));
+  EXPECT_LE(1u, countOf("globalFunction"));
+}
+
+TEST_F(HermesRuntimeTest, GCTelemetryTest) {
+  // Nothing is recorded by default.
+  EXPECT_NE(
+      std::string::npos,
+      rt->getInstrumentedStats().find("\"gcTelemetry\": {}"));
+
+  auto telemetryRt = makeHermesRuntime(
+      ::hermes::vm::RuntimeConfig::Builder()
+          .withGCConfig(::hermes::vm::GCConfig::Builder()
+                            .withShouldRecordTelemetry(true)
+                            .build())
+          .build());
+  telemetryRt->global()
+      .getPropertyAsFunction(*telemetryRt, "eval")
+      .call(
+          *telemetryRt,
+          "var kept = []; for (var i = 0; i < 10000; ++i) kept.push({i: i});");
+  telemetryRt->instrumentation().collectGarbage();
+
+  std::string stats = telemetryRt->getInstrumentedStats();
+  EXPECT_NE(std::string::npos, stats.find("\"allocationRate\""));
+  EXPECT_NE(std::string::npos, stats.find("\"youngGenSurvival\""));
+  EXPECT_NE(std::string::npos, stats.find("\"promotionAge\""));
+  EXPECT_NE(std::string::npos, stats.find("\"allocatedBytesByKind\""));
+}
+
+TEST_F(HermesRuntimeTest, ExternalStringTest) {
+  std::string ascii(1000, 'x');
+  String fromAscii = rt->createExternalString(std::move(ascii));
+  std::u16string utf16(1000, u'\u00e9');
+  String fromUtf16 = rt->createExternalString(std::move(utf16));
+  String fromUtf8 = rt->createExternalString(std::string("caf\xc3\xa9"));
+  rt->global().setProperty(*rt, "fromAscii", fromAscii);
+  rt->global().setProperty(*rt, "fromUtf16", fromUtf16);
+  EXPECT_TRUE(eval("fromAscii.length === 1000 && fromAscii[999] === 'x' && "
+                   "fromUtf16.length === 1000 && fromUtf16[0] === '\\u00e9'")
+                  .getBool());
+  EXPECT_EQ(fromUtf8.utf8(*rt), "caf\xc3\xa9");
+  EXPECT_EQ(fromAscii.utf8(*rt), std::string(1000, 'x'));
+
+  struct Data {
+    bool ascii;
+    std::u16string chars;
+  };
+  auto collect = [](void *ctx, bool ascii, const void *data, size_t num) {
+    auto *out = static_cast<Data *>(ctx);
+    out->ascii = ascii;
+    if (ascii) {
+      auto *chars = static_cast<const char *>(data);
+      out->chars.assign(chars, chars + num);
+    } else {
+      out->chars.assign(static_cast<const char16_t *>(data), num);
+    }
+  };
+  Data data;
+  rt->getStringData(fromAscii, &data, collect);
+  EXPECT_TRUE(data.ascii);
+  EXPECT_EQ(data.chars, std::u16string(1000, u'x'));
+  rt->getStringData(fromUtf8, &data, collect);
+  EXPECT_FALSE(data.ascii);
+  EXPECT_EQ(data.chars, u"caf\u00e9");
+}
+
+TEST_F(HermesRuntimeTest, ExternalArrayBufferTest) {
+  std::vector<uint8_t> storage(64, 1);
+  int releases = 0;
+  {
+    ArrayBuffer buffer = rt->createExternalArrayBuffer(
+        storage.data(), storage.size(), [&releases] { ++releases; });
+    EXPECT_EQ(buffer.size(*rt), 64);
+    EXPECT_EQ(buffer.data(*rt), storage.data());
+    rt->global().setProperty(*rt, "buffer", buffer);
+  }
+  EXPECT_TRUE(eval("var view = new Uint8Array(buffer);"
+                   "view[63] = 42;"
+                   "buffer.byteLength === 64 && view[0] === 1")
+                  .getBool());
+  EXPECT_EQ(storage[63], 42);
+
+  // An empty buffer has nothing to hold on to.
+  rt->createExternalArrayBuffer(nullptr, 0, [&releases] { ++releases; });
+  EXPECT_EQ(releases, 1);
+
+  // The storage is handed back at the latest when the runtime goes away.
+  rt.reset();
+  EXPECT_EQ(releases, 2);
+}
+
+TEST_F(HermesRuntimeTest, BulkPropertiesTest) {
+  PropNameID names[] = {PropNameID::forAscii(*rt, "a"),
+                        PropNameID::forAscii(*rt, "b"),
+                        PropNameID::forAscii(*rt, "0")};
+  Value values[] = {Value(1), String::createFromAscii(*rt, "two"), Value(3)};
+  // The second object reuses the class of the first.
+  Object first = rt->createObjectWithProperties(names, values, 2);
+  values[0] = Value(10);
+  Object second = rt->createObjectWithProperties(names, values, 2);
+  rt->global().setProperty(*rt, "first", first);
+  rt->global().setProperty(*rt, "second", second);
+  EXPECT_EQ(
+      eval("JSON.stringify([first, second])").getString(*rt).utf8(*rt),
+      "[{\"a\":1,\"b\":\"two\"},{\"a\":10,\"b\":\"two\"}]");
+  EXPECT_TRUE(eval("Object.getPrototypeOf(second) === Object.prototype "
+                   "&& Object.getOwnPropertyDescriptor(second, 'a').writable")
+                  .getBool());
+
+  // Repeated and index-like names.
+  PropNameID repeated[] = {PropNameID(*rt, names[0]),
+                           PropNameID(*rt, names[2]),
+                           PropNameID(*rt, names[0])};
+  Object third = rt->createObjectWithProperties(repeated, values, 3);
+  rt->global().setProperty(*rt, "third", third);
+  EXPECT_EQ(
+      eval("JSON.stringify(third)").getString(*rt).utf8(*rt),
+      "{\"0\":\"two\",\"a\":3}");
+
+  Value read[3];
+  rt->getProperties(second, names, read, 3);
+  EXPECT_EQ(read[0].getNumber(), 10);
+  EXPECT_EQ(read[1].getString(*rt).utf8(*rt), "two");
+  EXPECT_TRUE(read[2].isUndefined());
+
+  Value written[] = {Value(true), Value(nullptr), Value(5)};
+  rt->setProperties(second, names, written, 3);
+  EXPECT_EQ(
+      eval("JSON.stringify(second)").getString(*rt).utf8(*rt),
+      "{\"0\":5,\"a\":true,\"b\":null}");
+  // The class of the first object is unchanged.
+  EXPECT_EQ(
+      eval("JSON.stringify(first)").getString(*rt).utf8(*rt),
+      "{\"a\":1,\"b\":\"two\"}");
+}
+
+TEST_F(HermesRuntimeTest, PresizedCreationTest) {
+  Object obj = rt->createObjectWithCapacity(20);
+  for (int i = 0; i < 20; ++i) {
+    obj.setProperty(*rt, ("p" + std::to_string(i)).c_str(), i);
+  }
+  rt->global().setProperty(*rt, "obj", obj);
+  EXPECT_EQ(eval("Object.keys(obj).length + obj.p19").getNumber(), 39);
+
+  std::vector<Value> values;
+  for (int i = 0; i < 10000; ++i) {
+    values.emplace_back(i);
+  }
+  values[1] = String::createFromAscii(*rt, "one");
+  values[2] = Object(*rt);
+  Array arr = rt->createArrayWithElements(values.data(), values.size());
+  EXPECT_EQ(arr.size(*rt), 10000u);
+  rt->global().setProperty(*rt, "arr", arr);
+  EXPECT_TRUE(eval("Array.isArray(arr) && arr[9999] === 9999 && "
+                   "arr[1] === 'one' && typeof arr[2] === 'object'")
+                  .getBool());
+  // The array grows like any other.
+  EXPECT_EQ(eval("arr.push(1)").getNumber(), 10001);
+  EXPECT_EQ(rt->createArrayWithElements(nullptr, 0).size(*rt), 0u);
+}
+
+TEST_F(HermesRuntimeTest, SnapshotToCallbackTest) {
+  eval("var big = []; for (var i = 0; i < 1000; ++i) big.push({i: i});");
+  static constexpr size_t kChunkSize = 256;
+  std::string snapshot;
+  size_t numChunks = 0;
+  rt->createSnapshotToCallback(
+      [&snapshot, &numChunks](const char *data, size_t size) {
+        EXPECT_LE(size, kChunkSize);
+        snapshot.append(data, size);
+        ++numChunks;
+      },
+      true,
+      kChunkSize);
+
+  EXPECT_GT(numChunks, 1u);
+  EXPECT_EQ(0u, snapshot.find("{\"snapshot\""));
+  EXPECT_EQ('}', snapshot.back());
+}
+
+TEST_F(HermesRuntimeTest, ResetToSavedPointTest) {
+  EXPECT_THROW(rt->resetToSavedPoint(), JSError);
+  rt->evaluateJavaScript(
+      std::make_unique<StringBuffer>(
+          "var config = {a: 1};\n"
+          "function render(x) { return 'hi ' + x; }"),
+      "init.js");
+  rt->saveResetPoint();
+
+  // A script's variables are not configurable, but they are deleted too.
+  rt->evaluateJavaScript(
+      std::make_unique<StringBuffer>("var leaked = 1; config = 2;"),
+      "request.js");
+  eval(
+      "Array.prototype.extra = 3;"
+      "Object.defineProperty(this, 'fixed', {value: 4});"
+      "Object.setPrototypeOf(Math, null);"
+      "Object.freeze(Math);"
+      "render = null;"
+      "Promise.resolve().then(function() { late = 5; });");
+  rt->resetToSavedPoint();
+  rt->drainMicrotasks();
+
+  EXPECT_TRUE(eval("typeof leaked === 'undefined' && typeof fixed === "
+                   "'undefined' && typeof late === 'undefined'")
+                  .getBool());
+  EXPECT_EQ(1, eval("config.a").getNumber());
+  EXPECT_TRUE(eval("[].extra === undefined && Object.isExtensible(Math) && "
+                   "Object.getPrototypeOf(Math) === Object.prototype")
+                  .getBool());
+  EXPECT_EQ("hi x", eval("render('x')").getString(*rt).utf8(*rt));
+
+  // The runtime can be reset again.
+  eval("config = 3; gc();");
+  rt->resetToSavedPoint();
+  EXPECT_EQ(1, eval("config.a").getNumber());
+}
+
+TEST(HermesRuntimePoolTest, ReusesRuntimesTest) {
+  int inits = 0;
+  HermesRuntimePool pool(
+      ::hermes::vm::RuntimeConfig(),
+      [&inits](HermesRuntime &rt) {
+        ++inits;
+        rt.evaluateJavaScript(
+            std::make_unique<StringBuffer>("var count = 0;"), "init.js");
+      },
+      1);
+  auto a = pool.acquire();
+  auto b = pool.acquire();
+  EXPECT_EQ(2, inits);
+  a->evaluateJavaScript(std::make_unique<StringBuffer>("++count;"), "a.js");
+  HermesRuntime *aPtr = a.get();
+  pool.release(std::move(a));
+  // The pool is full, so b is destroyed.
+  pool.release(std::move(b));
+  EXPECT_EQ(1u, pool.idleCount());
+
+  auto c = pool.acquire();
+  EXPECT_EQ(aPtr, c.get());
+  EXPECT_EQ(0, c->global().getProperty(*c, "count").getNumber());
+  EXPECT_EQ(2, inits);
+  EXPECT_EQ(0u, pool.idleCount());
+}
+
+TEST(ThreadSafeRuntimeTest, LockScopeTest) {
+  std::unique_ptr<ThreadSafeRuntime> rt = makeThreadSafeHermesRuntime();
+  rt->global().setProperty(*rt, "count", 0);
+  Function increment = rt->global()
+                           .getPropertyAsFunction(*rt, "eval")
+                           .call(*rt, "(function() { return ++count; })")
+                           .getObject(*rt)
+                           .getFunction(*rt);
+
+  auto work = [&rt, &increment] {
+    for (int i = 0; i < 100; ++i) {
+      // Every call takes the lock again while the scope holds it.
+      ThreadSafeRuntimeLock lock(*rt);
+      double before = rt->global().getProperty(*rt, "count").getNumber();
+      double after = increment.call(*rt).getNumber();
+      EXPECT_EQ(after, before + 1);
+    }
+  };
+  std::thread other(work);
+  work();
+  other.join();
+  EXPECT_EQ(rt->global().getProperty(*rt, "count").getNumber(), 200);
+}
+
 } // namespace
@@ -10,6 +10,8 @@
 
 #include "SegmentTestCompile.h"
 
+#include <vector>
+
 using namespace facebook::jsi;
 using namespace facebook::hermes;
 
@@ -52,4 +54,46 @@ TEST(SegmentTest, LoadSegmentTest) {
   ASSERT_EQ(rt->global().getProperty(*rt, "x").getNumber(), 42);
 }
 
+TEST(SegmentTest, SegmentLoaderTest) {
+  std::shared_ptr<HermesRuntime> rt = makeHermesRuntime();
+
+  // The segment of module 1 is only loaded when it is first required, and no
+  // segment defines module 2.
+  std::string mainCode = R"(
+    x = HermesInternal.requireFast(1).x;
+    y = HermesInternal.requireFast(1).x;
+    try {
+      HermesInternal.requireFast(2);
+    } catch (e) {
+      missing = e instanceof TypeError;
+    }
+  )";
+
+  std::string segmentCode = R"(
+    exports.x = 42;
+  )";
+
+  auto code = hermes::genSplitCode(mainCode, segmentCode);
+
+  auto mainBC = std::make_unique<StringBuffer>(std::move(code.first));
+  auto segmentBC = std::make_unique<StringBuffer>(std::move(code.second));
+
+  std::vector<uint32_t> requested;
+  rt->setSegmentLoader(
+      [&requested, &segmentBC](
+          uint32_t moduleID) -> std::unique_ptr<const Buffer> {
+        requested.push_back(moduleID);
+        if (moduleID != 1) {
+          return nullptr;
+        }
+        return std::move(segmentBC);
+      });
+
+  rt->evaluateJavaScript(std::move(mainBC), "main.js");
+  EXPECT_EQ(rt->global().getProperty(*rt, "x").getNumber(), 42);
+  EXPECT_EQ(rt->global().getProperty(*rt, "y").getNumber(), 42);
+  EXPECT_TRUE(rt->global().getProperty(*rt, "missing").getBool());
+  EXPECT_EQ((std::vector<uint32_t>{1, 2}), requested);
+}
+
 } // namespace
@@ -717,6 +717,73 @@ TEST_F(SynthTraceSerializationTest, FullTraceWithDateAndMath) {
   EXPECT_THAT(result, ::testing::MatchesRegex(expected));
 }
 
+TEST_F(SynthTraceSerializationTest, BinaryTraceRoundTrip) {
+  const ::hermes::vm::RuntimeConfig conf;
+  std::unique_ptr<TracingHermesRuntime> rt(
+      makeTracingHermesRuntime(makeHermesRuntime(conf), conf));
+  {
+    auto obj = jsi::Object(*rt);
+    obj.setProperty(*rt, "a", jsi::String::createFromAscii(*rt, "a"));
+    obj.setProperty(*rt, "b", 1.5);
+    obj.setProperty(*rt, "c", -0.0);
+    obj.setProperty(*rt, "a", 123456789);
+    auto arr = jsi::Array(*rt, 2);
+    arr.setValueAtIndex(*rt, 1, obj);
+    ASSERT_TRUE(obj.hasProperty(*rt, "a"));
+  }
+  std::string binary;
+  llvm::raw_string_ostream binaryStream{binary};
+  rt->writeBinaryTrace(binaryStream);
+  binaryStream.flush();
+
+  // Printing the parsed trace as JSON gives back the original.
+  auto result =
+      SynthTrace::parse(llvm::MemoryBuffer::getMemBufferCopy(binary));
+  std::string expected;
+  llvm::raw_string_ostream expectedStream{expected};
+  rt->writeTrace(expectedStream);
+  expectedStream.flush();
+  std::string actual;
+  llvm::raw_string_ostream actualStream{actual};
+  actualStream << SynthTrace::Printable(
+      std::get<0>(result), std::get<2>(result), std::get<1>(result));
+  actualStream.flush();
+  EXPECT_EQ(expected, actual);
+  EXPECT_LT(binary.size(), expected.size());
+}
+
+TEST_F(SynthTraceSerializationTest, StreamedBinaryTrace) {
+  const ::hermes::vm::RuntimeConfig conf;
+  std::unique_ptr<TracingHermesRuntime> rt(
+      makeTracingHermesRuntime(makeHermesRuntime(conf), conf));
+  std::string binary;
+  rt->streamBinaryTrace(std::make_unique<llvm::raw_string_ostream>(binary));
+  SynthTrace::ObjectID globalObjID = rt->getUniqueID(rt->global());
+  SynthTrace::ObjectID objID;
+  {
+    auto obj = jsi::Object(*rt);
+    objID = rt->getUniqueID(obj);
+    obj.setProperty(*rt, "prop", jsi::String::createFromAscii(*rt, "prop"));
+  }
+  // Nothing is kept in memory, and the trace ends with the runtime.
+  EXPECT_EQ(0, rt->trace().records().size());
+  rt.reset();
+
+  auto result =
+      SynthTrace::parse(llvm::MemoryBuffer::getMemBufferCopy(binary));
+  const SynthTrace &parsed = std::get<0>(result);
+  EXPECT_EQ(globalObjID, parsed.globalObjID());
+  ASSERT_EQ(2, parsed.records().size());
+  EXPECT_EQ(
+      SynthTrace::RecordType::CreateObject,
+      parsed.records()[0]->getType());
+  const auto &setProp = dynamic_cast<const SynthTrace::SetPropertyRecord &>(
+      *parsed.records()[1]);
+  EXPECT_EQ(objID, setProp.objID_);
+  EXPECT_EQ("prop", setProp.propName_);
+  EXPECT_EQ("prop", parsed.decodeString(setProp.value_));
+}
+
 struct SynthTraceParseTest : public ::testing::Test {
   std::unique_ptr<llvm::MemoryBuffer> bufFromStr(const std::string &str) {
     llvm::StringRef ref{str.data(), str.size()};
@@ -162,4 +162,65 @@ TEST(DebugInfo, TestGetAddress) {
   EXPECT_EQ(3u, result->functionIndex);
   EXPECT_EQ(2u, result->bytecodeOffset);
 }
+TEST(DebugInfo, TestLargeFunction) {
+  // Functions with many locations are looked up with a binary search.
+  auto dbg = makeGenerator();
+
+  std::vector<Loc> locs;
+  for (uint32_t i = 0; i < 100; ++i) {
+    // Opcode at address 4i is at file1:(i+2),(i%7+1), statement i/3+1.
+    locs.push_back(Loc{4 * i, 1, i + 2, i % 7 + 1, i / 3 + 1});
+  }
+  auto offset1 = dbg.appendSourceLocations(Loc{0, 1, 1, 1, 0}, 0, locs);
+  auto offset2 = dbg.appendSourceLocations(
+      Loc{0, 1, 200, 1, 0}, 1, {Loc{2, 1, 201, 4, 1}});
+
+  DebugInfo info = dbg.serializeWithMove();
+
+  for (uint32_t i = 0; i < 100; ++i) {
+    checkAddress(&info, offset1, 4 * i, 1, i + 2, i % 7 + 1, i / 3 + 1);
+    checkAddress(&info, offset1, 4 * i + 3, 1, i + 2, i % 7 + 1, i / 3 + 1);
+  }
+  checkAddress(&info, offset2, 2, 1, 201, 4, 1);
+
+  OptValue<DebugSearchResult> result;
+  result = info.getAddressForLocation(1, 52, llvm::None);
+  ASSERT_TRUE(result.hasValue());
+  EXPECT_EQ(0u, result->functionIndex);
+  EXPECT_EQ(200u, result->bytecodeOffset);
+
+  result = info.getAddressForLocation(1, 201, 4);
+  ASSERT_TRUE(result.hasValue());
+  EXPECT_EQ(1u, result->functionIndex);
+  EXPECT_EQ(2u, result->bytecodeOffset);
+
+  result = info.getAddressForLocation(1, 52, 1);
+  ASSERT_FALSE(result.hasValue());
+}
+
+TEST(DebugInfo, TestGetAddressFirstOnLine) {
+  // Without a column, the first location of the line in the debug info is
+  // found, even if another one has a smaller column.
+  auto dbg = makeGenerator();
+
+  dbg.appendSourceLocations(
+      Loc{0, 7, 1, 1, 0},
+      2,
+      {
+          Loc{0, 7, 5, 9, 1},
+          Loc{2, 7, 4, 1, 1},
+          Loc{4, 7, 5, 3, 2},
+      });
+
+  DebugInfo info = dbg.serializeWithMove();
+
+  OptValue<DebugSearchResult> result = info.getAddressForLocation(7, 5, llvm::None);
+  ASSERT_TRUE(result.hasValue());
+  EXPECT_EQ(0u, result->bytecodeOffset);
+  EXPECT_EQ(9u, result->column);
+
+  result = info.getAddressForLocation(7, 5, 3);
+  ASSERT_TRUE(result.hasValue());
+  EXPECT_EQ(4u, result->bytecodeOffset);
+}
 } // end anonymous namespace
@@ -643,6 +643,27 @@ TEST(StringStorageTest, DeltaOptimizingModeTest) {
   }
 }
 
+// Enough UTF-16 strings to be packed on their own thread, mixed with ASCII
+// ones, and each looked up by its ID in the resulting table.
+TEST(StringStorageTest, OptimizingManyUTF16Strings) {
+  std::vector<std::string> strings;
+  for (unsigned i = 0; i < 1000; ++i) {
+    strings.push_back("ascii" + to_string(i));
+    strings.push_back("\xE2\x84\xAB" + to_string(i * 7));
+  }
+  std::vector<llvm::StringRef> refs(strings.begin(), strings.end());
+
+  auto table = tableForStrings(refs);
+  std::vector<char> storage = table.acquireStringStorage();
+  std::vector<StringTableEntry> entries = table.acquireStringTable();
+  ASSERT_EQ(refs.size(), entries.size());
+  std::string utf8;
+  for (auto str : refs) {
+    uint32_t id = table.getStringID(str);
+    EXPECT_EQ(str, hbc::getStringFromEntry(entries[id], storage, utf8));
+  }
+}
+
 TEST(PredefinedStringIDTest, NonExistent) {
   EXPECT_FALSE(hbc::getPredefinedStringID("not_a_predefined_string"));
 }
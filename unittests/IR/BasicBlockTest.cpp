@@ -41,4 +41,28 @@ TEST(IRBasicBlockTest, BasicBlockConnectionTest) {
   EXPECT_FALSE(succ_contains(BB1, BB1));
 }
 
+/// Erasing the body of a function removes the uses of the values outside of
+/// it, but keeps the function and its parameters.
+TEST(IRBasicBlockTest, EraseFunctionBodyTest) {
+  auto Ctx = std::make_shared<Context>();
+  Module M(Ctx);
+  IRBuilder Builder(&M);
+  auto F = Builder.createFunction(
+      "main", Function::DefinitionKind::ES5Function, true);
+  auto Arg = Builder.createParameter(F, "arg");
+  auto BB1 = Builder.createBasicBlock(F);
+  auto BB2 = Builder.createBasicBlock(F);
+  Builder.setInsertionBlock(BB1);
+  Builder.createBranchInst(BB2);
+  Builder.setInsertionBlock(BB2);
+  Builder.createReturnInst(Arg);
+  EXPECT_TRUE(Arg->hasUsers());
+
+  F->eraseBody();
+  EXPECT_TRUE(F->empty());
+  EXPECT_FALSE(Arg->hasUsers());
+  EXPECT_EQ(1u, F->getParameters().size());
+  EXPECT_EQ(F, &*M.begin());
+}
+
 } // end anonymous namespace
@@ -341,6 +341,62 @@ TEST(JSLexerTest, IdentifierTest) {
   ASSERT_EQ(TokenKind::eof, lex.advance()->getKind());
 }
 
+TEST(JSLexerTest, LongRunsTest) {
+  JSLexer::Allocator alloc;
+  SourceErrorManager sm;
+  DiagContext diag(sm);
+
+  // Runs longer than the chunks that the lexer may skip at once, followed by
+  // the characters that end them.
+  JSLexer lex(
+      "abcdefghijklmnopqrstuvwxyz_$0123456789 "
+      "abcdefghijklmnopqrstuvwxyz\\u0061\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t ;"
+      "/* a block comment that is long enough **/ ;"
+      "/* a block comment that spans \n two lines */ ;"
+      "// a line comment that is long enough to span chunks\n"
+      "'a string that is long enough to span chunks\\n' "
+      "'a string with a non-ASCII character \xc3\xa9 after a run' "
+      "\"a string with 'the other quote' in the middle\" "
+      "'a string that is not terminated before the end of the line\n"
+      "                                                             ;",
+      sm,
+      alloc);
+
+  LEX_EXPECT_IDENT("abcdefghijklmnopqrstuvwxyz_$0123456789", lex);
+  LEX_EXPECT_IDENT("abcdefghijklmnopqrstuvwxyza", lex);
+  ASSERT_EQ(TokenKind::semi, lex.advance()->getKind());
+
+  ASSERT_EQ(TokenKind::semi, lex.advance()->getKind());
+  ASSERT_FALSE(lex.isNewLineBeforeCurrentToken());
+  ASSERT_EQ(TokenKind::semi, lex.advance()->getKind());
+  ASSERT_TRUE(lex.isNewLineBeforeCurrentToken());
+
+  ASSERT_EQ(TokenKind::string_literal, lex.advance()->getKind());
+  ASSERT_TRUE(lex.isNewLineBeforeCurrentToken());
+  EXPECT_STREQ(
+      "a string that is long enough to span chunks\n",
+      lex.getCurToken()->getStringLiteral()->c_str());
+  ASSERT_EQ(TokenKind::string_literal, lex.advance()->getKind());
+  EXPECT_STREQ(
+      "a string with a non-ASCII character \xc3\xa9 after a run",
+      lex.getCurToken()->getStringLiteral()->c_str());
+  ASSERT_EQ(TokenKind::string_literal, lex.advance()->getKind());
+  EXPECT_STREQ(
+      "a string with 'the other quote' in the middle",
+      lex.getCurToken()->getStringLiteral()->c_str());
+  ASSERT_EQ(0, diag.getErrCountClear());
+
+  ASSERT_EQ(TokenKind::string_literal, lex.advance()->getKind());
+  ASSERT_EQ(1, diag.getErrCountClear());
+  EXPECT_STREQ(
+      "a string that is not terminated before the end of the line",
+      lex.getCurToken()->getStringLiteral()->c_str());
+
+  ASSERT_EQ(TokenKind::semi, lex.advance()->getKind());
+  ASSERT_TRUE(lex.isNewLineBeforeCurrentToken());
+  ASSERT_EQ(TokenKind::eof, lex.advance()->getKind());
+}
+
 TEST(JSLexerTest, StringTest1) {
   JSLexer::Allocator alloc;
   SourceErrorManager sm;
@@ -4,6 +4,7 @@
  * This source code is licensed under the MIT license found in the LICENSE
  * file in the root directory of this source tree.
  */
+#include "hermes/SourceMap/IndexedSourceMap.h"
 #include "hermes/SourceMap/SourceMapGenerator.h"
 #include "hermes/SourceMap/SourceMapParser.h"
 #include "hermes/Support/Base64vlq.h"
@@ -406,6 +407,80 @@ TEST(SourceMap, EmptyLines) {
       *sourceMap, generatedLine, sources, loc(28, sourceIndex, 2, 10));
 }
 
+/// Check that \p indexed has the same locations as \p sourceMap, up to
+/// column \p maxColumn of each line.
+void verifyIndexedSourceMap(
+    SourceMap &sourceMap,
+    IndexedSourceMap &indexed,
+    uint32_t numLines,
+    uint32_t maxColumn) {
+  // Look the lines up backwards, so that the indexed map skips over them.
+  for (uint32_t line = numLines + 1; line > 0; --line) {
+    for (uint32_t column = 1; column <= maxColumn; ++column) {
+      auto expected = sourceMap.getLocationForAddress(line, column);
+      auto actual = indexed.getLocationForAddress(line, column);
+      ASSERT_EQ(expected.hasValue(), actual.hasValue());
+      if (expected.hasValue()) {
+        EXPECT_EQ(expected->fileName, actual->fileName);
+        EXPECT_EQ(expected->line, actual->line);
+        EXPECT_EQ(expected->column, actual->column);
+      }
+    }
+  }
+}
+
+TEST(SourceMap, IndexedLookups) {
+  const char *noRepresentedLocation = R"#({
+    "version": 3,
+    "sources": ["a.js", "b.js"],
+    "mappings": "CACC,E,G;A,A,CCCC;"
+  })#";
+  for (const char *json :
+       {TestMap,
+        TestMapEmptyLines,
+        TestMapNoSourceRoot,
+        noRepresentedLocation}) {
+    std::unique_ptr<SourceMap> sourceMap = SourceMapParser::parse(json);
+    std::unique_ptr<IndexedSourceMap> indexed =
+        SourceMapParser::parseIndexed(json);
+    ASSERT_TRUE(indexed != nullptr);
+    verifyIndexedSourceMap(*sourceMap, *indexed, indexed->getNumLines(), 40);
+
+    // The index read back from the binary format has the same locations.
+    std::string storage;
+    llvm::raw_string_ostream OS(storage);
+    SourceMapParser::parseIndexed(json)->writeIndex(OS);
+    std::unique_ptr<IndexedSourceMap> readBack =
+        IndexedSourceMap::readIndex(OS.str());
+    ASSERT_TRUE(readBack != nullptr);
+    verifyIndexedSourceMap(*sourceMap, *readBack, readBack->getNumLines(), 40);
+  }
+
+  EXPECT_TRUE(SourceMapParser::parseIndexed(InvalidJsonMap) == nullptr);
+  EXPECT_TRUE(IndexedSourceMap::readIndex("HSMI") == nullptr);
+}
+
+/// Malformed lines are only found when looked up or skipped over.
+TEST(SourceMap, IndexedMalformedLines) {
+  std::unique_ptr<IndexedSourceMap> indexed = SourceMapParser::parseIndexed(
+      R"#({
+        "version": 3,
+        "sources": ["a.js"],
+        "mappings": "CACC;!;AAAA"
+      })#");
+  ASSERT_TRUE(indexed != nullptr);
+  EXPECT_EQ(3u, indexed->getNumLines());
+  EXPECT_FALSE(indexed->getLocationForAddress(2, 1).hasValue());
+  // The state at the start of the last line is not known.
+  EXPECT_FALSE(indexed->getLocationForAddress(3, 1).hasValue());
+
+  auto locOpt = indexed->getLocationForAddress(1, 2);
+  ASSERT_TRUE(locOpt.hasValue());
+  EXPECT_EQ("a.js", locOpt->fileName);
+  EXPECT_EQ(2u, locOpt->line);
+  EXPECT_EQ(2u, locOpt->column);
+}
+
 TEST(SourceMap, VLQRandos) {
   // clang-format off
   const std::vector<int32_t> inputs = {0, 1, -1, 2, -2, 5298, -23498,
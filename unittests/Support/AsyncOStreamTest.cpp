@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/Support/AsyncOStream.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+using namespace hermes;
+
+namespace {
+
+TEST(AsyncOStreamTest, SyncWritesEverything) {
+  std::string out;
+  llvm::raw_string_ostream os(out);
+  {
+    // Never wake up on the interval, only when syncing or stopping.
+    AsyncOStream async(os, std::chrono::hours(1));
+    async << "abc" << 123;
+    async.sync();
+    EXPECT_EQ("abc123", out);
+    async << '\n';
+    EXPECT_EQ(7u, async.tell());
+  }
+  EXPECT_EQ("abc123\n", out);
+}
+
+TEST(AsyncOStreamTest, WritesLargeOutputInOrder) {
+  std::string out;
+  llvm::raw_string_ostream os(out);
+  std::string expected;
+  {
+    AsyncOStream async(os, std::chrono::milliseconds(1));
+    for (unsigned i = 0; i < 100000; ++i) {
+      std::string line = std::to_string(i) + "\n";
+      async << line;
+      expected += line;
+    }
+    // Writes bigger than the buffer go straight to the writer.
+    std::string large(3 * AsyncOStream::kWakeSize, 'x');
+    async << large;
+    expected += large;
+  }
+  EXPECT_EQ(expected, out);
+}
+
+} // namespace
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/Support/CallbackOStream.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+using namespace hermes;
+
+namespace {
+
+TEST(CallbackOStreamTest, PassesChunksInOrder) {
+  std::vector<std::string> chunks;
+  {
+    CallbackOStream os(
+        [&chunks](const char *data, size_t size) {
+          chunks.emplace_back(data, size);
+        },
+        4);
+    os << "ab";
+    EXPECT_TRUE(chunks.empty());
+    os << "cdef" << 123;
+  }
+  std::string joined;
+  for (const std::string &chunk : chunks) {
+    EXPECT_LE(chunk.size(), 4u);
+    joined += chunk;
+  }
+  EXPECT_EQ("abcdef123", joined);
+}
+
+TEST(CallbackOStreamTest, SplitsLargeWrites) {
+  std::vector<size_t> sizes;
+  std::string joined;
+  const std::string large(100, 'x');
+  {
+    CallbackOStream os(
+        [&sizes, &joined](const char *data, size_t size) {
+          sizes.push_back(size);
+          joined.append(data, size);
+        },
+        16);
+    os << large;
+    os.flush();
+    EXPECT_EQ(large.size(), os.tell());
+  }
+  EXPECT_EQ(large, joined);
+  for (size_t size : sizes) {
+    EXPECT_LE(size, 16u);
+  }
+}
+
+TEST(CallbackOStreamTest, FlushPassesTheRest) {
+  std::string out;
+  CallbackOStream os(
+      [&out](const char *data, size_t size) { out.append(data, size); });
+  os << "hermes";
+  EXPECT_TRUE(out.empty());
+  os.flush();
+  EXPECT_EQ("hermes", out);
+}
+
+} // namespace
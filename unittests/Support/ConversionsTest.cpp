@@ -6,6 +6,7 @@
  */
 #include "hermes/Support/Conversions.h"
 
+#include <cmath>
 #include <limits>
 
 #include "gtest/gtest.h"
@@ -162,6 +163,65 @@ TEST(ConversionsTest, numberToStringTest) {
   DoubleToStringTest("0", 0);
   DoubleToStringTest("12384", 12384);
   DoubleToStringTest("-12384", -12384);
+
+  // Boundaries of the integer and Grisu3 paths, and numbers where Grisu3 fails
+  // and dtoa is used.
+  DoubleToStringTest("9007199254740991", 9007199254740991.0);
+  DoubleToStringTest("9007199254740992", 9007199254740992.0);
+  DoubleToStringTest("18014398509481984", 18014398509481984.0);
+  DoubleToStringTest("0.1", 0.1);
+  DoubleToStringTest("0.30000000000000004", 0.1 + 0.2);
+  DoubleToStringTest("0.000001", 1e-6);
+  DoubleToStringTest("1e-7", 1e-7);
+  DoubleToStringTest("5e-324", 5e-324);
+  DoubleToStringTest("2.2250738585072014e-308", 2.2250738585072014e-308);
+  DoubleToStringTest("1.7976931348623157e+308", 1.7976931348623157e308);
+  DoubleToStringTest("8.139595609508228e-25", 8.139595609508228e-25);
+  DoubleToStringTest("-2.0755067846079348e+301", -2.0755067846079348e301);
+}
+
+TEST(ConversionsTest, parseDecimalFastTest) {
+  auto parse = [](llvm::StringRef str) {
+    return parseDecimalFast(str.begin(), str.end());
+  };
+
+  EXPECT_EQ(0, *parse("0"));
+  EXPECT_TRUE(std::signbit(*parse("-0")));
+  EXPECT_EQ(123, *parse("+123"));
+  EXPECT_EQ(-1.5, *parse("-1.5"));
+  EXPECT_EQ(0.5, *parse(".5"));
+  EXPECT_EQ(5, *parse("5."));
+  EXPECT_EQ(0.001, *parse("0.001"));
+  EXPECT_EQ(1.5e-10, *parse("15e-11"));
+  EXPECT_EQ(1e30, *parse("1e30"));
+  EXPECT_EQ(123456789012345, *parse("123456789012345"));
+  EXPECT_EQ(0, *parse("0.000e-50"));
+
+  // Literals which need the Eisel-Lemire algorithm.
+  EXPECT_EQ(1234567890123456, *parse("1234567890123456"));
+  EXPECT_EQ(9007199254740992, *parse("9007199254740993"));
+  EXPECT_EQ(1e-23, *parse("1e-23"));
+  EXPECT_EQ(1e23, *parse("1e23"));
+  EXPECT_EQ(12345e40, *parse("12345e40"));
+  EXPECT_EQ(0.1, *parse("0.1000000000000000000"));
+  EXPECT_EQ(-1.7976931348623157e308, *parse("-1.7976931348623157e308"));
+  EXPECT_EQ(2.2250738585072014e-308, *parse("2.2250738585072014e-308"));
+
+  // Literals which need dtoa.
+  EXPECT_FALSE(parse("12345678901234567890").hasValue());
+  EXPECT_FALSE(parse("1e400").hasValue());
+  EXPECT_FALSE(parse("1.7976931348623159e308").hasValue());
+  EXPECT_FALSE(parse("5e-324").hasValue());
+
+  // Invalid literals.
+  EXPECT_FALSE(parse("").hasValue());
+  EXPECT_FALSE(parse("-").hasValue());
+  EXPECT_FALSE(parse(".").hasValue());
+  EXPECT_FALSE(parse("1e").hasValue());
+  EXPECT_FALSE(parse("1e+").hasValue());
+  EXPECT_FALSE(parse("1x").hasValue());
+  EXPECT_FALSE(parse(" 1").hasValue());
+  EXPECT_FALSE(parse("1.2.3").hasValue());
 }
 
 } // end anonymous namespace
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include <gtest/gtest.h>
+
+#include "hermes/Support/StringSearch.h"
+
+#include <string>
+
+namespace {
+
+using namespace hermes;
+
+/// \return the result findSubstring() should have, found with std::string.
+template <typename T>
+size_t expectedFind(
+    const std::basic_string<T> &haystack,
+    const std::basic_string<T> &needle,
+    size_t start) {
+  size_t pos = start <= haystack.size() ? haystack.find(needle, start)
+                                        : std::basic_string<T>::npos;
+  return pos == std::basic_string<T>::npos ? kSubstringNotFound : pos;
+}
+
+/// \return the result findLastSubstring() should have.
+template <typename T>
+size_t expectedFindLast(
+    const std::basic_string<T> &haystack,
+    const std::basic_string<T> &needle,
+    size_t start) {
+  size_t pos = haystack.rfind(needle, start);
+  return pos == std::basic_string<T>::npos ? kSubstringNotFound : pos;
+}
+
+/// Search for every substring of \p haystack, and a few strings that are not
+/// in it, from every start position, in both directions.
+template <typename T>
+void checkAllSearches(const std::basic_string<T> &haystack) {
+  std::vector<std::basic_string<T>> needles;
+  for (size_t len : {0, 1, 2, 3, 7, 16, 17, 31, 32, 40}) {
+    for (size_t pos = 0; pos + len <= haystack.size(); pos += 5)
+      needles.push_back(haystack.substr(pos, len));
+    needles.push_back(std::basic_string<T>(len, T('z')));
+  }
+  for (const auto &needle : needles) {
+    for (size_t start = 0; start <= haystack.size() + 1; ++start) {
+      EXPECT_EQ(
+          expectedFind(haystack, needle, start),
+          findSubstring(
+              llvm::makeArrayRef(haystack.data(), haystack.size()),
+              llvm::makeArrayRef(needle.data(), needle.size()),
+              start))
+          << "needle length " << needle.size() << " start " << start;
+      EXPECT_EQ(
+          expectedFindLast(haystack, needle, start),
+          findLastSubstring(
+              llvm::makeArrayRef(haystack.data(), haystack.size()),
+              llvm::makeArrayRef(needle.data(), needle.size()),
+              start))
+          << "needle length " << needle.size() << " start " << start;
+    }
+  }
+}
+
+/// A haystack with many near matches and runs of repeated characters.
+template <typename T>
+std::basic_string<T> makeHaystack() {
+  std::basic_string<T> str;
+  for (unsigned i = 0; i < 100; ++i) {
+    str.push_back(T('a' + (i * i) % 5));
+    if (i % 9 == 0)
+      str.append(20, T('b'));
+  }
+  return str;
+}
+
+TEST(StringSearchTest, FindASCII) {
+  checkAllSearches(makeHaystack<char>());
+}
+
+TEST(StringSearchTest, FindUTF16) {
+  auto haystack = makeHaystack<char16_t>();
+  // Characters that share their low byte with the ones in the needles.
+  for (size_t i = 3; i < haystack.size(); i += 11)
+    haystack[i] = u'\u0162';
+  checkAllSearches(haystack);
+}
+
+TEST(StringSearchTest, FindLongNeedle) {
+  std::string haystack(1000, 'a');
+  std::string needle(100, 'a');
+  needle.back() = 'b';
+  EXPECT_EQ(
+      kSubstringNotFound,
+      findSubstring(
+          llvm::makeArrayRef(haystack.data(), haystack.size()),
+          llvm::makeArrayRef(needle.data(), needle.size())));
+  haystack.replace(850, needle.size(), needle);
+  EXPECT_EQ(
+      850u,
+      findSubstring(
+          llvm::makeArrayRef(haystack.data(), haystack.size()),
+          llvm::makeArrayRef(needle.data(), needle.size())));
+  EXPECT_EQ(
+      850u,
+      findLastSubstring(
+          llvm::makeArrayRef(haystack.data(), haystack.size()),
+          llvm::makeArrayRef(needle.data(), needle.size())));
+}
+
+TEST(StringSearchTest, Mismatch) {
+  std::string a(70, 'x');
+  std::u16string wide(70, u'x');
+  EXPECT_EQ(70u, findMismatch(a.data(), a.data(), a.size()));
+  EXPECT_EQ(70u, findMismatch(wide.data(), wide.data(), wide.size()));
+  EXPECT_EQ(70u, findMismatch(a.data(), wide.data(), a.size()));
+  for (size_t i : {0, 5, 15, 16, 40, 69}) {
+    std::string b = a;
+    b[i] = 'y';
+    std::u16string wideB = wide;
+    wideB[i] = u'\u0178';
+    EXPECT_EQ(i, findMismatch(a.data(), b.data(), a.size()));
+    EXPECT_EQ(i, findMismatch(wide.data(), wideB.data(), wide.size()));
+    EXPECT_EQ(i, findMismatch(a.data(), wideB.data(), a.size()));
+    EXPECT_EQ(i, findMismatch(b.data(), wide.data(), b.size()));
+  }
+}
+
+TEST(StringSearchTest, JSONEscape) {
+  std::string plain(50, 'x');
+  EXPECT_EQ(50u, findJSONEscape(llvm::makeArrayRef(plain.data(), 50)));
+  for (char c : {'\0', '\n', '\x1f', '"', '\\'}) {
+    for (size_t i : {0, 17, 49}) {
+      std::string str = plain;
+      str[i] = c;
+      EXPECT_EQ(i, findJSONEscape(llvm::makeArrayRef(str.data(), 50)));
+      std::u16string wide(str.begin(), str.end());
+      EXPECT_EQ(i, findJSONEscape(llvm::makeArrayRef(wide.data(), 50)));
+    }
+  }
+  // Characters whose low byte would need escaping don't.
+  std::u16string wide(50, u'\u0122');
+  wide[20] = u'\\';
+  EXPECT_EQ(20u, findJSONEscape(llvm::makeArrayRef(wide.data(), 50)));
+}
+
+TEST(StringSearchTest, Character) {
+  std::string str(50, 'x');
+  str[3] = str[30] = '%';
+  std::u16string wide(str.begin(), str.end());
+  auto ref = llvm::makeArrayRef(str.data(), 50);
+  auto wideRef = llvm::makeArrayRef(wide.data(), 50);
+  EXPECT_EQ(3u, findCharacter(ref, '%'));
+  EXPECT_EQ(30u, findCharacter(ref, '%', 4));
+  EXPECT_EQ(50u, findCharacter(ref, '%', 31));
+  EXPECT_EQ(3u, findCharacter(wideRef, u'%'));
+  EXPECT_EQ(30u, findCharacter(wideRef, u'%', 4));
+  EXPECT_EQ(50u, findCharacter(wideRef, u'%', 31));
+  // Only the whole character matches, not its low byte.
+  wide[10] = u'\u0125';
+  EXPECT_EQ(30u, findCharacter(wideRef, u'%', 4));
+}
+
+TEST(StringSearchTest, NonAlphanumeric) {
+  std::string str;
+  for (int i = 0; i < 3; ++i)
+    str += "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+  auto ref = llvm::makeArrayRef(str.data(), str.size());
+  EXPECT_EQ(str.size(), findNonAlphanumeric(ref));
+  EXPECT_EQ(str.size(), findNonAlphanumeric(ref, 70));
+  // The characters just outside each range.
+  for (char c : {'/', ':', '@', '[', '`', '{', ' ', '-', '\x7f'}) {
+    for (size_t i : {0, 17, 100, 185}) {
+      std::string s = str;
+      s[i] = c;
+      EXPECT_EQ(i, findNonAlphanumeric(llvm::makeArrayRef(s.data(), s.size())));
+      std::u16string wide(s.begin(), s.end());
+      EXPECT_EQ(
+          i, findNonAlphanumeric(llvm::makeArrayRef(wide.data(), wide.size())));
+      EXPECT_EQ(
+          s.size(),
+          findNonAlphanumeric(llvm::makeArrayRef(s.data(), s.size()), i + 1));
+    }
+  }
+  // Characters whose low byte is a letter or digit aren't.
+  std::u16string wide(str.begin(), str.end());
+  wide[40] = u'\u0161';
+  wide[50] = u'\u0130';
+  EXPECT_EQ(40u, findNonAlphanumeric(llvm::makeArrayRef(wide.data(), 186)));
+  EXPECT_EQ(50u, findNonAlphanumeric(llvm::makeArrayRef(wide.data(), 186), 41));
+}
+
+} // namespace
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/Support/XorShift128Plus.h"
+
+#include "gtest/gtest.h"
+
+#include <random>
+
+using namespace hermes;
+
+namespace {
+
+TEST(XorShift128PlusTest, KnownSequence) {
+  // The state is seeded with the SplitMix64 numbers 0xE220A8397B1DCDAF and
+  // 0x6E789E6AA1B965F4.
+  XorShift128Plus engine{0};
+  EXPECT_EQ(UINT64_C(0xFF5E664AA2264AB1), engine.next());
+  EXPECT_EQ(UINT64_C(0x5CB3706844353952), engine.next());
+}
+
+TEST(XorShift128PlusTest, Seed) {
+  XorShift128Plus a{123};
+  XorShift128Plus b{124};
+  uint64_t first = a.next();
+  EXPECT_NE(first, b.next());
+  EXPECT_NE(first, a.next());
+  a.seed(123);
+  EXPECT_EQ(first, a.next());
+}
+
+TEST(XorShift128PlusTest, Doubles) {
+  XorShift128Plus engine{42};
+  double sum = 0;
+  const unsigned count = 10000;
+  for (unsigned i = 0; i < count; ++i) {
+    double d = engine.nextDouble();
+    ASSERT_GE(d, 0.0);
+    ASSERT_LT(d, 1.0);
+    sum += d;
+  }
+  // The mean of uniform numbers in [0, 1) is 0.5, with a standard deviation
+  // of about 0.003 for this many.
+  EXPECT_NEAR(0.5, sum / count, 0.02);
+
+  // It can also be used with the distributions of <random>.
+  std::uniform_int_distribution<int> dist{1, 6};
+  int roll = dist(engine);
+  EXPECT_GE(roll, 1);
+  EXPECT_LE(roll, 6);
+}
+
+} // namespace
@@ -224,6 +224,29 @@ TEST_F(CardTableNCTest, NextDirtyCard) {
   }
 }
 
+TEST_F(CardTableNCTest, NextDirtyCardAfterCleaning) {
+  // Dirty a card in each of two summarized groups, then clean the occupied
+  // cards after a compaction, which must not lose either group.
+  const size_t first = 3 * CardTable::kCardsPerSummaryBit + 5;
+  const size_t second = 70 * CardTable::kCardsPerSummaryBit - 1;
+  table->dirtyCardForAddress(table->indexToAddress(first));
+  table->dirtyCardForAddress(table->indexToAddress(second));
+
+  auto dirty = table->findNextDirtyCard(first + 1, CardTable::kValidIndices);
+  ASSERT_TRUE(dirty);
+  EXPECT_EQ(second, *dirty);
+
+  // Dirty everything below first + 1, and clean everything above it.
+  table->updateAfterCompaction(table->indexToAddress(first + 1));
+  EXPECT_FALSE(table->findNextDirtyCard(first + 1, CardTable::kValidIndices));
+  dirty = table->findNextDirtyCard(first, CardTable::kValidIndices);
+  ASSERT_TRUE(dirty);
+  EXPECT_EQ(first, *dirty);
+
+  table->clear();
+  EXPECT_FALSE(table->findNextDirtyCard(0, CardTable::kValidIndices));
+}
+
 } // namespace
 
 #endif // HERMESVM_GC_NONCONTIG_GENERATIONAL
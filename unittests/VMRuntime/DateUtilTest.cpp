@@ -7,7 +7,9 @@
 #include "TestHelpers.h"
 
 #include "hermes/VM/JSLib/DateUtil.h"
+#include "hermes/VM/JSLib/LocalTimeCache.h"
 
+#include <cmath>
 #include <cstdlib>
 
 using namespace hermes::vm;
@@ -267,6 +269,46 @@ TEST(DateUtilTest, LocalTimeTest) {
   hermes::oscompat::unset_env("TZ");
 }
 
+TEST(DateUtilTest, LocalTimeCacheTest) {
+  LocalTimeCache cache;
+  auto expectSameAsUncached = [&cache]() {
+    // Every 5 hours from 2017 to 2019, backwards to change ranges in both
+    // directions, and a few times outside the cached range.
+    for (double t = 1546300800000; t >= 1483228800000; t -= 5 * MS_PER_HOUR) {
+      EXPECT_EQ(daylightSavingTA(t), cache.daylightSavingTA(t)) << t;
+      EXPECT_EQ(localTime(t), cache.localTime(t)) << t;
+      EXPECT_EQ(utcTime(t), cache.utcTime(t)) << t;
+    }
+    for (double t : {-1e15, -1.5, 0.0, 1e15, 8.64e15}) {
+      EXPECT_EQ(daylightSavingTA(t), cache.daylightSavingTA(t)) << t;
+    }
+    EXPECT_TRUE(std::isnan(cache.daylightSavingTA(std::nan(""))));
+    EXPECT_TRUE(std::isnan(cache.daylightSavingTA(8.64e15 + 1)));
+    EXPECT_EQ(localTZA(), cache.localTZA());
+  };
+
+#ifdef _WINDOWS
+  hermes::oscompat::set_env("TZ", "PST8PDT");
+#else
+  hermes::oscompat::set_env("TZ", "America/Los_Angeles");
+#endif
+  expectSameAsUncached();
+  // The transitions are exact to the second.
+  EXPECT_EQ(0, cache.daylightSavingTA(1520762399000)); // 2018-03-11T09:59:59Z
+  EXPECT_EQ(MS_PER_HOUR, cache.daylightSavingTA(1520762400000));
+
+  // Changing the time zone clears the cache.
+#ifdef _WINDOWS
+  hermes::oscompat::set_env("TZ", "JST-9");
+#else
+  hermes::oscompat::set_env("TZ", "Pacific/Auckland");
+#endif
+  expectSameAsUncached();
+
+  hermes::oscompat::unset_env("TZ");
+  expectSameAsUncached();
+}
+
 TEST(DateUtilTest, HoursMinutesSecondsMsTest) {
   // Uses the formulae from spec, perform sanity check.
   double t = 0;
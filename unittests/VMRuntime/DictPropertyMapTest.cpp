@@ -130,6 +130,48 @@ TEST_F(DictPropertyMapTest, SmokeTest) {
   }
 }
 
+TEST_F(DictPropertyMapTest, ChurnTest) {
+  // An object used as a hash map: properties are repeatedly added and deleted
+  // while others stay. The map must be compacted with enough room to make the
+  // reallocations rare.
+  auto res = DictPropertyMap::create(runtime);
+  ASSERT_RETURNED(res);
+  MutableHandle<DictPropertyMap> map{runtime, res->get()};
+  NamedPropertyDescriptor desc(PropertyFlags{}, 0);
+
+  const unsigned kLive = 100;
+  const unsigned kChurn = 10000;
+  auto addProp = [&](unsigned index) {
+    desc.slot = DictPropertyMap::allocatePropertySlot(*map);
+    return DictPropertyMap::add(
+        map, runtime, SymbolID::unsafeCreate(index), desc);
+  };
+  for (unsigned i = 1; i <= kLive; ++i) {
+    ASSERT_RETURNED(addProp(i));
+  }
+
+  unsigned reallocs = 0;
+  for (unsigned i = kLive + 1; i <= kLive + kChurn; ++i) {
+    auto *before = map.get();
+    ASSERT_RETURNED(addProp(i));
+    if (map.get() != before)
+      ++reallocs;
+    auto found = DictPropertyMap::find(*map, SymbolID::unsafeCreate(i));
+    ASSERT_TRUE(found);
+    DictPropertyMap::erase(*map, *found);
+  }
+  EXPECT_LT(reallocs, kChurn / 20);
+
+  ASSERT_EQ(kLive, map->size());
+  for (unsigned i = 1; i <= kLive + kChurn; ++i) {
+    EXPECT_EQ(
+        i <= kLive,
+        DictPropertyMap::find(*map, SymbolID::unsafeCreate(i)).hasValue());
+  }
+  // The slots of the deleted properties were reused.
+  EXPECT_EQ(kLive, DictPropertyMap::allocatePropertySlot(*map));
+}
+
 TEST_F(DictPropertyMapTest, CreateOverCapacityTest) {
   (void)DictPropertyMap::create(runtime);
   ASSERT_EQ(
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "TestHelpers.h"
+
+#include "hermes/BCGen/HBC/BytecodeDataProvider.h"
+#include "hermes/VM/EvalCache.h"
+#include "hermes/VM/JSLib.h"
+
+using namespace hermes::vm;
+using namespace hermes::hbc;
+
+namespace {
+
+/// A runtime whose eval cache can hold \p maxBytes.
+class EvalCacheTest : public RuntimeTestFixtureBase {
+ public:
+  EvalCacheTest(size_t maxBytes = 1 << 20)
+      : RuntimeTestFixtureBase(RuntimeConfig::Builder()
+                                   .withGCConfig(kTestGCConfig)
+                                   .withEvalCacheBytes(maxBytes)
+                                   .build()) {}
+
+ protected:
+  /// Compile \p source with \p scopeChain, which must succeed.
+  std::shared_ptr<BCProvider> compile(
+      llvm::StringRef source,
+      bool singleFunction = false,
+      const hermes::ScopeChain &scopeChain = {}) {
+    auto res = compileEvalSource(runtime, source, scopeChain, singleFunction);
+    EXPECT_EQ(ExecutionStatus::RETURNED, res.getStatus());
+    return res == ExecutionStatus::RETURNED ? *res : nullptr;
+  }
+};
+
+class DisabledEvalCacheTest : public EvalCacheTest {
+ public:
+  DisabledEvalCacheTest() : EvalCacheTest(0) {}
+};
+
+TEST_F(EvalCacheTest, ReusesBytecodeOfSameSource) {
+  auto first = compile("1 + 2");
+  ASSERT_NE(nullptr, first);
+  EXPECT_EQ(first, compile("1 + 2"));
+  EXPECT_NE(first, compile("1 + 3"));
+  EXPECT_EQ(2u, runtime->getEvalCache().size());
+
+  // Requiring a single function compiles the source differently.
+  auto function = compile("(function () {})", true);
+  EXPECT_NE(function, compile("(function () {})", false));
+  EXPECT_EQ(function, compile("(function () {})", true));
+
+  // The cached bytecode can be run again.
+  auto res = runtime->runBytecode(
+      compile("1 + 2"),
+      RuntimeModuleFlags{},
+      "",
+      runtime->makeNullHandle<Environment>());
+  ASSERT_EQ(ExecutionStatus::RETURNED, res.getStatus());
+  EXPECT_EQ(3, res->getNumber());
+}
+
+TEST_F(EvalCacheTest, SyntaxErrorsAreNotCached) {
+  auto res = compileEvalSource(runtime, "1 +", {}, false);
+  EXPECT_EQ(ExecutionStatus::EXCEPTION, res.getStatus());
+  runtime->clearThrownValue();
+  EXPECT_EQ(0u, runtime->getEvalCache().size());
+}
+
+TEST_F(EvalCacheTest, VisibleVariablesAreNotCached) {
+  hermes::ScopeChain scopeChain{};
+  scopeChain.functions.emplace_back();
+  scopeChain.functions.back().variables.push_back("x");
+  EXPECT_NE(compile("x", false, scopeChain), compile("x", false, scopeChain));
+
+  // A local eval which sees no variables is cached separately from a global
+  // one.
+  hermes::ScopeChain emptyScopeChain{};
+  emptyScopeChain.functions.emplace_back();
+  auto local = compile("x", false, emptyScopeChain);
+  EXPECT_EQ(local, compile("x", false, emptyScopeChain));
+  EXPECT_NE(local, compile("x"));
+}
+
+TEST_F(EvalCacheTest, ClearedOnMemoryPressure) {
+  compile("1 + 2");
+  EXPECT_EQ(1u, runtime->getEvalCache().size());
+  runtime->handleMemoryPressure(MemoryPressure::Moderate);
+  EXPECT_EQ(0u, runtime->getEvalCache().size());
+}
+
+TEST_F(DisabledEvalCacheTest, NothingIsCached) {
+  EXPECT_NE(compile("1 + 2"), compile("1 + 2"));
+  EXPECT_EQ(0u, runtime->getEvalCache().size());
+}
+
+TEST_F(DisabledEvalCacheTest, EvictsLeastRecentlyUsed) {
+  auto a = compile("a");
+  auto b = compile("b");
+  auto c = compile("c");
+  EvalCache cache{100};
+  cache.insert("a", 0, a, 40);
+  cache.insert("b", 0, b, 40);
+  EXPECT_EQ(82u, cache.getSizeInBytes());
+  // Using "a" keeps it in the cache when "c" needs room.
+  EXPECT_EQ(a, cache.find("a", 0));
+  cache.insert("c", 0, c, 40);
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_EQ(82u, cache.getSizeInBytes());
+  EXPECT_EQ(a, cache.find("a", 0));
+  EXPECT_EQ(nullptr, cache.find("b", 0));
+  EXPECT_EQ(c, cache.find("c", 0));
+  EXPECT_EQ(nullptr, cache.find("c", 1));
+
+  // Inserting an existing key replaces its entry.
+  cache.insert("c", 0, b, 10);
+  EXPECT_EQ(b, cache.find("c", 0));
+  EXPECT_EQ(52u, cache.getSizeInBytes());
+
+  // An entry larger than the budget is not cached.
+  cache.insert("d", 0, a, 100);
+  EXPECT_EQ(nullptr, cache.find("d", 0));
+  EXPECT_EQ(2u, cache.size());
+
+  cache.clear();
+  EXPECT_EQ(0u, cache.size());
+  EXPECT_EQ(0u, cache.getSizeInBytes());
+}
+
+} // namespace
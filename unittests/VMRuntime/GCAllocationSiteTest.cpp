@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "gtest/gtest.h"
+
+#include "Array.h"
+#include "TestHelpers.h"
+#include "hermes/VM/AlignedHeapSegment.h"
+#include "hermes/VM/AllocationSite.h"
+#include "hermes/VM/BuildMetadata.h"
+#include "hermes/VM/GC.h"
+
+using namespace hermes::vm;
+using namespace hermes::unittest;
+
+namespace hermes {
+namespace vm {
+template <>
+struct IsGCObject<Array> : public std::true_type {};
+} // namespace vm
+} // namespace hermes
+
+namespace {
+
+/// Record kNumSamples fates for \p site, of which \p numSurvived survive.
+void sample(AllocationSite &site, unsigned numSurvived) {
+  for (unsigned i = 0; i < AllocationSite::kNumSamples; ++i) {
+    ASSERT_TRUE(site.wantsSample());
+  }
+  EXPECT_FALSE(site.wantsSample());
+  for (unsigned i = 0; i < AllocationSite::kNumSamples; ++i) {
+    site.recordFate(i < numSurvived);
+  }
+}
+
+TEST(GCAllocationSiteTest, PretenureWhenMostSurvive) {
+  AllocationSite site;
+  EXPECT_FALSE(site.isPretenured());
+  sample(site, AllocationSite::kNumSamples);
+  EXPECT_TRUE(site.isPretenured());
+  // The decision is final.
+  EXPECT_FALSE(site.wantsSample());
+}
+
+TEST(GCAllocationSiteTest, StayYoungWhenManyDie) {
+  AllocationSite site;
+  sample(
+      site,
+      AllocationSite::kNumSamples * AllocationSite::kPretenureSurvivalPct /
+              100 -
+          1);
+  EXPECT_FALSE(site.isPretenured());
+  EXPECT_FALSE(site.wantsSample());
+}
+
+TEST(GCAllocationSiteTest, DroppedSamplesAreTakenAgain) {
+  AllocationSite site;
+  ASSERT_TRUE(site.wantsSample());
+  site.dropSample();
+  sample(site, AllocationSite::kNumSamples);
+  EXPECT_TRUE(site.isPretenured());
+}
+
+#ifdef HERMESVM_GC_NONCONTIG_GENERATIONAL
+
+MetadataTableForTests getMetadataTable() {
+  static const Metadata storage[] = {
+      Metadata(), // Uninitialized
+      buildMetadata(
+          CellKind::FillerCellKind, ::hermes::unittest::ArrayBuildMeta)};
+  return MetadataTableForTests(storage);
+}
+
+TEST(GCAllocationSiteTest, YoungGenRecordsFates) {
+  static constexpr gcheapsize_t kHeapSize =
+      AlignedHeapSegment::maxSize() * GC::kYoungGenFractionDenom;
+  auto runtime = DummyRuntime::create(
+      getMetadataTable(), TestGCConfigFixedSize(kHeapSize));
+  DummyRuntime &rt = *runtime;
+  auto &gc = rt.gc;
+
+  GCCell *table = Array::create(rt, AllocationSite::kNumSamples);
+  rt.pointerRoots.push_back(&table);
+
+  // The objects of one site are kept alive, those of the other are not.
+  AllocationSite liveSite;
+  AllocationSite deadSite;
+  for (unsigned i = 0; i < AllocationSite::kNumSamples; ++i) {
+    Array *live = Array::create(rt, 4);
+    gc.trackAllocationSite(live, &liveSite);
+    vmcast<Array>(table)->values()[i].set(
+        HermesValue::encodeObjectValue(live), &gc);
+    gc.trackAllocationSite(Array::create(rt, 4), &deadSite);
+  }
+  EXPECT_FALSE(liveSite.isPretenured());
+
+  // Fill the young gen until it is collected.
+  static constexpr unsigned kGarbageLength = 256;
+  const unsigned numGarbage =
+      AlignedHeapSegment::maxSize() * 2 / Array::allocSize(kGarbageLength);
+  for (unsigned i = 0; i < numGarbage; ++i) {
+    Array::create(rt, kGarbageLength);
+  }
+
+  EXPECT_TRUE(liveSite.isPretenured());
+  EXPECT_FALSE(deadSite.isPretenured());
+  EXPECT_FALSE(deadSite.wantsSample());
+}
+
+#endif // HERMESVM_GC_NONCONTIG_GENERATIONAL
+
+} // namespace
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifdef HERMESVM_GC_NONCONTIG_GENERATIONAL
+
+#include "gtest/gtest.h"
+
+#include "Array.h"
+#include "TestHelpers.h"
+#include "hermes/VM/AlignedHeapSegment.h"
+#include "hermes/VM/BuildMetadata.h"
+#include "hermes/VM/GC.h"
+
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace hermes::vm;
+using namespace hermes::unittest;
+
+namespace hermes {
+namespace vm {
+template <>
+struct IsGCObject<Array> : public std::true_type {};
+} // namespace vm
+} // namespace hermes
+
+namespace {
+
+MetadataTableForTests getMetadataTable() {
+  static const Metadata storage[] = {
+      Metadata(), // Uninitialized
+      buildMetadata(
+          CellKind::FillerCellKind, ::hermes::unittest::ArrayBuildMeta)};
+  return MetadataTableForTests(storage);
+}
+
+constexpr gcheapsize_t kHeapSize =
+    AlignedHeapSegment::maxSize() * GC::kYoungGenFractionDenom;
+
+bool hasPhase(const GCCycleEvent &event, llvm::StringRef name) {
+  return std::any_of(
+      event.phases.begin(),
+      event.phases.end(),
+      [name](const std::pair<const char *, double> &phase) {
+        return name == phase.first;
+      });
+}
+
+struct GCCycleEventNCTest : public ::testing::Test {
+  GCCycleEventNCTest()
+      : runtime(DummyRuntime::create(
+            getMetadataTable(),
+            TestGCConfigFixedSize(
+                kHeapSize,
+                GCConfig::Builder(kTestGCConfigBuilder)
+                    .withCycleEventCallback(
+                        [this](const GCCycleEvent &event) {
+                          events.push_back(event);
+                        })))),
+        rt(*runtime) {}
+
+  std::vector<GCCycleEvent> events;
+  std::shared_ptr<DummyRuntime> runtime;
+  DummyRuntime &rt;
+};
+
+TEST_F(GCCycleEventNCTest, YoungCollectionFromAllocation) {
+  static constexpr unsigned kLength = 256;
+  GCCell *live = Array::create(rt, kLength);
+  rt.pointerRoots.push_back(&live);
+
+  // Fill the young gen with garbage until it is collected.
+  const unsigned numGarbage =
+      AlignedHeapSegment::maxSize() * 2 / Array::allocSize(kLength);
+  for (unsigned i = 0; i < numGarbage && events.empty(); ++i) {
+    Array::create(rt, kLength);
+  }
+
+  ASSERT_EQ(1u, events.size());
+  const GCCycleEvent &event = events[0];
+  EXPECT_STREQ("young", event.kind);
+  EXPECT_STREQ("allocation", event.cause);
+  EXPECT_GT(event.allocatedBefore, event.allocatedAfter);
+  EXPECT_GE(event.promotedBytes, Array::allocSize(kLength));
+  EXPECT_GE(event.wallTime, 0.0);
+  EXPECT_TRUE(hasPhase(event, "markRoots"));
+  EXPECT_TRUE(hasPhase(event, "scanTransitive"));
+  EXPECT_TRUE(hasPhase(event, "finalizers"));
+}
+
+TEST_F(GCCycleEventNCTest, ExplicitFullCollection) {
+  Array::create(rt, 16);
+  rt.gc.collect();
+
+  ASSERT_EQ(1u, events.size());
+  const GCCycleEvent &event = events[0];
+  EXPECT_STREQ("full", event.kind);
+  EXPECT_STREQ("explicit", event.cause);
+  EXPECT_EQ(0u, event.promotedBytes);
+  EXPECT_TRUE(hasPhase(event, "markRoots"));
+  EXPECT_TRUE(hasPhase(event, "sweep"));
+  EXPECT_TRUE(hasPhase(event, "updateReferences"));
+  EXPECT_TRUE(hasPhase(event, "compact"));
+
+#ifndef NDEBUG
+  rt.gc.youngGenCollect();
+  ASSERT_EQ(2u, events.size());
+  EXPECT_STREQ("young", events[1].kind);
+  EXPECT_STREQ("explicit", events[1].cause);
+#endif
+}
+
+TEST(GCCycleEventNCStatsTest, PrintedWithStats) {
+  auto runtime = DummyRuntime::create(
+      getMetadataTable(),
+      TestGCConfigFixedSize(
+          kHeapSize,
+          GCConfig::Builder(kTestGCConfigBuilder).withShouldRecordStats(true)));
+  DummyRuntime &rt = *runtime;
+  rt.gc.collect();
+
+  std::string stats;
+  llvm::raw_string_ostream os(stats);
+  rt.gc.printAllCollectedStats(os);
+  os.flush();
+  EXPECT_NE(std::string::npos, stats.find("\"collections\": [\n"));
+  EXPECT_NE(
+      std::string::npos,
+      stats.find("{\"kind\": \"full\", \"cause\": \"explicit\""));
+}
+
+} // namespace
+
+#endif // HERMESVM_GC_NONCONTIG_GENERATIONAL
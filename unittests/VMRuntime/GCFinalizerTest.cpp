@@ -12,6 +12,7 @@
 #include "hermes/VM/Handle.h"
 #include "hermes/VM/HermesValueTraits.h"
 
+#include <chrono>
 #include <vector>
 
 using namespace hermes::vm;
@@ -46,6 +47,25 @@ struct FinalizerCell final : public GCCell {
       : GCCell(gc, &vt), numFinalized(numFinalized) {}
 };
 
+/// A cell whose finalizer defers its work until after the collection.
+struct DeferringFinalizerCell final : public GCCell {
+  static const VTable vt;
+  int *numReleased;
+
+  static void finalize(GCCell *cell, GC *gc) {
+    int *numReleased = static_cast<DeferringFinalizerCell *>(cell)->numReleased;
+    gc->deferFinalization([numReleased]() { ++*numReleased; });
+  }
+
+  static DeferringFinalizerCell *create(DummyRuntime &runtime, int *released) {
+    return new (runtime.allocWithFinalizer(sizeof(DeferringFinalizerCell)))
+        DeferringFinalizerCell(&runtime.getHeap(), released);
+  }
+
+  DeferringFinalizerCell(GC *gc, int *numReleased)
+      : GCCell(gc, &vt), numReleased(numReleased) {}
+};
+
 struct DummyCell final : public GCCell {
   static const VTable vt;
 
@@ -60,6 +80,10 @@ const VTable FinalizerCell::vt{CellKind::FillerCellKind,
                                sizeof(FinalizerCell),
                                FinalizerCell::finalize};
 
+const VTable DeferringFinalizerCell::vt{CellKind::FillerCellKind,
+                                        sizeof(DeferringFinalizerCell),
+                                        DeferringFinalizerCell::finalize};
+
 const VTable DummyCell::vt{CellKind::UninitializedKind, sizeof(DummyCell)};
 
 MetadataTableForTests getMetadataTable() {
@@ -119,6 +143,41 @@ TEST(GCFinalizerTest, MultipleCollect) {
   ASSERT_EQ(3, finalized);
 }
 
+TEST(GCFinalizerTest, DeferredFinalization) {
+  int released = 0;
+  {
+    auto runtime = DummyRuntime::create(getMetadataTable(), kTestGCConfigSmall);
+    DummyRuntime &rt = *runtime;
+    auto &gc = rt.gc;
+
+    DeferringFinalizerCell::create(rt, &released);
+    gc.collect();
+    // Without idle time, the release is done before the collection returns.
+    ASSERT_EQ(1, released);
+
+#ifdef HERMESVM_GC_NONCONTIG_GENERATIONAL
+    // Once there is idle time, the release is left for it.
+    gc.collectIncrementally(std::chrono::steady_clock::now());
+    DeferringFinalizerCell::create(rt, &released);
+    gc.collect();
+    ASSERT_EQ(1, released);
+    EXPECT_FALSE(gc.collectIncrementally(
+        std::chrono::steady_clock::now() + std::chrono::seconds(1)));
+    ASSERT_EQ(2, released);
+
+    // Whatever is left is released when the runtime is destroyed.
+    DeferringFinalizerCell::create(rt, &released);
+    gc.collect();
+    ASSERT_EQ(2, released);
+#else
+    DeferringFinalizerCell::create(rt, &released);
+    DeferringFinalizerCell::create(rt, &released);
+    gc.collect();
+#endif
+  }
+  ASSERT_EQ(3, released);
+}
+
 TEST(GCFinalizerTest, FinalizeAllOnRuntimeDestructDummyRuntime) {
   int finalized = 0;
   {
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifdef HERMESVM_GC_NONCONTIG_GENERATIONAL
+
+#include "gtest/gtest.h"
+
+#include "Array.h"
+#include "TestHelpers.h"
+#include "hermes/VM/AlignedHeapSegment.h"
+#include "hermes/VM/BuildMetadata.h"
+#include "hermes/VM/GC.h"
+
+using namespace hermes::vm;
+using namespace hermes::unittest;
+
+namespace hermes {
+namespace vm {
+template <>
+struct IsGCObject<Array> : public std::true_type {};
+} // namespace vm
+} // namespace hermes
+
+namespace {
+
+MetadataTableForTests getMetadataTable() {
+  static const Metadata storage[] = {
+      Metadata(), // Uninitialized
+      buildMetadata(
+          CellKind::FillerCellKind, ::hermes::unittest::ArrayBuildMeta)};
+  return MetadataTableForTests(storage);
+}
+
+constexpr gcheapsize_t kHeapSize =
+    AlignedHeapSegment::maxSize() * GC::kYoungGenFractionDenom;
+
+struct GCHeapVerificationNCTest : public ::testing::Test {
+  GCHeapVerificationNCTest()
+      : runtime(DummyRuntime::create(
+            getMetadataTable(),
+            TestGCConfigFixedSize(
+                kHeapSize,
+                GCConfig::Builder(kTestGCConfigBuilder)
+                    .withHeapVerificationInterval(1)))),
+        rt(*runtime) {}
+
+  std::shared_ptr<DummyRuntime> runtime;
+  DummyRuntime &rt;
+};
+
+TEST_F(GCHeapVerificationNCTest, WellFormedHeapPasses) {
+  GCCell *outer = Array::create(rt, 4);
+  rt.pointerRoots.push_back(&outer);
+  for (unsigned i = 0; i < 4; ++i) {
+    GCCell *inner = Array::create(rt, 8);
+    vmcast<Array>(outer)->values()[i].set(
+        HermesValue::encodeObjectValue(inner), &rt.getHeap());
+  }
+
+  // Every collection verifies a segment.
+  rt.gc.collect();
+  rt.gc.collect();
+  rt.gc.verifyRandomSegment();
+}
+
+TEST_F(GCHeapVerificationNCTest, CorruptPointerIsFatal) {
+  GCCell *live = Array::create(rt, 4);
+  rt.pointerRoots.push_back(&live);
+  // Move the array to the old generation, leaving the young one empty, so
+  // that its segment is the only one to verify.
+  rt.gc.collect();
+
+  static uint64_t notACell[4];
+  EXPECT_DEATH(
+      {
+        vmcast<Array>(live)->values()[0].set(
+            HermesValue::encodeObjectValue(notACell), &rt.getHeap());
+        rt.gc.verifyRandomSegment();
+      },
+      "Heap verification failed");
+}
+
+} // namespace
+
+#endif // HERMESVM_GC_NONCONTIG_GENERATIONAL
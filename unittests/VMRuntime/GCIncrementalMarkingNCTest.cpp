@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifdef HERMESVM_GC_NONCONTIG_GENERATIONAL
+#include "gtest/gtest.h"
+
+#include "Array.h"
+#include "TestHelpers.h"
+#include "hermes/VM/AlignedHeapSegment.h"
+#include "hermes/VM/ArrayStorage.h"
+#include "hermes/VM/BuildMetadata.h"
+#include "hermes/VM/DictPropertyMap.h"
+#include "hermes/VM/GC.h"
+#include "hermes/VM/IdentifierTable.h"
+#include "hermes/VM/StringRefUtils.h"
+#include "hermes/VM/StringView.h"
+
+#include <chrono>
+#include <utility>
+#include <vector>
+
+using namespace hermes::vm;
+using namespace hermes::unittest;
+
+namespace hermes {
+namespace vm {
+template <>
+struct IsGCObject<Array> : public std::true_type {};
+} // namespace vm
+} // namespace hermes
+
+namespace {
+
+MetadataTableForTests getMetadataTable() {
+  static const Metadata storage[] = {
+      Metadata(), // Uninitialized
+      buildMetadata(
+          CellKind::FillerCellKind, ::hermes::unittest::ArrayBuildMeta)};
+  return MetadataTableForTests(storage);
+}
+
+Array *arrayAt(Array *array, unsigned i) {
+  return vmcast<Array>(array->values()[i]);
+}
+
+TEST(GCIncrementalMarkingNCTest, MutateWhileMarking) {
+  // A young gen of one segment, and an old gen of seven.
+  static constexpr gcheapsize_t kHeapSize =
+      AlignedHeapSegment::maxSize() * GC::kYoungGenFractionDenom;
+  static constexpr gcheapsize_t kOGSize =
+      kHeapSize - AlignedHeapSegment::maxSize();
+
+  const GCConfig config = TestGCConfigFixedSize(
+      kHeapSize,
+      GCConfig::Builder(kTestGCConfigBuilder).withIncrementalMarking(true));
+  auto runtime = DummyRuntime::create(getMetadataTable(), config);
+  DummyRuntime &rt = *runtime;
+  auto &gc = rt.gc;
+
+  static constexpr unsigned kLeafLength = 1024;
+  const unsigned kLeafSize = Array::allocSize(kLeafLength);
+  // The leaves are live throughout, and fill some 40% of the old gen.
+  const unsigned numLeaves = kOGSize * 2 / 5 / kLeafSize;
+  // Short-lived objects are kept alive by the ring, which holds about half a
+  // young gen's worth, so that they are promoted before they die.
+  const unsigned ringLength = AlignedHeapSegment::maxSize() / 2 / kLeafSize;
+
+  GCCell *table = Array::create(rt, numLeaves);
+  rt.pointerRoots.push_back(&table);
+  GCCell *ring = Array::create(rt, ringLength);
+  rt.pointerRoots.push_back(&ring);
+
+  // Leaf i holds i, and a child that holds i.
+  std::vector<unsigned> expected;
+  for (unsigned i = 0; i < numLeaves; ++i) {
+    Array *leaf = Array::create(rt, kLeafLength);
+    leaf->values()[0].setNonPtr(HermesValue::encodeNumberValue(i));
+    vmcast<Array>(table)->values()[i].set(
+        HermesValue::encodeObjectValue(leaf), &gc);
+    Array *child = Array::create(rt, 1);
+    child->values()[0].setNonPtr(HermesValue::encodeNumberValue(i));
+    arrayAt(vmcast<Array>(table), i)
+        ->values()[1]
+        .set(HermesValue::encodeObjectValue(child), &gc);
+    expected.push_back(i);
+  }
+
+  const unsigned iterations = AlignedHeapSegment::maxSize() / kLeafSize * 40;
+  for (unsigned iter = 0; iter < iterations; ++iter) {
+    Array *garbage = Array::create(rt, kLeafLength);
+    vmcast<Array>(ring)->values()[iter % ringLength].set(
+        HermesValue::encodeObjectValue(garbage), &gc);
+
+    // Move leaves between parts of the table that the marking may or may not
+    // have visited yet.  Each leaf is only referenced from the table.
+    unsigned i = (iter * 7919u) % numLeaves;
+    unsigned j = ((iter + 1) * 104729u) % numLeaves;
+    auto *tableArray = vmcast<Array>(table);
+    HermesValue tmp = tableArray->values()[i];
+    tableArray->values()[i].set(tableArray->values()[j], &gc);
+    tableArray->values()[j].set(tmp, &gc);
+    std::swap(expected[i], expected[j]);
+  }
+
+  EXPECT_LT(0u, gc.numIncrementalFullGCs());
+
+  for (unsigned i = 0; i < numLeaves; ++i) {
+    Array *leaf = arrayAt(vmcast<Array>(table), i);
+    EXPECT_EQ(expected[i], leaf->values()[0].getNumber());
+    EXPECT_EQ(expected[i], arrayAt(leaf, 1)->values()[0].getNumber());
+  }
+
+  // A full collection, possibly in the middle of a cycle, marks from scratch.
+  gc.collect();
+  EXPECT_FALSE(gc.isOldGenMarkingActive());
+  for (unsigned i = 0; i < numLeaves; ++i) {
+    Array *leaf = arrayAt(vmcast<Array>(table), i);
+    EXPECT_EQ(expected[i], leaf->values()[0].getNumber());
+    EXPECT_EQ(expected[i], arrayAt(leaf, 1)->values()[0].getNumber());
+  }
+}
+
+TEST(GCIncrementalMarkingNCTest, CollectIncrementally) {
+  static constexpr gcheapsize_t kHeapSize =
+      AlignedHeapSegment::maxSize() * GC::kYoungGenFractionDenom;
+  static constexpr gcheapsize_t kOGSize =
+      kHeapSize - AlignedHeapSegment::maxSize();
+
+  const GCConfig config = TestGCConfigFixedSize(
+      kHeapSize,
+      GCConfig::Builder(kTestGCConfigBuilder).withIncrementalMarking(true));
+  auto runtime = DummyRuntime::create(getMetadataTable(), config);
+  DummyRuntime &rt = *runtime;
+  auto &gc = rt.gc;
+
+  // Enough live leaves to start a marking cycle once they are promoted.
+  static constexpr unsigned kLeafLength = 1024;
+  const unsigned kLeafSize = Array::allocSize(kLeafLength);
+  const unsigned numLeaves = kOGSize * 4 / 5 / kLeafSize;
+  GCCell *table = Array::create(rt, numLeaves);
+  rt.pointerRoots.push_back(&table);
+  for (unsigned i = 0; i < numLeaves; ++i) {
+    Array *leaf = Array::create(rt, kLeafLength);
+    leaf->values()[0].setNonPtr(HermesValue::encodeNumberValue(i));
+    vmcast<Array>(table)->values()[i].set(
+        HermesValue::encodeObjectValue(leaf), &gc);
+  }
+
+  // Nothing is done once the deadline has passed.
+  const size_t numGCsBefore = gc.numGCs();
+  gc.collectIncrementally(std::chrono::steady_clock::now());
+  EXPECT_EQ(numGCsBefore, gc.numGCs());
+
+  // Idle periods between bursts of allocation collect the young gen, and
+  // start, advance, and finish a marking cycle.
+  const unsigned burst = AlignedHeapSegment::maxSize() / 8 / kLeafSize;
+  for (unsigned round = 0; round < 64 && gc.numIncrementalFullGCs() == 0;
+       ++round) {
+    for (unsigned i = 0; i < burst; ++i) {
+      Array::create(rt, kLeafLength);
+    }
+    gc.collectIncrementally(
+        std::chrono::steady_clock::now() + std::chrono::seconds(10));
+  }
+  EXPECT_LT(0u, gc.numIncrementalFullGCs());
+
+  for (unsigned i = 0; i < numLeaves; ++i) {
+    EXPECT_EQ(i, arrayAt(vmcast<Array>(table), i)->values()[0].getNumber());
+  }
+}
+
+/// Runs the phases of a marking cycle one at a time, so that symbols can be
+/// stored into the heap between them.
+class GCIncrementalMarkingSymbolsNCTest : public RuntimeTestFixtureBase {
+ public:
+  GCIncrementalMarkingSymbolsNCTest()
+      : RuntimeTestFixtureBase(
+            RuntimeConfig::Builder()
+                .withGCConfig(GCConfig::Builder(kTestGCConfigBuilder)
+                                  .withInitHeapSize(kInitHeapLarge)
+                                  .withMaxHeapSize(kMaxHeapLarge)
+                                  .withIncrementalMarking(true)
+                                  .build())
+                .build()) {}
+
+ protected:
+  /// \return a new symbol named \p name, which nothing references.
+  SymbolID createUnreferencedSymbol(const char *name) {
+    GCScopeMarkerRAII marker{runtime};
+    auto res = runtime->getIdentifierTable().getSymbolHandle(
+        runtime, createASCIIRef(name));
+    EXPECT_NE(ExecutionStatus::EXCEPTION, res.getStatus());
+    return res->get();
+  }
+
+  /// \return true if \p symbol is still named \p name, and its index is not
+  /// given to a new symbol.
+  bool symbolIsLive(SymbolID symbol, const char *name) {
+    SymbolID fresh = createUnreferencedSymbol("markingTestFresh");
+    StringView view =
+        runtime->getIdentifierTable().getStringView(runtime, symbol);
+    return fresh.unsafeGetIndex() != symbol.unsafeGetIndex() &&
+        view.equals(createASCIIRef(name));
+  }
+};
+
+TEST_F(GCIncrementalMarkingSymbolsNCTest, SymbolStoredIntoScannedObject) {
+  auto &gc = runtime->getHeap();
+  auto res = ArrayStorage::create(runtime, 1, 1);
+  ASSERT_RETURNED(res.getStatus());
+  Handle<ArrayStorage> storage =
+      runtime->makeHandle(vmcast<ArrayStorage>(*res));
+  SymbolID symbol = createUnreferencedSymbol("markingTestScanned");
+
+  const size_t numIncrementalBefore = gc.numIncrementalFullGCs();
+  gc.startOldGenMarkingForTesting();
+  gc.advanceOldGenMarkingForTesting();
+  // The storage has been visited, so only the write barrier can mark the
+  // symbol.
+  storage->at(0).set(HermesValue::encodeSymbolValue(symbol), &gc);
+  gc.finishOldGenMarkingForTesting();
+
+  EXPECT_EQ(numIncrementalBefore + 1, gc.numIncrementalFullGCs());
+  EXPECT_TRUE(symbolIsLive(symbol, "markingTestScanned"));
+}
+
+TEST_F(GCIncrementalMarkingSymbolsNCTest, SymbolAddedAsDictPropertyMapKey) {
+  auto &gc = runtime->getHeap();
+  // Big enough that adding the key does not reallocate the map into the young
+  // generation.
+  auto res = DictPropertyMap::create(runtime, 4);
+  ASSERT_RETURNED(res.getStatus());
+  MutableHandle<DictPropertyMap> map{runtime, res->get()};
+  SymbolID symbol = createUnreferencedSymbol("markingTestKey");
+
+  const size_t numIncrementalBefore = gc.numIncrementalFullGCs();
+  gc.startOldGenMarkingForTesting();
+  gc.advanceOldGenMarkingForTesting();
+  DictPropertyMap *before = map.get();
+  ASSERT_RETURNED(
+      DictPropertyMap::add(map, runtime, symbol, NamedPropertyDescriptor{}));
+  ASSERT_EQ(before, map.get());
+  gc.finishOldGenMarkingForTesting();
+
+  EXPECT_EQ(numIncrementalBefore + 1, gc.numIncrementalFullGCs());
+  EXPECT_TRUE(symbolIsLive(symbol, "markingTestKey"));
+  EXPECT_TRUE(DictPropertyMap::find(*map, symbol));
+}
+
+TEST_F(GCIncrementalMarkingSymbolsNCTest, UnreferencedSymbolIsFreed) {
+  auto &gc = runtime->getHeap();
+  // Free the garbage symbols of the runtime's initialization, so that the
+  // only one freed by the cycle is ours.
+  gc.collect();
+  SymbolID symbol = createUnreferencedSymbol("markingTestUnreferenced");
+
+  const size_t numIncrementalBefore = gc.numIncrementalFullGCs();
+  gc.startOldGenMarkingForTesting();
+  gc.advanceOldGenMarkingForTesting();
+  gc.finishOldGenMarkingForTesting();
+
+  EXPECT_EQ(numIncrementalBefore + 1, gc.numIncrementalFullGCs());
+  // Its slot is the first to be reused.
+  EXPECT_EQ(
+      symbol.unsafeGetIndex(),
+      createUnreferencedSymbol("markingTestFresh").unsafeGetIndex());
+}
+
+} // namespace
+
+#endif // HERMESVM_GC_NONCONTIG_GENERATIONAL
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifdef HERMESVM_GC_NONCONTIG_GENERATIONAL
+
+#include "gtest/gtest.h"
+
+#include "Array.h"
+#include "LogSuccessStorageProvider.h"
+#include "TestHelpers.h"
+#include "hermes/VM/AlignedHeapSegment.h"
+#include "hermes/VM/BuildMetadata.h"
+#include "hermes/VM/GC.h"
+
+using namespace hermes::vm;
+using namespace hermes::unittest;
+
+namespace hermes {
+namespace vm {
+template <>
+struct IsGCObject<Array> : public std::true_type {};
+} // namespace vm
+} // namespace hermes
+
+namespace {
+
+MetadataTableForTests getMetadataTable() {
+  static const Metadata storage[] = {
+      Metadata(), // Uninitialized
+      buildMetadata(
+          CellKind::FillerCellKind, ::hermes::unittest::ArrayBuildMeta)};
+  return MetadataTableForTests(storage);
+}
+
+constexpr gcheapsize_t kHeapSize =
+    AlignedHeapSegment::maxSize() * GC::kYoungGenFractionDenom;
+
+/// Arrays of at least this length are large objects.
+constexpr unsigned kLargeLength = 16 * 1024;
+
+/// The length of the arrays that share segments.
+constexpr unsigned kSmallLength = 16;
+
+struct GCLargeObjectNCTest : public ::testing::Test {
+  GCLargeObjectNCTest()
+      : config(TestGCConfigFixedSize(
+            kHeapSize,
+            GCConfig::Builder(kTestGCConfigBuilder)
+                .withLargeObjectThreshold(Array::allocSize(kLargeLength)))),
+        provider(std::make_shared<LogSuccessStorageProvider>(
+            DummyRuntime::defaultProvider(config))),
+        runtime(DummyRuntime::create(getMetadataTable(), config, provider)),
+        rt(*runtime) {}
+
+  const GCConfig config;
+  std::shared_ptr<LogSuccessStorageProvider> provider;
+  std::shared_ptr<DummyRuntime> runtime;
+  DummyRuntime &rt;
+};
+
+TEST_F(GCLargeObjectNCTest, NotMovedByCompaction) {
+  // Garbage below the arrays, so that compaction moves the small one.
+  Array::create(rt, kSmallLength);
+  GCCell *small = Array::create(rt, kSmallLength);
+  rt.pointerRoots.push_back(&small);
+  GCCell *large = Array::create(rt, kLargeLength);
+  rt.pointerRoots.push_back(&large);
+  EXPECT_FALSE(AlignedHeapSegment::containedInSame(small, large));
+
+  vmcast<Array>(large)->values()[0].set(
+      HermesValue::encodeObjectValue(small), &rt.gc);
+  vmcast<Array>(small)->values()[0].set(
+      HermesValue::encodeNumberValue(42), &rt.gc);
+
+  const GCCell *smallBefore = small;
+  const GCCell *largeBefore = large;
+  rt.gc.collect();
+
+  EXPECT_NE(smallBefore, small);
+  EXPECT_EQ(largeBefore, large);
+  Array *largeArr = vmcast<Array>(large);
+  EXPECT_EQ(small, largeArr->values()[0].getPointer());
+  EXPECT_EQ(42, vmcast<Array>(small)->values()[0].getNumber());
+  for (unsigned i = 1; i < kLargeLength; ++i) {
+    ASSERT_TRUE(largeArr->values()[i].isEmpty());
+  }
+}
+
+TEST_F(GCLargeObjectNCTest, YoungGenPointersAreScanned) {
+  GCCell *large = Array::create(rt, kLargeLength);
+  rt.pointerRoots.push_back(&large);
+
+  // The young array is only reachable from the large one.
+  Array *young = Array::create(rt, kSmallLength);
+  young->values()[0].set(HermesValue::encodeNumberValue(42), &rt.gc);
+  vmcast<Array>(large)->values()[kLargeLength - 1].set(
+      HermesValue::encodeObjectValue(young), &rt.gc);
+
+  // Fill the young gen until it is collected.
+  static constexpr unsigned kGarbageLength = 256;
+  const unsigned numGarbage =
+      AlignedHeapSegment::maxSize() * 2 / Array::allocSize(kGarbageLength);
+  for (unsigned i = 0; i < numGarbage; ++i) {
+    Array::create(rt, kGarbageLength);
+  }
+
+  auto *promoted = vmcast<Array>(static_cast<GCCell *>(
+      vmcast<Array>(large)->values()[kLargeLength - 1].getPointer()));
+  EXPECT_NE(young, promoted);
+  EXPECT_EQ(42, promoted->values()[0].getNumber());
+}
+
+TEST_F(GCLargeObjectNCTest, DeadSegmentsAreReleased) {
+  const size_t numLiveBefore = provider->numLive();
+  GCCell *large = Array::create(rt, kLargeLength);
+  rt.pointerRoots.push_back(&large);
+  EXPECT_EQ(numLiveBefore + 1, provider->numLive());
+
+  // A live large object keeps its segment.
+  rt.gc.collect();
+  EXPECT_EQ(numLiveBefore + 1, provider->numLive());
+
+  rt.pointerRoots.clear();
+  rt.gc.collect();
+  EXPECT_EQ(numLiveBefore, provider->numLive());
+}
+
+TEST_F(GCLargeObjectNCTest, SmallObjectsShareSegments) {
+  GCCell *first = Array::create(rt, kSmallLength);
+  rt.pointerRoots.push_back(&first);
+  GCCell *second = Array::create(rt, kLargeLength - 1);
+  rt.pointerRoots.push_back(&second);
+  EXPECT_TRUE(AlignedHeapSegment::containedInSame(first, second));
+}
+
+} // namespace
+
+#endif // HERMESVM_GC_NONCONTIG_GENERATIONAL
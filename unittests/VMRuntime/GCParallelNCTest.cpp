@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifdef HERMESVM_GC_NONCONTIG_GENERATIONAL
+#include "gtest/gtest.h"
+
+#include "Array.h"
+#include "TestHelpers.h"
+#include "hermes/VM/AlignedHeapSegment.h"
+#include "hermes/VM/BuildMetadata.h"
+#include "hermes/VM/GC.h"
+
+using namespace hermes::vm;
+using namespace hermes::unittest;
+
+namespace hermes {
+namespace vm {
+template <>
+struct IsGCObject<Array> : public std::true_type {};
+} // namespace vm
+} // namespace hermes
+
+namespace {
+
+MetadataTableForTests getMetadataTable() {
+  static const Metadata storage[] = {
+      Metadata(), // Uninitialized
+      buildMetadata(
+          CellKind::FillerCellKind, ::hermes::unittest::ArrayBuildMeta)};
+  return MetadataTableForTests(storage);
+}
+
+Array *arrayAt(Array *array, unsigned i) {
+  return vmcast<Array>(array->values()[i]);
+}
+
+TEST(GCParallelNCTest, CollectWithThreads) {
+  static constexpr gcheapsize_t kHeapSize =
+      AlignedHeapSegment::maxSize() * GC::kYoungGenFractionDenom;
+
+  const GCConfig config = TestGCConfigFixedSize(
+      kHeapSize, GCConfig::Builder(kTestGCConfigBuilder).withNumGCThreads(4));
+  auto runtime = DummyRuntime::create(getMetadataTable(), config);
+  DummyRuntime &rt = *runtime;
+  auto &gc = rt.gc;
+
+  // Enough nodes to span several old-gen segments, so that there is work to
+  // share between the threads in both phases.
+  static constexpr unsigned kNodeLength = 256;
+  const unsigned numNodes =
+      AlignedHeapSegment::maxSize() * 3 / Array::allocSize(kNodeLength);
+
+  GCCell *table = Array::create(rt, numNodes);
+  rt.pointerRoots.push_back(&table);
+
+  // Node i holds i, and references node (i * 7) % numNodes, so that most nodes
+  // are reachable along several paths.  Garbage is interleaved with them.
+  for (unsigned i = 0; i < numNodes; ++i) {
+    Array *node = Array::create(rt, kNodeLength);
+    node->values()[0].setNonPtr(HermesValue::encodeNumberValue(i));
+    vmcast<Array>(table)->values()[i].set(
+        HermesValue::encodeObjectValue(node), &gc);
+    Array::create(rt, kNodeLength);
+  }
+  for (unsigned i = 0; i < numNodes; ++i) {
+    auto *tableArray = vmcast<Array>(table);
+    arrayAt(tableArray, i)->values()[1].set(
+        tableArray->values()[(i * 7) % numNodes], &gc);
+  }
+
+  for (unsigned round = 0; round < 2; ++round) {
+    gc.collect();
+    auto *tableArray = vmcast<Array>(table);
+    for (unsigned i = 0; i < numNodes; ++i) {
+      Array *node = arrayAt(tableArray, i);
+      EXPECT_EQ(i, node->values()[0].getNumber());
+      EXPECT_EQ((i * 7) % numNodes, arrayAt(node, 1)->values()[0].getNumber());
+    }
+  }
+}
+
+TEST(GCParallelNCTest, YoungGenWithThreads) {
+  static constexpr gcheapsize_t kHeapSize =
+      AlignedHeapSegment::maxSize() * GC::kYoungGenFractionDenom;
+
+  const GCConfig config = TestGCConfigFixedSize(
+      kHeapSize, GCConfig::Builder(kTestGCConfigBuilder).withNumGCThreads(4));
+  auto runtime = DummyRuntime::create(getMetadataTable(), config);
+  DummyRuntime &rt = *runtime;
+  auto &gc = rt.gc;
+
+  static constexpr unsigned kNodeLength = 16;
+  static constexpr unsigned kNumNodes = 1024;
+  GCCell *table = Array::create(rt, kNumNodes);
+  rt.pointerRoots.push_back(&table);
+  // Move the table to the old gen, so that the nodes are only reachable from
+  // the young gen through its cards.
+  gc.collect();
+
+  // Each round replaces the nodes with young ones, referencing each other as
+  // in CollectWithThreads, with enough garbage between them to trigger
+  // several young-gen collections along the way.
+  for (unsigned round = 0; round < 4; ++round) {
+    for (unsigned i = 0; i < kNumNodes; ++i) {
+      Array *node = Array::create(rt, kNodeLength);
+      node->values()[0].setNonPtr(HermesValue::encodeNumberValue(round + i));
+      vmcast<Array>(table)->values()[i].set(
+          HermesValue::encodeObjectValue(node), &gc);
+      for (unsigned j = 0; j < 4; ++j) {
+        Array::create(rt, kNodeLength * 16);
+      }
+    }
+    for (unsigned i = 0; i < kNumNodes; ++i) {
+      auto *tableArray = vmcast<Array>(table);
+      arrayAt(tableArray, i)->values()[1].set(
+          tableArray->values()[(i * 7) % kNumNodes], &gc);
+      Array::create(rt, kNodeLength * 16);
+    }
+
+    auto *tableArray = vmcast<Array>(table);
+    for (unsigned i = 0; i < kNumNodes; ++i) {
+      Array *node = arrayAt(tableArray, i);
+      EXPECT_EQ(round + i, node->values()[0].getNumber());
+      EXPECT_EQ(
+          round + (i * 7) % kNumNodes,
+          arrayAt(node, 1)->values()[0].getNumber());
+    }
+  }
+}
+
+} // namespace
+
+#endif // HERMESVM_GC_NONCONTIG_GENERATIONAL
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifdef HERMESVM_GC_NONCONTIG_GENERATIONAL
+
+#include "gtest/gtest.h"
+
+#include "TestHelpers.h"
+#include "hermes/VM/GC.h"
+#include "hermes/VM/JSObject.h"
+
+using namespace hermes::vm;
+
+namespace {
+
+using GCRuntimeInitNCTest = RuntimeTestFixture;
+
+TEST_F(GCRuntimeInitNCTest, InitialHeapInOldGen) {
+  GC &gc = runtime->getHeap();
+  EXPECT_FALSE(gc.inYoungGen(runtime->getGlobal().get()));
+  EXPECT_FALSE(gc.inYoungGen(vmcast<JSObject>(runtime->objectPrototype)));
+
+  // Allocation reverts to the young gen once the runtime is initialized.
+  Handle<JSObject> obj = toHandle(runtime, JSObject::create(runtime));
+  EXPECT_TRUE(gc.inYoungGen(obj.get()));
+}
+
+TEST(GCRuntimeInitNCTest, StaysInOldGenIfConfigured) {
+  auto rt = Runtime::create(
+      RuntimeConfig::Builder()
+          .withGCConfig(GCConfig::Builder(kTestGCConfigBuilder)
+                            .withInitHeapSize(kInitHeapSize)
+                            .withMaxHeapSize(kMaxHeapSize)
+                            .withAllocInYoung(false)
+                            .build())
+          .build());
+  Runtime *runtime = rt.get();
+  GCScope scope{runtime};
+  Handle<JSObject> obj = toHandle(runtime, JSObject::create(runtime));
+  EXPECT_FALSE(runtime->getHeap().inYoungGen(obj.get()));
+}
+
+} // namespace
+
+#endif // HERMESVM_GC_NONCONTIG_GENERATIONAL
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#ifdef HERMESVM_GC_NONCONTIG_GENERATIONAL
+
+#include "gtest/gtest.h"
+
+#include "EmptyCell.h"
+#include "LogSuccessStorageProvider.h"
+#include "TestHelpers.h"
+#include "hermes/VM/AlignedHeapSegment.h"
+#include "hermes/VM/GC.h"
+
+#include <chrono>
+#include <deque>
+
+using namespace hermes;
+using namespace hermes::vm;
+
+namespace {
+
+const MetadataTableForTests getMetadataTable() {
+  static const Metadata storage[] = {
+      Metadata() // Uninitialized
+  };
+  return MetadataTableForTests(storage);
+}
+
+constexpr size_t kHeapSize =
+    AlignedHeapSegment::maxSize() * GC::kYoungGenFractionDenom;
+
+using SegmentCell = EmptyCell<
+    AlignedHeapSegment::maxSize(),
+    /* FixedSize */ true>;
+
+/// The number of old-gen segments that the test fills, and then frees.
+constexpr size_t kNumSegments = 3;
+
+struct GCSegmentRetentionNCTest : public ::testing::Test {
+  /// Create a runtime that caches the old-gen segments it stops using for \p
+  /// retention, fill kNumSegments of them, and free them with a full
+  /// collection.
+  void fillThenFree(std::chrono::milliseconds retention) {
+    const GCConfig config = TestGCConfigFixedSize(
+        kHeapSize,
+        GCConfig::Builder(kTestGCConfigBuilder)
+            .withShouldReleaseUnused(false)
+            .withUnusedSegmentRetention(retention));
+    provider = std::make_shared<LogSuccessStorageProvider>(
+        DummyRuntime::defaultProvider(config));
+    runtime = DummyRuntime::create(getMetadataTable(), config, provider);
+    DummyRuntime &rt = *runtime;
+
+    std::deque<GCCell *> roots;
+    for (size_t i = 0; i < kNumSegments; ++i) {
+      roots.push_back(SegmentCell::createLongLived(rt));
+      rt.pointerRoots.push_back(&roots.back());
+    }
+    numLiveWhenFull = provider->numLive();
+
+    rt.pointerRoots.clear();
+    rt.gc.collect();
+  }
+
+  std::shared_ptr<LogSuccessStorageProvider> provider;
+  std::shared_ptr<DummyRuntime> runtime;
+  size_t numLiveWhenFull{0};
+};
+
+TEST_F(GCSegmentRetentionNCTest, KeptUntilMemoryPressure) {
+  fillThenFree(std::chrono::milliseconds::max());
+  // Only the first segment is still used, the others are cached.
+  EXPECT_EQ(numLiveWhenFull, provider->numLive());
+
+  runtime->gc.handleMemoryPressure(MemoryPressure::Moderate);
+  EXPECT_EQ(numLiveWhenFull - (kNumSegments - 1), provider->numLive());
+}
+
+TEST_F(GCSegmentRetentionNCTest, ReleasedAfterRetention) {
+  fillThenFree(std::chrono::milliseconds(0));
+  EXPECT_EQ(numLiveWhenFull - (kNumSegments - 1), provider->numLive());
+}
+
+TEST_F(GCSegmentRetentionNCTest, CriticalPressureCollects) {
+  fillThenFree(std::chrono::milliseconds::max());
+  DummyRuntime &rt = *runtime;
+  const size_t numFullGCs = rt.gc.numFullGCs();
+
+  rt.gc.handleMemoryPressure(MemoryPressure::Critical);
+  EXPECT_EQ(numFullGCs + 1, rt.gc.numFullGCs());
+  EXPECT_EQ(numLiveWhenFull - (kNumSegments - 1), provider->numLive());
+}
+
+} // namespace
+
+#endif // HERMESVM_GC_NONCONTIG_GENERATIONAL
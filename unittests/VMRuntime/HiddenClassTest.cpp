@@ -400,4 +400,185 @@ TEST_F(HiddenClassTest, UpdatePropertyFlagsWithoutTransitionsTest) {
   ASSERT_NE(*addRes->first, *partlyFrozenSingleton);
   ASSERT_EQ(addRes->first->getNumProperties(), 4);
 }
+
+TEST_F(HiddenClassTest, TransitionMapTest) {
+  GCScope gcScope{runtime, "HiddenClassTest.TransitionMapTest", 128};
+  auto rootHnd = runtime->makeHandle<HiddenClass>(
+      runtime->ignoreAllocationFailure(HiddenClass::createRoot(runtime)));
+  auto flags = PropertyFlags::defaultNewNamedPropertyFlags();
+
+  // Add enough transitions to the root to use every representation, checking
+  // that the previous ones are still found.
+  const unsigned kNumChildren = 20;
+  std::vector<Handle<SymbolID>> names;
+  std::vector<Handle<HiddenClass>> children;
+  for (unsigned i = 0; i < kNumChildren; ++i) {
+    std::string name = "p" + std::to_string(i);
+    names.push_back(*runtime->getIdentifierTable().getSymbolHandle(
+        runtime, createASCIIRef(name.c_str())));
+    auto addRes = HiddenClass::addProperty(rootHnd, runtime, *names[i], flags);
+    ASSERT_RETURNED(addRes);
+    children.push_back(addRes->first);
+    runtime->collect();
+    for (unsigned j = 0; j <= i; ++j) {
+      GCScopeMarkerRAII marker{runtime};
+      addRes = HiddenClass::addProperty(rootHnd, runtime, *names[j], flags);
+      ASSERT_RETURNED(addRes);
+      EXPECT_EQ(*children[j], *addRes->first);
+    }
+  }
+  EXPECT_FALSE(rootHnd->isKnownLeaf());
+
+  // Transitions to collected children are dropped.
+  for (unsigned numChildren : {1, 3}) {
+    auto parent = runtime->makeHandle<HiddenClass>(
+        runtime->ignoreAllocationFailure(HiddenClass::createRoot(runtime)));
+    {
+      GCScopeMarkerRAII marker{runtime};
+      for (unsigned i = 0; i < numChildren; ++i)
+        ASSERT_RETURNED(
+            HiddenClass::addProperty(parent, runtime, *names[i], flags));
+    }
+    EXPECT_FALSE(parent->isKnownLeaf());
+    runtime->collect();
+    EXPECT_TRUE(parent->isKnownLeaf());
+  }
+}
+
+TEST_F(HiddenClassTest, UnusedPropertyMapTest) {
+  GCScope gcScope{runtime, "HiddenClassTest.UnusedPropertyMapTest", 48};
+  auto aHnd = *runtime->getIdentifierTable().getSymbolHandle(
+      runtime, createUTF16Ref(u"a"));
+  auto bHnd = *runtime->getIdentifierTable().getSymbolHandle(
+      runtime, createUTF16Ref(u"b"));
+  auto rootHnd = runtime->makeHandle<HiddenClass>(
+      runtime->ignoreAllocationFailure(HiddenClass::createRoot(runtime)));
+  auto flags = PropertyFlags::defaultNewNamedPropertyFlags();
+
+  // Create the classes {a} and {a, b}, and look up a property of the
+  // intermediate class, which gives it a property map.
+  auto addRes = HiddenClass::addProperty(rootHnd, runtime, *aHnd, flags);
+  ASSERT_RETURNED(addRes);
+  auto aClass = addRes->first;
+  addRes = HiddenClass::addProperty(aClass, runtime, *bHnd, flags);
+  ASSERT_RETURNED(addRes);
+  auto abClass = addRes->first;
+  NamedPropertyDescriptor desc;
+  ASSERT_TRUE(HiddenClass::findProperty(
+      aClass, runtime, *aHnd, PropertyFlags::invalid(), desc));
+
+  // The map is freed by the collections and rebuilt on demand.
+  for (unsigned i = 0; i < 3; ++i) {
+    runtime->collect();
+    auto found = HiddenClass::findProperty(
+        aClass, runtime, *aHnd, PropertyFlags::invalid(), desc);
+    ASSERT_TRUE(found);
+    EXPECT_EQ(0u, desc.slot);
+    EXPECT_FALSE(HiddenClass::findProperty(
+        aClass, runtime, *bHnd, PropertyFlags::invalid(), desc));
+    runtime->collect();
+    runtime->collect();
+  }
+  ASSERT_TRUE(HiddenClass::findProperty(
+      abClass, runtime, *bHnd, PropertyFlags::invalid(), desc));
+  EXPECT_EQ(1u, desc.slot);
+
+  // The transition is still found without a map.
+  addRes = HiddenClass::addProperty(aClass, runtime, *bHnd, flags);
+  ASSERT_RETURNED(addRes);
+  EXPECT_EQ(*abClass, *addRes->first);
+}
+
+TEST_F(HiddenClassTest, MaxDescendantPropertiesTest) {
+  GCScope gcScope{runtime, "HiddenClassTest.MaxDescendantPropertiesTest", 48};
+  auto rootHnd = runtime->makeHandle<HiddenClass>(
+      runtime->ignoreAllocationFailure(HiddenClass::createRoot(runtime)));
+  auto flags = PropertyFlags::defaultNewNamedPropertyFlags();
+  EXPECT_EQ(0u, rootHnd->getMaxDescendantProperties());
+
+  // Build the classes {p0}, {p0, p1}, ... {p0, ..., p9}.
+  MutableHandle<HiddenClass> cur{runtime, *rootHnd};
+  MutableHandle<HiddenClass> third{runtime};
+  for (unsigned i = 0; i < 10; ++i) {
+    GCScopeMarkerRAII marker{runtime};
+    std::string name = "p" + std::to_string(i);
+    auto sym = runtime->getIdentifierTable().getSymbolHandle(
+        runtime, createASCIIRef(name.c_str()));
+    ASSERT_RETURNED(sym.getStatus());
+    auto addRes = HiddenClass::addProperty(cur, runtime, **sym, flags);
+    ASSERT_RETURNED(addRes);
+    cur = *addRes->first;
+    if (i == 2)
+      third = *cur;
+  }
+  EXPECT_EQ(10u, rootHnd->getMaxDescendantProperties());
+  EXPECT_EQ(10u, third->getMaxDescendantProperties());
+  EXPECT_EQ(10u, cur->getMaxDescendantProperties());
+
+  // A shorter branch doesn't change the ancestors.
+  auto xHnd = *runtime->getIdentifierTable().getSymbolHandle(
+      runtime, createUTF16Ref(u"x"));
+  auto addRes = HiddenClass::addProperty(third, runtime, *xHnd, flags);
+  ASSERT_RETURNED(addRes);
+  EXPECT_EQ(4u, addRes->first->getMaxDescendantProperties());
+  EXPECT_EQ(10u, third->getMaxDescendantProperties());
+}
+
+TEST_F(HiddenClassTest, CacheableDictionaryTest) {
+  GCScope gcScope{runtime, "HiddenClassTest.CacheableDictionaryTest", 48};
+  auto aHnd = *runtime->getIdentifierTable().getSymbolHandle(
+      runtime, createUTF16Ref(u"a"));
+  auto bHnd = *runtime->getIdentifierTable().getSymbolHandle(
+      runtime, createUTF16Ref(u"b"));
+  auto flags = PropertyFlags::defaultNewNamedPropertyFlags();
+  NamedPropertyDescriptor desc;
+
+  auto rootHnd = runtime->makeHandle<HiddenClass>(
+      runtime->ignoreAllocationFailure(HiddenClass::createRoot(runtime)));
+  MutableHandle<HiddenClass> x{
+      runtime, *HiddenClass::makeCacheableDictionary(rootHnd, runtime)};
+  ASSERT_NE(*rootHnd, *x);
+  ASSERT_TRUE(x->isDictionary());
+  ASSERT_TRUE(x->isCacheable());
+
+  // Adding properties keeps the class.
+  auto addRes = HiddenClass::addProperty(x, runtime, *aHnd, flags);
+  ASSERT_RETURNED(addRes);
+  ASSERT_EQ(*x, *addRes->first);
+  addRes = HiddenClass::addProperty(x, runtime, *bHnd, flags);
+  ASSERT_RETURNED(addRes);
+  ASSERT_EQ(*x, *addRes->first);
+  ASSERT_EQ(1u, addRes->second);
+
+  // Updating the flags of a property replaces the class.
+  auto found = HiddenClass::findProperty(
+      x, runtime, *bHnd, PropertyFlags::invalid(), desc);
+  ASSERT_TRUE(found);
+  PropertyFlags readOnly = desc.flags;
+  readOnly.writable = 0;
+  auto x1 = HiddenClass::updateProperty(x, runtime, *found, readOnly);
+  ASSERT_NE(*x, *x1);
+  ASSERT_TRUE(x1->isCacheable());
+  found = HiddenClass::findProperty(
+      x1, runtime, *bHnd, PropertyFlags::invalid(), desc);
+  ASSERT_TRUE(found);
+  ASSERT_EQ(1u, desc.slot);
+  ASSERT_FALSE(desc.flags.writable);
+  // Unless they don't change.
+  ASSERT_EQ(*x1, *HiddenClass::updateProperty(x1, runtime, *found, readOnly));
+  x = *x1;
+
+  // Deleting a property replaces the class.
+  found = HiddenClass::findProperty(
+      x, runtime, *aHnd, PropertyFlags::invalid(), desc);
+  ASSERT_TRUE(found);
+  auto x2 = HiddenClass::deleteProperty(x, runtime, *found);
+  ASSERT_NE(*x, *x2);
+  ASSERT_TRUE(x2->isCacheable());
+  ASSERT_EQ(1u, x2->getNumProperties());
+  found = HiddenClass::findProperty(
+      x2, runtime, *bHnd, PropertyFlags::invalid(), desc);
+  ASSERT_TRUE(found);
+  ASSERT_EQ(1u, desc.slot);
+}
 } // namespace
@@ -5,6 +5,7 @@
  * file in the root directory of this source tree.
  */
 #include "hermes/VM/IdentifierTable.h"
+#include "hermes/BCGen/HBC/BytecodeProviderFromSrc.h"
 #include "hermes/Support/UTF8.h"
 #include "hermes/VM/StringPrimitive.h"
 #include "hermes/VM/StringRefUtils.h"
@@ -14,6 +15,7 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <iterator>
 #include <sstream>
 #include <string>
@@ -198,4 +200,34 @@ TEST_F(IdentifierTableTest, ConsecutiveIncreasingSymbolIDAlloc) {
   }
 }
 
+using IdentifierTableLazyModuleTest = RuntimeTestFixture;
+
+TEST_F(IdentifierTableLazyModuleTest, RegisteredOnFirstUse) {
+  IdentifierTable &table = runtime->getIdentifierTable();
+  auto isRegistered = [&table](llvm::StringRef name) {
+    bool found = false;
+    table.visitIdentifiers([&found, name](UTF16Ref str, uint32_t) {
+      found |= std::equal(str.begin(), str.end(), name.begin(), name.end());
+    });
+    return found;
+  };
+
+  // The property names are only used by a function that has not run yet.
+  ASSERT_EQ(
+      ExecutionStatus::RETURNED,
+      runtime->run(
+          "function f(o) { return o.lazyIdA + o.lazyIdB; }",
+          "source/url",
+          hbc::CompileFlags{}));
+  EXPECT_FALSE(isRegistered("lazyIdA"));
+  EXPECT_FALSE(isRegistered("lazyIdB"));
+
+  auto res = runtime->run(
+      "f({lazyIdA: 1, lazyIdB: 2})", "source/url", hbc::CompileFlags{});
+  ASSERT_EQ(ExecutionStatus::RETURNED, res.getStatus());
+  EXPECT_EQ(3, res->getNumber());
+  EXPECT_TRUE(isRegistered("lazyIdA"));
+  EXPECT_TRUE(isRegistered("lazyIdB"));
+}
+
 } // namespace
@@ -57,9 +57,14 @@ TEST(DiscoverBBTest, SmokeTest) {
   std::vector<uint32_t> basicBlocks;
   llvm::DenseMap<uint32_t, unsigned> labels;
 
-  discoverBasicBlocks(cb, basicBlocks, labels);
+  std::vector<unsigned> loopHeaders;
+
+  discoverBasicBlocks(cb, basicBlocks, labels, &loopHeaders);
   EXPECT_EQ(6, basicBlocks.size());
   EXPECT_EQ(6, labels.size());
+  // Both loops are rotated, so their bodies are the targets of the backward
+  // branches.
+  EXPECT_EQ(2, loopHeaders.size());
 }
 
 } // namespace
@@ -123,4 +123,56 @@ TEST(ExecHeapTest, SmokeTest) {
   eh.dump(llvm::errs(), true);
 }
 
+TEST(ExecHeapTest, WriteXorExecuteTest) {
+  ExecHeap eh{4096, 4096, 4096 * 2, /* writeXorExecute */ true};
+  EXPECT_TRUE(eh.isWriteXorExecute());
+  ASSERT_TRUE(eh.addPool());
+
+  auto r1 = eh.alloc({16, 16});
+  ASSERT_TRUE(r1);
+
+  // The blocks can be written between makeWritable() and makeExecutable(),
+  // and remain readable afterwards.
+  ASSERT_TRUE(eh.makeWritable(*r1));
+  r1->first[0] = 0x11;
+  r1->second[0] = 0x22;
+  ASSERT_TRUE(eh.makeExecutable(*r1, {1, 1}));
+  EXPECT_EQ(0x11, r1->first[0]);
+  EXPECT_EQ(0x22, r1->second[0]);
+
+  // Making the pool writable again allows further modification.
+  ASSERT_TRUE(eh.makeWritable(*r1));
+  r1->first[0] = 0x33;
+  ASSERT_TRUE(eh.makeExecutable(*r1, {1, 0}));
+  EXPECT_EQ(0x33, r1->first[0]);
+
+  eh.free(*r1);
+}
+
+TEST(ExecHeapTest, CanAllocTest) {
+  ExecHeap eh{4096, 4096, 4096 * 2};
+
+  // Too large for any pool.
+  EXPECT_FALSE(eh.canAlloc({8192, 16}));
+  // A new pool can still be added.
+  EXPECT_TRUE(eh.canAlloc({4096, 4096}));
+
+  auto r1 = eh.alloc({4096, 16});
+  if (!r1) {
+    ASSERT_TRUE(eh.addPool());
+    r1 = eh.alloc({4096, 16});
+  }
+  ASSERT_TRUE(r1);
+
+  // The only pool is full in the first heap and no more pools are allowed.
+  EXPECT_FALSE(eh.canAlloc({16, 16}));
+  EXPECT_TRUE(eh.canAlloc({0, 16}));
+
+  eh.freeRemaining(*r1, {1024, 16});
+  EXPECT_TRUE(eh.canAlloc({3072, 16}));
+  EXPECT_FALSE(eh.canAlloc({3073, 16}));
+
+  eh.free(*r1);
+}
+
 } // namespace
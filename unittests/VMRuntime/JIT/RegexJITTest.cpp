@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/Regex/Compiler.h"
+#include "hermes/Regex/Executor.h"
+#include "hermes/Regex/RegexTraits.h"
+#include "hermes/VM/JIT/JIT.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+using namespace hermes::vm;
+using namespace hermes::regex;
+
+namespace {
+#if defined(__x86_64__)
+
+std::vector<uint8_t> compileRegex(const char *pattern, int flags = 0) {
+  std::u16string pattern16(pattern, pattern + strlen(pattern));
+  Regex<U16RegexTraits> re(
+      pattern16.data(),
+      pattern16.data() + pattern16.size(),
+      static_cast<constants::SyntaxFlags>(flags));
+  EXPECT_TRUE(re.valid()) << pattern;
+  return re.compile();
+}
+
+/// \return the ranges matched by the interpreter searching \p input from
+/// \p offset, as a string.
+std::string interpret(
+    llvm::ArrayRef<uint8_t> bytecode,
+    const std::string &input,
+    size_t offset) {
+  MatchResults<const char *> m;
+  auto flags = constants::matchDefault | constants::matchInputAllAscii;
+  if (offset)
+    flags |= constants::matchPreviousCharAvailable;
+  auto result = searchWithBytecode(
+      bytecode, input.data() + offset, input.data() + input.size(), m, flags);
+  if (result != MatchRuntimeResult::Match)
+    return "no match";
+  std::string str;
+  for (const auto &range : m) {
+    if (!range.matched)
+      str += "[-]";
+    else
+      str += "[" + std::to_string(range.first - input.data()) + "," +
+          std::to_string(range.second - input.data()) + "]";
+  }
+  return str;
+}
+
+/// \return the ranges matched by the native code \p code searching \p input
+/// from \p offset, in the same format as interpret().
+std::string run(
+    x86_64::JITContext &context,
+    RegexJITFunction code,
+    llvm::ArrayRef<uint8_t> bytecode,
+    const std::string &input,
+    size_t offset) {
+  auto header = reinterpret_cast<const RegexBytecodeHeader *>(bytecode.data());
+  std::vector<const char *> captures(2 * (header->markedCount + 1));
+  int result = context.runRegex(
+      code,
+      input.data(),
+      input.data() + input.size(),
+      input.data() + offset,
+      captures.data());
+  if (result == RegexJITGiveUp)
+    return "give up";
+  if (result == RegexJITNoMatch)
+    return "no match";
+  std::string str;
+  for (size_t i = 0; i < captures.size(); i += 2) {
+    if (!captures[i])
+      str += "[-]";
+    else
+      str += "[" + std::to_string(captures[i] - input.data()) + "," +
+          std::to_string(captures[i + 1] - input.data()) + "]";
+  }
+  return str;
+}
+
+class RegexJITTest : public ::testing::Test {
+ protected:
+  RegexJITTest() {
+    context_.setRegExpThreshold(0);
+  }
+
+  /// Compile \p pattern with \p flags, and check that the native code finds
+  /// the same matches as the interpreter in each of \p inputs, from every
+  /// offset.
+  void expectSameMatches(
+      const char *pattern,
+      int flags,
+      std::initializer_list<const char *> inputs) {
+    auto bytecode = compileRegex(pattern, flags);
+    RegexJITEntry *entry = nullptr;
+    RegexJITFunction code = context_.compileRegex(entry, bytecode);
+    ASSERT_TRUE(code) << pattern;
+    for (const char *input : inputs) {
+      for (size_t offset = 0, e = strlen(input); offset <= e; ++offset) {
+        EXPECT_EQ(
+            interpret(bytecode, input, offset),
+            run(context_, code, bytecode, input, offset))
+            << "/" << pattern << "/ on \"" << input << "\" at " << offset;
+      }
+    }
+  }
+
+  x86_64::JITContext context_{true, 1 << 16, 1 << 20};
+};
+
+TEST_F(RegexJITTest, CharactersTest) {
+  expectSameMatches("abc", 0, {"", "abc", "xxabcx", "ababc", "abxabc"});
+  expectSameMatches("a.c", 0, {"abc", "a\nc", "axxc", "a c"});
+  expectSameMatches("[a-c][^a-c]\\d\\w\\s", 0, {"ax1_ ", "ab1_ ", "cz9a\t"});
+  expectSameMatches("AbC", constants::icase, {"abc", "ABC", "xaBcx"});
+  expectSameMatches("[a-z]B", constants::icase, {"Ab", "ZB", "1b"});
+  expectSameMatches("\\u00e9|a", 0, {"a", "bab"});
+}
+
+TEST_F(RegexJITTest, AnchorsTest) {
+  expectSameMatches("^ab", 0, {"ab", "xab", "ab\nab"});
+  expectSameMatches("ab$", 0, {"ab", "abx", "ab\nab"});
+  expectSameMatches("^ab$", constants::multiline, {"ab\nab", "x\r\nab\r"});
+  expectSameMatches("\\bab\\b", 0, {"ab", "xab ab", "ab_ ab"});
+  expectSameMatches("\\Ba\\B", 0, {"a", "bab", "b a"});
+}
+
+TEST_F(RegexJITTest, AlternationsTest) {
+  expectSameMatches("(a|ab)(c|bcd)(d?)", 0, {"abcd", "abc", "xabcdd"});
+  expectSameMatches("a(b|)c|(x)", 0, {"ac", "abc", "x", "abx"});
+  expectSameMatches("(?:a|b\\u00e9)c", 0, {"ac", "bc"});
+}
+
+TEST_F(RegexJITTest, LoopsTest) {
+  expectSameMatches("a*b+c?", 0, {"aabbc", "bc", "aac", "b"});
+  expectSameMatches("a*?b+?c??", 0, {"aabbc", "bc", "aac", "b"});
+  expectSameMatches("x{2,4}y{3}", 0, {"xxxxxyyy", "xyyy", "xxyyyy"});
+  expectSameMatches("x{2,4}?y", 0, {"xxxxxy", "xy"});
+  expectSameMatches("(a{2,})(a*?)(\\w*)", 0, {"aaaab", "a", "aab"});
+  expectSameMatches("^[ab]*b$", constants::multiline, {"abab\nbb\nba"});
+}
+
+TEST_F(RegexJITTest, UnsupportedTest) {
+  for (const char *pattern : {"(a)\\1", "a(?=b)", "(ab)*", "(?:a|b)+"}) {
+    auto bytecode = compileRegex(pattern);
+    RegexJITEntry *entry = nullptr;
+    EXPECT_FALSE(context_.compileRegex(entry, bytecode)) << pattern;
+    EXPECT_TRUE(entry->dontJIT);
+  }
+}
+
+TEST_F(RegexJITTest, ThresholdTest) {
+  context_.setRegExpThreshold(2);
+  auto bytecode = compileRegex("a+b");
+  RegexJITEntry *entry1 = nullptr;
+  RegexJITEntry *entry2 = nullptr;
+  // The searches with the same bytecode are counted together.
+  EXPECT_FALSE(context_.compileRegex(entry1, bytecode));
+  EXPECT_FALSE(context_.compileRegex(entry2, bytecode));
+  EXPECT_EQ(entry1, entry2);
+  RegexJITFunction code = context_.compileRegex(entry1, bytecode);
+  EXPECT_TRUE(code);
+  EXPECT_EQ(code, context_.compileRegex(entry2, bytecode));
+}
+
+TEST_F(RegexJITTest, GiveUpTest) {
+  auto bytecode = compileRegex("a*a*a*a*a*b");
+  RegexJITEntry *entry = nullptr;
+  RegexJITFunction code = context_.compileRegex(entry, bytecode);
+  ASSERT_TRUE(code);
+  // Backtracking takes polynomial time when there is no match.
+  EXPECT_EQ("give up", run(context_, code, bytecode, std::string(100, 'a'), 0));
+  EXPECT_EQ(
+      "[95,101]",
+      run(context_, code, bytecode, std::string(95, 'x') + "aaaaab", 0));
+}
+
+#endif
+
+} // namespace
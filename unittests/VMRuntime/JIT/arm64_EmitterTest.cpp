@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/VM/JIT/NativeDisassembler.h"
+#include "hermes/VM/JIT/arm64/Emitter.h"
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+
+using namespace hermes::vm;
+using namespace hermes::vm::arm64;
+
+namespace {
+#ifdef HERMESVM_JIT_DISASSEMBLER
+
+TEST(arm64_EmitterTest, Test) {
+  uint8_t buf[16384];
+  Emitter emitter{buf};
+
+  std::string str;
+  llvm::raw_string_ostream OS{str};
+  auto dis = NativeDisassembler::create(
+      NativeDisassembler::aarch64_unknown_linux_gnu);
+
+  auto trim = [](std::string str) {
+    // Strip the address
+    if (str.compare(0, 6, "00000:") == 0)
+      str.erase(0, 6);
+    // Strip leading spaces
+    while (!str.empty() && isspace(str.front()))
+      str.erase(0, 1);
+
+    // Skip trailing comment
+    auto com = str.rfind("//");
+    if (com != std::string::npos)
+      str.erase(com);
+
+    while (!str.empty() && isspace(str.back()))
+      str.pop_back();
+    for (char &ch : str)
+      if (ch == '\t')
+        ch = ' ';
+    return str;
+  };
+
+#define CHECK(expected)                                         \
+  str.clear();                                                  \
+  dis->disassembleBuffer(                                       \
+      OS, llvm::makeArrayRef(buf, emitter.current()), 0, true); \
+  emitter = Emitter{buf};                                       \
+  EXPECT_STREQ(expected, trim(OS.str()).c_str())
+
+  emitter.movz(Reg::x10, 10);
+  CHECK("4a 01 80 d2                   mov x10, #10");
+  emitter.movk(Reg::x10, 0xfff9, 3);
+  CHECK("2a ff ff f2                   movk x10, #65529, lsl #48");
+  emitter.movz<W::L>(Reg::x0, 1);
+  CHECK("20 00 80 52                   mov w0, #1");
+  emitter.movn(Reg::x9, 0);
+  CHECK("09 00 80 92                   mov x9, #-1");
+  emitter.movRegToReg(Reg::x0, Reg::x19);
+  CHECK("f3 03 00 aa                   mov x19, x0");
+  emitter.movSP(Reg::sp, Reg::x29);
+  CHECK("fd 03 00 91                   mov x29, sp");
+  emitter.addImm(Reg::x10, Reg::x20, 16);
+  CHECK("8a 42 00 91                   add x10, x20, #16");
+  emitter.subImm(Reg::x10, Reg::x20, 64);
+  CHECK("8a 02 01 d1                   sub x10, x20, #64");
+  emitter.cmpImm<W::L>(Reg::x0, 0);
+  CHECK("1f 00 00 71                   cmp w0, #0");
+  emitter.cmpImm(Reg::x9, 14);
+  CHECK("3f 39 00 f1                   cmp x9, #14");
+  emitter.addReg(Reg::x10, Reg::x9, Reg::x17);
+  CHECK("2a 01 11 8b                   add x10, x9, x17");
+  emitter.cmpReg(Reg::x10, Reg::x11);
+  CHECK("5f 01 0b eb                   cmp x10, x11");
+  emitter.orrReg(Reg::x9, Reg::x9, Reg::x16);
+  CHECK("29 01 10 aa                   orr x9, x9, x16");
+  emitter.mvnReg(Reg::x10, Reg::x9);
+  CHECK("ea 03 29 aa                   mvn x10, x9");
+  emitter.mvnReg<W::L>(Reg::x9, Reg::x9);
+  CHECK("e9 03 29 2a                   mvn w9, w9");
+  emitter.lsrImm(Reg::x10, Reg::x10, 47);
+  CHECK("4a fd 6f d3                   lsr x10, x10, #47");
+  emitter.ubfm(Reg::x9, Reg::x9, 0, 46);
+  CHECK("29 b9 40 d3                   ubfx x9, x9, #0, #47");
+  emitter.uxtb(Reg::x0, Reg::x0);
+  CHECK("00 1c 00 53                   uxtb w0, w0");
+  emitter.cset(Reg::x9, Cond::EQ);
+  CHECK("e9 17 9f 9a                   cset x9, eq");
+  emitter.ldrImm(Reg::x9, Reg::x19, 8);
+  CHECK("69 06 40 f9                   ldr x9, [x19, #8]");
+  emitter.strImm<W::L>(Reg::x9, Reg::x20, 4);
+  CHECK("89 06 00 b9                   str w9, [x20, #4]");
+  emitter.ldur(Reg::x9, Reg::x20, -8);
+  CHECK("89 82 5f f8                   ldur x9, [x20, #-8]");
+  emitter.stur(Reg::x9, Reg::x20, -16);
+  CHECK("89 02 1f f8                   stur x9, [x20, #-16]");
+  emitter.ldrReg(Reg::x9, Reg::x10, Reg::x11, true);
+  CHECK("49 79 6b f8                   ldr x9, [x10, x11, lsl #3]");
+  emitter.strReg(Reg::x9, Reg::x10, Reg::x17);
+  CHECK("49 69 31 f8                   str x9, [x10, x17]");
+  emitter.ldrfpImm(FReg::d0, Reg::x20, 24);
+  CHECK("80 0e 40 fd                   ldr d0, [x20, #24]");
+  emitter.sturfp(FReg::d1, Reg::x20, -24);
+  CHECK("81 82 1e fc                   stur d1, [x20, #-24]");
+  emitter.stpPre(Reg::x29, Reg::x30, Reg::sp, -48);
+  CHECK("fd 7b bd a9                   stp x29, x30, [sp, #-48]!");
+  emitter.stp(Reg::x19, Reg::x20, Reg::sp, 16);
+  CHECK("f3 53 01 a9                   stp x19, x20, [sp, #16]");
+  emitter.ldp(Reg::x19, Reg::x20, Reg::sp, 16);
+  CHECK("f3 53 41 a9                   ldp x19, x20, [sp, #16]");
+  emitter.ldpPost(Reg::x29, Reg::x30, Reg::sp, 48);
+  CHECK("fd 7b c3 a8                   ldp x29, x30, [sp], #48");
+  emitter.fadd(FReg::d0, FReg::d0, FReg::d1);
+  CHECK("00 28 61 1e                   fadd d0, d0, d1");
+  emitter.fsub(FReg::d0, FReg::d0, FReg::d1);
+  CHECK("00 38 61 1e                   fsub d0, d0, d1");
+  emitter.fmul(FReg::d0, FReg::d0, FReg::d1);
+  CHECK("00 08 61 1e                   fmul d0, d0, d1");
+  emitter.fdiv(FReg::d0, FReg::d0, FReg::d1);
+  CHECK("00 18 61 1e                   fdiv d0, d0, d1");
+  emitter.fneg(FReg::d0, FReg::d0);
+  CHECK("00 40 61 1e                   fneg d0, d0");
+  emitter.fcmp(FReg::d0, FReg::d1);
+  CHECK("00 20 61 1e                   fcmp d0, d1");
+  emitter.fcvtzsToW(Reg::x9, FReg::d0);
+  CHECK("09 00 78 1e                   fcvtzs w9, d0");
+  emitter.scvtfFromW(FReg::d1, Reg::x9);
+  CHECK("21 01 62 1e                   scvtf d1, w9");
+  emitter.ucvtfFromW(FReg::d0, Reg::x9);
+  CHECK("20 01 63 1e                   ucvtf d0, w9");
+  emitter.b(buf + 16);
+  CHECK("04 00 00 14                   b #16");
+  emitter.bcond(Cond::NE, buf + 8);
+  CHECK("41 00 00 54                   b.ne #8");
+  emitter.bcond(Cond::LS, buf - 8);
+  CHECK("c9 ff ff 54                   b.ls #-8");
+  emitter.cbz(Reg::x9, buf + 12);
+  CHECK("69 00 00 b4                   cbz x9, #12");
+  emitter.blr(Reg::x16);
+  CHECK("00 02 3f d6                   blr x16");
+  emitter.ret();
+  CHECK("c0 03 5f d6                   ret");
+
+#undef CHECK
+}
+
+#endif // HERMESVM_JIT_DISASSEMBLER
+
+TEST(arm64_EmitterTest, MovImmTest) {
+  EXPECT_EQ(1u, Emitter::movImmLength(0));
+  EXPECT_EQ(1u, Emitter::movImmLength(0xffff));
+  EXPECT_EQ(1u, Emitter::movImmLength(~(uint64_t)0));
+  EXPECT_EQ(1u, Emitter::movImmLength(0xfff9000000000000ull));
+  EXPECT_EQ(2u, Emitter::movImmLength(0xfff9000000000001ull));
+  EXPECT_EQ(4u, Emitter::movImmLength(0x0123456789abcdefull));
+}
+
+TEST(arm64_EmitterTest, BranchTest) {
+  uint8_t buf[16];
+  Emitter emitter{buf};
+
+  // Emit branches to themselves and patch them afterwards.
+  emitter.b(buf);
+  emitter.bcond(Cond::EQ, buf + 4);
+  Emitter::patchBranch(buf, buf + 12);
+  Emitter::patchBranch(buf + 4, buf);
+
+  uint32_t insn;
+  memcpy(&insn, buf, sizeof(insn));
+  EXPECT_EQ(0x14000003u, insn);
+  memcpy(&insn, buf + 4, sizeof(insn));
+  EXPECT_EQ(0x54ffffe0u, insn);
+
+  EXPECT_TRUE(Emitter::inBranchRange(19, buf, buf + ((1 << 20) - 4)));
+  EXPECT_FALSE(Emitter::inBranchRange(19, buf, buf + (1 << 20)));
+  EXPECT_TRUE(Emitter::inBranchRange(26, buf, buf + (1 << 20)));
+}
+
+} // namespace
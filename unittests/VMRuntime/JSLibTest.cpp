@@ -7,6 +7,7 @@
 #include "TestHelpers.h"
 
 #include "hermes/BCGen/HBC/BytecodeGenerator.h"
+#include "hermes/Support/XorShift128Plus.h"
 #include "hermes/VM/JSDate.h"
 #include "hermes/VM/JSLib/RuntimeCommonStorage.h"
 #include "hermes/VM/MockedEnvironment.h"
@@ -935,11 +936,9 @@ TEST_F(JSLibTest, MockedEnvironmentTest) {
   GCScope scope(runtime);
 
   const std::minstd_rand::result_type mathRandomSeed = 123;
-  std::minstd_rand engine;
-  engine.seed(mathRandomSeed);
-  std::uniform_real_distribution<> dist{0.0, 1.0};
-  const double mathRandom = dist(engine);
-  const double secondMathRandom = dist(engine);
+  hermes::XorShift128Plus engine{mathRandomSeed};
+  const double mathRandom = engine.nextDouble();
+  const double secondMathRandom = engine.nextDouble();
   const uint64_t dateNow = 100;
   const uint64_t newDate = 200;
   const std::string dateAsFunc{"foo"};
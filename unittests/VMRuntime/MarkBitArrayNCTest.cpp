@@ -91,6 +91,19 @@ TEST_F(MarkBitArrayNCTest, MarkGet) {
   }
 }
 
+TEST_F(MarkBitArrayNCTest, AtomicMark) {
+  for (char *addr : addrs) {
+    size_t ind = mba->addressToIndex(addr);
+    EXPECT_TRUE(mba->atomicMark(ind)) << "first " << ind;
+    EXPECT_TRUE(mba->at(ind)) << "first " << ind;
+    EXPECT_FALSE(mba->atomicMark(ind)) << "second " << ind;
+  }
+  EXPECT_EQ(addrs.size(), mba->countMarkedBits());
+
+  mba->clear();
+  EXPECT_EQ(0u, mba->countMarkedBits());
+}
+
 TEST_F(MarkBitArrayNCTest, Initial) {
   for (char *addr : addrs) {
     size_t ind = mba->addressToIndex(addr);
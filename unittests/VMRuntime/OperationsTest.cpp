@@ -487,6 +487,20 @@ TEST_F(OperationsTest, ToStringTest) {
     SmallIntToStringTest(u"0", 0);
     SmallIntToStringTest(u"12384", 12384);
     SmallIntToStringTest(u"-12384", -12384);
+    SmallIntToStringTest(u"1023", 1023);
+    SmallIntToStringTest(u"1024", 1024);
+  }
+
+  // Small integers convert to the same cached string every time.
+  {
+    auto seven = runtime->makeHandle(HermesValue::encodeNumberValue(7));
+    auto first = toString_RJS(runtime, seven);
+    ASSERT_EQ(ExecutionStatus::RETURNED, first.getStatus());
+    StringPrimitive *firstStr = first->get();
+    auto second = toString_RJS(runtime, seven);
+    ASSERT_EQ(ExecutionStatus::RETURNED, second.getStatus());
+    EXPECT_EQ(firstStr, second->get());
+    EXPECT_TRUE(firstStr->isUniqued());
   }
 
   // TODO: Test Object toString once Runtime::interpretFunction() is written.
@@ -956,4 +970,42 @@ TEST_F(OperationsTest, AdditionTest) {
     DoubleAdditionTest(3528.142, 3527, 1.142);
   }
 }
+
+TEST_F(OperationsTest, ArrayIndexKeyTest) {
+  auto toIndex = [this](const char16_t *str) {
+    return toArrayIndexFastPath(
+        StringPrimitive::createNoThrow(runtime, createUTF16Ref(str))
+            .getHermesValue());
+  };
+  EXPECT_EQ(42u, *toIndex(u"42"));
+  EXPECT_EQ(4294967294u, *toIndex(u"4294967294"));
+  EXPECT_FALSE(toIndex(u"4294967295").hasValue());
+  EXPECT_FALSE(toIndex(u"042").hasValue());
+  EXPECT_FALSE(toIndex(u"").hasValue());
+  EXPECT_FALSE(toIndex(u"length").hasValue());
+
+  // Small indices are converted to the same identifier from a number and
+  // from a string, without creating a string.
+  auto id = runtime->getIdentifierTable().getSymbolHandle(
+      runtime, createASCIIRef("42"));
+  ASSERT_EQ(ExecutionStatus::RETURNED, id.getStatus());
+  auto fromNumber = valueToSymbolID(
+      runtime, runtime->makeHandle(HermesValue::encodeNumberValue(42)));
+  ASSERT_EQ(ExecutionStatus::RETURNED, fromNumber.getStatus());
+  EXPECT_EQ(**id, **fromNumber);
+  auto fromString = valueToSymbolID(
+      runtime,
+      StringPrimitive::createNoThrow(runtime, createUTF16Ref(u"42")));
+  ASSERT_EQ(ExecutionStatus::RETURNED, fromString.getStatus());
+  EXPECT_EQ(**id, **fromString);
+
+  // Larger indices are converted through a string.
+  auto large = valueToSymbolID(
+      runtime, runtime->makeHandle(HermesValue::encodeNumberValue(100000)));
+  ASSERT_EQ(ExecutionStatus::RETURNED, large.getStatus());
+  EXPECT_EQ(
+      **runtime->getIdentifierTable().getSymbolHandle(
+          runtime, createASCIIRef("100000")),
+      **large);
+}
 } // namespace
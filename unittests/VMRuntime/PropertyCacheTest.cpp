@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/VM/PropertyCache.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+using namespace hermes::vm;
+
+namespace {
+
+/// The cache never dereferences the classes it holds, so tests can use
+/// arbitrary distinct addresses.
+HiddenClass *fakeClass(uintptr_t n) {
+  return reinterpret_cast<HiddenClass *>(n * 16);
+}
+
+TEST(PropertyCacheTest, MonomorphicLayout) {
+  PolyPropertyCacheEntry entry;
+  EXPECT_TRUE(entry.insert(fakeClass(1), 7));
+  // The first way must alias a plain PropertyCacheEntry.
+  auto *mono = reinterpret_cast<PropertyCacheEntry *>(&entry);
+  EXPECT_EQ(fakeClass(1), mono->clazz);
+  EXPECT_EQ(7u, mono->slot);
+}
+
+TEST(PropertyCacheTest, PolymorphicLookup) {
+  PolyPropertyCacheEntry entry;
+  for (unsigned i = 1; i <= PolyPropertyCacheEntry::kNumWays; ++i)
+    EXPECT_TRUE(entry.insert(fakeClass(i), i * 10));
+  EXPECT_FALSE(entry.megamorphic);
+
+  for (unsigned i = 1; i <= PolyPropertyCacheEntry::kNumWays; ++i) {
+    auto *way = entry.find(fakeClass(i));
+    ASSERT_NE(nullptr, way);
+    EXPECT_EQ(i * 10, way->slot);
+  }
+  EXPECT_EQ(nullptr, entry.find(fakeClass(100)));
+
+  // Re-inserting a known class updates its slot in place.
+  EXPECT_TRUE(entry.insert(fakeClass(2), 99));
+  EXPECT_EQ(99u, entry.find(fakeClass(2))->slot);
+  EXPECT_FALSE(entry.megamorphic);
+}
+
+TEST(PropertyCacheTest, BecomesMegamorphic) {
+  PolyPropertyCacheEntry entry;
+  for (unsigned i = 1; i <= PolyPropertyCacheEntry::kNumWays; ++i)
+    entry.insert(fakeClass(i), i);
+  EXPECT_FALSE(entry.insert(fakeClass(100), 100));
+  EXPECT_TRUE(entry.megamorphic);
+  EXPECT_EQ(nullptr, entry.find(fakeClass(100)));
+  // Existing ways still hit.
+  EXPECT_NE(nullptr, entry.find(fakeClass(1)));
+
+  // A way cleared by the GC is not refilled once megamorphic.
+  entry.ways[0].clazz = nullptr;
+  EXPECT_FALSE(entry.insert(fakeClass(101), 101));
+}
+
+TEST(PropertyCacheTest, ReusesClearedWays) {
+  PolyPropertyCacheEntry entry;
+  for (unsigned i = 1; i <= PolyPropertyCacheEntry::kNumWays; ++i)
+    entry.insert(fakeClass(i), i);
+  // Simulate the GC collecting the class in the second way.
+  entry.ways[1].clazz = nullptr;
+  EXPECT_TRUE(entry.insert(fakeClass(100), 100));
+  EXPECT_EQ(&entry.ways[1], entry.find(fakeClass(100)));
+  EXPECT_FALSE(entry.megamorphic);
+}
+
+TEST(PropertyCacheTest, MegamorphicCache) {
+  std::unique_ptr<MegamorphicPropertyCache> cache{
+      new MegamorphicPropertyCache()};
+  auto a = SymbolID::unsafeCreate(10);
+  auto b = SymbolID::unsafeCreate(11);
+  EXPECT_EQ(nullptr, cache->find(fakeClass(1), a));
+
+  cache->insert(fakeClass(1), a, 3, true);
+  cache->insert(fakeClass(2), b, 4, false);
+  auto *entry = cache->find(fakeClass(1), a);
+  ASSERT_NE(nullptr, entry);
+  EXPECT_EQ(3u, entry->slot);
+  EXPECT_TRUE(entry->writable);
+  entry = cache->find(fakeClass(2), b);
+  ASSERT_NE(nullptr, entry);
+  EXPECT_EQ(4u, entry->slot);
+  EXPECT_FALSE(entry->writable);
+  // Both the class and the name must match.
+  EXPECT_EQ(nullptr, cache->find(fakeClass(1), b));
+  EXPECT_EQ(nullptr, cache->find(fakeClass(2), a));
+
+  cache->clear();
+  EXPECT_EQ(nullptr, cache->find(fakeClass(1), a));
+  EXPECT_EQ(nullptr, cache->find(fakeClass(2), b));
+}
+
+TEST(PropertyCacheTest, StatsAccumulate) {
+  PropertyCacheStats a{};
+  a.hits = 3;
+  a.misses = 2;
+  PropertyCacheStats b{};
+  b.hits = 1;
+  b.megamorphicMisses = 5;
+  a += b;
+  EXPECT_EQ(4u, a.hits);
+  EXPECT_EQ(2u, a.misses);
+  EXPECT_EQ(5u, a.megamorphicMisses);
+}
+
+} // namespace
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/VM/RegExpCache.h"
+
+#include "gtest/gtest.h"
+
+using namespace hermes::vm;
+
+namespace {
+
+/// \return bytecode holding the single byte \p n, to tell entries apart.
+RegExpBytecode fakeBytecode(uint8_t n) {
+  return std::make_shared<const std::vector<uint8_t>>(1, n);
+}
+
+/// \return the pattern "p" followed by the decimal digits of \p n.
+std::u16string pattern(unsigned n) {
+  std::u16string result = u"p";
+  for (char c : std::to_string(n))
+    result.push_back(c);
+  return result;
+}
+
+llvm::ArrayRef<char16_t> arrayRef(const std::u16string &str) {
+  return llvm::makeArrayRef(str.data(), str.size());
+}
+
+TEST(RegExpCacheTest, KeyedByPatternAndFlags) {
+  RegExpCache cache;
+  std::u16string ab = u"ab";
+  EXPECT_EQ(nullptr, cache.find(arrayRef(ab), 0));
+  cache.insert(arrayRef(ab), 0, fakeBytecode(1));
+  cache.insert(arrayRef(ab), 1, fakeBytecode(2));
+  ASSERT_NE(nullptr, cache.find(arrayRef(ab), 0));
+  EXPECT_EQ(1, cache.find(arrayRef(ab), 0)->front());
+  EXPECT_EQ(2, cache.find(arrayRef(ab), 1)->front());
+  EXPECT_EQ(nullptr, cache.find(arrayRef(u"a"), 0));
+  EXPECT_EQ(nullptr, cache.find(arrayRef(u"abb"), 0));
+  EXPECT_EQ(2u, cache.size());
+
+  // Inserting an existing key replaces its bytecode.
+  cache.insert(arrayRef(ab), 0, fakeBytecode(3));
+  EXPECT_EQ(3, cache.find(arrayRef(ab), 0)->front());
+  EXPECT_EQ(2u, cache.size());
+
+  cache.clear();
+  EXPECT_EQ(nullptr, cache.find(arrayRef(ab), 0));
+}
+
+TEST(RegExpCacheTest, EvictsLeastRecentlyUsed) {
+  RegExpCache cache;
+  for (unsigned i = 0; i < RegExpCache::kMaxEntries; ++i)
+    cache.insert(arrayRef(pattern(i)), 0, fakeBytecode(i));
+  // Using the oldest entry keeps it in the cache.
+  EXPECT_NE(nullptr, cache.find(arrayRef(pattern(0)), 0));
+  cache.insert(arrayRef(pattern(1000)), 0, fakeBytecode(0));
+  EXPECT_EQ(RegExpCache::kMaxEntries, cache.size());
+  EXPECT_NE(nullptr, cache.find(arrayRef(pattern(0)), 0));
+  EXPECT_EQ(nullptr, cache.find(arrayRef(pattern(1)), 0));
+  EXPECT_NE(nullptr, cache.find(arrayRef(pattern(2)), 0));
+  EXPECT_NE(nullptr, cache.find(arrayRef(pattern(1000)), 0));
+}
+
+TEST(RegExpCacheTest, LongPatternsAreNotCached) {
+  RegExpCache cache;
+  std::u16string longPattern(RegExpCache::kMaxPatternLength + 1, u'a');
+  cache.insert(arrayRef(longPattern), 0, fakeBytecode(1));
+  EXPECT_EQ(nullptr, cache.find(arrayRef(longPattern), 0));
+  longPattern.pop_back();
+  cache.insert(arrayRef(longPattern), 0, fakeBytecode(1));
+  EXPECT_NE(nullptr, cache.find(arrayRef(longPattern), 0));
+}
+
+} // namespace
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "TestHelpers.h"
+
+#include "hermes/BCGen/HBC/BytecodeDataProvider.h"
+#include "hermes/BCGen/HBC/BytecodeProviderFromSrc.h"
+#include "hermes/BCGen/HBC/BytecodeStream.h"
+#include "hermes/VM/StringView.h"
+
+#include "llvm/Support/raw_ostream.h"
+
+using namespace hermes::vm;
+using namespace hermes::hbc;
+
+namespace {
+
+using RuntimeModuleTest = RuntimeTestFixture;
+
+/// A buffer owning a copy of its bytes.
+class VectorBuffer : public hermes::Buffer {
+ public:
+  VectorBuffer(std::vector<uint8_t> bytes) : bytes_(std::move(bytes)) {
+    data_ = bytes_.data();
+    size_ = bytes_.size();
+  }
+
+ private:
+  std::vector<uint8_t> bytes_;
+};
+
+/// Compile \p source into a bytecode file without debug info.
+std::vector<uint8_t> compileToBytecode(const char *source) {
+  auto res = BCProviderFromSrc::createBCProviderFromSrc(
+      std::make_unique<hermes::Buffer>(
+          reinterpret_cast<const uint8_t *>(source), strlen(source)),
+      "",
+      CompileFlags{});
+  EXPECT_TRUE(res.first) << res.second;
+  std::string bytes;
+  llvm::raw_string_ostream os{bytes};
+  hermes::BytecodeGenerationOptions opts{hermes::EmitBundle};
+  opts.stripDebugInfoSection = true;
+  BytecodeSerializer{os, opts}.serialize(
+      *res.first->getBytecodeModule(), hermes::SHA1{});
+  os.flush();
+  return {bytes.begin(), bytes.end()};
+}
+
+TEST_F(RuntimeModuleTest, FunctionOutsideTruncatedBytecode) {
+  auto bytes = compileToBytecode("function f() { return 42; }\nf();\n");
+
+  auto full = BCProviderFromBuffer::createBCProviderFromBuffer(
+                  std::make_unique<VectorBuffer>(bytes))
+                  .first;
+  ASSERT_TRUE(full);
+  ASSERT_EQ(2u, full->getFunctionCount());
+  uint32_t globalIndex = full->getGlobalFunctionIndex();
+  uint32_t fIndex = 1 - globalIndex;
+  auto globalHeader = full->getFunctionHeader(globalIndex);
+  auto fHeader = full->getFunctionHeader(fIndex);
+  // Cut the buffer in the middle of f, leaving the global function intact.
+  size_t cut = fHeader.offset() + 1;
+  ASSERT_LE(globalHeader.offset() + globalHeader.bytecodeSizeInBytes(), cut);
+  ASSERT_TRUE(full->isFunctionInBounds(globalIndex));
+  ASSERT_TRUE(full->isFunctionInBounds(fIndex));
+  bytes.resize(cut);
+
+  // Loading does not look at the functions, so the truncated file loads.
+  auto truncated = BCProviderFromBuffer::createBCProviderFromBuffer(
+      std::make_unique<VectorBuffer>(bytes));
+  ASSERT_TRUE(truncated.first) << truncated.second;
+  EXPECT_TRUE(truncated.first->isFunctionInBounds(globalIndex));
+  EXPECT_FALSE(truncated.first->isFunctionInBounds(fIndex));
+
+  // Creating a closure for f reports the malformed bytecode.
+  auto res = runtime->runBytecode(
+      std::move(truncated.first),
+      RuntimeModuleFlags{},
+      "",
+      runtime->makeNullHandle<Environment>());
+  ASSERT_EQ(ExecutionStatus::EXCEPTION, res.getStatus());
+  auto error =
+      runtime->makeHandle(vmcast<JSObject>(runtime->getThrownValue()));
+  runtime->clearThrownValue();
+  EXPECT_EQ(
+      error->getParent(runtime),
+      vmcast<JSObject>(runtime->SyntaxErrorPrototype));
+  auto message = JSObject::getNamed_RJS(
+      error, runtime, Predefined::getSymbolID(Predefined::message));
+  ASSERT_EQ(ExecutionStatus::RETURNED, message.getStatus());
+  ASSERT_TRUE(message->isString());
+  std::string text;
+  for (char16_t c : StringPrimitive::createStringView(
+           runtime, runtime->makeHandle(message->getString())))
+    text.push_back(c);
+  EXPECT_EQ(
+      "Malformed bytecode: function " + std::to_string(fIndex) +
+          " lies outside of the bytecode",
+      text);
+}
+
+} // namespace
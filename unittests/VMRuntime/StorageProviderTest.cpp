@@ -205,6 +205,37 @@ TEST(StorageProviderTest, WithExcess) {
   // A request for a second storage *can* fail, but is not required to.
 }
 
+TEST(StorageProviderTest, PreAllocatedHugePages) {
+  constexpr size_t NUM = 3;
+  auto result = StorageProvider::preAllocatedProvider(
+      NUM * AlignedStorage::size(), NUM * AlignedStorage::size(), 0, true);
+  ASSERT_TRUE(result);
+  std::unique_ptr<StorageProvider> provider{std::move(result.get())};
+  // Huge pages are only a hint, which the OS may not support.
+  EXPECT_TRUE(
+      provider->hugePageBytes() == 0 ||
+      provider->hugePageBytes() == NUM * AlignedStorage::size());
+
+  char *storages[NUM];
+  for (size_t i = 0; i < NUM; ++i) {
+    auto storage = provider->newStorage("Test");
+    ASSERT_TRUE(storage);
+    storages[i] = static_cast<char *>(storage.get());
+  }
+  // The storages are contiguous.
+  EXPECT_EQ(storages[0] + AlignedStorage::size(), storages[1]);
+  EXPECT_EQ(storages[1] + AlignedStorage::size(), storages[2]);
+
+  // Freed storages are re-used lowest address first.
+  provider->deleteStorage(storages[0]);
+  provider->deleteStorage(storages[1]);
+  auto storage = provider->newStorage("Test");
+  ASSERT_TRUE(storage);
+  EXPECT_EQ(storages[0], storage.get());
+  provider->deleteStorage(storage.get());
+  provider->deleteStorage(storages[2]);
+}
+
 #ifndef NDEBUG
 
 class SetVALimit final {
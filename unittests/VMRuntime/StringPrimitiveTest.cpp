@@ -5,6 +5,7 @@
  * file in the root directory of this source tree.
  */
 #include "hermes/VM/StringPrimitive.h"
+#include "hermes/Support/HashString.h"
 #include "hermes/VM/StringView.h"
 
 #include "llvm/Support/AlignOf.h"
@@ -95,6 +96,39 @@ TEST_F(StringPrimTest, CreateEfficientTest) {
   }
 }
 
+TEST_F(StringPrimTest, HashTest) {
+  auto handlefy = [&](CallResult<HermesValue> cr) {
+    return Handle<StringPrimitive>::vmcast(runtime, *cr);
+  };
+
+  size_t longLength = StringPrimitive::EXTERNAL_STRING_MIN_SIZE;
+  std::string narrow(longLength, 'x');
+  std::u16string wide(longLength, u'x');
+  const uint32_t hash = hermes::hashString(createASCIIRef(narrow.c_str()));
+  auto dynamic = handlefy(StringPrimitive::createEfficient(
+      runtime, createASCIIRef(narrow.c_str())));
+  auto external =
+      handlefy(StringPrimitive::createEfficient(runtime, std::move(narrow)));
+  auto externalWide =
+      handlefy(StringPrimitive::createEfficient(runtime, std::move(wide)));
+  EXPECT_TRUE(externalWide->isExternal());
+  for (auto s : {dynamic, external, externalWide}) {
+    EXPECT_EQ(hash, s->getHash());
+    // The second call may use the cached hash.
+    EXPECT_EQ(hash, s->getHash());
+  }
+
+  auto symRes = runtime->getIdentifierTable().getSymbolHandle(
+      runtime, createASCIIRef("hello"));
+  ASSERT_NE(ExecutionStatus::EXCEPTION, symRes.getStatus());
+  StringPrimitive *uniqued =
+      runtime->getIdentifierTable().getStringPrim(runtime, **symRes);
+  EXPECT_TRUE(uniqued->isUniqued());
+  auto hello = StringPrimitive::createNoThrow(runtime, "hello");
+  EXPECT_EQ(hello->getHash(), uniqued->getHash());
+  EXPECT_EQ(hello->getHash(), uniqued->getHash());
+}
+
 TEST_F(StringPrimTest, CompareTest) {
 #define TEST_CMP(v, a, b)                                 \
   {                                                       \
@@ -142,6 +176,130 @@ TEST_F(StringPrimTest, ConcatTest) {
   }
 }
 
+TEST_F(StringPrimTest, BufferedConcatTest) {
+  auto concat = [&](Handle<StringPrimitive> x, Handle<StringPrimitive> y) {
+    auto strRes = StringPrimitive::concat(runtime, x, y);
+    EXPECT_NE(ExecutionStatus::EXCEPTION, strRes.getStatus());
+    return runtime->makeHandle<StringPrimitive>(*strRes);
+  };
+  auto equals = [&](Handle<StringPrimitive> str, const std::u16string &ref) {
+    return StringPrimitive::createStringView(runtime, str)
+        .equals(UTF16Ref(ref.data(), ref.size()));
+  };
+
+  std::u16string expected(StringPrimitive::EXTERNAL_STRING_MIN_SIZE, u'a');
+  auto a = StringPrimitive::createNoThrow(runtime, createUTF16Ref(u"a"));
+  auto b = StringPrimitive::createNoThrow(runtime, createUTF16Ref(u"b"));
+  auto str = StringPrimitive::createNoThrow(
+      runtime, UTF16Ref(expected.data(), expected.size() - 1));
+  str = concat(str, a);
+  EXPECT_TRUE(str->isBuffered());
+  EXPECT_TRUE(str->isASCII());
+  EXPECT_TRUE(equals(str, expected));
+
+  // Appending to the end of the buffer.
+  auto withA = concat(str, a);
+  EXPECT_TRUE(equals(withA, expected + u"a"));
+  // Appending to a string which no longer ends its buffer.
+  auto withB = concat(str, b);
+  EXPECT_TRUE(equals(withB, expected + u"b"));
+  EXPECT_TRUE(equals(withA, expected + u"a"));
+  EXPECT_TRUE(equals(str, expected));
+
+  // Appending a string to itself.
+  auto twice = concat(withA, withA);
+  EXPECT_TRUE(equals(twice, expected + u"a" + expected + u"a"));
+
+  // Appending a UTF-16 string.
+  auto wide =
+      StringPrimitive::createNoThrow(runtime, createUTF16Ref(u"\u1234"));
+  auto withWide = concat(withB, wide);
+  EXPECT_FALSE(withWide->isASCII());
+  EXPECT_TRUE(equals(withWide, expected + u"b\u1234"));
+  EXPECT_TRUE(equals(concat(withWide, a), expected + u"b\u1234a"));
+}
+
+TEST_F(StringPrimTest, SharedSliceTest) {
+  auto slice = [&](Handle<StringPrimitive> str, size_t start, size_t length) {
+    auto strRes = StringPrimitive::slice(runtime, str, start, length);
+    EXPECT_NE(ExecutionStatus::EXCEPTION, strRes.getStatus());
+    return runtime->makeHandle<StringPrimitive>(*strRes);
+  };
+  auto equals = [&](Handle<StringPrimitive> str, const std::u16string &ref) {
+    return StringPrimitive::createStringView(runtime, str)
+        .equals(UTF16Ref(ref.data(), ref.size()));
+  };
+
+  std::u16string chars;
+  for (unsigned i = 0; i < StringPrimitive::EXTERNAL_STRING_MIN_SIZE; ++i) {
+    chars.push_back(u'\u0100' + i);
+  }
+  auto ext = runtime->makeHandle<StringPrimitive>(
+      *StringPrimitive::createEfficient(runtime, std::u16string(chars)));
+  ASSERT_TRUE(ext->isExternal());
+
+  // Slices of external strings, and slices of those slices.
+  auto sliced = slice(ext, 10, 100);
+  EXPECT_TRUE(sliced->isSliced());
+  EXPECT_TRUE(equals(sliced, chars.substr(10, 100)));
+  auto slicedTwice = slice(sliced, 20, 50);
+  EXPECT_TRUE(slicedTwice->isSliced());
+  EXPECT_TRUE(equals(slicedTwice, chars.substr(30, 50)));
+
+  // Short slices are copied.
+  auto copied = slice(sliced, 20, StringPrimitive::SHARED_SLICE_MIN_SIZE - 1);
+  EXPECT_FALSE(copied->isSliced());
+  EXPECT_TRUE(equals(
+      copied, chars.substr(30, StringPrimitive::SHARED_SLICE_MIN_SIZE - 1)));
+
+  // Slices of buffered strings share the buffer, and appending to a slice
+  // which ends the buffer appends in place.
+  auto a = StringPrimitive::createNoThrow(runtime, createUTF16Ref(u"a"));
+  auto buffered = runtime->makeHandle<StringPrimitive>(
+      *StringPrimitive::concat(runtime, ext, a));
+  ASSERT_TRUE(buffered->isBuffered());
+  auto tail = slice(buffered, 50, chars.size() + 1 - 50);
+  EXPECT_TRUE(tail->isBuffered());
+  EXPECT_TRUE(equals(tail, chars.substr(50) + u"a"));
+  auto tailA = runtime->makeHandle<StringPrimitive>(
+      *StringPrimitive::concat(runtime, tail, a));
+  EXPECT_TRUE(equals(tailA, chars.substr(50) + u"aa"));
+  EXPECT_TRUE(equals(buffered, chars + u"a"));
+}
+
+TEST_F(StringPrimTest, BufferedSliceKeepsBufferChargedTest) {
+  auto mallocSize = [&]() {
+    runtime->getHeap().collect();
+    GCBase::HeapInfo info;
+    runtime->getHeap().getHeapInfoWithMallocSize(info);
+    return info.mallocSizeEstimate;
+  };
+
+  std::u16string chars(StringPrimitive::EXTERNAL_STRING_MIN_SIZE, u'\u0100');
+  auto ext = runtime->makeHandle<StringPrimitive>(
+      *StringPrimitive::createEfficient(runtime, std::u16string(chars)));
+  auto a = StringPrimitive::createNoThrow(runtime, createUTF16Ref(u"a"));
+  auto before = mallocSize();
+
+  // Slice a buffered string, and only keep the slice.
+  MutableHandle<StringPrimitive> tail{runtime};
+  {
+    GCScopeMarkerRAII marker{runtime};
+    auto buffered = runtime->makeHandle<StringPrimitive>(
+        *StringPrimitive::concat(runtime, ext, a));
+    ASSERT_TRUE(buffered->isBuffered());
+    auto strRes = StringPrimitive::slice(runtime, buffered, 50, 50);
+    ASSERT_NE(ExecutionStatus::EXCEPTION, strRes.getStatus());
+    tail = vmcast<StringPrimitive>(*strRes);
+    ASSERT_TRUE(tail->isBuffered());
+  }
+
+  // The buffer the slice retains is still charged.
+  EXPECT_GE(mallocSize(), before + (chars.size() + 1) * sizeof(char16_t));
+  EXPECT_TRUE(StringPrimitive::createStringView(runtime, tail)
+                  .equals(UTF16Ref(chars.data(), 50)));
+}
+
 // This attempts to test that strings above a sufficient length may be freely
 // memcpy'd around. This would not be true if the small-string optimization used
 // an interior pointer, or if someone else maintained a pointer to the string.
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/VM/StructuredClone.h"
+
+#include "hermes/BCGen/HBC/BytecodeProviderFromSrc.h"
+#include "hermes/VM/JSObject.h"
+#include "hermes/VM/StringRefUtils.h"
+
+#include "TestHelpers.h"
+
+#include "gtest/gtest.h"
+
+using namespace hermes::vm;
+
+namespace {
+
+using StructuredCloneTest = RuntimeTestFixture;
+
+TEST_F(StructuredCloneTest, TypedArrays) {
+  auto msgRes = runtime->run(
+      "var buffer = new ArrayBuffer(8);"
+      "var words = new Uint16Array(buffer, 2, 3);"
+      "words[0] = 0x1234;"
+      "[words, new Uint8Array(buffer), new Float64Array([1.5, -2])]",
+      "source/url",
+      hermes::hbc::CompileFlags{});
+  ASSERT_EQ(ExecutionStatus::RETURNED, msgRes.getStatus());
+  auto msg = runtime->makeHandle(*msgRes);
+
+  auto serialized = SerializedValue::serialize(
+      runtime, msg, runtime->getUndefinedValue());
+  ASSERT_EQ(ExecutionStatus::RETURNED, serialized.getStatus());
+  auto copyRes = (*serialized)->deserialize(runtime);
+  ASSERT_EQ(ExecutionStatus::RETURNED, copyRes.getStatus());
+  auto copy = runtime->makeHandle(*copyRes);
+  EXPECT_NE(msg.get().getRaw(), copy.get().getRaw());
+
+  auto nameRes = runtime->getIdentifierTable().getSymbolHandle(
+      runtime, createASCIIRef("copy"));
+  ASSERT_EQ(ExecutionStatus::RETURNED, nameRes.getStatus());
+  ASSERT_EQ(
+      ExecutionStatus::RETURNED,
+      JSObject::putNamed_RJS(runtime->getGlobal(), runtime, **nameRes, copy)
+          .getStatus());
+
+  // The views are rebuilt over a single copied buffer.
+  auto res = runtime->run(
+      "copy[0] instanceof Uint16Array && copy[0].byteOffset === 2 &&"
+      "copy[0].length === 3 && copy[0][0] === 0x1234 &&"
+      "copy[0].buffer === copy[1].buffer && copy[0].buffer !== buffer &&"
+      "copy[1].length === 8 && copy[1][2] === 0x34 &&"
+      "copy[2] instanceof Float64Array && copy[2][1] === -2",
+      "source/url",
+      hermes::hbc::CompileFlags{});
+  ASSERT_EQ(ExecutionStatus::RETURNED, res.getStatus());
+  EXPECT_TRUE(res->getBool());
+}
+
+} // namespace
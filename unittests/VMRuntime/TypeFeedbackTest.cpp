@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the LICENSE
+ * file in the root directory of this source tree.
+ */
+#include "hermes/VM/TypeFeedback.h"
+
+#include "gtest/gtest.h"
+
+using namespace hermes::vm;
+using hermes::inst::OpCode;
+
+namespace {
+
+TEST(TypeFeedbackTest, FeedbackSites) {
+  EXPECT_TRUE(TypeFeedbackVector::isFeedbackSite(OpCode::Add));
+  EXPECT_TRUE(TypeFeedbackVector::isFeedbackSite(OpCode::JLessLong));
+  EXPECT_TRUE(TypeFeedbackVector::isFeedbackSite(OpCode::GetByIdShort));
+  EXPECT_TRUE(TypeFeedbackVector::isFeedbackSite(OpCode::Call2));
+  // The specialized forms only run with numbers.
+  EXPECT_FALSE(TypeFeedbackVector::isFeedbackSite(OpCode::AddN));
+  EXPECT_FALSE(TypeFeedbackVector::isFeedbackSite(OpCode::JLessN));
+  EXPECT_FALSE(TypeFeedbackVector::isFeedbackSite(OpCode::Mov));
+  EXPECT_FALSE(TypeFeedbackVector::isFeedbackSite(OpCode::Ret));
+}
+
+TEST(TypeFeedbackTest, TypeOf) {
+  EXPECT_EQ(FeedbackNumber, feedbackTypeOf(HermesValue::encodeNumberValue(1)));
+  EXPECT_EQ(FeedbackBoolean, feedbackTypeOf(HermesValue::encodeBoolValue(1)));
+  EXPECT_EQ(
+      FeedbackNullOrUndefined,
+      feedbackTypeOf(HermesValue::encodeUndefinedValue()));
+  EXPECT_EQ(
+      FeedbackNullOrUndefined, feedbackTypeOf(HermesValue::encodeNullValue()));
+  EXPECT_EQ(FeedbackOther, feedbackTypeOf(HermesValue::encodeEmptyValue()));
+}
+
+TEST(TypeFeedbackTest, RecordBySlot) {
+  const uint32_t offsets[] = {3, 10, 24};
+  TypeFeedbackVector feedback(offsets);
+  ASSERT_EQ(3u, feedback.size());
+  EXPECT_EQ(10u, feedback.getSlotOffset(1));
+  EXPECT_EQ(1u, feedback.findSlot(10));
+  EXPECT_EQ(feedback.size(), feedback.findSlot(11));
+
+  feedback.record(10, FeedbackNumber);
+  feedback.record(10, FeedbackString);
+  EXPECT_EQ(FeedbackNumber | FeedbackString, feedback.getSlotTypes(1));
+  EXPECT_EQ(FeedbackNumber | FeedbackString, feedback.getTypes(10));
+  EXPECT_EQ(0, feedback.getTypes(3));
+
+  // Offsets that are not feedback sites are ignored.
+  feedback.record(4, FeedbackObject);
+  feedback.record(100, FeedbackObject);
+  EXPECT_EQ(0, feedback.getTypes(4));
+  EXPECT_EQ(0, feedback.getSlotTypes(0));
+  EXPECT_EQ(0, feedback.getSlotTypes(2));
+}
+
+} // namespace
@@ -91,6 +91,7 @@ def run_interval(unicode_data_lines, args):
         print("{" + hex(i[0]) + ", " + hex(i[1]) + "},")
     print("};")
     print("")
+    return name, intervals
 
 
 def print_categories(unicode_data_lines):
@@ -103,8 +104,83 @@ def print_categories(unicode_data_lines):
         "UNICODE_DIGIT Nd",
         "UNICODE_CONNECTOR_PUNCTUATION Pc",
     ]
-    for cat in categories:
-        run_interval(unicode_data_lines, cat.split())
+    tables = [run_interval(unicode_data_lines, cat.split()) for cat in categories]
+    print_category_trie(tables)
+
+
+# The code points covered by the category trie, and the log2 of the number of
+# code points of its blocks. The tables are searched for the code points above,
+# which are rare and mostly CJK ideographs.
+CATEGORY_TRIE_LIMIT = 0x20000
+CATEGORY_TRIE_SHIFT = 5
+
+
+def print_numbers(numbers):
+    """Print the numbers of an array initializer, wrapped at 80 columns."""
+    line = "   "
+    for n in numbers:
+        item = " " + str(n) + ","
+        if len(line) + len(item) > 80:
+            print(line)
+            line = "   "
+        line += item
+    print(line)
+
+
+def print_category_trie(tables):
+    """Print a two-level trie of the categories of the code points below
+    CATEGORY_TRIE_LIMIT.
+
+    The trie maps every code point to a byte with a flag per table of
+    \p tables, a list of (name, intervals) pairs. The first level maps the
+    high bits of the code point to the index of a block, and the second level
+    is the deduplicated blocks of flags of the consecutive code points.
+
+    """
+    flags = bytearray(CATEGORY_TRIE_LIMIT)
+    for bit, (_, intervals) in enumerate(tables):
+        for first, last in intervals:
+            for cp in range(first, min(last + 1, CATEGORY_TRIE_LIMIT)):
+                flags[cp] |= 1 << bit
+
+    block_size = 1 << CATEGORY_TRIE_SHIFT
+    block_ids = {}
+    index = []
+    blocks = []
+    for start in range(0, CATEGORY_TRIE_LIMIT, block_size):
+        block = bytes(flags[start : start + block_size])
+        if block not in block_ids:
+            block_ids[block] = len(block_ids)
+            blocks.extend(block)
+        index.append(block_ids[block])
+    index_type = "uint8_t" if len(block_ids) <= 256 else "uint16_t"
+
+    print("// The categories above as flags, for UNICODE_CATEGORY_TRIE_BLOCKS.")
+    print("enum UnicodeCategoryFlag : uint8_t {")
+    for bit, (name, _) in enumerate(tables):
+        print("  %s_FLAG = %d," % (name, 1 << bit))
+    print("};")
+    print("")
+    print("// The flags of the code point cp below UNICODE_CATEGORY_TRIE_LIMIT are")
+    print("// UNICODE_CATEGORY_TRIE_BLOCKS[")
+    print("//     (UNICODE_CATEGORY_TRIE_INDEX[cp >> UNICODE_CATEGORY_TRIE_SHIFT]")
+    print("//      << UNICODE_CATEGORY_TRIE_SHIFT) +")
+    print("//     (cp & ((1 << UNICODE_CATEGORY_TRIE_SHIFT) - 1))].")
+    print(
+        "static constexpr uint32_t UNICODE_CATEGORY_TRIE_LIMIT = %s;"
+        % hex(CATEGORY_TRIE_LIMIT)
+    )
+    print(
+        "static constexpr uint32_t UNICODE_CATEGORY_TRIE_SHIFT = %d;"
+        % CATEGORY_TRIE_SHIFT
+    )
+    print("static constexpr %s UNICODE_CATEGORY_TRIE_INDEX[] = {" % index_type)
+    print_numbers(index)
+    print("};")
+    print("static constexpr uint8_t UNICODE_CATEGORY_TRIE_BLOCKS[] = {")
+    print_numbers(blocks)
+    print("};")
+    print("")
 
 
 class CaseMap(object):